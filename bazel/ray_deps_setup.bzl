@@ -183,6 +183,11 @@ def ray_deps_setup():
         sha256 = "b4870bf121ff7795ba20d20bcdd8627b8e088f2d1dab299a031c1034eddc93d5",
     )
 
+    auto_http_archive(
+        name = "com_github_google_benchmark",
+        url = "https://github.com/google/benchmark/archive/refs/tags/v1.7.1.tar.gz",
+    )
+
     auto_http_archive(
         name = "com_github_gflags_gflags",
         url = "https://github.com/gflags/gflags/archive/e171aa2d15ed9eb17054558e0b3a6a413bb01067.tar.gz",
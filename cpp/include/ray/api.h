@@ -27,6 +27,7 @@
 #include <ray/api/wait_result.h>
 
 #include <boost/callable_traits.hpp>
+#include <future>
 #include <memory>
 #include <msgpack.hpp>
 #include <mutex>
@@ -73,6 +74,25 @@ std::shared_ptr<T> Get(const ray::ObjectRef<T> &object);
 template <typename T>
 std::vector<std::shared_ptr<T>> Get(const std::vector<ray::ObjectRef<T>> &objects);
 
+/// Get a single object from the object store without blocking.
+/// The object is deserialized where it is in the object store, on a thread of the
+/// runtime, once it is ready.
+///
+/// \param[in] object The object reference which should be returned.
+/// \return A future of the result, which holds the exception if getting it failed.
+template <typename T>
+std::future<std::shared_ptr<T>> GetAsync(const ray::ObjectRef<T> &object);
+
+/// Get a list of objects from the object store without blocking.
+/// The objects are fetched concurrently, and deserialized as they become ready.
+///
+/// \param[in] objects The object array which should be got.
+/// \return A future of the results, which holds the first exception if getting any of
+/// them failed.
+template <typename T>
+std::future<std::vector<std::shared_ptr<T>>> GetAsync(
+    const std::vector<ray::ObjectRef<T>> &objects);
+
 /// Wait for a list of objects to be locally available,
 /// until specified number of objects are ready, or specified timeout has passed.
 ///
@@ -161,9 +181,12 @@ inline std::vector<std::string> ObjectRefsToObjectIDs(
 
 template <typename T>
 inline ray::ObjectRef<T> Put(const T &obj) {
-  auto buffer =
-      std::make_shared<msgpack::sbuffer>(ray::internal::Serializer::Serialize(obj));
-  auto id = ray::internal::GetRayRuntime()->Put(buffer);
+  // Serialize the object directly into the object store, instead of through an
+  // intermediate buffer.
+  auto size = ray::internal::Serializer::SerializedSize(obj);
+  auto id = ray::internal::GetRayRuntime()->PutInPlace(size, [&obj, size](char *data) {
+    ray::internal::Serializer::SerializeTo(obj, data, size);
+  });
   auto ref = ObjectRef<T>(id);
   // The core worker will add an initial ref to the put ID to
   // keep it in scope. Now that we've created the frontend
@@ -196,6 +219,77 @@ inline std::vector<std::shared_ptr<T>> Get(const std::vector<ray::ObjectRef<T>>
   return Get<T>(object_ids);
 }
 
+template <typename T>
+inline std::future<std::shared_ptr<T>> GetAsync(const ray::ObjectRef<T> &object) {
+  auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+  auto future = promise->get_future();
+  // The reference is held until the object is got, so that it isn't released meanwhile.
+  ray::internal::GetRayRuntime()->GetAsync(
+      object.ID(),
+      [promise, object](const char *data, size_t size, std::exception_ptr error) {
+        if (error) {
+          promise->set_exception(error);
+          return;
+        }
+        try {
+          promise->set_value(DeserializeResult<T>(data, size));
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+  return future;
+}
+
+template <typename T>
+inline std::future<std::vector<std::shared_ptr<T>>> GetAsync(
+    const std::vector<ray::ObjectRef<T>> &objects) {
+  struct PendingGet {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<T>> results;
+    size_t num_pending;
+    bool done = false;
+    std::promise<std::vector<std::shared_ptr<T>>> promise;
+  };
+  auto pending = std::make_shared<PendingGet>();
+  pending->results.resize(objects.size());
+  pending->num_pending = objects.size();
+  auto future = pending->promise.get_future();
+  if (objects.empty()) {
+    pending->promise.set_value({});
+    return future;
+  }
+  for (size_t i = 0; i < objects.size(); i++) {
+    ray::internal::GetRayRuntime()->GetAsync(
+        objects[i].ID(),
+        [pending, i, object = objects[i]](
+            const char *data, size_t size, std::exception_ptr error) {
+          std::shared_ptr<T> result;
+          if (!error) {
+            try {
+              result = DeserializeResult<T>(data, size);
+            } catch (...) {
+              error = std::current_exception();
+            }
+          }
+          std::lock_guard<std::mutex> lock(pending->mutex);
+          if (pending->done) {
+            return;
+          }
+          if (error) {
+            pending->done = true;
+            pending->promise.set_exception(error);
+            return;
+          }
+          pending->results[i] = std::move(result);
+          if (--pending->num_pending == 0) {
+            pending->done = true;
+            pending->promise.set_value(std::move(pending->results));
+          }
+        });
+  }
+  return future;
+}
+
 template <typename T>
 inline WaitResult<T> Wait(const std::vector<ray::ObjectRef<T>> &objects,
                           int num_objects,
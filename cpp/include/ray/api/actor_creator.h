@@ -59,6 +59,13 @@ class ActorCreator {
     return *this;
   }
 
+  /// Define a concurrency group, which runs the actor tasks that are submitted to it
+  /// with `ActorTaskCaller::SetConcurrencyGroup` on threads of its own.
+  ActorCreator &SetConcurrencyGroup(std::string name, int max_concurrency) {
+    create_options_.concurrency_groups[std::move(name)] = max_concurrency;
+    return *this;
+  }
+
   ActorCreator &SetPlacementGroup(PlacementGroup group, int bundle_index) {
     create_options_.group = group;
     create_options_.bundle_index = bundle_index;
@@ -69,6 +76,8 @@ class ActorCreator {
   RayRuntime *runtime_;
   RemoteFunctionHolder remote_function_holder_;
   std::vector<TaskArg> args_;
+  /// The values of `args_` packed by `Arguments::WrapArgs`.
+  msgpack::sbuffer packed_args_;
   ActorCreationOptions create_options_{};
 };
 
@@ -82,6 +91,7 @@ ActorHandle<GetActorType<F>, is_python_v<F>> ActorCreator<F>::Remote(Args &&...a
     using ArgsTuple = std::tuple<Args...>;
     Arguments::WrapArgs<ArgsTuple>(/*cross_lang=*/true,
                                    &args_,
+                                   &packed_args_,
                                    std::make_index_sequence<sizeof...(Args)>{},
                                    std::forward<Args>(args)...);
   } else {
@@ -89,6 +99,7 @@ ActorHandle<GetActorType<F>, is_python_v<F>> ActorCreator<F>::Remote(Args &&...a
     using ArgsTuple = RemoveReference_t<boost::callable_traits::args_t<F>>;
     Arguments::WrapArgs<ArgsTuple>(/*cross_lang=*/false,
                                    &args_,
+                                   &packed_args_,
                                    std::make_index_sequence<sizeof...(Args)>{},
                                    std::forward<Args>(args)...);
   }
@@ -51,11 +51,19 @@ class ActorTaskCaller {
     return *this;
   }
 
+  /// Run the task in a concurrency group that the actor was created with.
+  ActorTaskCaller &SetConcurrencyGroup(std::string name) {
+    task_options_.concurrency_group_name = std::move(name);
+    return *this;
+  }
+
  private:
   RayRuntime *runtime_;
   std::string id_;
   RemoteFunctionHolder remote_function_holder_;
   std::vector<TaskArg> args_;
+  /// The values of `args_` packed by `Arguments::WrapArgs`.
+  msgpack::sbuffer packed_args_;
   CallOptions task_options_;
 };
 
@@ -71,6 +79,7 @@ ObjectRef<boost::callable_traits::return_type_t<F>> ActorTaskCaller<F>::Remote(
     using ArgsTuple = std::tuple<Args...>;
     Arguments::WrapArgs<ArgsTuple>(/*cross_lang=*/true,
                                    &args_,
+                                   &packed_args_,
                                    std::make_index_sequence<sizeof...(Args)>{},
                                    std::forward<Args>(args)...);
   } else {
@@ -78,6 +87,7 @@ ObjectRef<boost::callable_traits::return_type_t<F>> ActorTaskCaller<F>::Remote(
     using ArgsTuple = RemoveReference_t<RemoveFirst_t<boost::callable_traits::args_t<F>>>;
     Arguments::WrapArgs<ArgsTuple>(/*cross_lang=*/false,
                                    &args_,
+                                   &packed_args_,
                                    std::make_index_sequence<sizeof...(Args)>{},
                                    std::forward<Args>(args)...);
   }
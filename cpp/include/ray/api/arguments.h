@@ -28,6 +28,7 @@ class Arguments {
   template <typename OriginArgType, typename InputArgTypes>
   static void WrapArgsImpl(bool cross_lang,
                            std::vector<TaskArg> *task_args,
+                           msgpack::sbuffer *packed_args,
                            InputArgTypes &&arg) {
     if constexpr (is_object_ref_v<OriginArgType>) {
       PushReferenceArg(task_args, std::forward<InputArgTypes>(arg));
@@ -46,7 +47,10 @@ class Arguments {
         msgpack::sbuffer dummy_buf(METADATA_STR_DUMMY.size());
         dummy_buf.write(METADATA_STR_DUMMY.data(), METADATA_STR_DUMMY.size());
 
-        auto data_buf = Serializer::Serialize(std::forward<InputArgTypes>(arg));
+        // Other languages can't read the contiguous encoding of the vectors of numbers,
+        // so the argument is packed by msgpack directly.
+        msgpack::sbuffer data_buf;
+        msgpack::pack(data_buf, std::forward<InputArgTypes>(arg));
         auto len_buf = Serializer::Serialize(data_buf.size());
 
         msgpack::sbuffer buffer(XLANG_HEADER_LEN + data_buf.size());
@@ -59,27 +63,69 @@ class Arguments {
         PushValueArg(task_args, std::move(dummy_buf), METADATA_STR_RAW);
         PushValueArg(task_args, std::move(buffer), METADATA_STR_XLANG);
       } else {
-        msgpack::sbuffer buffer = Serializer::Serialize(std::forward<InputArgTypes>(arg));
-        PushValueArg(task_args, std::move(buffer));
+        PushPackedArg(task_args, packed_args, arg);
       }
     }
   }
 
+  /// Wrap the arguments of a call into task arguments.
+  ///
+  /// The values of a call between C++ workers are serialized back to back into
+  /// `packed_args`, which is sized for all of them up front, so that a call allocates
+  /// one buffer rather than one per argument. `packed_args` must outlive the
+  /// submission of the task.
   template <typename OriginArgsTuple, size_t... I, typename... InputArgTypes>
   static void WrapArgs(bool cross_lang,
                        std::vector<TaskArg> *task_args,
+                       msgpack::sbuffer *packed_args,
                        std::index_sequence<I...>,
                        InputArgTypes &&...args) {
+    // A cross-language value takes two task arguments.
+    task_args->reserve(task_args->size() + (cross_lang ? 2 : 1) * sizeof...(I));
+    if (!cross_lang && packed_args->size() == 0) {
+      const size_t packed_size =
+          (size_t{0} + ... +
+           PackedArgSize<std::tuple_element_t<I, OriginArgsTuple>>(args));
+      if (packed_size > 0) {
+        *packed_args = msgpack::sbuffer(packed_size);
+      }
+    }
     (void)std::initializer_list<int>{
         (WrapArgsImpl<std::tuple_element_t<I, OriginArgsTuple>>(
-             cross_lang, task_args, std::forward<InputArgTypes>(args)),
+             cross_lang, task_args, packed_args, std::forward<InputArgTypes>(args)),
          0)...};
     /// Silence gcc warning error.
     (void)task_args;
+    (void)packed_args;
     (void)cross_lang;
   }
 
  private:
+  /// The serialized size of an argument that `WrapArgsImpl` packs into the shared
+  /// buffer of a call between C++ workers, or 0 for the other arguments.
+  template <typename OriginArgType, typename InputArgTypes>
+  static size_t PackedArgSize(const InputArgTypes &arg) {
+    if constexpr (is_object_ref_v<OriginArgType> || is_object_ref_v<InputArgTypes>) {
+      return 0;
+    } else {
+      return Serializer::SerializedSize(arg);
+    }
+  }
+
+  template <typename T>
+  static void PushPackedArg(std::vector<TaskArg> *task_args,
+                            msgpack::sbuffer *packed_args,
+                            const T &arg) {
+    /// Pass by value. The offset rather than the address is kept, because the
+    /// buffer may still grow while the other arguments are packed.
+    TaskArg task_arg;
+    task_arg.packed_buf = packed_args;
+    task_arg.packed_offset = packed_args->size();
+    Serializer::SerializeAppend(arg, packed_args);
+    task_arg.packed_size = packed_args->size() - task_arg.packed_offset;
+    task_args->emplace_back(std::move(task_arg));
+  }
+
   static void PushValueArg(std::vector<TaskArg> *task_args,
                            msgpack::sbuffer &&buffer,
                            std::string_view meta_str = "") {
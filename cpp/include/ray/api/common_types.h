@@ -26,6 +26,9 @@ struct TaskArg {
   TaskArg() = default;
   TaskArg(TaskArg &&rhs) {
     buf = std::move(rhs.buf);
+    packed_buf = rhs.packed_buf;
+    packed_offset = rhs.packed_offset;
+    packed_size = rhs.packed_size;
     id = rhs.id;
     meta_str = std::move(rhs.meta_str);
   }
@@ -36,6 +39,11 @@ struct TaskArg {
 
   /// If the buf is initialized shows it is a value argument.
   boost::optional<msgpack::sbuffer> buf;
+  /// If the packed_buf is set, it is a value argument packed at `packed_offset` into a
+  /// buffer shared by the arguments of a call.
+  const msgpack::sbuffer *packed_buf = nullptr;
+  size_t packed_offset = 0;
+  size_t packed_size = 0;
   /// If the id is initialized shows it is a reference argument.
   boost::optional<std::string> id;
 
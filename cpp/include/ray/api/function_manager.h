@@ -23,6 +23,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -58,6 +59,19 @@ using RemoteMemberFunction =
     std::function<msgpack::sbuffer(msgpack::sbuffer *, const ArgsBufferList &)>;
 using RemoteMemberFunctionMap_t = std::unordered_map<std::string, RemoteMemberFunction>;
 
+/// Return the ID of a remote function, the 64-bit FNV-1a hash of its name. Calls
+/// between C++ workers carry the ID so that the function is looked up by an integer
+/// instead of by its name. This is constexpr, so the ID of a name known at compile
+/// time is computed at compile time.
+constexpr uint64_t GetFunctionId(std::string_view function_name) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : function_name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 /// It's help to invoke functions and member functions, the class Invoker<Function> help
 /// do type erase.
 template <typename Function>
@@ -217,6 +231,15 @@ class FunctionManager {
     return &it->second;
   }
 
+  RemoteFunction *GetFunction(uint64_t function_id) {
+    auto it = invokers_by_id_.find(function_id);
+    if (it == invokers_by_id_.end()) {
+      return nullptr;
+    }
+
+    return it->second;
+  }
+
   template <typename Function>
   std::enable_if_t<!std::is_member_function_pointer<Function>::value, bool>
   RegisterRemoteFunction(std::string const &name, const Function &f) {
@@ -284,6 +307,15 @@ class FunctionManager {
     return &it->second;
   }
 
+  RemoteMemberFunction *GetMemberFunction(uint64_t function_id) {
+    auto it = mem_func_invokers_by_id_.find(function_id);
+    if (it == mem_func_invokers_by_id_.end()) {
+      return nullptr;
+    }
+
+    return it->second;
+  }
+
  private:
   FunctionManager() = default;
   ~FunctionManager() = default;
@@ -292,22 +324,32 @@ class FunctionManager {
 
   template <typename Function>
   bool RegisterNonMemberFunc(std::string const &name, Function f) {
-    return map_invokers_
-        .emplace(
-            name,
-            std::bind(&Invoker<Function>::Apply, std::move(f), std::placeholders::_1))
-        .second;
+    auto pair = map_invokers_.emplace(
+        name, std::bind(&Invoker<Function>::Apply, std::move(f), std::placeholders::_1));
+    if (!pair.second) {
+      return false;
+    }
+    if (!invokers_by_id_.emplace(GetFunctionId(name), &pair.first->second).second) {
+      throw RayException("RAY_REMOTE function ID collision: " + name);
+    }
+    return true;
   }
 
   template <typename Function>
   bool RegisterMemberFunc(std::string const &name, Function f) {
-    return map_mem_func_invokers_
-        .emplace(name,
-                 std::bind(&Invoker<Function>::ApplyMember,
-                           std::move(f),
-                           std::placeholders::_1,
-                           std::placeholders::_2))
-        .second;
+    auto pair = map_mem_func_invokers_.emplace(name,
+                                               std::bind(&Invoker<Function>::ApplyMember,
+                                                         std::move(f),
+                                                         std::placeholders::_1,
+                                                         std::placeholders::_2));
+    if (!pair.second) {
+      return false;
+    }
+    if (!mem_func_invokers_by_id_.emplace(GetFunctionId(name), &pair.first->second)
+             .second) {
+      throw RayException("RAY_REMOTE function ID collision: " + name);
+    }
+    return true;
   }
 
   template <class Dest, class Source>
@@ -328,6 +370,9 @@ class FunctionManager {
 
   RemoteFunctionMap_t map_invokers_;
   RemoteMemberFunctionMap_t map_mem_func_invokers_;
+  /// The functions of the maps above by function ID.
+  std::unordered_map<uint64_t, RemoteFunction *> invokers_by_id_;
+  std::unordered_map<uint64_t, RemoteMemberFunction *> mem_func_invokers_by_id_;
   std::unordered_map<std::string, std::string> func_ptr_to_key_map_;
   std::map<std::pair<std::string, std::string>, std::string> mem_func_to_key_map_;
 };
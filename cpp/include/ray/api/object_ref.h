@@ -27,17 +27,20 @@ template <typename T>
 class ObjectRef;
 
 /// Common helper functions used by ObjectRef<T> and ObjectRef<void>;
-inline void CheckResult(const std::shared_ptr<msgpack::sbuffer> &packed_object) {
-  bool has_error =
-      ray::internal::Serializer::HasError(packed_object->data(), packed_object->size());
+inline void CheckResult(const char *data, size_t size) {
+  bool has_error = ray::internal::Serializer::HasError(data, size);
   if (has_error) {
-    auto tp = ray::internal::Serializer::Deserialize<std::tuple<int, std::string>>(
-        packed_object->data(), packed_object->size(), 1);
+    auto tp =
+        ray::internal::Serializer::Deserialize<std::tuple<int, std::string>>(data, size, 1);
     std::string err_msg = std::get<1>(tp);
     throw ray::internal::RayTaskException(err_msg);
   }
 }
 
+inline void CheckResult(const std::shared_ptr<msgpack::sbuffer> &packed_object) {
+  CheckResult(packed_object->data(), packed_object->size());
+}
+
 inline void CopyAndAddReference(std::string &dest_id, const std::string &id) {
   dest_id = id;
   ray::internal::GetRayRuntime()->AddLocalReference(id);
@@ -109,17 +112,25 @@ class ObjectRef {
 
 // ---------- implementation ----------
 template <typename T>
-inline static std::shared_ptr<T> GetFromRuntime(const ObjectRef<T> &object) {
-  auto packed_object = internal::GetRayRuntime()->Get(object.ID());
-  CheckResult(packed_object);
-
-  if (ray::internal::Serializer::IsXLang(packed_object->data(), packed_object->size())) {
+inline static std::shared_ptr<T> DeserializeResult(const char *data, size_t size) {
+  CheckResult(data, size);
+  if (ray::internal::Serializer::IsXLang(data, size)) {
     return ray::internal::Serializer::Deserialize<std::shared_ptr<T>>(
-        packed_object->data(), packed_object->size(), internal::XLANG_HEADER_LEN);
+        data, size, internal::XLANG_HEADER_LEN);
   }
+  return ray::internal::Serializer::Deserialize<std::shared_ptr<T>>(data, size);
+}
 
-  return ray::internal::Serializer::Deserialize<std::shared_ptr<T>>(
-      packed_object->data(), packed_object->size());
+template <typename T>
+inline static std::shared_ptr<T> GetFromRuntime(const ObjectRef<T> &object) {
+  // Deserialize the object where it is in the object store, instead of copying it out
+  // first.
+  std::shared_ptr<T> result;
+  internal::GetRayRuntime()->GetInPlace(
+      object.ID(), [&result](const char *data, size_t size) {
+        result = DeserializeResult<T>(data, size);
+      });
+  return result;
 }
 
 template <typename T>
@@ -19,6 +19,8 @@
 #include <ray/api/xlang_function.h>
 
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <msgpack.hpp>
 #include <typeinfo>
@@ -46,11 +48,14 @@ struct RemoteFunctionHolder {
           "Function not found. Please use RAY_REMOTE to register this function.");
     }
     function_name = std::move(func_name);
+    function_id = GetFunctionId(function_name);
   }
 
   std::string module_name;
   std::string function_name;
   std::string class_name;
+  /// The ID of a registered C++ function, see `GetFunctionId`, or 0.
+  uint64_t function_id = 0;
   LangType lang_type = LangType::CPP;
 };
 
@@ -59,6 +64,29 @@ class RayRuntime {
   virtual std::string Put(std::shared_ptr<msgpack::sbuffer> data) = 0;
   virtual std::shared_ptr<msgpack::sbuffer> Get(const std::string &id) = 0;
 
+  /// Put an object that is serialized directly into the object store.
+  ///
+  /// \param size The size of the serialized object.
+  /// \param writer Writes the serialized object into the buffer it is passed.
+  virtual std::string PutInPlace(size_t size,
+                                 const std::function<void(char *)> &writer) = 0;
+
+  /// Get an object, and read it where it is in the object store.
+  ///
+  /// \param reader Called with the serialized object, which is only valid until it
+  /// returns.
+  virtual void GetInPlace(const std::string &id,
+                          const std::function<void(const char *, size_t)> &reader) = 0;
+
+  /// Get an object without blocking, and read it where it is in the object store.
+  ///
+  /// \param callback Called once the object is ready, with the serialized object, which
+  /// is only valid until it returns, or with the error that getting it failed with. It
+  /// may be called on a thread of the runtime, so it shouldn't block.
+  virtual void GetAsync(
+      const std::string &id,
+      std::function<void(const char *, size_t, std::exception_ptr)> callback) = 0;
+
   virtual std::vector<std::shared_ptr<msgpack::sbuffer>> Get(
       const std::vector<std::string> &ids) = 0;
 
@@ -69,6 +97,14 @@ class RayRuntime {
   virtual std::string Call(const RemoteFunctionHolder &remote_function_holder,
                            std::vector<TaskArg> &args,
                            const CallOptions &task_options) = 0;
+  /// Submit a task of the function with the same options for each of the argument
+  /// lists.
+  ///
+  /// \return The IDs of the returned objects of the tasks, in order.
+  virtual std::vector<std::string> CallBatch(
+      const RemoteFunctionHolder &remote_function_holder,
+      std::vector<std::vector<TaskArg>> &args_list,
+      const CallOptions &task_options) = 0;
   virtual std::string CreateActor(const RemoteFunctionHolder &remote_function_holder,
                                   std::vector<TaskArg> &args,
                                   const ActorCreationOptions &create_options) = 0;
@@ -15,8 +15,12 @@
 #pragma once
 
 #include <ray/api/ray_exception.h>
+#include <ray/api/type_traits.h>
 #include <ray/api/xlang_function.h>
 
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <msgpack.hpp>
 
 namespace ray {
@@ -27,10 +31,35 @@ class Serializer {
   template <typename T>
   static msgpack::sbuffer Serialize(const T &t) {
     msgpack::sbuffer buffer;
-    msgpack::pack(buffer, t);
+    Pack(buffer, t);
     return buffer;
   }
 
+  /// Get the size of the serialized object, so that it can be serialized directly into
+  /// a buffer of that size with `SerializeTo`.
+  template <typename T>
+  static size_t SerializedSize(const T &t) {
+    SizeCounter counter;
+    Pack(counter, t);
+    return counter.size;
+  }
+
+  /// Serialize the object at the end of a buffer, e.g. to pack several objects into one
+  /// buffer that was allocated for the sum of their `SerializedSize`.
+  template <typename T>
+  static void SerializeAppend(const T &t, msgpack::sbuffer *buffer) {
+    Pack(*buffer, t);
+  }
+
+  template <typename T>
+  static void SerializeTo(const T &t, char *data, size_t size) {
+    FixedBufferWriter writer{data, size};
+    Pack(writer, t);
+    if (writer.offset != size) {
+      throw RayException("The serialized object doesn't match its precomputed size.");
+    }
+  }
+
   static msgpack::sbuffer Serialize(const char *data, size_t size) {
     msgpack::sbuffer buffer;
     msgpack::packer<msgpack::sbuffer> packer(&buffer);
@@ -41,6 +70,18 @@ class Serializer {
 
   template <typename T>
   static T Deserialize(const char *data, size_t size) {
+    if constexpr (is_numeric_vector_v<T>) {
+      if (IsNumericArray(data, size)) {
+        return UnpackNumericArray<T>(data, size);
+      }
+    } else if constexpr (is_shared_ptr_v<T>) {
+      if constexpr (is_numeric_vector_v<typename T::element_type>) {
+        if (IsNumericArray(data, size)) {
+          return std::make_shared<typename T::element_type>(
+              UnpackNumericArray<typename T::element_type>(data, size));
+        }
+      }
+    }
     msgpack::unpacked unpacked;
     msgpack::unpack(unpacked, data, size);
     return unpacked.get().as<T>();
@@ -59,6 +100,11 @@ class Serializer {
 
   template <typename T>
   static std::pair<bool, T> DeserializeWhenNil(const char *data, size_t size) {
+    if constexpr (is_numeric_vector_v<T>) {
+      if (IsNumericArray(data, size)) {
+        return {true, UnpackNumericArray<T>(data, size)};
+      }
+    }
     T val;
     size_t off = 0;
     msgpack::unpacked unpacked = msgpack::unpack(data, size, off);
@@ -69,16 +115,137 @@ class Serializer {
     return {true, val};
   }
 
-  static bool HasError(char *data, size_t size) {
-    msgpack::unpacked unpacked = msgpack::unpack(data, size);
-    return unpacked.get().is_nil() && size > 1;
+  // NOTE: Only the first byte of the object is checked, so that a large object is not
+  // unpacked just to find out its type.
+  static bool HasError(const char *data, size_t size) {
+    return size > 1 && static_cast<uint8_t>(data[0]) == 0xc0;
+  }
+
+  static bool IsXLang(const char *data, size_t size) {
+    if (size < XLANG_HEADER_LEN) {
+      return false;
+    }
+    auto first_byte = static_cast<uint8_t>(data[0]);
+    // A positive fixint, or an uint 8/16/32/64.
+    return first_byte <= 0x7f || (first_byte >= 0xcc && first_byte <= 0xcf);
   }
 
-  static bool IsXLang(char *data, size_t size) {
-    msgpack::unpacked unpacked = msgpack::unpack(data, size);
-    return unpacked.get().type == msgpack::type::POSITIVE_INTEGER &&
-           size >= XLANG_HEADER_LEN;
+  /// Whether the data is a vector of numbers serialized by the contiguous fast path.
+  static bool IsNumericArray(const char *data, size_t size) {
+    return size >= kNumericArrayHeaderLen && static_cast<uint8_t>(data[0]) == 0xc9 &&
+           data[5] == kNumericArrayExtType;
   }
+
+  /// Convert a vector of numbers serialized by the contiguous fast path into a plain
+  /// msgpack array, which other languages can read.
+  static msgpack::sbuffer NumericArrayToMsgpack(const char *data, size_t size) {
+    switch (data[6]) {
+    case 'f':
+      if (data[7] == 4) {
+        return RepackNumericArray<float>(data, size);
+      }
+      return RepackNumericArray<double>(data, size);
+    case 'i':
+      switch (data[7]) {
+      case 1:
+        return RepackNumericArray<int8_t>(data, size);
+      case 2:
+        return RepackNumericArray<int16_t>(data, size);
+      case 4:
+        return RepackNumericArray<int32_t>(data, size);
+      default:
+        return RepackNumericArray<int64_t>(data, size);
+      }
+    default:
+      switch (data[7]) {
+      case 1:
+        return RepackNumericArray<uint8_t>(data, size);
+      case 2:
+        return RepackNumericArray<uint16_t>(data, size);
+      case 4:
+        return RepackNumericArray<uint32_t>(data, size);
+      default:
+        return RepackNumericArray<uint64_t>(data, size);
+      }
+    }
+  }
+
+ private:
+  /// The msgpack extension type of the vectors of numbers, which are serialized as one
+  /// contiguous block of memory instead of element by element. The extension is laid out
+  /// as an ext 32 header, followed by the kind ('f', 'i' or 'u') and the size of the
+  /// elements, and then the elements themselves in the byte order of the host. The
+  /// elements start at offset 8, so they are aligned in an aligned buffer.
+  static constexpr char kNumericArrayExtType = 102;
+  static constexpr size_t kNumericArrayHeaderLen = 8;
+
+  template <typename Stream, typename T>
+  static void Pack(Stream &stream, const T &t) {
+    if constexpr (is_numeric_vector_v<T>) {
+      using Element = typename T::value_type;
+      uint64_t payload_size = 2 + t.size() * sizeof(Element);
+      // Fall back to msgpack for the vectors that don't fit in an ext 32.
+      if (payload_size <= std::numeric_limits<uint32_t>::max()) {
+        char header[kNumericArrayHeaderLen];
+        header[0] = static_cast<char>(0xc9);
+        for (int i = 0; i < 4; i++) {
+          header[1 + i] = static_cast<char>(payload_size >> (8 * (3 - i)));
+        }
+        header[5] = kNumericArrayExtType;
+        header[6] = std::is_floating_point_v<Element>
+                        ? 'f'
+                        : (std::is_signed_v<Element> ? 'i' : 'u');
+        header[7] = static_cast<char>(sizeof(Element));
+        stream.write(header, kNumericArrayHeaderLen);
+        stream.write(reinterpret_cast<const char *>(t.data()),
+                     t.size() * sizeof(Element));
+        return;
+      }
+    }
+    msgpack::pack(stream, t);
+  }
+
+  template <typename T>
+  static T UnpackNumericArray(const char *data, size_t size) {
+    using Element = typename T::value_type;
+    const char kind = std::is_floating_point_v<Element>
+                          ? 'f'
+                          : (std::is_signed_v<Element> ? 'i' : 'u');
+    if (data[6] != kind || data[7] != static_cast<char>(sizeof(Element)) ||
+        (size - kNumericArrayHeaderLen) % sizeof(Element) != 0) {
+      throw msgpack::type_error();
+    }
+    T result((size - kNumericArrayHeaderLen) / sizeof(Element));
+    std::memcpy(result.data(), data + kNumericArrayHeaderLen, size - kNumericArrayHeaderLen);
+    return result;
+  }
+
+  template <typename Element>
+  static msgpack::sbuffer RepackNumericArray(const char *data, size_t size) {
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, UnpackNumericArray<std::vector<Element>>(data, size));
+    return buffer;
+  }
+
+  /// A msgpack stream that only counts the bytes written to it.
+  struct SizeCounter {
+    void write(const char *, size_t len) { size += len; }
+    size_t size = 0;
+  };
+
+  /// A msgpack stream that writes into a buffer of a fixed size.
+  struct FixedBufferWriter {
+    void write(const char *buf, size_t len) {
+      if (offset + len > capacity) {
+        throw RayException("The serialized object doesn't match its precomputed size.");
+      }
+      std::memcpy(data + offset, buf, len);
+      offset += len;
+    }
+    char *data;
+    size_t capacity;
+    size_t offset = 0;
+  };
 };
 
 }  // namespace internal
@@ -95,6 +95,9 @@ struct CallOptions {
   std::unordered_map<std::string, double> resources;
   PlacementGroup group;
   int bundle_index;
+  /// The concurrency group of the actor that the task runs in. The default group if
+  /// empty.
+  std::string concurrency_group_name;
 };
 
 struct ActorCreationOptions {
@@ -102,6 +105,9 @@ struct ActorCreationOptions {
   std::unordered_map<std::string, double> resources;
   int max_restarts = 0;
   int max_concurrency = 1;
+  /// The max concurrency of each concurrency group, by name. Every group has its own
+  /// threads, besides the max_concurrency threads of the default group.
+  std::unordered_map<std::string, int> concurrency_groups;
   PlacementGroup group;
   int bundle_index;
 };
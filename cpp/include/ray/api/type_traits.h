@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace ray {
 namespace internal {
@@ -61,5 +63,35 @@ struct is_python_t<T, std::void_t<decltype(std::declval<T>().is_python())>>
 template <typename T>
 auto constexpr is_python_v = is_python_t<T>::value;
 
+template <typename T>
+struct is_shared_ptr_t : std::false_type {};
+
+template <typename T>
+struct is_shared_ptr_t<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+auto constexpr is_shared_ptr_v = is_shared_ptr_t<T>::value;
+
+template <typename T>
+struct is_tuple_t : std::false_type {};
+
+template <typename... T>
+struct is_tuple_t<std::tuple<T...>> : std::true_type {};
+
+template <typename T>
+auto constexpr is_tuple_v = is_tuple_t<T>::value;
+
+/// The vectors of numbers, which are serialized as one contiguous block of memory. Only
+/// the arithmetic types are included, because their layout is the same everywhere.
+template <typename T>
+struct is_numeric_vector_t : std::false_type {};
+
+template <typename T>
+struct is_numeric_vector_t<std::vector<T>>
+    : std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>> {};
+
+template <typename T>
+auto constexpr is_numeric_vector_v = is_numeric_vector_t<T>::value;
+
 }  // namespace internal
 }  // namespace ray
\ No newline at end of file
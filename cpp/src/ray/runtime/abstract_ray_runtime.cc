@@ -96,6 +96,25 @@ std::shared_ptr<msgpack::sbuffer> AbstractRayRuntime::Get(const std::string &obj
   return object_store_->Get(ObjectID::FromBinary(object_id), -1);
 }
 
+std::string AbstractRayRuntime::PutInPlace(size_t size,
+                                           const std::function<void(char *)> &writer) {
+  ObjectID object_id{};
+  object_store_->Put(size, writer, &object_id);
+  return object_id.Binary();
+}
+
+void AbstractRayRuntime::GetInPlace(
+    const std::string &object_id,
+    const std::function<void(const char *, size_t)> &reader) {
+  object_store_->Get(ObjectID::FromBinary(object_id), -1, reader);
+}
+
+void AbstractRayRuntime::GetAsync(
+    const std::string &object_id,
+    std::function<void(const char *, size_t, std::exception_ptr)> callback) {
+  object_store_->GetAsync(ObjectID::FromBinary(object_id), std::move(callback));
+}
+
 inline static std::vector<ObjectID> StringIDsToObjectIDs(
     const std::vector<std::string> &ids) {
   std::vector<ObjectID> object_ids;
@@ -121,10 +140,19 @@ std::vector<std::unique_ptr<::ray::TaskArg>> TransformArgs(
   std::vector<std::unique_ptr<::ray::TaskArg>> ray_args;
   for (auto &arg : args) {
     std::unique_ptr<::ray::TaskArg> ray_arg = nullptr;
-    if (arg.buf) {
-      auto &buffer = *arg.buf;
-      auto memory_buffer = std::make_shared<ray::LocalMemoryBuffer>(
-          reinterpret_cast<uint8_t *>(buffer.data()), buffer.size(), true);
+    if (arg.buf || arg.packed_buf) {
+      // The submitters copy the values into the task spec before the call returns, and
+      // the caller keeps the buffers until then, so they are not copied here.
+      std::shared_ptr<ray::LocalMemoryBuffer> memory_buffer;
+      if (arg.buf) {
+        auto &buffer = *arg.buf;
+        memory_buffer = std::make_shared<ray::LocalMemoryBuffer>(
+            reinterpret_cast<uint8_t *>(buffer.data()), buffer.size(), false);
+      } else {
+        auto data = const_cast<char *>(arg.packed_buf->data()) + arg.packed_offset;
+        memory_buffer = std::make_shared<ray::LocalMemoryBuffer>(
+            reinterpret_cast<uint8_t *>(data), arg.packed_size, false);
+      }
       std::shared_ptr<Buffer> metadata = nullptr;
       if (cross_lang) {
         auto meta_str = arg.meta_str;
@@ -174,6 +202,24 @@ std::string AbstractRayRuntime::Call(const RemoteFunctionHolder &remote_function
   return task_submitter_->SubmitTask(invocation_spec, task_options).Binary();
 }
 
+std::vector<std::string> AbstractRayRuntime::CallBatch(
+    const RemoteFunctionHolder &remote_function_holder,
+    std::vector<std::vector<ray::internal::TaskArg>> &args_list,
+    const CallOptions &task_options) {
+  std::vector<InvocationSpec> invocation_specs;
+  invocation_specs.reserve(args_list.size());
+  for (auto &args : args_list) {
+    invocation_specs.push_back(BuildInvocationSpec1(
+        TaskType::NORMAL_TASK, remote_function_holder, args, ActorID::Nil()));
+  }
+  std::vector<std::string> return_ids;
+  return_ids.reserve(args_list.size());
+  for (const auto &id : task_submitter_->SubmitTasks(invocation_specs, task_options)) {
+    return_ids.push_back(id.Binary());
+  }
+  return return_ids;
+}
+
 std::string AbstractRayRuntime::CreateActor(
     const RemoteFunctionHolder &remote_function_holder,
     std::vector<ray::internal::TaskArg> &args,
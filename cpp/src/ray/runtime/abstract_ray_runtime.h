@@ -52,6 +52,14 @@ class AbstractRayRuntime : public RayRuntime {
 
   std::shared_ptr<msgpack::sbuffer> Get(const std::string &id);
 
+  std::string PutInPlace(size_t size, const std::function<void(char *)> &writer);
+
+  void GetInPlace(const std::string &id,
+                  const std::function<void(const char *, size_t)> &reader);
+
+  void GetAsync(const std::string &id,
+                std::function<void(const char *, size_t, std::exception_ptr)> callback);
+
   std::vector<std::shared_ptr<msgpack::sbuffer>> Get(const std::vector<std::string> &ids);
 
   std::vector<bool> Wait(const std::vector<std::string> &ids,
@@ -62,6 +70,11 @@ class AbstractRayRuntime : public RayRuntime {
                    std::vector<ray::internal::TaskArg> &args,
                    const CallOptions &task_options);
 
+  std::vector<std::string> CallBatch(
+      const RemoteFunctionHolder &remote_function_holder,
+      std::vector<std::vector<ray::internal::TaskArg>> &args_list,
+      const CallOptions &task_options);
+
   std::string CreateActor(const RemoteFunctionHolder &remote_function_holder,
                           std::vector<ray::internal::TaskArg> &args,
                           const ActorCreationOptions &create_options);
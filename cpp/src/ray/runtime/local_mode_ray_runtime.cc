@@ -49,5 +49,13 @@ std::string LocalModeRayRuntime::Put(std::shared_ptr<msgpack::sbuffer> data) {
   return object_id.Binary();
 }
 
+std::string LocalModeRayRuntime::PutInPlace(size_t size,
+                                            const std::function<void(char *)> &writer) {
+  ObjectID object_id =
+      ObjectID::FromIndex(worker_.GetCurrentTaskID(), worker_.GetNextPutIndex());
+  object_store_->Put(size, writer, &object_id);
+  return object_id.Binary();
+}
+
 }  // namespace internal
 }  // namespace ray
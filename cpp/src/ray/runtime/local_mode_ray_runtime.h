@@ -28,6 +28,7 @@ class LocalModeRayRuntime : public AbstractRayRuntime {
   ActorID GetNextActorID();
   ActorID GetCurrentActorID();
   std::string Put(std::shared_ptr<msgpack::sbuffer> data);
+  std::string PutInPlace(size_t size, const std::function<void(char *)> &writer);
   const WorkerContext &GetWorkerContext();
   bool IsLocalMode() { return true; }
 
@@ -25,6 +25,30 @@
 
 namespace ray {
 namespace internal {
+
+namespace {
+
+/// A buffer that holds a serialized object, so that it can be stored without being
+/// copied.
+class SbufferBuffer : public Buffer {
+ public:
+  explicit SbufferBuffer(std::shared_ptr<msgpack::sbuffer> data)
+      : data_(std::move(data)) {}
+
+  uint8_t *Data() const override { return reinterpret_cast<uint8_t *>(data_->data()); }
+
+  size_t Size() const override { return data_->size(); }
+
+  bool OwnsData() const override { return true; }
+
+  bool IsPlasmaBuffer() const override { return false; }
+
+ private:
+  std::shared_ptr<msgpack::sbuffer> data_;
+};
+
+}  // namespace
+
 LocalModeObjectStore::LocalModeObjectStore(LocalModeRayRuntime &local_mode_ray_tuntime)
     : local_mode_ray_tuntime_(local_mode_ray_tuntime) {
   memory_store_ = std::make_unique<CoreWorkerMemoryStore>();
@@ -37,8 +61,8 @@ void LocalModeObjectStore::PutRaw(std::shared_ptr<msgpack::sbuffer> data,
 
 void LocalModeObjectStore::PutRaw(std::shared_ptr<msgpack::sbuffer> data,
                                   const ObjectID &object_id) {
-  auto buffer = std::make_shared<::ray::LocalMemoryBuffer>(
-      reinterpret_cast<uint8_t *>(data->data()), data->size(), true);
+  // The object store takes over the serialized object, instead of copying it.
+  auto buffer = std::make_shared<SbufferBuffer>(std::move(data));
   auto status = memory_store_->Put(
       ::ray::RayObject(buffer, nullptr, std::vector<rpc::ObjectReference>()), object_id);
   if (!status) {
@@ -46,6 +70,37 @@ void LocalModeObjectStore::PutRaw(std::shared_ptr<msgpack::sbuffer> data,
   }
 }
 
+void LocalModeObjectStore::PutRaw(size_t size,
+                                  const std::function<void(char *)> &writer,
+                                  ObjectID *object_id) {
+  auto buffer = std::make_shared<::ray::LocalMemoryBuffer>(size);
+  writer(reinterpret_cast<char *>(buffer->Data()));
+  auto status = memory_store_->Put(
+      ::ray::RayObject(buffer, nullptr, std::vector<rpc::ObjectReference>()), *object_id);
+  if (!status) {
+    throw RayException("Put object error");
+  }
+}
+
+void LocalModeObjectStore::GetRaw(
+    const ObjectID &object_id,
+    int timeout_ms,
+    const std::function<void(const char *, size_t)> &reader) {
+  std::vector<std::shared_ptr<::ray::RayObject>> results;
+  ::ray::Status status = memory_store_->Get({object_id},
+                                            1,
+                                            timeout_ms,
+                                            local_mode_ray_tuntime_.GetWorkerContext(),
+                                            false,
+                                            &results);
+  if (!status.ok()) {
+    throw RayException("Get object error: " + status.ToString());
+  }
+  RAY_CHECK(results.size() == 1);
+  auto data_buffer = results[0]->GetData();
+  reader(reinterpret_cast<const char *>(data_buffer->Data()), data_buffer->Size());
+}
+
 std::shared_ptr<msgpack::sbuffer> LocalModeObjectStore::GetRaw(const ObjectID &object_id,
                                                                int timeout_ms) {
   std::vector<ObjectID> object_ids;
@@ -80,6 +135,19 @@ std::vector<std::shared_ptr<msgpack::sbuffer>> LocalModeObjectStore::GetRaw(
   return result_sbuffers;
 }
 
+void LocalModeObjectStore::GetAsyncRaw(
+    const ObjectID &object_id,
+    std::function<void(const char *, size_t, std::exception_ptr)> callback) {
+  memory_store_->GetAsync(
+      object_id,
+      [callback = std::move(callback)](std::shared_ptr<::ray::RayObject> result) {
+        auto data_buffer = result->GetData();
+        callback(reinterpret_cast<const char *>(data_buffer->Data()),
+                 data_buffer->Size(),
+                 nullptr);
+      });
+}
+
 std::vector<bool> LocalModeObjectStore::Wait(const std::vector<ObjectID> &ids,
                                              int num_objects,
                                              int timeout_ms) {
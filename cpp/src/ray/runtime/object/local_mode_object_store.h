@@ -44,9 +44,19 @@ class LocalModeObjectStore : public ObjectStore {
 
   std::shared_ptr<msgpack::sbuffer> GetRaw(const ObjectID &object_id, int timeout_ms);
 
+  void PutRaw(size_t size, const std::function<void(char *)> &writer, ObjectID *object_id);
+
+  void GetRaw(const ObjectID &object_id,
+              int timeout_ms,
+              const std::function<void(const char *, size_t)> &reader);
+
   std::vector<std::shared_ptr<msgpack::sbuffer>> GetRaw(const std::vector<ObjectID> &ids,
                                                         int timeout_ms);
 
+  void GetAsyncRaw(
+      const ObjectID &object_id,
+      std::function<void(const char *, size_t, std::exception_ptr)> callback);
+
   std::unique_ptr<CoreWorkerMemoryStore> memory_store_;
 
   LocalModeRayRuntime &local_mode_ray_tuntime_;
@@ -58,6 +58,56 @@ void NativeObjectStore::PutRaw(std::shared_ptr<msgpack::sbuffer> data,
   return;
 }
 
+void NativeObjectStore::PutRaw(size_t size,
+                               const std::function<void(char *)> &writer,
+                               ObjectID *object_id) {
+  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+  std::shared_ptr<Buffer> data;
+  auto status = core_worker.CreateOwnedAndIncrementLocalRef(
+      std::make_shared<::ray::LocalMemoryBuffer>(nullptr, 0),
+      size,
+      {},
+      object_id,
+      &data,
+      /*created_by_worker=*/true);
+  if (!status.ok()) {
+    throw RayException("Put object error: " + status.ToString());
+  }
+  // The object already exists if there is no buffer to write it into.
+  if (data != nullptr) {
+    try {
+      writer(reinterpret_cast<char *>(data->Data()));
+    } catch (...) {
+      core_worker.RemoveLocalReference(*object_id);
+      throw;
+    }
+    status = core_worker.SealOwned(*object_id, /*pin_object=*/true);
+    if (!status.ok()) {
+      throw RayException("Put object error: " + status.ToString());
+    }
+  }
+}
+
+void NativeObjectStore::GetRaw(const ObjectID &object_id,
+                               int timeout_ms,
+                               const std::function<void(const char *, size_t)> &reader) {
+  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+  std::vector<std::shared_ptr<::ray::RayObject>> results;
+  ::ray::Status status = core_worker.Get({object_id}, timeout_ms, &results);
+  if (!status.ok()) {
+    throw RayException("Get object error: " + status.ToString());
+  }
+  RAY_CHECK(results.size() == 1);
+  const auto &meta = results[0]->GetMetadata();
+  const auto &data_buffer = results[0]->GetData();
+  if (meta != nullptr) {
+    std::string meta_str((char *)meta->Data(), meta->Size());
+    CheckException(meta_str, data_buffer);
+  }
+  // The result holds the object in the object store until the reader returns.
+  reader(reinterpret_cast<const char *>(data_buffer->Data()), data_buffer->Size());
+}
+
 std::shared_ptr<msgpack::sbuffer> NativeObjectStore::GetRaw(const ObjectID &object_id,
                                                             int timeout_ms) {
   std::vector<ObjectID> object_ids;
@@ -67,6 +117,37 @@ std::shared_ptr<msgpack::sbuffer> NativeObjectStore::GetRaw(const ObjectID &obje
   return buffers[0];
 }
 
+void NativeObjectStore::GetAsyncRaw(
+    const ObjectID &object_id,
+    std::function<void(const char *, size_t, std::exception_ptr)> callback) {
+  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+  core_worker.GetAsync(
+      object_id,
+      [this, callback = std::move(callback)](
+          std::shared_ptr<::ray::RayObject> result, ObjectID object_id, void *) {
+        const auto &meta = result->GetMetadata();
+        const auto &data_buffer = result->GetData();
+        if (meta != nullptr) {
+          try {
+            std::string meta_str((char *)meta->Data(), meta->Size());
+            CheckException(meta_str, data_buffer);
+          } catch (...) {
+            callback(nullptr, 0, std::current_exception());
+            return;
+          }
+        }
+        if (data_buffer == nullptr) {
+          callback(nullptr, 0, nullptr);
+          return;
+        }
+        // The result holds the object in the object store until the callback returns.
+        callback(reinterpret_cast<const char *>(data_buffer->Data()),
+                 data_buffer->Size(),
+                 nullptr);
+      },
+      nullptr);
+}
+
 void NativeObjectStore::CheckException(const std::string &meta_str,
                                        const std::shared_ptr<Buffer> &data_buffer) {
   std::string data_str =
@@ -39,8 +39,18 @@ class NativeObjectStore : public ObjectStore {
 
   std::shared_ptr<msgpack::sbuffer> GetRaw(const ObjectID &object_id, int timeout_ms);
 
+  void PutRaw(size_t size, const std::function<void(char *)> &writer, ObjectID *object_id);
+
+  void GetRaw(const ObjectID &object_id,
+              int timeout_ms,
+              const std::function<void(const char *, size_t)> &reader);
+
   std::vector<std::shared_ptr<msgpack::sbuffer>> GetRaw(const std::vector<ObjectID> &ids,
                                                         int timeout_ms);
+
+  void GetAsyncRaw(
+      const ObjectID &object_id,
+      std::function<void(const char *, size_t, std::exception_ptr)> callback);
   void CheckException(const std::string &meta_str,
                       const std::shared_ptr<Buffer> &data_buffer);
 };
@@ -33,11 +33,29 @@ void ObjectStore::Put(std::shared_ptr<msgpack::sbuffer> data, const ObjectID &ob
   PutRaw(data, object_id);
 }
 
+void ObjectStore::Put(size_t size,
+                      const std::function<void(char *)> &writer,
+                      ObjectID *object_id) {
+  PutRaw(size, writer, object_id);
+}
+
 std::shared_ptr<msgpack::sbuffer> ObjectStore::Get(const ObjectID &object_id,
                                                    int timeout_ms) {
   return GetRaw(object_id, timeout_ms);
 }
 
+void ObjectStore::Get(const ObjectID &object_id,
+                      int timeout_ms,
+                      const std::function<void(const char *, size_t)> &reader) {
+  GetRaw(object_id, timeout_ms, reader);
+}
+
+void ObjectStore::GetAsync(
+    const ObjectID &object_id,
+    std::function<void(const char *, size_t, std::exception_ptr)> callback) {
+  GetAsyncRaw(object_id, std::move(callback));
+}
+
 std::vector<std::shared_ptr<msgpack::sbuffer>> ObjectStore::Get(
     const std::vector<ObjectID> &ids, int timeout_ms) {
   return GetRaw(ids, timeout_ms);
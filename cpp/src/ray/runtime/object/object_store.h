@@ -16,6 +16,8 @@
 
 #include <ray/api/wait_result.h>
 
+#include <exception>
+#include <functional>
 #include <memory>
 #include <msgpack.hpp>
 
@@ -43,6 +45,14 @@ class ObjectStore {
   /// \param[in] object_id The object which should be stored.
   void Put(std::shared_ptr<msgpack::sbuffer> data, const ObjectID &object_id);
 
+  /// Store an object that is serialized directly into the object store.
+  ///
+  /// \param[in] size The size of the serialized object.
+  /// \param[in] writer Writes the serialized object into the buffer it is passed.
+  /// \param[in,out] object_id The id which is allocated to the object. The local mode
+  /// store uses the id that is passed in.
+  void Put(size_t size, const std::function<void(char *)> &writer, ObjectID *object_id);
+
   /// Get a single object from the object store.
   /// This method will be blocked until the object are ready or wait for timeout.
   ///
@@ -52,6 +62,27 @@ class ObjectStore {
   std::shared_ptr<msgpack::sbuffer> Get(const ObjectID &object_id,
                                         int timeout_ms = default_get_timeout_ms);
 
+  /// Get a single object from the object store, and read it without copying it out.
+  /// This method will be blocked until the object are ready or wait for timeout.
+  ///
+  /// \param[in] object_id The object id which should be got.
+  /// \param[in] timeout_ms The maximum wait time in milliseconds.
+  /// \param[in] reader Called with the object data, which is only valid until it
+  /// returns.
+  void Get(const ObjectID &object_id,
+           int timeout_ms,
+           const std::function<void(const char *, size_t)> &reader);
+
+  /// Get a single object from the object store without blocking, and read it without
+  /// copying it out.
+  ///
+  /// \param[in] object_id The object id which should be got.
+  /// \param[in] callback Called once the object is ready, with the object data, which is
+  /// only valid until it returns, or with the error that getting it failed with. It may
+  /// be called on another thread.
+  void GetAsync(const ObjectID &object_id,
+                std::function<void(const char *, size_t, std::exception_ptr)> callback);
+
   /// Get a list of objects from the object store.
   /// This method will be blocked until all the objects are ready or wait for timeout.
   ///
@@ -98,8 +129,20 @@ class ObjectStore {
   virtual std::shared_ptr<msgpack::sbuffer> GetRaw(const ObjectID &object_id,
                                                    int timeout_ms) = 0;
 
+  virtual void PutRaw(size_t size,
+                      const std::function<void(char *)> &writer,
+                      ObjectID *object_id) = 0;
+
+  virtual void GetRaw(const ObjectID &object_id,
+                      int timeout_ms,
+                      const std::function<void(const char *, size_t)> &reader) = 0;
+
   virtual std::vector<std::shared_ptr<msgpack::sbuffer>> GetRaw(
       const std::vector<ObjectID> &ids, int timeout_ms) = 0;
+
+  virtual void GetAsyncRaw(
+      const ObjectID &object_id,
+      std::function<void(const char *, size_t, std::exception_ptr)> callback) = 0;
 };
 }  // namespace internal
 }  // namespace ray
\ No newline at end of file
@@ -16,8 +16,10 @@
 
 #include <ray/api/ray_exception.h>
 
+#include <algorithm>
 #include <boost/asio/post.hpp>
 #include <memory>
+#include <thread>
 
 #include "../abstract_ray_runtime.h"
 
@@ -27,7 +29,10 @@ namespace internal {
 LocalModeTaskSubmitter::LocalModeTaskSubmitter(
     LocalModeRayRuntime &local_mode_ray_tuntime)
     : local_mode_ray_tuntime_(local_mode_ray_tuntime) {
-  thread_pool_.reset(new boost::asio::thread_pool(10));
+  // Tasks may block on the results of other tasks, so there are at least 10 threads even
+  // on a small machine.
+  thread_pool_.reset(new boost::asio::thread_pool(
+      std::max<size_t>(10, std::thread::hardware_concurrency())));
 }
 
 ObjectID LocalModeTaskSubmitter::Submit(InvocationSpec &invocation,
@@ -37,7 +42,10 @@ ObjectID LocalModeTaskSubmitter::Submit(InvocationSpec &invocation,
   /// Maybe some infomation of TaskSpecification are not reasonable or invalid.
   /// We will enhance this after implement the cluster mode.
   auto functionDescriptor = FunctionDescriptorBuilder::BuildCpp(
-      invocation.remote_function_holder.function_name);
+      invocation.remote_function_holder.function_name,
+      /*caller=*/"",
+      /*class_name=*/"",
+      invocation.remote_function_holder.function_id);
   rpc::Address address;
   std::unordered_map<std::string, double> required_resources;
   std::unordered_map<std::string, double> required_placement_resources;
@@ -27,7 +27,10 @@ using ray::core::TaskOptions;
 RayFunction BuildRayFunction(InvocationSpec &invocation) {
   if (invocation.remote_function_holder.lang_type == LangType::CPP) {
     auto function_descriptor = FunctionDescriptorBuilder::BuildCpp(
-        invocation.remote_function_holder.function_name);
+        invocation.remote_function_holder.function_name,
+        /*caller=*/"",
+        /*class_name=*/"",
+        invocation.remote_function_holder.function_id);
     return RayFunction(ray::Language::CPP, function_descriptor);
   } else if (invocation.remote_function_holder.lang_type == LangType::PYTHON) {
     auto function_descriptor = FunctionDescriptorBuilder::BuildPython(
@@ -51,12 +54,33 @@ static BundleID GetBundleID(const T &options) {
   return bundle_id;
 };
 
-ObjectID NativeTaskSubmitter::Submit(InvocationSpec &invocation,
-                                     const CallOptions &call_options) {
-  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+static TaskOptions BuildTaskOptions(const CallOptions &call_options) {
   TaskOptions options{};
   options.name = call_options.name;
   options.resources = call_options.resources;
+  options.concurrency_group_name = call_options.concurrency_group_name;
+  return options;
+}
+
+static rpc::SchedulingStrategy BuildSchedulingStrategy(const CallOptions &call_options) {
+  BundleID bundle_id = GetBundleID(call_options);
+  rpc::SchedulingStrategy scheduling_strategy;
+  scheduling_strategy.mutable_default_scheduling_strategy();
+  if (!bundle_id.first.IsNil()) {
+    auto placement_group_scheduling_strategy =
+        scheduling_strategy.mutable_placement_group_scheduling_strategy();
+    placement_group_scheduling_strategy->set_placement_group_id(bundle_id.first.Binary());
+    placement_group_scheduling_strategy->set_placement_group_bundle_index(
+        bundle_id.second);
+    placement_group_scheduling_strategy->set_placement_group_capture_child_tasks(false);
+  }
+  return scheduling_strategy;
+}
+
+ObjectID NativeTaskSubmitter::Submit(InvocationSpec &invocation,
+                                     const CallOptions &call_options) {
+  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+  TaskOptions options = BuildTaskOptions(call_options);
   std::optional<std::vector<rpc::ObjectReference>> return_refs;
   if (invocation.task_type == TaskType::ACTOR_TASK) {
     return_refs = core_worker.SubmitActorTask(
@@ -65,24 +89,12 @@ ObjectID NativeTaskSubmitter::Submit(InvocationSpec &invocation,
       return ObjectID::Nil();
     }
   } else {
-    BundleID bundle_id = GetBundleID(call_options);
-    rpc::SchedulingStrategy scheduling_strategy;
-    scheduling_strategy.mutable_default_scheduling_strategy();
-    if (!bundle_id.first.IsNil()) {
-      auto placement_group_scheduling_strategy =
-          scheduling_strategy.mutable_placement_group_scheduling_strategy();
-      placement_group_scheduling_strategy->set_placement_group_id(
-          bundle_id.first.Binary());
-      placement_group_scheduling_strategy->set_placement_group_bundle_index(
-          bundle_id.second);
-      placement_group_scheduling_strategy->set_placement_group_capture_child_tasks(false);
-    }
     return_refs = core_worker.SubmitTask(BuildRayFunction(invocation),
                                          invocation.args,
                                          options,
                                          1,
                                          false,
-                                         scheduling_strategy,
+                                         BuildSchedulingStrategy(call_options),
                                          "");
   }
   std::vector<ObjectID> return_ids;
@@ -97,6 +109,33 @@ ObjectID NativeTaskSubmitter::SubmitTask(InvocationSpec &invocation,
   return Submit(invocation, call_options);
 }
 
+std::vector<ObjectID> NativeTaskSubmitter::SubmitTasks(
+    std::vector<InvocationSpec> &invocations, const CallOptions &call_options) {
+  if (invocations.empty()) {
+    return {};
+  }
+  std::vector<std::vector<std::unique_ptr<::ray::TaskArg>>> args_list;
+  args_list.reserve(invocations.size());
+  for (auto &invocation : invocations) {
+    args_list.push_back(std::move(invocation.args));
+  }
+  // The tasks of a batch share their function, so it's built from the first one.
+  auto &core_worker = CoreWorkerProcess::GetCoreWorker();
+  auto return_refs_list = core_worker.SubmitTasks(BuildRayFunction(invocations[0]),
+                                                  args_list,
+                                                  BuildTaskOptions(call_options),
+                                                  1,
+                                                  false,
+                                                  BuildSchedulingStrategy(call_options),
+                                                  "");
+  std::vector<ObjectID> return_ids;
+  return_ids.reserve(return_refs_list.size());
+  for (const auto &return_refs : return_refs_list) {
+    return_ids.push_back(ObjectID::FromBinary(return_refs[0].object_id()));
+  }
+  return return_ids;
+}
+
 ActorID NativeTaskSubmitter::CreateActor(InvocationSpec &invocation,
                                          const ActorCreationOptions &create_options) {
   auto &core_worker = CoreWorkerProcess::GetCoreWorker();
@@ -114,6 +153,15 @@ ActorID NativeTaskSubmitter::CreateActor(InvocationSpec &invocation,
         bundle_id.second);
     placement_group_scheduling_strategy->set_placement_group_capture_child_tasks(false);
   }
+  std::vector<ConcurrencyGroup> concurrency_groups;
+  for (const auto &[group_name, max_concurrency] : create_options.concurrency_groups) {
+    if (max_concurrency <= 0) {
+      throw RayException("The max concurrency of concurrency group " + group_name +
+                         " must be positive.");
+    }
+    concurrency_groups.emplace_back(
+        group_name, max_concurrency, std::vector<ray::FunctionDescriptor>());
+  }
   ray::core::ActorCreationOptions actor_options{
       create_options.max_restarts,
       /*max_task_retries=*/0,
@@ -125,7 +173,9 @@ ActorID NativeTaskSubmitter::CreateActor(InvocationSpec &invocation,
       name,
       ray_namespace,
       /*is_asyncio=*/false,
-      scheduling_strategy};
+      scheduling_strategy,
+      /*serialized_runtime_env_info=*/"{}",
+      concurrency_groups};
   ActorID actor_id;
   auto status = core_worker.CreateActor(
       BuildRayFunction(invocation), invocation.args, actor_options, "", &actor_id);
@@ -25,6 +25,9 @@ class NativeTaskSubmitter : public TaskSubmitter {
  public:
   ObjectID SubmitTask(InvocationSpec &invocation, const CallOptions &call_options);
 
+  std::vector<ObjectID> SubmitTasks(std::vector<InvocationSpec> &invocations,
+                                    const CallOptions &call_options);
+
   ActorID CreateActor(InvocationSpec &invocation,
                       const ActorCreationOptions &create_options);
 
@@ -17,6 +17,7 @@
 #include <ray/api/common_types.h>
 
 #include <memory>
+#include <optional>
 
 #include "../../util/function_helper.h"
 #include "../abstract_ray_runtime.h"
@@ -86,9 +87,28 @@ std::unique_ptr<ObjectID> TaskExecutor::Execute(InvocationSpec &invocation) {
 /// task id etc.
 std::pair<Status, std::shared_ptr<msgpack::sbuffer>> GetExecuteResult(
     const std::string &func_name,
+    uint64_t function_id,
     const ArgsBufferList &args_buffer,
     msgpack::sbuffer *actor_ptr) {
   try {
+    // Calls from C++ workers carry the function ID, which is looked up without hashing
+    // the name. Fall back to the name if the ID isn't set or isn't known here.
+    if (function_id != 0) {
+      auto &helper = FunctionHelper::GetInstance();
+      std::optional<msgpack::sbuffer> result;
+      if (actor_ptr == nullptr) {
+        if (auto func_ptr = helper.GetFunctionById(function_id)) {
+          result = (*func_ptr)(args_buffer);
+        }
+      } else if (auto func_ptr = helper.GetMemberFunctionById(function_id)) {
+        result = (*func_ptr)(actor_ptr, args_buffer);
+      }
+      if (result) {
+        RAY_LOG(DEBUG) << "Execute function " << func_name << " ok.";
+        return std::make_pair(ray::Status::OK(),
+                              std::make_shared<msgpack::sbuffer>(std::move(*result)));
+      }
+    }
     EntryFuntion entry_function;
     if (actor_ptr == nullptr) {
       entry_function = FunctionHelper::GetInstance().GetExecutableFunctions(func_name);
@@ -144,6 +164,7 @@ Status TaskExecutor::ExecuteTask(
   auto typed_descriptor = function_descriptor->As<ray::CppFunctionDescriptor>();
   std::string func_name = typed_descriptor->FunctionName();
   bool cross_lang = !typed_descriptor->Caller().empty();
+  uint64_t function_id = cross_lang ? 0 : typed_descriptor->FunctionId();
 
   Status status{};
   std::shared_ptr<msgpack::sbuffer> data = nullptr;
@@ -161,7 +182,8 @@ Status TaskExecutor::ExecuteTask(
     ray_args_buffer.push_back(std::move(sbuf));
   }
   if (task_type == ray::TaskType::ACTOR_CREATION_TASK) {
-    std::tie(status, data) = GetExecuteResult(func_name, ray_args_buffer, nullptr);
+    std::tie(status, data) =
+        GetExecuteResult(func_name, function_id, ray_args_buffer, nullptr);
     current_actor_ = data;
   } else if (task_type == ray::TaskType::ACTOR_TASK) {
     if (cross_lang) {
@@ -172,10 +194,11 @@ Status TaskExecutor::ExecuteTask(
                       .append(typed_descriptor->FunctionName());
     }
     RAY_CHECK(current_actor_ != nullptr);
-    std::tie(status, data) =
-        GetExecuteResult(func_name, ray_args_buffer, current_actor_.get());
+    std::tie(status, data) = GetExecuteResult(
+        func_name, function_id, ray_args_buffer, current_actor_.get());
   } else {  // NORMAL_TASK
-    std::tie(status, data) = GetExecuteResult(func_name, ray_args_buffer, nullptr);
+    std::tie(status, data) =
+        GetExecuteResult(func_name, function_id, ray_args_buffer, nullptr);
   }
 
   std::shared_ptr<ray::LocalMemoryBuffer> meta_buffer = nullptr;
@@ -209,6 +232,12 @@ Status TaskExecutor::ExecuteTask(
 
   results->resize(return_ids.size(), nullptr);
   if (task_type != ray::TaskType::ACTOR_CREATION_TASK) {
+    if (cross_lang && meta_buffer == nullptr &&
+        Serializer::IsNumericArray(data->data(), data->size())) {
+      // Other languages can't read the contiguous encoding of the vectors of numbers.
+      data = std::make_shared<msgpack::sbuffer>(
+          Serializer::NumericArrayToMsgpack(data->data(), data->size()));
+    }
     size_t data_size = data->size();
     auto &result_id = return_ids[0];
     auto result_ptr = &(*results)[0];
@@ -279,17 +308,33 @@ void TaskExecutor::Invoke(
 
   auto function_descriptor = task_spec.FunctionDescriptor();
   auto typed_descriptor = function_descriptor->As<ray::CppFunctionDescriptor>();
+  auto &function_manager = FunctionManager::Instance();
+  const uint64_t function_id = typed_descriptor->FunctionId();
 
   std::shared_ptr<msgpack::sbuffer> data;
   try {
     if (actor) {
-      auto result = TaskExecutionHandler(
-          typed_descriptor->FunctionName(), args_buffer, actor.get());
+      auto func_ptr =
+          function_id == 0 ? nullptr : function_manager.GetMemberFunction(function_id);
+      msgpack::sbuffer result;
+      if (func_ptr != nullptr) {
+        result = (*func_ptr)(actor.get(), args_buffer);
+      } else {
+        result = TaskExecutionHandler(
+            typed_descriptor->FunctionName(), args_buffer, actor.get());
+      }
       data = std::make_shared<msgpack::sbuffer>(std::move(result));
       runtime->Put(std::move(data), task_spec.ReturnId(0));
     } else {
-      auto result =
-          TaskExecutionHandler(typed_descriptor->FunctionName(), args_buffer, nullptr);
+      auto func_ptr =
+          function_id == 0 ? nullptr : function_manager.GetFunction(function_id);
+      msgpack::sbuffer result;
+      if (func_ptr != nullptr) {
+        result = (*func_ptr)(args_buffer);
+      } else {
+        result =
+            TaskExecutionHandler(typed_descriptor->FunctionName(), args_buffer, nullptr);
+      }
       data = std::make_shared<msgpack::sbuffer>(std::move(result));
       if (task_spec.IsActorCreationTask()) {
         std::unique_ptr<ActorContext> actorContext(new ActorContext());
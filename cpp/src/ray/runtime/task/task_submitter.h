@@ -17,6 +17,7 @@
 #include <ray/api/ray_runtime.h>
 
 #include <memory>
+#include <vector>
 
 #include "invocation_spec.h"
 
@@ -32,6 +33,17 @@ class TaskSubmitter {
   virtual ObjectID SubmitTask(InvocationSpec &invocation,
                               const CallOptions &call_options) = 0;
 
+  /// Submit the normal tasks of a batch, which share their function and options.
+  virtual std::vector<ObjectID> SubmitTasks(std::vector<InvocationSpec> &invocations,
+                                            const CallOptions &call_options) {
+    std::vector<ObjectID> return_ids;
+    return_ids.reserve(invocations.size());
+    for (auto &invocation : invocations) {
+      return_ids.push_back(SubmitTask(invocation, call_options));
+    }
+    return return_ids;
+  }
+
   virtual ActorID CreateActor(InvocationSpec &invocation,
                               const ActorCreationOptions &create_options) = 0;
 
@@ -172,6 +172,28 @@ TEST(RayApiTest, StaticGetTest) {
   EXPECT_EQ(200, *res2);
 }
 
+TEST(RayApiTest, GetAsyncTest) {
+  ray::RayConfig config;
+  config.local_mode = true;
+  ray::Init(config);
+
+  auto obj_ref1 = ray::Put(100);
+  auto obj_ref2 = ray::Put(200);
+  EXPECT_EQ(100, *ray::GetAsync(obj_ref1).get());
+
+  std::vector<ray::ObjectRef<int>> obj_refs{obj_ref1, obj_ref2};
+  auto results = ray::GetAsync(obj_refs).get();
+  EXPECT_EQ(results.size(), 2);
+  EXPECT_EQ(100, *results[0]);
+  EXPECT_EQ(200, *results[1]);
+
+  // The future is ready once the task returns.
+  auto r = ray::Task(Plus1).Remote(1);
+  EXPECT_EQ(2, *ray::GetAsync(r).get());
+
+  EXPECT_TRUE(ray::GetAsync(std::vector<ray::ObjectRef<int>>()).get().empty());
+}
+
 TEST(RayApiTest, WaitTest) {
   ray::RayConfig config;
   config.local_mode = true;
@@ -229,6 +251,23 @@ TEST(RayApiTest, CallWithValueTest) {
   EXPECT_EQ(result3, 6);
 }
 
+TEST(RayApiTest, CallBatchTest) {
+  auto r1 = ray::Task(Plus1).RemoteBatch(std::vector<int>{1, 2, 3});
+  auto r0 = ray::Task(Return1).Remote();
+  auto r2 = ray::Task(Plus).RemoteBatch(
+      std::vector<std::tuple<ray::ObjectRef<int>, int>>{{r0, 1}, {r0, 2}});
+  auto empty = ray::Task(Plus1).RemoteBatch(std::vector<int>{});
+
+  ASSERT_EQ(r1.size(), 3);
+  EXPECT_EQ(*r1[0].Get(), 2);
+  EXPECT_EQ(*r1[1].Get(), 3);
+  EXPECT_EQ(*r1[2].Get(), 4);
+  ASSERT_EQ(r2.size(), 2);
+  EXPECT_EQ(*r2[0].Get(), 2);
+  EXPECT_EQ(*r2[1].Get(), 3);
+  EXPECT_TRUE(empty.empty());
+}
+
 TEST(RayApiTest, CallWithObjectTest) {
   auto rt0 = ray::Task(Return1).Remote();
   auto rt1 = ray::Task(Plus1).Remote(rt0);
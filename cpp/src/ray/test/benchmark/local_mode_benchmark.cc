@@ -0,0 +1,112 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ray/api.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+int Plus1(int x) { return x + 1; }
+
+RAY_REMOTE(Plus1);
+
+class Counter {
+ public:
+  static Counter *FactoryCreate() { return new Counter(); }
+
+  int Add(int x) {
+    count_ += x;
+    return count_;
+  }
+
+ private:
+  int count_ = 0;
+};
+
+RAY_REMOTE(Counter::FactoryCreate, &Counter::Add);
+
+/// The runtime is shared by all of the benchmarks, so that they only measure the
+/// overhead of the calls.
+void InitLocalMode() {
+  if (!ray::IsInitialized()) {
+    ray::RayConfig config;
+    config.local_mode = true;
+    ray::Init(config);
+  }
+}
+
+void BM_PutAndGet(benchmark::State &state) {
+  InitLocalMode();
+  std::vector<double> object(state.range(0) / sizeof(double));
+  for (auto _ : state) {
+    auto ref = ray::Put(object);
+    benchmark::DoNotOptimize(ray::Get(ref));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PutAndGet)->Arg(64)->Arg(64 << 10)->Arg(16 << 20);
+
+void BM_TaskRoundTrip(benchmark::State &state) {
+  InitLocalMode();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(*ray::Task(Plus1).Remote(1).Get());
+  }
+}
+
+BENCHMARK(BM_TaskRoundTrip);
+
+void BM_TaskBatch(benchmark::State &state) {
+  InitLocalMode();
+  std::vector<ray::ObjectRef<int>> refs;
+  for (auto _ : state) {
+    refs.clear();
+    for (int64_t i = 0; i < state.range(0); i++) {
+      refs.push_back(ray::Task(Plus1).Remote(1));
+    }
+    benchmark::DoNotOptimize(ray::Get(refs));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TaskBatch)->Arg(100)->Arg(1000);
+
+void BM_TaskChain(benchmark::State &state) {
+  InitLocalMode();
+  for (auto _ : state) {
+    auto ref = ray::Task(Plus1).Remote(0);
+    for (int64_t i = 1; i < state.range(0); i++) {
+      ref = ray::Task(Plus1).Remote(ref);
+    }
+    benchmark::DoNotOptimize(*ref.Get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TaskChain)->Arg(100);
+
+void BM_ActorCall(benchmark::State &state) {
+  InitLocalMode();
+  auto actor = ray::Actor(Counter::FactoryCreate).Remote();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(*actor.Task(&Counter::Add).Remote(1).Get());
+  }
+}
+
+BENCHMARK(BM_ActorCall);
+
+}  // namespace
@@ -264,6 +264,27 @@ TEST(RayClusterModeTest, MaxConcurrentTest) {
   EXPECT_EQ(*object3.Get(), "ok");
 }
 
+TEST(RayClusterModeTest, ConcurrencyGroupTest) {
+  // The default group runs one task at a time, so the tasks only finish if they run
+  // concurrently in their own group.
+  auto actor1 = ray::Actor(ActorConcurrentCall::FactoryCreate)
+                    .SetConcurrencyGroup("count_down", 3)
+                    .Remote();
+  auto object1 = actor1.Task(&ActorConcurrentCall::CountDown)
+                     .SetConcurrencyGroup("count_down")
+                     .Remote();
+  auto object2 = actor1.Task(&ActorConcurrentCall::CountDown)
+                     .SetConcurrencyGroup("count_down")
+                     .Remote();
+  auto object3 = actor1.Task(&ActorConcurrentCall::CountDown)
+                     .SetConcurrencyGroup("count_down")
+                     .Remote();
+
+  EXPECT_EQ(*object1.Get(), "ok");
+  EXPECT_EQ(*object2.Get(), "ok");
+  EXPECT_EQ(*object3.Get(), "ok");
+}
+
 TEST(RayClusterModeTest, ResourcesManagementTest) {
   auto actor1 =
       ray::Actor(RAY_FUNC(Counter::FactoryCreate)).SetResources({{"CPU", 1.0}}).Remote();
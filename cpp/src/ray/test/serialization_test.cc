@@ -40,4 +40,48 @@ TEST(SerializationTest, TypeHybridTest) {
 
   EXPECT_EQ(in_arg1, out_arg1);
   EXPECT_EQ(in_arg2, out_arg2);
-}
\ No newline at end of file
+}
+TEST(SerializationTest, SerializeToTest) {
+  std::vector<float> in_arg(1000, 1.5f);
+  auto expected = ray::internal::Serializer::Serialize(in_arg);
+
+  size_t size = ray::internal::Serializer::SerializedSize(in_arg);
+  EXPECT_EQ(size, expected.size());
+  std::vector<char> buffer(size);
+  ray::internal::Serializer::SerializeTo(in_arg, buffer.data(), buffer.size());
+  EXPECT_EQ(std::string(buffer.data(), size), std::string(expected.data(), size));
+
+  auto out_arg = ray::internal::Serializer::Deserialize<std::vector<float>>(
+      buffer.data(), buffer.size());
+  EXPECT_EQ(in_arg, out_arg);
+
+  // A buffer that is too small is not overrun.
+  EXPECT_THROW(
+      ray::internal::Serializer::SerializeTo(in_arg, buffer.data(), buffer.size() - 1),
+      ray::internal::RayException);
+}
+
+TEST(SerializationTest, NumericVectorTest) {
+  std::vector<double> in_arg{1.5, -2.25, 1e300};
+  auto buffer = ray::internal::Serializer::Serialize(in_arg);
+  EXPECT_TRUE(ray::internal::Serializer::IsNumericArray(buffer.data(), buffer.size()));
+  EXPECT_FALSE(ray::internal::Serializer::HasError(buffer.data(), buffer.size()));
+  EXPECT_EQ(buffer.size(), 8 + in_arg.size() * sizeof(double));
+  auto out_arg = ray::internal::Serializer::Deserialize<std::vector<double>>(
+      buffer.data(), buffer.size());
+  EXPECT_EQ(in_arg, out_arg);
+
+  // The vectors that are packed by msgpack, e.g. by other languages, are still read.
+  auto msgpack_buffer = ray::internal::Serializer::NumericArrayToMsgpack(buffer.data(),
+                                                                        buffer.size());
+  EXPECT_FALSE(ray::internal::Serializer::IsNumericArray(msgpack_buffer.data(),
+                                                         msgpack_buffer.size()));
+  out_arg = ray::internal::Serializer::Deserialize<std::vector<double>>(
+      msgpack_buffer.data(), msgpack_buffer.size());
+  EXPECT_EQ(in_arg, out_arg);
+
+  // The type of the elements is checked.
+  EXPECT_THROW(ray::internal::Serializer::Deserialize<std::vector<int64_t>>(
+                   buffer.data(), buffer.size()),
+               msgpack::type_error);
+}
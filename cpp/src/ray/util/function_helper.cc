@@ -102,10 +102,12 @@ std::string FunctionHelper::LoadAllRemoteFunctions(const std::string lib_path,
   for (const auto &pair : function_maps.first) {
     names_str.append(pair.first).append(", ");
     remote_funcs_.emplace(pair.first, entry_function);
+    remote_funcs_by_id_.emplace(GetFunctionId(pair.first), &pair.second);
   }
   for (const auto &pair : function_maps.second) {
     names_str.append(pair.first).append(", ");
     remote_member_funcs_.emplace(pair.first, entry_function);
+    remote_member_funcs_by_id_.emplace(GetFunctionId(pair.first), &pair.second);
   }
   if (!names_str.empty()) {
     names_str.pop_back();
@@ -175,5 +177,16 @@ const EntryFuntion &FunctionHelper::GetExecutableMemberFunctions(
   }
 }
 
+const RemoteFunction *FunctionHelper::GetFunctionById(uint64_t function_id) {
+  auto it = remote_funcs_by_id_.find(function_id);
+  return it == remote_funcs_by_id_.end() ? nullptr : it->second;
+}
+
+const RemoteMemberFunction *FunctionHelper::GetMemberFunctionById(
+    uint64_t function_id) {
+  auto it = remote_member_funcs_by_id_.find(function_id);
+  return it == remote_member_funcs_by_id_.end() ? nullptr : it->second;
+}
+
 }  // namespace internal
 }  // namespace ray
\ No newline at end of file
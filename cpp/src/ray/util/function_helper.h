@@ -45,6 +45,10 @@ class FunctionHelper {
   void LoadFunctionsFromPaths(const std::vector<std::string> &paths);
   const EntryFuntion &GetExecutableFunctions(const std::string &function_name);
   const EntryFuntion &GetExecutableMemberFunctions(const std::string &function_name);
+  /// Return the function with an ID computed by `GetFunctionId`, or nullptr if no
+  /// loaded library registered it.
+  const RemoteFunction *GetFunctionById(uint64_t function_id);
+  const RemoteMemberFunction *GetMemberFunctionById(uint64_t function_id);
 
  private:
   FunctionHelper() = default;
@@ -59,6 +63,10 @@ class FunctionHelper {
   std::unordered_map<std::string, EntryFuntion> remote_funcs_;
   // Map from remote member function name to executable entry function.
   std::unordered_map<std::string, EntryFuntion> remote_member_funcs_;
+  // Map from function ID to the remote function registered in a loaded library.
+  std::unordered_map<uint64_t, const RemoteFunction *> remote_funcs_by_id_;
+  // Map from function ID to the remote member function registered in a loaded library.
+  std::unordered_map<uint64_t, const RemoteMemberFunction *> remote_member_funcs_by_id_;
 };
 }  // namespace internal
 }  // namespace ray
\ No newline at end of file
@@ -25,6 +25,7 @@ from ray._private.async_compat import create_task
 from ray._private.runtime_env.pip import PipManager
 from ray._private.runtime_env.conda import CondaManager
 from ray._private.runtime_env.context import RuntimeEnvContext
+from ray._private.runtime_env.packaging import PackagePeers
 from ray._private.runtime_env.py_modules import PyModulesManager
 from ray._private.runtime_env.working_dir import WorkingDirManager
 from ray._private.runtime_env.container import ContainerManager
@@ -183,8 +184,19 @@ class RuntimeEnvAgent(
 
         self._pip_manager = PipManager(self._runtime_env_dir)
         self._conda_manager = CondaManager(self._runtime_env_dir)
-        self._py_modules_manager = PyModulesManager(self._runtime_env_dir)
-        self._working_dir_manager = WorkingDirManager(self._runtime_env_dir)
+        # Let the nodes fetch the GCS packages from each other, which needs the
+        # grpc server of the agent.
+        package_peers = None
+        if runtime_env_consts.RUNTIME_ENV_PEER_FETCH and dashboard_agent.grpc_port:
+            package_peers = PackagePeers(
+                f"{dashboard_agent.ip}:{dashboard_agent.grpc_port}"
+            )
+        self._py_modules_manager = PyModulesManager(
+            self._runtime_env_dir, package_peers
+        )
+        self._working_dir_manager = WorkingDirManager(
+            self._runtime_env_dir, package_peers
+        )
         self._container_manager = ContainerManager(dashboard_agent.temp_dir)
 
         self._reference_table = ReferenceTable(
@@ -538,6 +550,34 @@ class RuntimeEnvAgent(
             status=agent_manager_pb2.AGENT_RPC_STATUS_OK
         )
 
+    async def GetRuntimeEnvPackage(self, request, context):
+        def _read():
+            for manager in [self._working_dir_manager, self._py_modules_manager]:
+                package = manager.read_package(request.uri)
+                if package is not None:
+                    return package
+            return None
+
+        loop = asyncio.get_event_loop()
+        try:
+            package = await loop.run_in_executor(None, _read)
+        except Exception as e:
+            self._logger.exception(f"Failed to read package {request.uri}")
+            return runtime_env_agent_pb2.GetRuntimeEnvPackageReply(
+                status=agent_manager_pb2.AGENT_RPC_STATUS_FAILED,
+                error_message="".join(
+                    traceback.format_exception(type(e), e, e.__traceback__)
+                ),
+            )
+        if package is None:
+            return runtime_env_agent_pb2.GetRuntimeEnvPackageReply(
+                status=agent_manager_pb2.AGENT_RPC_STATUS_FAILED,
+                error_message=f"Package {request.uri} isn't on this node.",
+            )
+        return runtime_env_agent_pb2.GetRuntimeEnvPackageReply(
+            status=agent_manager_pb2.AGENT_RPC_STATUS_OK, package=package
+        )
+
     async def run(self, server):
         if server:
             runtime_env_agent_pb2_grpc.add_RuntimeEnvServiceServicer_to_server(
@@ -5,3 +5,7 @@ RUNTIME_ENV_RETRY_TIMES = ray_constants.env_integer("RUNTIME_ENV_RETRY_TIMES", 3
 RUNTIME_ENV_RETRY_INTERVAL_MS = ray_constants.env_integer(
     "RUNTIME_ENV_RETRY_INTERVAL_MS", 1000
 )
+
+# Whether the nodes fetch the working_dir and py_modules packages from the other
+# nodes that already downloaded them, rather than all from the GCS.
+RUNTIME_ENV_PEER_FETCH = ray_constants.env_bool("RUNTIME_ENV_PEER_FETCH", False)
@@ -6,7 +6,6 @@ import io.ray.api.ObjectRef;
 import io.ray.api.Ray;
 import io.ray.api.id.ObjectId;
 import io.ray.runtime.RayRuntimeInternal;
-import io.ray.runtime.generated.Common.Address;
 import io.ray.runtime.generated.Common.Language;
 import io.ray.runtime.object.NativeRayObject;
 import io.ray.runtime.object.ObjectRefImpl;
@@ -36,12 +35,10 @@ public class ArgumentsBuilder {
     List<FunctionArg> ret = new ArrayList<>();
     for (Object arg : args) {
       ObjectId id = null;
-      Address address = null;
       NativeRayObject value = null;
       if (arg instanceof ObjectRef) {
         Preconditions.checkState(arg instanceof ObjectRefImpl);
         id = ((ObjectRefImpl<?>) arg).getId();
-        address = ((RayRuntimeInternal) Ray.internal()).getObjectStore().getOwnerAddress(id);
       } else {
         value = ObjectSerializer.serialize(arg);
         if (language != Language.JAVA) {
@@ -61,7 +58,6 @@ public class ArgumentsBuilder {
         }
         if (value.data.length > LARGEST_SIZE_PASS_BY_VALUE) {
           id = ((RayRuntimeInternal) Ray.internal()).getObjectStore().putRaw(value);
-          address = ((RayRuntimeInternal) Ray.internal()).getWorkerContext().getRpcAddress();
           value = null;
         }
       }
@@ -69,7 +65,8 @@ public class ArgumentsBuilder {
         ret.add(FunctionArg.passByValue(PYTHON_DUMMY_TYPE));
       }
       if (id != null) {
-        ret.add(FunctionArg.passByReference(id, address));
+        // The owner address is looked up by the core worker on submission.
+        ret.add(FunctionArg.passByReference(id));
       } else {
         ret.add(FunctionArg.passByValue(value));
       }
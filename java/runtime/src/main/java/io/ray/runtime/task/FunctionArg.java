@@ -14,7 +14,10 @@ public class FunctionArg {
   /** The id of this argument (passed by reference). */
   public final ObjectId id;
 
-  /** The owner address of this argument (passed by reference). */
+  /**
+   * The owner address of this argument (passed by reference). If null, the owner is looked up by
+   * the core worker when the task is submitted.
+   */
   public final Address ownerAddress;
 
   /** Serialized data of this argument (passed by value). */
@@ -22,7 +25,6 @@ public class FunctionArg {
 
   private FunctionArg(ObjectId id, Address ownerAddress) {
     Preconditions.checkNotNull(id);
-    Preconditions.checkNotNull(ownerAddress);
     this.id = id;
     this.ownerAddress = ownerAddress;
     this.value = null;
@@ -40,6 +42,14 @@ public class FunctionArg {
     return new FunctionArg(id, ownerAddress);
   }
 
+  /**
+   * Create a FunctionArg that will be passed by reference, whose owner is known to the core
+   * worker. This saves converting the owner address between Java and C++.
+   */
+  public static FunctionArg passByReference(ObjectId id) {
+    return new FunctionArg(id, null);
+  }
+
   /** Create a FunctionArg that will be passed by value. */
   public static FunctionArg passByValue(NativeRayObject value) {
     return new FunctionArg(value);
@@ -5,6 +5,7 @@ import hashlib
 import logging
 import os
 from pathlib import Path
+import random
 import shutil
 from typing import Callable, List, Optional, Tuple
 from urllib.parse import urlparse
@@ -13,6 +14,8 @@ from ray.experimental.internal_kv import (
     _internal_kv_put,
     _internal_kv_get,
     _internal_kv_exists,
+    _internal_kv_del,
+    _internal_kv_list,
 )
 from ray._private.thirdparty.pathspec import PathSpec
 
@@ -24,6 +27,8 @@ FILE_SIZE_WARNING = 10 * 1024 * 1024  # 10MiB
 # limit, but for some reason that causes failures when downloading.
 GCS_STORAGE_MAX_SIZE = 100 * 1024 * 1024  # 100MiB
 RAY_PKG_PREFIX = "_ray_pkg_"
+# The prefix of the internal KV keys of the nodes that keep a GCS package.
+PACKAGE_PEER_PREFIX = "runtime_env_package_peer:"
 
 
 def _mib_string(num_bytes: float) -> str:
@@ -273,6 +278,105 @@ def _get_local_path(base_directory: str, pkg_uri: str) -> str:
     return os.path.join(base_directory, pkg_name)
 
 
+class PackagePeers:
+    """Fetches GCS packages from the nodes that already downloaded them.
+
+    Each node registers the GCS packages it keeps in the internal KV, under the
+    address of its runtime env agent. A node downloading a package asks a few of
+    these nodes for it before falling back to the GCS, so that the head node isn't
+    the only source of a package when many nodes start a job at once.
+    """
+
+    def __init__(
+        self,
+        address: str,
+        max_peers_to_try: int = 3,
+        timeout_s: float = 60,
+    ):
+        """
+        Args:
+            address: The address of the runtime env agent of this node.
+            max_peers_to_try: The number of nodes to ask for a package before
+                falling back to the GCS.
+            timeout_s: The timeout of a request to another node.
+        """
+        self._address = address
+        self._max_peers_to_try = max_peers_to_try
+        self._timeout_s = timeout_s
+
+    @staticmethod
+    def _key_prefix(pkg_uri: str) -> str:
+        return f"{PACKAGE_PEER_PREFIX}{pkg_uri}|"
+
+    def register(self, pkg_uri: str):
+        """Let the other nodes fetch a package from this node."""
+        _internal_kv_put(self._key_prefix(pkg_uri) + self._address, b"")
+
+    def unregister(self, pkg_uri: str):
+        _internal_kv_del(self._key_prefix(pkg_uri) + self._address)
+
+    def fetch(
+        self, pkg_uri: str, logger: Optional[logging.Logger] = default_logger
+    ) -> Optional[bytes]:
+        """Fetch a package from the other nodes that keep it.
+
+        Returns:
+            The package, or None if no node could send it.
+        """
+        import ray._private.utils
+        from ray import ray_constants
+        from ray.core.generated import agent_manager_pb2
+        from ray.core.generated import runtime_env_agent_pb2
+        from ray.core.generated import runtime_env_agent_pb2_grpc
+
+        prefix = self._key_prefix(pkg_uri)
+        addresses = [
+            key.decode()[len(prefix) :] for key in _internal_kv_list(prefix)
+        ]
+        addresses = [address for address in addresses if address != self._address]
+        random.shuffle(addresses)
+        for address in addresses[: self._max_peers_to_try]:
+            try:
+                channel = ray._private.utils.init_grpc_channel(
+                    address,
+                    options=[
+                        (
+                            "grpc.max_receive_message_length",
+                            ray_constants.GRPC_CPP_MAX_MESSAGE_SIZE,
+                        )
+                    ],
+                )
+                stub = runtime_env_agent_pb2_grpc.RuntimeEnvServiceStub(channel)
+                reply = stub.GetRuntimeEnvPackage(
+                    runtime_env_agent_pb2.GetRuntimeEnvPackageRequest(uri=pkg_uri),
+                    timeout=self._timeout_s,
+                )
+                channel.close()
+            except Exception as e:
+                logger.debug(f"Failed to fetch {pkg_uri} from {address}: {e}")
+                continue
+            if reply.status == agent_manager_pb2.AGENT_RPC_STATUS_OK:
+                logger.info(f"Fetched {pkg_uri} from the node at {address}.")
+                return reply.package
+            logger.debug(
+                f"Failed to fetch {pkg_uri} from {address}: {reply.error_message}"
+            )
+        return None
+
+
+def read_package(pkg_uri: str, base_directory: str) -> Optional[bytes]:
+    """Read a GCS package that was kept when it was downloaded.
+
+    Returns:
+        The package, or None if it wasn't kept.
+    """
+    pkg_file = Path(_get_local_path(base_directory, pkg_uri))
+    with FileLock(str(pkg_file) + ".lock"):
+        if not pkg_file.is_file():
+            return None
+        return pkg_file.read_bytes()
+
+
 def _zip_directory(
     directory: str,
     excludes: List[str],
@@ -480,11 +584,16 @@ def download_and_unpack_package(
     pkg_uri: str,
     base_directory: str,
     logger: Optional[logging.Logger] = default_logger,
+    package_peers: Optional[PackagePeers] = None,
 ) -> str:
     """Download the package corresponding to this URI and unpack it if zipped.
 
     Will be written to a file or directory named {base_directory}/{uri}.
     Returns the path to this file or directory.
+
+    If package_peers is given, a GCS package is fetched from the other nodes that
+    keep it if possible, and a zipped GCS package is kept next to its directory so
+    that the other nodes can fetch it from this node.
     """
     pkg_file = Path(_get_local_path(base_directory, pkg_uri))
     with FileLock(str(pkg_file) + ".lock"):
@@ -500,8 +609,12 @@ def download_and_unpack_package(
         else:
             protocol, pkg_name = parse_uri(pkg_uri)
             if protocol == Protocol.GCS:
-                # Download package from the GCS.
-                code = _internal_kv_get(pkg_uri)
+                code = None
+                if package_peers is not None and is_zip_uri(pkg_uri):
+                    code = package_peers.fetch(pkg_uri, logger=logger)
+                if code is None:
+                    # Download package from the GCS.
+                    code = _internal_kv_get(pkg_uri)
                 if code is None:
                     raise IOError(f"Failed to fetch URI {pkg_uri} from GCS.")
                 code = code or b""
@@ -512,9 +625,11 @@ def download_and_unpack_package(
                         package_path=pkg_file,
                         target_dir=local_dir,
                         remove_top_level_directory=False,
-                        unlink_zip=True,
+                        unlink_zip=package_peers is None,
                         logger=logger,
                     )
+                    if package_peers is not None:
+                        package_peers.register(pkg_uri)
                 else:
                     return str(pkg_file)
             elif protocol in Protocol.remote_protocols():
@@ -662,11 +777,17 @@ def unzip_package(
         Path(package_path).unlink()
 
 
-def delete_package(pkg_uri: str, base_directory: str) -> Tuple[bool, int]:
+def delete_package(
+    pkg_uri: str,
+    base_directory: str,
+    package_peers: Optional[PackagePeers] = None,
+) -> Tuple[bool, int]:
     """Deletes a specific URI from the local filesystem.
 
     Args:
         pkg_uri (str): URI to delete.
+        package_peers: If given, the other nodes stop fetching the package from
+            this node.
 
     Returns:
         bool: True if the URI was successfully deleted, else False.
@@ -675,6 +796,11 @@ def delete_package(pkg_uri: str, base_directory: str) -> Tuple[bool, int]:
     deleted = False
     path = Path(_get_local_path(base_directory, pkg_uri))
     with FileLock(str(path) + ".lock"):
+        if package_peers is not None:
+            package_peers.unregister(pkg_uri)
+        # The package may have been kept for the other nodes.
+        if path.is_file():
+            path.unlink()
         path = path.with_suffix("")
         if path.exists():
             if path.is_dir() and not path.is_symlink():
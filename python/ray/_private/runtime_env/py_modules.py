@@ -10,6 +10,8 @@ from ray._private.runtime_env.conda_utils import exec_cmd_stream_to_logger
 from ray._private.runtime_env.context import RuntimeEnvContext
 from ray._private.runtime_env.packaging import (
     download_and_unpack_package,
+    read_package,
+    PackagePeers,
     delete_package,
     get_local_dir_from_uri,
     get_uri_for_directory,
@@ -126,8 +128,11 @@ def upload_py_modules_if_needed(
 
 
 class PyModulesManager:
-    def __init__(self, resources_dir: str):
+    def __init__(
+        self, resources_dir: str, package_peers: Optional[PackagePeers] = None
+    ):
         self._resources_dir = os.path.join(resources_dir, "py_modules_files")
+        self._package_peers = package_peers
         try_to_create_directory(self._resources_dir)
         assert _internal_kv_initialized()
 
@@ -141,13 +146,17 @@ class PyModulesManager:
         local_dir = get_local_dir_from_uri(uri, self._resources_dir)
         local_dir_size = get_directory_size_bytes(local_dir)
 
-        deleted = delete_package(uri, self._resources_dir)
+        deleted = delete_package(uri, self._resources_dir, self._package_peers)
         if not deleted:
             logger.warning(f"Tried to delete nonexistent URI: {uri}.")
             return 0
 
         return local_dir_size
 
+    def read_package(self, uri: str) -> Optional[bytes]:
+        """Read a package kept for the other nodes, or return None."""
+        return read_package(uri, self._resources_dir)
+
     def get_uris(self, runtime_env: dict) -> Optional[List[str]]:
         return runtime_env.py_modules()
 
@@ -201,7 +210,10 @@ class PyModulesManager:
 
             else:
                 module_dir = download_and_unpack_package(
-                    uri, self._resources_dir, logger=logger
+                    uri,
+                    self._resources_dir,
+                    logger=logger,
+                    package_peers=self._package_peers,
                 )
 
             return get_directory_size_bytes(module_dir)
@@ -8,6 +8,8 @@ from ray.experimental.internal_kv import _internal_kv_initialized
 from ray._private.runtime_env.context import RuntimeEnvContext
 from ray._private.runtime_env.packaging import (
     download_and_unpack_package,
+    read_package,
+    PackagePeers,
     delete_package,
     get_local_dir_from_uri,
     get_uri_for_directory,
@@ -104,8 +106,11 @@ def set_pythonpath_in_context(python_path: str, context: RuntimeEnvContext):
 
 
 class WorkingDirManager:
-    def __init__(self, resources_dir: str):
+    def __init__(
+        self, resources_dir: str, package_peers: Optional[PackagePeers] = None
+    ):
         self._resources_dir = os.path.join(resources_dir, "working_dir_files")
+        self._package_peers = package_peers
         try_to_create_directory(self._resources_dir)
         assert _internal_kv_initialized()
 
@@ -116,13 +121,17 @@ class WorkingDirManager:
         local_dir = get_local_dir_from_uri(uri, self._resources_dir)
         local_dir_size = get_directory_size_bytes(local_dir)
 
-        deleted = delete_package(uri, self._resources_dir)
+        deleted = delete_package(uri, self._resources_dir, self._package_peers)
         if not deleted:
             logger.warning(f"Tried to delete nonexistent URI: {uri}.")
             return 0
 
         return local_dir_size
 
+    def read_package(self, uri: str) -> Optional[bytes]:
+        """Read a package kept for the other nodes, or return None."""
+        return read_package(uri, self._resources_dir)
+
     def get_uri(self, runtime_env: "RuntimeEnv") -> Optional[str]:  # noqa: F821
         working_dir_uri = runtime_env.working_dir()
         if working_dir_uri != "":
@@ -142,7 +151,10 @@ class WorkingDirManager:
         # make this method running in current loop.
         def _create():
             local_dir = download_and_unpack_package(
-                uri, self._resources_dir, logger=logger
+                uri,
+                self._resources_dir,
+                logger=logger,
+                package_peers=self._package_peers,
             )
             return get_directory_size_bytes(local_dir)
 
@@ -7,7 +7,9 @@
 from cpython.exc cimport PyErr_CheckSignals
 
 import asyncio
+import collections
 import gc
+import hashlib
 import inspect
 import logging
 import msgpack
@@ -156,6 +158,10 @@ OPTIMIZED = __OPTIMIZE__
 
 logger = logging.getLogger(__name__)
 
+# The number of distinct large task arguments that a worker remembers, to pass
+# them by reference once they are seen again.
+MAX_REPEATED_ARG_REFS = 128
+
 cdef int check_status(const CRayStatus& status) nogil except -1:
     if status.ok():
         return 0
@@ -389,6 +395,7 @@ cdef prepare_args_internal(
         size_t size
         int64_t put_threshold
         int64_t rpc_inline_threshold
+        int64_t dedup_threshold
         int64_t total_inlined
         shared_ptr[CBuffer] arg_data
         c_vector[CObjectID] inlined_ids
@@ -399,6 +406,7 @@ cdef prepare_args_internal(
     put_threshold = RayConfig.instance().max_direct_call_object_size()
     total_inlined = 0
     rpc_inline_threshold = RayConfig.instance().task_rpc_inlined_bytes_limit()
+    dedup_threshold = RayConfig.instance().task_arg_dedup_min_bytes()
     for arg in args:
         if isinstance(arg, ObjectRef):
             c_arg = (<ObjectRef>arg).native()
@@ -447,15 +455,27 @@ cdef prepare_args_internal(
                         Buffer.make(arg_data))
                 for object_ref in serialized_arg.contained_object_refs:
                     inlined_ids.push_back((<ObjectRef>object_ref).native())
-                inlined_refs = (CCoreWorkerProcess.GetCoreWorker()
-                                .GetObjectRefs(inlined_ids))
-                args_vector.push_back(
-                    unique_ptr[CTaskArg](new CTaskArgByValue(
-                        make_shared[CRayObject](
-                            arg_data, string_to_buffer(metadata),
-                            inlined_refs))))
+                repeated_arg_ref = None
+                if (dedup_threshold > 0 and <int64_t>size >= dedup_threshold
+                        and inlined_ids.empty()):
+                    repeated_arg_ref = core_worker.get_repeated_arg_ref(
+                        serialized_arg, metadata, Buffer.make(arg_data))
+                if repeated_arg_ref is not None:
+                    args_vector.push_back(unique_ptr[CTaskArg](
+                        new CTaskArgByReference(
+                            (<ObjectRef>repeated_arg_ref).native(),
+                            CCoreWorkerProcess.GetCoreWorker().GetRpcAddress(),
+                            put_arg_call_site)))
+                else:
+                    inlined_refs = (CCoreWorkerProcess.GetCoreWorker()
+                                    .GetObjectRefs(inlined_ids))
+                    args_vector.push_back(
+                        unique_ptr[CTaskArg](new CTaskArgByValue(
+                            make_shared[CRayObject](
+                                arg_data, string_to_buffer(metadata),
+                                inlined_refs))))
+                    total_inlined += <int64_t>size
                 inlined_ids.clear()
-                total_inlined += <int64_t>size
             else:
                 put_id = CObjectID.FromBinary(
                         core_worker.put_serialized_object_and_increment_local_ref(
@@ -1129,6 +1149,7 @@ cdef class CoreWorker:
         self.cgname_to_eventloop_dict = None
         self.fd_to_cgname_dict = None
         self.eventloop_for_default_cg = None
+        self.repeated_arg_refs = collections.OrderedDict()
 
     def shutdown(self):
         with nogil:
@@ -1331,6 +1352,38 @@ cdef class CoreWorker:
                             c_object_id, pin_object=False,
                             owner_address=c_owner_address))
 
+    def get_repeated_arg_ref(self, serialized_arg, metadata, data):
+        """Get a reference to the put copy of an argument value that was
+        already passed to a task by value.
+
+        The first time a value is seen, it is remembered by the hash of its
+        serialized bytes and None is returned, to inline it. From the second
+        time on, the value is put once and the reference to it is returned.
+
+        Args:
+            serialized_arg: The serialized argument.
+            metadata(bytes): The metadata of the serialized argument.
+            data: The serialized bytes of the argument.
+
+        Returns:
+            The ObjectRef to pass the argument by, or None to inline it.
+        """
+        key = (metadata, hashlib.sha256(data).digest())
+        if key not in self.repeated_arg_refs:
+            self.repeated_arg_refs[key] = None
+            if len(self.repeated_arg_refs) > MAX_REPEATED_ARG_REFS:
+                self.repeated_arg_refs.popitem(last=False)
+            return None
+        self.repeated_arg_refs.move_to_end(key)
+        object_ref = self.repeated_arg_refs[key]
+        if object_ref is None:
+            object_ref = ObjectRef(
+                self.put_serialized_object_and_increment_local_ref(
+                    serialized_arg, inline_small_object=False),
+                skip_adding_local_ref=True)
+            self.repeated_arg_refs[key] = object_ref
+        return object_ref
+
     def put_serialized_object_and_increment_local_ref(self, serialized_object,
                                                       ObjectRef object_ref=None,
                                                       c_bool pin_object=True,
@@ -1414,6 +1467,32 @@ cdef class CoreWorker:
 
         return ready, not_ready
 
+    def create_wait_set(self, object_refs):
+        cdef:
+            c_vector[CObjectID] wait_ids = ObjectRefsToVector(object_refs)
+            int64_t wait_set_id
+
+        with nogil:
+            check_status(CCoreWorkerProcess.GetCoreWorker().CreateWaitSet(
+                wait_ids, &wait_set_id))
+        return wait_set_id
+
+    def poll_wait_set(self, int64_t wait_set_id, int num_returns,
+                      int64_t timeout_ms, c_bool fetch_local):
+        """Return the binary IDs of at most num_returns objects of the wait
+        set that are ready, in the order they became ready, and remove them
+        from the set."""
+        cdef:
+            c_vector[CObjectID] ready
+
+        with nogil:
+            check_status(CCoreWorkerProcess.GetCoreWorker().PollWaitSet(
+                wait_set_id, num_returns, timeout_ms, fetch_local, &ready))
+        return [ready[i].Binary() for i in range(ready.size())]
+
+    def destroy_wait_set(self, int64_t wait_set_id):
+        CCoreWorkerProcess.GetCoreWorker().DestroyWaitSet(wait_set_id)
+
     def free_objects(self, object_refs, c_bool local_only):
         cdef:
             c_vector[CObjectID] free_ids = ObjectRefsToVector(object_refs)
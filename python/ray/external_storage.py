@@ -306,16 +306,27 @@ class FileSystemStorage(ExternalStorage):
         self, object_refs: List[ObjectRef], url_with_offset_list: List[str]
     ):
         total = 0
-        for i in range(len(object_refs)):
-            object_ref = object_refs[i]
-            url_with_offset = url_with_offset_list[i].decode()
-            # Retrieve the information needed.
-            parsed_result = parse_url_with_offset(url_with_offset)
-            base_url = parsed_result.base_url
-            offset = parsed_result.offset
-            # Read a part of the file and recover the object.
-            with open(base_url, "rb") as f:
-                f.seek(offset)
+        parsed_results = [
+            parse_url_with_offset(url_with_offset.decode())
+            for url_with_offset in url_with_offset_list
+        ]
+        # Restore the objects fused into the same file with one open file, in the
+        # order they were written, so that the file is read sequentially.
+        order = sorted(
+            range(len(object_refs)),
+            key=lambda i: (parsed_results[i].base_url, parsed_results[i].offset),
+        )
+        f = None
+        try:
+            for i in order:
+                object_ref = object_refs[i]
+                parsed_result = parsed_results[i]
+                if f is None or f.name != parsed_result.base_url:
+                    if f is not None:
+                        f.close()
+                    f = open(parsed_result.base_url, "rb")
+                # Read a part of the file and recover the object.
+                f.seek(parsed_result.offset)
                 address_len = int.from_bytes(f.read(8), byteorder="little")
                 metadata_len = int.from_bytes(f.read(8), byteorder="little")
                 buf_len = int.from_bytes(f.read(8), byteorder="little")
@@ -327,6 +338,9 @@ class FileSystemStorage(ExternalStorage):
                 self._put_object_to_store(
                     metadata, buf_len, f, object_ref, owner_address
                 )
+        finally:
+            if f is not None:
+                f.close()
         return total
 
     def delete_spilled_objects(self, urls: List[str]):
@@ -227,6 +227,12 @@ cdef extern from "ray/core_worker/core_worker.h" nogil:
         CRayStatus Wait(const c_vector[CObjectID] &object_ids, int num_objects,
                         int64_t timeout_ms, c_vector[c_bool] *results,
                         c_bool fetch_local)
+        CRayStatus CreateWaitSet(const c_vector[CObjectID] &object_ids,
+                                 int64_t *wait_set_id)
+        CRayStatus PollWaitSet(int64_t wait_set_id, int num_objects,
+                               int64_t timeout_ms, c_bool fetch_local,
+                               c_vector[CObjectID] *ready)
+        void DestroyWaitSet(int64_t wait_set_id)
         CRayStatus Delete(const c_vector[CObjectID] &object_ids,
                           c_bool local_only)
         CRayStatus GetLocationFromOwner(
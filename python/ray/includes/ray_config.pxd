@@ -55,6 +55,8 @@ cdef extern from "ray/common/ray_config.h" nogil:
 
         int64_t task_rpc_inlined_bytes_limit() const
 
+        int64_t task_arg_dedup_min_bytes() const
+
         uint64_t metrics_report_interval_ms() const
 
         c_bool enable_timeline() const
@@ -49,21 +49,33 @@ _METRICS = [
     "ray_operation_run_time_ms",
     "ray_operation_queue_time_ms",
     "ray_operation_active_count",
+    "ray_event_loop_lag_ms_sum",
     "ray_grpc_server_req_process_time_ms",
     "ray_grpc_server_req_new_total",
     "ray_grpc_server_req_handling_total",
     "ray_grpc_server_req_finished_total",
+    "ray_grpc_server_req_queue_time_ms_sum",
+    "ray_grpc_server_req_handler_time_ms_sum",
+    "ray_grpc_server_req_reply_time_ms_sum",
+    "ray_grpc_server_req_in_flight",
+    "ray_grpc_client_req_latency_ms_sum",
+    "ray_grpc_client_req_callback_queue_time_ms_sum",
+    "ray_grpc_client_req_in_flight",
     "ray_object_manager_received_chunks",
+    "ray_object_manager_peer_throughput_bytes_per_s",
     "ray_pull_manager_usage_bytes",
     "ray_pull_manager_requested_bundles",
     "ray_pull_manager_requests",
     "ray_pull_manager_active_bundles",
     "ray_pull_manager_retries_total",
+    "ray_pull_manager_object_pull_latency_ms_sum",
+    "ray_pull_manager_stalled_objects",
     "ray_push_manager_in_flight_pushes",
     "ray_push_manager_chunks",
     "ray_scheduler_failed_worker_startup_total",
     "ray_scheduler_tasks",
     "ray_scheduler_unscheduleable_tasks",
+    "ray_raylet_startup_time_ms",
     "ray_spill_manager_objects",
     "ray_spill_manager_objects_bytes",
     "ray_spill_manager_request_total",
@@ -0,0 +1,86 @@
+"""Forks Python workers for the raylet.
+
+The forkserver imports Ray once, and then forks a worker for each request that
+the raylet sends over a Unix socket, so that the workers don't pay for starting
+the interpreter and importing Ray themselves.
+
+Each request is a 4-byte big-endian length followed by the worker's command line
+and the environment variables to set on it, all null-terminated, with an empty
+string between the two. The forkserver replies with the pid of the worker as a
+4-byte big-endian integer, or -1 if the fork failed. The forkserver exits once
+the raylet disconnects.
+"""
+import os
+import runpy
+import signal
+import socket
+import struct
+import sys
+
+import ray  # noqa: F401 Imported so that the workers inherit it.
+import ray.actor  # noqa: F401
+import ray.node  # noqa: F401
+
+
+def _recv_exactly(conn, size):
+    data = b""
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def _parse_request(payload):
+    entries = payload.decode().split("\0")
+    separator = entries.index("")
+    argv = entries[:separator]
+    env = dict(
+        entry.split("=", 1) for entry in entries[separator + 1 :] if "=" in entry
+    )
+    return argv, env
+
+
+def _run_worker(argv, env):
+    signal.signal(signal.SIGCHLD, signal.SIG_DFL)
+    os.environ.update(env)
+    # argv[0] is the Python executable.
+    sys.argv = argv[1:]
+    runpy.run_path(argv[1], run_name="__main__")
+    sys.exit(0)
+
+
+def main(socket_path):
+    # The workers are reaped automatically, the raylet watches them by pid.
+    signal.signal(signal.SIGCHLD, signal.SIG_IGN)
+    if os.path.exists(socket_path):
+        os.unlink(socket_path)
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(socket_path)
+    server.listen(1)
+    conn, _ = server.accept()
+    server.close()
+    os.unlink(socket_path)
+
+    while True:
+        header = _recv_exactly(conn, 4)
+        if header is None:
+            break
+        (size,) = struct.unpack("!I", header)
+        payload = _recv_exactly(conn, size)
+        if payload is None:
+            break
+        argv, env = _parse_request(payload)
+        try:
+            pid = os.fork()
+        except OSError:
+            pid = -1
+        if pid == 0:
+            conn.close()
+            _run_worker(argv, env)
+        conn.sendall(struct.pack("!i", pid))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
@@ -45,6 +45,12 @@ class MockCoreWorker : public CoreWorker {
                rpc::PushTaskReply *reply,
                rpc::SendReplyCallback send_reply_callback),
               (override));
+  MOCK_METHOD(void,
+              HandlePushTaskBatch,
+              (const rpc::PushTaskBatchRequest &request,
+               rpc::PushTaskBatchReply *reply,
+               rpc::SendReplyCallback send_reply_callback),
+              (override));
   MOCK_METHOD(void,
               HandleDirectActorCallArgWaitComplete,
               (const rpc::DirectActorCallArgWaitCompleteRequest &request,
@@ -57,6 +63,12 @@ class MockCoreWorker : public CoreWorker {
                rpc::GetObjectStatusReply *reply,
                rpc::SendReplyCallback send_reply_callback),
               (override));
+  MOCK_METHOD(void,
+              HandleGetObjectStatusBatch,
+              (const rpc::GetObjectStatusBatchRequest &request,
+               rpc::GetObjectStatusBatchReply *reply,
+               rpc::SendReplyCallback send_reply_callback),
+              (override));
   MOCK_METHOD(void,
               HandleWaitForActorOutOfScope,
               (const rpc::WaitForActorOutOfScopeRequest &request,
@@ -165,6 +177,12 @@ class MockCoreWorker : public CoreWorker {
                rpc::AssignObjectOwnerReply *reply,
                rpc::SendReplyCallback send_reply_callback),
               (override));
+  MOCK_METHOD(void,
+              HandleReportStreamingReturn,
+              (const rpc::ReportStreamingReturnRequest &request,
+               rpc::ReportStreamingReturnReply *reply,
+               rpc::SendReplyCallback send_reply_callback),
+              (override));
 };
 
 }  // namespace core
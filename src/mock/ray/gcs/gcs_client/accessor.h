@@ -29,6 +29,11 @@ class MockActorInfoAccessor : public ActorInfoAccessor {
               AsyncGetAll,
               (const MultiItemCallback<rpc::ActorTableData> &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncGetPage,
+              (const rpc::GetAllActorInfoRequest &request,
+               const PageCallback<rpc::ActorTableData> &callback),
+              (override));
   MOCK_METHOD(Status,
               AsyncGetByName,
               (const std::string &name,
@@ -49,6 +54,12 @@ class MockActorInfoAccessor : public ActorInfoAccessor {
                const StatusCallback &callback,
                int64_t timeout_ms),
               (override));
+  MOCK_METHOD(Status,
+              AsyncRegisterActors,
+              (const std::vector<TaskSpecification> &task_specs,
+               const std::function<void(std::vector<Status>)> &callback,
+               int64_t timeout_ms),
+              (override));
   MOCK_METHOD(Status,
               SyncRegisterActor,
               (const TaskSpecification &task_spec),
@@ -102,6 +113,11 @@ class MockJobInfoAccessor : public JobInfoAccessor {
               AsyncGetAll,
               (const MultiItemCallback<rpc::JobTableData> &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncGetPage,
+              (const rpc::GetAllJobInfoRequest &request,
+               const PageCallback<rpc::JobTableData> &callback),
+              (override));
   MOCK_METHOD(void, AsyncResubscribe, (), (override));
   MOCK_METHOD(Status,
               AsyncGetNextJobID,
@@ -136,6 +152,11 @@ class MockNodeInfoAccessor : public NodeInfoAccessor {
               AsyncGetAll,
               (const MultiItemCallback<rpc::GcsNodeInfo> &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncGetPage,
+              (const rpc::GetAllNodeInfoRequest &request,
+               const PageCallback<rpc::GcsNodeInfo> &callback),
+              (override));
   MOCK_METHOD(Status,
               AsyncSubscribeToNodeChange,
               ((const SubscribeCallback<NodeID, rpc::GcsNodeInfo> &subscribe),
@@ -155,6 +176,12 @@ class MockNodeInfoAccessor : public NodeInfoAccessor {
               (const std::shared_ptr<rpc::HeartbeatTableData> &data_ptr,
                const StatusCallback &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncReportNodeSuspected,
+              (const NodeID &node_id,
+               const NodeID &reporter_node_id,
+               const StatusCallback &callback),
+              (override));
   MOCK_METHOD(void, AsyncResubscribe, (), (override));
   MOCK_METHOD(Status,
               AsyncGetInternalConfig,
@@ -257,6 +284,11 @@ class MockWorkerInfoAccessor : public WorkerInfoAccessor {
               AsyncGetAll,
               (const MultiItemCallback<rpc::WorkerTableData> &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncGetPage,
+              (const rpc::GetAllWorkerInfoRequest &request,
+               const PageCallback<rpc::WorkerTableData> &callback),
+              (override));
   MOCK_METHOD(Status,
               AsyncAdd,
               (const std::shared_ptr<rpc::WorkerTableData> &data_ptr,
@@ -344,6 +376,20 @@ class MockInternalKVAccessor : public InternalKVAccessor {
                bool del_by_prefix,
                const StatusCallback &callback),
               (override));
+  MOCK_METHOD(Status,
+              AsyncInternalKVMultiGet,
+              (const std::string &ns,
+               const std::vector<std::string> &keys,
+               (const OptionalItemCallback<absl::flat_hash_map<std::string, std::string>>
+                    &callback)),
+              (override));
+  MOCK_METHOD(Status,
+              AsyncInternalKVMultiPut,
+              (const std::string &ns,
+               (const std::vector<std::pair<std::string, std::string>> &entries),
+               bool overwrite,
+               const OptionalItemCallback<int> &callback),
+              (override));
 };
 
 }  // namespace gcs
@@ -33,6 +33,12 @@ class MockGcsActorManager : public GcsActorManager {
                rpc::RegisterActorReply *reply,
                rpc::SendReplyCallback send_reply_callback),
               (override));
+  MOCK_METHOD(void,
+              HandleRegisterActors,
+              (const rpc::RegisterActorsRequest &request,
+               rpc::RegisterActorsReply *reply,
+               rpc::SendReplyCallback send_reply_callback),
+              (override));
   MOCK_METHOD(void,
               HandleCreateActor,
               (const rpc::CreateActorRequest &request,
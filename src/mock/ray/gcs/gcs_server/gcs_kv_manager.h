@@ -52,6 +52,20 @@ class MockInternalKVInterface : public ray::gcs::InternalKVInterface {
                const std::string &prefix,
                std::function<void(std::vector<std::string>)> callback),
               (override));
+  MOCK_METHOD(void,
+              MultiGet,
+              (const std::string &ns,
+               const std::vector<std::string> &keys,
+               std::function<void(absl::flat_hash_map<std::string, std::string>)>
+                   callback),
+              (override));
+  MOCK_METHOD(void,
+              MultiPut,
+              (const std::string &ns,
+               (const std::vector<std::pair<std::string, std::string>> &entries),
+               bool overwrite,
+               std::function<void(int64_t)> callback),
+              (override));
   MOCK_METHOD(instrumented_io_context &, GetEventLoop, (), (override));
 };
 
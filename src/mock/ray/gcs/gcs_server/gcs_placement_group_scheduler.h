@@ -34,6 +34,10 @@ class MockGcsPlacementGroupSchedulerInterface
                PGSchedulingFailureCallback failure_callback,
                PGSchedulingSuccessfulCallback success_callback),
               (override));
+  MOCK_METHOD(bool,
+              FitsAvailableResources,
+              (const std::shared_ptr<GcsPlacementGroup> &placement_group),
+              (override));
   MOCK_METHOD((absl::flat_hash_map<PlacementGroupID, std::vector<int64_t>>),
               GetBundlesOnNode,
               (const NodeID &node_id),
@@ -93,6 +97,10 @@ class MockGcsPlacementGroupScheduler : public GcsPlacementGroupScheduler {
                PGSchedulingFailureCallback failure_handler,
                PGSchedulingSuccessfulCallback success_handler),
               (override));
+  MOCK_METHOD(bool,
+              FitsAvailableResources,
+              (const std::shared_ptr<GcsPlacementGroup> &placement_group),
+              (override));
   MOCK_METHOD(void,
               DestroyPlacementGroupBundleResourcesIfExists,
               (const PlacementGroupID &placement_group_id),
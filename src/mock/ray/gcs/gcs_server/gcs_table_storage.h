@@ -22,6 +22,11 @@ class MockGcsTable : public GcsTable<Key, Data> {
               Put,
               (const Key &key, const Data &value, const StatusCallback &callback),
               (override));
+  MOCK_METHOD(Status,
+              BatchPut,
+              ((const std::vector<std::pair<Key, Data>> &values),
+               const StatusCallback &callback),
+              (override));
   MOCK_METHOD(Status,
               Delete,
               (const Key &key, const StatusCallback &callback),
@@ -45,6 +50,11 @@ class MockGcsTableWithJobId : public GcsTableWithJobId<Key, Data> {
               Put,
               (const Key &key, const Data &value, const StatusCallback &callback),
               (override));
+  MOCK_METHOD(Status,
+              BatchPut,
+              ((const std::vector<std::pair<Key, Data>> &values),
+               const StatusCallback &callback),
+              (override));
   MOCK_METHOD(Status,
               Delete,
               (const Key &key, const StatusCallback &callback),
@@ -29,6 +29,12 @@ class MockDefaultStatsHandler : public DefaultStatsHandler {
                rpc::GetAllProfileInfoReply *reply,
                rpc::SendReplyCallback send_reply_callback),
               (override));
+  MOCK_METHOD(void,
+              HandleProfileGcsCpu,
+              (const ProfileGcsCpuRequest &request,
+               ProfileGcsCpuReply *reply,
+               SendReplyCallback send_reply_callback),
+              (override));
 };
 
 }  // namespace rpc
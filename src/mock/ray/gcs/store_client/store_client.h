@@ -41,6 +41,12 @@ class MockStoreClient : public StoreClient {
                const std::vector<std::string> &key,
                (const MapCallback<std::string, std::string> &callback)),
               (override));
+  MOCK_METHOD(Status,
+              AsyncBatchPut,
+              (const std::string &table_name,
+               (std::vector<std::pair<std::string, std::string>> kvs),
+               const StatusCallback &callback),
+              (override));
   MOCK_METHOD(Status,
               AsyncDelete,
               (const std::string &table_name,
@@ -23,6 +23,11 @@ class MockTaskDependencyManagerInterface : public TaskDependencyManagerInterface
                const std::vector<rpc::ObjectReference> &required_objects),
               (override));
   MOCK_METHOD(void, RemoveTaskDependencies, (const TaskID &task_id), (override));
+  MOCK_METHOD(
+      void,
+      PrefetchTaskDependencies,
+      ((const absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> &tasks)),
+      (override));
   MOCK_METHOD(bool, TaskDependenciesBlocked, (const TaskID &task_id), (const, override));
   MOCK_METHOD(bool, CheckObjectLocal, (const ObjectID &object_id), (const, override));
 };
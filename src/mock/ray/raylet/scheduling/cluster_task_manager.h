@@ -72,7 +72,7 @@ class MockClusterTaskManager : public ClusterTaskManager {
               (override));
   MOCK_METHOD(void, ScheduleAndDispatchTasks, (), (override));
   MOCK_METHOD(void, RecordMetrics, (), (override));
-  MOCK_METHOD(std::string, DebugStr, (), (const, override));
+  MOCK_METHOD(std::string, DebugStr, (bool full), (const, override));
   MOCK_METHOD(ResourceRequest, CalcNormalTaskResources, (), (const, override));
 };
 
@@ -63,7 +63,7 @@ class MockClusterTaskManagerInterface : public ClusterTaskManagerInterface {
                int *num_pending_actor_creation,
                int *num_pending_tasks),
               (const, override));
-  MOCK_METHOD(std::string, DebugStr, (), (const, override));
+  MOCK_METHOD(std::string, DebugStr, (bool full), (const, override));
   MOCK_METHOD(void, RecordMetrics, (), (override));
   MOCK_METHOD(ResourceRequest, CalcNormalTaskResources, (), (const, override));
 };
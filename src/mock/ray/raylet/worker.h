@@ -76,6 +76,7 @@ class MockWorkerInterface : public WorkerInterface {
   MOCK_METHOD(void, ClearLifetimeAllocatedInstances, (), (override));
   MOCK_METHOD(RayTask &, GetAssignedTask, (), (override));
   MOCK_METHOD(void, SetAssignedTask, (const RayTask &assigned_task), (override));
+  MOCK_METHOD(int64_t, GetAssignedTaskTime, (), (const, override));
   MOCK_METHOD(bool, IsRegistered, (), (override));
   MOCK_METHOD(rpc::CoreWorkerClientInterface *, rpc_client, (), (override));
 };
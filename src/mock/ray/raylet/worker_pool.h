@@ -31,6 +31,10 @@ class MockWorkerPoolInterface : public WorkerPoolInterface {
               GetAllRegisteredWorkers,
               (bool filter_dead_workers),
               (override));
+  MOCK_METHOD(boost::optional<const rpc::JobConfig &>,
+              GetJobConfig,
+              (const JobID &job_id),
+              (const, override));
 };
 
 }  // namespace raylet
@@ -79,7 +79,7 @@ class MockResourceReserveInterface : public ResourceReserveInterface {
   MOCK_METHOD(
       void,
       CancelResourceReserve,
-      (const BundleSpecification &bundle_spec,
+      (const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
        const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback),
       (override));
   MOCK_METHOD(void,
@@ -110,11 +110,13 @@ class MockResourceTrackingInterface : public ResourceTrackingInterface {
   MOCK_METHOD(void,
               UpdateResourceUsage,
               (std::string & serialized_resource_usage_batch,
+               const std::vector<rpc::Address> &forward_to,
                const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback),
               (override));
   MOCK_METHOD(void,
               RequestResourceReport,
-              (const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback),
+              (int64_t last_report_version,
+               const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback),
               (override));
 };
 
@@ -175,7 +177,7 @@ class MockRayletClientInterface : public RayletClientInterface {
   MOCK_METHOD(
       void,
       CancelResourceReserve,
-      (const BundleSpecification &bundle_spec,
+      (const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
        const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback),
       (override));
   MOCK_METHOD(void,
@@ -200,11 +202,13 @@ class MockRayletClientInterface : public RayletClientInterface {
   MOCK_METHOD(void,
               UpdateResourceUsage,
               (std::string & serialized_resource_usage_batch,
+               const std::vector<rpc::Address> &forward_to,
                const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback),
               (override));
   MOCK_METHOD(void,
               RequestResourceReport,
-              (const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback),
+              (int64_t last_report_version,
+               const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback),
               (override));
   MOCK_METHOD(void,
               ShutdownRaylet,
@@ -212,6 +216,17 @@ class MockRayletClientInterface : public RayletClientInterface {
                bool graceful,
                const rpc::ClientCallback<rpc::ShutdownRayletReply> &callback),
               (override));
+  MOCK_METHOD(void,
+              StealTasks,
+              (const NodeID &node_id,
+               (const absl::flat_hash_map<std::string, double> &resources_available),
+               const rpc::ClientCallback<rpc::StealTasksReply> &callback),
+              (override));
+  MOCK_METHOD(void,
+              ProbeNode,
+              (const absl::optional<rpc::Address> &target,
+               const rpc::ClientCallback<rpc::ProbeNodeReply> &callback),
+              (override));
 };
 
 }  // namespace ray
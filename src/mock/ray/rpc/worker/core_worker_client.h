@@ -50,6 +50,11 @@ class MockCoreWorkerClientInterface : public ray::pubsub::MockSubscriberClientIn
               (const GetObjectStatusRequest &request,
                const ClientCallback<GetObjectStatusReply> &callback),
               (override));
+  MOCK_METHOD(void,
+              GetObjectStatusBatch,
+              (const GetObjectStatusBatchRequest &request,
+               const ClientCallback<GetObjectStatusBatchReply> &callback),
+              (override));
   MOCK_METHOD(void,
               WaitForActorOutOfScope,
               (const WaitForActorOutOfScopeRequest &request,
@@ -129,6 +134,11 @@ class MockCoreWorkerClientInterface : public ray::pubsub::MockSubscriberClientIn
               (const AssignObjectOwnerRequest &request,
                const ClientCallback<AssignObjectOwnerReply> &callback),
               (override));
+  MOCK_METHOD(void,
+              ReportStreamingReturn,
+              (const ReportStreamingReturnRequest &request,
+               const ClientCallback<ReportStreamingReturnReply> &callback),
+              (override));
   MOCK_METHOD(int64_t, ClientProcessedUpToSeqno, (), (override));
 };
 
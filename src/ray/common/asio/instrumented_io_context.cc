@@ -15,13 +15,133 @@
 #include "ray/common/asio/instrumented_io_context.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #include "ray/common/asio/asio_chaos.h"
 #include "ray/common/asio/asio_util.h"
+#include "ray/stats/metric_defs.h"
+
+instrumented_io_context::~instrumented_io_context() {
+  auto *node = queue_head_.exchange(nullptr, std::memory_order_acquire);
+  while (node != nullptr) {
+    std::unique_ptr<QueuedHandler> handler(node);
+    node = node->next;
+  }
+}
+
+void instrumented_io_context::PostHandler(std::function<void()> handler) {
+  if (!RayConfig::instance().event_loop_batched_post()) {
+    boost::asio::io_context::post(std::move(handler));
+    return;
+  }
+  auto *node =
+      new QueuedHandler{std::move(handler), queue_head_.load(std::memory_order_relaxed)};
+  while (!queue_head_.compare_exchange_weak(
+      node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  if (node->next == nullptr) {
+    // The queue was empty, so no drain is pending that would run this handler.
+    boost::asio::io_context::post([this]() { DrainQueue(); });
+  }
+}
+
+void instrumented_io_context::DrainQueue() {
+  // Take all of the handlers at once. The handlers that are pushed from now on post
+  // another drain.
+  auto *node = queue_head_.exchange(nullptr, std::memory_order_acquire);
+  // Reverse the stack, so that the handlers are run in the order they were pushed.
+  QueuedHandler *first = nullptr;
+  while (node != nullptr) {
+    auto *next = node->next;
+    node->next = first;
+    first = node;
+    node = next;
+  }
+  while (first != nullptr) {
+    std::unique_ptr<QueuedHandler> handler(first);
+    first = first->next;
+    handler->handler();
+  }
+}
+
+void instrumented_io_context::StartLagProbe(const std::string &name) {
+  if (RayConfig::instance().event_loop_lag_probe_interval_ms() <= 0) {
+    return;
+  }
+  RAY_CHECK(lag_probe_timer_ == nullptr) << "The lag of " << name << " is already probed";
+  lag_probe_name_ = name;
+  lag_probe_timer_ = std::make_unique<boost::asio::steady_timer>(*this);
+  ScheduleLagProbe();
+}
+
+void instrumented_io_context::ScheduleLagProbe() {
+  lag_probe_timer_->expires_after(std::chrono::milliseconds(
+      RayConfig::instance().event_loop_lag_probe_interval_ms()));
+  lag_probe_timer_->async_wait([this](const boost::system::error_code &error) {
+    if (error == boost::asio::error::operation_aborted) {
+      return;
+    }
+    // The timer handler is due at the expiry, so it's late by as much as any handler
+    // that is posted now would wait.
+    const int64_t lag_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() -
+                               lag_probe_timer_->expiry())
+                               .count();
+    last_lag_ms_ = lag_ms;
+    ray::stats::STATS_event_loop_lag_ms.Record(lag_ms, lag_probe_name_);
+    ReportSlowHandlers(lag_ms);
+    ScheduleLagProbe();
+  });
+}
+
+void instrumented_io_context::ReportSlowHandlers(int64_t lag_ms) {
+  const int64_t threshold_ms =
+      RayConfig::instance().event_loop_lag_warning_threshold_ms();
+  if (threshold_ms <= 0) {
+    return;
+  }
+  const bool is_slow = lag_ms > threshold_ms;
+  // Pairs of the time a handler ran since the previous probe and its name.
+  std::vector<std::pair<int64_t, std::string>> handlers;
+  if (RayConfig::instance().event_stats()) {
+    for (const auto &entry : event_stats_->get_event_stats()) {
+      auto &previous_execution_time = lag_probe_execution_times_[entry.first];
+      const int64_t execution_time =
+          entry.second.cum_execution_time - previous_execution_time;
+      previous_execution_time = entry.second.cum_execution_time;
+      if (is_slow && execution_time > 0) {
+        handlers.emplace_back(execution_time, entry.first);
+      }
+    }
+  }
+  if (!is_slow) {
+    return;
+  }
+  const size_t num_reported = std::min<size_t>(handlers.size(), 5);
+  std::partial_sort(handlers.begin(),
+                    handlers.begin() + num_reported,
+                    handlers.end(),
+                    std::greater<std::pair<int64_t, std::string>>());
+  std::stringstream slowest_handlers;
+  for (size_t i = 0; i < num_reported; i++) {
+    slowest_handlers << "\n\t" << handlers[i].second << ": "
+                     << handlers[i].first / 1000000 << " ms";
+  }
+  RAY_LOG(WARNING) << "The " << lag_probe_name_ << " event loop runs handlers "
+                   << lag_ms << " ms late, above the threshold of " << threshold_ms
+                   << " ms."
+                   << (num_reported > 0 ? " The handlers that ran the longest since "
+                                          "the previous check:"
+                                        : "")
+                   << slowest_handlers.str();
+}
 
 void instrumented_io_context::post(std::function<void()> handler,
                                    const std::string name) {
@@ -38,7 +158,7 @@ void instrumented_io_context::post(std::function<void()> handler,
   }
   auto defer_us = ray::asio::testing::get_delay_us(name);
   if (defer_us == 0) {
-    boost::asio::io_context::post(std::move(handler));
+    PostHandler(std::move(handler));
   } else {
     RAY_LOG(DEBUG) << "Deferring " << name << " by " << defer_us << "us";
     execute_after_us(*this, std::move(handler), defer_us);
@@ -61,7 +181,7 @@ void instrumented_io_context::post(std::function<void()> handler,
     };
   }
   if (defer_us == 0) {
-    return boost::asio::io_context::post(std::move(handler));
+    PostHandler(std::move(handler));
   } else {
     RAY_LOG(DEBUG) << "Deferring " << stats_handle->event_name << " by " << defer_us
                    << "us";
@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/asio.hpp>
 #include <limits>
+#include <memory>
+#include <string>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
@@ -30,9 +33,15 @@ class instrumented_io_context : public boost::asio::io_context {
   /// TODO(ekl) allow taking an externally defined event tracker.
   instrumented_io_context() : event_stats_(std::make_shared<EventTracker>()) {}
 
+  ~instrumented_io_context();
+
   /// A proxy post function that collects count, queueing, and execution statistics for
   /// the given handler.
   ///
+  /// If event_loop_batched_post is enabled, the handler is pushed to a lock-free queue
+  /// that is drained by the event loop, so it's run in order with the other handlers
+  /// posted through this class, but not with the handlers posted to asio directly.
+  ///
   /// \param handler The handler to be posted to the event loop.
   /// \param name A human-readable name for the handler, to be used for viewing stats
   /// for the provided handler.
@@ -55,7 +64,55 @@ class instrumented_io_context : public boost::asio::io_context {
 
   EventTracker &stats() const { return *event_stats_; };
 
+  /// Start probing the lag of the event loop, i.e. how late it runs the handlers that
+  /// are due, every event_loop_lag_probe_interval_ms. The lag is recorded in the
+  /// event_loop_lag_ms histogram, and a lag above event_loop_lag_warning_threshold_ms
+  /// is logged along with the handlers that ran the longest since the previous probe,
+  /// if event_stats is enabled. The probe is a timer, so this keeps the loop running.
+  ///
+  /// \param name The name of the event loop in the metrics and logs, e.g. "raylet".
+  void StartLagProbe(const std::string &name);
+
+  /// Get the lag measured by the last probe, in milliseconds.
+  int64_t LastLagMs() const { return last_lag_ms_; }
+
  private:
+  /// A handler in the queue of posted handlers.
+  struct QueuedHandler {
+    std::function<void()> handler;
+    QueuedHandler *next;
+  };
+
+  /// Post a handler to asio, or push it to the queue if event_loop_batched_post is
+  /// enabled. The queue is drained by a single asio handler, which is posted when the
+  /// queue becomes non-empty.
+  void PostHandler(std::function<void()> handler);
+
+  /// Run all of the handlers in the queue, in the order they were pushed.
+  void DrainQueue();
+
+  /// Set the lag probe timer to expire after the probe interval.
+  void ScheduleLagProbe();
+
+  /// Log the handlers that ran the longest since the previous probe if the lag is
+  /// above the warning threshold, and remember how long every handler ran so far.
+  void ReportSlowHandlers(int64_t lag_ms);
+
   /// The event stats tracker to use to record asio handler stats to.
   std::shared_ptr<EventTracker> event_stats_;
+
+  /// The queue of posted handlers, as a stack with the last pushed handler on top.
+  std::atomic<QueuedHandler *> queue_head_{nullptr};
+
+  /// The name of the event loop, once its lag is probed.
+  std::string lag_probe_name_;
+
+  /// The timer of the lag probe, nullptr if the lag isn't probed.
+  std::unique_ptr<boost::asio::steady_timer> lag_probe_timer_;
+
+  /// The total execution time of every handler at the previous probe, in nanoseconds.
+  absl::flat_hash_map<std::string, int64_t> lag_probe_execution_times_;
+
+  /// The lag measured by the last probe, in milliseconds.
+  std::atomic<int64_t> last_lag_ms_{0};
 };
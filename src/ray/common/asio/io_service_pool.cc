@@ -14,11 +14,19 @@
 
 #include "ray/common/asio/io_service_pool.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <sstream>
+
 #include "ray/util/logging.h"
 
 namespace ray {
 
-IOServicePool::IOServicePool(size_t io_service_num) : io_service_num_(io_service_num) {}
+IOServicePool::IOServicePool(size_t io_service_num, std::vector<int> cpus)
+    : io_service_num_(io_service_num), cpus_(std::move(cpus)) {}
 
 IOServicePool::~IOServicePool() {}
 
@@ -30,6 +38,19 @@ void IOServicePool::Run() {
       boost::asio::io_service::work work(io_service);
       io_service.run();
     });
+#ifdef __linux__
+    if (!cpus_.empty()) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpus_[i % cpus_.size()], &cpu_set);
+      const int ret = pthread_setaffinity_np(
+          threads_.back().native_handle(), sizeof(cpu_set), &cpu_set);
+      if (ret != 0) {
+        RAY_LOG(WARNING) << "Failed to pin io_service thread " << i << " to CPU "
+                         << cpus_[i % cpus_.size()] << ", error " << ret;
+      }
+    }
+#endif
   }
 
   RAY_LOG(INFO) << "IOServicePool is running with " << io_service_num_ << " io_service.";
@@ -47,4 +68,22 @@ void IOServicePool::Stop() {
   RAY_LOG(INFO) << "IOServicePool is stopped.";
 }
 
+std::string IOServicePool::DebugString() const {
+  std::ostringstream stream;
+  stream << "IOServicePool:";
+  for (size_t i = 0; i < io_services_.size(); i++) {
+    int64_t num_queued = 0;
+    int64_t num_run = 0;
+    int64_t execution_time_ns = 0;
+    for (const auto &entry : io_services_[i]->stats().get_event_stats()) {
+      num_queued += entry.second.curr_count;
+      num_run += entry.second.cum_count;
+      execution_time_ns += entry.second.cum_execution_time;
+    }
+    stream << "\n- io_service " << i << ": " << num_queued << " queued, " << num_run
+           << " total, " << execution_time_ns / 1000000 << " ms run";
+  }
+  return stream.str();
+}
+
 }  // namespace ray
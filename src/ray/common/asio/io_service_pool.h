@@ -16,7 +16,9 @@
 
 #include <atomic>
 #include <boost/asio.hpp>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "ray/common/asio/instrumented_io_context.h"
 
@@ -28,7 +30,11 @@ namespace ray {
 /// Before exit, `Stop()` must be called.
 class IOServicePool {
  public:
-  IOServicePool(size_t io_service_num);
+  /// \param io_service_num The number of io_services, and threads.
+  /// \param cpus If not empty, the CPUs to pin the threads to, one CPU per thread in
+  /// turn, so that each io_service keeps its state in the cache of one core. Only
+  /// supported on Linux.
+  IOServicePool(size_t io_service_num, std::vector<int> cpus = {});
 
   ~IOServicePool();
 
@@ -52,8 +58,13 @@ class IOServicePool {
   /// This is only use for RedisClient::Connect().
   std::vector<instrumented_io_context *> GetAll();
 
+  /// Return the load of each io_service: the number of handlers queued and run so far,
+  /// and the time spent running them. This needs the event stats to be enabled.
+  std::string DebugString() const;
+
  private:
   size_t io_service_num_{0};
+  std::vector<int> cpus_;
 
   std::vector<std::thread> threads_;
   std::vector<std::unique_ptr<instrumented_io_context>> io_services_;
@@ -0,0 +1,122 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/asio/timer_wheel.h"
+
+#include <algorithm>
+
+#include "ray/common/ray_config.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+TimerWheel::TimerWheel(instrumented_io_context &io_context,
+                       uint64_t tick_ms,
+                       size_t num_slots,
+                       std::string name)
+    : io_context_(io_context),
+      tick_ms_(tick_ms),
+      name_(std::move(name)),
+      timer_(io_context),
+      slots_(num_slots) {
+  RAY_CHECK(tick_ms_ > 0);
+  RAY_CHECK(!slots_.empty());
+}
+
+TimerWheel::~TimerWheel() {
+  absl::MutexLock lock(&mu_);
+  timer_.cancel();
+}
+
+TimerWheel::TimerId TimerWheel::RunAfter(uint64_t timeout_ms, std::function<void()> fn) {
+  absl::MutexLock lock(&mu_);
+  // The next tick may be less than a tick away, so count it only if the timer is
+  // armed now, to never run the function early.
+  uint64_t num_ticks = (timeout_ms + tick_ms_ - 1) / tick_ms_ + (armed_ ? 1 : 0);
+  num_ticks = std::max<uint64_t>(num_ticks, 1);
+  const size_t slot = (current_slot_ + num_ticks) % slots_.size();
+  const TimerId id = next_id_++;
+  auto &timeouts = slots_[slot];
+  timeouts.push_back({id, (num_ticks - 1) / slots_.size(), std::move(fn)});
+  index_.emplace(id, std::make_pair(slot, std::prev(timeouts.end())));
+  MaybeArm();
+  return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+  absl::MutexLock lock(&mu_);
+  auto it = index_.find(id);
+  if (it == index_.end()) {
+    return false;
+  }
+  slots_[it->second.first].erase(it->second.second);
+  index_.erase(it);
+  return true;
+}
+
+size_t TimerWheel::NumPending() const {
+  absl::MutexLock lock(&mu_);
+  return index_.size();
+}
+
+void TimerWheel::MaybeArm() {
+  if (armed_ || index_.empty()) {
+    return;
+  }
+  armed_ = true;
+  timer_.expires_from_now(std::chrono::milliseconds(tick_ms_));
+  std::shared_ptr<StatsHandle> stats_handle;
+  if (RayConfig::instance().event_stats()) {
+    stats_handle = io_context_.stats().RecordStart(name_, tick_ms_ * 1000000);
+  }
+  timer_.async_wait([this, stats_handle = std::move(stats_handle)](
+                        const boost::system::error_code &error) {
+    if (error == boost::asio::error::operation_aborted) {
+      // The wheel is destroyed.
+      return;
+    }
+    RAY_CHECK(!error) << error.message();
+    if (stats_handle) {
+      io_context_.stats().RecordExecution([this]() { Tick(); }, std::move(stats_handle));
+    } else {
+      Tick();
+    }
+  });
+}
+
+void TimerWheel::Tick() {
+  std::vector<std::function<void()>> expired;
+  {
+    absl::MutexLock lock(&mu_);
+    armed_ = false;
+    current_slot_ = (current_slot_ + 1) % slots_.size();
+    auto &timeouts = slots_[current_slot_];
+    for (auto it = timeouts.begin(); it != timeouts.end();) {
+      if (it->turns > 0) {
+        it->turns--;
+        it++;
+        continue;
+      }
+      expired.push_back(std::move(it->fn));
+      index_.erase(it->id);
+      it = timeouts.erase(it);
+    }
+    MaybeArm();
+  }
+  for (const auto &fn : expired) {
+    fn();
+  }
+}
+
+}  // namespace ray
@@ -0,0 +1,102 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio/steady_timer.hpp>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/asio/instrumented_io_context.h"
+
+namespace ray {
+
+/// \class TimerWheel
+/// Runs functions after coarse-grained timeouts, for components that keep many
+/// timeouts pending at once, e.g. one per request. Each asio timer is an entry in the
+/// io context's timer heap, so inserting and canceling one is O(log n) in the number
+/// of pending timers. The wheel instead hashes each timeout into one of a fixed number
+/// of slots by its expiry tick, so adding and canceling one is O(1), and it only keeps
+/// a single asio timer, which ticks while any timeout is pending. Timeouts longer than
+/// a full turn of the wheel stay in their slot for several turns.
+///
+/// Timeouts are rounded up to the tick, so a function may run up to a tick late. This
+/// class is thread-safe. The functions run on the io context, without any lock held.
+class TimerWheel {
+ public:
+  using TimerId = uint64_t;
+
+  /// \param tick_ms The resolution of the timeouts.
+  /// \param num_slots The number of slots. Timeouts up to `tick_ms * num_slots` are
+  /// checked only once, when they expire.
+  /// \param name The name of the tick handler, for the event stats.
+  TimerWheel(instrumented_io_context &io_context,
+             uint64_t tick_ms,
+             size_t num_slots = 1024,
+             std::string name = "TimerWheel.Tick");
+
+  ~TimerWheel();
+
+  /// Run a function once the timeout expires.
+  ///
+  /// \return The ID to cancel the timeout with.
+  TimerId RunAfter(uint64_t timeout_ms, std::function<void()> fn) LOCKS_EXCLUDED(mu_);
+
+  /// Cancel a timeout, so that its function doesn't run.
+  ///
+  /// \return Whether the timeout was pending. It isn't if its function already ran or
+  /// is about to run.
+  bool Cancel(TimerId id) LOCKS_EXCLUDED(mu_);
+
+  /// Return the number of pending timeouts.
+  size_t NumPending() const LOCKS_EXCLUDED(mu_);
+
+ private:
+  struct Timeout {
+    TimerId id;
+    /// The number of turns of the wheel left before the timeout expires.
+    uint64_t turns;
+    std::function<void()> fn;
+  };
+
+  /// Arm the asio timer for the next tick, if it isn't armed yet.
+  void MaybeArm() EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// Advance the wheel by a tick and run the functions of the expired timeouts.
+  void Tick() LOCKS_EXCLUDED(mu_);
+
+  instrumented_io_context &io_context_;
+  const uint64_t tick_ms_;
+  const std::string name_;
+
+  mutable absl::Mutex mu_;
+  boost::asio::steady_timer timer_ GUARDED_BY(mu_);
+  /// Whether `timer_` is waiting for the next tick.
+  bool armed_ GUARDED_BY(mu_) = false;
+  /// The timeouts, by the slot they expire in.
+  std::vector<std::list<Timeout>> slots_ GUARDED_BY(mu_);
+  /// The slot of the current tick.
+  size_t current_slot_ GUARDED_BY(mu_) = 0;
+  /// The slot and position of each pending timeout.
+  absl::flat_hash_map<TimerId, std::pair<size_t, std::list<Timeout>::iterator>> index_
+      GUARDED_BY(mu_);
+  TimerId next_id_ GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace ray
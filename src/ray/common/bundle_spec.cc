@@ -14,6 +14,8 @@
 
 #include "ray/common/bundle_spec.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace ray {
 
 void BundleSpecification::ComputeResources() {
@@ -35,6 +37,7 @@ void BundleSpecification::ComputeResources() {
 
 void BundleSpecification::ComputeBundleResourceLabels() {
   RAY_CHECK(unit_resource_);
+  const auto group_id_hex = PlacementGroupId().Hex();
 
   for (auto &resource_id : unit_resource_->ResourceIds()) {
     auto resource_name = resource_id.Binary();
@@ -42,20 +45,33 @@ void BundleSpecification::ComputeBundleResourceLabels() {
 
     /// With bundle index (e.g., CPU_group_i_zzz).
     const std::string &resource_label =
-        FormatPlacementGroupResource(resource_name, PlacementGroupId(), Index());
+        FormatPlacementGroupResource(resource_name, group_id_hex, Index());
     bundle_resource_labels_[resource_label] = resource_value.Double();
 
     /// Without bundle index (e.g., CPU_group_zzz).
     const std::string &wildcard_label =
-        FormatPlacementGroupResource(resource_name, PlacementGroupId(), -1);
+        FormatPlacementGroupResource(resource_name, group_id_hex, -1);
     bundle_resource_labels_[wildcard_label] = resource_value.Double();
   }
   auto bundle_label =
-      FormatPlacementGroupResource(kBundle_ResourceLabel, PlacementGroupId(), -1);
+      FormatPlacementGroupResource(kBundle_ResourceLabel, group_id_hex, -1);
   auto index_bundle_label =
-      FormatPlacementGroupResource(kBundle_ResourceLabel, PlacementGroupId(), Index());
+      FormatPlacementGroupResource(kBundle_ResourceLabel, group_id_hex, Index());
   bundle_resource_labels_[index_bundle_label] = bundle_resource_labels_[bundle_label] =
       1000;
+
+  bundle_resource_ids_.reserve(bundle_resource_labels_.size());
+  for (const auto &label : bundle_resource_labels_) {
+    const auto &original_resource_name = GetOriginalResourceName(label.first);
+    bundle_resource_ids_.push_back(
+        {scheduling::ResourceID(label.first),
+         original_resource_name == kBundle_ResourceLabel
+             ? scheduling::ResourceID(-1)
+             : scheduling::ResourceID(original_resource_name),
+         label.second});
+  }
+  bundle_resource_request_ = ResourceMapToResourceRequest(
+      bundle_resource_labels_, /*requires_object_store_memory=*/false);
 }
 
 const ResourceRequest &BundleSpecification::GetRequiredResources() const {
@@ -97,15 +113,21 @@ std::string BundleSpecification::DebugString() const {
 std::string FormatPlacementGroupResource(const std::string &original_resource_name,
                                          const PlacementGroupID &group_id,
                                          int64_t bundle_index) {
-  std::stringstream os;
+  return FormatPlacementGroupResource(
+      original_resource_name, group_id.Hex(), bundle_index);
+}
+
+std::string FormatPlacementGroupResource(const std::string &original_resource_name,
+                                         absl::string_view group_id_hex,
+                                         int64_t bundle_index) {
+  std::string result;
   if (bundle_index >= 0) {
-    os << original_resource_name << kGroupKeyword << std::to_string(bundle_index) << "_"
-       << group_id.Hex();
+    result = absl::StrCat(
+        original_resource_name, kGroupKeyword, bundle_index, "_", group_id_hex);
   } else {
     RAY_CHECK(bundle_index == -1) << "Invalid index " << bundle_index;
-    os << original_resource_name << kGroupKeyword << group_id.Hex();
+    result = absl::StrCat(original_resource_name, kGroupKeyword, group_id_hex);
   }
-  std::string result = os.str();
   RAY_DCHECK(GetOriginalResourceName(result) == original_resource_name)
       << "Generated: " << GetOriginalResourceName(result)
       << " Original: " << original_resource_name;
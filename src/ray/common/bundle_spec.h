@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/function_descriptor.h"
 #include "ray/common/grpc_util.h"
@@ -72,6 +73,26 @@ class BundleSpecification : public MessageWrapper<rpc::Bundle> {
     return bundle_resource_labels_;
   }
 
+  /// A placement group bundle resource label, as a resource id.
+  struct FormattedResource {
+    scheduling::ResourceID id;
+    /// The resource that the label is formatted from, or nil for the bundle resource.
+    scheduling::ResourceID original_id;
+    double value;
+  };
+
+  /// Get all placement group bundle resource labels, as resource ids. These are
+  /// computed once, so that committing and returning the bundle doesn't format and
+  /// look up the labels again.
+  const std::vector<FormattedResource> &GetFormattedResourceIds() const {
+    return bundle_resource_ids_;
+  }
+
+  /// Get all placement group bundle resource labels, as a resource request.
+  const ResourceRequest &GetFormattedResourceRequest() const {
+    return bundle_resource_request_;
+  }
+
   std::string DebugString() const;
 
  private:
@@ -90,6 +111,12 @@ class BundleSpecification : public MessageWrapper<rpc::Bundle> {
   /// 2) `CPU_group_${bundle_index}_${group_id}`: this is the requested resource
   /// when the actor or task specifies placement group with bundle id.
   absl::flat_hash_map<std::string, double> bundle_resource_labels_;
+
+  /// The resource ids of `bundle_resource_labels_`.
+  std::vector<FormattedResource> bundle_resource_ids_;
+
+  /// `bundle_resource_labels_` as a resource request.
+  ResourceRequest bundle_resource_request_;
 };
 
 /// Format a placement group resource, e.g., CPU -> CPU_group_i
@@ -101,6 +128,12 @@ std::string FormatPlacementGroupResource(const std::string &original_resource_na
 std::string FormatPlacementGroupResource(const std::string &original_resource_name,
                                          const BundleSpecification &bundle_spec);
 
+/// Format a placement group resource from the hex of the group id, so that callers
+/// that format several resources of the same group only compute the hex once.
+std::string FormatPlacementGroupResource(const std::string &original_resource_name,
+                                         absl::string_view group_id_hex,
+                                         int64_t bundle_index);
+
 /// Return whether a formatted resource is a bundle of the given index.
 bool IsBundleIndex(const std::string &resource,
                    const PlacementGroupID &group_id,
@@ -14,6 +14,7 @@
 
 #include "ray/common/client_connection.h"
 
+#include <algorithm>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/generic/stream_protocol.hpp>
 #include <boost/asio/placeholders.hpp>
@@ -21,6 +22,7 @@
 #include <boost/asio/write.hpp>
 #include <boost/bind/bind.hpp>
 #include <chrono>
+#include <cstring>
 #include <sstream>
 #include <thread>
 
@@ -68,9 +70,17 @@ std::shared_ptr<ServerConnection> ServerConnection::Create(local_stream_socket &
   return self;
 }
 
+namespace {
+
+/// The largest write buffer that is kept for reuse once its message is written.
+constexpr size_t kMaxReusedWriteBufferSize = 4096;
+
+}  // namespace
+
 ServerConnection::ServerConnection(local_stream_socket &&socket)
     : socket_(std::move(socket)),
-      async_write_max_messages_(1),
+      async_write_max_messages_(std::max<int64_t>(
+          1, RayConfig::instance().client_connection_max_coalesced_writes())),
       async_write_queue_(),
       async_write_in_flight_(false),
       async_write_broken_pipe_(false) {}
@@ -85,23 +95,35 @@ ServerConnection::~ServerConnection() {
 Status ServerConnection::WriteBuffer(
     const std::vector<boost::asio::const_buffer> &buffer) {
   boost::system::error_code error;
-  // Loop until all bytes are written while handling interrupts.
+  // Write all the buffers with a single vectored write when possible, and loop until all
+  // bytes are written while handling interrupts.
   // When profiling with pprof, unhandled interrupts were being sent by the profiler to
   // the raylet process, which was causing synchronous reads and writes to fail.
+  std::vector<boost::asio::const_buffer> remaining;
+  remaining.reserve(buffer.size());
   for (const auto &b : buffer) {
-    uint64_t bytes_remaining = boost::asio::buffer_size(b);
-    uint64_t position = 0;
-    while (bytes_remaining != 0) {
-      size_t bytes_written =
-          socket_.write_some(boost::asio::buffer(b + position, bytes_remaining), error);
-      position += bytes_written;
-      bytes_remaining -= bytes_written;
-      if (error.value() == EINTR) {
-        continue;
-      } else if (error.value() != boost::system::errc::errc_t::success) {
-        return boost_to_ray_status(error);
+    if (b.size() > 0) {
+      remaining.push_back(b);
+    }
+  }
+  while (!remaining.empty()) {
+    size_t bytes_written = socket_.write_some(remaining, error);
+    // Drop the bytes that were written from the front of the buffers.
+    auto it = remaining.begin();
+    while (bytes_written > 0) {
+      const size_t consumed = std::min(bytes_written, it->size());
+      *it += consumed;
+      bytes_written -= consumed;
+      if (it->size() == 0) {
+        it++;
       }
     }
+    remaining.erase(remaining.begin(), it);
+    if (error.value() == EINTR) {
+      continue;
+    } else if (error.value() != boost::system::errc::errc_t::success) {
+      return boost_to_ray_status(error);
+    }
   }
   return ray::Status::OK();
 }
@@ -138,20 +160,31 @@ Status ServerConnection::ReadBuffer(
     const std::vector<boost::asio::mutable_buffer> &buffer) {
   boost::system::error_code error;
   // Loop until all bytes are read while handling interrupts.
+  std::vector<boost::asio::mutable_buffer> remaining;
+  remaining.reserve(buffer.size());
   for (const auto &b : buffer) {
-    uint64_t bytes_remaining = boost::asio::buffer_size(b);
-    uint64_t position = 0;
-    while (bytes_remaining != 0) {
-      size_t bytes_read =
-          socket_.read_some(boost::asio::buffer(b + position, bytes_remaining), error);
-      position += bytes_read;
-      bytes_remaining -= bytes_read;
-      if (error.value() == EINTR) {
-        continue;
-      } else if (error.value() != boost::system::errc::errc_t::success) {
-        return boost_to_ray_status(error);
+    if (b.size() > 0) {
+      remaining.push_back(b);
+    }
+  }
+  while (!remaining.empty()) {
+    size_t bytes_read = socket_.read_some(remaining, error);
+    // Drop the bytes that were read from the front of the buffers.
+    auto it = remaining.begin();
+    while (bytes_read > 0) {
+      const size_t consumed = std::min(bytes_read, it->size());
+      *it += consumed;
+      bytes_read -= consumed;
+      if (it->size() == 0) {
+        it++;
       }
     }
+    remaining.erase(remaining.begin(), it);
+    if (error.value() == EINTR) {
+      continue;
+    } else if (error.value() != boost::system::errc::errc_t::success) {
+      return boost_to_ray_status(error);
+    }
   }
   return Status::OK();
 }
@@ -190,37 +223,38 @@ ray::Status ServerConnection::WriteMessage(int64_t type,
   sync_writes_ += 1;
   bytes_written_ += length;
 
-  auto write_cookie = RayConfig::instance().ray_cookie();
+  MessageHeader header{RayConfig::instance().ray_cookie(), type, length};
   return WriteBuffer({
-      boost::asio::buffer(&write_cookie, sizeof(write_cookie)),
-      boost::asio::buffer(&type, sizeof(type)),
-      boost::asio::buffer(&length, sizeof(length)),
+      boost::asio::buffer(&header, sizeof(header)),
       boost::asio::buffer(message, length),
   });
 }
 
 Status ServerConnection::ReadMessage(int64_t type, std::vector<uint8_t> *message) {
-  int64_t read_cookie, read_type, read_length;
-  // Wait for a message header from the client. The message header includes the
-  // protocol version, the message type, and the length of the message.
-  RAY_RETURN_NOT_OK(ReadBuffer({
-      boost::asio::buffer(&read_cookie, sizeof(read_cookie)),
-      boost::asio::buffer(&read_type, sizeof(read_type)),
-      boost::asio::buffer(&read_length, sizeof(read_length)),
-  }));
-  if (read_cookie != RayConfig::instance().ray_cookie()) {
+  int64_t received_type;
+  RAY_RETURN_NOT_OK(ReadAnyMessage(&received_type, message));
+  if (type != received_type) {
     std::ostringstream ss;
-    ss << "Ray cookie mismatch for received message. "
-       << "Received cookie: " << read_cookie;
+    ss << "Connection corrupted. Expected message type: " << type
+       << ", receviced message type: " << received_type;
     return Status::IOError(ss.str());
   }
-  if (type != read_type) {
+  return Status::OK();
+}
+
+Status ServerConnection::ReadAnyMessage(int64_t *type, std::vector<uint8_t> *message) {
+  MessageHeader header;
+  // Wait for a message header from the client. The message header includes the
+  // protocol version, the message type, and the length of the message.
+  RAY_RETURN_NOT_OK(ReadBuffer({boost::asio::buffer(&header, sizeof(header))}));
+  if (header.cookie != RayConfig::instance().ray_cookie()) {
     std::ostringstream ss;
-    ss << "Connection corrupted. Expected message type: " << type
-       << ", receviced message type: " << read_type;
+    ss << "Ray cookie mismatch for received message. "
+       << "Received cookie: " << header.cookie;
     return Status::IOError(ss.str());
   }
-  message->resize(read_length);
+  *type = header.type;
+  message->resize(header.length);
   return ReadBuffer({boost::asio::buffer(*message)});
 }
 
@@ -232,12 +266,19 @@ void ServerConnection::WriteMessageAsync(
   async_writes_ += 1;
   bytes_written_ += length;
 
-  auto write_buffer = std::make_unique<AsyncWriteBuffer>();
-  write_buffer->write_cookie = RayConfig::instance().ray_cookie();
-  write_buffer->write_type = type;
-  write_buffer->write_length = length;
-  write_buffer->write_message.resize(length);
-  write_buffer->write_message.assign(message, message + length);
+  std::unique_ptr<AsyncWriteBuffer> write_buffer;
+  if (free_write_buffers_.empty()) {
+    write_buffer = std::make_unique<AsyncWriteBuffer>();
+  } else {
+    write_buffer = std::move(free_write_buffers_.back());
+    free_write_buffers_.pop_back();
+  }
+  MessageHeader header{RayConfig::instance().ray_cookie(), type, length};
+  write_buffer->data.resize(sizeof(header) + length);
+  std::memcpy(write_buffer->data.data(), &header, sizeof(header));
+  if (length > 0) {
+    std::memcpy(write_buffer->data.data() + sizeof(header), message, length);
+  }
   write_buffer->handler = handler;
 
   auto size = async_write_queue_.size();
@@ -262,13 +303,7 @@ void ServerConnection::DoAsyncWrites() {
   std::vector<boost::asio::const_buffer> message_buffers;
   int num_messages = 0;
   for (const auto &write_buffer : async_write_queue_) {
-    message_buffers.push_back(boost::asio::buffer(&write_buffer->write_cookie,
-                                                  sizeof(write_buffer->write_cookie)));
-    message_buffers.push_back(
-        boost::asio::buffer(&write_buffer->write_type, sizeof(write_buffer->write_type)));
-    message_buffers.push_back(boost::asio::buffer(&write_buffer->write_length,
-                                                  sizeof(write_buffer->write_length)));
-    message_buffers.push_back(boost::asio::buffer(write_buffer->write_message));
+    message_buffers.push_back(boost::asio::buffer(write_buffer->data));
     num_messages++;
     if (num_messages >= async_write_max_messages_) {
       break;
@@ -281,6 +316,12 @@ void ServerConnection::DoAsyncWrites() {
       auto write_buffer = std::move(async_write_queue_.front());
       write_buffer->handler(status);
       async_write_queue_.pop_front();
+      if (write_buffer->data.capacity() <= kMaxReusedWriteBufferSize &&
+          free_write_buffers_.size() < static_cast<size_t>(async_write_max_messages_)) {
+        // Don't keep whatever the handler captured alive.
+        write_buffer->handler = nullptr;
+        free_write_buffers_.push_back(std::move(write_buffer));
+      }
     }
     // We finished writing, so mark that we're no longer doing an async write.
     async_write_in_flight_ = false;
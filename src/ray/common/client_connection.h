@@ -77,6 +77,13 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
   /// \return Status.
   Status ReadMessage(int64_t type, std::vector<uint8_t> *message);
 
+  /// Read the next message from the client, whatever its type.
+  ///
+  /// \param type Set to the message type.
+  /// \param message A pointer to the message buffer.
+  /// \return Status.
+  Status ReadAnyMessage(int64_t *type, std::vector<uint8_t> *message);
+
   /// Write a buffer to this connection.
   ///
   /// \param buffer The buffer.
@@ -127,12 +134,20 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
   /// A private constructor for a server connection.
   ServerConnection(local_stream_socket &&socket);
 
-  /// A message that is queued for writing asynchronously.
+  /// The header that precedes every message on a connection.
+  struct MessageHeader {
+    int64_t cookie;
+    int64_t type;
+    int64_t length;
+  };
+  static_assert(sizeof(MessageHeader) == 3 * sizeof(int64_t),
+                "The message header must match the wire format.");
+
+  /// A message that is queued for writing asynchronously. The header and the message are
+  /// stored contiguously, so that each message is a single buffer of the vectored write
+  /// that flushes the queue.
   struct AsyncWriteBuffer {
-    int64_t write_cookie;
-    int64_t write_type;
-    uint64_t write_length;
-    std::vector<uint8_t> write_message;
+    std::vector<uint8_t> data;
     std::function<void(const ray::Status &)> handler;
   };
 
@@ -145,6 +160,10 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
   /// List of pending messages to write.
   std::deque<std::unique_ptr<AsyncWriteBuffer>> async_write_queue_;
 
+  /// Buffers of messages that were written, kept to be reused by later messages so that
+  /// bursts of small messages don't allocate.
+  std::vector<std::unique_ptr<AsyncWriteBuffer>> free_write_buffers_;
+
   /// Whether we are in the middle of an async write.
   bool async_write_in_flight_;
 
@@ -51,5 +51,11 @@ constexpr int kMessagePackOffset = 9;
 /// Should be kept in sync with SETUP_WORKER_FILENAME in ray.ray_constants.
 constexpr char kSetupWorkerFilename[] = "setup_worker.py";
 
+/// Filename of the default Python worker, which the worker forkserver can start.
+constexpr char kDefaultWorkerFilename[] = "default_worker.py";
+
+/// Filename of the worker forkserver, which lives next to the default worker.
+constexpr char kForkserverFilename[] = "forkserver.py";
+
 /// The version of Ray
 constexpr char kRayVersion[] = "2.0.0.dev0";
@@ -0,0 +1,195 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/cpu_profiler.h"
+
+#ifdef __linux__
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+#ifdef __linux__
+
+namespace {
+
+/// The maximum number of frames of a sampled call stack.
+constexpr int kMaxDepth = 64;
+/// The maximum number of samples of a profile, e.g. 16 seconds of a fully busy
+/// thread at 1000 samples per second. Later samples are dropped.
+constexpr size_t kMaxSamples = 1 << 14;
+/// The frames of the signal handler at the top of the sampled call stacks.
+constexpr int kNumHandlerFrames = 2;
+
+/// A call stack sampled by the signal handler.
+struct Sample {
+  int depth;
+  void *pcs[kMaxDepth];
+};
+
+/// The samples, allocated while a profile is being taken.
+std::unique_ptr<Sample[]> sample_buffer;
+
+// The state shared with the signal handler, which can only use lock-free atomics.
+std::atomic<Sample *> samples{nullptr};
+std::atomic<size_t> num_samples{0};
+std::atomic<int> num_running_handlers{0};
+struct sigaction previous_action;
+
+/// Append words of the legacy pprof CPU profile format to the profile.
+void AppendWords(std::string *profile, std::initializer_list<uintptr_t> words) {
+  for (uintptr_t word : words) {
+    profile->append(reinterpret_cast<const char *>(&word), sizeof(word));
+  }
+}
+
+void HandleProfilingSignal(int signal, siginfo_t *info, void *context) {
+  const int saved_errno = errno;
+  num_running_handlers.fetch_add(1);
+  auto *sample_array = samples.load();
+  if (sample_array != nullptr) {
+    const size_t index = num_samples.fetch_add(1, std::memory_order_relaxed);
+    if (index < kMaxSamples) {
+      auto &sample = sample_array[index];
+      sample.depth = backtrace(sample.pcs, kMaxDepth);
+    }
+  }
+  num_running_handlers.fetch_sub(1);
+  errno = saved_errno;
+}
+
+}  // namespace
+
+CpuProfiler &CpuProfiler::Instance() {
+  static auto *profiler = new CpuProfiler();
+  return *profiler;
+}
+
+Status CpuProfiler::Start(int64_t frequency) {
+  absl::MutexLock lock(&mutex_);
+  if (running_) {
+    return Status::Invalid("A CPU profile is already being taken.");
+  }
+  if (frequency <= 0 || frequency > 1000) {
+    return Status::Invalid("The sampling frequency must be between 1 and 1000.");
+  }
+  // backtrace() loads the unwinder the first time it's called, which allocates and
+  // isn't safe in a signal handler.
+  void *pcs[1];
+  RAY_UNUSED(backtrace(pcs, 1));
+
+  running_ = true;
+  sample_buffer.reset(new Sample[kMaxSamples]);
+  num_samples = 0;
+  samples = sample_buffer.get();
+  struct sigaction action = {};
+  action.sa_sigaction = HandleProfilingSignal;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  RAY_CHECK(sigaction(SIGPROF, &action, &previous_action) == 0);
+
+  period_us_ = 1000000 / frequency;
+  struct itimerval timer;
+  timer.it_interval.tv_sec = period_us_ / 1000000;
+  timer.it_interval.tv_usec = period_us_ % 1000000;
+  timer.it_value = timer.it_interval;
+  RAY_CHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+  return Status::OK();
+}
+
+Status CpuProfiler::Stop(std::string *profile) {
+  absl::MutexLock lock(&mutex_);
+  if (!running_) {
+    return Status::Invalid("No CPU profile is being taken.");
+  }
+  running_ = false;
+  struct itimerval timer = {};
+  RAY_CHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+  // Stop the handlers from writing samples, and wait for the ones that may still be
+  // writing on other threads before reading the samples.
+  samples = nullptr;
+  while (num_running_handlers.load() > 0) {
+    std::this_thread::yield();
+  }
+  RAY_CHECK(sigaction(SIGPROF, &previous_action, nullptr) == 0);
+
+  const size_t total_samples = num_samples.load();
+  if (total_samples > kMaxSamples) {
+    RAY_LOG(WARNING) << "Dropped " << total_samples - kMaxSamples << " of "
+                     << total_samples << " CPU profile samples.";
+  }
+  std::map<std::vector<uintptr_t>, uintptr_t> stack_counts;
+  for (size_t i = 0; i < std::min(total_samples, kMaxSamples); i++) {
+    const auto &sample = sample_buffer[i];
+    if (sample.depth <= kNumHandlerFrames) {
+      continue;
+    }
+    std::vector<uintptr_t> stack;
+    for (int j = kNumHandlerFrames; j < sample.depth; j++) {
+      stack.push_back(reinterpret_cast<uintptr_t>(sample.pcs[j]));
+    }
+    stack_counts[std::move(stack)]++;
+  }
+  sample_buffer.reset();
+
+  // The format is described in docs/cpuprofile-fileformat.html of gperftools.
+  profile->clear();
+  AppendWords(profile, {0, 3, 0, static_cast<uintptr_t>(period_us_), 0});
+  for (const auto &entry : stack_counts) {
+    AppendWords(profile, {entry.second, entry.first.size()});
+    for (uintptr_t pc : entry.first) {
+      AppendWords(profile, {pc});
+    }
+  }
+  AppendWords(profile, {0, 1, 0});
+  // The memory mappings tell pprof which binary or library every address is in.
+  std::ifstream maps("/proc/self/maps");
+  std::stringstream buffer;
+  buffer << maps.rdbuf();
+  profile->append(buffer.str());
+  return Status::OK();
+}
+
+#else
+
+CpuProfiler &CpuProfiler::Instance() {
+  static auto *profiler = new CpuProfiler();
+  return *profiler;
+}
+
+Status CpuProfiler::Start(int64_t frequency) {
+  return Status::NotImplemented("CPU profiling is only supported on Linux.");
+}
+
+Status CpuProfiler::Stop(std::string *profile) {
+  return Status::Invalid("No CPU profile is being taken.");
+}
+
+#endif
+
+}  // namespace ray
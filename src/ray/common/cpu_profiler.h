@@ -0,0 +1,61 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "absl/synchronization/mutex.h"
+#include "ray/common/status.h"
+
+namespace ray {
+
+/// \class CpuProfiler
+/// Samples the call stacks of the threads of this process as they use CPU, so that a
+/// running raylet or GCS server can be profiled on demand without external tools.
+/// Like gperftools, samples are taken by a SIGPROF handler at a frequency of CPU
+/// time, and the profile is in the legacy pprof CPU profile format, which `pprof`
+/// symbolizes with the binary. There is a single profiler per process, because the
+/// profiling timer and signal are process-wide. Only supported on Linux.
+class CpuProfiler {
+ public:
+  /// Get the profiler of this process.
+  static CpuProfiler &Instance();
+
+  /// Start taking samples.
+  ///
+  /// \param frequency The number of samples to take per second of CPU time, at most
+  /// 1000.
+  /// \return Invalid if a profile is already being taken or the frequency is out of
+  /// range, NotImplemented if profiling isn't supported on this platform.
+  Status Start(int64_t frequency) LOCKS_EXCLUDED(mutex_);
+
+  /// Stop taking samples.
+  ///
+  /// \param[out] profile The profile of the samples taken since Start.
+  /// \return Invalid if no profile is being taken.
+  Status Stop(std::string *profile) LOCKS_EXCLUDED(mutex_);
+
+ private:
+  CpuProfiler() = default;
+
+  absl::Mutex mutex_;
+  /// Whether a profile is being taken.
+  bool running_ GUARDED_BY(mutex_) = false;
+  /// The sampling period, in microseconds.
+  int64_t period_us_ GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace ray
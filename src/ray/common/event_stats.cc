@@ -29,16 +29,14 @@ namespace {
 /// This acquires a reader lock on the provided global stats, and creates a
 /// lockless copy of the stats.
 GlobalStats to_global_stats_view(std::shared_ptr<GuardedGlobalStats> stats) {
-  absl::MutexLock lock(&(stats->mutex));
-  return GlobalStats(stats->stats);
+  return stats->Merge();
 }
 
 /// A helper for creating a snapshot view of the stats for a event.
 /// This acquires a lock on the provided guarded event stats, and creates a
 /// lockless copy of the stats.
 EventStats to_event_stats_view(std::shared_ptr<GuardedEventStats> stats) {
-  absl::MutexLock lock(&(stats->mutex));
-  return EventStats(stats->stats);
+  return stats->Merge();
 }
 
 /// A helper for converting a duration into a human readable string, such as "5.346 ms".
@@ -59,17 +57,47 @@ std::string to_human_readable(int64_t duration) {
 
 }  // namespace
 
+size_t GetEventStatsShard() {
+  static std::atomic<size_t> next_shard(0);
+  thread_local const size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kNumEventStatsShards;
+  return shard;
+}
+
+EventStats GuardedEventStats::Merge() const {
+  EventStats result;
+  for (const auto &shard : shards) {
+    absl::MutexLock lock(&shard.mutex);
+    result.cum_count += shard.stats.cum_count;
+    result.curr_count += shard.stats.curr_count;
+    result.cum_execution_time += shard.stats.cum_execution_time;
+    result.running_count += shard.stats.running_count;
+  }
+  return result;
+}
+
+GlobalStats GuardedGlobalStats::Merge() const {
+  GlobalStats result;
+  for (const auto &shard : shards) {
+    absl::MutexLock lock(&shard.mutex);
+    result.cum_queue_time += shard.stats.cum_queue_time;
+    result.min_queue_time = std::min(result.min_queue_time, shard.stats.min_queue_time);
+    result.max_queue_time = std::max(result.max_queue_time, shard.stats.max_queue_time);
+  }
+  return result;
+}
+
+std::atomic<uint64_t> EventTracker::next_tracker_id_(0);
+
 std::shared_ptr<StatsHandle> EventTracker::RecordStart(
     const std::string &name, int64_t expected_queueing_delay_ns) {
   auto stats = GetOrCreate(name);
-  int64_t curr_count = 0;
   {
-    absl::MutexLock lock(&(stats->mutex));
-    stats->stats.cum_count++;
-    curr_count = ++stats->stats.curr_count;
+    auto &shard = stats->ThreadShard();
+    absl::MutexLock lock(&shard.mutex);
+    shard.stats.cum_count++;
+    shard.stats.curr_count++;
   }
-  ray::stats::STATS_operation_count.Record(curr_count, name);
-  ray::stats::STATS_operation_active_count.Record(curr_count, name);
   return std::make_shared<StatsHandle>(
       name,
       absl::GetCurrentTimeNanos() + expected_queueing_delay_ns,
@@ -82,9 +110,9 @@ void EventTracker::RecordExecution(const std::function<void()> &fn,
   int64_t start_execution = absl::GetCurrentTimeNanos();
   // Update running count
   {
-    auto &stats = handle->handler_stats;
-    absl::MutexLock lock(&(stats->mutex));
-    stats->stats.running_count++;
+    auto &shard = handle->handler_stats->ThreadShard();
+    absl::MutexLock lock(&shard.mutex);
+    shard.stats.running_count++;
   }
   // Execute actual function.
   fn();
@@ -94,38 +122,48 @@ void EventTracker::RecordExecution(const std::function<void()> &fn,
   // Update event-specific stats.
   ray::stats::STATS_operation_run_time_ms.Record(execution_time_ns / 1000000,
                                                  handle->event_name);
-  int64_t curr_count;
   {
-    auto &stats = handle->handler_stats;
-    absl::MutexLock lock(&(stats->mutex));
+    auto &shard = handle->handler_stats->ThreadShard();
+    absl::MutexLock lock(&shard.mutex);
     // Event-specific execution stats.
-    stats->stats.cum_execution_time += execution_time_ns;
+    shard.stats.cum_execution_time += execution_time_ns;
     // Event-specific current count.
-    curr_count = --stats->stats.curr_count;
+    shard.stats.curr_count--;
     // Event-specific running count.
-    stats->stats.running_count--;
+    shard.stats.running_count--;
   }
-  ray::stats::STATS_operation_active_count.Record(curr_count, handle->event_name);
   // Update global stats.
   const auto queue_time_ns = start_execution - handle->start_time;
   ray::stats::STATS_operation_queue_time_ms.Record(queue_time_ns / 1000000,
                                                    handle->event_name);
   {
-    auto global_stats = handle->global_stats;
-    absl::MutexLock lock(&(global_stats->mutex));
+    auto &shard = handle->global_stats->ThreadShard();
+    absl::MutexLock lock(&shard.mutex);
     // Global queue stats.
-    global_stats->stats.cum_queue_time += queue_time_ns;
-    if (global_stats->stats.min_queue_time > queue_time_ns) {
-      global_stats->stats.min_queue_time = queue_time_ns;
+    shard.stats.cum_queue_time += queue_time_ns;
+    if (shard.stats.min_queue_time > queue_time_ns) {
+      shard.stats.min_queue_time = queue_time_ns;
     }
-    if (global_stats->stats.max_queue_time < queue_time_ns) {
-      global_stats->stats.max_queue_time = queue_time_ns;
+    if (shard.stats.max_queue_time < queue_time_ns) {
+      shard.stats.max_queue_time = queue_time_ns;
     }
   }
   handle->execution_recorded = true;
 }
 
 std::shared_ptr<GuardedEventStats> EventTracker::GetOrCreate(const std::string &name) {
+  // The stats of the trackers that this thread has recorded events for. The stats of a
+  // tracker that is destroyed are kept until the thread exits, which is fine since
+  // there are few trackers per process.
+  thread_local absl::flat_hash_map<
+      uint64_t,
+      absl::flat_hash_map<std::string, std::shared_ptr<GuardedEventStats>>>
+      thread_cache;
+  auto &cache = thread_cache[tracker_id_];
+  auto cache_it = cache.find(name);
+  if (cache_it != cache.end()) {
+    return cache_it->second;
+  }
   // Get this event's stats.
   std::shared_ptr<GuardedEventStats> result;
   mutex_.ReaderLock();
@@ -145,6 +183,7 @@ std::shared_ptr<GuardedEventStats> EventTracker::GetOrCreate(const std::string &
     result = it->second;
     mutex_.ReaderUnlock();
   }
+  cache.emplace(name, result);
   return result;
 }
 
@@ -195,6 +234,11 @@ std::string EventTracker::StatsString() const {
   int64_t cum_execution_time = 0;
   std::stringstream event_stats_stream;
   for (const auto &entry : stats) {
+    // The counts are only known once the shards are merged, so they are exported here
+    // rather than when each event starts and finishes.
+    ray::stats::STATS_operation_count.Record(entry.second.curr_count, entry.first);
+    ray::stats::STATS_operation_active_count.Record(entry.second.curr_count,
+                                                    entry.first);
     cum_count += entry.second.cum_count;
     curr_count += entry.second.curr_count;
     cum_execution_time += entry.second.cum_execution_time;
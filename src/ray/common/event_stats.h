@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <boost/asio.hpp>
 #include <limits>
 
@@ -41,26 +43,52 @@ struct GlobalStats {
   int64_t max_queue_time = -1;
 };
 
+/// The number of shards that the stats are split into. Each thread writes to the
+/// shard it's assigned, so that the threads that run events don't contend on the
+/// same mutex, and the shards are merged when the stats are read.
+constexpr size_t kNumEventStatsShards = 16;
+
+/// Returns the index of the stats shard that the calling thread writes to.
+size_t GetEventStatsShard();
+
 /// A mutex wrapper around a handler stats struct.
 struct GuardedEventStats {
-  // Stats for some handler.
-  EventStats stats GUARDED_BY(mutex);
+  struct alignas(64) Shard {
+    // Stats for some handler, as recorded by the threads assigned to this shard. Only
+    // the sum over all shards is meaningful, e.g., the current count of a shard is
+    // negative if its threads finished events that were started by other threads.
+    EventStats stats GUARDED_BY(mutex);
+
+    // The mutex protecting the reading and writing of these stats.
+    mutable absl::Mutex mutex;
+  };
+
+  // Returns the shard that the calling thread writes to.
+  Shard &ThreadShard() { return shards[GetEventStatsShard()]; }
+
+  // Returns the stats, merged over all shards.
+  EventStats Merge() const;
 
-  // The mutex protecting the reading and writing of these stats.
-  // This mutex should be acquired with a reader lock before reading, and should be
-  // acquired with a writer lock before writing.
-  mutable absl::Mutex mutex;
+  std::array<Shard, kNumEventStatsShards> shards;
 };
 
 /// A mutex wrapper around a handler stats struct.
 struct GuardedGlobalStats {
-  // Stats over all handlers.
-  GlobalStats stats GUARDED_BY(mutex);
+  struct alignas(64) Shard {
+    // Stats over all handlers, as recorded by the threads assigned to this shard.
+    GlobalStats stats GUARDED_BY(mutex);
 
-  // The mutex protecting the reading and writing of these stats.
-  // This mutex should be acquired with a reader lock before reading, and should be
-  // acquired with a writer lock before writing.
-  mutable absl::Mutex mutex;
+    // The mutex protecting the reading and writing of these stats.
+    mutable absl::Mutex mutex;
+  };
+
+  // Returns the shard that the calling thread writes to.
+  Shard &ThreadShard() { return shards[GetEventStatsShard()]; }
+
+  // Returns the stats, merged over all shards.
+  GlobalStats Merge() const;
+
+  std::array<Shard, kNumEventStatsShards> shards;
 };
 
 /// An opaque stats handle, used to manually instrument event handlers.
@@ -87,8 +115,9 @@ struct StatsHandle {
     if (!execution_recorded) {
       // If handler execution was never recorded, we need to clean up some queueing
       // stats in order to prevent those stats from leaking.
-      absl::MutexLock lock(&(handler_stats->mutex));
-      handler_stats->stats.curr_count--;
+      auto &shard = handler_stats->ThreadShard();
+      absl::MutexLock lock(&shard.mutex);
+      shard.stats.curr_count--;
     }
   }
 };
@@ -96,7 +125,9 @@ struct StatsHandle {
 class EventTracker {
  public:
   /// Initializes the global stats struct after calling the base constructor.
-  EventTracker() : global_stats_(std::make_shared<GuardedGlobalStats>()) {}
+  EventTracker()
+      : global_stats_(std::make_shared<GuardedGlobalStats>()),
+        tracker_id_(next_tracker_id_.fetch_add(1, std::memory_order_relaxed)) {}
 
   /// Sets the queueing start time, increments the current and cumulative counts and
   /// returns an opaque handle for these stats. This is used in conjunction with
@@ -144,6 +175,7 @@ class EventTracker {
 
   /// Builds and returns a statistics summary string. Used by the DebugString() of
   /// objects that used this io_context wrapper, such as the raylet and the core worker.
+  /// The current counts of the events are also exported as metrics.
   ///
   /// \return A stats summary string, suitable for inclusion in an object's
   /// DebugString().
@@ -155,6 +187,9 @@ class EventTracker {
   /// Get the mutex-guarded stats for this event if it exists, otherwise create the
   /// stats for this handler and return an iterator pointing to it.
   ///
+  /// The stats are cached by each thread, so that looking up the stats of an event
+  /// the thread has seen before doesn't take the table lock.
+  ///
   /// \param name A human-readable name for the handler, to be used for viewing stats
   /// for the provided handler.
   std::shared_ptr<GuardedEventStats> GetOrCreate(const std::string &name);
@@ -162,6 +197,11 @@ class EventTracker {
   /// Global stats, across all handlers.
   std::shared_ptr<GuardedGlobalStats> global_stats_;
 
+  /// The ID that the stats of this tracker are cached by. Unlike the address of the
+  /// tracker, it isn't reused after the tracker is destroyed.
+  const uint64_t tracker_id_;
+  static std::atomic<uint64_t> next_tracker_id_;
+
   /// Table of per-handler post stats.
   /// We use a std::shared_ptr value in order to ensure pointer stability.
   EventStatsTable post_handler_stats_ GUARDED_BY(mutex_);
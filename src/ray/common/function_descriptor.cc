@@ -48,12 +48,14 @@ FunctionDescriptor FunctionDescriptorBuilder::BuildPython(
 
 FunctionDescriptor FunctionDescriptorBuilder::BuildCpp(const std::string &function_name,
                                                        const std::string &caller,
-                                                       const std::string &class_name) {
+                                                       const std::string &class_name,
+                                                       uint64_t function_id) {
   rpc::FunctionDescriptor descriptor;
   auto typed_descriptor = descriptor.mutable_cpp_function_descriptor();
   typed_descriptor->set_function_name(function_name);
   typed_descriptor->set_caller(caller);
   typed_descriptor->set_class_name(class_name);
+  typed_descriptor->set_function_id(function_id);
   return ray::FunctionDescriptor(new CppFunctionDescriptor(std::move(descriptor)));
 }
 
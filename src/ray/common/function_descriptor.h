@@ -262,6 +262,8 @@ class CppFunctionDescriptor : public FunctionDescriptorInterface {
 
   const std::string &ClassName() const { return typed_message_->class_name(); }
 
+  uint64_t FunctionId() const { return typed_message_->function_id(); }
+
  private:
   const rpc::CppFunctionDescriptor *typed_message_;
 };
@@ -329,7 +331,8 @@ class FunctionDescriptorBuilder {
   /// \return a ray::CppFunctionDescriptor
   static FunctionDescriptor BuildCpp(const std::string &function_name,
                                      const std::string &caller = "",
-                                     const std::string &class_name = "");
+                                     const std::string &class_name = "",
+                                     uint64_t function_id = 0);
 
   /// Build a ray::FunctionDescriptor according to input message.
   ///
@@ -46,6 +46,32 @@ using ObjectIDIndexType = uint32_t;
 // Declaration.
 uint64_t MurmurHash64A(const void *key, int len, unsigned int seed);
 
+/// Hash the bytes of an ID. IDs are mostly random bytes, so instead of a general
+/// purpose hash, each 8-byte word is folded in with a multiply and the result is
+/// finalized once. This is cheap enough that the hash isn't cached, and it still mixes
+/// in every byte, as some IDs only differ in their last bytes, e.g., the object IDs of
+/// the same task.
+inline uint64_t HashIDBytes(const uint8_t *data, size_t size) {
+  constexpr uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  uint64_t hash = size * kMul;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * kMul;
+    hash ^= hash >> 47;
+  }
+  if (i < size) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + i, size - i);
+    hash = (hash ^ word) * kMul;
+    hash ^= hash >> 47;
+  }
+  hash *= kMul;
+  hash ^= hash >> 47;
+  return hash;
+}
+
 // Change the compiler alignment to 1 byte (default is 8).
 #pragma pack(push, 1)
 
@@ -80,12 +106,9 @@ class BaseID {
         << binary.size();
     std::memcpy(const_cast<uint8_t *>(this->Data()), binary.data(), binary.size());
   }
-  // All IDs are immutable for hash evaluations. MutableData is only allow to use
-  // in construction time, so this function is protected.
+  // MutableData is only allow to use in construction time, so this function is
+  // protected.
   uint8_t *MutableData();
-  // For lazy evaluation, be careful to have one Id contained in another.
-  // This hash code will be duplicated.
-  mutable size_t hash_ = 0;
 };
 
 class UniqueID : public BaseID<UniqueID> {
@@ -368,15 +391,11 @@ class PlacementGroupID : public BaseID<PlacementGroupID> {
 
 typedef std::pair<PlacementGroupID, int64_t> BundleID;
 
-static_assert(sizeof(JobID) == JobID::kLength + sizeof(size_t),
-              "JobID size is not as expected");
-static_assert(sizeof(ActorID) == ActorID::kLength + sizeof(size_t),
-              "ActorID size is not as expected");
-static_assert(sizeof(TaskID) == TaskID::kLength + sizeof(size_t),
-              "TaskID size is not as expected");
-static_assert(sizeof(ObjectID) == ObjectID::kLength + sizeof(size_t),
-              "ObjectID size is not as expected");
-static_assert(sizeof(PlacementGroupID) == PlacementGroupID::kLength + sizeof(size_t),
+static_assert(sizeof(JobID) == JobID::kLength, "JobID size is not as expected");
+static_assert(sizeof(ActorID) == ActorID::kLength, "ActorID size is not as expected");
+static_assert(sizeof(TaskID) == TaskID::kLength, "TaskID size is not as expected");
+static_assert(sizeof(ObjectID) == ObjectID::kLength, "ObjectID size is not as expected");
+static_assert(sizeof(PlacementGroupID) == PlacementGroupID::kLength,
               "PlacementGroupID size is not as expected");
 
 std::ostream &operator<<(std::ostream &os, const UniqueID &id);
@@ -416,8 +435,6 @@ std::ostream &operator<<(std::ostream &os, const PlacementGroupID &id);
 
 template <typename T>
 BaseID<T>::BaseID() {
-  // Using const_cast to directly change data is dangerous. The cached
-  // hash may not be changed. This is used in construction time.
   std::fill_n(this->MutableData(), T::Size(), 0xff);
 }
 
@@ -490,12 +507,7 @@ bool BaseID<T>::IsNil() const {
 
 template <typename T>
 size_t BaseID<T>::Hash() const {
-  // Note(ashione): hash code lazy calculation(it's invoked every time if hash code is
-  // default value 0)
-  if (!hash_) {
-    hash_ = MurmurHash64A(Data(), T::Size(), 0);
-  }
-  return hash_;
+  return HashIDBytes(Data(), T::Size());
 }
 
 template <typename T>
@@ -510,12 +522,12 @@ bool BaseID<T>::operator!=(const BaseID &rhs) const {
 
 template <typename T>
 uint8_t *BaseID<T>::MutableData() {
-  return reinterpret_cast<uint8_t *>(this) + sizeof(hash_);
+  return reinterpret_cast<uint8_t *>(this);
 }
 
 template <typename T>
 const uint8_t *BaseID<T>::Data() const {
-  return reinterpret_cast<const uint8_t *>(this) + sizeof(hash_);
+  return reinterpret_cast<const uint8_t *>(this);
 }
 
 template <typename T>
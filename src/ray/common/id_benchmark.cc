@@ -0,0 +1,93 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "benchmark/benchmark.h"
+#include "ray/common/id.h"
+
+namespace ray {
+
+namespace {
+
+/// Object IDs as the hot paths see them: the returns and puts of many tasks, so that
+/// the IDs of the same task only differ in their index.
+std::vector<ObjectID> CreateObjectIDs(int num_ids) {
+  std::vector<ObjectID> ids;
+  ids.reserve(num_ids);
+  const auto job_id = JobID::FromInt(1);
+  while (ids.size() < static_cast<size_t>(num_ids)) {
+    const auto task_id = TaskID::FromRandom(job_id);
+    for (int index = 1; index <= 4 && ids.size() < static_cast<size_t>(num_ids);
+         index++) {
+      ids.push_back(ObjectID::FromIndex(task_id, index));
+    }
+  }
+  return ids;
+}
+
+void BM_HashObjectID(benchmark::State &state) {
+  const auto ids = CreateObjectIDs(1024);
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      benchmark::DoNotOptimize(id.Hash());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_HashObjectID);
+
+void BM_MurmurHashObjectID(benchmark::State &state) {
+  const auto ids = CreateObjectIDs(1024);
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      benchmark::DoNotOptimize(MurmurHash64A(id.Data(), ObjectID::Size(), 0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_MurmurHashObjectID);
+
+void BM_ObjectIDMapInsert(benchmark::State &state) {
+  const auto ids = CreateObjectIDs(state.range(0));
+  for (auto _ : state) {
+    absl::flat_hash_map<ObjectID, int64_t> map;
+    for (const auto &id : ids) {
+      map.emplace(id, 0);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_ObjectIDMapInsert)->Arg(1 << 10)->Arg(1 << 16);
+
+void BM_ObjectIDMapFind(benchmark::State &state) {
+  const auto ids = CreateObjectIDs(state.range(0));
+  absl::flat_hash_map<ObjectID, int64_t> map;
+  for (const auto &id : ids) {
+    map.emplace(id, 0);
+  }
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      benchmark::DoNotOptimize(map.find(id));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_ObjectIDMapFind)->Arg(1 << 10)->Arg(1 << 16);
+
+}  // namespace
+
+}  // namespace ray
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "absl/container/flat_hash_set.h"
 #include "gtest/gtest.h"
 #include "ray/common/common_protocol.h"
 #include "ray/common/task/task_spec.h"
@@ -137,6 +138,18 @@ TEST(HashTest, TestNilHash) {
   ASSERT_NE(id1.Hash(), id2.Hash());
 }
 
+TEST(HashTest, TestHashIndexBytes) {
+  // The object IDs of the same task only differ in their last bytes.
+  const auto task_id = TaskID::FromRandom(JobID::FromInt(1));
+  absl::flat_hash_set<size_t> hashes;
+  for (ObjectIDIndexType index = 1; index <= 1000; index++) {
+    const auto id = ObjectID::FromIndex(task_id, index);
+    ASSERT_EQ(id.Hash(), ObjectID::FromBinary(id.Binary()).Hash());
+    hashes.insert(id.Hash());
+  }
+  ASSERT_EQ(hashes.size(), 1000);
+}
+
 TEST(PlacementGroupIDTest, TestPlacementGroup) {
   {
     // test from binary
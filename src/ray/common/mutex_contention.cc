@@ -0,0 +1,121 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/mutex_contention.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "absl/base/internal/cycleclock.h"
+#include "ray/common/ray_config.h"
+#include "ray/stats/metric_defs.h"
+
+namespace ray {
+
+MutexContentionTracker &MutexContentionTracker::Instance() {
+  static auto *tracker = new MutexContentionTracker();
+  return *tracker;
+}
+
+void MutexContentionTracker::Register(const absl::Mutex *mutex,
+                                      const std::string &name) {
+  if (!RayConfig::instance().mutex_contention_tracing()) {
+    return;
+  }
+  static std::once_flag tracer_installed;
+  std::call_once(tracer_installed, []() { absl::RegisterMutexTracer(&Trace); });
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &counters = counters_by_name_[name];
+  if (counters == nullptr) {
+    counters = std::make_unique<Counters>();
+  }
+  counters_by_mutex_[mutex] = counters.get();
+}
+
+void MutexContentionTracker::Unregister(const absl::Mutex *mutex) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  counters_by_mutex_.erase(mutex);
+}
+
+void MutexContentionTracker::Trace(const char *message,
+                                   const void *mutex,
+                                   int64_t wait_cycles) {
+  auto &tracker = Instance();
+  std::lock_guard<std::mutex> lock(tracker.mutex_);
+  auto it = tracker.counters_by_mutex_.find(mutex);
+  if (it == tracker.counters_by_mutex_.end()) {
+    return;
+  }
+  it->second->num_contentions.fetch_add(1, std::memory_order_relaxed);
+  it->second->wait_cycles.fetch_add(wait_cycles, std::memory_order_relaxed);
+}
+
+int64_t MutexContentionTracker::CyclesToNanoseconds(int64_t cycles) {
+  static const double cycles_per_ns = absl::base_internal::CycleClock::Frequency() / 1e9;
+  return static_cast<int64_t>(cycles / cycles_per_ns);
+}
+
+MutexContentionTracker::Stats MutexContentionTracker::GetStats(
+    const std::string &name) const {
+  Stats stats;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = counters_by_name_.find(name);
+  if (it != counters_by_name_.end()) {
+    stats.num_contentions = it->second->num_contentions;
+    stats.wait_time_ns = CyclesToNanoseconds(it->second->wait_cycles);
+  }
+  return stats;
+}
+
+void MutexContentionTracker::RecordMetrics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &entry : counters_by_name_) {
+    auto &counters = *entry.second;
+    const int64_t num_contentions = counters.num_contentions;
+    const int64_t wait_cycles = counters.wait_cycles;
+    ray::stats::STATS_mutex_contentions.Record(
+        num_contentions - counters.recorded_num_contentions, entry.first);
+    ray::stats::STATS_mutex_wait_time_ms.Record(
+        CyclesToNanoseconds(wait_cycles - counters.recorded_wait_cycles) / 1e6,
+        entry.first);
+    counters.recorded_num_contentions = num_contentions;
+    counters.recorded_wait_cycles = wait_cycles;
+  }
+}
+
+std::string MutexContentionTracker::DebugString() const {
+  std::vector<std::pair<std::string, Stats>> stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &entry : counters_by_name_) {
+      stats.emplace_back(entry.first,
+                         Stats{entry.second->num_contentions,
+                               CyclesToNanoseconds(entry.second->wait_cycles)});
+    }
+  }
+  std::sort(stats.begin(), stats.end(), [](const auto &a, const auto &b) {
+    return a.second.wait_time_ns > b.second.wait_time_ns;
+  });
+  std::stringstream result;
+  result << "MutexContention:";
+  for (const auto &entry : stats) {
+    result << "\n\t" << entry.first << ": " << entry.second.num_contentions
+           << " contentions, " << entry.second.wait_time_ns / 1000000 << " ms waited";
+  }
+  return result.str();
+}
+
+}  // namespace ray
@@ -0,0 +1,105 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace ray {
+
+/// \class MutexContentionTracker
+/// Records how often the named mutexes of this process are contended and how long
+/// their waiters wait, aggregated by name, to tell which lock to shard first. The
+/// contention is reported by a tracer that absl::Mutex calls when a contended mutex
+/// is released, which is installed when the first mutex is registered with
+/// mutex_contention_tracing enabled. Uncontended locking costs nothing more.
+class MutexContentionTracker {
+ public:
+  /// The contention of the mutexes of a name.
+  struct Stats {
+    /// The number of contended releases.
+    int64_t num_contentions = 0;
+    /// The total time the waiters waited, in nanoseconds.
+    int64_t wait_time_ns = 0;
+  };
+
+  /// Get the tracker of this process.
+  static MutexContentionTracker &Instance();
+
+  /// Record the contention of a mutex under a name, if mutex_contention_tracing is
+  /// enabled. Mutexes of objects that have many instances share their name.
+  void Register(const absl::Mutex *mutex, const std::string &name);
+
+  /// Stop recording the contention of a mutex, before it's destroyed.
+  void Unregister(const absl::Mutex *mutex);
+
+  /// Get the contention of the mutexes of a name.
+  Stats GetStats(const std::string &name) const;
+
+  /// Record the contention since the last call as metrics.
+  void RecordMetrics();
+
+  /// Get the contention of every name, from the most waited on.
+  std::string DebugString() const;
+
+ private:
+  MutexContentionTracker() = default;
+
+  /// The contention of the mutexes of a name, updated by the tracer.
+  struct Counters {
+    std::atomic<int64_t> num_contentions{0};
+    std::atomic<int64_t> wait_cycles{0};
+    /// The values at the last RecordMetrics.
+    int64_t recorded_num_contentions = 0;
+    int64_t recorded_wait_cycles = 0;
+  };
+
+  /// The tracer installed in absl::Mutex.
+  static void Trace(const char *message, const void *mutex, int64_t wait_cycles);
+
+  static int64_t CyclesToNanoseconds(int64_t cycles);
+
+  /// Protects the maps below. This isn't an absl::Mutex, since the tracer runs when
+  /// an absl::Mutex is released and would trace itself.
+  mutable std::mutex mutex_;
+  /// The counters by name. They are never erased, so the mutexes can point to them.
+  absl::flat_hash_map<std::string, std::unique_ptr<Counters>> counters_by_name_;
+  /// The counters of every registered mutex.
+  absl::flat_hash_map<const void *, Counters *> counters_by_mutex_;
+};
+
+/// Registers a mutex with the contention tracker for as long as it lives. Declare it
+/// after the mutex, so that it's destroyed before the mutex.
+class TrackedMutexName {
+ public:
+  TrackedMutexName(const absl::Mutex *mutex, const std::string &name) : mutex_(mutex) {
+    MutexContentionTracker::Instance().Register(mutex_, name);
+  }
+
+  ~TrackedMutexName() { MutexContentionTracker::Instance().Unregister(mutex_); }
+
+  TrackedMutexName(const TrackedMutexName &) = delete;
+  TrackedMutexName &operator=(const TrackedMutexName &) = delete;
+
+ private:
+  const absl::Mutex *mutex_;
+};
+
+}  // namespace ray
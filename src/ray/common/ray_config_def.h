@@ -21,10 +21,29 @@
 /// The duration between dumping debug info to logs, or 0 to disable.
 RAY_CONFIG(uint64_t, debug_dump_period_milliseconds, 10000)
 
+/// If positive, the raylet serves the worker stats of GetNodeStats requests from a
+/// cache, and refreshes the cache from the workers at most once per this interval,
+/// in the background of a request that finds it stale. Requests that include the
+/// memory info are always sent to the workers. 0 sends every request to every worker.
+RAY_CONFIG(uint64_t, node_stats_cache_refresh_interval_ms, 0)
+
 /// Whether to enable Ray event stats collection.
 /// TODO(ekl) this seems to segfault Java unit tests when on by default?
 RAY_CONFIG(bool, event_stats, true)
 
+/// How often the main event loops of the raylet, the GCS server and the core workers
+/// check how late they run their handlers. 0 disables the check.
+RAY_CONFIG(int64_t, event_loop_lag_probe_interval_ms, 1000)
+
+/// Log a warning with the handlers that ran the longest when an event loop runs its
+/// handlers later than this. 0 disables the warning.
+RAY_CONFIG(int64_t, event_loop_lag_warning_threshold_ms, 1000)
+
+/// Whether to record how often the hot locks of the core worker and the raylet are
+/// contended and how long their waiters wait. The contention is exported as metrics
+/// and in the raylet's debug state.
+RAY_CONFIG(bool, mutex_contention_tracing, false)
+
 /// Whether to enable Ray legacy scheduler warnings. These are replaced by
 /// autoscaler messages after https://github.com/ray-project/ray/pull/18724.
 /// TODO(ekl) remove this after Ray 1.8
@@ -36,6 +55,12 @@ RAY_CONFIG(bool, legacy_scheduler_warnings, false)
 /// NOTE: This requires event_stats=1.
 RAY_CONFIG(int64_t, event_stats_print_interval_ms, 60000)
 
+/// Whether the handlers posted to an instrumented_io_context are pushed to a
+/// lock-free queue, which the event loop drains in batches, instead of being posted
+/// to asio one by one. This avoids contending on asio's queue mutex when many threads
+/// post to the same event loop.
+RAY_CONFIG(bool, event_loop_batched_post, false)
+
 /// In theory, this is used to detect Ray cookie mismatches.
 /// This magic number (hex for "RAY") is used instead of zero, rationale is
 /// that it could still be possible that some random program sends an int64_t
@@ -43,6 +68,10 @@ RAY_CONFIG(int64_t, event_stats_print_interval_ms, 60000)
 /// particular magic number.
 RAY_CONFIG(int64_t, ray_cookie, 0x5241590000000000)
 
+/// The maximum number of queued messages that a client connection writes to its socket
+/// with a single vectored write.
+RAY_CONFIG(int64_t, client_connection_max_coalesced_writes, 64)
+
 /// The duration that a single handler on the event loop can take before a
 /// warning is logged that the handler is taking too long.
 RAY_CONFIG(int64_t, handler_warning_timeout_ms, 1000)
@@ -58,6 +87,17 @@ RAY_CONFIG(int64_t, num_heartbeats_timeout, 30)
 /// handler is drifting.
 RAY_CONFIG(uint64_t, num_heartbeats_warning, 5)
 
+/// If positive, the raylets don't send heartbeats to the GCS. Instead, at this period
+/// each raylet probes one peer, and reports the peers that don't reply, neither
+/// directly nor through others, to the GCS as suspected. The GCS then probes a suspected
+/// node itself every heartbeat period, and marks it dead if it doesn't reply within
+/// num_heartbeats_timeout periods. 0 disables it.
+RAY_CONFIG(uint64_t, raylet_gossip_probe_period_ms, 0)
+/// The timeout of a probe of a peer when gossip failure detection is enabled.
+RAY_CONFIG(int64_t, raylet_gossip_probe_timeout_ms, 1000)
+/// The number of peers asked to probe a node that didn't reply to a direct probe.
+RAY_CONFIG(uint64_t, raylet_gossip_num_indirect_probes, 3)
+
 /// The duration between reporting resources sent by the raylets.
 RAY_CONFIG(uint64_t, raylet_report_resources_period_milliseconds, 100)
 /// For a raylet, if the last resource report was sent more than this many
@@ -65,6 +105,11 @@ RAY_CONFIG(uint64_t, raylet_report_resources_period_milliseconds, 100)
 /// handler is drifting.
 RAY_CONFIG(uint64_t, num_resource_report_periods_warning, 5)
 
+/// If positive, an idle raylet asks the peer with the most queued tasks for work at
+/// this period, so that tasks don't stay queued behind a stale resource view. The peer
+/// spills the tasks that fit the idle raylet's resources back to it. 0 disables it.
+RAY_CONFIG(uint64_t, work_stealing_period_ms, 0)
+
 /// Whether to record the creation sites of object references. This adds more
 /// information to `ray memory`, but introduces a little extra overhead when
 /// creating object references (e.g. 5~10 microsec per call in Python).
@@ -109,12 +154,83 @@ RAY_CONFIG(int64_t, reconstruct_objects_period_milliseconds, 100)
 /// inlined args.
 RAY_CONFIG(int64_t, max_lineage_bytes, 1024 * 1024 * 1024)
 
+/// Whether to keep the specs of finished tasks that are only kept as lineage in
+/// their serialized form, which takes a fraction of the memory of the parsed
+/// protobuf. The spec is parsed again if the task is resubmitted.
+RAY_CONFIG(bool, compact_lineage_specs, false)
+
+/// If positive, a worker that borrowed at least this many references during a task
+/// returns them to the owner in a compact encoding, which sends every address once
+/// and groups the references by owner. 0 always uses the plain encoding.
+RAY_CONFIG(int64_t, compact_borrowed_refs_threshold, 0)
+
 /// Whether to re-populate plasma memory. This avoids memory allocation failures
 /// at runtime (SIGBUS errors creating new objects), however it will use more memory
 /// upfront and can slow down Ray startup.
 /// See also: https://github.com/ray-project/ray/issues/14182
 RAY_CONFIG(bool, preallocate_plasma_memory, false)
 
+/// If preallocate_plasma_memory is set, allocate the plasma memory in a background
+/// thread instead of while the raylet starts, which can take seconds for large object
+/// stores. Objects can be created in the memory that isn't allocated yet meanwhile.
+RAY_CONFIG(bool, preallocate_plasma_memory_in_background, false)
+
+/// If non-zero, the resolution in milliseconds of the timeouts of plasma get requests,
+/// which are then kept in a timer wheel instead of an asio timer each. This makes
+/// adding and canceling a timeout O(1) when many gets are pending, and may delay a
+/// timeout by up to this much.
+RAY_CONFIG(uint64_t, plasma_get_timeout_tick_ms, 0)
+
+/// If non-zero, back the plasma store memory with huge pages of this size in bytes,
+/// e.g. 2MB or 1GB, created with `memfd_create`. Unlike `--huge-pages`, this doesn't
+/// need a hugetlbfs mount, but enough huge pages of this size must be reserved, see
+/// /proc/sys/vm/nr_hugepages. Only supported on Linux.
+RAY_CONFIG(int64_t, plasma_huge_page_size, 0)
+
+/// A comma separated list of NUMA nodes to allocate the plasma store memory on, e.g.
+/// "0" or "0,1". The memory is bound to a single node, or interleaved across several
+/// nodes. By default, the memory follows the policy of the plasma store process. Only
+/// supported on Linux.
+RAY_CONFIG(std::string, plasma_numa_nodes, "")
+
+/// A comma separated list of directories to create the fallback allocations of the
+/// plasma store in, each optionally followed by the max bytes to allocate in it, e.g.
+/// "/mnt/nvme:100000000000,/tmp". A fallback allocation goes to the first directory
+/// with room for it, and fails if there is none, so that objects are spilled instead.
+/// By default, all fallback allocations go to the fallback directory.
+RAY_CONFIG(std::string, plasma_fallback_tiers, "")
+
+/// The policy the plasma store uses to choose which unused objects to evict. Can be
+/// "lru", "segmented_lru" (objects used more than once are protected from objects
+/// used only once), or "greedy_dual_size" (weighs the object size, how often and how
+/// recently it was used, and whether it is the primary copy).
+RAY_CONFIG(std::string, plasma_eviction_policy, "lru")
+
+/// The fraction of the plasma store capacity reserved for objects that were used more
+/// than once, for the "segmented_lru" eviction policy.
+RAY_CONFIG(float, plasma_eviction_protected_fraction, 0.8)
+
+/// For the "greedy_dual_size" eviction policy, the fixed cost in bytes of fetching an
+/// object again, on top of its size. The larger this is, the more small objects are
+/// favored over large objects that are used equally often.
+RAY_CONFIG(int64_t, plasma_eviction_fetch_overhead_bytes, 1024 * 1024)
+
+/// For the "greedy_dual_size" eviction policy, how much more expensive it is to lose
+/// a primary copy than a secondary copy, which can be fetched again from another node.
+RAY_CONFIG(float, plasma_eviction_primary_copy_cost_factor, 4.0)
+
+/// If positive, the fraction of the plasma store capacity that the objects of each
+/// job may take before the objects its workers create stop evicting other objects to
+/// make space. Such creates only use free memory, and otherwise wait for objects to
+/// be spilled like a create in a full store. 0 disables the soft quota.
+RAY_CONFIG(float, object_store_job_soft_quota_fraction, 0)
+
+/// If positive, the fraction of the plasma store capacity that the objects of each
+/// job may never exceed in shared memory. Creates over it wait for the objects of the
+/// job to be freed or spilled, and fall back to the filesystem like a create in a
+/// full store. 0 disables the hard quota.
+RAY_CONFIG(float, object_store_job_hard_quota_fraction, 0)
+
 // If true, we place a soft cap on the numer of scheduling classes, see
 // `worker_cap_initial_backoff_delay_ms`.
 RAY_CONFIG(bool, worker_cap_enabled, true)
@@ -132,6 +248,26 @@ RAY_CONFIG(int64_t, worker_cap_initial_backoff_delay_ms, 1000)
 /// until it hits a maximum delay.
 RAY_CONFIG(int64_t, worker_cap_max_backoff_delay_ms, 1000 * 10)
 
+/// If true, the raylet remembers the scheduling classes whose dispatch queue is
+/// blocked on local resources, and doesn't revisit them until the resource view of the
+/// cluster changes or the arguments of a running task are released.
+RAY_CONFIG(bool, skip_resource_blocked_dispatch_queues, false)
+
+/// If true, the raylet dispatches the tasks of the tenant whose running tasks hold the
+/// smallest dominant share of the local resources first, one task at a time, instead
+/// of draining the dispatch queues in scheduling class order.
+RAY_CONFIG(bool, scheduler_fair_share, false)
+
+/// The key of the job config metadata that names the tenant of a job for fair share
+/// scheduling. Jobs without the key, or all jobs if it's empty, are their own tenant.
+RAY_CONFIG(std::string, scheduler_fair_share_tenant_key, "")
+
+/// The weights of the tenants for fair share scheduling, as
+/// "tenant1:weight1,tenant2:weight2". A tenant is named by its job ID in hex unless
+/// `scheduler_fair_share_tenant_key` is set. Tenants that aren't listed have a weight
+/// of 1.
+RAY_CONFIG(std::string, scheduler_fair_share_weights, "")
+
 /// The fraction of resource utilization on a node after which the scheduler starts
 /// to prefer spreading tasks to other nodes. This balances between locality and
 /// even balancing of load. Low values (min 0.0) encourage more load spreading.
@@ -146,6 +282,23 @@ RAY_CONFIG(bool, scheduler_report_pinned_bytes_only, true)
 // Objects larger than this size will be spilled/promoted to plasma.
 RAY_CONFIG(int64_t, max_direct_call_object_size, 100 * 1024)
 
+// The max allowed size in bytes of a return object from actor tasks, if larger than
+// max_direct_call_object_size. Returns up to this size are sent back to the caller in
+// the task reply instead of being put in plasma, and are only promoted to plasma if the
+// caller passes them on to other workers. The total of the returns inlined in a reply
+// is still capped by task_rpc_inlined_bytes_limit.
+RAY_CONFIG(int64_t, max_direct_actor_call_return_size, 0)
+
+// The number of shards of the in-process memory store of each worker. Each shard
+// has its own lock, so threaded actors don't contend on a single lock for every
+// put and get of small return objects.
+RAY_CONFIG(uint64_t, memory_store_num_shards, 16)
+
+// If positive, the max bytes of the objects in the in-process memory store of each
+// worker. When it is exceeded, the oldest objects owned by the worker are promoted to
+// plasma, where they can be spilled like any other object. 0 means unlimited.
+RAY_CONFIG(int64_t, memory_store_max_bytes, 0)
+
 // The max gRPC message size (the gRPC internal default is 4MB). We use a higher
 // limit in Ray to avoid crashing with many small inlined task arguments.
 RAY_CONFIG(int64_t, max_grpc_message_size, 100 * 1024 * 1024)
@@ -154,6 +307,31 @@ RAY_CONFIG(int64_t, max_grpc_message_size, 100 * 1024 * 1024)
 // of retries is non zero.
 RAY_CONFIG(int64_t, grpc_server_retry_timeout_milliseconds, 1000)
 
+// gRPC replies of at least this many bytes are compressed with gzip, which the
+// clients accept by default. -1 disables the compression.
+RAY_CONFIG(int64_t, grpc_reply_compression_min_bytes, -1)
+
+// The number of threads that poll the completion queues of the outgoing gRPC
+// requests of a process, shared by all of its gRPC clients. 0 means one thread per
+// core. -1 means every client call manager polls its own queues on its own threads.
+RAY_CONFIG(int64_t, grpc_client_shared_cq_threads, -1)
+
+// The number of calls that a gRPC server initially keeps waiting for requests, per
+// RPC handler and completion queue, if the handler doesn't limit its active requests.
+// The number doubles whenever a burst of requests takes all the waiting calls, up to
+// grpc_server_max_pending_calls.
+RAY_CONFIG(int64_t, grpc_server_initial_pending_calls, 8)
+RAY_CONFIG(int64_t, grpc_server_max_pending_calls, 100)
+
+// If non-negative, gRPC client channels that have no RPCs in flight for this long
+// close their connection, and reconnect on the next RPC. -1 keeps gRPC's default.
+RAY_CONFIG(int64_t, grpc_client_idle_timeout_ms, -1)
+
+// The number of clients that a pool of core worker clients holds, above which it
+// removes the least recently used clients that are not used outside of the pool.
+// 0 means no limit.
+RAY_CONFIG(uint64_t, core_worker_client_pool_max_size, 0)
+
 // The min number of retries for direct actor creation tasks. The actual number
 // of creation retries will be MAX(actor_creation_min_retries, max_restarts).
 RAY_CONFIG(uint64_t, actor_creation_min_retries, 3)
@@ -173,6 +351,16 @@ RAY_CONFIG(int64_t, object_timeout_milliseconds, 100)
 /// for direct task submission until it must be returned to the raylet.
 RAY_CONFIG(int64_t, worker_lease_timeout_milliseconds, 500)
 
+/// Whether a worker leased for the tasks of one scheduling class may run the queued
+/// tasks of another class with the same resources, instead of being returned to the
+/// raylet while another lease is requested for them.
+RAY_CONFIG(bool, worker_lease_reuse_across_scheduling_classes, false)
+
+/// How long a worker that has no more tasks to run is kept leased, in case more tasks
+/// that it can run are submitted, before it's returned to the raylet. 0 returns it
+/// right away.
+RAY_CONFIG(int64_t, worker_lease_idle_linger_ms, 0)
+
 /// The interval at which the workers will check if their raylet has gone down.
 /// When this happens, they will kill themselves.
 RAY_CONFIG(uint64_t, raylet_death_check_interval_milliseconds, 1000)
@@ -192,6 +380,17 @@ RAY_CONFIG(int64_t, fetch_warn_timeout_milliseconds, 60000)
 /// object directory.
 RAY_CONFIG(int64_t, fetch_fail_timeout_milliseconds, 600000)
 
+/// Whether the pull manager activates the smaller of two pull bundles of the same
+/// priority and deadline first, instead of the earlier one. This lowers the average
+/// latency of pulls, but a large bundle may starve behind a stream of small ones.
+RAY_CONFIG(bool, pull_manager_shortest_bundle_first, false)
+
+/// The maximum number of bytes of locally spilled objects that the pull manager
+/// restores ahead of time, for the queued bundles that don't fit in memory yet. These
+/// restores only use the memory that the active pulls leave free. Set to 0 to only
+/// restore objects once their bundle is pulled.
+RAY_CONFIG(int64_t, pull_manager_restore_prefetch_bytes, 0)
+
 /// Temporary workaround for https://github.com/ray-project/ray/pull/16402.
 RAY_CONFIG(bool, yield_plasma_lock_workaround, true)
 
@@ -223,6 +422,13 @@ RAY_CONFIG(uint32_t, worker_max_resource_analysis_iteration, 128);
 RAY_CONFIG(int64_t, redis_db_connect_retries, 600)
 RAY_CONFIG(int64_t, redis_db_connect_wait_milliseconds, 100)
 
+/// The number of connections the GCS opens to each Redis shard. The keys of a shard are
+/// spread across its connections, so that the storage isn't limited by what a single
+/// connection can do, while the commands about a key still run in order. Scans go
+/// through the first connection of each shard, so they may miss the writes that are
+/// still in flight on the others.
+RAY_CONFIG(uint64_t, gcs_redis_connections_per_shard, 1)
+
 /// The object manager's global timer interval in milliseconds.
 RAY_CONFIG(int, object_manager_timer_freq_ms, 100)
 
@@ -243,6 +449,54 @@ RAY_CONFIG(int, object_manager_push_timeout_ms, 10000)
 /// NOTE(ekl): this has been raised to lower broadcast overheads.
 RAY_CONFIG(uint64_t, object_manager_default_chunk_size, 5 * 1024 * 1024)
 
+/// If larger than object_manager_default_chunk_size, large objects are pushed in
+/// larger chunks of up to this size, so that they are split into fewer chunks. It must
+/// be below max_grpc_message_size.
+RAY_CONFIG(uint64_t, object_manager_max_chunk_size, 0)
+
+/// If non-zero, the object manager limits the chunks in flight to each node with a
+/// window of its own, starting at this many chunks. The window adapts to the round
+/// trip time and failures of the chunks sent to the node, so that a slow node gets
+/// fewer of the object_manager_max_bytes_in_flight than the fast ones.
+RAY_CONFIG(int64_t, object_manager_push_initial_window, 0)
+
+/// Whether the object manager sends the chunks of objects in plasma straight from the
+/// shared memory, instead of copying each chunk into the push request first.
+RAY_CONFIG(bool, object_manager_zero_copy_push, true)
+
+/// If non-zero, the object manager sends object chunks to other nodes on this many
+/// parallel TCP connections per node, instead of on gRPC. The chunk data is sent
+/// without protobuf framing. Nodes that don't enable it still receive on gRPC. With
+/// USE_TLS, the connections are encrypted with kernel TLS, offloaded to the NIC where
+/// it supports it, and nodes whose kernel lacks it keep using gRPC.
+RAY_CONFIG(int, object_manager_bulk_transfer_streams, 0)
+
+/// If true, object chunks pushed over gRPC are compressed with gzip, e.g. to save
+/// bandwidth between zones for compressible objects. This costs CPU on both sides and
+/// doesn't pay off for incompressible data or fast links. The bulk data plane sends
+/// chunks uncompressed.
+RAY_CONFIG(bool, object_manager_transfer_compression, false)
+
+/// If true, the raylet spills the objects that the fewest queued tasks and workers
+/// wait on first, and the largest of those, instead of the pinned objects in no
+/// particular order, so that objects that are about to be used aren't spilled and
+/// restored right away.
+RAY_CONFIG(bool, spill_objects_by_demand, false)
+
+/// The number of tasks per scheduling class, queued on a raylet while waiting for
+/// resources, whose arguments the raylet prefetches, so that the arguments are
+/// transferred while the running tasks finish. 0 to only pull the arguments of tasks
+/// once they have resources. Prefetches are admitted within the pull memory budget.
+RAY_CONFIG(int64_t, task_args_prefetch_lookahead, 0)
+
+/// The maximum number of copies of an object that a pull stripes the object's chunks
+/// over, so that many nodes pulling the same object spread the load over all of its
+/// copies instead of all pulling from one. 1 pulls every object from a single copy.
+RAY_CONFIG(int64_t, object_manager_max_pull_sources, 4)
+
+/// Objects smaller than this are always pulled from a single copy.
+RAY_CONFIG(uint64_t, object_manager_striped_pull_min_bytes, 64 * 1024 * 1024)
+
 /// The maximum number of outbound bytes to allow to be outstanding. This avoids
 /// excessive memory usage during object broadcast to many receivers.
 RAY_CONFIG(uint64_t,
@@ -255,8 +509,15 @@ RAY_CONFIG(uint32_t, maximum_gcs_deletion_batch_size, 1000)
 /// Maximum number of items in one batch to scan/get/delete from GCS storage.
 RAY_CONFIG(uint32_t, maximum_gcs_storage_operation_batch_size, 1000)
 
-/// Maximum number of rows in GCS profile table.
-RAY_CONFIG(int32_t, maximum_profile_table_rows_count, 10 * 1000)
+/// How long the Redis GCS storage buffers writes for, in milliseconds, before it
+/// flushes them in one batch per shard. Writes to the same key are coalesced, and
+/// their callbacks are only called once the batch is written. 0 flushes on the next
+/// turn of the event loop, and -1 sends every write to Redis right away.
+RAY_CONFIG(int64_t, gcs_storage_write_batch_interval_ms, -1)
+
+/// Maximum number of profile events kept in GCS server memory. The oldest events are
+/// dropped once there are more.
+RAY_CONFIG(uint64_t, maximum_gcs_profile_events_count, 1000 * 1000)
 
 /// When getting objects from object store, max number of ids to print in the warning
 /// message.
@@ -265,6 +526,14 @@ RAY_CONFIG(uint32_t, object_store_get_max_ids_to_print_in_warning, 20)
 RAY_CONFIG(uint32_t, gcs_server_rpc_server_thread_num, 1)
 /// Number of threads used by rpc server in gcs server.
 RAY_CONFIG(uint32_t, gcs_server_rpc_client_thread_num, 1)
+/// Number of threads that run the gcs server services whose state is thread-safe,
+/// such as the internal KV and the stats services, off the main thread. Each of those
+/// services is assigned to one of the threads by the hash of its name. If 0, they run
+/// on the main thread.
+RAY_CONFIG(uint32_t, gcs_server_service_thread_num, 0)
+/// A comma-separated list of the CPUs to pin the gcs server service threads to, one
+/// per thread in turn, e.g. "2,3". If empty, they aren't pinned.
+RAY_CONFIG(std::string, gcs_server_service_thread_cpus, "")
 /// Allow up to 5 seconds for connecting to gcs service.
 /// Note: this only takes effect when gcs service is enabled.
 RAY_CONFIG(int64_t, gcs_service_connect_retries, 50)
@@ -273,28 +542,83 @@ RAY_CONFIG(int64_t, internal_gcs_service_connect_wait_milliseconds, 100)
 /// The interval at which the gcs server will check if redis has gone down.
 /// When this happens, gcs server will kill itself.
 RAY_CONFIG(uint64_t, gcs_redis_heartbeat_interval_milliseconds, 100)
-/// Duration to wait between retries for leasing worker in gcs server.
+/// Duration to wait before retrying a failed worker lease request in gcs server.
+/// Leases waiting for resources or for a node to release its unused workers are
+/// not polled, they are retried when the wait is over.
 RAY_CONFIG(uint32_t, gcs_lease_worker_retry_interval_ms, 200)
-/// Duration to wait between retries for creating actor in gcs server.
+/// Duration to wait before retrying a failed actor creation request in gcs server.
 RAY_CONFIG(uint32_t, gcs_create_actor_retry_interval_ms, 200)
 /// Exponential backoff params for gcs to retry creating a placement group
 RAY_CONFIG(uint64_t, gcs_create_placement_group_retry_min_interval_ms, 100)
 RAY_CONFIG(uint64_t, gcs_create_placement_group_retry_max_interval_ms, 1000)
 RAY_CONFIG(double, gcs_create_placement_group_retry_multiplier, 1.5);
+/// If true, each round of placement group scheduling scans the whole pending queue, in
+/// the order of priority, and schedules the first placement group whose bundles fit the
+/// available resources. The placement groups that don't fit keep their place in the
+/// queue, instead of being retried with the exponential backoff above, which is only
+/// used when the bundles fit but fail to be reserved on the nodes.
+RAY_CONFIG(bool, gcs_placement_group_batch_scheduling, false)
 /// Maximum number of destroyed actors in GCS server memory cache.
 RAY_CONFIG(uint32_t, maximum_gcs_destroyed_actor_cached_count, 100000)
+/// Maximum number of destroyed actors evicted from the cache above that are kept in a
+/// compact archive, with only the fields shown by the state API. They are dropped if 0.
+RAY_CONFIG(uint32_t, gcs_actor_archive_max_entries, 0)
 /// Maximum number of dead nodes in GCS server memory cache.
 RAY_CONFIG(uint32_t, maximum_gcs_dead_node_cached_count, 1000)
 // The interval at which the gcs server will pull a new resource.
 RAY_CONFIG(int, gcs_resource_report_poll_period_ms, 100)
+// If larger than gcs_resource_report_poll_period_ms, the gcs server doubles the poll
+// period of a node whose report didn't change, up to this period, and the raylet
+// doesn't send the unchanged report. A node whose report changes is polled at
+// gcs_resource_report_poll_period_ms again. At this period, the full report is pulled
+// even if it didn't change.
+RAY_CONFIG(int, gcs_resource_report_max_poll_period_ms, 0)
 // The number of concurrent polls to polls to GCS.
 RAY_CONFIG(uint64_t, gcs_max_concurrent_resource_pulls, 100)
-// The storage backend to use for the GCS. It can be either 'redis' or 'memory'.
+// The storage backend to use for the GCS. It can be either 'redis', 'memory' or
+// 'file'.
 RAY_CONFIG(std::string, gcs_storage, "memory")
 
+/// The directory that the 'file' GCS storage persists the GCS tables to.
+RAY_CONFIG(std::string, gcs_storage_file_directory, "")
+
+/// Once the log of the 'file' GCS storage grows past this many bytes, it is compacted
+/// into a snapshot of the GCS tables.
+RAY_CONFIG(uint64_t, gcs_storage_file_compaction_bytes, 256 * 1024 * 1024)
+
 /// Duration to sleep after failing to put an object in plasma because it is full.
 RAY_CONFIG(uint32_t, object_store_full_delay_ms, 10)
 
+/// The number of threads the plasma store uses to handle client requests. With more
+/// than one thread, requests from different clients are read and replied to in
+/// parallel, while updates to the store itself are still serialized.
+RAY_CONFIG(int, plasma_store_io_threads, 1)
+
+/// If non-zero, plasma objects up to this many bytes are allocated from pages of
+/// fixed-size slots instead of directly from the shared memory arena, so that many
+/// small objects don't fragment the arena. Capped at 64KB.
+RAY_CONFIG(uint64_t, plasma_small_object_max_size, 0)
+
+/// If non-zero, plasma clients ask the store for a ring in shared memory holding this
+/// many object IDs, and release objects by pushing their IDs to it instead of sending
+/// a message per release. Only supported on Linux.
+RAY_CONFIG(int64_t, plasma_release_ring_capacity, 0)
+
+/// If non-zero, plasma clients keep up to this many sealed objects that they no longer
+/// use pinned in the store, so that getting them again is served without a round trip
+/// to the store. The store can't evict or delete the objects meanwhile.
+RAY_CONFIG(uint64_t, plasma_client_release_cache_size, 0)
+
+/// How long a plasma client keeps an object in its release cache before releasing it
+/// to the store. Expired objects are released on the client's next get or release.
+RAY_CONFIG(int64_t, plasma_client_release_cache_lease_ms, 1000)
+
+/// Whether plasma clients can read the objects that are being received from other
+/// nodes before they are sealed. The object manager then tells the store how much of
+/// each object has been received after every chunk, and streaming readers wait for
+/// the bytes they read next instead of for the whole object.
+RAY_CONFIG(bool, plasma_streaming_reads_enabled, false)
+
 /// The threshold to trigger a global gc
 RAY_CONFIG(double, high_plasma_storage_usage, 0.7)
 
@@ -323,6 +647,11 @@ RAY_CONFIG(bool, start_python_importer_thread, true)
 /// Note that this only enables forking in workers, but not drivers.
 RAY_CONFIG(bool, support_fork, false)
 
+/// Whether to start Python workers that have no runtime env by forking them from a
+/// forkserver process that has already imported Ray, instead of starting them from
+/// scratch. Only supported on Linux.
+RAY_CONFIG(bool, worker_forkserver, false)
+
 /// Maximum timeout for GCS reconnection in seconds.
 /// Each reconnection ping will be retried every 1 second.
 RAY_CONFIG(int32_t, gcs_rpc_server_reconnect_timeout_s, 60)
@@ -343,9 +672,54 @@ RAY_CONFIG(int64_t, enable_metrics_collection, true)
 // Max number bytes of inlined objects in a task rpc request/response.
 RAY_CONFIG(int64_t, task_rpc_inlined_bytes_limit, 10 * 1024 * 1024)
 
+// If positive, a Python worker that passes the same argument value of at least this
+// many bytes to several tasks, e.g. a config dict passed to every task of a fan-out,
+// puts the value in the object store once and passes it by reference from then on,
+// instead of inlining a copy into every task spec. Values are matched by the hash of
+// their serialized bytes. Such arguments then share the fate of the worker's puts.
+RAY_CONFIG(int64_t, task_arg_dedup_min_bytes, 0)
+
+/// The max number of bytes of task return objects that a worker keeps unsealed in the
+/// plasma store so that they can be sealed with a single request. Unsealed objects
+/// can't be spilled, so this bounds the memory that a task with many returns holds
+/// while it allocates the rest of its returns.
+RAY_CONFIG(int64_t, task_return_seal_batch_bytes, 16 * 1024 * 1024)
+
 /// Maximum number of pending lease requests per scheduling category
 RAY_CONFIG(uint64_t, max_pending_lease_requests_per_scheduling_category, 10)
 
+/// Whether to allow as many pending lease requests per scheduling category as there
+/// are alive nodes, if that's more than
+/// max_pending_lease_requests_per_scheduling_category. This lets a large fan-out of
+/// tasks lease workers on all of the nodes at once.
+RAY_CONFIG(bool, scale_pending_lease_requests_with_cluster_size, false)
+
+/// Maximum number of normal tasks that are pushed to a leased worker at once. The
+/// worker queues the tasks and runs them one at a time, so that it doesn't idle for
+/// a round trip between short tasks.
+RAY_CONFIG(uint64_t, max_tasks_in_flight_per_worker, 1)
+
+/// Maximum number of actor tasks that a caller sends to an actor in one PushTaskBatch
+/// RPC, or 1 to send every task in its own PushTask RPC. While a batch is in flight,
+/// the tasks that are submitted to the actor are held until a full batch is queued or
+/// the batch in flight is replied to, which is after all of its tasks finish. So this
+/// should only be enabled for actors whose tasks don't wait for each other, e.g., it
+/// may deadlock an async actor whose task waits for the result of a later task.
+RAY_CONFIG(uint64_t, push_task_batch_size, 1)
+
+/// Maximum number of objects borrowed from the same owner whose status a worker asks
+/// for in one GetObjectStatusBatch RPC, or 1 to ask for every object in its own
+/// GetObjectStatus RPC. The objects that are deserialized before the worker's event
+/// loop gets to send the requests are batched, and a batch is only replied to once all
+/// of its objects are created, so an object may be resolved later than it could be.
+RAY_CONFIG(uint64_t, object_status_batch_size, 1)
+
+/// Whether the concurrency groups of a threaded actor run their tasks on one
+/// work-stealing thread pool, instead of a thread pool per group. The concurrency of
+/// each group is still limited to its max_concurrency, and the tasks of a group that
+/// is at its limit are queued instead of blocking the thread that schedules them.
+RAY_CONFIG(bool, actor_work_stealing_executor, false)
+
 /// Wait timeout for dashboard agent register.
 #ifdef _WIN32
 // agent startup time can involve creating conda environments
@@ -375,6 +749,12 @@ RAY_CONFIG(uint64_t, kill_idle_workers_interval_ms, 200)
 /// The idle time threshold for an idle worker to be killed.
 RAY_CONFIG(int64_t, idle_worker_killing_time_threshold_ms, 1000)
 
+/// The half life of the worker demand that the worker pool predicts from the history
+/// of each job, runtime env and language. If positive, the pool keeps enough idle
+/// workers warm for the predicted demand, within the soft limit of workers, instead of
+/// killing them, and prestarts them if needed. 0 means that the demand isn't predicted.
+RAY_CONFIG(int64_t, worker_demand_half_life_ms, 0)
+
 /// The soft limit of the number of workers.
 /// -1 means using num_cpus instead.
 RAY_CONFIG(int64_t, num_workers_soft_limit, -1)
@@ -382,6 +762,15 @@ RAY_CONFIG(int64_t, num_workers_soft_limit, -1)
 // The interval where metrics are exported in milliseconds.
 RAY_CONFIG(uint64_t, metrics_report_interval_ms, 10000)
 
+/// Whether to only send the metrics agent the time series that changed since the
+/// last report. The agent keeps the last value of the other time series.
+RAY_CONFIG(bool, metrics_report_only_changed, false)
+
+/// The maximum number of combinations of tag values that a metric is recorded with.
+/// The values of the combinations past the limit are replaced with a few "other"
+/// values. 0 means no limit.
+RAY_CONFIG(int64_t, metrics_max_tag_combinations, 0)
+
 /// Enable the task timeline. If this is enabled, certain events such as task
 /// execution are profiled and sent to the GCS.
 RAY_CONFIG(bool, enable_timeline, true)
@@ -425,15 +814,75 @@ RAY_CONFIG(int64_t, max_fused_object_count, 2000)
 /// In unlimited allocation mode, this is the time delay prior to fallback allocating.
 RAY_CONFIG(int64_t, oom_grace_period_s, 2)
 
+/// The period in milliseconds at which the raylet samples the memory usage of its
+/// node, or 0 to not monitor it. While the usage is above memory_usage_threshold, the
+/// raylet doesn't start more tasks, unless none are running, and it kills the worker
+/// that most recently started a task that can be retried, at most one per period, so
+/// that the kernel doesn't kill arbitrary workers instead.
+RAY_CONFIG(uint64_t, memory_monitor_interval_ms, 0)
+
+/// The fraction of the node's memory above which the memory monitor considers the node
+/// to be running out of memory.
+RAY_CONFIG(float, memory_usage_threshold, 0.95)
+
+/// Whether to pin the raylet and its workers to the CPUs of the node, on Linux. A
+/// leased worker is pinned to the CPUs of the CPU instances allocated to it if CPU is
+/// one of the predefined_unit_instance_resources, and else only kept off the CPUs
+/// reserved for the raylet.
+RAY_CONFIG(bool, worker_cpu_pinning_enabled, false)
+
+/// The number of CPUs that the raylet and its threads, including the object store, are
+/// pinned to if worker_cpu_pinning_enabled is set. Workers don't run on these CPUs.
+RAY_CONFIG(uint64_t, num_raylet_reserved_cpus, 0)
+
+/// If true, a create request that doesn't fit in the object store doesn't block the
+/// create requests of other clients, which are served round-robin in the meantime.
+/// Otherwise, create requests are served in FIFO order.
+RAY_CONFIG(bool, plasma_create_request_fair_queueing, false)
+
 /// Whether or not the external storage is file system.
 /// This is configured based on object_spilling_config.
 RAY_CONFIG(bool, is_external_storage_type_fs, true)
 
+/// Whether the file system the objects are spilled to is shared by all the nodes and
+/// mounted at the same path on each of them, like NFS. If true, the objects spilled to
+/// it are reported to their owners like those spilled to cloud storage, so that the
+/// nodes that need them restore them from the spilled files directly, instead of asking
+/// the node that spilled them to restore and push them, and they outlive that node.
+RAY_CONFIG(bool, object_spilling_shared_filesystem, false)
+
+/// If not empty, and the external storage is the file system, the raylet spills
+/// objects to fused files in this directory and restores them on threads of its own,
+/// instead of on Python IO workers. The files have the same layout as those of the
+/// Python file system storage.
+RAY_CONFIG(std::string, object_spilling_native_directory, "")
+
+/// Whether the native object spiller writes with O_DIRECT, bypassing the page cache.
+/// It falls back to buffered writes if the file system does not support it.
+RAY_CONFIG(bool, object_spilling_native_direct_io, true)
+
 /* Configuration parameters for locality-aware scheduling. */
 /// Whether to enable locality-aware leasing. If enabled, then Ray will consider task
 /// dependency locality when choosing a worker for leasing.
 RAY_CONFIG(bool, locality_aware_leasing_enabled, true)
 
+/// Whether locality-aware leasing should weigh the bytes to transfer to a node against
+/// the leases that this worker already holds on it, and pick the node with the least
+/// expected completion time, instead of always picking the node with the most bytes.
+RAY_CONFIG(bool, locality_aware_leasing_cost_based, false)
+
+/// The network bandwidth between nodes assumed by cost-based leasing, in bytes/s.
+RAY_CONFIG(uint64_t, locality_aware_leasing_bandwidth_bytes_per_s, 1ULL << 30)
+
+/// The task duration assumed by cost-based leasing to estimate how long a lease waits
+/// behind the others on a node, in milliseconds.
+RAY_CONFIG(uint64_t, locality_aware_leasing_task_duration_ms, 1000)
+
+/// Whether to place actors that use the default scheduling strategy on the node that
+/// holds the most bytes of their creation arguments, if it has the resources. The
+/// owner looks up the locations when it creates the actor.
+RAY_CONFIG(bool, actor_locality_aware_scheduling, false)
+
 /* Configuration parameters for logging */
 /// Parameters for log rotation. This value is equivalent to RotatingFileHandler's
 /// maxBytes argument.
@@ -457,12 +906,66 @@ RAY_CONFIG(int, publish_batch_size, 5000)
 /// Maximum size in bytes of buffered messages per entity, in Ray publisher.
 RAY_CONFIG(int, publisher_entity_buffer_max_bytes, 10 << 20)
 
+/// The maximum size in bytes of the messages published for each publish call, on top
+/// of publish_batch_size. At least one message is always published. 0 means no limit.
+RAY_CONFIG(int64_t, publish_batch_max_bytes, 0)
+
+/// How long the publisher waits for more messages to fill a batch, before it replies
+/// to a waiting subscriber with less than publish_batch_size messages. 0 replies right
+/// away.
+RAY_CONFIG(uint64_t, publish_linger_ms, 0)
+
+/// If true, an actor update that is queued for a subscriber is merged with the
+/// updates of the same actor that are queued after it, so that the subscriber only
+/// gets the latest state of each actor when it polls again.
+RAY_CONFIG(bool, publisher_merge_actor_messages, false)
+
+/// If true, the publisher queues the messages of bulk channels (logs and error infos)
+/// for a subscriber separately, and fills each long polling reply with the messages of
+/// the other channels first, so that ownership and actor messages don't wait behind
+/// bulk traffic. The messages of each channel are still sent in order.
+RAY_CONFIG(bool, publisher_prioritize_channels, false)
+
+/// If true, a worker that is passed a handle to an actor only subscribes to the state
+/// of the actor from the GCS once it submits a task to the actor, instead of when it
+/// deserializes the handle. Handles that are passed along but never called then don't
+/// load the GCS.
+RAY_CONFIG(bool, lazy_actor_state_subscription, false)
+
+/// If true, each worker also listens on a unix domain socket in the session's socket
+/// directory, and workers connect to the other workers on the same node through it
+/// instead of through TCP loopback, e.g. for actor calls between co-located actors.
+RAY_CONFIG(bool, worker_unix_socket_enabled, false)
+
+/// The number of threads that a worker copies large objects into the object store
+/// with when putting them from C++, or 1 to copy them on the calling thread.
+RAY_CONFIG(int, worker_put_memcopy_threads, 1)
+
 /// The maximum command batch size.
 RAY_CONFIG(int64_t, max_command_batch_size, 2000)
 
+/// The maximum number of pubsub command batches a subscriber has in flight to a
+/// publisher. Commands for the same key are still sent in order, one batch at a time.
+RAY_CONFIG(int64_t, max_in_flight_pubsub_command_batches, 1)
+
+/// Whether a pubsub subscriber drops a queued subscribe command together with the
+/// unsubscribe command for the same key that follows it, instead of sending both.
+RAY_CONFIG(bool, merge_pubsub_commands, false)
+
+/// If positive, the max number of object pin requests that a worker sends to its
+/// raylet at a time. Pins made while the max is reached are sent together in one
+/// request when a request finishes, so that tasks creating many plasma objects don't
+/// flood the raylet with pin requests. 0 means unlimited.
+RAY_CONFIG(int64_t, raylet_client_max_pin_requests_in_flight, 0)
+
 /// The maximum batch size for OBOD report.
 RAY_CONFIG(int64_t, max_object_report_batch_size, 2000)
 
+/// How long the object directory of a raylet keeps subscribing to the locations of an
+/// object that it no longer needs, so that its locations are cached and kept up to date
+/// in case it's needed again. 0 unsubscribes right away.
+RAY_CONFIG(int64_t, object_location_cache_ttl_ms, 0)
+
 /// For Ray publishers, the minimum time to drop an inactive subscriber connection in ms.
 /// In the current implementation, a subscriber might be dead for up to 3x the configured
 /// time before it is deleted from the publisher, i.e. deleted in 300s ~ 900s.
@@ -500,12 +1003,29 @@ RAY_CONFIG(std::string, predefined_unit_instance_resources, "GPU")
 /// When set it to "FPGA", we will treat FPGA as unit_instance.
 RAY_CONFIG(std::string, custom_unit_instance_resources, "")
 
+/// The node scorer used by each placement group strategy, as a comma separated list of
+/// <strategy>:<scorer> pairs, e.g. "PACK:dot_product,STRICT_PACK:gpu_fragmentation".
+/// The scorers are "least_resource", "dot_product", "gpu_fragmentation" and
+/// "locality_weighted". Strategies that are not listed use "least_resource".
+RAY_CONFIG(std::string, placement_group_node_scorers, "")
+
 // Maximum size of the batches when broadcasting resources to raylet.
 RAY_CONFIG(uint64_t, resource_broadcast_batch_size, 512);
 
+// The number of raylets that each relay raylet forwards the resource broadcasts to.
+// When it's 0, the GCS sends the broadcasts to every raylet itself. Otherwise, it
+// only sends them to 1 in every (resource_broadcast_relay_fanout + 1) raylets.
+RAY_CONFIG(uint64_t, resource_broadcast_relay_fanout, 0);
+
 // Maximum ray sync message batch size in bytes (1MB by default) between nodes.
 RAY_CONFIG(uint64_t, max_sync_message_batch_bytes, 1 * 1024 * 1024);
 
+// The number of nodes that act as syncer hubs between the GCS and the rest of the
+// nodes. Each hub merges the messages of its children, and only forwards the newest
+// versions. When it's 0, every node syncs with the GCS directly. When it's negative,
+// the square root of the number of nodes is used.
+RAY_CONFIG(int64_t, ray_syncer_num_hubs, 0);
+
 // If enabled and worker stated in container, the container will add
 // resource limit.
 RAY_CONFIG(bool, worker_resource_limits_enabled, false)
@@ -535,6 +1055,17 @@ RAY_CONFIG(int64_t, grpc_keepalive_timeout_ms, 20000);
 /// Whether to use log reporter in event framework
 RAY_CONFIG(bool, event_log_reporter_enabled, false)
 
+/// Whether the event log reporter formats and writes the events on a background
+/// thread, in batches, instead of on the thread that reports them.
+RAY_CONFIG(bool, event_log_reporter_async, false)
+
+/// The fraction of the tasks whose latency is traced by their owner and broken down
+/// by stage, in the task_stage_latency_ms metric. 0 disables the tracing.
+RAY_CONFIG(double, task_latency_trace_sample_rate, 0)
+
+/// The number of the latest traced tasks whose traces are kept by their owner.
+RAY_CONFIG(int64_t, task_latency_trace_buffer_size, 1000)
+
 /// Whether to enable register actor async.
 /// If it is false, the actor registration to GCS becomes synchronous, i.e.,
 /// core worker is blocked until GCS registers the actor and replies to it.
@@ -542,12 +1073,29 @@ RAY_CONFIG(bool, event_log_reporter_enabled, false)
 /// be passed to other worker until it is registered to GCS.
 RAY_CONFIG(bool, actor_register_async, true)
 
+/// The maximum number of actors that are registered to GCS in one RPC. While a
+/// registration RPC is in flight, the actors created in the meantime are queued, and
+/// registered together once it replies. 1 registers each actor in its own RPC.
+/// Only used when actor_register_async is true.
+RAY_CONFIG(int64_t, actor_register_batch_size, 1)
+
 /// Event severity threshold value
 RAY_CONFIG(std::string, event_level, "warning")
 
 /// Whether to avoid scheduling cpu requests on gpu nodes
 RAY_CONFIG(bool, scheduler_avoid_gpu_nodes, true)
 
+/// If set, nodes are grouped by their custom resource whose name starts with this
+/// prefix, e.g. "zone:" for nodes started with the resource "zone:us-west-2a". The
+/// hybrid policy then looks for an available node in the group of the local node
+/// first, and only considers the nodes of other groups if there is none.
+RAY_CONFIG(std::string, scheduler_node_group_resource_prefix, "")
+
+/// If set, every scheduler records its scheduling decisions into a trace file in this
+/// directory, named after the process ID, to be replayed offline by the
+/// `scheduler_replay` benchmark.
+RAY_CONFIG(std::string, scheduler_trace_directory, "")
+
 /// Whether to skip running local GC in runtime env.
 RAY_CONFIG(bool, runtime_env_skip_local_gc, false)
 
@@ -14,12 +14,50 @@
 
 #include "ray/common/ray_syncer/ray_syncer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 
 #include "ray/common/ray_config.h"
 namespace ray {
 namespace syncer {
 
+absl::flat_hash_map<std::string, std::vector<std::string>> AssignSyncerHubs(
+    std::vector<std::string> node_ids, int64_t num_hubs) {
+  if (num_hubs < 0) {
+    num_hubs = static_cast<int64_t>(std::ceil(std::sqrt(node_ids.size())));
+  }
+  absl::flat_hash_map<std::string, std::vector<std::string>> hubs;
+  if (num_hubs == 0 || node_ids.size() <= static_cast<size_t>(num_hubs)) {
+    for (auto &node_id : node_ids) {
+      hubs[std::move(node_id)];
+    }
+    return hubs;
+  }
+
+  std::sort(node_ids.begin(), node_ids.end());
+  std::vector<std::string> hub_ids(node_ids.begin(), node_ids.begin() + num_hubs);
+  for (const auto &hub_id : hub_ids) {
+    hubs[hub_id];
+  }
+  for (size_t i = num_hubs; i < node_ids.size(); ++i) {
+    // boost::hash is used because it's the same in every process, unlike absl::Hash.
+    const std::string *best_hub = nullptr;
+    size_t best_weight = 0;
+    for (const auto &hub_id : hub_ids) {
+      size_t weight = 0;
+      boost::hash_combine(weight, node_ids[i]);
+      boost::hash_combine(weight, hub_id);
+      if (best_hub == nullptr || weight > best_weight) {
+        best_hub = &hub_id;
+        best_weight = weight;
+      }
+    }
+    hubs[*best_hub].push_back(std::move(node_ids[i]));
+  }
+  return hubs;
+}
+
 NodeState::NodeState() { sync_message_versions_taken_.fill(-1); }
 
 bool NodeState::SetComponent(RayComponentId cid,
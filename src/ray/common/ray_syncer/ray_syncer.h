@@ -71,6 +71,24 @@ struct ReceiverInterface {
   virtual ~ReceiverInterface() {}
 };
 
+/// Assign the nodes of the cluster to syncer hubs, for the hierarchical fan-out mode.
+/// The root node (the GCS) connects to every hub, and each hub connects to its
+/// children, so that the root only has as many connections as there are hubs.
+///
+/// The hubs are the nodes with the smallest ids, and the other nodes are spread over
+/// them with rendezvous hashing, so every process that calls this with the same
+/// nodes gets the same assignment, and a node that joins or leaves only moves itself.
+///
+/// \param node_ids The nodes to assign, not including the root.
+/// \param num_hubs The number of hubs. When it's 0, there are no hubs, and the root
+/// connects to every node. When it's negative, the square root of the number of nodes
+/// is used.
+///
+/// \return The nodes the root connects to, with the children that each of them
+/// connects to.
+absl::flat_hash_map<std::string, std::vector<std::string>> AssignSyncerHubs(
+    std::vector<std::string> node_ids, int64_t num_hubs);
+
 // Forward declaration of internal structures
 class NodeState;
 class NodeSyncConnection;
@@ -196,6 +214,7 @@ class RaySyncer {
   FRIEND_TEST(SyncerTest, Test1ToN);
   FRIEND_TEST(SyncerTest, TestMToN);
   FRIEND_TEST(SyncerTest, Reconnect);
+  FRIEND_TEST(SyncerTest, TestHubs);
 };
 
 class ClientSyncConnection;
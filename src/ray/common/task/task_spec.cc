@@ -14,6 +14,7 @@
 
 #include "ray/common/task/task_spec.h"
 
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <sstream>
 
@@ -23,6 +24,39 @@
 
 namespace ray {
 
+namespace {
+
+/// The maximum number of entries in each per-thread interning cache. The caches are
+/// cleared once they grow past it, e.g., if the tasks' shapes keep changing.
+constexpr size_t kMaxInternedEntries = 10000;
+
+/// Append a length-prefixed field to an interning key, so that the concatenation of the
+/// fields is unambiguous.
+void AppendKeyField(const std::string &field, std::string *key) {
+  uint64_t size = field.size();
+  key->append(reinterpret_cast<const char *>(&size), sizeof(size));
+  key->append(field);
+}
+
+/// Intern a function descriptor by its serialized message, so that the tasks of the
+/// same function share it instead of each parsing their own.
+FunctionDescriptor InternFunctionDescriptor(const rpc::FunctionDescriptor &message,
+                                            const std::string &serialized) {
+  thread_local absl::flat_hash_map<std::string, FunctionDescriptor> interned;
+  auto it = interned.find(serialized);
+  if (it != interned.end()) {
+    return it->second;
+  }
+  if (interned.size() >= kMaxInternedEntries) {
+    interned.clear();
+  }
+  auto function_descriptor = FunctionDescriptorBuilder::FromProto(message);
+  interned.emplace(serialized, function_descriptor);
+  return function_descriptor;
+}
+
+}  // namespace
+
 absl::Mutex TaskSpecification::mutex_;
 absl::flat_hash_map<SchedulingClassDescriptor, SchedulingClass>
     TaskSpecification::sched_cls_to_id_;
@@ -110,16 +144,46 @@ void TaskSpecification::ComputeResources() {
         new ResourceSet(MapFromProtobuf(required_placement_resources)));
   }
 
+  const auto serialized_function_descriptor =
+      message_->function_descriptor().SerializeAsString();
+  function_descriptor_ = InternFunctionDescriptor(message_->function_descriptor(),
+                                                  serialized_function_descriptor);
+
   if (!IsActorTask()) {
     // There is no need to compute `SchedulingClass` for actor tasks since
     // the actor tasks need not be scheduled.
-    const auto &resource_set = GetRequiredResources();
-    const auto &function_descriptor = FunctionDescriptor();
+    // The scheduling classes are interned by the wire form of their descriptors, so
+    // that repeated tasks of the same shape are classified without building and
+    // hashing a descriptor, or taking the global lock.
+    thread_local absl::flat_hash_map<std::string, SchedulingClass> interned;
+    std::string key;
+    AppendKeyField(serialized_function_descriptor, &key);
+    std::vector<std::pair<std::string, double>> resources(required_resources.begin(),
+                                                          required_resources.end());
+    std::sort(resources.begin(), resources.end());
+    for (const auto &resource : resources) {
+      AppendKeyField(resource.first, &key);
+      key.append(reinterpret_cast<const char *>(&resource.second),
+                 sizeof(resource.second));
+    }
+    AppendKeyField(message_->scheduling_strategy().SerializeAsString(), &key);
     auto depth = GetDepth();
+    key.append(reinterpret_cast<const char *>(&depth), sizeof(depth));
+
+    auto it = interned.find(key);
+    if (it != interned.end()) {
+      sched_cls_id_ = it->second;
+      return;
+    }
+    const auto &resource_set = GetRequiredResources();
     auto sched_cls_desc = SchedulingClassDescriptor(
-        resource_set, function_descriptor, depth, GetSchedulingStrategy());
+        resource_set, function_descriptor_, depth, GetSchedulingStrategy());
     // Map the scheduling class descriptor to an integer for performance.
     sched_cls_id_ = GetSchedulingClass(sched_cls_desc);
+    if (interned.size() >= kMaxInternedEntries) {
+      interned.clear();
+    }
+    interned.emplace(std::move(key), sched_cls_id_);
   }
 }
 
@@ -153,6 +217,9 @@ TaskID TaskSpecification::ParentTaskId() const {
 size_t TaskSpecification::ParentCounter() const { return message_->parent_counter(); }
 
 ray::FunctionDescriptor TaskSpecification::FunctionDescriptor() const {
+  if (function_descriptor_) {
+    return function_descriptor_;
+  }
   return ray::FunctionDescriptorBuilder::FromProto(message_->function_descriptor());
 }
 
@@ -201,6 +268,14 @@ ObjectID TaskSpecification::ReturnId(size_t return_index) const {
   return ObjectID::FromIndex(TaskId(), return_index + 1);
 }
 
+bool TaskSpecification::StreamingReturns() const {
+  return message_->streaming_returns();
+}
+
+ObjectID TaskSpecification::StreamingReturnId(int64_t index) const {
+  return ObjectID::FromIndex(TaskId(), NumReturns() + 1 + index);
+}
+
 bool TaskSpecification::ArgByRef(size_t arg_index) const {
   return message_->args(arg_index).has_object_ref();
 }
@@ -388,6 +463,12 @@ int TaskSpecification::MaxActorConcurrency() const {
   return message_->actor_creation_task_spec().max_concurrency();
 }
 
+NodeID TaskSpecification::ActorCreationLocalityNodeId() const {
+  RAY_CHECK(IsActorCreationTask());
+  const auto &node_id = message_->actor_creation_task_spec().locality_node_id();
+  return node_id.empty() ? NodeID::Nil() : NodeID::FromBinary(node_id);
+}
+
 std::string TaskSpecification::ConcurrencyGroupName() const {
   RAY_CHECK(IsActorTask());
   return message_->concurrency_group_name();
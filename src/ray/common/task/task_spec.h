@@ -221,6 +221,15 @@ class TaskSpecification : public MessageWrapper<rpc::TaskSpec> {
 
   ObjectID ReturnId(size_t return_index) const;
 
+  /// Whether the task streams results to the caller while it runs.
+  bool StreamingReturns() const;
+
+  /// The ID of a result that the task streams. The streamed results are numbered
+  /// after all of the fixed returns of the task.
+  ///
+  /// \param index The index of the result among the streamed results.
+  ObjectID StreamingReturnId(int64_t index) const;
+
   const uint8_t *ArgData(size_t arg_index) const;
 
   size_t ArgDataSize(size_t arg_index) const;
@@ -330,6 +339,10 @@ class TaskSpecification : public MessageWrapper<rpc::TaskSpec> {
 
   int MaxActorConcurrency() const;
 
+  /// The node that held the most bytes of the arguments of the actor creation task,
+  /// or nil if it's not known.
+  NodeID ActorCreationLocalityNodeId() const;
+
   bool IsAsyncioActor() const;
 
   bool IsDetachedActor() const;
@@ -373,6 +386,9 @@ class TaskSpecification : public MessageWrapper<rpc::TaskSpec> {
   std::shared_ptr<ResourceSet> required_placement_resources_;
   /// Cached scheduling class of this task.
   SchedulingClass sched_cls_id_ = 0;
+  /// Cached function descriptor of this task, so that it isn't parsed from the message
+  /// on every access. Initialized in constructor.
+  ray::FunctionDescriptor function_descriptor_;
 
   /// Below static fields could be mutated in `ComputeResources` concurrently due to
   /// multi-threading, we need a mutex to protect it.
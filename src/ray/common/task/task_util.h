@@ -225,6 +225,15 @@ class TaskSpecBuilder {
     return *this;
   }
 
+  /// Set the node that the actor creation task prefers for the locality of its
+  /// arguments. This must be called after SetActorCreationTaskSpec.
+  ///
+  /// \return Reference to the builder object itself.
+  TaskSpecBuilder &SetActorCreationLocalityNodeId(const NodeID &node_id) {
+    message_->mutable_actor_creation_task_spec()->set_locality_node_id(node_id.Binary());
+    return *this;
+  }
+
   /// Set the `ActorTaskSpec` of the task spec.
   /// See `common.proto` for meaning of the arguments.
   ///
@@ -244,6 +253,14 @@ class TaskSpecBuilder {
     return *this;
   }
 
+  /// Set whether the task streams results to the caller while it runs.
+  ///
+  /// \return Reference to the builder object itself.
+  TaskSpecBuilder &SetStreamingReturns(bool streaming_returns) {
+    message_->set_streaming_returns(streaming_returns);
+    return *this;
+  }
+
  private:
   std::shared_ptr<rpc::TaskSpec> message_;
 };
@@ -146,6 +146,64 @@ TEST_F(ClientConnectionTest, SimpleAsyncWrite) {
   ASSERT_EQ(num_messages, 3);
 }
 
+TEST_F(ClientConnectionTest, CoalescedAsyncWrites) {
+  // Enough messages of different sizes that they are written in several batches, and
+  // some of them reuse the buffers of earlier ones.
+  const int num_messages = 500;
+  std::vector<std::vector<uint8_t>> messages(num_messages);
+  for (int i = 0; i < num_messages; i++) {
+    messages[i].resize((i * 37) % 5000, static_cast<uint8_t>(i));
+  }
+  int num_received = 0;
+  int num_written = 0;
+
+  ClientHandler client_handler = [](ClientConnection &client) {};
+
+  MessageHandler noop_handler = [](std::shared_ptr<ClientConnection> client,
+                                   int64_t message_type,
+                                   const std::vector<uint8_t> &message) {};
+
+  std::shared_ptr<ClientConnection> reader = NULL;
+
+  MessageHandler message_handler = [&messages, &num_received, &reader](
+                                       std::shared_ptr<ClientConnection> client,
+                                       int64_t message_type,
+                                       const std::vector<uint8_t> &message) {
+    ASSERT_EQ(message_type, num_received % 7);
+    ASSERT_EQ(message, messages[num_received]);
+    num_received += 1;
+    if (num_received < static_cast<int>(messages.size())) {
+      reader->ProcessMessages();
+    }
+  };
+
+  auto writer = ClientConnection::Create(
+      client_handler, noop_handler, std::move(in_), "writer", {}, error_message_type_);
+
+  reader = ClientConnection::Create(client_handler,
+                                    message_handler,
+                                    std::move(out_),
+                                    "reader",
+                                    {},
+                                    error_message_type_);
+
+  for (int i = 0; i < num_messages; i++) {
+    writer->WriteMessageAsync(i % 7,
+                              messages[i].size(),
+                              messages[i].data(),
+                              [&num_written, i](const ray::Status &status) {
+                                RAY_CHECK_OK(status);
+                                // Handlers are called in the order of the messages.
+                                ASSERT_EQ(num_written, i);
+                                num_written += 1;
+                              });
+  }
+  reader->ProcessMessages();
+  io_service_.run();
+  ASSERT_EQ(num_received, num_messages);
+  ASSERT_EQ(num_written, num_messages);
+}
+
 TEST_F(ClientConnectionTest, SimpleSyncReadWriteMessage) {
   auto writer = ServerConnection::Create(std::move(in_));
   auto reader = ServerConnection::Create(std::move(out_));
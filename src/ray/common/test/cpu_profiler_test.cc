@@ -0,0 +1,53 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/cpu_profiler.h"
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+#ifdef __linux__
+TEST(CpuProfilerTest, TestProfile) {
+  auto &profiler = CpuProfiler::Instance();
+  std::string profile;
+  ASSERT_TRUE(profiler.Stop(&profile).IsInvalid());
+  ASSERT_TRUE(profiler.Start(1000).ok());
+  ASSERT_TRUE(profiler.Start(1000).IsInvalid());
+
+  volatile int64_t sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(200)) {
+    sum += 1;
+  }
+  ASSERT_TRUE(profiler.Stop(&profile).ok());
+
+  // The header holds the sampling period, and is followed by at least one sample.
+  const auto *words = reinterpret_cast<const uintptr_t *>(profile.data());
+  ASSERT_GT(profile.size(), 7 * sizeof(uintptr_t));
+  ASSERT_EQ(words[1], 3u);
+  ASSERT_EQ(words[3], 1000u);
+  ASSERT_GT(words[5], 0u);
+  // The memory mappings are at the end.
+  ASSERT_NE(profile.find("[stack]"), std::string::npos);
+
+  // Another profile can be taken after the first one.
+  ASSERT_TRUE(profiler.Start(100).ok());
+  ASSERT_TRUE(profiler.Stop(&profile).ok());
+}
+#endif
+
+}  // namespace ray
@@ -0,0 +1,123 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/asio/instrumented_io_context.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ray/common/asio/asio_util.h"
+#include "ray/common/ray_config.h"
+
+TEST(InstrumentedIoContextTest, TestBatchedPost) {
+  RayConfig::instance().initialize(R"({"event_loop_batched_post": true})");
+  instrumented_io_context io_service;
+  const int num_threads = 4;
+  const int num_posts = 1000;
+  // The handlers are run on the event loop, so these don't need to be synchronized.
+  std::vector<int> num_run(num_threads, 0);
+  bool in_order = true;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < num_posts; j++) {
+        io_service.post(
+            [&, i, j]() {
+              in_order = in_order && num_run[i] == j;
+              num_run[i]++;
+            },
+            "TestBatchedPost");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  io_service.run();
+
+  ASSERT_TRUE(in_order);
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_EQ(num_run[i], num_posts);
+  }
+  auto stats = io_service.stats().get_event_stats("TestBatchedPost");
+  ASSERT_TRUE(stats.has_value());
+  ASSERT_EQ(stats->cum_count, num_threads * num_posts);
+  ASSERT_EQ(stats->curr_count, 0);
+
+  // The handlers that aren't run are destroyed with the event loop.
+  io_service.restart();
+  io_service.post([]() {}, "TestBatchedPost");
+  RayConfig::instance().initialize("");
+}
+
+TEST(InstrumentedIoContextTest, TestStatsAcrossThreads) {
+  instrumented_io_context io_service;
+  const int num_threads = 4;
+  const int num_events = 100;
+  // Start the events on some threads, and finish them on others, so that the stats
+  // of every event are recorded to different shards.
+  std::vector<std::shared_ptr<StatsHandle>> handles(num_threads * num_events);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < num_events; j++) {
+        handles[i * num_events + j] = io_service.stats().RecordStart("TestEvent");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stats = io_service.stats().get_event_stats("TestEvent");
+  ASSERT_EQ(stats->cum_count, num_threads * num_events);
+  ASSERT_EQ(stats->curr_count, num_threads * num_events);
+
+  threads.clear();
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < num_events; j++) {
+        EventTracker::RecordExecution([]() {}, handles[j * num_threads + i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  stats = io_service.stats().get_event_stats("TestEvent");
+  ASSERT_EQ(stats->cum_count, num_threads * num_events);
+  ASSERT_EQ(stats->curr_count, 0);
+  ASSERT_EQ(stats->running_count, 0);
+  const auto global_stats = io_service.stats().get_global_stats();
+  ASSERT_GE(global_stats.min_queue_time, 0);
+  ASSERT_GE(global_stats.max_queue_time, global_stats.min_queue_time);
+}
+
+TEST(InstrumentedIoContextTest, TestLagProbe) {
+  RayConfig::instance().initialize(R"({"event_loop_lag_probe_interval_ms": 50})");
+  instrumented_io_context io_service;
+  io_service.StartLagProbe("TestLagProbe");
+  // Block the loop past the first probe, and stop it before the probe after it.
+  io_service.post(
+      [&io_service]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        execute_after(io_service, [&io_service]() { io_service.stop(); }, 20);
+      },
+      "TestLagProbe.Block");
+  io_service.run();
+  ASSERT_GE(io_service.LastLagMs(), 100);
+  RayConfig::instance().initialize("");
+}
@@ -0,0 +1,59 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/mutex_contention.h"
+
+#include <chrono>
+#include <thread>
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+#include "ray/common/ray_config.h"
+
+namespace ray {
+
+TEST(MutexContentionTest, TestContentionIsRecorded) {
+  RayConfig::instance().initialize(R"({"mutex_contention_tracing": true})");
+  auto &tracker = MutexContentionTracker::Instance();
+  absl::Mutex mutex;
+  absl::Notification locked;
+  {
+    TrackedMutexName name(&mutex, "TestContentionIsRecorded");
+    std::thread holder([&]() {
+      absl::MutexLock lock(&mutex);
+      locked.Notify();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+    locked.WaitForNotification();
+    // Wait for the holder to release the mutex.
+    { absl::MutexLock lock(&mutex); }
+    holder.join();
+    const auto stats = tracker.GetStats("TestContentionIsRecorded");
+    ASSERT_EQ(stats.num_contentions, 1);
+    ASSERT_GT(stats.wait_time_ns, 0);
+  }
+
+  // Unregistered mutexes aren't recorded anymore.
+  std::thread holder([&]() {
+    absl::MutexLock lock(&mutex);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  { absl::MutexLock lock(&mutex); }
+  holder.join();
+  ASSERT_EQ(tracker.GetStats("TestContentionIsRecorded").num_contentions, 1);
+  RayConfig::instance().initialize("");
+}
+
+}  // namespace ray
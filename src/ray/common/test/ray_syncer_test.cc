@@ -814,5 +814,74 @@ TEST(SyncerTest, TestMToN) {
   ASSERT_TRUE(TestCorrectness(get_cluster_view, servers, g));
 }
 
+TEST(SyncerTest, AssignSyncerHubs) {
+  std::vector<std::string> node_ids;
+  for (int i = 0; i < 100; ++i) {
+    node_ids.push_back(NodeID::FromRandom().Binary());
+  }
+  // Without hubs, the root connects to every node.
+  auto hubs = AssignSyncerHubs(node_ids, 0);
+  ASSERT_EQ(hubs.size(), 100);
+  for (const auto &[_, children] : hubs) {
+    ASSERT_TRUE(children.empty());
+  }
+
+  hubs = AssignSyncerHubs(node_ids, -1);
+  ASSERT_EQ(hubs.size(), 10);
+  std::set<std::string> assigned;
+  for (const auto &[hub_id, children] : hubs) {
+    assigned.insert(hub_id);
+    assigned.insert(children.begin(), children.end());
+  }
+  ASSERT_EQ(assigned, std::set<std::string>(node_ids.begin(), node_ids.end()));
+
+  // A new node, which is not a hub, doesn't move the other nodes.
+  std::string new_node_id(NodeID::Size(), '\xff');
+  node_ids.push_back(new_node_id);
+  auto new_hubs = AssignSyncerHubs(node_ids, 10);
+  for (auto &[hub_id, children] : new_hubs) {
+    children.erase(std::remove(children.begin(), children.end(), new_node_id),
+                   children.end());
+    ASSERT_EQ(children, hubs[hub_id]);
+  }
+}
+
+TEST(SyncerTest, TestHubs) {
+  size_t base_port = 18990;
+  std::vector<std::unique_ptr<SyncerServerTest>> servers;
+  std::map<std::string, size_t> node_id_to_idx;
+  std::vector<std::string> node_ids;
+  for (int i = 0; i < 20; ++i) {
+    servers.push_back(
+        std::make_unique<SyncerServerTest>(std::to_string(i + base_port), i != 0));
+    node_id_to_idx[servers[i]->syncer->GetLocalNodeID()] = i;
+    if (i != 0) {
+      node_ids.push_back(servers[i]->syncer->GetLocalNodeID());
+    }
+  }
+  // The root connects to the hubs, and the hubs connect to their children.
+  std::vector<std::set<size_t>> g(servers.size());
+  for (const auto &[hub_id, children] : AssignSyncerHubs(node_ids, -1)) {
+    auto hub = node_id_to_idx[hub_id];
+    servers[0]->syncer->Connect(MakeChannel(servers[hub]->server_port));
+    g[0].insert(hub);
+    for (const auto &child_id : children) {
+      auto child = node_id_to_idx[child_id];
+      servers[hub]->syncer->Connect(MakeChannel(servers[child]->server_port));
+      g[hub].insert(child);
+    }
+  }
+
+  auto get_cluster_view = [](RaySyncer &syncer) {
+    std::promise<TClusterView> p;
+    auto f = p.get_future();
+    syncer.GetIOContext().post(
+        [&p, &syncer]() mutable { p.set_value(syncer.node_state_->GetClusterView()); },
+        "TEST");
+    return f.get();
+  };
+  ASSERT_TRUE(TestCorrectness(get_cluster_view, servers, g));
+}
+
 }  // namespace syncer
 }  // namespace ray
@@ -113,6 +113,32 @@ TEST(TaskSpecTest, TestTaskSpecification) {
   ASSERT_TRUE(task_spec.GetNodeAffinitySchedulingStrategySoft());
   ASSERT_TRUE(task_spec.GetNodeAffinitySchedulingStrategyNodeId() == node_id);
 }
+
+TEST(TaskSpecTest, TestInternedSchedulingClass) {
+  auto make_task_spec = [](const std::string &function_name, double cpus) {
+    rpc::TaskSpec message;
+    message.mutable_function_descriptor()
+        ->mutable_python_function_descriptor()
+        ->set_function_name(function_name);
+    (*message.mutable_required_resources())["CPU"] = cpus;
+    message.mutable_scheduling_strategy()->mutable_default_scheduling_strategy();
+    return TaskSpecification(std::move(message));
+  };
+  auto task_spec1 = make_task_spec("f", 1);
+  auto task_spec2 = make_task_spec("f", 1);
+  auto task_spec3 = make_task_spec("f", 2);
+  auto task_spec4 = make_task_spec("g", 1);
+  // Tasks of the same shape share the scheduling class and the function descriptor.
+  ASSERT_EQ(task_spec1.GetSchedulingClass(), task_spec2.GetSchedulingClass());
+  ASSERT_EQ(task_spec1.FunctionDescriptor(), task_spec2.FunctionDescriptor());
+  ASSERT_NE(task_spec1.GetSchedulingClass(), task_spec3.GetSchedulingClass());
+  ASSERT_NE(task_spec1.GetSchedulingClass(), task_spec4.GetSchedulingClass());
+  // The interned class is the same as the one of its descriptor.
+  ASSERT_EQ(task_spec3.GetSchedulingClass(),
+            TaskSpecification::GetSchedulingClass(
+                TaskSpecification::GetSchedulingClassDescriptor(
+                    task_spec3.GetSchedulingClass())));
+}
 }  // namespace ray
 
 int main(int argc, char **argv) {
@@ -0,0 +1,72 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/asio/timer_wheel.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+TEST(TimerWheelTest, TestRunAfter) {
+  instrumented_io_context io_context;
+  TimerWheel wheel(io_context, /*tick_ms=*/5, /*num_slots=*/4);
+  std::vector<int> run;
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration long_timeout_elapsed;
+  wheel.RunAfter(10, [&]() { run.push_back(10); });
+  wheel.RunAfter(0, [&]() { run.push_back(0); });
+  // This takes several turns of the wheel.
+  wheel.RunAfter(50, [&]() {
+    run.push_back(50);
+    long_timeout_elapsed = std::chrono::steady_clock::now() - start;
+  });
+  const auto canceled = wheel.RunAfter(5, [&]() { run.push_back(5); });
+  ASSERT_EQ(wheel.NumPending(), 4);
+  ASSERT_TRUE(wheel.Cancel(canceled));
+  ASSERT_FALSE(wheel.Cancel(canceled));
+  ASSERT_EQ(wheel.NumPending(), 3);
+
+  while (wheel.NumPending() > 0) {
+    io_context.run_one();
+  }
+  ASSERT_EQ(run, std::vector<int>({0, 10, 50}));
+  // Timeouts never expire early.
+  ASSERT_GE(long_timeout_elapsed, std::chrono::milliseconds(50));
+}
+
+TEST(TimerWheelTest, TestRunAfterWhileTicking) {
+  instrumented_io_context io_context;
+  TimerWheel wheel(io_context, /*tick_ms=*/5, /*num_slots=*/4);
+  std::chrono::steady_clock::time_point added;
+  std::chrono::steady_clock::duration elapsed;
+  bool done = false;
+  wheel.RunAfter(5, [&]() {
+    added = std::chrono::steady_clock::now();
+    // Added from a function run by the wheel, and after the wheel was idle.
+    wheel.RunAfter(10, [&]() {
+      elapsed = std::chrono::steady_clock::now() - added;
+      done = true;
+    });
+  });
+  while (!done) {
+    io_context.run_one();
+  }
+  ASSERT_GE(elapsed, std::chrono::milliseconds(10));
+  ASSERT_EQ(wheel.NumPending(), 0);
+}
+
+}  // namespace ray
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <deque>
 #include <memory>
 
 #include "ray/common/ray_config.h"
@@ -86,15 +87,16 @@ class DefaultActorCreator : public ActorCreatorInterface {
       if (callback != nullptr) {
         (*registering_actors_)[actor_id].emplace_back(std::move(callback));
       }
+      if (::RayConfig::instance().actor_register_batch_size() > 1) {
+        pending_registrations_->queued.push_back(task_spec);
+        if (!pending_registrations_->in_flight) {
+          SendRegistrationBatch();
+        }
+        return Status::OK();
+      }
       return gcs_client_->Actors().AsyncRegisterActor(
-          task_spec, [actor_id, this](Status status) {
-            std::vector<ray::gcs::StatusCallback> cbs;
-            cbs = std::move((*registering_actors_)[actor_id]);
-            registering_actors_->erase(actor_id);
-            for (auto &cb : cbs) {
-              cb(status);
-            }
-          });
+          task_spec,
+          [actor_id, this](Status status) { OnActorRegistered(actor_id, status); });
     } else {
       callback(RegisterActor(task_spec));
       return Status::OK();
@@ -119,10 +121,64 @@ class DefaultActorCreator : public ActorCreatorInterface {
   }
 
  private:
+  /// Invoke the callbacks that wait for the registration of an actor.
+  void OnActorRegistered(const ActorID &actor_id, const Status &status) {
+    std::vector<ray::gcs::StatusCallback> cbs;
+    cbs = std::move((*registering_actors_)[actor_id]);
+    registering_actors_->erase(actor_id);
+    for (auto &cb : cbs) {
+      cb(status);
+    }
+  }
+
+  /// Register the queued actors in one RPC. The actors that are queued while the RPC
+  /// is in flight are sent in the next batch once it replies.
+  void SendRegistrationBatch() {
+    auto &pending = *pending_registrations_;
+    if (pending.queued.empty()) {
+      pending.in_flight = false;
+      return;
+    }
+    const size_t batch_size =
+        std::min(pending.queued.size(),
+                 static_cast<size_t>(::RayConfig::instance().actor_register_batch_size()));
+    std::vector<TaskSpecification> batch(
+        std::make_move_iterator(pending.queued.begin()),
+        std::make_move_iterator(pending.queued.begin() + batch_size));
+    pending.queued.erase(pending.queued.begin(), pending.queued.begin() + batch_size);
+    std::vector<ActorID> actor_ids;
+    actor_ids.reserve(batch.size());
+    for (const auto &task_spec : batch) {
+      actor_ids.push_back(task_spec.ActorCreationId());
+    }
+    pending.in_flight = true;
+    auto status = gcs_client_->Actors().AsyncRegisterActors(
+        batch, [this, actor_ids](std::vector<Status> statuses) {
+          for (size_t i = 0; i < actor_ids.size(); i++) {
+            OnActorRegistered(actor_ids[i], statuses[i]);
+          }
+          SendRegistrationBatch();
+        });
+    if (!status.ok()) {
+      for (const auto &actor_id : actor_ids) {
+        OnActorRegistered(actor_id, status);
+      }
+      SendRegistrationBatch();
+    }
+  }
+
   std::shared_ptr<gcs::GcsClient> gcs_client_;
   using RegisteringActorType =
       absl::flat_hash_map<ActorID, std::vector<ray::gcs::StatusCallback>>;
   ThreadPrivate<RegisteringActorType> registering_actors_;
+
+  /// The actors that wait to be registered in a batch.
+  struct PendingRegistrations {
+    std::deque<TaskSpecification> queued;
+    /// Whether a batch is being registered.
+    bool in_flight = false;
+  };
+  ThreadPrivate<PendingRegistrations> pending_registrations_;
 };
 
 }  // namespace core
@@ -164,10 +164,17 @@ bool ActorManager::AddActorHandle(std::unique_ptr<ActorHandle> actor_handle,
   reference_counter_->AddLocalReference(actor_creation_return_id, call_site);
   direct_actor_submitter_->AddActorQueueIfNotExists(
       actor_id, actor_handle->MaxPendingCalls(), actor_handle->ExecuteOutOfOrder());
+  // Only borrowed handles are subscribed to lazily. Named actors are subscribed to
+  // right away, since they are only cached once the subscription is done.
+  const bool subscribe_lazily =
+      lazy_subscription_ && !is_owner_handle && cached_actor_name.empty() && !is_self;
   bool inserted;
   {
     absl::MutexLock lock(&mutex_);
     inserted = actor_handles_.emplace(actor_id, std::move(actor_handle)).second;
+    if (inserted && subscribe_lazily) {
+      actors_pending_subscription_.insert(actor_id);
+    }
   }
 
   if (is_self) {
@@ -178,29 +185,46 @@ bool ActorManager::AddActorHandle(std::unique_ptr<ActorHandle> actor_handle,
     return inserted;
   }
 
-  if (inserted) {
-    // Register a callback to handle actor notifications.
-    auto actor_notification_callback =
-        std::bind(&ActorManager::HandleActorStateNotification,
-                  this,
-                  std::placeholders::_1,
-                  std::placeholders::_2);
-    RAY_CHECK_OK(gcs_client_->Actors().AsyncSubscribe(
-        actor_id,
-        actor_notification_callback,
-        [this, actor_id, cached_actor_name](Status status) {
-          if (status.ok() && !cached_actor_name.empty()) {
-            {
-              absl::MutexLock lock(&cache_mutex_);
-              cached_actor_name_to_ids_.emplace(cached_actor_name, actor_id);
-            }
-          }
-        }));
+  if (inserted && !subscribe_lazily) {
+    SubscribeActorState(actor_id, cached_actor_name);
   }
 
   return inserted;
 }
 
+void ActorManager::SubscribeActorStateIfNeeded(const ActorID &actor_id) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (actors_pending_subscription_.erase(actor_id) == 0) {
+      return;
+    }
+  }
+  RAY_LOG(DEBUG) << "Subscribing to the state of actor " << actor_id
+                 << " on its first task submission";
+  SubscribeActorState(actor_id, /*cached_actor_name=*/"");
+}
+
+void ActorManager::SubscribeActorState(const ActorID &actor_id,
+                                       const std::string &cached_actor_name) {
+  // Register a callback to handle actor notifications.
+  auto actor_notification_callback =
+      std::bind(&ActorManager::HandleActorStateNotification,
+                this,
+                std::placeholders::_1,
+                std::placeholders::_2);
+  RAY_CHECK_OK(gcs_client_->Actors().AsyncSubscribe(
+      actor_id,
+      actor_notification_callback,
+      [this, actor_id, cached_actor_name](Status status) {
+        if (status.ok() && !cached_actor_name.empty()) {
+          {
+            absl::MutexLock lock(&cache_mutex_);
+            cached_actor_name_to_ids_.emplace(cached_actor_name, actor_id);
+          }
+        }
+      }));
+}
+
 void ActorManager::OnActorKilled(const ActorID &actor_id) {
   const auto &actor_handle = GetActorHandle(actor_id);
   const auto &actor_name = actor_handle->GetName();
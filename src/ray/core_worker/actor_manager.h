@@ -15,6 +15,8 @@
 #pragma once
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "ray/common/ray_config.h"
 #include "ray/core_worker/actor_creator.h"
 #include "ray/core_worker/actor_handle.h"
 #include "ray/core_worker/reference_count.h"
@@ -32,10 +34,12 @@ class ActorManager {
   explicit ActorManager(
       std::shared_ptr<gcs::GcsClient> gcs_client,
       std::shared_ptr<CoreWorkerDirectActorTaskSubmitterInterface> direct_actor_submitter,
-      std::shared_ptr<ReferenceCounterInterface> reference_counter)
+      std::shared_ptr<ReferenceCounterInterface> reference_counter,
+      bool lazy_subscription = RayConfig::instance().lazy_actor_state_subscription())
       : gcs_client_(gcs_client),
         direct_actor_submitter_(direct_actor_submitter),
-        reference_counter_(reference_counter) {}
+        reference_counter_(reference_counter),
+        lazy_subscription_(lazy_subscription) {}
 
   ~ActorManager() = default;
 
@@ -60,6 +64,14 @@ class ActorManager {
                               const rpc::Address &caller_address,
                               bool is_self = false);
 
+  /// Subscribe to the state of an actor from the GCS, if the actor's handle was
+  /// registered with a lazy subscription that didn't start yet. This should be called
+  /// before a task is submitted to the actor, since tasks aren't sent until the actor
+  /// is known to be alive.
+  ///
+  /// \param[in] actor_id The actor to subscribe to.
+  void SubscribeActorStateIfNeeded(const ActorID &actor_id);
+
   /// Get a handle to an actor.
   ///
   /// \param[in] actor_id The actor handle to get.
@@ -161,6 +173,13 @@ class ActorManager {
                       const ObjectID &actor_creation_return_id,
                       bool is_self = false);
 
+  /// Subscribe to the state of an actor from the GCS.
+  ///
+  /// \param[in] actor_id The actor to subscribe to.
+  /// \param[in] cached_actor_name Actor name used to cache named actor, once the
+  /// subscription is done.
+  void SubscribeActorState(const ActorID &actor_id, const std::string &cached_actor_name);
+
   /// Check if named actor is cached locally.
   /// If it has been cached, core worker will not get actor id by name from GCS.
   ActorID GetCachedNamedActorID(const std::string &actor_name);
@@ -182,8 +201,16 @@ class ActorManager {
   /// All actor handle related ref counting logic should be included here.
   std::shared_ptr<ReferenceCounterInterface> reference_counter_;
 
+  /// Whether to subscribe to the state of actors whose handles are borrowed only once
+  /// a task is submitted to them.
+  const bool lazy_subscription_;
+
   mutable absl::Mutex mutex_;
 
+  /// The actors whose handles were registered, but whose state wasn't subscribed to
+  /// yet because no task was submitted to them.
+  absl::flat_hash_set<ActorID> actors_pending_subscription_ GUARDED_BY(mutex_);
+
   /// Map from actor ID to a handle to that actor.
   /// Actor handle is a logical abstraction that holds actor handle's states.
   absl::flat_hash_map<ActorID, std::shared_ptr<ActorHandle>> actor_handles_
@@ -79,6 +79,9 @@ struct TaskOptions {
   /// fields which not contained in Runtime Env, such as eager_install.
   /// Propagated to child actors and tasks.
   std::string serialized_runtime_env_info;
+  /// Whether the task streams results to the caller while it runs. This is only
+  /// supported for actor tasks.
+  bool streaming_returns = false;
 };
 
 /// Options for actor creation tasks.
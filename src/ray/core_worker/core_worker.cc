@@ -18,6 +18,7 @@
 
 #include "boost/fiber/all.hpp"
 #include "ray/common/bundle_spec.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/common/ray_config.h"
 #include "ray/common/runtime_env_common.h"
 #include "ray/common/task/task_util.h"
@@ -164,6 +165,19 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
                                         assigned_port,
                                         options_.node_ip_address == "127.0.0.1");
   core_worker_server_->RegisterService(grpc_service_);
+#ifndef _WIN32
+  // The workers of the node put their sockets next to the raylet's socket.
+  const auto socket_dir_end = options_.raylet_socket.find_last_of('/');
+  if (RayConfig::instance().worker_unix_socket_enabled() &&
+      !RayConfig::instance().USE_TLS() && socket_dir_end != std::string::npos) {
+    worker_socket_dir_ = options_.raylet_socket.substr(0, socket_dir_end);
+    const auto unix_socket_path = rpc::CoreWorkerClient::UnixSocketPath(
+        worker_socket_dir_, worker_context_.GetWorkerID());
+    if (!unix_socket_path.empty()) {
+      core_worker_server_->ListenOnUnixSocket(unix_socket_path);
+    }
+  }
+#endif
   core_worker_server_->Run();
 
   // Set our own address.
@@ -200,8 +214,17 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
   RAY_CHECK_OK(gcs_client_->Connect(io_service_));
   RegisterToGcs();
 
+  if (RayConfig::instance().scale_pending_lease_requests_with_cluster_size()) {
+    lease_request_rate_limiter_ =
+        std::make_shared<ClusterSizeBasedLeaseRequestRateLimiter>(
+            RayConfig::instance().max_pending_lease_requests_per_scheduling_category());
+  }
+
   // Register a callback to monitor removed nodes.
   auto on_node_change = [this](const NodeID &node_id, const rpc::GcsNodeInfo &data) {
+    if (lease_request_rate_limiter_) {
+      lease_request_rate_limiter_->OnNodeChange(node_id, data);
+    }
     if (data.state() == rpc::GcsNodeInfo::DEAD) {
       OnNodeRemoved(node_id);
     }
@@ -212,8 +235,23 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
   profiler_ = std::make_shared<worker::Profiler>(
       worker_context_, options_.node_ip_address, io_service_, gcs_client_);
 
-  core_worker_client_pool_ =
-      std::make_shared<rpc::CoreWorkerClientPool>(*client_call_manager_);
+  if (worker_socket_dir_.empty()) {
+    core_worker_client_pool_ =
+        std::make_shared<rpc::CoreWorkerClientPool>(*client_call_manager_);
+  } else {
+    // Connect to the workers on this node through their unix domain sockets.
+    core_worker_client_pool_ = std::make_shared<rpc::CoreWorkerClientPool>(
+        [this, local_raylet_id](const rpc::Address &addr) {
+          std::string unix_socket_path;
+          if (addr.raylet_id() == local_raylet_id.Binary()) {
+            unix_socket_path = rpc::CoreWorkerClient::UnixSocketPath(
+                worker_socket_dir_, WorkerID::FromBinary(addr.worker_id()));
+          }
+          return std::make_shared<rpc::CoreWorkerClient>(
+              addr, *client_call_manager_, unix_socket_path);
+        },
+        RayConfig::instance().core_worker_client_pool_max_size());
+  }
 
   object_info_publisher_ = std::make_unique<pubsub::Publisher>(
       /*channels=*/std::vector<
@@ -281,6 +319,23 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
               }
             },
             "CoreWorker.HandleException");
+      },
+      /*object_allocator=*/nullptr,
+      /*promote_to_plasma=*/
+      [this](const RayObject &object, const ObjectID &object_id) {
+        // Only the owner may create the primary copy of an object.
+        if (options_.is_local_mode || !reference_counter_->OwnedByUs(object_id)) {
+          return false;
+        }
+        auto status = CreateInLocalPlasmaStore(object, object_id, /*pin_object=*/true);
+        if (!status.ok()) {
+          RAY_LOG(WARNING) << "Failed to promote object " << object_id
+                           << " to plasma: " << status.ToString();
+          return false;
+        }
+        reference_counter_->UpdateObjectPinnedAtRaylet(
+            object_id, NodeID::FromBinary(rpc_address_.raylet_id()));
+        return true;
       }));
 
   periodical_runner_.RunFnPeriodically([this] { InternalHeartbeat(); },
@@ -372,7 +427,8 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
                                              *task_manager_,
                                              *actor_creator_,
                                              on_excess_queueing,
-                                             io_service_));
+                                             io_service_,
+                                             reference_counter_.get()));
 
   auto node_addr_factory = [this](const NodeID &node_id) {
     absl::optional<rpc::Address> addr;
@@ -385,10 +441,28 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
     }
     return addr;
   };
+  absl::optional<LeaseCostModel> lease_cost_model;
+  if (RayConfig::instance().locality_aware_leasing_cost_based()) {
+    lease_cost_model = LeaseCostModel{
+        RayConfig::instance().locality_aware_leasing_bandwidth_bytes_per_s() / 1000.0,
+        static_cast<double>(RayConfig::instance().locality_aware_leasing_task_duration_ms()),
+        [this](const NodeID &node_id) {
+          if (auto node_info = gcs_client_->Nodes().Get(node_id)) {
+            auto it = node_info->resources_total().find("CPU");
+            if (it != node_info->resources_total().end()) {
+              return it->second;
+            }
+          }
+          return 0.0;
+        }};
+  }
   auto lease_policy = RayConfig::instance().locality_aware_leasing_enabled()
                           ? std::shared_ptr<LeasePolicyInterface>(
                                 std::make_shared<LocalityAwareLeasePolicy>(
-                                    reference_counter_, node_addr_factory, rpc_address_))
+                                    reference_counter_,
+                                    node_addr_factory,
+                                    rpc_address_,
+                                    std::move(lease_cost_model)))
                           : std::shared_ptr<LeasePolicyInterface>(
                                 std::make_shared<LocalLeasePolicy>(rpc_address_));
 
@@ -406,7 +480,12 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
       actor_creator_,
       worker_context_.GetCurrentJobID(),
       boost::asio::steady_timer(io_service_),
-      RayConfig::instance().max_pending_lease_requests_per_scheduling_category());
+      RayConfig::instance().max_pending_lease_requests_per_scheduling_category(),
+      RayConfig::instance().max_tasks_in_flight_per_worker(),
+      lease_request_rate_limiter_,
+      RayConfig::instance().worker_lease_reuse_across_scheduling_classes(),
+      RayConfig::instance().worker_lease_idle_linger_ms(),
+      reference_counter_.get());
   auto report_locality_data_callback = [this](
                                            const ObjectID &object_id,
                                            const absl::flat_hash_set<NodeID> &locations,
@@ -417,7 +496,8 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
                                             reference_counter_,
                                             std::move(report_locality_data_callback),
                                             core_worker_client_pool_,
-                                            rpc_address_));
+                                            rpc_address_,
+                                            io_service_));
 
   // Unfortunately the raylet client has to be constructed after the receivers.
   if (direct_task_receiver_ != nullptr) {
@@ -472,6 +552,7 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
                          /*pin_object=*/pin_object));
       });
 
+  io_service_.StartLagProbe("core_worker");
   // Start the IO thread after all other members have been initialized, in case
   // the thread calls back into any of our members.
   io_thread_ = std::thread([this]() { RunIOService(); });
@@ -484,6 +565,9 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
   }
   // Used to detect if the object is in the plasma store.
   max_direct_call_object_size_ = RayConfig::instance().max_direct_call_object_size();
+  max_direct_actor_call_return_size_ =
+      std::max(max_direct_call_object_size_,
+               RayConfig::instance().max_direct_actor_call_return_size());
 
   /// If periodic asio stats print is enabled, it will print it.
   const auto event_stats_print_interval_ms =
@@ -497,6 +581,13 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
         event_stats_print_interval_ms);
   }
 
+  if (RayConfig::instance().mutex_contention_tracing()) {
+    periodical_runner_.RunFnPeriodically(
+        [] { MutexContentionTracker::Instance().RecordMetrics(); },
+        RayConfig::instance().metrics_report_interval_ms(),
+        "CoreWorker.RecordMutexContention");
+  }
+
   // Set event context for current core worker thread.
   RayEventContext::Instance().SetEventContext(
       ray::rpc::Event_SourceType::Event_SourceType_CORE_WORKER,
@@ -515,13 +606,11 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
           // will eventually be stored for the objects (either an
           // UnreconstructableError or a value reconstructed from lineage).
           memory_store_->Delete(lost_objects);
-          for (const auto &object_id : lost_objects) {
-            // NOTE(swang): There is a race condition where this can return false if
-            // the reference went out of scope since the call to the ref counter to get
-            // the lost objects. It's okay to not mark the object as failed or recover
-            // the object since there are no reference holders.
-            RAY_UNUSED(object_recovery_manager_->RecoverObject(object_id));
-          }
+          // NOTE(swang): There is a race condition where this can return objects if
+          // their reference went out of scope since the call to the ref counter to get
+          // the lost objects. It's okay to not mark the objects as failed or recover
+          // them since there are no reference holders.
+          RAY_UNUSED(object_recovery_manager_->RecoverObjects(lost_objects));
         }
       },
       100);
@@ -898,6 +987,14 @@ Status CoreWorker::Put(const RayObject &object,
 Status CoreWorker::PutInLocalPlasmaStore(const RayObject &object,
                                          const ObjectID &object_id,
                                          bool pin_object) {
+  RAY_RETURN_NOT_OK(CreateInLocalPlasmaStore(object, object_id, pin_object));
+  RAY_CHECK(memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+  return Status::OK();
+}
+
+Status CoreWorker::CreateInLocalPlasmaStore(const RayObject &object,
+                                            const ObjectID &object_id,
+                                            bool pin_object) {
   bool object_exists;
   RAY_RETURN_NOT_OK(plasma_store_provider_->Put(
       object, object_id, /* owner_address = */ rpc_address_, &object_exists));
@@ -920,7 +1017,6 @@ Status CoreWorker::PutInLocalPlasmaStore(const RayObject &object,
       RAY_RETURN_NOT_OK(plasma_store_provider_->Release(object_id));
     }
   }
-  RAY_CHECK(memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
   return Status::OK();
 }
 
@@ -1269,6 +1365,106 @@ Status CoreWorker::Wait(const std::vector<ObjectID> &ids,
   return Status::OK();
 }
 
+Status CoreWorker::CreateWaitSet(const std::vector<ObjectID> &object_ids,
+                                 int64_t *wait_set_id) {
+  if (absl::flat_hash_set<ObjectID>(object_ids.begin(), object_ids.end()).size() !=
+      object_ids.size()) {
+    return Status::Invalid("Duplicate object IDs not supported in wait.");
+  }
+  auto wait_set = ObjectWaitSet::Create(*memory_store_, object_ids);
+  absl::MutexLock lock(&wait_sets_mutex_);
+  *wait_set_id = next_wait_set_id_++;
+  wait_sets_.emplace(*wait_set_id, std::move(wait_set));
+  return Status::OK();
+}
+
+Status CoreWorker::PollWaitSet(int64_t wait_set_id,
+                               int num_objects,
+                               int64_t timeout_ms,
+                               bool fetch_local,
+                               std::vector<ObjectID> *ready) {
+  if (num_objects <= 0) {
+    return Status::Invalid("Number of objects to wait for must be positive.");
+  }
+  std::shared_ptr<ObjectWaitSet> wait_set;
+  {
+    absl::MutexLock lock(&wait_sets_mutex_);
+    auto it = wait_sets_.find(wait_set_id);
+    if (it == wait_sets_.end()) {
+      return Status::Invalid("The wait set doesn't exist.");
+    }
+    wait_set = it->second;
+  }
+  const size_t num_required =
+      std::min(static_cast<size_t>(num_objects), wait_set->NumRemaining());
+
+  // Wait in shorter slices, like the memory store does, so that signals are checked
+  // between them.
+  const int64_t start_time = current_time_ms();
+  int64_t remaining_ms = timeout_ms;
+  while (true) {
+    const int64_t slice_ms = RayConfig::instance().get_timeout_milliseconds();
+    if (wait_set->WaitAvailable(num_required,
+                                remaining_ms < 0 ? slice_ms
+                                                 : std::min(remaining_ms, slice_ms))) {
+      break;
+    }
+    if (options_.check_signals) {
+      RAY_RETURN_NOT_OK(options_.check_signals());
+    }
+    if (timeout_ms >= 0) {
+      remaining_ms = timeout_ms - (current_time_ms() - start_time);
+      if (remaining_ms <= 0) {
+        break;
+      }
+    }
+  }
+  if (timeout_ms >= 0) {
+    remaining_ms = std::max<int64_t>(0, timeout_ms - (current_time_ms() - start_time));
+  }
+
+  // The objects whose value is in memory are ready. Those in plasma are ready once they
+  // are local, if the caller asked for it.
+  auto available = wait_set->TakeAvailable();
+  absl::flat_hash_set<ObjectID> ready_ids;
+  absl::flat_hash_set<ObjectID> plasma_object_ids;
+  for (const auto &object : available) {
+    if (ready_ids.size() == num_required) {
+      break;
+    }
+    if (fetch_local && object.second) {
+      plasma_object_ids.insert(object.first);
+    } else {
+      ready_ids.insert(object.first);
+    }
+  }
+  if (ready_ids.size() < num_required && !plasma_object_ids.empty()) {
+    RAY_RETURN_NOT_OK(plasma_store_provider_->Wait(
+        plasma_object_ids,
+        static_cast<int>(
+            std::min(plasma_object_ids.size(), num_required - ready_ids.size())),
+        remaining_ms,
+        worker_context_,
+        &ready_ids));
+  }
+
+  std::vector<ObjectWaitSet::AvailableObject> not_ready;
+  for (const auto &object : available) {
+    if (ready_ids.contains(object.first)) {
+      ready->push_back(object.first);
+    } else {
+      not_ready.push_back(object);
+    }
+  }
+  wait_set->PutBack(not_ready);
+  return Status::OK();
+}
+
+void CoreWorker::DestroyWaitSet(int64_t wait_set_id) {
+  absl::MutexLock lock(&wait_sets_mutex_);
+  wait_sets_.erase(wait_set_id);
+}
+
 Status CoreWorker::Delete(const std::vector<ObjectID> &object_ids, bool local_only) {
   // Release the object from plasma. This does not affect the object's ref
   // count. If this was called from a non-owning worker, then a warning will be
@@ -1451,12 +1647,15 @@ std::unordered_map<std::string, double> AddPlacementGroupConstraint(
   }
   std::unordered_map<std::string, double> new_resources;
   if (placement_group_id != PlacementGroupID::Nil()) {
+    const auto placement_group_id_hex = placement_group_id.Hex();
+    new_resources.reserve(bundle_index >= 0 ? 2 * resources.size() : resources.size());
     for (auto iter = resources.begin(); iter != resources.end(); iter++) {
-      auto new_name = FormatPlacementGroupResource(iter->first, placement_group_id, -1);
+      auto new_name =
+          FormatPlacementGroupResource(iter->first, placement_group_id_hex, -1);
       new_resources[new_name] = iter->second;
       if (bundle_index >= 0) {
-        auto index_name =
-            FormatPlacementGroupResource(iter->first, placement_group_id, bundle_index);
+        auto index_name = FormatPlacementGroupResource(
+            iter->first, placement_group_id_hex, bundle_index);
         new_resources[index_name] = iter->second;
       }
     }
@@ -1537,6 +1736,34 @@ static std::vector<std::string> GetUrisFromRuntimeEnv(
 
 std::shared_ptr<rpc::RuntimeEnvInfo> CoreWorker::OverrideTaskOrActorRuntimeEnvInfo(
     const std::string &serialized_runtime_env_info) {
+  std::string parent_serialized_runtime_env;
+  std::shared_ptr<rpc::RuntimeEnv> parent_runtime_env;
+  if (options_.worker_type == WorkerType::DRIVER) {
+    parent_serialized_runtime_env =
+        job_config_->runtime_env_info().serialized_runtime_env();
+    parent_runtime_env = job_runtime_env_;
+  } else {
+    parent_serialized_runtime_env = worker_context_.GetCurrentSerializedRuntimeEnv();
+    parent_runtime_env = worker_context_.GetCurrentRuntimeEnv();
+  }
+
+  absl::MutexLock lock(&last_overridden_runtime_env_info_mutex_);
+  auto &last = last_overridden_runtime_env_info_;
+  if (!last.has_value() ||
+      last->serialized_runtime_env_info != serialized_runtime_env_info ||
+      last->parent_serialized_runtime_env != parent_serialized_runtime_env ||
+      last->parent_runtime_env != parent_runtime_env) {
+    last = OverriddenRuntimeEnvInfo{
+        serialized_runtime_env_info,
+        std::move(parent_serialized_runtime_env),
+        std::move(parent_runtime_env),
+        ComputeOverriddenRuntimeEnvInfo(serialized_runtime_env_info)};
+  }
+  return last->runtime_env_info;
+}
+
+std::shared_ptr<rpc::RuntimeEnvInfo> CoreWorker::ComputeOverriddenRuntimeEnvInfo(
+    const std::string &serialized_runtime_env_info) {
   // TODO(Catch-Bull,SongGuyang): task runtime env not support the field eager_install
   // yet, we will overwrite the filed eager_install when it did.
   std::shared_ptr<rpc::RuntimeEnv> parent = nullptr;
@@ -1706,6 +1933,82 @@ std::vector<rpc::ObjectReference> CoreWorker::SubmitTask(
   return returned_refs;
 }
 
+std::vector<std::vector<rpc::ObjectReference>> CoreWorker::SubmitTasks(
+    const RayFunction &function,
+    const std::vector<std::vector<std::unique_ptr<TaskArg>>> &args_list,
+    const TaskOptions &task_options,
+    int max_retries,
+    bool retry_exceptions,
+    const rpc::SchedulingStrategy &scheduling_strategy,
+    const std::string &debugger_breakpoint) {
+  RAY_CHECK(scheduling_strategy.scheduling_strategy_case() !=
+            rpc::SchedulingStrategy::SchedulingStrategyCase::SCHEDULING_STRATEGY_NOT_SET);
+  if (args_list.empty()) {
+    return {};
+  }
+
+  // Everything but the task ID and the arguments is the same for all the tasks.
+  const auto job_id = worker_context_.GetCurrentJobID();
+  const auto current_internal_task_id = worker_context_.GetCurrentInternalTaskId();
+  const auto current_task_id = worker_context_.GetCurrentTaskID();
+  const auto caller_id = GetCallerId();
+  const auto constrained_resources =
+      AddPlacementGroupConstraint(task_options.resources, scheduling_strategy);
+  const std::unordered_map<std::string, double> required_resources;
+  const auto task_name = task_options.name.empty()
+                             ? function.GetFunctionDescriptor()->DefaultTaskName()
+                             : task_options.name;
+  const int64_t depth = worker_context_.GetTaskDepth() + 1;
+
+  std::vector<TaskSpecification> task_specs;
+  task_specs.reserve(args_list.size());
+  for (const auto &args : args_list) {
+    TaskSpecBuilder builder;
+    const auto next_task_index = worker_context_.GetNextTaskIndex();
+    const auto task_id =
+        TaskID::ForNormalTask(job_id, current_internal_task_id, next_task_index);
+    BuildCommonTaskSpec(builder,
+                        job_id,
+                        task_id,
+                        task_name,
+                        current_task_id,
+                        next_task_index,
+                        caller_id,
+                        rpc_address_,
+                        function,
+                        args,
+                        task_options.num_returns,
+                        constrained_resources,
+                        required_resources,
+                        debugger_breakpoint,
+                        depth,
+                        task_options.serialized_runtime_env_info);
+    builder.SetNormalTaskSpec(max_retries, retry_exceptions, scheduling_strategy);
+    task_specs.push_back(builder.Build());
+  }
+  RAY_LOG(DEBUG) << "Submitting " << task_specs.size() << " normal tasks, the first one "
+                 << task_specs.front().DebugString();
+
+  std::vector<std::vector<rpc::ObjectReference>> returned_refs;
+  if (options_.is_local_mode) {
+    returned_refs.reserve(task_specs.size());
+    for (const auto &task_spec : task_specs) {
+      returned_refs.push_back(ExecuteTaskLocalMode(task_spec));
+    }
+  } else {
+    returned_refs = task_manager_->AddPendingTasks(
+        rpc_address_, task_specs, CurrentCallSite(), max_retries);
+    io_service_.post(
+        [this, task_specs = std::move(task_specs)]() {
+          for (const auto &task_spec : task_specs) {
+            RAY_UNUSED(direct_task_submitter_->SubmitTask(task_spec));
+          }
+        },
+        "CoreWorker.SubmitTasks");
+  }
+  return returned_refs;
+}
+
 Status CoreWorker::CreateActor(const RayFunction &function,
                                const std::vector<std::unique_ptr<TaskArg>> &args,
                                const ActorCreationOptions &actor_creation_options,
@@ -1802,6 +2105,16 @@ Status CoreWorker::CreateActor(const RayFunction &function,
                                    actor_creation_options.concurrency_groups,
                                    extension_data,
                                    actor_creation_options.execute_out_of_order);
+  if (RayConfig::instance().actor_locality_aware_scheduling() &&
+      actor_creation_options.scheduling_strategy.scheduling_strategy_case() ==
+          rpc::SchedulingStrategy::SchedulingStrategyCase::kDefaultSchedulingStrategy) {
+    // Let the GCS place the actor where most of its arguments already are, so that
+    // it doesn't pull them from other nodes when it starts.
+    if (auto node_id = GetNodeWithMostLocalBytes(builder.Build().GetDependencyIds(),
+                                                 *reference_counter_)) {
+      builder.SetActorCreationLocalityNodeId(*node_id);
+    }
+  }
   // Add the actor handle before we submit the actor creation task, since the
   // actor handle must be in scope by the time the GCS sends the
   // WaitForActorOutOfScopeRequest.
@@ -1951,6 +2264,7 @@ std::optional<std::vector<rpc::ObjectReference>> CoreWorker::SubmitActorTask(
   }
 
   auto actor_handle = actor_manager_->GetActorHandle(actor_id);
+  actor_manager_->SubscribeActorStateIfNeeded(actor_id);
 
   // Add one for actor cursor object id for tasks.
   const int num_returns = task_options.num_returns + 1;
@@ -1994,6 +2308,7 @@ std::optional<std::vector<rpc::ObjectReference>> CoreWorker::SubmitActorTask(
   // TODO(swang): Do we actually need to set this ObjectID?
   const ObjectID new_cursor = ObjectID::FromIndex(actor_task_id, num_returns);
   actor_handle->SetActorTaskSpec(builder, new_cursor);
+  builder.SetStreamingReturns(task_options.streaming_returns);
 
   // Submit task.
   TaskSpecification task_spec = builder.Build();
@@ -2224,9 +2539,14 @@ Status CoreWorker::AllocateReturnObject(const ObjectID &object_id,
           object_id, contained_object_ids, owner_address);
     }
 
-    // Allocate a buffer for the return object.
+    // Allocate a buffer for the return object. Actor tasks may inline larger returns,
+    // since their callers usually consume the results themselves.
+    int64_t max_inlined_size = max_direct_call_object_size_;
+    if (!options_.is_local_mode && worker_context_.GetCurrentTask()->IsActorTask()) {
+      max_inlined_size = max_direct_actor_call_return_size_;
+    }
     if (options_.is_local_mode ||
-        (static_cast<int64_t>(data_size) < max_direct_call_object_size_ &&
+        (static_cast<int64_t>(data_size) < max_inlined_size &&
          // ensure we don't exceed the limit if we allocate this object inline.
          (*task_output_inlined_bytes + static_cast<int64_t>(data_size) <=
           RayConfig::instance().task_rpc_inlined_bytes_limit()))) {
@@ -2424,6 +2744,99 @@ Status CoreWorker::SealReturnObject(const ObjectID &return_id,
   return status;
 }
 
+Status CoreWorker::SealReturnObjects(
+    const std::vector<ObjectID> &return_ids,
+    const std::vector<std::shared_ptr<RayObject>> &return_objects) {
+  RAY_CHECK(return_ids.size() == return_objects.size());
+  RAY_CHECK(!options_.is_local_mode);
+  std::vector<ObjectID> plasma_ids;
+  for (size_t i = 0; i < return_ids.size(); i++) {
+    RAY_CHECK(return_objects[i]);
+    if (return_objects[i]->GetData() != nullptr &&
+        return_objects[i]->GetData()->IsPlasmaBuffer()) {
+      plasma_ids.push_back(return_ids[i]);
+    }
+  }
+  if (plasma_ids.empty()) {
+    return Status::OK();
+  }
+  RAY_LOG(DEBUG) << "Sealing " << plasma_ids.size() << " return objects";
+  Status status = plasma_store_provider_->Seal(plasma_ids);
+  if (!status.ok()) {
+    RAY_LOG(FATAL) << "Failed to seal " << plasma_ids.size()
+                   << " return objects in store: " << status.message();
+  }
+  // Tell the raylet to pin the objects **after** they are created, and release them
+  // once the raylet has responded, like SealExisting does.
+  local_raylet_client_->PinObjectIDs(
+      worker_context_.GetCurrentTask()->CallerAddress(),
+      plasma_ids,
+      [this, plasma_ids](const Status &status, const rpc::PinObjectIDsReply &reply) {
+        if (!plasma_store_provider_->Release(plasma_ids).ok()) {
+          RAY_LOG(ERROR) << "Failed to release " << plasma_ids.size()
+                         << " return objects, might cause a leak in plasma.";
+        }
+      });
+  for (const auto &object_id : plasma_ids) {
+    RAY_CHECK(
+        memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+  }
+  return Status::OK();
+}
+
+Status CoreWorker::ReportStreamingReturn(int64_t index,
+                                         const std::shared_ptr<RayObject> &result) {
+  if (options_.is_local_mode) {
+    return Status::NotImplemented("Streaming returns aren't supported in local mode.");
+  }
+  RAY_CHECK(result);
+  const auto task_spec = worker_context_.GetCurrentTask();
+  if (!task_spec->StreamingReturns()) {
+    return Status::Invalid("The executing task doesn't stream its results.");
+  }
+  const auto object_id = task_spec->StreamingReturnId(index);
+
+  rpc::ReportStreamingReturnRequest request;
+  request.set_task_id(task_spec->TaskId().Binary());
+  request.set_index(index);
+  request.mutable_worker_addr()->CopyFrom(rpc_address_);
+  auto return_object = request.mutable_return_object();
+  return_object->set_object_id(object_id.Binary());
+  return_object->set_size(result->GetSize());
+  if (result->GetData() != nullptr && result->GetData()->IsPlasmaBuffer()) {
+    return_object->set_in_plasma(true);
+  } else {
+    if (result->GetData() != nullptr) {
+      return_object->set_data(result->GetData()->Data(), result->GetData()->Size());
+    }
+    if (result->GetMetadata() != nullptr) {
+      return_object->set_metadata(result->GetMetadata()->Data(),
+                                  result->GetMetadata()->Size());
+    }
+  }
+  for (const auto &nested_ref : result->GetNestedRefs()) {
+    return_object->add_nested_inlined_refs()->CopyFrom(nested_ref);
+  }
+
+  auto conn = core_worker_client_pool_->GetOrConnect(task_spec->CallerAddress());
+  std::promise<Status> status_promise;
+  conn->ReportStreamingReturn(
+      request,
+      [&status_promise](const Status &returned_status,
+                        const rpc::ReportStreamingReturnReply &reply) {
+        status_promise.set_value(returned_status);
+      });
+  // Block until the caller stored the result, so that all of the results are
+  // stored before the reply of the task.
+  return status_promise.get_future().get();
+}
+
+bool CoreWorker::TryReadStreamingReturn(const TaskID &task_id,
+                                        rpc::ObjectReference *object_ref,
+                                        bool *finished) {
+  return task_manager_->TryReadStreamingReturn(task_id, object_ref, finished);
+}
+
 bool CoreWorker::PinExistingReturnObject(const ObjectID &return_id,
                                          std::shared_ptr<RayObject> *return_object) {
   // TODO(swang): If there is already an existing copy of this object, then it
@@ -2650,6 +3063,36 @@ void CoreWorker::HandlePushTask(const rpc::PushTaskRequest &request,
   }
 }
 
+void CoreWorker::HandlePushTaskBatch(const rpc::PushTaskBatchRequest &request,
+                                     rpc::PushTaskBatchReply *reply,
+                                     rpc::SendReplyCallback send_reply_callback) {
+  const int num_tasks = request.requests_size();
+  if (num_tasks == 0) {
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+    return;
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    reply->add_replies();
+    reply->add_status_codes(static_cast<int32_t>(StatusCode::OK));
+    reply->add_status_messages();
+  }
+  // The tasks may be replied to from different threads.
+  auto num_pending_tasks = std::make_shared<std::atomic<int>>(num_tasks);
+  for (int i = 0; i < num_tasks; i++) {
+    HandlePushTask(
+        request.requests(i),
+        reply->mutable_replies(i),
+        [reply, i, num_pending_tasks, send_reply_callback](
+            Status status, std::function<void()> success, std::function<void()> failure) {
+          reply->set_status_codes(i, static_cast<int32_t>(status.code()));
+          reply->set_status_messages(i, status.message());
+          if (num_pending_tasks->fetch_sub(1) == 1) {
+            send_reply_callback(Status::OK(), nullptr, nullptr);
+          }
+        });
+  }
+}
+
 void CoreWorker::HandleDirectActorCallArgWaitComplete(
     const rpc::DirectActorCallArgWaitCompleteRequest &request,
     rpc::DirectActorCallArgWaitCompleteReply *reply,
@@ -2683,6 +3126,51 @@ void CoreWorker::HandleGetObjectStatus(const rpc::GetObjectStatusRequest &reques
 
   ObjectID object_id = ObjectID::FromBinary(request.object_id());
   RAY_LOG(DEBUG) << "Received GetObjectStatus " << object_id;
+  PopulateObjectStatusAsync(
+      object_id, request.owner_worker_id(), reply, [send_reply_callback]() {
+        send_reply_callback(Status::OK(), nullptr, nullptr);
+      });
+}
+
+void CoreWorker::HandleGetObjectStatusBatch(
+    const rpc::GetObjectStatusBatchRequest &request,
+    rpc::GetObjectStatusBatchReply *reply,
+    rpc::SendReplyCallback send_reply_callback) {
+  if (HandleWrongRecipient(WorkerID::FromBinary(request.owner_worker_id()),
+                           send_reply_callback)) {
+    RAY_LOG(INFO) << "Handling GetObjectStatusBatch for objects produced by a previous "
+                     "worker with the same address";
+    return;
+  }
+
+  const int num_objects = request.object_ids_size();
+  RAY_LOG(DEBUG) << "Received GetObjectStatusBatch for " << num_objects << " objects";
+  if (num_objects == 0) {
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+    return;
+  }
+  // Add all the statuses first, so that the reply isn't modified while they are
+  // filled in, possibly from other threads.
+  for (int i = 0; i < num_objects; i++) {
+    reply->add_statuses();
+  }
+  auto num_pending = std::make_shared<std::atomic<int>>(num_objects);
+  for (int i = 0; i < num_objects; i++) {
+    PopulateObjectStatusAsync(ObjectID::FromBinary(request.object_ids(i)),
+                              request.owner_worker_id(),
+                              reply->mutable_statuses(i),
+                              [num_pending, send_reply_callback]() {
+                                if (--*num_pending == 0) {
+                                  send_reply_callback(Status::OK(), nullptr, nullptr);
+                                }
+                              });
+  }
+}
+
+void CoreWorker::PopulateObjectStatusAsync(const ObjectID &object_id,
+                                           const std::string &owner_worker_id,
+                                           rpc::GetObjectStatusReply *reply,
+                                           std::function<void()> on_done) {
   // Acquire a reference to the object. This prevents the object from being
   // evicted out from under us while we check the object status and start the
   // Get.
@@ -2693,24 +3181,25 @@ void CoreWorker::HandleGetObjectStatus(const rpc::GetObjectStatusRequest &reques
   if (!has_owner) {
     // We owned this object, but the object has gone out of scope.
     reply->set_status(rpc::GetObjectStatusReply::OUT_OF_SCOPE);
-    send_reply_callback(Status::OK(), nullptr, nullptr);
+    on_done();
   } else {
-    RAY_CHECK(owner_address.worker_id() == request.owner_worker_id());
+    RAY_CHECK(owner_address.worker_id() == owner_worker_id);
     bool is_freed = reference_counter_->IsPlasmaObjectFreed(object_id);
 
-    // Send the reply once the value has become available. The value is
+    // Fill in the status once the value has become available. The value is
     // guaranteed to become available eventually because we own the object and
     // its ref count is > 0.
-    memory_store_->GetAsync(object_id,
-                            [this, object_id, reply, send_reply_callback, is_freed](
-                                std::shared_ptr<RayObject> obj) {
-                              if (is_freed) {
-                                reply->set_status(rpc::GetObjectStatusReply::FREED);
-                              } else {
-                                PopulateObjectStatus(object_id, obj, reply);
-                              }
-                              send_reply_callback(Status::OK(), nullptr, nullptr);
-                            });
+    memory_store_->GetAsync(
+        object_id,
+        [this, object_id, reply, on_done = std::move(on_done), is_freed](
+            std::shared_ptr<RayObject> obj) {
+          if (is_freed) {
+            reply->set_status(rpc::GetObjectStatusReply::FREED);
+          } else {
+            PopulateObjectStatus(object_id, obj, reply);
+          }
+          on_done();
+        });
   }
 
   RemoveLocalReference(object_id);
@@ -3286,6 +3775,17 @@ void CoreWorker::HandleAssignObjectOwner(const rpc::AssignObjectOwnerRequest &re
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
 
+void CoreWorker::HandleReportStreamingReturn(
+    const rpc::ReportStreamingReturnRequest &request,
+    rpc::ReportStreamingReturnReply *reply,
+    rpc::SendReplyCallback send_reply_callback) {
+  task_manager_->HandleStreamingReturn(TaskID::FromBinary(request.task_id()),
+                                       request.index(),
+                                       request.return_object(),
+                                       request.worker_addr());
+  send_reply_callback(Status::OK(), nullptr, nullptr);
+}
+
 void CoreWorker::YieldCurrentFiber(FiberEvent &event) {
   RAY_CHECK(worker_context_.CurrentActorIsAsync());
   boost::this_fiber::yield();
@@ -29,6 +29,7 @@
 #include "ray/core_worker/gcs_server_address_updater.h"
 #include "ray/core_worker/lease_policy.h"
 #include "ray/core_worker/object_recovery_manager.h"
+#include "ray/core_worker/object_wait_set.h"
 #include "ray/core_worker/profiling.h"
 #include "ray/core_worker/reference_count.h"
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
@@ -393,6 +394,39 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
               std::vector<bool> *results,
               bool fetch_local);
 
+  /// Create a set of objects to wait on incrementally, e.g. to process the results of
+  /// many tasks as they complete. Unlike `Wait`, polling the set only costs as much as
+  /// the objects it returns, instead of all the objects still waited on.
+  ///
+  /// \param[in] object_ids IDs of the objects to wait for. They must be distinct.
+  /// \param[out] wait_set_id The ID of the set, to poll and destroy it.
+  /// 
+eturn Status.
+  Status CreateWaitSet(const std::vector<ObjectID> &object_ids, int64_t *wait_set_id);
+
+  /// Wait for objects of a wait set to appear in the object store, and remove them
+  /// from the set.
+  ///
+  /// \param[in] wait_set_id The ID of the set.
+  /// \param[in] num_objects Number of objects that should appear. Fewer are waited on
+  /// if the set has fewer objects left.
+  /// \param[in] timeout_ms Timeout in milliseconds, wait infinitely if it's negative.
+  /// \param[in] fetch_local Whether to wait for the objects to be local.
+  /// \param[out] ready At most `num_objects` objects that appeared, in the order they
+  /// appeared.
+  /// 
+eturn Status.
+  Status PollWaitSet(int64_t wait_set_id,
+                     int num_objects,
+                     int64_t timeout_ms,
+                     bool fetch_local,
+                     std::vector<ObjectID> *ready);
+
+  /// Destroy a wait set.
+  ///
+  /// \param[in] wait_set_id The ID of the set.
+  void DestroyWaitSet(int64_t wait_set_id);
+
   /// Delete a list of objects from the plasma object store.
   ///
   /// \param[in] object_ids IDs of the objects to delete.
@@ -464,6 +498,23 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
       const rpc::SchedulingStrategy &scheduling_strategy,
       const std::string &debugger_breakpoint);
 
+  /// Submit a batch of normal tasks of the same function and options, that only
+  /// differ by their arguments. This is the same as calling `SubmitTask` for each of
+  /// them, except that what the tasks share is computed once, the tasks are added to
+  /// the task manager under one lock, and they are handed to the submitter in one
+  /// event.
+  ///
+  /// \param[in] args_list Arguments of each task.
+  /// \return ObjectRefs returned by each task, in order.
+  std::vector<std::vector<rpc::ObjectReference>> SubmitTasks(
+      const RayFunction &function,
+      const std::vector<std::vector<std::unique_ptr<TaskArg>>> &args_list,
+      const TaskOptions &task_options,
+      int max_retries,
+      bool retry_exceptions,
+      const rpc::SchedulingStrategy &scheduling_strategy,
+      const std::string &debugger_breakpoint);
+
   /// Create an actor.
   ///
   /// \param[in] caller_id ID of the task submitter.
@@ -599,7 +650,8 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
  public:
   /// Allocate the return object for an executing task. The caller should write into the
   /// data buffer of the allocated buffer, then call SealReturnObject() to seal it.
-  /// To avoid deadlock, the caller should allocate and seal a single object at a time.
+  /// To avoid deadlock, the caller should allocate and seal a single object at a time,
+  /// or a batch of at most `task_return_seal_batch_bytes` with SealReturnObjects().
   ///
   /// \param[in] object_id Object ID of the return value.
   /// \param[in] data_size Size of the return value.
@@ -626,6 +678,40 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
   Status SealReturnObject(const ObjectID &return_id,
                           std::shared_ptr<RayObject> return_object);
 
+  /// Seal several return objects for an executing task. The objects in plasma are
+  /// sealed with a single request to the store and pinned with a single request to
+  /// the raylet. Since unsealed objects can't be spilled, the caller should only
+  /// allocate up to `task_return_seal_batch_bytes` of returns before sealing them.
+  ///
+  /// \param[in] return_ids Object IDs of the return values.
+  /// \param[in] return_objects RayObjects containing the buffers written into, in the
+  /// same order as `return_ids`.
+  /// \return Status.
+  Status SealReturnObjects(const std::vector<ObjectID> &return_ids,
+                           const std::vector<std::shared_ptr<RayObject>> &return_objects);
+
+  /// Report a result of the executing streaming task to its caller, so that the
+  /// caller can read it before the task finishes. The result should be allocated and
+  /// sealed like a return object, with the ID
+  /// TaskSpecification::StreamingReturnId(index). This blocks until the caller has
+  /// stored the result.
+  ///
+  /// \param[in] index The index of the result among the results of the task.
+  /// \param[in] result The result.
+  /// \return Status.
+  Status ReportStreamingReturn(int64_t index, const std::shared_ptr<RayObject> &result);
+
+  /// Read the next result that a streaming task submitted by this worker reported.
+  ///
+  /// \param[in] task_id The ID of the streaming task.
+  /// \param[out] object_ref The result, if there was one. The caller takes over the
+  /// local reference to it, like for the refs returned by SubmitActorTask.
+  /// \param[out] finished Set if the task finished and all of its results were read.
+  /// \return Whether there was a result to read.
+  bool TryReadStreamingReturn(const TaskID &task_id,
+                              rpc::ObjectReference *object_ref,
+                              bool *finished);
+
   /// Pin the local copy of the return object, if one exists.
   ///
   /// \param[in] return_id ObjectID of the return value.
@@ -681,6 +767,11 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
                       rpc::PushTaskReply *reply,
                       rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Implements gRPC server handler.
+  void HandlePushTaskBatch(const rpc::PushTaskBatchRequest &request,
+                           rpc::PushTaskBatchReply *reply,
+                           rpc::SendReplyCallback send_reply_callback) override;
+
   /// Implements gRPC server handler.
   void HandleDirectActorCallArgWaitComplete(
       const rpc::DirectActorCallArgWaitCompleteRequest &request,
@@ -692,6 +783,11 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
                              rpc::GetObjectStatusReply *reply,
                              rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Implements gRPC server handler.
+  void HandleGetObjectStatusBatch(const rpc::GetObjectStatusBatchRequest &request,
+                                  rpc::GetObjectStatusBatchReply *reply,
+                                  rpc::SendReplyCallback send_reply_callback) override;
+
   /// Implements gRPC server handler.
   void HandleWaitForActorOutOfScope(const rpc::WaitForActorOutOfScopeRequest &request,
                                     rpc::WaitForActorOutOfScopeReply *reply,
@@ -775,6 +871,11 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
                                rpc::AssignObjectOwnerReply *reply,
                                rpc::SendReplyCallback send_reply_callback) override;
 
+  // Store a result that a streaming task submitted by this worker reported.
+  void HandleReportStreamingReturn(const rpc::ReportStreamingReturnRequest &request,
+                                   rpc::ReportStreamingReturnReply *reply,
+                                   rpc::SendReplyCallback send_reply_callback) override;
+
   ///
   /// Public methods related to async actor call. This should only be used when
   /// the actor is (1) direct actor and (2) using asyncio mode.
@@ -822,9 +923,20 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
   FRIEND_TEST(TestOverrideRuntimeEnv, TestCondaInherit);
   FRIEND_TEST(TestOverrideRuntimeEnv, TestCondaOverride);
 
+  /// Override the runtime env of the parent (the job's on a driver, the current task's
+  /// on a worker) with the given one. The result of the last call is cached, so that
+  /// submitting many tasks with the same runtime env doesn't parse and merge it again
+  /// for each of them.
+  ///
+  /// \return The overridden runtime env. It may be shared with other callers, so it
+  /// must not be modified.
   std::shared_ptr<rpc::RuntimeEnvInfo> OverrideTaskOrActorRuntimeEnvInfo(
       const std::string &serialized_runtime_env_info);
 
+  /// The uncached implementation of `OverrideTaskOrActorRuntimeEnvInfo`.
+  std::shared_ptr<rpc::RuntimeEnvInfo> ComputeOverriddenRuntimeEnvInfo(
+      const std::string &serialized_runtime_env_info);
+
   void BuildCommonTaskSpec(
       TaskSpecBuilder &builder,
       const JobID &job_id,
@@ -865,6 +977,17 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
   /// Heartbeat for internal bookkeeping.
   void InternalHeartbeat();
 
+  /// Fill in the status of an object that we own, once it's known.
+  ///
+  /// \param[in] object_id The object.
+  /// \param[in] owner_worker_id The owner that the request was sent to.
+  /// \param[out] reply The status to fill in.
+  /// \param[in] on_done Called once the status is filled in.
+  void PopulateObjectStatusAsync(const ObjectID &object_id,
+                                 const std::string &owner_worker_id,
+                                 rpc::GetObjectStatusReply *reply,
+                                 std::function<void()> on_done);
+
   /// Helper method to fill in object status reply given an object.
   void PopulateObjectStatus(const ObjectID &object_id,
                             std::shared_ptr<RayObject> obj,
@@ -918,6 +1041,12 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
                                const ObjectID &object_id,
                                bool pin_object);
 
+  /// Create an object in the local plasma store, without marking it as in plasma in
+  /// the memory store.
+  Status CreateInLocalPlasmaStore(const RayObject &object,
+                                  const ObjectID &object_id,
+                                  bool pin_object);
+
   /// Execute a local mode task (runs normal ExecuteTask)
   ///
   /// \param spec[in] task_spec Task specification.
@@ -1078,6 +1207,10 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
   /// RPC server used to receive tasks to execute.
   std::unique_ptr<rpc::GrpcServer> core_worker_server_;
 
+  /// The directory that the workers on this node put their unix domain sockets in, or
+  /// empty if workers on this node are connected to through their ports.
+  std::string worker_socket_dir_;
+
   /// Address of our RPC server.
   rpc::Address rpc_address_;
 
@@ -1139,6 +1272,10 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
   // Interface to submit non-actor tasks directly to leased workers.
   std::unique_ptr<CoreWorkerDirectTaskSubmitter> direct_task_submitter_;
 
+  // Limits the lease requests of the direct task submitter by the number of alive
+  // nodes. Only set if scale_pending_lease_requests_with_cluster_size is enabled.
+  std::shared_ptr<ClusterSizeBasedLeaseRequestRateLimiter> lease_request_rate_limiter_;
+
   /// Manages recovery of objects stored in remote plasma nodes.
   std::unique_ptr<ObjectRecoveryManager> object_recovery_manager_;
 
@@ -1230,12 +1367,33 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
 
   int64_t max_direct_call_object_size_;
 
+  /// The max size of a return object of an actor task that is inlined in the reply.
+  int64_t max_direct_actor_call_return_size_;
+
   friend class CoreWorkerTest;
 
   std::unique_ptr<rpc::JobConfig> job_config_;
 
   std::shared_ptr<rpc::RuntimeEnv> job_runtime_env_;
 
+  /// The inputs and the result of the last call to `OverrideTaskOrActorRuntimeEnvInfo`.
+  struct OverriddenRuntimeEnvInfo {
+    std::string serialized_runtime_env_info;
+    /// The parent runtime env, in both forms, since the result depends on both.
+    std::string parent_serialized_runtime_env;
+    std::shared_ptr<rpc::RuntimeEnv> parent_runtime_env;
+    std::shared_ptr<rpc::RuntimeEnvInfo> runtime_env_info;
+  };
+  absl::Mutex last_overridden_runtime_env_info_mutex_;
+  absl::optional<OverriddenRuntimeEnvInfo> last_overridden_runtime_env_info_
+      GUARDED_BY(last_overridden_runtime_env_info_mutex_);
+
+  /// The wait sets created by `CreateWaitSet`, by ID.
+  absl::Mutex wait_sets_mutex_;
+  absl::flat_hash_map<int64_t, std::shared_ptr<ObjectWaitSet>> wait_sets_
+      GUARDED_BY(wait_sets_mutex_);
+  int64_t next_wait_set_id_ GUARDED_BY(wait_sets_mutex_) = 0;
+
   /// Simple container for per function task counters. The counters will be
   /// keyed by the function name in task spec.
   struct TaskCounter {
@@ -146,7 +146,8 @@ CoreWorkerProcessImpl::CoreWorkerProcessImpl(const CoreWorkerOptions &options)
     RayEventInit(ray::rpc::Event_SourceType::Event_SourceType_CORE_WORKER,
                  absl::flat_hash_map<std::string, std::string>(),
                  options_.log_dir,
-                 RayConfig::instance().event_level());
+                 RayConfig::instance().event_level(),
+                 RayConfig::instance().event_log_reporter_async());
   }
 }
 
@@ -16,6 +16,7 @@
 
 #include <boost/fiber/all.hpp>
 #include <chrono>
+#include <deque>
 
 #include "ray/util/logging.h"
 namespace ray {
@@ -69,8 +70,8 @@ class FiberRateLimiter {
       num_ += 1;
     }
     // NOTE(simon): This not does guarantee to wake up the first queued fiber.
-    // This could be a problem for certain workloads because there is no guarantee
-    // on task ordering.
+    // FiberState only has one fiber waiting here at a time, so its callbacks still
+    // start in order.
     cond_.notify_one();
   }
 
@@ -94,11 +95,39 @@ class FiberState {
     fiber_runner_thread_ =
         std::thread(
             [&]() {
+              // A fiber is only created once it can run, so that the callbacks that
+              // wait for the rate limiter don't each hold a fiber stack. Only fibers
+              // of this thread access the pending callbacks, so they need no lock.
+              std::deque<std::function<void()>> pending;
+              boost::fibers::mutex pending_mutex;
+              boost::fibers::condition_variable pending_cond;
+              boost::fibers::fiber(boost::fibers::launch::post, [&]() {
+                while (true) {
+                  {
+                    std::unique_lock<boost::fibers::mutex> lock(pending_mutex);
+                    pending_cond.wait(lock, [&]() { return !pending.empty(); });
+                  }
+                  rate_limiter_.Acquire();
+                  auto func = std::move(pending.front());
+                  pending.pop_front();
+                  boost::fibers::fiber(boost::fibers::launch::dispatch,
+                                       [this, func = std::move(func)]() {
+                                         func();
+                                         rate_limiter_.Release();
+                                       })
+                      .detach();
+                }
+              }).detach();
+
               while (!channel_.is_closed()) {
                 std::function<void()> func;
                 auto op_status = channel_.pop(func);
                 if (op_status == boost::fibers::channel_op_status::success) {
-                  boost::fibers::fiber(boost::fibers::launch::dispatch, func).detach();
+                  {
+                    std::unique_lock<boost::fibers::mutex> lock(pending_mutex);
+                    pending.push_back(std::move(func));
+                  }
+                  pending_cond.notify_one();
                 } else if (op_status == boost::fibers::channel_op_status::closed) {
                   // The channel was closed. We will just exit the loop and finish
                   // cleanup.
@@ -132,11 +161,7 @@ class FiberState {
   }
 
   void EnqueueFiber(std::function<void()> &&callback) {
-    auto op_status = channel_.push([this, callback]() {
-      rate_limiter_.Acquire();
-      callback();
-      rate_limiter_.Release();
-    });
+    auto op_status = channel_.push(std::move(callback));
     RAY_CHECK(op_status == boost::fibers::channel_op_status::success);
   }
 
@@ -152,7 +177,7 @@ class FiberState {
   /// (main direct_actor_trasnport thread) and the fiber_runner_thread_ (defined below)
   FiberChannel channel_;
   /// The fiber semaphore used to limit the number of concurrent fibers
-  /// running at once.
+  /// running at once. The callbacks that wait for it are queued without a fiber.
   FiberRateLimiter rate_limiter_;
   /// The fiber event used to notify that all worker fibers are stopped running.
   FiberEvent fiber_stopped_event_;
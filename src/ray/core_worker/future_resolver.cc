@@ -14,6 +14,10 @@
 
 #include "ray/core_worker/future_resolver.h"
 
+#include <algorithm>
+
+#include "ray/common/ray_config.h"
+
 namespace ray {
 namespace core {
 
@@ -24,6 +28,75 @@ void FutureResolver::ResolveFutureAsync(const ObjectID &object_id,
     // with a borrowed reference executes on the object's owning worker.
     return;
   }
+  if (RayConfig::instance().object_status_batch_size() <= 1) {
+    GetObjectStatus(object_id, owner_address);
+    return;
+  }
+
+  bool post_send = false;
+  {
+    absl::MutexLock lock(&mu_);
+    auto &queued = queued_futures_[WorkerID::FromBinary(owner_address.worker_id())];
+    if (queued.object_ids.empty()) {
+      queued.owner_address = owner_address;
+    }
+    queued.object_ids.push_back(object_id);
+    post_send = !send_posted_;
+    send_posted_ = true;
+  }
+  // Futures are usually deserialized many at a time, e.g. the object refs in a list,
+  // so the ones queued until the event loop gets to this are sent together.
+  if (post_send) {
+    io_service_.post([this]() { SendQueuedFutures(); },
+                     "FutureResolver.SendQueuedFutures");
+  }
+}
+
+void FutureResolver::SendQueuedFutures() {
+  absl::flat_hash_map<WorkerID, QueuedFutures> queued_futures;
+  {
+    absl::MutexLock lock(&mu_);
+    queued_futures.swap(queued_futures_);
+    send_posted_ = false;
+  }
+
+  const size_t batch_size = RayConfig::instance().object_status_batch_size();
+  for (const auto &entry : queued_futures) {
+    const auto &owner_address = entry.second.owner_address;
+    const auto &object_ids = entry.second.object_ids;
+    for (size_t start = 0; start < object_ids.size(); start += batch_size) {
+      const size_t end = std::min(start + batch_size, object_ids.size());
+      if (end - start == 1) {
+        GetObjectStatus(object_ids[start], owner_address);
+        continue;
+      }
+      std::vector<ObjectID> batch(object_ids.begin() + start, object_ids.begin() + end);
+      rpc::GetObjectStatusBatchRequest request;
+      request.set_owner_worker_id(owner_address.worker_id());
+      for (const auto &object_id : batch) {
+        request.add_object_ids(object_id.Binary());
+      }
+      owner_clients_->GetOrConnect(owner_address)
+          ->GetObjectStatusBatch(
+              request,
+              [this, batch, owner_address](const Status &status,
+                                           const rpc::GetObjectStatusBatchReply &reply) {
+                RAY_CHECK(!status.ok() ||
+                          reply.statuses_size() == static_cast<int>(batch.size()));
+                for (size_t i = 0; i < batch.size(); i++) {
+                  ProcessResolvedObject(batch[i],
+                                        owner_address,
+                                        status,
+                                        status.ok() ? reply.statuses(i)
+                                                    : rpc::GetObjectStatusReply());
+                }
+              });
+    }
+  }
+}
+
+void FutureResolver::GetObjectStatus(const ObjectID &object_id,
+                                     const rpc::Address &owner_address) {
   auto conn = owner_clients_->GetOrConnect(owner_address);
 
   rpc::GetObjectStatusRequest request;
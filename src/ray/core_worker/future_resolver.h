@@ -15,7 +15,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/grpc_util.h"
 #include "ray/common/id.h"
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
@@ -37,18 +41,23 @@ class FutureResolver {
                  std::shared_ptr<ReferenceCounter> ref_counter,
                  ReportLocalityDataCallback report_locality_data_callback,
                  std::shared_ptr<rpc::CoreWorkerClientPool> core_worker_client_pool,
-                 const rpc::Address &rpc_address)
+                 const rpc::Address &rpc_address,
+                 instrumented_io_context &io_service)
       : in_memory_store_(store),
         reference_counter_(ref_counter),
         report_locality_data_callback_(std::move(report_locality_data_callback)),
         owner_clients_(core_worker_client_pool),
-        rpc_address_(rpc_address) {}
+        rpc_address_(rpc_address),
+        io_service_(io_service) {}
 
   /// Resolve the value for a future. This will periodically contact the given
   /// owner until the owner dies or the owner has finished creating the object.
   /// In either case, this will put an OBJECT_IN_PLASMA error as the future's
   /// value.
   ///
+  /// If `object_status_batch_size` is greater than 1, the owner is asked about the
+  /// futures borrowed from it in batches, which are sent from the event loop.
+  ///
   /// \param[in] object_id The ID of the future to resolve.
   /// \param[in] owner_address The address of the task or actor that owns the
   /// future.
@@ -66,6 +75,18 @@ class FutureResolver {
                              const rpc::GetObjectStatusReply &object_status);
 
  private:
+  /// The futures borrowed from an owner that wait to be sent in a batch.
+  struct QueuedFutures {
+    rpc::Address owner_address;
+    std::vector<ObjectID> object_ids;
+  };
+
+  /// Ask the owner about the status of a single future.
+  void GetObjectStatus(const ObjectID &object_id, const rpc::Address &owner_address);
+
+  /// Ask the owners about the status of the queued futures, in batches.
+  void SendQueuedFutures();
+
   /// Used to store values of resolved futures.
   std::shared_ptr<CoreWorkerMemoryStore> in_memory_store_;
 
@@ -82,6 +103,17 @@ class FutureResolver {
   /// address, so the owner can contact us to ask when our reference to the
   /// object has gone out of scope.
   const rpc::Address rpc_address_;
+
+  /// The event loop that the batches are sent from.
+  instrumented_io_context &io_service_;
+
+  absl::Mutex mu_;
+
+  /// The futures that wait to be sent in a batch, by owner.
+  absl::flat_hash_map<WorkerID, QueuedFutures> queued_futures_ GUARDED_BY(mu_);
+
+  /// Whether sending the queued futures is posted to the event loop.
+  bool send_posted_ GUARDED_BY(mu_) = false;
 };
 
 }  // namespace core
@@ -14,6 +14,8 @@
 
 #include "ray/core_worker/lease_policy.h"
 
+#include <algorithm>
+
 namespace ray {
 namespace core {
 
@@ -36,25 +38,38 @@ std::pair<rpc::Address, bool> LocalityAwareLeasePolicy::GetBestNodeForTask(
   }
 
   // Pick node based on locality.
-  if (auto node_id = GetBestNodeIdForTask(spec)) {
-    if (auto addr = node_addr_factory_(node_id.value())) {
+  if (auto best_node = GetBestNodeIdForTask(spec)) {
+    if (!best_node->second) {
+      return std::make_pair(fallback_rpc_address_, false);
+    }
+    if (auto addr = node_addr_factory_(best_node->first)) {
       return std::make_pair(addr.value(), true);
     }
   }
   return std::make_pair(fallback_rpc_address_, false);
 }
 
-/// Criteria for "best" node: The node with the most object bytes (from object_ids) local.
-absl::optional<NodeID> LocalityAwareLeasePolicy::GetBestNodeIdForTask(
-    const TaskSpecification &spec) {
-  const auto object_ids = spec.GetDependencyIds();
+void LocalityAwareLeasePolicy::OnLeaseGranted(const NodeID &node_id) {
+  num_leases_per_node_[node_id]++;
+}
+
+void LocalityAwareLeasePolicy::OnLeaseReturned(const NodeID &node_id) {
+  auto it = num_leases_per_node_.find(node_id);
+  if (it != num_leases_per_node_.end() && --it->second <= 0) {
+    num_leases_per_node_.erase(it);
+  }
+}
+
+absl::optional<NodeID> GetNodeWithMostLocalBytes(
+    const std::vector<ObjectID> &object_ids,
+    LocalityDataProviderInterface &locality_data_provider) {
   // Number of object bytes (from object_ids) that a given node has local.
   absl::flat_hash_map<NodeID, uint64_t> bytes_local_table;
   uint64_t max_bytes = 0;
   absl::optional<NodeID> max_bytes_node;
   // Finds the node with the maximum number of object bytes local.
   for (const ObjectID &object_id : object_ids) {
-    if (auto locality_data = locality_data_provider_->GetLocalityData(object_id)) {
+    if (auto locality_data = locality_data_provider.GetLocalityData(object_id)) {
       for (const NodeID &node_id : locality_data->nodes_containing_object) {
         auto &bytes = bytes_local_table[node_id];
         bytes += locality_data->object_size;
@@ -72,6 +87,79 @@ absl::optional<NodeID> LocalityAwareLeasePolicy::GetBestNodeIdForTask(
   return max_bytes_node;
 }
 
+absl::optional<std::pair<NodeID, bool>> GetNodeWithLeastExpectedCompletionTime(
+    const std::vector<ObjectID> &object_ids,
+    LocalityDataProviderInterface &locality_data_provider,
+    const NodeID &fallback_node_id,
+    const absl::flat_hash_map<NodeID, int64_t> &num_leases_per_node,
+    const LeaseCostModel &cost_model) {
+  // Number of object bytes (from object_ids) that a given node has local.
+  absl::flat_hash_map<NodeID, uint64_t> bytes_local_table;
+  uint64_t total_bytes = 0;
+  for (const ObjectID &object_id : object_ids) {
+    if (auto locality_data = locality_data_provider.GetLocalityData(object_id)) {
+      total_bytes += locality_data->object_size;
+      for (const NodeID &node_id : locality_data->nodes_containing_object) {
+        bytes_local_table[node_id] += locality_data->object_size;
+      }
+    }
+  }
+  if (bytes_local_table.empty()) {
+    return absl::nullopt;
+  }
+  // The fallback node is always a candidate, even if it has none of the bytes.
+  bytes_local_table.emplace(fallback_node_id, 0);
+
+  absl::optional<NodeID> best_node;
+  uint64_t best_node_bytes = 0;
+  double best_cost = 0;
+  for (const auto &entry : bytes_local_table) {
+    const NodeID &node_id = entry.first;
+    double transfer_ms =
+        (total_bytes - entry.second) / std::max(cost_model.transfer_bytes_per_ms, 1.0);
+    double capacity = cost_model.node_capacity ? cost_model.node_capacity(node_id) : 0;
+    if (capacity <= 0) {
+      capacity = 1;
+    }
+    int64_t num_leases = 0;
+    auto it = num_leases_per_node.find(node_id);
+    if (it != num_leases_per_node.end()) {
+      num_leases = it->second;
+    }
+    // The new lease waits for the ones queued beyond the capacity of the node.
+    double queue_ms =
+        std::max(0.0, num_leases + 1 - capacity) / capacity * cost_model.task_duration_ms;
+    double cost = transfer_ms + queue_ms;
+    // Break ties in favor of the node with more bytes local.
+    if (!best_node || cost < best_cost ||
+        (cost == best_cost && entry.second > best_node_bytes)) {
+      best_node = node_id;
+      best_node_bytes = entry.second;
+      best_cost = cost;
+    }
+  }
+  return std::make_pair(*best_node, best_node_bytes > 0);
+}
+
+/// Criteria for "best" node: The node with the most object bytes (from object_ids) local,
+/// or, with a cost model, the node with the least expected completion time.
+absl::optional<std::pair<NodeID, bool>> LocalityAwareLeasePolicy::GetBestNodeIdForTask(
+    const TaskSpecification &spec) {
+  if (cost_model_) {
+    return GetNodeWithLeastExpectedCompletionTime(
+        spec.GetDependencyIds(),
+        *locality_data_provider_,
+        NodeID::FromBinary(fallback_rpc_address_.raylet_id()),
+        num_leases_per_node_,
+        *cost_model_);
+  }
+  if (auto node_id =
+          GetNodeWithMostLocalBytes(spec.GetDependencyIds(), *locality_data_provider_)) {
+    return std::make_pair(*node_id, true);
+  }
+  return absl::nullopt;
+}
+
 std::pair<rpc::Address, bool> LocalLeasePolicy::GetBestNodeForTask(
     const TaskSpecification &spec) {
   // Always return the local node.
@@ -37,6 +37,41 @@ class LocalityDataProviderInterface {
   virtual ~LocalityDataProviderInterface() {}
 };
 
+/// Get the node that has the most bytes of the given objects local.
+///
+/// \return The node, or nullopt if none of the objects has a known location.
+absl::optional<NodeID> GetNodeWithMostLocalBytes(
+    const std::vector<ObjectID> &object_ids,
+    LocalityDataProviderInterface &locality_data_provider);
+
+/// Inputs of the cost model that LocalityAwareLeasePolicy uses to weigh the locality
+/// of a node against how loaded it already is.
+struct LeaseCostModel {
+  /// Estimated network bandwidth between nodes, in bytes per millisecond.
+  double transfer_bytes_per_ms;
+  /// Estimated duration of a task, in milliseconds. Used to convert the queue on a
+  /// node into a waiting time.
+  double task_duration_ms;
+  /// The number of tasks a node can run at a time (usually its CPUs), or 0 if unknown.
+  std::function<double(const NodeID &node_id)> node_capacity;
+};
+
+/// Get the node with the least expected completion time for a task with the given
+/// arguments. The expected completion time of a node is the time to transfer the
+/// argument bytes that it doesn't have, plus the time to wait for the leases that are
+/// already queued on it beyond its capacity. Only the nodes that hold some of the
+/// arguments and the fallback node are considered.
+///
+/// \param num_leases_per_node The number of leases currently held on each node.
+/// eturn The node and whether it was chosen because it holds some of the arguments,
+/// or nullopt if none of the objects has a known location.
+absl::optional<std::pair<NodeID, bool>> GetNodeWithLeastExpectedCompletionTime(
+    const std::vector<ObjectID> &object_ids,
+    LocalityDataProviderInterface &locality_data_provider,
+    const NodeID &fallback_node_id,
+    const absl::flat_hash_map<NodeID, int64_t> &num_leases_per_node,
+    const LeaseCostModel &cost_model);
+
 /// Interface for mocking the lease policy.
 class LeasePolicyInterface {
  public:
@@ -44,6 +79,12 @@ class LeasePolicyInterface {
   virtual std::pair<rpc::Address, bool> GetBestNodeForTask(
       const TaskSpecification &spec) = 0;
 
+  /// Called when a worker lease has been granted on the given node.
+  virtual void OnLeaseGranted(const NodeID &node_id) {}
+
+  /// Called when a worker lease on the given node has been returned.
+  virtual void OnLeaseReturned(const NodeID &node_id) {}
+
   virtual ~LeasePolicyInterface() {}
 };
 
@@ -57,10 +98,12 @@ class LocalityAwareLeasePolicy : public LeasePolicyInterface {
   LocalityAwareLeasePolicy(
       std::shared_ptr<LocalityDataProviderInterface> locality_data_provider,
       NodeAddrFactory node_addr_factory,
-      const rpc::Address fallback_rpc_address)
+      const rpc::Address fallback_rpc_address,
+      absl::optional<LeaseCostModel> cost_model = absl::nullopt)
       : locality_data_provider_(locality_data_provider),
         node_addr_factory_(node_addr_factory),
-        fallback_rpc_address_(fallback_rpc_address) {}
+        fallback_rpc_address_(fallback_rpc_address),
+        cost_model_(std::move(cost_model)) {}
 
   ~LocalityAwareLeasePolicy() {}
 
@@ -68,9 +111,15 @@ class LocalityAwareLeasePolicy : public LeasePolicyInterface {
   std::pair<rpc::Address, bool> GetBestNodeForTask(
       const TaskSpecification &spec) override;
 
+  void OnLeaseGranted(const NodeID &node_id) override;
+
+  void OnLeaseReturned(const NodeID &node_id) override;
+
  private:
-  /// Get the best worker node for a lease request for the provided task.
-  absl::optional<NodeID> GetBestNodeIdForTask(const TaskSpecification &spec);
+  /// Get the best worker node for a lease request for the provided task, and whether
+  /// it was chosen based on locality.
+  absl::optional<std::pair<NodeID, bool>> GetBestNodeIdForTask(
+      const TaskSpecification &spec);
 
   /// Provider of locality data that will be used in choosing the best lessor.
   std::shared_ptr<LocalityDataProviderInterface> locality_data_provider_;
@@ -80,6 +129,13 @@ class LocalityAwareLeasePolicy : public LeasePolicyInterface {
 
   /// RPC address of fallback node (usually the local node).
   const rpc::Address fallback_rpc_address_;
+
+  /// If set, weigh locality against the load of the nodes instead of picking the node
+  /// with the most bytes local.
+  const absl::optional<LeaseCostModel> cost_model_;
+
+  /// The number of leases that this worker currently holds on each node.
+  absl::flat_hash_map<NodeID, int64_t> num_leases_per_node_;
 };
 
 /// Class used by the core worker to implement a local-only lease policy for picking
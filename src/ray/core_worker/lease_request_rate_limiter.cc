@@ -0,0 +1,39 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/core_worker/lease_request_rate_limiter.h"
+
+#include <algorithm>
+
+namespace ray {
+namespace core {
+
+size_t ClusterSizeBasedLeaseRequestRateLimiter::
+    GetMaxPendingLeaseRequestsPerSchedulingCategory() {
+  return std::max(kMinLimit, num_alive_nodes_.load(std::memory_order_relaxed));
+}
+
+void ClusterSizeBasedLeaseRequestRateLimiter::OnNodeChange(
+    const NodeID &node_id, const rpc::GcsNodeInfo &data) {
+  absl::MutexLock lock(&mutex_);
+  if (data.state() == rpc::GcsNodeInfo::ALIVE) {
+    alive_nodes_.insert(node_id);
+  } else {
+    alive_nodes_.erase(node_id);
+  }
+  num_alive_nodes_.store(alive_nodes_.size(), std::memory_order_relaxed);
+}
+
+}  // namespace core
+}  // namespace ray
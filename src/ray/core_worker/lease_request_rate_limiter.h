@@ -0,0 +1,73 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/id.h"
+#include "src/ray/protobuf/gcs.pb.h"
+
+namespace ray {
+namespace core {
+
+/// Interface for limiting the number of lease requests that a submitter has in flight
+/// per scheduling category.
+class LeaseRequestRateLimiter {
+ public:
+  virtual size_t GetMaxPendingLeaseRequestsPerSchedulingCategory() = 0;
+
+  virtual ~LeaseRequestRateLimiter() {}
+};
+
+/// Limits the lease requests in flight to a fixed number.
+class StaticLeaseRequestRateLimiter : public LeaseRequestRateLimiter {
+ public:
+  explicit StaticLeaseRequestRateLimiter(size_t limit) : kLimit(limit) {}
+
+  size_t GetMaxPendingLeaseRequestsPerSchedulingCategory() override { return kLimit; }
+
+ private:
+  const size_t kLimit;
+};
+
+/// Limits the lease requests in flight to the number of alive nodes, but no fewer than
+/// a minimum. Each lease request is scheduled, and possibly spilled back, on its own,
+/// so this lets a large fan-out ramp up on all of the nodes at once. This class is
+/// thread-safe.
+class ClusterSizeBasedLeaseRequestRateLimiter : public LeaseRequestRateLimiter {
+ public:
+  explicit ClusterSizeBasedLeaseRequestRateLimiter(size_t min_limit)
+      : kMinLimit(min_limit) {}
+
+  size_t GetMaxPendingLeaseRequestsPerSchedulingCategory() override;
+
+  /// Update the number of alive nodes, given the new state of a node.
+  void OnNodeChange(const NodeID &node_id, const rpc::GcsNodeInfo &data);
+
+ private:
+  const size_t kMinLimit;
+
+  /// The IDs of the alive nodes, guarded by the mutex. Node changes are rare, so the
+  /// count that the submitter reads is kept separately.
+  absl::Mutex mutex_;
+  absl::flat_hash_set<NodeID> alive_nodes_ GUARDED_BY(mutex_);
+  std::atomic<size_t> num_alive_nodes_{0};
+};
+
+}  // namespace core
+}  // namespace ray
@@ -193,6 +193,11 @@ Java_io_ray_runtime_RayNativeRuntime_nativeInitialize(JNIEnv *env,
                 return JavaNativeRayObjectToNativeRayObject(env, java_native_ray_object);
               });
           results->resize(return_ids.size(), nullptr);
+          // The returns are sealed in batches, to save round trips to the store for
+          // tasks with many returns.
+          std::vector<ObjectID> unsealed_ids;
+          std::vector<std::shared_ptr<RayObject>> unsealed_objects;
+          int64_t unsealed_bytes = 0;
           for (size_t i = 0; i < return_objects.size(); i++) {
             auto &result_id = return_ids[i];
             size_t data_size =
@@ -220,10 +225,18 @@ Java_io_ray_runtime_RayNativeRuntime_nativeInitialize(JNIEnv *env,
                        return_objects[i]->GetData()->Data(),
                        data_size);
               }
+              unsealed_ids.push_back(result_id);
+              unsealed_objects.push_back(result);
+              unsealed_bytes += data_size;
+            }
+            if (unsealed_bytes >= RayConfig::instance().task_return_seal_batch_bytes() ||
+                i + 1 == return_objects.size()) {
+              RAY_CHECK_OK(CoreWorkerProcess::GetCoreWorker().SealReturnObjects(
+                  unsealed_ids, unsealed_objects));
+              unsealed_ids.clear();
+              unsealed_objects.clear();
+              unsealed_bytes = 0;
             }
-
-            RAY_CHECK_OK(
-                CoreWorkerProcess::GetCoreWorker().SealReturnObject(result_id, result));
           }
         }
 
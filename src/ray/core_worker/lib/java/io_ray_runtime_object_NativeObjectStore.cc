@@ -28,12 +28,14 @@ Status PutSerializedObject(JNIEnv *env,
                            ObjectID *out_object_id,
                            bool pin_object = true,
                            const std::unique_ptr<rpc::Address> &owner_address = nullptr) {
-  auto native_ray_object = JavaNativeRayObjectToNativeRayObject(env, obj);
+  // The data is copied straight from the Java array to the object store, instead of
+  // through a native copy of the array.
+  auto java_data = static_cast<jbyteArray>(
+      env->GetObjectField(obj, java_native_ray_object_data));
+  size_t data_size = java_data ? env->GetArrayLength(java_data) : 0;
+  auto native_ray_object =
+      JavaNativeRayObjectToNativeRayObject(env, obj, /*with_data=*/false);
   RAY_CHECK(native_ray_object != nullptr);
-  size_t data_size = 0;
-  if (native_ray_object->HasData()) {
-    data_size = native_ray_object->GetData()->Size();
-  }
   std::shared_ptr<Buffer> data;
   Status status;
   if (object_id.IsNil()) {
@@ -67,7 +69,8 @@ Status PutSerializedObject(JNIEnv *env,
   // here.
   if (data != nullptr) {
     if (data->Size() > 0) {
-      memcpy(data->Data(), native_ray_object->GetData()->Data(), data->Size());
+      env->GetByteArrayRegion(
+          java_data, 0, data->Size(), reinterpret_cast<jbyte *>(data->Data()));
     }
     if (object_id.IsNil()) {
       RAY_CHECK_OK(CoreWorkerProcess::GetCoreWorker().SealOwned(
@@ -36,6 +36,13 @@ inline const RayFunction &ToRayFunction(JNIEnv *env,
                                         jobject functionDescriptor,
                                         jint hash) {
   auto &fd_vector = submitter_function_descriptor_cache[hash];
+  // The same descriptor instance is usually passed again, e.g. for the calls of an actor
+  // method, which is checked without calling into Java.
+  for (auto &[obj, func] : fd_vector) {
+    if (env->IsSameObject(obj, functionDescriptor)) {
+      return func;
+    }
+  }
   for (auto &[obj, func] : fd_vector) {
     if (env->CallBooleanMethod(obj, java_object_equals, functionDescriptor)) {
       return func;
@@ -66,15 +73,20 @@ inline std::vector<std::unique_ptr<TaskArg>> ToTaskArgs(JNIEnv *env, jobject arg
       env, args, &task_args, [](JNIEnv *env, jobject arg) {
         auto java_id = env->GetObjectField(arg, java_function_arg_id);
         if (java_id) {
-          auto java_id_bytes = static_cast<jbyteArray>(
-              env->CallObjectMethod(java_id, java_base_id_get_bytes));
-          RAY_CHECK_JAVA_EXCEPTION(env);
-          auto id = JavaByteArrayToId<ObjectID>(env, java_id_bytes);
+          auto id = JavaIdToNativeId<ObjectID>(env, java_id);
+          env->DeleteLocalRef(java_id);
           auto java_owner_address =
               env->GetObjectField(arg, java_function_arg_owner_address);
-          RAY_CHECK(java_owner_address);
-          auto owner_address = JavaProtobufObjectToNativeProtobufObject<rpc::Address>(
-              env, java_owner_address);
+          rpc::Address owner_address;
+          if (java_owner_address) {
+            owner_address = JavaProtobufObjectToNativeProtobufObject<rpc::Address>(
+                env, java_owner_address);
+            env->DeleteLocalRef(java_owner_address);
+          } else {
+            // Look up the owner here rather than round-tripping its address through
+            // Java.
+            owner_address = CoreWorkerProcess::GetCoreWorker().GetOwnerAddress(id);
+          }
           return std::unique_ptr<TaskArg>(
               new TaskArgByReference(id, owner_address, /*call_site=*/""));
         }
@@ -108,10 +120,7 @@ inline std::pair<PlacementGroupID, int64_t> ToPlacementGroupOptions(JNIEnv *env,
   auto group = env->GetObjectField(callOptions, java_task_creation_options_group);
   if (group) {
     auto placement_group_id = env->GetObjectField(group, java_placement_group_id);
-    auto java_id_bytes = static_cast<jbyteArray>(
-        env->CallObjectMethod(placement_group_id, java_base_id_get_bytes));
-    RAY_CHECK_JAVA_EXCEPTION(env);
-    auto id = JavaByteArrayToId<PlacementGroupID>(env, java_id_bytes);
+    auto id = JavaIdToNativeId<PlacementGroupID>(env, placement_group_id);
     auto index = env->GetIntField(callOptions, java_task_creation_options_bundle_index);
     placement_group_options = std::make_pair(id, index);
   }
@@ -75,6 +75,7 @@ jmethodID java_jni_exception_util_get_stack_trace;
 
 jclass java_base_id_class;
 jmethodID java_base_id_get_bytes;
+jfieldID java_base_id_id;
 
 jclass java_abstract_message_lite_class;
 jmethodID java_abstract_message_lite_to_byte_array;
@@ -268,6 +269,7 @@ jint JNI_OnLoad(JavaVM *vm, void *reserved) {
 
   java_base_id_class = LoadClass(env, "io/ray/api/id/BaseId");
   java_base_id_get_bytes = env->GetMethodID(java_base_id_class, "getBytes", "()[B");
+  java_base_id_id = env->GetFieldID(java_base_id_class, "id", "[B");
 
   java_abstract_message_lite_class =
       LoadClass(env, "io/ray/shaded/com/google/protobuf/AbstractMessage");
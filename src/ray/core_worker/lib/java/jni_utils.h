@@ -133,6 +133,8 @@ extern jmethodID java_jni_exception_util_get_stack_trace;
 extern jclass java_base_id_class;
 /// getBytes method of BaseId class
 extern jmethodID java_base_id_get_bytes;
+/// id field of BaseId class
+extern jfieldID java_base_id_id;
 
 /// AbstractMessageLite class
 extern jclass java_abstract_message_lite_class;
@@ -337,11 +339,12 @@ class JavaByteArrayBuffer : public Buffer {
   JavaByteArrayBuffer(JNIEnv *env, jbyteArray java_byte_array)
       : env_(env), java_byte_array_(java_byte_array) {
     native_bytes_ = env_->GetByteArrayElements(java_byte_array_, nullptr);
+    size_ = env_->GetArrayLength(java_byte_array_);
   }
 
   uint8_t *Data() const override { return reinterpret_cast<uint8_t *>(native_bytes_); }
 
-  size_t Size() const override { return env_->GetArrayLength(java_byte_array_); }
+  size_t Size() const override { return size_; }
 
   bool OwnsData() const override { return true; }
 
@@ -356,6 +359,8 @@ class JavaByteArrayBuffer : public Buffer {
   JNIEnv *env_;
   jbyteArray java_byte_array_;
   jbyte *native_bytes_;
+  /// The size is cached, so that it doesn't cost a JNI call each time.
+  size_t size_;
 };
 
 /// Convert a Java byte array to a C++ string.
@@ -378,6 +383,17 @@ inline ID JavaByteArrayToId(JNIEnv *env, const jbyteArray &bytes) {
   return ID::FromBinary(id_str);
 }
 
+/// Convert a Java BaseId to a C++ UniqueID. The bytes of the ID are read from its field
+/// directly, rather than by calling `getBytes`.
+template <typename ID>
+inline ID JavaIdToNativeId(JNIEnv *env, jobject java_id) {
+  auto java_id_bytes =
+      static_cast<jbyteArray>(env->GetObjectField(java_id, java_base_id_id));
+  auto id = JavaByteArrayToId<ID>(env, java_id_bytes);
+  env->DeleteLocalRef(java_id_bytes);
+  return id;
+}
+
 /// Convert C++ UniqueID to a Java byte array.
 template <typename ID>
 inline jbyteArray IdToJavaByteArray(JNIEnv *env, const ID &id) {
@@ -575,15 +591,22 @@ inline std::shared_ptr<JavaByteArrayBuffer> JavaByteArrayToNativeBuffer(
 
 /// Convert a Java NativeRayObject to a C++ RayObject.
 /// NOTE: the returned RayObject cannot be used across threads.
+///
+/// \param with_data Whether to convert the data. If false, the RayObject has no data,
+/// so that the caller can copy it straight from the Java array to where it's needed.
 inline std::shared_ptr<RayObject> JavaNativeRayObjectToNativeRayObject(
-    JNIEnv *env, const jobject &java_obj) {
+    JNIEnv *env, const jobject &java_obj, bool with_data = true) {
   if (!java_obj) {
     return nullptr;
   }
-  auto java_data = (jbyteArray)env->GetObjectField(java_obj, java_native_ray_object_data);
+  std::shared_ptr<Buffer> data_buffer;
+  if (with_data) {
+    auto java_data =
+        (jbyteArray)env->GetObjectField(java_obj, java_native_ray_object_data);
+    data_buffer = JavaByteArrayToNativeBuffer(env, java_data);
+  }
   auto java_metadata =
       (jbyteArray)env->GetObjectField(java_obj, java_native_ray_object_metadata);
-  std::shared_ptr<Buffer> data_buffer = JavaByteArrayToNativeBuffer(env, java_data);
   std::shared_ptr<Buffer> metadata_buffer =
       JavaByteArrayToNativeBuffer(env, java_metadata);
   if (data_buffer && data_buffer->Size() == 0) {
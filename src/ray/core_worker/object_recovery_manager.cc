@@ -14,8 +14,15 @@
 
 #include "ray/core_worker/object_recovery_manager.h"
 
+#include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
 
+DEFINE_stats(object_recovery_time_ms,
+             "Time to recover a lost object, by pinning a copy or reconstructing it.",
+             (),
+             ({10, 100, 1000, 10000, 100000}, ),
+             ray::stats::HISTOGRAM);
+
 namespace ray {
 namespace core {
 
@@ -49,7 +56,8 @@ bool ObjectRecoveryManager::RecoverObject(const ObjectID &object_id) {
       absl::MutexLock lock(&mu_);
       // Mark that we are attempting recovery for this object to prevent
       // duplicate restarts of the same object.
-      already_pending_recovery = !objects_pending_recovery_.insert(object_id).second;
+      already_pending_recovery =
+          !objects_pending_recovery_.emplace(object_id, current_time_ms()).second;
     }
   }
 
@@ -58,7 +66,10 @@ bool ObjectRecoveryManager::RecoverObject(const ObjectID &object_id) {
     in_memory_store_->GetAsync(
         object_id, [this, object_id](std::shared_ptr<RayObject> obj) {
           absl::MutexLock lock(&mu_);
-          RAY_CHECK(objects_pending_recovery_.erase(object_id)) << object_id;
+          auto it = objects_pending_recovery_.find(object_id);
+          RAY_CHECK(it != objects_pending_recovery_.end()) << object_id;
+          STATS_object_recovery_time_ms.Record(current_time_ms() - it->second);
+          objects_pending_recovery_.erase(it);
           RAY_LOG(INFO) << "Recovery complete for object " << object_id;
         });
     // Lookup the object in the GCS to find another copy.
@@ -76,6 +87,53 @@ bool ObjectRecoveryManager::RecoverObject(const ObjectID &object_id) {
   return true;
 }
 
+std::vector<ObjectID> ObjectRecoveryManager::RecoverObjects(
+    const std::vector<ObjectID> &object_ids) {
+  {
+    absl::MutexLock lock(&mu_);
+    num_recovery_batches_++;
+  }
+  std::vector<ObjectID> unrecoverable;
+  for (const auto &object_id : object_ids) {
+    if (!RecoverObject(object_id)) {
+      unrecoverable.push_back(object_id);
+    }
+  }
+
+  // Recover the arguments of the resubmitted tasks, one level of lineage at a time.
+  while (true) {
+    std::vector<ObjectID> wave;
+    {
+      absl::MutexLock lock(&mu_);
+      wave.swap(next_recovery_wave_);
+    }
+    if (wave.empty()) {
+      break;
+    }
+    RAY_LOG(DEBUG) << "Recovering " << wave.size() << " arguments of resubmitted tasks";
+    for (const auto &dep : wave) {
+      if (!RecoverObject(dep)) {
+        FailDependencyRecovery(dep);
+      }
+    }
+  }
+
+  absl::flat_hash_map<NodeID, std::pair<rpc::Address, std::vector<PendingPin>>> pins;
+  {
+    absl::MutexLock lock(&mu_);
+    if (--num_recovery_batches_ == 0) {
+      pins.swap(pending_pins_);
+    }
+  }
+  if (!pins.empty()) {
+    RAY_LOG(INFO) << "Pinning copies of lost objects at " << pins.size() << " nodes";
+  }
+  for (auto &entry : pins) {
+    PinExistingObjectCopies(entry.second.first, std::move(entry.second.second));
+  }
+  return unrecoverable;
+}
+
 void ObjectRecoveryManager::PinOrReconstructObject(
     const ObjectID &object_id, const std::vector<rpc::Address> &locations) {
   RAY_LOG(DEBUG) << "Lost object " << object_id << " has " << locations.size()
@@ -95,11 +153,25 @@ void ObjectRecoveryManager::PinExistingObjectCopy(
     const ObjectID &object_id,
     const rpc::Address &raylet_address,
     const std::vector<rpc::Address> &other_locations) {
+  {
+    absl::MutexLock lock(&mu_);
+    if (num_recovery_batches_ > 0) {
+      auto &batch = pending_pins_[NodeID::FromBinary(raylet_address.raylet_id())];
+      batch.first = raylet_address;
+      batch.second.push_back(PendingPin{object_id, other_locations});
+      return;
+    }
+  }
+  PinExistingObjectCopies(raylet_address, {PendingPin{object_id, other_locations}});
+}
+
+void ObjectRecoveryManager::PinExistingObjectCopies(const rpc::Address &raylet_address,
+                                                    std::vector<PendingPin> pins) {
   // If a copy still exists, pin the object by sending a
   // PinObjectIDs RPC.
   const auto node_id = NodeID::FromBinary(raylet_address.raylet_id());
-  RAY_LOG(DEBUG) << "Trying to pin copy of lost object " << object_id << " at node "
-                 << node_id;
+  RAY_LOG(DEBUG) << "Trying to pin copies of " << pins.size()
+                 << " lost objects at node " << node_id;
 
   std::shared_ptr<PinObjectsInterface> client;
   if (node_id == NodeID::FromBinary(rpc_address_.raylet_id())) {
@@ -118,23 +190,39 @@ void ObjectRecoveryManager::PinExistingObjectCopy(
     client = client_it->second;
   }
 
-  client->PinObjectIDs(rpc_address_,
-                       {object_id},
-                       [this, object_id, other_locations, node_id](
-                           const Status &status, const rpc::PinObjectIDsReply &reply) {
-                         if (status.ok()) {
-                           // TODO(swang): Make sure that the node is still alive when
-                           // marking the object as pinned.
-                           RAY_CHECK(in_memory_store_->Put(
-                               RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
-                           reference_counter_->UpdateObjectPinnedAtRaylet(object_id,
-                                                                          node_id);
-                         } else {
-                           RAY_LOG(INFO) << "Error pinning new copy of lost object "
-                                         << object_id << ", trying again";
-                           PinOrReconstructObject(object_id, other_locations);
-                         }
-                       });
+  std::vector<ObjectID> object_ids;
+  object_ids.reserve(pins.size());
+  for (const auto &pin : pins) {
+    object_ids.push_back(pin.object_id);
+  }
+  client->PinObjectIDs(
+      rpc_address_,
+      object_ids,
+      [this, raylet_address, pins = std::move(pins), node_id](
+          const Status &status, const rpc::PinObjectIDsReply &reply) {
+        if (status.ok()) {
+          for (const auto &pin : pins) {
+            // TODO(swang): Make sure that the node is still alive when
+            // marking the object as pinned.
+            RAY_CHECK(in_memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA),
+                                            pin.object_id));
+            reference_counter_->UpdateObjectPinnedAtRaylet(pin.object_id, node_id);
+          }
+        } else if (pins.size() > 1) {
+          // The whole request fails if any of the copies is gone, so retry each of
+          // them on its own.
+          RAY_LOG(INFO) << "Error pinning new copies of " << pins.size()
+                        << " lost objects at node " << node_id
+                        << ", trying each of them again";
+          for (const auto &pin : pins) {
+            PinExistingObjectCopies(raylet_address, {pin});
+          }
+        } else {
+          RAY_LOG(INFO) << "Error pinning new copy of lost object "
+                        << pins.front().object_id << ", trying again";
+          PinOrReconstructObject(pins.front().object_id, pins.front().other_locations);
+        }
+      });
 }
 
 void ObjectRecoveryManager::ReconstructObject(const ObjectID &object_id) {
@@ -164,20 +252,19 @@ void ObjectRecoveryManager::ReconstructObject(const ObjectID &object_id) {
   auto resubmitted = task_resubmitter_->ResubmitTask(task_id, &task_deps);
 
   if (resubmitted) {
-    // Try to recover the task's dependencies.
-    for (const auto &dep : task_deps) {
-      auto recovered = RecoverObject(dep);
-      if (!recovered) {
-        RAY_LOG(INFO) << "Failed to reconstruct object " << dep;
-        // This case can happen if the dependency was borrowed from another
-        // worker, or if there was a bug in reconstruction that caused us to GC
-        // the dependency ref.
-        // We do not pin the dependency because we may not be the owner.
-        recovery_failure_callback_(dep,
-                                   rpc::ErrorType::OBJECT_UNRECONSTRUCTABLE,
-                                   /*pin_object=*/false);
+    // Try to recover the task's dependencies. While objects are recovered together,
+    // they are recovered with the next wave.
+    {
+      absl::MutexLock lock(&mu_);
+      if (num_recovery_batches_ > 0) {
+        next_recovery_wave_.insert(
+            next_recovery_wave_.end(), task_deps.begin(), task_deps.end());
+        return;
       }
     }
+    for (const auto &dep : RecoverObjects(task_deps)) {
+      FailDependencyRecovery(dep);
+    }
   } else {
     RAY_LOG(INFO) << "Failed to reconstruct object " << object_id
                   << " because lineage has already been deleted";
@@ -188,5 +275,15 @@ void ObjectRecoveryManager::ReconstructObject(const ObjectID &object_id) {
   }
 }
 
+void ObjectRecoveryManager::FailDependencyRecovery(const ObjectID &dep) {
+  RAY_LOG(INFO) << "Failed to reconstruct object " << dep;
+  // This case can happen if the dependency was borrowed from another
+  // worker, or if there was a bug in reconstruction that caused us to GC
+  // the dependency ref.
+  // We do not pin the dependency because we may not be the owner.
+  recovery_failure_callback_(
+      dep, rpc::ErrorType::OBJECT_UNRECONSTRUCTABLE, /*pin_object=*/false);
+}
+
 }  // namespace core
 }  // namespace ray
@@ -79,8 +79,8 @@ class ObjectRecoveryManager {
   /// that created the object. If the task resubmission fails, then the
   /// fail the recovery operation.
   /// 4. If task resubmission succeeds, recursively attempt to recover any
-  /// plasma arguments to the task. The recovery operation will succeed once
-  /// the task completes and stores a new value for its return object.
+  /// plasma arguments to the task, together. The recovery operation will succeed
+  /// once the task completes and stores a new value for its return object.
   ///
   /// \return True if recovery for the object has successfully started, false
   /// if the object is not recoverable because we do not have any metadata
@@ -89,6 +89,14 @@ class ObjectRecoveryManager {
   /// reconstruction failure callback will be called for this object).
   bool RecoverObject(const ObjectID &object_id);
 
+  /// Recover a set of objects together, e.g., the objects lost with a node. The
+  /// copies of the objects that are pinned at the same node are pinned with a
+  /// single request, and the tasks that created the other objects are resubmitted
+  /// in waves, one per level of their lineage.
+  ///
+  /// \return The objects that are not recoverable, see RecoverObject.
+  std::vector<ObjectID> RecoverObjects(const std::vector<ObjectID> &object_ids);
+
  private:
   /// Pin a new copy for a lost object from the given locations or, if that
   /// fails, attempt to reconstruct it by resubmitting the task that created
@@ -96,15 +104,30 @@ class ObjectRecoveryManager {
   void PinOrReconstructObject(const ObjectID &object_id,
                               const std::vector<rpc::Address> &locations);
 
+  /// A copy of a lost object to pin, and the locations to try if that fails.
+  struct PendingPin {
+    ObjectID object_id;
+    std::vector<rpc::Address> other_locations;
+  };
+
   /// Pin a new copy for the object at the given location. If that fails, then
-  /// try one of the other locations.
+  /// try one of the other locations. While objects are recovered together, the
+  /// copy is batched with the other copies at the same location.
   void PinExistingObjectCopy(const ObjectID &object_id,
                              const rpc::Address &raylet_address,
                              const std::vector<rpc::Address> &other_locations);
 
+  /// Pin the copies of objects at the given location with a single request. If the
+  /// request fails, each of the copies is retried on its own.
+  void PinExistingObjectCopies(const rpc::Address &raylet_address,
+                               std::vector<PendingPin> pins);
+
   /// Reconstruct an object by resubmitting the task that created it.
   void ReconstructObject(const ObjectID &object_id);
 
+  /// Fail the recovery of an argument of a resubmitted task.
+  void FailDependencyRecovery(const ObjectID &dep);
+
   /// Used to resubmit tasks.
   std::shared_ptr<TaskResubmissionInterface> task_resubmitter_;
 
@@ -138,9 +161,22 @@ class ObjectRecoveryManager {
   absl::flat_hash_map<NodeID, std::shared_ptr<PinObjectsInterface>>
       remote_object_pinning_clients_ GUARDED_BY(mu_);
 
-  /// Objects that are currently pending recovery. Calls to RecoverObject for
-  /// objects currently in this set are idempotent.
-  absl::flat_hash_set<ObjectID> objects_pending_recovery_ GUARDED_BY(mu_);
+  /// Objects that are currently pending recovery, and the time their recovery
+  /// started. Calls to RecoverObject for objects currently in this map are
+  /// idempotent.
+  absl::flat_hash_map<ObjectID, int64_t> objects_pending_recovery_ GUARDED_BY(mu_);
+
+  /// The number of RecoverObjects calls in progress. While it is positive, the
+  /// copies to pin are batched per location, and they are sent once it drops to 0.
+  int num_recovery_batches_ GUARDED_BY(mu_) = 0;
+
+  /// The copies to pin at each location, while objects are recovered together.
+  absl::flat_hash_map<NodeID, std::pair<rpc::Address, std::vector<PendingPin>>>
+      pending_pins_ GUARDED_BY(mu_);
+
+  /// The arguments of the tasks resubmitted by the current wave of recovery, which
+  /// are recovered by the next wave.
+  std::vector<ObjectID> next_recovery_wave_ GUARDED_BY(mu_);
 };
 
 }  // namespace core
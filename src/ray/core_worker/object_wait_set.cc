@@ -0,0 +1,75 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/core_worker/object_wait_set.h"
+
+namespace ray {
+namespace core {
+
+std::shared_ptr<ObjectWaitSet> ObjectWaitSet::Create(
+    CoreWorkerMemoryStore &memory_store, const std::vector<ObjectID> &object_ids) {
+  std::shared_ptr<ObjectWaitSet> wait_set(new ObjectWaitSet(object_ids.size()));
+  // The memory store keeps the callbacks until the objects are available, so they
+  // must not keep a destroyed set alive.
+  std::weak_ptr<ObjectWaitSet> weak_wait_set = wait_set;
+  for (const auto &object_id : object_ids) {
+    memory_store.GetAsync(
+        object_id, [weak_wait_set, object_id](std::shared_ptr<RayObject> object) {
+          if (auto wait_set = weak_wait_set.lock()) {
+            wait_set->OnAvailable(object_id, object->IsInPlasmaError());
+          }
+        });
+  }
+  return wait_set;
+}
+
+void ObjectWaitSet::OnAvailable(const ObjectID &object_id, bool in_plasma) {
+  absl::MutexLock lock(&mu_);
+  available_.emplace_back(object_id, in_plasma);
+}
+
+bool ObjectWaitSet::WaitAvailable(size_t num_objects, int64_t timeout_ms) {
+  absl::MutexLock lock(&mu_);
+  auto enough_available = [this, num_objects]() EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return available_.size() >= num_objects;
+  };
+  if (timeout_ms < 0) {
+    mu_.Await(absl::Condition(&enough_available));
+    return true;
+  }
+  return mu_.AwaitWithTimeout(absl::Condition(&enough_available),
+                              absl::Milliseconds(timeout_ms));
+}
+
+std::vector<ObjectWaitSet::AvailableObject> ObjectWaitSet::TakeAvailable() {
+  absl::MutexLock lock(&mu_);
+  std::vector<AvailableObject> objects(available_.begin(), available_.end());
+  available_.clear();
+  num_remaining_ -= objects.size();
+  return objects;
+}
+
+void ObjectWaitSet::PutBack(const std::vector<AvailableObject> &objects) {
+  absl::MutexLock lock(&mu_);
+  available_.insert(available_.begin(), objects.begin(), objects.end());
+  num_remaining_ += objects.size();
+}
+
+size_t ObjectWaitSet::NumRemaining() const {
+  absl::MutexLock lock(&mu_);
+  return num_remaining_;
+}
+
+}  // namespace core
+}  // namespace ray
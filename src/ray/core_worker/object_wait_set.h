@@ -0,0 +1,77 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "ray/common/id.h"
+#include "ray/core_worker/store_provider/memory_store/memory_store.h"
+
+namespace ray {
+namespace core {
+
+/// \class ObjectWaitSet
+/// A set of objects that a worker waits on repeatedly, e.g. to process the results of
+/// many tasks as they complete. The set subscribes once to each object in the memory
+/// store and queues the objects as they become available, so that each poll only
+/// touches the objects it returns, instead of all the objects still waited on. This
+/// class is thread-safe.
+class ObjectWaitSet : public std::enable_shared_from_this<ObjectWaitSet> {
+ public:
+  /// An available object, and whether its value is in plasma.
+  using AvailableObject = std::pair<ObjectID, bool>;
+
+  /// Create a wait set and subscribe to its objects.
+  ///
+  /// \param memory_store The store that the objects' values, or their in-plasma
+  /// markers, are put in.
+  /// \param object_ids The objects to wait on. They must be distinct.
+  static std::shared_ptr<ObjectWaitSet> Create(CoreWorkerMemoryStore &memory_store,
+                                               const std::vector<ObjectID> &object_ids);
+
+  /// Wait until at least `num_objects` objects are available, or the timeout expires.
+  ///
+  /// \param timeout_ms The time to wait for, or -1 to wait until they are available.
+  /// \return Whether the objects are available.
+  bool WaitAvailable(size_t num_objects, int64_t timeout_ms);
+
+  /// Take all the available objects out of the set, in the order they became
+  /// available.
+  std::vector<AvailableObject> TakeAvailable();
+
+  /// Put objects taken out of the set back, at the front, e.g. because they were not
+  /// returned to the caller.
+  void PutBack(const std::vector<AvailableObject> &objects);
+
+  /// Return the number of objects that were not taken out of the set yet.
+  size_t NumRemaining() const;
+
+ private:
+  explicit ObjectWaitSet(size_t num_objects) : num_remaining_(num_objects) {}
+
+  void OnAvailable(const ObjectID &object_id, bool in_plasma);
+
+  mutable absl::Mutex mu_;
+  /// The objects that are available and were not taken out of the set yet.
+  std::deque<AvailableObject> available_ GUARDED_BY(mu_);
+  size_t num_remaining_ GUARDED_BY(mu_);
+};
+
+}  // namespace core
+}  // namespace ray
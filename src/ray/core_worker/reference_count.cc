@@ -76,6 +76,99 @@ ReferenceCounter::ReferenceTable ReferenceCounter::ReferenceTableFromProto(
   return refs;
 }
 
+void ReferenceCounter::ReferenceTableFromCompactProto(
+    const rpc::CompactObjectReferenceCounts &proto, ReferenceTable *refs) {
+  std::vector<rpc::WorkerAddress> addresses;
+  addresses.reserve(proto.addresses_size());
+  for (const auto &address : proto.addresses()) {
+    addresses.emplace_back(address);
+  }
+  for (const auto &group : proto.owner_groups()) {
+    RAY_CHECK_LT(group.owner(), addresses.size());
+    const auto &owner_address = proto.addresses(group.owner());
+    auto add_reference = [&](const std::string &id, bool has_local_ref) -> Reference & {
+      auto &ref = (*refs)[ObjectID::FromBinary(id)];
+      ref.owner_address = owner_address;
+      ref.local_ref_count = has_local_ref ? 1 : 0;
+      return ref;
+    };
+    for (const auto &id : group.ids_with_local_ref()) {
+      add_reference(id, /*has_local_ref=*/true);
+    }
+    for (const auto &id : group.ids_without_local_ref()) {
+      add_reference(id, /*has_local_ref=*/false);
+    }
+    for (const auto &entry : group.entries()) {
+      auto &ref = add_reference(entry.object_id(), entry.has_local_ref());
+      for (const auto borrower : entry.borrowers()) {
+        RAY_CHECK_LT(borrower, addresses.size());
+        ref.mutable_borrow()->borrowers.insert(addresses[borrower]);
+      }
+      RAY_CHECK_EQ(entry.stored_in_object_ids_size(),
+                   entry.stored_in_object_owners_size());
+      for (int i = 0; i < entry.stored_in_object_ids_size(); i++) {
+        const auto owner = entry.stored_in_object_owners(i);
+        RAY_CHECK_LT(owner, addresses.size());
+        ref.mutable_borrow()->stored_in_objects.emplace(
+            ObjectID::FromBinary(entry.stored_in_object_ids(i)), addresses[owner]);
+      }
+      for (const auto &id : entry.contains()) {
+        ref.mutable_nested()->contains.insert(ObjectID::FromBinary(id));
+      }
+      for (const auto &id : entry.contained_in_borrowed_ids()) {
+        ref.mutable_nested()->contained_in_borrowed_ids.insert(ObjectID::FromBinary(id));
+      }
+    }
+  }
+}
+
+void ReferenceCounter::CompactReferenceTableProto(
+    ReferenceTableProto *refs, rpc::CompactObjectReferenceCounts *compact) {
+  absl::flat_hash_map<std::string, uint32_t> address_indexes;
+  auto address_index = [&](const rpc::Address &address) {
+    auto [it, inserted] =
+        address_indexes.try_emplace(address.SerializeAsString(), address_indexes.size());
+    if (inserted) {
+      compact->add_addresses()->CopyFrom(address);
+    }
+    return it->second;
+  };
+  absl::flat_hash_map<uint32_t, rpc::CompactObjectReferenceCounts::OwnerGroup *>
+      owner_groups;
+  for (auto &ref : *refs) {
+    const auto owner = address_index(ref.reference().owner_address());
+    auto &group = owner_groups[owner];
+    if (group == nullptr) {
+      group = compact->add_owner_groups();
+      group->set_owner(owner);
+    }
+    auto *object_id = ref.mutable_reference()->mutable_object_id();
+    if (ref.borrowers().empty() && ref.stored_in_objects().empty() &&
+        ref.contained_in_borrowed_ids().empty() && ref.contains().empty()) {
+      if (ref.has_local_ref()) {
+        group->add_ids_with_local_ref(std::move(*object_id));
+      } else {
+        group->add_ids_without_local_ref(std::move(*object_id));
+      }
+      continue;
+    }
+    auto *entry = group->add_entries();
+    entry->set_object_id(std::move(*object_id));
+    entry->set_has_local_ref(ref.has_local_ref());
+    for (const auto &borrower : ref.borrowers()) {
+      entry->add_borrowers(address_index(borrower));
+    }
+    for (auto &object : *ref.mutable_stored_in_objects()) {
+      entry->add_stored_in_object_ids(std::move(*object.mutable_object_id()));
+      entry->add_stored_in_object_owners(address_index(object.owner_address()));
+    }
+    entry->mutable_contained_in_borrowed_ids()->Swap(
+        ref.mutable_contained_in_borrowed_ids());
+    entry->mutable_contains()->Swap(ref.mutable_contains());
+  }
+  refs->Clear();
+}
+
 void ReferenceCounter::ReferenceTableToProto(ReferenceProtoTable &table,
                                              ReferenceTableProto *proto) {
   for (auto &[id, ref] : table) {
@@ -360,7 +453,12 @@ void ReferenceCounter::UpdateFinishedTaskReferences(
     bool release_lineage,
     const rpc::Address &worker_addr,
     const ReferenceTableProto &borrowed_refs,
+    const rpc::CompactObjectReferenceCounts &compact_borrowed_refs,
     std::vector<ObjectID> *deleted) {
+  // Decode the references before taking the lock, since this is most of the work
+  // for tasks that borrowed many references.
+  auto refs = ReferenceTableFromProto(borrowed_refs);
+  ReferenceTableFromCompactProto(compact_borrowed_refs, &refs);
   absl::MutexLock lock(&mutex_);
   for (const auto &return_id : return_ids) {
     UpdateObjectPendingCreation(return_id, false);
@@ -369,7 +467,6 @@ void ReferenceCounter::UpdateFinishedTaskReferences(
   // to make sure that for serialized IDs, we increment the borrower count for
   // the inner ID before decrementing the submitted_task_ref_count for the
   // outer ID.
-  const auto refs = ReferenceTableFromProto(borrowed_refs);
   if (!refs.empty()) {
     RAY_CHECK(!WorkerID::FromBinary(worker_addr.worker_id()).IsNil());
   }
@@ -1213,7 +1310,8 @@ absl::optional<absl::flat_hash_set<NodeID>> ReferenceCounter::GetObjectLocations
                    << " that doesn't exist in the reference table";
     return absl::nullopt;
   }
-  return it->second.locations;
+  return absl::flat_hash_set<NodeID>(it->second.locations.begin(),
+                                     it->second.locations.end());
 }
 
 bool ReferenceCounter::HandleObjectSpilled(const ObjectID &object_id,
@@ -1281,11 +1379,12 @@ absl::optional<LocalityData> ReferenceCounter::GetLocalityData(
   //   locations.
   // - If we don't own this object, this will contain a snapshot of the object locations
   //   at future resolution time.
-  const auto &node_ids = it->second.locations;
+  const auto &locations = it->second.locations;
+  absl::flat_hash_set<NodeID> node_ids(locations.begin(), locations.end());
 
   // We should only reach here if we have valid locality data to return.
   absl::optional<LocalityData> locality_data(
-      {static_cast<uint64_t>(object_size), node_ids});
+      {static_cast<uint64_t>(object_size), std::move(node_ids)});
   return locality_data;
 }
 
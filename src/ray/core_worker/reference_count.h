@@ -17,8 +17,10 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/id.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/core_worker/lease_policy.h"
 #include "ray/pubsub/publisher.h"
 #include "ray/pubsub/subscriber.h"
@@ -26,6 +28,8 @@
 #include "ray/rpc/worker/core_worker_client.h"
 #include "ray/rpc/worker/core_worker_client_pool.h"
 #include "ray/util/logging.h"
+#include "ray/util/slab_allocator.h"
+#include "ray/util/small_set.h"
 #include "src/ray/protobuf/common.pb.h"
 
 namespace ray {
@@ -77,6 +81,11 @@ class ReferenceCounter : public ReferenceCounterInterface,
       : rpc_address_(rpc_address),
         lineage_pinning_enabled_(lineage_pinning_enabled),
         borrower_pool_(client_factory),
+        object_id_refs_(/*bucket_count=*/0,
+                        ReferenceTable::hasher(),
+                        ReferenceTable::key_equal(),
+                        ReferenceTable::allocator_type(std::make_shared<SlabArena>(
+                            sizeof(ReferenceTable::value_type)))),
         object_info_publisher_(object_info_publisher),
         object_info_subscriber_(object_info_subscriber),
         check_node_alive_(check_node_alive) {}
@@ -155,7 +164,36 @@ class ReferenceCounter : public ReferenceCounterInterface,
                                     const rpc::Address &worker_addr,
                                     const ReferenceTableProto &borrowed_refs,
                                     std::vector<ObjectID> *deleted)
-      LOCKS_EXCLUDED(mutex_);
+      LOCKS_EXCLUDED(mutex_) {
+    UpdateFinishedTaskReferences(return_ids,
+                                 argument_ids,
+                                 release_lineage,
+                                 worker_addr,
+                                 borrowed_refs,
+                                 rpc::CompactObjectReferenceCounts::default_instance(),
+                                 deleted);
+  }
+
+  /// Same as above, for a worker that returned some of the references it borrowed
+  /// in the compact encoding.
+  ///
+  /// \param[in] compact_borrowed_refs The rest of the references that the worker
+  /// borrowed during the task.
+  void UpdateFinishedTaskReferences(
+      const std::vector<ObjectID> return_ids,
+      const std::vector<ObjectID> &argument_ids,
+      bool release_lineage,
+      const rpc::Address &worker_addr,
+      const ReferenceTableProto &borrowed_refs,
+      const rpc::CompactObjectReferenceCounts &compact_borrowed_refs,
+      std::vector<ObjectID> *deleted) LOCKS_EXCLUDED(mutex_);
+
+  /// Move a table of references into the compact encoding.
+  ///
+  /// \param[in, out] refs The references, which are cleared.
+  /// \param[out] compact The compact encoding of the references.
+  static void CompactReferenceTableProto(ReferenceTableProto *refs,
+                                         rpc::CompactObjectReferenceCounts *compact);
 
   /// Add an object that we own. The object may depend on other objects.
   /// Dependencies for each ObjectID must be set at most once. The local
@@ -494,19 +532,19 @@ class ReferenceCounter : public ReferenceCounterInterface,
     ///  1. We call ray.put() and store the inner ID(s) in the outer object.
     ///  2. A task that we submitted returned an ID(s).
     /// ObjectIDs are erased from this field when their Reference is deleted.
-    absl::flat_hash_set<ObjectID> contained_in_owned;
+    small_set<ObjectID> contained_in_owned;
     /// Object IDs that we borrowed and that contain this object ID.
     /// ObjectIDs are added to this field when we get the value of an ObjectRef
     /// (either by deserializing the object or receiving the GetObjectStatus
     /// reply for inlined objects) and it contains another ObjectRef.
-    absl::flat_hash_set<ObjectID> contained_in_borrowed_ids;
+    small_set<ObjectID> contained_in_borrowed_ids;
     /// Reverse pointer for contained_in_owned and contained_in_borrowed_ids.
     /// The object IDs contained in this object. These could be objects that we
     /// own or are borrowing. This field is updated in 2 cases:
     ///  1. We call ray.put() on this ID and store the contained IDs.
     ///  2. We call ray.get() on an ID whose contents we do not know and we
     ///     discover that it contains these IDs.
-    absl::flat_hash_set<ObjectID> contains;
+    small_set<ObjectID> contains;
   };
 
   /// Contains information related to borrowing only.
@@ -648,7 +686,7 @@ class ReferenceCounter : public ReferenceCounterInterface,
     int64_t object_size = -1;
     /// If this object is owned by us and stored in plasma, this contains all
     /// object locations.
-    absl::flat_hash_set<NodeID> locations;
+    small_set<NodeID> locations;
     /// The object's owner's address, if we know it. If this process is the
     /// owner, then this is added during creation of the Reference. If this is
     /// process is a borrower, the borrower must add the owner's address before
@@ -722,7 +760,15 @@ class ReferenceCounter : public ReferenceCounterInterface,
     bool pending_creation = false;
   };
 
-  using ReferenceTable = absl::flat_hash_map<ObjectID, Reference>;
+  /// References are allocated one by one from a slab arena, so that the table only
+  /// stores a pointer per slot, and rehashing a table of millions of references doesn't
+  /// move them.
+  using ReferenceTable =
+      absl::node_hash_map<ObjectID,
+                          Reference,
+                          absl::Hash<ObjectID>,
+                          std::equal_to<ObjectID>,
+                          SlabAllocator<std::pair<const ObjectID, Reference>>>;
   using ReferenceProtoTable = absl::flat_hash_map<ObjectID, rpc::ObjectReferenceCount>;
 
   void SetNestedRefInUseRecursive(ReferenceTable::iterator inner_ref_it)
@@ -743,6 +789,11 @@ class ReferenceCounter : public ReferenceCounterInterface,
   /// Deserialize a ReferenceTable.
   static ReferenceTable ReferenceTableFromProto(const ReferenceTableProto &proto);
 
+  /// Deserialize the compact encoding of references into a ReferenceTable. Every
+  /// address is only parsed once.
+  static void ReferenceTableFromCompactProto(
+      const rpc::CompactObjectReferenceCounts &proto, ReferenceTable *refs);
+
   /// Packs an object ID to ObjectReferenceCount map, into an array of
   /// ObjectReferenceCount. Consumes the input proto table.
   static void ReferenceTableToProto(ReferenceProtoTable &table,
@@ -921,6 +972,7 @@ class ReferenceCounter : public ReferenceCounterInterface,
 
   /// Protects access to the reference counting state.
   mutable absl::Mutex mutex_;
+  TrackedMutexName mutex_name_{&mutex_, "ReferenceCounter::mutex_"};
 
   /// Holds all reference counts and dependency information for tracked ObjectIDs.
   ReferenceTable object_id_refs_ GUARDED_BY(mutex_);
@@ -0,0 +1,143 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "benchmark/benchmark.h"
+#include "gmock/gmock.h"
+#include "ray/core_worker/reference_count.h"
+#include "ray/pubsub/mock_pubsub.h"
+
+namespace ray {
+namespace core {
+
+namespace {
+
+/// A reference counter as the owner of the objects sees it, without any borrowers.
+class ReferenceCounterFixture {
+ public:
+  explicit ReferenceCounterFixture(bool lineage_pinning_enabled)
+      : reference_counter_(
+            rpc::WorkerAddress(rpc::Address()),
+            &publisher_,
+            &subscriber_,
+            [](const NodeID &node_id) { return true; },
+            lineage_pinning_enabled) {}
+
+  ReferenceCounter &Get() { return reference_counter_; }
+
+ private:
+  testing::NiceMock<mock_pubsub::MockPublisher> publisher_;
+  testing::NiceMock<mock_pubsub::MockSubscriber> subscriber_;
+  ReferenceCounter reference_counter_;
+};
+
+std::vector<ObjectID> CreateReturnIDs(int num_tasks) {
+  std::vector<ObjectID> ids;
+  ids.reserve(num_tasks);
+  const auto job_id = JobID::FromInt(1);
+  for (int i = 0; i < num_tasks; i++) {
+    ids.push_back(ObjectID::FromIndex(TaskID::FromRandom(job_id), 1));
+  }
+  return ids;
+}
+
+/// Many small objects that are created, referenced once and released.
+void BM_OwnedObjectLifecycle(benchmark::State &state) {
+  ReferenceCounterFixture fixture(/*lineage_pinning_enabled=*/false);
+  auto &reference_counter = fixture.Get();
+  const auto ids = CreateReturnIDs(state.range(0));
+  std::vector<ObjectID> deleted;
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      reference_counter.AddOwnedObject(id,
+                                       /*contained_ids=*/{},
+                                       rpc::Address(),
+                                       /*call_site=*/"",
+                                       /*object_size=*/100,
+                                       /*is_reconstructable=*/false,
+                                       /*add_local_ref=*/true);
+    }
+    for (const auto &id : ids) {
+      reference_counter.RemoveLocalReference(id, &deleted);
+    }
+    deleted.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_OwnedObjectLifecycle)->Arg(1 << 10)->Arg(1 << 16);
+
+/// A chain of tasks that each depend on the return of the previous one, with lineage
+/// pinning, so that releasing the last return releases the whole lineage.
+void BM_DeepLineage(benchmark::State &state) {
+  ReferenceCounterFixture fixture(/*lineage_pinning_enabled=*/true);
+  auto &reference_counter = fixture.Get();
+  const auto ids = CreateReturnIDs(state.range(0));
+  absl::flat_hash_map<ObjectID, ObjectID> argument_of;
+  for (size_t i = 1; i < ids.size(); i++) {
+    argument_of.emplace(ids[i], ids[i - 1]);
+  }
+  reference_counter.SetReleaseLineageCallback(
+      [&argument_of](const ObjectID &object_id, std::vector<ObjectID> *argument_ids) {
+        auto it = argument_of.find(object_id);
+        if (it != argument_of.end()) {
+          argument_ids->push_back(it->second);
+        }
+        return int64_t{0};
+      });
+
+  std::vector<ObjectID> deleted;
+  for (auto _ : state) {
+    for (size_t i = 0; i < ids.size(); i++) {
+      reference_counter.AddOwnedObject(ids[i],
+                                       /*contained_ids=*/{},
+                                       rpc::Address(),
+                                       /*call_site=*/"",
+                                       /*object_size=*/100,
+                                       /*is_reconstructable=*/true,
+                                       /*add_local_ref=*/true);
+      std::vector<ObjectID> arguments;
+      if (i > 0) {
+        arguments.push_back(ids[i - 1]);
+      }
+      reference_counter.UpdateSubmittedTaskReferences({ids[i]}, arguments);
+      if (i > 0) {
+        // Only the last return stays in scope.
+        reference_counter.RemoveLocalReference(ids[i - 1], &deleted);
+      }
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+      std::vector<ObjectID> arguments;
+      if (i > 0) {
+        arguments.push_back(ids[i - 1]);
+      }
+      reference_counter.UpdateFinishedTaskReferences({ids[i]},
+                                                     arguments,
+                                                     /*release_lineage=*/false,
+                                                     rpc::Address(),
+                                                     ReferenceCounter::ReferenceTableProto(),
+                                                     &deleted);
+    }
+    reference_counter.RemoveLocalReference(ids.back(), &deleted);
+    deleted.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_DeepLineage)->Arg(1 << 10)->Arg(1 << 14);
+
+}  // namespace
+
+}  // namespace core
+}  // namespace ray
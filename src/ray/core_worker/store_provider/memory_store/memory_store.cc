@@ -140,7 +140,8 @@ std::shared_ptr<RayObject> GetRequest::Get(const ObjectID &object_id) const {
   std::unique_lock<std::mutex> lock(mutex_);
   auto iter = objects_.find(object_id);
   if (iter != objects_.end()) {
-    iter->second->SetAccessed();
+    // NOTE: The object was already marked as accessed by `Set`, under the lock of its
+    // memory store shard.
     return iter->second;
   }
 
@@ -153,23 +154,47 @@ CoreWorkerMemoryStore::CoreWorkerMemoryStore(
     std::function<Status()> check_signals,
     std::function<void(const RayObject &)> unhandled_exception_handler,
     std::function<std::shared_ptr<ray::RayObject>(
-        const ray::RayObject &object, const ObjectID &object_id)> object_allocator)
+        const ray::RayObject &object, const ObjectID &object_id)> object_allocator,
+    std::function<bool(const RayObject &object, const ObjectID &object_id)>
+        promote_to_plasma)
     : ref_counter_(std::move(counter)),
       raylet_client_(raylet_client),
       check_signals_(check_signals),
       unhandled_exception_handler_(unhandled_exception_handler),
-      object_allocator_(std::move(object_allocator)) {}
+      object_allocator_(std::move(object_allocator)),
+      promote_to_plasma_(std::move(promote_to_plasma)),
+      max_bytes_(promote_to_plasma_ != nullptr
+                     ? std::max<int64_t>(RayConfig::instance().memory_store_max_bytes(), 0)
+                     : 0) {
+  const size_t num_shards =
+      std::max<uint64_t>(RayConfig::instance().memory_store_num_shards(), 1);
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; i++) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+std::shared_ptr<RayObject> CoreWorkerMemoryStore::GetIfAccessed(
+    Shard &shard, const ObjectID &object_id) {
+  absl::ReaderMutexLock lock(&shard.mu);
+  auto iter = shard.objects.find(object_id);
+  if (iter != shard.objects.end() && iter->second->WasAccessed()) {
+    return iter->second;
+  }
+  return nullptr;
+}
 
 void CoreWorkerMemoryStore::GetAsync(
     const ObjectID &object_id, std::function<void(std::shared_ptr<RayObject>)> callback) {
-  std::shared_ptr<RayObject> ptr;
-  {
-    absl::MutexLock lock(&mu_);
-    auto iter = objects_.find(object_id);
-    if (iter != objects_.end()) {
+  auto &shard = GetShard(object_id);
+  std::shared_ptr<RayObject> ptr = GetIfAccessed(shard, object_id);
+  if (ptr == nullptr) {
+    absl::MutexLock lock(&shard.mu);
+    auto iter = shard.objects.find(object_id);
+    if (iter != shard.objects.end()) {
       ptr = iter->second;
     } else {
-      object_async_get_requests_[object_id].push_back(callback);
+      shard.object_async_get_requests[object_id].push_back(callback);
     }
     if (ptr != nullptr) {
       ptr->SetAccessed();
@@ -182,11 +207,12 @@ void CoreWorkerMemoryStore::GetAsync(
 }
 
 std::shared_ptr<RayObject> CoreWorkerMemoryStore::GetIfExists(const ObjectID &object_id) {
-  std::shared_ptr<RayObject> ptr;
-  {
-    absl::MutexLock lock(&mu_);
-    auto iter = objects_.find(object_id);
-    if (iter != objects_.end()) {
+  auto &shard = GetShard(object_id);
+  std::shared_ptr<RayObject> ptr = GetIfAccessed(shard, object_id);
+  if (ptr == nullptr) {
+    absl::MutexLock lock(&shard.mu);
+    auto iter = shard.objects.find(object_id);
+    if (iter != shard.objects.end()) {
       ptr = iter->second;
     }
     if (ptr != nullptr) {
@@ -211,23 +237,24 @@ bool CoreWorkerMemoryStore::Put(const RayObject &object, const ObjectID &object_
   // TODO(edoakes): we should instead return a flag to the caller to put the object in
   // plasma.
   {
-    absl::MutexLock lock(&mu_);
+    auto &shard = GetShard(object_id);
+    absl::MutexLock lock(&shard.mu);
 
-    auto iter = objects_.find(object_id);
-    if (iter != objects_.end()) {
+    auto iter = shard.objects.find(object_id);
+    if (iter != shard.objects.end()) {
       return true;  // Object already exists in the store, which is fine.
     }
 
-    auto async_callback_it = object_async_get_requests_.find(object_id);
-    if (async_callback_it != object_async_get_requests_.end()) {
+    auto async_callback_it = shard.object_async_get_requests.find(object_id);
+    if (async_callback_it != shard.object_async_get_requests.end()) {
       auto &callbacks = async_callback_it->second;
       async_callbacks = std::move(callbacks);
-      object_async_get_requests_.erase(async_callback_it);
+      shard.object_async_get_requests.erase(async_callback_it);
     }
 
     bool should_add_entry = true;
-    auto object_request_iter = object_get_requests_.find(object_id);
-    if (object_request_iter != object_get_requests_.end()) {
+    auto object_request_iter = shard.object_get_requests.find(object_id);
+    if (object_request_iter != shard.object_get_requests.end()) {
       auto &get_requests = object_request_iter->second;
       for (auto &get_request : get_requests) {
         get_request->Set(object_id, object_entry);
@@ -244,7 +271,7 @@ bool CoreWorkerMemoryStore::Put(const RayObject &object, const ObjectID &object_
 
     if (should_add_entry) {
       // If there is no existing get request, then add the `RayObject` to map.
-      EmplaceObjectAndUpdateStats(object_id, object_entry);
+      EmplaceObjectAndUpdateStats(shard, object_id, object_entry);
     } else {
       // It is equivalent to the object being added and immediately deleted from the
       // store.
@@ -261,9 +288,56 @@ bool CoreWorkerMemoryStore::Put(const RayObject &object, const ObjectID &object_
     cb(object_entry);
   }
 
+  if (max_bytes_ > 0 && used_bytes_ > max_bytes_) {
+    PromoteToPlasmaIfOverBudget();
+  }
+
   return stored_in_direct_memory;
 }
 
+void CoreWorkerMemoryStore::PromoteToPlasmaIfOverBudget() {
+  if (promoting_.exchange(true)) {
+    // Another thread is already promoting objects.
+    return;
+  }
+  size_t num_empty_shards = 0;
+  while (used_bytes_ > max_bytes_ && num_empty_shards < shards_.size()) {
+    auto &shard = *shards_[next_promotion_shard_++ % shards_.size()];
+    ObjectID object_id;
+    std::shared_ptr<RayObject> object;
+    {
+      absl::MutexLock lock(&shard.mu);
+      if (shard.promotion_candidates.empty()) {
+        num_empty_shards++;
+        continue;
+      }
+      num_empty_shards = 0;
+      object_id = shard.promotion_candidates.front();
+      shard.promotion_candidates.pop_front();
+      shard.promotion_candidate_index.erase(object_id);
+      auto it = shard.objects.find(object_id);
+      RAY_CHECK(it != shard.objects.end());
+      object = it->second;
+    }
+    // Copy the object outside the lock, since it talks to the plasma store. If the
+    // object can't be promoted, it stays in memory.
+    if (!promote_to_plasma_(*object, object_id)) {
+      continue;
+    }
+    RAY_LOG(DEBUG) << "Promoted object " << object_id
+                   << " to plasma, since the memory store is over its budget";
+    absl::MutexLock lock(&shard.mu);
+    auto it = shard.objects.find(object_id);
+    // Skip the object if it was deleted in the meantime.
+    if (it != shard.objects.end() && it->second == object) {
+      EraseObjectAndUpdateStats(shard, object_id);
+      auto in_plasma = std::make_shared<RayObject>(rpc::ErrorType::OBJECT_IN_PLASMA);
+      EmplaceObjectAndUpdateStats(shard, object_id, in_plasma);
+    }
+  }
+  promoting_ = false;
+}
+
 Status CoreWorkerMemoryStore::Get(const std::vector<ObjectID> &object_ids,
                                   int num_objects,
                                   int64_t timeout_ms,
@@ -290,24 +364,48 @@ Status CoreWorkerMemoryStore::GetImpl(const std::vector<ObjectID> &object_ids,
 
   std::shared_ptr<GetRequest> get_request;
   int count = 0;
+  // Clean up the objects if ref counting is off.
+  const bool remove_objects = remove_after_get && ref_counter_ == nullptr;
 
   {
     absl::flat_hash_set<ObjectID> remaining_ids;
-    absl::flat_hash_set<ObjectID> ids_to_remove;
+    // The objects that were removed from the store by this call. Note that
+    // `object_ids` might have duplicate ids.
+    absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> removed_objects;
 
-    absl::MutexLock lock(&mu_);
     // Check for existing objects and see if this get request can be fullfilled.
     for (size_t i = 0; i < object_ids.size() && count < num_objects; i++) {
       const auto &object_id = object_ids[i];
-      auto iter = objects_.find(object_id);
-      if (iter != objects_.end()) {
-        iter->second->SetAccessed();
-        (*results)[i] = iter->second;
-        if (remove_after_get) {
-          // Note that we cannot remove the object_id from `objects_` now,
-          // because `object_ids` might have duplicate ids.
-          ids_to_remove.insert(object_id);
+      auto &shard = GetShard(object_id);
+      std::shared_ptr<RayObject> object;
+      if (remove_objects) {
+        auto removed_iter = removed_objects.find(object_id);
+        if (removed_iter != removed_objects.end()) {
+          object = removed_iter->second;
+        } else {
+          absl::MutexLock lock(&shard.mu);
+          auto iter = shard.objects.find(object_id);
+          if (iter != shard.objects.end()) {
+            object = iter->second;
+            object->SetAccessed();
+            removed_objects.emplace(object_id, object);
+            EraseObjectAndUpdateStats(shard, object_id);
+          }
+        }
+      } else {
+        object = GetIfAccessed(shard, object_id);
+        if (object == nullptr) {
+          absl::MutexLock lock(&shard.mu);
+          auto iter = shard.objects.find(object_id);
+          if (iter != shard.objects.end()) {
+            object = iter->second;
+            object->SetAccessed();
+          }
         }
+      }
+
+      if (object != nullptr) {
+        (*results)[i] = std::move(object);
         count += 1;
       } else {
         remaining_ids.insert(object_id);
@@ -315,13 +413,6 @@ Status CoreWorkerMemoryStore::GetImpl(const std::vector<ObjectID> &object_ids,
     }
     RAY_CHECK(count <= num_objects);
 
-    // Clean up the objects if ref counting is off.
-    if (ref_counter_ == nullptr) {
-      for (const auto &object_id : ids_to_remove) {
-        EraseObjectAndUpdateStats(object_id);
-      }
-    }
-
     // Return if all the objects are obtained.
     if (remaining_ids.empty() || count >= num_objects) {
       return Status::OK();
@@ -335,7 +426,19 @@ Status CoreWorkerMemoryStore::GetImpl(const std::vector<ObjectID> &object_ids,
                                                remove_after_get,
                                                abort_if_any_object_is_exception);
     for (const auto &object_id : get_request->ObjectIds()) {
-      object_get_requests_[object_id].push_back(get_request);
+      auto &shard = GetShard(object_id);
+      absl::MutexLock lock(&shard.mu);
+      // The object may have been put since the check above, because the shards are
+      // not locked together.
+      auto iter = shard.objects.find(object_id);
+      if (iter == shard.objects.end()) {
+        shard.object_get_requests[object_id].push_back(get_request);
+        continue;
+      }
+      get_request->Set(object_id, iter->second);
+      if (remove_objects && get_request->Get(object_id) != nullptr) {
+        EraseObjectAndUpdateStats(shard, object_id);
+      }
     }
   }
 
@@ -379,29 +482,28 @@ Status CoreWorkerMemoryStore::GetImpl(const std::vector<ObjectID> &object_ids,
     RAY_CHECK_OK(raylet_client_->NotifyDirectCallTaskUnblocked());
   }
 
-  {
-    absl::MutexLock lock(&mu_);
-    // Populate results.
-    for (size_t i = 0; i < object_ids.size(); i++) {
-      const auto &object_id = object_ids[i];
-      if ((*results)[i] == nullptr) {
-        (*results)[i] = get_request->Get(object_id);
-      }
+  // Populate results.
+  for (size_t i = 0; i < object_ids.size(); i++) {
+    const auto &object_id = object_ids[i];
+    if ((*results)[i] == nullptr) {
+      (*results)[i] = get_request->Get(object_id);
     }
+  }
 
-    // Remove get request.
-    for (const auto &object_id : get_request->ObjectIds()) {
-      auto object_request_iter = object_get_requests_.find(object_id);
-      if (object_request_iter != object_get_requests_.end()) {
-        auto &get_requests = object_request_iter->second;
-        // Erase get_request from the vector.
-        auto it = std::find(get_requests.begin(), get_requests.end(), get_request);
-        if (it != get_requests.end()) {
-          get_requests.erase(it);
-          // If the vector is empty, remove the object ID from the map.
-          if (get_requests.empty()) {
-            object_get_requests_.erase(object_request_iter);
-          }
+  // Remove get request.
+  for (const auto &object_id : get_request->ObjectIds()) {
+    auto &shard = GetShard(object_id);
+    absl::MutexLock lock(&shard.mu);
+    auto object_request_iter = shard.object_get_requests.find(object_id);
+    if (object_request_iter != shard.object_get_requests.end()) {
+      auto &get_requests = object_request_iter->second;
+      // Erase get_request from the vector.
+      auto it = std::find(get_requests.begin(), get_requests.end(), get_request);
+      if (it != get_requests.end()) {
+        get_requests.erase(it);
+        // If the vector is empty, remove the object ID from the map.
+        if (get_requests.empty()) {
+          shard.object_get_requests.erase(object_request_iter);
         }
       }
     }
@@ -476,35 +578,38 @@ Status CoreWorkerMemoryStore::Wait(const absl::flat_hash_set<ObjectID> &object_i
 
 void CoreWorkerMemoryStore::Delete(const absl::flat_hash_set<ObjectID> &object_ids,
                                    absl::flat_hash_set<ObjectID> *plasma_ids_to_delete) {
-  absl::MutexLock lock(&mu_);
   for (const auto &object_id : object_ids) {
-    auto it = objects_.find(object_id);
-    if (it != objects_.end()) {
+    auto &shard = GetShard(object_id);
+    absl::MutexLock lock(&shard.mu);
+    auto it = shard.objects.find(object_id);
+    if (it != shard.objects.end()) {
       if (it->second->IsInPlasmaError()) {
         plasma_ids_to_delete->insert(object_id);
       } else {
         OnDelete(it->second);
-        EraseObjectAndUpdateStats(object_id);
+        EraseObjectAndUpdateStats(shard, object_id);
       }
     }
   }
 }
 
 void CoreWorkerMemoryStore::Delete(const std::vector<ObjectID> &object_ids) {
-  absl::MutexLock lock(&mu_);
   for (const auto &object_id : object_ids) {
-    auto it = objects_.find(object_id);
-    if (it != objects_.end()) {
+    auto &shard = GetShard(object_id);
+    absl::MutexLock lock(&shard.mu);
+    auto it = shard.objects.find(object_id);
+    if (it != shard.objects.end()) {
       OnDelete(it->second);
-      EraseObjectAndUpdateStats(object_id);
+      EraseObjectAndUpdateStats(shard, object_id);
     }
   }
 }
 
 bool CoreWorkerMemoryStore::Contains(const ObjectID &object_id, bool *in_plasma) {
-  absl::MutexLock lock(&mu_);
-  auto it = objects_.find(object_id);
-  if (it != objects_.end()) {
+  auto &shard = GetShard(object_id);
+  absl::ReaderMutexLock lock(&shard.mu);
+  auto it = shard.objects.find(object_id);
+  if (it != shard.objects.end()) {
     if (it->second->IsInPlasmaError()) {
       *in_plasma = true;
     }
@@ -513,6 +618,15 @@ bool CoreWorkerMemoryStore::Contains(const ObjectID &object_id, bool *in_plasma)
   return false;
 }
 
+int CoreWorkerMemoryStore::Size() {
+  int size = 0;
+  for (const auto &shard : shards_) {
+    absl::ReaderMutexLock lock(&shard->mu);
+    size += shard->objects.size();
+  }
+  return size;
+}
+
 inline bool IsUnhandledError(const std::shared_ptr<RayObject> &obj) {
   rpc::ErrorType error_type;
   // TODO(ekl) note that this doesn't warn on errors that are stored in plasma.
@@ -530,60 +644,82 @@ void CoreWorkerMemoryStore::OnDelete(std::shared_ptr<RayObject> obj) {
 }
 
 void CoreWorkerMemoryStore::NotifyUnhandledErrors() {
-  absl::MutexLock lock(&mu_);
   int64_t threshold = absl::GetCurrentTimeNanos() - kUnhandledErrorGracePeriodNanos;
-  auto it = objects_.begin();
   int count = 0;
-  while (it != objects_.end() && count < kMaxUnhandledErrorScanItems) {
-    const auto &obj = it->second;
-    if (IsUnhandledError(obj) && obj->CreationTimeNanos() < threshold &&
-        unhandled_exception_handler_ != nullptr) {
-      obj->SetAccessed();
-      unhandled_exception_handler_(*obj);
+  for (const auto &shard : shards_) {
+    absl::MutexLock lock(&shard->mu);
+    auto it = shard->objects.begin();
+    while (it != shard->objects.end() && count < kMaxUnhandledErrorScanItems) {
+      const auto &obj = it->second;
+      if (IsUnhandledError(obj) && obj->CreationTimeNanos() < threshold &&
+          unhandled_exception_handler_ != nullptr) {
+        obj->SetAccessed();
+        unhandled_exception_handler_(*obj);
+      }
+      it++;
+      count++;
+    }
+    if (count >= kMaxUnhandledErrorScanItems) {
+      break;
     }
-    it++;
-    count++;
   }
 }
 
-inline void CoreWorkerMemoryStore::EraseObjectAndUpdateStats(const ObjectID &object_id) {
-  auto it = objects_.find(object_id);
-  if (it == objects_.end()) {
+inline void CoreWorkerMemoryStore::EraseObjectAndUpdateStats(Shard &shard,
+                                                             const ObjectID &object_id) {
+  auto it = shard.objects.find(object_id);
+  if (it == shard.objects.end()) {
     return;
   }
 
   if (it->second->IsInPlasmaError()) {
-    num_in_plasma_ -= 1;
+    shard.num_in_plasma -= 1;
   } else {
-    num_local_objects_ -= 1;
-    used_object_store_memory_ -= it->second->GetSize();
+    shard.num_local_objects -= 1;
+    shard.used_object_store_memory -= it->second->GetSize();
+    used_bytes_ -= it->second->GetSize();
+    auto candidate_it = shard.promotion_candidate_index.find(object_id);
+    if (candidate_it != shard.promotion_candidate_index.end()) {
+      shard.promotion_candidates.erase(candidate_it->second);
+      shard.promotion_candidate_index.erase(candidate_it);
+    }
   }
-  RAY_CHECK(num_in_plasma_ >= 0 && num_local_objects_ >= 0 &&
-            used_object_store_memory_ >= 0);
-  objects_.erase(it);
+  RAY_CHECK(shard.num_in_plasma >= 0 && shard.num_local_objects >= 0 &&
+            shard.used_object_store_memory >= 0);
+  shard.objects.erase(it);
 }
 
 inline void CoreWorkerMemoryStore::EmplaceObjectAndUpdateStats(
-    const ObjectID &object_id, std::shared_ptr<RayObject> &object_entry) {
-  auto inserted = objects_.emplace(object_id, object_entry).second;
+    Shard &shard, const ObjectID &object_id, std::shared_ptr<RayObject> &object_entry) {
+  auto inserted = shard.objects.emplace(object_id, object_entry).second;
   if (inserted) {
     if (object_entry->IsInPlasmaError()) {
-      num_in_plasma_ += 1;
+      shard.num_in_plasma += 1;
     } else {
-      num_local_objects_ += 1;
-      used_object_store_memory_ += object_entry->GetSize();
+      shard.num_local_objects += 1;
+      shard.used_object_store_memory += object_entry->GetSize();
+      used_bytes_ += object_entry->GetSize();
+      // Errors are small and are not worth promoting.
+      if (max_bytes_ > 0 && !object_entry->IsException()) {
+        shard.promotion_candidate_index.emplace(
+            object_id,
+            shard.promotion_candidates.insert(shard.promotion_candidates.end(),
+                                              object_id));
+      }
     }
   }
-  RAY_CHECK(num_in_plasma_ >= 0 && num_local_objects_ >= 0 &&
-            used_object_store_memory_ >= 0);
+  RAY_CHECK(shard.num_in_plasma >= 0 && shard.num_local_objects >= 0 &&
+            shard.used_object_store_memory >= 0);
 }
 
 MemoryStoreStats CoreWorkerMemoryStore::GetMemoryStoreStatisticalData() {
-  absl::MutexLock lock(&mu_);
   MemoryStoreStats item;
-  item.num_in_plasma = num_in_plasma_;
-  item.num_local_objects = num_local_objects_;
-  item.used_object_store_memory = used_object_store_memory_;
+  for (const auto &shard : shards_) {
+    absl::ReaderMutexLock lock(&shard->mu);
+    item.num_in_plasma += shard->num_in_plasma;
+    item.num_local_objects += shard->num_local_objects;
+    item.used_object_store_memory += shard->used_object_store_memory;
+  }
   return item;
 }
 
@@ -16,10 +16,14 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
+#include <list>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/id.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/common/status.h"
 #include "ray/core_worker/common.h"
 #include "ray/core_worker/context.h"
@@ -40,6 +44,15 @@ class CoreWorkerMemoryStore;
 /// The class provides implementations for local process memory store.
 /// An example usage for this is to retrieve the returned objects from direct
 /// actor call (see direct_actor_transport.cc).
+///
+/// Objects are partitioned into `memory_store_num_shards` shards by object ID hash,
+/// so that threads of a threaded actor only contend when they access objects of the
+/// same shard.
+///
+/// If `memory_store_max_bytes` is set and a promotion callback is given, the oldest
+/// objects are promoted to plasma when the objects in the store take more memory than
+/// that, so that a worker that accumulates many small objects doesn't run out of
+/// memory. Promoted objects are replaced by an `OBJECT_IN_PLASMA` marker.
 class CoreWorkerMemoryStore {
  public:
   /// Create a memory store.
@@ -47,6 +60,9 @@ class CoreWorkerMemoryStore {
   /// \param[in] counter If not null, this enables ref counting for local objects,
   ///            and the `remove_after_get` flag for Get() will be ignored.
   /// \param[in] raylet_client If not null, used to notify tasks blocked / unblocked.
+  /// \param[in] promote_to_plasma If not null, used to copy an object to plasma when
+  ///            the store is over its memory budget. Returns whether the object was
+  ///            copied, in which case the store drops its own copy.
   CoreWorkerMemoryStore(
       std::shared_ptr<ReferenceCounter> counter = nullptr,
       std::shared_ptr<raylet::RayletClient> raylet_client = nullptr,
@@ -54,7 +70,9 @@ class CoreWorkerMemoryStore {
       std::function<void(const RayObject &)> unhandled_exception_handler = nullptr,
       std::function<std::shared_ptr<RayObject>(const RayObject &object,
                                                const ObjectID &object_id)>
-          object_allocator = nullptr);
+          object_allocator = nullptr,
+      std::function<bool(const RayObject &object, const ObjectID &object_id)>
+          promote_to_plasma = nullptr);
   ~CoreWorkerMemoryStore(){};
 
   /// Put an object with specified ID into object store.
@@ -142,10 +160,7 @@ class CoreWorkerMemoryStore {
   /// Returns the number of objects in this store.
   ///
   /// \return Count of objects in the store.
-  int Size() {
-    absl::MutexLock lock(&mu_);
-    return objects_.size();
-  }
+  int Size();
 
   /// Returns stats data of memory usage.
   ///
@@ -165,6 +180,8 @@ class CoreWorkerMemoryStore {
 
  private:
   FRIEND_TEST(TestMemoryStore, TestMemoryStoreStats);
+  FRIEND_TEST(TestMemoryStore, TestConcurrentPutAndGet);
+  FRIEND_TEST(TestMemoryStore, TestPromoteToPlasmaOverBudget);
 
   /// See the public version of `Get` for meaning of the other arguments.
   /// \param[in] abort_if_any_object_is_exception Whether we should abort if any object
@@ -180,14 +197,72 @@ class CoreWorkerMemoryStore {
   /// Called when an object is deleted from the store.
   void OnDelete(std::shared_ptr<RayObject> obj);
 
+  /// Promote the oldest objects to plasma until the objects in the store fit in the
+  /// memory budget, or there are no more objects to promote.
+  void PromoteToPlasmaIfOverBudget();
+
+  /// A partition of the store. Each object ID always maps to the same shard, so
+  /// operations on objects of different shards don't contend on the same lock.
+  struct Shard {
+    /// Protects the data structures below.
+    mutable absl::Mutex mu;
+    TrackedMutexName mu_name{&mu, "CoreWorkerMemoryStore::mu"};
+
+    /// Map from object ID to `RayObject`.
+    /// NOTE: This map should be modified by EmplaceObjectAndUpdateStats and
+    /// EraseObjectAndUpdateStats.
+    absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> objects GUARDED_BY(mu);
+
+    /// Map from object ID to its get requests.
+    absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<GetRequest>>>
+        object_get_requests GUARDED_BY(mu);
+
+    /// Map from object ID to its async get requests.
+    absl::flat_hash_map<ObjectID,
+                        std::vector<std::function<void(std::shared_ptr<RayObject>)>>>
+        object_async_get_requests GUARDED_BY(mu);
+
+    ///
+    /// Below information is stats of this shard. They are summed up over all shards
+    /// when the stats of the store are requested.
+    ///
+    /// Number of objects in the plasma store for this shard.
+    int32_t num_in_plasma GUARDED_BY(mu) = 0;
+    /// Number of objects that don't exist in the plasma store.
+    int32_t num_local_objects GUARDED_BY(mu) = 0;
+    /// Number of object store memory used by this shard. (It doesn't include plasma
+    /// store memory usage).
+    int64_t used_object_store_memory GUARDED_BY(mu) = 0;
+
+    /// The objects of this shard that may be promoted to plasma, oldest first. Only
+    /// maintained if the store has a memory budget.
+    std::list<ObjectID> promotion_candidates GUARDED_BY(mu);
+    absl::flat_hash_map<ObjectID, std::list<ObjectID>::iterator>
+        promotion_candidate_index GUARDED_BY(mu);
+  };
+
+  /// Return the shard that stores the given object.
+  Shard &GetShard(const ObjectID &object_id) {
+    return *shards_[object_id.Hash() % shards_.size()];
+  }
+
+  /// Return the object if it is in the store and was already accessed, using only a
+  /// reader lock of its shard. Otherwise return nullptr, and the caller must look the
+  /// object up again under the writer lock, since marking an object as accessed
+  /// modifies it.
+  std::shared_ptr<RayObject> GetIfAccessed(Shard &shard, const ObjectID &object_id)
+      LOCKS_EXCLUDED(shard.mu);
+
   /// Emplace the given object entry to the in-memory-store and update stats properly.
-  void EmplaceObjectAndUpdateStats(const ObjectID &object_id,
+  void EmplaceObjectAndUpdateStats(Shard &shard,
+                                   const ObjectID &object_id,
                                    std::shared_ptr<RayObject> &object_entry)
-      EXCLUSIVE_LOCKS_REQUIRED(mu_);
+      EXCLUSIVE_LOCKS_REQUIRED(shard.mu);
 
   /// Erase the object of the object id from the in memory store and update stats
   /// properly.
-  void EraseObjectAndUpdateStats(const ObjectID &object_id) EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void EraseObjectAndUpdateStats(Shard &shard, const ObjectID &object_id)
+      EXCLUSIVE_LOCKS_REQUIRED(shard.mu);
 
   /// If enabled, holds a reference to local worker ref counter. TODO(ekl) make this
   /// mandatory once Java is supported.
@@ -196,22 +271,9 @@ class CoreWorkerMemoryStore {
   // If set, this will be used to notify worker blocked / unblocked on get calls.
   std::shared_ptr<raylet::RayletClient> raylet_client_ = nullptr;
 
-  /// Protects the data structures below.
-  mutable absl::Mutex mu_;
-
-  /// Map from object ID to `RayObject`.
-  /// NOTE: This map should be modified by EmplaceObjectAndUpdateStats and
-  /// EraseObjectAndUpdateStats.
-  absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> objects_ GUARDED_BY(mu_);
-
-  /// Map from object ID to its get requests.
-  absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<GetRequest>>>
-      object_get_requests_ GUARDED_BY(mu_);
-
-  /// Map from object ID to its async get requests.
-  absl::flat_hash_map<ObjectID,
-                      std::vector<std::function<void(std::shared_ptr<RayObject>)>>>
-      object_async_get_requests_ GUARDED_BY(mu_);
+  /// The shards of the store, indexed by object ID hash. The number of shards is
+  /// fixed at construction time.
+  std::vector<std::unique_ptr<Shard>> shards_;
 
   /// Function passed in to be called to check for signals (e.g., Ctrl-C).
   std::function<Status()> check_signals_;
@@ -219,22 +281,29 @@ class CoreWorkerMemoryStore {
   /// Function called to report unhandled exceptions.
   std::function<void(const RayObject &)> unhandled_exception_handler_;
 
-  ///
-  /// Below information is stats.
-  ///
-  /// Number of objects in the plasma store for this memory store.
-  int32_t num_in_plasma_ GUARDED_BY(mu_) = 0;
-  /// Number of objects that don't exist in the plasma store.
-  int32_t num_local_objects_ GUARDED_BY(mu_) = 0;
-  /// Number of object store memory used by this memory store. (It doesn't include plasma
-  /// store memory usage).
-  int64_t used_object_store_memory_ GUARDED_BY(mu_) = 0;
-
   /// This lambda is used to allow language frontend to allocate the objects
   /// in the memory store.
   std::function<std::shared_ptr<RayObject>(const RayObject &object,
                                            const ObjectID &object_id)>
       object_allocator_;
+
+  /// Copies an object to plasma when the store is over its memory budget.
+  std::function<bool(const RayObject &object, const ObjectID &object_id)>
+      promote_to_plasma_;
+
+  /// The memory budget of the objects in the store, or 0 if unlimited.
+  const int64_t max_bytes_;
+
+  /// The memory used by the objects in all shards.
+  std::atomic<int64_t> used_bytes_ = 0;
+
+  /// Whether a thread is promoting objects to plasma. Only one thread promotes objects
+  /// at a time.
+  std::atomic<bool> promoting_ = false;
+
+  /// The shard to promote an object from next. Shards are visited in turn, so that the
+  /// objects promoted are roughly the oldest ones of the whole store.
+  std::atomic<size_t> next_promotion_shard_ = 0;
 };
 
 }  // namespace core
@@ -0,0 +1,110 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/core_worker/store_provider/memory_store/memory_store.h"
+
+namespace ray {
+namespace core {
+
+namespace {
+
+std::vector<ObjectID> CreateObjectIDs(int num_objects) {
+  std::vector<ObjectID> ids;
+  ids.reserve(num_objects);
+  const auto job_id = JobID::FromInt(1);
+  for (int i = 0; i < num_objects; i++) {
+    ids.push_back(ObjectID::FromIndex(TaskID::FromRandom(job_id), 1));
+  }
+  return ids;
+}
+
+/// A small object, like the return of a task that is inlined in the reply.
+RayObject CreateSmallObject() {
+  static uint8_t data[64] = {};
+  auto buffer = std::make_shared<LocalMemoryBuffer>(data, sizeof(data));
+  return RayObject(buffer, nullptr, std::vector<rpc::ObjectReference>());
+}
+
+/// Many small objects that are put, read once and deleted.
+void BM_PutGetDelete(benchmark::State &state) {
+  CoreWorkerMemoryStore store;
+  const auto ids = CreateObjectIDs(state.range(0));
+  const auto object = CreateSmallObject();
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      store.Put(object, id);
+    }
+    for (const auto &id : ids) {
+      benchmark::DoNotOptimize(store.GetIfExists(id));
+    }
+    store.Delete(ids);
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_PutGetDelete)->Arg(1 << 10)->Arg(1 << 16);
+
+/// Objects that are waited on before they are put, as the returns of submitted tasks
+/// are.
+void BM_GetAsyncThenPut(benchmark::State &state) {
+  CoreWorkerMemoryStore store;
+  const auto ids = CreateObjectIDs(state.range(0));
+  const auto object = CreateSmallObject();
+  int64_t num_callbacks = 0;
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      store.GetAsync(id, [&num_callbacks](std::shared_ptr<RayObject>) {
+        num_callbacks++;
+      });
+    }
+    for (const auto &id : ids) {
+      store.Put(object, id);
+    }
+    store.Delete(ids);
+  }
+  benchmark::DoNotOptimize(num_callbacks);
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_GetAsyncThenPut)->Arg(1 << 10)->Arg(1 << 16);
+
+/// Several threads that put and delete their own objects in the same store, as the
+/// task execution threads of an actor do.
+void BM_ConcurrentPut(benchmark::State &state) {
+  static CoreWorkerMemoryStore *store = nullptr;
+  if (state.thread_index() == 0) {
+    store = new CoreWorkerMemoryStore();
+  }
+  const auto ids = CreateObjectIDs(1 << 10);
+  const auto object = CreateSmallObject();
+  for (auto _ : state) {
+    for (const auto &id : ids) {
+      store->Put(object, id);
+    }
+    store->Delete(ids);
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+  if (state.thread_index() == 0) {
+    delete store;
+    store = nullptr;
+  }
+}
+BENCHMARK(BM_ConcurrentPut)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
+
+}  // namespace core
+}  // namespace ray
@@ -17,11 +17,21 @@
 #include "ray/common/ray_config.h"
 #include "ray/core_worker/context.h"
 #include "ray/core_worker/core_worker.h"
+#include "ray/util/memory.h"
 #include "src/ray/protobuf/gcs.pb.h"
 
 namespace ray {
 namespace core {
 
+namespace {
+
+/// Objects larger than this are copied into the object store on multiple threads.
+/// The sizes match those of the Python serializer.
+constexpr size_t kMemcopyThreshold = 1024 * 1024;
+constexpr uintptr_t kMemcopyBlockSize = 64;
+
+}  // namespace
+
 void BufferTracker::Record(const ObjectID &object_id,
                            TrackedBuffer *buffer,
                            const std::string &call_site) {
@@ -96,7 +106,16 @@ Status CoreWorkerPlasmaStoreProvider::Put(const RayObject &object,
   // not throw an error.
   if (data != nullptr) {
     if (object.HasData()) {
-      memcpy(data->Data(), object.GetData()->Data(), object.GetData()->Size());
+      const int memcopy_threads = RayConfig::instance().worker_put_memcopy_threads();
+      if (memcopy_threads > 1 && object.GetData()->Size() > kMemcopyThreshold) {
+        parallel_memcopy(data->Data(),
+                         object.GetData()->Data(),
+                         object.GetData()->Size(),
+                         kMemcopyBlockSize,
+                         memcopy_threads);
+      } else {
+        memcpy(data->Data(), object.GetData()->Data(), object.GetData()->Size());
+      }
     }
     RAY_RETURN_NOT_OK(Seal(object_id));
     if (object_exists) {
@@ -157,10 +176,18 @@ Status CoreWorkerPlasmaStoreProvider::Seal(const ObjectID &object_id) {
   return store_client_.Seal(object_id);
 }
 
+Status CoreWorkerPlasmaStoreProvider::Seal(const std::vector<ObjectID> &object_ids) {
+  return store_client_.Seal(object_ids);
+}
+
 Status CoreWorkerPlasmaStoreProvider::Release(const ObjectID &object_id) {
   return store_client_.Release(object_id);
 }
 
+Status CoreWorkerPlasmaStoreProvider::Release(const std::vector<ObjectID> &object_ids) {
+  return store_client_.Release(object_ids);
+}
+
 Status CoreWorkerPlasmaStoreProvider::FetchAndGetFromPlasmaStore(
     absl::flat_hash_set<ObjectID> &remaining,
     const std::vector<ObjectID> &batch_ids,
@@ -137,6 +137,12 @@ class CoreWorkerPlasmaStoreProvider {
   /// argument to Get to retrieve the object data.
   Status Seal(const ObjectID &object_id);
 
+  /// Seal several object buffers created with Create(), with a single round trip to the
+  /// store. The same NOTE as for Seal() applies to each of the objects.
+  ///
+  /// \param[in] object_ids The IDs of the objects.
+  Status Seal(const std::vector<ObjectID> &object_ids);
+
   /// Release the first reference to the object created by Put() or Create(). This should
   /// be called exactly once per object and until it is called, the object is pinned and
   /// cannot be evicted.
@@ -145,6 +151,12 @@ class CoreWorkerPlasmaStoreProvider {
   /// argument to Get to retrieve the object data.
   Status Release(const ObjectID &object_id);
 
+  /// Release the first reference to several objects, with a single message to the
+  /// store.
+  ///
+  /// \param[in] object_ids The IDs of the objects.
+  Status Release(const std::vector<ObjectID> &object_ids);
+
   Status Get(const absl::flat_hash_set<ObjectID> &object_ids,
              int64_t timeout_ms,
              const WorkerContext &ctx,
@@ -0,0 +1,115 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/core_worker/task_latency_tracer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "absl/time/clock.h"
+#include "ray/stats/metric_defs.h"
+
+DEFINE_stats(task_stage_latency_ms,
+             "The latency of the stages of the sampled tasks, from the point of view of "
+             "their owners: {DependencyResolution, Scheduling, Execution, "
+             "ReturnStorage}.",
+             ("Stage"),
+             ({0.1, 1, 10, 100, 1000, 10000}, ),
+             ray::stats::HISTOGRAM);
+
+namespace ray {
+namespace core {
+
+namespace {
+
+constexpr uint64_t kSampleBuckets = 10000;
+
+/// The names of the stages that end at each TaskStage, for the metric.
+constexpr const char *kStageNames[] = {
+    "", "DependencyResolution", "Scheduling", "Execution", "ReturnStorage"};
+
+static_assert(sizeof(kStageNames) / sizeof(kStageNames[0]) ==
+                  static_cast<size_t>(TaskStage::NUM_STAGES),
+              "Every stage needs a name.");
+
+}  // namespace
+
+TaskLatencyTracer::TaskLatencyTracer(double sample_rate, size_t capacity)
+    : sample_threshold_(static_cast<uint64_t>(
+          std::lround(std::min(std::max(sample_rate, 0.0), 1.0) * kSampleBuckets))),
+      capacity_(capacity) {}
+
+bool TaskLatencyTracer::IsSampled(const TaskID &task_id) const {
+  return sample_threshold_ > 0 && capacity_ > 0 &&
+         task_id.Hash() % kSampleBuckets < sample_threshold_;
+}
+
+void TaskLatencyTracer::Record(const TaskID &task_id, TaskStage stage) {
+  if (!IsSampled(task_id)) {
+    return;
+  }
+  const int64_t now_ns = absl::GetCurrentTimeNanos();
+  absl::MutexLock lock(&mutex_);
+  auto it = active_traces_.find(task_id);
+  if (it == active_traces_.end()) {
+    if (stage != TaskStage::SUBMITTED || active_traces_.size() >= capacity_) {
+      return;
+    }
+    it = active_traces_.emplace(task_id, TaskTrace{task_id}).first;
+  }
+  it->second.stage_times_ns[static_cast<size_t>(stage)] = now_ns;
+  if (stage == TaskStage::RETURNS_STORED) {
+    Finish(it->second);
+    active_traces_.erase(it);
+  }
+}
+
+void TaskLatencyTracer::Discard(const TaskID &task_id) {
+  if (!IsSampled(task_id)) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  active_traces_.erase(task_id);
+}
+
+void TaskLatencyTracer::Finish(const TaskTrace &trace) {
+  for (size_t stage = 1; stage < trace.stage_times_ns.size(); stage++) {
+    const int64_t start_ns = trace.stage_times_ns[stage - 1];
+    const int64_t end_ns = trace.stage_times_ns[stage];
+    if (start_ns > 0 && end_ns >= start_ns) {
+      STATS_task_stage_latency_ms.Record((end_ns - start_ns) / 1e6, kStageNames[stage]);
+    }
+  }
+  if (finished_traces_.size() < capacity_) {
+    finished_traces_.push_back(trace);
+  } else {
+    finished_traces_[next_finished_index_] = trace;
+    next_finished_index_ = (next_finished_index_ + 1) % capacity_;
+  }
+}
+
+std::vector<TaskTrace> TaskLatencyTracer::GetRecentTraces() const {
+  absl::MutexLock lock(&mutex_);
+  std::vector<TaskTrace> traces;
+  traces.reserve(finished_traces_.size());
+  traces.insert(
+      traces.end(), finished_traces_.begin() + next_finished_index_, finished_traces_.end());
+  traces.insert(traces.end(),
+                finished_traces_.begin(),
+                finished_traces_.begin() + next_finished_index_);
+  return traces;
+}
+
+}  // namespace core
+}  // namespace ray
@@ -0,0 +1,99 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/id.h"
+
+namespace ray {
+namespace core {
+
+/// The stages of a task, as its owner sees them.
+enum class TaskStage : int {
+  /// The task was submitted.
+  SUBMITTED = 0,
+  /// The dependencies of the task were resolved, and it waits for a worker.
+  DEPENDENCIES_RESOLVED,
+  /// The task was pushed to a leased worker, or to its actor.
+  PUSHED,
+  /// The reply of the worker that executed the task was received.
+  FINISHED,
+  /// The returns of the task were stored.
+  RETURNS_STORED,
+  NUM_STAGES,
+};
+
+/// The times at which a task reached its stages, in nanoseconds since the epoch, by
+/// stage. 0 if the task didn't reach the stage.
+struct TaskTrace {
+  TaskID task_id;
+  std::array<int64_t, static_cast<size_t>(TaskStage::NUM_STAGES)> stage_times_ns{};
+};
+
+/// \class TaskLatencyTracer
+///
+/// Records when a sample of the tasks that a worker owns reach each of their stages,
+/// so that the latency of the tasks can be broken down by stage. The latency of every
+/// stage of a traced task is recorded to the task_stage_latency_ms metric once the
+/// task finishes, and the traces of the latest tasks are kept in a ring buffer.
+///
+/// Whether a task is sampled only depends on its ID, so the tasks that aren't sampled
+/// don't take the lock.
+///
+/// This class is thread safe.
+class TaskLatencyTracer {
+ public:
+  /// \param sample_rate The fraction of the tasks that are traced. 0 disables tracing.
+  /// \param capacity The number of finished traces that are kept. This is also the
+  /// maximum number of tasks that are traced at a time.
+  TaskLatencyTracer(double sample_rate, size_t capacity);
+
+  /// Record that a task reached a stage. A trace is started when a sampled task is
+  /// submitted, and finished once its returns are stored.
+  void Record(const TaskID &task_id, TaskStage stage) LOCKS_EXCLUDED(mutex_);
+
+  /// Stop tracing a task, e.g. because it failed.
+  void Discard(const TaskID &task_id) LOCKS_EXCLUDED(mutex_);
+
+  /// Get the traces of the latest finished tasks, from the oldest to the newest.
+  std::vector<TaskTrace> GetRecentTraces() const LOCKS_EXCLUDED(mutex_);
+
+ private:
+  bool IsSampled(const TaskID &task_id) const;
+
+  /// Record the latencies of the stages of a finished task, and keep its trace.
+  void Finish(const TaskTrace &trace) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// A task is sampled if the hash of its ID modulo kSampleBuckets is below this.
+  const uint64_t sample_threshold_;
+  const size_t capacity_;
+
+  mutable absl::Mutex mutex_;
+  /// The traces of the tasks that haven't finished yet.
+  absl::flat_hash_map<TaskID, TaskTrace> active_traces_ GUARDED_BY(mutex_);
+  /// A ring buffer of the traces of the finished tasks.
+  std::vector<TaskTrace> finished_traces_ GUARDED_BY(mutex_);
+  /// The index in finished_traces_ that the next finished trace is written to, once
+  /// the buffer is full.
+  size_t next_finished_index_ GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace core
+}  // namespace ray
@@ -17,6 +17,7 @@
 #include "ray/common/buffer.h"
 #include "ray/common/common_protocol.h"
 #include "ray/common/constants.h"
+#include "ray/common/ray_config.h"
 #include "ray/util/util.h"
 
 namespace ray {
@@ -33,6 +34,46 @@ std::vector<rpc::ObjectReference> TaskManager::AddPendingTask(
     const TaskSpecification &spec,
     const std::string &call_site,
     int max_retries) {
+  auto returned_refs = AddTaskReferences(caller_address, spec, call_site, max_retries);
+  {
+    absl::MutexLock lock(&mu_);
+    AddSubmissibleTask(caller_address, spec, call_site, max_retries);
+  }
+  task_latency_tracer_.Record(spec.TaskId(), TaskStage::SUBMITTED);
+
+  return returned_refs;
+}
+
+std::vector<std::vector<rpc::ObjectReference>> TaskManager::AddPendingTasks(
+    const rpc::Address &caller_address,
+    const std::vector<TaskSpecification> &specs,
+    const std::string &call_site,
+    int max_retries) {
+  std::vector<std::vector<rpc::ObjectReference>> returned_refs;
+  returned_refs.reserve(specs.size());
+  for (const auto &spec : specs) {
+    returned_refs.push_back(
+        AddTaskReferences(caller_address, spec, call_site, max_retries));
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    submissible_tasks_.reserve(submissible_tasks_.size() + specs.size());
+    for (const auto &spec : specs) {
+      AddSubmissibleTask(caller_address, spec, call_site, max_retries);
+    }
+  }
+  for (const auto &spec : specs) {
+    task_latency_tracer_.Record(spec.TaskId(), TaskStage::SUBMITTED);
+  }
+
+  return returned_refs;
+}
+
+std::vector<rpc::ObjectReference> TaskManager::AddTaskReferences(
+    const rpc::Address &caller_address,
+    const TaskSpecification &spec,
+    const std::string &call_site,
+    int max_retries) {
   RAY_LOG(DEBUG) << "Adding pending task " << spec.TaskId() << " with " << max_retries
                  << " retries";
 
@@ -94,16 +135,26 @@ std::vector<rpc::ObjectReference> TaskManager::AddPendingTask(
   }
 
   reference_counter_->UpdateSubmittedTaskReferences(return_ids, task_deps);
+  return returned_refs;
+}
 
-  {
-    absl::MutexLock lock(&mu_);
-    auto inserted = submissible_tasks_.emplace(spec.TaskId(),
-                                               TaskEntry(spec, max_retries, num_returns));
-    RAY_CHECK(inserted.second);
-    num_pending_tasks_++;
+void TaskManager::AddSubmissibleTask(const rpc::Address &caller_address,
+                                     const TaskSpecification &spec,
+                                     const std::string &call_site,
+                                     int max_retries) {
+  size_t num_returns = spec.NumReturns();
+  if (spec.IsActorTask()) {
+    num_returns--;
+  }
+  auto inserted = submissible_tasks_.emplace(spec.TaskId(),
+                                             TaskEntry(spec, max_retries, num_returns));
+  RAY_CHECK(inserted.second);
+  num_pending_tasks_++;
+  if (spec.StreamingReturns()) {
+    auto &stream = streaming_returns_[spec.TaskId()];
+    stream.caller_address = caller_address;
+    stream.call_site = call_site;
   }
-
-  return returned_refs;
 }
 
 bool TaskManager::ResubmitTask(const TaskID &task_id, std::vector<ObjectID> *task_deps) {
@@ -129,6 +180,7 @@ bool TaskManager::ResubmitTask(const TaskID &task_id, std::vector<ObjectID> *tas
       // to the footprint sum.
       total_lineage_footprint_bytes_ -= it->second.lineage_footprint_bytes;
       it->second.lineage_footprint_bytes = 0;
+      it->second.ExpandSpec();
 
       if (it->second.num_retries_left > 0) {
         it->second.num_retries_left--;
@@ -211,10 +263,145 @@ size_t TaskManager::NumPendingTasks() const {
   return num_pending_tasks_;
 }
 
+bool TaskManager::HandleTaskReturn(const ObjectID &object_id,
+                                   const rpc::ReturnObject &return_object,
+                                   const NodeID &worker_raylet_id,
+                                   bool store_in_plasma) {
+  bool direct_return = false;
+  reference_counter_->UpdateObjectSize(object_id, return_object.size());
+  RAY_LOG(DEBUG) << "Task return object " << object_id << " has size "
+                 << return_object.size();
+
+  const auto nested_refs =
+      VectorFromProtobuf<rpc::ObjectReference>(return_object.nested_inlined_refs());
+  if (return_object.in_plasma()) {
+    // Mark it as in plasma with a dummy object.
+    RAY_CHECK(
+        in_memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+    reference_counter_->UpdateObjectPinnedAtRaylet(object_id, worker_raylet_id);
+  } else {
+    // NOTE(swang): If a direct object was promoted to plasma, then we do not
+    // record the node ID that it was pinned at, which means that we will not
+    // be able to reconstruct it if the plasma object copy is lost. However,
+    // this is okay because the pinned copy is on the local node, so we will
+    // fate-share with the object if the local node fails.
+    std::shared_ptr<LocalMemoryBuffer> data_buffer;
+    if (return_object.data().size() > 0) {
+      data_buffer = std::make_shared<LocalMemoryBuffer>(
+          const_cast<uint8_t *>(
+              reinterpret_cast<const uint8_t *>(return_object.data().data())),
+          return_object.data().size());
+    }
+    std::shared_ptr<LocalMemoryBuffer> metadata_buffer;
+    if (return_object.metadata().size() > 0) {
+      metadata_buffer = std::make_shared<LocalMemoryBuffer>(
+          const_cast<uint8_t *>(
+              reinterpret_cast<const uint8_t *>(return_object.metadata().data())),
+          return_object.metadata().size());
+    }
+
+    RayObject object(data_buffer, metadata_buffer, nested_refs);
+    if (store_in_plasma) {
+      put_in_local_plasma_callback_(object, object_id);
+    } else {
+      direct_return = in_memory_store_->Put(object, object_id);
+    }
+  }
+
+  rpc::Address owner_address;
+  if (reference_counter_->GetOwner(object_id, &owner_address) && !nested_refs.empty()) {
+    std::vector<ObjectID> nested_ids;
+    for (const auto &nested_ref : nested_refs) {
+      nested_ids.emplace_back(ObjectRefToId(nested_ref));
+    }
+    reference_counter_->AddNestedObjectIds(object_id, nested_ids, owner_address);
+  }
+  return direct_return;
+}
+
+bool TaskManager::HandleStreamingReturn(const TaskID &task_id,
+                                        int64_t index,
+                                        const rpc::ReturnObject &return_object,
+                                        const rpc::Address &worker_addr) {
+  const auto object_id = ObjectID::FromBinary(return_object.object_id());
+  rpc::Address caller_address;
+  std::string call_site;
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = streaming_returns_.find(task_id);
+    // Drop the result if the stream has ended, or if it's a duplicate that a retry of
+    // the task reported again.
+    if (it == streaming_returns_.end() || it->second.finished ||
+        index < it->second.next_read_index || it->second.reported.count(index)) {
+      RAY_LOG(DEBUG) << "Dropping streamed result " << index << " of task " << task_id;
+      return false;
+    }
+    caller_address = it->second.caller_address;
+    call_site = it->second.call_site;
+  }
+
+  // The result must be in scope and stored before the reader can see it.
+  reference_counter_->AddOwnedObject(object_id,
+                                     /*inner_ids=*/{},
+                                     caller_address,
+                                     call_site,
+                                     return_object.size(),
+                                     /*is_reconstructable=*/false,
+                                     /*add_local_ref=*/true);
+  HandleTaskReturn(object_id,
+                   return_object,
+                   NodeID::FromBinary(worker_addr.raylet_id()),
+                   /*store_in_plasma=*/false);
+
+  absl::MutexLock lock(&mu_);
+  auto it = streaming_returns_.find(task_id);
+  RAY_CHECK(it != streaming_returns_.end());
+  it->second.reported.emplace(index, object_id);
+  return true;
+}
+
+bool TaskManager::TryReadStreamingReturn(const TaskID &task_id,
+                                         rpc::ObjectReference *object_ref,
+                                         bool *finished) {
+  absl::MutexLock lock(&mu_);
+  *finished = false;
+  auto it = streaming_returns_.find(task_id);
+  if (it == streaming_returns_.end()) {
+    *finished = true;
+    return false;
+  }
+  auto &stream = it->second;
+  // The results are read in order. Once the task has finished, no result is
+  // missing any longer, so the ones after a gap are read too.
+  if (!stream.reported.empty() &&
+      (stream.reported.begin()->first == stream.next_read_index || stream.finished)) {
+    auto result = stream.reported.begin();
+    object_ref->set_object_id(result->second.Binary());
+    object_ref->mutable_owner_address()->CopyFrom(stream.caller_address);
+    object_ref->set_call_site(stream.call_site);
+    stream.next_read_index = result->first + 1;
+    stream.reported.erase(result);
+    return true;
+  }
+  if (stream.finished) {
+    *finished = true;
+    streaming_returns_.erase(it);
+  }
+  return false;
+}
+
+void TaskManager::FinishStreamingReturns(const TaskID &task_id) {
+  auto it = streaming_returns_.find(task_id);
+  if (it != streaming_returns_.end()) {
+    it->second.finished = true;
+  }
+}
+
 void TaskManager::CompletePendingTask(const TaskID &task_id,
                                       const rpc::PushTaskReply &reply,
                                       const rpc::Address &worker_addr) {
   RAY_LOG(DEBUG) << "Completing task " << task_id;
+  task_latency_tracer_.Record(task_id, TaskStage::FINISHED);
 
   // Objects that were stored in plasma upon the first successful execution of
   // this task. These objects will get stored in plasma again, even if they
@@ -236,59 +423,14 @@ void TaskManager::CompletePendingTask(const TaskID &task_id,
   for (int i = 0; i < reply.return_objects_size(); i++) {
     const auto &return_object = reply.return_objects(i);
     ObjectID object_id = ObjectID::FromBinary(return_object.object_id());
-    reference_counter_->UpdateObjectSize(object_id, return_object.size());
-    RAY_LOG(DEBUG) << "Task return object " << object_id << " has size "
-                   << return_object.size();
-
-    const auto nested_refs =
-        VectorFromProtobuf<rpc::ObjectReference>(return_object.nested_inlined_refs());
-    if (return_object.in_plasma()) {
-      // Mark it as in plasma with a dummy object.
-      RAY_CHECK(
-          in_memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
-      const auto pinned_at_raylet_id = NodeID::FromBinary(worker_addr.raylet_id());
-      reference_counter_->UpdateObjectPinnedAtRaylet(object_id, pinned_at_raylet_id);
-    } else {
-      // NOTE(swang): If a direct object was promoted to plasma, then we do not
-      // record the node ID that it was pinned at, which means that we will not
-      // be able to reconstruct it if the plasma object copy is lost. However,
-      // this is okay because the pinned copy is on the local node, so we will
-      // fate-share with the object if the local node fails.
-      std::shared_ptr<LocalMemoryBuffer> data_buffer;
-      if (return_object.data().size() > 0) {
-        data_buffer = std::make_shared<LocalMemoryBuffer>(
-            const_cast<uint8_t *>(
-                reinterpret_cast<const uint8_t *>(return_object.data().data())),
-            return_object.data().size());
-      }
-      std::shared_ptr<LocalMemoryBuffer> metadata_buffer;
-      if (return_object.metadata().size() > 0) {
-        metadata_buffer = std::make_shared<LocalMemoryBuffer>(
-            const_cast<uint8_t *>(
-                reinterpret_cast<const uint8_t *>(return_object.metadata().data())),
-            return_object.metadata().size());
-      }
-
-      RayObject object(data_buffer, metadata_buffer, nested_refs);
-      if (store_in_plasma_ids.count(object_id)) {
-        put_in_local_plasma_callback_(object, object_id);
-      } else {
-        bool stored_in_direct_memory = in_memory_store_->Put(object, object_id);
-        if (stored_in_direct_memory) {
-          direct_return_ids.push_back(object_id);
-        }
-      }
-    }
-
-    rpc::Address owner_address;
-    if (reference_counter_->GetOwner(object_id, &owner_address) && !nested_refs.empty()) {
-      std::vector<ObjectID> nested_ids;
-      for (const auto &nested_ref : nested_refs) {
-        nested_ids.emplace_back(ObjectRefToId(nested_ref));
-      }
-      reference_counter_->AddNestedObjectIds(object_id, nested_ids, owner_address);
+    if (HandleTaskReturn(object_id,
+                         return_object,
+                         NodeID::FromBinary(worker_addr.raylet_id()),
+                         store_in_plasma_ids.count(object_id))) {
+      direct_return_ids.push_back(object_id);
     }
   }
+  task_latency_tracer_.Record(task_id, TaskStage::RETURNS_STORED);
 
   TaskSpecification spec;
   bool release_lineage = true;
@@ -315,6 +457,7 @@ void TaskManager::CompletePendingTask(const TaskID &task_id,
 
     it->second.status = rpc::TaskStatus::FINISHED;
     num_pending_tasks_--;
+    FinishStreamingReturns(task_id);
 
     // A finished task can only be re-executed if it has some number of
     // retries left and returned at least one object that is still in use and
@@ -326,6 +469,9 @@ void TaskManager::CompletePendingTask(const TaskID &task_id,
       release_lineage = false;
       it->second.lineage_footprint_bytes = it->second.spec.GetMessage().ByteSizeLong();
       total_lineage_footprint_bytes_ += it->second.lineage_footprint_bytes;
+      if (RayConfig::instance().compact_lineage_specs()) {
+        it->second.CompactSpec();
+      }
       if (total_lineage_footprint_bytes_ > max_lineage_bytes_) {
         RAY_LOG(INFO) << "Total lineage size is " << total_lineage_footprint_bytes_ / 1e6
                       << "MB, which exceeds the limit of " << max_lineage_bytes_ / 1e6
@@ -338,7 +484,11 @@ void TaskManager::CompletePendingTask(const TaskID &task_id,
     }
   }
 
-  RemoveFinishedTaskReferences(spec, release_lineage, worker_addr, reply.borrowed_refs());
+  RemoveFinishedTaskReferences(spec,
+                               release_lineage,
+                               worker_addr,
+                               reply.borrowed_refs(),
+                               reply.compact_borrowed_refs());
   if (min_lineage_bytes_to_evict > 0) {
     // Evict at least half of the current lineage.
     auto bytes_evicted = reference_counter_->EvictLineage(min_lineage_bytes_to_evict);
@@ -392,6 +542,7 @@ void TaskManager::FailPendingTask(const TaskID &task_id,
   // loudly with ERROR here.
   RAY_LOG(DEBUG) << "Task " << task_id << " failed with error "
                  << rpc::ErrorType_Name(error_type);
+  task_latency_tracer_.Discard(task_id);
 
   TaskSpecification spec;
   {
@@ -404,6 +555,7 @@ void TaskManager::FailPendingTask(const TaskID &task_id,
     spec = it->second.spec;
     submissible_tasks_.erase(it);
     num_pending_tasks_--;
+    FinishStreamingReturns(task_id);
 
     // Throttled logging of task failure errors.
     auto debug_str = spec.DebugString();
@@ -428,7 +580,8 @@ void TaskManager::FailPendingTask(const TaskID &task_id,
   RemoveFinishedTaskReferences(spec,
                                /*release_lineage=*/true,
                                rpc::Address(),
-                               ReferenceCounter::ReferenceTableProto());
+                               ReferenceCounter::ReferenceTableProto(),
+                               rpc::CompactObjectReferenceCounts());
   if (mark_task_object_failed) {
     MarkTaskReturnObjectsFailed(spec, error_type, ray_error_info);
   }
@@ -487,7 +640,8 @@ void TaskManager::RemoveFinishedTaskReferences(
     TaskSpecification &spec,
     bool release_lineage,
     const rpc::Address &borrower_addr,
-    const ReferenceCounter::ReferenceTableProto &borrowed_refs) {
+    const ReferenceCounter::ReferenceTableProto &borrowed_refs,
+    const rpc::CompactObjectReferenceCounts &compact_borrowed_refs) {
   std::vector<ObjectID> plasma_dependencies;
   for (size_t i = 0; i < spec.NumArgs(); i++) {
     if (spec.ArgByRef(i)) {
@@ -519,6 +673,7 @@ void TaskManager::RemoveFinishedTaskReferences(
                                                    release_lineage,
                                                    borrower_addr,
                                                    borrowed_refs,
+                                                   compact_borrowed_refs,
                                                    &deleted);
   in_memory_store_->Delete(deleted);
 }
@@ -547,11 +702,12 @@ int64_t TaskManager::RemoveLineageReference(const ObjectID &object_id,
   if (it->second.reconstructable_return_ids.empty() && !it->second.IsPending()) {
     // If the task can no longer be retried, decrement the lineage ref count
     // for each of the task's args.
-    for (size_t i = 0; i < it->second.spec.NumArgs(); i++) {
-      if (it->second.spec.ArgByRef(i)) {
-        released_objects->push_back(it->second.spec.ArgId(i));
+    const auto spec = it->second.GetSpec();
+    for (size_t i = 0; i < spec.NumArgs(); i++) {
+      if (spec.ArgByRef(i)) {
+        released_objects->push_back(spec.ArgId(i));
       } else {
-        const auto &inlined_refs = it->second.spec.ArgInlinedRefs(i);
+        const auto &inlined_refs = spec.ArgInlinedRefs(i);
         for (const auto &inlined_ref : inlined_refs) {
           released_objects->push_back(ObjectID::FromBinary(inlined_ref.object_id()));
         }
@@ -599,7 +755,7 @@ absl::optional<TaskSpecification> TaskManager::GetTaskSpec(const TaskID &task_id
   if (it == submissible_tasks_.end()) {
     return absl::optional<TaskSpecification>();
   }
-  return it->second.spec;
+  return it->second.GetSpec();
 }
 
 std::vector<TaskID> TaskManager::GetPendingChildrenTasks(
@@ -625,11 +781,12 @@ void TaskManager::AddTaskStatusInfo(rpc::CoreWorkerStats *stats) const {
       continue;
     }
     ref->set_task_status(it->second.status);
-    ref->set_attempt_number(it->second.spec.AttemptNumber());
+    ref->set_attempt_number(it->second.GetSpec().AttemptNumber());
   }
 }
 
 void TaskManager::MarkDependenciesResolved(const TaskID &task_id) {
+  task_latency_tracer_.Record(task_id, TaskStage::DEPENDENCIES_RESOLVED);
   absl::MutexLock lock(&mu_);
   auto it = submissible_tasks_.find(task_id);
   if (it == submissible_tasks_.end()) {
@@ -640,12 +797,16 @@ void TaskManager::MarkDependenciesResolved(const TaskID &task_id) {
   }
 }
 
+void TaskManager::MarkTaskPushed(const TaskID &task_id) {
+  task_latency_tracer_.Record(task_id, TaskStage::PUSHED);
+}
+
 void TaskManager::FillTaskInfo(rpc::GetCoreWorkerStatsReply *reply) const {
   absl::MutexLock lock(&mu_);
   for (const auto &task_it : submissible_tasks_) {
     const auto &task_entry = task_it.second;
     auto entry = reply->add_task_info_entries();
-    const auto &task_spec = task_entry.spec;
+    const auto task_spec = task_entry.GetSpec();
     const auto &task_state = task_entry.status;
     rpc::TaskType type;
     if (task_spec.IsNormalTask()) {
@@ -18,8 +18,11 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/id.h"
+#include "ray/common/mutex_contention.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/task/task.h"
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
+#include "ray/core_worker/task_latency_tracer.h"
 #include "src/ray/protobuf/common.pb.h"
 #include "src/ray/protobuf/core_worker.pb.h"
 #include "src/ray/protobuf/gcs.pb.h"
@@ -53,6 +56,8 @@ class TaskFinisherInterface {
 
   virtual void MarkDependenciesResolved(const TaskID &task_id) = 0;
 
+  virtual void MarkTaskPushed(const TaskID &task_id) = 0;
+
   virtual bool MarkTaskCanceled(const TaskID &task_id) = 0;
 
   virtual void MarkTaskReturnObjectsFailed(
@@ -94,7 +99,9 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
         put_in_local_plasma_callback_(put_in_local_plasma_callback),
         retry_task_callback_(retry_task_callback),
         push_error_callback_(push_error_callback),
-        max_lineage_bytes_(max_lineage_bytes) {
+        max_lineage_bytes_(max_lineage_bytes),
+        task_latency_tracer_(RayConfig::instance().task_latency_trace_sample_rate(),
+                             RayConfig::instance().task_latency_trace_buffer_size()) {
     reference_counter_->SetReleaseLineageCallback(
         [this](const ObjectID &object_id, std::vector<ObjectID> *ids_to_release) {
           return RemoveLineageReference(object_id, ids_to_release);
@@ -119,6 +126,19 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
                                                    const std::string &call_site,
                                                    int max_retries = 0);
 
+  /// Add a batch of tasks that are pending execution, the same as `AddPendingTask`
+  /// for each of them, but taking the lock of the task table once for the batch.
+  ///
+  /// \param[in] caller_address The rpc address of the calling task.
+  /// \param[in] specs The specs of the pending tasks.
+  /// \param[in] max_retries Number of times each task may be retried on failure.
+  /// \return ObjectRefs returned by each task, in order.
+  std::vector<std::vector<rpc::ObjectReference>> AddPendingTasks(
+      const rpc::Address &caller_address,
+      const std::vector<TaskSpecification> &specs,
+      const std::string &call_site,
+      int max_retries = 0);
+
   /// Resubmit a task that has completed execution before. This is used to
   /// reconstruct objects stored in Plasma that were lost.
   ///
@@ -147,6 +167,34 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
                            const rpc::PushTaskReply &reply,
                            const rpc::Address &worker_addr) override;
 
+  /// Store a result that a pending streaming task reported while it runs. The
+  /// result is owned by this worker, and it's held by a local reference until it's
+  /// read with TryReadStreamingReturn.
+  ///
+  /// \param[in] task_id ID of the pending task.
+  /// \param[in] index The index of the result among the results of the task.
+  /// \param[in] return_object The result.
+  /// \param[in] worker_addr Address of the worker that executes the task.
+  /// \return Whether the result was stored. It's dropped if the task isn't pending,
+  /// or if the result was already reported.
+  bool HandleStreamingReturn(const TaskID &task_id,
+                             int64_t index,
+                             const rpc::ReturnObject &return_object,
+                             const rpc::Address &worker_addr) LOCKS_EXCLUDED(mu_);
+
+  /// Read the next result of a streaming task, in the order that the task reported
+  /// the results in. The state of the stream is dropped once the end of the stream
+  /// is read.
+  ///
+  /// \param[in] task_id ID of the streaming task.
+  /// \param[out] object_ref The result, if there was one. The caller takes over the
+  /// local reference to it.
+  /// \param[out] finished Set if the task finished and all of its results were read.
+  /// \return Whether there was a result to read.
+  bool TryReadStreamingReturn(const TaskID &task_id,
+                              rpc::ObjectReference *object_ref,
+                              bool *finished) LOCKS_EXCLUDED(mu_);
+
   bool RetryTaskIfPossible(const TaskID &task_id) override;
 
   /// A pending task failed. This will either retry the task or mark the task
@@ -249,6 +297,14 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
   /// \param[in] task_id The task that is now scheduled.
   void MarkDependenciesResolved(const TaskID &task_id) override;
 
+  /// Record that the given task was pushed to the worker that executes it.
+  ///
+  /// \param[in] task_id The task that was pushed.
+  void MarkTaskPushed(const TaskID &task_id) override;
+
+  /// Get the tracer of the latency of the stages of the tasks.
+  const TaskLatencyTracer &GetTaskLatencyTracer() const { return task_latency_tracer_; }
+
   /// Add debug information about the current task status for the ObjectRefs
   /// included in the given stats.
   ///
@@ -272,6 +328,30 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
 
     bool IsPending() const { return status != rpc::TaskStatus::FINISHED; }
 
+    /// Get the task spec, which is parsed again if it was compacted.
+    TaskSpecification GetSpec() const {
+      if (IsSpecCompacted()) {
+        return TaskSpecification(compacted_spec);
+      }
+      return spec;
+    }
+
+    bool IsSpecCompacted() const { return !compacted_spec.empty(); }
+
+    /// Keep only the serialized spec, while the task is only kept as lineage.
+    void CompactSpec() {
+      compacted_spec = spec.Serialize();
+      spec = TaskSpecification();
+    }
+
+    /// Parse the compacted spec again, e.g., once the task is resubmitted.
+    void ExpandSpec() {
+      if (IsSpecCompacted()) {
+        spec = TaskSpecification(compacted_spec);
+        std::string().swap(compacted_spec);
+      }
+    }
+
     /// The task spec. This is pinned as long as the following are true:
     /// - The task is still pending execution. This means that the task may
     /// fail and so it may be retried in the future.
@@ -283,7 +363,11 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
     /// the worker fails. We could avoid this by either not caching the full
     /// TaskSpec for tasks that cannot be retried (e.g., actor tasks), or by
     /// storing a shared_ptr to a PushTaskRequest protobuf for all tasks.
-    const TaskSpecification spec;
+    /// While the spec is compacted, this is empty, see GetSpec().
+    TaskSpecification spec;
+    /// The serialized spec, if the task finished and is only kept as lineage, and
+    /// compact_lineage_specs is set. Empty otherwise.
+    std::string compacted_spec;
     // Number of times this task may be resubmitted. If this reaches 0, then
     // the task entry may be erased.
     int num_retries_left;
@@ -329,11 +413,42 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
       TaskSpecification &spec,
       bool release_lineage,
       const rpc::Address &worker_addr,
-      const ReferenceCounter::ReferenceTableProto &borrowed_refs);
+      const ReferenceCounter::ReferenceTableProto &borrowed_refs,
+      const rpc::CompactObjectReferenceCounts &compact_borrowed_refs);
 
   /// Shutdown if all tasks are finished and shutdown is scheduled.
   void ShutdownIfNeeded() LOCKS_EXCLUDED(mu_);
 
+  /// Store a return object of a task in the memory store, or mark it as stored in
+  /// plasma.
+  ///
+  /// \param[in] store_in_plasma Whether to put an inlined object in plasma, because
+  /// the object was stored in plasma by an earlier execution of the task.
+  /// \return Whether the object was stored in the memory store.
+  bool HandleTaskReturn(const ObjectID &object_id,
+                        const rpc::ReturnObject &return_object,
+                        const NodeID &worker_raylet_id,
+                        bool store_in_plasma) LOCKS_EXCLUDED(mu_);
+
+  /// Mark the end of the results of a streaming task, once it's no longer pending.
+  void FinishStreamingReturns(const TaskID &task_id) EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// Add the references of a new pending task, that is, its dependencies and its owned
+  /// return objects.
+  ///
+  /// \return ObjectRefs returned by the task.
+  std::vector<rpc::ObjectReference> AddTaskReferences(const rpc::Address &caller_address,
+                                                      const TaskSpecification &spec,
+                                                      const std::string &call_site,
+                                                      int max_retries)
+      LOCKS_EXCLUDED(mu_);
+
+  /// Add a new pending task to the table of submissible tasks.
+  void AddSubmissibleTask(const rpc::Address &caller_address,
+                          const TaskSpecification &spec,
+                          const std::string &call_site,
+                          int max_retries) EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   /// Used to store task results.
   std::shared_ptr<CoreWorkerMemoryStore> in_memory_store_;
 
@@ -356,6 +471,9 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
 
   const int64_t max_lineage_bytes_;
 
+  /// Traces the latency of the stages of a sample of the tasks.
+  TaskLatencyTracer task_latency_tracer_;
+
   // The number of task failures we have logged total.
   int64_t num_failure_logs_ GUARDED_BY(mu_) = 0;
 
@@ -364,6 +482,7 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
 
   /// Protects below fields.
   mutable absl::Mutex mu_;
+  TrackedMutexName mu_name_{&mu_, "TaskManager::mu_"};
 
   /// This map contains one entry per task that may be submitted for
   /// execution. This includes both tasks that are currently pending execution
@@ -371,6 +490,22 @@ class TaskManager : public TaskFinisherInterface, public TaskResubmissionInterfa
   /// future.
   absl::flat_hash_map<TaskID, TaskEntry> submissible_tasks_ GUARDED_BY(mu_);
 
+  /// The results that a streaming task reported, which weren't read yet.
+  struct StreamingReturns {
+    /// The owner of the results, and the call site of the task.
+    rpc::Address caller_address;
+    std::string call_site;
+    /// The results that weren't read yet, by their index.
+    std::map<int64_t, ObjectID> reported;
+    /// The index of the next result to read.
+    int64_t next_read_index = 0;
+    /// Whether the task is no longer pending, so no more results are reported.
+    bool finished = false;
+  };
+
+  /// The results of the streaming tasks, until the end of the results is read.
+  absl::flat_hash_map<TaskID, StreamingReturns> streaming_returns_ GUARDED_BY(mu_);
+
   /// Number of tasks that are pending. This is a count of all tasks in
   /// submissible_tasks_ that have been submitted and are currently pending
   /// execution.
@@ -79,6 +79,49 @@ TEST_F(ActorCreatorTest, AsyncWaitForFinish) {
   ASSERT_EQ(101, cnt);
 }
 
+TEST_F(ActorCreatorTest, BatchRegistration) {
+  RayConfig::instance().initialize(R"({"actor_register_batch_size": 2})");
+  std::vector<ActorID> actor_ids;
+  for (int i = 0; i < 4; ++i) {
+    actor_ids.push_back(ActorID::Of(JobID::FromInt(1), TaskID::Nil(), i));
+  }
+  std::vector<size_t> batch_sizes;
+  std::function<void(std::vector<Status>)> cb;
+  EXPECT_CALL(*gcs_client->mock_actor_accessor,
+              AsyncRegisterActors(::testing::_, ::testing::_, ::testing::_))
+      .WillRepeatedly(::testing::Invoke(
+          [&](const std::vector<TaskSpecification> &task_specs,
+              const std::function<void(std::vector<Status>)> &callback,
+              int64_t timeout_ms) {
+            batch_sizes.push_back(task_specs.size());
+            cb = callback;
+            return Status::OK();
+          }));
+  int cnt = 0;
+  auto per_finish_cb = [&cnt](Status status) {
+    ASSERT_TRUE(status.ok());
+    cnt++;
+  };
+  // The first actor is registered right away, and the rest wait for its reply.
+  for (const auto &actor_id : actor_ids) {
+    ASSERT_TRUE(
+        actor_creator->AsyncRegisterActor(GetTaskSpec(actor_id), per_finish_cb).ok());
+  }
+  ASSERT_EQ(batch_sizes, std::vector<size_t>({1}));
+  cb({Status::OK()});
+  ASSERT_FALSE(actor_creator->IsActorInRegistering(actor_ids[0]));
+  ASSERT_TRUE(actor_creator->IsActorInRegistering(actor_ids[1]));
+  ASSERT_EQ(batch_sizes, std::vector<size_t>({1, 2}));
+  cb({Status::OK(), Status::OK()});
+  ASSERT_EQ(batch_sizes, std::vector<size_t>({1, 2, 1}));
+  cb({Status::OK()});
+  for (const auto &actor_id : actor_ids) {
+    ASSERT_FALSE(actor_creator->IsActorInRegistering(actor_id));
+  }
+  ASSERT_EQ(4, cnt);
+  RayConfig::instance().initialize("");
+}
+
 }  // namespace core
 }  // namespace ray
 
@@ -298,6 +298,43 @@ TEST_F(ActorManagerTest, RegisterActorHandles) {
   ASSERT_TRUE(actor_handle_to_get->CreationJobID() == job_id);
 }
 
+TEST_F(ActorManagerTest, TestLazyActorStateSubscription) {
+  actor_manager_ = std::make_shared<ActorManager>(gcs_client_mock_,
+                                                  direct_actor_submitter_,
+                                                  reference_counter_,
+                                                  /*lazy_subscription=*/true);
+  JobID job_id = JobID::FromInt(1);
+  const TaskID task_id = TaskID::ForDriverTask(job_id);
+  ActorID actor_id = ActorID::Of(job_id, task_id, 1);
+  RayFunction function(Language::PYTHON,
+                       FunctionDescriptorBuilder::BuildPython("", "", "", ""));
+  auto actor_handle = absl::make_unique<ActorHandle>(actor_id,
+                                                     TaskID::Nil(),
+                                                     rpc::Address(),
+                                                     job_id,
+                                                     ObjectID::FromRandom(),
+                                                     function.GetLanguage(),
+                                                     function.GetFunctionDescriptor(),
+                                                     "",
+                                                     0,
+                                                     "",
+                                                     "",
+                                                     -1,
+                                                     false);
+  EXPECT_CALL(*reference_counter_, AddBorrowedObject(_, _, _, _));
+  actor_manager_->RegisterActorHandle(
+      std::move(actor_handle), ObjectID::Nil(), /*call_site=*/"", rpc::Address());
+  // The borrowed handle isn't subscribed to until a task is submitted to the actor.
+  ASSERT_FALSE(actor_info_accessor_->CheckSubscriptionRequested(actor_id));
+  actor_manager_->SubscribeActorStateIfNeeded(actor_id);
+  ASSERT_TRUE(actor_info_accessor_->CheckSubscriptionRequested(actor_id));
+
+  // The actor is only subscribed to once.
+  actor_info_accessor_->callback_map_.clear();
+  actor_manager_->SubscribeActorStateIfNeeded(actor_id);
+  ASSERT_FALSE(actor_info_accessor_->CheckSubscriptionRequested(actor_id));
+}
+
 TEST_F(ActorManagerTest, TestActorStateNotificationPending) {
   ActorID actor_id = AddActorHandle();
   // Nothing happens if state is pending.
@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 #include "ray/common/test_util.h"
 #include "ray/core_worker/transport/out_of_order_actor_submit_queue.h"
+#include "ray/core_worker/transport/sequential_actor_submit_queue.h"
 
 namespace ray {
 namespace core {
@@ -97,6 +98,31 @@ TEST(OutofOrderActorSubmitQueueTest, PassThroughTest) {
   }
 }
 
+TEST(SequentialActorSubmitQueueTest, CompletedTasksTest) {
+  SequentialActorSubmitQueue queue(ActorID{});
+  // task 0 completes in order, task 2 and 3 complete before task 1.
+  queue.MarkTaskCompleted(0, BuildTaskSpec(0));
+  queue.MarkTaskCompleted(2, BuildTaskSpec(2));
+  queue.MarkTaskCompleted(3, BuildTaskSpec(3));
+
+  // the restarted actor starts from task 1, and task 2 and 3 are resent to it.
+  queue.OnClientConnected();
+  EXPECT_EQ(queue.GetSequenceNumber(BuildTaskSpec(1)), 0);
+  auto out_of_order_completed_tasks = queue.PopAllOutOfOrderCompletedTasks();
+  EXPECT_EQ(out_of_order_completed_tasks.size(), 2);
+  EXPECT_EQ(out_of_order_completed_tasks.begin()->first, 2);
+  EXPECT_EQ(out_of_order_completed_tasks.rbegin()->first, 3);
+  EXPECT_TRUE(queue.PopAllOutOfOrderCompletedTasks().empty());
+
+  // all tasks complete in order.
+  for (uint64_t i = 1; i < 4; i++) {
+    queue.MarkTaskCompleted(i, BuildTaskSpec(i));
+  }
+  queue.OnClientConnected();
+  EXPECT_EQ(queue.GetSequenceNumber(BuildTaskSpec(4)), 0);
+  EXPECT_TRUE(queue.PopAllOutOfOrderCompletedTasks().empty());
+}
+
 }  // namespace core
 }  // namespace ray
 
@@ -78,6 +78,51 @@ TEST(ConcurrencyGroupManagerTest, TestBasicConcurrencyGroupManager) {
   manager.Stop();
 }
 
+TEST(ConcurrencyGroupManagerTest, TestWorkStealingExecutor) {
+  RayConfig::instance().initialize(R"({"actor_work_stealing_executor": true})");
+  static auto empty = std::make_shared<ray::EmptyFunctionDescriptor>();
+  std::vector<ConcurrencyGroup> defined_concurrency_groups = {{"io_group", 2, {}}};
+  ConcurrencyGroupManager<BoundedExecutor> manager(defined_concurrency_groups, 3);
+  auto io_executor = manager.GetExecutor("io_group", empty);
+  ASSERT_EQ(io_executor->GetMaxConcurrency(), 2);
+
+  absl::Mutex mu;
+  bool released = false;
+  int num_running = 0;
+  int max_running = 0;
+  int num_finished = 0;
+  // The posts don't block, though the group is at its limit after two of them.
+  for (int i = 0; i < 10; i++) {
+    io_executor->Post([&]() {
+      absl::MutexLock lock(&mu);
+      num_running++;
+      max_running = std::max(max_running, num_running);
+      mu.Await(absl::Condition(&released));
+      num_running--;
+      num_finished++;
+    });
+  }
+  // The default group isn't held up by the full group.
+  bool default_done = false;
+  manager.GetDefaultExecutor()->Post([&]() {
+    absl::MutexLock lock(&mu);
+    default_done = true;
+  });
+  {
+    absl::MutexLock lock(&mu);
+    mu.Await(absl::Condition(&default_done));
+    auto two_running = [&]() { return num_running == 2; };
+    mu.Await(absl::Condition(&two_running));
+    released = true;
+    auto all_finished = [&]() { return num_finished == 10; };
+    mu.Await(absl::Condition(&all_finished));
+  }
+  ASSERT_EQ(max_running, 2);
+
+  manager.Stop();
+  RayConfig::instance().initialize("");
+}
+
 }  // namespace core
 }  // namespace ray
 
@@ -15,6 +15,7 @@
 #include "ray/core_worker/transport/direct_task_transport.h"
 
 #include "gtest/gtest.h"
+#include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/task/task_spec.h"
 #include "ray/common/task/task_util.h"
 #include "ray/common/test_util.h"
@@ -142,6 +143,8 @@ class MockTaskFinisher : public TaskFinisherInterface {
 
   void MarkDependenciesResolved(const TaskID &task_id) override {}
 
+  void MarkTaskPushed(const TaskID &task_id) override {}
+
   int num_tasks_complete = 0;
   int num_tasks_failed = 0;
   int num_inlined_dependencies = 0;
@@ -502,6 +505,50 @@ TEST(LocalDependencyResolverTest, TestInlinePendingDependencies) {
   ASSERT_EQ(task_finisher->num_contained_ids, 0);
 }
 
+TEST(LocalDependencyResolverTest, TestTasksWaitingOnSameObject) {
+  auto store = std::make_shared<CoreWorkerMemoryStore>();
+  auto task_finisher = std::make_shared<MockTaskFinisher>();
+  MockActorCreator actor_creator;
+  LocalDependencyResolver resolver(*store, *task_finisher, actor_creator);
+  ObjectID obj1 = ObjectID::FromRandom();
+  ObjectID obj2 = ObjectID::FromRandom();
+  auto data = GenerateRandomObject();
+  TaskSpecification task1;
+  task1.GetMutableMessage().add_args()->mutable_object_ref()->set_object_id(
+      obj1.Binary());
+  TaskSpecification task2;
+  task2.GetMutableMessage().add_args()->mutable_object_ref()->set_object_id(
+      obj1.Binary());
+  task2.GetMutableMessage().add_args()->mutable_object_ref()->set_object_id(
+      obj2.Binary());
+  int num_resolved = 0;
+  resolver.ResolveDependencies(task1, [&num_resolved](Status) { num_resolved++; });
+  resolver.ResolveDependencies(task2, [&num_resolved](Status) { num_resolved++; });
+  ASSERT_EQ(resolver.NumPendingTasks(), 2);
+
+  // The object is resolved for both tasks, but only the first one has all of its
+  // dependencies.
+  ASSERT_TRUE(store->Put(*data, obj1));
+  ASSERT_EQ(num_resolved, 1);
+  ASSERT_FALSE(task1.ArgByRef(0));
+  ASSERT_EQ(resolver.NumPendingTasks(), 1);
+
+  ASSERT_TRUE(store->Put(*data, obj2));
+  ASSERT_EQ(num_resolved, 2);
+  ASSERT_FALSE(task2.ArgByRef(0));
+  ASSERT_FALSE(task2.ArgByRef(1));
+  ASSERT_EQ(resolver.NumPendingTasks(), 0);
+  ASSERT_EQ(task_finisher->num_inlined_dependencies, 3);
+
+  // A task that waits on an object that is already available is resolved right away.
+  TaskSpecification task3;
+  task3.GetMutableMessage().add_args()->mutable_object_ref()->set_object_id(
+      obj1.Binary());
+  resolver.ResolveDependencies(task3, [&num_resolved](Status) { num_resolved++; });
+  ASSERT_EQ(num_resolved, 3);
+  ASSERT_EQ(resolver.NumPendingTasks(), 0);
+}
+
 TEST(LocalDependencyResolverTest, TestInlinedObjectIds) {
   auto store = std::make_shared<CoreWorkerMemoryStore>();
   auto task_finisher = std::make_shared<MockTaskFinisher>();
@@ -1046,6 +1093,64 @@ TEST(DirectTaskTransportTest, TestConcurrentWorkerLeases) {
   ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
 }
 
+TEST(DirectTaskTransportTest, TestClusterSizeBasedLeaseRequests) {
+  rpc::Address address;
+  auto raylet_client = std::make_shared<MockRayletClient>();
+  auto worker_client = std::make_shared<MockWorkerClient>();
+  auto store = std::make_shared<CoreWorkerMemoryStore>();
+  auto client_pool = std::make_shared<rpc::CoreWorkerClientPool>(
+      [&](const rpc::Address &addr) { return worker_client; });
+  auto task_finisher = std::make_shared<MockTaskFinisher>();
+  auto actor_creator = std::make_shared<MockActorCreator>();
+  auto lease_policy = std::make_shared<MockLeasePolicy>();
+  auto rate_limiter = std::make_shared<ClusterSizeBasedLeaseRequestRateLimiter>(1);
+  CoreWorkerDirectTaskSubmitter submitter(address,
+                                          raylet_client,
+                                          client_pool,
+                                          nullptr,
+                                          lease_policy,
+                                          store,
+                                          task_finisher,
+                                          NodeID::Nil(),
+                                          WorkerType::WORKER,
+                                          kLongTimeout,
+                                          actor_creator,
+                                          JobID::Nil(),
+                                          absl::nullopt,
+                                          1,
+                                          1,
+                                          rate_limiter);
+
+  // There are 3 alive nodes, so up to 3 leases are requested at once.
+  std::vector<NodeID> node_ids;
+  rpc::GcsNodeInfo node_info;
+  node_info.set_state(rpc::GcsNodeInfo::ALIVE);
+  for (int i = 0; i < 3; i++) {
+    node_ids.push_back(NodeID::FromRandom());
+    rate_limiter->OnNodeChange(node_ids.back(), node_info);
+  }
+  ASSERT_EQ(rate_limiter->GetMaxPendingLeaseRequestsPerSchedulingCategory(), 3);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(submitter.SubmitTask(BuildEmptyTaskSpec()).ok());
+  }
+  ASSERT_EQ(raylet_client->num_workers_requested, 3);
+
+  // The limit doesn't drop below the minimum when the nodes die.
+  node_info.set_state(rpc::GcsNodeInfo::DEAD);
+  for (const auto &node_id : node_ids) {
+    rate_limiter->OnNodeChange(node_id, node_info);
+  }
+  ASSERT_EQ(rate_limiter->GetMaxPendingLeaseRequestsPerSchedulingCategory(), 1);
+
+  // The pending requests are granted, and a new one is only requested once the
+  // number of pending requests drops below the limit.
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1000 + i, NodeID::Nil()));
+  }
+  ASSERT_EQ(worker_client->callbacks.size(), 3);
+  ASSERT_EQ(raylet_client->num_workers_requested, 4);
+}
+
 TEST(DirectTaskTransportTest, TestSubmitMultipleTasks) {
   rpc::Address address;
   auto raylet_client = std::make_shared<MockRayletClient>();
@@ -1193,6 +1298,74 @@ TEST(DirectTaskTransportTest, TestReuseWorkerLease) {
   ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
 }
 
+TEST(DirectTaskTransportTest, TestPipelineTasksToWorker) {
+  rpc::Address address;
+  auto raylet_client = std::make_shared<MockRayletClient>();
+  auto worker_client = std::make_shared<MockWorkerClient>();
+  auto store = std::make_shared<CoreWorkerMemoryStore>();
+  auto client_pool = std::make_shared<rpc::CoreWorkerClientPool>(
+      [&](const rpc::Address &addr) { return worker_client; });
+  auto task_finisher = std::make_shared<MockTaskFinisher>();
+  auto actor_creator = std::make_shared<MockActorCreator>();
+  auto lease_policy = std::make_shared<MockLeasePolicy>();
+  CoreWorkerDirectTaskSubmitter submitter(address,
+                                          raylet_client,
+                                          client_pool,
+                                          nullptr,
+                                          lease_policy,
+                                          store,
+                                          task_finisher,
+                                          NodeID::Nil(),
+                                          WorkerType::WORKER,
+                                          kLongTimeout,
+                                          actor_creator,
+                                          JobID::Nil(),
+                                          absl::nullopt,
+                                          1,
+                                          /*max_tasks_in_flight_per_worker=*/2);
+
+  TaskSpecification task1 = BuildEmptyTaskSpec();
+  TaskSpecification task2 = BuildEmptyTaskSpec();
+  TaskSpecification task3 = BuildEmptyTaskSpec();
+
+  ASSERT_TRUE(submitter.SubmitTask(task1).ok());
+  ASSERT_TRUE(submitter.SubmitTask(task2).ok());
+  ASSERT_TRUE(submitter.SubmitTask(task3).ok());
+  ASSERT_EQ(raylet_client->num_workers_requested, 1);
+
+  // Tasks 1 and 2 are pushed to the worker at once.
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1000, NodeID::Nil()));
+  ASSERT_EQ(worker_client->callbacks.size(), 2);
+  ASSERT_EQ(raylet_client->num_workers_requested, 2);
+  ASSERT_EQ(raylet_client->num_leases_canceled, 0);
+
+  // Task 1 finishes, Task 3 is pushed behind Task 2.
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(worker_client->callbacks.size(), 2);
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+  ASSERT_EQ(raylet_client->num_leases_canceled, 1);
+  ASSERT_TRUE(raylet_client->ReplyCancelWorkerLease());
+
+  // Task 2 fails, so the worker isn't reused, but it isn't returned until Task 3
+  // finishes.
+  ASSERT_TRUE(worker_client->ReplyPushTask(Status::IOError("oops")));
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+  ASSERT_EQ(raylet_client->num_workers_disconnected, 1);
+
+  // The second lease request is returned immediately.
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1001, NodeID::Nil()));
+  ASSERT_EQ(worker_client->callbacks.size(), 0);
+  ASSERT_EQ(raylet_client->num_workers_returned, 1);
+  ASSERT_EQ(task_finisher->num_tasks_complete, 2);
+  ASSERT_EQ(task_finisher->num_tasks_failed, 1);
+
+  // Check that there are no entries left in the scheduling_key_entries_ hashmap. These
+  // would otherwise cause a memory leak.
+  ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
+}
+
 TEST(DirectTaskTransportTest, TestRetryLeaseCancellation) {
   rpc::Address address;
   auto raylet_client = std::make_shared<MockRayletClient>();
@@ -1879,6 +2052,118 @@ TEST(DirectTaskTransportTest, TestWorkerLeaseTimeout) {
   ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
 }
 
+TEST(DirectTaskTransportTest, TestReuseLeaseAcrossSchedulingClasses) {
+  rpc::Address address;
+  auto raylet_client = std::make_shared<MockRayletClient>();
+  auto worker_client = std::make_shared<MockWorkerClient>();
+  auto store = std::make_shared<CoreWorkerMemoryStore>();
+  auto client_pool = std::make_shared<rpc::CoreWorkerClientPool>(
+      [&](const rpc::Address &addr) { return worker_client; });
+  auto task_finisher = std::make_shared<MockTaskFinisher>();
+  auto actor_creator = std::make_shared<MockActorCreator>();
+  auto lease_policy = std::make_shared<MockLeasePolicy>();
+  CoreWorkerDirectTaskSubmitter submitter(address,
+                                          raylet_client,
+                                          client_pool,
+                                          nullptr,
+                                          lease_policy,
+                                          store,
+                                          task_finisher,
+                                          NodeID::Nil(),
+                                          WorkerType::WORKER,
+                                          kLongTimeout,
+                                          actor_creator,
+                                          JobID::Nil(),
+                                          absl::nullopt,
+                                          1,
+                                          1,
+                                          nullptr,
+                                          /*reuse_leases_across_classes=*/true);
+
+  std::unordered_map<std::string, double> resources({{"a", 1.0}});
+  std::unordered_map<std::string, double> other_resources({{"b", 1.0}});
+  TaskSpecification task1 =
+      BuildTaskSpec(resources, FunctionDescriptorBuilder::BuildPython("a", "", "", ""));
+  TaskSpecification task2 =
+      BuildTaskSpec(resources, FunctionDescriptorBuilder::BuildPython("b", "", "", ""));
+  TaskSpecification task3 = BuildTaskSpec(
+      other_resources, FunctionDescriptorBuilder::BuildPython("c", "", "", ""));
+  ASSERT_TRUE(submitter.SubmitTask(task1).ok());
+  ASSERT_TRUE(submitter.SubmitTask(task2).ok());
+  ASSERT_TRUE(submitter.SubmitTask(task3).ok());
+  ASSERT_EQ(raylet_client->num_workers_requested, 3);
+
+  // Once task 1 finishes, its worker runs task 2, which needs the same resources, and
+  // the lease request for task 2 is canceled.
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1000, NodeID::Nil()));
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(worker_client->callbacks.size(), 1);
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+  ASSERT_EQ(raylet_client->num_leases_canceled, 1);
+  ASSERT_TRUE(raylet_client->ReplyCancelWorkerLease());
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("", 0, NodeID::Nil(), /*cancel=*/true));
+
+  // The worker isn't reused for task 3, which needs other resources.
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(raylet_client->num_workers_returned, 1);
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1001, NodeID::Nil()));
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(raylet_client->num_workers_returned, 2);
+  ASSERT_EQ(raylet_client->num_workers_requested, 3);
+  ASSERT_EQ(task_finisher->num_tasks_complete, 3);
+  ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
+}
+
+TEST(DirectTaskTransportTest, TestIdleWorkerLingers) {
+  rpc::Address address;
+  auto raylet_client = std::make_shared<MockRayletClient>();
+  auto worker_client = std::make_shared<MockWorkerClient>();
+  auto store = std::make_shared<CoreWorkerMemoryStore>();
+  auto client_pool = std::make_shared<rpc::CoreWorkerClientPool>(
+      [&](const rpc::Address &addr) { return worker_client; });
+  auto task_finisher = std::make_shared<MockTaskFinisher>();
+  auto actor_creator = std::make_shared<MockActorCreator>();
+  auto lease_policy = std::make_shared<MockLeasePolicy>();
+  instrumented_io_context io_service;
+  CoreWorkerDirectTaskSubmitter submitter(address,
+                                          raylet_client,
+                                          client_pool,
+                                          nullptr,
+                                          lease_policy,
+                                          store,
+                                          task_finisher,
+                                          NodeID::Nil(),
+                                          WorkerType::WORKER,
+                                          kLongTimeout,
+                                          actor_creator,
+                                          JobID::Nil(),
+                                          boost::asio::steady_timer(io_service),
+                                          1,
+                                          1,
+                                          nullptr,
+                                          /*reuse_leases_across_classes=*/false,
+                                          /*lease_idle_linger_ms=*/10);
+
+  TaskSpecification task = BuildEmptyTaskSpec();
+  ASSERT_TRUE(submitter.SubmitTask(task).ok());
+  ASSERT_TRUE(raylet_client->GrantWorkerLease("localhost", 1000, NodeID::Nil()));
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+
+  // A task submitted while the worker lingers runs on it without a new lease.
+  ASSERT_TRUE(submitter.SubmitTask(task).ok());
+  ASSERT_EQ(worker_client->callbacks.size(), 1);
+  ASSERT_EQ(raylet_client->num_workers_requested, 1);
+  ASSERT_TRUE(worker_client->ReplyPushTask());
+  ASSERT_EQ(raylet_client->num_workers_returned, 0);
+
+  // The worker is returned once it has lingered idle.
+  io_service.run();
+  ASSERT_EQ(raylet_client->num_workers_returned, 1);
+  ASSERT_EQ(task_finisher->num_tasks_complete, 2);
+  ASSERT_TRUE(submitter.CheckNoSchedulingKeyEntriesPublic());
+}
+
 TEST(DirectTaskTransportTest, TestKillExecutingTask) {
   rpc::Address address;
   auto raylet_client = std::make_shared<MockRayletClient>();
@@ -285,5 +285,52 @@ TEST(LocalityAwareLeasePolicyTest, TestBestLocalityFallbackAddrFetchFail) {
   ASSERT_FALSE(is_selected_based_on_locality);
 }
 
+TEST(LocalityAwareLeasePolicyTest, TestCostBasedAvoidsLoadedNode) {
+  absl::flat_hash_map<ObjectID, LocalityData> locality_data;
+  NodeID fallback_node = NodeID::FromRandom();
+  rpc::Address fallback_rpc_address = MockNodeAddrFactory(fallback_node).value();
+  NodeID best_node = NodeID::FromRandom();
+  ObjectID obj1 = ObjectID::FromRandom();
+  // Transferring the object takes 1ms, while waiting behind a task takes 1s.
+  locality_data.emplace(obj1, LocalityData{1 << 20, {best_node}});
+  auto mock_locality_data_provider =
+      std::make_shared<MockLocalityDataProvider>(locality_data);
+  LeaseCostModel cost_model{
+      1 << 20, 1000, [](const NodeID &node_id) { return 1.0; }};
+  LocalityAwareLeasePolicy locality_lease_policy(mock_locality_data_provider,
+                                                 MockNodeAddrFactory,
+                                                 fallback_rpc_address,
+                                                 cost_model);
+  auto task_spec = CreateFakeTask({obj1});
+
+  // The node with the object is idle, so it is the best.
+  auto [best_node_address, is_selected_based_on_locality] =
+      locality_lease_policy.GetBestNodeForTask(task_spec);
+  ASSERT_EQ(NodeID::FromBinary(best_node_address.raylet_id()), best_node);
+  ASSERT_TRUE(is_selected_based_on_locality);
+
+  // The node with the object is busy, so moving the object is cheaper.
+  locality_lease_policy.OnLeaseGranted(best_node);
+  std::tie(best_node_address, is_selected_based_on_locality) =
+      locality_lease_policy.GetBestNodeForTask(task_spec);
+  ASSERT_EQ(NodeID::FromBinary(best_node_address.raylet_id()), fallback_node);
+  ASSERT_FALSE(is_selected_based_on_locality);
+
+  // The fallback node is busy too, so the object decides again.
+  locality_lease_policy.OnLeaseGranted(fallback_node);
+  std::tie(best_node_address, is_selected_based_on_locality) =
+      locality_lease_policy.GetBestNodeForTask(task_spec);
+  ASSERT_EQ(NodeID::FromBinary(best_node_address.raylet_id()), best_node);
+  ASSERT_TRUE(is_selected_based_on_locality);
+
+  // Once its lease is returned, the node with the object is the best again.
+  locality_lease_policy.OnLeaseReturned(fallback_node);
+  locality_lease_policy.OnLeaseReturned(best_node);
+  std::tie(best_node_address, is_selected_based_on_locality) =
+      locality_lease_policy.GetBestNodeForTask(task_spec);
+  ASSERT_EQ(NodeID::FromBinary(best_node_address.raylet_id()), best_node);
+  ASSERT_TRUE(is_selected_based_on_locality);
+}
+
 }  // namespace core
 }  // namespace ray
@@ -16,6 +16,7 @@
 
 #include "absl/synchronization/mutex.h"
 #include "gtest/gtest.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/test_util.h"
 
 namespace ray {
@@ -84,9 +85,9 @@ TEST(TestMemoryStore, TestMemoryStoreStats) {
   // Iterate through the memory store and compare the values that are obtained by
   // GetMemoryStoreStatisticalData.
   auto fill_expected_memory_stats = [&](MemoryStoreStats &expected_item) {
-    {
-      absl::MutexLock lock(&provider->mu_);
-      for (const auto &it : provider->objects_) {
+    for (const auto &shard : provider->shards_) {
+      absl::MutexLock lock(&shard->mu);
+      for (const auto &it : shard->objects) {
         if (it.second->IsInPlasmaError()) {
           expected_item.num_in_plasma += 1;
         } else {
@@ -137,6 +138,60 @@ TEST(TestMemoryStore, TestMemoryStoreStats) {
   ASSERT_EQ(item.used_object_store_memory, expected_item3.used_object_store_memory);
 }
 
+TEST(TestMemoryStore, TestConcurrentPutAndGet) {
+  WorkerContext context(WorkerType::WORKER, WorkerID::FromRandom(), JobID::FromInt(0));
+  std::shared_ptr<CoreWorkerMemoryStore> provider =
+      std::make_shared<CoreWorkerMemoryStore>();
+  ASSERT_GT(provider->shards_.size(), 1);
+
+  const int num_threads = 8;
+  const int num_objects_per_thread = 100;
+  std::vector<ObjectID> ids;
+  for (int i = 0; i < num_threads * num_objects_per_thread; i++) {
+    ids.push_back(ObjectID::FromRandom());
+  }
+
+  // Block on all objects at once, so that the get request spans all shards.
+  std::vector<std::shared_ptr<RayObject>> results;
+  std::thread getter([&]() {
+    RAY_CHECK_OK(provider->Get(ids, ids.size(), -1, context, false, &results));
+  });
+
+  std::vector<std::thread> putters;
+  for (int t = 0; t < num_threads; t++) {
+    putters.emplace_back([&, t]() {
+      for (int i = t * num_objects_per_thread; i < (t + 1) * num_objects_per_thread;
+           i++) {
+        auto buffer = MakeLocalMemoryBufferFromString(std::to_string(i));
+        RayObject object(buffer, nullptr, std::vector<rpc::ObjectReference>());
+        RAY_CHECK(provider->Put(object, ids[i]));
+        // Read the object back, once to mark it as accessed and once more through the
+        // reader lock only path.
+        RAY_CHECK(provider->GetIfExists(ids[i]) != nullptr);
+        RAY_CHECK(provider->GetIfExists(ids[i]) != nullptr);
+      }
+    });
+  }
+  for (auto &putter : putters) {
+    putter.join();
+  }
+  getter.join();
+
+  ASSERT_EQ(results.size(), ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    ASSERT_TRUE(results[i] != nullptr);
+    std::string data(reinterpret_cast<char *>(results[i]->GetData()->Data()),
+                     results[i]->GetData()->Size());
+    ASSERT_EQ(data, std::to_string(i));
+  }
+  ASSERT_EQ(provider->Size(), ids.size());
+  ASSERT_EQ(provider->GetMemoryStoreStatisticalData().num_local_objects, ids.size());
+
+  provider->Delete(ids);
+  ASSERT_EQ(provider->Size(), 0);
+  ASSERT_EQ(provider->GetMemoryStoreStatisticalData().used_object_store_memory, 0);
+}
+
 /// A mock manager that manages all test buffers. This mocks
 /// that memory pressure is able to be awared.
 class MockBufferManager {
@@ -205,6 +260,51 @@ TEST(TestMemoryStore, TestObjectAllocator) {
   ASSERT_EQ(max_rounds * hello.size(), mock_buffer_manager.GetBuferPressureInBytes());
 }
 
+TEST(TestMemoryStore, TestPromoteToPlasmaOverBudget) {
+  RayConfig::instance().initialize(
+      R"({"memory_store_max_bytes": 1000, "memory_store_num_shards": 1})");
+  std::vector<ObjectID> ids;
+  for (int i = 0; i < 10; i++) {
+    ids.push_back(ObjectID::FromRandom());
+  }
+  std::vector<ObjectID> promoted;
+  // The first object can't be promoted, e.g., because it is not owned by this worker.
+  auto promote_to_plasma = [&ids, &promoted](const RayObject &object,
+                                             const ObjectID &object_id) {
+    if (object_id == ids[0]) {
+      return false;
+    }
+    promoted.push_back(object_id);
+    return true;
+  };
+  auto memory_store = std::make_shared<CoreWorkerMemoryStore>(
+      nullptr, nullptr, nullptr, nullptr, nullptr, std::move(promote_to_plasma));
+
+  for (const auto &id : ids) {
+    RayObject object(MakeLocalMemoryBufferFromString(std::string(200, 'x')),
+                     nullptr,
+                     std::vector<rpc::ObjectReference>());
+    memory_store->Put(object, id);
+  }
+
+  // The oldest objects are promoted until the store fits in its budget again.
+  ASSERT_EQ(promoted, std::vector<ObjectID>(ids.begin() + 1, ids.begin() + 6));
+  auto stats = memory_store->GetMemoryStoreStatisticalData();
+  ASSERT_EQ(stats.used_object_store_memory, 1000);
+  ASSERT_EQ(stats.num_in_plasma, 5);
+  ASSERT_EQ(stats.num_local_objects, 5);
+  for (size_t i = 0; i < ids.size(); i++) {
+    bool in_plasma = false;
+    ASSERT_TRUE(memory_store->Contains(ids[i], &in_plasma));
+    ASSERT_EQ(in_plasma, i >= 1 && i < 6);
+  }
+
+  // Deleted objects are no longer candidates for promotion.
+  memory_store->Delete(std::vector<ObjectID>(ids.begin() + 6, ids.end()));
+  ASSERT_EQ(memory_store->GetMemoryStoreStatisticalData().used_object_store_memory, 200);
+  RayConfig::instance().initialize("");
+}
+
 }  // namespace core
 }  // namespace ray
 
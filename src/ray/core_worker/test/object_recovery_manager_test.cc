@@ -63,6 +63,7 @@ class MockRayletClient : public PinObjectsInterface {
       const std::vector<ObjectID> &object_ids,
       const rpc::ClientCallback<rpc::PinObjectIDsReply> &callback) override {
     RAY_LOG(INFO) << "PinObjectIDs " << object_ids.size();
+    num_objects_pinned += object_ids.size();
     callbacks.push_back(callback);
   }
 
@@ -76,12 +77,17 @@ class MockRayletClient : public PinObjectsInterface {
   }
 
   std::list<rpc::ClientCallback<rpc::PinObjectIDsReply>> callbacks = {};
+  size_t num_objects_pinned = 0;
 };
 
 class MockObjectDirectory {
  public:
   void AsyncGetLocations(const ObjectID &object_id,
                          const ObjectLookupCallback &callback) {
+    if (synchronous) {
+      callback(object_id, locations[object_id]);
+      return;
+    }
     callbacks.push_back({object_id, callback});
   }
 
@@ -103,6 +109,8 @@ class MockObjectDirectory {
 
   std::vector<std::pair<ObjectID, ObjectLookupCallback>> callbacks = {};
   absl::flat_hash_map<ObjectID, std::vector<rpc::Address>> locations;
+  /// Whether to reply to lookups right away, like the owner's own directory does.
+  bool synchronous = false;
 };
 
 class ObjectRecoveryManagerTestBase : public ::testing::Test {
@@ -393,6 +401,50 @@ TEST_F(ObjectRecoveryManagerTest, TestLineageEvicted) {
 }  // namespace core
 }  // namespace ray
 
+TEST_F(ObjectRecoveryManagerTest, TestRecoverObjectsTogether) {
+  object_directory_->synchronous = true;
+  std::vector<ObjectID> pinned_ids;
+  std::vector<ObjectID> lost_ids;
+  std::vector<ObjectID> dependencies;
+  for (int i = 0; i < 3; i++) {
+    // Objects with a copy at the same node.
+    ObjectID object_id = ObjectID::FromRandom();
+    ref_counter_->AddOwnedObject(object_id,
+                                 {},
+                                 rpc::Address(),
+                                 "",
+                                 0,
+                                 true,
+                                 /*add_local_ref=*/true);
+    object_directory_->SetLocations(object_id, {rpc::Address()});
+    pinned_ids.push_back(object_id);
+
+    // A chain of objects without any copies.
+    object_id = ObjectID::FromRandom();
+    ref_counter_->AddOwnedObject(object_id,
+                                 {},
+                                 rpc::Address(),
+                                 "",
+                                 0,
+                                 true,
+                                 /*add_local_ref=*/true);
+    task_resubmitter_->AddTask(object_id.TaskId(), dependencies);
+    dependencies = {object_id};
+    lost_ids.push_back(object_id);
+  }
+
+  std::vector<ObjectID> object_ids = pinned_ids;
+  object_ids.push_back(lost_ids.back());
+  ASSERT_TRUE(manager_.RecoverObjects(object_ids).empty());
+  // The copies are pinned with a single request.
+  ASSERT_EQ(raylet_client_->callbacks.size(), 1);
+  ASSERT_EQ(raylet_client_->num_objects_pinned, 3);
+  ASSERT_EQ(raylet_client_->Flush(), 1);
+  // The whole lineage of the lost object is resubmitted.
+  ASSERT_EQ(task_resubmitter_->num_tasks_resubmitted, 3);
+  ASSERT_TRUE(failed_reconstructions_.empty());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
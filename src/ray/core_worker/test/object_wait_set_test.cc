@@ -0,0 +1,62 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/core_worker/object_wait_set.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace core {
+
+TEST(ObjectWaitSetTest, TestTakeInOrderAvailable) {
+  CoreWorkerMemoryStore memory_store;
+  const auto id1 = ObjectID::FromRandom();
+  const auto id2 = ObjectID::FromRandom();
+  const auto id3 = ObjectID::FromRandom();
+  ASSERT_TRUE(memory_store.Put(RayObject(rpc::ErrorType::TASK_EXECUTION_EXCEPTION), id2));
+  auto wait_set = ObjectWaitSet::Create(memory_store, {id1, id2, id3});
+  ASSERT_EQ(wait_set->NumRemaining(), 3);
+
+  // The object that was already in the store is available right away.
+  ASSERT_TRUE(wait_set->WaitAvailable(1, 0));
+  ASSERT_FALSE(wait_set->WaitAvailable(2, 0));
+  ASSERT_TRUE(memory_store.Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), id3));
+  ASSERT_TRUE(wait_set->WaitAvailable(2, 0));
+
+  auto available = wait_set->TakeAvailable();
+  ASSERT_EQ(available,
+            (std::vector<ObjectWaitSet::AvailableObject>{{id2, false}, {id3, true}}));
+  ASSERT_EQ(wait_set->NumRemaining(), 1);
+
+  // Objects put back are taken again first.
+  ASSERT_TRUE(memory_store.Put(RayObject(rpc::ErrorType::TASK_EXECUTION_EXCEPTION), id1));
+  wait_set->PutBack({{id3, true}});
+  ASSERT_EQ(wait_set->NumRemaining(), 2);
+  available = wait_set->TakeAvailable();
+  ASSERT_EQ(available,
+            (std::vector<ObjectWaitSet::AvailableObject>{{id3, true}, {id1, false}}));
+  ASSERT_EQ(wait_set->NumRemaining(), 0);
+}
+
+TEST(ObjectWaitSetTest, TestDestroyedBeforeAvailable) {
+  CoreWorkerMemoryStore memory_store;
+  const auto id = ObjectID::FromRandom();
+  auto wait_set = ObjectWaitSet::Create(memory_store, {id});
+  wait_set.reset();
+  // Make sure this doesn't crash.
+  ASSERT_TRUE(memory_store.Put(RayObject(rpc::ErrorType::TASK_EXECUTION_EXCEPTION), id));
+}
+
+}  // namespace core
+}  // namespace ray
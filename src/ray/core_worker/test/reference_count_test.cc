@@ -1398,6 +1398,71 @@ TEST(DistributedReferenceCountTest, TestNestedObjectDifferentOwners) {
   ASSERT_FALSE(owner->rc_.HasReference(owner_id1));
 }
 
+// Same as above, but the borrowers return their references in the compact
+// encoding.
+TEST(DistributedReferenceCountTest, TestNestedObjectDifferentOwnersCompactBorrowedRefs) {
+  auto borrower1 = std::make_shared<MockWorkerClient>("1");
+  auto borrower2 = std::make_shared<MockWorkerClient>("2");
+  auto owner = std::make_shared<MockWorkerClient>("3", [&](const rpc::Address &addr) {
+    if (addr.ip_address() == borrower1->address_.ip_address()) {
+      return borrower1;
+    } else {
+      return borrower2;
+    }
+  });
+  auto handle_submitted_task_finished = [](MockWorkerClient &worker,
+                                           const ObjectID &return_id,
+                                           const ObjectID &arg_id,
+                                           const rpc::Address &borrower_address,
+                                           ReferenceCounter::ReferenceTableProto refs) {
+    rpc::CompactObjectReferenceCounts compact_refs;
+    ReferenceCounter::CompactReferenceTableProto(&refs, &compact_refs);
+    ASSERT_TRUE(refs.empty());
+    worker.rc_.UpdateFinishedTaskReferences(
+        {return_id}, {arg_id}, false, borrower_address, refs, compact_refs, nullptr);
+  };
+
+  auto owner_id1 = ObjectID::FromRandom();
+  auto owner_id2 = ObjectID::FromRandom();
+  auto owner_id3 = ObjectID::FromRandom();
+  owner->Put(owner_id1);
+  owner->PutWrappedId(owner_id2, owner_id1);
+  owner->PutWrappedId(owner_id3, owner_id2);
+  auto return_id2 = owner->SubmitTaskWithArg(owner_id3);
+  owner->rc_.RemoveLocalReference(owner_id1, nullptr);
+  owner->rc_.RemoveLocalReference(owner_id2, nullptr);
+  owner->rc_.RemoveLocalReference(owner_id3, nullptr);
+
+  borrower1->ExecuteTaskWithArg(owner_id3, owner_id2, owner->address_);
+  auto borrower_id = ObjectID::FromRandom();
+  borrower1->PutWrappedId(borrower_id, owner_id2);
+  borrower1->rc_.RemoveLocalReference(owner_id2, nullptr);
+  auto return_id1 = borrower1->SubmitTaskWithArg(borrower_id);
+  borrower1->rc_.RemoveLocalReference(borrower_id, nullptr);
+  borrower2->ExecuteTaskWithArg(borrower_id, owner_id2, owner->address_);
+
+  borrower2->GetSerializedObjectId(owner_id2, owner_id1, owner->address_);
+  borrower2->rc_.RemoveLocalReference(owner_id2, nullptr);
+  auto borrower_refs = borrower2->FinishExecutingTask(borrower_id, ObjectID::Nil());
+  handle_submitted_task_finished(
+      *borrower1, return_id1, borrower_id, borrower2->address_, borrower_refs);
+  ASSERT_TRUE(borrower1->rc_.HasReference(owner_id1));
+
+  borrower_refs = borrower1->FinishExecutingTask(owner_id3, ObjectID::Nil());
+  ASSERT_FALSE(borrower1->rc_.HasReference(owner_id1));
+  handle_submitted_task_finished(
+      *owner, return_id2, owner_id3, borrower1->address_, borrower_refs);
+  ASSERT_TRUE(owner->rc_.HasReference(owner_id1));
+  ASSERT_FALSE(owner->rc_.HasReference(owner_id2));
+  ASSERT_FALSE(owner->rc_.HasReference(owner_id3));
+
+  borrower2->FlushBorrowerCallbacks();
+  ASSERT_TRUE(owner->rc_.HasReference(owner_id1));
+  borrower2->rc_.RemoveLocalReference(owner_id1, nullptr);
+  ASSERT_FALSE(borrower2->rc_.HasReference(owner_id1));
+  ASSERT_FALSE(owner->rc_.HasReference(owner_id1));
+}
+
 // A borrower is given a reference to an object ID, whose value contains
 // another object ID. The borrower passes the reference again to another
 // borrower but does not wait for it to finish. The nested borrower unwraps the
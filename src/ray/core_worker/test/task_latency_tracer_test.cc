@@ -0,0 +1,96 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/core_worker/task_latency_tracer.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace core {
+
+void RecordAllStages(TaskLatencyTracer &tracer, const TaskID &task_id) {
+  tracer.Record(task_id, TaskStage::SUBMITTED);
+  tracer.Record(task_id, TaskStage::DEPENDENCIES_RESOLVED);
+  tracer.Record(task_id, TaskStage::PUSHED);
+  tracer.Record(task_id, TaskStage::FINISHED);
+  tracer.Record(task_id, TaskStage::RETURNS_STORED);
+}
+
+TEST(TaskLatencyTracerTest, TestDisabled) {
+  TaskLatencyTracer tracer(/*sample_rate=*/0, /*capacity=*/10);
+  RecordAllStages(tracer, TaskID::FromRandom(JobID::FromInt(1)));
+  ASSERT_TRUE(tracer.GetRecentTraces().empty());
+}
+
+TEST(TaskLatencyTracerTest, TestTrace) {
+  TaskLatencyTracer tracer(/*sample_rate=*/1, /*capacity=*/10);
+  auto task_id = TaskID::FromRandom(JobID::FromInt(1));
+  RecordAllStages(tracer, task_id);
+
+  auto traces = tracer.GetRecentTraces();
+  ASSERT_EQ(traces.size(), 1);
+  ASSERT_EQ(traces[0].task_id, task_id);
+  for (size_t stage = 1; stage < traces[0].stage_times_ns.size(); stage++) {
+    ASSERT_GT(traces[0].stage_times_ns[stage - 1], 0);
+    ASSERT_GE(traces[0].stage_times_ns[stage], traces[0].stage_times_ns[stage - 1]);
+  }
+}
+
+TEST(TaskLatencyTracerTest, TestDiscard) {
+  TaskLatencyTracer tracer(/*sample_rate=*/1, /*capacity=*/10);
+  auto task_id = TaskID::FromRandom(JobID::FromInt(1));
+  tracer.Record(task_id, TaskStage::SUBMITTED);
+  tracer.Discard(task_id);
+  tracer.Record(task_id, TaskStage::RETURNS_STORED);
+  ASSERT_TRUE(tracer.GetRecentTraces().empty());
+
+  // A task that wasn't submitted isn't traced.
+  tracer.Record(task_id, TaskStage::FINISHED);
+  tracer.Record(task_id, TaskStage::RETURNS_STORED);
+  ASSERT_TRUE(tracer.GetRecentTraces().empty());
+}
+
+TEST(TaskLatencyTracerTest, TestRingBuffer) {
+  TaskLatencyTracer tracer(/*sample_rate=*/1, /*capacity=*/3);
+  std::vector<TaskID> task_ids;
+  for (int i = 0; i < 5; i++) {
+    task_ids.push_back(TaskID::FromRandom(JobID::FromInt(1)));
+    RecordAllStages(tracer, task_ids.back());
+  }
+
+  // Only the latest traces are kept, from the oldest to the newest.
+  auto traces = tracer.GetRecentTraces();
+  ASSERT_EQ(traces.size(), 3);
+  for (size_t i = 0; i < traces.size(); i++) {
+    ASSERT_EQ(traces[i].task_id, task_ids[i + 2]);
+  }
+}
+
+TEST(TaskLatencyTracerTest, TestSampling) {
+  TaskLatencyTracer tracer(/*sample_rate=*/0.5, /*capacity=*/1000);
+  for (int i = 0; i < 1000; i++) {
+    RecordAllStages(tracer, TaskID::FromRandom(JobID::FromInt(1)));
+  }
+  auto num_traces = tracer.GetRecentTraces().size();
+  ASSERT_GT(num_traces, 300);
+  ASSERT_LT(num_traces, 700);
+}
+
+}  // namespace core
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
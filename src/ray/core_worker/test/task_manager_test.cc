@@ -16,6 +16,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/task/task_spec.h"
 #include "ray/common/test_util.h"
 #include "ray/core_worker/reference_count.h"
@@ -130,6 +131,83 @@ TEST_F(TaskManagerTest, TestTaskSuccess) {
   ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 0);
 }
 
+TEST_F(TaskManagerTest, TestAddPendingTasks) {
+  rpc::Address caller_address;
+  ObjectID dep = ObjectID::FromRandom();
+  std::vector<TaskSpecification> specs = {CreateTaskHelper(1, {dep}),
+                                          CreateTaskHelper(1, {dep})};
+  auto returned_refs = manager_.AddPendingTasks(caller_address, specs, "");
+  ASSERT_EQ(returned_refs.size(), 2);
+  for (size_t i = 0; i < specs.size(); i++) {
+    ASSERT_TRUE(manager_.IsTaskPending(specs[i].TaskId()));
+    ASSERT_EQ(returned_refs[i].size(), 1);
+    ASSERT_EQ(returned_refs[i][0].object_id(), specs[i].ReturnId(0).Binary());
+  }
+  // The shared dependency and the return object of each task.
+  ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 3);
+
+  for (const auto &spec : specs) {
+    rpc::PushTaskReply reply;
+    auto return_object = reply.add_return_objects();
+    return_object->set_object_id(spec.ReturnId(0).Binary());
+    auto data = GenerateRandomBuffer();
+    return_object->set_data(data->Data(), data->Size());
+    manager_.CompletePendingTask(spec.TaskId(), reply, rpc::Address());
+    ASSERT_FALSE(manager_.IsTaskPending(spec.TaskId()));
+  }
+  // Only the return object references should remain.
+  ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 2);
+}
+
+TEST_F(TaskManagerTest, TestStreamingReturns) {
+  rpc::Address caller_address;
+  auto spec = CreateTaskHelper(1, {});
+  spec.GetMutableMessage().set_streaming_returns(true);
+  manager_.AddPendingTask(caller_address, spec, "");
+  WorkerContext ctx(WorkerType::WORKER, WorkerID::FromRandom(), JobID::FromInt(0));
+
+  auto report = [&](int64_t index) {
+    rpc::ReturnObject return_object;
+    return_object.set_object_id(spec.StreamingReturnId(index).Binary());
+    auto data = GenerateRandomBuffer();
+    return_object.set_data(data->Data(), data->Size());
+    return manager_.HandleStreamingReturn(
+        spec.TaskId(), index, return_object, rpc::Address());
+  };
+  rpc::ObjectReference ref;
+  bool finished = false;
+  ASSERT_FALSE(manager_.TryReadStreamingReturn(spec.TaskId(), &ref, &finished));
+  ASSERT_FALSE(finished);
+
+  // The results are read in order.
+  ASSERT_TRUE(report(1));
+  ASSERT_FALSE(manager_.TryReadStreamingReturn(spec.TaskId(), &ref, &finished));
+  ASSERT_TRUE(report(0));
+  for (int64_t index = 0; index < 2; index++) {
+    ASSERT_TRUE(manager_.TryReadStreamingReturn(spec.TaskId(), &ref, &finished));
+    auto object_id = ObjectID::FromBinary(ref.object_id());
+    ASSERT_EQ(object_id, spec.StreamingReturnId(index));
+    ASSERT_TRUE(reference_counter_->HasReference(object_id));
+    std::vector<std::shared_ptr<RayObject>> results;
+    RAY_CHECK_OK(store_->Get({object_id}, 1, -1, ctx, false, &results));
+    ASSERT_EQ(results.size(), 1);
+  }
+  // A result that was reported before is dropped.
+  ASSERT_FALSE(report(0));
+  ASSERT_FALSE(manager_.TryReadStreamingReturn(spec.TaskId(), &ref, &finished));
+  ASSERT_FALSE(finished);
+
+  rpc::PushTaskReply reply;
+  auto return_object = reply.add_return_objects();
+  return_object->set_object_id(spec.ReturnId(0).Binary());
+  manager_.CompletePendingTask(spec.TaskId(), reply, rpc::Address());
+  ASSERT_FALSE(report(2));
+  ASSERT_FALSE(manager_.TryReadStreamingReturn(spec.TaskId(), &ref, &finished));
+  ASSERT_TRUE(finished);
+  // The return object and the results that were read remain in scope.
+  ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 3);
+}
+
 TEST_F(TaskManagerTest, TestTaskFailure) {
   rpc::Address caller_address;
   ObjectID dep1 = ObjectID::FromRandom();
@@ -582,6 +660,46 @@ TEST_F(TaskManagerLineageTest, TestResubmitTask) {
   ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 0);
 }
 
+TEST_F(TaskManagerLineageTest, TestCompactLineageSpecs) {
+  RayConfig::instance().initialize(R"({"compact_lineage_specs": true})");
+  rpc::Address caller_address;
+  ObjectID dep1 = ObjectID::FromRandom();
+  ObjectID dep2 = ObjectID::FromRandom();
+  auto spec = CreateTaskHelper(1, {dep1, dep2});
+  auto return_id = spec.ReturnId(0);
+  manager_.AddPendingTask(caller_address, spec, "", /*max_retries=*/3);
+
+  // The task completes, and its spec is only kept as lineage.
+  rpc::PushTaskReply reply;
+  auto return_object = reply.add_return_objects();
+  return_object->set_object_id(return_id.Binary());
+  auto data = GenerateRandomBuffer();
+  return_object->set_data(data->Data(), data->Size());
+  return_object->set_in_plasma(true);
+  manager_.CompletePendingTask(spec.TaskId(), reply, rpc::Address());
+  ASSERT_GT(manager_.TotalLineageFootprintBytes(), 0);
+  auto lineage_spec = manager_.GetTaskSpec(spec.TaskId());
+  ASSERT_TRUE(lineage_spec.has_value());
+  ASSERT_TRUE(*lineage_spec == spec);
+
+  // The compacted spec can still be resubmitted.
+  std::vector<ObjectID> resubmitted_task_deps;
+  ASSERT_TRUE(manager_.ResubmitTask(spec.TaskId(), &resubmitted_task_deps));
+  ASSERT_EQ(resubmitted_task_deps, spec.GetDependencyIds());
+  ASSERT_EQ(num_retries_, 1);
+  ASSERT_EQ(manager_.TotalLineageFootprintBytes(), 0);
+
+  // The resubmitted task finishes, and the lineage is released once the return ID goes
+  // out of scope.
+  manager_.CompletePendingTask(spec.TaskId(), reply, rpc::Address());
+  ASSERT_GT(manager_.TotalLineageFootprintBytes(), 0);
+  reference_counter_->RemoveLocalReference(return_id, nullptr);
+  ASSERT_FALSE(manager_.GetTaskSpec(spec.TaskId()).has_value());
+  ASSERT_EQ(manager_.TotalLineageFootprintBytes(), 0);
+  ASSERT_EQ(reference_counter_->NumObjectIDsInScope(), 0);
+  RayConfig::instance().initialize("");
+}
+
 // Test resubmission for a task that was successfully executed once and stored
 // its return values in plasma. On re-execution, the task's return values
 // should be stored in plasma again, even if the worker returns its values
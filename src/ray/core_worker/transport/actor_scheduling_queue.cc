@@ -88,13 +88,23 @@ void ActorSchedulingQueue::Add(int64_t seq_no,
   }
   RAY_LOG(DEBUG) << "Enqueue " << seq_no << " cur seqno " << next_seq_no_;
 
-  pending_actor_tasks_[seq_no] = InboundRequest(std::move(accept_request),
-                                                std::move(reject_request),
-                                                std::move(send_reply_callback),
-                                                task_id,
-                                                dependencies.size() > 0,
-                                                concurrency_group_name,
-                                                function_descriptor);
+  InboundRequest request(std::move(accept_request),
+                         std::move(reject_request),
+                         std::move(send_reply_callback),
+                         task_id,
+                         dependencies.size() > 0,
+                         concurrency_group_name,
+                         function_descriptor);
+
+  if (seq_no == next_seq_no_ && dependencies.empty() && pending_actor_tasks_.empty()) {
+    // Fast path for a task that arrives in order with nothing queued before it. The
+    // queue is empty, so there's no stale request to cancel and no timer to reset.
+    next_seq_no_++;
+    AcceptRequest(request);
+    return;
+  }
+
+  pending_actor_tasks_[seq_no] = std::move(request);
 
   if (dependencies.size() > 0) {
     waiter_.Wait(dependencies, [seq_no, this]() {
@@ -130,51 +140,64 @@ void ActorSchedulingQueue::ScheduleRequests() {
     pending_actor_tasks_.erase(head);
   }
 
-  // Process as many in-order requests as we can.
-  while (!pending_actor_tasks_.empty() &&
-         pending_actor_tasks_.begin()->first == next_seq_no_ &&
-         pending_actor_tasks_.begin()->second.CanExecute()) {
-    auto head = pending_actor_tasks_.begin();
-    auto request = head->second;
-
-    if (is_asyncio_) {
-      // Process async actor task.
-      auto fiber = fiber_state_manager_->GetExecutor(request.ConcurrencyGroupName(),
-                                                     request.FunctionDescriptor());
-      fiber->EnqueueFiber([request]() mutable { request.Accept(); });
-    } else {
-      // Process actor tasks.
-      RAY_CHECK(pool_manager_ != nullptr);
-      auto pool = pool_manager_->GetExecutor(request.ConcurrencyGroupName(),
-                                             request.FunctionDescriptor());
-      if (pool == nullptr) {
-        request.Accept();
-      } else {
-        pool->PostBlocking([request]() mutable { request.Accept(); });
-      }
-    }
-    pending_actor_tasks_.erase(head);
+  // Take the contiguous range of in-order requests that can execute out of the queue
+  // at once, and then accept them in order.
+  std::vector<InboundRequest> ready;
+  auto it = pending_actor_tasks_.begin();
+  while (it != pending_actor_tasks_.end() && it->first == next_seq_no_ &&
+         it->second.CanExecute()) {
+    ready.push_back(std::move(it->second));
     next_seq_no_++;
+    it++;
+  }
+  pending_actor_tasks_.erase(pending_actor_tasks_.begin(), it);
+  for (auto &request : ready) {
+    AcceptRequest(request);
   }
 
   if (pending_actor_tasks_.empty() ||
       !pending_actor_tasks_.begin()->second.CanExecute()) {
     // No timeout for object dependency waits.
-    wait_timer_.cancel();
-  } else {
-    // Set a timeout on the queued tasks to avoid an infinite wait on failure.
+    if (wait_timer_seq_no_ != -1) {
+      wait_timer_.cancel();
+      wait_timer_seq_no_ = -1;
+    }
+  } else if (wait_timer_seq_no_ != next_seq_no_) {
+    // Set a timeout on the queued tasks to avoid an infinite wait on failure. The
+    // timer is only reset once the task it waits for has arrived.
     wait_timer_.expires_from_now(boost::posix_time::seconds(reorder_wait_seconds_));
+    wait_timer_seq_no_ = next_seq_no_;
     RAY_LOG(DEBUG) << "waiting for " << next_seq_no_ << " queue size "
                    << pending_actor_tasks_.size();
     wait_timer_.async_wait([this](const boost::system::error_code &error) {
       if (error == boost::asio::error::operation_aborted) {
         return;  // time deadline was adjusted
       }
+      wait_timer_seq_no_ = -1;
       OnSequencingWaitTimeout();
     });
   }
 }
 
+void ActorSchedulingQueue::AcceptRequest(InboundRequest &request) {
+  if (is_asyncio_) {
+    // Process async actor task.
+    auto fiber = fiber_state_manager_->GetExecutor(request.ConcurrencyGroupName(),
+                                                   request.FunctionDescriptor());
+    fiber->EnqueueFiber([request]() mutable { request.Accept(); });
+  } else {
+    // Process actor tasks.
+    RAY_CHECK(pool_manager_ != nullptr);
+    auto pool = pool_manager_->GetExecutor(request.ConcurrencyGroupName(),
+                                           request.FunctionDescriptor());
+    if (pool == nullptr) {
+      request.Accept();
+    } else {
+      pool->Post([request]() mutable { request.Accept(); });
+    }
+  }
+}
+
 /// Called when we time out waiting for an earlier task to show up.
 void ActorSchedulingQueue::OnSequencingWaitTimeout() {
   RAY_CHECK(boost::this_thread::get_id() == main_thread_id_);
@@ -77,6 +77,9 @@ class ActorSchedulingQueue : public SchedulingQueue {
   /// Called when we time out waiting for an earlier task to show up.
   void OnSequencingWaitTimeout();
 
+  /// Run a request on the executor of its concurrency group.
+  void AcceptRequest(InboundRequest &request);
+
   /// Max time in seconds to wait for dependencies to show up.
   const int64_t reorder_wait_seconds_ = 0;
   /// Sorted map of (accept, rej) task callbacks keyed by their sequence number.
@@ -86,6 +89,8 @@ class ActorSchedulingQueue : public SchedulingQueue {
   /// Timer for waiting on dependencies. Note that this is set on the task main
   /// io service, which is fine since it only ever fires if no tasks are running.
   boost::asio::deadline_timer wait_timer_;
+  /// The sequence number that the timer waits for, or -1 if it isn't set.
+  int64_t wait_timer_seq_no_ = -1;
   /// The id of the thread that constructed this scheduling queue.
   boost::thread::id main_thread_id_;
   /// Reference to the waiter owned by the task receiver.
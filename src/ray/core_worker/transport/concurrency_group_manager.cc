@@ -14,20 +14,51 @@
 
 #include "ray/core_worker/transport/concurrency_group_manager.h"
 
+#include "ray/common/ray_config.h"
 #include "ray/core_worker/fiber.h"
 #include "ray/core_worker/transport/thread_pool.h"
 
 namespace ray {
 namespace core {
 
+namespace {
+
+/// Executors that are created for the same manager share the thread pool, if the
+/// executor type supports it.
+class ExecutorFactory {
+ public:
+  template <typename ExecutorType>
+  std::shared_ptr<ExecutorType> Create(int32_t max_concurrency) {
+    return std::make_shared<ExecutorType>(max_concurrency);
+  }
+
+ private:
+  std::shared_ptr<WorkStealingThreadPool> shared_pool_;
+};
+
+template <>
+std::shared_ptr<BoundedExecutor> ExecutorFactory::Create<BoundedExecutor>(
+    int32_t max_concurrency) {
+  if (!RayConfig::instance().actor_work_stealing_executor()) {
+    return std::make_shared<BoundedExecutor>(max_concurrency);
+  }
+  if (shared_pool_ == nullptr) {
+    shared_pool_ = std::make_shared<WorkStealingThreadPool>();
+  }
+  return std::make_shared<BoundedExecutor>(max_concurrency, shared_pool_);
+}
+
+}  // namespace
+
 template <typename ExecutorType>
 ConcurrencyGroupManager<ExecutorType>::ConcurrencyGroupManager(
     const std::vector<ConcurrencyGroup> &concurrency_groups,
     const int32_t max_concurrency_for_default_concurrency_group) {
+  ExecutorFactory factory;
   for (auto &group : concurrency_groups) {
     const auto name = group.name;
     const auto max_concurrency = group.max_concurrency;
-    auto executor = std::make_shared<ExecutorType>(max_concurrency);
+    auto executor = factory.Create<ExecutorType>(max_concurrency);
     auto &fds = group.function_descriptors;
     for (auto fd : fds) {
       functions_to_executor_index_[fd->ToString()] = executor;
@@ -42,7 +73,7 @@ ConcurrencyGroupManager<ExecutorType>::ConcurrencyGroupManager(
   if (ExecutorType::NeedDefaultExecutor(max_concurrency_for_default_concurrency_group) ||
       !concurrency_groups.empty()) {
     defatult_executor_ =
-        std::make_shared<ExecutorType>(max_concurrency_for_default_concurrency_group);
+        factory.Create<ExecutorType>(max_concurrency_for_default_concurrency_group);
   }
 }
 
@@ -17,13 +17,15 @@
 namespace ray {
 namespace core {
 
-struct TaskState {
+struct LocalDependencyResolver::TaskState {
   TaskState(TaskSpecification t,
             absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> deps,
-            std::vector<ActorID> actor_ids)
+            std::vector<ActorID> actor_ids,
+            std::function<void(Status)> on_complete)
       : task(t),
         local_dependencies(std::move(deps)),
         actor_dependencies(std::move(actor_ids)),
+        on_complete(std::move(on_complete)),
         status(Status::OK()) {
     obj_dependencies_remaining = local_dependencies.size();
     actor_dependencies_remaining = actor_dependencies.size();
@@ -38,12 +40,15 @@ struct TaskState {
   /// map).
   size_t actor_dependencies_remaining;
   size_t obj_dependencies_remaining;
+  /// Called once all of the dependencies are resolved.
+  std::function<void(Status)> on_complete;
   Status status;
 };
 
 void InlineDependencies(
-    absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> dependencies,
+    const absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> &dependencies,
     TaskSpecification &task,
+    LocalityDataProviderInterface *locality_data_provider,
     std::vector<ObjectID> *inlined_dependency_ids,
     std::vector<ObjectID> *contained_ids) {
   auto &msg = task.GetMutableMessage();
@@ -72,6 +77,13 @@ void InlineDependencies(
             contained_ids->push_back(ObjectID::FromBinary(nested_ref.object_id()));
           }
           inlined_dependency_ids->push_back(id);
+        } else if (locality_data_provider != nullptr) {
+          // The object stays in plasma. Pass on its size if we know it, so that the
+          // raylet can admit the pull without waiting for the object's location.
+          if (auto locality_data = locality_data_provider->GetLocalityData(id)) {
+            mutable_arg->mutable_object_ref()->set_object_size(
+                locality_data->object_size);
+          }
         }
         found++;
       }
@@ -105,56 +117,91 @@ void LocalDependencyResolver::ResolveDependencies(
   }
 
   // This is deleted when the last dependency fetch callback finishes.
-  std::shared_ptr<TaskState> state = std::make_shared<TaskState>(
-      task, std::move(local_dependencies), std::move(actor_dependences));
+  std::shared_ptr<TaskState> state =
+      std::make_shared<TaskState>(task,
+                                  std::move(local_dependencies),
+                                  std::move(actor_dependences),
+                                  std::move(on_complete));
   num_pending_ += 1;
 
-  for (const auto &it : state->local_dependencies) {
-    const ObjectID &obj_id = it.first;
-    in_memory_store_.GetAsync(
-        obj_id, [this, state, obj_id, on_complete](std::shared_ptr<RayObject> obj) {
-          RAY_CHECK(obj != nullptr);
-          bool complete = false;
-          std::vector<ObjectID> inlined_dependency_ids;
-          std::vector<ObjectID> contained_ids;
-          {
-            absl::MutexLock lock(&mu_);
-            state->local_dependencies[obj_id] = std::move(obj);
-            if (--state->obj_dependencies_remaining == 0) {
-              InlineDependencies(state->local_dependencies,
-                                 state->task,
-                                 &inlined_dependency_ids,
-                                 &contained_ids);
-              if (state->actor_dependencies_remaining == 0) {
-                complete = true;
-                num_pending_ -= 1;
-              }
-            }
-          }
-          if (inlined_dependency_ids.size() > 0) {
-            task_finisher_.OnTaskDependenciesInlined(inlined_dependency_ids,
-                                                     contained_ids);
-          }
-          if (complete) {
-            on_complete(state->status);
-          }
-        });
+  std::vector<ObjectID> objects_to_fetch;
+  {
+    absl::MutexLock lock(&mu_);
+    for (const auto &it : state->local_dependencies) {
+      auto &waiting_tasks = pending_objects_[it.first];
+      if (waiting_tasks.empty()) {
+        objects_to_fetch.push_back(it.first);
+      }
+      waiting_tasks.push_back(state);
+    }
+  }
+  // The callbacks may run right away, so they're registered outside the lock.
+  for (const auto &obj_id : objects_to_fetch) {
+    in_memory_store_.GetAsync(obj_id, [this, obj_id](std::shared_ptr<RayObject> obj) {
+      OnObjectAvailable(obj_id, std::move(obj));
+    });
   }
 
   for (const auto &actor_id : state->actor_dependencies) {
     actor_creator_.AsyncWaitForActorRegisterFinish(
-        actor_id, [this, state, on_complete](const Status &status) {
+        actor_id, [this, state](const Status &status) {
           if (!status.ok()) {
             state->status = status;
           }
           if (--state->actor_dependencies_remaining == 0 &&
               state->obj_dependencies_remaining == 0) {
             num_pending_--;
-            on_complete(state->status);
+            state->on_complete(state->status);
           }
         });
   }
 }
 
+void LocalDependencyResolver::OnObjectAvailable(const ObjectID &object_id,
+                                                std::shared_ptr<RayObject> obj) {
+  RAY_CHECK(obj != nullptr);
+  struct ResolvedTask {
+    std::shared_ptr<TaskState> state;
+    std::vector<ObjectID> inlined_dependency_ids;
+    std::vector<ObjectID> contained_ids;
+    bool complete = false;
+  };
+  std::vector<ResolvedTask> resolved_tasks;
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = pending_objects_.find(object_id);
+    RAY_CHECK(it != pending_objects_.end());
+    const auto waiting_tasks = std::move(it->second);
+    pending_objects_.erase(it);
+    for (const auto &state : waiting_tasks) {
+      state->local_dependencies[object_id] = obj;
+      if (--state->obj_dependencies_remaining > 0) {
+        continue;
+      }
+      ResolvedTask resolved{state};
+      InlineDependencies(state->local_dependencies,
+                         state->task,
+                         locality_data_provider_,
+                         &resolved.inlined_dependency_ids,
+                         &resolved.contained_ids);
+      if (state->actor_dependencies_remaining == 0) {
+        resolved.complete = true;
+        num_pending_ -= 1;
+      }
+      resolved_tasks.push_back(std::move(resolved));
+    }
+  }
+
+  for (const auto &resolved : resolved_tasks) {
+    if (resolved.inlined_dependency_ids.size() > 0) {
+      task_finisher_.OnTaskDependenciesInlined(resolved.inlined_dependency_ids,
+                                               resolved.contained_ids);
+    }
+    if (resolved.complete) {
+      resolved.state->on_complete(resolved.state->status);
+    }
+  }
+}
+
 }  // namespace core
 }  // namespace ray
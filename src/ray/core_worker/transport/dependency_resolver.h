@@ -15,10 +15,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "ray/common/id.h"
 #include "ray/common/task/task_spec.h"
 #include "ray/core_worker/actor_creator.h"
+#include "ray/core_worker/lease_policy.h"
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
 #include "ray/core_worker/task_manager.h"
 
@@ -30,10 +34,12 @@ class LocalDependencyResolver {
  public:
   LocalDependencyResolver(CoreWorkerMemoryStore &store,
                           TaskFinisherInterface &task_finisher,
-                          ActorCreatorInterface &actor_creator)
+                          ActorCreatorInterface &actor_creator,
+                          LocalityDataProviderInterface *locality_data_provider = nullptr)
       : in_memory_store_(store),
         task_finisher_(task_finisher),
         actor_creator_(actor_creator),
+        locality_data_provider_(locality_data_provider),
         num_pending_(0) {}
 
   /// Resolve all local and remote dependencies for the task, calling the specified
@@ -52,6 +58,12 @@ class LocalDependencyResolver {
   int NumPendingTasks() const { return num_pending_; }
 
  private:
+  struct TaskState;
+
+  /// Resolve an object for all of the tasks that wait on it, and complete the ones
+  /// that no longer wait on anything.
+  void OnObjectAvailable(const ObjectID &object_id, std::shared_ptr<RayObject> obj);
+
   /// The in-memory store.
   CoreWorkerMemoryStore &in_memory_store_;
 
@@ -59,11 +71,22 @@ class LocalDependencyResolver {
   TaskFinisherInterface &task_finisher_;
 
   ActorCreatorInterface &actor_creator_;
+
+  /// Used to attach the known sizes of the arguments that stay in plasma to the task
+  /// spec. May be nullptr.
+  LocalityDataProviderInterface *locality_data_provider_;
+
   /// Number of tasks pending dependency resolution.
   std::atomic<int> num_pending_;
 
   /// Protects against concurrent access to internal state.
   absl::Mutex mu_;
+
+  /// The tasks that wait on each object. A single callback is registered with the
+  /// in-memory store per object, however many tasks wait on it, and it resolves the
+  /// object for all of them at once.
+  absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<TaskState>>>
+      pending_objects_ GUARDED_BY(mu_);
 };
 
 }  // namespace core
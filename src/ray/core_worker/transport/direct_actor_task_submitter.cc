@@ -401,29 +401,37 @@ void CoreWorkerDirectActorTaskSubmitter::PushActorTask(ClientQueue &queue,
     warn_excess_queueing_(actor_id, num_queued);
     next_queueing_warn_threshold_ *= 2;
   }
+  task_finisher_.MarkTaskPushed(task_id);
 
   rpc::Address addr(queue.rpc_client->Addr());
+  // NOTE: `reply_callback` is called outside of `mu_`. On success, the task is already
+  // marked completed in the queue by `wrapped_callback`, which does it under the same
+  // lock as it removes the inflight callback. Otherwise, including when the callback
+  // is called by `FailInflightTasks`, `reply_callback` does it itself.
   rpc::ClientCallback<rpc::PushTaskReply> reply_callback =
       [this, addr, task_id, actor_id, actor_counter, task_spec, task_skipped](
           const Status &status, const rpc::PushTaskReply &reply) {
+        if (status.ok()) {
+          if (!task_skipped) {
+            task_finisher_.CompletePendingTask(task_id, reply, addr);
+          }
+          return;
+        }
+
         /// Whether or not we will retry this actor task.
         auto will_retry = false;
-
+        absl::MutexLock lock(&mu_);
+        auto queue_pair = client_queues_.find(actor_id);
+        RAY_CHECK(queue_pair != client_queues_.end());
+        auto &queue = queue_pair->second;
         if (task_skipped) {
           // NOTE(simon):Increment the task counter regardless of the status because the
           // reply for a previously completed task. We are not calling CompletePendingTask
           // because the tasks are pushed directly to the actor, not placed on any queues
           // in task_finisher_.
-        } else if (status.ok()) {
-          task_finisher_.CompletePendingTask(task_id, reply, addr);
         } else {
           // push task failed due to network error. For example, actor is dead
           // and no process response for the push task.
-          absl::MutexLock lock(&mu_);
-          auto queue_pair = client_queues_.find(actor_id);
-          RAY_CHECK(queue_pair != client_queues_.end());
-          auto &queue = queue_pair->second;
-
           bool is_actor_dead = (queue.state == rpc::ActorTableData::DEAD);
           const auto &death_cause = queue.death_cause;
           const auto &error_info = GetErrorInfoFromActorDeathCause(death_cause);
@@ -452,21 +460,16 @@ void CoreWorkerDirectActorTaskSubmitter::PushActorTask(ClientQueue &queue,
                 << ", wait queue size=" << queue.wait_for_death_info_tasks.size();
           }
         }
-        {
-          absl::MutexLock lock(&mu_);
-          auto queue_pair = client_queues_.find(actor_id);
-          RAY_CHECK(queue_pair != client_queues_.end());
-          auto &queue = queue_pair->second;
-          if (!will_retry) {
-            queue.actor_submit_queue->MarkTaskCompleted(actor_counter, task_spec);
-          }
-          queue.cur_pending_calls--;
+        if (!will_retry) {
+          queue.actor_submit_queue->MarkTaskCompleted(actor_counter, task_spec);
         }
+        queue.cur_pending_calls--;
       };
 
   queue.inflight_task_callbacks.emplace(task_id, std::move(reply_callback));
   rpc::ClientCallback<rpc::PushTaskReply> wrapped_callback =
-      [this, task_id, actor_id](const Status &status, const rpc::PushTaskReply &reply) {
+      [this, task_id, actor_id, actor_counter, task_spec](
+          const Status &status, const rpc::PushTaskReply &reply) {
         rpc::ClientCallback<rpc::PushTaskReply> reply_callback;
         {
           absl::MutexLock lock(&mu_);
@@ -481,6 +484,10 @@ void CoreWorkerDirectActorTaskSubmitter::PushActorTask(ClientQueue &queue,
           }
           reply_callback = std::move(callback_it->second);
           queue.inflight_task_callbacks.erase(callback_it);
+          if (status.ok()) {
+            queue.actor_submit_queue->MarkTaskCompleted(actor_counter, task_spec);
+            queue.cur_pending_calls--;
+          }
         }
         reply_callback(status, reply);
       };
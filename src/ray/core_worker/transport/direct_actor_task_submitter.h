@@ -72,9 +72,10 @@ class CoreWorkerDirectActorTaskSubmitter
       TaskFinisherInterface &task_finisher,
       ActorCreatorInterface &actor_creator,
       std::function<void(const ActorID &, int64_t)> warn_excess_queueing,
-      instrumented_io_context &io_service)
+      instrumented_io_context &io_service,
+      LocalityDataProviderInterface *locality_data_provider = nullptr)
       : core_worker_client_pool_(core_worker_client_pool),
-        resolver_(store, task_finisher, actor_creator),
+        resolver_(store, task_finisher, actor_creator, locality_data_provider),
         task_finisher_(task_finisher),
         warn_excess_queueing_(warn_excess_queueing),
         io_service_(io_service) {
@@ -99,6 +99,13 @@ void CoreWorkerDirectTaskReceiver::HandleTask(
                                 reply->mutable_borrowed_refs(),
                                 &is_application_level_error);
     reply->set_is_application_level_error(is_application_level_error);
+    const int64_t compact_borrowed_refs_threshold =
+        RayConfig::instance().compact_borrowed_refs_threshold();
+    if (compact_borrowed_refs_threshold > 0 &&
+        reply->borrowed_refs_size() >= compact_borrowed_refs_threshold) {
+      ReferenceCounter::CompactReferenceTableProto(
+          reply->mutable_borrowed_refs(), reply->mutable_compact_borrowed_refs());
+    }
 
     bool objects_valid = return_objects.size() == num_returns;
     if (objects_valid) {
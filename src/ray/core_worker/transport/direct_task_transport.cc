@@ -48,6 +48,8 @@ Status CoreWorkerDirectTaskSubmitter::SubmitTask(TaskSpecification task_spec) {
               // Copy the actor's reply to the GCS for ref counting purposes.
               rpc::PushTaskReply push_task_reply;
               push_task_reply.mutable_borrowed_refs()->CopyFrom(reply.borrowed_refs());
+              push_task_reply.mutable_compact_borrowed_refs()->CopyFrom(
+                  reply.compact_borrowed_refs());
               task_finisher_->CompletePendingTask(
                   task_id, push_task_reply, reply.actor_address());
             } else {
@@ -80,23 +82,32 @@ Status CoreWorkerDirectTaskSubmitter::SubmitTask(TaskSpecification task_spec) {
         scheduling_key_entry.task_queue.push_back(task_spec);
         scheduling_key_entry.resource_spec = task_spec;
 
-        if (!scheduling_key_entry.AllWorkersBusy()) {
-          // There are idle workers, so we don't need more
-          // workers.
-
-          for (auto active_worker_addr : scheduling_key_entry.active_workers) {
+        if (!scheduling_key_entry.AllPipelinesToWorkersFull(
+                max_tasks_in_flight_per_worker_)) {
+          // There are workers with room for more tasks, so push the task to the one
+          // with the fewest tasks in flight.
+          const rpc::WorkerAddress *least_busy_worker_addr = nullptr;
+          uint32_t least_tasks_in_flight = max_tasks_in_flight_per_worker_;
+          for (const auto &active_worker_addr : scheduling_key_entry.active_workers) {
             RAY_CHECK(worker_to_lease_entry_.find(active_worker_addr) !=
                       worker_to_lease_entry_.end());
-            auto &lease_entry = worker_to_lease_entry_[active_worker_addr];
-            if (!lease_entry.is_busy) {
-              OnWorkerIdle(active_worker_addr,
-                           scheduling_key,
-                           /*was_error*/ false,
-                           /*worker_exiting*/ false,
-                           lease_entry.assigned_resources);
-              break;
+            const auto &lease_entry = worker_to_lease_entry_[active_worker_addr];
+            if (lease_entry.tasks_in_flight < least_tasks_in_flight) {
+              least_busy_worker_addr = &active_worker_addr;
+              least_tasks_in_flight = lease_entry.tasks_in_flight;
             }
           }
+          if (least_busy_worker_addr != nullptr) {
+            const auto active_worker_addr = *least_busy_worker_addr;
+            OnWorkerIdle(active_worker_addr,
+                         scheduling_key,
+                         /*was_error*/ false,
+                         /*worker_exiting*/ false,
+                         worker_to_lease_entry_[active_worker_addr].assigned_resources);
+          }
+        }
+        if (reuse_leases_across_scheduling_classes_) {
+          ReuseLingeringWorker(scheduling_key);
         }
         RequestNewWorkerIfNeeded(scheduling_key);
       }
@@ -119,6 +130,7 @@ void CoreWorkerDirectTaskSubmitter::AddWorkerLeaseClient(
   LeaseEntry new_lease_entry =
       LeaseEntry(std::move(lease_client), expiration, assigned_resources, scheduling_key);
   worker_to_lease_entry_.emplace(addr, new_lease_entry);
+  lease_policy_->OnLeaseGranted(addr.raylet_id);
 
   auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
   RAY_CHECK(scheduling_key_entry.active_workers.emplace(addr).second);
@@ -135,7 +147,10 @@ void CoreWorkerDirectTaskSubmitter::ReturnWorker(const rpc::WorkerAddress addr,
   RAY_CHECK(scheduling_key_entry.active_workers.size() >= 1);
   auto &lease_entry = worker_to_lease_entry_[addr];
   RAY_CHECK(lease_entry.lease_client);
-  RAY_CHECK(!lease_entry.is_busy);
+  RAY_CHECK_EQ(lease_entry.tasks_in_flight, 0u);
+  if (lease_entry.linger_timer) {
+    lease_entry.linger_timer->cancel();
+  }
 
   // Decrement the number of active workers consuming tasks from the queue associated
   // with the current scheduling_key
@@ -151,6 +166,7 @@ void CoreWorkerDirectTaskSubmitter::ReturnWorker(const rpc::WorkerAddress addr,
   if (!status.ok()) {
     RAY_LOG(ERROR) << "Error returning worker to raylet: " << status.ToString();
   }
+  lease_policy_->OnLeaseReturned(addr.raylet_id);
   worker_to_lease_entry_.erase(addr);
 }
 
@@ -165,6 +181,13 @@ void CoreWorkerDirectTaskSubmitter::OnWorkerIdle(
     return;
   }
 
+  // Remember an error, so that the worker isn't reused while other tasks are in flight
+  // to it.
+  lease_entry.was_error = lease_entry.was_error || was_error;
+  lease_entry.worker_exiting = lease_entry.worker_exiting || worker_exiting;
+  was_error = lease_entry.was_error;
+  worker_exiting = lease_entry.worker_exiting;
+
   auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
   auto &current_queue = scheduling_key_entry.task_queue;
   // Return the worker if there was an error executing the previous task,
@@ -175,22 +198,48 @@ void CoreWorkerDirectTaskSubmitter::OnWorkerIdle(
       current_queue.empty()) {
     RAY_CHECK(scheduling_key_entry.active_workers.size() >= 1);
 
-    // Return the worker only if there are no tasks to do.
-    if (!lease_entry.is_busy) {
-      ReturnWorker(addr, was_error, worker_exiting, scheduling_key);
+    // Return the worker only if there are no tasks in flight.
+    if (lease_entry.tasks_in_flight == 0) {
+      const bool can_reuse = !was_error && !worker_exiting &&
+                             current_time_ms() <= lease_entry.lease_expiration_time;
+      if (can_reuse && reuse_leases_across_scheduling_classes_) {
+        const auto new_scheduling_key = MoveIdleWorkerToQueuedTasks(addr, scheduling_key);
+        if (new_scheduling_key.has_value()) {
+          OnWorkerIdle(addr,
+                       *new_scheduling_key,
+                       /*was_error*/ false,
+                       /*worker_exiting*/ false,
+                       assigned_resources);
+          return;
+        }
+      }
+      if (can_reuse && lease_idle_linger_ms_ > 0 && cancel_retry_timer_.has_value()) {
+        LingerWorker(addr);
+      } else {
+        ReturnWorker(addr, was_error, worker_exiting, scheduling_key);
+      }
     }
   } else {
+    if (lease_entry.linger_timer) {
+      lease_entry.linger_timer->cancel();
+      lease_entry.linger_timer.reset();
+    }
     auto &client = *client_cache_->GetOrConnect(addr.ToProto());
 
-    while (!current_queue.empty() && !lease_entry.is_busy) {
+    // Push tasks until the pipeline to the worker is full. The worker runs them one
+    // at a time, in the order they were pushed.
+    while (!current_queue.empty() &&
+           !lease_entry.PipelineToWorkerFull(max_tasks_in_flight_per_worker_)) {
       auto task_spec = current_queue.front();
-      lease_entry.is_busy = true;
+      if (lease_entry.tasks_in_flight == 0) {
+        RAY_CHECK(scheduling_key_entry.active_workers.size() >= 1);
+        scheduling_key_entry.num_busy_workers++;
+      }
+      lease_entry.tasks_in_flight++;
 
       // Increment the total number of tasks in flight to any worker associated with the
       // current scheduling_key
-
-      RAY_CHECK(scheduling_key_entry.active_workers.size() >= 1);
-      scheduling_key_entry.num_busy_workers++;
+      scheduling_key_entry.total_tasks_in_flight++;
 
       executing_tasks_.emplace(task_spec.TaskId(), addr);
       PushNormalTask(addr, client, scheduling_key, task_spec, assigned_resources);
@@ -202,6 +251,98 @@ void CoreWorkerDirectTaskSubmitter::OnWorkerIdle(
   RequestNewWorkerIfNeeded(scheduling_key);
 }
 
+bool CoreWorkerDirectTaskSubmitter::CanShareLease(
+    const SchedulingKey &scheduling_key, const SchedulingKey &other_scheduling_key) {
+  if (!std::get<2>(scheduling_key).IsNil() || !std::get<2>(other_scheduling_key).IsNil() ||
+      std::get<3>(scheduling_key) != std::get<3>(other_scheduling_key)) {
+    return false;
+  }
+  const auto &descriptor =
+      TaskSpecification::GetSchedulingClassDescriptor(std::get<0>(scheduling_key));
+  const auto &other_descriptor =
+      TaskSpecification::GetSchedulingClassDescriptor(std::get<0>(other_scheduling_key));
+  return descriptor.resource_set == other_descriptor.resource_set &&
+         descriptor.scheduling_strategy == other_descriptor.scheduling_strategy &&
+         descriptor.depth == other_descriptor.depth;
+}
+
+absl::optional<SchedulingKey>
+CoreWorkerDirectTaskSubmitter::MoveIdleWorkerToQueuedTasks(
+    const rpc::WorkerAddress &addr, const SchedulingKey &scheduling_key) {
+  absl::optional<SchedulingKey> new_scheduling_key;
+  for (const auto &scheduling_key_and_entry : scheduling_key_entries_) {
+    if (scheduling_key_and_entry.first != scheduling_key &&
+        !scheduling_key_and_entry.second.task_queue.empty() &&
+        CanShareLease(scheduling_key, scheduling_key_and_entry.first)) {
+      new_scheduling_key = scheduling_key_and_entry.first;
+      break;
+    }
+  }
+  if (!new_scheduling_key.has_value()) {
+    return absl::nullopt;
+  }
+
+  RAY_LOG(DEBUG) << "Reusing idle worker " << addr.worker_id
+                 << " for the tasks of another scheduling class";
+  auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
+  scheduling_key_entry.active_workers.erase(addr);
+  if (scheduling_key_entry.CanDelete()) {
+    scheduling_key_entries_.erase(scheduling_key);
+  }
+  RAY_CHECK(
+      scheduling_key_entries_[*new_scheduling_key].active_workers.emplace(addr).second);
+  worker_to_lease_entry_[addr].scheduling_key = *new_scheduling_key;
+  return new_scheduling_key;
+}
+
+void CoreWorkerDirectTaskSubmitter::ReuseLingeringWorker(
+    const SchedulingKey &scheduling_key) {
+  if (scheduling_key_entries_[scheduling_key].task_queue.empty()) {
+    return;
+  }
+  for (const auto &addr_and_lease_entry : worker_to_lease_entry_) {
+    const auto &lease_entry = addr_and_lease_entry.second;
+    if (lease_entry.linger_timer && lease_entry.tasks_in_flight == 0 &&
+        CanShareLease(lease_entry.scheduling_key, scheduling_key)) {
+      // The worker has no tasks of its own scheduling key queued, so this moves it to
+      // the queued tasks it can run.
+      const auto addr = addr_and_lease_entry.first;
+      const auto lingering_scheduling_key = lease_entry.scheduling_key;
+      OnWorkerIdle(addr,
+                   lingering_scheduling_key,
+                   /*was_error*/ false,
+                   /*worker_exiting*/ false,
+                   lease_entry.assigned_resources);
+      return;
+    }
+  }
+}
+
+void CoreWorkerDirectTaskSubmitter::LingerWorker(const rpc::WorkerAddress &addr) {
+  auto &lease_entry = worker_to_lease_entry_[addr];
+  if (lease_entry.linger_timer) {
+    lease_entry.linger_timer->cancel();
+  }
+  auto timer =
+      std::make_shared<boost::asio::steady_timer>(cancel_retry_timer_->get_executor());
+  timer->expires_after(std::chrono::milliseconds(lease_idle_linger_ms_));
+  lease_entry.linger_timer = timer;
+  timer->async_wait([this, addr, timer](const boost::system::error_code &error) {
+    if (error == boost::asio::error::operation_aborted) {
+      return;
+    }
+    absl::MutexLock lock(&mu_);
+    auto it = worker_to_lease_entry_.find(addr);
+    if (it == worker_to_lease_entry_.end() || it->second.linger_timer != timer) {
+      // The worker was reused or returned in the meantime.
+      return;
+    }
+    it->second.linger_timer.reset();
+    const auto scheduling_key = it->second.scheduling_key;
+    ReturnWorker(addr, /*was_error*/ false, /*worker_exiting*/ false, scheduling_key);
+  });
+}
+
 void CoreWorkerDirectTaskSubmitter::CancelWorkerLeaseIfNeeded(
     const SchedulingKey &scheduling_key) {
   auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
@@ -309,14 +450,13 @@ void CoreWorkerDirectTaskSubmitter::RequestNewWorkerIfNeeded(
     const SchedulingKey &scheduling_key, const rpc::Address *raylet_address) {
   auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
 
-  if (scheduling_key_entry.pending_lease_requests.size() ==
-      max_pending_lease_requests_per_scheduling_category_) {
+  const size_t max_pending_lease_requests =
+      lease_request_rate_limiter_->GetMaxPendingLeaseRequestsPerSchedulingCategory();
+  if (scheduling_key_entry.pending_lease_requests.size() >= max_pending_lease_requests) {
     RAY_LOG(DEBUG) << "Exceeding the pending request limit "
-                   << max_pending_lease_requests_per_scheduling_category_;
+                   << max_pending_lease_requests;
     return;
   }
-  RAY_CHECK(scheduling_key_entry.pending_lease_requests.size() <
-            max_pending_lease_requests_per_scheduling_category_);
 
   if (!scheduling_key_entry.AllWorkersBusy()) {
     // There are idle workers, so we don't need more.
@@ -340,9 +480,9 @@ void CoreWorkerDirectTaskSubmitter::RequestNewWorkerIfNeeded(
   num_leases_requested_++;
   // Create a TaskSpecification with an overwritten TaskID to make sure we don't reuse the
   // same TaskID to request a worker
-  auto resource_spec_msg = scheduling_key_entry.resource_spec.GetMutableMessage();
+  auto resource_spec_msg = scheduling_key_entry.resource_spec.GetMessage();
   resource_spec_msg.set_task_id(TaskID::FromRandom(job_id_).Binary());
-  const TaskSpecification resource_spec = TaskSpecification(resource_spec_msg);
+  const TaskSpecification resource_spec = TaskSpecification(std::move(resource_spec_msg));
   rpc::Address best_node_address;
   const bool is_spillback = (raylet_address != nullptr);
   bool is_selected_based_on_locality = false;
@@ -537,6 +677,7 @@ void CoreWorkerDirectTaskSubmitter::PushNormalTask(
   request->mutable_task_spec()->CopyFrom(task_spec.GetMessage());
   request->mutable_resource_mapping()->CopyFrom(assigned_resources);
   request->set_intended_worker_id(addr.worker_id.Binary());
+  task_finisher_->MarkTaskPushed(task_id);
   client.PushNormalTask(
       std::move(request),
       [this,
@@ -555,15 +696,19 @@ void CoreWorkerDirectTaskSubmitter::PushNormalTask(
 
           // Decrement the number of tasks in flight to the worker
           auto &lease_entry = worker_to_lease_entry_[addr];
-          RAY_CHECK(lease_entry.is_busy);
-          lease_entry.is_busy = false;
+          RAY_CHECK_GE(lease_entry.tasks_in_flight, 1u);
+          lease_entry.tasks_in_flight--;
 
           // Decrement the total number of tasks in flight to any worker with the current
           // scheduling_key.
           auto &scheduling_key_entry = scheduling_key_entries_[scheduling_key];
           RAY_CHECK_GE(scheduling_key_entry.active_workers.size(), 1u);
-          RAY_CHECK_GE(scheduling_key_entry.num_busy_workers, 1u);
-          scheduling_key_entry.num_busy_workers--;
+          RAY_CHECK_GE(scheduling_key_entry.total_tasks_in_flight, 1u);
+          scheduling_key_entry.total_tasks_in_flight--;
+          if (lease_entry.tasks_in_flight == 0) {
+            RAY_CHECK_GE(scheduling_key_entry.num_busy_workers, 1u);
+            scheduling_key_entry.num_busy_workers--;
+          }
 
           if (!status.ok() || !is_actor_creation || reply.worker_exiting()) {
             // Successful actor creation leases the worker indefinitely from the raylet.
@@ -19,10 +19,12 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/id.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/common/ray_object.h"
 #include "ray/core_worker/actor_manager.h"
 #include "ray/core_worker/context.h"
 #include "ray/core_worker/lease_policy.h"
+#include "ray/core_worker/lease_request_rate_limiter.h"
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
 #include "ray/core_worker/task_manager.h"
 #include "ray/core_worker/transport/dependency_resolver.h"
@@ -71,12 +73,20 @@ class CoreWorkerDirectTaskSubmitter {
       const JobID &job_id,
       absl::optional<boost::asio::steady_timer> cancel_timer = absl::nullopt,
       uint64_t max_pending_lease_requests_per_scheduling_category =
-          ::RayConfig::instance().max_pending_lease_requests_per_scheduling_category())
+          ::RayConfig::instance().max_pending_lease_requests_per_scheduling_category(),
+      uint32_t max_tasks_in_flight_per_worker =
+          ::RayConfig::instance().max_tasks_in_flight_per_worker(),
+      std::shared_ptr<LeaseRequestRateLimiter> lease_request_rate_limiter = nullptr,
+      bool reuse_leases_across_classes =
+          ::RayConfig::instance().worker_lease_reuse_across_scheduling_classes(),
+      int64_t lease_idle_linger_ms =
+          ::RayConfig::instance().worker_lease_idle_linger_ms(),
+      LocalityDataProviderInterface *locality_data_provider = nullptr)
       : rpc_address_(rpc_address),
         local_lease_client_(lease_client),
         lease_client_factory_(lease_client_factory),
         lease_policy_(std::move(lease_policy)),
-        resolver_(*store, *task_finisher, *actor_creator),
+        resolver_(*store, *task_finisher, *actor_creator, locality_data_provider),
         task_finisher_(task_finisher),
         lease_timeout_ms_(lease_timeout_ms),
         local_raylet_id_(local_raylet_id),
@@ -84,9 +94,17 @@ class CoreWorkerDirectTaskSubmitter {
         actor_creator_(actor_creator),
         client_cache_(core_worker_client_pool),
         job_id_(job_id),
-        max_pending_lease_requests_per_scheduling_category_(
-            max_pending_lease_requests_per_scheduling_category),
-        cancel_retry_timer_(std::move(cancel_timer)) {}
+        lease_request_rate_limiter_(
+            lease_request_rate_limiter
+                ? std::move(lease_request_rate_limiter)
+                : std::make_shared<StaticLeaseRequestRateLimiter>(
+                      max_pending_lease_requests_per_scheduling_category)),
+        max_tasks_in_flight_per_worker_(max_tasks_in_flight_per_worker),
+        reuse_leases_across_scheduling_classes_(reuse_leases_across_classes),
+        lease_idle_linger_ms_(lease_idle_linger_ms),
+        cancel_retry_timer_(std::move(cancel_timer)) {
+    RAY_CHECK_GE(max_tasks_in_flight_per_worker_, 1u);
+  }
 
   /// Schedule a task for direct submission to a worker.
   ///
@@ -185,6 +203,31 @@ class CoreWorkerDirectTaskSubmitter {
                     bool worker_exiting,
                     const SchedulingKey &scheduling_key) EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  /// Whether a worker leased for the tasks of one scheduling key can run the tasks of
+  /// another. The tasks must need the same resources, scheduling strategy, depth and
+  /// runtime env, and must not create actors. Their plasma dependencies may differ,
+  /// in which case the worker fetches them itself.
+  static bool CanShareLease(const SchedulingKey &scheduling_key,
+                            const SchedulingKey &other_scheduling_key);
+
+  /// Move an idle worker to the first scheduling key that it can run queued tasks of.
+  ///
+  /// 
+eturn The new scheduling key of the worker, or nullopt if there is no such
+  /// key.
+  absl::optional<SchedulingKey> MoveIdleWorkerToQueuedTasks(
+      const rpc::WorkerAddress &addr, const SchedulingKey &scheduling_key)
+      EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// Push the tasks of a scheduling key to a lingering worker of another scheduling
+  /// key that can run them, if there is one.
+  void ReuseLingeringWorker(const SchedulingKey &scheduling_key)
+      EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// Keep an idle worker leased for lease_idle_linger_ms_, and return it to the
+  /// raylet then if it's still idle.
+  void LingerWorker(const rpc::WorkerAddress &addr) EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   /// Check that the scheduling_key_entries_ hashmap is empty.
   inline bool CheckNoSchedulingKeyEntries() const EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     return scheduling_key_entries_.empty();
@@ -237,6 +280,7 @@ class CoreWorkerDirectTaskSubmitter {
 
   // Protects task submission state below.
   absl::Mutex mu_;
+  TrackedMutexName mu_name_{&mu_, "CoreWorkerDirectTaskSubmitter::mu_"};
 
   /// Cache of gRPC clients to other workers.
   std::shared_ptr<rpc::CoreWorkerClientPool> client_cache_;
@@ -244,21 +288,38 @@ class CoreWorkerDirectTaskSubmitter {
   /// The ID of the job.
   const JobID job_id_;
 
-  // Max number of pending lease requests per SchedulingKey.
-  const uint64_t max_pending_lease_requests_per_scheduling_category_;
+  // Limits the number of pending lease requests per SchedulingKey.
+  std::shared_ptr<LeaseRequestRateLimiter> lease_request_rate_limiter_;
+
+  // Max number of tasks in flight to a leased worker.
+  const uint32_t max_tasks_in_flight_per_worker_;
+
+  // Whether idle workers may run the queued tasks of other scheduling keys that need
+  // the same resources.
+  const bool reuse_leases_across_scheduling_classes_;
+
+  // How long idle workers are kept leased before they are returned. Lingering needs
+  // cancel_retry_timer_, whose executor runs the linger timers.
+  const int64_t lease_idle_linger_ms_;
 
   /// A LeaseEntry struct is used to condense the metadata about a single executor:
   /// (1) The lease client through which the worker should be returned
   /// (2) The expiration time of a worker's lease.
-  /// (3) Whether the worker has assigned task to do.
+  /// (3) The number of tasks in flight to the worker.
+  /// (4) Whether a task failed on the worker or the worker is exiting, in which case
+  ///     it's returned once the tasks in flight to it finish.
   /// (5) The resources assigned to the worker
   /// (6) The SchedulingKey assigned to tasks that will be sent to the worker
+  /// (7) The timer that returns the worker if it's lingering, idle
   struct LeaseEntry {
     std::shared_ptr<WorkerLeaseInterface> lease_client;
     int64_t lease_expiration_time;
-    bool is_busy = false;
+    uint32_t tasks_in_flight = 0;
+    bool was_error = false;
+    bool worker_exiting = false;
     google::protobuf::RepeatedPtrField<rpc::ResourceMapEntry> assigned_resources;
     SchedulingKey scheduling_key;
+    std::shared_ptr<boost::asio::steady_timer> linger_timer;
 
     LeaseEntry(
         std::shared_ptr<WorkerLeaseInterface> lease_client = nullptr,
@@ -271,6 +332,11 @@ class CoreWorkerDirectTaskSubmitter {
           lease_expiration_time(lease_expiration_time),
           assigned_resources(assigned_resources),
           scheduling_key(scheduling_key) {}
+
+    // Check whether the worker has as many tasks in flight as it can be pushed.
+    inline bool PipelineToWorkerFull(uint32_t max_tasks_in_flight_per_worker) const {
+      return tasks_in_flight >= max_tasks_in_flight_per_worker;
+    }
   };
 
   // Map from worker address to a LeaseEntry struct containing the lease's metadata.
@@ -290,13 +356,16 @@ class CoreWorkerDirectTaskSubmitter {
         absl::flat_hash_set<rpc::WorkerAddress>();
     // Keep track of how many workers have tasks to do.
     uint32_t num_busy_workers = 0;
+    // Keep track of how many tasks are in flight to the workers.
+    uint32_t total_tasks_in_flight = 0;
     int64_t last_reported_backlog_size = 0;
 
     // Check whether it's safe to delete this SchedulingKeyEntry from the
     // scheduling_key_entries_ hashmap.
     inline bool CanDelete() const {
       if (pending_lease_requests.empty() && task_queue.empty() &&
-          active_workers.size() == 0 && num_busy_workers == 0) {
+          active_workers.size() == 0 && num_busy_workers == 0 &&
+          total_tasks_in_flight == 0) {
         return true;
       }
 
@@ -309,6 +378,12 @@ class CoreWorkerDirectTaskSubmitter {
       return num_busy_workers == active_workers.size();
     }
 
+    // Check whether the workers have as many tasks in flight as they can be pushed.
+    inline bool AllPipelinesToWorkersFull(uint32_t max_tasks_in_flight_per_worker) const {
+      return total_tasks_in_flight >=
+             active_workers.size() * max_tasks_in_flight_per_worker;
+    }
+
     // Get the current backlog size for this scheduling key
     [[nodiscard]] inline int64_t BacklogSize() const {
       if (task_queue.size() < pending_lease_requests.size()) {
@@ -14,6 +14,8 @@
 
 #include "ray/core_worker/transport/sequential_actor_submit_queue.h"
 
+#include <iterator>
+
 namespace ray {
 namespace core {
 SequentialActorSubmitQueue::SequentialActorSubmitQueue(ActorID actor_id)
@@ -74,7 +76,9 @@ SequentialActorSubmitQueue::PopNextTaskToSend() {
 
 std::map<uint64_t, TaskSpecification>
 SequentialActorSubmitQueue::PopAllOutOfOrderCompletedTasks() {
-  auto result = std::move(out_of_order_completed_tasks);
+  std::map<uint64_t, TaskSpecification> result(
+      std::make_move_iterator(out_of_order_completed_tasks.begin()),
+      std::make_move_iterator(out_of_order_completed_tasks.end()));
   out_of_order_completed_tasks.clear();
   return result;
 }
@@ -101,13 +105,18 @@ void SequentialActorSubmitQueue::MarkTaskCompleted(uint64_t sequence_no,
   // cannot. In the case of tasks not received in order, the following block
   // ensure queue.next_task_reply_position are incremented to the max possible
   // value.
-  out_of_order_completed_tasks.insert({sequence_no, task_spec});
+  if (sequence_no == next_task_reply_position) {
+    // The common case of a task completed in order doesn't need to be stored.
+    next_task_reply_position++;
+  } else {
+    out_of_order_completed_tasks.insert({sequence_no, task_spec});
+  }
   auto min_completed_task = out_of_order_completed_tasks.begin();
   while (min_completed_task != out_of_order_completed_tasks.end()) {
     if (min_completed_task->first == next_task_reply_position) {
       next_task_reply_position++;
-      // increment the iterator and erase the old value
-      out_of_order_completed_tasks.erase(min_completed_task++);
+      // erase the old value and move to the next one
+      min_completed_task = out_of_order_completed_tasks.erase(min_completed_task);
     } else {
       break;
     }
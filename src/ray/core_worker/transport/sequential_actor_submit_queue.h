@@ -17,6 +17,7 @@
 #include <map>
 #include <utility>
 
+#include "absl/container/btree_map.h"
 #include "absl/types/optional.h"
 #include "ray/common/id.h"
 #include "ray/core_worker/transport/actor_submit_queue.h"
@@ -71,7 +72,7 @@ class SequentialActorSubmitQueue : public IActorSubmitQueue {
   /// for that task have been resolved yet. A task will be sent after its
   /// dependencies have been resolved and its task number matches
   /// next_send_position.
-  std::map<uint64_t, std::pair<TaskSpecification, bool>> requests;
+  absl::btree_map<uint64_t, std::pair<TaskSpecification, bool>> requests;
 
   /// Diagram of the sequence numbers assigned to actor tasks during actor
   /// crash and restart:
@@ -122,10 +123,8 @@ class SequentialActorSubmitQueue : public IActorSubmitQueue {
   /// async or threaded actor mode. This map is used to store the seqno and task
   /// spec for (1) increment next_task_reply_position later when the in order tasks are
   /// returned (2) resend the tasks to restarted actor so retried tasks can maintain
-  /// ordering.
-  // NOTE(simon): consider absl::btree_set for performance, but it requires updating
-  // abseil.
-  std::map<uint64_t, TaskSpecification> out_of_order_completed_tasks;
+  /// ordering. Tasks completed in order never go through this map.
+  absl::btree_map<uint64_t, TaskSpecification> out_of_order_completed_tasks;
 };
 }  // namespace core
 }  // namespace ray
\ No newline at end of file
@@ -16,14 +16,191 @@
 
 #include <boost/asio/post.hpp>
 
+#include "ray/util/logging.h"
+
 namespace ray {
 namespace core {
 
+namespace {
+
+/// The pool and the index of the queue of the current thread, if it's a thread of a
+/// WorkStealingThreadPool.
+thread_local const WorkStealingThreadPool *current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}  // namespace
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  Stop();
+  Join();
+}
+
+void WorkStealingThreadPool::AddThreads(int num_threads) {
+  absl::MutexLock lock(&mu_);
+  RAY_CHECK(!started_) << "Threads can't be added to a pool that has started.";
+  num_threads_ += num_threads;
+}
+
+void WorkStealingThreadPool::MaybeStart() {
+  if (started_) {
+    return;
+  }
+  started_ = true;
+  for (int i = 0; i < num_threads_; i++) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < num_threads_; i++) {
+    threads_.emplace_back([this, i]() { Run(i); });
+  }
+}
+
+void WorkStealingThreadPool::Post(std::function<void()> fn) {
+  size_t index;
+  {
+    absl::MutexLock lock(&mu_);
+    if (stopped_) {
+      return;
+    }
+    MaybeStart();
+    RAY_CHECK(!workers_.empty()) << "Work was posted to a pool without threads.";
+  }
+  if (current_pool == this) {
+    index = current_worker;
+  } else {
+    index = next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  }
+  {
+    absl::MutexLock lock(&workers_[index]->mu);
+    workers_[index]->tasks.push_back(std::move(fn));
+  }
+  // The task is counted only once it's queued, so that a thread that claims it always
+  // finds a task in one of the queues.
+  absl::MutexLock lock(&mu_);
+  num_queued_++;
+  work_available_.Signal();
+}
+
+bool WorkStealingThreadPool::TryTake(size_t index, std::function<void()> *fn) {
+  {
+    auto &own = *workers_[index];
+    absl::MutexLock lock(&own.mu);
+    if (!own.tasks.empty()) {
+      *fn = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); i++) {
+    auto &victim = *workers_[(index + i) % workers_.size()];
+    absl::MutexLock lock(&victim.mu);
+    if (!victim.tasks.empty()) {
+      *fn = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::Run(size_t index) {
+  current_pool = this;
+  current_worker = index;
+  while (true) {
+    {
+      absl::MutexLock lock(&mu_);
+      while (!stopped_ && num_queued_ == 0) {
+        work_available_.Wait(&mu_);
+      }
+      if (stopped_) {
+        return;
+      }
+      // Claim one of the queued tasks.
+      num_queued_--;
+    }
+    std::function<void()> fn;
+    while (!TryTake(index, &fn)) {
+      // The claimed task was queued, but another thread took it out of the queue we
+      // looked at after we scanned it, so there's another one.
+      std::this_thread::yield();
+    }
+    fn();
+  }
+}
+
+void WorkStealingThreadPool::Stop() {
+  absl::MutexLock lock(&mu_);
+  stopped_ = true;
+  work_available_.SignalAll();
+}
+
+void WorkStealingThreadPool::Join() {
+  std::vector<std::thread> threads;
+  {
+    absl::MutexLock lock(&mu_);
+    threads.swap(threads_);
+  }
+  for (auto &thread : threads) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      // The pool is joined by one of its own tasks, so the thread exits on its own.
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
 /// Wraps a thread-pool to block posts until the pool has free slots. This is used
 /// by the SchedulingQueue to provide backpressure to clients.
 BoundedExecutor::BoundedExecutor(int max_concurrency)
     : num_running_(0), max_concurrency_(max_concurrency), pool_(max_concurrency){};
 
+BoundedExecutor::BoundedExecutor(int max_concurrency,
+                                 std::shared_ptr<WorkStealingThreadPool> shared_pool)
+    : num_running_(0),
+      max_concurrency_(max_concurrency),
+      shared_pool_(std::move(shared_pool)),
+      pool_(0) {
+  shared_pool_->AddThreads(max_concurrency);
+}
+
+BoundedExecutor::~BoundedExecutor() {
+  // The work in the shared pool refers to this executor, so the pool must be done
+  // with it before the executor goes away.
+  if (shared_pool_ != nullptr) {
+    shared_pool_->Stop();
+    shared_pool_->Join();
+  }
+}
+
+void BoundedExecutor::Post(std::function<void()> fn) {
+  if (shared_pool_ == nullptr) {
+    PostBlocking(std::move(fn));
+    return;
+  }
+  absl::MutexLock lock(&mu_);
+  if (!ThreadsAvailable()) {
+    pending_.push_back(std::move(fn));
+    return;
+  }
+  num_running_ += 1;
+  PostToSharedPool(std::move(fn));
+}
+
+void BoundedExecutor::PostToSharedPool(std::function<void()> fn) {
+  shared_pool_->Post([this, fn = std::move(fn)]() {
+    fn();
+    absl::MutexLock lock(&mu_);
+    if (pending_.empty()) {
+      num_running_ -= 1;
+      return;
+    }
+    // Pass the token on to the next queued work.
+    auto next = std::move(pending_.front());
+    pending_.pop_front();
+    PostToSharedPool(std::move(next));
+  });
+}
+
 /// Posts work to the pool, blocking if no free threads are available.
 void BoundedExecutor::PostBlocking(std::function<void()> fn) {
   mu_.LockWhen(absl::Condition(this, &BoundedExecutor::ThreadsAvailable));
@@ -39,10 +216,20 @@ void BoundedExecutor::PostBlocking(std::function<void()> fn) {
 int32_t BoundedExecutor::GetMaxConcurrency() const { return max_concurrency_; }
 
 /// Stop the thread pool.
-void BoundedExecutor::Stop() { pool_.stop(); }
+void BoundedExecutor::Stop() {
+  if (shared_pool_ != nullptr) {
+    shared_pool_->Stop();
+  }
+  pool_.stop();
+}
 
 /// Join the thread pool.
-void BoundedExecutor::Join() { pool_.join(); }
+void BoundedExecutor::Join() {
+  if (shared_pool_ != nullptr) {
+    shared_pool_->Join();
+  }
+  pool_.join();
+}
 
 bool BoundedExecutor::ThreadsAvailable() { return num_running_ < max_concurrency_; }
 
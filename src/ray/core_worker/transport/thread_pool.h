@@ -16,9 +16,11 @@
 
 #include <boost/asio/thread_pool.hpp>
 #include <boost/thread.hpp>
+#include <deque>
 #include <list>
 #include <queue>
 #include <set>
+#include <thread>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
@@ -30,8 +32,69 @@
 namespace ray {
 namespace core {
 
+/// A thread pool that is shared by the executors of the concurrency groups of an
+/// actor. Every thread has its own queue of tasks, which the other threads steal from
+/// once their own queues are empty. The threads are started by the first post.
+///
+/// This class is thread safe.
+class WorkStealingThreadPool {
+ public:
+  WorkStealingThreadPool() = default;
+
+  ~WorkStealingThreadPool();
+
+  /// Add threads to the pool. This must be called before the first post.
+  void AddThreads(int num_threads);
+
+  /// Posts work to the pool. Work posted from a thread of the pool is queued on the
+  /// thread's own queue, and other work is spread over the queues of all threads.
+  void Post(std::function<void()> fn);
+
+  /// Stop the thread pool. The work that hasn't started yet is dropped.
+  void Stop();
+
+  /// Join the thread pool.
+  void Join();
+
+ private:
+  struct Worker {
+    absl::Mutex mu;
+    std::deque<std::function<void()>> tasks GUARDED_BY(mu);
+  };
+
+  /// Start the threads, if they aren't started yet.
+  void MaybeStart() EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// The loop of the thread that owns workers_[index].
+  void Run(size_t index);
+
+  /// Take a task from the front of the thread's own queue, or from the back of the
+  /// queue of another thread.
+  bool TryTake(size_t index, std::function<void()> *fn);
+
+  /// Protects the state of the threads, and the count of queued tasks that the
+  /// threads wait on.
+  absl::Mutex mu_;
+  absl::CondVar work_available_;
+  int num_threads_ GUARDED_BY(mu_) = 0;
+  bool started_ GUARDED_BY(mu_) = false;
+  bool stopped_ GUARDED_BY(mu_) = false;
+  /// The number of queued tasks that no thread has claimed yet.
+  size_t num_queued_ GUARDED_BY(mu_) = 0;
+  std::vector<std::thread> threads_ GUARDED_BY(mu_);
+  /// The queues of the threads. This is only resized before the threads start.
+  std::vector<std::unique_ptr<Worker>> workers_;
+  /// The queue that the next post from outside of the pool goes to.
+  std::atomic<size_t> next_worker_{0};
+};
+
 /// Wraps a thread-pool to block posts until the pool has free slots. This is used
 /// by the SchedulingQueue to provide backpressure to clients.
+///
+/// If the executor is created with a shared WorkStealingThreadPool, the pool has free
+/// slots as long as the executor holds fewer than max_concurrency tokens, and the
+/// work that is posted while all tokens are held is queued until one is returned,
+/// instead of blocking the poster.
 class BoundedExecutor {
  public:
   static bool NeedDefaultExecutor(int32_t max_concurrency_in_default_group) {
@@ -41,8 +104,19 @@ class BoundedExecutor {
 
   explicit BoundedExecutor(int max_concurrency);
 
+  /// Create an executor that runs its work on a pool shared with other executors,
+  /// and adds max_concurrency threads to the pool.
+  BoundedExecutor(int max_concurrency,
+                  std::shared_ptr<WorkStealingThreadPool> shared_pool);
+
+  ~BoundedExecutor();
+
   int32_t GetMaxConcurrency() const;
 
+  /// Posts work to the pool. Work is queued rather than blocking the poster if the
+  /// pool is shared, and otherwise this is the same as PostBlocking.
+  void Post(std::function<void()> fn);
+
   /// Posts work to the pool, blocking if no free threads are available.
   void PostBlocking(std::function<void()> fn);
 
@@ -55,13 +129,22 @@ class BoundedExecutor {
  private:
   bool ThreadsAvailable() EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  /// Post work that holds a token to the shared pool. The token is passed on to the
+  /// next queued work once the work finishes.
+  void PostToSharedPool(std::function<void()> fn);
+
   /// Protects access to the counters below.
   absl::Mutex mu_;
   /// The number of currently running tasks.
   int num_running_ GUARDED_BY(mu_);
   /// The max number of concurrently running tasks allowed.
   const int max_concurrency_;
-  /// The underlying thread pool for running tasks.
+  /// The work that waits for a token of the shared pool.
+  std::deque<std::function<void()>> pending_ GUARDED_BY(mu_);
+  /// The shared pool for running tasks, or nullptr if the executor owns its pool.
+  std::shared_ptr<WorkStealingThreadPool> shared_pool_;
+  /// The underlying thread pool for running tasks. It has no threads if the pool is
+  /// shared.
   boost::asio::thread_pool pool_;
 };
 
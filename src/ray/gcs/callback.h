@@ -15,6 +15,7 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <string>
 #include <vector>
 
 #include "ray/common/status.h"
@@ -44,6 +45,15 @@ using OptionalItemCallback =
 template <typename Data>
 using MultiItemCallback = std::function<void(Status status, std::vector<Data> &&result)>;
 
+/// This callback is used to receive a page of items from GCS when a read completes.
+/// \param status Status indicates whether the read was successful.
+/// \param result The items of the page returned by GCS.
+/// \param next_page_token The token to read the next page with, or empty if this is the
+/// last page.
+template <typename Data>
+using PageCallback = std::function<void(
+    Status status, std::vector<Data> &&result, const std::string &next_page_token)>;
+
 /// This callback is used to receive notifications of the subscribed items in the GCS.
 /// \param id The id of the item.
 /// \param result The notification message.
@@ -119,6 +119,20 @@ Status JobInfoAccessor::AsyncGetAll(
   return Status::OK();
 }
 
+Status JobInfoAccessor::AsyncGetPage(
+    const rpc::GetAllJobInfoRequest &request,
+    const PageCallback<rpc::JobTableData> &callback) {
+  RAY_LOG(DEBUG) << "Getting a page of job info.";
+  client_impl_->GetGcsRpcClient().GetAllJobInfo(
+      request, [callback](const Status &status, const rpc::GetAllJobInfoReply &reply) {
+        callback(status,
+                 VectorFromProtobuf(reply.job_info_list()),
+                 reply.next_page_token());
+        RAY_LOG(DEBUG) << "Finished getting a page of job info, status = " << status;
+      });
+  return Status::OK();
+}
+
 Status JobInfoAccessor::AsyncGetNextJobID(const ItemCallback<JobID> &callback) {
   RAY_LOG(DEBUG) << "Getting next job id";
   rpc::GetNextJobIDRequest request;
@@ -168,6 +182,20 @@ Status ActorInfoAccessor::AsyncGetAll(
   return Status::OK();
 }
 
+Status ActorInfoAccessor::AsyncGetPage(
+    const rpc::GetAllActorInfoRequest &request,
+    const PageCallback<rpc::ActorTableData> &callback) {
+  RAY_LOG(DEBUG) << "Getting a page of actor info.";
+  client_impl_->GetGcsRpcClient().GetAllActorInfo(
+      request, [callback](const Status &status, const rpc::GetAllActorInfoReply &reply) {
+        callback(status,
+                 VectorFromProtobuf(reply.actor_table_data()),
+                 reply.next_page_token());
+        RAY_LOG(DEBUG) << "Finished getting a page of actor info, status = " << status;
+      });
+  return Status::OK();
+}
+
 Status ActorInfoAccessor::AsyncGetByName(
     const std::string &name,
     const std::string &ray_namespace,
@@ -271,6 +299,38 @@ Status ActorInfoAccessor::AsyncRegisterActor(const ray::TaskSpecification &task_
   return Status::OK();
 }
 
+Status ActorInfoAccessor::AsyncRegisterActors(
+    const std::vector<TaskSpecification> &task_specs,
+    const std::function<void(std::vector<Status>)> &callback,
+    int64_t timeout_ms) {
+  RAY_CHECK(callback);
+  rpc::RegisterActorsRequest request;
+  for (const auto &task_spec : task_specs) {
+    RAY_CHECK(task_spec.IsActorCreationTask());
+    request.add_task_specs()->CopyFrom(task_spec.GetMessage());
+  }
+  const size_t num_actors = task_specs.size();
+  client_impl_->GetGcsRpcClient().RegisterActors(
+      request,
+      [callback, num_actors](const Status & /*unused*/,
+                             const rpc::RegisterActorsReply &reply) {
+        std::vector<Status> statuses;
+        statuses.reserve(num_actors);
+        for (size_t i = 0; i < num_actors; i++) {
+          // A reply without the statuses fails the whole batch.
+          const auto &status = i < static_cast<size_t>(reply.statuses_size())
+                                   ? reply.statuses(i)
+                                   : reply.status();
+          statuses.push_back(status.code() == (int)StatusCode::OK
+                                 ? Status()
+                                 : Status(StatusCode(status.code()), status.message()));
+        }
+        callback(std::move(statuses));
+      },
+      timeout_ms);
+  return Status::OK();
+}
+
 Status ActorInfoAccessor::SyncRegisterActor(const ray::TaskSpecification &task_spec) {
   RAY_CHECK(task_spec.IsActorCreationTask());
   rpc::RegisterActorRequest request;
@@ -513,6 +573,20 @@ Status NodeInfoAccessor::AsyncGetAll(const MultiItemCallback<GcsNodeInfo> &callb
   return Status::OK();
 }
 
+Status NodeInfoAccessor::AsyncGetPage(
+    const rpc::GetAllNodeInfoRequest &request,
+    const PageCallback<rpc::GcsNodeInfo> &callback) {
+  RAY_LOG(DEBUG) << "Getting a page of node info.";
+  client_impl_->GetGcsRpcClient().GetAllNodeInfo(
+      request, [callback](const Status &status, const rpc::GetAllNodeInfoReply &reply) {
+        callback(status,
+                 VectorFromProtobuf(reply.node_info_list()),
+                 reply.next_page_token());
+        RAY_LOG(DEBUG) << "Finished getting a page of node info, status = " << status;
+      });
+  return Status::OK();
+}
+
 Status NodeInfoAccessor::AsyncSubscribeToNodeChange(
     const SubscribeCallback<NodeID, GcsNodeInfo> &subscribe, const StatusCallback &done) {
   RAY_CHECK(subscribe != nullptr);
@@ -577,6 +651,22 @@ Status NodeInfoAccessor::AsyncReportHeartbeat(
   return Status::OK();
 }
 
+Status NodeInfoAccessor::AsyncReportNodeSuspected(const NodeID &node_id,
+                                                  const NodeID &reporter_node_id,
+                                                  const StatusCallback &callback) {
+  rpc::ReportNodeSuspectedRequest request;
+  request.set_node_id(node_id.Binary());
+  request.set_reporter_node_id(reporter_node_id.Binary());
+  client_impl_->GetGcsRpcClient().ReportNodeSuspected(
+      request,
+      [callback](const Status &status, const rpc::ReportNodeSuspectedReply &reply) {
+        if (callback) {
+          callback(status);
+        }
+      });
+  return Status::OK();
+}
+
 void NodeInfoAccessor::HandleNotification(const GcsNodeInfo &node_info) {
   NodeID node_id = NodeID::FromBinary(node_info.node_id());
   bool is_alive = (node_info.state() == GcsNodeInfo::ALIVE);
@@ -920,6 +1010,20 @@ Status WorkerInfoAccessor::AsyncGetAll(
   return Status::OK();
 }
 
+Status WorkerInfoAccessor::AsyncGetPage(
+    const rpc::GetAllWorkerInfoRequest &request,
+    const PageCallback<rpc::WorkerTableData> &callback) {
+  RAY_LOG(DEBUG) << "Getting a page of worker info.";
+  client_impl_->GetGcsRpcClient().GetAllWorkerInfo(
+      request, [callback](const Status &status, const rpc::GetAllWorkerInfoReply &reply) {
+        callback(status,
+                 VectorFromProtobuf(reply.worker_table_data()),
+                 reply.next_page_token());
+        RAY_LOG(DEBUG) << "Finished getting a page of worker info, status = " << status;
+      });
+  return Status::OK();
+}
+
 Status WorkerInfoAccessor::AsyncAdd(const std::shared_ptr<rpc::WorkerTableData> &data_ptr,
                                     const StatusCallback &callback) {
   rpc::AddWorkerInfoRequest request;
@@ -1110,6 +1214,55 @@ Status InternalKVAccessor::AsyncInternalKVDel(const std::string &ns,
   return Status::OK();
 }
 
+Status InternalKVAccessor::AsyncInternalKVMultiGet(
+    const std::string &ns,
+    const std::vector<std::string> &keys,
+    const OptionalItemCallback<absl::flat_hash_map<std::string, std::string>>
+        &callback) {
+  rpc::InternalKVMultiGetRequest req;
+  req.set_namespace_(ns);
+  for (const auto &key : keys) {
+    req.add_keys(key);
+  }
+  client_impl_->GetGcsRpcClient().InternalKVMultiGet(
+      req,
+      [callback](const Status &status, const rpc::InternalKVMultiGetReply &reply) {
+        if (!status.ok()) {
+          callback(status, boost::none);
+        } else {
+          absl::flat_hash_map<std::string, std::string> results;
+          for (const auto &entry : reply.results()) {
+            results.emplace(entry.key(), entry.value());
+          }
+          callback(status, std::move(results));
+        }
+      },
+      /*timeout_ms*/ GetGcsTimeoutMs());
+  return Status::OK();
+}
+
+Status InternalKVAccessor::AsyncInternalKVMultiPut(
+    const std::string &ns,
+    const std::vector<std::pair<std::string, std::string>> &entries,
+    bool overwrite,
+    const OptionalItemCallback<int> &callback) {
+  rpc::InternalKVMultiPutRequest req;
+  req.set_namespace_(ns);
+  req.set_overwrite(overwrite);
+  for (const auto &entry : entries) {
+    auto *kv = req.add_entries();
+    kv->set_key(entry.first);
+    kv->set_value(entry.second);
+  }
+  client_impl_->GetGcsRpcClient().InternalKVMultiPut(
+      req,
+      [callback](const Status &status, const rpc::InternalKVMultiPutReply &reply) {
+        callback(status, reply.added_num());
+      },
+      /*timeout_ms*/ GetGcsTimeoutMs());
+  return Status::OK();
+}
+
 Status InternalKVAccessor::AsyncInternalKVKeys(
     const std::string &ns,
     const std::string &prefix,
@@ -58,6 +58,15 @@ class ActorInfoAccessor {
   /// \return Status
   virtual Status AsyncGetAll(const MultiItemCallback<rpc::ActorTableData> &callback);
 
+  /// Get a page of the actors that match the filters of the request from GCS
+  /// asynchronously.
+  ///
+  /// \param request The filters, page size, page token and fields of the query.
+  /// \param callback Callback that will be called after lookup finishes.
+  /// \return Status
+  virtual Status AsyncGetPage(const rpc::GetAllActorInfoRequest &request,
+                              const PageCallback<rpc::ActorTableData> &callback);
+
   /// Get actor specification for a named actor from the GCS asynchronously.
   ///
   /// \param name The name of the detached actor to look up in the GCS.
@@ -119,6 +128,18 @@ class ActorInfoAccessor {
                                     const StatusCallback &callback,
                                     int64_t timeout_ms = -1);
 
+  /// Register a batch of actors to GCS asynchronously, in one RPC.
+  ///
+  /// \param task_specs The specifications for the actor creation tasks.
+  /// \param callback Callback that will be called with the status of each
+  /// registration, in the order of `task_specs`, after all of them are written to GCS.
+  /// \param timeout_ms RPC timeout ms. -1 means there's no timeout.
+  /// \return Status
+  virtual Status AsyncRegisterActors(
+      const std::vector<TaskSpecification> &task_specs,
+      const std::function<void(std::vector<Status>)> &callback,
+      int64_t timeout_ms = -1);
+
   /// Register actor to GCS synchronously.
   ///
   /// The RPC will timeout after the default GCS RPC timeout is exceeded.
@@ -239,6 +260,15 @@ class JobInfoAccessor {
   /// \return Status
   virtual Status AsyncGetAll(const MultiItemCallback<rpc::JobTableData> &callback);
 
+  /// Get a page of the jobs that match the filters of the request from GCS
+  /// asynchronously.
+  ///
+  /// \param request The filters, page size, page token and fields of the query.
+  /// \param callback Callback that will be called after lookup finished.
+  /// \return Status
+  virtual Status AsyncGetPage(const rpc::GetAllJobInfoRequest &request,
+                              const PageCallback<rpc::JobTableData> &callback);
+
   /// Reestablish subscription.
   /// This should be called when GCS server restarts from a failure.
   /// PubSub server restart will cause GCS server restart. In this case, we need to
@@ -323,6 +353,15 @@ class NodeInfoAccessor {
   /// \return Status
   virtual Status AsyncGetAll(const MultiItemCallback<rpc::GcsNodeInfo> &callback);
 
+  /// Get a page of the nodes that match the filters of the request from GCS
+  /// asynchronously.
+  ///
+  /// \param request The filters, page size, page token and fields of the query.
+  /// \param callback Callback that will be called after lookup finishes.
+  /// \return Status
+  virtual Status AsyncGetPage(const rpc::GetAllNodeInfoRequest &request,
+                              const PageCallback<rpc::GcsNodeInfo> &callback);
+
   /// Subscribe to node addition and removal events from GCS and cache those information.
   ///
   /// \param subscribe Callback that will be called if a node is
@@ -373,6 +412,16 @@ class NodeInfoAccessor {
       AsyncReportHeartbeat(const std::shared_ptr<rpc::HeartbeatTableData> &data_ptr,
                            const StatusCallback &callback);
 
+  /// Report a node that didn't reply to the probes of this node to GCS asynchronously.
+  ///
+  /// \param node_id The node that didn't reply.
+  /// \param reporter_node_id This node.
+  /// \param callback Callback that will be called after report finishes.
+  /// \return Status
+  virtual Status AsyncReportNodeSuspected(const NodeID &node_id,
+                                          const NodeID &reporter_node_id,
+                                          const StatusCallback &callback);
+
   /// Reestablish subscription.
   /// This should be called when GCS server restarts from a failure.
   /// PubSub server restart will cause GCS server restart. In this case, we need to
@@ -606,6 +655,15 @@ class WorkerInfoAccessor {
   /// \return Status
   virtual Status AsyncGetAll(const MultiItemCallback<rpc::WorkerTableData> &callback);
 
+  /// Get a page of the workers that match the filters of the request from GCS
+  /// asynchronously.
+  ///
+  /// \param request The filters, page size, page token and fields of the query.
+  /// \param callback Callback that will be called after lookup finished.
+  /// \return Status
+  virtual Status AsyncGetPage(const rpc::GetAllWorkerInfoRequest &request,
+                              const PageCallback<rpc::WorkerTableData> &callback);
+
   /// Add worker information to GCS asynchronously.
   ///
   /// \param data_ptr The worker that will be add to GCS.
@@ -755,6 +813,32 @@ class InternalKVAccessor {
                                     bool del_by_prefix,
                                     const StatusCallback &callback);
 
+  /// Asynchronously get the values for the given keys, in one RPC.
+  ///
+  /// \param ns The namespace to lookup.
+  /// \param keys The keys to lookup.
+  /// \param callback Callback that will be called with the values of the keys that
+  /// exist.
+  /// \return Status
+  virtual Status AsyncInternalKVMultiGet(
+      const std::string &ns,
+      const std::vector<std::string> &keys,
+      const OptionalItemCallback<absl::flat_hash_map<std::string, std::string>>
+          &callback);
+
+  /// Asynchronously set the values for the given keys, in one RPC.
+  ///
+  /// \param ns The namespace to put the keys.
+  /// \param entries The <key, value> pairs.
+  /// \param overwrite If it's true, it'll overwrite the existing values.
+  /// \param callback Callback that will be called with the number of keys added.
+  /// \return Status
+  virtual Status AsyncInternalKVMultiPut(
+      const std::string &ns,
+      const std::vector<std::pair<std::string, std::string>> &entries,
+      bool overwrite,
+      const OptionalItemCallback<int> &callback);
+
   // These are sync functions of the async above
 
   /// List keys with prefix stored in internal kv
@@ -225,19 +225,23 @@ TEST_P(GlobalStateAccessorTest, TestGetAllResourceUsage) {
 }
 
 TEST_P(GlobalStateAccessorTest, TestProfileTable) {
-  int profile_count = RayConfig::instance().maximum_profile_table_rows_count() + 1;
+  int profile_count = 10;
   ASSERT_EQ(global_state_->GetAllProfileInfo().size(), 0);
   for (int index = 0; index < profile_count; ++index) {
     auto node_id = NodeID::FromRandom();
     auto profile_table_data = Mocker::GenProfileTableData(node_id);
+    auto profile_event = profile_table_data->add_profile_events();
+    profile_event->set_event_type("task");
+    profile_event->set_start_time(index);
+    profile_event->set_end_time(index + 1);
     std::promise<bool> promise;
     RAY_CHECK_OK(gcs_client_->Stats().AsyncAddProfileData(
         profile_table_data,
         [&promise](Status status) { promise.set_value(status.ok()); }));
     WaitReady(promise.get_future(), timeout_ms_);
   }
-  ASSERT_EQ(global_state_->GetAllProfileInfo().size(),
-            RayConfig::instance().maximum_profile_table_rows_count());
+  // The events of each component are returned in one batch.
+  ASSERT_EQ(global_state_->GetAllProfileInfo().size(), profile_count);
 }
 
 TEST_P(GlobalStateAccessorTest, TestWorkerTable) {
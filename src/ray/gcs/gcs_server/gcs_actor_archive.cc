@@ -0,0 +1,116 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/gcs_server/gcs_actor_archive.h"
+
+namespace ray {
+namespace gcs {
+
+uint32_t GcsActorArchive::Dictionary::Encode(const std::string &value) {
+  auto it = codes_.find(value);
+  if (it != codes_.end()) {
+    return it->second;
+  }
+  const uint32_t code = values_.size();
+  values_.push_back(value);
+  codes_.emplace(value, code);
+  return code;
+}
+
+void GcsActorArchive::Add(const rpc::ActorTableData &data) {
+  if (max_entries_ == 0) {
+    return;
+  }
+  const auto actor_id = ActorID::FromBinary(data.actor_id());
+  if (sequence_numbers_.contains(actor_id)) {
+    return;
+  }
+  if (Size() == max_entries_) {
+    PopFront();
+  }
+
+  sequence_numbers_.emplace(actor_id, num_dropped_ + Size());
+  actor_ids_.push_back(actor_id);
+  job_ids_.push_back(job_ids_dictionary_.Encode(data.job_id()));
+  class_names_.push_back(class_names_dictionary_.Encode(data.class_name()));
+  namespaces_.push_back(namespaces_dictionary_.Encode(data.ray_namespace()));
+  node_ids_.push_back(node_ids_dictionary_.Encode(data.address().raylet_id()));
+  ip_addresses_.push_back(ip_addresses_dictionary_.Encode(data.address().ip_address()));
+  names_.push_back(data.name());
+  pids_.push_back(data.pid());
+  num_restarts_.push_back(data.num_restarts());
+  is_detached_.push_back(data.is_detached());
+  start_times_.push_back(data.start_time());
+  end_times_.push_back(data.end_time());
+  timestamps_.push_back(data.timestamp());
+  death_causes_.push_back(data.death_cause().SerializeAsString());
+}
+
+void GcsActorArchive::PopFront() {
+  sequence_numbers_.erase(actor_ids_.front());
+  actor_ids_.pop_front();
+  job_ids_.pop_front();
+  class_names_.pop_front();
+  namespaces_.pop_front();
+  node_ids_.pop_front();
+  ip_addresses_.pop_front();
+  names_.pop_front();
+  pids_.pop_front();
+  num_restarts_.pop_front();
+  is_detached_.pop_front();
+  start_times_.pop_front();
+  end_times_.pop_front();
+  timestamps_.pop_front();
+  death_causes_.pop_front();
+  num_dropped_++;
+}
+
+bool GcsActorArchive::Get(const ActorID &actor_id, rpc::ActorTableData *data) const {
+  auto it = sequence_numbers_.find(actor_id);
+  if (it == sequence_numbers_.end()) {
+    return false;
+  }
+  const size_t i = it->second - num_dropped_;
+  data->set_actor_id(actor_id.Binary());
+  data->set_job_id(job_ids_dictionary_.Decode(job_ids_[i]));
+  data->set_state(rpc::ActorTableData::DEAD);
+  data->set_class_name(class_names_dictionary_.Decode(class_names_[i]));
+  data->set_ray_namespace(namespaces_dictionary_.Decode(namespaces_[i]));
+  data->mutable_address()->set_raylet_id(node_ids_dictionary_.Decode(node_ids_[i]));
+  data->mutable_address()->set_ip_address(
+      ip_addresses_dictionary_.Decode(ip_addresses_[i]));
+  data->set_name(names_[i]);
+  data->set_pid(pids_[i]);
+  data->set_num_restarts(num_restarts_[i]);
+  data->set_is_detached(is_detached_[i]);
+  data->set_start_time(start_times_[i]);
+  data->set_end_time(end_times_[i]);
+  data->set_timestamp(timestamps_[i]);
+  data->mutable_death_cause()->ParseFromString(death_causes_[i]);
+  return true;
+}
+
+void GcsActorArchive::ForEach(
+    const std::function<void(const ActorID &actor_id,
+                             const std::string &job_id,
+                             const std::string &node_id)> &fn) const {
+  for (size_t i = 0; i < actor_ids_.size(); i++) {
+    fn(actor_ids_[i],
+       job_ids_dictionary_.Decode(job_ids_[i]),
+       node_ids_dictionary_.Decode(node_ids_[i]));
+  }
+}
+
+}  // namespace gcs
+}  // namespace ray
@@ -0,0 +1,101 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/id.h"
+#include "src/ray/protobuf/gcs.pb.h"
+
+namespace ray {
+namespace gcs {
+
+/// \class GcsActorArchive
+/// An append-only archive of dead actors, in a compact columnar form, so that they can
+/// still be queried after they are evicted from the cache of destroyed actors. Only the
+/// fields shown by the state API are kept, and the columns of strings that repeat
+/// across actors (job, class, namespace and node) are dictionary-encoded. Once the
+/// archive is full, the oldest actors are dropped.
+class GcsActorArchive {
+ public:
+  /// \param max_entries The maximum number of actors to archive.
+  explicit GcsActorArchive(size_t max_entries) : max_entries_(max_entries) {}
+
+  /// Archive a dead actor.
+  void Add(const rpc::ActorTableData &data);
+
+  /// Get an archived actor.
+  ///
+  /// \return Whether the actor is archived.
+  bool Get(const ActorID &actor_id, rpc::ActorTableData *data) const;
+
+  /// Call `fn` with the ID, job ID and node ID (in binary) of each archived actor, so
+  /// that they can be filtered before being decoded.
+  void ForEach(const std::function<void(const ActorID &actor_id,
+                                        const std::string &job_id,
+                                        const std::string &node_id)> &fn) const;
+
+  size_t Size() const { return actor_ids_.size(); }
+
+ private:
+  /// Strings that repeat across actors, stored once each.
+  class Dictionary {
+   public:
+    uint32_t Encode(const std::string &value);
+    const std::string &Decode(uint32_t code) const { return values_[code]; }
+
+   private:
+    std::vector<std::string> values_;
+    absl::flat_hash_map<std::string, uint32_t> codes_;
+  };
+
+  /// Drop the oldest archived actor.
+  void PopFront();
+
+  const size_t max_entries_;
+  /// The number of actors dropped so far, so that the position of an actor in the
+  /// columns is its sequence number minus this.
+  uint64_t num_dropped_ = 0;
+  absl::flat_hash_map<ActorID, uint64_t> sequence_numbers_;
+
+  Dictionary job_ids_dictionary_;
+  Dictionary class_names_dictionary_;
+  Dictionary namespaces_dictionary_;
+  Dictionary node_ids_dictionary_;
+  Dictionary ip_addresses_dictionary_;
+
+  std::deque<ActorID> actor_ids_;
+  std::deque<uint32_t> job_ids_;
+  std::deque<uint32_t> class_names_;
+  std::deque<uint32_t> namespaces_;
+  std::deque<uint32_t> node_ids_;
+  std::deque<uint32_t> ip_addresses_;
+  std::deque<std::string> names_;
+  std::deque<uint32_t> pids_;
+  std::deque<uint64_t> num_restarts_;
+  std::deque<bool> is_detached_;
+  std::deque<uint64_t> start_times_;
+  std::deque<uint64_t> end_times_;
+  std::deque<double> timestamps_;
+  /// The serialized death causes.
+  std::deque<std::string> death_causes_;
+};
+
+}  // namespace gcs
+}  // namespace ray
@@ -76,9 +76,14 @@ GcsBasedActorScheduler::AllocateActorWorkerAssignment(
   auto required_resources = ResourceMapToResourceRequest(
       task_spec.GetRequiredResources().GetResourceMap(), false);
 
-  // Allocate resources from cluster.
-  auto selected_node_id =
-      AllocateResources(required_placement_resources, required_resources);
+  // Allocate resources from cluster, on the node that holds most of the actor's
+  // arguments if it has them.
+  const auto locality_node_id = task_spec.ActorCreationLocalityNodeId();
+  auto selected_node_id = AllocateResources(
+      required_placement_resources,
+      required_resources,
+      locality_node_id.IsNil() ? scheduling::NodeID::Nil()
+                               : scheduling::NodeID(locality_node_id.Binary()));
   if (selected_node_id.IsNil()) {
     WarnResourceAllocationFailure(task_spec, required_placement_resources);
     return nullptr;
@@ -93,7 +98,21 @@ GcsBasedActorScheduler::AllocateActorWorkerAssignment(
 
 scheduling::NodeID GcsBasedActorScheduler::AllocateResources(
     const ResourceRequest &required_placement_resources,
-    const ResourceRequest &required_resources) {
+    const ResourceRequest &required_resources,
+    scheduling::NodeID preferred_node_id) {
+  auto &cluster_resource_manager =
+      cluster_resource_scheduler_->GetClusterResourceManager();
+  if (!preferred_node_id.IsNil() &&
+      cluster_resource_manager.ContainsNode(preferred_node_id) &&
+      cluster_resource_manager.HasSufficientResource(
+          preferred_node_id,
+          required_placement_resources,
+          /*ignore_object_store_memory_requirement=*/true)) {
+    RAY_CHECK(cluster_resource_manager.SubtractNodeAvailableResources(
+        preferred_node_id, required_resources));
+    return preferred_node_id;
+  }
+
   // TODO(Shanly): Use BundleSpread scheduling policy for the timebeing, it should be
   // replaced with Spread policy once the shceduling interfaces are unified inside
   // `ISchedulingPolicy`.
@@ -112,8 +131,6 @@ scheduling::NodeID GcsBasedActorScheduler::AllocateResources(
 
   auto selected_node_id = selected_nodes[0];
   if (!selected_node_id.IsNil()) {
-    auto &cluster_resource_manager =
-        cluster_resource_scheduler_->GetClusterResourceManager();
     // Acquire the resources from the selected node.
     RAY_CHECK(cluster_resource_manager.SubtractNodeAvailableResources(
         selected_node_id, required_resources));
@@ -128,10 +128,12 @@ class GcsBasedActorScheduler : public GcsActorScheduler {
   ///
   /// \param required_placement_resources The required resources of the task for
   /// scheduling. \param required_resources The required resources of the task for
-  /// allocation. \return ID of the node from which the resources are allocated.
+  /// allocation. \param preferred_node_id The node to allocate from if it has the
+  /// resources, or nil. \return ID of the node from which the resources are allocated.
   scheduling::NodeID AllocateResources(
       const ResourceRequest &required_placement_resources,
-      const ResourceRequest &required_resources);
+      const ResourceRequest &required_resources,
+      scheduling::NodeID preferred_node_id = scheduling::NodeID::Nil());
 
   scheduling::NodeID GetHighestScoreNodeResource(
       const ResourceRequest &required_resources) const;
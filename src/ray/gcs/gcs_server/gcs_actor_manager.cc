@@ -17,7 +17,9 @@
 #include <boost/regex.hpp>
 #include <utility>
 
+#include "absl/container/flat_hash_set.h"
 #include "ray/common/ray_config.h"
+#include "ray/gcs/gcs_server/gcs_table_query.h"
 #include "ray/gcs/pb_util.h"
 #include "ray/stats/metric_defs.h"
 
@@ -212,7 +214,8 @@ GcsActorManager::GcsActorManager(
       runtime_env_manager_(runtime_env_manager),
       function_manager_(function_manager),
       run_delayed_(run_delayed),
-      actor_gc_delay_(RayConfig::instance().gcs_actor_table_min_duration_ms()) {
+      actor_gc_delay_(RayConfig::instance().gcs_actor_table_min_duration_ms()),
+      actor_archive_(RayConfig::instance().gcs_actor_archive_max_entries()) {
   RAY_CHECK(worker_client_factory_);
   RAY_CHECK(destroy_owned_placement_group_if_needed_);
   if (RayConfig::instance().gcs_actor_scheduling_enabled() &&
@@ -255,6 +258,50 @@ void GcsActorManager::HandleRegisterActor(const rpc::RegisterActorRequest &reque
   ++counts_[CountType::REGISTER_ACTOR_REQUEST];
 }
 
+void GcsActorManager::HandleRegisterActors(const rpc::RegisterActorsRequest &request,
+                                           rpc::RegisterActorsReply *reply,
+                                           rpc::SendReplyCallback send_reply_callback) {
+  const int num_actors = request.task_specs_size();
+  RAY_LOG(DEBUG) << "Registering a batch of " << num_actors << " actors";
+  if (num_actors == 0) {
+    GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+    return;
+  }
+  for (int i = 0; i < num_actors; i++) {
+    reply->add_statuses();
+  }
+  // The reply is sent once every actor of the batch is registered, or failed to.
+  auto num_pending = std::make_shared<int>(num_actors);
+  auto on_done = [reply, send_reply_callback, num_pending](int index,
+                                                           const Status &status) {
+    reply->mutable_statuses(index)->set_code((int)status.code());
+    reply->mutable_statuses(index)->set_message(status.message());
+    if (--(*num_pending) == 0) {
+      GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+    }
+  };
+  for (int i = 0; i < num_actors; i++) {
+    const auto &task_spec = request.task_specs(i);
+    RAY_CHECK(task_spec.type() == TaskType::ACTOR_CREATION_TASK);
+    auto actor_id = ActorID::FromBinary(task_spec.actor_creation_task_spec().actor_id());
+    rpc::RegisterActorRequest register_request;
+    register_request.mutable_task_spec()->CopyFrom(task_spec);
+    Status status = RegisterActor(
+        register_request,
+        [on_done, i, actor_id](const std::shared_ptr<gcs::GcsActor> &actor) {
+          RAY_LOG(DEBUG) << "Registered actor, job id = " << actor_id.JobId()
+                         << ", actor id = " << actor_id;
+          on_done(i, Status::OK());
+        });
+    if (!status.ok()) {
+      RAY_LOG(WARNING) << "Failed to register actor: " << status.ToString()
+                       << ", job id = " << actor_id.JobId() << ", actor id = " << actor_id;
+      on_done(i, status);
+    }
+    ++counts_[CountType::REGISTER_ACTOR_REQUEST];
+  }
+}
+
 void GcsActorManager::HandleCreateActor(const rpc::CreateActorRequest &request,
                                         rpc::CreateActorReply *reply,
                                         rpc::SendReplyCallback send_reply_callback) {
@@ -272,6 +319,8 @@ void GcsActorManager::HandleCreateActor(const rpc::CreateActorRequest &request,
                       << ", actor id = " << actor_id;
         reply->mutable_actor_address()->CopyFrom(actor->GetAddress());
         reply->mutable_borrowed_refs()->CopyFrom(task_reply.borrowed_refs());
+        reply->mutable_compact_borrowed_refs()->CopyFrom(
+            task_reply.compact_borrowed_refs());
         GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
       });
   if (!status.ok()) {
@@ -298,6 +347,11 @@ void GcsActorManager::HandleGetActorInfo(const rpc::GetActorInfoRequest &request
     if (destroyed_actor_iter != destroyed_actors_.end()) {
       reply->unsafe_arena_set_allocated_actor_table_data(
           destroyed_actor_iter->second->GetMutableActorTableData());
+    } else {
+      rpc::ActorTableData data;
+      if (actor_archive_.Get(actor_id, &data)) {
+        reply->mutable_actor_table_data()->Swap(&data);
+      }
     }
   }
 
@@ -312,15 +366,23 @@ void GcsActorManager::HandleGetAllActorInfo(const rpc::GetAllActorInfoRequest &r
                                             rpc::SendReplyCallback send_reply_callback) {
   RAY_LOG(DEBUG) << "Getting all actor info.";
   ++counts_[CountType::GET_ALL_ACTOR_INFO_REQUEST];
+  auto matches = [&request](const rpc::ActorTableData &data) {
+    return (request.job_id().empty() || data.job_id() == request.job_id()) &&
+           (!request.has_state() || data.state() == request.state()) &&
+           (request.node_id().empty() ||
+            data.address().raylet_id() == request.node_id());
+  };
   if (request.show_dead_jobs() == false) {
-    for (const auto &iter : registered_actors_) {
-      reply->mutable_actor_table_data()->UnsafeArenaAddAllocated(
-          const_cast<rpc::ActorTableData *>(iter.second->GetMutableActorTableData()));
-    }
-    for (const auto &iter : destroyed_actors_) {
-      reply->mutable_actor_table_data()->UnsafeArenaAddAllocated(
-          const_cast<rpc::ActorTableData *>(iter.second->GetMutableActorTableData()));
+    std::vector<std::pair<std::string, const rpc::ActorTableData *>> entries;
+    for (const auto *actors : {&registered_actors_, &destroyed_actors_}) {
+      for (const auto &iter : *actors) {
+        const auto &data = iter.second->GetActorTableData();
+        if (matches(data)) {
+          entries.emplace_back(iter.first.Binary(), &data);
+        }
+      }
     }
+    AddActorsPageToReply(request, std::move(entries), /*borrow=*/true, reply);
     RAY_LOG(DEBUG) << "Finished getting all actor info.";
     GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
     return;
@@ -330,13 +392,16 @@ void GcsActorManager::HandleGetAllActorInfo(const rpc::GetAllActorInfoRequest &r
   // We don't maintain an in-memory cache of all actors which belong to dead
   // jobs, so fetch it from redis.
   Status status = gcs_table_storage_->ActorTable().GetAll(
-      [reply, send_reply_callback](
+      [this, &request, matches, reply, send_reply_callback](
           const absl::flat_hash_map<ActorID, rpc::ActorTableData> &result) {
+        std::vector<std::pair<std::string, const rpc::ActorTableData *>> entries;
         for (const auto &pair : result) {
-          // TODO yic: Fix const cast
-          reply->mutable_actor_table_data()->UnsafeArenaAddAllocated(
-              const_cast<rpc::ActorTableData *>(&pair.second));
+          if (matches(pair.second)) {
+            entries.emplace_back(pair.first.Binary(), &pair.second);
+          }
         }
+        // The result is freed once this callback returns, so it's copied into the reply.
+        AddActorsPageToReply(request, std::move(entries), /*borrow=*/false, reply);
         GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
         RAY_LOG(DEBUG) << "Finished getting all actor info.";
       });
@@ -346,6 +411,33 @@ void GcsActorManager::HandleGetAllActorInfo(const rpc::GetAllActorInfoRequest &r
   }
 }
 
+void GcsActorManager::AddActorsPageToReply(
+    const rpc::GetAllActorInfoRequest &request,
+    std::vector<std::pair<std::string, const rpc::ActorTableData *>> entries,
+    bool borrow,
+    rpc::GetAllActorInfoReply *reply) const {
+  // The archived actors are only decoded once they are selected for the page.
+  if (!request.has_state() || request.state() == rpc::ActorTableData::DEAD) {
+    actor_archive_.ForEach([&request, &entries](const ActorID &actor_id,
+                                                const std::string &job_id,
+                                                const std::string &node_id) {
+      if ((request.job_id().empty() || job_id == request.job_id()) &&
+          (request.node_id().empty() || node_id == request.node_id())) {
+        entries.emplace_back(actor_id.Binary(), nullptr);
+      }
+    });
+  }
+  for (const auto &entry : SelectPage(request, std::move(entries), reply)) {
+    if (entry.second != nullptr) {
+      AddToReply(request, *entry.second, borrow, reply->mutable_actor_table_data());
+    } else {
+      auto *data = reply->add_actor_table_data();
+      RAY_CHECK(actor_archive_.Get(ActorID::FromBinary(entry.first), data));
+      ProjectFields(request.fields(), data);
+    }
+  }
+}
+
 void GcsActorManager::HandleGetNamedActorInfo(
     const rpc::GetNamedActorInfoRequest &request,
     rpc::GetNamedActorInfoReply *reply,
@@ -713,6 +805,57 @@ void GcsActorManager::PollOwnerForActorOutOfScope(
 void GcsActorManager::DestroyActor(const ActorID &actor_id,
                                    const rpc::ActorDeathCause &death_cause,
                                    bool force_kill) {
+  auto actor_table_data = MarkActorDestroyed(actor_id, death_cause, force_kill);
+  if (actor_table_data == nullptr) {
+    return;
+  }
+  // The backend storage is reliable in the future, so the status must be ok.
+  RAY_CHECK_OK(gcs_table_storage_->ActorTable().Put(
+      actor_id,
+      *actor_table_data,
+      [this, actor_id, actor_table_data](Status status) {
+        RAY_CHECK_OK(gcs_publisher_->PublishActor(
+            actor_id, *GenActorDataOnlyWithStates(*actor_table_data), nullptr));
+        RAY_CHECK_OK(gcs_table_storage_->ActorTaskSpecTable().Delete(actor_id, nullptr));
+        // Destroy placement group owned by this actor.
+        destroy_owned_placement_group_if_needed_(actor_id);
+      }));
+}
+
+void GcsActorManager::DestroyActors(
+    const std::vector<std::pair<ActorID, rpc::ActorDeathCause>> &actors) {
+  auto dead_actors =
+      std::make_shared<std::vector<std::pair<ActorID, rpc::ActorTableData>>>();
+  for (const auto &[actor_id, death_cause] : actors) {
+    auto actor_table_data =
+        MarkActorDestroyed(actor_id, death_cause, /*force_kill=*/true);
+    if (actor_table_data != nullptr) {
+      dead_actors->emplace_back(actor_id, std::move(*actor_table_data));
+    }
+  }
+  if (dead_actors->empty()) {
+    return;
+  }
+  RAY_CHECK_OK(gcs_table_storage_->ActorTable().BatchPut(
+      *dead_actors, [this, dead_actors](Status status) {
+        std::vector<ActorID> actor_ids;
+        actor_ids.reserve(dead_actors->size());
+        for (const auto &[actor_id, actor_table_data] : *dead_actors) {
+          RAY_CHECK_OK(gcs_publisher_->PublishActor(
+              actor_id, *GenActorDataOnlyWithStates(actor_table_data), nullptr));
+          actor_ids.push_back(actor_id);
+        }
+        RAY_CHECK_OK(
+            gcs_table_storage_->ActorTaskSpecTable().BatchDelete(actor_ids, nullptr));
+        for (const auto &actor_id : actor_ids) {
+          // Destroy placement group owned by this actor.
+          destroy_owned_placement_group_if_needed_(actor_id);
+        }
+      }));
+}
+
+std::shared_ptr<rpc::ActorTableData> GcsActorManager::MarkActorDestroyed(
+    const ActorID &actor_id, const rpc::ActorDeathCause &death_cause, bool force_kill) {
   RAY_LOG(INFO) << "Destroying actor, actor id = " << actor_id
                 << ", job id = " << actor_id.JobId();
   actor_to_register_callbacks_.erase(actor_id);
@@ -720,7 +863,7 @@ void GcsActorManager::DestroyActor(const ActorID &actor_id,
   auto it = registered_actors_.find(actor_id);
   if (it == registered_actors_.end()) {
     RAY_LOG(INFO) << "Tried to destroy actor that does not exist " << actor_id;
-    return;
+    return nullptr;
   }
 
   if (RayConfig::instance().gcs_actor_scheduling_enabled()) {
@@ -746,7 +889,7 @@ void GcsActorManager::DestroyActor(const ActorID &actor_id,
   if (actor->GetState() == rpc::ActorTableData::DEAD) {
     RAY_LOG(DEBUG) << "Actor " << actor->GetActorID() << "has been dead,"
                    << "skip sending killing request.";
-    return;
+    return nullptr;
   }
   if (actor->GetState() == rpc::ActorTableData::DEPENDENCIES_UNREADY) {
     // The actor creation task still has unresolved dependencies. Remove from the
@@ -782,19 +925,7 @@ void GcsActorManager::DestroyActor(const ActorID &actor_id,
   mutable_actor_table_data->set_timestamp(time);
   mutable_actor_table_data->mutable_death_cause()->CopyFrom(death_cause);
 
-  auto actor_table_data =
-      std::make_shared<rpc::ActorTableData>(*mutable_actor_table_data);
-  // The backend storage is reliable in the future, so the status must be ok.
-  RAY_CHECK_OK(gcs_table_storage_->ActorTable().Put(
-      actor->GetActorID(),
-      *actor_table_data,
-      [this, actor_id, actor_table_data](Status status) {
-        RAY_CHECK_OK(gcs_publisher_->PublishActor(
-            actor_id, *GenActorDataOnlyWithStates(*actor_table_data), nullptr));
-        RAY_CHECK_OK(gcs_table_storage_->ActorTaskSpecTable().Delete(actor_id, nullptr));
-        // Destroy placement group owned by this actor.
-        destroy_owned_placement_group_if_needed_(actor_id);
-      }));
+  return std::make_shared<rpc::ActorTableData>(*mutable_actor_table_data);
 }
 
 absl::flat_hash_map<WorkerID, absl::flat_hash_set<ActorID>>
@@ -851,15 +982,14 @@ void GcsActorManager::OnWorkerDead(const ray::NodeID &node_id,
 
   bool need_reconstruct = disconnect_type != rpc::WorkerExitType::INTENDED_EXIT &&
                           disconnect_type != rpc::WorkerExitType::CREATION_TASK_ERROR;
-  // Destroy all actors that are owned by this worker.
+  // Destroy all actors that are owned by this worker, all at once, since the owner may
+  // be a driver with many actors.
+  std::vector<std::pair<ActorID, rpc::ActorDeathCause>> actors_to_destroy;
   const auto it = owners_.find(node_id);
   if (it != owners_.end() && it->second.count(worker_id)) {
     auto owner = it->second.find(worker_id);
-    // Make a copy of the children actor IDs since we will delete from the
-    // list.
-    const auto children_ids = owner->second.children_actor_ids;
-    for (const auto &child_id : children_ids) {
-      DestroyActor(
+    for (const auto &child_id : owner->second.children_actor_ids) {
+      actors_to_destroy.emplace_back(
           child_id,
           GenOwnerDiedCause(GetActor(child_id), worker_id, disconnect_type, worker_ip));
     }
@@ -871,11 +1001,12 @@ void GcsActorManager::OnWorkerDead(const ray::NodeID &node_id,
   auto unresolved_actors = GetUnresolvedActorsByOwnerWorker(node_id, worker_id);
   for (auto &actor_id : unresolved_actors) {
     if (registered_actors_.count(actor_id)) {
-      DestroyActor(
+      actors_to_destroy.emplace_back(
           actor_id,
           GenOwnerDiedCause(GetActor(actor_id), worker_id, disconnect_type, worker_ip));
     }
   }
+  DestroyActors(actors_to_destroy);
 
   // Find if actor is already created or in the creation process (lease request is
   // granted)
@@ -1166,8 +1297,23 @@ void GcsActorManager::SchedulePendingActors() {
 
   RAY_LOG(DEBUG) << "Scheduling actor creation tasks, size = " << pending_actors_.size();
   auto actors = std::move(pending_actors_);
+  pending_actors_.clear();
+  // The actors of a scheduling class need the same resources, so once one of them
+  // finds no node, the rest of the class stays pending until the next change of the
+  // cluster resources instead of being scheduled only to fail again.
+  absl::flat_hash_set<SchedulingClass> failed_classes;
   for (auto &actor : actors) {
+    const auto scheduling_class =
+        actor->GetCreationTaskSpecification().GetSchedulingClass();
+    if (failed_classes.contains(scheduling_class)) {
+      pending_actors_.emplace_back(std::move(actor));
+      continue;
+    }
+    const size_t num_pending_actors = pending_actors_.size();
     gcs_actor_scheduler_->Schedule(std::move(actor));
+    if (pending_actors_.size() > num_pending_actors) {
+      failed_classes.insert(scheduling_class);
+    }
   }
 }
 
@@ -1403,7 +1549,11 @@ void GcsActorManager::AddDestroyedActorToCache(const std::shared_ptr<GcsActor> &
       RayConfig::instance().maximum_gcs_destroyed_actor_cached_count()) {
     const auto &actor_id = sorted_destroyed_actor_list_.front().first;
     RAY_CHECK_OK(gcs_table_storage_->ActorTable().Delete(actor_id, nullptr));
-    destroyed_actors_.erase(actor_id);
+    auto it = destroyed_actors_.find(actor_id);
+    if (it != destroyed_actors_.end()) {
+      actor_archive_.Add(it->second->GetActorTableData());
+      destroyed_actors_.erase(it);
+    }
     sorted_destroyed_actor_list_.pop_front();
   }
 
@@ -1482,6 +1632,7 @@ std::string GcsActorManager::DebugString() const {
          << counts_[CountType::LIST_NAMED_ACTORS_REQUEST]
          << "\n- Registered actors count: " << registered_actors_.size()
          << "\n- Destroyed actors count: " << destroyed_actors_.size()
+         << "\n- Archived actors count: " << actor_archive_.Size()
          << "\n- Named actors count: " << num_named_actors
          << "\n- Unresolved actors count: " << unresolved_actors_.size()
          << "\n- Pending actors count: " << pending_actors_.size()
@@ -1497,6 +1648,7 @@ void GcsActorManager::RecordMetrics() const {
   ray::stats::STATS_gcs_actors_count.Record(registered_actors_.size(), "Registered");
   ray::stats::STATS_gcs_actors_count.Record(created_actors_.size(), "Created");
   ray::stats::STATS_gcs_actors_count.Record(destroyed_actors_.size(), "Destroyed");
+  ray::stats::STATS_gcs_actors_count.Record(actor_archive_.Size(), "Archived");
   ray::stats::STATS_gcs_actors_count.Record(unresolved_actors_.size(), "Unresolved");
   ray::stats::STATS_gcs_actors_count.Record(pending_actors_.size(), "Pending");
 }
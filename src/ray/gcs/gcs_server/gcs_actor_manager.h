@@ -20,6 +20,7 @@
 #include "ray/common/id.h"
 #include "ray/common/runtime_env_manager.h"
 #include "ray/common/task/task_spec.h"
+#include "ray/gcs/gcs_server/gcs_actor_archive.h"
 #include "ray/gcs/gcs_server/gcs_actor_distribution.h"
 #include "ray/gcs/gcs_server/gcs_actor_scheduler.h"
 #include "ray/gcs/gcs_server/gcs_function_manager.h"
@@ -235,6 +236,12 @@ class GcsActorManager : public rpc::ActorInfoHandler {
                            rpc::RegisterActorReply *reply,
                            rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Register each actor of the batch as if by `HandleRegisterActor`, and reply once
+  /// all of them are registered.
+  void HandleRegisterActors(const rpc::RegisterActorsRequest &request,
+                            rpc::RegisterActorsReply *reply,
+                            rpc::SendReplyCallback send_reply_callback) override;
+
   void HandleCreateActor(const rpc::CreateActorRequest &request,
                          rpc::CreateActorReply *reply,
                          rpc::SendReplyCallback send_reply_callback) override;
@@ -417,6 +424,22 @@ class GcsActorManager : public rpc::ActorInfoHandler {
                     const rpc::ActorDeathCause &death_cause,
                     bool force_kill = true);
 
+  /// Destroy a batch of actors, e.g. all the children of a dead owner, like
+  /// `DestroyActor`, but with one write to the actor table and one delete from the
+  /// actor task spec table for all of them.
+  ///
+  /// \param[in] actors The ids of the actors to destroy, with the reason why each of
+  /// them is destroyed.
+  void DestroyActors(
+      const std::vector<std::pair<ActorID, rpc::ActorDeathCause>> &actors);
+
+  /// Clean up the local state of an actor being destroyed and mark it as dead.
+  ///
+  /// \return The actor table data to write to the storage, or nullptr if the actor
+  /// doesn't need to be written, because it doesn't exist or is already dead.
+  std::shared_ptr<rpc::ActorTableData> MarkActorDestroyed(
+      const ActorID &actor_id, const rpc::ActorDeathCause &death_cause, bool force_kill);
+
   /// Get unresolved actors that were submitted from the specified node.
   absl::flat_hash_map<WorkerID, absl::flat_hash_set<ActorID>>
   GetUnresolvedActorsByOwnerNode(const NodeID &node_id) const;
@@ -469,6 +492,17 @@ class GcsActorManager : public rpc::ActorInfoHandler {
   /// \param actor The actor to be killed.
   void AddDestroyedActorToCache(const std::shared_ptr<GcsActor> &actor);
 
+  /// Add a page of the given actors and of the archived actors that match the filters
+  /// of a GetAllActorInfo request to its reply.
+  ///
+  /// \param entries The IDs (in binary) and data of the actors that match the filters.
+  /// \param borrow Whether the actors outlive the reply.
+  void AddActorsPageToReply(
+      const rpc::GetAllActorInfoRequest &request,
+      std::vector<std::pair<std::string, const rpc::ActorTableData *>> entries,
+      bool borrow,
+      rpc::GetAllActorInfoReply *reply) const;
+
   std::shared_ptr<rpc::ActorTableData> GenActorDataOnlyWithStates(
       const rpc::ActorTableData &actor) {
     auto actor_delta = std::make_shared<rpc::ActorTableData>();
@@ -568,6 +602,8 @@ class GcsActorManager : public rpc::ActorInfoHandler {
   std::function<void(std::function<void(void)>, boost::posix_time::milliseconds)>
       run_delayed_;
   const boost::posix_time::milliseconds actor_gc_delay_;
+  /// The destroyed actors evicted from the cache of destroyed actors, in a compact form.
+  GcsActorArchive actor_archive_;
 
   /// Indicate whether a call of SchedulePendingActors has been posted.
   bool schedule_pending_actors_posted_;
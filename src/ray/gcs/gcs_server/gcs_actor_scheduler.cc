@@ -197,6 +197,15 @@ void GcsActorScheduler::ReleaseUnusedWorkers(
         [this, node_id](const Status &status,
                         const rpc::ReleaseUnusedWorkersReply &reply) {
           nodes_of_releasing_unused_workers_.erase(node_id);
+          // Lease workers for the actors that were waiting for the reply.
+          auto waiting_it = actors_waiting_for_released_workers_.find(node_id);
+          if (waiting_it != actors_waiting_for_released_workers_.end()) {
+            auto waiting_actors = std::move(waiting_it->second);
+            actors_waiting_for_released_workers_.erase(waiting_it);
+            for (auto &entry : waiting_actors) {
+              DoRetryLeasingWorkerFromNode(entry.first, entry.second);
+            }
+          }
         };
     auto iter = node_to_workers.find(alive_node.first);
 
@@ -217,9 +226,9 @@ void GcsActorScheduler::LeaseWorkerFromNode(std::shared_ptr<GcsActor> actor,
                 << actor->GetActorID() << ", job id = " << actor->GetActorID().JobId();
 
   // We need to ensure that the RequestWorkerLease won't be sent before the reply of
-  // ReleaseUnusedWorkers is returned.
+  // ReleaseUnusedWorkers is returned, so the lease is requested when the reply arrives.
   if (nodes_of_releasing_unused_workers_.contains(node_id)) {
-    RetryLeasingWorkerFromNode(actor, node);
+    actors_waiting_for_released_workers_[node_id].emplace_back(actor, node);
     return;
   }
 
@@ -452,7 +461,9 @@ std::string GcsActorScheduler::DebugString() const {
          << "\n- node_to_workers_when_creating_: "
          << node_to_workers_when_creating_.size()
          << "\n- nodes_of_releasing_unused_workers_: "
-         << nodes_of_releasing_unused_workers_.size();
+         << nodes_of_releasing_unused_workers_.size()
+         << "\n- actors_waiting_for_released_workers_: "
+         << actors_waiting_for_released_workers_.size();
   return stream.str();
 }
 
@@ -460,10 +471,18 @@ NodeID RayletBasedActorScheduler::SelectNode(std::shared_ptr<GcsActor> actor) {
   // Select a node to lease worker for the actor.
   std::shared_ptr<rpc::GcsNodeInfo> node;
 
-  // If an actor has resource requirements, we will try to schedule it on the same node as
-  // the owner if possible.
+  // If the owner found a node that holds most of the actor's arguments, we will try to
+  // schedule the actor there, and the raylet spills it back if the node doesn't have
+  // the resources. Otherwise, if an actor has resource requirements, we will try to
+  // schedule it on the same node as the owner if possible.
   const auto &task_spec = actor->GetCreationTaskSpecification();
-  if (!task_spec.GetRequiredResources().IsEmpty()) {
+  const auto locality_node_id = task_spec.ActorCreationLocalityNodeId();
+  auto maybe_locality_node = locality_node_id.IsNil()
+                                 ? absl::nullopt
+                                 : gcs_node_manager_.GetAliveNode(locality_node_id);
+  if (maybe_locality_node.has_value()) {
+    node = maybe_locality_node.value();
+  } else if (!task_spec.GetRequiredResources().IsEmpty()) {
     auto maybe_node = gcs_node_manager_.GetAliveNode(actor->GetOwnerNodeID());
     node = maybe_node.has_value() ? maybe_node.value() : SelectNodeRandomly();
   } else {
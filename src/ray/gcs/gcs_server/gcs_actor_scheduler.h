@@ -334,6 +334,12 @@ class GcsActorScheduler : public GcsActorSchedulerInterface {
   GcsActorSchedulerSuccessCallback schedule_success_handler_;
   /// The nodes which are releasing unused workers.
   absl::flat_hash_set<NodeID> nodes_of_releasing_unused_workers_;
+  /// The actors whose worker lease is deferred until the node replies to the
+  /// ReleaseUnusedWorkers request, keyed by node.
+  absl::flat_hash_map<NodeID,
+                      std::vector<std::pair<std::shared_ptr<GcsActor>,
+                                            std::shared_ptr<rpc::GcsNodeInfo>>>>
+      actors_waiting_for_released_workers_;
   /// The cached raylet clients used to communicate with raylet.
   std::shared_ptr<rpc::NodeManagerClientPool> raylet_client_pool_;
   /// The cached core worker clients which are used to communicate with leased worker.
@@ -27,9 +27,14 @@ GcsHeartbeatManager::GcsHeartbeatManager(
     : io_service_(io_service),
       on_node_death_callback_(std::move(on_node_death_callback)),
       num_heartbeats_timeout_(RayConfig::instance().num_heartbeats_timeout()),
-      periodical_runner_(io_service) {
+      periodical_runner_(io_service),
+      gossip_failure_detection_(RayConfig::instance().raylet_gossip_probe_period_ms() >
+                                0),
+      client_call_manager_(io_service),
+      raylet_client_pool_(client_call_manager_) {
   RAY_LOG(INFO) << "GcsHeartbeatManager start, num_heartbeats_timeout="
-                << num_heartbeats_timeout_;
+                << num_heartbeats_timeout_
+                << ", gossip_failure_detection=" << gossip_failure_detection_;
   io_service_thread_.reset(new std::thread([this] {
     SetThreadName("heartbeat");
     /// The asio work to keep io_service_ alive.
@@ -42,6 +47,11 @@ void GcsHeartbeatManager::Initialize(const GcsInitData &gcs_init_data) {
   for (const auto &item : gcs_init_data.Nodes()) {
     if (item.second.state() == rpc::GcsNodeInfo::ALIVE) {
       heartbeats_.emplace(item.first, num_heartbeats_timeout_);
+      rpc::Address address;
+      address.set_raylet_id(item.second.node_id());
+      address.set_ip_address(item.second.node_manager_address());
+      address.set_port(item.second.node_manager_port());
+      node_addresses_.emplace(item.first, address);
     }
   }
 }
@@ -51,7 +61,13 @@ void GcsHeartbeatManager::Start() {
       [this] {
         if (!is_started_) {
           periodical_runner_.RunFnPeriodically(
-              [this] { DetectDeadNodes(); },
+              [this] {
+                if (gossip_failure_detection_) {
+                  DetectDeadSuspectedNodes();
+                } else {
+                  DetectDeadNodes();
+                }
+              },
               RayConfig::instance().raylet_heartbeat_period_milliseconds(),
               "GcsHeartbeatManager.deadline_timer.detect_dead_nodes");
           is_started_ = true;
@@ -67,12 +83,31 @@ void GcsHeartbeatManager::Stop() {
   }
 }
 
-void GcsHeartbeatManager::AddNode(const NodeID &node_id) {
+void GcsHeartbeatManager::AddNode(const rpc::GcsNodeInfo &node_info) {
+  const auto node_id = NodeID::FromBinary(node_info.node_id());
+  rpc::Address address;
+  address.set_raylet_id(node_info.node_id());
+  address.set_ip_address(node_info.node_manager_address());
+  address.set_port(node_info.node_manager_port());
   io_service_.post(
-      [this, node_id] { heartbeats_.emplace(node_id, num_heartbeats_timeout_); },
+      [this, node_id, address] {
+        heartbeats_.emplace(node_id, num_heartbeats_timeout_);
+        node_addresses_.emplace(node_id, address);
+      },
       "GcsHeartbeatManager.AddNode");
 }
 
+void GcsHeartbeatManager::RemoveNode(const NodeID &node_id) {
+  io_service_.post(
+      [this, node_id] {
+        heartbeats_.erase(node_id);
+        node_addresses_.erase(node_id);
+        suspected_nodes_.erase(node_id);
+        raylet_client_pool_.Disconnect(node_id);
+      },
+      "GcsHeartbeatManager.RemoveNode");
+}
+
 void GcsHeartbeatManager::HandleReportHeartbeat(
     const rpc::ReportHeartbeatRequest &request,
     rpc::ReportHeartbeatReply *reply,
@@ -87,6 +122,21 @@ void GcsHeartbeatManager::HandleReportHeartbeat(
   }
 
   iter->second = num_heartbeats_timeout_;
+  suspected_nodes_.erase(node_id);
+  GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+}
+
+void GcsHeartbeatManager::HandleReportNodeSuspected(
+    const rpc::ReportNodeSuspectedRequest &request,
+    rpc::ReportNodeSuspectedReply *reply,
+    rpc::SendReplyCallback send_reply_callback) {
+  NodeID node_id = NodeID::FromBinary(request.node_id());
+  if (heartbeats_.contains(node_id) && suspected_nodes_.insert(node_id).second) {
+    RAY_LOG(WARNING) << "Node " << node_id << " is suspected by node "
+                     << NodeID::FromBinary(request.reporter_node_id())
+                     << ", probing it until it replies or times out.";
+    heartbeats_[node_id] = num_heartbeats_timeout_;
+  }
   GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
 }
 
@@ -105,10 +155,45 @@ void GcsHeartbeatManager::DetectDeadNodes() {
       auto node_id = current->first;
       RAY_LOG(WARNING) << "Node timed out: " << node_id;
       heartbeats_.erase(current);
+      node_addresses_.erase(node_id);
+      if (on_node_death_callback_) {
+        on_node_death_callback_(node_id);
+      }
+    }
+  }
+}
+
+void GcsHeartbeatManager::DetectDeadSuspectedNodes() {
+  for (auto it = suspected_nodes_.begin(); it != suspected_nodes_.end();) {
+    auto current = it++;
+    const auto node_id = *current;
+    auto heartbeat_it = heartbeats_.find(node_id);
+    if (heartbeat_it == heartbeats_.end()) {
+      suspected_nodes_.erase(current);
+      continue;
+    }
+    if (--heartbeat_it->second == 0) {
+      RAY_LOG(WARNING) << "Suspected node timed out: " << node_id;
+      heartbeats_.erase(heartbeat_it);
+      suspected_nodes_.erase(current);
+      node_addresses_.erase(node_id);
+      raylet_client_pool_.Disconnect(node_id);
       if (on_node_death_callback_) {
         on_node_death_callback_(node_id);
       }
+      continue;
     }
+    raylet_client_pool_.GetOrConnectByAddress(node_addresses_[node_id])
+        ->ProbeNode(absl::nullopt,
+                    [this, node_id](const Status &status, const rpc::ProbeNodeReply &) {
+                      if (status.ok() && suspected_nodes_.erase(node_id) > 0) {
+                        RAY_LOG(INFO) << "Suspected node " << node_id << " replied.";
+                        auto heartbeat_it = heartbeats_.find(node_id);
+                        if (heartbeat_it != heartbeats_.end()) {
+                          heartbeat_it->second = num_heartbeats_timeout_;
+                        }
+                      }
+                    });
   }
 }
 
@@ -16,12 +16,14 @@
 #pragma once
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/asio/periodical_runner.h"
 #include "ray/common/id.h"
 #include "ray/gcs/gcs_server/gcs_init_data.h"
 #include "ray/rpc/client_call.h"
 #include "ray/rpc/gcs_server/gcs_rpc_server.h"
+#include "ray/rpc/node_manager/node_manager_client_pool.h"
 #include "src/ray/protobuf/gcs.pb.h"
 #include "src/ray/protobuf/gcs_service.pb.h"
 
@@ -30,6 +32,11 @@ namespace gcs {
 
 /// GcsHeartbeatManager is responsible for monitoring nodes liveness as well as
 /// handing heartbeat rpc requests. This class is not thread-safe.
+///
+/// If gossip failure detection is enabled, the raylets probe each other instead of
+/// sending heartbeats, and only report the nodes that they can't reach. Such a node is
+/// probed by the GCS at every heartbeat period, and marked dead if it doesn't reply for
+/// as long as a node that stopped sending heartbeats would be.
 class GcsHeartbeatManager : public rpc::HeartbeatInfoHandler {
  public:
   /// Create a GcsHeartbeatManager.
@@ -51,6 +58,11 @@ class GcsHeartbeatManager : public rpc::HeartbeatInfoHandler {
                         rpc::CheckAliveReply *reply,
                         rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Handle a node reported by a raylet that couldn't reach it.
+  void HandleReportNodeSuspected(const rpc::ReportNodeSuspectedRequest &request,
+                                 rpc::ReportNodeSuspectedReply *reply,
+                                 rpc::SendReplyCallback send_reply_callback) override;
+
   /// Initialize with the gcs tables data synchronously.
   /// This should be called when GCS server restarts after a failure.
   ///
@@ -66,14 +78,23 @@ class GcsHeartbeatManager : public rpc::HeartbeatInfoHandler {
   /// Register node to this detector.
   /// Only if the node has registered, its heartbeat data will be accepted.
   ///
-  /// \param node_id ID of the node to be registered.
-  void AddNode(const NodeID &node_id);
+  /// \param node_info The node to be registered.
+  void AddNode(const rpc::GcsNodeInfo &node_info);
+
+  /// Stop monitoring a node, e.g., once it is drained.
+  ///
+  /// \param node_id ID of the node to be removed.
+  void RemoveNode(const NodeID &node_id);
 
  protected:
   /// Check that if any raylet is inactive due to no heartbeat for a period of time.
   /// If found any, mark it as dead.
   void DetectDeadNodes();
 
+  /// Probe the suspected nodes, and mark the ones that didn't reply for too long as
+  /// dead. Used instead of `DetectDeadNodes` with gossip failure detection.
+  void DetectDeadSuspectedNodes();
+
  private:
   /// The main event loop for node failure detector.
   instrumented_io_context &io_service_;
@@ -89,6 +110,15 @@ class GcsHeartbeatManager : public rpc::HeartbeatInfoHandler {
   absl::flat_hash_map<NodeID, int64_t> heartbeats_;
   /// Is the detect started.
   bool is_started_ = false;
+  /// Whether the raylets detect each other's failures instead of sending heartbeats.
+  const bool gossip_failure_detection_;
+  /// The addresses of the raylets, to probe the suspected ones.
+  absl::flat_hash_map<NodeID, rpc::Address> node_addresses_;
+  /// The nodes that some raylet couldn't reach and that haven't replied to us since.
+  absl::flat_hash_set<NodeID> suspected_nodes_;
+  /// The clients to probe the suspected nodes, run on the detector's event loop.
+  rpc::ClientCallManager client_call_manager_;
+  rpc::NodeManagerClientPool raylet_client_pool_;
 };
 
 }  // namespace gcs
@@ -14,13 +14,18 @@
 
 #include "ray/gcs/gcs_server/gcs_init_data.h"
 
+#include "ray/util/util.h"
+
 namespace ray {
 namespace gcs {
 void GcsInitData::AsyncLoad(const EmptyCallback &on_done) {
-  // There are 6 kinds of table data need to be loaded.
+  // There are 6 kinds of table data need to be loaded. They are loaded concurrently.
   auto count_down = std::make_shared<int>(6);
-  auto on_load_finished = [count_down, on_done] {
+  const auto start_time_ms = current_time_ms();
+  auto on_load_finished = [count_down, on_done, start_time_ms] {
     if (--(*count_down) == 0) {
+      RAY_LOG(INFO) << "Finished loading the GCS tables in "
+                    << current_time_ms() - start_time_ms << " ms.";
       if (on_done) {
         on_done();
       }
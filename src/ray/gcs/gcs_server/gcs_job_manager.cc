@@ -14,6 +14,7 @@
 
 #include "ray/gcs/gcs_server/gcs_job_manager.h"
 
+#include "ray/gcs/gcs_server/gcs_table_query.h"
 #include "ray/gcs/pb_util.h"
 
 namespace ray {
@@ -149,11 +150,19 @@ void GcsJobManager::HandleGetAllJobInfo(const rpc::GetAllJobInfoRequest &request
                                         rpc::GetAllJobInfoReply *reply,
                                         rpc::SendReplyCallback send_reply_callback) {
   RAY_LOG(INFO) << "Getting all job info.";
-  auto on_done = [reply, send_reply_callback](
+  auto on_done = [&request, reply, send_reply_callback](
                      const absl::flat_hash_map<JobID, JobTableData> &result) {
+    std::vector<std::pair<std::string, const JobTableData *>> entries;
     for (auto &data : result) {
-      reply->add_job_info_list()->CopyFrom(data.second);
+      if (!request.has_is_dead() || data.second.is_dead() == request.is_dead()) {
+        entries.emplace_back(data.first.Binary(), &data.second);
+      }
     }
+    AddPageToReply(request,
+                   std::move(entries),
+                   /*borrow=*/false,
+                   reply,
+                   reply->mutable_job_info_list());
     RAY_LOG(INFO) << "Finished getting all job info.";
     GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
   };
@@ -169,6 +169,65 @@ void RedisInternalKV::Keys(const std::string &ns,
       }));
 }
 
+void RedisInternalKV::MultiGet(
+    const std::string &ns,
+    const std::vector<std::string> &keys,
+    std::function<void(absl::flat_hash_map<std::string, std::string>)> callback) {
+  if (keys.empty()) {
+    if (callback) {
+      io_service_.post(
+          [callback = std::move(callback)]() {
+            callback(absl::flat_hash_map<std::string, std::string>());
+          },
+          "RedisInternalKV.MultiGet");
+    }
+    return;
+  }
+  // The commands are pipelined on the connection, so that the keys are fetched in one
+  // round trip.
+  auto num_pending = std::make_shared<size_t>(keys.size());
+  auto results = std::make_shared<absl::flat_hash_map<std::string, std::string>>();
+  for (const auto &key : keys) {
+    std::vector<std::string> cmd = {"HGET", MakeKey(ns, key), "value"};
+    RAY_CHECK_OK(redis_client_->GetPrimaryContext()->RunArgvAsync(
+        cmd, [key, num_pending, results, callback](auto redis_reply) {
+          if (!redis_reply->IsNil()) {
+            results->emplace(key, redis_reply->ReadAsString());
+          }
+          if (--*num_pending == 0 && callback) {
+            callback(std::move(*results));
+          }
+        }));
+  }
+}
+
+void RedisInternalKV::MultiPut(
+    const std::string &ns,
+    const std::vector<std::pair<std::string, std::string>> &entries,
+    bool overwrite,
+    std::function<void(int64_t)> callback) {
+  if (entries.empty()) {
+    if (callback) {
+      io_service_.post([callback = std::move(callback)]() { callback(0); },
+                       "RedisInternalKV.MultiPut");
+    }
+    return;
+  }
+  auto num_pending = std::make_shared<size_t>(entries.size());
+  auto num_added = std::make_shared<int64_t>(0);
+  for (const auto &entry : entries) {
+    std::vector<std::string> cmd = {
+        overwrite ? "HSET" : "HSETNX", MakeKey(ns, entry.first), "value", entry.second};
+    RAY_CHECK_OK(redis_client_->GetPrimaryContext()->RunArgvAsync(
+        cmd, [num_pending, num_added, callback](auto redis_reply) {
+          *num_added += redis_reply->ReadAsInteger() != 0;
+          if (--*num_pending == 0 && callback) {
+            callback(*num_added);
+          }
+        }));
+  }
+}
+
 void MemoryInternalKV::Get(const std::string &ns,
                            const std::string &key,
                            std::function<void(std::optional<std::string>)> callback) {
@@ -262,6 +321,45 @@ void MemoryInternalKV::Keys(const std::string &ns,
   }
 }
 
+void MemoryInternalKV::MultiGet(
+    const std::string &ns,
+    const std::vector<std::string> &keys,
+    std::function<void(absl::flat_hash_map<std::string, std::string>)> callback) {
+  absl::ReaderMutexLock lock(&mu_);
+  absl::flat_hash_map<std::string, std::string> results;
+  for (const auto &key : keys) {
+    auto it = map_.find(MakeKey(ns, key));
+    if (it != map_.end()) {
+      results.emplace(key, it->second);
+    }
+  }
+  if (callback != nullptr) {
+    io_context_.post(std::bind(std::move(callback), std::move(results)),
+                     "MemoryInternalKV.MultiGet");
+  }
+}
+
+void MemoryInternalKV::MultiPut(
+    const std::string &ns,
+    const std::vector<std::pair<std::string, std::string>> &entries,
+    bool overwrite,
+    std::function<void(int64_t)> callback) {
+  absl::WriterMutexLock _(&mu_);
+  int64_t num_added = 0;
+  for (const auto &entry : entries) {
+    auto result = map_.emplace(MakeKey(ns, entry.first), entry.second);
+    if (result.second) {
+      ++num_added;
+    } else if (overwrite) {
+      result.first->second = entry.second;
+    }
+  }
+  if (callback != nullptr) {
+    io_context_.post(std::bind(std::move(callback), num_added),
+                     "MemoryInternalKV.MultiPut");
+  }
+}
+
 void GcsInternalKVManager::HandleInternalKVGet(
     const rpc::InternalKVGetRequest &request,
     rpc::InternalKVGetReply *reply,
@@ -357,5 +455,53 @@ void GcsInternalKVManager::HandleInternalKVKeys(
   }
 }
 
+void GcsInternalKVManager::HandleInternalKVMultiGet(
+    const rpc::InternalKVMultiGetRequest &request,
+    rpc::InternalKVMultiGetReply *reply,
+    rpc::SendReplyCallback send_reply_callback) {
+  std::vector<std::string> keys;
+  keys.reserve(request.keys_size());
+  for (const auto &key : request.keys()) {
+    auto status = ValidateKey(key);
+    if (!status.ok()) {
+      GCS_RPC_SEND_REPLY(send_reply_callback, reply, status);
+      return;
+    }
+    keys.push_back(key);
+  }
+  auto callback = [reply, send_reply_callback](
+                      absl::flat_hash_map<std::string, std::string> results) {
+    for (auto &result : results) {
+      auto *entry = reply->add_results();
+      entry->set_key(result.first);
+      entry->set_value(std::move(result.second));
+    }
+    GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+  };
+  kv_instance_->MultiGet(request.namespace_(), keys, std::move(callback));
+}
+
+void GcsInternalKVManager::HandleInternalKVMultiPut(
+    const rpc::InternalKVMultiPutRequest &request,
+    rpc::InternalKVMultiPutReply *reply,
+    rpc::SendReplyCallback send_reply_callback) {
+  std::vector<std::pair<std::string, std::string>> entries;
+  entries.reserve(request.entries_size());
+  for (const auto &entry : request.entries()) {
+    auto status = ValidateKey(entry.key());
+    if (!status.ok()) {
+      GCS_RPC_SEND_REPLY(send_reply_callback, reply, status);
+      return;
+    }
+    entries.emplace_back(entry.key(), entry.value());
+  }
+  auto callback = [reply, send_reply_callback](int64_t num_added) {
+    reply->set_added_num(num_added);
+    GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+  };
+  kv_instance_->MultiPut(
+      request.namespace_(), entries, request.overwrite(), std::move(callback));
+}
+
 }  // namespace gcs
 }  // namespace ray
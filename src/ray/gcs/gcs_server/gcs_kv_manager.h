@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/gcs/redis_client.h"
 #include "ray/gcs/store_client/redis_store_client.h"
@@ -83,6 +84,28 @@ class InternalKVInterface {
                     const std::string &prefix,
                     std::function<void(std::vector<std::string>)> callback) = 0;
 
+  /// Get the values associated with `keys`, in one pass over the store.
+  ///
+  /// \param ns The namespace of the keys.
+  /// \param keys The keys to fetch.
+  /// \param callback Callback function, called with the values of the keys that exist.
+  virtual void MultiGet(
+      const std::string &ns,
+      const std::vector<std::string> &keys,
+      std::function<void(absl::flat_hash_map<std::string, std::string>)> callback) = 0;
+
+  /// Associate keys with the specified values, in one pass over the store.
+  ///
+  /// \param ns The namespace of the keys.
+  /// \param entries The <key, value> pairs.
+  /// \param overwrite Whether to overwrite existing values. Otherwise, the updates
+  ///   of the existing keys will be ignored.
+  /// \param callback Callback function, called with the number of keys added.
+  virtual void MultiPut(const std::string &ns,
+                        const std::vector<std::pair<std::string, std::string>> &entries,
+                        bool overwrite,
+                        std::function<void(int64_t)> callback) = 0;
+
   /// Return the event loop associated with the instance. This is where the
   /// callback is called.
   virtual instrumented_io_context &GetEventLoop() = 0;
@@ -124,6 +147,17 @@ class RedisInternalKV : public InternalKVInterface {
             const std::string &prefix,
             std::function<void(std::vector<std::string>)> callback) override;
 
+  void MultiGet(
+      const std::string &ns,
+      const std::vector<std::string> &keys,
+      std::function<void(absl::flat_hash_map<std::string, std::string>)> callback)
+      override;
+
+  void MultiPut(const std::string &ns,
+                const std::vector<std::pair<std::string, std::string>> &entries,
+                bool overwrite,
+                std::function<void(int64_t)> callback) override;
+
   instrumented_io_context &GetEventLoop() override { return io_service_; }
 
  private:
@@ -161,6 +195,17 @@ class MemoryInternalKV : public InternalKVInterface {
             const std::string &prefix,
             std::function<void(std::vector<std::string>)> callback) override;
 
+  void MultiGet(
+      const std::string &ns,
+      const std::vector<std::string> &keys,
+      std::function<void(absl::flat_hash_map<std::string, std::string>)> callback)
+      override;
+
+  void MultiPut(const std::string &ns,
+                const std::vector<std::pair<std::string, std::string>> &entries,
+                bool overwrite,
+                std::function<void(int64_t)> callback) override;
+
   instrumented_io_context &GetEventLoop() override { return io_context_; }
 
  private:
@@ -195,6 +240,14 @@ class GcsInternalKVManager : public rpc::InternalKVHandler {
                             rpc::InternalKVKeysReply *reply,
                             rpc::SendReplyCallback send_reply_callback) override;
 
+  void HandleInternalKVMultiGet(const rpc::InternalKVMultiGetRequest &request,
+                                rpc::InternalKVMultiGetReply *reply,
+                                rpc::SendReplyCallback send_reply_callback) override;
+
+  void HandleInternalKVMultiPut(const rpc::InternalKVMultiPutRequest &request,
+                                rpc::InternalKVMultiPutReply *reply,
+                                rpc::SendReplyCallback send_reply_callback) override;
+
   InternalKVInterface &GetInstance() { return *kv_instance_; }
 
   instrumented_io_context &GetEventLoop() { return kv_instance_->GetEventLoop(); }
@@ -17,6 +17,7 @@
 #include <utility>
 
 #include "ray/common/ray_config.h"
+#include "ray/gcs/gcs_server/gcs_table_query.h"
 #include "ray/gcs/pb_util.h"
 #include "ray/stats/stats.h"
 #include "ray/util/event.h"
@@ -141,12 +142,22 @@ void GcsNodeManager::HandleGetAllNodeInfo(const rpc::GetAllNodeInfoRequest &requ
   // then reply.
   // The request will be sent when call send_reply_callback and after that, reply will
   // not be used any more. But entry is still valid.
-  for (const auto &entry : alive_nodes_) {
-    reply->mutable_node_info_list()->UnsafeArenaAddAllocated(entry.second.get());
+  std::vector<std::pair<std::string, const rpc::GcsNodeInfo *>> entries;
+  if (!request.has_state() || request.state() == rpc::GcsNodeInfo::ALIVE) {
+    for (const auto &entry : alive_nodes_) {
+      entries.emplace_back(entry.first.Binary(), entry.second.get());
+    }
   }
-  for (const auto &entry : dead_nodes_) {
-    reply->mutable_node_info_list()->UnsafeArenaAddAllocated(entry.second.get());
+  if (!request.has_state() || request.state() == rpc::GcsNodeInfo::DEAD) {
+    for (const auto &entry : dead_nodes_) {
+      entries.emplace_back(entry.first.Binary(), entry.second.get());
+    }
   }
+  AddPageToReply(request,
+                 std::move(entries),
+                 /*borrow=*/true,
+                 reply,
+                 reply->mutable_node_info_list());
   GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
   ++counts_[CountType::GET_ALL_NODE_INFO_REQUEST];
 }
@@ -263,7 +263,15 @@ void GcsPlacementGroupManager::OnPlacementGroupCreationFailed(
       AddToPendingQueue(std::move(placement_group), /* rank */ 0);
     } else if (state == rpc::PlacementGroupTableData::PENDING) {
       stats->set_scheduling_state(rpc::PlacementGroupStats::NO_RESOURCES);
-      AddToPendingQueue(std::move(placement_group), std::nullopt, backoff);
+      if (RayConfig::instance().gcs_placement_group_batch_scheduling() &&
+          !gcs_placement_group_scheduler_->FitsAvailableResources(placement_group)) {
+        // The placement group waits for resources at its original place in the queue,
+        // and is skipped by each round until its bundles fit.
+        auto rank = stats->creation_request_received_ns();
+        AddToPendingQueue(std::move(placement_group), rank);
+      } else {
+        AddToPendingQueue(std::move(placement_group), std::nullopt, backoff);
+      }
     } else {
       stats->set_scheduling_state(rpc::PlacementGroupStats::REMOVED);
       AddToPendingQueue(std::move(placement_group), std::nullopt, backoff);
@@ -334,9 +342,11 @@ void GcsPlacementGroupManager::SchedulePendingPlacementGroups() {
     return;
   }
 
+  const bool batch_scheduling =
+      RayConfig::instance().gcs_placement_group_batch_scheduling();
   bool is_new_placement_group_scheduled = false;
-  while (!pending_placement_groups_.empty() && !is_new_placement_group_scheduled) {
-    auto iter = pending_placement_groups_.begin();
+  auto iter = pending_placement_groups_.begin();
+  while (iter != pending_placement_groups_.end() && !is_new_placement_group_scheduled) {
     if (iter->first > absl::GetCurrentTimeNanos()) {
       // Here the rank equals the time to schedule, and it's an ordered tree,
       // it means all the other tasks should be scheduled after this one.
@@ -344,9 +354,19 @@ void GcsPlacementGroupManager::SchedulePendingPlacementGroups() {
       // Tick will cover the next time retry.
       break;
     }
+    if (batch_scheduling &&
+        registered_placement_groups_.contains(
+            iter->second.second->GetPlacementGroupID()) &&
+        !gcs_placement_group_scheduler_->FitsAvailableResources(iter->second.second)) {
+      // Leave the placement group in the queue, and try the ones after it.
+      iter->second.second->GetMutableStats()->set_scheduling_state(
+          rpc::PlacementGroupStats::NO_RESOURCES);
+      ++iter;
+      continue;
+    }
     auto backoff = iter->second.first;
     auto placement_group = std::move(iter->second.second);
-    pending_placement_groups_.erase(iter);
+    iter = pending_placement_groups_.erase(iter);
 
     const auto &placement_group_id = placement_group->GetPlacementGroupID();
     // Do not reschedule if the placement group has removed already.
@@ -380,6 +380,8 @@ class GcsPlacementGroupManager : public rpc::PlacementGroupInfoHandler {
   /// inserting an element into the queue with a bigger key. With this, we don't
   /// need to post retry job to io context. And when schedule pending placement
   /// group, we always start with the one with the smallest key.
+  /// With gcs_placement_group_batch_scheduling, the placement groups that don't fit
+  /// the available resources stay in the queue and are skipped.
   absl::btree_multimap<int64_t,
                        std::pair<ExponentialBackOff, std::shared_ptr<GcsPlacementGroup>>>
       pending_placement_groups_;
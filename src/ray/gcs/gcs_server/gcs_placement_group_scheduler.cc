@@ -136,6 +136,26 @@ void GcsPlacementGroupScheduler::ScheduleUnplacedBundles(
   }
 }
 
+bool GcsPlacementGroupScheduler::FitsAvailableResources(
+    const std::shared_ptr<GcsPlacementGroup> &placement_group) {
+  const auto &bundles = placement_group->GetUnplacedBundles();
+  if (bundles.empty()) {
+    return true;
+  }
+  std::vector<const ResourceRequest *> resource_request_list;
+  resource_request_list.reserve(bundles.size());
+  for (const auto &bundle : bundles) {
+    resource_request_list.emplace_back(&bundle->GetRequiredResources());
+  }
+  // The policies release the resources they deduct while scheduling, so this doesn't
+  // change the resource view.
+  auto scheduling_options = CreateSchedulingOptions(
+      placement_group->GetPlacementGroupID(), placement_group->GetStrategy());
+  auto scheduling_result =
+      cluster_resource_scheduler_.Schedule(resource_request_list, scheduling_options);
+  return !scheduling_result.status.IsFailed();
+}
+
 void GcsPlacementGroupScheduler::DestroyPlacementGroupBundleResourcesIfExists(
     const PlacementGroupID &placement_group_id) {
   auto &bundle_locations =
@@ -217,38 +237,51 @@ void GcsPlacementGroupScheduler::CommitResources(
 }
 
 void GcsPlacementGroupScheduler::CancelResourceReserve(
-    const std::shared_ptr<const BundleSpecification> &bundle_spec,
+    const std::vector<std::shared_ptr<const BundleSpecification>> &bundles,
     const absl::optional<std::shared_ptr<ray::rpc::GcsNodeInfo>> &node) {
   if (!node.has_value()) {
-    RAY_LOG(INFO) << "Node for a placement group id " << bundle_spec->PlacementGroupId()
-                  << " and a bundle index, " << bundle_spec->Index()
+    RAY_LOG(INFO) << "Node for bundles " << GetDebugStringForBundles(bundles)
                   << " has already removed. Cancellation request will be ignored.";
     return;
   }
   auto node_id = NodeID::FromBinary(node.value()->node_id());
-  RAY_LOG(DEBUG) << "Cancelling the resource reserved for bundle: "
-                 << bundle_spec->DebugString() << " at node " << node_id;
+  RAY_LOG(DEBUG) << "Cancelling the resource reserved for bundles: "
+                 << GetDebugStringForBundles(bundles) << " at node " << node_id;
   const auto return_client = GetLeaseClientFromNode(node.value());
 
   return_client->CancelResourceReserve(
-      *bundle_spec,
-      [this, bundle_spec, node_id](const Status &status,
-                                   const rpc::CancelResourceReserveReply &reply) {
-        RAY_LOG(DEBUG) << "Finished cancelling the resource reserved for bundle: "
-                       << bundle_spec->DebugString() << " at node " << node_id;
-        std::vector<std::string> resource_names;
-        rpc::NodeResourceChange node_resource_change;
-        auto &resources = bundle_spec->GetFormattedResources();
-        for (const auto &iter : resources) {
-          resource_names.push_back(iter.first);
-          node_resource_change.add_deleted_resources(iter.first);
+      bundles,
+      [this, bundles, node_id](const Status &status,
+                               const rpc::CancelResourceReserveReply &reply) {
+        RAY_LOG(DEBUG) << "Finished cancelling the resource reserved for bundles: "
+                       << GetDebugStringForBundles(bundles) << " at node " << node_id;
+        for (const auto &bundle_spec : bundles) {
+          std::vector<std::string> resource_names;
+          rpc::NodeResourceChange node_resource_change;
+          auto &resources = bundle_spec->GetFormattedResources();
+          for (const auto &iter : resources) {
+            resource_names.push_back(iter.first);
+            node_resource_change.add_deleted_resources(iter.first);
+          }
+          node_resource_change.set_node_id(node_id.Binary());
+          ray_syncer_.Update(std::move(node_resource_change));
+          gcs_resource_manager_.DeleteResources(node_id, std::move(resource_names));
         }
-        node_resource_change.set_node_id(node_id.Binary());
-        ray_syncer_.Update(std::move(node_resource_change));
-        gcs_resource_manager_.DeleteResources(node_id, std::move(resource_names));
       });
 }
 
+void GcsPlacementGroupScheduler::CancelResourceReserve(
+    const BundleLocations &bundle_locations) {
+  absl::flat_hash_map<NodeID, std::vector<std::shared_ptr<const BundleSpecification>>>
+      bundles_per_node;
+  for (const auto &iter : bundle_locations) {
+    bundles_per_node[iter.second.first].emplace_back(iter.second.second);
+  }
+  for (const auto &[node_id, bundles] : bundles_per_node) {
+    CancelResourceReserve(bundles, gcs_node_manager_.GetAliveNode(node_id));
+  }
+}
+
 std::shared_ptr<ResourceReserveInterface>
 GcsPlacementGroupScheduler::GetOrConnectLeaseClient(const rpc::Address &raylet_address) {
   return raylet_client_pool_->GetOrConnectByAddress(raylet_address);
@@ -439,9 +472,9 @@ SchedulingOptions GcsPlacementGroupScheduler::CreateSchedulingOptions(
     const PlacementGroupID &placement_group_id, rpc::PlacementStrategy strategy) {
   switch (strategy) {
   case rpc::PlacementStrategy::PACK:
-    return SchedulingOptions::BundlePack();
+    return SchedulingOptions::BundlePack(CreateSchedulingContext(placement_group_id));
   case rpc::PlacementStrategy::SPREAD:
-    return SchedulingOptions::BundleSpread();
+    return SchedulingOptions::BundleSpread(CreateSchedulingContext(placement_group_id));
   case rpc::PlacementStrategy::STRICT_PACK:
     return SchedulingOptions::BundleStrictPack();
   case rpc::PlacementStrategy::STRICT_SPREAD:
@@ -536,11 +569,7 @@ void GcsPlacementGroupScheduler::DestroyPlacementGroupPreparedBundleResources(
     // Cancel all resource reservation of prepared bundles.
     RAY_LOG(INFO) << "Cancelling all prepared bundles of a placement group, id is "
                   << placement_group_id;
-    for (const auto &iter : *(leasing_bundle_locations)) {
-      auto &bundle_spec = iter.second.second;
-      auto &node_id = iter.second.first;
-      CancelResourceReserve(bundle_spec, gcs_node_manager_.GetAliveNode(node_id));
-    }
+    CancelResourceReserve(*leasing_bundle_locations);
   }
 }
 
@@ -555,11 +584,7 @@ void GcsPlacementGroupScheduler::DestroyPlacementGroupCommittedBundleResources(
     // Cancel all resource reservation of committed bundles.
     RAY_LOG(INFO) << "Cancelling all committed bundles of a placement group, id is "
                   << placement_group_id;
-    for (const auto &iter : *(committed_bundle_locations)) {
-      auto &bundle_spec = iter.second.second;
-      auto &node_id = iter.second.first;
-      CancelResourceReserve(bundle_spec, gcs_node_manager_.GetAliveNode(node_id));
-    }
+    CancelResourceReserve(*committed_bundle_locations);
     committed_bundle_location_index_.Erase(placement_group_id);
   }
 }
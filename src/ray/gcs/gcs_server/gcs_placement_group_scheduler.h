@@ -61,6 +61,14 @@ class GcsPlacementGroupSchedulerInterface {
       PGSchedulingFailureCallback failure_callback,
       PGSchedulingSuccessfulCallback success_callback) = 0;
 
+  /// Check whether the unplaced bundles of the placement group fit the resources that
+  /// are available in the cluster, without reserving them.
+  ///
+  /// \param placement_group The placement group to check.
+  /// \return False if the bundles are feasible, but don't fit the available resources.
+  virtual bool FitsAvailableResources(
+      const std::shared_ptr<GcsPlacementGroup> &placement_group) = 0;
+
   /// Get bundles belong to the specified node.
   ///
   /// \param node_id ID of the dead node.
@@ -354,6 +362,9 @@ class GcsPlacementGroupScheduler : public GcsPlacementGroupSchedulerInterface {
                                PGSchedulingFailureCallback failure_handler,
                                PGSchedulingSuccessfulCallback success_handler) override;
 
+  bool FitsAvailableResources(
+      const std::shared_ptr<GcsPlacementGroup> &placement_group) override;
+
   /// Destroy the actual bundle resources or locked resources (for 2PC)
   /// on all nodes associated with this placement group.
   /// The method is idempotent, meaning if all bundles are already cancelled,
@@ -418,16 +429,21 @@ class GcsPlacementGroupScheduler : public GcsPlacementGroupSchedulerInterface {
       const absl::optional<std::shared_ptr<ray::rpc::GcsNodeInfo>> &node,
       const StatusCallback callback);
 
-  /// Cacnel prepared or committed resources from a node.
+  /// Cacnel prepared or committed resources from a node, in one request.
   /// Nodes will be in charge of tracking state of a bundle.
   /// This method is supposed to be idempotent.
   ///
-  /// \param bundle A description of the bundle to return.
+  /// \param bundles Descriptions of the bundles on the node to return.
   /// \param node The node that the worker will be returned for.
   void CancelResourceReserve(
-      const std::shared_ptr<const BundleSpecification> &bundle_spec,
+      const std::vector<std::shared_ptr<const BundleSpecification>> &bundles,
       const absl::optional<std::shared_ptr<ray::rpc::GcsNodeInfo>> &node);
 
+  /// Cancel the reserved resources of the bundles, with one request per node.
+  ///
+  /// \param bundle_locations The bundles to return, and the nodes they are on.
+  void CancelResourceReserve(const BundleLocations &bundle_locations);
+
   /// Get an existing lease client or connect a new one or connect a new one.
   std::shared_ptr<ResourceReserveInterface> GetOrConnectLeaseClient(
       const rpc::Address &raylet_address);
@@ -0,0 +1,210 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/gcs_server/gcs_profile_event_store.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ray {
+namespace gcs {
+
+namespace {
+
+int64_t ToMicroseconds(double seconds) { return std::llround(seconds * 1e6); }
+
+double ToSeconds(int64_t microseconds) { return microseconds / 1e6; }
+
+void PutVarint(uint64_t value, std::string *buffer) {
+  while (value >= 0x80) {
+    buffer->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  buffer->push_back(static_cast<char>(value));
+}
+
+uint64_t GetVarint(const std::string &buffer, size_t *position) {
+  uint64_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    const uint8_t byte = buffer[(*position)++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}  // namespace
+
+uint32_t GcsProfileEventStore::Dictionary::Encode(const std::string &value) {
+  auto it = codes_.find(value);
+  if (it != codes_.end()) {
+    return it->second;
+  }
+  const uint32_t code = values_.size();
+  values_.push_back(value);
+  codes_.emplace(value, code);
+  return code;
+}
+
+int64_t GcsProfileEventStore::Dictionary::Find(const std::string &value) const {
+  auto it = codes_.find(value);
+  return it == codes_.end() ? -1 : it->second;
+}
+
+void GcsProfileEventStore::Add(const rpc::ProfileTableData &data) {
+  if (max_events_ == 0) {
+    return;
+  }
+  // The component is the same for all the events of the batch, so it's only encoded
+  // again when they continue in a new partition.
+  const Partition *component_partition = nullptr;
+  uint32_t component_code = 0;
+  for (const auto &event : data.profile_events()) {
+    if (partitions_.empty() ||
+        partitions_.back().event_components.size() == events_per_partition_) {
+      partitions_.emplace_back();
+      component_partition = nullptr;
+    }
+    auto &partition = partitions_.back();
+    if (component_partition != &partition) {
+      const Component component{partition.strings.Encode(data.component_type()),
+                                partition.strings.Encode(data.component_id()),
+                                partition.strings.Encode(data.node_ip_address())};
+      auto it = partition.component_codes.find(component);
+      if (it == partition.component_codes.end()) {
+        it = partition.component_codes.emplace(component, partition.components.size())
+                 .first;
+        partition.components.push_back(component);
+      }
+      component_partition = &partition;
+      component_code = it->second;
+    }
+
+    const int64_t start_time_us = ToMicroseconds(event.start_time());
+    const int64_t end_time_us =
+        std::max(ToMicroseconds(event.end_time()), start_time_us);
+    partition.event_components.push_back(component_code);
+    partition.event_types.push_back(partition.strings.Encode(event.event_type()));
+    partition.extra_data.push_back(partition.strings.Encode(event.extra_data()));
+    PutVarint(ZigZagEncode(start_time_us - partition.last_start_time_us),
+              &partition.start_time_deltas);
+    PutVarint(end_time_us - start_time_us, &partition.durations);
+    partition.last_start_time_us = start_time_us;
+    partition.min_start_time_us = std::min(partition.min_start_time_us, start_time_us);
+    partition.max_end_time_us = std::max(partition.max_end_time_us, end_time_us);
+
+    num_events_++;
+    if (num_events_ > max_events_) {
+      PopFront();
+    }
+  }
+}
+
+void GcsProfileEventStore::PopFront() {
+  auto &partition = partitions_.front();
+  partition.num_dropped++;
+  num_events_--;
+  if (partition.num_dropped == partition.event_components.size()) {
+    partitions_.pop_front();
+  }
+}
+
+void GcsProfileEventStore::Query(const rpc::GetAllProfileInfoRequest &request,
+                                 rpc::GetAllProfileInfoReply *reply) const {
+  const bool has_start_time = request.start_time() > 0;
+  const bool has_end_time = request.end_time() > 0;
+  const int64_t start_time_us = ToMicroseconds(request.start_time());
+  const int64_t end_time_us = ToMicroseconds(request.end_time());
+  int64_t num_remaining = request.limit() > 0 ? request.limit() : INT64_MAX;
+
+  for (const auto &partition : partitions_) {
+    if (num_remaining == 0) {
+      break;
+    }
+    if ((has_start_time && partition.max_end_time_us < start_time_us) ||
+        (has_end_time && partition.min_start_time_us >= end_time_us)) {
+      continue;
+    }
+
+    // Resolve the filter of the component to the codes of the partition, so that the
+    // events are filtered without decoding their strings.
+    std::vector<bool> component_matches(partition.components.size(), true);
+    if (!request.component_type().empty() || !request.component_id().empty()) {
+      const int64_t type_code = request.component_type().empty()
+                                    ? -1
+                                    : partition.strings.Find(request.component_type());
+      const int64_t id_code = request.component_id().empty()
+                                  ? -1
+                                  : partition.strings.Find(request.component_id());
+      bool any_component_matches = false;
+      for (size_t i = 0; i < partition.components.size(); i++) {
+        const auto &component = partition.components[i];
+        component_matches[i] =
+            (request.component_type().empty() || std::get<0>(component) == type_code) &&
+            (request.component_id().empty() || std::get<1>(component) == id_code);
+        any_component_matches = any_component_matches || component_matches[i];
+      }
+      if (!any_component_matches) {
+        continue;
+      }
+    }
+
+    absl::flat_hash_map<uint32_t, rpc::ProfileTableData *> batches;
+    size_t start_time_position = 0;
+    size_t duration_position = 0;
+    int64_t event_start_time_us = 0;
+    for (size_t i = 0; i < partition.event_components.size() && num_remaining > 0;
+         i++) {
+      // The times are decoded for every event, since each start time is relative to
+      // the previous one.
+      event_start_time_us +=
+          ZigZagDecode(GetVarint(partition.start_time_deltas, &start_time_position));
+      const int64_t event_end_time_us =
+          event_start_time_us + GetVarint(partition.durations, &duration_position);
+      const uint32_t component_code = partition.event_components[i];
+      if (i < partition.num_dropped || !component_matches[component_code] ||
+          (has_start_time && event_end_time_us < start_time_us) ||
+          (has_end_time && event_start_time_us >= end_time_us)) {
+        continue;
+      }
+
+      auto &batch = batches[component_code];
+      if (batch == nullptr) {
+        const auto &component = partition.components[component_code];
+        batch = reply->add_profile_info_list();
+        batch->set_component_type(partition.strings.Decode(std::get<0>(component)));
+        batch->set_component_id(partition.strings.Decode(std::get<1>(component)));
+        batch->set_node_ip_address(partition.strings.Decode(std::get<2>(component)));
+      }
+      auto *event = batch->add_profile_events();
+      event->set_event_type(partition.strings.Decode(partition.event_types[i]));
+      event->set_start_time(ToSeconds(event_start_time_us));
+      event->set_end_time(ToSeconds(event_end_time_us));
+      event->set_extra_data(partition.strings.Decode(partition.extra_data[i]));
+      num_remaining--;
+    }
+  }
+}
+
+}  // namespace gcs
+}  // namespace ray
@@ -0,0 +1,115 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "src/ray/protobuf/gcs.pb.h"
+#include "src/ray/protobuf/gcs_service.pb.h"
+
+namespace ray {
+namespace gcs {
+
+/// \class GcsProfileEventStore
+/// An in-memory store of the profile events that the components of the cluster report,
+/// which are the events of the tasks shown by the timeline and the state API.
+///
+/// The events are kept in columns, in partitions of consecutive events. The strings
+/// that repeat across events (the component, the event type, which holds the function
+/// name of task events, and the extra data, which holds the task ID) are
+/// dictionary-encoded per partition, so that they are dropped with it. The start times
+/// are delta-encoded and the durations stored as varints, both in microseconds. Each
+/// partition keeps the range of times of its events, so that queries skip the
+/// partitions and the components that their filter excludes before decoding any event.
+///
+/// Once the store is full, the oldest events are dropped.
+class GcsProfileEventStore {
+ public:
+  /// \param max_events The maximum number of events to keep.
+  /// \param events_per_partition The number of events of each partition.
+  explicit GcsProfileEventStore(size_t max_events,
+                                size_t events_per_partition = 64 * 1024)
+      : max_events_(max_events), events_per_partition_(events_per_partition) {}
+
+  /// Add the events of a batch.
+  void Add(const rpc::ProfileTableData &data);
+
+  /// Get the events that match a filter, oldest first. The events of each component are
+  /// grouped in batches, with at most one batch per component and partition.
+  ///
+  /// \param request The filter of the events. Its unset fields match all events.
+  /// \param[out] reply The reply, to which the batches are added.
+  void Query(const rpc::GetAllProfileInfoRequest &request,
+             rpc::GetAllProfileInfoReply *reply) const;
+
+  /// The number of events in the store.
+  size_t Size() const { return num_events_; }
+
+ private:
+  /// Strings that repeat across events, stored once each.
+  class Dictionary {
+   public:
+    uint32_t Encode(const std::string &value);
+    /// \return The code of a string, or -1 if it isn't in the dictionary.
+    int64_t Find(const std::string &value) const;
+    const std::string &Decode(uint32_t code) const { return values_[code]; }
+
+   private:
+    std::vector<std::string> values_;
+    absl::flat_hash_map<std::string, uint32_t> codes_;
+  };
+
+  /// The codes of the type, ID and IP address of a component.
+  using Component = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+  struct Partition {
+    Dictionary strings;
+    std::vector<Component> components;
+    absl::flat_hash_map<Component, uint32_t> component_codes;
+
+    /// The columns of the events.
+    std::vector<uint32_t> event_components;
+    std::vector<uint32_t> event_types;
+    std::vector<uint32_t> extra_data;
+    /// The zigzag-encoded differences between the start time of each event and the
+    /// previous one, as varints.
+    std::string start_time_deltas;
+    /// The differences between the end time and the start time of each event, as
+    /// varints.
+    std::string durations;
+
+    /// The number of events at the front of the partition that were dropped.
+    size_t num_dropped = 0;
+    int64_t last_start_time_us = 0;
+    int64_t min_start_time_us = INT64_MAX;
+    int64_t max_end_time_us = INT64_MIN;
+  };
+
+  /// Drop the oldest event.
+  void PopFront();
+
+  const size_t max_events_;
+  const size_t events_per_partition_;
+  size_t num_events_ = 0;
+  std::deque<Partition> partitions_;
+};
+
+}  // namespace gcs
+}  // namespace ray
@@ -23,6 +23,7 @@ GcsResourceReportPoller::GcsResourceReportPoller(
     std::function<int64_t(void)> get_current_time_milli,
     std::function<void(
         const rpc::Address &,
+        int64_t,
         std::shared_ptr<rpc::NodeManagerClientPool> &,
         std::function<void(const Status &, const rpc::RequestResourceReportReply &)>)>
         request_report)
@@ -33,7 +34,9 @@ GcsResourceReportPoller::GcsResourceReportPoller(
       handle_resource_report_(handle_resource_report),
       get_current_time_milli_(get_current_time_milli),
       request_report_(request_report),
-      poll_period_ms_(RayConfig::instance().gcs_resource_report_poll_period_ms()) {}
+      poll_period_ms_(RayConfig::instance().gcs_resource_report_poll_period_ms()),
+      max_poll_period_ms_(
+          RayConfig::instance().gcs_resource_report_max_poll_period_ms()) {}
 
 GcsResourceReportPoller::~GcsResourceReportPoller() { Stop(); }
 
@@ -80,7 +83,8 @@ void GcsResourceReportPoller::HandleNodeAdded(const rpc::GcsNodeInfo &node_info)
   auto state = std::make_shared<PullState>(NodeID::FromBinary(node_info.node_id()),
                                            std::move(address),
                                            -1,
-                                           get_current_time_milli_());
+                                           get_current_time_milli_(),
+                                           poll_period_ms_);
 
   const auto &node_id = state->node_id;
 
@@ -130,32 +134,58 @@ void GcsResourceReportPoller::TryPullResourceReport() {
 void GcsResourceReportPoller::PullResourceReport(const std::shared_ptr<PullState> state) {
   inflight_pulls_++;
 
+  // Let the raylet skip an unchanged report, unless the node is due for a full one.
+  const int64_t last_report_version =
+      max_poll_period_ms_ > poll_period_ms_ && state->poll_period_ms < max_poll_period_ms_
+          ? state->report_version
+          : 0;
   request_report_(
       state->address,
+      last_report_version,
       raylet_client_pool_,
       [this, state](const Status &status, const rpc::RequestResourceReportReply &reply) {
+        absl::optional<int64_t> report_version;
         if (status.ok()) {
           // TODO (Alex): This callback is always posted onto the main thread. Since most
           // of the work is in the callback we should move this callback's execution to
           // the polling thread. We will need to implement locking once we switch threads.
-          handle_resource_report_(reply.resources());
+          if (!reply.unchanged()) {
+            handle_resource_report_(reply.resources());
+          }
+          report_version = reply.report_version();
         } else {
           RAY_LOG(INFO) << "Couldn't get resource request from raylet " << state->node_id
                         << ": " << status.ToString();
         }
-        polling_service_.post([this, state]() { NodeResourceReportReceived(state); },
-                              "GcsResourceReportPoller.PullResourceReport");
+        polling_service_.post(
+            [this, state, report_version]() {
+              NodeResourceReportReceived(state, report_version);
+            },
+            "GcsResourceReportPoller.PullResourceReport");
       });
 }
 
 void GcsResourceReportPoller::NodeResourceReportReceived(
-    const std::shared_ptr<PullState> state) {
+    const std::shared_ptr<PullState> state, absl::optional<int64_t> report_version) {
   absl::MutexLock guard(&mutex_);
   inflight_pulls_--;
 
+  if (max_poll_period_ms_ > poll_period_ms_) {
+    // Back off from a node whose report didn't change, and poll a node whose report
+    // changed, or that couldn't be polled, at the base period again.
+    if (report_version && *report_version == state->report_version) {
+      state->poll_period_ms = std::min(state->poll_period_ms * 2, max_poll_period_ms_);
+    } else {
+      state->poll_period_ms = poll_period_ms_;
+    }
+  }
+  if (report_version) {
+    state->report_version = *report_version;
+  }
+
   // Schedule the next pull. The scheduling `TryPullResourceReport` loop will handle
   // validating that this node is still in the cluster.
-  state->next_pull_time = get_current_time_milli_() + poll_period_ms_;
+  state->next_pull_time = get_current_time_milli_() + state->poll_period_ms;
   to_pull_queue_.push_back(state);
 
   polling_service_.post([this] { TryPullResourceReport(); },
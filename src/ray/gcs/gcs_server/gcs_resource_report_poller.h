@@ -13,6 +13,7 @@
 // limitations under the License.
 #pragma once
 
+#include "absl/types/optional.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/gcs/gcs_server/gcs_resource_manager.h"
 #include "ray/rpc/node_manager/node_manager_client_pool.h"
@@ -55,15 +56,17 @@ class GcsResourceReportPoller {
           []() { return absl::GetCurrentTimeNanos() / (1000 * 1000); },
       std::function<void(
           const rpc::Address &,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>)>
           request_report =
               [](const rpc::Address &address,
+                 int64_t last_report_version,
                  std::shared_ptr<rpc::NodeManagerClientPool> &raylet_client_pool,
                  std::function<void(const Status &,
                                     const rpc::RequestResourceReportReply &)> callback) {
                 auto raylet_client = raylet_client_pool->GetOrConnectByAddress(address);
-                raylet_client->RequestResourceReport(callback);
+                raylet_client->RequestResourceReport(last_report_version, callback);
               });
 
   ~GcsResourceReportPoller();
@@ -103,29 +106,41 @@ class GcsResourceReportPoller {
 
   // Return the current time in miliseconds
   std::function<int64_t(void)> get_current_time_milli_;
-  // Send the `RequestResourceReport` RPC.
+  // Send the `RequestResourceReport` RPC, with the version of the last report received
+  // from the node.
   std::function<void(
       const rpc::Address &,
+      int64_t,
       std::shared_ptr<rpc::NodeManagerClientPool> &,
       std::function<void(const Status &, const rpc::RequestResourceReportReply &)>)>
       request_report_;
   // The minimum delay between two pull requests to the same thread.
   const int64_t poll_period_ms_;
+  // The delay that the polls of a node whose report doesn't change back off to. Polling
+  // is adaptive only if it is larger than `poll_period_ms_`.
+  int64_t max_poll_period_ms_;
 
   struct PullState {
     NodeID node_id;
     rpc::Address address;
     int64_t last_pull_time;
     int64_t next_pull_time;
+    // The version of the last report received from the node, or 0.
+    int64_t report_version;
+    // The current delay between two pull requests to the node.
+    int64_t poll_period_ms;
 
     PullState(NodeID _node_id,
               rpc::Address _address,
               int64_t _last_pull_time,
-              int64_t _next_pull_time)
+              int64_t _next_pull_time,
+              int64_t _poll_period_ms)
         : node_id(_node_id),
           address(_address),
           last_pull_time(_last_pull_time),
-          next_pull_time(_next_pull_time) {}
+          next_pull_time(_next_pull_time),
+          report_version(0),
+          poll_period_ms(_poll_period_ms) {}
 
     ~PullState() {}
   };
@@ -145,9 +160,10 @@ class GcsResourceReportPoller {
   void TryPullResourceReport() LOCKS_EXCLUDED(mutex_);
   /// Pull resource report without validation.
   void PullResourceReport(const std::shared_ptr<PullState> state);
-  /// A resource report was successfully pulled (and the resource manager was already
-  /// updated). This method is thread safe.
-  void NodeResourceReportReceived(const std::shared_ptr<PullState> state)
+  /// A resource report was pulled (and the resource manager was already updated), with
+  /// the given version, or the pull failed. This method is thread safe.
+  void NodeResourceReportReceived(const std::shared_ptr<PullState> state,
+                                  absl::optional<int64_t> report_version)
       LOCKS_EXCLUDED(mutex_);
 
   friend class GcsResourceReportPollerTest;
@@ -15,6 +15,7 @@
 #include "ray/gcs/gcs_server/gcs_server.h"
 
 #include <fstream>
+#include <sstream>
 
 #include "ray/common/asio/asio_util.h"
 #include "ray/common/asio/instrumented_io_context.h"
@@ -51,12 +52,30 @@ GcsServer::GcsServer(const ray::gcs::GcsServerConfig &config,
       periodical_runner_(main_service),
       is_started_(false),
       is_stopped_(false) {
+  const auto service_thread_num = RayConfig::instance().gcs_server_service_thread_num();
+  if (service_thread_num > 0) {
+    std::vector<int> service_thread_cpus;
+    std::stringstream cpus(RayConfig::instance().gcs_server_service_thread_cpus());
+    std::string cpu;
+    while (std::getline(cpus, cpu, ',')) {
+      if (!cpu.empty()) {
+        service_thread_cpus.push_back(std::stoi(cpu));
+      }
+    }
+    service_io_service_pool_ =
+        std::make_unique<IOServicePool>(service_thread_num, service_thread_cpus);
+    service_io_service_pool_->Run();
+  }
+
   // Init GCS table storage.
   RAY_LOG(INFO) << "GCS storage type is " << storage_type_;
   if (storage_type_ == "redis") {
     gcs_table_storage_ = std::make_shared<gcs::RedisGcsTableStorage>(GetOrConnectRedis());
   } else if (storage_type_ == "memory") {
     gcs_table_storage_ = std::make_shared<InMemoryGcsTableStorage>(main_service_);
+  } else if (storage_type_ == "file") {
+    gcs_table_storage_ = std::make_shared<FileGcsTableStorage>(
+        main_service_, RayConfig::instance().gcs_storage_file_directory());
   }
 
   auto on_done = [this](const ray::Status &status) {
@@ -108,7 +127,8 @@ RedisClientOptions GcsServer::GetRedisClientOptions() const {
   return RedisClientOptions(config_.redis_address,
                             config_.redis_port,
                             config_.redis_password,
-                            config_.enable_sharding_conn);
+                            config_.enable_sharding_conn,
+                            RayConfig::instance().gcs_redis_connections_per_shard());
 }
 
 void GcsServer::Start() {
@@ -207,6 +227,9 @@ void GcsServer::Stop() {
     rpc_server_.Shutdown();
 
     pubsub_handler_->Stop();
+    if (service_io_service_pool_ != nullptr) {
+      service_io_service_pool_->Stop();
+    }
     kv_manager_.reset();
 
     is_stopped_ = true;
@@ -396,6 +419,11 @@ std::string GcsServer::StorageType() const {
     RAY_CHECK(!config_.redis_address.empty());
     return "redis";
   }
+  if (RayConfig::instance().gcs_storage() == "file") {
+    RAY_CHECK(!RayConfig::instance().gcs_storage_file_directory().empty())
+        << "gcs_storage_file_directory must be set for the 'file' GCS storage.";
+    return "file";
+  }
   RAY_LOG(FATAL) << "Unsupported GCS storage type: "
                  << RayConfig::instance().gcs_storage();
   return RayConfig::instance().gcs_storage();
@@ -430,9 +458,10 @@ void GcsServer::InitRaySyncer(const GcsInitData &gcs_init_data) {
 
 void GcsServer::InitStatsHandler() {
   RAY_CHECK(gcs_table_storage_);
-  stats_handler_.reset(new rpc::DefaultStatsHandler(gcs_table_storage_));
+  auto &stats_io_service = GetServiceIOService("Stats");
+  stats_handler_.reset(new rpc::DefaultStatsHandler(stats_io_service));
   // Register service.
-  stats_service_.reset(new rpc::StatsGrpcService(main_service_, *stats_handler_));
+  stats_service_.reset(new rpc::StatsGrpcService(stats_io_service, *stats_handler_));
   rpc_server_.RegisterService(*stats_service_);
 }
 
@@ -441,16 +470,17 @@ void GcsServer::InitFunctionManager() {
 }
 
 void GcsServer::InitKVManager() {
+  auto &kv_io_service = GetServiceIOService("InternalKV");
   std::unique_ptr<InternalKVInterface> instance;
   // TODO (yic): Use a factory with configs
   if (storage_type_ == "redis") {
     instance = std::make_unique<RedisInternalKV>(GetRedisClientOptions());
-  } else if (storage_type_ == "memory") {
-    instance = std::make_unique<MemoryInternalKV>(main_service_);
+  } else if (storage_type_ == "memory" || storage_type_ == "file") {
+    instance = std::make_unique<MemoryInternalKV>(kv_io_service);
   }
 
   kv_manager_ = std::make_unique<GcsInternalKVManager>(std::move(instance));
-  kv_service_ = std::make_unique<rpc::InternalKVGrpcService>(main_service_, *kv_manager_);
+  kv_service_ = std::make_unique<rpc::InternalKVGrpcService>(kv_io_service, *kv_manager_);
   // Register service.
   rpc_server_.RegisterService(*kv_service_);
 }
@@ -491,7 +521,11 @@ void GcsServer::InitRuntimeEnvManager() {
                 "" /* namespace */,
                 uri /* key */,
                 false /* del_by_prefix*/,
-                [callback = std::move(callback)](int64_t) { callback(false); });
+                // The KV callbacks may run off the main thread.
+                [this, callback = std::move(callback)](int64_t) {
+                  main_service_.post([callback]() { callback(false); },
+                                     "GcsServer.DeleteRuntimeEnvURI");
+                });
           }
         }
       });
@@ -514,7 +548,7 @@ void GcsServer::InstallEventListeners() {
     gcs_resource_manager_->OnNodeAdd(*node);
     gcs_placement_group_manager_->OnNodeAdd(NodeID::FromBinary(node->node_id()));
     gcs_actor_manager_->SchedulePendingActors();
-    gcs_heartbeat_manager_->AddNode(NodeID::FromBinary(node->node_id()));
+    gcs_heartbeat_manager_->AddNode(*node);
     ray_syncer_->AddNode(*node);
   });
   gcs_node_manager_->AddNodeRemovedListener(
@@ -527,6 +561,7 @@ void GcsServer::InstallEventListeners() {
         gcs_placement_group_manager_->OnNodeDead(node_id);
         gcs_actor_manager_->OnNodeDead(node_id, node_ip_address);
         raylet_client_pool_->Disconnect(NodeID::FromBinary(node->node_id()));
+        gcs_heartbeat_manager_->RemoveNode(node_id);
         ray_syncer_->RemoveNode(*node);
       });
 
@@ -596,9 +631,19 @@ std::string GcsServer::GetDebugState() const {
          << runtime_env_manager_->DebugString() << "\n\n";
 
   stream << ray_syncer_->DebugString();
+  if (service_io_service_pool_ != nullptr) {
+    stream << "\n\n" << service_io_service_pool_->DebugString();
+  }
   return stream.str();
 }
 
+instrumented_io_context &GcsServer::GetServiceIOService(const std::string &service_name) {
+  if (service_io_service_pool_ == nullptr) {
+    return main_service_;
+  }
+  return *service_io_service_pool_->Get(std::hash<std::string>()(service_name));
+}
+
 std::shared_ptr<RedisClient> GcsServer::GetOrConnectRedis() {
   if (redis_client_ == nullptr) {
     redis_client_ = std::make_shared<RedisClient>(GetRedisClientOptions());
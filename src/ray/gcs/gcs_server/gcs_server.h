@@ -15,6 +15,7 @@
 #pragma once
 
 #include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/asio/io_service_pool.h"
 #include "ray/common/runtime_env_manager.h"
 #include "ray/gcs/gcs_server/gcs_function_manager.h"
 #include "ray/gcs/gcs_server/gcs_heartbeat_manager.h"
@@ -160,6 +161,13 @@ class GcsServer {
   /// Get or connect to a redis server
   std::shared_ptr<RedisClient> GetOrConnectRedis();
 
+  /// Get the io service to run a service with thread-safe state on. Any callback
+  /// into the state of the other services must be posted to the main io service.
+  ///
+  /// \param service_name The name of the service.
+  /// \return The io service of the service.
+  instrumented_io_context &GetServiceIOService(const std::string &service_name);
+
   /// Gcs server configuration.
   const GcsServerConfig config_;
   // Type of storage to use.
@@ -171,6 +179,9 @@ class GcsServer {
   instrumented_io_context heartbeat_manager_io_service_;
   /// The io service used by Pubsub, for isolation from other workload.
   instrumented_io_context pubsub_io_service_;
+  /// The io services that run the services with thread-safe state, so that they
+  /// don't queue behind the main io service. Null if they run on the main io service.
+  std::unique_ptr<IOServicePool> service_io_service_pool_;
   /// The grpc server
   rpc::GrpcServer rpc_server_;
   /// The `ClientCallManager` object that is shared by all `NodeManagerWorkerClient`s.
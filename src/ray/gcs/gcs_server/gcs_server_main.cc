@@ -62,6 +62,7 @@ int main(int argc, char *argv[]) {
   // Ensure that the IO service keeps running. Without this, the main_service will exit
   // as soon as there is no more work to be processed.
   boost::asio::io_service::work work(main_service);
+  main_service.StartLagProbe("gcs_server");
 
   const ray::stats::TagsType global_tags = {
       {ray::stats::ComponentKey, "gcs_server"},
@@ -74,7 +75,8 @@ int main(int argc, char *argv[]) {
     ray::RayEventInit(ray::rpc::Event_SourceType::Event_SourceType_GCS,
                       absl::flat_hash_map<std::string, std::string>(),
                       log_dir,
-                      RayConfig::instance().event_level());
+                      RayConfig::instance().event_level(),
+                      RayConfig::instance().event_log_reporter_async());
   }
 
   ray::gcs::GcsServerConfig gcs_server_config;
@@ -0,0 +1,119 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace ray {
+namespace gcs {
+
+/// Clear the fields of a message that aren't in `fields`. Nothing is cleared if
+/// `fields` is empty.
+inline void ProjectFields(const google::protobuf::RepeatedPtrField<std::string> &fields,
+                          google::protobuf::Message *message) {
+  if (fields.empty()) {
+    return;
+  }
+  const absl::flat_hash_set<std::string> keep(fields.begin(), fields.end());
+  const auto *descriptor = message->GetDescriptor();
+  const auto *reflection = message->GetReflection();
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const auto *field = descriptor->field(i);
+    if (!keep.contains(field->name())) {
+      reflection->ClearField(message, field);
+    }
+  }
+}
+
+/// Select a page of the entries that match the filters of a GetAll request.
+///
+/// The entries are ordered by ID. Only the entries after the request's `page_token`
+/// are selected, at most `limit` of them. Sorting is skipped when all the entries are
+/// selected at once.
+///
+/// \param request The GetAll request.
+/// \param entries The IDs (in binary) and the data, or a handle to it, of the entries
+/// that match the filters.
+/// \param reply The GetAll reply, whose `next_page_token` and `total` are set.
+/// \return The entries of the page.
+template <typename Request, typename Reply, typename T>
+std::vector<std::pair<std::string, T>> SelectPage(
+    const Request &request, std::vector<std::pair<std::string, T>> entries, Reply *reply) {
+  reply->set_total(entries.size());
+  const auto &page_token = request.page_token();
+  if (!page_token.empty()) {
+    entries.erase(std::remove_if(entries.begin(),
+                                 entries.end(),
+                                 [&page_token](const auto &entry) {
+                                   return entry.first <= page_token;
+                                 }),
+                  entries.end());
+  }
+  const size_t limit = request.limit();
+  if (limit > 0 && entries.size() > limit) {
+    std::partial_sort(entries.begin(), entries.begin() + limit, entries.end());
+    entries.resize(limit);
+    reply->set_next_page_token(entries.back().first);
+  } else if (limit > 0 || !page_token.empty()) {
+    std::sort(entries.begin(), entries.end());
+  }
+  return entries;
+}
+
+/// Add an entry to the list of a GetAll reply, with only the request's `fields`.
+///
+/// \param borrow Whether the entry outlives the reply, so that it can be added to it
+/// without a copy when all its fields are returned.
+template <typename Request, typename Data>
+void AddToReply(const Request &request,
+                const Data &data,
+                bool borrow,
+                google::protobuf::RepeatedPtrField<Data> *list) {
+  if (borrow && request.fields().empty()) {
+    list->UnsafeArenaAddAllocated(const_cast<Data *>(&data));
+  } else {
+    auto *copy = list->Add();
+    copy->CopyFrom(data);
+    ProjectFields(request.fields(), copy);
+  }
+}
+
+/// Add a page of the entries that match the filters of a GetAll request to the reply.
+/// See `SelectPage` and `AddToReply`.
+///
+/// \param list The list of the reply to add the entries to.
+template <typename Request, typename Reply, typename Data>
+void AddPageToReply(const Request &request,
+                    std::vector<std::pair<std::string, const Data *>> entries,
+                    bool borrow,
+                    Reply *reply,
+                    google::protobuf::RepeatedPtrField<Data> *list) {
+  const auto page = SelectPage(request, std::move(entries), reply);
+  list->Reserve(page.size());
+  for (const auto &entry : page) {
+    AddToReply(request, *entry.second, borrow, list);
+  }
+}
+
+}  // namespace gcs
+}  // namespace ray
@@ -29,6 +29,17 @@ Status GcsTable<Key, Data>::Put(const Key &key,
       table_name_, key.Binary(), value.SerializeAsString(), callback);
 }
 
+template <typename Key, typename Data>
+Status GcsTable<Key, Data>::BatchPut(const std::vector<std::pair<Key, Data>> &values,
+                                     const StatusCallback &callback) {
+  std::vector<std::pair<std::string, std::string>> kvs;
+  kvs.reserve(values.size());
+  for (const auto &value : values) {
+    kvs.emplace_back(value.first.Binary(), value.second.SerializeAsString());
+  }
+  return store_client_->AsyncBatchPut(table_name_, std::move(kvs), callback);
+}
+
 template <typename Key, typename Data>
 Status GcsTable<Key, Data>::Get(const Key &key,
                                 const OptionalItemCallback<Data> &callback) {
@@ -88,15 +99,30 @@ Status GcsTableWithJobId<Key, Data>::Put(const Key &key,
       this->table_name_, key.Binary(), value.SerializeAsString(), callback);
 }
 
+template <typename Key, typename Data>
+Status GcsTableWithJobId<Key, Data>::BatchPut(
+    const std::vector<std::pair<Key, Data>> &values, const StatusCallback &callback) {
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto &value : values) {
+      index_[GetJobIdFromKey(value.first)].insert(value.first);
+    }
+  }
+  return GcsTable<Key, Data>::BatchPut(values, callback);
+}
+
 template <typename Key, typename Data>
 Status GcsTableWithJobId<Key, Data>::GetByJobId(const JobID &job_id,
                                                 const MapCallback<Key, Data> &callback) {
   std::vector<std::string> keys;
   {
     absl::MutexLock lock(&mutex_);
-    auto &key_set = index_[job_id];
-    for (auto &key : key_set) {
-      keys.push_back(key.Binary());
+    auto it = index_.find(job_id);
+    if (it != index_.end()) {
+      keys.reserve(it->second.size());
+      for (auto &key : it->second) {
+        keys.push_back(key.Binary());
+      }
     }
   }
   auto on_done = [callback](absl::flat_hash_map<std::string, std::string> &&result) {
@@ -117,9 +143,9 @@ Status GcsTableWithJobId<Key, Data>::DeleteByJobId(const JobID &job_id,
   std::vector<Key> keys;
   {
     absl::MutexLock lock(&mutex_);
-    auto &key_set = index_[job_id];
-    for (auto &key : key_set) {
-      keys.push_back(key);
+    auto it = index_.find(job_id);
+    if (it != index_.end()) {
+      keys.assign(it->second.begin(), it->second.end());
     }
   }
   return BatchDelete(keys, callback);
@@ -144,7 +170,12 @@ Status GcsTableWithJobId<Key, Data>::BatchDelete(const std::vector<Key> &keys,
           {
             absl::MutexLock lock(&mutex_);
             for (auto &key : keys) {
-              index_[GetJobIdFromKey(key)].erase(key);
+              // Drop the jobs with no keys left, so that the index doesn't grow with
+              // the number of jobs.
+              auto it = index_.find(GetJobIdFromKey(key));
+              if (it != index_.end() && it->second.erase(key) && it->second.empty()) {
+                index_.erase(it);
+              }
             }
           }
         }
@@ -16,8 +16,10 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "ray/common/asio/instrumented_io_context.h"
+#include "ray/gcs/store_client/file_store_client.h"
 #include "ray/gcs/store_client/in_memory_store_client.h"
 #include "ray/gcs/store_client/redis_store_client.h"
 #include "src/ray/protobuf/gcs.pb.h"
@@ -62,6 +64,14 @@ class GcsTable {
   /// \return Status
   virtual Status Put(const Key &key, const Data &value, const StatusCallback &callback);
 
+  /// Write a batch of data to the table asynchronously.
+  ///
+  /// \param values The keys that will be written to the table, with their values.
+  /// \param callback Callback that will be called after all of them are written.
+  /// \return Status
+  virtual Status BatchPut(const std::vector<std::pair<Key, Data>> &values,
+                          const StatusCallback &callback);
+
   /// Get data from the table asynchronously.
   ///
   /// \param key The key to lookup from the table.
@@ -116,6 +126,14 @@ class GcsTableWithJobId : public GcsTable<Key, Data> {
   /// \return Status
   Status Put(const Key &key, const Data &value, const StatusCallback &callback) override;
 
+  /// Write a batch of data to the table asynchronously.
+  ///
+  /// \param values The keys that will be written to the table, with their values.
+  /// \param callback Callback that will be called after all of them are written.
+  /// \return Status
+  Status BatchPut(const std::vector<std::pair<Key, Data>> &values,
+                  const StatusCallback &callback) override;
+
   /// Get all the data of the specified job id from the table asynchronously.
   ///
   /// \param job_id The key to lookup from the table.
@@ -366,5 +384,15 @@ class InMemoryGcsTableStorage : public GcsTableStorage {
       : GcsTableStorage(std::make_shared<InMemoryStoreClient>(main_io_service)) {}
 };
 
+/// \class FileGcsTableStorage
+/// FileGcsTableStorage is an implementation of `GcsTableStorage`
+/// that uses memory as storage, and persists it to a local directory.
+class FileGcsTableStorage : public GcsTableStorage {
+ public:
+  FileGcsTableStorage(instrumented_io_context &main_io_service,
+                      const std::string &directory)
+      : GcsTableStorage(std::make_shared<FileStoreClient>(main_io_service, directory)) {}
+};
+
 }  // namespace gcs
 }  // namespace ray
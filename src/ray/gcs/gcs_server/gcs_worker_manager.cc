@@ -14,6 +14,7 @@
 
 #include "ray/gcs/gcs_server/gcs_worker_manager.h"
 
+#include "ray/gcs/gcs_server/gcs_table_query.h"
 #include "ray/stats/metric_defs.h"
 
 namespace ray {
@@ -115,11 +116,21 @@ void GcsWorkerManager::HandleGetAllWorkerInfo(
     rpc::GetAllWorkerInfoReply *reply,
     rpc::SendReplyCallback send_reply_callback) {
   RAY_LOG(DEBUG) << "Getting all worker info.";
-  auto on_done = [reply, send_reply_callback](
+  auto on_done = [&request, reply, send_reply_callback](
                      const absl::flat_hash_map<WorkerID, WorkerTableData> &result) {
+    std::vector<std::pair<std::string, const WorkerTableData *>> entries;
     for (auto &data : result) {
-      reply->add_worker_table_data()->CopyFrom(data.second);
+      if ((!request.has_is_alive() || data.second.is_alive() == request.is_alive()) &&
+          (request.node_id().empty() ||
+           data.second.worker_address().raylet_id() == request.node_id())) {
+        entries.emplace_back(data.first.Binary(), &data.second);
+      }
     }
+    AddPageToReply(request,
+                   std::move(entries),
+                   /*borrow=*/false,
+                   reply,
+                   reply->mutable_worker_table_data());
     RAY_LOG(DEBUG) << "Finished getting all worker info.";
     GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
   };
@@ -14,6 +14,7 @@
 
 #include "ray/gcs/gcs_server/grpc_based_resource_broadcaster.h"
 
+#include "ray/common/ray_config.h"
 #include "ray/stats/metric_defs.h"
 
 namespace ray {
@@ -21,13 +22,7 @@ namespace gcs {
 
 GrpcBasedResourceBroadcaster::GrpcBasedResourceBroadcaster(
     std::shared_ptr<rpc::NodeManagerClientPool> raylet_client_pool,
-    std::function<void(const rpc::Address &,
-                       std::shared_ptr<rpc::NodeManagerClientPool> &,
-                       std::string &,
-                       const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &)>
-        send_batch
-
-    )
+    SendBatchFn send_batch)
     : seq_no_(absl::GetCurrentTimeNanos()),
       raylet_client_pool_(raylet_client_pool),
       send_batch_(send_batch) {}
@@ -79,22 +74,45 @@ void GrpcBasedResourceBroadcaster::SendBroadcast(rpc::ResourceUsageBroadcastData
   batch.set_seq_no(seq_no_++);
 
   // Serializing is relatively expensive on large batches, so we should only do it once.
-  std::string serialized_batch = batch.SerializeAsString();
-  stats::OutboundHeartbeatSizeKB.Record((double)(serialized_batch.size() / 1024.0));
+  auto serialized_batch = std::make_shared<std::string>(batch.SerializeAsString());
+  stats::OutboundHeartbeatSizeKB.Record((double)(serialized_batch->size() / 1024.0));
 
+  const auto relay_fanout = RayConfig::instance().resource_broadcast_relay_fanout();
   absl::MutexLock guard(&mutex_);
-  for (const auto &pair : nodes_) {
-    const auto &address = pair.second;
-    double start_time = absl::GetCurrentTimeNanos();
-    auto callback = [start_time](const Status &status,
-                                 const rpc::UpdateResourceUsageReply &reply) {
-      double end_time = absl::GetCurrentTimeNanos();
-      double lapsed_time_ms = static_cast<double>(end_time - start_time) / 1e6;
-      ray::stats::GcsUpdateResourceUsageTime.Record(lapsed_time_ms);
-    };
-    send_batch_(address, raylet_client_pool_, serialized_batch, callback);
+  auto it = nodes_.begin();
+  while (it != nodes_.end()) {
+    const auto &address = it->second;
+    ++it;
+    // The raylets that follow a relay form the rest of its group.
+    std::vector<rpc::Address> forward_to;
+    for (; it != nodes_.end() && forward_to.size() < relay_fanout; ++it) {
+      forward_to.push_back(it->second);
+    }
+    SendBatch(address, serialized_batch, std::move(forward_to));
   }
 }
 
+void GrpcBasedResourceBroadcaster::SendBatch(
+    const rpc::Address &address,
+    const std::shared_ptr<std::string> &serialized_batch,
+    std::vector<rpc::Address> forward_to) {
+  double start_time = absl::GetCurrentTimeNanos();
+  auto callback = [this, start_time, serialized_batch, forward_to](
+                      const Status &status, const rpc::UpdateResourceUsageReply &reply) {
+    double end_time = absl::GetCurrentTimeNanos();
+    double lapsed_time_ms = static_cast<double>(end_time - start_time) / 1e6;
+    ray::stats::GcsUpdateResourceUsageTime.Record(lapsed_time_ms);
+    if (!status.ok() && !forward_to.empty()) {
+      // The relay is unreachable, so the rest of its group gets the batch directly.
+      RAY_LOG(DEBUG) << "Failed to send a resource broadcast to a relay, sending it to "
+                     << forward_to.size() << " raylets directly: " << status;
+      for (const auto &address : forward_to) {
+        SendBatch(address, serialized_batch, {});
+      }
+    }
+  };
+  send_batch_(address, raylet_client_pool_, *serialized_batch, forward_to, callback);
+}
+
 }  // namespace gcs
 }  // namespace ray
@@ -22,24 +22,33 @@ namespace ray {
 namespace gcs {
 
 /// Broadcasts resource report batches to raylets from a separate thread.
+///
+/// When resource_broadcast_relay_fanout is set, the raylets are split into groups, and
+/// each batch is only sent to the first raylet of every group, which relays it to the
+/// rest of its group. If a relay can't be reached, the batch is sent to the rest of
+/// its group directly.
 class GrpcBasedResourceBroadcaster {
  public:
-  GrpcBasedResourceBroadcaster(
-      std::shared_ptr<rpc::NodeManagerClientPool> raylet_client_pool,
-      /* Default values should only be changed for testing. */
+  using SendBatchFn =
       std::function<void(const rpc::Address &,
                          std::shared_ptr<rpc::NodeManagerClientPool> &,
                          std::string &,
-                         const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &)>
-          send_batch =
-              [](const rpc::Address &address,
-                 std::shared_ptr<rpc::NodeManagerClientPool> &raylet_client_pool,
-                 std::string &serialized_resource_usage_batch,
-                 const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) {
-                auto raylet_client = raylet_client_pool->GetOrConnectByAddress(address);
-                raylet_client->UpdateResourceUsage(serialized_resource_usage_batch,
-                                                   callback);
-              });
+                         const std::vector<rpc::Address> &,
+                         const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &)>;
+
+  GrpcBasedResourceBroadcaster(
+      std::shared_ptr<rpc::NodeManagerClientPool> raylet_client_pool,
+      /* Default values should only be changed for testing. */
+      SendBatchFn send_batch =
+          [](const rpc::Address &address,
+             std::shared_ptr<rpc::NodeManagerClientPool> &raylet_client_pool,
+             std::string &serialized_resource_usage_batch,
+             const std::vector<rpc::Address> &forward_to,
+             const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) {
+            auto raylet_client = raylet_client_pool->GetOrConnectByAddress(address);
+            raylet_client->UpdateResourceUsage(
+                serialized_resource_usage_batch, forward_to, callback);
+          });
 
   ~GrpcBasedResourceBroadcaster();
 
@@ -55,17 +64,22 @@ class GrpcBasedResourceBroadcaster {
   void SendBroadcast(rpc::ResourceUsageBroadcastData batch);
 
  private:
+  /// Send a serialized batch to a raylet.
+  ///
+  /// \param address The raylet to send the batch to.
+  /// \param serialized_batch The serialized batch.
+  /// \param forward_to The raylets that the raylet relays the batch to.
+  void SendBatch(const rpc::Address &address,
+                 const std::shared_ptr<std::string> &serialized_batch,
+                 std::vector<rpc::Address> forward_to);
+
   // The sequence number of the next broadcast to send.
   int64_t seq_no_;
 
   // The shared, thread safe pool of raylet clients, which we use to minimize connections.
   std::shared_ptr<rpc::NodeManagerClientPool> raylet_client_pool_;
 
-  std::function<void(const rpc::Address &,
-                     std::shared_ptr<rpc::NodeManagerClientPool> &,
-                     std::string &,
-                     const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &)>
-      send_batch_;
+  SendBatchFn send_batch_;
 
   /// A lock to protect the data structures.
   absl::Mutex mutex_;
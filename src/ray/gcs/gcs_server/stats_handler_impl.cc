@@ -14,6 +14,8 @@
 
 #include "ray/gcs/gcs_server/stats_handler_impl.h"
 
+#include "ray/common/asio/asio_util.h"
+#include "ray/common/cpu_profiler.h"
 #include "ray/common/ray_config.h"
 
 namespace ray {
@@ -25,29 +27,10 @@ void DefaultStatsHandler::HandleAddProfileData(const AddProfileDataRequest &requ
   NodeID node_id = NodeID::FromBinary(request.profile_data().component_id());
   RAY_LOG(DEBUG) << "Adding profile data, component type = "
                  << request.profile_data().component_type() << ", node id = " << node_id;
-  auto profile_table_data = std::make_shared<ProfileTableData>();
-  profile_table_data->CopyFrom(request.profile_data());
-  auto on_done = [node_id, request, reply, send_reply_callback](Status status) {
-    if (!status.ok()) {
-      RAY_LOG(ERROR) << "Failed to add profile data, component type = "
-                     << request.profile_data().component_type()
-                     << ", node id = " << node_id;
-    }
-    GCS_RPC_SEND_REPLY(send_reply_callback, reply, status);
-  };
-
-  // To limit the number of profile table, we save `maximum_profile_table_rows_count` ids,
-  // each of which is generated by random. We use the FIFO strategy to eliminate the
-  // record when it reaches the upper limit. When we receive a record, we update the
-  // `cursor_` and get the corresponding id through it. Put operation will directly cover
-  // the previous data, so that we can avoid a delete operation.
-  Status status = gcs_table_storage_->ProfileTable().Put(
-      ids_[cursor_++ % ids_.size()], *profile_table_data, on_done);
-  if (!status.ok()) {
-    on_done(status);
-  }
+  profile_event_store_.Add(request.profile_data());
   RAY_LOG(DEBUG) << "Finished adding profile data, component type = "
                  << request.profile_data().component_type() << ", node id = " << node_id;
+  GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
 }
 
 void DefaultStatsHandler::HandleGetAllProfileInfo(
@@ -55,19 +38,29 @@ void DefaultStatsHandler::HandleGetAllProfileInfo(
     rpc::GetAllProfileInfoReply *reply,
     rpc::SendReplyCallback send_reply_callback) {
   RAY_LOG(DEBUG) << "Getting all profile info.";
-  auto on_done = [reply, send_reply_callback](
-                     const absl::flat_hash_map<UniqueID, ProfileTableData> &result) {
-    for (const auto &data : result) {
-      reply->add_profile_info_list()->CopyFrom(data.second);
-    }
-    RAY_LOG(DEBUG) << "Finished getting all profile info.";
-    GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
-  };
+  profile_event_store_.Query(request, reply);
+  RAY_LOG(DEBUG) << "Finished getting all profile info.";
+  GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+}
 
-  Status status = gcs_table_storage_->ProfileTable().GetAll(on_done);
+void DefaultStatsHandler::HandleProfileGcsCpu(const ProfileGcsCpuRequest &request,
+                                              ProfileGcsCpuReply *reply,
+                                              SendReplyCallback send_reply_callback) {
+  RAY_LOG(INFO) << "Profiling the CPU use of the GCS server for " << request.duration_ms()
+                << " ms.";
+  Status status =
+      CpuProfiler::Instance().Start(request.frequency() > 0 ? request.frequency() : 100);
   if (!status.ok()) {
-    on_done(absl::flat_hash_map<UniqueID, ProfileTableData>());
+    GCS_RPC_SEND_REPLY(send_reply_callback, reply, status);
+    return;
   }
+  RAY_UNUSED(execute_after(
+      io_service_,
+      [reply, send_reply_callback]() {
+        Status status = CpuProfiler::Instance().Stop(reply->mutable_profile());
+        GCS_RPC_SEND_REPLY(send_reply_callback, reply, status);
+      },
+      request.duration_ms()));
 }
 
 }  // namespace rpc
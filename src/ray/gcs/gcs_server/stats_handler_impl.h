@@ -14,8 +14,9 @@
 
 #pragma once
 
+#include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/ray_config.h"
-#include "ray/gcs/gcs_server/gcs_table_storage.h"
+#include "ray/gcs/gcs_server/gcs_profile_event_store.h"
 #include "ray/rpc/gcs_server/gcs_rpc_server.h"
 
 namespace ray {
@@ -24,13 +25,10 @@ namespace rpc {
 /// This implementation class of `StatsHandler`.
 class DefaultStatsHandler : public rpc::StatsHandler {
  public:
-  explicit DefaultStatsHandler(std::shared_ptr<gcs::GcsTableStorage> gcs_table_storage)
-      : gcs_table_storage_(std::move(gcs_table_storage)) {
-    for (int index = 0; index < RayConfig::instance().maximum_profile_table_rows_count();
-         ++index) {
-      ids_.emplace_back(UniqueID::FromRandom());
-    }
-  }
+  explicit DefaultStatsHandler(instrumented_io_context &io_service)
+      : io_service_(io_service),
+        profile_event_store_(
+            RayConfig::instance().maximum_gcs_profile_events_count()) {}
 
   void HandleAddProfileData(const AddProfileDataRequest &request,
                             AddProfileDataReply *reply,
@@ -40,11 +38,16 @@ class DefaultStatsHandler : public rpc::StatsHandler {
                                rpc::GetAllProfileInfoReply *reply,
                                rpc::SendReplyCallback send_reply_callback) override;
 
+  void HandleProfileGcsCpu(const ProfileGcsCpuRequest &request,
+                           ProfileGcsCpuReply *reply,
+                           SendReplyCallback send_reply_callback) override;
+
  private:
-  int cursor_ = 0;
-  std::vector<UniqueID> ids_;
+  /// The event loop that the requests are handled on.
+  instrumented_io_context &io_service_;
 
-  std::shared_ptr<gcs::GcsTableStorage> gcs_table_storage_;
+  /// The profile events, which are only accessed on the event loop above.
+  gcs::GcsProfileEventStore profile_event_store_;
 };
 
 }  // namespace rpc
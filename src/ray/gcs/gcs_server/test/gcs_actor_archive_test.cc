@@ -0,0 +1,96 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/gcs_server/gcs_actor_archive.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace gcs {
+
+rpc::ActorTableData GenDeadActor(const JobID &job_id, const std::string &class_name) {
+  rpc::ActorTableData data;
+  data.set_actor_id(ActorID::Of(job_id, TaskID::ForDriverTask(job_id), 0).Binary());
+  data.set_job_id(job_id.Binary());
+  data.set_state(rpc::ActorTableData::DEAD);
+  data.set_class_name(class_name);
+  data.mutable_address()->set_raylet_id(NodeID::FromRandom().Binary());
+  data.mutable_address()->set_ip_address("127.0.0.1");
+  data.mutable_address()->set_worker_id(WorkerID::FromRandom().Binary());
+  data.set_pid(1234);
+  data.set_end_time(100);
+  data.mutable_death_cause()->mutable_actor_died_error_context()->set_error_message(
+      "The actor died.");
+  return data;
+}
+
+TEST(GcsActorArchiveTest, TestAddAndGet) {
+  GcsActorArchive archive(/*max_entries=*/10);
+  const auto job_id = JobID::FromInt(1);
+  auto data = GenDeadActor(job_id, "Actor");
+  archive.Add(data);
+  // An actor is only archived once.
+  archive.Add(data);
+  ASSERT_EQ(archive.Size(), 1);
+
+  rpc::ActorTableData archived;
+  ASSERT_TRUE(archive.Get(ActorID::FromBinary(data.actor_id()), &archived));
+  ASSERT_EQ(archived.actor_id(), data.actor_id());
+  ASSERT_EQ(archived.job_id(), data.job_id());
+  ASSERT_EQ(archived.state(), rpc::ActorTableData::DEAD);
+  ASSERT_EQ(archived.class_name(), "Actor");
+  ASSERT_EQ(archived.address().raylet_id(), data.address().raylet_id());
+  ASSERT_EQ(archived.address().ip_address(), "127.0.0.1");
+  ASSERT_EQ(archived.pid(), 1234);
+  ASSERT_EQ(archived.end_time(), 100);
+  ASSERT_EQ(archived.death_cause().actor_died_error_context().error_message(),
+            "The actor died.");
+  // The fields that the state API doesn't show aren't archived.
+  ASSERT_TRUE(archived.address().worker_id().empty());
+
+  ASSERT_FALSE(archive.Get(ActorID::Of(job_id, TaskID::ForDriverTask(job_id), 1),
+                           &archived));
+}
+
+TEST(GcsActorArchiveTest, TestDropOldest) {
+  GcsActorArchive archive(/*max_entries=*/2);
+  std::vector<rpc::ActorTableData> actors;
+  for (int i = 0; i < 3; i++) {
+    actors.push_back(GenDeadActor(JobID::FromInt(i), "Actor"));
+    archive.Add(actors.back());
+  }
+  ASSERT_EQ(archive.Size(), 2);
+  rpc::ActorTableData archived;
+  ASSERT_FALSE(archive.Get(ActorID::FromBinary(actors[0].actor_id()), &archived));
+  for (int i = 1; i < 3; i++) {
+    ASSERT_TRUE(archive.Get(ActorID::FromBinary(actors[i].actor_id()), &archived));
+    ASSERT_EQ(archived.job_id(), actors[i].job_id());
+  }
+
+  std::vector<std::string> job_ids;
+  archive.ForEach(
+      [&job_ids](const ActorID &, const std::string &job_id, const std::string &) {
+        job_ids.push_back(job_id);
+      });
+  ASSERT_EQ(job_ids, std::vector<std::string>({actors[1].job_id(), actors[2].job_id()}));
+}
+
+TEST(GcsActorArchiveTest, TestDisabled) {
+  GcsActorArchive archive(/*max_entries=*/0);
+  archive.Add(GenDeadActor(JobID::FromInt(1), "Actor"));
+  ASSERT_EQ(archive.Size(), 0);
+}
+
+}  // namespace gcs
+}  // namespace ray
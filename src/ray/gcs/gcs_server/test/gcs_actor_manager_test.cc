@@ -973,6 +973,60 @@ TEST_F(GcsActorManagerTest, TestOwnerWorkerDieBeforeDetachedActorDependenciesRes
   ASSERT_FALSE(callbacks.count(registered_actor->GetActorID()));
 }
 
+TEST_F(GcsActorManagerTest, TestOwnerWorkerDieDestroysAllChildren) {
+  auto job_id = JobID::FromInt(1);
+  auto owner_address = RandomAddress();
+  std::vector<std::shared_ptr<gcs::GcsActor>> actors;
+  for (int i = 0; i < 3; i++) {
+    rpc::RegisterActorRequest request;
+    request.mutable_task_spec()->CopyFrom(
+        Mocker::GenActorCreationTask(job_id, 0, false, "", "", owner_address)
+            .GetMessage());
+    std::promise<std::shared_ptr<gcs::GcsActor>> promise;
+    io_service_.post(
+        [this, request, &promise]() {
+          RAY_CHECK_OK(gcs_actor_manager_->RegisterActor(
+              request, [&promise](std::shared_ptr<gcs::GcsActor> actor) {
+                promise.set_value(std::move(actor));
+              }));
+        },
+        "test");
+    actors.push_back(promise.get_future().get());
+  }
+
+  std::promise<bool> promise;
+  io_service_.post(
+      [this, &owner_address, &promise]() {
+        gcs_actor_manager_->OnWorkerDead(NodeID::FromBinary(owner_address.raylet_id()),
+                                         WorkerID::FromBinary(owner_address.worker_id()));
+        promise.set_value(true);
+      },
+      "test");
+  promise.get_future().get();
+  const auto &registered_actors = gcs_actor_manager_->GetRegisteredActors();
+  for (const auto &actor : actors) {
+    ASSERT_EQ(actor->GetState(), rpc::ActorTableData::DEAD);
+    ASSERT_FALSE(registered_actors.count(actor->GetActorID()));
+  }
+
+  // All of them are written to the storage as dead.
+  auto condition = [this, &actors]() {
+    std::promise<bool> all_dead;
+    RAY_CHECK_OK(gcs_table_storage_->ActorTable().GetAll(
+        [&actors, &all_dead](absl::flat_hash_map<ActorID, rpc::ActorTableData> &&result) {
+          bool dead = true;
+          for (const auto &actor : actors) {
+            auto it = result.find(actor->GetActorID());
+            dead = dead && it != result.end() &&
+                   it->second.state() == rpc::ActorTableData::DEAD;
+          }
+          all_dead.set_value(dead);
+        }));
+    return all_dead.get_future().get();
+  };
+  EXPECT_TRUE(WaitForCondition(condition, timeout_ms_.count()));
+}
+
 TEST_F(GcsActorManagerTest, TestOwnerNodeDieBeforeActorDependenciesResolved) {
   auto job_id = JobID::FromInt(1);
   auto registered_actor = RegisterActor(job_id);
@@ -646,19 +646,19 @@ TEST_F(GcsBasedActorSchedulerTest, TestReleaseUnusedWorkers) {
   // `LeaseWorkerFromNode` method.
   // But since the `ReleaseUnusedWorkers` request hasn't finished, `GcsActorScheduler`
   // won't send `RequestWorkerLease` request to node immediately. But instead, it will
-  // invoke the `RetryLeasingWorkerFromNode` to retry later.
+  // wait for the reply of the `ReleaseUnusedWorkers` request.
   // Schedule a actor (requiring 32 memory units and 4 CPU).
   std::unordered_map<std::string, double> required_placement_resources = {
       {kMemory_ResourceLabel, 32}, {kCPU_ResourceLabel, 4}};
   auto actor = NewGcsActor(required_placement_resources);
   gcs_actor_scheduler_->Schedule(actor);
-  ASSERT_EQ(2, gcs_actor_scheduler_->num_retry_leasing_count_);
+  ASSERT_EQ(0, gcs_actor_scheduler_->num_retry_leasing_count_);
   ASSERT_EQ(raylet_client_->num_workers_requested, 0);
 
   // When `GcsActorScheduler` receives the `ReleaseUnusedWorkers` reply, it will send
-  // out the `RequestWorkerLease` request.
+  // out the `RequestWorkerLease` request without polling.
   ASSERT_TRUE(raylet_client_->ReplyReleaseUnusedWorkers());
-  gcs_actor_scheduler_->TryLeaseWorkerFromNodeAgain(actor, node);
+  ASSERT_EQ(0, gcs_actor_scheduler_->num_retry_leasing_count_);
   ASSERT_EQ(raylet_client_->num_workers_requested, 1);
 }
 }  // namespace gcs
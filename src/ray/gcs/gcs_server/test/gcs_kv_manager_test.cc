@@ -97,6 +97,39 @@ TEST_P(GcsKVManagerTest, TestInternalKV) {
   }
 }
 
+TEST_P(GcsKVManagerTest, TestInternalKVMulti) {
+  kv_instance->MultiPut("N1",
+                        {{"A", "1"}, {"B", "2"}},
+                        false,
+                        [](int64_t num_added) { ASSERT_EQ(2, num_added); });
+  kv_instance->MultiPut("N1",
+                        {{"B", "3"}, {"C", "4"}},
+                        false,
+                        [](int64_t num_added) { ASSERT_EQ(1, num_added); });
+  kv_instance->MultiPut("N1",
+                        {{"C", "5"}},
+                        true,
+                        [](int64_t num_added) { ASSERT_EQ(0, num_added); });
+  kv_instance->MultiGet(
+      "N2", {"A", "B"}, [](absl::flat_hash_map<std::string, std::string> results) {
+        ASSERT_TRUE(results.empty());
+      });
+  {
+    // Make sure the last cb is called.
+    std::promise<void> p;
+    kv_instance->MultiGet(
+        "N1",
+        {"A", "B", "C", "D"},
+        [&p](absl::flat_hash_map<std::string, std::string> results) {
+          absl::flat_hash_map<std::string, std::string> expected = {
+              {"A", "1"}, {"B", "2"}, {"C", "5"}};
+          ASSERT_EQ(expected, results);
+          p.set_value();
+        });
+    p.get_future().get();
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(GcsKVManagerTestFixture,
                          GcsKVManagerTest,
                          ::testing::Values("redis", "memory"));
@@ -92,6 +92,52 @@ TEST_F(GcsNodeManagerTest, TestListener) {
   }
 }
 
+TEST_F(GcsNodeManagerTest, TestGetAllNodeInfoPages) {
+  gcs::GcsNodeManager node_manager(gcs_publisher_, gcs_table_storage_, client_pool_);
+  absl::flat_hash_set<std::string> node_ids;
+  for (int i = 0; i < 5; ++i) {
+    auto node = Mocker::GenNodeInfo();
+    node_ids.insert(node->node_id());
+    node_manager.AddNode(node);
+  }
+
+  // The nodes are borrowed by the replies, so they must be allocated on an arena.
+  google::protobuf::Arena arena;
+  rpc::GetAllNodeInfoRequest request;
+  request.set_state(rpc::GcsNodeInfo::ALIVE);
+  request.set_limit(2);
+  request.add_fields("node_id");
+  absl::flat_hash_set<std::string> returned_node_ids;
+  int num_pages = 0;
+  do {
+    auto *reply =
+        google::protobuf::Arena::CreateMessage<rpc::GetAllNodeInfoReply>(&arena);
+    node_manager.HandleGetAllNodeInfo(
+        request, reply, [](Status, std::function<void()>, std::function<void()>) {});
+    ASSERT_EQ(reply->total(), 5);
+    ASSERT_LE(reply->node_info_list_size(), 2);
+    for (const auto &node : reply->node_info_list()) {
+      ASSERT_TRUE(returned_node_ids.insert(node.node_id()).second);
+      // Only the requested fields are returned.
+      ASSERT_TRUE(node.node_manager_address().empty());
+    }
+    request.set_page_token(reply->next_page_token());
+    num_pages++;
+  } while (!request.page_token().empty());
+  ASSERT_EQ(num_pages, 3);
+  ASSERT_EQ(returned_node_ids, node_ids);
+
+  // No node matches the filter.
+  request.Clear();
+  request.set_state(rpc::GcsNodeInfo::DEAD);
+  auto *reply = google::protobuf::Arena::CreateMessage<rpc::GetAllNodeInfoReply>(&arena);
+  node_manager.HandleGetAllNodeInfo(
+      request, reply, [](Status, std::function<void()>, std::function<void()>) {});
+  ASSERT_EQ(reply->total(), 0);
+  ASSERT_TRUE(reply->node_info_list().empty());
+  ASSERT_TRUE(reply->next_page_token().empty());
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
@@ -175,5 +175,52 @@ TEST_F(GcsPlacementGroupManagerMockTest, PendingQueuePriorityOrder) {
   ASSERT_EQ(pg1, pending_queue.begin()->second.second);
 }
 
+TEST_F(GcsPlacementGroupManagerMockTest, PendingQueueBatchScheduling) {
+  // Test batch scheduling
+  //   The PG that doesn't fit is skipped and keeps its place in the queue
+  //   The PG that fails without resources isn't backed off
+  RayConfig::instance().initialize(R"({"gcs_placement_group_batch_scheduling": true})");
+  auto req1 =
+      Mocker::GenCreatePlacementGroupRequest("", rpc::PlacementStrategy::SPREAD, 1);
+  auto pg1 = std::make_shared<GcsPlacementGroup>(req1, "");
+  auto req2 =
+      Mocker::GenCreatePlacementGroupRequest("", rpc::PlacementStrategy::SPREAD, 1);
+  auto pg2 = std::make_shared<GcsPlacementGroup>(req2, "");
+  auto cb = [](Status s) {};
+  PGSchedulingFailureCallback failure_callback;
+  PGSchedulingSuccessfulCallback success_callback;
+  StatusCallback put_cb;
+  EXPECT_CALL(*store_client_, AsyncPut(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SaveArg<3>(&put_cb), Return(Status::OK())));
+  EXPECT_CALL(*gcs_placement_group_scheduler_, FitsAvailableResources(pg1))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*gcs_placement_group_scheduler_, FitsAvailableResources(pg2))
+      .WillOnce(Return(true))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*gcs_placement_group_scheduler_, ScheduleUnplacedBundles(pg2, _, _))
+      .WillOnce(DoAll(SaveArg<1>(&failure_callback), SaveArg<2>(&success_callback)));
+  gcs_placement_group_manager_->RegisterPlacementGroup(pg1, cb);
+  gcs_placement_group_manager_->RegisterPlacementGroup(pg2, cb);
+  auto &pending_queue = gcs_placement_group_manager_->pending_placement_groups_;
+  ASSERT_EQ(2, pending_queue.size());
+  auto rank = pending_queue.begin()->first;
+  put_cb(Status::OK());
+  // PG1 doesn't fit, so PG2 is scheduled first.
+  ASSERT_EQ(1, pending_queue.size());
+  ASSERT_EQ(pg1, pending_queue.begin()->second.second);
+  ASSERT_EQ(rank, pending_queue.begin()->first);
+  pg2->UpdateState(rpc::PlacementGroupTableData::PENDING);
+  failure_callback(pg2, true);
+  ASSERT_EQ(2, pending_queue.size());
+  ASSERT_EQ(pg1, pending_queue.begin()->second.second);
+  ASSERT_EQ(pg2, std::next(pending_queue.begin())->second.second);
+  ASSERT_GE(absl::GetCurrentTimeNanos(), std::next(pending_queue.begin())->first);
+  // Neither fits, so nothing is scheduled.
+  gcs_placement_group_manager_->SchedulePendingPlacementGroups();
+  ASSERT_EQ(2, pending_queue.size());
+  RayConfig::instance().initialize("");
+}
+
 }  // namespace gcs
 }  // namespace ray
@@ -44,6 +44,11 @@ class MockPlacementGroupScheduler : public gcs::GcsPlacementGroupSchedulerInterf
     placement_groups_.push_back(placement_group);
   }
 
+  bool FitsAvailableResources(
+      const std::shared_ptr<gcs::GcsPlacementGroup> &placement_group) override {
+    return true;
+  }
+
   MOCK_METHOD1(DestroyPlacementGroupBundleResourcesIfExists,
                void(const PlacementGroupID &placement_group_id));
 
@@ -512,7 +512,8 @@ TEST_F(GcsPlacementGroupSchedulerTest, DestroyPlacementGroup) {
   WaitPlacementGroupPendingDone(1, GcsPlacementGroupStatus::SUCCESS);
   const auto &placement_group_id = placement_group->GetPlacementGroupID();
   scheduler_->DestroyPlacementGroupBundleResourcesIfExists(placement_group_id);
-  ASSERT_TRUE(raylet_clients_[0]->GrantCancelResourceReserve());
+  // Both bundles are on the node, so they are cancelled in one request.
+  ASSERT_EQ(1, raylet_clients_[0]->num_return_requested);
   ASSERT_TRUE(raylet_clients_[0]->GrantCancelResourceReserve());
   WaitUntilSyncMessage(4);
   {
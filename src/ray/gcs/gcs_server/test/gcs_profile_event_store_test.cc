@@ -0,0 +1,129 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/gcs_server/gcs_profile_event_store.h"
+
+#include "gtest/gtest.h"
+#include "ray/common/id.h"
+
+namespace ray {
+namespace gcs {
+
+rpc::ProfileTableData GenProfileData(const std::string &component_type,
+                                     const WorkerID &worker_id,
+                                     const std::vector<double> &start_times) {
+  rpc::ProfileTableData data;
+  data.set_component_type(component_type);
+  data.set_component_id(worker_id.Binary());
+  data.set_node_ip_address("127.0.0.1");
+  for (double start_time : start_times) {
+    auto event = data.add_profile_events();
+    event->set_event_type("task::f");
+    event->set_start_time(start_time);
+    event->set_end_time(start_time + 0.5);
+    event->set_extra_data("{\"task_id\": \"" + worker_id.Hex() + "\"}");
+  }
+  return data;
+}
+
+std::vector<double> GetStartTimes(const rpc::GetAllProfileInfoReply &reply) {
+  std::vector<double> start_times;
+  for (const auto &data : reply.profile_info_list()) {
+    for (const auto &event : data.profile_events()) {
+      start_times.push_back(event.start_time());
+    }
+  }
+  return start_times;
+}
+
+TEST(GcsProfileEventStoreTest, TestAddAndQuery) {
+  GcsProfileEventStore store(/*max_events=*/100, /*events_per_partition=*/2);
+  const auto worker_id = WorkerID::FromRandom();
+  const auto data = GenProfileData("worker", worker_id, {1650000000.25, 1650000001.5});
+  store.Add(data);
+  store.Add(GenProfileData("driver", WorkerID::FromRandom(), {1650000002}));
+  ASSERT_EQ(store.Size(), 3);
+
+  rpc::GetAllProfileInfoReply reply;
+  store.Query(rpc::GetAllProfileInfoRequest(), &reply);
+  ASSERT_EQ(reply.profile_info_list_size(), 2);
+  const auto &batch = reply.profile_info_list(0);
+  ASSERT_EQ(batch.component_type(), "worker");
+  ASSERT_EQ(batch.component_id(), worker_id.Binary());
+  ASSERT_EQ(batch.node_ip_address(), "127.0.0.1");
+  ASSERT_EQ(batch.profile_events_size(), 2);
+  for (int i = 0; i < 2; i++) {
+    const auto &event = batch.profile_events(i);
+    const auto &expected = data.profile_events(i);
+    ASSERT_EQ(event.event_type(), expected.event_type());
+    ASSERT_DOUBLE_EQ(event.start_time(), expected.start_time());
+    ASSERT_DOUBLE_EQ(event.end_time(), expected.end_time());
+    ASSERT_EQ(event.extra_data(), expected.extra_data());
+  }
+  ASSERT_EQ(reply.profile_info_list(1).component_type(), "driver");
+}
+
+TEST(GcsProfileEventStoreTest, TestFilters) {
+  GcsProfileEventStore store(/*max_events=*/100, /*events_per_partition=*/2);
+  const auto worker_id = WorkerID::FromRandom();
+  store.Add(GenProfileData("worker", worker_id, {1, 2, 3}));
+  store.Add(GenProfileData("worker", WorkerID::FromRandom(), {4, 5}));
+  store.Add(GenProfileData("driver", WorkerID::FromRandom(), {6}));
+
+  rpc::GetAllProfileInfoRequest request;
+  rpc::GetAllProfileInfoReply reply;
+  request.set_component_id(worker_id.Binary());
+  store.Query(request, &reply);
+  ASSERT_EQ(GetStartTimes(reply), std::vector<double>({1, 2, 3}));
+
+  request.Clear();
+  reply.Clear();
+  request.set_component_type("driver");
+  store.Query(request, &reply);
+  ASSERT_EQ(GetStartTimes(reply), std::vector<double>({6}));
+
+  // The events that overlap the range of times are returned.
+  request.Clear();
+  reply.Clear();
+  request.set_start_time(2.75);
+  request.set_end_time(5);
+  store.Query(request, &reply);
+  ASSERT_EQ(GetStartTimes(reply), std::vector<double>({3, 4}));
+
+  request.Clear();
+  reply.Clear();
+  request.set_component_type("worker");
+  request.set_limit(4);
+  store.Query(request, &reply);
+  ASSERT_EQ(GetStartTimes(reply), std::vector<double>({1, 2, 3, 4}));
+
+  request.Clear();
+  reply.Clear();
+  request.set_component_type("actor");
+  store.Query(request, &reply);
+  ASSERT_EQ(reply.profile_info_list_size(), 0);
+}
+
+TEST(GcsProfileEventStoreTest, TestDropOldest) {
+  GcsProfileEventStore store(/*max_events=*/3, /*events_per_partition=*/2);
+  store.Add(GenProfileData("worker", WorkerID::FromRandom(), {1, 2, 3, 4}));
+  store.Add(GenProfileData("worker", WorkerID::FromRandom(), {5}));
+  ASSERT_EQ(store.Size(), 3);
+  rpc::GetAllProfileInfoReply reply;
+  store.Query(rpc::GetAllProfileInfoRequest(), &reply);
+  ASSERT_EQ(GetStartTimes(reply), std::vector<double>({3, 4, 5}));
+}
+
+}  // namespace gcs
+}  // namespace ray
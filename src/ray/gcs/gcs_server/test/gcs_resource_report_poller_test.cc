@@ -30,15 +30,16 @@ class GcsResourceReportPollerTest : public ::testing::Test {
       : current_time_(0),
         gcs_resource_report_poller_(
             nullptr,
-            [](const rpc::ResourcesData &) {},
+            [this](const rpc::ResourcesData &) { num_reports_handled_++; },
             [this]() { return current_time_; },
             [this](
                 const rpc::Address &address,
+                int64_t last_report_version,
                 std::shared_ptr<rpc::NodeManagerClientPool> &client_pool,
                 std::function<void(const Status &,
                                    const rpc::RequestResourceReportReply &)> callback) {
               if (request_report_) {
-                request_report_(address, client_pool, callback);
+                request_report_(address, last_report_version, client_pool, callback);
               }
             }
 
@@ -56,9 +57,15 @@ class GcsResourceReportPollerTest : public ::testing::Test {
     gcs_resource_report_poller_.TryPullResourceReport();
   }
 
+  void SetMaxPollPeriod(int64_t max_poll_period_ms) {
+    gcs_resource_report_poller_.max_poll_period_ms_ = max_poll_period_ms;
+  }
+
   int64_t current_time_;
+  int num_reports_handled_ = 0;
   std::function<void(
       const rpc::Address &,
+      int64_t,
       std::shared_ptr<rpc::NodeManagerClientPool> &,
       std::function<void(const Status &, const rpc::RequestResourceReportReply &)>)>
       request_report_;
@@ -72,6 +79,7 @@ TEST_F(GcsResourceReportPollerTest, TestBasic) {
   request_report_ =
       [&rpc_sent](
           const rpc::Address &,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
               callback) {
@@ -104,6 +112,7 @@ TEST_F(GcsResourceReportPollerTest, TestFailedRpc) {
   request_report_ =
       [&rpc_sent](
           const rpc::Address &,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
               callback) {
@@ -145,6 +154,7 @@ TEST_F(GcsResourceReportPollerTest, TestMaxInFlight) {
   int num_rpcs_sent = 0;
   request_report_ =
       [&](const rpc::Address &,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
               callback) {
@@ -181,6 +191,7 @@ TEST_F(GcsResourceReportPollerTest, TestNodeRemoval) {
   int num_rpcs_sent = 0;
   request_report_ =
       [&](const rpc::Address &,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
               callback) {
@@ -228,6 +239,7 @@ TEST_F(GcsResourceReportPollerTest, TestPrioritizeNewNodes) {
   int num_rpcs_sent = 0;
   request_report_ =
       [&](const rpc::Address &address,
+          int64_t,
           std::shared_ptr<rpc::NodeManagerClientPool> &,
           std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
               callback) {
@@ -274,5 +286,66 @@ TEST_F(GcsResourceReportPollerTest, TestPrioritizeNewNodes) {
   ASSERT_EQ(nodes_requested.size(), 200);
 }
 
+TEST_F(GcsResourceReportPollerTest, TestBackOffUnchangedReports) {
+  SetMaxPollPeriod(400);
+  int num_rpcs_sent = 0;
+  int64_t last_version_sent = -1;
+  int64_t report_version = 1;
+  request_report_ =
+      [&](const rpc::Address &,
+          int64_t last_report_version,
+          std::shared_ptr<rpc::NodeManagerClientPool> &,
+          std::function<void(const Status &, const rpc::RequestResourceReportReply &)>
+              callback) {
+        num_rpcs_sent++;
+        last_version_sent = last_report_version;
+        rpc::RequestResourceReportReply reply;
+        reply.set_report_version(report_version);
+        reply.set_unchanged(last_report_version == report_version);
+        callback(Status::OK(), reply);
+      };
+
+  auto node_info = Mocker::GenNodeInfo();
+  gcs_resource_report_poller_.HandleNodeAdded(*node_info);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 1);
+  ASSERT_EQ(last_version_sent, 0);
+  ASSERT_EQ(num_reports_handled_, 1);
+
+  // The report didn't change since the last poll, so it isn't handled and the node is
+  // polled at twice the period.
+  Tick(100);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 2);
+  ASSERT_EQ(last_version_sent, 1);
+  ASSERT_EQ(num_reports_handled_, 1);
+  Tick(100);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 2);
+  Tick(100);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 3);
+  ASSERT_EQ(num_reports_handled_, 1);
+
+  // At the max period, the full report is pulled.
+  Tick(400);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 4);
+  ASSERT_EQ(last_version_sent, 0);
+  ASSERT_EQ(num_reports_handled_, 2);
+
+  // The report changed, so the node is polled at the base period again.
+  report_version++;
+  Tick(400);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 5);
+  ASSERT_EQ(num_reports_handled_, 3);
+  Tick(100);
+  RunPollingService();
+  ASSERT_EQ(num_rpcs_sent, 6);
+  ASSERT_EQ(last_version_sent, 2);
+  ASSERT_EQ(num_reports_handled_, 3);
+}
+
 }  // namespace gcs
 }  // namespace ray
@@ -0,0 +1,682 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A harness that drives a real, in-process GCS server with a simulated cluster, to
+// measure how the GCS scales with the number of nodes without needing that many
+// machines. Every node is a fake raylet that serves the node manager RPCs the GCS
+// sends (resource reports and broadcasts, worker leases and bundle reservations) from
+// a table of resources, and grants leases on a fake worker that accepts any task.
+//
+// The results are printed to stdout as a single JSON object, e.g.
+//   gcs_scalability_harness --num_nodes=1000 --num_actors=10000
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/time/clock.h"
+#include "gflags/gflags.h"
+#include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/asio/periodical_runner.h"
+#include "ray/common/placement_group.h"
+#include "ray/common/ray_config.h"
+#include "ray/gcs/gcs_server/gcs_server.h"
+#include "ray/gcs/test/gcs_test_util.h"
+#include "ray/raylet/scheduling/scheduling_ids.h"
+#include "ray/rpc/gcs_server/gcs_rpc_client.h"
+#include "ray/rpc/node_manager/node_manager_client_pool.h"
+#include "ray/rpc/node_manager/node_manager_server.h"
+#include "ray/rpc/worker/core_worker_server.h"
+#include "ray/util/util.h"
+
+DEFINE_int32(num_nodes, 100, "The number of simulated nodes.");
+DEFINE_double(cpus_per_node, 64, "The number of CPUs of each simulated node.");
+DEFINE_int32(num_actors, 1000, "The number of actors to create.");
+DEFINE_int32(num_placement_groups, 100, "The number of placement groups to create.");
+DEFINE_int32(bundles_per_placement_group, 4, "The number of 1-CPU bundles per group.");
+DEFINE_int32(max_in_flight, 100, "The maximum number of outstanding requests.");
+DEFINE_int32(broadcast_window_ms,
+             10000,
+             "How long to measure the resource broadcast for.");
+DEFINE_double(resource_change_probability,
+              0.1,
+              "The probability that a node reports a change of its available "
+              "resources in each resource report.");
+DEFINE_string(system_config, "", "The system config of the GCS, as a JSON string.");
+DEFINE_string(log_dir, "/tmp", "The dir where the GCS dumps its debug state.");
+
+namespace ray {
+
+namespace {
+
+const std::string kLocalhost = "127.0.0.1";
+
+const std::string kNamespace = "scalability_harness";
+
+/// A resource whose availability the fake raylets flip, to simulate the churn of
+/// the resources used by tasks.
+const std::string kChurnResource = "scalability_churn";
+
+/// Handle an RPC that the simulation doesn't need by replying with an empty reply.
+#define IGNORE_RPC(METHOD)                                                       \
+  void Handle##METHOD(const rpc::METHOD##Request &request,                       \
+                      rpc::METHOD##Reply *reply,                                 \
+                      rpc::SendReplyCallback send_reply_callback) override {     \
+    send_reply_callback(Status::OK(), nullptr, nullptr);                         \
+  }
+
+/// Counters of the requests that the GCS sends to the simulated cluster. They are
+/// updated on the harness's event loop and read from the main thread.
+struct ClusterCounters {
+  std::atomic<int64_t> resource_reports{0};
+  std::atomic<int64_t> broadcasts_received{0};
+  std::atomic<int64_t> broadcast_bytes_received{0};
+  std::atomic<int64_t> leases_granted{0};
+  std::atomic<int64_t> bundles_prepared{0};
+  std::atomic<int64_t> tasks_pushed{0};
+};
+
+/// A worker that accepts any task pushed to it, e.g., actor creation tasks. It is
+/// shared by all the fake raylets, which lease it out under different worker IDs.
+class FakeWorker : public rpc::CoreWorkerServiceHandler {
+ public:
+  FakeWorker(instrumented_io_context &io_service, ClusterCounters &counters)
+      : counters_(counters),
+        server_("FakeWorker", 0, /*listen_to_localhost_only=*/true),
+        service_(io_service, *this) {
+    server_.RegisterService(service_);
+    server_.Run();
+  }
+
+  int GetPort() const { return server_.GetPort(); }
+
+  void HandlePushTask(const rpc::PushTaskRequest &request,
+                      rpc::PushTaskReply *reply,
+                      rpc::SendReplyCallback send_reply_callback) override {
+    counters_.tasks_pushed++;
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  IGNORE_RPC(PushTaskBatch)
+  IGNORE_RPC(DirectActorCallArgWaitComplete)
+  IGNORE_RPC(GetObjectStatus)
+  IGNORE_RPC(GetObjectStatusBatch)
+  IGNORE_RPC(WaitForActorOutOfScope)
+  IGNORE_RPC(PubsubLongPolling)
+  IGNORE_RPC(PubsubCommandBatch)
+  IGNORE_RPC(UpdateObjectLocationBatch)
+  IGNORE_RPC(GetObjectLocationsOwner)
+  IGNORE_RPC(KillActor)
+  IGNORE_RPC(CancelTask)
+  IGNORE_RPC(RemoteCancelTask)
+  IGNORE_RPC(GetCoreWorkerStats)
+  IGNORE_RPC(LocalGC)
+  IGNORE_RPC(SpillObjects)
+  IGNORE_RPC(RestoreSpilledObjects)
+  IGNORE_RPC(DeleteSpilledObjects)
+  IGNORE_RPC(PlasmaObjectReady)
+  IGNORE_RPC(Exit)
+  IGNORE_RPC(AssignObjectOwner)
+  IGNORE_RPC(ReportStreamingReturn)
+
+ private:
+  ClusterCounters &counters_;
+  rpc::GrpcServer server_;
+  rpc::CoreWorkerGrpcService service_;
+};
+
+/// A raylet without a worker pool, object store or local scheduler. It accounts for
+/// the bundles reserved on it, grants every lease on the fake worker and relays the
+/// resource broadcasts as a real raylet does.
+class FakeRaylet : public rpc::NodeManagerServiceHandler {
+ public:
+  FakeRaylet(instrumented_io_context &io_service,
+             rpc::NodeManagerClientPool &raylet_client_pool,
+             ClusterCounters &counters,
+             int worker_port,
+             double num_cpus,
+             double resource_change_probability)
+      : node_id_(NodeID::FromRandom()),
+        raylet_client_pool_(raylet_client_pool),
+        counters_(counters),
+        worker_port_(worker_port),
+        resource_change_probability_(resource_change_probability),
+        server_("FakeRaylet", 0, /*listen_to_localhost_only=*/true),
+        service_(io_service, *this) {
+    total_ = {{kCPU_ResourceLabel, num_cpus}, {kChurnResource, 1}};
+    available_ = total_;
+    server_.RegisterService(service_);
+    server_.Run();
+    gen_.seed(server_.GetPort());
+  }
+
+  const NodeID &GetNodeID() const { return node_id_; }
+
+  rpc::GcsNodeInfo GetNodeInfo() const {
+    rpc::GcsNodeInfo node_info;
+    node_info.set_node_id(node_id_.Binary());
+    node_info.set_node_manager_address(kLocalhost);
+    node_info.set_node_manager_port(server_.GetPort());
+    node_info.set_node_manager_hostname("fake-raylet-" +
+                                        std::to_string(server_.GetPort()));
+    node_info.set_node_name(node_info.node_manager_hostname());
+    node_info.set_state(rpc::GcsNodeInfo::ALIVE);
+    node_info.mutable_resources_total()->insert(total_.begin(), total_.end());
+    return node_info;
+  }
+
+  void HandleRequestResourceReport(const rpc::RequestResourceReportRequest &request,
+                                   rpc::RequestResourceReportReply *reply,
+                                   rpc::SendReplyCallback send_reply_callback) override {
+    counters_.resource_reports++;
+    if (std::bernoulli_distribution(resource_change_probability_)(gen_)) {
+      available_[kChurnResource] = 1 - available_[kChurnResource];
+      resources_changed_ = true;
+    }
+    auto resources = reply->mutable_resources();
+    resources->set_node_id(node_id_.Binary());
+    resources->set_node_manager_address(kLocalhost);
+    if (!reported_total_) {
+      resources->mutable_resources_total()->insert(total_.begin(), total_.end());
+      reported_total_ = true;
+    }
+    if (resources_changed_) {
+      resources->mutable_resources_available()->insert(available_.begin(),
+                                                       available_.end());
+      resources->set_resources_available_changed(true);
+      resources_changed_ = false;
+    }
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  void HandleUpdateResourceUsage(const rpc::UpdateResourceUsageRequest &request,
+                                 rpc::UpdateResourceUsageReply *reply,
+                                 rpc::SendReplyCallback send_reply_callback) override {
+    counters_.broadcasts_received++;
+    counters_.broadcast_bytes_received +=
+        request.serialized_resource_usage_batch().size();
+    if (request.forward_to_size() > 0) {
+      std::string serialized_batch = request.serialized_resource_usage_batch();
+      for (const auto &address : request.forward_to()) {
+        raylet_client_pool_.GetOrConnectByAddress(address)->UpdateResourceUsage(
+            serialized_batch,
+            /*forward_to=*/{},
+            [](const Status &status, const rpc::UpdateResourceUsageReply &reply) {});
+      }
+    }
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  void HandleRequestWorkerLease(const rpc::RequestWorkerLeaseRequest &request,
+                                rpc::RequestWorkerLeaseReply *reply,
+                                rpc::SendReplyCallback send_reply_callback) override {
+    counters_.leases_granted++;
+    auto worker_address = reply->mutable_worker_address();
+    worker_address->set_raylet_id(node_id_.Binary());
+    worker_address->set_ip_address(kLocalhost);
+    worker_address->set_port(worker_port_);
+    worker_address->set_worker_id(WorkerID::FromRandom().Binary());
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  void HandlePrepareBundleResources(
+      const rpc::PrepareBundleResourcesRequest &request,
+      rpc::PrepareBundleResourcesReply *reply,
+      rpc::SendReplyCallback send_reply_callback) override {
+    absl::flat_hash_map<std::string, double> demand;
+    for (const auto &bundle : request.bundle_specs()) {
+      for (const auto &resource : bundle.unit_resources()) {
+        demand[resource.first] += resource.second;
+      }
+    }
+    bool success = std::all_of(demand.begin(), demand.end(), [this](const auto &entry) {
+      auto it = available_.find(entry.first);
+      return it != available_.end() && it->second >= entry.second;
+    });
+    if (success) {
+      for (const auto &entry : demand) {
+        available_[entry.first] -= entry.second;
+      }
+      for (const auto &bundle : request.bundle_specs()) {
+        BundleID bundle_id(
+            PlacementGroupID::FromBinary(bundle.bundle_id().placement_group_id()),
+            bundle.bundle_id().bundle_index());
+        reserved_bundles_[bundle_id] = bundle;
+      }
+      counters_.bundles_prepared += request.bundle_specs_size();
+      resources_changed_ = true;
+    }
+    reply->set_success(success);
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  void HandleCancelResourceReserve(
+      const rpc::CancelResourceReserveRequest &request,
+      rpc::CancelResourceReserveReply *reply,
+      rpc::SendReplyCallback send_reply_callback) override {
+    for (const auto &bundle : request.bundle_specs()) {
+      BundleID bundle_id(
+          PlacementGroupID::FromBinary(bundle.bundle_id().placement_group_id()),
+          bundle.bundle_id().bundle_index());
+      auto it = reserved_bundles_.find(bundle_id);
+      if (it == reserved_bundles_.end()) {
+        continue;
+      }
+      for (const auto &resource : it->second.unit_resources()) {
+        available_[resource.first] += resource.second;
+      }
+      reserved_bundles_.erase(it);
+      resources_changed_ = true;
+    }
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+  }
+
+  IGNORE_RPC(ReportWorkerBacklog)
+  IGNORE_RPC(ReturnWorker)
+  IGNORE_RPC(ReleaseUnusedWorkers)
+  IGNORE_RPC(ShutdownRaylet)
+  IGNORE_RPC(CancelWorkerLease)
+  IGNORE_RPC(CommitBundleResources)
+  IGNORE_RPC(PinObjectIDs)
+  IGNORE_RPC(GetNodeStats)
+  IGNORE_RPC(GlobalGC)
+  IGNORE_RPC(FormatGlobalMemoryInfo)
+  IGNORE_RPC(RequestObjectSpillage)
+  IGNORE_RPC(ReleaseUnusedBundles)
+  IGNORE_RPC(GetSystemConfig)
+  IGNORE_RPC(GetGcsServerAddress)
+  IGNORE_RPC(GetTasksInfo)
+  IGNORE_RPC(GetObjectsInfo)
+  IGNORE_RPC(StealTasks)
+  IGNORE_RPC(ProbeNode)
+  IGNORE_RPC(ProfileCpu)
+
+ private:
+  const NodeID node_id_;
+  rpc::NodeManagerClientPool &raylet_client_pool_;
+  ClusterCounters &counters_;
+  const int worker_port_;
+  const double resource_change_probability_;
+  std::mt19937 gen_;
+  absl::flat_hash_map<std::string, double> total_;
+  absl::flat_hash_map<std::string, double> available_;
+  absl::flat_hash_map<BundleID, rpc::Bundle, pair_hash> reserved_bundles_;
+  bool reported_total_ = false;
+  bool resources_changed_ = true;
+  rpc::GrpcServer server_;
+  rpc::NodeManagerGrpcService service_;
+};
+
+/// Runs a number of asynchronous operations, keeping a bounded number of them
+/// outstanding, and records the latency of each. Operations are started and must
+/// complete on the given event loop.
+class ClosedLoop {
+ public:
+  /// Start the operation with the given index and call `done` when it completes.
+  using Operation = std::function<void(int index, std::function<void()> done)>;
+
+  ClosedLoop(instrumented_io_context &io_service, int num_ops, Operation op)
+      : io_service_(io_service),
+        num_ops_(num_ops),
+        op_(std::move(op)),
+        latencies_ms_(num_ops) {}
+
+  /// Run all the operations and block until they complete.
+  ///
+  /// \return The latency of each operation in milliseconds.
+  std::vector<double> Run(int max_in_flight) {
+    if (num_ops_ == 0) {
+      return {};
+    }
+    io_service_.post(
+        [this, max_in_flight] {
+          for (int i = 0; i < std::min(max_in_flight, num_ops_); i++) {
+            StartNext();
+          }
+        },
+        "ClosedLoop.Start");
+    finished_.get_future().wait();
+    return latencies_ms_;
+  }
+
+ private:
+  void StartNext() {
+    if (next_ == num_ops_) {
+      return;
+    }
+    const int index = next_++;
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    op_(index, [this, index, start_ns] {
+      latencies_ms_[index] = (absl::GetCurrentTimeNanos() - start_ns) / 1e6;
+      if (++num_done_ == num_ops_) {
+        finished_.set_value();
+      } else {
+        StartNext();
+      }
+    });
+  }
+
+  instrumented_io_context &io_service_;
+  const int num_ops_;
+  const Operation op_;
+  std::vector<double> latencies_ms_;
+  int next_ = 0;
+  int num_done_ = 0;
+  std::promise<void> finished_;
+};
+
+/// Format the throughput and latency percentiles of a closed loop as a JSON object.
+std::string LatencyStats(std::vector<double> latencies_ms, double elapsed_s) {
+  std::ostringstream stream;
+  stream << "{\"count\": " << latencies_ms.size()
+         << ", \"per_s\": " << latencies_ms.size() / elapsed_s;
+  if (!latencies_ms.empty()) {
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    auto percentile = [&latencies_ms](double p) {
+      return latencies_ms[std::min(latencies_ms.size() - 1,
+                                   static_cast<size_t>(p * latencies_ms.size()))];
+    };
+    stream << ", \"p50_ms\": " << percentile(0.5)
+           << ", \"p99_ms\": " << percentile(0.99)
+           << ", \"max_ms\": " << latencies_ms.back();
+  }
+  stream << "}";
+  return stream.str();
+}
+
+double SecondsSince(int64_t start_ns) {
+  return (absl::GetCurrentTimeNanos() - start_ns) / 1e9;
+}
+
+/// A real GCS server with a cluster of fake raylets, and a client that drives it as
+/// the drivers of the cluster would.
+class SimulatedCluster {
+ public:
+  SimulatedCluster() : job_id_(JobID::FromInt(1)) {}
+
+  ~SimulatedCluster() { Stop(); }
+
+  void Start(int num_nodes, double cpus_per_node, double resource_change_probability) {
+    gcs::GcsServerConfig config;
+    config.grpc_server_port = 0;
+    config.grpc_server_name = "GcsServer";
+    config.grpc_server_thread_num = 1;
+    config.node_ip_address = kLocalhost;
+    config.log_dir = FLAGS_log_dir;
+    // The GCS server runs its event loop in the constructor, so it must be constructed
+    // before the loop runs on its own thread.
+    gcs_server_ = std::make_unique<gcs::GcsServer>(config, gcs_io_service_);
+    gcs_server_->Start();
+    gcs_thread_ = std::thread([this] {
+      SetThreadName("gcs_server");
+      boost::asio::io_service::work work(gcs_io_service_);
+      gcs_io_service_.run();
+    });
+    while (gcs_server_->GetPort() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    client_thread_ = std::thread([this] {
+      SetThreadName("cluster");
+      boost::asio::io_service::work work(io_service_);
+      io_service_.run();
+    });
+    client_call_manager_ = std::make_unique<rpc::ClientCallManager>(io_service_);
+    gcs_client_ = std::make_unique<rpc::GcsRpcClient>(
+        kLocalhost, gcs_server_->GetPort(), *client_call_manager_);
+    raylet_client_pool_ =
+        std::make_unique<rpc::NodeManagerClientPool>(*client_call_manager_);
+    worker_ = std::make_unique<FakeWorker>(io_service_, counters_);
+    for (int i = 0; i < num_nodes; i++) {
+      raylets_.push_back(std::make_unique<FakeRaylet>(io_service_,
+                                                      *raylet_client_pool_,
+                                                      counters_,
+                                                      worker_->GetPort(),
+                                                      cpus_per_node,
+                                                      resource_change_probability));
+    }
+  }
+
+  void Stop() {
+    if (gcs_server_ == nullptr) {
+      return;
+    }
+    gcs_server_->Stop();
+    gcs_io_service_.stop();
+    gcs_thread_.join();
+    gcs_server_.reset();
+    io_service_.stop();
+    client_thread_.join();
+    heartbeat_runner_.reset();
+    raylets_.clear();
+    worker_.reset();
+  }
+
+  /// Register all the nodes with the GCS, and start sending their heartbeats.
+  std::string RegisterNodes(int max_in_flight) {
+    ClosedLoop loop(
+        io_service_, raylets_.size(), [this](int index, std::function<void()> done) {
+          rpc::RegisterNodeRequest request;
+          request.mutable_node_info()->CopyFrom(raylets_[index]->GetNodeInfo());
+          gcs_client_->RegisterNode(
+              request,
+              [done](const Status &status, const rpc::RegisterNodeReply &reply) {
+                RAY_CHECK(reply.status().code() == static_cast<int>(StatusCode::OK))
+                    << reply.status().message();
+                done();
+              });
+        });
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    auto latencies_ms = loop.Run(max_in_flight);
+    const double elapsed_s = SecondsSince(start_ns);
+
+    heartbeat_runner_ = std::make_unique<PeriodicalRunner>(io_service_);
+    heartbeat_runner_->RunFnPeriodically(
+        [this] {
+          for (const auto &raylet : raylets_) {
+            rpc::ReportHeartbeatRequest request;
+            request.mutable_heartbeat()->set_node_id(raylet->GetNodeID().Binary());
+            gcs_client_->ReportHeartbeat(
+                request, [](const Status &status, const rpc::ReportHeartbeatReply &) {});
+          }
+        },
+        RayConfig::instance().raylet_heartbeat_period_milliseconds(),
+        "SimulatedCluster.ReportHeartbeats");
+    return LatencyStats(std::move(latencies_ms), elapsed_s);
+  }
+
+  void AddJob() {
+    std::promise<void> promise;
+    rpc::AddJobRequest request;
+    request.mutable_data()->CopyFrom(*Mocker::GenJobTableData(job_id_));
+    request.mutable_data()->mutable_config()->set_ray_namespace(kNamespace);
+    gcs_client_->AddJob(request,
+                        [&promise](const Status &status, const rpc::AddJobReply &reply) {
+                          RAY_CHECK(reply.status().code() ==
+                                    static_cast<int>(StatusCode::OK))
+                              << reply.status().message();
+                          promise.set_value();
+                        });
+    promise.get_future().wait();
+  }
+
+  /// Measure the resource reports polled by the GCS and the resource broadcasts it
+  /// sends back, while the cluster is otherwise idle.
+  std::string MeasureResourceBroadcast(int window_ms) {
+    const int64_t reports = counters_.resource_reports;
+    const int64_t broadcasts = counters_.broadcasts_received;
+    const int64_t bytes = counters_.broadcast_bytes_received;
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    std::this_thread::sleep_for(std::chrono::milliseconds(window_ms));
+    const double elapsed_s = SecondsSince(start_ns);
+    std::ostringstream stream;
+    stream << "{\"reports_per_s\": " << (counters_.resource_reports - reports) / elapsed_s
+           << ", \"broadcasts_per_s\": "
+           << (counters_.broadcasts_received - broadcasts) / elapsed_s
+           << ", \"broadcast_bytes_per_s\": "
+           << (counters_.broadcast_bytes_received - bytes) / elapsed_s << "}";
+    return stream.str();
+  }
+
+  /// Create detached actors, from registration until the GCS reports them alive.
+  ///
+  /// \param[out] scheduling The rate at which the GCS leased workers for the actors.
+  std::string CreateActors(int num_actors, int max_in_flight, std::string *scheduling) {
+    rpc::Address owner_address;
+    owner_address.set_ip_address(kLocalhost);
+    owner_address.set_port(worker_->GetPort());
+    owner_address.set_worker_id(WorkerID::FromRandom().Binary());
+    ClosedLoop loop(
+        io_service_,
+        num_actors,
+        [this, owner_address](int index, std::function<void()> done) {
+          auto task_spec = Mocker::GenActorCreationTask(job_id_,
+                                                        /*max_restarts=*/0,
+                                                        /*detached=*/true,
+                                                        /*name=*/"",
+                                                        kNamespace,
+                                                        owner_address);
+          rpc::RegisterActorRequest request;
+          request.mutable_task_spec()->CopyFrom(task_spec.GetMessage());
+          gcs_client_->RegisterActor(
+              request,
+              [this, task_spec, done](const Status &status,
+                                      const rpc::RegisterActorReply &reply) {
+                RAY_CHECK(reply.status().code() == static_cast<int>(StatusCode::OK))
+                    << reply.status().message();
+                rpc::CreateActorRequest request;
+                request.mutable_task_spec()->CopyFrom(task_spec.GetMessage());
+                gcs_client_->CreateActor(
+                    request,
+                    [done](const Status &status, const rpc::CreateActorReply &reply) {
+                      RAY_CHECK(reply.status().code() ==
+                                static_cast<int>(StatusCode::OK))
+                          << reply.status().message();
+                      done();
+                    });
+              });
+        });
+    const int64_t leases = counters_.leases_granted;
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    auto latencies_ms = loop.Run(max_in_flight);
+    const double elapsed_s = SecondsSince(start_ns);
+    std::ostringstream stream;
+    stream << "{\"leases_per_s\": " << (counters_.leases_granted - leases) / elapsed_s
+           << "}";
+    *scheduling = stream.str();
+    return LatencyStats(std::move(latencies_ms), elapsed_s);
+  }
+
+  /// Create placement groups of 1-CPU bundles spread across the nodes, from creation
+  /// until the GCS reports them ready.
+  std::string CreatePlacementGroups(int num_placement_groups,
+                                    int bundles_per_placement_group,
+                                    int max_in_flight) {
+    ClosedLoop loop(
+        io_service_,
+        num_placement_groups,
+        [this, bundles_per_placement_group](int index, std::function<void()> done) {
+          auto request =
+              Mocker::GenCreatePlacementGroupRequest(/*name=*/"",
+                                                     rpc::PlacementStrategy::SPREAD,
+                                                     bundles_per_placement_group,
+                                                     /*cpu_num=*/1.0,
+                                                     job_id_);
+          const auto placement_group_id =
+              request.placement_group_spec().placement_group_id();
+          gcs_client_->CreatePlacementGroup(
+              request,
+              [this, placement_group_id, done](
+                  const Status &status, const rpc::CreatePlacementGroupReply &reply) {
+                RAY_CHECK(reply.status().code() == static_cast<int>(StatusCode::OK))
+                    << reply.status().message();
+                rpc::WaitPlacementGroupUntilReadyRequest request;
+                request.set_placement_group_id(placement_group_id);
+                gcs_client_->WaitPlacementGroupUntilReady(
+                    request,
+                    [done](const Status &status,
+                           const rpc::WaitPlacementGroupUntilReadyReply &reply) {
+                      RAY_CHECK(reply.status().code() ==
+                                static_cast<int>(StatusCode::OK))
+                          << reply.status().message();
+                      done();
+                    });
+              });
+        });
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    auto latencies_ms = loop.Run(max_in_flight);
+    return LatencyStats(std::move(latencies_ms), SecondsSince(start_ns));
+  }
+
+ private:
+  const JobID job_id_;
+  ClusterCounters counters_;
+  instrumented_io_context gcs_io_service_;
+  std::unique_ptr<gcs::GcsServer> gcs_server_;
+  std::thread gcs_thread_;
+  /// The event loop of the fake raylets and the worker, and of the client.
+  instrumented_io_context io_service_;
+  std::thread client_thread_;
+  std::unique_ptr<rpc::ClientCallManager> client_call_manager_;
+  std::unique_ptr<rpc::GcsRpcClient> gcs_client_;
+  std::unique_ptr<rpc::NodeManagerClientPool> raylet_client_pool_;
+  std::unique_ptr<FakeWorker> worker_;
+  std::vector<std::unique_ptr<FakeRaylet>> raylets_;
+  std::unique_ptr<PeriodicalRunner> heartbeat_runner_;
+};
+
+}  // namespace
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  InitShutdownRAII ray_log_shutdown_raii(ray::RayLog::StartRayLog,
+                                         ray::RayLog::ShutDownRayLog,
+                                         argv[0],
+                                         ray::RayLogLevel::WARNING,
+                                         /*log_dir=*/"");
+  ray::RayLog::InstallFailureSignalHandler(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  RayConfig::instance().initialize(FLAGS_system_config);
+
+  ray::SimulatedCluster cluster;
+  cluster.Start(FLAGS_num_nodes, FLAGS_cpus_per_node, FLAGS_resource_change_probability);
+  const auto node_registration = cluster.RegisterNodes(FLAGS_max_in_flight);
+  cluster.AddJob();
+  const auto resource_broadcast =
+      cluster.MeasureResourceBroadcast(FLAGS_broadcast_window_ms);
+  std::string scheduling;
+  const auto actor_creation =
+      cluster.CreateActors(FLAGS_num_actors, FLAGS_max_in_flight, &scheduling);
+  const auto placement_group_creation =
+      cluster.CreatePlacementGroups(FLAGS_num_placement_groups,
+                                    FLAGS_bundles_per_placement_group,
+                                    FLAGS_max_in_flight);
+  cluster.Stop();
+
+  std::cout << "{\"num_nodes\": " << FLAGS_num_nodes
+            << ", \"node_registration\": " << node_registration
+            << ", \"resource_broadcast\": " << resource_broadcast
+            << ", \"actor_creation\": " << actor_creation
+            << ", \"actor_scheduling\": " << scheduling
+            << ", \"placement_group_creation\": " << placement_group_creation << "}"
+            << std::endl;
+  gflags::ShutDownCommandLineFlags();
+  return 0;
+}
@@ -193,7 +193,7 @@ struct GcsServerMocker {
 
     /// ResourceReserveInterface
     void CancelResourceReserve(
-        const BundleSpecification &bundle_spec,
+        const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
         const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback)
         override {
       num_return_requested += 1;
@@ -270,6 +270,7 @@ struct GcsServerMocker {
 
     /// ResourceUsageInterface
     void RequestResourceReport(
+        int64_t last_report_version,
         const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback) override {
       RAY_CHECK(false) << "Unused";
     };
@@ -277,6 +278,7 @@ struct GcsServerMocker {
     /// ResourceUsageInterface
     void UpdateResourceUsage(
         std::string &address,
+        const std::vector<rpc::Address> &forward_to,
         const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) override {
       RAY_CHECK(false) << "Unused";
     };
@@ -287,6 +289,18 @@ struct GcsServerMocker {
         bool graceful,
         const rpc::ClientCallback<rpc::ShutdownRayletReply> &callback) override{};
 
+    void StealTasks(
+        const NodeID &node_id,
+        const absl::flat_hash_map<std::string, double> &resources_available,
+        const rpc::ClientCallback<rpc::StealTasksReply> &callback) override {
+      RAY_CHECK(false) << "Unused";
+    };
+
+    void ProbeNode(const absl::optional<rpc::Address> &target,
+                   const rpc::ClientCallback<rpc::ProbeNodeReply> &callback) override {
+      RAY_CHECK(false) << "Unused";
+    };
+
     ~MockRayletClient() {}
 
     int num_workers_requested = 0;
@@ -312,11 +326,6 @@ struct GcsServerMocker {
    public:
     using gcs::RayletBasedActorScheduler::RayletBasedActorScheduler;
 
-    void TryLeaseWorkerFromNodeAgain(std::shared_ptr<gcs::GcsActor> actor,
-                                     std::shared_ptr<rpc::GcsNodeInfo> node) {
-      DoRetryLeasingWorkerFromNode(std::move(actor), std::move(node));
-    }
-
    protected:
     void RetryLeasingWorkerFromNode(std::shared_ptr<gcs::GcsActor> actor,
                                     std::shared_ptr<rpc::GcsNodeInfo> node) override {
@@ -341,11 +350,6 @@ struct GcsServerMocker {
    public:
     using gcs::GcsBasedActorScheduler::GcsBasedActorScheduler;
 
-    void TryLeaseWorkerFromNodeAgain(std::shared_ptr<gcs::GcsActor> actor,
-                                     std::shared_ptr<rpc::GcsNodeInfo> node) {
-      DoRetryLeasingWorkerFromNode(std::move(actor), std::move(node));
-    }
-
    protected:
     void RetryLeasingWorkerFromNode(std::shared_ptr<gcs::GcsActor> actor,
                                     std::shared_ptr<rpc::GcsNodeInfo> node) override {
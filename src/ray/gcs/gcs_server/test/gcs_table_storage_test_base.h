@@ -96,6 +96,13 @@ class GcsTableStorageTestBase : public ::testing::Test {
 
     ASSERT_EQ(Get(table, actor_id3, values), 0);
     ASSERT_EQ(GetByJobId(table, job_id3, actor_id3, values), 0);
+
+    // Delete by job id, including a job with no actors left.
+    Put(table, actor_id1, *actor_table_data1);
+    DeleteByJobId(table, job_id1);
+    ASSERT_EQ(Get(table, actor_id1, values), 0);
+    DeleteByJobId(table, job_id1);
+    ASSERT_EQ(GetByJobId(table, job_id1, actor_id1, values), 0);
   }
 
   template <typename TABLE, typename KEY, typename VALUE>
@@ -171,6 +178,17 @@ class GcsTableStorageTestBase : public ::testing::Test {
     WaitPendingDone();
   }
 
+  template <typename TABLE>
+  void DeleteByJobId(TABLE &table, const JobID &job_id) {
+    auto on_done = [this](const Status &status) {
+      RAY_CHECK_OK(status);
+      --pending_count_;
+    };
+    ++pending_count_;
+    RAY_CHECK_OK(table.DeleteByJobId(job_id, on_done));
+    WaitPendingDone();
+  }
+
   void WaitPendingDone() { WaitPendingDone(pending_count_); }
 
   void WaitPendingDone(std::atomic<int> &pending_count) {
@@ -35,8 +35,10 @@ class GrpcBasedResourceBroadcasterTest : public ::testing::Test {
             [this](const rpc::Address &address,
                    std::shared_ptr<rpc::NodeManagerClientPool> &pool,
                    std::string &data,
+                   const std::vector<rpc::Address> &forward_to,
                    const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) {
               num_batches_sent_++;
+              num_forwarded_ += forward_to.size();
               callbacks_.push_back(callback);
             }) {}
 
@@ -55,6 +57,7 @@ class GrpcBasedResourceBroadcasterTest : public ::testing::Test {
   }
 
   int num_batches_sent_;
+  size_t num_forwarded_ = 0;
   std::deque<rpc::ClientCallback<rpc::UpdateResourceUsageReply>> callbacks_;
 
   GrpcBasedResourceBroadcaster broadcaster_;
@@ -87,5 +90,24 @@ TEST_F(GrpcBasedResourceBroadcasterTest, TestNodeRemoval) {
   AssertNoLeaks();
 }
 
+TEST_F(GrpcBasedResourceBroadcasterTest, TestRelay) {
+  RayConfig::instance().initialize(R"({"resource_broadcast_relay_fanout": 2})");
+  for (int i = 0; i < 5; i++) {
+    broadcaster_.HandleNodeAdded(*Mocker::GenNodeInfo());
+  }
+  SendBroadcast();
+  // The nodes are split into a group of 3 and a group of 2.
+  ASSERT_EQ(num_batches_sent_, 2);
+  ASSERT_EQ(num_forwarded_, 3);
+
+  // The first relay fails, so the rest of its group gets the batch directly.
+  rpc::UpdateResourceUsageReply reply;
+  callbacks_.front()(Status::IOError("unreachable"), reply);
+  callbacks_.pop_front();
+  ASSERT_EQ(num_batches_sent_, 4);
+  ASSERT_EQ(num_forwarded_, 3);
+  RayConfig::instance().initialize("");
+}
+
 }  // namespace gcs
 }  // namespace ray
@@ -130,6 +130,37 @@ TEST_F(RayletBasedActorSchedulerTest, TestScheduleActorSuccess) {
   ASSERT_EQ(actor->GetWorkerID(), worker_id);
 }
 
+TEST_F(RayletBasedActorSchedulerTest, TestScheduleActorOnLocalityNode) {
+  for (int i = 0; i < 3; i++) {
+    gcs_node_manager_->AddNode(Mocker::GenNodeInfo());
+  }
+  auto locality_node = Mocker::GenNodeInfo();
+  auto locality_node_id = NodeID::FromBinary(locality_node->node_id());
+  gcs_node_manager_->AddNode(locality_node);
+
+  // The actor is placed on the node that holds its arguments.
+  auto job_id = JobID::FromInt(1);
+  auto create_actor_request = Mocker::GenCreateActorRequest(job_id);
+  create_actor_request.mutable_task_spec()
+      ->mutable_actor_creation_task_spec()
+      ->set_locality_node_id(locality_node_id.Binary());
+  auto actor = std::make_shared<gcs::GcsActor>(create_actor_request.task_spec(), "");
+  gcs_actor_scheduler_->Schedule(actor);
+  ASSERT_EQ(1, raylet_client_->num_workers_requested);
+  ASSERT_EQ(actor->GetNodeID(), locality_node_id);
+
+  // The node is ignored once it's dead.
+  gcs_node_manager_->RemoveNode(locality_node_id);
+  create_actor_request = Mocker::GenCreateActorRequest(job_id);
+  create_actor_request.mutable_task_spec()
+      ->mutable_actor_creation_task_spec()
+      ->set_locality_node_id(locality_node_id.Binary());
+  actor = std::make_shared<gcs::GcsActor>(create_actor_request.task_spec(), "");
+  gcs_actor_scheduler_->Schedule(actor);
+  ASSERT_EQ(2, raylet_client_->num_workers_requested);
+  ASSERT_NE(actor->GetNodeID(), locality_node_id);
+}
+
 TEST_F(RayletBasedActorSchedulerTest, TestScheduleRetryWhenLeasing) {
   auto node = Mocker::GenNodeInfo();
   auto node_id = NodeID::FromBinary(node->node_id());
@@ -522,18 +553,18 @@ TEST_F(RayletBasedActorSchedulerTest, TestReleaseUnusedWorkers) {
   // `LeaseWorkerFromNode` method.
   // But since the `ReleaseUnusedWorkers` request hasn't finished, `GcsActorScheduler`
   // won't send `RequestWorkerLease` request to node immediately. But instead, it will
-  // invoke the `RetryLeasingWorkerFromNode` to retry later.
+  // wait for the reply of the `ReleaseUnusedWorkers` request.
   auto job_id = JobID::FromInt(1);
   auto request = Mocker::GenCreateActorRequest(job_id);
   auto actor = std::make_shared<gcs::GcsActor>(request.task_spec(), "");
   gcs_actor_scheduler_->Schedule(actor);
-  ASSERT_EQ(2, gcs_actor_scheduler_->num_retry_leasing_count_);
+  ASSERT_EQ(0, gcs_actor_scheduler_->num_retry_leasing_count_);
   ASSERT_EQ(raylet_client_->num_workers_requested, 0);
 
   // When `GcsActorScheduler` receives the `ReleaseUnusedWorkers` reply, it will send
-  // out the `RequestWorkerLease` request.
+  // out the `RequestWorkerLease` request without polling.
   ASSERT_TRUE(raylet_client_->ReplyReleaseUnusedWorkers());
-  gcs_actor_scheduler_->TryLeaseWorkerFromNodeAgain(actor, node);
+  ASSERT_EQ(0, gcs_actor_scheduler_->num_retry_leasing_count_);
   ASSERT_EQ(raylet_client_->num_workers_requested, 1);
 }
 
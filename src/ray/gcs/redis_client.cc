@@ -14,6 +14,8 @@
 
 #include "ray/gcs/redis_client.h"
 
+#include <algorithm>
+
 #include "ray/common/ray_config.h"
 #include "ray/gcs/redis_context.h"
 
@@ -145,24 +147,9 @@ Status RedisClient::Connect(std::vector<instrumented_io_context *> io_services)
       ports.push_back(options_.server_port_);
     }
 
-    for (size_t i = 0; i < addresses.size(); ++i) {
-      size_t io_service_index = (i + 1) % io_services.size();
-      instrumented_io_context &io_service = *io_services[io_service_index];
-      // Populate shard_contexts.
-      shard_contexts_.push_back(std::make_shared<RedisContext>(io_service));
-      // Only async context is used in sharding context, so wen disable the other two.
-      RAY_CHECK_OK(shard_contexts_[i]->Connect(addresses[i],
-                                               ports[i],
-                                               /*sharding=*/true,
-                                               /*password=*/options_.password_));
-    }
+    ConnectShards(addresses, ports, io_services);
   } else {
-    shard_contexts_.push_back(std::make_shared<RedisContext>(*io_services[0]));
-    // Only async context is used in sharding context, so wen disable the other two.
-    RAY_CHECK_OK(shard_contexts_[0]->Connect(options_.server_ip_,
-                                             options_.server_port_,
-                                             /*sharding=*/true,
-                                             /*password=*/options_.password_));
+    ConnectShards({options_.server_ip_}, {options_.server_port_}, io_services);
   }
 
   Attach();
@@ -173,13 +160,39 @@ Status RedisClient::Connect(std::vector<instrumented_io_context *> io_services)
   return Status::OK();
 }
 
+void RedisClient::ConnectShards(
+    const std::vector<std::string> &addresses,
+    const std::vector<int> &ports,
+    const std::vector<instrumented_io_context *> &io_services) {
+  const size_t connections_per_shard =
+      std::max<size_t>(1, options_.connections_per_shard_);
+  size_t num_connections = 0;
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    shard_connections_.emplace_back();
+    for (size_t j = 0; j < connections_per_shard; ++j) {
+      size_t io_service_index = (++num_connections) % io_services.size();
+      instrumented_io_context &io_service = *io_services[io_service_index];
+      auto context = std::make_shared<RedisContext>(io_service);
+      // Only async context is used in sharding context, so wen disable the other two.
+      RAY_CHECK_OK(context->Connect(addresses[i],
+                                    ports[i],
+                                    /*sharding=*/true,
+                                    /*password=*/options_.password_));
+      shard_connections_.back().push_back(std::move(context));
+    }
+    shard_contexts_.push_back(shard_connections_.back().front());
+  }
+}
+
 void RedisClient::Attach() {
   // Take care of sharding contexts.
   RAY_CHECK(shard_asio_async_clients_.empty()) << "Attach shall be called only once";
-  for (std::shared_ptr<RedisContext> context : shard_contexts_) {
-    instrumented_io_context &io_service = context->io_service();
-    shard_asio_async_clients_.emplace_back(
-        new RedisAsioClient(io_service, context->async_context()));
+  for (const auto &connections : shard_connections_) {
+    for (const auto &context : connections) {
+      instrumented_io_context &io_service = context->io_service();
+      shard_asio_async_clients_.emplace_back(
+          new RedisAsioClient(io_service, context->async_context()));
+    }
   }
   instrumented_io_context &io_service = primary_context_->io_service();
   asio_async_auxiliary_client_.reset(
@@ -193,10 +206,11 @@ void RedisClient::Disconnect() {
 }
 
 std::shared_ptr<RedisContext> RedisClient::GetShardContext(const std::string &shard_key) {
-  RAY_CHECK(!shard_contexts_.empty());
+  RAY_CHECK(!shard_connections_.empty());
   static std::hash<std::string> hash;
-  size_t index = hash(shard_key) % shard_contexts_.size();
-  return shard_contexts_[index];
+  const size_t key_hash = hash(shard_key);
+  const auto &connections = shard_connections_[key_hash % shard_connections_.size()];
+  return connections[key_hash / shard_connections_.size() % connections.size()];
 }
 
 int RedisClient::GetNextJobID() {
@@ -33,11 +33,13 @@ class RedisClientOptions {
   RedisClientOptions(const std::string &ip,
                      int port,
                      const std::string &password,
-                     bool enable_sharding_conn = true)
+                     bool enable_sharding_conn = true,
+                     size_t connections_per_shard = 1)
       : server_ip_(ip),
         server_port_(port),
         password_(password),
-        enable_sharding_conn_(enable_sharding_conn) {}
+        enable_sharding_conn_(enable_sharding_conn),
+        connections_per_shard_(connections_per_shard) {}
 
   // Redis server address
   std::string server_ip_;
@@ -48,6 +50,10 @@ class RedisClientOptions {
 
   // Whether we enable sharding for accessing data.
   bool enable_sharding_conn_{true};
+
+  // The number of connections to open to each shard. The keys of a shard are spread
+  // across its connections, each key always going through the same one.
+  size_t connections_per_shard_{1};
 };
 
 /// \class RedisClient
@@ -78,10 +84,13 @@ class RedisClient {
   /// Disconnect with Redis. Non-thread safe.
   void Disconnect();
 
+  /// Get a context of each shard, e.g. to scan all the shards.
   std::vector<std::shared_ptr<RedisContext>> GetShardContexts() {
     return shard_contexts_;
   }
 
+  /// Get the context to send the commands about a key through. The commands about the
+  /// same key always go through the same context, so they are run in order.
   std::shared_ptr<RedisContext> GetShardContext(const std::string &shard_key);
 
   std::shared_ptr<RedisContext> GetPrimaryContext() { return primary_context_; }
@@ -93,6 +102,11 @@ class RedisClient {
   /// one event loop should be attached at a time.
   void Attach();
 
+  /// Connect to each shard, with `connections_per_shard_` connections.
+  void ConnectShards(const std::vector<std::string> &addresses,
+                     const std::vector<int> &ports,
+                     const std::vector<instrumented_io_context *> &io_services);
+
   RedisClientOptions options_;
 
   /// Whether this client is connected to redis.
@@ -100,6 +114,8 @@ class RedisClient {
 
   // The following contexts write to the data shard
   std::vector<std::shared_ptr<RedisContext>> shard_contexts_;
+  // The connections to each shard, the first of which is in `shard_contexts_`.
+  std::vector<std::vector<std::shared_ptr<RedisContext>>> shard_connections_;
   std::vector<std::unique_ptr<RedisAsioClient>> shard_asio_async_clients_;
   std::unique_ptr<RedisAsioClient> asio_async_auxiliary_client_;
   // The following context writes everything to the primary shard
@@ -0,0 +1,386 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/store_client/file_store_client.h"
+
+#include <fcntl.h>
+
+#include <boost/asio/post.hpp>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "ray/common/ray_config.h"
+
+namespace ray {
+
+namespace gcs {
+
+namespace {
+
+/// The type of a record in the log or in the snapshot.
+enum class RecordType : char {
+  /// Put data into a table.
+  PUT = 0,
+  /// Delete a key from a table.
+  ERASE = 1,
+  /// Set the last job ID to the data.
+  JOB_ID = 2,
+  /// Set the generation to the data. The first record of a snapshot.
+  GENERATION = 3,
+};
+
+/// Append a string, prefixed with its little endian 8-byte size.
+void AppendString(const std::string &value, std::string *out) {
+  const uint64_t size = value.size();
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    out->push_back(static_cast<char>(size >> (8 * i)));
+  }
+  out->append(value);
+}
+
+/// Read a string appended by AppendString, or return false if the input ends first.
+bool ReadString(const std::string &in, size_t *offset, std::string *value) {
+  if (in.size() - *offset < sizeof(uint64_t)) {
+    return false;
+  }
+  uint64_t size = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    size |= static_cast<uint64_t>(static_cast<uint8_t>(in[*offset + i])) << (8 * i);
+  }
+  *offset += sizeof(uint64_t);
+  if (in.size() - *offset < size) {
+    return false;
+  }
+  value->assign(in, *offset, size);
+  *offset += size;
+  return true;
+}
+
+std::string EncodeRecord(RecordType type,
+                         const std::string &table_name,
+                         const std::string &key,
+                         const std::string &data) {
+  std::string record(1, static_cast<char>(type));
+  AppendString(table_name, &record);
+  AppendString(key, &record);
+  AppendString(data, &record);
+  return record;
+}
+
+Status ErrnoToStatus(const std::string &operation, const std::string &path) {
+  return Status::IOError(operation + " " + path + ": " + std::strerror(errno));
+}
+
+/// Write the data to the file, and sync it to the disk.
+Status WriteAndSync(std::FILE *file, const std::string &data, const std::string &path) {
+  if (std::fwrite(data.data(), 1, data.size(), file) != data.size() ||
+      std::fflush(file) != 0) {
+    return ErrnoToStatus("Failed to write", path);
+  }
+#ifdef _WIN32
+  if (_commit(_fileno(file)) != 0) {
+#else
+  if (fsync(fileno(file)) != 0) {
+#endif
+    return ErrnoToStatus("Failed to sync", path);
+  }
+  return Status::OK();
+}
+
+/// Sync a directory, so that the files created or renamed in it are durable.
+void SyncDirectory(const std::string &directory) {
+#ifndef _WIN32
+  int fd = open(directory.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+#endif
+}
+
+}  // namespace
+
+FileStoreClient::FileStoreClient(instrumented_io_context &main_io_service,
+                                 std::string directory)
+    : InMemoryStoreClient(main_io_service),
+      io_service_(main_io_service),
+      directory_(std::move(directory)),
+      commit_thread_(1) {
+  Load();
+}
+
+FileStoreClient::~FileStoreClient() {
+  // Wait for the pending commits.
+  commit_thread_.join();
+  absl::MutexLock lock(&commit_mutex_);
+  if (log_file_ != nullptr) {
+    std::fclose(log_file_);
+  }
+}
+
+Status FileStoreClient::AsyncPut(const std::string &table_name,
+                                 const std::string &key,
+                                 const std::string &data,
+                                 const StatusCallback &callback) {
+  absl::MutexLock lock(&log_mutex_);
+  RAY_CHECK_OK(InMemoryStoreClient::AsyncPut(table_name, key, data, nullptr));
+  AppendRecord(EncodeRecord(RecordType::PUT, table_name, key, data),
+               PostToMain(callback, "GcsFileStore.Put"));
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncBatchPut(
+    const std::string &table_name,
+    std::vector<std::pair<std::string, std::string>> kvs,
+    const StatusCallback &callback) {
+  absl::MutexLock lock(&log_mutex_);
+  std::string records;
+  for (const auto &kv : kvs) {
+    records += EncodeRecord(RecordType::PUT, table_name, kv.first, kv.second);
+  }
+  RAY_CHECK_OK(InMemoryStoreClient::AsyncBatchPut(table_name, std::move(kvs), nullptr));
+  AppendRecord(records, PostToMain(callback, "GcsFileStore.BatchPut"));
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncDelete(const std::string &table_name,
+                                    const std::string &key,
+                                    const StatusCallback &callback) {
+  absl::MutexLock lock(&log_mutex_);
+  RAY_CHECK_OK(InMemoryStoreClient::AsyncDelete(table_name, key, nullptr));
+  AppendRecord(EncodeRecord(RecordType::ERASE, table_name, key, ""),
+               PostToMain(callback, "GcsFileStore.Delete"));
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncBatchDelete(const std::string &table_name,
+                                         const std::vector<std::string> &keys,
+                                         const StatusCallback &callback) {
+  absl::MutexLock lock(&log_mutex_);
+  RAY_CHECK_OK(InMemoryStoreClient::AsyncBatchDelete(table_name, keys, nullptr));
+  std::string records;
+  for (const auto &key : keys) {
+    records += EncodeRecord(RecordType::ERASE, table_name, key, "");
+  }
+  AppendRecord(records, PostToMain(callback, "GcsFileStore.BatchDelete"));
+  return Status::OK();
+}
+
+int FileStoreClient::GetNextJobID() {
+  std::promise<Status> synced;
+  int job_id = 0;
+  {
+    absl::MutexLock lock(&log_mutex_);
+    job_id = ++job_id_;
+    AppendRecord(EncodeRecord(RecordType::JOB_ID, "", "", std::to_string(job_id)),
+                 [&synced](Status status) { synced.set_value(status); });
+  }
+  RAY_CHECK_OK(synced.get_future().get());
+  return job_id;
+}
+
+void FileStoreClient::Load() {
+  absl::MutexLock lock(&log_mutex_);
+  absl::MutexLock commit_lock(&commit_mutex_);
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  RAY_CHECK(!ec) << "Failed to create the GCS storage directory " << directory_ << ": "
+                 << ec.message();
+  if (std::filesystem::exists(SnapshotPath())) {
+    ApplyRecords(SnapshotPath());
+  }
+  // Remove what a crash during a compaction may have left behind.
+  const auto log_path = LogPath(generation_);
+  for (const auto &entry : std::filesystem::directory_iterator(directory_)) {
+    const auto path = entry.path().string();
+    if (path != SnapshotPath() && path != log_path) {
+      std::filesystem::remove(entry.path(), ec);
+    }
+  }
+  if (std::filesystem::exists(log_path)) {
+    log_size_ = ApplyRecords(log_path);
+    // Drop the torn record, so that the next ones can be read after it.
+    std::filesystem::resize_file(log_path, log_size_, ec);
+    RAY_CHECK(!ec) << "Failed to truncate " << log_path << ": " << ec.message();
+  }
+  log_file_ = std::fopen(log_path.c_str(), "ab");
+  RAY_CHECK(log_file_ != nullptr) << ErrnoToStatus("Failed to open", log_path);
+  RAY_LOG(INFO) << "Loaded the GCS tables from " << directory_ << ", generation "
+                << generation_ << ", log size " << log_size_;
+}
+
+uint64_t FileStoreClient::ApplyRecords(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  RAY_CHECK(file) << "Failed to read " << path;
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string records = buffer.str();
+
+  size_t offset = 0;
+  std::string table_name;
+  std::string key;
+  std::string data;
+  while (offset < records.size()) {
+    size_t record_offset = offset + 1;
+    if (!ReadString(records, &record_offset, &table_name) ||
+        !ReadString(records, &record_offset, &key) ||
+        !ReadString(records, &record_offset, &data)) {
+      RAY_LOG(WARNING) << "Ignoring the torn record at offset " << offset << " of "
+                       << path;
+      break;
+    }
+    switch (static_cast<RecordType>(records[offset])) {
+    case RecordType::PUT:
+      RAY_CHECK_OK(InMemoryStoreClient::AsyncPut(table_name, key, data, nullptr));
+      break;
+    case RecordType::ERASE:
+      RAY_CHECK_OK(InMemoryStoreClient::AsyncDelete(table_name, key, nullptr));
+      break;
+    case RecordType::JOB_ID:
+      job_id_ = std::stoi(data);
+      break;
+    case RecordType::GENERATION:
+      generation_ = std::stoull(data);
+      break;
+    default:
+      RAY_LOG(FATAL) << "Unknown record type " << static_cast<int>(records[offset])
+                     << " at offset " << offset << " of " << path;
+    }
+    offset = record_offset;
+  }
+  return offset;
+}
+
+void FileStoreClient::AppendRecord(const std::string &record,
+                                   std::function<void(Status)> callback) {
+  pending_records_ += record;
+  if (callback) {
+    pending_callbacks_.push_back(std::move(callback));
+  }
+  if (!commit_scheduled_) {
+    commit_scheduled_ = true;
+    boost::asio::post(commit_thread_, [this]() { Commit(); });
+  }
+}
+
+void FileStoreClient::Commit() {
+  absl::MutexLock commit_lock(&commit_mutex_);
+  while (true) {
+    // The records that arrive while a group is synced form the next group.
+    std::string records;
+    std::vector<std::function<void(Status)>> callbacks;
+    std::string snapshot;
+    {
+      absl::MutexLock lock(&log_mutex_);
+      if (pending_records_.empty()) {
+        commit_scheduled_ = false;
+        return;
+      }
+      records.swap(pending_records_);
+      callbacks.swap(pending_callbacks_);
+      if (log_size_ + records.size() >
+          RayConfig::instance().gcs_storage_file_compaction_bytes()) {
+        // The tables already include the group, so the snapshot replaces it too.
+        snapshot = EncodeRecord(
+            RecordType::GENERATION, "", "", std::to_string(generation_ + 1));
+        snapshot += EncodeRecord(RecordType::JOB_ID, "", "", std::to_string(job_id_));
+        ForEachRecord([&snapshot](const std::string &table_name,
+                                  const std::string &key,
+                                  const std::string &data) {
+          snapshot += EncodeRecord(RecordType::PUT, table_name, key, data);
+        });
+      }
+    }
+    auto status = snapshot.empty() ? WriteLog(records) : WriteSnapshot(snapshot);
+    if (!snapshot.empty() && !status.ok()) {
+      RAY_LOG(WARNING) << "Failed to compact the GCS tables: " << status;
+      status = WriteLog(records);
+    }
+    if (!status.ok()) {
+      RAY_LOG(ERROR) << "Failed to persist the GCS tables: " << status;
+    }
+    for (const auto &callback : callbacks) {
+      callback(status);
+    }
+  }
+}
+
+Status FileStoreClient::WriteLog(const std::string &records) {
+  RAY_RETURN_NOT_OK(WriteAndSync(log_file_, records, LogPath(generation_)));
+  log_size_ += records.size();
+  return Status::OK();
+}
+
+Status FileStoreClient::WriteSnapshot(const std::string &snapshot) {
+  const auto snapshot_path = SnapshotPath();
+  const auto tmp_path = snapshot_path + ".tmp";
+  std::FILE *file = std::fopen(tmp_path.c_str(), "wb");
+  if (file == nullptr) {
+    return ErrnoToStatus("Failed to open", tmp_path);
+  }
+  auto status = WriteAndSync(file, snapshot, tmp_path);
+  std::fclose(file);
+  RAY_RETURN_NOT_OK(status);
+  std::error_code ec;
+  // Once the snapshot is renamed, it is loaded with the log of the next generation.
+  std::filesystem::rename(tmp_path, snapshot_path, ec);
+  if (ec) {
+    return Status::IOError("Failed to rename " + tmp_path + ": " + ec.message());
+  }
+  const auto old_log_path = LogPath(generation_);
+  generation_++;
+  const auto log_path = LogPath(generation_);
+  std::fclose(log_file_);
+  log_file_ = std::fopen(log_path.c_str(), "wb");
+  RAY_CHECK(log_file_ != nullptr) << ErrnoToStatus("Failed to open", log_path);
+  log_size_ = 0;
+  SyncDirectory(directory_);
+  std::filesystem::remove(old_log_path, ec);
+  RAY_LOG(INFO) << "Compacted the GCS tables into a snapshot of " << snapshot.size()
+                << " bytes, generation " << generation_;
+  return Status::OK();
+}
+
+std::function<void(Status)> FileStoreClient::PostToMain(const StatusCallback &callback,
+                                                        const std::string &name) {
+  if (callback == nullptr) {
+    return nullptr;
+  }
+  return [&io_service = io_service_, callback, name](Status status) {
+    io_service.post([callback, status]() { callback(status); }, name);
+  };
+}
+
+std::string FileStoreClient::SnapshotPath() const {
+  return (std::filesystem::path(directory_) / "snapshot").string();
+}
+
+std::string FileStoreClient::LogPath(uint64_t generation) const {
+  return (std::filesystem::path(directory_) / ("log." + std::to_string(generation)))
+      .string();
+}
+
+}  // namespace gcs
+
+}  // namespace ray
@@ -0,0 +1,127 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio/thread_pool.hpp>
+#include <cstdio>
+
+#include "absl/synchronization/mutex.h"
+#include "ray/gcs/store_client/in_memory_store_client.h"
+
+namespace ray {
+
+namespace gcs {
+
+/// \class FileStoreClient
+/// Store client that serves every read from memory, and persists the writes to a
+/// directory on the local disk, so that they survive a restart.
+///
+/// The writes are appended to a log, and the writes that arrive while the log is
+/// synced are committed together with the next sync. Once the log grows past
+/// gcs_storage_file_compaction_bytes, it is replaced by a snapshot of all of the
+/// tables and a new, empty log. The snapshot and the log it is followed by are loaded
+/// when the client is created.
+///
+/// This class is thread safe.
+class FileStoreClient : public InMemoryStoreClient {
+ public:
+  /// Create the client, and load the tables persisted in the directory.
+  ///
+  /// \param main_io_service The event loop that the callbacks are posted to.
+  /// \param directory The directory to persist the tables to.
+  FileStoreClient(instrumented_io_context &main_io_service, std::string directory);
+
+  ~FileStoreClient() override;
+
+  Status AsyncPut(const std::string &table_name,
+                  const std::string &key,
+                  const std::string &data,
+                  const StatusCallback &callback) override;
+
+  Status AsyncBatchPut(const std::string &table_name,
+                       std::vector<std::pair<std::string, std::string>> kvs,
+                       const StatusCallback &callback) override;
+
+  Status AsyncDelete(const std::string &table_name,
+                     const std::string &key,
+                     const StatusCallback &callback) override;
+
+  Status AsyncBatchDelete(const std::string &table_name,
+                          const std::vector<std::string> &keys,
+                          const StatusCallback &callback) override;
+
+  /// The job ID is synced to the log before it is returned.
+  int GetNextJobID() override;
+
+ private:
+  /// Read the snapshot and the log, apply their records, and open the log for
+  /// appending.
+  void Load();
+
+  /// Apply the records of a file, and return the size of its prefix of complete
+  /// records. A record that was torn by a crash is ignored.
+  uint64_t ApplyRecords(const std::string &path)
+      EXCLUSIVE_LOCKS_REQUIRED(log_mutex_, commit_mutex_);
+
+  /// Append a record to the next commit, and schedule the commit.
+  ///
+  /// \param callback Called on the commit thread once the record is synced.
+  void AppendRecord(const std::string &record, std::function<void(Status)> callback)
+      EXCLUSIVE_LOCKS_REQUIRED(log_mutex_);
+
+  /// Write and sync the pending records, in groups, until there are none left.
+  void Commit();
+
+  /// Append records to the log, and sync it.
+  Status WriteLog(const std::string &records) EXCLUSIVE_LOCKS_REQUIRED(commit_mutex_);
+
+  /// Write a snapshot of all of the tables, which replaces the log.
+  Status WriteSnapshot(const std::string &snapshot)
+      EXCLUSIVE_LOCKS_REQUIRED(commit_mutex_);
+
+  /// Wrap a callback so that it is posted to the main io service.
+  std::function<void(Status)> PostToMain(const StatusCallback &callback,
+                                         const std::string &name);
+
+  std::string SnapshotPath() const;
+  std::string LogPath(uint64_t generation) const;
+
+  instrumented_io_context &io_service_;
+  const std::string directory_;
+
+  /// Protects the tables in memory together with the pending records, so that the
+  /// records are in the order of the writes to the tables.
+  absl::Mutex log_mutex_;
+  /// The records that are waiting to be committed.
+  std::string pending_records_ GUARDED_BY(log_mutex_);
+  std::vector<std::function<void(Status)>> pending_callbacks_ GUARDED_BY(log_mutex_);
+  bool commit_scheduled_ GUARDED_BY(log_mutex_) = false;
+
+  /// Held while a group is committed.
+  absl::Mutex commit_mutex_;
+  /// The generation of the snapshot and of the log that follows it.
+  uint64_t generation_ GUARDED_BY(commit_mutex_) = 0;
+  /// The log, open for appending.
+  std::FILE *log_file_ GUARDED_BY(commit_mutex_) = nullptr;
+  /// The number of bytes in the log.
+  uint64_t log_size_ GUARDED_BY(commit_mutex_) = 0;
+
+  /// The thread that commits the records.
+  boost::asio::thread_pool commit_thread_;
+};
+
+}  // namespace gcs
+
+}  // namespace ray
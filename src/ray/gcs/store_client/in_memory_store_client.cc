@@ -32,6 +32,22 @@ Status InMemoryStoreClient::AsyncPut(const std::string &table_name,
   return Status::OK();
 }
 
+Status InMemoryStoreClient::AsyncBatchPut(
+    const std::string &table_name,
+    std::vector<std::pair<std::string, std::string>> kvs,
+    const StatusCallback &callback) {
+  auto table = GetOrCreateTable(table_name);
+  absl::MutexLock lock(&(table->mutex_));
+  for (auto &kv : kvs) {
+    table->records_[std::move(kv.first)] = std::move(kv.second);
+  }
+  if (callback != nullptr) {
+    main_io_service_.post([callback]() { callback(Status::OK()); },
+                          "GcsInMemoryStore.BatchPut");
+  }
+  return Status::OK();
+}
+
 Status InMemoryStoreClient::AsyncGet(const std::string &table_name,
                                      const std::string &key,
                                      const OptionalItemCallback<std::string> &callback) {
@@ -119,6 +135,19 @@ int InMemoryStoreClient::GetNextJobID() {
   return job_id_;
 }
 
+void InMemoryStoreClient::ForEachRecord(
+    const std::function<void(const std::string &table_name,
+                             const std::string &key,
+                             const std::string &data)> &fn) {
+  absl::MutexLock lock(&mutex_);
+  for (const auto &table : tables_) {
+    absl::MutexLock table_lock(&(table.second->mutex_));
+    for (const auto &record : table.second->records_) {
+      fn(table.first, record.first, record.second);
+    }
+  }
+}
+
 std::shared_ptr<InMemoryStoreClient::InMemoryTable> InMemoryStoreClient::GetOrCreateTable(
     const std::string &table_name) {
   absl::MutexLock lock(&mutex_);
@@ -37,6 +37,10 @@ class InMemoryStoreClient : public StoreClient {
                   const std::string &data,
                   const StatusCallback &callback) override;
 
+  Status AsyncBatchPut(const std::string &table_name,
+                       std::vector<std::pair<std::string, std::string>> kvs,
+                       const StatusCallback &callback) override;
+
   Status AsyncGet(const std::string &table_name,
                   const std::string &key,
                   const OptionalItemCallback<std::string> &callback) override;
@@ -58,6 +62,14 @@ class InMemoryStoreClient : public StoreClient {
 
   int GetNextJobID() override;
 
+ protected:
+  /// Call the function on every record of every table.
+  void ForEachRecord(const std::function<void(const std::string &table_name,
+                                              const std::string &key,
+                                              const std::string &data)> &fn);
+
+  int job_id_ = 0;
+
  private:
   struct InMemoryTable {
     /// Mutex to protect the records_ field and the index_keys_ field.
@@ -77,8 +89,6 @@ class InMemoryStoreClient : public StoreClient {
   /// Async API Callback needs to post to main_io_service_ to ensure the orderly execution
   /// of the callback.
   instrumented_io_context &main_io_service_;
-
-  int job_id_ = 0;
 };
 
 }  // namespace gcs
@@ -16,6 +16,7 @@
 
 #include <functional>
 
+#include "ray/common/asio/asio_util.h"
 #include "ray/common/ray_config.h"
 #include "ray/gcs/redis_context.h"
 #include "ray/util/logging.h"
@@ -25,19 +26,85 @@ namespace ray {
 namespace gcs {
 
 std::string RedisStoreClient::table_separator_ = ":";
-std::string RedisStoreClient::index_table_separator_ = "&";
+
+RedisStoreClient::~RedisStoreClient() {
+  // Don't drop the writes that are still buffered.
+  FlushWrites(redis_client_, write_buffer_);
+}
 
 Status RedisStoreClient::AsyncPut(const std::string &table_name,
                                   const std::string &key,
                                   const std::string &data,
                                   const StatusCallback &callback) {
+  if (IsWriteBehindEnabled()) {
+    BufferWrites({{GenRedisKey(table_name, key), data}}, callback);
+    return Status::OK();
+  }
   return DoPut(GenRedisKey(table_name, key), data, callback);
 }
 
+Status RedisStoreClient::AsyncBatchPut(
+    const std::string &table_name,
+    std::vector<std::pair<std::string, std::string>> kvs,
+    const StatusCallback &callback) {
+  if (kvs.empty()) {
+    if (callback) {
+      callback(Status::OK());
+    }
+    return Status::OK();
+  }
+  if (IsWriteBehindEnabled()) {
+    std::vector<std::pair<std::string, boost::optional<std::string>>> writes;
+    writes.reserve(kvs.size());
+    for (auto &kv : kvs) {
+      writes.emplace_back(GenRedisKey(table_name, kv.first), std::move(kv.second));
+    }
+    BufferWrites(std::move(writes), callback);
+    return Status::OK();
+  }
+
+  // One `MSET` command per shard and batch.
+  const size_t batch_size =
+      RayConfig::instance().maximum_gcs_storage_operation_batch_size();
+  absl::flat_hash_map<RedisContext *, std::vector<std::vector<std::string>>>
+      commands_by_shards;
+  int total_count = 0;
+  for (auto &kv : kvs) {
+    auto redis_key = GenRedisKey(table_name, kv.first);
+    auto &commands = commands_by_shards[redis_client_->GetShardContext(redis_key).get()];
+    if (commands.empty() || (commands.back().size() - 1) / 2 == batch_size) {
+      commands.push_back({"MSET"});
+      total_count++;
+    }
+    commands.back().push_back(std::move(redis_key));
+    commands.back().push_back(std::move(kv.second));
+  }
+
+  auto finished_count = std::make_shared<int>(0);
+  auto status = std::make_shared<Status>();
+  for (auto &command_list : commands_by_shards) {
+    for (auto &command : command_list.second) {
+      auto put_callback = [finished_count, total_count, status, callback](
+                              const std::shared_ptr<CallbackReply> &reply) {
+        auto reply_status = reply->ReadAsStatus();
+        if (status->ok()) {
+          *status = reply_status;
+        }
+        if (++(*finished_count) == total_count && callback) {
+          callback(*status);
+        }
+      };
+      RAY_CHECK_OK(command_list.first->RunArgvAsync(command, put_callback));
+    }
+  }
+  return Status::OK();
+}
+
 Status RedisStoreClient::AsyncGet(const std::string &table_name,
                                   const std::string &key,
                                   const OptionalItemCallback<std::string> &callback) {
   RAY_CHECK(callback != nullptr);
+  FlushWrites(redis_client_, write_buffer_);
 
   auto redis_callback = [callback](const std::shared_ptr<CallbackReply> &reply) {
     boost::optional<std::string> result;
@@ -61,6 +128,7 @@ Status RedisStoreClient::AsyncGetAll(
     const std::string &table_name,
     const MapCallback<std::string, std::string> &callback) {
   RAY_CHECK(callback);
+  FlushWrites(redis_client_, write_buffer_);
   std::string match_pattern = GenRedisMatchPattern(table_name);
   auto scanner = std::make_shared<RedisScanner>(redis_client_, table_name);
   auto on_done = [callback,
@@ -73,6 +141,10 @@ Status RedisStoreClient::AsyncGetAll(
 Status RedisStoreClient::AsyncDelete(const std::string &table_name,
                                      const std::string &key,
                                      const StatusCallback &callback) {
+  if (IsWriteBehindEnabled()) {
+    BufferWrites({{GenRedisKey(table_name, key), boost::none}}, callback);
+    return Status::OK();
+  }
   RedisCallback delete_callback = nullptr;
   if (callback) {
     delete_callback = [callback](const std::shared_ptr<CallbackReply> &reply) {
@@ -96,6 +168,15 @@ Status RedisStoreClient::AsyncBatchDelete(const std::string &table_name,
   for (auto &key : keys) {
     redis_keys.push_back(GenRedisKey(table_name, key));
   }
+  if (IsWriteBehindEnabled() && !redis_keys.empty()) {
+    std::vector<std::pair<std::string, boost::optional<std::string>>> writes;
+    writes.reserve(redis_keys.size());
+    for (auto &redis_key : redis_keys) {
+      writes.emplace_back(std::move(redis_key), boost::none);
+    }
+    BufferWrites(std::move(writes), callback);
+    return Status::OK();
+  }
   return DeleteByKeys(redis_keys, callback);
 }
 
@@ -106,7 +187,9 @@ Status RedisStoreClient::AsyncMultiGet(
   RAY_CHECK(callback);
   if (keys.empty()) {
     callback({});
+    return Status::OK();
   }
+  FlushWrites(redis_client_, write_buffer_);
   std::vector<std::string> true_keys;
   for (auto &key : keys) {
     true_keys.push_back(GenRedisKey(table_name, key));
@@ -115,6 +198,130 @@ Status RedisStoreClient::AsyncMultiGet(
   return Status::OK();
 }
 
+bool RedisStoreClient::IsWriteBehindEnabled() {
+  return RayConfig::instance().gcs_storage_write_batch_interval_ms() >= 0;
+}
+
+void RedisStoreClient::BufferWrites(
+    std::vector<std::pair<std::string, boost::optional<std::string>>> writes,
+    const StatusCallback &callback) {
+  bool flush_now = false;
+  bool schedule_flush = false;
+  {
+    absl::MutexLock lock(&write_buffer_->mutex);
+    for (auto &write : writes) {
+      // A later write of the same key replaces the earlier one.
+      write_buffer_->writes[std::move(write.first)] = std::move(write.second);
+    }
+    if (callback) {
+      write_buffer_->callbacks.push_back(callback);
+    }
+    if (write_buffer_->writes.size() >=
+        RayConfig::instance().maximum_gcs_storage_operation_batch_size()) {
+      flush_now = true;
+    } else if (!write_buffer_->flush_scheduled) {
+      write_buffer_->flush_scheduled = true;
+      schedule_flush = true;
+    }
+  }
+  if (flush_now) {
+    FlushWrites(redis_client_, write_buffer_);
+    return;
+  }
+  if (!schedule_flush) {
+    return;
+  }
+  auto flush = [redis_client = redis_client_, write_buffer = write_buffer_]() {
+    FlushWrites(redis_client, write_buffer);
+  };
+  auto &io_service = redis_client_->GetPrimaryContext()->io_service();
+  const auto interval_ms = RayConfig::instance().gcs_storage_write_batch_interval_ms();
+  if (interval_ms == 0) {
+    io_service.post(std::move(flush), "RedisStoreClient.FlushWrites");
+  } else {
+    execute_after(io_service, std::move(flush), interval_ms);
+  }
+}
+
+void RedisStoreClient::FlushWrites(const std::shared_ptr<RedisClient> &redis_client,
+                                   const std::shared_ptr<WriteBuffer> &write_buffer) {
+  absl::flat_hash_map<std::string, boost::optional<std::string>> writes;
+  std::vector<StatusCallback> callbacks;
+  {
+    absl::MutexLock lock(&write_buffer->mutex);
+    writes.swap(write_buffer->writes);
+    callbacks.swap(write_buffer->callbacks);
+    write_buffer->flush_scheduled = false;
+  }
+  if (writes.empty()) {
+    return;
+  }
+
+  // Each key is written once, so the commands of a flush don't need to be ordered.
+  const size_t batch_size =
+      RayConfig::instance().maximum_gcs_storage_operation_batch_size();
+  std::vector<std::pair<RedisContext *, std::vector<std::string>>> commands;
+  absl::flat_hash_map<RedisContext *, size_t> mset_commands;
+  absl::flat_hash_map<RedisContext *, size_t> unlink_commands;
+  auto get_command = [&commands, batch_size](
+                         absl::flat_hash_map<RedisContext *, size_t> &shard_commands,
+                         const std::string &command,
+                         size_t num_args_per_key,
+                         RedisContext *shard_context) -> std::vector<std::string> & {
+    auto it = shard_commands.find(shard_context);
+    // If the last batch is full, add a new batch.
+    if (it == shard_commands.end() ||
+        (commands[it->second].second.size() - 1) / num_args_per_key == batch_size) {
+      commands.emplace_back(shard_context, std::vector<std::string>{command});
+      shard_commands[shard_context] = commands.size() - 1;
+      return commands.back().second;
+    }
+    return commands[it->second].second;
+  };
+  for (auto &write : writes) {
+    auto shard_context = redis_client->GetShardContext(write.first).get();
+    if (write.second) {
+      auto &command = get_command(mset_commands, "MSET", 2, shard_context);
+      command.push_back(write.first);
+      command.push_back(std::move(*write.second));
+    } else {
+      // We always replace `DEL` with `UNLINK`.
+      auto &command = get_command(unlink_commands, "UNLINK", 1, shard_context);
+      command.push_back(write.first);
+    }
+  }
+
+  struct FlushState {
+    absl::Mutex mutex;
+    size_t num_pending_commands GUARDED_BY(mutex);
+    Status status GUARDED_BY(mutex);
+    std::vector<StatusCallback> callbacks;
+  };
+  auto state = std::make_shared<FlushState>();
+  state->num_pending_commands = commands.size();
+  state->callbacks = std::move(callbacks);
+  for (auto &command : commands) {
+    const bool is_put = command.second.front() == "MSET";
+    auto flush_callback = [state, is_put](const std::shared_ptr<CallbackReply> &reply) {
+      Status status;
+      {
+        absl::MutexLock lock(&state->mutex);
+        if (is_put && state->status.ok()) {
+          state->status = reply->ReadAsStatus();
+        }
+        if (--state->num_pending_commands > 0) {
+          return;
+        }
+        status = state->status;
+      }
+      for (const auto &callback : state->callbacks) {
+        callback(status);
+      }
+    };
+    RAY_CHECK_OK(command.first->RunArgvAsync(command.second, flush_callback));
+  }
+}
+
 Status RedisStoreClient::DoPut(const std::string &key,
                                const std::string &data,
                                const StatusCallback &callback) {
@@ -133,6 +340,12 @@ Status RedisStoreClient::DoPut(const std::string &key,
 
 Status RedisStoreClient::DeleteByKeys(const std::vector<std::string> &keys,
                                       const StatusCallback &callback) {
+  if (keys.empty()) {
+    if (callback) {
+      callback(Status::OK());
+    }
+    return Status::OK();
+  }
   // Delete for each shard.
   // We always replace `DEL` with `UNLINK`.
   int total_count = 0;
@@ -195,42 +408,18 @@ std::string RedisStoreClient::GenRedisKey(const std::string &table_name,
   return ss.str();
 }
 
-std::string RedisStoreClient::GenRedisKey(const std::string &table_name,
-                                          const std::string &key,
-                                          const std::string &index_key) {
-  std::stringstream ss;
-  ss << table_name << index_table_separator_ << index_key << index_table_separator_
-     << key;
-  return ss.str();
-}
-
 std::string RedisStoreClient::GenRedisMatchPattern(const std::string &table_name) {
   std::stringstream ss;
   ss << table_name << table_separator_ << "*";
   return ss.str();
 }
 
-std::string RedisStoreClient::GenRedisMatchPattern(const std::string &table_name,
-                                                   const std::string &index_key) {
-  std::stringstream ss;
-  ss << table_name << index_table_separator_ << index_key << index_table_separator_
-     << "*";
-  return ss.str();
-}
-
 std::string RedisStoreClient::GetKeyFromRedisKey(const std::string &redis_key,
                                                  const std::string &table_name) {
   auto pos = table_name.size() + table_separator_.size();
   return redis_key.substr(pos, redis_key.size() - pos);
 }
 
-std::string RedisStoreClient::GetKeyFromRedisKey(const std::string &redis_key,
-                                                 const std::string &table_name,
-                                                 const std::string &index_key) {
-  auto pos = table_name.size() + index_table_separator_.size() * 2 + index_key.size();
-  return redis_key.substr(pos, redis_key.size() - pos);
-}
-
 Status RedisStoreClient::MGetValues(
     std::shared_ptr<RedisClient> redis_client,
     const std::string &table_name,
@@ -282,15 +471,53 @@ RedisStoreClient::RedisScanner::RedisScanner(std::shared_ptr<RedisClient> redis_
 Status RedisStoreClient::RedisScanner::ScanKeysAndValues(
     const std::string &match_pattern,
     const MapCallback<std::string, std::string> &callback) {
-  auto on_done = [this, callback](const Status &status,
-                                  const std::vector<std::string> &result) {
-    if (result.empty()) {
-      callback(absl::flat_hash_map<std::string, std::string>());
-    } else {
-      RAY_CHECK_OK(MGetValues(redis_client_, table_name_, result, callback));
+  // The values of each page of keys are fetched as soon as the page is scanned, so
+  // that the fetches overlap with the rest of the scan.
+  auto on_keys = [this, callback](std::vector<std::string> &&keys) {
+    {
+      absl::MutexLock lock(&mutex_);
+      ++pending_fetch_count_;
     }
+    auto on_values =
+        [this, callback](absl::flat_hash_map<std::string, std::string> &&result) {
+          bool finished = false;
+          {
+            absl::MutexLock lock(&mutex_);
+            for (auto &item : result) {
+              key_value_map_[item.first] = std::move(item.second);
+            }
+            --pending_fetch_count_;
+            finished = scan_finished_ && pending_fetch_count_ == 0;
+          }
+          if (finished) {
+            FinishScanKeysAndValues(callback);
+          }
+        };
+    RAY_CHECK_OK(MGetValues(redis_client_, table_name_, keys, on_values));
   };
-  return ScanKeys(match_pattern, on_done);
+  auto on_done = [this, callback](const Status &status) {
+    bool finished = false;
+    {
+      absl::MutexLock lock(&mutex_);
+      scan_finished_ = true;
+      finished = pending_fetch_count_ == 0;
+    }
+    if (finished) {
+      FinishScanKeysAndValues(callback);
+    }
+  };
+  Scan(match_pattern, on_keys, on_done);
+  return Status::OK();
+}
+
+void RedisStoreClient::RedisScanner::FinishScanKeysAndValues(
+    const MapCallback<std::string, std::string> &callback) {
+  absl::flat_hash_map<std::string, std::string> result;
+  {
+    absl::MutexLock lock(&mutex_);
+    result.swap(key_value_map_);
+  }
+  callback(std::move(result));
 }
 
 Status RedisStoreClient::RedisScanner::ScanKeys(
@@ -300,20 +527,27 @@ Status RedisStoreClient::RedisScanner::ScanKeys(
     result.insert(result.begin(), keys_.begin(), keys_.end());
     callback(status, std::move(result));
   };
-  Scan(match_pattern, on_done);
+  Scan(match_pattern, nullptr, on_done);
   return Status::OK();
 }
 
 void RedisStoreClient::RedisScanner::Scan(const std::string &match_pattern,
+                                          const KeysCallback &on_keys,
                                           const StatusCallback &callback) {
   // This lock guards the iterator over shard_to_cursor_ because the callbacks
   // can remove items from the shard_to_cursor_ map. If performance is a concern,
   // we should consider using a reader-writer lock.
-  absl::MutexLock lock(&mutex_);
-  if (shard_to_cursor_.empty()) {
+  bool scan_finished = false;
+  {
+    absl::MutexLock lock(&mutex_);
+    scan_finished = shard_to_cursor_.empty();
+  }
+  if (scan_finished) {
+    // The callback may take the lock too.
     callback(Status::OK());
     return;
   }
+  absl::MutexLock lock(&mutex_);
 
   size_t batch_count = RayConfig::instance().maximum_gcs_storage_operation_batch_size();
   for (const auto &item : shard_to_cursor_) {
@@ -322,9 +556,9 @@ void RedisStoreClient::RedisScanner::Scan(const std::string &match_pattern,
     size_t shard_index = item.first;
     size_t cursor = item.second;
 
-    auto scan_callback = [this, match_pattern, shard_index, callback](
+    auto scan_callback = [this, match_pattern, shard_index, on_keys, callback](
                              const std::shared_ptr<CallbackReply> &reply) {
-      OnScanCallback(match_pattern, shard_index, reply, callback);
+      OnScanCallback(match_pattern, shard_index, reply, on_keys, callback);
     };
     // Scan by prefix from Redis.
     std::vector<std::string> args = {"SCAN",
@@ -345,10 +579,14 @@ void RedisStoreClient::RedisScanner::OnScanCallback(
     const std::string &match_pattern,
     size_t shard_index,
     const std::shared_ptr<CallbackReply> &reply,
+    const KeysCallback &on_keys,
     const StatusCallback &callback) {
   RAY_CHECK(reply);
   std::vector<std::string> scan_result;
   size_t cursor = reply->ReadAsScanArray(&scan_result);
+  // A key may be returned more than once by a scan, so only the keys that were not
+  // scanned before are new.
+  std::vector<std::string> new_keys;
   // Update shard cursors and keys_.
   {
     absl::MutexLock lock(&mutex_);
@@ -362,13 +600,20 @@ void RedisStoreClient::RedisScanner::OnScanCallback(
       shard_it->second = cursor;
     }
 
-    keys_.insert(scan_result.begin(), scan_result.end());
+    for (auto &key : scan_result) {
+      if (keys_.insert(key).second && on_keys) {
+        new_keys.push_back(std::move(key));
+      }
+    }
+  }
+  if (!new_keys.empty()) {
+    on_keys(std::move(new_keys));
   }
 
   // If pending_request_count_ is equal to 0, it means that the scan of this batch is
   // completed and the next batch is started if any.
   if (--pending_request_count_ == 0) {
-    Scan(match_pattern, callback);
+    Scan(match_pattern, on_keys, callback);
   }
 }
 
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "absl/container/flat_hash_set.h"
 #include "ray/gcs/redis_client.h"
 #include "ray/gcs/redis_context.h"
@@ -24,16 +26,27 @@ namespace ray {
 
 namespace gcs {
 
+/// \class RedisStoreClient
+/// Store client backed by Redis. If gcs_storage_write_batch_interval_ms is not
+/// negative, puts and deletes are buffered and written behind in batches. Reads flush
+/// the buffered writes first, so they always observe the writes issued before them.
 class RedisStoreClient : public StoreClient {
  public:
   explicit RedisStoreClient(std::shared_ptr<RedisClient> redis_client)
-      : redis_client_(std::move(redis_client)) {}
+      : redis_client_(std::move(redis_client)),
+        write_buffer_(std::make_shared<WriteBuffer>()) {}
+
+  ~RedisStoreClient() override;
 
   Status AsyncPut(const std::string &table_name,
                   const std::string &key,
                   const std::string &data,
                   const StatusCallback &callback) override;
 
+  Status AsyncBatchPut(const std::string &table_name,
+                       std::vector<std::pair<std::string, std::string>> kvs,
+                       const StatusCallback &callback) override;
+
   Status AsyncGet(const std::string &table_name,
                   const std::string &key,
                   const OptionalItemCallback<std::string> &callback) override;
@@ -73,13 +86,26 @@ class RedisStoreClient : public StoreClient {
                     const MultiItemCallback<std::string> &callback);
 
    private:
-    void Scan(const std::string &match_pattern, const StatusCallback &callback);
+    /// Called with each page of keys that is scanned.
+    using KeysCallback = std::function<void(std::vector<std::string> &&keys)>;
+
+    /// Scan the keys, in rounds of one page per shard.
+    ///
+    /// \param on_keys Called with the new keys of each page, if not null.
+    /// \param callback Called once all of the shards are scanned.
+    void Scan(const std::string &match_pattern,
+              const KeysCallback &on_keys,
+              const StatusCallback &callback);
 
     void OnScanCallback(const std::string &match_pattern,
                         size_t shard_index,
                         const std::shared_ptr<CallbackReply> &reply,
+                        const KeysCallback &on_keys,
                         const StatusCallback &callback);
 
+    /// Call the callback of ScanKeysAndValues with the fetched values.
+    void FinishScanKeysAndValues(const MapCallback<std::string, std::string> &callback);
+
     std::string table_name_;
 
     /// Mutex to protect the shard_to_cursor_ field and the keys_ field and the
@@ -92,12 +118,49 @@ class RedisStoreClient : public StoreClient {
     /// The scan cursor for each shard.
     absl::flat_hash_map<size_t, size_t> shard_to_cursor_;
 
+    /// The values fetched by ScanKeysAndValues so far.
+    absl::flat_hash_map<std::string, std::string> key_value_map_ GUARDED_BY(mutex_);
+
+    /// The number of pages of keys whose values are being fetched.
+    size_t pending_fetch_count_ GUARDED_BY(mutex_) = 0;
+
+    /// Whether all of the keys are scanned.
+    bool scan_finished_ GUARDED_BY(mutex_) = false;
+
     /// The pending shard scan count.
     std::atomic<size_t> pending_request_count_{0};
 
     std::shared_ptr<RedisClient> redis_client_;
   };
 
+  /// The writes that are waiting to be flushed to Redis.
+  struct WriteBuffer {
+    absl::Mutex mutex;
+    /// The latest value of each written Redis key, or none if it was deleted.
+    absl::flat_hash_map<std::string, boost::optional<std::string>> writes
+        GUARDED_BY(mutex);
+    /// The callbacks of the buffered writes.
+    std::vector<StatusCallback> callbacks GUARDED_BY(mutex);
+    /// Whether a flush of the buffer is scheduled.
+    bool flush_scheduled GUARDED_BY(mutex) = false;
+  };
+
+  /// Whether writes are buffered and written behind.
+  static bool IsWriteBehindEnabled();
+
+  /// Buffer writes, and schedule a flush of the buffer.
+  ///
+  /// \param writes The Redis keys to write, with their values, or none to delete them.
+  /// \param callback Called once all of the writes are flushed.
+  void BufferWrites(
+      std::vector<std::pair<std::string, boost::optional<std::string>>> writes,
+      const StatusCallback &callback);
+
+  /// Write the buffered writes to Redis, with one MSET and one UNLINK command per
+  /// shard and batch, and call their callbacks once all of them are written.
+  static void FlushWrites(const std::shared_ptr<RedisClient> &redis_client,
+                          const std::shared_ptr<WriteBuffer> &write_buffer);
+
   Status DoPut(const std::string &key,
                const std::string &data,
                const StatusCallback &callback);
@@ -115,32 +178,23 @@ class RedisStoreClient : public StoreClient {
 
   /// The separator is used when building redis key.
   static std::string table_separator_;
-  static std::string index_table_separator_;
 
   static std::string GenRedisKey(const std::string &table_name, const std::string &key);
 
-  static std::string GenRedisKey(const std::string &table_name,
-                                 const std::string &key,
-                                 const std::string &index_key);
-
   static std::string GenRedisMatchPattern(const std::string &table_name);
 
-  static std::string GenRedisMatchPattern(const std::string &table_name,
-                                          const std::string &index_key);
-
   static std::string GetKeyFromRedisKey(const std::string &redis_key,
                                         const std::string &table_name);
 
-  static std::string GetKeyFromRedisKey(const std::string &redis_key,
-                                        const std::string &table_name,
-                                        const std::string &index_key);
-
   static Status MGetValues(std::shared_ptr<RedisClient> redis_client,
                            const std::string &table_name,
                            const std::vector<std::string> &keys,
                            const MapCallback<std::string, std::string> &callback);
 
   std::shared_ptr<RedisClient> redis_client_;
+
+  /// Shared with the scheduled flushes, which may outlive this client.
+  std::shared_ptr<WriteBuffer> write_buffer_;
 };
 
 }  // namespace gcs
@@ -16,6 +16,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ray/common/asio/io_service_pool.h"
 #include "ray/common/id.h"
@@ -46,6 +48,17 @@ class StoreClient {
                           const std::string &data,
                           const StatusCallback &callback) = 0;
 
+  /// Write a batch of data to the given table asynchronously, with as few writes to
+  /// the storage as possible.
+  ///
+  /// \param table_name The name of the table to be written.
+  /// \param kvs The keys that will be written to the table, with their values.
+  /// \param callback Callback that will be called after all of them are written.
+  /// \return Status
+  virtual Status AsyncBatchPut(const std::string &table_name,
+                               std::vector<std::pair<std::string, std::string>> kvs,
+                               const StatusCallback &callback) = 0;
+
   /// Get data from the given table asynchronously.
   ///
   /// \param table_name The name of the table to be read.
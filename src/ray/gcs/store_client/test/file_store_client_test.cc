@@ -0,0 +1,117 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/store_client/file_store_client.h"
+
+#include <filesystem>
+
+#include "ray/gcs/store_client/test/store_client_test_base.h"
+#include "ray/util/filesystem.h"
+
+namespace ray {
+
+namespace gcs {
+
+class FileStoreClientTest : public StoreClientTestBase {
+ public:
+  FileStoreClientTest()
+      : directory_(JoinPaths(GetUserTempDir(),
+                             "file_store_client_test_" + UniqueID::FromRandom().Hex())) {}
+
+  ~FileStoreClientTest() { std::filesystem::remove_all(directory_); }
+
+  void InitStoreClient() override {
+    store_client_ =
+        std::make_shared<FileStoreClient>(*(io_service_pool_->Get()), directory_);
+  }
+
+  void DisconnectStoreClient() override { store_client_.reset(); }
+
+  /// Destroy the client, and load the tables into a new one.
+  void RestartStoreClient() {
+    store_client_.reset();
+    InitStoreClient();
+  }
+
+ protected:
+  const std::string directory_;
+};
+
+TEST_F(FileStoreClientTest, AsyncPutAndAsyncGetTest) { TestAsyncPutAndAsyncGet(); }
+
+TEST_F(FileStoreClientTest, AsyncGetAllAndBatchDeleteTest) {
+  TestAsyncGetAllAndBatchDelete();
+}
+
+TEST_F(FileStoreClientTest, AsyncBatchPutAndBatchDeleteTest) {
+  TestAsyncBatchPutAndBatchDelete();
+}
+
+TEST_F(FileStoreClientTest, RecoverTest) {
+  Put();
+  ASSERT_EQ(store_client_->GetNextJobID(), 1);
+  ASSERT_EQ(store_client_->GetNextJobID(), 2);
+
+  RestartStoreClient();
+  Get();
+  GetAll();
+  ASSERT_EQ(store_client_->GetNextJobID(), 3);
+
+  Delete();
+  RestartStoreClient();
+  GetEmpty();
+  ASSERT_EQ(store_client_->GetNextJobID(), 4);
+}
+
+class FileStoreClientCompactionTest : public FileStoreClientTest {
+ public:
+  void SetUp() override {
+    RayConfig::instance().initialize(R"({"gcs_storage_file_compaction_bytes": 4096})");
+    FileStoreClientTest::SetUp();
+  }
+
+  void TearDown() override {
+    FileStoreClientTest::TearDown();
+    RayConfig::instance().initialize("");
+  }
+};
+
+TEST_F(FileStoreClientCompactionTest, RecoverTest) {
+  Put();
+  ASSERT_EQ(store_client_->GetNextJobID(), 1);
+  // Overwrite the keys, so that the log is compacted again.
+  Put();
+
+  RestartStoreClient();
+  Get();
+  GetAll();
+  ASSERT_EQ(store_client_->GetNextJobID(), 2);
+  // Only the snapshot and the log of the latest generation are kept.
+  ASSERT_EQ(std::distance(std::filesystem::directory_iterator(directory_),
+                          std::filesystem::directory_iterator()),
+            2);
+
+  BatchDelete();
+  RestartStoreClient();
+  GetEmpty();
+}
+
+}  // namespace gcs
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
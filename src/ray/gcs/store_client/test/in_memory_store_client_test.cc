@@ -35,6 +35,10 @@ TEST_F(InMemoryStoreClientTest, AsyncGetAllAndBatchDeleteTest) {
   TestAsyncGetAllAndBatchDelete();
 }
 
+TEST_F(InMemoryStoreClientTest, AsyncBatchPutAndBatchDeleteTest) {
+  TestAsyncBatchPutAndBatchDelete();
+}
+
 }  // namespace gcs
 
 }  // namespace ray
@@ -36,7 +36,8 @@ class RedisStoreClientTest : public StoreClientTestBase {
     RedisClientOptions options("127.0.0.1",
                                TEST_REDIS_SERVER_PORTS.front(),
                                "",
-                               /*enable_sharding_conn=*/false);
+                               /*enable_sharding_conn=*/false,
+                               connections_per_shard_);
     redis_client_ = std::make_shared<RedisClient>(options);
     RAY_CHECK_OK(redis_client_->Connect(io_service_pool_->GetAll()));
 
@@ -47,6 +48,7 @@ class RedisStoreClientTest : public StoreClientTestBase {
 
  protected:
   std::shared_ptr<RedisClient> redis_client_;
+  size_t connections_per_shard_ = 1;
 };
 
 TEST_F(RedisStoreClientTest, AsyncPutAndAsyncGetTest) { TestAsyncPutAndAsyncGet(); }
@@ -55,6 +57,54 @@ TEST_F(RedisStoreClientTest, AsyncGetAllAndBatchDeleteTest) {
   TestAsyncGetAllAndBatchDelete();
 }
 
+TEST_F(RedisStoreClientTest, AsyncBatchPutAndBatchDeleteTest) {
+  TestAsyncBatchPutAndBatchDelete();
+}
+
+class RedisStoreClientWriteBehindTest : public RedisStoreClientTest {
+ public:
+  void SetUp() override {
+    RayConfig::instance().initialize(
+        R"({"gcs_storage_write_batch_interval_ms": 10,
+            "maximum_gcs_storage_operation_batch_size": 7})");
+    RedisStoreClientTest::SetUp();
+  }
+
+  void TearDown() override {
+    RedisStoreClientTest::TearDown();
+    RayConfig::instance().initialize("");
+  }
+};
+
+TEST_F(RedisStoreClientWriteBehindTest, AsyncPutAndAsyncGetTest) {
+  TestAsyncPutAndAsyncGet();
+}
+
+TEST_F(RedisStoreClientWriteBehindTest, AsyncGetAllAndBatchDeleteTest) {
+  TestAsyncGetAllAndBatchDelete();
+}
+
+TEST_F(RedisStoreClientWriteBehindTest, AsyncBatchPutAndBatchDeleteTest) {
+  TestAsyncBatchPutAndBatchDelete();
+}
+
+class RedisStoreClientConnectionPoolTest : public RedisStoreClientTest {
+ public:
+  RedisStoreClientConnectionPoolTest() { connections_per_shard_ = 4; }
+};
+
+TEST_F(RedisStoreClientConnectionPoolTest, AsyncPutAndAsyncGetTest) {
+  TestAsyncPutAndAsyncGet();
+}
+
+TEST_F(RedisStoreClientConnectionPoolTest, AsyncGetAllAndBatchDeleteTest) {
+  TestAsyncGetAllAndBatchDelete();
+}
+
+TEST_F(RedisStoreClientConnectionPoolTest, AsyncBatchPutAndBatchDeleteTest) {
+  TestAsyncBatchPutAndBatchDelete();
+}
+
 }  // namespace gcs
 
 }  // namespace ray
@@ -74,6 +74,22 @@ class StoreClientTestBase : public ::testing::Test {
     WaitPendingDone();
   }
 
+  void BatchPut() {
+    auto put_calllback = [this](const Status &status) {
+      RAY_CHECK_OK(status);
+      --pending_count_;
+    };
+    std::vector<std::pair<std::string, std::string>> kvs;
+    for (const auto &[key, value] : key_to_value_) {
+      kvs.emplace_back(key.Binary(), value.SerializeAsString());
+    }
+    ++pending_count_;
+    RAY_CHECK_OK(store_client_->AsyncBatchPut(table_name_, kvs, put_calllback));
+    // Make sure no-op callback is handled well
+    RAY_CHECK_OK(store_client_->AsyncBatchPut(table_name_, kvs, nullptr));
+    WaitPendingDone();
+  }
+
   void Delete() {
     auto delete_calllback = [this](const Status &status) {
       RAY_CHECK_OK(status);
@@ -189,6 +205,20 @@ class StoreClientTestBase : public ::testing::Test {
     GetEmpty();
   }
 
+  void TestAsyncBatchPutAndBatchDelete() {
+    // AsyncBatchPut
+    BatchPut();
+
+    // AsyncGet
+    Get();
+
+    // AsyncBatchDelete
+    BatchDelete();
+
+    // AsyncGet
+    GetEmpty();
+  }
+
   void GenTestData() {
     for (size_t i = 0; i < key_count_; i++) {
       rpc::ActorTableData actor;
@@ -0,0 +1,248 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/bulk_chunk_tls.h"
+
+#ifdef __linux__
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <openssl/err.h>
+#include <openssl/mem.h>
+#include <openssl/nid.h>
+#include <openssl/ssl.h>
+
+#include <array>
+#include <boost/endian/conversion.hpp>
+#include <cerrno>
+#include <cstring>
+
+#include "ray/common/ray_config.h"
+#include "ray/util/logging.h"
+
+#ifdef __linux__
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
+namespace ray {
+
+namespace {
+
+using boost::asio::ip::tcp;
+
+std::string LastSslError() {
+  char buffer[256];
+  ERR_error_string_n(ERR_get_error(), buffer, sizeof(buffer));
+  return buffer;
+}
+
+#ifdef __linux__
+
+/// Whether the kernel has the TLS upper layer protocol. Setting it on a socket that
+/// isn't connected fails with ENOTCONN if the kernel has it, and ENOENT otherwise.
+bool KernelTlsAvailable() {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return false;
+  }
+  const bool available = setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 ||
+                         errno != ENOENT;
+  close(fd);
+  return available;
+}
+
+/// Install the keys of the finished handshake in the kernel, for the direction that
+/// this side of the connection uses.
+///
+/// \return An empty string, or the reason it failed.
+std::string InstallKernelTls(int fd, SSL *ssl, bool is_sender) {
+  const SSL_CIPHER *cipher = SSL_get_current_cipher(ssl);
+  if (SSL_version(ssl) != TLS1_2_VERSION || cipher == nullptr ||
+      SSL_CIPHER_get_cipher_nid(cipher) != NID_aes_128_gcm) {
+    return "unexpected TLS version or cipher";
+  }
+  // The key block of an AEAD cipher holds the client and server keys, followed by the
+  // client and server salts. Only the client sends, so both sides use its keys.
+  constexpr size_t kKeySize = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+  constexpr size_t kSaltSize = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+  std::array<uint8_t, 2 * (kKeySize + kSaltSize)> key_block;
+  if (SSL_get_key_block_len(ssl) != key_block.size() ||
+      !SSL_generate_key_block(ssl, key_block.data(), key_block.size())) {
+    return "failed to export the TLS keys";
+  }
+  tls12_crypto_info_aes_gcm_128 crypto_info;
+  std::memset(&crypto_info, 0, sizeof(crypto_info));
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+  std::memcpy(crypto_info.key, key_block.data(), kKeySize);
+  std::memcpy(crypto_info.salt, key_block.data() + 2 * kKeySize, kSaltSize);
+  // The explicit nonce of a record is its sequence number, like BoringSSL sends it.
+  const uint64_t sequence = boost::endian::native_to_big(
+      is_sender ? SSL_get_write_sequence(ssl) : SSL_get_read_sequence(ssl));
+  std::memcpy(crypto_info.rec_seq, &sequence, sizeof(sequence));
+  std::memcpy(crypto_info.iv, &sequence, sizeof(sequence));
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+
+  std::string error;
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      setsockopt(fd,
+                 SOL_TLS,
+                 is_sender ? TLS_TX : TLS_RX,
+                 &crypto_info,
+                 sizeof(crypto_info)) != 0) {
+    error = std::string("failed to enable kernel TLS: ") + std::strerror(errno);
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return error;
+}
+
+#endif
+
+/// The state of a handshake, which drives SSL_do_handshake on the non-blocking socket
+/// whenever it can make progress.
+class TlsHandshake : public std::enable_shared_from_this<TlsHandshake> {
+ public:
+  TlsHandshake(SSL *ssl,
+               tcp::socket &socket,
+               bool is_sender,
+               std::function<void(const std::string &error)> callback)
+      : ssl_(ssl),
+        socket_(socket),
+        is_sender_(is_sender),
+        callback_(std::move(callback)) {}
+
+  ~TlsHandshake() { SSL_free(ssl_); }
+
+  void Continue() {
+    const int result = SSL_do_handshake(ssl_);
+    if (result == 1) {
+      Finish();
+      return;
+    }
+    const int error = SSL_get_error(ssl_, result);
+    if (error != SSL_ERROR_WANT_READ && error != SSL_ERROR_WANT_WRITE) {
+      Done("TLS handshake failed: " + LastSslError());
+      return;
+    }
+    socket_.async_wait(
+        error == SSL_ERROR_WANT_READ ? tcp::socket::wait_read : tcp::socket::wait_write,
+        [self = shared_from_this()](const boost::system::error_code &error) {
+          if (error) {
+            self->Done("TLS handshake failed: " + error.message());
+          } else {
+            self->Continue();
+          }
+        });
+  }
+
+ private:
+  void Finish() {
+    boost::system::error_code ignored_error;
+    socket_.non_blocking(false, ignored_error);
+#ifdef __linux__
+    // Records read ahead of the end of the handshake would be lost to the kernel.
+    if (SSL_pending(ssl_) > 0) {
+      Done("unexpected data after the TLS handshake");
+      return;
+    }
+    Done(InstallKernelTls(socket_.native_handle(), ssl_, is_sender_));
+#else
+    Done("kernel TLS is not supported on this platform");
+#endif
+  }
+
+  void Done(const std::string &error) {
+    ERR_clear_error();
+    callback_(error);
+  }
+
+  SSL *const ssl_;
+  tcp::socket &socket_;
+  const bool is_sender_;
+  const std::function<void(const std::string &error)> callback_;
+};
+
+}  // namespace
+
+std::shared_ptr<BulkChunkTls> BulkChunkTls::Create() {
+#ifdef __linux__
+  if (!KernelTlsAvailable()) {
+    RAY_LOG(WARNING) << "The kernel doesn't support TLS, so object chunks can't be "
+                     << "sent on the bulk data plane with TLS enabled.";
+    return nullptr;
+  }
+  SSL_CTX *ctx = SSL_CTX_new(TLS_method());
+  const bool ok =
+      ctx != nullptr && SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION) &&
+      SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION) &&
+      SSL_CTX_set_strict_cipher_list(
+          ctx, "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256") &&
+      SSL_CTX_use_certificate_chain_file(
+          ctx, RayConfig::instance().TLS_SERVER_CERT().c_str()) == 1 &&
+      SSL_CTX_use_PrivateKey_file(
+          ctx, RayConfig::instance().TLS_SERVER_KEY().c_str(), SSL_FILETYPE_PEM) == 1 &&
+      SSL_CTX_load_verify_locations(
+          ctx, RayConfig::instance().TLS_CA_CERT().c_str(), nullptr) == 1;
+  if (!ok) {
+    RAY_LOG(WARNING) << "Failed to load the TLS credentials of the bulk data plane: "
+                     << LastSslError();
+    SSL_CTX_free(ctx);
+    ERR_clear_error();
+    return nullptr;
+  }
+  SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, nullptr);
+  // Session tickets are sent after the handshake, in records that the kernel would
+  // have to skip.
+  SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+  return std::shared_ptr<BulkChunkTls>(new BulkChunkTls(ctx));
+#else
+  RAY_LOG(WARNING) << "Kernel TLS is only supported on Linux, so object chunks can't "
+                   << "be sent on the bulk data plane with TLS enabled.";
+  return nullptr;
+#endif
+}
+
+BulkChunkTls::~BulkChunkTls() { SSL_CTX_free(ctx_); }
+
+void BulkChunkTls::Handshake(tcp::socket &socket,
+                             bool is_sender,
+                             std::function<void(const std::string &error)> callback) {
+  SSL *ssl = SSL_new(ctx_);
+  if (ssl == nullptr || !SSL_set_fd(ssl, socket.native_handle())) {
+    SSL_free(ssl);
+    callback("failed to create the TLS session: " + LastSslError());
+    ERR_clear_error();
+    return;
+  }
+  if (is_sender) {
+    SSL_set_connect_state(ssl);
+  } else {
+    SSL_set_accept_state(ssl);
+  }
+  boost::system::error_code ignored_error;
+  socket.non_blocking(true, ignored_error);
+  std::make_shared<TlsHandshake>(ssl, socket, is_sender, std::move(callback))
+      ->Continue();
+}
+
+}  // namespace ray
@@ -0,0 +1,66 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+struct ssl_ctx_st;
+
+namespace ray {
+
+/// \class BulkChunkTls
+/// Encrypts the TCP connections of the bulk data plane when USE_TLS is set, with
+/// kernel TLS (kTLS). Every connection runs a TLS 1.2 handshake in user space with the
+/// credentials of TLS_SERVER_CERT, TLS_SERVER_KEY and TLS_CA_CERT, mutually verified
+/// like the gRPC connections. The record layer is then handed to the kernel, which
+/// encrypts and decrypts the chunks as they are written and read, or offloads that to
+/// the NIC if it supports it. The connections are written and read as plain TCP
+/// sockets afterwards, so the chunks are still sent straight from the object store
+/// and read straight into it.
+///
+/// Only AES-128-GCM is negotiated, which every kernel with kTLS supports.
+class BulkChunkTls {
+ public:
+  /// Create the TLS context of the bulk data plane.
+  ///
+  /// \return The context, or nullptr if the kernel doesn't support TLS or the
+  /// credentials can't be loaded.
+  static std::shared_ptr<BulkChunkTls> Create();
+
+  ~BulkChunkTls();
+
+  /// Run the TLS handshake on a connected socket, and then install its keys in the
+  /// kernel. The socket must not be used until the callback is called.
+  ///
+  /// \param socket The socket, which must outlive the handshake.
+  /// \param is_sender Whether this is the side that connected and writes the chunks.
+  /// The other side accepted the connection and only reads.
+  /// \param callback Called on the event loop of the socket with an empty string once
+  /// the socket is encrypted by the kernel, or with the reason it failed. It may be
+  /// called before this method returns.
+  void Handshake(boost::asio::ip::tcp::socket &socket,
+                 bool is_sender,
+                 std::function<void(const std::string &error)> callback);
+
+ private:
+  explicit BulkChunkTls(ssl_ctx_st *ctx) : ctx_(ctx) {}
+
+  ssl_ctx_st *const ctx_;
+};
+
+}  // namespace ray
@@ -0,0 +1,485 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/bulk_chunk_transport.h"
+
+#include <array>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <deque>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/ray_config.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace {
+
+using boost::asio::ip::tcp;
+
+/// Every chunk on a stream is framed as the little endian sizes of the serialized push
+/// request and of the chunk data, followed by the request and the data.
+constexpr size_t kFrameSizesLength = sizeof(uint32_t) + sizeof(uint64_t);
+
+/// Push requests without data are small, anything larger is a corrupted stream.
+constexpr uint32_t kMaxRequestSize = 64 * 1024;
+
+/// A chunk waiting to be written to a stream.
+struct PendingChunk {
+  std::array<uint8_t, kFrameSizesLength> frame_sizes;
+  std::string request;
+  std::vector<absl::string_view> chunk;
+  std::shared_ptr<const void> chunk_owner;
+  std::function<void(const Status &)> on_complete;
+};
+
+/// A TCP connection to a remote receiver, that writes one chunk at a time.
+class TcpChunkStream : public std::enable_shared_from_this<TcpChunkStream> {
+ public:
+  TcpChunkStream(instrumented_io_context &io_service,
+                 tcp::endpoint endpoint,
+                 std::shared_ptr<BulkChunkTls> tls)
+      : socket_(io_service), endpoint_(std::move(endpoint)), tls_(std::move(tls)) {}
+
+  /// Queue a chunk, and connect to the receiver if this is the first one.
+  void Send(PendingChunk chunk) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!failed_) {
+        queue_.push_back(std::move(chunk));
+        if (!connected_ && !connecting_) {
+          connecting_ = true;
+          socket_.async_connect(endpoint_,
+                                [self = shared_from_this()](
+                                    const boost::system::error_code &error) {
+                                  self->OnConnected(error);
+                                });
+        } else if (connected_ && !writing_) {
+          WriteNext();
+        }
+        return;
+      }
+    }
+    chunk.on_complete(Status::IOError("The bulk stream is broken"));
+  }
+
+  /// Whether the stream failed, in which case it must be replaced.
+  bool Failed() const {
+    absl::MutexLock lock(&mutex_);
+    return failed_;
+  }
+
+ private:
+  void OnConnected(const boost::system::error_code &error) {
+    absl::ReleasableMutexLock lock(&mutex_);
+    connecting_ = false;
+    if (error) {
+      Fail(&lock, "Failed to connect the bulk stream: " + error.message());
+      return;
+    }
+    boost::system::error_code ignored_error;
+    socket_.set_option(tcp::no_delay(true), ignored_error);
+    if (tls_ != nullptr) {
+      // The stream stays connecting until the handshake is done, so the chunks sent
+      // meanwhile are only queued.
+      connecting_ = true;
+      lock.Release();
+      tls_->Handshake(
+          socket_,
+          /*is_sender=*/true,
+          [self = shared_from_this()](const std::string &error) {
+            self->OnSecured(error);
+          });
+      return;
+    }
+    connected_ = true;
+    WriteNext();
+  }
+
+  void OnSecured(const std::string &error) {
+    absl::ReleasableMutexLock lock(&mutex_);
+    connecting_ = false;
+    if (!error.empty()) {
+      Fail(&lock, "Failed to secure the bulk stream: " + error);
+      return;
+    }
+    connected_ = true;
+    WriteNext();
+  }
+
+  void WriteNext() EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (queue_.empty()) {
+      writing_ = false;
+      return;
+    }
+    writing_ = true;
+    const auto &chunk = queue_.front();
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(chunk.chunk.size() + 2);
+    buffers.emplace_back(chunk.frame_sizes.data(), chunk.frame_sizes.size());
+    buffers.emplace_back(chunk.request.data(), chunk.request.size());
+    for (const auto &part : chunk.chunk) {
+      buffers.emplace_back(part.data(), part.size());
+    }
+    boost::asio::async_write(
+        socket_,
+        buffers,
+        [self = shared_from_this()](const boost::system::error_code &error, size_t) {
+          self->OnWritten(error);
+        });
+  }
+
+  void OnWritten(const boost::system::error_code &error) {
+    absl::ReleasableMutexLock lock(&mutex_);
+    if (error) {
+      Fail(&lock, "Failed to write to the bulk stream: " + error.message());
+      return;
+    }
+    auto on_complete = std::move(queue_.front().on_complete);
+    queue_.pop_front();
+    WriteNext();
+    lock.Release();
+    on_complete(Status::OK());
+  }
+
+  /// Fail all queued chunks, releasing the lock before calling their callbacks.
+  void Fail(absl::ReleasableMutexLock *lock, const std::string &message)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    RAY_LOG(WARNING) << message << ", remote: " << endpoint_;
+    failed_ = true;
+    writing_ = false;
+    boost::system::error_code ignored_error;
+    socket_.close(ignored_error);
+    std::vector<std::function<void(const Status &)>> callbacks;
+    for (auto &chunk : queue_) {
+      callbacks.push_back(std::move(chunk.on_complete));
+    }
+    queue_.clear();
+    lock->Release();
+    for (const auto &callback : callbacks) {
+      callback(Status::IOError(message));
+    }
+  }
+
+  tcp::socket socket_;
+  const tcp::endpoint endpoint_;
+  const std::shared_ptr<BulkChunkTls> tls_;
+  mutable absl::Mutex mutex_;
+  std::deque<PendingChunk> queue_ GUARDED_BY(mutex_);
+  bool connecting_ GUARDED_BY(mutex_) = false;
+  bool connected_ GUARDED_BY(mutex_) = false;
+  bool writing_ GUARDED_BY(mutex_) = false;
+  bool failed_ GUARDED_BY(mutex_) = false;
+};
+
+class TcpChunkSender : public BulkChunkSender {
+ public:
+  TcpChunkSender(instrumented_io_context &io_service,
+                 int num_streams,
+                 std::shared_ptr<BulkChunkTls> tls)
+      : io_service_(io_service), num_streams_(num_streams), tls_(std::move(tls)) {
+    RAY_CHECK(num_streams_ > 0);
+  }
+
+  void SendChunk(const RemoteConnectionInfo &remote,
+                 const rpc::PushRequest &request,
+                 std::vector<absl::string_view> chunk,
+                 std::shared_ptr<const void> chunk_owner,
+                 std::function<void(const Status &)> on_complete) override {
+    PendingChunk pending_chunk;
+    RAY_CHECK(request.SerializeToString(&pending_chunk.request));
+    uint64_t chunk_size = 0;
+    for (const auto &part : chunk) {
+      chunk_size += part.size();
+    }
+    const uint32_t request_size = boost::endian::native_to_little(
+        static_cast<uint32_t>(pending_chunk.request.size()));
+    chunk_size = boost::endian::native_to_little(chunk_size);
+    std::memcpy(pending_chunk.frame_sizes.data(), &request_size, sizeof(request_size));
+    std::memcpy(pending_chunk.frame_sizes.data() + sizeof(request_size),
+                &chunk_size,
+                sizeof(chunk_size));
+    pending_chunk.chunk = std::move(chunk);
+    pending_chunk.chunk_owner = std::move(chunk_owner);
+    pending_chunk.on_complete = std::move(on_complete);
+    auto stream = GetStream(remote);
+    if (stream == nullptr) {
+      pending_chunk.on_complete(
+          Status::Invalid("Invalid address of the bulk receiver: " + remote.ip));
+      return;
+    }
+    stream->Send(std::move(pending_chunk));
+  }
+
+ private:
+  /// Pick the next stream to the remote node, replacing it if it failed.
+  ///
+  /// \return The stream, or nullptr if the address of the node is invalid.
+  std::shared_ptr<TcpChunkStream> GetStream(const RemoteConnectionInfo &remote) {
+    boost::system::error_code error;
+    const auto address = boost::asio::ip::make_address(remote.ip, error);
+    if (error) {
+      return nullptr;
+    }
+    absl::MutexLock lock(&mutex_);
+    auto &streams = streams_[remote.node_id];
+    if (streams.streams.empty()) {
+      streams.streams.resize(num_streams_);
+    }
+    auto &stream = streams.streams[streams.next_stream++ % streams.streams.size()];
+    if (stream == nullptr || stream->Failed()) {
+      stream = std::make_shared<TcpChunkStream>(
+          io_service_, tcp::endpoint(address, remote.bulk_port), tls_);
+    }
+    return stream;
+  }
+
+  struct NodeStreams {
+    std::vector<std::shared_ptr<TcpChunkStream>> streams;
+    size_t next_stream = 0;
+  };
+
+  instrumented_io_context &io_service_;
+  const int num_streams_;
+  const std::shared_ptr<BulkChunkTls> tls_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<NodeID, NodeStreams> streams_ GUARDED_BY(mutex_);
+};
+
+/// A TCP connection from a remote sender, that reads one chunk at a time.
+class TcpChunkConnection : public std::enable_shared_from_this<TcpChunkConnection> {
+ public:
+  TcpChunkConnection(tcp::socket socket,
+                     BulkChunkReceiver::ChunkHandler handler,
+                     BulkChunkReceiver::BufferProvider buffer_provider)
+      : socket_(std::move(socket)),
+        handler_(std::move(handler)),
+        buffer_provider_(std::move(buffer_provider)) {}
+
+  /// Run the TLS handshake, and then read the chunks.
+  void Secure(BulkChunkTls &tls) {
+    tls.Handshake(socket_,
+                  /*is_sender=*/false,
+                  [self = shared_from_this()](const std::string &error) {
+                    if (!error.empty()) {
+                      RAY_LOG(WARNING) << "Failed to secure a bulk stream: " << error;
+                      return;
+                    }
+                    self->ReadFrameSizes();
+                  });
+  }
+
+  void ReadFrameSizes() {
+    boost::asio::async_read(
+        socket_,
+        boost::asio::buffer(frame_sizes_),
+        [self = shared_from_this()](const boost::system::error_code &error, size_t) {
+          if (!error) {
+            self->ReadChunk();
+          }
+        });
+  }
+
+ private:
+  void ReadChunk() {
+    uint32_t request_size;
+    uint64_t chunk_size;
+    std::memcpy(&request_size, frame_sizes_.data(), sizeof(request_size));
+    std::memcpy(
+        &chunk_size, frame_sizes_.data() + sizeof(request_size), sizeof(chunk_size));
+    request_size = boost::endian::little_to_native(request_size);
+    chunk_size = boost::endian::little_to_native(chunk_size);
+    if (request_size > kMaxRequestSize ||
+        chunk_size >
+            static_cast<uint64_t>(RayConfig::instance().max_grpc_message_size())) {
+      RAY_LOG(WARNING) << "Closing a corrupted bulk stream.";
+      return;
+    }
+    request_.resize(request_size);
+    data_.resize(chunk_size);
+    if (buffer_provider_ == nullptr) {
+      std::array<boost::asio::mutable_buffer, 2> buffers{
+          boost::asio::buffer(&request_[0], request_.size()),
+          boost::asio::buffer(&data_[0], data_.size())};
+      boost::asio::async_read(
+          socket_,
+          buffers,
+          [self = shared_from_this()](const boost::system::error_code &error, size_t) {
+            if (!error && self->ParseRequest()) {
+              self->HandleChunk();
+            }
+          });
+      return;
+    }
+    // Read the request first, to know where to read the data into.
+    boost::asio::async_read(
+        socket_,
+        boost::asio::buffer(&request_[0], request_.size()),
+        [self = shared_from_this()](const boost::system::error_code &error, size_t) {
+          if (!error && self->ParseRequest()) {
+            self->ReadData();
+          }
+        });
+  }
+
+  bool ParseRequest() {
+    if (!request_message_.ParseFromString(request_)) {
+      RAY_LOG(WARNING) << "Closing a corrupted bulk stream.";
+      return false;
+    }
+    return true;
+  }
+
+  void ReadData() {
+    auto buffer = buffer_provider_(request_message_, data_.size());
+    if (buffer.data == nullptr) {
+      boost::asio::async_read(
+          socket_,
+          boost::asio::buffer(&data_[0], data_.size()),
+          [self = shared_from_this()](const boost::system::error_code &error, size_t) {
+            if (!error) {
+              self->HandleChunk();
+            }
+          });
+      return;
+    }
+    RAY_CHECK(buffer.size == data_.size());
+    boost::asio::async_read(
+        socket_,
+        boost::asio::buffer(buffer.data, buffer.size),
+        [self = shared_from_this(), on_done = std::move(buffer.on_done)](
+            const boost::system::error_code &error, size_t) {
+          on_done(!error);
+          if (!error) {
+            self->ReadFrameSizes();
+          }
+        });
+  }
+
+  void HandleChunk() {
+    handler_(request_message_, data_);
+    ReadFrameSizes();
+  }
+
+  tcp::socket socket_;
+  const BulkChunkReceiver::ChunkHandler handler_;
+  const BulkChunkReceiver::BufferProvider buffer_provider_;
+  std::array<uint8_t, kFrameSizesLength> frame_sizes_;
+  /// The serialized push request and the data of the chunk being read. The buffers are
+  /// reused for the next chunk. The data buffer is only filled for the chunks that the
+  /// buffer provider provides no memory for.
+  std::string request_;
+  std::string data_;
+  rpc::PushRequest request_message_;
+};
+
+class TcpChunkReceiver : public BulkChunkReceiver {
+ public:
+  TcpChunkReceiver(instrumented_io_context &io_service,
+                   const std::string &address,
+                   ChunkHandler handler,
+                   BufferProvider buffer_provider,
+                   std::shared_ptr<BulkChunkTls> tls)
+      : acceptor_(io_service),
+        address_(address),
+        handler_(std::move(handler)),
+        buffer_provider_(std::move(buffer_provider)),
+        tls_(std::move(tls)) {}
+
+  ~TcpChunkReceiver() { Stop(); }
+
+  int Start() override {
+    boost::system::error_code error;
+    tcp::endpoint endpoint(boost::asio::ip::make_address(address_, error), 0);
+    if (!error) {
+      acceptor_.open(endpoint.protocol(), error);
+    }
+    if (!error) {
+      acceptor_.bind(endpoint, error);
+    }
+    if (!error) {
+      acceptor_.listen(boost::asio::socket_base::max_listen_connections, error);
+    }
+    if (error) {
+      RAY_LOG(WARNING) << "Failed to start the bulk chunk receiver on " << address_
+                       << ": " << error.message();
+      Stop();
+      return 0;
+    }
+    Accept();
+    return acceptor_.local_endpoint().port();
+  }
+
+  void Stop() override {
+    boost::system::error_code ignored_error;
+    acceptor_.close(ignored_error);
+  }
+
+ private:
+  void Accept() {
+    acceptor_.async_accept(
+        [this](const boost::system::error_code &error, tcp::socket socket) {
+          if (error == boost::asio::error::operation_aborted) {
+            return;
+          }
+          if (!error) {
+            boost::system::error_code ignored_error;
+            socket.set_option(tcp::no_delay(true), ignored_error);
+            auto connection = std::make_shared<TcpChunkConnection>(
+                std::move(socket), handler_, buffer_provider_);
+            if (tls_ != nullptr) {
+              connection->Secure(*tls_);
+            } else {
+              connection->ReadFrameSizes();
+            }
+          }
+          Accept();
+        });
+  }
+
+  tcp::acceptor acceptor_;
+  const std::string address_;
+  const ChunkHandler handler_;
+  const BufferProvider buffer_provider_;
+  const std::shared_ptr<BulkChunkTls> tls_;
+};
+
+}  // namespace
+
+std::unique_ptr<BulkChunkSender> CreateTcpChunkSender(
+    instrumented_io_context &io_service,
+    int num_streams,
+    std::shared_ptr<BulkChunkTls> tls) {
+  return std::make_unique<TcpChunkSender>(io_service, num_streams, std::move(tls));
+}
+
+std::unique_ptr<BulkChunkReceiver> CreateTcpChunkReceiver(
+    instrumented_io_context &io_service,
+    const std::string &address,
+    BulkChunkReceiver::ChunkHandler handler,
+    BulkChunkReceiver::BufferProvider buffer_provider,
+    std::shared_ptr<BulkChunkTls> tls) {
+  return std::make_unique<TcpChunkReceiver>(io_service,
+                                            address,
+                                            std::move(handler),
+                                            std::move(buffer_provider),
+                                            std::move(tls));
+}
+
+}  // namespace ray
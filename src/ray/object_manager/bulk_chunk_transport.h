@@ -0,0 +1,114 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/status.h"
+#include "ray/object_manager/bulk_chunk_tls.h"
+#include "ray/object_manager/object_directory.h"
+#include "src/ray/protobuf/object_manager.pb.h"
+
+namespace ray {
+
+/// Sends object chunks to remote object managers on a data plane of its own, next to
+/// the gRPC service that carries the control messages. The chunk data is sent as is,
+/// without protobuf framing, and only the push request describing it is serialized.
+class BulkChunkSender {
+ public:
+  virtual ~BulkChunkSender() = default;
+
+  /// Send a chunk of an object. Chunks sent to the same node may arrive out of order.
+  /// This method is thread-safe.
+  ///
+  /// \param remote The remote object manager, with the port of its bulk receiver.
+  /// \param request The push request describing the chunk, without its data.
+  /// \param chunk The memory of the chunk data, in order.
+  /// \param chunk_owner Kept alive until the chunk is sent, e.g. to pin the object.
+  /// \param on_complete Called once the chunk is sent, or failed to send.
+  virtual void SendChunk(const RemoteConnectionInfo &remote,
+                         const rpc::PushRequest &request,
+                         std::vector<absl::string_view> chunk,
+                         std::shared_ptr<const void> chunk_owner,
+                         std::function<void(const Status &)> on_complete) = 0;
+};
+
+/// Receives the object chunks sent by `BulkChunkSender`s.
+class BulkChunkReceiver {
+ public:
+  /// Handles a received chunk, described by the push request, with the chunk data.
+  using ChunkHandler =
+      std::function<void(const rpc::PushRequest &request, const std::string &data)>;
+
+  /// Memory to read the data of a chunk into directly, e.g. the chunk's place in the
+  /// object store, instead of a buffer of the receiver.
+  struct ChunkBuffer {
+    uint8_t *data = nullptr;
+    uint64_t size = 0;
+    /// Called once the data was read into the memory, or failed to be read.
+    std::function<void(bool success)> on_done;
+  };
+
+  /// Returns the memory to read a chunk into, given its push request and the size of
+  /// its data, or a buffer without memory to read the chunk into a buffer of the
+  /// receiver and pass it to the ChunkHandler instead.
+  using BufferProvider =
+      std::function<ChunkBuffer(const rpc::PushRequest &request, uint64_t size)>;
+
+  virtual ~BulkChunkReceiver() = default;
+
+  /// Start accepting chunks.
+  ///
+  /// \return The port that the senders should connect to, 0 if it failed to start.
+  virtual int Start() = 0;
+
+  /// Stop accepting chunks.
+  virtual void Stop() = 0;
+};
+
+/// Create a sender that sends chunks over TCP, on up to `num_streams` parallel
+/// connections per remote node.
+///
+/// \param io_service The event loop that drives the connections.
+/// \param num_streams The number of connections to each remote node.
+/// \param tls If set, the connections are encrypted with it. The receivers must be
+/// created with TLS too.
+std::unique_ptr<BulkChunkSender> CreateTcpChunkSender(
+    instrumented_io_context &io_service,
+    int num_streams,
+    std::shared_ptr<BulkChunkTls> tls = nullptr);
+
+/// Create a receiver that accepts chunks over TCP.
+///
+/// \param io_service The event loop that drives the connections. The handler is
+/// called on it.
+/// \param address The address to listen on.
+/// \param handler The handler of received chunks.
+/// \param buffer_provider If set, provides the memory to read chunks into, so that
+/// their data is written once. The chunks it provides no memory for go to the handler.
+/// \param tls If set, the connections are encrypted with it.
+std::unique_ptr<BulkChunkReceiver> CreateTcpChunkReceiver(
+    instrumented_io_context &io_service,
+    const std::string &address,
+    BulkChunkReceiver::ChunkHandler handler,
+    BulkChunkReceiver::BufferProvider buffer_provider = nullptr,
+    std::shared_ptr<BulkChunkTls> tls = nullptr);
+
+}  // namespace ray
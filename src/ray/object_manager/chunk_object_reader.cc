@@ -29,7 +29,8 @@ uint64_t ChunkObjectReader::GetNumChunks() const {
          chunk_size_;
 }
 
-absl::optional<std::string> ChunkObjectReader::GetChunk(uint64_t chunk_index) const {
+ChunkObjectReader::ChunkSections ChunkObjectReader::GetChunkSections(
+    uint64_t chunk_index) const {
   // The spilled file stores metadata before data. But the GetChunk needs to
   // return data before metadata. We achieve by first read from data section,
   // then read from metadata section.
@@ -38,29 +39,83 @@ absl::optional<std::string> ChunkObjectReader::GetChunk(uint64_t chunk_index) co
       std::min(chunk_size_,
                object_->GetDataSize() + object_->GetMetadataSize() - cur_chunk_offset);
 
-  std::string result(cur_chunk_size, '\0');
-  size_t result_offset = 0;
-
+  ChunkSections sections;
   if (cur_chunk_offset < object_->GetDataSize()) {
     // read from data section.
-    auto offset = cur_chunk_offset;
-    auto size = std::min(object_->GetDataSize() - cur_chunk_offset, cur_chunk_size);
-    if (!object_->ReadFromDataSection(offset, size, &result[result_offset])) {
-      return absl::optional<std::string>();
-    }
-    result_offset = size;
+    sections.data_offset = cur_chunk_offset;
+    sections.data_size =
+        std::min(object_->GetDataSize() - cur_chunk_offset, cur_chunk_size);
   }
 
   if (cur_chunk_offset + cur_chunk_size > object_->GetDataSize()) {
     // read from metadata section.
-    auto offset =
+    sections.metadata_offset =
         std::max(cur_chunk_offset, object_->GetDataSize()) - object_->GetDataSize();
-    auto size = std::min(cur_chunk_offset + cur_chunk_size - object_->GetDataSize(),
-                         cur_chunk_size);
-    if (!object_->ReadFromMetadataSection(offset, size, &result[result_offset])) {
-      return absl::optional<std::string>();
-    }
+    sections.metadata_size = std::min(
+        cur_chunk_offset + cur_chunk_size - object_->GetDataSize(), cur_chunk_size);
+  }
+  return sections;
+}
+
+absl::optional<std::string> ChunkObjectReader::GetChunk(uint64_t chunk_index) const {
+  const auto sections = GetChunkSections(chunk_index);
+  std::string result(sections.data_size + sections.metadata_size, '\0');
+
+  if (sections.data_size > 0 &&
+      !object_->ReadFromDataSection(
+          sections.data_offset, sections.data_size, &result[0])) {
+    return absl::optional<std::string>();
+  }
+  if (sections.metadata_size > 0 &&
+      !object_->ReadFromMetadataSection(sections.metadata_offset,
+                                        sections.metadata_size,
+                                        &result[sections.data_size])) {
+    return absl::optional<std::string>();
   }
   return absl::optional<std::string>(std::move(result));
 }
+
+std::shared_ptr<const std::string> ChunkObjectReader::GetSharedChunk(
+    uint64_t chunk_index) const {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = shared_chunks_.find(chunk_index);
+    if (it != shared_chunks_.end()) {
+      if (auto chunk = it->second.lock()) {
+        return chunk;
+      }
+    }
+  }
+  // Read without holding the lock, so that different chunks are read concurrently. If
+  // the same chunk is read concurrently, the last read is the one that is shared.
+  auto optional_chunk = GetChunk(chunk_index);
+  if (!optional_chunk.has_value()) {
+    return nullptr;
+  }
+  auto chunk = std::make_shared<const std::string>(std::move(optional_chunk.value()));
+  absl::MutexLock lock(&mutex_);
+  shared_chunks_[chunk_index] = chunk;
+  return chunk;
+}
+
+bool ChunkObjectReader::GetChunkInMemory(uint64_t chunk_index,
+                                         std::vector<absl::string_view> *chunk) const {
+  const auto sections = GetChunkSections(chunk_index);
+  chunk->clear();
+  if (sections.data_size > 0) {
+    const char *data = object_->GetDataSectionAddress();
+    if (data == nullptr) {
+      return false;
+    }
+    chunk->emplace_back(data + sections.data_offset, sections.data_size);
+  }
+  if (sections.metadata_size > 0) {
+    const char *metadata = object_->GetMetadataSectionAddress();
+    if (metadata == nullptr) {
+      return false;
+    }
+    chunk->emplace_back(metadata + sections.metadata_offset, sections.metadata_size);
+  }
+  return true;
+}
 };  // namespace ray
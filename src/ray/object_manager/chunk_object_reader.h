@@ -14,11 +14,19 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "ray/object_manager/spilled_object_reader.h"
 
 namespace ray {
 
 /// Read object in chunks.
+/// This class is thread safe.
 class ChunkObjectReader {
  public:
   /// Create a ChunkObjectReader.
@@ -29,6 +37,8 @@ class ChunkObjectReader {
 
   uint64_t GetNumChunks() const;
 
+  uint64_t GetChunkSize() const { return chunk_size_; }
+
   /// Return the value in a given chunk, identified by chunk_index.
   /// It migh return an empty optional if the file is deleted.
   ///
@@ -36,11 +46,42 @@ class ChunkObjectReader {
   ///                    equal to GetNumChunks() yields undefined behavior.
   absl::optional<std::string> GetChunk(uint64_t chunk_index) const;
 
+  /// Like `GetChunk`, but the read is shared: as long as the returned chunk is alive,
+  /// e.g. while it's being sent to one node, reading the same chunk again, to send it
+  /// to another node, returns it instead of reading the object again.
+  ///
+  /// \return The chunk, or null if it couldn't be read.
+  std::shared_ptr<const std::string> GetSharedChunk(uint64_t chunk_index) const;
+
+  /// Return the memory of a given chunk without copying it, if the object is in
+  /// memory. The memory is valid as long as this reader.
+  ///
+  /// \param chunk_index the index of chunk to return.
+  /// \param[out] chunk the memory of the chunk in order, data before metadata.
+  /// \return whether the chunk is in memory.
+  bool GetChunkInMemory(uint64_t chunk_index,
+                        std::vector<absl::string_view> *chunk) const;
+
   const IObjectReader &GetObject() const { return *object_; }
 
  private:
+  /// The parts of the data and metadata sections that a chunk is made of.
+  struct ChunkSections {
+    uint64_t data_offset = 0;
+    uint64_t data_size = 0;
+    uint64_t metadata_offset = 0;
+    uint64_t metadata_size = 0;
+  };
+
+  ChunkSections GetChunkSections(uint64_t chunk_index) const;
+
   const std::shared_ptr<IObjectReader> object_;
   const uint64_t chunk_size_;
+
+  mutable absl::Mutex mutex_;
+  /// The chunks returned by `GetSharedChunk` that may still be alive.
+  mutable absl::flat_hash_map<uint64_t, std::weak_ptr<const std::string>> shared_chunks_
+      GUARDED_BY(mutex_);
 };
 
 }  // namespace ray
@@ -62,6 +62,21 @@ struct ObjectInfo {
   }
 };
 
+/// A subset of the chunks of an object, the chunks whose index is `index` modulo
+/// `count`. A pull of a large object asks each of several copies for one stripe.
+struct ChunkStripe {
+  uint32_t index = 0;
+  uint32_t count = 1;
+
+  /// The number of chunks in the stripe, of an object with `num_chunks` chunks.
+  uint64_t NumChunks(uint64_t num_chunks) const {
+    return num_chunks > index ? (num_chunks - index + count - 1) / count : 0;
+  }
+
+  /// The index in the object of the `i`-th chunk of the stripe.
+  uint64_t ChunkIndex(uint64_t i) const { return index + i * count; }
+};
+
 // A callback to call when an object is added to the shared memory store.
 using AddObjectCallback = std::function<void(const ObjectInfo &)>;
 
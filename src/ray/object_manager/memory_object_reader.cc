@@ -51,4 +51,12 @@ bool MemoryObjectReader::ReadFromMetadataSection(uint64_t offset,
   return true;
 }
 
+const char *MemoryObjectReader::GetDataSectionAddress() const {
+  return reinterpret_cast<const char *>(object_buffer_.data->Data());
+}
+
+const char *MemoryObjectReader::GetMetadataSectionAddress() const {
+  return reinterpret_cast<const char *>(object_buffer_.metadata->Data());
+}
+
 }  // namespace ray
@@ -36,6 +36,10 @@ class MemoryObjectReader : public IObjectReader {
                                uint64_t size,
                                char *output) const override;
 
+  const char *GetDataSectionAddress() const override;
+
+  const char *GetMetadataSectionAddress() const override;
+
  private:
   const plasma::ObjectBuffer object_buffer_;
   const rpc::Address owner_address_;
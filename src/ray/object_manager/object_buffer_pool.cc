@@ -14,6 +14,8 @@
 
 #include "ray/object_manager/object_buffer_pool.h"
 
+#include <algorithm>
+
 #include "absl/time/time.h"
 #include "ray/common/status.h"
 #include "ray/util/logging.h"
@@ -21,8 +23,12 @@
 namespace ray {
 
 ObjectBufferPool::ObjectBufferPool(
-    std::shared_ptr<plasma::PlasmaClientInterface> store_client, uint64_t chunk_size)
-    : store_client_(store_client), default_chunk_size_(chunk_size) {}
+    std::shared_ptr<plasma::PlasmaClientInterface> store_client,
+    uint64_t chunk_size,
+    bool streaming_reads_enabled)
+    : store_client_(store_client),
+      default_chunk_size_(chunk_size),
+      streaming_reads_enabled_(streaming_reads_enabled) {}
 
 ObjectBufferPool::~ObjectBufferPool() {
   absl::MutexLock lock(&pool_mutex_);
@@ -57,15 +63,21 @@ ObjectBufferPool::~ObjectBufferPool() {
   RAY_CHECK_OK(store_client_->Disconnect());
 }
 
-uint64_t ObjectBufferPool::GetNumChunks(uint64_t data_size) const {
-  return (data_size + default_chunk_size_ - 1) / default_chunk_size_;
+uint64_t ObjectBufferPool::GetNumChunks(uint64_t data_size, uint64_t chunk_size) const {
+  if (chunk_size == 0) {
+    chunk_size = default_chunk_size_;
+  }
+  return (data_size + chunk_size - 1) / chunk_size;
 }
 
 uint64_t ObjectBufferPool::GetBufferLength(uint64_t chunk_index,
-                                           uint64_t data_size) const {
-  return (chunk_index + 1) * default_chunk_size_ > data_size
-             ? data_size % default_chunk_size_
-             : default_chunk_size_;
+                                           uint64_t data_size,
+                                           uint64_t chunk_size) const {
+  if (chunk_size == 0) {
+    chunk_size = default_chunk_size_;
+  }
+  return (chunk_index + 1) * chunk_size > data_size ? data_size % chunk_size
+                                                    : chunk_size;
 }
 
 std::pair<std::shared_ptr<MemoryObjectReader>, ray::Status>
@@ -98,11 +110,20 @@ ray::Status ObjectBufferPool::CreateChunk(const ObjectID &object_id,
                                           const rpc::Address &owner_address,
                                           uint64_t data_size,
                                           uint64_t metadata_size,
-                                          uint64_t chunk_index) {
+                                          uint64_t chunk_index,
+                                          uint64_t chunk_size) {
+  if (chunk_size == 0) {
+    chunk_size = default_chunk_size_;
+  }
   absl::MutexLock lock(&pool_mutex_);
   RAY_RETURN_NOT_OK(EnsureBufferExists(
-      object_id, owner_address, data_size, metadata_size, chunk_index));
+      object_id, owner_address, data_size, metadata_size, chunk_index, chunk_size));
   auto &state = create_buffer_state_.at(object_id);
+  if (state.chunk_size != chunk_size) {
+    // Another node is pushing the object in chunks of a different size. This chunk
+    // will be pushed again if the other push doesn't complete the object.
+    return ray::Status::IOError("Chunk size mismatch");
+  }
   if (chunk_index >= state.chunk_state.size()) {
     return ray::Status::IOError("Object size mismatch");
   }
@@ -121,7 +142,8 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
                                   const std::string &data) {
   absl::MutexLock lock(&pool_mutex_);
   auto it = create_buffer_state_.find(object_id);
-  if (it == create_buffer_state_.end() || chunk_index >= it->second.chunk_state.size() ||
+  if (it == create_buffer_state_.end() || it->second.aborted ||
+      chunk_index >= it->second.chunk_state.size() ||
       it->second.chunk_state.at(chunk_index) != CreateChunkState::REFERENCED) {
     RAY_LOG(DEBUG) << "Object " << object_id << " aborted before chunk " << chunk_index
                    << " could be sealed";
@@ -137,14 +159,85 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
       << "size mismatch!  data size: " << data.size()
       << " chunk size: " << chunk_info.buffer_length;
   std::memcpy(chunk_info.data, data.data(), chunk_info.buffer_length);
-  it->second.chunk_state.at(chunk_index) = CreateChunkState::SEALED;
-  it->second.num_seals_remaining--;
-  if (it->second.num_seals_remaining == 0) {
+  SealChunk(object_id, chunk_index);
+}
+
+std::pair<ObjectBufferPool::ChunkInfo, ray::Status>
+ObjectBufferPool::CreateChunkForWrite(const ObjectID &object_id,
+                                      const rpc::Address &owner_address,
+                                      uint64_t data_size,
+                                      uint64_t metadata_size,
+                                      uint64_t chunk_index,
+                                      uint64_t chunk_size) {
+  auto status = CreateChunk(
+      object_id, owner_address, data_size, metadata_size, chunk_index, chunk_size);
+  if (!status.ok()) {
+    return std::make_pair(errored_chunk_, status);
+  }
+  absl::MutexLock lock(&pool_mutex_);
+  auto it = create_buffer_state_.find(object_id);
+  if (it == create_buffer_state_.end() || it->second.aborted) {
+    // The object was aborted after the chunk was created.
+    return std::make_pair(errored_chunk_,
+                          ray::Status::IOError("Object aborted before the chunk could "
+                                               "be written"));
+  }
+  it->second.num_writers++;
+  return std::make_pair(it->second.chunk_info.at(chunk_index), ray::Status::OK());
+}
+
+void ObjectBufferPool::FinishChunk(const ObjectID &object_id,
+                                   uint64_t chunk_index,
+                                   bool success) {
+  absl::MutexLock lock(&pool_mutex_);
+  auto it = create_buffer_state_.find(object_id);
+  RAY_CHECK(it != create_buffer_state_.end() && it->second.num_writers > 0);
+  auto &state = it->second;
+  state.num_writers--;
+  if (state.aborted) {
+    if (state.num_writers == 0) {
+      AbortCreateInternal(object_id);
+    }
+    return;
+  }
+  RAY_CHECK(state.chunk_state.at(chunk_index) == CreateChunkState::REFERENCED);
+  if (!success) {
+    // The chunk will be pushed again.
+    state.chunk_state.at(chunk_index) = CreateChunkState::AVAILABLE;
+    return;
+  }
+  SealChunk(object_id, chunk_index);
+}
+
+void ObjectBufferPool::SealChunk(const ObjectID &object_id, uint64_t chunk_index) {
+  auto it = create_buffer_state_.find(object_id);
+  RAY_CHECK(it != create_buffer_state_.end());
+  auto &state = it->second;
+  state.chunk_state.at(chunk_index) = CreateChunkState::SEALED;
+  state.num_seals_remaining--;
+  if (state.num_seals_remaining == 0) {
+    RAY_CHECK(state.num_writers == 0);
     RAY_CHECK_OK(store_client_->Seal(object_id));
     RAY_CHECK_OK(store_client_->Release(object_id));
     create_buffer_state_.erase(it);
     RAY_LOG(DEBUG) << "Have received all chunks for object " << object_id
                    << ", last chunk index: " << chunk_index;
+    return;
+  }
+  if (!streaming_reads_enabled_) {
+    return;
+  }
+  const uint64_t num_chunks_sealed_prefix = state.num_chunks_sealed_prefix;
+  while (state.num_chunks_sealed_prefix < state.chunk_state.size() &&
+         state.chunk_state.at(state.num_chunks_sealed_prefix) ==
+             CreateChunkState::SEALED) {
+    state.num_chunks_sealed_prefix++;
+  }
+  if (state.num_chunks_sealed_prefix > num_chunks_sealed_prefix) {
+    // Readers of the object may read the chunks in order up to the first one missing.
+    const uint64_t num_bytes =
+        std::min(state.num_chunks_sealed_prefix * state.chunk_size, state.data_size);
+    RAY_CHECK_OK(store_client_->SealPrefix(object_id, num_bytes));
   }
 }
 
@@ -157,6 +250,12 @@ void ObjectBufferPool::AbortCreate(const ObjectID &object_id) {
 
 void ObjectBufferPool::AbortCreateInternal(const ObjectID &object_id) {
   auto it = create_buffer_state_.find(object_id);
+  if (it != create_buffer_state_.end() && it->second.num_writers > 0) {
+    // Chunks are still being written into the buffer, so it can't be released yet.
+    // The last of them to finish aborts it.
+    it->second.aborted = true;
+    return;
+  }
   if (it != create_buffer_state_.end()) {
     RAY_CHECK_OK(store_client_->Release(object_id));
     RAY_CHECK_OK(store_client_->Abort(object_id));
@@ -168,19 +267,19 @@ std::vector<ObjectBufferPool::ChunkInfo> ObjectBufferPool::BuildChunks(
     const ObjectID &object_id,
     uint8_t *data,
     uint64_t data_size,
+    uint64_t chunk_size,
     std::shared_ptr<Buffer> buffer_ref) {
   uint64_t space_remaining = data_size;
   std::vector<ChunkInfo> chunks;
   int64_t position = 0;
   while (space_remaining) {
     position = data_size - space_remaining;
-    if (space_remaining < default_chunk_size_) {
+    if (space_remaining < chunk_size) {
       chunks.emplace_back(chunks.size(), data + position, space_remaining, buffer_ref);
       space_remaining = 0;
     } else {
-      chunks.emplace_back(
-          chunks.size(), data + position, default_chunk_size_, buffer_ref);
-      space_remaining -= default_chunk_size_;
+      chunks.emplace_back(chunks.size(), data + position, chunk_size, buffer_ref);
+      space_remaining -= chunk_size;
     }
   }
   return chunks;
@@ -190,11 +289,19 @@ ray::Status ObjectBufferPool::EnsureBufferExists(const ObjectID &object_id,
                                                  const rpc::Address &owner_address,
                                                  uint64_t data_size,
                                                  uint64_t metadata_size,
-                                                 uint64_t chunk_index) {
+                                                 uint64_t chunk_index,
+                                                 uint64_t chunk_size) {
   while (true) {
     // Buffer for object_id already exists and the size matches ours.
     {
       auto it = create_buffer_state_.find(object_id);
+      if (it != create_buffer_state_.end() && it->second.num_writers > 0 &&
+          (it->second.aborted || it->second.data_size != data_size ||
+           it->second.metadata_size != metadata_size)) {
+        // The buffer can't be replaced until the chunks being written into it finish.
+        // This chunk will be pushed again.
+        return ray::Status::IOError("Object buffer is being aborted");
+      }
       if (it != create_buffer_state_.end() && it->second.data_size == data_size &&
           it->second.metadata_size == metadata_size) {
         return ray::Status::OK();
@@ -270,13 +377,15 @@ ray::Status ObjectBufferPool::EnsureBufferExists(const ObjectID &object_id,
 
   // Read object into store.
   uint8_t *mutable_data = data->Data();
-  uint64_t num_chunks = GetNumChunks(data_size);
+  uint64_t num_chunks = GetNumChunks(data_size, chunk_size);
   auto inserted = create_buffer_state_.emplace(
       std::piecewise_construct,
       std::forward_as_tuple(object_id),
-      std::forward_as_tuple(metadata_size,
-                            data_size,
-                            BuildChunks(object_id, mutable_data, data_size, data)));
+      std::forward_as_tuple(
+          metadata_size,
+          data_size,
+          chunk_size,
+          BuildChunks(object_id, mutable_data, data_size, chunk_size, data)));
   RAY_CHECK(inserted.first->second.chunk_info.size() == num_chunks);
   RAY_LOG(DEBUG) << "Created object " << object_id
                  << " in plasma store, number of chunks: " << num_chunks
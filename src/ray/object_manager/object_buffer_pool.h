@@ -60,8 +60,12 @@ class ObjectBufferPool {
   ///
   /// \param store_client Plasma store client. Used for testing purposes only.
   /// \param chunk_size The chunk size into which objects are to be split.
+  /// \param streaming_reads_enabled Whether to tell the store how much of an object
+  /// was received each time a chunk is sealed, so that it can be read before the whole
+  /// object is received.
   ObjectBufferPool(std::shared_ptr<plasma::PlasmaClientInterface> store_client,
-                   const uint64_t chunk_size);
+                   const uint64_t chunk_size,
+                   bool streaming_reads_enabled = false);
 
   ~ObjectBufferPool();
 
@@ -71,15 +75,19 @@ class ObjectBufferPool {
   /// Computes the number of chunks needed to transfer an object and its metadata.
   ///
   /// \param data_size The size of the object + metadata.
+  /// \param chunk_size The chunk size, or 0 for the default chunk size.
   /// \return The number of chunks into which the object will be split.
-  uint64_t GetNumChunks(uint64_t data_size) const;
+  uint64_t GetNumChunks(uint64_t data_size, uint64_t chunk_size = 0) const;
 
   /// Computes the buffer length of a chunk of an object.
   ///
   /// \param chunk_index The chunk index for which to obtain the buffer length.
   /// \param data_size The size of the object + metadata.
+  /// \param chunk_size The chunk size, or 0 for the default chunk size.
   /// \return The buffer length of the chunk at chunk_index.
-  uint64_t GetBufferLength(uint64_t chunk_index, uint64_t data_size) const;
+  uint64_t GetBufferLength(uint64_t chunk_index,
+                           uint64_t data_size,
+                           uint64_t chunk_size = 0) const;
 
   /// Returns an object reader for read.
   ///
@@ -104,15 +112,19 @@ class ObjectBufferPool {
   /// \param data_size The sum of the object size and metadata size.
   /// \param metadata_size The size of the metadata.
   /// \param chunk_index The index of the chunk.
+  /// \param chunk_size The size of the chunks that the sender splits the object into,
+  /// or 0 for the default chunk size.
   /// \return status of invoking this method.
   /// An IOError status is returned if object creation on the store client fails,
-  /// or if create is invoked consecutively on the same chunk
-  /// (with no intermediate AbortCreateChunk).
+  /// if create is invoked consecutively on the same chunk
+  /// (with no intermediate AbortCreateChunk), or if the object is already being
+  /// received in chunks of a different size.
   ray::Status CreateChunk(const ObjectID &object_id,
                           const rpc::Address &owner_address,
                           uint64_t data_size,
                           uint64_t metadata_size,
-                          uint64_t chunk_index) LOCKS_EXCLUDED(pool_mutex_);
+                          uint64_t chunk_index,
+                          uint64_t chunk_size = 0) LOCKS_EXCLUDED(pool_mutex_);
 
   /// Write to a Chunk of an object. If all chunks of an object is written,
   /// it seals the object.
@@ -130,6 +142,29 @@ class ObjectBufferPool {
                   uint64_t chunk_index,
                   const std::string &data) LOCKS_EXCLUDED(pool_mutex_);
 
+  /// Create a chunk of an object like CreateChunk, and return its memory, so that the
+  /// chunk can be received into the object store directly instead of through
+  /// WriteChunk. FinishChunk must be called once the chunk is written, and the object
+  /// isn't aborted until then.
+  ///
+  /// \return A pair consisting of the chunk info and status of invoking this method.
+  std::pair<ChunkInfo, ray::Status> CreateChunkForWrite(
+      const ObjectID &object_id,
+      const rpc::Address &owner_address,
+      uint64_t data_size,
+      uint64_t metadata_size,
+      uint64_t chunk_index,
+      uint64_t chunk_size = 0) LOCKS_EXCLUDED(pool_mutex_);
+
+  /// Finish writing a chunk returned by CreateChunkForWrite. If all chunks of the
+  /// object are written, it seals the object.
+  ///
+  /// \param object_id The ObjectID.
+  /// \param chunk_index The index of the chunk.
+  /// \param success Whether the chunk was written. If not, it can be created again.
+  void FinishChunk(const ObjectID &object_id, uint64_t chunk_index, bool success)
+      LOCKS_EXCLUDED(pool_mutex_);
+
   /// Free a list of objects from object store.
   ///
   /// \param object_ids the The list of ObjectIDs to be deleted.
@@ -151,6 +186,7 @@ class ObjectBufferPool {
   std::vector<ChunkInfo> BuildChunks(const ObjectID &object_id,
                                      uint8_t *data,
                                      uint64_t data_size,
+                                     uint64_t chunk_size,
                                      std::shared_ptr<Buffer> buffer_ref)
       EXCLUSIVE_LOCKS_REQUIRED(pool_mutex_);
 
@@ -162,12 +198,18 @@ class ObjectBufferPool {
                                  const rpc::Address &owner_address,
                                  uint64_t data_size,
                                  uint64_t metadata_size,
-                                 uint64_t chunk_index)
+                                 uint64_t chunk_index,
+                                 uint64_t chunk_size)
       EXCLUSIVE_LOCKS_REQUIRED(pool_mutex_);
 
   void AbortCreateInternal(const ObjectID &object_id)
       EXCLUSIVE_LOCKS_REQUIRED(pool_mutex_);
 
+  /// Mark a chunk of a buffer as sealed, and seal the object once all of its chunks
+  /// are sealed.
+  void SealChunk(const ObjectID &object_id, uint64_t chunk_index)
+      EXCLUSIVE_LOCKS_REQUIRED(pool_mutex_);
+
   /// The state of a chunk associated with a create operation.
   enum class CreateChunkState : unsigned int { AVAILABLE = 0, REFERENCED, SEALED };
 
@@ -175,9 +217,11 @@ class ObjectBufferPool {
   struct CreateBufferState {
     CreateBufferState(uint64_t metadata_size,
                       uint64_t data_size,
+                      uint64_t chunk_size,
                       std::vector<ChunkInfo> chunk_info)
         : metadata_size(metadata_size),
           data_size(data_size),
+          chunk_size(chunk_size),
           chunk_info(chunk_info),
           chunk_state(chunk_info.size(), CreateChunkState::AVAILABLE),
           num_seals_remaining(chunk_info.size()) {}
@@ -185,6 +229,8 @@ class ObjectBufferPool {
     uint64_t metadata_size;
     /// Total size of the object data.
     uint64_t data_size;
+    /// The size of the chunks the object is split into.
+    uint64_t chunk_size;
     /// A vector maintaining information about the chunks which comprise
     /// an object.
     std::vector<ChunkInfo> chunk_info;
@@ -193,9 +239,17 @@ class ObjectBufferPool {
     std::vector<CreateChunkState> chunk_state;
     /// The number of chunks left to seal before the buffer is sealed.
     uint64_t num_seals_remaining;
+    /// The number of leading chunks that are all sealed, which the store was told
+    /// about if streaming reads are enabled.
+    uint64_t num_chunks_sealed_prefix = 0;
+    /// The number of chunks returned by CreateChunkForWrite that are being written.
+    uint64_t num_writers = 0;
+    /// Whether the buffer was aborted while chunks were being written. It is aborted in
+    /// the store once the last of them finishes.
+    bool aborted = false;
   };
 
-  /// Returned when GetChunk or CreateChunk fails.
+  /// Returned when GetChunk or CreateChunkForWrite fails.
   const ChunkInfo errored_chunk_ = {0, nullptr, 0, nullptr};
 
   /// Mutex to protect create_buffer_ops_, create_buffer_state_ and following invariants:
@@ -219,6 +273,9 @@ class ObjectBufferPool {
   /// Determines the maximum chunk size to be transferred by a single thread.
   const uint64_t default_chunk_size_;
 
+  /// Whether the store is told about the sealed prefix of the objects being received.
+  const bool streaming_reads_enabled_;
+
   friend class ObjectBufferPoolTest;
 };
 
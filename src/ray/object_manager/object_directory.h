@@ -39,6 +39,8 @@ struct RemoteConnectionInfo {
   NodeID node_id;
   std::string ip;
   uint16_t port;
+  /// The port of the bulk chunk receiver, 0 if the node only receives chunks on gRPC.
+  uint16_t bulk_port = 0;
 };
 
 /// Callback for object location notifications.
@@ -14,6 +14,7 @@
 
 #include "ray/object_manager/object_manager.h"
 
+#include <atomic>
 #include <chrono>
 
 #include "ray/common/common_protocol.h"
@@ -24,6 +25,14 @@ namespace asio = boost::asio;
 
 namespace ray {
 
+namespace {
+
+/// The number of chunks that large objects are split into, if the chunks can be larger
+/// than the default chunk size.
+constexpr uint64_t kTargetChunksPerObject = 16;
+
+}  // namespace
+
 ObjectStoreRunner::ObjectStoreRunner(const ObjectManagerConfig &config,
                                      SpillObjectsCallback spill_objects_callback,
                                      std::function<void()> object_store_full_callback,
@@ -99,7 +108,9 @@ ObjectManager::ObjectManager(
                 "ObjectManager.ObjectDeleted");
           }),
       buffer_pool_store_client_(std::make_shared<plasma::PlasmaClient>()),
-      buffer_pool_(buffer_pool_store_client_, config_.object_chunk_size),
+      buffer_pool_(buffer_pool_store_client_,
+                   config_.object_chunk_size,
+                   RayConfig::instance().plasma_streaming_reads_enabled()),
       rpc_work_(rpc_service_),
       object_manager_server_("ObjectManager",
                              config_.object_manager_port,
@@ -113,9 +124,14 @@ ObjectManager::ObjectManager(
                         boost::posix_time::milliseconds(config.timer_freq_ms)) {
   RAY_CHECK(config_.rpc_service_threads_number > 0);
 
-  push_manager_.reset(new PushManager(/* max_chunks_in_flight= */ std::max(
-      static_cast<int64_t>(1L),
-      static_cast<int64_t>(config_.max_bytes_in_flight / config_.object_chunk_size))));
+  push_manager_.reset(new PushManager(
+      /* max_chunks_in_flight= */ std::max(
+          static_cast<int64_t>(1L),
+          static_cast<int64_t>(config_.max_bytes_in_flight / config_.object_chunk_size)),
+      RayConfig::instance().object_manager_push_initial_window()));
+  RAY_CHECK(RayConfig::instance().object_manager_max_chunk_size() <
+            static_cast<uint64_t>(RayConfig::instance().max_grpc_message_size()))
+      << "object_manager_max_chunk_size must be below max_grpc_message_size.";
 
   pull_retry_timer_.async_wait([this](const boost::system::error_code &e) { Tick(e); });
 
@@ -123,8 +139,9 @@ ObjectManager::ObjectManager(
     return local_objects_.count(object_id) != 0;
   };
   const auto &send_pull_request = [this](const ObjectID &object_id,
-                                         const NodeID &client_id) {
-    SendPullRequest(object_id, client_id);
+                                         const NodeID &client_id,
+                                         const ChunkStripe &stripe) {
+    SendPullRequest(object_id, client_id, stripe);
   };
   const auto &cancel_pull_request = [this](const ObjectID &object_id) {
     // We must abort this object because it may have only been partially
@@ -152,6 +169,32 @@ ObjectManager::ObjectManager(
   RAY_CHECK_OK(
       buffer_pool_store_client_->Connect(config_.store_socket_name.c_str(), "", 0, 300));
 
+  const int bulk_transfer_streams =
+      RayConfig::instance().object_manager_bulk_transfer_streams();
+  // With TLS, the bulk data plane is encrypted by the kernel. Without kernel TLS, the
+  // chunks are sent on the encrypted gRPC channels instead.
+  std::shared_ptr<BulkChunkTls> bulk_tls;
+  if (bulk_transfer_streams > 0 && RayConfig::instance().USE_TLS()) {
+    bulk_tls = BulkChunkTls::Create();
+  }
+  if (bulk_transfer_streams > 0 &&
+      (!RayConfig::instance().USE_TLS() || bulk_tls != nullptr)) {
+    bulk_chunk_sender_ =
+        CreateTcpChunkSender(rpc_service_, bulk_transfer_streams, bulk_tls);
+    bulk_chunk_receiver_ = CreateTcpChunkReceiver(
+        rpc_service_,
+        config_.object_manager_address == "127.0.0.1" ? "127.0.0.1" : "0.0.0.0",
+        [this](const rpc::PushRequest &request, const std::string &data) {
+          HandlePushedChunk(request, data);
+        },
+        [this](const rpc::PushRequest &request, uint64_t size) {
+          return ProvideChunkBuffer(request, size);
+        },
+        bulk_tls);
+    bulk_port_ = bulk_chunk_receiver_->Start();
+    RAY_LOG(INFO) << "Receiving object chunks on bulk port " << bulk_port_;
+  }
+
   // Start object manager rpc server and send & receive request threads
   StartRpcService();
 }
@@ -179,6 +222,9 @@ void ObjectManager::StartRpcService() {
 }
 
 void ObjectManager::StopRpcService() {
+  if (bulk_chunk_receiver_ != nullptr) {
+    bulk_chunk_receiver_->Stop();
+  }
   rpc_service_.stop();
   for (int i = 0; i < config_.rpc_service_threads_number; i++) {
     rpc_threads_[i].join();
@@ -230,9 +276,10 @@ void ObjectManager::HandleObjectDeleted(const ObjectID &object_id) {
 }
 
 uint64_t ObjectManager::Pull(const std::vector<rpc::ObjectReference> &object_refs,
-                             BundlePriority prio) {
+                             BundlePriority prio,
+                             const PullOptions &options) {
   std::vector<rpc::ObjectReference> objects_to_locate;
-  auto request_id = pull_manager_->Pull(object_refs, prio, &objects_to_locate);
+  auto request_id = pull_manager_->Pull(object_refs, prio, &objects_to_locate, options);
 
   const auto &callback = [this](const ObjectID &object_id,
                                 const std::unordered_set<NodeID> &client_ids,
@@ -269,15 +316,19 @@ void ObjectManager::CancelPull(uint64_t request_id) {
   }
 }
 
-void ObjectManager::SendPullRequest(const ObjectID &object_id, const NodeID &client_id) {
+void ObjectManager::SendPullRequest(const ObjectID &object_id,
+                                    const NodeID &client_id,
+                                    const ChunkStripe &stripe) {
   auto rpc_client = GetRpcClient(client_id);
   if (rpc_client) {
     // Try pulling from the client.
     rpc_service_.post(
-        [this, object_id, client_id, rpc_client]() {
+        [this, object_id, client_id, rpc_client, stripe]() {
           rpc::PullRequest pull_request;
           pull_request.set_object_id(object_id.Binary());
           pull_request.set_node_id(self_node_id_.Binary());
+          pull_request.set_stripe_index(stripe.index);
+          pull_request.set_num_stripes(stripe.count);
 
           rpc_client->Pull(
               pull_request,
@@ -317,6 +368,15 @@ void ObjectManager::HandlePushTaskTimeout(const ObjectID &object_id,
   }
 }
 
+void ObjectManager::AddPeerBytes(const NodeID &node_id,
+                                 uint64_t sent_bytes,
+                                 uint64_t received_bytes) {
+  absl::MutexLock lock(&peer_bytes_mu_);
+  auto &bytes = peer_bytes_[node_id];
+  bytes.sent += sent_bytes;
+  bytes.received += received_bytes;
+}
+
 void ObjectManager::HandleSendFinished(const ObjectID &object_id,
                                        const NodeID &node_id,
                                        uint64_t chunk_index,
@@ -333,17 +393,19 @@ void ObjectManager::HandleSendFinished(const ObjectID &object_id,
   }
 }
 
-void ObjectManager::Push(const ObjectID &object_id, const NodeID &node_id) {
+void ObjectManager::Push(const ObjectID &object_id,
+                         const NodeID &node_id,
+                         const ChunkStripe &stripe) {
   RAY_LOG(DEBUG) << "Push on " << self_node_id_ << " to " << node_id << " of object "
-                 << object_id;
+                 << object_id << ", stripe " << stripe.index << "/" << stripe.count;
   if (local_objects_.count(object_id) != 0) {
-    return PushLocalObject(object_id, node_id);
+    return PushLocalObject(object_id, node_id, stripe);
   }
 
   // Push from spilled object directly if the object is on local disk.
   auto object_url = get_spilled_object_url_(object_id);
   if (!object_url.empty() && RayConfig::instance().is_external_storage_type_fs()) {
-    return PushFromFilesystem(object_id, node_id, object_url);
+    return PushFromFilesystem(object_id, node_id, object_url, stripe);
   }
 
   // Avoid setting duplicated timer for the same object and node pair.
@@ -377,7 +439,9 @@ void ObjectManager::Push(const ObjectID &object_id, const NodeID &node_id) {
   }
 }
 
-void ObjectManager::PushLocalObject(const ObjectID &object_id, const NodeID &node_id) {
+void ObjectManager::PushLocalObject(const ObjectID &object_id,
+                                    const NodeID &node_id,
+                                    const ChunkStripe &stripe) {
   const ObjectInfo &object_info = local_objects_[object_id].object_info;
   uint64_t data_size = static_cast<uint64_t>(object_info.data_size);
   uint64_t metadata_size = static_cast<uint64_t>(object_info.metadata_size);
@@ -414,20 +478,50 @@ void ObjectManager::PushLocalObject(const ObjectID &object_id, const NodeID &nod
     local_objects_[object_id].object_info.metadata_size = 1;
   }
 
-  PushObjectInternal(object_id,
-                     node_id,
-                     std::make_shared<ChunkObjectReader>(std::move(object_reader),
-                                                         config_.object_chunk_size),
-                     /*from_disk=*/false);
+  const auto chunk_size = GetPushChunkSize(object_reader->GetObjectSize());
+  PushObjectInternal(
+      object_id,
+      node_id,
+      std::make_shared<ChunkObjectReader>(std::move(object_reader), chunk_size),
+      /*from_disk=*/false,
+      stripe);
+}
+
+uint64_t ObjectManager::GetPushChunkSize(uint64_t object_size) const {
+  const uint64_t max_chunk_size = RayConfig::instance().object_manager_max_chunk_size();
+  if (max_chunk_size <= config_.object_chunk_size) {
+    return config_.object_chunk_size;
+  }
+  // Round up to a multiple of the default chunk size, so that a chunk takes a whole
+  // number of push slots.
+  const uint64_t num_default_chunks =
+      (object_size / kTargetChunksPerObject + config_.object_chunk_size - 1) /
+      config_.object_chunk_size;
+  return std::max(config_.object_chunk_size,
+                  std::min(max_chunk_size / config_.object_chunk_size,
+                           num_default_chunks) *
+                      config_.object_chunk_size);
 }
 
 void ObjectManager::PushFromFilesystem(const ObjectID &object_id,
                                        const NodeID &node_id,
-                                       const std::string &spilled_url) {
+                                       const std::string &spilled_url,
+                                       const ChunkStripe &stripe) {
+  auto reader_it = spilled_object_readers_.find(object_id);
+  if (reader_it != spilled_object_readers_.end() &&
+      reader_it->second.first == spilled_url) {
+    if (auto chunk_object_reader = reader_it->second.second.lock()) {
+      // The object is already being pushed to another node, share its chunk reads.
+      PushObjectInternal(
+          object_id, node_id, std::move(chunk_object_reader), /*from_disk=*/true, stripe);
+      return;
+    }
+  }
+
   // SpilledObjectReader::CreateSpilledObjectReader does synchronous IO; schedule it off
   // main thread.
   rpc_service_.post(
-      [this, object_id, node_id, spilled_url, chunk_size = config_.object_chunk_size]() {
+      [this, object_id, node_id, spilled_url, stripe]() {
         auto optional_spilled_object =
             SpilledObjectReader::CreateSpilledObjectReader(spilled_url);
         if (!optional_spilled_object.has_value()) {
@@ -435,10 +529,11 @@ void ObjectManager::PushFromFilesystem(const ObjectID &object_id,
               << "Ignoring stale read request for already deleted object: " << object_id;
           return;
         }
+        auto object_size = optional_spilled_object->GetObjectSize();
         auto chunk_object_reader = std::make_shared<ChunkObjectReader>(
             std::make_shared<SpilledObjectReader>(
                 std::move(optional_spilled_object.value())),
-            chunk_size);
+            GetPushChunkSize(object_size));
 
         // Schedule PushObjectInternal back to main_service as PushObjectInternal access
         // thread unsafe datastructure.
@@ -446,11 +541,31 @@ void ObjectManager::PushFromFilesystem(const ObjectID &object_id,
             [this,
              object_id,
              node_id,
-             chunk_object_reader = std::move(chunk_object_reader)]() {
+             spilled_url,
+             stripe,
+             chunk_object_reader = std::move(chunk_object_reader)]() mutable {
+              // Forget the readers of the spilled objects that are no longer pushed.
+              for (auto it = spilled_object_readers_.begin();
+                   it != spilled_object_readers_.end();) {
+                if (it->second.second.expired()) {
+                  spilled_object_readers_.erase(it++);
+                } else {
+                  ++it;
+                }
+              }
+              auto &entry = spilled_object_readers_[object_id];
+              auto existing_reader = entry.second.lock();
+              if (existing_reader != nullptr && entry.first == spilled_url) {
+                // Another push of the object started meanwhile.
+                chunk_object_reader = std::move(existing_reader);
+              } else {
+                entry = {spilled_url, chunk_object_reader};
+              }
               PushObjectInternal(object_id,
                                  node_id,
                                  std::move(chunk_object_reader),
-                                 /*from_disk=*/true);
+                                 /*from_disk=*/true,
+                                 stripe);
             },
             "ObjectManager.PushLocalSpilledObjectInternal");
       },
@@ -460,7 +575,13 @@ void ObjectManager::PushFromFilesystem(const ObjectID &object_id,
 void ObjectManager::PushObjectInternal(const ObjectID &object_id,
                                        const NodeID &node_id,
                                        std::shared_ptr<ChunkObjectReader> chunk_reader,
-                                       bool from_disk) {
+                                       bool from_disk,
+                                       const ChunkStripe &stripe) {
+  const uint64_t num_chunks = stripe.NumChunks(chunk_reader->GetNumChunks());
+  if (num_chunks == 0) {
+    // The object has fewer chunks than stripes, the other sources push all of them.
+    return;
+  }
   auto rpc_client = GetRpcClient(node_id);
   if (!rpc_client) {
     // Push is best effort, so do nothing here.
@@ -470,16 +591,35 @@ void ObjectManager::PushObjectInternal(const ObjectID &object_id,
   }
 
   RAY_LOG(DEBUG) << "Sending object chunks of " << object_id << " to node " << node_id
-                 << ", number of chunks: " << chunk_reader->GetNumChunks()
+                 << ", number of chunks: " << num_chunks << "/"
+                 << chunk_reader->GetNumChunks()
                  << ", total data size: " << chunk_reader->GetObject().GetObjectSize();
 
+  // Send the chunks on the bulk transport if both nodes have it enabled.
+  absl::optional<RemoteConnectionInfo> bulk_receiver;
+  if (bulk_chunk_sender_ != nullptr) {
+    RemoteConnectionInfo connection_info(node_id);
+    object_directory_->LookupRemoteConnectionInfo(connection_info);
+    if (connection_info.Connected() && connection_info.bulk_port != 0) {
+      bulk_receiver = std::move(connection_info);
+    }
+  }
+
   auto push_id = UniqueID::FromRandom();
+  const int64_t chunk_slots = static_cast<int64_t>(
+      (chunk_reader->GetChunkSize() + config_.object_chunk_size - 1) /
+      config_.object_chunk_size);
   push_manager_->StartPush(
-      node_id, object_id, chunk_reader->GetNumChunks(), [=](int64_t chunk_id) {
+      node_id,
+      object_id,
+      num_chunks,
+      [=](int64_t stripe_chunk_id) {
+        const uint64_t chunk_id = stripe.ChunkIndex(stripe_chunk_id);
         rpc_service_.post(
             [=]() {
               // Post to the multithreaded RPC event loop so that data is copied
               // off of the main thread.
+              const double start_time = absl::GetCurrentTimeNanos() / 1e9;
               SendObjectChunk(
                   push_id,
                   object_id,
@@ -487,29 +627,35 @@ void ObjectManager::PushObjectInternal(const ObjectID &object_id,
                   chunk_id,
                   rpc_client,
                   [=](const Status &status) {
+                    const double rtt_s = absl::GetCurrentTimeNanos() / 1e9 - start_time;
                     // Post back to the main event loop because the
                     // PushManager is thread-safe.
                     main_service_->post(
-                        [this, node_id, object_id]() {
-                          push_manager_->OnChunkComplete(node_id, object_id);
+                        [this, node_id, object_id, status, rtt_s]() {
+                          push_manager_->OnChunkComplete(
+                              node_id, object_id, status, rtt_s);
                         },
                         "ObjectManager.Push");
                   },
                   chunk_reader,
-                  from_disk);
+                  from_disk,
+                  bulk_receiver);
             },
             "ObjectManager.Push");
-      });
+      },
+      chunk_slots);
 }
 
-void ObjectManager::SendObjectChunk(const UniqueID &push_id,
-                                    const ObjectID &object_id,
-                                    const NodeID &node_id,
-                                    uint64_t chunk_index,
-                                    std::shared_ptr<rpc::ObjectManagerClient> rpc_client,
-                                    std::function<void(const Status &)> on_complete,
-                                    std::shared_ptr<ChunkObjectReader> chunk_reader,
-                                    bool from_disk) {
+void ObjectManager::SendObjectChunk(
+    const UniqueID &push_id,
+    const ObjectID &object_id,
+    const NodeID &node_id,
+    uint64_t chunk_index,
+    std::shared_ptr<rpc::ObjectManagerClient> rpc_client,
+    std::function<void(const Status &)> on_complete,
+    std::shared_ptr<ChunkObjectReader> chunk_reader,
+    bool from_disk,
+    const absl::optional<RemoteConnectionInfo> &bulk_receiver) {
   double start_time = absl::GetCurrentTimeNanos() / 1e9;
   rpc::PushRequest push_request;
   // Set request header
@@ -521,21 +667,7 @@ void ObjectManager::SendObjectChunk(const UniqueID &push_id,
   push_request.set_data_size(chunk_reader->GetObject().GetObjectSize());
   push_request.set_metadata_size(chunk_reader->GetObject().GetMetadataSize());
   push_request.set_chunk_index(chunk_index);
-
-  // read a chunk into push_request and handle errors.
-  auto optional_chunk = chunk_reader->GetChunk(chunk_index);
-  if (!optional_chunk.has_value()) {
-    RAY_LOG(DEBUG) << "Read chunk " << chunk_index << " of object " << object_id
-                   << " failed. It may have been evicted.";
-    on_complete(Status::IOError("Failed to read spilled object"));
-    return;
-  }
-  push_request.set_data(std::move(optional_chunk.value()));
-  if (from_disk) {
-    num_bytes_pushed_from_disk_ += push_request.data().length();
-  } else {
-    num_bytes_pushed_from_plasma_ += push_request.data().length();
-  }
+  push_request.set_chunk_size(chunk_reader->GetChunkSize());
 
   // record the time cost between send chunk and receive reply
   rpc::ClientCallback<rpc::PushReply> callback =
@@ -552,6 +684,79 @@ void ObjectManager::SendObjectChunk(const UniqueID &push_id,
         on_complete(status);
       };
 
+  // Send a chunk of an object in plasma straight from the shared memory. The chunk
+  // reader keeps the object pinned until the chunk is sent.
+  std::vector<absl::string_view> chunk;
+  if (!from_disk && RayConfig::instance().object_manager_zero_copy_push() &&
+      chunk_reader->GetChunkInMemory(chunk_index, &chunk)) {
+    uint64_t chunk_size = 0;
+    for (const auto &part : chunk) {
+      chunk_size += part.size();
+    }
+    num_bytes_pushed_from_plasma_ += chunk_size;
+    AddPeerBytes(node_id, chunk_size, 0);
+    if (bulk_receiver.has_value()) {
+      bulk_chunk_sender_->SendChunk(
+          *bulk_receiver,
+          push_request,
+          std::move(chunk),
+          std::move(chunk_reader),
+          [callback](const Status &status) { callback(status, rpc::PushReply()); });
+    } else {
+      rpc_client->PushChunk(push_request, chunk, chunk_reader, callback);
+    }
+    return;
+  }
+
+  if (from_disk) {
+    // Share the read of the chunk with the concurrent pushes of the object to other
+    // nodes, and send it without copying it into the request.
+    auto shared_chunk = chunk_reader->GetSharedChunk(chunk_index);
+    if (shared_chunk == nullptr) {
+      RAY_LOG(DEBUG) << "Read chunk " << chunk_index << " of object " << object_id
+                     << " failed. It may have been deleted.";
+      on_complete(Status::IOError("Failed to read spilled object"));
+      return;
+    }
+    num_bytes_pushed_from_disk_ += shared_chunk->size();
+    AddPeerBytes(node_id, shared_chunk->size(), 0);
+    std::vector<absl::string_view> chunk_parts{*shared_chunk};
+    if (bulk_receiver.has_value()) {
+      bulk_chunk_sender_->SendChunk(
+          *bulk_receiver,
+          push_request,
+          std::move(chunk_parts),
+          std::move(shared_chunk),
+          [callback](const Status &status) { callback(status, rpc::PushReply()); });
+    } else {
+      rpc_client->PushChunk(push_request, chunk_parts, shared_chunk, callback);
+    }
+    return;
+  }
+
+  // read a chunk into push_request and handle errors.
+  auto optional_chunk = chunk_reader->GetChunk(chunk_index);
+  if (!optional_chunk.has_value()) {
+    RAY_LOG(DEBUG) << "Read chunk " << chunk_index << " of object " << object_id
+                   << " failed. It may have been evicted.";
+    on_complete(Status::IOError("Failed to read spilled object"));
+    return;
+  }
+  push_request.set_data(std::move(optional_chunk.value()));
+  num_bytes_pushed_from_plasma_ += push_request.data().length();
+  AddPeerBytes(node_id, push_request.data().length(), 0);
+
+  if (bulk_receiver.has_value()) {
+    auto data = std::make_shared<std::string>(std::move(*push_request.mutable_data()));
+    push_request.clear_data();
+    bulk_chunk_sender_->SendChunk(
+        *bulk_receiver,
+        push_request,
+        {*data},
+        data,
+        [callback](const Status &status) { callback(status, rpc::PushReply()); });
+    return;
+  }
   rpc_client->Push(push_request, callback);
 }
 
@@ -559,6 +764,12 @@ void ObjectManager::SendObjectChunk(const UniqueID &push_id,
 void ObjectManager::HandlePush(const rpc::PushRequest &request,
                                rpc::PushReply *reply,
                                rpc::SendReplyCallback send_reply_callback) {
+  HandlePushedChunk(request, request.data());
+  send_reply_callback(Status::OK(), nullptr, nullptr);
+}
+
+void ObjectManager::HandlePushedChunk(const rpc::PushRequest &request,
+                                      const std::string &data) {
   ObjectID object_id = ObjectID::FromBinary(request.object_id());
   NodeID node_id = NodeID::FromBinary(request.node_id());
 
@@ -567,10 +778,15 @@ void ObjectManager::HandlePush(const rpc::PushRequest &request,
   uint64_t metadata_size = request.metadata_size();
   uint64_t data_size = request.data_size();
   const rpc::Address &owner_address = request.owner_address();
-  const std::string &data = request.data();
 
-  bool success = ReceiveObjectChunk(
-      node_id, object_id, owner_address, data_size, metadata_size, chunk_index, data);
+  bool success = ReceiveObjectChunk(node_id,
+                                    object_id,
+                                    owner_address,
+                                    data_size,
+                                    metadata_size,
+                                    chunk_index,
+                                    request.chunk_size(),
+                                    data);
   num_chunks_received_total_++;
   if (!success) {
     num_chunks_received_total_failed_++;
@@ -579,8 +795,49 @@ void ObjectManager::HandlePush(const rpc::PushRequest &request,
                   << num_chunks_received_total_failed_ << "/"
                   << num_chunks_received_total_ << " failed";
   }
+}
 
-  send_reply_callback(Status::OK(), nullptr, nullptr);
+BulkChunkReceiver::ChunkBuffer ObjectManager::ProvideChunkBuffer(
+    const rpc::PushRequest &request, uint64_t size) {
+  const ObjectID object_id = ObjectID::FromBinary(request.object_id());
+  const NodeID node_id = NodeID::FromBinary(request.node_id());
+  const uint64_t chunk_index = request.chunk_index();
+  // Chunks that won't be received are passed to HandlePushedChunk, which drops them.
+  if (!pull_manager_->IsObjectActive(object_id)) {
+    return {};
+  }
+  auto chunk = buffer_pool_.CreateChunkForWrite(object_id,
+                                                request.owner_address(),
+                                                request.data_size(),
+                                                request.metadata_size(),
+                                                chunk_index,
+                                                request.chunk_size());
+  if (!chunk.second.ok()) {
+    return {};
+  }
+  if (!pull_manager_->IsObjectActive(object_id) ||
+      chunk.first.buffer_length != size) {
+    // Same as in ReceiveObjectChunk, the object may have been deactivated right
+    // before creating the chunk.
+    buffer_pool_.FinishChunk(object_id, chunk_index, /*success=*/false);
+    if (!pull_manager_->IsObjectActive(object_id)) {
+      buffer_pool_.AbortCreate(object_id);
+    }
+    return {};
+  }
+  BulkChunkReceiver::ChunkBuffer buffer;
+  buffer.data = chunk.first.data;
+  buffer.size = size;
+  buffer.on_done = [this, object_id, node_id, chunk_index, size](bool success) {
+    buffer_pool_.FinishChunk(object_id, chunk_index, success);
+    num_chunks_received_total_++;
+    num_bytes_received_total_ += size;
+    AddPeerBytes(node_id, 0, size);
+    if (!success) {
+      num_chunks_received_total_failed_++;
+    }
+  };
+  return buffer;
 }
 
 bool ObjectManager::ReceiveObjectChunk(const NodeID &node_id,
@@ -589,8 +846,10 @@ bool ObjectManager::ReceiveObjectChunk(const NodeID &node_id,
                                        uint64_t data_size,
                                        uint64_t metadata_size,
                                        uint64_t chunk_index,
+                                       uint64_t chunk_size,
                                        const std::string &data) {
   num_bytes_received_total_ += data.size();
+  AddPeerBytes(node_id, 0, data.size());
   RAY_LOG(DEBUG) << "ReceiveObjectChunk on " << self_node_id_ << " from " << node_id
                  << " of object " << object_id << " chunk index: " << chunk_index
                  << ", chunk data size: " << data.size()
@@ -602,7 +861,7 @@ bool ObjectManager::ReceiveObjectChunk(const NodeID &node_id,
     return false;
   }
   auto chunk_status = buffer_pool_.CreateChunk(
-      object_id, owner_address, data_size, metadata_size, chunk_index);
+      object_id, owner_address, data_size, metadata_size, chunk_index, chunk_size);
   if (!pull_manager_->IsObjectActive(object_id)) {
     num_chunks_received_cancelled_++;
     // This object is no longer being actively pulled. Abort the object. We
@@ -632,8 +891,14 @@ void ObjectManager::HandlePull(const rpc::PullRequest &request,
   RAY_LOG(DEBUG) << "Received pull request from node " << node_id << " for object ["
                  << object_id << "].";
 
-  main_service_->post([this, object_id, node_id]() { Push(object_id, node_id); },
-                      "ObjectManager.HandlePull");
+  ChunkStripe stripe;
+  if (request.num_stripes() > 1 && request.stripe_index() < request.num_stripes()) {
+    stripe.index = request.stripe_index();
+    stripe.count = request.num_stripes();
+  }
+  main_service_->post(
+      [this, object_id, node_id, stripe]() { Push(object_id, node_id, stripe); },
+      "ObjectManager.HandlePull");
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
 
@@ -648,6 +913,64 @@ void ObjectManager::HandleFreeObjects(const rpc::FreeObjectsRequest &request,
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
 
+void ObjectManager::RestoreFromFilesystem(const ObjectID &object_id,
+                                          const std::string &spilled_url,
+                                          std::function<void(const Status &)> callback) {
+  rpc_service_.post(
+      [this, object_id, spilled_url, callback]() {
+        auto optional_spilled_object =
+            SpilledObjectReader::CreateSpilledObjectReader(spilled_url);
+        if (!optional_spilled_object.has_value()) {
+          main_service_->post(
+              [callback, spilled_url]() {
+                callback(Status::IOError("Failed to read spilled object " + spilled_url));
+              },
+              "ObjectManager.RestoreFromFilesystem");
+          return;
+        }
+        auto object_size = optional_spilled_object->GetObjectSize();
+        auto chunk_reader = std::make_shared<ChunkObjectReader>(
+            std::make_shared<SpilledObjectReader>(
+                std::move(optional_spilled_object.value())),
+            GetPushChunkSize(object_size));
+        const uint64_t num_chunks = chunk_reader->GetNumChunks();
+        auto num_chunks_remaining = std::make_shared<std::atomic<uint64_t>>(num_chunks);
+        auto num_chunks_failed = std::make_shared<std::atomic<uint64_t>>(0);
+        for (uint64_t chunk_index = 0; chunk_index < num_chunks; chunk_index++) {
+          // Read the chunks in parallel, each from its own range of the file.
+          rpc_service_.post(
+              [=]() {
+                const auto &object = chunk_reader->GetObject();
+                auto chunk = chunk_reader->GetChunk(chunk_index);
+                if (!chunk.has_value() ||
+                    !ReceiveObjectChunk(self_node_id_,
+                                        object_id,
+                                        object.GetOwnerAddress(),
+                                        object.GetDataSize(),
+                                        object.GetMetadataSize(),
+                                        chunk_index,
+                                        chunk_reader->GetChunkSize(),
+                                        chunk.value())) {
+                  num_chunks_failed->fetch_add(1);
+                }
+                if (num_chunks_remaining->fetch_sub(1) != 1) {
+                  return;
+                }
+                const auto status =
+                    num_chunks_failed->load() == 0
+                        ? Status::OK()
+                        : Status::IOError("Failed to restore " +
+                                          std::to_string(num_chunks_failed->load()) +
+                                          " chunks of " + object_id.Hex());
+                main_service_->post([callback, status]() { callback(status); },
+                                    "ObjectManager.RestoreFromFilesystem");
+              },
+              "ObjectManager.RestoreChunkFromFilesystem");
+        }
+      },
+      "ObjectManager.CreateSpilledObject");
+}
+
 void ObjectManager::FreeObjects(const std::vector<ObjectID> &object_ids,
                                 bool local_only) {
   buffer_pool_.FreeObjects(object_ids);
@@ -711,7 +1034,7 @@ std::shared_ptr<rpc::ObjectManagerClient> ObjectManager::GetRpcClient(
   return it->second;
 }
 
-std::string ObjectManager::DebugString() const {
+std::string ObjectManager::DebugString(bool full) const {
   std::stringstream result;
   result << "ObjectManager:";
   result << "\n- num local objects: " << local_objects_.size();
@@ -727,7 +1050,7 @@ std::string ObjectManager::DebugString() const {
   result << "\n" << push_manager_->DebugString();
   result << "\n" << object_directory_->DebugString();
   result << "\n" << buffer_pool_.DebugString();
-  result << "\n" << pull_manager_->DebugString();
+  result << "\n" << pull_manager_->DebugString(full);
   return result.str();
 }
 
@@ -738,6 +1061,8 @@ void ObjectManager::RecordMetrics() {
   stats::ObjectStoreUsedMemory().Record(used_memory_);
   stats::ObjectStoreFallbackMemory().Record(
       plasma::plasma_store_runner->GetFallbackAllocated());
+  stats::ObjectStoreSmallObjectUnusedMemory().Record(
+      plasma::plasma_store_runner->GetSmallObjectUnusedBytes());
   stats::ObjectStoreLocalObjects().Record(local_objects_.size());
   stats::ObjectManagerPullRequests().Record(pull_manager_->NumActiveRequests());
 
@@ -755,6 +1080,25 @@ void ObjectManager::RecordMetrics() {
                                                           "FailedCancelled");
   ray::stats::STATS_object_manager_received_chunks.Record(
       num_chunks_received_failed_due_to_plasma_, "FailedPlasmaFull");
+
+  absl::MutexLock lock(&peer_bytes_mu_);
+  const int64_t now_ns = absl::GetCurrentTimeNanos();
+  const double period_s = std::max<int64_t>(now_ns - last_metrics_time_ns_, 1) / 1e9;
+  last_metrics_time_ns_ = now_ns;
+  for (auto it = peer_bytes_.begin(); it != peer_bytes_.end();) {
+    const std::string peer = it->first.Hex();
+    ray::stats::STATS_object_manager_peer_throughput_bytes_per_s.Record(
+        it->second.sent / period_s, {{"Direction", "Sent"}, {"PeerNode", peer}});
+    ray::stats::STATS_object_manager_peer_throughput_bytes_per_s.Record(
+        it->second.received / period_s, {{"Direction", "Received"}, {"PeerNode", peer}});
+    // Keep the peers that are idle until their throughput has been recorded as 0.
+    if (it->second.sent == 0 && it->second.received == 0) {
+      peer_bytes_.erase(it++);
+    } else {
+      it->second = PeerBytes();
+      it++;
+    }
+  }
 }
 
 void ObjectManager::FillObjectStoreStats(rpc::GetNodeStatsReply *reply) const {
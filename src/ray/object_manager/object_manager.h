@@ -28,11 +28,13 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/id.h"
 #include "ray/common/ray_config.h"
 #include "ray/common/status.h"
+#include "ray/object_manager/bulk_chunk_transport.h"
 #include "ray/object_manager/chunk_object_reader.h"
 #include "ray/object_manager/common.h"
 #include "ray/object_manager/object_buffer_pool.h"
@@ -104,7 +106,8 @@ class ObjectStoreRunner {
 class ObjectManagerInterface {
  public:
   virtual uint64_t Pull(const std::vector<rpc::ObjectReference> &object_refs,
-                        BundlePriority prio) = 0;
+                        BundlePriority prio,
+                        const PullOptions &options) = 0;
   virtual void CancelPull(uint64_t request_id) = 0;
   virtual bool PullRequestActiveOrWaitingForMetadata(uint64_t request_id) const = 0;
   virtual ~ObjectManagerInterface(){};
@@ -149,6 +152,9 @@ class ObjectManager : public ObjectManagerInterface,
   /// Get the port of the object manager rpc server.
   int GetServerPort() const { return object_manager_server_.GetPort(); }
 
+  /// Get the port of the bulk chunk receiver, 0 if chunks are only received on gRPC.
+  int GetBulkPort() const { return bulk_port_; }
+
   bool PullRequestActiveOrWaitingForMetadata(uint64_t pull_request_id) const override {
     return pull_manager_->PullRequestActiveOrWaitingForMetadata(pull_request_id);
   }
@@ -194,17 +200,23 @@ class ObjectManager : public ObjectManagerInterface,
   ///
   /// \param object_id The object's object id.
   /// \param node_id The remote node's id.
+  /// \param stripe The chunks of the object to push. An object that is not local yet
+  /// is pushed whole once it is.
   /// \return Void.
-  void Push(const ObjectID &object_id, const NodeID &node_id);
+  void Push(const ObjectID &object_id,
+            const NodeID &node_id,
+            const ChunkStripe &stripe = ChunkStripe());
 
   /// Pull a bundle of objects. This will attempt to make all objects in the
   /// bundle local until the request is canceled with the returned ID.
   ///
   /// \param object_refs The bundle of objects that must be made local.
   /// \param prio The bundle priority.
+  /// \param options The order of the bundle among those of the same priority.
   /// \return A request ID that can be used to cancel the request.
   uint64_t Pull(const std::vector<rpc::ObjectReference> &object_refs,
-                BundlePriority prio) override;
+                BundlePriority prio,
+                const PullOptions &options) override;
 
   /// Cancels the pull request with the given ID. This cancels any fetches for
   /// objects that were passed to the original pull request, if no other pull
@@ -220,10 +232,24 @@ class ObjectManager : public ObjectManagerInterface,
   ///                   or send it to all the object stores.
   void FreeObjects(const std::vector<ObjectID> &object_ids, bool local_only);
 
+  /// Restore an object spilled to the local filesystem into the object store. The
+  /// chunks of the object are read and written in parallel on the RPC threads, as if
+  /// they were pushed by this node, so the object must be actively pulled.
+  ///
+  /// \param object_id The object to restore.
+  /// \param spilled_url The URL of the spilled object.
+  /// \param callback Called on the main thread once the object is restored, or it
+  /// failed to.
+  void RestoreFromFilesystem(const ObjectID &object_id,
+                             const std::string &spilled_url,
+                             std::function<void(const Status &)> callback);
+
   /// Returns debug string for class.
   ///
+  /// \param full Whether to also include the details that take a walk over the
+  /// pulled objects.
   /// \return string.
-  std::string DebugString() const;
+  std::string DebugString(bool full = false) const;
 
   /// Record the internal stats.
   void RecordMetrics();
@@ -260,17 +286,29 @@ class ObjectManager : public ObjectManagerInterface,
   ///
   /// \param object_id The object's object id.
   /// \param node_id The remote node's id.
+  /// \param stripe The chunks of the object to push.
   /// \return Void.
-  void PushLocalObject(const ObjectID &object_id, const NodeID &node_id);
+  void PushLocalObject(const ObjectID &object_id,
+                       const NodeID &node_id,
+                       const ChunkStripe &stripe);
 
   /// Pushing a known spilled object to a remote object manager.
   /// \param object_id The object's object id.
   /// \param node_id The remote node's id.
   /// \param spilled_url The url of the spilled object.
+  /// \param stripe The chunks of the object to push.
   /// \return Void.
   void PushFromFilesystem(const ObjectID &object_id,
                           const NodeID &node_id,
-                          const std::string &spilled_url);
+                          const std::string &spilled_url,
+                          const ChunkStripe &stripe);
+
+  /// Get the size of the chunks to push an object in. Large objects are pushed in
+  /// larger chunks, up to object_manager_max_chunk_size.
+  ///
+  /// \param object_size The size of the object data and metadata.
+  /// \return The chunk size, a multiple of the default chunk size.
+  uint64_t GetPushChunkSize(uint64_t object_size) const;
 
   /// The internal implementation of pushing an object.
   ///
@@ -279,11 +317,13 @@ class ObjectManager : public ObjectManagerInterface,
   /// \param chunk_reader Chunk reader used to read a chunk of the object
   /// \param from_disk Whether chunk is being read from disk or plasma. This is
   /// used only for metrics.
+  /// \param stripe The chunks of the object to push.
   /// Status::OK() if the read succeeded.
   void PushObjectInternal(const ObjectID &object_id,
                           const NodeID &node_id,
                           std::shared_ptr<ChunkObjectReader> chunk_reader,
-                          bool from_disk);
+                          bool from_disk,
+                          const ChunkStripe &stripe);
 
   /// Send one chunk of the object to remote object manager
   ///
@@ -298,6 +338,8 @@ class ObjectManager : public ObjectManagerInterface,
   /// \param chunk_reader Chunk reader used to read a chunk of the object
   /// \param from_disk Whether chunk is being read from disk or plasma. This is
   /// used only for metrics.
+  /// \param bulk_receiver The remote bulk chunk receiver to send the chunk to, instead
+  /// of the rpc client. Empty if the remote node has no bulk receiver.
   void SendObjectChunk(const UniqueID &push_id,
                        const ObjectID &object_id,
                        const NodeID &node_id,
@@ -305,7 +347,8 @@ class ObjectManager : public ObjectManagerInterface,
                        std::shared_ptr<rpc::ObjectManagerClient> rpc_client,
                        std::function<void(const Status &)> on_complete,
                        std::shared_ptr<ChunkObjectReader> chunk_reader,
-                       bool from_disk);
+                       bool from_disk,
+                       const absl::optional<RemoteConnectionInfo> &bulk_receiver);
 
   /// Handle starting, running, and stopping asio rpc_service.
   void StartRpcService();
@@ -322,6 +365,11 @@ class ObjectManager : public ObjectManagerInterface,
   /// as soon as possible.
   void HandleObjectDeleted(const ObjectID &object_id);
 
+  /// Count the bytes of object chunks sent to or received from a peer node, for the
+  /// per-peer throughput metric. Thread-safe.
+  void AddPeerBytes(const NodeID &node_id, uint64_t sent_bytes, uint64_t received_bytes)
+      LOCKS_EXCLUDED(peer_bytes_mu_);
+
   /// This is used to notify the main thread that the sending of a chunk has
   /// completed.
   ///
@@ -360,6 +408,8 @@ class ObjectManager : public ObjectManagerInterface,
   /// \param data_size Data size
   /// \param metadata_size Metadata size
   /// \param chunk_index Chunk index
+  /// \param chunk_size The size of the chunks the sender splits the object into, 0
+  /// for the default chunk size.
   /// \param data Chunk data
   /// \return Whether the chunk was successfully written into the local object
   /// store. This can fail if the chunk was already received in the past, or if
@@ -370,13 +420,34 @@ class ObjectManager : public ObjectManagerInterface,
                           uint64_t data_size,
                           uint64_t metadata_size,
                           uint64_t chunk_index,
+                          uint64_t chunk_size,
                           const std::string &data);
 
+  /// Handle a chunk pushed by a remote object manager, either on gRPC or on the bulk
+  /// chunk transport.
+  ///
+  /// \param request The push request describing the chunk.
+  /// \param data The chunk data.
+  void HandlePushedChunk(const rpc::PushRequest &request, const std::string &data);
+
+  /// Provide the memory in the local object store to receive a chunk pushed on the
+  /// bulk chunk transport into, so that its data is written once.
+  ///
+  /// \param request The push request describing the chunk.
+  /// \param size The size of the chunk data.
+  /// \return The chunk's memory, or a buffer without memory if the chunk can't be
+  /// received in place, in which case it is passed to HandlePushedChunk.
+  BulkChunkReceiver::ChunkBuffer ProvideChunkBuffer(const rpc::PushRequest &request,
+                                                    uint64_t size);
+
   /// Send pull request
   ///
   /// \param object_id Object id
   /// \param client_id Remote server client id
-  void SendPullRequest(const ObjectID &object_id, const NodeID &client_id);
+  /// \param stripe The chunks of the object to pull from the remote server
+  void SendPullRequest(const ObjectID &object_id,
+                       const NodeID &client_id,
+                       const ChunkStripe &stripe);
 
   /// Get the rpc client according to the node ID
   ///
@@ -428,6 +499,13 @@ class ObjectManager : public ObjectManagerInterface,
       absl::flat_hash_map<NodeID, std::unique_ptr<boost::asio::deadline_timer>>>
       unfulfilled_push_requests_;
 
+  /// The readers of the spilled objects being pushed, with their spilled URLs, so that
+  /// concurrent pushes of the same spilled object to different nodes share one reader,
+  /// and so read each chunk from the file once. Only accessed on the main thread.
+  absl::flat_hash_map<ObjectID,
+                      std::pair<std::string, std::weak_ptr<ChunkObjectReader>>>
+      spilled_object_readers_;
+
   /// The gPRC server.
   rpc::GrpcServer object_manager_server_;
 
@@ -441,6 +519,15 @@ class ObjectManager : public ObjectManagerInterface,
   absl::flat_hash_map<NodeID, std::shared_ptr<rpc::ObjectManagerClient>>
       remote_object_manager_clients_;
 
+  /// Sends object chunks outside of gRPC, nullptr if the bulk transport is disabled.
+  std::unique_ptr<BulkChunkSender> bulk_chunk_sender_;
+
+  /// Receives object chunks outside of gRPC, nullptr if the bulk transport is disabled.
+  std::unique_ptr<BulkChunkReceiver> bulk_chunk_receiver_;
+
+  /// The port of the bulk chunk receiver, 0 if it is disabled.
+  int bulk_port_ = 0;
+
   /// Callback to trigger direct restoration of an object.
   const RestoreSpilledObjectCallback restore_spilled_object_;
 
@@ -480,6 +567,22 @@ class ObjectManager : public ObjectManagerInterface,
   /// create the object in plasma. This is usually due to out-of-memory in
   /// plasma.
   size_t num_chunks_received_failed_due_to_plasma_ = 0;
+
+  /// The bytes sent to and received from a peer node.
+  struct PeerBytes {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+  };
+
+  /// Protects the per-peer byte counts, which are updated on the RPC threads.
+  absl::Mutex peer_bytes_mu_;
+
+  /// The bytes sent to and received from each peer node since the metrics were last
+  /// recorded. Peers are removed once a period without transfers has been recorded.
+  absl::flat_hash_map<NodeID, PeerBytes> peer_bytes_ GUARDED_BY(peer_bytes_mu_);
+
+  /// When the metrics were last recorded.
+  int64_t last_metrics_time_ns_ GUARDED_BY(peer_bytes_mu_) = absl::GetCurrentTimeNanos();
 };
 
 }  // namespace ray
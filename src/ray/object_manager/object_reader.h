@@ -53,5 +53,14 @@ class IObjectReader {
   virtual bool ReadFromMetadataSection(uint64_t offset,
                                        uint64_t size,
                                        char *output) const = 0;
+
+  /// Return the memory of the data section if the object is in memory, so that it can
+  /// be sent without a copy. Return nullptr if it can only be read with
+  /// `ReadFromDataSection`.
+  virtual const char *GetDataSectionAddress() const { return nullptr; }
+
+  /// Return the memory of the metadata section if the object is in memory. Return
+  /// nullptr if it can only be read with `ReadFromMetadataSection`.
+  virtual const char *GetMetadataSectionAddress() const { return nullptr; }
 };
 }  // namespace ray
@@ -14,24 +14,35 @@
 
 #include "ray/object_manager/ownership_based_object_directory.h"
 
+#include "ray/common/asio/asio_util.h"
 #include "ray/stats/metric_defs.h"
 
 namespace ray {
 
+namespace {
+
+/// The maximum number of objects whose locations are cached without callbacks. Each
+/// of them keeps a subscription at its owner.
+constexpr size_t kMaxCachedLocations = 10000;
+
+}  // namespace
+
 OwnershipBasedObjectDirectory::OwnershipBasedObjectDirectory(
     instrumented_io_context &io_service,
     std::shared_ptr<gcs::GcsClient> &gcs_client,
     pubsub::SubscriberInterface *object_location_subscriber,
     rpc::CoreWorkerClientPool *owner_client_pool,
     int64_t max_object_report_batch_size,
-    std::function<void(const ObjectID &, const rpc::ErrorType &)> mark_as_failed)
+    std::function<void(const ObjectID &, const rpc::ErrorType &)> mark_as_failed,
+    int64_t location_cache_ttl_ms)
     : io_service_(io_service),
       gcs_client_(gcs_client),
       client_call_manager_(io_service),
       object_location_subscriber_(object_location_subscriber),
       owner_client_pool_(owner_client_pool),
       kMaxObjectReportBatchSize(max_object_report_batch_size),
-      mark_as_failed_(mark_as_failed) {}
+      mark_as_failed_(mark_as_failed),
+      location_cache_ttl_ms_(location_cache_ttl_ms) {}
 
 namespace {
 
@@ -346,6 +357,12 @@ ray::Status OwnershipBasedObjectDirectory::SubscribeObjectLocations(
     auto failure_callback = [this, owner_address](const std::string &object_id_binary,
                                                   const Status &status) {
       const auto object_id = ObjectID::FromBinary(object_id_binary);
+      auto it = listeners_.find(object_id);
+      if (it != listeners_.end() && it->second.cached) {
+        // Nobody needs the object anymore, its locations were only cached.
+        RemoveListener(it, /*unsubscribe=*/false);
+        return;
+      }
       rpc::WorkerObjectLocationsPubMessage location_info;
       if (!status.ok()) {
         RAY_LOG(INFO) << "Failed to get the location for " << object_id
@@ -382,12 +399,18 @@ ray::Status OwnershipBasedObjectDirectory::SubscribeObjectLocations(
     auto location_state = LocationListenerState();
     location_state.owner_address = owner_address;
     it = listeners_.emplace(object_id, std::move(location_state)).first;
+    num_listeners_per_owner_[WorkerID::FromBinary(owner_address.worker_id())]++;
   }
   auto &listener_state = it->second;
 
   if (listener_state.callbacks.count(callback_id) > 0) {
     return Status::OK();
   }
+  if (listener_state.cached) {
+    // The object is needed again while its locations are cached.
+    listener_state.cached = false;
+    num_cached_listeners_--;
+  }
   listener_state.callbacks.emplace(callback_id, callback);
 
   // If we previously received some notifications about the object's locations,
@@ -433,17 +456,52 @@ ray::Status OwnershipBasedObjectDirectory::UnsubscribeObjectLocations(
   if (entry == listeners_.end()) {
     return Status::OK();
   }
-  entry->second.callbacks.erase(callback_id);
-  if (entry->second.callbacks.empty()) {
+  if (entry->second.callbacks.erase(callback_id) == 0 ||
+      !entry->second.callbacks.empty()) {
+    return Status::OK();
+  }
+  if (location_cache_ttl_ms_ <= 0 || num_cached_listeners_ >= kMaxCachedLocations) {
+    RemoveListener(entry, /*unsubscribe=*/true);
+    return Status::OK();
+  }
+  // Keep the subscription for a while, so that the cached locations are kept up to date
+  // by the owner, and are available right away if the object is needed again.
+  entry->second.cached = true;
+  num_cached_listeners_++;
+  const uint64_t num_unsubscribes = ++entry->second.num_unsubscribes;
+  execute_after(
+      io_service_,
+      [this, object_id, num_unsubscribes]() {
+        auto it = listeners_.find(object_id);
+        if (it != listeners_.end() && it->second.cached &&
+            it->second.num_unsubscribes == num_unsubscribes) {
+          RemoveListener(it, /*unsubscribe=*/true);
+        }
+      },
+      location_cache_ttl_ms_);
+  return Status::OK();
+}
+
+void OwnershipBasedObjectDirectory::RemoveListener(ListenerMap::iterator it,
+                                                   bool unsubscribe) {
+  const auto &owner_address = it->second.owner_address;
+  if (unsubscribe) {
     object_location_subscriber_->Unsubscribe(
         rpc::ChannelType::WORKER_OBJECT_LOCATIONS_CHANNEL,
-        entry->second.owner_address,
-        object_id.Binary());
-    owner_client_pool_->Disconnect(
-        WorkerID::FromBinary(entry->second.owner_address.worker_id()));
-    listeners_.erase(entry);
+        owner_address,
+        it->first.Binary());
   }
-  return Status::OK();
+  if (it->second.cached) {
+    num_cached_listeners_--;
+  }
+  const auto owner_id = WorkerID::FromBinary(owner_address.worker_id());
+  auto owner_it = num_listeners_per_owner_.find(owner_id);
+  RAY_CHECK(owner_it != num_listeners_per_owner_.end());
+  if (--owner_it->second == 0) {
+    num_listeners_per_owner_.erase(owner_it);
+    owner_client_pool_->Disconnect(owner_id);
+  }
+  listeners_.erase(it);
 }
 
 void OwnershipBasedObjectDirectory::LookupRemoteConnectionInfo(
@@ -454,6 +512,8 @@ void OwnershipBasedObjectDirectory::LookupRemoteConnectionInfo(
     RAY_CHECK(result_node_id == connection_info.node_id);
     connection_info.ip = node_info->node_manager_address();
     connection_info.port = static_cast<uint16_t>(node_info->object_manager_port());
+    connection_info.bulk_port =
+        static_cast<uint16_t>(node_info->object_manager_bulk_port());
   }
 }
 
@@ -498,7 +558,8 @@ void OwnershipBasedObjectDirectory::HandleNodeRemoved(const NodeID &node_id) {
 }
 
 void OwnershipBasedObjectDirectory::RecordMetrics(uint64_t duration_ms) {
-  stats::ObjectDirectoryLocationSubscriptions.Record(listeners_.size());
+  stats::ObjectDirectoryLocationSubscriptions.Record(listeners_.size() -
+                                                     num_cached_listeners_);
 
   // Record number of object location updates per second.
   metrics_num_object_location_updates_per_second_ =
@@ -530,7 +591,8 @@ std::string OwnershipBasedObjectDirectory::DebugString() const {
   std::stringstream result;
   result << std::fixed << std::setprecision(3);
   result << "OwnershipBasedObjectDirectory:";
-  result << "\n- num listeners: " << listeners_.size();
+  result << "\n- num listeners: " << listeners_.size() - num_cached_listeners_;
+  result << "\n- num cached object locations: " << num_cached_listeners_;
   result << "\n- cumulative location updates: "
          << cum_metrics_num_object_location_updates_;
   result << "\n- num location updates per second: "
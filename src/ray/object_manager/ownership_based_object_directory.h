@@ -42,13 +42,18 @@ class OwnershipBasedObjectDirectory : public IObjectDirectory {
   /// usually be the same event loop that the given gcs_client runs on.
   /// \param gcs_client A Ray GCS client to request object and node
   /// information from.
+  /// \param location_cache_ttl_ms How long to keep the subscription to the locations of
+  /// an object after its last callback is unsubscribed, so that the locations stay
+  /// cached, and up to date, in case the object is needed again. 0 means the
+  /// subscription is removed right away.
   OwnershipBasedObjectDirectory(
       instrumented_io_context &io_service,
       std::shared_ptr<gcs::GcsClient> &gcs_client,
       pubsub::SubscriberInterface *object_location_subscriber,
       rpc::CoreWorkerClientPool *owner_client_pool,
       int64_t max_object_report_batch_size,
-      std::function<void(const ObjectID &, const rpc::ErrorType &)> mark_as_failed);
+      std::function<void(const ObjectID &, const rpc::ErrorType &)> mark_as_failed,
+      int64_t location_cache_ttl_ms = 0);
 
   virtual ~OwnershipBasedObjectDirectory() {}
 
@@ -112,14 +117,27 @@ class OwnershipBasedObjectDirectory : public IObjectDirectory {
     bool subscribed;
     /// The address of the owner.
     rpc::Address owner_address;
+    /// Whether the object has no callbacks, and its locations are only cached.
+    bool cached = false;
+    /// The number of times the last callback was unsubscribed, so that a timer that
+    /// removes the cached locations can tell whether the object was needed again since.
+    uint64_t num_unsubscribes = 0;
   };
 
+  using ListenerMap = absl::flat_hash_map<ObjectID, LocationListenerState>;
+
   /// Reference to the event loop.
   instrumented_io_context &io_service_;
   /// Reference to the gcs client.
   std::shared_ptr<gcs::GcsClient> gcs_client_;
-  /// Info about subscribers to object locations.
-  absl::flat_hash_map<ObjectID, LocationListenerState> listeners_;
+  /// Info about subscribers to object locations. This includes the objects whose
+  /// locations are cached, which have no callbacks.
+  ListenerMap listeners_;
+  /// The number of listeners per owner, so that the client to an owner is kept as long
+  /// as any object of the owner is subscribed to.
+  absl::flat_hash_map<WorkerID, size_t> num_listeners_per_owner_;
+  /// The number of listeners that only cache the locations of their object.
+  size_t num_cached_listeners_ = 0;
   /// The client call manager used to create the RPC clients.
   rpc::ClientCallManager client_call_manager_;
   /// The object location subscriber.
@@ -130,6 +148,8 @@ class OwnershipBasedObjectDirectory : public IObjectDirectory {
   const int64_t kMaxObjectReportBatchSize;
   /// The callback used to mark an object as failed.
   std::function<void(const ObjectID &, const rpc::ErrorType &)> mark_as_failed_;
+  /// How long to cache the locations of an object that has no callbacks.
+  const int64_t location_cache_ttl_ms_;
 
   /// A buffer for batch object location updates.
   /// owner id -> {(FIFO object queue (to avoid starvation), map for the latest update of
@@ -147,6 +167,14 @@ class OwnershipBasedObjectDirectory : public IObjectDirectory {
   std::shared_ptr<rpc::CoreWorkerClientInterface> GetClient(
       const rpc::Address &owner_address);
 
+  /// Remove a listener, and disconnect from its owner if it was the last listener of
+  /// the owner.
+  ///
+  /// \param it The listener to remove.
+  /// \param unsubscribe Whether to unsubscribe from the locations of the object. This
+  /// isn't needed if the subscription already failed.
+  void RemoveListener(ListenerMap::iterator it, bool unsubscribe);
+
   /// Internal callback function used by object location subscription.
   void ObjectLocationSubscriptionCallback(
       const rpc::WorkerObjectLocationsPubMessage &location_info,
@@ -19,23 +19,36 @@
 
 #include "ray/object_manager/plasma/client.h"
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/ioctl.h>
+#endif
+
 #include <algorithm>
 #include <boost/asio.hpp>
 #include <cstring>
 #include <deque>
+#include <list>
 #include <mutex>
+#include <sstream>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/connection.h"
 #include "ray/object_manager/plasma/plasma.h"
 #include "ray/object_manager/plasma/protocol.h"
 #include "ray/object_manager/plasma/shared_memory.h"
+#include "ray/util/util.h"
 
 namespace fb = plasma::flatbuf;
 
@@ -94,6 +107,13 @@ struct ObjectInUseEntry {
   PlasmaObject object;
   /// A flag representing whether the object has been sealed.
   bool is_sealed;
+  /// Whether the object is in the release cache, i.e. the client no longer uses it
+  /// but hasn't released it to the store yet. The count is 0 then.
+  bool is_cached = false;
+  /// The position of the object in the release cache, if it is cached.
+  std::list<ObjectID>::iterator cache_position;
+  /// The time at which the cached object is released to the store.
+  int64_t cache_expiry_ms = 0;
 };
 
 class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Impl> {
@@ -145,14 +165,33 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
              ObjectBuffer *object_buffers,
              bool is_from_worker);
 
+  void GetAsync(const std::vector<ObjectID> &object_ids,
+                int64_t timeout_ms,
+                GetCallback callback,
+                bool is_from_worker);
+
+  Status GetStreaming(const ObjectID &object_id,
+                      int64_t timeout_ms,
+                      ObjectBuffer *object_buffer);
+
+  Status WaitForPrefix(const ObjectID &object_id,
+                       int64_t num_bytes,
+                       int64_t *num_bytes_written);
+
   Status Release(const ObjectID &object_id);
 
+  Status Release(const std::vector<ObjectID> &object_ids);
+
   Status Contains(const ObjectID &object_id, bool *has_object);
 
   Status Abort(const ObjectID &object_id);
 
   Status Seal(const ObjectID &object_id);
 
+  Status Seal(const std::vector<ObjectID> &object_ids);
+
+  Status SealPrefix(const ObjectID &object_id, int64_t num_bytes);
+
   Status Delete(const std::vector<ObjectID> &object_ids);
 
   Status Evict(int64_t num_bytes, int64_t &num_bytes_evicted);
@@ -166,6 +205,36 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
   int64_t store_capacity() { return store_capacity_; }
 
  private:
+  /// A get that was sent without waiting for its reply.
+  struct AsyncGet {
+    std::vector<ObjectID> object_ids;
+    std::vector<ObjectBuffer> object_buffers;
+    GetCallback callback;
+    Status status;
+  };
+
+  using WrapBufferFn = std::function<std::shared_ptr<Buffer>(
+      const ObjectID &, const std::shared_ptr<Buffer> &)>;
+
+  /// Receive the reply to the request that was just sent. Replies to async gets that
+  /// arrive before it are handled on the way.
+  Status ReceiveReply(MessageType message_type, std::vector<uint8_t> *buffer);
+
+  /// Fill in the buffers of the objects of a get reply, and queue the callback of the
+  /// get to run on the reply thread.
+  Status HandleAsyncGetReply(uint64_t request_id, std::vector<uint8_t> *buffer);
+
+  /// Complete all the async gets still waiting for a reply with an error.
+  void FailAsyncGets(const Status &status);
+
+  /// Read the replies to async gets and run their callbacks, until no async gets are
+  /// left. This runs on its own thread, which holds a reference to the client.
+  void RunAsyncGetLoop();
+
+  /// Return a function that wraps the buffers of gotten objects, to release the
+  /// objects when the buffers go out of scope.
+  WrapBufferFn ReleasingBufferWrapper();
+
   /// Helper method to read and process the reply of a create request.
   Status HandleCreateReply(const ObjectID &object_id,
                            const uint8_t *metadata,
@@ -190,17 +259,62 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
   Status GetBuffers(const ObjectID *object_ids,
                     int64_t num_objects,
                     int64_t timeout_ms,
-                    const std::function<std::shared_ptr<Buffer>(
-                        const ObjectID &, const std::shared_ptr<Buffer> &)> &wrap_buffer,
+                    const WrapBufferFn &wrap_buffer,
                     ObjectBuffer *object_buffers,
-                    bool is_from_worker);
+                    bool is_from_worker,
+                    bool allow_partial = false);
+
+  /// Fill in the buffers of the objects that are already in use by this client.
+  ///
+  /// \return Whether all the objects were in use.
+  bool GetBuffersInUse(const ObjectID *object_ids,
+                       int64_t num_objects,
+                       int64_t timeout_ms,
+                       const WrapBufferFn &wrap_buffer,
+                       ObjectBuffer *object_buffers);
+
+  /// Fill in the buffers of the objects that a get reply returns and that weren't
+  /// filled in yet.
+  Status ProcessGetReply(std::vector<uint8_t> &buffer,
+                         const ObjectID *object_ids,
+                         int64_t num_objects,
+                         const WrapBufferFn &wrap_buffer,
+                         ObjectBuffer *object_buffers);
 
   uint8_t *LookupMmappedFile(MEMFD_TYPE store_fd_val);
 
+  /// Keep a sealed object that the client no longer uses in the release cache, so
+  /// that getting it again doesn't need a round trip to the store.
+  void CacheObject(const ObjectID &object_id, ObjectInUseEntry *object_entry);
+
+  /// Take an object out of the release cache, without releasing it to the store.
+  void UncacheObject(ObjectInUseEntry *object_entry);
+
+  /// Take the objects out of the release cache that no longer fit in it or whose
+  /// lease expired, or all of them.
+  ///
+  /// \param all Whether to take all the objects out of the cache.
+  /// 
+eturn The IDs of the objects, which must be released to the store.
+  std::vector<ObjectID> EvictCachedObjects(bool all = false);
+
+  /// Tell the store that the client no longer uses the objects.
+  Status SendRelease(std::vector<ObjectID> object_ids);
+
   void IncrementObjectCount(const ObjectID &object_id,
                             PlasmaObject *object,
                             bool is_sealed);
 
+  /// Map the release ring from the fds that the store sends after the connect reply.
+  Status AttachReleaseRing();
+
+  /// Push the IDs of released objects to the release ring, and wake up the store if
+  /// it may be waiting on an empty ring.
+  ///
+  /// \param object_ids The IDs of the released objects.
+  /// \return The IDs that did not fit, which must be released on the socket.
+  std::vector<ObjectID> PushToReleaseRing(const std::vector<ObjectID> &object_ids);
+
   /// The boost::asio IO context for the client.
   instrumented_io_context main_service_;
   /// The connection to the store service.
@@ -222,13 +336,39 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
   int64_t store_capacity_;
   /// A hash set to record the ids that users want to delete but still in use.
   std::unordered_set<ObjectID> deletion_cache_;
+  /// The sealed objects that the client no longer uses but keeps in use in the store
+  /// for a while, so that getting them again is served locally, oldest first. The
+  /// store doesn't evict or delete them until they are released, so the cache is
+  /// bounded both in size and in how long the objects stay in it.
+  std::list<ObjectID> release_cache_;
+  /// The maximum number of objects in the release cache, 0 if it is disabled.
+  const size_t release_cache_capacity_;
+  /// How long an object stays in the release cache.
+  const int64_t release_cache_lease_ms_;
+  /// The ring that the IDs of released objects are pushed to, nullptr if the store
+  /// did not set one up.
+  std::unique_ptr<ObjectIdRing> release_ring_;
+  /// The eventfd that wakes up the store after a push to an empty release ring.
+  int release_ring_event_fd_ = -1;
+  /// The async gets waiting for their reply, by request ID.
+  absl::flat_hash_map<uint64_t, std::unique_ptr<AsyncGet>> pending_async_gets_;
+  /// The async gets whose callbacks are yet to run on the reply thread.
+  std::vector<std::unique_ptr<AsyncGet>> completed_async_gets_;
+  /// The ID of the next async get. 0 is the ID of gets that wait for their reply.
+  uint64_t next_async_get_id_ = 1;
+  /// Whether the thread that reads the replies to async gets is running.
+  bool async_get_thread_running_ = false;
   /// A mutex which protects this class.
   std::recursive_mutex client_mutex_;
 };
 
 PlasmaBuffer::~PlasmaBuffer() { RAY_UNUSED(client_->Release(object_id_)); }
 
-PlasmaClient::Impl::Impl() : store_capacity_(0) {}
+PlasmaClient::Impl::Impl()
+    : store_capacity_(0),
+      release_cache_capacity_(RayConfig::instance().plasma_client_release_cache_size()),
+      release_cache_lease_ms_(
+          RayConfig::instance().plasma_client_release_cache_lease_ms()) {}
 
 PlasmaClient::Impl::~Impl() {}
 
@@ -267,7 +407,7 @@ bool PlasmaClient::Impl::IsInUse(const ObjectID &object_id) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
   const auto elem = objects_in_use_.find(object_id);
-  return (elem != objects_in_use_.end());
+  return (elem != objects_in_use_.end() && elem->second->count > 0);
 }
 
 void PlasmaClient::Impl::IncrementObjectCount(const ObjectID &object_id,
@@ -287,7 +427,15 @@ void PlasmaClient::Impl::IncrementObjectCount(const ObjectID &object_id,
     object_entry = objects_in_use_[object_id].get();
   } else {
     object_entry = elem->second.get();
-    RAY_CHECK(object_entry->count > 0);
+    if (object_entry->is_cached) {
+      UncacheObject(object_entry);
+    } else {
+      RAY_CHECK(object_entry->count > 0);
+    }
+    if (is_sealed) {
+      // The object was gotten before it was sealed.
+      object_entry->is_sealed = true;
+    }
   }
   // Increment the count of the number of instances of this object that are
   // being used by this client. The corresponding decrement should happen in
@@ -300,7 +448,7 @@ Status PlasmaClient::Impl::HandleCreateReply(const ObjectID &object_id,
                                              uint64_t *retry_with_request_id,
                                              std::shared_ptr<Buffer> *data) {
   std::vector<uint8_t> buffer;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaCreateReply, &buffer));
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaCreateReply, &buffer));
   ObjectID id;
   PlasmaObject object;
   MEMFD_TYPE store_fd;
@@ -428,14 +576,36 @@ Status PlasmaClient::Impl::TryCreateImmediately(const ObjectID &object_id,
   return HandleCreateReply(object_id, metadata, nullptr, data);
 }
 
-Status PlasmaClient::Impl::GetBuffers(
-    const ObjectID *object_ids,
-    int64_t num_objects,
-    int64_t timeout_ms,
-    const std::function<std::shared_ptr<Buffer>(
-        const ObjectID &, const std::shared_ptr<Buffer> &)> &wrap_buffer,
-    ObjectBuffer *object_buffers,
-    bool is_from_worker) {
+Status PlasmaClient::Impl::GetBuffers(const ObjectID *object_ids,
+                                      int64_t num_objects,
+                                      int64_t timeout_ms,
+                                      const WrapBufferFn &wrap_buffer,
+                                      ObjectBuffer *object_buffers,
+                                      bool is_from_worker,
+                                      bool allow_partial) {
+  if (GetBuffersInUse(object_ids, num_objects, timeout_ms, wrap_buffer, object_buffers)) {
+    return Status::OK();
+  }
+
+  // If we get here, then the objects aren't all currently in use by this
+  // client, so we need to send a request to the plasma store.
+  RAY_RETURN_NOT_OK(SendGetRequest(store_conn_,
+                                   &object_ids[0],
+                                   num_objects,
+                                   timeout_ms,
+                                   is_from_worker,
+                                   /*request_id=*/0,
+                                   allow_partial));
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaGetReply, &buffer));
+  return ProcessGetReply(buffer, object_ids, num_objects, wrap_buffer, object_buffers);
+}
+
+bool PlasmaClient::Impl::GetBuffersInUse(const ObjectID *object_ids,
+                                         int64_t num_objects,
+                                         int64_t timeout_ms,
+                                         const WrapBufferFn &wrap_buffer,
+                                         ObjectBuffer *object_buffers) {
   // Fill out the info for the objects that are already in use locally.
   bool all_present = true;
   for (int64_t i = 0; i < num_objects; ++i) {
@@ -444,6 +614,10 @@ Status PlasmaClient::Impl::GetBuffers(
       // This object is not currently in use by this client, so we need to send
       // a request to the store.
       all_present = false;
+    } else if (!object_entry->second->is_sealed && object_entry->second->object.partial) {
+      // This client is reading the object while it's being received. The store
+      // returns it again, as sealed if it was sealed since.
+      all_present = false;
     } else if (!object_entry->second->is_sealed) {
       // This client created the object but hasn't sealed it. If we call Get
       // with no timeout, we will deadlock, because this client won't be able to
@@ -475,17 +649,14 @@ Status PlasmaClient::Impl::GetBuffers(
       IncrementObjectCount(object_ids[i], object, true);
     }
   }
+  return all_present;
+}
 
-  if (all_present) {
-    return Status::OK();
-  }
-
-  // If we get here, then the objects aren't all currently in use by this
-  // client, so we need to send a request to the plasma store.
-  RAY_RETURN_NOT_OK(SendGetRequest(
-      store_conn_, &object_ids[0], num_objects, timeout_ms, is_from_worker));
-  std::vector<uint8_t> buffer;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaGetReply, &buffer));
+Status PlasmaClient::Impl::ProcessGetReply(std::vector<uint8_t> &buffer,
+                                           const ObjectID *object_ids,
+                                           int64_t num_objects,
+                                           const WrapBufferFn &wrap_buffer,
+                                           ObjectBuffer *object_buffers) {
   std::vector<ObjectID> received_object_ids(num_objects);
   std::vector<PlasmaObject> object_data(num_objects);
   PlasmaObject *object;
@@ -535,9 +706,10 @@ Status PlasmaClient::Impl::GetBuffers(
       object_buffers[i].metadata = SharedMemoryBuffer::Slice(
           physical_buf, object->data_size, object->metadata_size);
       object_buffers[i].device_num = object->device_num;
+      object_buffers[i].partial = object->partial;
       // Increment the count of the number of instances of this object that this
       // client is using. Cache the reference to the object.
-      IncrementObjectCount(received_object_ids[i], object, true);
+      IncrementObjectCount(received_object_ids[i], object, !object->partial);
     } else {
       // The object was not retrieved.  The caller can detect this condition
       // by checking the boolean value of the metadata/data buffers.
@@ -548,20 +720,232 @@ Status PlasmaClient::Impl::GetBuffers(
   return Status::OK();
 }
 
+PlasmaClient::Impl::WrapBufferFn PlasmaClient::Impl::ReleasingBufferWrapper() {
+  return [this](const ObjectID &object_id, const std::shared_ptr<Buffer> &buffer) {
+    return std::make_shared<PlasmaBuffer>(shared_from_this(), object_id, buffer);
+  };
+}
+
 Status PlasmaClient::Impl::Get(const std::vector<ObjectID> &object_ids,
                                int64_t timeout_ms,
                                std::vector<ObjectBuffer> *out,
                                bool is_from_worker) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
-  const auto wrap_buffer = [=](const ObjectID &object_id,
-                               const std::shared_ptr<Buffer> &buffer) {
-    return std::make_shared<PlasmaBuffer>(shared_from_this(), object_id, buffer);
-  };
+  if (!release_cache_.empty() && store_conn_) {
+    RAY_RETURN_NOT_OK(SendRelease(EvictCachedObjects()));
+  }
   const size_t num_objects = object_ids.size();
   *out = std::vector<ObjectBuffer>(num_objects);
-  return GetBuffers(
-      &object_ids[0], num_objects, timeout_ms, wrap_buffer, &(*out)[0], is_from_worker);
+  return GetBuffers(&object_ids[0],
+                    num_objects,
+                    timeout_ms,
+                    ReleasingBufferWrapper(),
+                    &(*out)[0],
+                    is_from_worker);
+}
+
+void PlasmaClient::Impl::GetAsync(const std::vector<ObjectID> &object_ids,
+                                  int64_t timeout_ms,
+                                  GetCallback callback,
+                                  bool is_from_worker) {
+#ifdef _WIN32
+  // The replies can't be polled for, so the get waits for its reply.
+  std::vector<ObjectBuffer> object_buffers;
+  Status status = Get(object_ids, timeout_ms, &object_buffers, is_from_worker);
+  callback(status, std::move(object_buffers));
+#else
+  auto get = std::make_unique<AsyncGet>();
+  get->object_ids = object_ids;
+  get->object_buffers.resize(object_ids.size());
+  get->callback = std::move(callback);
+  {
+    std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+    if (!store_conn_) {
+      get->status = Status::IOError("Connection is closed.");
+    } else if (!GetBuffersInUse(get->object_ids.data(),
+                                get->object_ids.size(),
+                                timeout_ms,
+                                ReleasingBufferWrapper(),
+                                get->object_buffers.data())) {
+      const uint64_t request_id = next_async_get_id_++;
+      get->status = SendGetRequest(store_conn_,
+                                   get->object_ids.data(),
+                                   get->object_ids.size(),
+                                   timeout_ms,
+                                   is_from_worker,
+                                   request_id);
+      if (get->status.ok()) {
+        pending_async_gets_.emplace(request_id, std::move(get));
+        if (!async_get_thread_running_) {
+          async_get_thread_running_ = true;
+          std::thread(&PlasmaClient::Impl::RunAsyncGetLoop, shared_from_this()).detach();
+        }
+        return;
+      }
+    }
+  }
+  // The objects were all in use, or the request failed.
+  get->callback(get->status, std::move(get->object_buffers));
+#endif
+}
+
+Status PlasmaClient::Impl::GetStreaming(const ObjectID &object_id,
+                                        int64_t timeout_ms,
+                                        ObjectBuffer *object_buffer) {
+  std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+
+  if (!release_cache_.empty() && store_conn_) {
+    RAY_RETURN_NOT_OK(SendRelease(EvictCachedObjects()));
+  }
+  *object_buffer = ObjectBuffer();
+  return GetBuffers(&object_id,
+                    1,
+                    timeout_ms,
+                    ReleasingBufferWrapper(),
+                    object_buffer,
+                    /*is_from_worker=*/true,
+                    /*allow_partial=*/true);
+}
+
+Status PlasmaClient::Impl::WaitForPrefix(const ObjectID &object_id,
+                                         int64_t num_bytes,
+                                         int64_t *num_bytes_written) {
+  std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+
+  auto object_entry = objects_in_use_.find(object_id);
+  if (object_entry == objects_in_use_.end()) {
+    return Status::ObjectNotFound(
+        "WaitForPrefix() called on an object without a reference to it");
+  }
+  const PlasmaObject &object = object_entry->second->object;
+  const int64_t object_size = object.data_size + object.metadata_size;
+  if (object_entry->second->is_sealed) {
+    *num_bytes_written = object_size;
+    return Status::OK();
+  }
+  RAY_RETURN_NOT_OK(SendWaitPrefixRequest(store_conn_, object_id, num_bytes));
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaWaitPrefixReply, &buffer));
+  ObjectID reply_id;
+  RAY_RETURN_NOT_OK(
+      ReadWaitPrefixReply(buffer.data(), buffer.size(), &reply_id, num_bytes_written));
+  RAY_CHECK(reply_id == object_id);
+  if (*num_bytes_written == object_size) {
+    // The whole object was written, so it's sealed.
+    object_entry->second->is_sealed = true;
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::Impl::ReceiveReply(MessageType message_type,
+                                        std::vector<uint8_t> *buffer) {
+  while (!pending_async_gets_.empty()) {
+    MessageType received_type;
+    RAY_RETURN_NOT_OK(PlasmaReceiveAny(store_conn_, &received_type, buffer));
+    if (received_type == MessageType::PlasmaGetReply) {
+      const uint64_t request_id = ReadGetReplyRequestId(buffer->data(), buffer->size());
+      if (request_id != 0) {
+        RAY_RETURN_NOT_OK(HandleAsyncGetReply(request_id, buffer));
+        continue;
+      }
+    }
+    if (received_type != message_type) {
+      std::ostringstream ss;
+      ss << "Connection corrupted. Expected message type: "
+         << static_cast<int64_t>(message_type)
+         << ", received message type: " << static_cast<int64_t>(received_type);
+      return Status::IOError(ss.str());
+    }
+    return Status::OK();
+  }
+  return PlasmaReceive(store_conn_, message_type, buffer);
+}
+
+Status PlasmaClient::Impl::HandleAsyncGetReply(uint64_t request_id,
+                                               std::vector<uint8_t> *buffer) {
+  auto it = pending_async_gets_.find(request_id);
+  if (it == pending_async_gets_.end()) {
+    return Status::IOError("Received a get reply for an unknown request.");
+  }
+  auto get = std::move(it->second);
+  pending_async_gets_.erase(it);
+  get->status = ProcessGetReply(*buffer,
+                                get->object_ids.data(),
+                                get->object_ids.size(),
+                                ReleasingBufferWrapper(),
+                                get->object_buffers.data());
+  const Status status = get->status;
+  completed_async_gets_.push_back(std::move(get));
+  return status;
+}
+
+void PlasmaClient::Impl::FailAsyncGets(const Status &status) {
+  for (auto &request_id_and_get : pending_async_gets_) {
+    request_id_and_get.second->status = status;
+    completed_async_gets_.push_back(std::move(request_id_and_get.second));
+  }
+  pending_async_gets_.clear();
+}
+
+void PlasmaClient::Impl::RunAsyncGetLoop() {
+#ifndef _WIN32
+  // Bounds how long the thread takes to notice that the client disconnected.
+  constexpr int kPollTimeoutMs = 100;
+  std::unique_lock<std::recursive_mutex> guard(client_mutex_);
+  while (true) {
+    if (!completed_async_gets_.empty()) {
+      auto completed_gets = std::move(completed_async_gets_);
+      completed_async_gets_.clear();
+      guard.unlock();
+      for (auto &get : completed_gets) {
+        get->callback(get->status, std::move(get->object_buffers));
+      }
+      completed_gets.clear();
+      guard.lock();
+      continue;
+    }
+    if (pending_async_gets_.empty()) {
+      break;
+    }
+    if (!store_conn_) {
+      FailAsyncGets(Status::IOError("Connection is closed."));
+      continue;
+    }
+
+    // Wait for a reply without holding the lock. A call that is waiting for its own
+    // reply may read it first, in which case the socket is empty again once the lock
+    // is taken.
+    struct pollfd poll_fd = {store_conn_->GetNativeHandle(), POLLIN, 0};
+    guard.unlock();
+    RAY_UNUSED(poll(&poll_fd, 1, kPollTimeoutMs));
+    guard.lock();
+    int bytes_available = 0;
+    if (!store_conn_ || pending_async_gets_.empty() ||
+        ioctl(store_conn_->GetNativeHandle(), FIONREAD, &bytes_available) != 0 ||
+        bytes_available == 0) {
+      continue;
+    }
+    // Only replies to async gets can arrive while no other call holds the lock.
+    std::vector<uint8_t> buffer;
+    MessageType message_type;
+    Status status = PlasmaReceiveAny(store_conn_, &message_type, &buffer);
+    if (status.ok()) {
+      if (message_type == MessageType::PlasmaGetReply) {
+        status = HandleAsyncGetReply(
+            ReadGetReplyRequestId(buffer.data(), buffer.size()), &buffer);
+      } else {
+        status = Status::IOError("Received an unexpected message from the store.");
+      }
+    }
+    if (!status.ok()) {
+      RAY_LOG(ERROR) << "Failed to receive a get reply from the plasma store: "
+                     << status;
+      FailAsyncGets(status);
+    }
+  }
+  async_get_thread_running_ = false;
+#endif
 }
 
 Status PlasmaClient::Impl::MarkObjectUnused(const ObjectID &object_id) {
@@ -575,31 +959,117 @@ Status PlasmaClient::Impl::MarkObjectUnused(const ObjectID &object_id) {
 }
 
 Status PlasmaClient::Impl::Release(const ObjectID &object_id) {
+  return Release(std::vector<ObjectID>{object_id});
+}
+
+Status PlasmaClient::Impl::Release(const std::vector<ObjectID> &object_ids) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
   // If the client is already disconnected, ignore release requests.
   if (!store_conn_) {
     return Status::OK();
   }
-  auto object_entry = objects_in_use_.find(object_id);
-  RAY_CHECK(object_entry != objects_in_use_.end());
-
-  object_entry->second->count -= 1;
-  RAY_CHECK(object_entry->second->count >= 0);
-  // Check if the client is no longer using this object.
-  if (object_entry->second->count == 0) {
-    // Tell the store that the client no longer needs the object.
-    RAY_RETURN_NOT_OK(MarkObjectUnused(object_id));
-    RAY_RETURN_NOT_OK(SendReleaseRequest(store_conn_, object_id));
-    auto iter = deletion_cache_.find(object_id);
-    if (iter != deletion_cache_.end()) {
-      deletion_cache_.erase(object_id);
-      RAY_RETURN_NOT_OK(Delete({object_id}));
+  std::vector<ObjectID> unused_ids;
+  std::vector<ObjectID> ids_to_delete;
+  for (const auto &object_id : object_ids) {
+    auto object_entry = objects_in_use_.find(object_id);
+    RAY_CHECK(object_entry != objects_in_use_.end());
+
+    object_entry->second->count -= 1;
+    RAY_CHECK(object_entry->second->count >= 0);
+    // Check if the client is no longer using this object.
+    if (object_entry->second->count == 0) {
+      if (deletion_cache_.erase(object_id) > 0) {
+        ids_to_delete.push_back(object_id);
+      } else if (release_cache_capacity_ > 0 && object_entry->second->is_sealed) {
+        CacheObject(object_id, object_entry->second.get());
+        continue;
+      }
+      RAY_RETURN_NOT_OK(MarkObjectUnused(object_id));
+      unused_ids.push_back(object_id);
     }
   }
+  if (!release_cache_.empty()) {
+    for (const auto &object_id : EvictCachedObjects()) {
+      unused_ids.push_back(object_id);
+    }
+  }
+  RAY_RETURN_NOT_OK(SendRelease(std::move(unused_ids)));
+  if (!ids_to_delete.empty()) {
+    RAY_RETURN_NOT_OK(Delete(ids_to_delete));
+  }
   return Status::OK();
 }
 
+Status PlasmaClient::Impl::SendRelease(std::vector<ObjectID> object_ids) {
+  if (release_ring_ != nullptr) {
+    object_ids = PushToReleaseRing(object_ids);
+  }
+  if (object_ids.empty()) {
+    return Status::OK();
+  }
+  // Tell the store that the client no longer needs the objects, with a single message
+  // for all of them.
+  if (object_ids.size() == 1) {
+    return SendReleaseRequest(store_conn_, object_ids[0]);
+  }
+  return SendReleaseBatchRequest(store_conn_, object_ids);
+}
+
+void PlasmaClient::Impl::CacheObject(const ObjectID &object_id,
+                                     ObjectInUseEntry *object_entry) {
+  RAY_CHECK(!object_entry->is_cached);
+  object_entry->is_cached = true;
+  object_entry->cache_position = release_cache_.insert(release_cache_.end(), object_id);
+  object_entry->cache_expiry_ms = current_time_ms() + release_cache_lease_ms_;
+}
+
+void PlasmaClient::Impl::UncacheObject(ObjectInUseEntry *object_entry) {
+  RAY_CHECK(object_entry->is_cached);
+  release_cache_.erase(object_entry->cache_position);
+  object_entry->is_cached = false;
+}
+
+std::vector<ObjectID> PlasmaClient::Impl::EvictCachedObjects(bool all) {
+  std::vector<ObjectID> evicted_ids;
+  const int64_t now_ms = current_time_ms();
+  while (!release_cache_.empty()) {
+    const ObjectID object_id = release_cache_.front();
+    auto &object_entry = objects_in_use_[object_id];
+    if (!all && release_cache_.size() <= release_cache_capacity_ &&
+        object_entry->cache_expiry_ms > now_ms) {
+      break;
+    }
+    UncacheObject(object_entry.get());
+    RAY_CHECK_OK(MarkObjectUnused(object_id));
+    evicted_ids.push_back(object_id);
+  }
+  return evicted_ids;
+}
+
+std::vector<ObjectID> PlasmaClient::Impl::PushToReleaseRing(
+    const std::vector<ObjectID> &object_ids) {
+  std::vector<ObjectID> remaining_ids;
+  bool wake_up_store = false;
+  for (const auto &object_id : object_ids) {
+    bool needs_wakeup = false;
+    if (release_ring_->Push(object_id, &needs_wakeup)) {
+      wake_up_store |= needs_wakeup;
+    } else {
+      remaining_ids.push_back(object_id);
+    }
+  }
+#ifdef __linux__
+  if (wake_up_store) {
+    // Writing to an eventfd only fails if its counter overflows, in which case the
+    // store has a wakeup pending anyway.
+    const uint64_t increment = 1;
+    RAY_UNUSED(write(release_ring_event_fd_, &increment, sizeof(increment)));
+  }
+#endif
+  return remaining_ids;
+}
+
 // This method is used to query whether the plasma store contains an object.
 Status PlasmaClient::Impl::Contains(const ObjectID &object_id, bool *has_object) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
@@ -612,8 +1082,7 @@ Status PlasmaClient::Impl::Contains(const ObjectID &object_id, bool *has_object)
     // to see if we have the object.
     RAY_RETURN_NOT_OK(SendContainsRequest(store_conn_, object_id));
     std::vector<uint8_t> buffer;
-    RAY_RETURN_NOT_OK(
-        PlasmaReceive(store_conn_, MessageType::PlasmaContainsReply, &buffer));
+    RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaContainsReply, &buffer));
     ObjectID object_id2;
     RAY_DCHECK(buffer.size() > 0);
     RAY_RETURN_NOT_OK(
@@ -640,7 +1109,7 @@ Status PlasmaClient::Impl::Seal(const ObjectID &object_id) {
   /// Send the seal request to Plasma.
   RAY_RETURN_NOT_OK(SendSealRequest(store_conn_, object_id));
   std::vector<uint8_t> buffer;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaSealReply, &buffer));
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaSealReply, &buffer));
   ObjectID sealed_id;
   RAY_RETURN_NOT_OK(ReadSealReply(buffer.data(), buffer.size(), &sealed_id));
   RAY_CHECK(sealed_id == object_id);
@@ -652,6 +1121,55 @@ Status PlasmaClient::Impl::Seal(const ObjectID &object_id) {
   return Release(object_id);
 }
 
+Status PlasmaClient::Impl::SealPrefix(const ObjectID &object_id, int64_t num_bytes) {
+  std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+
+  auto object_entry = objects_in_use_.find(object_id);
+  if (object_entry == objects_in_use_.end()) {
+    return Status::ObjectNotFound(
+        "SealPrefix() called on an object without a reference to it");
+  }
+  if (object_entry->second->is_sealed) {
+    return Status::ObjectAlreadySealed("SealPrefix() called on a sealed object");
+  }
+  // The store doesn't reply, since the creator doesn't wait for the readers.
+  return SendSealPrefixRequest(store_conn_, object_id, num_bytes);
+}
+
+Status PlasmaClient::Impl::Seal(const std::vector<ObjectID> &object_ids) {
+  std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+
+  // Check all objects before sealing any of them, so that a failed call has no effect.
+  absl::flat_hash_set<ObjectID> unique_ids;
+  for (const auto &object_id : object_ids) {
+    auto object_entry = objects_in_use_.find(object_id);
+    if (object_entry == objects_in_use_.end()) {
+      return Status::ObjectNotFound(
+          "Seal() called on an object without a reference to it");
+    }
+    if (object_entry->second->is_sealed || !unique_ids.insert(object_id).second) {
+      return Status::ObjectAlreadySealed("Seal() called on an already sealed object");
+    }
+  }
+  if (object_ids.empty()) {
+    return Status::OK();
+  }
+
+  for (const auto &object_id : object_ids) {
+    objects_in_use_[object_id]->is_sealed = true;
+  }
+  /// Send a single seal request for all objects to Plasma.
+  RAY_RETURN_NOT_OK(SendSealBatchRequest(store_conn_, object_ids));
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaSealBatchReply, &buffer));
+  std::vector<ObjectID> sealed_ids;
+  RAY_RETURN_NOT_OK(ReadSealBatchReply(buffer.data(), buffer.size(), &sealed_ids));
+  RAY_CHECK(sealed_ids == object_ids);
+  // Release the references that were taken when the objects were created, see
+  // Seal(const ObjectID &).
+  return Release(object_ids);
+}
+
 Status PlasmaClient::Impl::Abort(const ObjectID &object_id) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
   auto object_entry = objects_in_use_.find(object_id);
@@ -675,7 +1193,7 @@ Status PlasmaClient::Impl::Abort(const ObjectID &object_id) {
 
   std::vector<uint8_t> buffer;
   ObjectID id;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaAbortReply, &buffer));
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaAbortReply, &buffer));
   return ReadAbortReply(buffer.data(), buffer.size(), &id);
 }
 
@@ -683,19 +1201,27 @@ Status PlasmaClient::Impl::Delete(const std::vector<ObjectID> &object_ids) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
   std::vector<ObjectID> not_in_use_ids;
+  std::vector<ObjectID> cached_ids;
   for (auto &object_id : object_ids) {
+    auto object_entry = objects_in_use_.find(object_id);
     // If the object is in used, skip it.
-    if (objects_in_use_.count(object_id) == 0) {
+    if (object_entry == objects_in_use_.end()) {
+      not_in_use_ids.push_back(object_id);
+    } else if (object_entry->second->is_cached) {
+      // The client no longer uses the object, so release it before deleting it.
+      UncacheObject(object_entry->second.get());
+      RAY_RETURN_NOT_OK(MarkObjectUnused(object_id));
+      cached_ids.push_back(object_id);
       not_in_use_ids.push_back(object_id);
     } else {
       deletion_cache_.emplace(object_id);
     }
   }
+  RAY_RETURN_NOT_OK(SendRelease(std::move(cached_ids)));
   if (not_in_use_ids.size() > 0) {
     RAY_RETURN_NOT_OK(SendDeleteRequest(store_conn_, not_in_use_ids));
     std::vector<uint8_t> buffer;
-    RAY_RETURN_NOT_OK(
-        PlasmaReceive(store_conn_, MessageType::PlasmaDeleteReply, &buffer));
+    RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaDeleteReply, &buffer));
     RAY_DCHECK(buffer.size() > 0);
     std::vector<PlasmaError> error_codes;
     not_in_use_ids.clear();
@@ -708,11 +1234,13 @@ Status PlasmaClient::Impl::Delete(const std::vector<ObjectID> &object_ids) {
 Status PlasmaClient::Impl::Evict(int64_t num_bytes, int64_t &num_bytes_evicted) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
+  // Release the cached objects first, so that the store can evict them.
+  RAY_RETURN_NOT_OK(SendRelease(EvictCachedObjects(/*all=*/true)));
   // Send a request to the store to evict objects.
   RAY_RETURN_NOT_OK(SendEvictRequest(store_conn_, num_bytes));
   // Wait for a response with the number of bytes actually evicted.
   std::vector<uint8_t> buffer;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaEvictReply, &buffer));
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaEvictReply, &buffer));
   return ReadEvictReply(buffer.data(), buffer.size(), num_bytes_evicted);
 }
 
@@ -727,10 +1255,34 @@ Status PlasmaClient::Impl::Connect(const std::string &store_socket_name,
   RAY_RETURN_NOT_OK(ray::ConnectSocketRetry(socket, store_socket_name));
   store_conn_.reset(new StoreConn(std::move(socket)));
   // Send a ConnectRequest to the store to get its memory capacity.
-  RAY_RETURN_NOT_OK(SendConnectRequest(store_conn_));
+  RAY_RETURN_NOT_OK(SendConnectRequest(
+      store_conn_, RayConfig::instance().plasma_release_ring_capacity()));
   std::vector<uint8_t> buffer;
-  RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaConnectReply, &buffer));
-  RAY_RETURN_NOT_OK(ReadConnectReply(buffer.data(), buffer.size(), &store_capacity_));
+  RAY_RETURN_NOT_OK(ReceiveReply(MessageType::PlasmaConnectReply, &buffer));
+  int64_t release_ring_capacity = 0;
+  RAY_RETURN_NOT_OK(ReadConnectReply(
+      buffer.data(), buffer.size(), &store_capacity_, &release_ring_capacity));
+  if (release_ring_capacity > 0) {
+    RAY_RETURN_NOT_OK(AttachReleaseRing());
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::Impl::AttachReleaseRing() {
+#ifdef __linux__
+  int ring_fd = -1;
+  RAY_RETURN_NOT_OK(store_conn_->RecvFd(&ring_fd));
+  Status status = store_conn_->RecvFd(&release_ring_event_fd_);
+  if (status.ok()) {
+    release_ring_ = ObjectIdRing::Attach(ring_fd);
+  }
+  close(ring_fd);
+  RAY_RETURN_NOT_OK(status);
+  if (release_ring_ == nullptr) {
+    // Fall back to releasing objects on the socket.
+    RAY_LOG(WARNING) << "Failed to attach the release ring of the plasma store.";
+  }
+#endif
   return Status::OK();
 }
 
@@ -744,6 +1296,13 @@ Status PlasmaClient::Impl::Disconnect() {
   // Close the connections to Plasma. The Plasma store will release the objects
   // that were in use by us when handling the SIGPIPE.
   store_conn_.reset();
+  release_ring_.reset();
+#ifdef __linux__
+  if (release_ring_event_fd_ >= 0) {
+    close(release_ring_event_fd_);
+    release_ring_event_fd_ = -1;
+  }
+#endif
   return Status::OK();
 }
 
@@ -753,7 +1312,7 @@ std::string PlasmaClient::Impl::DebugString() {
     return "error sending request";
   }
   std::vector<uint8_t> buffer;
-  if (!PlasmaReceive(store_conn_, MessageType::PlasmaGetDebugStringReply, &buffer).ok()) {
+  if (!ReceiveReply(MessageType::PlasmaGetDebugStringReply, &buffer).ok()) {
     return "error receiving reply";
   }
   std::string debug_string;
@@ -821,10 +1380,33 @@ Status PlasmaClient::Get(const std::vector<ObjectID> &object_ids,
   return impl_->Get(object_ids, timeout_ms, object_buffers, is_from_worker);
 }
 
+void PlasmaClient::GetAsync(const std::vector<ObjectID> &object_ids,
+                            int64_t timeout_ms,
+                            GetCallback callback,
+                            bool is_from_worker) {
+  impl_->GetAsync(object_ids, timeout_ms, std::move(callback), is_from_worker);
+}
+
+Status PlasmaClient::GetStreaming(const ObjectID &object_id,
+                                  int64_t timeout_ms,
+                                  ObjectBuffer *object_buffer) {
+  return impl_->GetStreaming(object_id, timeout_ms, object_buffer);
+}
+
+Status PlasmaClient::WaitForPrefix(const ObjectID &object_id,
+                                   int64_t num_bytes,
+                                   int64_t *num_bytes_written) {
+  return impl_->WaitForPrefix(object_id, num_bytes, num_bytes_written);
+}
+
 Status PlasmaClient::Release(const ObjectID &object_id) {
   return impl_->Release(object_id);
 }
 
+Status PlasmaClient::Release(const std::vector<ObjectID> &object_ids) {
+  return impl_->Release(object_ids);
+}
+
 Status PlasmaClient::Contains(const ObjectID &object_id, bool *has_object) {
   return impl_->Contains(object_id, has_object);
 }
@@ -833,6 +1415,14 @@ Status PlasmaClient::Abort(const ObjectID &object_id) { return impl_->Abort(obje
 
 Status PlasmaClient::Seal(const ObjectID &object_id) { return impl_->Seal(object_id); }
 
+Status PlasmaClient::SealPrefix(const ObjectID &object_id, int64_t num_bytes) {
+  return impl_->SealPrefix(object_id, num_bytes);
+}
+
+Status PlasmaClient::Seal(const std::vector<ObjectID> &object_ids) {
+  return impl_->Seal(object_ids);
+}
+
 Status PlasmaClient::Delete(const ObjectID &object_id) {
   return impl_->Delete(std::vector<ObjectID>{object_id});
 }
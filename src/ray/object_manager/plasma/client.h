@@ -42,6 +42,9 @@ struct ObjectBuffer {
   std::shared_ptr<SharedMemoryBuffer> metadata;
   /// The device number.
   int device_num;
+  /// Whether the object is still being received from another node, so that only the
+  /// prefix that PlasmaClient::WaitForPrefix returns may be read.
+  bool partial = false;
 };
 
 class PlasmaClientInterface {
@@ -90,6 +93,15 @@ class PlasmaClientInterface {
   /// \return The return status.
   virtual Status Seal(const ObjectID &object_id) = 0;
 
+  /// Tell the store that the first bytes of an unsealed object were written, so that
+  /// the clients that read the object while it's being received can read them.
+  ///
+  /// \param object_id The ID of the object.
+  /// \param num_bytes The number of bytes from the start of the object's data,
+  ///        counting the metadata after it, that won't change anymore.
+  /// \return The return status.
+  virtual Status SealPrefix(const ObjectID &object_id, int64_t num_bytes) = 0;
+
   /// Abort an unsealed object in the object store. If the abort succeeds, then
   /// it will be as if the object was never created at all. The unsealed object
   /// must have only a single reference (the one that would have been removed by
@@ -255,6 +267,55 @@ class PlasmaClient : public PlasmaClientInterface {
              std::vector<ObjectBuffer> *object_buffers,
              bool is_from_worker);
 
+  using GetCallback =
+      std::function<void(const Status &status, std::vector<ObjectBuffer> buffers)>;
+
+  /// Get some objects from the Plasma Store without waiting for them. The request is
+  /// tagged with an ID that the store sends back in its reply, and the replies are
+  /// read by one thread of the client, so that any number of gets can wait at once
+  /// and other calls on the client aren't held up while they do.
+  ///
+  /// \param object_ids The IDs of the objects to get.
+  /// \param timeout_ms The amount of time in milliseconds to wait before this
+  ///        request times out. If this value is -1, then no timeout is set.
+  /// \param callback Called with the object results, as Get returns them, once the
+  ///        objects have all been sealed or the timeout expires. It's called on the
+  ///        client's reply thread, or right away if the objects are already in use
+  ///        by the client. It must not call Disconnect.
+  /// \param is_from_worker Whether or not if the Get request comes from a Ray workers.
+  void GetAsync(const std::vector<ObjectID> &object_ids,
+                int64_t timeout_ms,
+                GetCallback callback,
+                bool is_from_worker);
+
+  /// Get an object without waiting for it to be sealed, if it's being received from
+  /// another node. The buffer is marked partial then, and only the prefix of it that
+  /// WaitForPrefix returns may be read. Otherwise this is the same as Get with a single
+  /// object. It's the same as Get if plasma_streaming_reads_enabled is unset.
+  ///
+  /// \param object_id The ID of the object to get.
+  /// \param timeout_ms The amount of time in milliseconds to wait for the object to be
+  ///        created. If this value is -1, then no timeout is set.
+  /// \param[out] object_buffer The object result.
+  /// \return The return status.
+  Status GetStreaming(const ObjectID &object_id,
+                      int64_t timeout_ms,
+                      ObjectBuffer *object_buffer);
+
+  /// Wait until the first bytes of an object that this client got are readable.
+  ///
+  /// \param object_id The ID of the object, which must be in use by this client.
+  /// \param num_bytes The number of bytes from the start of the object's data,
+  ///        counting the metadata after it, to wait for.
+  /// \param[out] num_bytes_written The number of bytes that are readable, which is at
+  ///        least num_bytes. It is the size of the data and the metadata once the
+  ///        object is sealed.
+  /// \return The return status. ObjectNotFound if the object was aborted before
+  ///         enough bytes were written, in which case none of it may be read.
+  Status WaitForPrefix(const ObjectID &object_id,
+                       int64_t num_bytes,
+                       int64_t *num_bytes_written);
+
   /// Tell Plasma that the client no longer needs the object. This should be
   /// called after Get() or Create() when the client is done with the object.
   /// After this call, the buffer returned by Get() is no longer valid.
@@ -263,6 +324,13 @@ class PlasmaClient : public PlasmaClientInterface {
   /// \return The return status.
   Status Release(const ObjectID &object_id);
 
+  /// Release several objects. The store is told about all objects that are no longer
+  /// used by this client with a single message.
+  ///
+  /// \param object_ids The IDs of the objects that are no longer needed.
+  /// \return The return status.
+  Status Release(const std::vector<ObjectID> &object_ids);
+
   /// Check if the object store contains a particular object and the object has
   /// been sealed. The result will be stored in has_object.
   ///
@@ -292,6 +360,15 @@ class PlasmaClient : public PlasmaClientInterface {
   /// \return The return status.
   Status Seal(const ObjectID &object_id);
 
+  Status SealPrefix(const ObjectID &object_id, int64_t num_bytes);
+
+  /// Seal several objects with a single round trip to the store. No object is sealed
+  /// if any of them can't be sealed.
+  ///
+  /// \param object_ids The IDs of the objects to seal. They must be distinct.
+  /// \return The return status.
+  Status Seal(const std::vector<ObjectID> &object_ids);
+
   /// Delete an object from the object store. This currently assumes that the
   /// object is present, has been sealed and not used by another client. Otherwise,
   /// it is a no operation.
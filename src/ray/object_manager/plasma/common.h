@@ -60,6 +60,9 @@ struct Allocation {
   int device_num;
   /// the total size of this mapped memory.
   int64_t mmap_size;
+  /// Whether the memory was allocated from a file in a fallback directory instead of
+  /// the primary shared memory region.
+  bool fallback_allocated = false;
 
   // only allow moves.
   RAY_DISALLOW_COPY_AND_ASSIGN(Allocation);
@@ -90,6 +93,7 @@ struct Allocation {
   friend struct ObjectLifecycleManagerTest;
   FRIEND_TEST(ObjectStoreTest, PassThroughTest);
   FRIEND_TEST(EvictionPolicyTest, Test);
+  friend class SizeAwareEvictionPolicyTest;
   friend struct GetRequestQueueTest;
 };
 
@@ -135,6 +139,7 @@ class LocalObject {
   FRIEND_TEST(ObjectLifecycleManagerTest, RemoveReferenceOneRefNotSealed);
   friend struct ObjectStatsCollectorTest;
   FRIEND_TEST(EvictionPolicyTest, Test);
+  friend class SizeAwareEvictionPolicyTest;
   friend struct GetRequestQueueTest;
 
   /// Allocation Info;
@@ -1,5 +1,10 @@
 #include "ray/object_manager/plasma/connection.h"
 
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 #ifndef _WIN32
 #include "ray/object_manager/plasma/fling.h"
 #endif
@@ -142,6 +147,80 @@ Status Client::SendFd(MEMFD_TYPE fd) {
   return Status::OK();
 }
 
+bool Client::SetUpReleaseRing(int64_t capacity) {
+#ifdef __linux__
+  RAY_CHECK(release_ring_ == nullptr);
+  int event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (event_fd < 0) {
+    return false;
+  }
+  release_ring_ = ObjectIdRing::Create(capacity, &release_ring_fd_);
+  if (release_ring_ == nullptr) {
+    close(event_fd);
+    return false;
+  }
+  release_ring_event_ = std::make_unique<boost::asio::posix::stream_descriptor>(
+      socket_.get_executor(), event_fd);
+  return true;
+#else
+  return false;
+#endif
+}
+
+Status Client::SendReleaseRingFds() {
+#ifdef __linux__
+  RAY_CHECK(release_ring_fd_ >= 0);
+  int ec = send_fd(GetNativeHandle(), release_ring_fd_);
+  if (ec > 0) {
+    ec = send_fd(GetNativeHandle(), release_ring_event_->native_handle());
+  }
+  // The client maps the ring with its own copy of the memfd.
+  close(release_ring_fd_);
+  release_ring_fd_ = -1;
+  if (ec <= 0) {
+    return Status::IOError("Failed to send the fds of the release ring");
+  }
+  return Status::OK();
+#else
+  return Status::NotImplemented("Release rings are only supported on Linux");
+#endif
+}
+
+void Client::WaitForReleases(std::function<void()> handler) {
+#ifdef __linux__
+  if (release_ring_event_ == nullptr) {
+    return;
+  }
+  std::weak_ptr<ray::ClientConnection> weak_self = shared_ClientConnection_from_this();
+  release_ring_event_->async_read_some(
+      boost::asio::buffer(&release_ring_event_count_, sizeof(release_ring_event_count_)),
+      [weak_self, handler = std::move(handler)](const boost::system::error_code &error,
+                                                size_t /*bytes_transferred*/) {
+        // The read is aborted when the ring is closed on disconnect. The store still
+        // pops released objects before every message if the eventfd fails.
+        if (error || weak_self.expired()) {
+          return;
+        }
+        handler();
+      });
+#endif
+}
+
+bool Client::PopReleasedObject(ray::ObjectID *object_id) {
+  return release_ring_ != nullptr && release_ring_->Pop(object_id);
+}
+
+void Client::CloseReleaseRing() {
+#ifdef __linux__
+  if (release_ring_fd_ >= 0) {
+    close(release_ring_fd_);
+    release_ring_fd_ = -1;
+  }
+  release_ring_event_.reset();
+#endif
+  release_ring_.reset();
+}
+
 StoreConn::StoreConn(ray::local_stream_socket &&socket)
     : ray::ServerConnection(std::move(socket)) {}
 
@@ -1,10 +1,15 @@
 #pragma once
 
+#ifdef __linux__
+#include <boost/asio/posix/stream_descriptor.hpp>
+#endif
+
 #include "absl/container/flat_hash_set.h"
 #include "ray/common/client_connection.h"
 #include "ray/common/id.h"
 #include "ray/common/status.h"
 #include "ray/object_manager/plasma/compat.h"
+#include "ray/object_manager/plasma/object_id_ring.h"
 
 namespace plasma {
 
@@ -45,10 +50,48 @@ class Client : public ray::ClientConnection, public ClientInterface {
     object_ids.erase(object_id);
   }
 
+  /// Set up a ring that the client pushes the IDs of the objects it releases to,
+  /// instead of sending a release request per object. Only supported on Linux.
+  ///
+  /// \param capacity The number of object IDs the ring should hold.
+  /// \return Whether the ring was set up.
+  bool SetUpReleaseRing(int64_t capacity);
+
+  /// Send the memfd and the eventfd of the release ring to the client.
+  ray::Status SendReleaseRingFds();
+
+  /// Call the handler once the client wakes up the store after pushing to the
+  /// release ring. Does nothing if the ring is closed.
+  ///
+  /// \param handler The handler, which should pop every released object and wait
+  /// again.
+  void WaitForReleases(std::function<void()> handler);
+
+  /// Pop the oldest object ID from the release ring.
+  ///
+  /// \param[out] object_id The ID of the released object.
+  /// \return Whether an ID was popped, false if the ring is empty or not set up.
+  bool PopReleasedObject(ray::ObjectID *object_id);
+
+  /// Close the release ring, if it was set up.
+  void CloseReleaseRing();
+
   std::string name = "anonymous_client";
 
  private:
   Client(ray::MessageHandler &message_handler, ray::local_stream_socket &&socket);
+
+  /// Ring of object IDs released by the client, nullptr if it was not set up.
+  std::unique_ptr<ObjectIdRing> release_ring_;
+  /// The memfd backing the release ring, until it is sent to the client.
+  int release_ring_fd_ = -1;
+#ifdef __linux__
+  /// The eventfd the client writes to after pushing to an empty release ring.
+  std::unique_ptr<boost::asio::posix::stream_descriptor> release_ring_event_;
+  /// Buffer for reading the eventfd's counter.
+  uint64_t release_ring_event_count_ = 0;
+#endif
+
   /// File descriptors that are used by this client.
   /// TODO(ekl) we should also clean up old fds that are removed.
   absl::flat_hash_set<MEMFD_TYPE> used_fds_;
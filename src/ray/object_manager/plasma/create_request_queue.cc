@@ -101,6 +101,13 @@ Status CreateRequestQueue::ProcessRequests() {
       FinishRequest(request_it);
       // Reset the oom start time since the creation succeeds.
       oom_start_time_ns_ = -1;
+    } else if (fair_queueing_ && ProcessRequestsOfOtherClients()) {
+      // Other clients made progress. Retry the head of the queue, since their
+      // objects may have been created in memory freed in the meantime. The oom
+      // timer of the head is kept, so that it still falls back eventually.
+      if (oom_start_time_ns_ == -1) {
+        oom_start_time_ns_ = now;
+      }
     } else {
       if (trigger_global_gc_) {
         trigger_global_gc_();
@@ -144,6 +151,28 @@ Status CreateRequestQueue::ProcessRequests() {
   return Status::OK();
 }
 
+bool CreateRequestQueue::ProcessRequestsOfOtherClients() {
+  // Requests of the same client are processed in order, so only the first
+  // request of each client is tried.
+  absl::flat_hash_set<const ClientInterface *> tried_clients;
+  tried_clients.insert(queue_.front()->client.get());
+  bool any_finished = false;
+  for (auto it = std::next(queue_.begin()); it != queue_.end();) {
+    auto request_it = it++;
+    if (!tried_clients.insert((*request_it)->client.get()).second) {
+      continue;
+    }
+    auto status = ProcessRequest(/*fallback_allocator=*/false,
+                                 *request_it,
+                                 /*spilling_required=*/nullptr);
+    if (status.ok()) {
+      FinishRequest(request_it);
+      any_finished = true;
+    }
+  }
+  return any_finished;
+}
+
 void CreateRequestQueue::FinishRequest(
     std::list<std::unique_ptr<CreateRequest>>::iterator request_it) {
   // Fulfill the request.
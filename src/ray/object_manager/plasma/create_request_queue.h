@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/common/status.h"
 #include "ray/object_manager/common.h"
 #include "ray/object_manager/plasma/common.h"
@@ -37,12 +38,14 @@ class CreateRequestQueue {
                      ray::SpillObjectsCallback spill_objects_callback,
                      std::function<void()> trigger_global_gc,
                      std::function<int64_t()> get_time,
-                     std::function<std::string()> dump_debug_info_callback = nullptr)
+                     std::function<std::string()> dump_debug_info_callback = nullptr,
+                     bool fair_queueing = false)
       : oom_grace_period_ns_(oom_grace_period_s * 1e9),
         spill_objects_callback_(spill_objects_callback),
         trigger_global_gc_(trigger_global_gc),
         get_time_(get_time),
-        dump_debug_info_callback_(dump_debug_info_callback) {}
+        dump_debug_info_callback_(dump_debug_info_callback),
+        fair_queueing_(fair_queueing) {}
 
   /// Add a request to the queue. The caller should use the returned request ID
   /// to later get the result of the request.
@@ -99,7 +102,9 @@ class CreateRequestQueue {
   ///
   /// This will try to process as many requests in the queue as possible, in
   /// FIFO order. If the first request is not serviceable, this will break and
-  /// the caller should try again later.
+  /// the caller should try again later. With fair queueing, the requests of the
+  /// other clients are tried first, one per client at a time, so that they are
+  /// not blocked behind it.
   ///
   /// \return Bad status for the first request in the queue if it failed to be
   /// serviced, or OK if all requests were fulfilled.
@@ -156,6 +161,12 @@ class CreateRequestQueue {
                         std::unique_ptr<CreateRequest> &request,
                         bool *spilling_required);
 
+  /// Try the first request of each client other than the client of the request
+  /// at the head of the queue, and finish the ones that succeed.
+  ///
+  /// \return Whether any request was finished.
+  bool ProcessRequestsOfOtherClients();
+
   /// Finish a queued request and remove it from the queue.
   void FinishRequest(std::list<std::unique_ptr<CreateRequest>>::iterator request_it);
 
@@ -182,6 +193,10 @@ class CreateRequestQueue {
   /// Sink for debug info.
   const std::function<std::string()> dump_debug_info_callback_;
 
+  /// Whether a request that is not serviceable should let the requests of
+  /// other clients go first, instead of blocking the whole queue.
+  const bool fair_queueing_;
+
   /// Queue of object creation requests to respond to. Requests will be placed
   /// on this queue if the object store does not have enough room at the time
   /// that the client made the creation request, but space may be made through
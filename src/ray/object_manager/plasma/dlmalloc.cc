@@ -26,6 +26,9 @@
 #define _GNU_SOURCE /* Turns on fallocate() definition */
 #endif              /* _GNU_SOURCE */
 #include <fcntl.h>
+#include <linux/memfd.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
 #endif /* __linux__ */
 
 #include <stddef.h>
@@ -37,8 +40,12 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #endif
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ray/common/ray_config.h"
@@ -116,6 +123,122 @@ struct DLMallocConfig {
 };
 
 DLMallocConfig dlmalloc_config;
+
+#ifdef __linux__
+/// Returns the size of the huge pages to back the given region with, or 0 if the
+/// region should use a file in the plasma directory instead. Only the initial region
+/// uses huge pages, fallback allocations always use files.
+int64_t huge_page_size_for_region() {
+  if (allocated_once) {
+    return 0;
+  }
+  const int64_t huge_page_size = RayConfig::instance().plasma_huge_page_size();
+  RAY_CHECK(huge_page_size >= 0 && (huge_page_size & (huge_page_size - 1)) == 0)
+      << "plasma_huge_page_size must be a power of 2, got " << huge_page_size;
+  return huge_page_size;
+}
+
+/// Create an anonymous file backed by huge pages of the given size.
+int create_huge_page_memfd(int64_t huge_page_size) {
+#ifdef SYS_memfd_create
+  // The huge page size is encoded as its log2 in the flags.
+  unsigned int flags = MFD_HUGETLB;
+  flags |= static_cast<unsigned int>(__builtin_ctzll(huge_page_size)) << MFD_HUGE_SHIFT;
+  int fd = static_cast<int>(syscall(SYS_memfd_create, "plasma", flags));
+  if (fd < 0) {
+    RAY_LOG(FATAL) << "memfd_create failed to create a file backed by huge pages of "
+                   << huge_page_size << " bytes, error " << std::strerror(errno);
+  }
+  return fd;
+#else
+  RAY_LOG(FATAL) << "plasma_huge_page_size is not supported on this platform.";
+  return -1;
+#endif
+}
+
+/// Returns the NUMA nodes to allocate the given region on. Only the initial region is
+/// placed, fallback allocations follow the policy of the process.
+std::vector<int> numa_nodes_for_region() {
+  std::vector<int> nodes;
+  if (allocated_once) {
+    return nodes;
+  }
+  std::stringstream stream(RayConfig::instance().plasma_numa_nodes());
+  std::string node;
+  while (std::getline(stream, node, ',')) {
+    if (!node.empty()) {
+      nodes.push_back(std::stoi(node));
+      RAY_CHECK(nodes.back() >= 0) << "Invalid NUMA node " << node;
+    }
+  }
+  return nodes;
+}
+
+/// Bind the pages of the given region to a single NUMA node, or interleave them across
+/// several nodes. This must be done before the pages are faulted in.
+void bind_to_numa_nodes(void *pointer, int64_t size, const std::vector<int> &nodes) {
+  constexpr int kBitsPerMask = 8 * sizeof(unsigned long);
+  const int max_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> node_mask(max_node / kBitsPerMask + 1, 0);
+  for (int node : nodes) {
+    node_mask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+  }
+  const int mode = nodes.size() == 1 ? MPOL_BIND : MPOL_INTERLEAVE;
+  if (syscall(SYS_mbind,
+              pointer,
+              static_cast<unsigned long>(size),
+              mode,
+              node_mask.data(),
+              static_cast<unsigned long>(node_mask.size() * kBitsPerMask),
+              0) != 0) {
+    // The placement only affects performance, so keep going.
+    RAY_LOG(WARNING) << "Failed to place the plasma store memory on NUMA nodes "
+                     << RayConfig::instance().plasma_numa_nodes() << ", error "
+                     << std::strerror(errno);
+    return;
+  }
+  RAY_LOG(INFO) << (mode == MPOL_BIND ? "Bound" : "Interleaved")
+                << " the plasma store memory on NUMA nodes "
+                << RayConfig::instance().plasma_numa_nodes();
+}
+
+/// Fault in all pages of the given region, like MAP_POPULATE does.
+void populate_pages(void *pointer, int64_t size, int64_t page_size) {
+  auto *bytes = static_cast<volatile char *>(pointer);
+  for (int64_t offset = 0; offset < size; offset += page_size) {
+    bytes[offset] = 0;
+  }
+}
+
+/// Allocate all pages of the given region in a background thread, so that the store
+/// can start serving requests meanwhile. Objects may already be created in the region,
+/// so this must not write to it.
+void populate_pages_in_background(void *pointer, int64_t size, int fd) {
+  std::thread([pointer, size, fd]() {
+    const auto start = std::chrono::steady_clock::now();
+    bool populated = false;
+#ifdef MADV_POPULATE_WRITE
+    // Fault the pages in without changing them (Linux 5.14+).
+    populated = madvise(pointer, size, MADV_POPULATE_WRITE) == 0;
+#endif
+    if (!populated) {
+      // Allocate the pages of the backing file at least, which is what avoids SIGBUS
+      // errors later. They are mapped in when first accessed.
+      populated = fallocate(fd, /*mode*/ 0, /*offset*/ 0, size) == 0;
+    }
+    const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+    if (populated) {
+      RAY_LOG(INFO) << "Preallocated " << size << " bytes of plasma memory in "
+                    << elapsed_ms << "ms in the background.";
+    } else {
+      RAY_LOG(WARNING) << "Failed to preallocate plasma memory in the background: "
+                       << std::strerror(errno);
+    }
+  }).detach();
+}
+#endif /* __linux__ */
 }  // namespace
 
 #ifdef _WIN32
@@ -138,16 +261,75 @@ void create_and_mmap_buffer(int64_t size, void **pointer, HANDLE *handle) {
   }
 }
 #else
-void create_and_mmap_buffer(int64_t size, void **pointer, int *fd) {
+/// A directory to create fallback files in.
+struct FallbackTier {
+  std::string directory;
+  /// The max bytes of the files in the directory, or 0 if unlimited.
+  int64_t capacity = 0;
+  /// The bytes of the files in the directory.
+  int64_t used = 0;
+};
+
+/// The fallback tiers, in the order they are filled. They are parsed from
+/// plasma_fallback_tiers on first use, or are the fallback directory if it is empty.
+std::vector<FallbackTier> &fallback_tiers() {
+  static std::vector<FallbackTier> tiers = [] {
+    std::vector<FallbackTier> tiers;
+    std::stringstream stream(RayConfig::instance().plasma_fallback_tiers());
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+      if (entry.empty()) {
+        continue;
+      }
+      FallbackTier tier;
+      const auto pos = entry.rfind(':');
+      tier.directory = entry.substr(0, pos);
+      if (pos != std::string::npos) {
+        tier.capacity = std::stoll(entry.substr(pos + 1));
+        RAY_CHECK(tier.capacity >= 0) << "Invalid fallback tier " << entry;
+      }
+      tiers.push_back(std::move(tier));
+    }
+    if (tiers.empty()) {
+      FallbackTier tier;
+      tier.directory = dlmalloc_config.fallback_directory;
+      tiers.push_back(std::move(tier));
+    }
+    return tiers;
+  }();
+  return tiers;
+}
+
+/// The fallback tier of each fallback region, by the address it is mapped at.
+absl::flat_hash_map<void *, size_t> fallback_region_tiers;
+
+/// Create the file of a region. A fallback region is created in the first fallback
+/// tier that has room for it.
+///
+/// \param[out] tier The fallback tier of the file, or -1 for the initial region.
+/// \return Whether the file was created. Fails if no fallback tier has room.
+bool create_buffer_file(int64_t size, int *fd, int *tier) {
   // Create a buffer. This is creating a temporary file and then
   // immediately unlinking it so we do not leave traces in the system.
   std::string file_template = dlmalloc_config.directory;
+  *tier = -1;
 
   // In never-OOM mode, fallback to allocating from the filesystem. Note that these
   // allocations will be run with dlmallopt(M_MMAP_THRESHOLD, 0) set by
   // plasma_allocator.cc.
   if (allocated_once && dlmalloc_config.fallback_enabled) {
-    file_template = dlmalloc_config.fallback_directory;
+    const auto &tiers = fallback_tiers();
+    for (size_t i = 0; i < tiers.size(); i++) {
+      if (tiers[i].capacity == 0 || tiers[i].used + size <= tiers[i].capacity) {
+        *tier = static_cast<int>(i);
+        break;
+      }
+    }
+    if (*tier < 0) {
+      RAY_LOG(ERROR) << "No fallback tier has room for " << size << " bytes";
+      return false;
+    }
+    file_template = tiers[*tier].directory;
   }
 
   file_template += "/plasmaXXXXXX";
@@ -173,18 +355,64 @@ void create_and_mmap_buffer(int64_t size, void **pointer, int *fd) {
                      << std::strerror(errno);
     }
   }
+  return true;
+}
+
+void create_and_mmap_buffer(int64_t size, void **pointer, int *fd) {
+  int64_t huge_page_size = 0;
+  int tier = -1;
+#ifdef __linux__
+  huge_page_size = huge_page_size_for_region();
+  if (huge_page_size > 0) {
+    RAY_LOG(INFO) << "create_and_mmap_buffer(" << size << ") with huge pages of "
+                  << huge_page_size << " bytes";
+    *fd = create_huge_page_memfd(huge_page_size);
+    if (ftruncate(*fd, (off_t)size) != 0) {
+      RAY_LOG(FATAL) << "failed to ftruncate huge page file, error"
+                     << std::strerror(errno);
+    }
+  } else if (!create_buffer_file(size, fd, &tier)) {
+    *pointer = MFAIL;
+    return;
+  }
+#else
+  if (!create_buffer_file(size, fd, &tier)) {
+    *pointer = MFAIL;
+    return;
+  }
+#endif /* __linux__ */
 
   // MAP_POPULATE can be used to pre-populate the page tables for this memory region
   // which avoids work when accessing the pages later. However it causes long pauses
   // when mmapping the files. Only supported on Linux.
   auto flags = MAP_SHARED;
+  bool populate = false;
   if (RayConfig::instance().preallocate_plasma_memory()) {
     if (!MAP_POPULATE) {
       RAY_LOG(FATAL) << "MAP_POPULATE is not supported on this platform.";
     }
     RAY_LOG(INFO) << "Preallocating all plasma memory using MAP_POPULATE.";
+    populate = true;
+  }
+#ifdef __linux__
+  bool populate_in_background = false;
+  if (populate && !allocated_once &&
+      RayConfig::instance().preallocate_plasma_memory_in_background()) {
+    // Only the initial region is large enough for this to matter for startup.
+    populate = false;
+    populate_in_background = true;
+  }
+  const auto numa_nodes = numa_nodes_for_region();
+  // The NUMA policy only applies to pages that are faulted in after it is set, so
+  // populate the pages after setting it.
+  if (populate && numa_nodes.empty()) {
+    flags |= MAP_POPULATE;
+  }
+#else
+  if (populate) {
     flags |= MAP_POPULATE;
   }
+#endif /* __linux__ */
 
 #ifdef __linux__
   // For fallback allocation, use fallocate to ensure follow up access to this
@@ -211,14 +439,33 @@ void create_and_mmap_buffer(int64_t size, void **pointer, int *fd) {
   *pointer = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, *fd, 0);
   if (*pointer == MAP_FAILED) {
     RAY_LOG(ERROR) << "mmap failed with error: " << std::strerror(errno);
-    if (errno == ENOMEM && dlmalloc_config.hugepages_enabled) {
+    if (errno == ENOMEM && (dlmalloc_config.hugepages_enabled || huge_page_size > 0)) {
       RAY_LOG(ERROR)
           << "  (this probably means you have to increase /proc/sys/vm/nr_hugepages)";
     }
-  } else if (!allocated_once) {
+    return;
+  }
+#ifdef __linux__
+  if (!numa_nodes.empty()) {
+    bind_to_numa_nodes(*pointer, size, numa_nodes);
+    if (populate) {
+      populate_pages(
+          *pointer, size, huge_page_size > 0 ? huge_page_size : sysconf(_SC_PAGESIZE));
+    }
+  }
+  if (populate_in_background) {
+    // After binding to the NUMA nodes, so that the policy applies to the pages.
+    populate_pages_in_background(*pointer, size, *fd);
+  }
+#endif /* __linux__ */
+  if (!allocated_once) {
     initial_region_ptr = static_cast<char *>(*pointer);
     initial_region_size = size;
   }
+  if (tier >= 0) {
+    fallback_tiers()[tier].used += size;
+    fallback_region_tiers[*pointer] = tier;
+  }
 }
 
 #endif
@@ -237,6 +484,13 @@ void *fake_mmap(size_t size) {
   // page-aligned. This ensures that the segments of memory returned by
   // fake_mmap are never contiguous.
   size += kMmapRegionsGap;
+#ifdef __linux__
+  // Huge pages can only be mapped in multiples of the huge page size.
+  const int64_t huge_page_size = huge_page_size_for_region();
+  if (huge_page_size > 0) {
+    size = (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+#endif /* __linux__ */
 
   void *pointer;
   MEMFD_TYPE_NON_UNIQUE fd;
@@ -282,6 +536,11 @@ int fake_munmap(void *addr, int64_t size) {
   r = munmap(addr, size);
   if (r == 0) {
     close(entry->second.fd.first);
+    auto tier_it = fallback_region_tiers.find(addr);
+    if (tier_it != fallback_region_tiers.end()) {
+      fallback_tiers()[tier_it->second].used -= size;
+      fallback_region_tiers.erase(tier_it);
+    }
   }
 #endif
 
@@ -20,10 +20,70 @@
 #include <algorithm>
 #include <sstream>
 
+#include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/plasma_allocator.h"
 
 namespace plasma {
 
+namespace {
+
+/// Choose objects to evict to make room for a new object of the given size, and
+/// return the number of bytes that are still needed.
+int64_t RequireSpaceFromPolicy(IEvictionPolicy &policy,
+                               const IAllocator &allocator,
+                               int64_t size,
+                               std::vector<ObjectID> &objects_to_evict) {
+  // Check if there is enough space to create the object.
+  int64_t required_space = allocator.Allocated() + size - allocator.GetFootprintLimit();
+  // Try to free up at least as much space as we need right now but ideally
+  // up to 20% of the total capacity.
+  int64_t space_to_free = std::max(required_space, allocator.GetFootprintLimit() / 5);
+  // Choose some objects to evict, and update the return pointers.
+  int64_t num_bytes_evicted =
+      policy.ChooseObjectsToEvict(space_to_free, objects_to_evict);
+  RAY_LOG(DEBUG) << "There is not enough space to create this object, so evicting "
+                 << objects_to_evict.size() << " objects to free up " << num_bytes_evicted
+                 << " bytes. The number of bytes in use (before "
+                 << "this eviction) is " << allocator.Allocated() << ".";
+  return required_space - num_bytes_evicted;
+}
+
+}  // namespace
+
+void EvictionStatsTracker::RecordCreation(const ObjectID &object_id) {
+  auto it = evicted_object_map_.find(object_id);
+  if (it == evicted_object_map_.end()) {
+    return;
+  }
+  stats_.num_misses++;
+  evicted_objects_.erase(it->second);
+  evicted_object_map_.erase(it);
+}
+
+void EvictionStatsTracker::RecordEviction(const ObjectID &object_id, int64_t size) {
+  stats_.num_evictions++;
+  stats_.bytes_evicted += size;
+  if (max_evicted_objects_ == 0) {
+    return;
+  }
+  auto it = evicted_object_map_.find(object_id);
+  if (it != evicted_object_map_.end()) {
+    evicted_objects_.erase(it->second);
+  } else if (evicted_objects_.size() == max_evicted_objects_) {
+    evicted_object_map_.erase(evicted_objects_.back());
+    evicted_objects_.pop_back();
+  }
+  evicted_objects_.push_front(object_id);
+  evicted_object_map_[object_id] = evicted_objects_.begin();
+}
+
+std::string EvictionStatsTracker::DebugString(const std::string &name) const {
+  std::stringstream result;
+  result << "\n(" << name << ") hits: " << stats_.num_hits;
+  result << "\n(" << name << ") misses: " << stats_.num_misses;
+  return result.str();
+}
+
 void LRUCache::Add(const ObjectID &key, int64_t size) {
   auto it = item_map_.find(key);
   RAY_CHECK(it == item_map_.end());
@@ -93,6 +153,13 @@ int64_t LRUCache::ChooseObjectsToEvict(int64_t num_bytes_required,
 
 bool LRUCache::Exists(const ObjectID &key) const { return item_map_.count(key) > 0; }
 
+std::pair<ObjectID, int64_t> LRUCache::PopLeastRecentlyUsed() {
+  RAY_CHECK(!item_list_.empty());
+  auto item = item_list_.back();
+  Remove(item.first);
+  return item;
+}
+
 EvictionPolicy::EvictionPolicy(const IObjectStore &object_store,
                                const IAllocator &allocator)
     : pinned_memory_bytes_(0),
@@ -106,34 +173,27 @@ int64_t EvictionPolicy::ChooseObjectsToEvict(int64_t num_bytes_required,
       cache_.ChooseObjectsToEvict(num_bytes_required, objects_to_evict);
   // Update the LRU cache.
   for (auto &object_id : objects_to_evict) {
-    cache_.Remove(object_id);
+    stats_.RecordEviction(object_id, cache_.Remove(object_id));
   }
   return bytes_evicted;
 }
 
 void EvictionPolicy::ObjectCreated(const ObjectID &object_id) {
   cache_.Add(object_id, GetObjectSize(object_id));
+  stats_.RecordCreation(object_id);
 }
 
 int64_t EvictionPolicy::RequireSpace(int64_t size,
                                      std::vector<ObjectID> &objects_to_evict) {
-  // Check if there is enough space to create the object.
-  int64_t required_space = allocator_.Allocated() + size - allocator_.GetFootprintLimit();
-  // Try to free up at least as much space as we need right now but ideally
-  // up to 20% of the total capacity.
-  int64_t space_to_free = std::max(required_space, allocator_.GetFootprintLimit() / 5);
-  // Choose some objects to evict, and update the return pointers.
-  int64_t num_bytes_evicted = ChooseObjectsToEvict(space_to_free, objects_to_evict);
-  RAY_LOG(DEBUG) << "There is not enough space to create this object, so evicting "
-                 << objects_to_evict.size() << " objects to free up " << num_bytes_evicted
-                 << " bytes. The number of bytes in use (before "
-                 << "this eviction) is " << allocator_.Allocated() << ".";
-  return required_space - num_bytes_evicted;
+  return RequireSpaceFromPolicy(*this, allocator_, size, objects_to_evict);
 }
 
 void EvictionPolicy::BeginObjectAccess(const ObjectID &object_id) {
-  // If the object is in the LRU cache, remove it.
-  cache_.Remove(object_id);
+  // If the object is in the LRU cache, remove it. Unsealed objects are in the cache
+  // before their creator first uses them, which is not a hit.
+  if (cache_.Remove(object_id) >= 0 && object_store_.GetObject(object_id)->Sealed()) {
+    stats_.RecordHit();
+  }
   pinned_memory_bytes_ += GetObjectSize(object_id);
 }
 
@@ -157,5 +217,225 @@ bool EvictionPolicy::IsObjectExists(const ObjectID &object_id) const {
   return cache_.Exists(object_id);
 }
 
-std::string EvictionPolicy::DebugString() const { return cache_.DebugString(); }
+std::string EvictionPolicy::DebugString() const {
+  return cache_.DebugString() + stats_.DebugString(Name());
+}
+
+SegmentedLRUEvictionPolicy::SegmentedLRUEvictionPolicy(const IObjectStore &object_store,
+                                                       const IAllocator &allocator,
+                                                       float protected_fraction)
+    : probationary_("probationary lru", allocator.GetFootprintLimit()),
+      protected_(
+          "protected lru",
+          static_cast<int64_t>(allocator.GetFootprintLimit() * protected_fraction)),
+      object_store_(object_store),
+      allocator_(allocator) {
+  RAY_CHECK(protected_fraction >= 0 && protected_fraction <= 1) << protected_fraction;
+}
+
+void SegmentedLRUEvictionPolicy::ObjectCreated(const ObjectID &object_id) {
+  probationary_.Add(object_id, GetObjectSize(object_id));
+  stats_.RecordCreation(object_id);
+}
+
+int64_t SegmentedLRUEvictionPolicy::RequireSpace(
+    int64_t size, std::vector<ObjectID> &objects_to_evict) {
+  return RequireSpaceFromPolicy(*this, allocator_, size, objects_to_evict);
+}
+
+void SegmentedLRUEvictionPolicy::BeginObjectAccess(const ObjectID &object_id) {
+  const bool was_protected = protected_.Remove(object_id) >= 0;
+  const bool was_probationary = probationary_.Remove(object_id) >= 0;
+  // Unsealed objects are in the cache before their creator first uses them, which is
+  // not a hit.
+  if ((was_protected || was_probationary) &&
+      object_store_.GetObject(object_id)->Sealed()) {
+    stats_.RecordHit();
+    reused_objects_.insert(object_id);
+  }
+}
+
+void SegmentedLRUEvictionPolicy::EndObjectAccess(const ObjectID &object_id) {
+  const auto size = GetObjectSize(object_id);
+  if (!reused_objects_.erase(object_id)) {
+    probationary_.Add(object_id, size);
+    return;
+  }
+  protected_.Add(object_id, size);
+  // Make room in the protected segment, by giving its least recently used objects a
+  // last chance in the probationary segment.
+  while (protected_.RemainingCapacity() < 0) {
+    const auto [demoted_id, demoted_size] = protected_.PopLeastRecentlyUsed();
+    probationary_.Add(demoted_id, demoted_size);
+  }
+}
+
+int64_t SegmentedLRUEvictionPolicy::ChooseObjectsToEvict(
+    int64_t num_bytes_required, std::vector<ObjectID> &objects_to_evict) {
+  const size_t num_objects_before = objects_to_evict.size();
+  int64_t bytes_evicted =
+      probationary_.ChooseObjectsToEvict(num_bytes_required, objects_to_evict);
+  if (bytes_evicted < num_bytes_required) {
+    bytes_evicted += protected_.ChooseObjectsToEvict(num_bytes_required - bytes_evicted,
+                                                     objects_to_evict);
+  }
+  for (size_t i = num_objects_before; i < objects_to_evict.size(); i++) {
+    const auto &object_id = objects_to_evict[i];
+    int64_t size = probationary_.Remove(object_id);
+    if (size < 0) {
+      size = protected_.Remove(object_id);
+    }
+    stats_.RecordEviction(object_id, size);
+  }
+  return bytes_evicted;
+}
+
+void SegmentedLRUEvictionPolicy::RemoveObject(const ObjectID &object_id) {
+  probationary_.Remove(object_id);
+  protected_.Remove(object_id);
+  reused_objects_.erase(object_id);
+}
+
+std::string SegmentedLRUEvictionPolicy::DebugString() const {
+  return probationary_.DebugString() + protected_.DebugString() +
+         stats_.DebugString(Name());
+}
+
+int64_t SegmentedLRUEvictionPolicy::GetObjectSize(const ObjectID &object_id) const {
+  return object_store_.GetObject(object_id)->GetObjectSize();
+}
+
+GreedyDualSizeEvictionPolicy::GreedyDualSizeEvictionPolicy(
+    const IObjectStore &object_store,
+    const IAllocator &allocator,
+    int64_t fetch_overhead_bytes,
+    float primary_copy_cost_factor)
+    : fetch_overhead_bytes_(fetch_overhead_bytes),
+      primary_copy_cost_factor_(primary_copy_cost_factor),
+      object_store_(object_store),
+      allocator_(allocator) {
+  RAY_CHECK(fetch_overhead_bytes_ >= 0) << fetch_overhead_bytes_;
+  RAY_CHECK(primary_copy_cost_factor_ > 0) << primary_copy_cost_factor_;
+}
+
+void GreedyDualSizeEvictionPolicy::ObjectCreated(const ObjectID &object_id) {
+  const auto *object = object_store_.GetObject(object_id);
+  auto &entry = objects_[object_id];
+  RAY_CHECK(!entry.evictable);
+  entry.size = object->GetObjectSize();
+  entry.is_primary_copy =
+      object->GetSource() == plasma::flatbuf::ObjectSource::CreatedByWorker;
+  MakeEvictable(object_id, entry);
+  stats_.RecordCreation(object_id);
+}
+
+int64_t GreedyDualSizeEvictionPolicy::RequireSpace(
+    int64_t size, std::vector<ObjectID> &objects_to_evict) {
+  return RequireSpaceFromPolicy(*this, allocator_, size, objects_to_evict);
+}
+
+void GreedyDualSizeEvictionPolicy::BeginObjectAccess(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  if (it == objects_.end() || !it->second.evictable) {
+    return;
+  }
+  // Unsealed objects are evictable before their creator first uses them, which is not
+  // a hit.
+  if (object_store_.GetObject(object_id)->Sealed()) {
+    stats_.RecordHit();
+    it->second.frequency++;
+  }
+  MakeUnevictable(it->second);
+}
+
+void GreedyDualSizeEvictionPolicy::EndObjectAccess(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  RAY_CHECK(it != objects_.end()) << object_id;
+  MakeEvictable(object_id, it->second);
+}
+
+int64_t GreedyDualSizeEvictionPolicy::ChooseObjectsToEvict(
+    int64_t num_bytes_required, std::vector<ObjectID> &objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < num_bytes_required && !queue_.empty()) {
+    auto queue_it = queue_.begin();
+    // Age the priority of all remaining objects.
+    inflation_ = queue_it->first;
+    const auto object_id = queue_it->second;
+    auto &entry = objects_[object_id];
+    MakeUnevictable(entry);
+    objects_to_evict.push_back(object_id);
+    bytes_evicted += entry.size;
+    stats_.RecordEviction(object_id, entry.size);
+  }
+  return bytes_evicted;
+}
+
+void GreedyDualSizeEvictionPolicy::RemoveObject(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  if (it == objects_.end()) {
+    return;
+  }
+  MakeUnevictable(it->second);
+  objects_.erase(it);
+}
+
+std::string GreedyDualSizeEvictionPolicy::DebugString() const {
+  std::stringstream result;
+  result << "\n(" << Name() << ") num objects: " << objects_.size();
+  result << "\n(" << Name() << ") num evictable objects: " << queue_.size();
+  result << "\n(" << Name() << ") evictable bytes: " << evictable_bytes_;
+  result << "\n(" << Name() << ") num evictions: " << stats_.Stats().num_evictions;
+  result << "\n(" << Name() << ") bytes evicted: " << stats_.Stats().bytes_evicted;
+  result << stats_.DebugString(Name());
+  return result.str();
+}
+
+void GreedyDualSizeEvictionPolicy::MakeEvictable(const ObjectID &object_id,
+                                                 ObjectEntry &entry) {
+  if (entry.evictable) {
+    return;
+  }
+  double cost = static_cast<double>(fetch_overhead_bytes_ + entry.size);
+  if (entry.is_primary_copy) {
+    cost *= primary_copy_cost_factor_;
+  }
+  const double priority =
+      inflation_ + entry.frequency * cost / std::max<int64_t>(entry.size, 1);
+  entry.queue_it = queue_.emplace(priority, object_id);
+  entry.evictable = true;
+  evictable_bytes_ += entry.size;
+}
+
+void GreedyDualSizeEvictionPolicy::MakeUnevictable(ObjectEntry &entry) {
+  if (!entry.evictable) {
+    return;
+  }
+  queue_.erase(entry.queue_it);
+  entry.evictable = false;
+  evictable_bytes_ -= entry.size;
+}
+
+std::unique_ptr<IEvictionPolicy> CreateEvictionPolicy(const std::string &name,
+                                                      const IObjectStore &object_store,
+                                                      const IAllocator &allocator) {
+  if (name == "lru") {
+    return std::make_unique<EvictionPolicy>(object_store, allocator);
+  } else if (name == "segmented_lru") {
+    return std::make_unique<SegmentedLRUEvictionPolicy>(
+        object_store,
+        allocator,
+        RayConfig::instance().plasma_eviction_protected_fraction());
+  } else if (name == "greedy_dual_size") {
+    return std::make_unique<GreedyDualSizeEvictionPolicy>(
+        object_store,
+        allocator,
+        RayConfig::instance().plasma_eviction_fetch_overhead_bytes(),
+        RayConfig::instance().plasma_eviction_primary_copy_cost_factor());
+  }
+  RAY_LOG(FATAL) << "Unknown plasma eviction policy " << name
+                 << ". Must be one of lru, segmented_lru, greedy_dual_size.";
+  return nullptr;
+}
+
 }  // namespace plasma
@@ -25,11 +25,15 @@
 
 #include <functional>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/object_manager/plasma/common.h"
 #include "ray/object_manager/plasma/object_store.h"
 #include "ray/object_manager/plasma/plasma.h"
@@ -37,6 +41,18 @@
 
 namespace plasma {
 
+/// Counters of the decisions of an eviction policy, exported as metrics.
+struct EvictionPolicyStats {
+  /// The number of times an unused object was used again before it was evicted.
+  int64_t num_hits = 0;
+  /// The number of times an object was created again after it was evicted.
+  int64_t num_misses = 0;
+  /// The number of objects that were chosen for eviction.
+  int64_t num_evictions = 0;
+  /// The number of bytes that were chosen for eviction.
+  int64_t bytes_evicted = 0;
+};
+
 /// The eviction policy interface.
 class IEvictionPolicy {
  public:
@@ -100,6 +116,41 @@ class IEvictionPolicy {
 
   /// Returns debugging information for this eviction policy.
   virtual std::string DebugString() const = 0;
+
+  /// Returns the name of this eviction policy, see `plasma_eviction_policy`.
+  virtual std::string Name() const = 0;
+
+  /// Returns the counters of the decisions of this eviction policy.
+  virtual const EvictionPolicyStats &GetStats() const = 0;
+};
+
+/// Counts the hits, misses and evictions of an eviction policy. A miss is an object
+/// that is created again after it was evicted, e.g. because it was pulled or restored
+/// again. Only the most recently evicted objects are remembered to count misses.
+class EvictionStatsTracker {
+ public:
+  explicit EvictionStatsTracker(size_t max_evicted_objects = 10000)
+      : max_evicted_objects_(max_evicted_objects) {}
+
+  /// Record that an unused object is used again.
+  void RecordHit() { stats_.num_hits++; }
+
+  /// Record that an object was created, which is a miss if it was recently evicted.
+  void RecordCreation(const ObjectID &object_id);
+
+  /// Record that an object was chosen for eviction.
+  void RecordEviction(const ObjectID &object_id, int64_t size);
+
+  const EvictionPolicyStats &Stats() const { return stats_; }
+
+  std::string DebugString(const std::string &name) const;
+
+ private:
+  const size_t max_evicted_objects_;
+  /// The most recently evicted objects, from the most to the least recent.
+  std::list<ObjectID> evicted_objects_;
+  absl::flat_hash_map<ObjectID, std::list<ObjectID>::iterator> evicted_object_map_;
+  EvictionPolicyStats stats_;
 };
 
 class LRUCache {
@@ -129,6 +180,10 @@ class LRUCache {
 
   void Foreach(std::function<void(const ObjectID &)>);
 
+  /// Remove the least recently used object from the cache, and return its ID and size.
+  /// The cache must not be empty.
+  std::pair<ObjectID, int64_t> PopLeastRecentlyUsed();
+
   bool Exists(const ObjectID &key) const;
 
   std::string DebugString() const;
@@ -176,6 +231,10 @@ class EvictionPolicy : public IEvictionPolicy {
 
   std::string DebugString() const override;
 
+  std::string Name() const override { return "lru"; }
+
+  const EvictionPolicyStats &GetStats() const override { return stats_.Stats(); }
+
  private:
   /// Returns the size of the object
   int64_t GetObjectSize(const ObjectID &object_id) const;
@@ -189,6 +248,8 @@ class EvictionPolicy : public IEvictionPolicy {
   /// Datastructure for the LRU cache.
   LRUCache cache_;
 
+  EvictionStatsTracker stats_;
+
   const IObjectStore &object_store_;
 
   const IAllocator &allocator_;
@@ -196,4 +257,136 @@ class EvictionPolicy : public IEvictionPolicy {
   FRIEND_TEST(EvictionPolicyTest, Test);
 };
 
+/// A segmented LRU eviction policy. Unused objects first go to a probationary
+/// segment, and move to a protected segment once they are used again. Objects are
+/// evicted from the probationary segment first, so that many objects that are used
+/// only once don't evict the objects that are used repeatedly, however large. The
+/// least recently used protected objects move back to the probationary segment when
+/// the protected segment grows past its capacity.
+class SegmentedLRUEvictionPolicy : public IEvictionPolicy {
+ public:
+  /// \param protected_fraction The fraction of the store capacity that the protected
+  /// segment can hold.
+  SegmentedLRUEvictionPolicy(const IObjectStore &object_store,
+                             const IAllocator &allocator,
+                             float protected_fraction);
+
+  void ObjectCreated(const ObjectID &object_id) override;
+
+  int64_t RequireSpace(int64_t size, std::vector<ObjectID> &objects_to_evict) override;
+
+  void BeginObjectAccess(const ObjectID &object_id) override;
+
+  void EndObjectAccess(const ObjectID &object_id) override;
+
+  int64_t ChooseObjectsToEvict(int64_t num_bytes_required,
+                               std::vector<ObjectID> &objects_to_evict) override;
+
+  void RemoveObject(const ObjectID &object_id) override;
+
+  std::string DebugString() const override;
+
+  std::string Name() const override { return "segmented_lru"; }
+
+  const EvictionPolicyStats &GetStats() const override { return stats_.Stats(); }
+
+ private:
+  /// Returns the size of the object.
+  int64_t GetObjectSize(const ObjectID &object_id) const;
+
+  /// Unused objects that were not used again yet.
+  LRUCache probationary_;
+  /// Unused objects that were used more than once.
+  LRUCache protected_;
+  /// The objects that are in use and were used more than once. They go to the
+  /// protected segment once they are unused again.
+  absl::flat_hash_set<ObjectID> reused_objects_;
+
+  EvictionStatsTracker stats_;
+
+  const IObjectStore &object_store_;
+
+  const IAllocator &allocator_;
+
+  FRIEND_TEST(SizeAwareEvictionPolicyTest, TestSegmentedLRU);
+};
+
+/// A GreedyDual-Size eviction policy, extended with use frequencies. Each unused
+/// object has a priority of `L + frequency * cost / size`, and the object with the
+/// lowest priority is evicted first. The cost is the cost of fetching the object again,
+/// which is its size plus a fixed overhead, and is scaled up for primary copies, which
+/// can't be fetched from another node. `L` is the priority of the last evicted object,
+/// so the priority of objects that are not used anymore ages: a large object that is
+/// used often is kept over small objects that were used once a long time ago.
+class GreedyDualSizeEvictionPolicy : public IEvictionPolicy {
+ public:
+  /// \param fetch_overhead_bytes The fixed cost of fetching an object again.
+  /// \param primary_copy_cost_factor How much more expensive it is to evict a primary
+  /// copy than a secondary copy.
+  GreedyDualSizeEvictionPolicy(const IObjectStore &object_store,
+                               const IAllocator &allocator,
+                               int64_t fetch_overhead_bytes,
+                               float primary_copy_cost_factor);
+
+  void ObjectCreated(const ObjectID &object_id) override;
+
+  int64_t RequireSpace(int64_t size, std::vector<ObjectID> &objects_to_evict) override;
+
+  void BeginObjectAccess(const ObjectID &object_id) override;
+
+  void EndObjectAccess(const ObjectID &object_id) override;
+
+  int64_t ChooseObjectsToEvict(int64_t num_bytes_required,
+                               std::vector<ObjectID> &objects_to_evict) override;
+
+  void RemoveObject(const ObjectID &object_id) override;
+
+  std::string DebugString() const override;
+
+  std::string Name() const override { return "greedy_dual_size"; }
+
+  const EvictionPolicyStats &GetStats() const override { return stats_.Stats(); }
+
+ private:
+  using PriorityQueue = std::multimap<double, ObjectID>;
+
+  struct ObjectEntry {
+    int64_t size = 0;
+    bool is_primary_copy = false;
+    /// The number of times the object was used.
+    int64_t frequency = 1;
+    /// The position of the object in the priority queue, if it's unused.
+    PriorityQueue::iterator queue_it;
+    bool evictable = false;
+  };
+
+  /// Add an unused object to the priority queue.
+  void MakeEvictable(const ObjectID &object_id, ObjectEntry &entry);
+
+  /// Remove an object from the priority queue, if it's in there.
+  void MakeUnevictable(ObjectEntry &entry);
+
+  const int64_t fetch_overhead_bytes_;
+  const float primary_copy_cost_factor_;
+  /// The priority of the last evicted object.
+  double inflation_ = 0;
+  /// All objects created in the store.
+  absl::flat_hash_map<ObjectID, ObjectEntry> objects_;
+  /// The unused objects, ordered by priority.
+  PriorityQueue queue_;
+  /// The total size of the unused objects.
+  int64_t evictable_bytes_ = 0;
+
+  EvictionStatsTracker stats_;
+
+  const IObjectStore &object_store_;
+
+  const IAllocator &allocator_;
+};
+
+/// Create the eviction policy with the given name, see `plasma_eviction_policy`.
+std::unique_ptr<IEvictionPolicy> CreateEvictionPolicy(const std::string &name,
+                                                      const IObjectStore &object_store,
+                                                      const IAllocator &allocator);
+
 }  // namespace plasma
@@ -17,22 +17,33 @@
 namespace plasma {
 
 GetRequest::GetRequest(instrumented_io_context &io_context,
+                       ray::TimerWheel *timer_wheel,
                        const std::shared_ptr<ClientInterface> &client,
                        const std::vector<ObjectID> &object_ids,
                        bool is_from_worker,
-                       int64_t num_unique_objects_to_wait_for)
+                       int64_t num_unique_objects_to_wait_for,
+                       uint64_t request_id,
+                       bool allow_partial)
     : client(client),
       object_ids(object_ids.begin(), object_ids.end()),
       objects(object_ids.size()),
       num_unique_objects_to_wait_for(num_unique_objects_to_wait_for),
       num_unique_objects_satisfied(0),
       is_from_worker(is_from_worker),
-      timer_(io_context) {}
+      request_id(request_id),
+      allow_partial(allow_partial),
+      timer_(io_context),
+      timer_wheel_(timer_wheel) {}
 
 void GetRequest::AsyncWait(
     int64_t timeout_ms,
     std::function<void(const boost::system::error_code &)> on_timeout) {
   RAY_CHECK(!is_removed_);
+  if (timer_wheel_ != nullptr) {
+    timer_wheel_id_ = timer_wheel_->RunAfter(
+        timeout_ms, [on_timeout = std::move(on_timeout)]() { on_timeout({}); });
+    return;
+  }
   // Set an expiry time relative to now.
   timer_.expires_from_now(std::chrono::milliseconds(timeout_ms));
   timer_.async_wait(on_timeout);
@@ -40,6 +51,10 @@ void GetRequest::AsyncWait(
 
 void GetRequest::CancelTimer() {
   RAY_CHECK(!is_removed_);
+  if (timer_wheel_id_) {
+    timer_wheel_->Cancel(*timer_wheel_id_);
+    return;
+  }
   timer_.cancel();
 }
 
@@ -53,20 +68,26 @@ bool GetRequest::IsRemoved() const { return is_removed_; }
 void GetRequestQueue::AddRequest(const std::shared_ptr<ClientInterface> &client,
                                  const std::vector<ObjectID> &object_ids,
                                  int64_t timeout_ms,
-                                 bool is_from_worker) {
+                                 bool is_from_worker,
+                                 uint64_t request_id,
+                                 bool allow_partial) {
   const absl::flat_hash_set<ObjectID> unique_ids(object_ids.begin(), object_ids.end());
   // Create a get request for this object.
-  auto get_request = std::make_shared<GetRequest>(
-      io_context_, client, object_ids, is_from_worker, unique_ids.size());
+  auto get_request = std::make_shared<GetRequest>(io_context_,
+                                                  timer_wheel_.get(),
+                                                  client,
+                                                  object_ids,
+                                                  is_from_worker,
+                                                  unique_ids.size(),
+                                                  request_id,
+                                                  allow_partial);
   for (const auto &object_id : unique_ids) {
     // Check if this object is already present
     // locally. If so, record that the object is being used and mark it as accounted for.
     auto entry = object_lifecycle_mgr_.GetObject(object_id);
-    if (entry && entry->Sealed()) {
+    if (entry && CanReturnObject(*entry, *get_request)) {
       // Update the get request to take into account the present object.
-      entry->ToPlasmaObject(&get_request->objects[object_id], /* checksealed */ true);
-      get_request->num_unique_objects_satisfied += 1;
-      object_satisfied_callback_(object_id, get_request);
+      SatisfyObject(object_id, *entry, get_request);
     } else {
       // Add a placeholder plasma object to the get request to indicate that the
       // object is not present. This will be parsed by the client. We set the
@@ -90,6 +111,7 @@ void GetRequestQueue::AddRequest(const std::shared_ptr<ClientInterface> &client,
                            [this, get_request](const boost::system::error_code &ec) {
                              if (ec != boost::asio::error::operation_aborted) {
                                // Timer was not cancelled, take necessary action.
+                               absl::MutexLockMaybe lock(mutex_);
                                OnGetRequestCompleted(get_request);
                              }
                            });
@@ -147,47 +169,86 @@ void GetRequestQueue::RemoveGetRequest(const std::shared_ptr<GetRequest> &get_re
   get_request->MarkRemoved();
 }
 
-void GetRequestQueue::MarkObjectSealed(const ObjectID &object_id) {
+void GetRequestQueue::MarkObjectsSealed(const std::vector<ObjectID> &object_ids) {
+  std::vector<std::shared_ptr<GetRequest>> completed_requests;
+  for (const auto &object_id : object_ids) {
+    auto it = object_get_requests_.find(object_id);
+    // If there are no get requests involving this object, then skip it.
+    if (it == object_get_requests_.end()) {
+      continue;
+    }
+
+    // No get requests will wait for this object anymore. Take them out of the
+    // map first, so that completing them doesn't need to search this object's
+    // requests for each of them.
+    auto get_requests = std::move(it->second);
+    object_get_requests_.erase(it);
+
+    auto entry = object_lifecycle_mgr_.GetObject(object_id);
+    RAY_CHECK(entry != nullptr);
+    for (const auto &get_request : get_requests) {
+      SatisfyObject(object_id, *entry, get_request);
+      if (get_request->num_unique_objects_satisfied ==
+          get_request->num_unique_objects_to_wait_for) {
+        completed_requests.push_back(get_request);
+      }
+    }
+  }
+
+  // If a get request is done, reply to the client.
+  for (const auto &get_request : completed_requests) {
+    OnGetRequestCompleted(get_request);
+  }
+}
+
+void GetRequestQueue::MarkObjectCreated(const ObjectID &object_id) {
   auto it = object_get_requests_.find(object_id);
-  // If there are no get requests involving this object, then return.
   if (it == object_get_requests_.end()) {
     return;
   }
-
+  auto entry = object_lifecycle_mgr_.GetObject(object_id);
+  RAY_CHECK(entry != nullptr);
+  std::vector<std::shared_ptr<GetRequest>> completed_requests;
   auto &get_requests = it->second;
-
-  // After finishing the loop below, get_requests and it will have been
-  // invalidated by the removal of object_id from object_get_requests_.
-  size_t index = 0;
-  size_t num_requests = get_requests.size();
-  for (size_t i = 0; i < num_requests; ++i) {
-    auto get_request = get_requests[index];
-    auto entry = object_lifecycle_mgr_.GetObject(object_id);
-    RAY_CHECK(entry != nullptr);
-    entry->ToPlasmaObject(&get_request->objects[object_id], /* check sealed */ true);
-    get_request->num_unique_objects_satisfied += 1;
-    object_satisfied_callback_(object_id, get_request);
-    // If this get request is done, reply to the client.
+  for (auto request_it = get_requests.begin(); request_it != get_requests.end();) {
+    const auto get_request = *request_it;
+    if (!CanReturnObject(*entry, *get_request)) {
+      request_it++;
+      continue;
+    }
+    request_it = get_requests.erase(request_it);
+    SatisfyObject(object_id, *entry, get_request);
     if (get_request->num_unique_objects_satisfied ==
         get_request->num_unique_objects_to_wait_for) {
-      OnGetRequestCompleted(get_request);
-    } else {
-      // The call to ReturnFromGet will remove the current element in the
-      // array, so we only increment the counter in the else branch.
-      index += 1;
+      completed_requests.push_back(get_request);
     }
   }
+  if (get_requests.empty()) {
+    object_get_requests_.erase(it);
+  }
 
-  // No get requests should be waiting for this object anymore. The object ID
-  // may have been removed from the object_get_requests_ by ReturnFromGet, but
-  // if the get request has not returned yet, then remove the object ID from the
-  // map here.
-  it = object_get_requests_.find(object_id);
-  if (it != object_get_requests_.end()) {
-    object_get_requests_.erase(object_id);
+  for (const auto &get_request : completed_requests) {
+    OnGetRequestCompleted(get_request);
   }
 }
 
+bool GetRequestQueue::CanReturnObject(const LocalObject &entry,
+                                      const GetRequest &get_request) {
+  return entry.Sealed() ||
+         (get_request.allow_partial &&
+          entry.GetSource() == flatbuf::ObjectSource::ReceivedFromRemoteRaylet);
+}
+
+void GetRequestQueue::SatisfyObject(const ObjectID &object_id,
+                                    const LocalObject &entry,
+                                    const std::shared_ptr<GetRequest> &get_request) {
+  auto &object = get_request->objects[object_id];
+  entry.ToPlasmaObject(&object, /*check_sealed=*/false);
+  object.partial = !entry.Sealed();
+  get_request->num_unique_objects_satisfied += 1;
+  object_satisfied_callback_(object_id, get_request);
+}
+
 bool GetRequestQueue::IsGetRequestExist(const ObjectID &object_id) {
   return object_get_requests_.contains(object_id);
 }
@@ -14,8 +14,12 @@
 
 #pragma once
 
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 #include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/asio/timer_wheel.h"
 #include "ray/common/id.h"
+#include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/connection.h"
 #include "ray/object_manager/plasma/object_lifecycle_manager.h"
 
@@ -27,11 +31,16 @@ using AllObjectReadyCallback =
     std::function<void(const std::shared_ptr<GetRequest> &get_request)>;
 
 struct GetRequest {
+  /// \param timer_wheel If set, the timeout of the request is added to it, instead
+  /// of using a timer of its own.
   GetRequest(instrumented_io_context &io_context,
+             ray::TimerWheel *timer_wheel,
              const std::shared_ptr<ClientInterface> &client,
              const std::vector<ObjectID> &object_ids,
              bool is_from_worker,
-             int64_t num_unique_objects_to_wait_for);
+             int64_t num_unique_objects_to_wait_for,
+             uint64_t request_id = 0,
+             bool allow_partial = false);
   /// The client that called get.
   std::shared_ptr<ClientInterface> client;
   /// The object IDs involved in this request. This is used in the reply.
@@ -47,6 +56,11 @@ struct GetRequest {
   /// Whether or not the request comes from the core worker. It is used to track the size
   /// of total objects that are consumed by core worker.
   const bool is_from_worker;
+  /// The ID that the client matches the reply with.
+  const uint64_t request_id;
+  /// Whether the objects that are being received from another node are returned
+  /// before they are sealed.
+  const bool allow_partial;
 
   void AsyncWait(int64_t timeout_ms,
                  std::function<void(const boost::system::error_code &)> on_timeout);
@@ -62,6 +76,10 @@ struct GetRequest {
   /// The timer that will time out and cause this wait to return to
   /// the client if it hasn't already returned.
   boost::asio::steady_timer timer_;
+  /// If set, the timeout is added to this wheel instead of `timer_`.
+  ray::TimerWheel *timer_wheel_;
+  /// The ID of the timeout in `timer_wheel_`, if it is set.
+  absl::optional<ray::TimerWheel::TimerId> timer_wheel_id_;
   /// Whether or not if this get request is removed.
   /// Once the get request is removed, any operation on top of the get request shouldn't
   /// happen.
@@ -70,14 +88,27 @@ struct GetRequest {
 
 class GetRequestQueue {
  public:
+  /// \param mutex If set, the mutex that guards this queue. It is acquired before a
+  /// timed out request is completed, since the timer may fire on any thread that runs
+  /// the io context.
   GetRequestQueue(instrumented_io_context &io_context,
                   IObjectLifecycleManager &object_lifecycle_mgr,
                   ObjectReadyCallback object_callback,
-                  AllObjectReadyCallback all_objects_callback)
+                  AllObjectReadyCallback all_objects_callback,
+                  absl::Mutex *mutex = nullptr)
       : io_context_(io_context),
         object_lifecycle_mgr_(object_lifecycle_mgr),
         object_satisfied_callback_(object_callback),
-        all_objects_satisfied_callback_(all_objects_callback) {}
+        all_objects_satisfied_callback_(all_objects_callback),
+        mutex_(mutex) {
+    if (RayConfig::instance().plasma_get_timeout_tick_ms() > 0) {
+      timer_wheel_ = std::make_unique<ray::TimerWheel>(
+          io_context,
+          RayConfig::instance().plasma_get_timeout_tick_ms(),
+          /*num_slots=*/1024,
+          "GetRequestQueue.Timeout");
+    }
+  }
 
   /// Add a get request to get request queue. Note this will call callback functions
   /// directly if all objects has been satisfied, otherwise store the request
@@ -89,22 +120,42 @@ class GetRequestQueue {
   /// \param object_callback the callback function called once any object has been
   /// satisfied. \param all_objects_callback the callback function called when all objects
   /// has been satisfied.
+  /// \param request_id The ID to send back in the reply.
+  /// \param allow_partial Whether the objects that are being received from another
+  /// node satisfy the request before they are sealed.
   void AddRequest(const std::shared_ptr<ClientInterface> &client,
                   const std::vector<ObjectID> &object_ids,
                   int64_t timeout_ms,
-                  bool is_from_worker);
+                  bool is_from_worker,
+                  uint64_t request_id = 0,
+                  bool allow_partial = false);
 
   /// Remove all of the GetRequests for a given client.
   ///
   /// \param client The client whose GetRequests should be removed.
   void RemoveGetRequestsForClient(const std::shared_ptr<ClientInterface> &client);
 
-  /// Handle a sealed object, should be called when an object sealed. Mark
-  /// the object satisfied and call object callbacks.
-  /// \param object_id the object_id to mark.
-  void MarkObjectSealed(const ObjectID &object_id);
+  /// Handle sealed objects, should be called when objects are sealed. Mark
+  /// the objects satisfied and call object callbacks. The get requests that
+  /// are completed by the objects are replied to once all of the objects are
+  /// marked, so that a request waiting for several of them gets one reply.
+  /// \param object_ids the object_ids to mark.
+  void MarkObjectsSealed(const std::vector<ObjectID> &object_ids);
+
+  /// Handle an object that was created to be received from another node. The get
+  /// requests that allow partial objects are satisfied by it right away.
+  /// \param object_id The ID of the created object.
+  void MarkObjectCreated(const ObjectID &object_id);
 
  private:
+  /// Whether an object satisfies a get request, before or after it is sealed.
+  static bool CanReturnObject(const LocalObject &entry, const GetRequest &get_request);
+
+  /// Fill in an object of a get request, and call the object callback.
+  void SatisfyObject(const ObjectID &object_id,
+                     const LocalObject &entry,
+                     const std::shared_ptr<GetRequest> &get_request);
+
   /// Remove a GetRequest and clean up the relevant data structures.
   ///
   /// \param get_request The GetRequest to remove.
@@ -121,6 +172,9 @@ class GetRequestQueue {
 
   instrumented_io_context &io_context_;
 
+  /// If set, the timeouts of the get requests are added to this wheel.
+  std::unique_ptr<ray::TimerWheel> timer_wheel_;
+
   /// A hash table mapping object IDs to a vector of the get requests that are
   /// waiting for the object to arrive.
   absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<GetRequest>>>
@@ -131,6 +185,8 @@ class GetRequestQueue {
   ObjectReadyCallback object_satisfied_callback_;
   AllObjectReadyCallback all_objects_satisfied_callback_;
 
+  absl::Mutex *mutex_;
+
   friend struct GetRequestQueueTest;
 };
 
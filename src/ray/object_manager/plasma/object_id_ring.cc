@@ -0,0 +1,153 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/object_id_ring.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include "ray/util/logging.h"
+
+namespace plasma {
+
+/// The header at the start of the shared memory. The indices only grow, the entry of
+/// an index is at `index % capacity`. They are kept on separate cache lines, since
+/// each of them is written by a different process.
+struct ObjectIdRing::Header {
+  /// The index of the next ID to push, written by the producer.
+  alignas(64) std::atomic<uint64_t> head;
+  /// The index of the next ID to pop, written by the consumer.
+  alignas(64) std::atomic<uint64_t> tail;
+  /// The number of entries, written once by the creator.
+  alignas(64) int64_t capacity;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The ring needs lock free atomics to be shared between processes.");
+
+size_t ObjectIdRing::RegionSize(int64_t capacity) {
+  return sizeof(Header) + static_cast<size_t>(capacity) * ObjectID::Size();
+}
+
+std::unique_ptr<ObjectIdRing> ObjectIdRing::Create(int64_t capacity, int *fd) {
+  RAY_CHECK(capacity > 0);
+#if defined(__linux__) && defined(SYS_memfd_create)
+  const size_t region_size = RegionSize(capacity);
+  *fd = static_cast<int>(syscall(SYS_memfd_create, "plasma_ring", 0));
+  if (*fd < 0) {
+    RAY_LOG(WARNING) << "Failed to create the memory for an object ID ring, error "
+                     << std::strerror(errno);
+    return nullptr;
+  }
+  void *region = MAP_FAILED;
+  if (ftruncate(*fd, static_cast<off_t>(region_size)) == 0) {
+    region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+  }
+  if (region == MAP_FAILED) {
+    RAY_LOG(WARNING) << "Failed to map the memory for an object ID ring, error "
+                     << std::strerror(errno);
+    close(*fd);
+    *fd = -1;
+    return nullptr;
+  }
+  auto header = new (region) Header();
+  header->head.store(0);
+  header->tail.store(0);
+  header->capacity = capacity;
+  return std::unique_ptr<ObjectIdRing>(new ObjectIdRing(region, region_size, capacity));
+#else
+  *fd = -1;
+  return nullptr;
+#endif
+}
+
+std::unique_ptr<ObjectIdRing> ObjectIdRing::Attach(int fd) {
+#ifdef __linux__
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(Header)) {
+    return nullptr;
+  }
+  const size_t region_size = static_cast<size_t>(file_stat.st_size);
+  void *region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (region == MAP_FAILED) {
+    RAY_LOG(WARNING) << "Failed to map the memory of an object ID ring, error "
+                     << std::strerror(errno);
+    return nullptr;
+  }
+  const int64_t capacity = static_cast<Header *>(region)->capacity;
+  if (capacity <= 0 || RegionSize(capacity) > region_size) {
+    munmap(region, region_size);
+    return nullptr;
+  }
+  return std::unique_ptr<ObjectIdRing>(new ObjectIdRing(region, region_size, capacity));
+#else
+  return nullptr;
+#endif
+}
+
+ObjectIdRing::ObjectIdRing(void *region, size_t region_size, int64_t capacity)
+    : region_(region),
+      region_size_(region_size),
+      capacity_(capacity),
+      header_(static_cast<Header *>(region)) {}
+
+ObjectIdRing::~ObjectIdRing() {
+#ifdef __linux__
+  munmap(region_, region_size_);
+#endif
+}
+
+uint8_t *ObjectIdRing::Entry(uint64_t index) const {
+  return static_cast<uint8_t *>(region_) + sizeof(Header) +
+         (index % static_cast<uint64_t>(capacity_)) * ObjectID::Size();
+}
+
+bool ObjectIdRing::Push(const ObjectID &object_id, bool *needs_wakeup) {
+  const uint64_t head = header_->head.load(std::memory_order_relaxed);
+  if (head - header_->tail.load(std::memory_order_acquire) >=
+      static_cast<uint64_t>(capacity_)) {
+    return false;
+  }
+  std::memcpy(Entry(head), object_id.Data(), ObjectID::Size());
+  // Publishing the ID and then checking whether the consumer already popped every
+  // earlier ID must be ordered, like the consumer's pop and its check for more IDs.
+  // Either the consumer sees this ID, or we see that it may be waiting.
+  header_->head.store(head + 1, std::memory_order_seq_cst);
+  *needs_wakeup = header_->tail.load(std::memory_order_seq_cst) == head;
+  return true;
+}
+
+bool ObjectIdRing::Pop(ObjectID *object_id) {
+  const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  const uint64_t head = header_->head.load(std::memory_order_seq_cst);
+  // Don't trust a head that is further ahead than the producer can push.
+  if (head == tail || head - tail > static_cast<uint64_t>(capacity_)) {
+    return false;
+  }
+  *object_id = ObjectID::FromBinary(std::string(
+      reinterpret_cast<const char *>(Entry(tail)), ObjectID::Size()));
+  header_->tail.store(tail + 1, std::memory_order_seq_cst);
+  return true;
+}
+
+}  // namespace plasma
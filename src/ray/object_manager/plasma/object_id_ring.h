@@ -0,0 +1,90 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "ray/common/id.h"
+#include "ray/util/macros.h"
+
+namespace plasma {
+
+using ray::ObjectID;
+
+/// A bounded queue of object IDs in memory shared between a single producer and a
+/// single consumer process. A plasma client pushes the IDs of the objects it releases
+/// to the ring, and the store pops them, which saves a message on the socket per
+/// release.
+///
+/// The producer should wake up the consumer when `Push` reports that the consumer may
+/// have seen the ring empty. The consumer pops until the ring is empty, so it never
+/// misses an ID pushed without a wakeup.
+///
+/// The ring is only supported on Linux, where it is backed by a memfd.
+class ObjectIdRing {
+ public:
+  /// Create a ring in a new memfd that can hold `capacity` object IDs.
+  ///
+  /// \param capacity The number of object IDs the ring can hold.
+  /// \param[out] fd The file descriptor of the memory backing the ring. The caller
+  /// owns it, and may close it once it has been sent to the other process.
+  /// \return The ring, or nullptr if it could not be created.
+  static std::unique_ptr<ObjectIdRing> Create(int64_t capacity, int *fd);
+
+  /// Map a ring created by another process.
+  ///
+  /// \param fd The file descriptor of the memory backing the ring.
+  /// \return The ring, or nullptr if the memory is not a valid ring.
+  static std::unique_ptr<ObjectIdRing> Attach(int fd);
+
+  ~ObjectIdRing();
+
+  /// Push an object ID to the ring. This must only be called by the producer.
+  ///
+  /// \param object_id The object ID to push.
+  /// \param[out] needs_wakeup Set to true if the consumer should be woken up.
+  /// \return Whether the ID was pushed, false if the ring is full.
+  bool Push(const ObjectID &object_id, bool *needs_wakeup);
+
+  /// Pop the oldest object ID from the ring. This must only be called by the consumer.
+  ///
+  /// \param[out] object_id The popped object ID.
+  /// \return Whether an ID was popped, false if the ring is empty.
+  bool Pop(ObjectID *object_id);
+
+  /// The number of object IDs the ring can hold.
+  int64_t Capacity() const { return capacity_; }
+
+ private:
+  struct Header;
+
+  ObjectIdRing(void *region, size_t region_size, int64_t capacity);
+
+  /// The size of the shared memory for a ring of the given capacity.
+  static size_t RegionSize(int64_t capacity);
+
+  uint8_t *Entry(uint64_t index) const;
+
+  void *region_;
+  const size_t region_size_;
+  const int64_t capacity_;
+  Header *header_;
+
+  RAY_DISALLOW_COPY_AND_ASSIGN(ObjectIdRing);
+};
+
+}  // namespace plasma
@@ -19,6 +19,7 @@
 
 #include "absl/time/clock.h"
 #include "ray/common/ray_config.h"
+#include "ray/stats/metric_defs.h"
 
 namespace plasma {
 using namespace flatbuf;
@@ -26,10 +27,17 @@ using namespace flatbuf;
 ObjectLifecycleManager::ObjectLifecycleManager(
     IAllocator &allocator, ray::DeleteObjectCallback delete_object_callback)
     : object_store_(std::make_unique<ObjectStore>(allocator)),
-      eviction_policy_(std::make_unique<EvictionPolicy>(*object_store_, allocator)),
+      eviction_policy_(CreateEvictionPolicy(
+          RayConfig::instance().plasma_eviction_policy(), *object_store_, allocator)),
       delete_object_callback_(delete_object_callback),
       earger_deletion_objects_(),
-      stats_collector_() {}
+      stats_collector_(),
+      job_soft_quota_bytes_(
+          allocator.GetFootprintLimit() *
+          RayConfig::instance().object_store_job_soft_quota_fraction()),
+      job_hard_quota_bytes_(
+          allocator.GetFootprintLimit() *
+          RayConfig::instance().object_store_job_hard_quota_fraction()) {}
 
 std::pair<const LocalObject *, flatbuf::PlasmaError> ObjectLifecycleManager::CreateObject(
     const ray::ObjectInfo &object_info,
@@ -40,7 +48,27 @@ std::pair<const LocalObject *, flatbuf::PlasmaError> ObjectLifecycleManager::Cre
   if (object_store_->GetObject(object_info.object_id) != nullptr) {
     return {nullptr, PlasmaError::ObjectExists};
   }
-  auto entry = CreateObjectInternal(object_info, source, fallback_allocator);
+  // The quotas only apply to the objects that workers create. The objects that the
+  // raylet pulls or restores are already admitted by the pull manager.
+  bool allow_shared_memory = true;
+  bool allow_eviction = true;
+  if (source == plasma::flatbuf::ObjectSource::CreatedByWorker &&
+      (job_soft_quota_bytes_ > 0 || job_hard_quota_bytes_ > 0)) {
+    const auto job_id = object_info.object_id.TaskId().JobId();
+    const int64_t job_bytes =
+        stats_collector_.GetNumBytesOfJob(job_id) + object_info.GetObjectSize();
+    if (job_hard_quota_bytes_ > 0 && job_bytes > job_hard_quota_bytes_) {
+      allow_shared_memory = false;
+      ray::stats::STATS_object_store_job_quota_exceeded.Record(
+          1, {{"JobId", job_id.Hex()}, {"Quota", "Hard"}});
+    } else if (job_soft_quota_bytes_ > 0 && job_bytes > job_soft_quota_bytes_) {
+      allow_eviction = false;
+      ray::stats::STATS_object_store_job_quota_exceeded.Record(
+          1, {{"JobId", job_id.Hex()}, {"Quota", "Soft"}});
+    }
+  }
+  auto entry = CreateObjectInternal(
+      object_info, source, fallback_allocator, allow_shared_memory, allow_eviction);
 
   if (entry == nullptr) {
     return {nullptr, PlasmaError::OutOfMemory};
@@ -174,17 +202,24 @@ std::string ObjectLifecycleManager::EvictionPolicyDebugString() const {
 const LocalObject *ObjectLifecycleManager::CreateObjectInternal(
     const ray::ObjectInfo &object_info,
     plasma::flatbuf::ObjectSource source,
-    bool allow_fallback_allocation) {
+    bool allow_fallback_allocation,
+    bool allow_shared_memory,
+    bool allow_eviction) {
   // Try to evict objects until there is enough space.
   // NOTE(ekl) if we can't achieve this after a number of retries, it's
   // because memory fragmentation in dlmalloc prevents us from allocating
   // even if our footprint tracker here still says we have free space.
-  for (int num_tries = 0; num_tries <= 10; num_tries++) {
+  for (int num_tries = 0; allow_shared_memory && num_tries <= 10; num_tries++) {
     auto result =
         object_store_->CreateObject(object_info, source, /*fallback_allocate*/ false);
     if (result != nullptr) {
       return result;
     }
+    if (!allow_eviction) {
+      RAY_LOG(DEBUG) << "The job of " << object_info.object_id
+                     << " is over its soft quota, not evicting objects.";
+      break;
+    }
     // Tell the eviction policy how much space we need to create this object.
     std::vector<ObjectID> objects_to_evict;
     int64_t space_needed =
@@ -271,7 +306,10 @@ int64_t ObjectLifecycleManager::GetNumObjectsUnsealed() const {
   return stats_collector_.GetNumObjectsUnsealed();
 }
 
-void ObjectLifecycleManager::RecordMetrics() const { stats_collector_.RecordMetrics(); }
+void ObjectLifecycleManager::RecordMetrics() const {
+  stats_collector_.RecordMetrics();
+  stats_collector_.RecordEvictionPolicyMetrics(*eviction_policy_);
+}
 
 void ObjectLifecycleManager::GetDebugDump(std::stringstream &buffer) const {
   return stats_collector_.GetDebugDump(buffer);
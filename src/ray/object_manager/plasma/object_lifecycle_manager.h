@@ -149,9 +149,14 @@ class ObjectLifecycleManager : public IObjectLifecycleManager {
                          std::unique_ptr<IEvictionPolicy> eviction_policy,
                          ray::DeleteObjectCallback delete_object_callback);
 
+  /// \param allow_shared_memory Whether the object may be allocated in shared
+  /// memory, rather than only by the fallback allocator.
+  /// \param allow_eviction Whether to evict objects to make space in shared memory.
   const LocalObject *CreateObjectInternal(const ray::ObjectInfo &object_info,
                                           plasma::flatbuf::ObjectSource source,
-                                          bool allow_fallback_allocation);
+                                          bool allow_fallback_allocation,
+                                          bool allow_shared_memory,
+                                          bool allow_eviction);
 
   // Evict objects returned by the eviction policy.
   //
@@ -177,6 +182,14 @@ class ObjectLifecycleManager : public IObjectLifecycleManager {
   absl::flat_hash_set<ObjectID> earger_deletion_objects_;
 
   ObjectStatsCollector stats_collector_;
+
+  /// The bytes of shared memory the objects of each job may take before the objects
+  /// its workers create stop evicting other objects, or 0 if unlimited. See
+  /// `object_store_job_soft_quota_fraction`.
+  const int64_t job_soft_quota_bytes_ = 0;
+  /// The bytes of shared memory the objects of each job may never exceed, or 0 if
+  /// unlimited. See `object_store_job_hard_quota_fraction`.
+  const int64_t job_hard_quota_bytes_ = 0;
 };
 
 }  // namespace plasma
@@ -0,0 +1,89 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <limits>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/object_manager/plasma/object_lifecycle_manager.h"
+
+namespace plasma {
+
+/// An allocator that doesn't allocate any memory, so that only the bookkeeping of the
+/// objects is measured.
+class DummyAllocator : public IAllocator {
+ public:
+  absl::optional<Allocation> Allocate(size_t bytes) override {
+    allocated_ += bytes;
+    auto allocation = Allocation();
+    allocation.size = bytes;
+    return std::move(allocation);
+  }
+
+  absl::optional<Allocation> FallbackAllocate(size_t bytes) override {
+    return absl::nullopt;
+  }
+
+  void Free(Allocation allocation) override { allocated_ -= allocation.size; }
+
+  int64_t GetFootprintLimit() const override {
+    return std::numeric_limits<int64_t>::max();
+  }
+
+  int64_t Allocated() const override { return allocated_; }
+
+  int64_t FallbackAllocated() const override { return 0; }
+
+ private:
+  int64_t allocated_ = 0;
+};
+
+namespace {
+
+std::vector<ray::ObjectInfo> CreateObjectInfos(int num_objects, int64_t object_size) {
+  std::vector<ray::ObjectInfo> infos(num_objects);
+  const auto job_id = ray::JobID::FromInt(1);
+  for (auto &info : infos) {
+    info.object_id = ray::ObjectID::FromIndex(ray::TaskID::FromRandom(job_id), 1);
+    info.data_size = object_size;
+    info.metadata_size = 0;
+  }
+  return infos;
+}
+
+/// The lifecycle of many small objects: created, sealed, read once, released and
+/// deleted.
+void BM_CreateSealDelete(benchmark::State &state) {
+  DummyAllocator allocator;
+  ObjectLifecycleManager manager(allocator, [](const ray::ObjectID &) {});
+  const auto infos = CreateObjectInfos(state.range(0), /*object_size=*/1024);
+  for (auto _ : state) {
+    for (const auto &info : infos) {
+      manager.CreateObject(
+          info, flatbuf::ObjectSource::CreatedByWorker, /*fallback_allocator=*/false);
+      manager.SealObject(info.object_id);
+      manager.AddReference(info.object_id);
+      manager.RemoveReference(info.object_id);
+    }
+    for (const auto &info : infos) {
+      manager.DeleteObject(info.object_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * infos.size());
+}
+BENCHMARK(BM_CreateSealDelete)->Arg(1 << 10)->Arg(1 << 16);
+
+}  // namespace
+
+}  // namespace plasma
@@ -49,6 +49,9 @@ struct PlasmaObject {
   int device_num;
   /// Set if device_num is equal to 0.
   int64_t mmap_size;
+  /// Whether the object is still being received from another node, and only the
+  /// bytes that the store reported as written can be read.
+  bool partial = false;
 
   bool operator==(const PlasmaObject &other) const {
     return ((store_fd == other.store_fd) && (data_offset == other.data_offset) &&
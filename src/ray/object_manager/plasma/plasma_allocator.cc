@@ -17,6 +17,8 @@
 
 #include "ray/object_manager/plasma/plasma_allocator.h"
 
+#include <algorithm>
+
 #include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/malloc.h"
 #include "ray/util/logging.h"
@@ -56,16 +58,36 @@ const size_t kAllocationAlignment = 64;
 // bookkeeping.
 const int64_t kDlMallocReserved = 256 * sizeof(size_t);
 
+// Size of a page of small objects. The largest size class holds at least
+// kMinSlotsPerPage slots per page.
+const size_t kSmallObjectPageSize = 256 * 1024;
+const size_t kMinSlotsPerPage = 4;
+
 }  // namespace
 
 PlasmaAllocator::PlasmaAllocator(const std::string &plasma_directory,
                                  const std::string &fallback_directory,
                                  bool hugepage_enabled,
-                                 int64_t footprint_limit)
+                                 int64_t footprint_limit,
+                                 size_t small_object_max_size)
     : kFootprintLimit(footprint_limit),
       kAlignment(kAllocationAlignment),
       allocated_(0),
-      fallback_allocated_(0) {
+      fallback_allocated_(0),
+      small_object_max_size_(
+          std::min(small_object_max_size, kSmallObjectPageSize / kMinSlotsPerPage)),
+      small_object_page_bytes_(0),
+      small_object_bytes_(0) {
+  if (small_object_max_size_ > 0) {
+    for (size_t slot_size = kAlignment;; slot_size *= 2) {
+      SizeClass size_class;
+      size_class.slot_size = slot_size;
+      size_classes_.push_back(std::move(size_class));
+      if (slot_size >= small_object_max_size_) {
+        break;
+      }
+    }
+  }
   internal::SetDLMallocConfig(plasma_directory,
                               fallback_directory,
                               hugepage_enabled,
@@ -83,7 +105,13 @@ PlasmaAllocator::PlasmaAllocator(const std::string &plasma_directory,
 
 absl::optional<Allocation> PlasmaAllocator::Allocate(size_t bytes) {
   RAY_LOG(DEBUG) << "allocating " << bytes;
-  void *mem = dlmemalign(kAlignment, bytes);
+  void *mem = nullptr;
+  if (bytes > 0 && bytes <= small_object_max_size_) {
+    mem = AllocateSmallObject(bytes);
+  }
+  if (!mem) {
+    mem = dlmemalign(kAlignment, bytes);
+  }
   RAY_LOG(DEBUG) << "allocated " << bytes << " at " << mem;
   if (!mem) {
     return absl::nullopt;
@@ -107,16 +135,23 @@ absl::optional<Allocation> PlasmaAllocator::FallbackAllocate(size_t bytes) {
 
   allocated_ += bytes;
   // The allocation was servicable using the initial region, no need to fallback.
-  if (internal::IsOutsideInitialAllocation(mem)) {
+  const bool outside_initial_allocation = internal::IsOutsideInitialAllocation(mem);
+  if (outside_initial_allocation) {
     fallback_allocated_ += bytes;
   }
-  return BuildAllocation(mem, bytes);
+  auto allocation = BuildAllocation(mem, bytes);
+  if (allocation.has_value()) {
+    allocation->fallback_allocated = outside_initial_allocation;
+  }
+  return allocation;
 }
 
 void PlasmaAllocator::Free(Allocation allocation) {
   RAY_CHECK(allocation.address != nullptr) << "Cannot free the nullptr";
   RAY_LOG(DEBUG) << "deallocating " << allocation.size << " at " << allocation.address;
-  dlfree(allocation.address);
+  if (!FreeSmallObject(allocation.address, allocation.size)) {
+    dlfree(allocation.address);
+  }
   allocated_ -= allocation.size;
   if (internal::IsOutsideInitialAllocation(allocation.address)) {
     fallback_allocated_ -= allocation.size;
@@ -129,6 +164,78 @@ int64_t PlasmaAllocator::Allocated() const { return allocated_; }
 
 int64_t PlasmaAllocator::FallbackAllocated() const { return fallback_allocated_; }
 
+int64_t PlasmaAllocator::SmallObjectUnusedBytes() const {
+  return small_object_page_bytes_ - small_object_bytes_;
+}
+
+void *PlasmaAllocator::AllocateSmallObject(size_t bytes) {
+  size_t index = 0;
+  while (size_classes_[index].slot_size < bytes) {
+    index++;
+  }
+  auto &size_class = size_classes_[index];
+  if (size_class.pages_with_free_slots.empty()) {
+    auto *address = static_cast<uint8_t *>(dlmemalign(kAlignment, kSmallObjectPageSize));
+    if (!address) {
+      return nullptr;
+    }
+    auto page = std::make_unique<SmallObjectPage>();
+    page->address = address;
+    page->size_class = index;
+    const size_t num_slots = kSmallObjectPageSize / size_class.slot_size;
+    page->free_slots.reserve(num_slots);
+    // Hand out the slots in address order.
+    for (size_t slot = num_slots; slot > 0; slot--) {
+      page->free_slots.push_back(slot - 1);
+    }
+    size_class.pages_with_free_slots.insert(page.get());
+    size_class.num_pages++;
+    small_object_page_bytes_ += kSmallObjectPageSize;
+    small_object_pages_.emplace(reinterpret_cast<uintptr_t>(address), std::move(page));
+  }
+  auto *page = *size_class.pages_with_free_slots.begin();
+  const uint32_t slot = page->free_slots.back();
+  page->free_slots.pop_back();
+  page->num_used++;
+  if (page->free_slots.empty()) {
+    size_class.pages_with_free_slots.erase(page);
+  }
+  small_object_bytes_ += bytes;
+  return page->address + slot * size_class.slot_size;
+}
+
+bool PlasmaAllocator::FreeSmallObject(void *address, size_t bytes) {
+  if (small_object_pages_.empty()) {
+    return false;
+  }
+  const auto addr = reinterpret_cast<uintptr_t>(address);
+  auto it = small_object_pages_.upper_bound(addr);
+  if (it == small_object_pages_.begin()) {
+    return false;
+  }
+  it--;
+  if (addr >= it->first + kSmallObjectPageSize) {
+    return false;
+  }
+  auto *page = it->second.get();
+  auto &size_class = size_classes_[page->size_class];
+  page->free_slots.push_back((addr - it->first) / size_class.slot_size);
+  page->num_used--;
+  small_object_bytes_ -= bytes;
+  if (page->num_used == 0 && size_class.num_pages > 1) {
+    // Give the page back to dlmalloc, so that its memory can be used for
+    // objects of any size.
+    size_class.pages_with_free_slots.erase(page);
+    size_class.num_pages--;
+    small_object_page_bytes_ -= kSmallObjectPageSize;
+    dlfree(page->address);
+    small_object_pages_.erase(it);
+  } else {
+    size_class.pages_with_free_slots.insert(page);
+  }
+  return true;
+}
+
 absl::optional<Allocation> PlasmaAllocator::BuildAllocation(void *addr, size_t size) {
   if (addr == nullptr) {
     return absl::nullopt;
@@ -20,7 +20,11 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/types/optional.h"
 #include "ray/object_manager/plasma/allocator.h"
 #include "ray/object_manager/plasma/common.h"
@@ -38,12 +42,20 @@ namespace plasma {
 //
 // The FallbackAllocate always allocates memory from a disk
 // based mmapped file.
+//
+// If small_object_max_size is set, objects up to that size are allocated
+// from pages carved out of the dlmalloc arena, each page holding slots of a
+// single size class (a power of two). This keeps small objects from
+// fragmenting the arena between the large ones. A page is given back to
+// dlmalloc once all its slots are free, unless it is the last page of its
+// size class.
 class PlasmaAllocator : public IAllocator {
  public:
   PlasmaAllocator(const std::string &plasma_directory,
                   const std::string &fallback_directory,
                   bool hugepage_enabled,
-                  int64_t footprint_limit);
+                  int64_t footprint_limit,
+                  size_t small_object_max_size = 0);
 
   /// On linux, it allocates memory from a pre-mmapped file from /dev/shm.
   /// On other system, it allocates memory from a pre-mmapped file on disk.
@@ -83,9 +95,46 @@ class PlasmaAllocator : public IAllocator {
   /// Get the number of bytes fallback allocated so far.
   int64_t FallbackAllocated() const override;
 
+  /// Get the number of bytes in the pages of small objects that are not used by
+  /// any object, either because the slot is free or because the object is
+  /// smaller than its slot.
+  int64_t SmallObjectUnusedBytes() const;
+
  private:
   absl::optional<Allocation> BuildAllocation(void *addr, size_t size);
 
+  /// A page of slots of a single size class.
+  struct SmallObjectPage {
+    /// Start of the page.
+    uint8_t *address;
+    /// Index of the size class of the slots.
+    size_t size_class;
+    /// Indices of the free slots.
+    std::vector<uint32_t> free_slots;
+    /// Number of slots in use.
+    size_t num_used = 0;
+  };
+
+  /// The pages of a size class.
+  struct SizeClass {
+    /// Size of the slots.
+    size_t slot_size;
+    /// Number of pages of this class.
+    size_t num_pages = 0;
+    /// Pages that have free slots.
+    absl::flat_hash_set<SmallObjectPage *> pages_with_free_slots;
+  };
+
+  /// Allocate a slot for a small object, or return nullptr if there is no
+  /// space for a new page.
+  void *AllocateSmallObject(size_t bytes);
+
+  /// Free the slot of a small object, if the address is in a page of small
+  /// objects.
+  ///
+  /// eturn Whether the address was a small object.
+  bool FreeSmallObject(void *address, size_t bytes);
+
  private:
   const int64_t kFootprintLimit;
   const size_t kAlignment;
@@ -93,6 +142,17 @@ class PlasmaAllocator : public IAllocator {
   // TODO(scv119): once we refactor object_manager this no longer
   // need to be atomic.
   std::atomic<int64_t> fallback_allocated_;
+
+  /// Objects up to this size are allocated from pages of size classes. 0
+  /// disables the pages.
+  const size_t small_object_max_size_;
+  /// The size classes, smallest first.
+  std::vector<SizeClass> size_classes_;
+  /// All pages of small objects, by start address.
+  std::map<uintptr_t, std::unique_ptr<SmallObjectPage>> small_object_pages_;
+  /// Bytes of the pages of small objects, and of the small objects in them.
+  std::atomic<int64_t> small_object_page_bytes_;
+  std::atomic<int64_t> small_object_bytes_;
 };
 
 }  // namespace plasma
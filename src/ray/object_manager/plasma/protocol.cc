@@ -84,6 +84,18 @@ flatbuffers::Offset<flatbuffers::Vector<int64_t>> ToFlatbuffer(
   return fbb->CreateVector(MakeNonNull(data.data()), data.size());
 }
 
+Status PlasmaReceiveAny(const std::shared_ptr<StoreConn> &store_conn,
+                        MessageType *message_type,
+                        std::vector<uint8_t> *buffer) {
+  if (!store_conn) {
+    return Status::IOError("Connection is closed.");
+  }
+  int64_t type;
+  RAY_RETURN_NOT_OK(store_conn->ReadAnyMessage(&type, buffer));
+  *message_type = static_cast<MessageType>(type);
+  return Status::OK();
+}
+
 Status PlasmaReceive(const std::shared_ptr<StoreConn> &store_conn,
                      MessageType message_type,
                      std::vector<uint8_t> *buffer) {
@@ -116,6 +128,15 @@ void ConvertToVector(const FlatbufferVectorPointer fbvector,
   }
 }
 
+// Helper function to read a vector of object IDs from a flatbuffer.
+void ToObjectIds(
+    const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *fbvector,
+    std::vector<ObjectID> *object_ids) {
+  ConvertToVector(fbvector, object_ids, [](const flatbuffers::String &object_id) {
+    return ObjectID::FromBinary(object_id.str());
+  });
+}
+
 template <typename Message>
 Status PlasmaSend(const std::shared_ptr<StoreConn> &store_conn,
                   MessageType message_type,
@@ -373,6 +394,109 @@ Status ReadSealReply(uint8_t *data, size_t size, ObjectID *object_id) {
   return PlasmaErrorStatus(message->error());
 }
 
+Status SendSealBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                            const std::vector<ObjectID> &object_ids) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaSealBatchRequest(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()));
+  return PlasmaSend(store_conn, MessageType::PlasmaSealBatchRequest, &fbb, message);
+}
+
+Status ReadSealBatchRequest(uint8_t *data,
+                            size_t size,
+                            std::vector<ObjectID> *object_ids) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaSealBatchRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ToObjectIds(message->object_ids(), object_ids);
+  return Status::OK();
+}
+
+Status SendSealBatchReply(const std::shared_ptr<Client> &client,
+                          const std::vector<ObjectID> &object_ids,
+                          PlasmaError error) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaSealBatchReply(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()), error);
+  return PlasmaSend(client, MessageType::PlasmaSealBatchReply, &fbb, message);
+}
+
+Status ReadSealBatchReply(uint8_t *data,
+                          size_t size,
+                          std::vector<ObjectID> *object_ids) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaSealBatchReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ToObjectIds(message->object_ids(), object_ids);
+  return PlasmaErrorStatus(message->error());
+}
+
+// Streaming read messages.
+
+Status SendSealPrefixRequest(const std::shared_ptr<StoreConn> &store_conn,
+                             const ObjectID &object_id,
+                             int64_t num_bytes) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaSealPrefixRequest(
+      fbb, fbb.CreateString(object_id.Binary()), num_bytes);
+  return PlasmaSend(store_conn, MessageType::PlasmaSealPrefixRequest, &fbb, message);
+}
+
+Status ReadSealPrefixRequest(uint8_t *data,
+                             size_t size,
+                             ObjectID *object_id,
+                             int64_t *num_bytes) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaSealPrefixRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *object_id = ObjectID::FromBinary(message->object_id()->str());
+  *num_bytes = message->num_bytes();
+  return Status::OK();
+}
+
+Status SendWaitPrefixRequest(const std::shared_ptr<StoreConn> &store_conn,
+                             const ObjectID &object_id,
+                             int64_t num_bytes) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaWaitPrefixRequest(
+      fbb, fbb.CreateString(object_id.Binary()), num_bytes);
+  return PlasmaSend(store_conn, MessageType::PlasmaWaitPrefixRequest, &fbb, message);
+}
+
+Status ReadWaitPrefixRequest(uint8_t *data,
+                             size_t size,
+                             ObjectID *object_id,
+                             int64_t *num_bytes) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaWaitPrefixRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *object_id = ObjectID::FromBinary(message->object_id()->str());
+  *num_bytes = message->num_bytes();
+  return Status::OK();
+}
+
+Status SendWaitPrefixReply(const std::shared_ptr<Client> &client,
+                           const ObjectID &object_id,
+                           int64_t num_bytes,
+                           PlasmaError error) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaWaitPrefixReply(
+      fbb, fbb.CreateString(object_id.Binary()), num_bytes, error);
+  return PlasmaSend(client, MessageType::PlasmaWaitPrefixReply, &fbb, message);
+}
+
+Status ReadWaitPrefixReply(uint8_t *data,
+                           size_t size,
+                           ObjectID *object_id,
+                           int64_t *num_bytes) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaWaitPrefixReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *object_id = ObjectID::FromBinary(message->object_id()->str());
+  *num_bytes = message->num_bytes();
+  return PlasmaErrorStatus(message->error());
+}
+
 // Release messages.
 
 Status SendReleaseRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -408,6 +532,24 @@ Status ReadReleaseReply(uint8_t *data, size_t size, ObjectID *object_id) {
   return PlasmaErrorStatus(message->error());
 }
 
+Status SendReleaseBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                               const std::vector<ObjectID> &object_ids) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaReleaseBatchRequest(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()));
+  return PlasmaSend(store_conn, MessageType::PlasmaReleaseBatchRequest, &fbb, message);
+}
+
+Status ReadReleaseBatchRequest(uint8_t *data,
+                               size_t size,
+                               std::vector<ObjectID> *object_ids) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaReleaseBatchRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ToObjectIds(message->object_ids(), object_ids);
+  return Status::OK();
+}
+
 // Delete objects messages.
 
 Status SendDeleteRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -508,25 +650,39 @@ Status ReadContainsReply(uint8_t *data,
 
 // Connect messages.
 
-Status SendConnectRequest(const std::shared_ptr<StoreConn> &store_conn) {
+Status SendConnectRequest(const std::shared_ptr<StoreConn> &store_conn,
+                          int64_t release_ring_capacity) {
   flatbuffers::FlatBufferBuilder fbb;
-  auto message = fb::CreatePlasmaConnectRequest(fbb);
+  auto message = fb::CreatePlasmaConnectRequest(fbb, release_ring_capacity);
   return PlasmaSend(store_conn, MessageType::PlasmaConnectRequest, &fbb, message);
 }
 
-Status ReadConnectRequest(uint8_t *data) { return Status::OK(); }
+Status ReadConnectRequest(uint8_t *data, size_t size, int64_t *release_ring_capacity) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaConnectRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *release_ring_capacity = message->release_ring_capacity();
+  return Status::OK();
+}
 
-Status SendConnectReply(const std::shared_ptr<Client> &client, int64_t memory_capacity) {
+Status SendConnectReply(const std::shared_ptr<Client> &client,
+                        int64_t memory_capacity,
+                        int64_t release_ring_capacity) {
   flatbuffers::FlatBufferBuilder fbb;
-  auto message = fb::CreatePlasmaConnectReply(fbb, memory_capacity);
+  auto message =
+      fb::CreatePlasmaConnectReply(fbb, memory_capacity, release_ring_capacity);
   return PlasmaSend(client, MessageType::PlasmaConnectReply, &fbb, message);
 }
 
-Status ReadConnectReply(uint8_t *data, size_t size, int64_t *memory_capacity) {
+Status ReadConnectReply(uint8_t *data,
+                        size_t size,
+                        int64_t *memory_capacity,
+                        int64_t *release_ring_capacity) {
   RAY_DCHECK(data);
   auto message = flatbuffers::GetRoot<fb::PlasmaConnectReply>(data);
   RAY_DCHECK(VerifyFlatbuffer(message, data, size));
   *memory_capacity = message->memory_capacity();
+  *release_ring_capacity = message->release_ring_capacity();
   return Status::OK();
 }
 
@@ -566,10 +722,16 @@ Status SendGetRequest(const std::shared_ptr<StoreConn> &store_conn,
                       const ObjectID *object_ids,
                       int64_t num_objects,
                       int64_t timeout_ms,
-                      bool is_from_worker) {
+                      bool is_from_worker,
+                      uint64_t request_id,
+                      bool allow_partial) {
   flatbuffers::FlatBufferBuilder fbb;
-  auto message = fb::CreatePlasmaGetRequest(
-      fbb, ToFlatbuffer(&fbb, object_ids, num_objects), timeout_ms, is_from_worker);
+  auto message = fb::CreatePlasmaGetRequest(fbb,
+                                            ToFlatbuffer(&fbb, object_ids, num_objects),
+                                            timeout_ms,
+                                            is_from_worker,
+                                            request_id,
+                                            allow_partial);
   return PlasmaSend(store_conn, MessageType::PlasmaGetRequest, &fbb, message);
 }
 
@@ -577,7 +739,9 @@ Status ReadGetRequest(uint8_t *data,
                       size_t size,
                       std::vector<ObjectID> &object_ids,
                       int64_t *timeout_ms,
-                      bool *is_from_worker) {
+                      bool *is_from_worker,
+                      uint64_t *request_id,
+                      bool *allow_partial) {
   RAY_DCHECK(data);
   auto message = flatbuffers::GetRoot<fb::PlasmaGetRequest>(data);
   RAY_DCHECK(VerifyFlatbuffer(message, data, size));
@@ -587,6 +751,8 @@ Status ReadGetRequest(uint8_t *data,
   }
   *timeout_ms = message->timeout_ms();
   *is_from_worker = message->is_from_worker();
+  *request_id = message->request_id();
+  *allow_partial = message->allow_partial();
   return Status::OK();
 }
 
@@ -595,13 +761,19 @@ Status SendGetReply(const std::shared_ptr<Client> &client,
                     absl::flat_hash_map<ObjectID, PlasmaObject> &plasma_objects,
                     int64_t num_objects,
                     const std::vector<MEMFD_TYPE> &store_fds,
-                    const std::vector<int64_t> &mmap_sizes) {
+                    const std::vector<int64_t> &mmap_sizes,
+                    uint64_t request_id) {
   flatbuffers::FlatBufferBuilder fbb;
   std::vector<PlasmaObjectSpec> objects;
 
   std::vector<flatbuffers::Offset<fb::CudaHandle>> handles;
+  std::vector<uint8_t> partial;
   for (int64_t i = 0; i < num_objects; ++i) {
     const PlasmaObject &object = plasma_objects[object_ids[i]];
+    if (object.partial) {
+      partial.resize(num_objects, false);
+      partial[i] = true;
+    }
     RAY_LOG(DEBUG) << "Sending object info, id: " << object_ids[i]
                    << " data_size: " << object.data_size
                    << " metadata_size: " << object.metadata_size;
@@ -626,10 +798,19 @@ Status SendGetReply(const std::shared_ptr<Client> &client,
       fbb.CreateVector(MakeNonNull(store_fds_as_int.data()), store_fds_as_int.size()),
       fbb.CreateVector(MakeNonNull(unique_fd_ids.data()), unique_fd_ids.size()),
       fbb.CreateVector(MakeNonNull(mmap_sizes.data()), mmap_sizes.size()),
-      fbb.CreateVector(MakeNonNull(handles.data()), handles.size()));
+      fbb.CreateVector(MakeNonNull(handles.data()), handles.size()),
+      request_id,
+      fbb.CreateVector(MakeNonNull(partial.data()), partial.size()));
   return PlasmaSend(client, MessageType::PlasmaGetReply, &fbb, message);
 }
 
+uint64_t ReadGetReplyRequestId(uint8_t *data, size_t size) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaGetReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  return message->request_id();
+}
+
 Status ReadGetReply(uint8_t *data,
                     size_t size,
                     ObjectID object_ids[],
@@ -652,6 +833,9 @@ Status ReadGetReply(uint8_t *data,
     plasma_objects[i].metadata_offset = object->metadata_offset();
     plasma_objects[i].metadata_size = object->metadata_size();
     plasma_objects[i].device_num = object->device_num();
+    plasma_objects[i].partial =
+        message->partial() != nullptr && i < message->partial()->size() &&
+        message->partial()->Get(i);
   }
   RAY_CHECK(message->store_fds()->size() == message->mmap_sizes()->size());
   for (uoffset_t i = 0; i < message->store_fds()->size(); i++) {
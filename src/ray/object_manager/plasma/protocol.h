@@ -63,6 +63,11 @@ flatbuffers::Offset<flatbuffers::Vector<int64_t>> ToFlatbuffer(
 
 /* Plasma receive message. */
 
+/// Receive the next message, whatever its type.
+Status PlasmaReceiveAny(const std::shared_ptr<StoreConn> &store_conn,
+                        MessageType *message_type,
+                        std::vector<uint8_t> *buffer);
+
 Status PlasmaReceive(const std::shared_ptr<StoreConn> &store_conn,
                      MessageType message_type,
                      std::vector<uint8_t> *buffer);
@@ -134,26 +139,49 @@ Status SendSealReply(const std::shared_ptr<Client> &client,
 
 Status ReadSealReply(uint8_t *data, size_t size, ObjectID *object_id);
 
+Status SendSealBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                            const std::vector<ObjectID> &object_ids);
+
+Status ReadSealBatchRequest(uint8_t *data,
+                            size_t size,
+                            std::vector<ObjectID> *object_ids);
+
+Status SendSealBatchReply(const std::shared_ptr<Client> &client,
+                          const std::vector<ObjectID> &object_ids,
+                          PlasmaError error);
+
+Status ReadSealBatchReply(uint8_t *data,
+                          size_t size,
+                          std::vector<ObjectID> *object_ids);
+
 /* Plasma Get message functions. */
 
 Status SendGetRequest(const std::shared_ptr<StoreConn> &store_conn,
                       const ObjectID *object_ids,
                       int64_t num_objects,
                       int64_t timeout_ms,
-                      bool is_from_worker);
+                      bool is_from_worker,
+                      uint64_t request_id = 0,
+                      bool allow_partial = false);
 
 Status ReadGetRequest(uint8_t *data,
                       size_t size,
                       std::vector<ObjectID> &object_ids,
                       int64_t *timeout_ms,
-                      bool *is_from_worker);
+                      bool *is_from_worker,
+                      uint64_t *request_id,
+                      bool *allow_partial);
 
 Status SendGetReply(const std::shared_ptr<Client> &client,
                     ObjectID object_ids[],
                     absl::flat_hash_map<ObjectID, PlasmaObject> &plasma_objects,
                     int64_t num_objects,
                     const std::vector<MEMFD_TYPE> &store_fds,
-                    const std::vector<int64_t> &mmap_sizes);
+                    const std::vector<int64_t> &mmap_sizes,
+                    uint64_t request_id = 0);
+
+/// Read the request_id of a get reply, to tell which request it replies to.
+uint64_t ReadGetReplyRequestId(uint8_t *data, size_t size);
 
 Status ReadGetReply(uint8_t *data,
                     size_t size,
@@ -163,6 +191,36 @@ Status ReadGetReply(uint8_t *data,
                     std::vector<MEMFD_TYPE> &store_fds,
                     std::vector<int64_t> &mmap_sizes);
 
+/* Plasma streaming read message functions. */
+
+Status SendSealPrefixRequest(const std::shared_ptr<StoreConn> &store_conn,
+                             const ObjectID &object_id,
+                             int64_t num_bytes);
+
+Status ReadSealPrefixRequest(uint8_t *data,
+                             size_t size,
+                             ObjectID *object_id,
+                             int64_t *num_bytes);
+
+Status SendWaitPrefixRequest(const std::shared_ptr<StoreConn> &store_conn,
+                             const ObjectID &object_id,
+                             int64_t num_bytes);
+
+Status ReadWaitPrefixRequest(uint8_t *data,
+                             size_t size,
+                             ObjectID *object_id,
+                             int64_t *num_bytes);
+
+Status SendWaitPrefixReply(const std::shared_ptr<Client> &client,
+                           const ObjectID &object_id,
+                           int64_t num_bytes,
+                           PlasmaError error);
+
+Status ReadWaitPrefixReply(uint8_t *data,
+                           size_t size,
+                           ObjectID *object_id,
+                           int64_t *num_bytes);
+
 /* Plasma Release message functions. */
 
 Status SendReleaseRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -176,6 +234,13 @@ Status SendReleaseReply(const std::shared_ptr<Client> &client,
 
 Status ReadReleaseReply(uint8_t *data, size_t size, ObjectID *object_id);
 
+Status SendReleaseBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                               const std::vector<ObjectID> &object_ids);
+
+Status ReadReleaseBatchRequest(uint8_t *data,
+                               size_t size,
+                               std::vector<ObjectID> *object_ids);
+
 /* Plasma Delete objects message functions. */
 
 Status SendDeleteRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -210,13 +275,19 @@ Status ReadContainsReply(uint8_t *data,
 
 /* Plasma Connect message functions. */
 
-Status SendConnectRequest(const std::shared_ptr<StoreConn> &store_conn);
+Status SendConnectRequest(const std::shared_ptr<StoreConn> &store_conn,
+                          int64_t release_ring_capacity);
 
-Status ReadConnectRequest(uint8_t *data, size_t size);
+Status ReadConnectRequest(uint8_t *data, size_t size, int64_t *release_ring_capacity);
 
-Status SendConnectReply(const std::shared_ptr<Client> &client, int64_t memory_capacity);
+Status SendConnectReply(const std::shared_ptr<Client> &client,
+                        int64_t memory_capacity,
+                        int64_t release_ring_capacity);
 
-Status ReadConnectReply(uint8_t *data, size_t size, int64_t *memory_capacity);
+Status ReadConnectReply(uint8_t *data,
+                        size_t size,
+                        int64_t *memory_capacity,
+                        int64_t *release_ring_capacity);
 
 /* Plasma Evict message functions (no reply so far). */
 
@@ -17,6 +17,7 @@
 
 #include "ray/object_manager/plasma/stats_collector.h"
 
+#include "ray/object_manager/plasma/eviction_policy.h"
 #include "ray/stats/metric_defs.h"
 
 namespace plasma {
@@ -27,6 +28,13 @@ void ObjectStatsCollector::OnObjectCreated(const LocalObject &obj) {
 
   num_bytes_created_total_ += kObjectSize;
 
+  if (obj.GetAllocation().fallback_allocated) {
+    num_objects_fallback_allocated_++;
+    num_bytes_fallback_allocated_ += kObjectSize;
+  } else {
+    num_bytes_by_job_[obj.GetObjectInfo().object_id.TaskId().JobId()] += kObjectSize;
+  }
+
   if (kSource == plasma::flatbuf::ObjectSource::CreatedByWorker) {
     num_objects_created_by_worker_++;
     num_bytes_created_by_worker_ += kObjectSize;
@@ -71,6 +79,18 @@ void ObjectStatsCollector::OnObjectDeleting(const LocalObject &obj) {
   const auto kObjectSize = obj.GetObjectInfo().GetObjectSize();
   const auto kSource = obj.GetSource();
 
+  if (obj.GetAllocation().fallback_allocated) {
+    num_objects_fallback_allocated_--;
+    num_bytes_fallback_allocated_ -= kObjectSize;
+  } else {
+    auto it = num_bytes_by_job_.find(obj.GetObjectInfo().object_id.TaskId().JobId());
+    RAY_CHECK(it != num_bytes_by_job_.end());
+    it->second -= kObjectSize;
+    if (it->second == 0) {
+      num_bytes_by_job_.erase(it);
+    }
+  }
+
   if (kSource == plasma::flatbuf::ObjectSource::CreatedByWorker) {
     num_objects_created_by_worker_--;
     num_bytes_created_by_worker_ -= kObjectSize;
@@ -169,7 +189,34 @@ void ObjectStatsCollector::OnObjectRefDecreased(const LocalObject &obj) {
 }
 
 void ObjectStatsCollector::RecordMetrics() const {
-  // TODO(sang): Add metrics.
+  const int64_t num_bytes = num_bytes_created_by_worker_ + num_bytes_restored_ +
+                            num_bytes_received_ + num_bytes_errored_;
+  ray::stats::STATS_object_store_tier_bytes.Record(
+      num_bytes - num_bytes_fallback_allocated_, "SharedMemory");
+  ray::stats::STATS_object_store_tier_bytes.Record(num_bytes_fallback_allocated_,
+                                                   "Filesystem");
+  for (const auto &job_id : reported_jobs_) {
+    if (!num_bytes_by_job_.contains(job_id)) {
+      ray::stats::STATS_object_store_job_bytes.Record(0, job_id.Hex());
+    }
+  }
+  reported_jobs_.clear();
+  for (const auto &[job_id, num_bytes] : num_bytes_by_job_) {
+    ray::stats::STATS_object_store_job_bytes.Record(num_bytes, job_id.Hex());
+    reported_jobs_.insert(job_id);
+  }
+}
+
+void ObjectStatsCollector::RecordEvictionPolicyMetrics(
+    const IEvictionPolicy &eviction_policy) const {
+  const auto policy = eviction_policy.Name();
+  const auto &stats = eviction_policy.GetStats();
+  ray::stats::STATS_object_store_eviction_policy_total.Record(
+      stats.num_hits, {{"Policy", policy}, {"Type", "Hit"}});
+  ray::stats::STATS_object_store_eviction_policy_total.Record(
+      stats.num_misses, {{"Policy", policy}, {"Type", "Miss"}});
+  ray::stats::STATS_object_store_eviction_policy_total.Record(
+      stats.num_evictions, {{"Policy", policy}, {"Type", "Eviction"}});
 }
 
 void ObjectStatsCollector::GetDebugDump(std::stringstream &buffer) const {
@@ -191,6 +238,8 @@ void ObjectStatsCollector::GetDebugDump(std::stringstream &buffer) const {
   buffer << "- bytes received: " << num_bytes_received_ << "\n";
   buffer << "- objects errored: " << num_objects_errored_ << "\n";
   buffer << "- bytes errored: " << num_bytes_errored_ << "\n";
+  buffer << "- objects fallback allocated: " << num_objects_fallback_allocated_ << "\n";
+  buffer << "- bytes fallback allocated: " << num_bytes_fallback_allocated_ << "\n";
 }
 
 int64_t ObjectStatsCollector::GetNumBytesInUse() const { return num_bytes_in_use_; }
@@ -205,4 +254,9 @@ int64_t ObjectStatsCollector::GetNumObjectsUnsealed() const {
   return num_objects_unsealed_;
 }
 
+int64_t ObjectStatsCollector::GetNumBytesOfJob(const ray::JobID &job_id) const {
+  auto it = num_bytes_by_job_.find(job_id);
+  return it == num_bytes_by_job_.end() ? 0 : it->second;
+}
+
 }  // namespace plasma
\ No newline at end of file
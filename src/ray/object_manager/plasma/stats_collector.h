@@ -17,10 +17,14 @@
 
 #pragma once
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/object_manager/plasma/common.h"
 
 namespace plasma {
 
+class IEvictionPolicy;
+
 // ObjectStatsCollector subscribes to plasma store state changes
 // and calculate the store statistics.
 //
@@ -46,6 +50,9 @@ class ObjectStatsCollector {
   /// Record the internal metrics.
   void RecordMetrics() const;
 
+  /// Record the hits, misses and evictions of the eviction policy.
+  void RecordEvictionPolicyMetrics(const IEvictionPolicy &eviction_policy) const;
+
   /// Debug dump the stats.
   void GetDebugDump(std::stringstream &buffer) const;
 
@@ -57,6 +64,9 @@ class ObjectStatsCollector {
 
   int64_t GetNumObjectsUnsealed() const;
 
+  /// The bytes of the objects of a job in shared memory.
+  int64_t GetNumBytesOfJob(const ray::JobID &job_id) const;
+
  private:
   friend struct ObjectStatsCollectorTest;
 
@@ -78,6 +88,13 @@ class ObjectStatsCollector {
   int64_t num_objects_errored_ = 0;
   int64_t num_bytes_errored_ = 0;
   int64_t num_bytes_created_total_ = 0;
+  int64_t num_objects_fallback_allocated_ = 0;
+  int64_t num_bytes_fallback_allocated_ = 0;
+  /// The bytes of the objects in shared memory by job, for the jobs that have any.
+  absl::flat_hash_map<ray::JobID, int64_t> num_bytes_by_job_;
+  /// The jobs whose bytes were last reported, so that the jobs whose objects were all
+  /// deleted since are reported once more with 0 bytes.
+  mutable absl::flat_hash_set<ray::JobID> reported_jobs_;
 };
 
 }  // namespace plasma
\ No newline at end of file
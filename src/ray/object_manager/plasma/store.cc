@@ -98,7 +98,8 @@ PlasmaStore::PlasmaStore(instrumented_io_context &main_service,
           [this]() ABSL_NO_THREAD_SAFETY_ANALYSIS {
             mutex_.AssertHeld();
             return GetDebugDump();
-          }),
+          },
+          RayConfig::instance().plasma_create_request_fair_queueing()),
       total_consumed_bytes_(0),
       get_request_queue_(
           io_context_,
@@ -107,9 +108,15 @@ PlasmaStore::PlasmaStore(instrumented_io_context &main_service,
           [this](const ObjectID &object_id, const auto &request)
               ABSL_NO_THREAD_SAFETY_ANALYSIS {
                 mutex_.AssertHeld();
+                if (request->objects[object_id].partial &&
+                    !request->client->GetObjectIDs().contains(object_id)) {
+                  partial_objects_[object_id].readers.insert(request->client);
+                }
                 this->AddToClientObjectIds(object_id, request->client);
               },
-          [this](const auto &request) { this->ReturnFromGet(request); }) {
+          [this](const auto &request) { this->ReturnFromGet(request); },
+          &mutex_),
+      streaming_reads_enabled_(RayConfig::instance().plasma_streaming_reads_enabled()) {
   const auto event_stats_print_interval_ms =
       RayConfig::instance().event_stats_print_interval_ms();
   if (event_stats_print_interval_ms > 0 && RayConfig::instance().event_stats()) {
@@ -196,6 +203,10 @@ PlasmaError PlasmaStore::CreateObject(const ray::ObjectInfo &object_info,
   entry->ToPlasmaObject(result, /* check sealed */ false);
   // Record that this client is using this object.
   AddToClientObjectIds(object_info.object_id, client);
+  if (streaming_reads_enabled_ &&
+      source == fb::ObjectSource::ReceivedFromRemoteRaylet) {
+    get_request_queue_.MarkObjectCreated(object_info.object_id);
+  }
   return PlasmaError::OK;
 }
 
@@ -228,7 +239,8 @@ void PlasmaStore::ReturnFromGet(const std::shared_ptr<GetRequest> &get_request)
                           get_request->objects,
                           get_request->object_ids.size(),
                           store_fds,
-                          mmap_sizes);
+                          mmap_sizes,
+                          get_request->request_id);
   // If we successfully sent the get reply message to the client, then also send
   // the file descriptors.
   if (s.ok()) {
@@ -248,8 +260,15 @@ void PlasmaStore::ReturnFromGet(const std::shared_ptr<GetRequest> &get_request)
 void PlasmaStore::ProcessGetRequest(const std::shared_ptr<Client> &client,
                                     const std::vector<ObjectID> &object_ids,
                                     int64_t timeout_ms,
-                                    bool is_from_worker) {
-  get_request_queue_.AddRequest(client, object_ids, timeout_ms, is_from_worker);
+                                    bool is_from_worker,
+                                    uint64_t request_id,
+                                    bool allow_partial) {
+  get_request_queue_.AddRequest(client,
+                                object_ids,
+                                timeout_ms,
+                                is_from_worker,
+                                request_id,
+                                allow_partial && streaming_reads_enabled_);
 }
 
 int PlasmaStore::RemoveFromClientObjectIds(const ObjectID &object_id,
@@ -273,21 +292,55 @@ void PlasmaStore::ReleaseObject(const ObjectID &object_id,
                                 const std::shared_ptr<Client> &client) {
   auto entry = object_lifecycle_mgr_.GetObject(object_id);
   RAY_CHECK(entry != nullptr);
+  auto partial_it = partial_objects_.find(object_id);
+  if (partial_it != partial_objects_.end() &&
+      partial_it->second.readers.erase(client) > 0 && partial_it->second.aborted &&
+      partial_it->second.readers.empty()) {
+    // The last reader of an aborted object released it, so it can be deleted now.
+    client->MarkObjectAsUnused(object_id);
+    partial_objects_.erase(partial_it);
+    RAY_CHECK(object_lifecycle_mgr_.AbortObject(object_id) == PlasmaError::OK);
+    return;
+  }
   // Remove the client from the object's array of clients.
   RAY_CHECK(RemoveFromClientObjectIds(object_id, client) == 1);
 }
 
+void PlasmaStore::ReleaseObjectsFromRing(const std::shared_ptr<Client> &client) {
+  ObjectID object_id;
+  while (client->PopReleasedObject(&object_id)) {
+    ReleaseObject(object_id, client);
+  }
+}
+
+void PlasmaStore::WaitForReleases(const std::shared_ptr<Client> &client) {
+  std::weak_ptr<Client> weak_client = client;
+  client->WaitForReleases([this, weak_client]() {
+    auto client = weak_client.lock();
+    if (client == nullptr) {
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    ReleaseObjectsFromRing(client);
+    WaitForReleases(client);
+  });
+}
+
 void PlasmaStore::SealObjects(const std::vector<ObjectID> &object_ids) {
   for (size_t i = 0; i < object_ids.size(); ++i) {
     RAY_LOG(DEBUG) << "sealing object " << object_ids[i];
     auto entry = object_lifecycle_mgr_.SealObject(object_ids[i]);
     RAY_CHECK(entry) << object_ids[i] << " is missing or not sealed.";
     add_object_callback_(entry->GetObjectInfo());
+    if (partial_objects_.contains(object_ids[i])) {
+      // The readers now use the object like any sealed object.
+      FinishObjectPrefixWaits(
+          object_ids[i], entry->GetObjectInfo().GetObjectSize(), PlasmaError::OK);
+      partial_objects_.erase(object_ids[i]);
+    }
   }
 
-  for (size_t i = 0; i < object_ids.size(); ++i) {
-    get_request_queue_.MarkObjectSealed(object_ids[i]);
-  }
+  get_request_queue_.MarkObjectsSealed(object_ids);
 }
 
 int PlasmaStore::AbortObject(const ObjectID &object_id,
@@ -299,12 +352,78 @@ int PlasmaStore::AbortObject(const ObjectID &object_id,
     // perform the abort.
     return 0;
   }
+  auto partial_it = partial_objects_.find(object_id);
+  if (partial_it != partial_objects_.end()) {
+    FinishObjectPrefixWaits(object_id, 0, PlasmaError::ObjectNonexistent);
+    if (!partial_it->second.readers.empty()) {
+      // The readers may still read the object's memory, so the object is deleted once
+      // the last of them releases it.
+      partial_it->second.aborted = true;
+      client->MarkObjectAsUnused(object_id);
+      RAY_CHECK(object_lifecycle_mgr_.RemoveReference(object_id));
+      return 1;
+    }
+    partial_objects_.erase(partial_it);
+  }
   // The client requesting the abort is the creator. Free the object.
   RAY_CHECK(object_lifecycle_mgr_.AbortObject(object_id) == PlasmaError::OK);
-  client->MarkObjectAsUnused(*it);
+  client->MarkObjectAsUnused(object_id);
   return 1;
 }
 
+void PlasmaStore::SealObjectPrefix(const ObjectID &object_id, int64_t num_bytes) {
+  auto entry = object_lifecycle_mgr_.GetObject(object_id);
+  if (entry == nullptr || entry->Sealed()) {
+    return;
+  }
+  auto &partial_object = partial_objects_[object_id];
+  partial_object.num_bytes_sealed = std::max(partial_object.num_bytes_sealed, num_bytes);
+  auto &waiters = partial_object.waiters;
+  for (auto it = waiters.begin(); it != waiters.end();) {
+    if (it->second > partial_object.num_bytes_sealed) {
+      it++;
+      continue;
+    }
+    static_cast<void>(SendWaitPrefixReply(
+        it->first, object_id, partial_object.num_bytes_sealed, PlasmaError::OK));
+    it = waiters.erase(it);
+  }
+}
+
+void PlasmaStore::WaitForObjectPrefix(const std::shared_ptr<Client> &client,
+                                      const ObjectID &object_id,
+                                      int64_t num_bytes) {
+  auto entry = object_lifecycle_mgr_.GetObject(object_id);
+  auto partial_it = partial_objects_.find(object_id);
+  if (entry != nullptr && entry->Sealed()) {
+    static_cast<void>(SendWaitPrefixReply(
+        client, object_id, entry->GetObjectInfo().GetObjectSize(), PlasmaError::OK));
+  } else if (entry == nullptr || (partial_it != partial_objects_.end() &&
+                                  partial_it->second.aborted)) {
+    static_cast<void>(
+        SendWaitPrefixReply(client, object_id, 0, PlasmaError::ObjectNonexistent));
+  } else if (partial_it != partial_objects_.end() &&
+             partial_it->second.num_bytes_sealed >= num_bytes) {
+    static_cast<void>(SendWaitPrefixReply(
+        client, object_id, partial_it->second.num_bytes_sealed, PlasmaError::OK));
+  } else {
+    partial_objects_[object_id].waiters.emplace_back(client, num_bytes);
+  }
+}
+
+void PlasmaStore::FinishObjectPrefixWaits(const ObjectID &object_id,
+                                          int64_t num_bytes,
+                                          PlasmaError error) {
+  auto it = partial_objects_.find(object_id);
+  if (it == partial_objects_.end()) {
+    return;
+  }
+  for (const auto &waiter : it->second.waiters) {
+    static_cast<void>(SendWaitPrefixReply(waiter.first, object_id, num_bytes, error));
+  }
+  it->second.waiters.clear();
+}
+
 void PlasmaStore::ConnectClient(const boost::system::error_code &error) {
   if (!error) {
     // Accept a new local client and dispatch it to the node manager.
@@ -320,8 +439,14 @@ void PlasmaStore::ConnectClient(const boost::system::error_code &error) {
 void PlasmaStore::DisconnectClient(const std::shared_ptr<Client> &client) {
   client->Close();
   RAY_LOG(DEBUG) << "Disconnecting client on fd " << client;
+  // The objects left in the release ring are still in the client's object IDs, so
+  // they are released below.
+  client->CloseReleaseRing();
   // Release all the objects that the client was using.
   absl::flat_hash_map<ObjectID, const LocalObject *> sealed_objects;
+  std::vector<ObjectID> partial_reads;
+  std::vector<ObjectID> unsealed_objects;
+  const std::shared_ptr<ClientInterface> client_interface = client;
   auto &object_ids = client->GetObjectIDs();
   for (const auto &object_id : object_ids) {
     auto entry = object_lifecycle_mgr_.GetObject(object_id);
@@ -329,15 +454,36 @@ void PlasmaStore::DisconnectClient(const std::shared_ptr<Client> &client) {
       continue;
     }
 
+    auto partial_it = partial_objects_.find(object_id);
     if (entry->Sealed()) {
       // Add sealed objects to a temporary list of object IDs. Do not perform
       // the remove here, since it potentially modifies the object_ids table.
       sealed_objects[object_id] = entry;
+    } else if (partial_it != partial_objects_.end() &&
+               partial_it->second.readers.contains(client_interface)) {
+      // The client read the object before it was sealed, so it's released rather
+      // than aborted.
+      partial_reads.push_back(object_id);
     } else {
       // Abort unsealed object.
-      object_lifecycle_mgr_.AbortObject(object_id);
+      unsealed_objects.push_back(object_id);
     }
   }
+  for (const auto &object_id : unsealed_objects) {
+    AbortObject(object_id, client);
+  }
+  for (const auto &object_id : partial_reads) {
+    ReleaseObject(object_id, client);
+  }
+  for (auto &[object_id, partial_object] : partial_objects_) {
+    auto &waiters = partial_object.waiters;
+    waiters.erase(std::remove_if(waiters.begin(),
+                                 waiters.end(),
+                                 [&client](const auto &waiter) {
+                                   return waiter.first == client;
+                                 }),
+                  waiters.end());
+  }
 
   /// Remove all of the client's GetRequests.
   get_request_queue_.RemoveGetRequestsForClient(client);
@@ -352,11 +498,18 @@ void PlasmaStore::DisconnectClient(const std::shared_ptr<Client> &client) {
 Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
                                    fb::MessageType type,
                                    const std::vector<uint8_t> &message) {
-  absl::MutexLock lock(&mutex_);
+  // Messages from different clients may be processed on different threads. Reading
+  // the requests is done in parallel, while the store state is guarded by `mutex_`.
+  // Requests that are answered right away release the lock before sending the reply,
+  // since the client waits for it and no other thread writes to its socket.
+  absl::ReleasableMutexLock lock(&mutex_);
   // TODO(suquark): We should convert these interfaces to const later.
   uint8_t *input = (uint8_t *)message.data();
   size_t input_size = message.size();
   ObjectID object_id;
+  // Objects released before this message are handled first, as if the releases had
+  // been sent on the socket.
+  ReleaseObjectsFromRing(client);
 
   // Process the different types of requests.
   switch (type) {
@@ -407,20 +560,50 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
     RAY_CHECK(AbortObject(object_id, client) == 1) << "To abort an object, the only "
                                                       "client currently using it "
                                                       "must be the creator.";
+    lock.Release();
     RAY_RETURN_NOT_OK(SendAbortReply(client, object_id));
   } break;
   case fb::MessageType::PlasmaGetRequest: {
     std::vector<ObjectID> object_ids_to_get;
     int64_t timeout_ms;
     bool is_from_worker;
-    RAY_RETURN_NOT_OK(ReadGetRequest(
-        input, input_size, object_ids_to_get, &timeout_ms, &is_from_worker));
-    ProcessGetRequest(client, object_ids_to_get, timeout_ms, is_from_worker);
+    uint64_t request_id;
+    bool allow_partial;
+    RAY_RETURN_NOT_OK(ReadGetRequest(input,
+                                     input_size,
+                                     object_ids_to_get,
+                                     &timeout_ms,
+                                     &is_from_worker,
+                                     &request_id,
+                                     &allow_partial));
+    ProcessGetRequest(client,
+                      object_ids_to_get,
+                      timeout_ms,
+                      is_from_worker,
+                      request_id,
+                      allow_partial);
+  } break;
+  case fb::MessageType::PlasmaSealPrefixRequest: {
+    int64_t num_bytes;
+    RAY_RETURN_NOT_OK(ReadSealPrefixRequest(input, input_size, &object_id, &num_bytes));
+    SealObjectPrefix(object_id, num_bytes);
+  } break;
+  case fb::MessageType::PlasmaWaitPrefixRequest: {
+    int64_t num_bytes;
+    RAY_RETURN_NOT_OK(ReadWaitPrefixRequest(input, input_size, &object_id, &num_bytes));
+    WaitForObjectPrefix(client, object_id, num_bytes);
   } break;
   case fb::MessageType::PlasmaReleaseRequest: {
     RAY_RETURN_NOT_OK(ReadReleaseRequest(input, input_size, &object_id));
     ReleaseObject(object_id, client);
   } break;
+  case fb::MessageType::PlasmaReleaseBatchRequest: {
+    std::vector<ObjectID> object_ids;
+    RAY_RETURN_NOT_OK(ReadReleaseBatchRequest(input, input_size, &object_ids));
+    for (const auto &object_id : object_ids) {
+      ReleaseObject(object_id, client);
+    }
+  } break;
   case fb::MessageType::PlasmaDeleteRequest: {
     std::vector<ObjectID> object_ids;
     std::vector<PlasmaError> error_codes;
@@ -429,30 +612,52 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
     for (auto &object_id : object_ids) {
       error_codes.push_back(object_lifecycle_mgr_.DeleteObject(object_id));
     }
+    lock.Release();
     RAY_RETURN_NOT_OK(SendDeleteReply(client, object_ids, error_codes));
   } break;
   case fb::MessageType::PlasmaContainsRequest: {
     RAY_RETURN_NOT_OK(ReadContainsRequest(input, input_size, &object_id));
-    if (object_lifecycle_mgr_.IsObjectSealed(object_id)) {
-      RAY_RETURN_NOT_OK(SendContainsReply(client, object_id, 1));
-    } else {
-      RAY_RETURN_NOT_OK(SendContainsReply(client, object_id, 0));
-    }
+    const bool has_object = object_lifecycle_mgr_.IsObjectSealed(object_id);
+    lock.Release();
+    RAY_RETURN_NOT_OK(SendContainsReply(client, object_id, has_object ? 1 : 0));
   } break;
   case fb::MessageType::PlasmaSealRequest: {
     RAY_RETURN_NOT_OK(ReadSealRequest(input, input_size, &object_id));
     SealObjects({object_id});
+    lock.Release();
     RAY_RETURN_NOT_OK(SendSealReply(client, object_id, PlasmaError::OK));
   } break;
+  case fb::MessageType::PlasmaSealBatchRequest: {
+    std::vector<ObjectID> object_ids;
+    RAY_RETURN_NOT_OK(ReadSealBatchRequest(input, input_size, &object_ids));
+    SealObjects(object_ids);
+    lock.Release();
+    RAY_RETURN_NOT_OK(SendSealBatchReply(client, object_ids, PlasmaError::OK));
+  } break;
   case fb::MessageType::PlasmaEvictRequest: {
     // This code path should only be used for testing.
     int64_t num_bytes;
     RAY_RETURN_NOT_OK(ReadEvictRequest(input, input_size, &num_bytes));
     int64_t num_bytes_evicted = object_lifecycle_mgr_.RequireSpace(num_bytes);
+    lock.Release();
     RAY_RETURN_NOT_OK(SendEvictReply(client, num_bytes_evicted));
   } break;
   case fb::MessageType::PlasmaConnectRequest: {
-    RAY_RETURN_NOT_OK(SendConnectReply(client, allocator_.GetFootprintLimit()));
+    int64_t release_ring_capacity = 0;
+    RAY_RETURN_NOT_OK(ReadConnectRequest(input, input_size, &release_ring_capacity));
+    if (release_ring_capacity > 0) {
+      if (client->SetUpReleaseRing(release_ring_capacity)) {
+        WaitForReleases(client);
+      } else {
+        release_ring_capacity = 0;
+      }
+    }
+    const int64_t footprint_limit = allocator_.GetFootprintLimit();
+    lock.Release();
+    RAY_RETURN_NOT_OK(SendConnectReply(client, footprint_limit, release_ring_capacity));
+    if (release_ring_capacity > 0) {
+      RAY_RETURN_NOT_OK(client->SendReleaseRingFds());
+    }
   } break;
   case fb::MessageType::PlasmaDisconnectClient:
     RAY_LOG(DEBUG) << "Disconnecting client on fd " << client;
@@ -460,8 +665,9 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
     return Status::Disconnected("The Plasma Store client is disconnected.");
     break;
   case fb::MessageType::PlasmaGetDebugStringRequest: {
-    RAY_RETURN_NOT_OK(SendGetDebugStringReply(
-        client, object_lifecycle_mgr_.EvictionPolicyDebugString()));
+    const std::string debug_string = object_lifecycle_mgr_.EvictionPolicyDebugString();
+    lock.Release();
+    RAY_RETURN_NOT_OK(SendGetDebugStringReply(client, debug_string));
   } break;
   default:
     // This code should be unreachable.
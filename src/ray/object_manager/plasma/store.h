@@ -25,8 +25,11 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/common/ray_config.h"
 #include "ray/common/status.h"
 #include "ray/object_manager/common.h"
@@ -158,10 +161,15 @@ class PlasmaStore {
   /// \param client The client making this request.
   /// \param object_ids Object IDs of the objects to be gotten.
   /// \param timeout_ms The timeout for the get request in milliseconds.
+  /// \param request_id The ID to send back in the reply.
+  /// \param allow_partial Whether to return the objects that are being received from
+  /// another node before they are sealed.
   void ProcessGetRequest(const std::shared_ptr<Client> &client,
                          const std::vector<ObjectID> &object_ids,
                          int64_t timeout_ms,
-                         bool is_from_worker) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+                         bool is_from_worker,
+                         uint64_t request_id,
+                         bool allow_partial) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   /// Process queued requests to create an object.
   void ProcessCreateRequests() EXCLUSIVE_LOCKS_REQUIRED(mutex_);
@@ -173,6 +181,34 @@ class PlasmaStore {
   void SealObjects(const std::vector<ObjectID> &object_ids)
       EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  /// Record that the first bytes of an object being received are written, and reply
+  /// to the clients waiting for them.
+  ///
+  /// \param object_id The ID of the object being received.
+  /// \param num_bytes The number of bytes at the start of the object that are written.
+  void SealObjectPrefix(const ObjectID &object_id, int64_t num_bytes)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Reply to a client once the first bytes of an object are written, the object is
+  /// sealed, or the object is aborted.
+  ///
+  /// \param client The client waiting for the bytes.
+  /// \param object_id The ID of the object.
+  /// \param num_bytes The number of bytes at the start of the object to wait for.
+  void WaitForObjectPrefix(const std::shared_ptr<Client> &client,
+                           const ObjectID &object_id,
+                           int64_t num_bytes) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Reply to all the clients waiting for bytes of an object that is sealed or
+  /// aborted.
+  ///
+  /// \param object_id The ID of the object.
+  /// \param num_bytes The size of the object if it was sealed, 0 if it was aborted.
+  /// \param error The error to reply with.
+  void FinishObjectPrefixWaits(const ObjectID &object_id,
+                               int64_t num_bytes,
+                               PlasmaError error) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   /// Record the fact that a particular client is no longer using an object.
   ///
   /// \param object_id The object ID of the object that is being released.
@@ -180,6 +216,19 @@ class PlasmaStore {
   void ReleaseObject(const ObjectID &object_id, const std::shared_ptr<Client> &client)
       EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  /// Release the objects that a client pushed to its release ring.
+  ///
+  /// \param client The client that released the objects.
+  void ReleaseObjectsFromRing(const std::shared_ptr<Client> &client)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Release the objects in a client's release ring whenever the client wakes up the
+  /// store, until the client disconnects.
+  ///
+  /// \param client The client with the release ring.
+  void WaitForReleases(const std::shared_ptr<Client> &client)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   /// Connect a new client to the PlasmaStore.
   ///
   /// \param error The error code from the acceptor.
@@ -243,8 +292,10 @@ class PlasmaStore {
   /// figure out the correct view of the object store. recursive_mutex is used to avoid
   /// deadlock while we keep the simplest possible change. NOTE(sang): Avoid adding more
   /// interface that node manager or object manager can access the plasma store with this
-  /// mutex if it is not absolutely necessary.
+  /// mutex if it is not absolutely necessary. It also serializes requests from clients
+  /// that are handled on different store io threads.
   mutable absl::Mutex mutex_;
+  TrackedMutexName mutex_name_{&mutex_, "PlasmaStore::mutex_"};
 
   /// The allocator that allocates mmaped memory.
   IAllocator &allocator_ GUARDED_BY(mutex_);
@@ -287,6 +338,28 @@ class PlasmaStore {
   bool dumped_on_oom_ GUARDED_BY(mutex_) = false;
 
   GetRequestQueue get_request_queue_ GUARDED_BY(mutex_);
+
+  /// An object that is being received from another node, and that clients may read
+  /// before it is sealed.
+  struct PartialObject {
+    /// The number of bytes at the start of the object that are written.
+    int64_t num_bytes_sealed = 0;
+    /// The clients that got the object before it was sealed, and haven't released it.
+    absl::flat_hash_set<std::shared_ptr<ClientInterface>> readers;
+    /// The clients waiting for a number of bytes at the start of the object.
+    std::vector<std::pair<std::shared_ptr<Client>, int64_t>> waiters;
+    /// Whether the object was aborted while it had readers. It is deleted once the
+    /// last of them releases it, since they may still read its memory.
+    bool aborted = false;
+  };
+
+  /// The objects being received whose written bytes were reported, or that clients
+  /// read or wait for before they are sealed. Erased when the object is sealed or
+  /// deleted.
+  absl::flat_hash_map<ObjectID, PartialObject> partial_objects_ GUARDED_BY(mutex_);
+
+  /// Whether get requests may return objects before they are sealed.
+  const bool streaming_reads_enabled_;
 };
 
 }  // namespace plasma
@@ -7,6 +7,9 @@
 #include <unistd.h>
 #endif
 
+#include <thread>
+#include <vector>
+
 #include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/plasma_allocator.h"
 
@@ -89,7 +92,11 @@ void PlasmaStoreRunner::Start(ray::SpillObjectsCallback spill_objects_callback,
   {
     absl::MutexLock lock(&store_runner_mutex_);
     allocator_ = std::make_unique<PlasmaAllocator>(
-        plasma_directory_, fallback_directory_, hugepages_enabled_, system_memory_);
+        plasma_directory_,
+        fallback_directory_,
+        hugepages_enabled_,
+        system_memory_,
+        RayConfig::instance().plasma_small_object_max_size());
     store_.reset(new PlasmaStore(main_service_,
                                  *allocator_,
                                  socket_name_,
@@ -101,7 +108,21 @@ void PlasmaStoreRunner::Start(ray::SpillObjectsCallback spill_objects_callback,
                                  delete_object_callback));
     store_->Start();
   }
+  // Clients are handled by every thread that runs the io context. The calling thread
+  // is the first one.
+  const int num_threads = RayConfig::instance().plasma_store_io_threads();
+  RAY_CHECK(num_threads >= 1) << "plasma_store_io_threads must be at least 1";
+  std::vector<std::thread> io_threads;
+  for (int i = 1; i < num_threads; i++) {
+    io_threads.emplace_back([this, i]() {
+      SetThreadName("store.io." + std::to_string(i));
+      main_service_.run();
+    });
+  }
   main_service_.run();
+  for (auto &thread : io_threads) {
+    thread.join();
+  }
   Shutdown();
 }
 
@@ -132,6 +153,11 @@ int64_t PlasmaStoreRunner::GetFallbackAllocated() const {
   return allocator_ ? allocator_->FallbackAllocated() : 0;
 }
 
+int64_t PlasmaStoreRunner::GetSmallObjectUnusedBytes() const {
+  absl::MutexLock lock(&store_runner_mutex_);
+  return allocator_ ? allocator_->SmallObjectUnusedBytes() : 0;
+}
+
 std::unique_ptr<PlasmaStoreRunner> plasma_store_runner;
 
 }  // namespace plasma
@@ -27,6 +27,7 @@ class PlasmaStoreRunner {
 
   int64_t GetConsumedBytes();
   int64_t GetFallbackAllocated() const;
+  int64_t GetSmallObjectUnusedBytes() const;
 
   void GetAvailableMemoryAsync(std::function<void(size_t)> callback) const {
     main_service_.post([this, callback]() { store_->GetAvailableMemory(callback); },
@@ -47,7 +48,7 @@ class PlasmaStoreRunner {
 };
 
 // We use a global variable for Plasma Store instance here because:
-// 1) There is only one plasma store thread in Raylet.
+// 1) There is only one plasma store in Raylet.
 // 2) The thirdparty dlmalloc library cannot be contained in a local variable,
 //    so even we use a local variable for plasma store, it does not provide
 //    better isolation.
@@ -183,6 +183,176 @@ TEST(EvictionPolicyTest, Test) {
     EXPECT_TRUE(policy.IsObjectExists(key1));
   }
 }
+
+TEST(EvictionStatsTrackerTest, Test) {
+  EvictionStatsTracker tracker(/*max_evicted_objects=*/2);
+  std::vector<ObjectID> keys;
+  for (int i = 0; i < 3; i++) {
+    keys.push_back(ObjectID::FromRandom());
+    tracker.RecordCreation(keys.back());
+  }
+  EXPECT_EQ(0, tracker.Stats().num_misses);
+
+  for (const auto &key : keys) {
+    tracker.RecordEviction(key, 10);
+  }
+  EXPECT_EQ(3, tracker.Stats().num_evictions);
+  EXPECT_EQ(30, tracker.Stats().bytes_evicted);
+
+  // Only the two most recently evicted objects are remembered.
+  for (const auto &key : keys) {
+    tracker.RecordCreation(key);
+  }
+  EXPECT_EQ(2, tracker.Stats().num_misses);
+  tracker.RecordCreation(keys[2]);
+  EXPECT_EQ(2, tracker.Stats().num_misses);
+}
+
+class SizeAwareEvictionPolicyTest : public Test {
+ public:
+  SizeAwareEvictionPolicyTest() {
+    EXPECT_CALL(allocator_, GetFootprintLimit()).WillRepeatedly(Return(100));
+    EXPECT_CALL(allocator_, Allocated()).WillRepeatedly(Return(0));
+    EXPECT_CALL(store_, GetObject(_))
+        .WillRepeatedly(Invoke([this](const ObjectID &object_id) -> const LocalObject * {
+          return objects_.at(object_id).get();
+        }));
+  }
+
+  ObjectID AddObject(int64_t size,
+                     plasma::flatbuf::ObjectSource source =
+                         plasma::flatbuf::ObjectSource::ReceivedFromRemoteRaylet) {
+    auto object_id = ObjectID::FromRandom();
+    auto object = std::make_unique<LocalObject>(Allocation());
+    object->object_info.data_size = size;
+    object->object_info.metadata_size = 0;
+    object->source = source;
+    object->state = ObjectState::PLASMA_SEALED;
+    objects_.emplace(object_id, std::move(object));
+    return object_id;
+  }
+
+  /// Create the object and seal it, like the creator of the object does.
+  ObjectID CreateObject(IEvictionPolicy &policy,
+                        int64_t size,
+                        plasma::flatbuf::ObjectSource source =
+                            plasma::flatbuf::ObjectSource::ReceivedFromRemoteRaylet) {
+    auto object_id = AddObject(size, source);
+    objects_[object_id]->state = ObjectState::PLASMA_CREATED;
+    policy.ObjectCreated(object_id);
+    policy.BeginObjectAccess(object_id);
+    objects_[object_id]->state = ObjectState::PLASMA_SEALED;
+    policy.EndObjectAccess(object_id);
+    return object_id;
+  }
+
+  void UseObject(IEvictionPolicy &policy, const ObjectID &object_id) {
+    policy.BeginObjectAccess(object_id);
+    policy.EndObjectAccess(object_id);
+  }
+
+  MockAllocator allocator_;
+  MockObjectStore store_;
+  absl::flat_hash_map<ObjectID, std::unique_ptr<LocalObject>> objects_;
+};
+
+TEST_F(SizeAwareEvictionPolicyTest, TestSegmentedLRU) {
+  SegmentedLRUEvictionPolicy policy(store_, allocator_, /*protected_fraction=*/0.5);
+  auto hot = CreateObject(policy, 40);
+  UseObject(policy, hot);
+  EXPECT_EQ(1, policy.GetStats().num_hits);
+
+  // Objects that are used only once are evicted before the hot object, even though it
+  // is less recently used and larger.
+  std::vector<ObjectID> cold;
+  for (int i = 0; i < 3; i++) {
+    cold.push_back(CreateObject(policy, 10));
+  }
+  std::vector<ObjectID> objects_to_evict;
+  EXPECT_EQ(30, policy.ChooseObjectsToEvict(25, objects_to_evict));
+  EXPECT_EQ(cold, objects_to_evict);
+  for (const auto &object_id : objects_to_evict) {
+    policy.RemoveObject(object_id);
+  }
+
+  // The protected segment holds up to half of the capacity, the least recently used
+  // protected object is moved back to the probationary segment.
+  auto hot2 = CreateObject(policy, 20);
+  UseObject(policy, hot2);
+  EXPECT_TRUE(policy.probationary_.Exists(hot));
+  EXPECT_TRUE(policy.protected_.Exists(hot2));
+  auto hot3 = CreateObject(policy, 20);
+  UseObject(policy, hot3);
+  EXPECT_TRUE(policy.protected_.Exists(hot3));
+
+  // Objects are evicted from the protected segment once the probationary segment is
+  // empty.
+  objects_to_evict.clear();
+  EXPECT_EQ(60, policy.ChooseObjectsToEvict(50, objects_to_evict));
+  EXPECT_EQ((std::vector<ObjectID>{hot, hot2}), objects_to_evict);
+  EXPECT_EQ(3, policy.GetStats().num_hits);
+  EXPECT_EQ(5, policy.GetStats().num_evictions);
+  EXPECT_EQ(90, policy.GetStats().bytes_evicted);
+}
+
+TEST_F(SizeAwareEvictionPolicyTest, TestGreedyDualSize) {
+  GreedyDualSizeEvictionPolicy policy(store_,
+                                      allocator_,
+                                      /*fetch_overhead_bytes=*/10,
+                                      /*primary_copy_cost_factor=*/4);
+  // A large object that is used often is kept over a small object that is used once.
+  auto large = CreateObject(policy, 50);
+  for (int i = 0; i < 10; i++) {
+    UseObject(policy, large);
+  }
+  auto small = CreateObject(policy, 10);
+  std::vector<ObjectID> objects_to_evict;
+  EXPECT_EQ(10, policy.ChooseObjectsToEvict(5, objects_to_evict));
+  EXPECT_EQ(std::vector<ObjectID>{small}, objects_to_evict);
+  policy.RemoveObject(small);
+
+  // Among objects used equally often, larger objects are evicted first, and primary
+  // copies are evicted after secondary copies.
+  auto secondary = CreateObject(policy, 30);
+  auto primary = CreateObject(policy, 30, plasma::flatbuf::ObjectSource::CreatedByWorker);
+  auto small_secondary = CreateObject(policy, 10);
+  objects_to_evict.clear();
+  EXPECT_EQ(70, policy.ChooseObjectsToEvict(70, objects_to_evict));
+  EXPECT_EQ((std::vector<ObjectID>{secondary, small_secondary, primary}),
+            objects_to_evict);
+  for (const auto &object_id : objects_to_evict) {
+    policy.RemoveObject(object_id);
+  }
+
+  // The priorities age, so the large object is eventually evicted once it's not used
+  // anymore.
+  int num_small_objects_evicted = 0;
+  for (; num_small_objects_evicted < 10; num_small_objects_evicted++) {
+    CreateObject(policy, 10);
+    objects_to_evict.clear();
+    policy.ChooseObjectsToEvict(10, objects_to_evict);
+    ASSERT_EQ(1, objects_to_evict.size());
+    policy.RemoveObject(objects_to_evict[0]);
+    if (objects_to_evict[0] == large) {
+      break;
+    }
+  }
+  EXPECT_EQ(2, num_small_objects_evicted);
+
+  EXPECT_EQ(10, policy.GetStats().num_hits);
+  // An evicted object that is created again is a miss.
+  policy.ObjectCreated(small);
+  EXPECT_EQ(1, policy.GetStats().num_misses);
+}
+
+TEST_F(SizeAwareEvictionPolicyTest, TestCreateEvictionPolicy) {
+  EXPECT_EQ("lru", CreateEvictionPolicy("lru", store_, allocator_)->Name());
+  EXPECT_EQ("segmented_lru",
+            CreateEvictionPolicy("segmented_lru", store_, allocator_)->Name());
+  EXPECT_EQ("greedy_dual_size",
+            CreateEvictionPolicy("greedy_dual_size", store_, allocator_)->Name());
+}
+
 }  // namespace plasma
 
 int main(int argc, char **argv) {
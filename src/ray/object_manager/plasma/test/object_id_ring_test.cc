@@ -0,0 +1,104 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/object_id_ring.h"
+
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace plasma {
+
+class ObjectIdRingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+#ifndef __linux__
+    GTEST_SKIP() << "The object ID ring is only supported on Linux.";
+#endif
+    producer_ = ObjectIdRing::Create(/*capacity=*/4, &fd_);
+    ASSERT_NE(producer_, nullptr);
+    consumer_ = ObjectIdRing::Attach(fd_);
+    ASSERT_NE(consumer_, nullptr);
+  }
+
+  void TearDown() override {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  int fd_ = -1;
+  std::unique_ptr<ObjectIdRing> producer_;
+  std::unique_ptr<ObjectIdRing> consumer_;
+};
+
+TEST_F(ObjectIdRingTest, TestPushAndPop) {
+  ASSERT_EQ(consumer_->Capacity(), 4);
+  ObjectID popped;
+  ASSERT_FALSE(consumer_->Pop(&popped));
+
+  std::vector<ObjectID> object_ids;
+  bool needs_wakeup = false;
+  for (int i = 0; i < 4; i++) {
+    object_ids.push_back(ObjectID::FromRandom());
+    ASSERT_TRUE(producer_->Push(object_ids.back(), &needs_wakeup));
+    // Only the first push finds the consumer waiting on an empty ring.
+    ASSERT_EQ(needs_wakeup, i == 0);
+  }
+  // The ring is full.
+  ASSERT_FALSE(producer_->Push(ObjectID::FromRandom(), &needs_wakeup));
+
+  for (const auto &object_id : object_ids) {
+    ASSERT_TRUE(consumer_->Pop(&popped));
+    ASSERT_EQ(popped, object_id);
+  }
+  ASSERT_FALSE(consumer_->Pop(&popped));
+
+  // The consumer emptied the ring, so the next push wakes it up again.
+  ASSERT_TRUE(producer_->Push(object_ids[0], &needs_wakeup));
+  ASSERT_TRUE(needs_wakeup);
+  ASSERT_TRUE(consumer_->Pop(&popped));
+  ASSERT_EQ(popped, object_ids[0]);
+}
+
+TEST_F(ObjectIdRingTest, TestConcurrentProducer) {
+  constexpr int kNumObjects = 10000;
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < kNumObjects; i++) {
+    object_ids.push_back(ObjectID::FromRandom());
+  }
+  std::thread producer([this, &object_ids]() {
+    bool needs_wakeup;
+    for (const auto &object_id : object_ids) {
+      while (!producer_->Push(object_id, &needs_wakeup)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  ObjectID popped;
+  for (int i = 0; i < kNumObjects; i++) {
+    while (!consumer_->Pop(&popped)) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(popped, object_ids[i]);
+  }
+  producer.join();
+  ASSERT_FALSE(consumer_->Pop(&popped));
+}
+
+}  // namespace plasma
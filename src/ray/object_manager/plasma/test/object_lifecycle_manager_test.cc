@@ -35,6 +35,8 @@ class MockEvictionPolicy : public IEvictionPolicy {
   MOCK_METHOD2(ChooseObjectsToEvict, int64_t(int64_t, std::vector<ObjectID> &));
   MOCK_METHOD1(RemoveObject, void(const ObjectID &));
   MOCK_CONST_METHOD0(DebugString, std::string());
+  MOCK_CONST_METHOD0(Name, std::string());
+  MOCK_CONST_METHOD0(GetStats, const EvictionPolicyStats &());
 };
 
 class MockObjectStore : public IObjectStore {
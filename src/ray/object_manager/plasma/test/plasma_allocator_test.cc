@@ -0,0 +1,91 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include "ray/object_manager/plasma/plasma_allocator.h"
+
+using namespace boost::filesystem;
+
+namespace plasma {
+namespace {
+const int64_t kKB = 1024;
+const int64_t kMB = 1024 * 1024;
+std::string CreateTestDir() {
+  path directory = temp_directory_path() / unique_path();
+  create_directories(directory);
+  return directory.string();
+}
+};  // namespace
+
+TEST(PlasmaAllocatorTest, SmallObjectPagesTest) {
+  auto plasma_directory = CreateTestDir();
+  auto fallback_directory = CreateTestDir();
+  int64_t kLimit = 256 * sizeof(size_t) + 8 * kMB;
+  const int64_t kPageSize = 256 * kKB;
+  PlasmaAllocator allocator(plasma_directory,
+                            fallback_directory,
+                            /* hugepage_enabled */ false,
+                            kLimit,
+                            /* small_object_max_size */ kKB);
+  EXPECT_EQ(0, allocator.SmallObjectUnusedBytes());
+
+  // Objects of 100 bytes share a page of 128-byte slots.
+  std::vector<Allocation> allocations;
+  for (int i = 0; i < 100; i++) {
+    auto allocation = allocator.Allocate(100);
+    ASSERT_TRUE(allocation.has_value());
+    allocations.push_back(std::move(allocation.value()));
+  }
+  EXPECT_EQ(100 * 100, allocator.Allocated());
+  EXPECT_EQ(kPageSize - 100 * 100, allocator.SmallObjectUnusedBytes());
+  EXPECT_EQ(static_cast<uint8_t *>(allocations[0].address) + 128,
+            allocations[1].address);
+  EXPECT_EQ(allocations[0].offset + 128, allocations[1].offset);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(allocations[1].address) % 64);
+
+  // The last page of a size class is kept when its objects are freed.
+  for (auto &allocation : allocations) {
+    allocator.Free(std::move(allocation));
+  }
+  allocations.clear();
+  EXPECT_EQ(0, allocator.Allocated());
+  EXPECT_EQ(kPageSize, allocator.SmallObjectUnusedBytes());
+
+  // Objects of 1000 bytes take 1024-byte slots, 256 per page.
+  for (int i = 0; i < 2000; i++) {
+    auto allocation = allocator.Allocate(1000);
+    ASSERT_TRUE(allocation.has_value());
+    allocations.push_back(std::move(allocation.value()));
+  }
+  EXPECT_EQ(2000 * 1000, allocator.Allocated());
+  EXPECT_EQ(9 * kPageSize - 2000 * 1000, allocator.SmallObjectUnusedBytes());
+
+  // Larger objects don't use the pages.
+  auto large_allocation = allocator.Allocate(kMB);
+  ASSERT_TRUE(large_allocation.has_value());
+  EXPECT_EQ(9 * kPageSize - 2000 * 1000, allocator.SmallObjectUnusedBytes());
+  allocator.Free(std::move(large_allocation.value()));
+
+  // Empty pages are given back, except the last one of each size class.
+  for (auto &allocation : allocations) {
+    allocator.Free(std::move(allocation));
+  }
+  allocations.clear();
+  EXPECT_EQ(0, allocator.Allocated());
+  EXPECT_EQ(2 * kPageSize, allocator.SmallObjectUnusedBytes());
+}
+
+}  // namespace plasma
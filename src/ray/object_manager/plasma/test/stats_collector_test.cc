@@ -32,6 +32,9 @@ int64_t Random(int64_t max) {
 class DummyAllocator : public IAllocator {
  public:
   absl::optional<Allocation> Allocate(size_t bytes) override {
+    if (primary_full_) {
+      return absl::nullopt;
+    }
     allocated_ += bytes;
     auto allocation = Allocation();
     allocation.size = bytes;
@@ -39,7 +42,14 @@ class DummyAllocator : public IAllocator {
   }
 
   absl::optional<Allocation> FallbackAllocate(size_t bytes) override {
-    return absl::nullopt;
+    if (!primary_full_) {
+      return absl::nullopt;
+    }
+    allocated_ += bytes;
+    auto allocation = Allocation();
+    allocation.size = bytes;
+    allocation.fallback_allocated = true;
+    return std::move(allocation);
   }
 
   void Free(Allocation allocation) override { allocated_ -= allocation.size; }
@@ -52,6 +62,9 @@ class DummyAllocator : public IAllocator {
 
   int64_t FallbackAllocated() const override { return 0; }
 
+  /// If set, allocations only succeed with the fallback allocator.
+  bool primary_full_ = false;
+
  private:
   int64_t allocated_ = 0;
 };
@@ -90,6 +103,9 @@ struct ObjectStatsCollectorTest : public Test {
     int64_t num_bytes_received = 0;
     int64_t num_objects_errored = 0;
     int64_t num_bytes_errored = 0;
+    int64_t num_objects_fallback_allocated = 0;
+    int64_t num_bytes_fallback_allocated = 0;
+    absl::flat_hash_map<JobID, int64_t> num_bytes_by_job;
 
     for (const auto &obj_entry : object_store_->object_table_) {
       const auto &obj = obj_entry.second;
@@ -128,6 +144,14 @@ struct ObjectStatsCollectorTest : public Test {
         num_objects_errored++;
         num_bytes_errored += obj->object_info.GetObjectSize();
       }
+
+      if (obj->allocation.fallback_allocated) {
+        num_objects_fallback_allocated++;
+        num_bytes_fallback_allocated += obj->object_info.GetObjectSize();
+      } else {
+        num_bytes_by_job[obj->object_info.object_id.TaskId().JobId()] +=
+            obj->object_info.GetObjectSize();
+      }
     }
 
     EXPECT_EQ(num_bytes_created_total_, collector_->num_bytes_created_total_);
@@ -147,6 +171,10 @@ struct ObjectStatsCollectorTest : public Test {
     EXPECT_EQ(num_bytes_received, collector_->num_bytes_received_);
     EXPECT_EQ(num_objects_errored, collector_->num_objects_errored_);
     EXPECT_EQ(num_bytes_errored, collector_->num_bytes_errored_);
+    EXPECT_EQ(num_objects_fallback_allocated,
+              collector_->num_objects_fallback_allocated_);
+    EXPECT_EQ(num_bytes_fallback_allocated, collector_->num_bytes_fallback_allocated_);
+    EXPECT_EQ(num_bytes_by_job, collector_->num_bytes_by_job_);
   }
 
   ray::ObjectInfo CreateNewObjectInfo(int64_t data_size) {
@@ -288,4 +316,26 @@ TEST_F(ObjectStatsCollectorTest, RefCountPassThrough) {
   manager_->DeleteObject(id2);
   ExpectStatsMatch();
 }
+
+TEST_F(ObjectStatsCollectorTest, FallbackAllocation) {
+  auto info1 = CreateNewObjectInfo(Random(100));
+  manager_->CreateObject(info1, ObjectSource::CreatedByWorker, true);
+  num_bytes_created_total_ += info1.GetObjectSize();
+  ExpectStatsMatch();
+  EXPECT_EQ(0, collector_->num_objects_fallback_allocated_);
+
+  // Once shared memory is full, new objects go to the fallback allocator.
+  allocator_->primary_full_ = true;
+  auto info2 = CreateNewObjectInfo(Random(100));
+  manager_->CreateObject(info2, ObjectSource::CreatedByWorker, true);
+  num_bytes_created_total_ += info2.GetObjectSize();
+  ExpectStatsMatch();
+  EXPECT_EQ(1, collector_->num_objects_fallback_allocated_);
+
+  for (auto id : used_ids_) {
+    manager_->AbortObject(id);
+    ExpectStatsMatch();
+  }
+  EXPECT_EQ(0, collector_->num_bytes_fallback_allocated_);
+}
 }  // namespace plasma
\ No newline at end of file
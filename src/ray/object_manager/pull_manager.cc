@@ -14,16 +14,65 @@
 
 #include "ray/object_manager/pull_manager.h"
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
 #include "ray/common/common_protocol.h"
+#include "ray/object_manager/spilled_object_reader.h"
 #include "ray/stats/metric_defs.h"
 #include "ray/util/container_util.h"
 
 namespace ray {
 
+namespace {
+
+/// The maximum number of queued bundles that PrefetchSpilledObjects looks at.
+constexpr size_t kMaxBundlesToPrefetch = 1000;
+
+/// Sort objects by the file and offset that they are restored from, so that the
+/// objects fused into the same spill file are read sequentially. Objects without a
+/// restore URL keep their order and go first.
+void SortBySpilledLocation(std::vector<std::pair<ObjectID, std::string>> *objects) {
+  std::vector<std::tuple<std::string, uint64_t, size_t>> locations;
+  locations.reserve(objects->size());
+  for (size_t i = 0; i < objects->size(); i++) {
+    std::string file_path;
+    uint64_t object_offset = 0;
+    uint64_t object_size = 0;
+    if (!SpilledObjectReader::ParseObjectURL(
+            (*objects)[i].second, file_path, object_offset, object_size)) {
+      file_path.clear();
+      object_offset = 0;
+    }
+    locations.emplace_back(std::move(file_path), object_offset, i);
+  }
+  std::sort(locations.begin(), locations.end());
+  std::vector<std::pair<ObjectID, std::string>> sorted;
+  sorted.reserve(objects->size());
+  for (const auto &location : locations) {
+    sorted.push_back(std::move((*objects)[std::get<2>(location)]));
+  }
+  *objects = std::move(sorted);
+}
+
+/// The size bucket of an object for the pull latency metric.
+std::string ObjectSizeBucket(int64_t object_size) {
+  if (object_size < 1024 * 1024) {
+    return "<1MB";
+  } else if (object_size < 100 * 1024 * 1024) {
+    return "1-100MB";
+  }
+  return ">100MB";
+}
+
+}  // namespace
+
 PullManager::PullManager(
     NodeID &self_node_id,
     const std::function<bool(const ObjectID &)> object_is_local,
-    const std::function<void(const ObjectID &, const NodeID &)> send_pull_request,
+    const std::function<void(const ObjectID &, const NodeID &, const ChunkStripe &)>
+        send_pull_request,
     const std::function<void(const ObjectID &)> cancel_pull_request,
     const std::function<void(const ObjectID &)> fail_pull_request,
     const RestoreSpilledObjectCallback restore_spilled_object,
@@ -47,7 +96,8 @@ PullManager::PullManager(
 
 uint64_t PullManager::Pull(const std::vector<rpc::ObjectReference> &object_ref_bundle,
                            BundlePriority prio,
-                           std::vector<rpc::ObjectReference> *objects_to_locate) {
+                           std::vector<rpc::ObjectReference> *objects_to_locate,
+                           const PullOptions &options) {
   // To avoid edge cases dealing with duplicated object ids in the bundle,
   // canonicalize the set up-front by dropping all duplicates.
   absl::flat_hash_set<ObjectID> seen;
@@ -59,18 +109,25 @@ uint64_t PullManager::Pull(const std::vector<rpc::ObjectReference> &object_ref_b
       deduplicated.push_back(ref);
     }
   }
-  Queue::iterator bundle_it;
+  const double deadline_s = options.timeout_ms < 0
+                                ? std::numeric_limits<double>::infinity()
+                                : get_time_seconds_() + options.timeout_ms / 1e3;
+  const BundleOrder order{options.priority, deadline_s, 0, next_req_id_++};
+  Queue *bundles = nullptr;
+  uint64_t *highest_req_id_being_pulled = nullptr;
   if (prio == BundlePriority::GET_REQUEST) {
-    bundle_it =
-        get_request_bundles_.emplace(next_req_id_++, std::move(deduplicated)).first;
+    bundles = &get_request_bundles_;
+    highest_req_id_being_pulled = &highest_get_req_id_being_pulled_;
   } else if (prio == BundlePriority::WAIT_REQUEST) {
-    bundle_it =
-        wait_request_bundles_.emplace(next_req_id_++, std::move(deduplicated)).first;
+    bundles = &wait_request_bundles_;
+    highest_req_id_being_pulled = &highest_wait_req_id_being_pulled_;
   } else {
     RAY_CHECK(prio == BundlePriority::TASK_ARGS);
-    bundle_it =
-        task_argument_bundles_.emplace(next_req_id_++, std::move(deduplicated)).first;
+    bundles = &task_argument_bundles_;
+    highest_req_id_being_pulled = &highest_task_req_id_being_pulled_;
   }
+  auto bundle_it =
+      bundles->emplace(order.request_id, PullBundleRequest(deduplicated, order)).first;
   RAY_LOG(DEBUG) << "Start pull request " << bundle_it->first
                  << ". Bundle size: " << bundle_it->second.objects.size();
 
@@ -86,6 +143,13 @@ uint64_t PullManager::Pull(const std::vector<rpc::ObjectReference> &object_ref_b
       // the retry timer fire immediately.
       it = object_pull_requests_.emplace(obj_id, ObjectPullRequest(get_time_seconds_()))
                .first;
+      // Task arguments carry their size if the submitter knew it, so the bundle
+      // doesn't wait for the first location update to be admitted.
+      if (ref.has_object_size()) {
+        it->second.object_size = ref.object_size();
+        it->second.object_size_set = true;
+        bundle_it->second.RegisterObjectSize(it->second.object_size);
+      }
     } else {
       if (it->second.object_size_set) {
         bundle_it->second.RegisterObjectSize(it->second.object_size);
@@ -94,57 +158,61 @@ uint64_t PullManager::Pull(const std::vector<rpc::ObjectReference> &object_ref_b
     it->second.bundle_request_ids.insert(bundle_it->first);
   }
 
+  std::vector<ObjectID> objects_to_pull;
+  if (bundle_it->second.num_object_sizes_missing == 0) {
+    MarkPullBundleRequestReady(
+        *bundles, bundle_it, *highest_req_id_being_pulled, &objects_to_pull);
+  }
+
   // We have a new request. Activate the new request, if the
   // current available memory allows it.
   UpdatePullsBasedOnAvailableMemory(num_bytes_available_);
 
+  absl::MutexLock lock(&active_objects_mu_);
+  for (const auto &obj_id : objects_to_pull) {
+    TryToMakeObjectLocal(obj_id);
+  }
   return bundle_it->first;
 }
 
+void PullManager::MarkPullBundleRequestReady(Queue &bundles,
+                                             const Queue::iterator &request_it,
+                                             uint64_t highest_req_id_being_pulled,
+                                             std::vector<ObjectID> *objects_to_pull) {
+  auto &request = request_it->second;
+  RAY_CHECK(request.num_object_sizes_missing == 0);
+  if (RayConfig::instance().pull_manager_shortest_bundle_first()) {
+    request.order.num_bytes = request.num_bytes_needed;
+  }
+  RAY_CHECK(bundles.ready.insert(request.order).second);
+  if (highest_req_id_being_pulled != 0 &&
+      request.order < bundles.at(highest_req_id_being_pulled).order) {
+    RAY_LOG(DEBUG) << "Request " << request_it->first << " preempts request "
+                   << highest_req_id_being_pulled;
+    absl::MutexLock lock(&active_objects_mu_);
+    ActivatePullBundleRequest(request_it->first, request, objects_to_pull);
+  }
+}
+
 bool PullManager::ActivateNextPullBundleRequest(const Queue &bundles,
                                                 uint64_t *highest_req_id_being_pulled,
                                                 bool respect_quota,
                                                 std::vector<ObjectID> *objects_to_pull) {
-  // Get the next pull request in the queue.
-  const auto last_request_it = bundles.find(*highest_req_id_being_pulled);
-  auto next_request_it = last_request_it;
-  if (next_request_it == bundles.end()) {
-    // No requests are active. Get the first request in the queue.
-    next_request_it = bundles.begin();
-  } else {
-    next_request_it++;
-  }
-
+  // Get the next pull request in the queue. Requests that are missing object
+  // sizes are not ordered yet, since they may put us over the available capacity.
+  const auto next_request_it =
+      NextPullBundleRequest(bundles, *highest_req_id_being_pulled);
   if (next_request_it == bundles.end()) {
     // No requests in the queue.
     return false;
   }
 
-  if (next_request_it->second.num_object_sizes_missing > 0) {
-    // There is at least one object size missing. We should not activate the
-    // bundle, since it may put us over the available capacity.
-    return false;
-  }
-
   // Activate the pull bundle request if possible.
   {
     absl::MutexLock lock(&active_objects_mu_);
 
     // First calculate the bytes we need.
-    int64_t bytes_to_pull = 0;
-    for (const auto &ref : next_request_it->second.objects) {
-      auto obj_id = ObjectRefToId(ref);
-      bool needs_pull = active_object_pull_requests_.count(obj_id) == 0;
-      if (needs_pull) {
-        // This is the first bundle request in the queue to require this object.
-        // Add the size to the number of bytes being pulled.
-        auto it = object_pull_requests_.find(obj_id);
-        RAY_CHECK(it != object_pull_requests_.end());
-        // TODO(ekl) this overestimates bytes needed if it's already available
-        // locally.
-        bytes_to_pull += it->second.object_size;
-      }
-    }
+    int64_t bytes_to_pull = BytesToActivate(next_request_it->second);
 
     // Quota check.
     if (respect_quota && num_active_bundles_ >= 1 && bytes_to_pull > RemainingQuota()) {
@@ -162,32 +230,75 @@ bool PullManager::ActivateNextPullBundleRequest(const Queue &bundles,
       return false;
     }
 
-    RAY_LOG(DEBUG) << "Activating request " << next_request_it->first
-                   << " num bytes being pulled: " << num_bytes_being_pulled_
-                   << " num bytes available: " << num_bytes_available_;
-    num_bytes_being_pulled_ += bytes_to_pull;
-    for (const auto &ref : next_request_it->second.objects) {
-      auto obj_id = ObjectRefToId(ref);
-      bool needs_pull = active_object_pull_requests_.count(obj_id) == 0;
-      active_object_pull_requests_[obj_id].insert(next_request_it->first);
-      if (needs_pull) {
-        RAY_LOG(DEBUG) << "Activating pull for object " << obj_id;
-        auto &request = map_find_or_die(object_pull_requests_, obj_id);
-        request.activate_time_ms = absl::GetCurrentTimeNanos() / 1e3;
-
-        TryPinObject(obj_id);
-        objects_to_pull->push_back(obj_id);
-        ResetRetryTimer(obj_id);
-      }
-    }
+    ActivatePullBundleRequest(
+        next_request_it->first, next_request_it->second, objects_to_pull);
   }
 
   // Update the pointer to the last pull request that we are actively pulling.
-  RAY_CHECK(next_request_it->first > *highest_req_id_being_pulled);
   *highest_req_id_being_pulled = next_request_it->first;
+  return true;
+}
 
+void PullManager::ActivatePullBundleRequest(uint64_t request_id,
+                                            const PullBundleRequest &request,
+                                            std::vector<ObjectID> *objects_to_pull) {
+  RAY_LOG(DEBUG) << "Activating request " << request_id
+                 << " num bytes being pulled: " << num_bytes_being_pulled_
+                 << " num bytes available: " << num_bytes_available_;
+  num_bytes_being_pulled_ += BytesToActivate(request);
+  for (const auto &ref : request.objects) {
+    auto obj_id = ObjectRefToId(ref);
+    bool needs_pull = active_object_pull_requests_.count(obj_id) == 0;
+    active_object_pull_requests_[obj_id].insert(request_id);
+    if (needs_pull) {
+      RAY_LOG(DEBUG) << "Activating pull for object " << obj_id;
+      auto &object_request = map_find_or_die(object_pull_requests_, obj_id);
+      object_request.activate_time_ms = absl::GetCurrentTimeNanos() / 1e6;
+
+      StopPrefetching(obj_id);
+      TryPinObject(obj_id);
+      objects_to_pull->push_back(obj_id);
+      ResetRetryTimer(obj_id);
+    }
+  }
   num_active_bundles_ += 1;
-  return true;
+}
+
+int64_t PullManager::BytesToActivate(const PullBundleRequest &request) const {
+  int64_t bytes_to_pull = 0;
+  for (const auto &ref : request.objects) {
+    auto obj_id = ObjectRefToId(ref);
+    bool needs_pull = active_object_pull_requests_.count(obj_id) == 0;
+    if (needs_pull) {
+      // This is the first bundle request in the queue to require this object.
+      // Add the size to the number of bytes being pulled.
+      auto it = object_pull_requests_.find(obj_id);
+      RAY_CHECK(it != object_pull_requests_.end());
+      // TODO(ekl) this overestimates bytes needed if it's already available
+      // locally.
+      bytes_to_pull += it->second.object_size;
+    }
+  }
+  return bytes_to_pull;
+}
+
+PullManager::Queue::const_iterator PullManager::NextPullBundleRequest(
+    const Queue &bundles, uint64_t highest_req_id_being_pulled) const {
+  auto next_it = highest_req_id_being_pulled == 0
+                     ? bundles.ready.begin()
+                     : bundles.ready.upper_bound(
+                           bundles.at(highest_req_id_being_pulled).order);
+  if (next_it == bundles.ready.end()) {
+    return bundles.end();
+  }
+  return bundles.find(next_it->request_id);
+}
+
+bool PullManager::IsPullBundleRequestActive(const Queue &bundles,
+                                            const PullBundleRequest &request,
+                                            uint64_t highest_req_id_being_pulled) const {
+  return highest_req_id_being_pulled != 0 && request.num_object_sizes_missing == 0 &&
+         !(bundles.at(highest_req_id_being_pulled).order < request.order);
 }
 
 void PullManager::DeactivatePullBundleRequest(
@@ -218,10 +329,12 @@ void PullManager::DeactivatePullBundleRequest(
   // If this was the last active request, update the pointer to its
   // predecessor, if one exists.
   if (*highest_req_id_being_pulled == request_it->first) {
-    if (request_it == bundles.begin()) {
+    auto order_it = bundles.ready.find(request_it->second.order);
+    RAY_CHECK(order_it != bundles.ready.end());
+    if (order_it == bundles.ready.begin()) {
       *highest_req_id_being_pulled = 0;
     } else {
-      *highest_req_id_being_pulled = std::prev(request_it)->first;
+      *highest_req_id_being_pulled = std::prev(order_it)->request_id;
     }
   }
 
@@ -347,12 +460,101 @@ void PullManager::UpdatePullsBasedOnAvailableMemory(int64_t num_bytes_available)
   }
 
   {
-    absl::MutexLock lock(&active_objects_mu_);
+    // Restore the objects that are spilled to the same file in the order of their
+    // offsets.
+    std::vector<std::pair<ObjectID, std::string>> objects_by_location;
     for (const auto &obj_id : objects_to_pull) {
       if (object_ids_to_cancel.count(obj_id) == 0) {
-        TryToMakeObjectLocal(obj_id);
+        objects_by_location.emplace_back(
+            obj_id,
+            GetDirectRestoreURL(obj_id, map_find_or_die(object_pull_requests_, obj_id)));
       }
     }
+    SortBySpilledLocation(&objects_by_location);
+    absl::MutexLock lock(&active_objects_mu_);
+    for (const auto &entry : objects_by_location) {
+      TryToMakeObjectLocal(entry.first);
+    }
+  }
+
+  PrefetchSpilledObjects();
+}
+
+void PullManager::PrefetchSpilledObjects() {
+  const int64_t max_prefetch_bytes =
+      RayConfig::instance().pull_manager_restore_prefetch_bytes();
+  if (max_prefetch_bytes <= 0) {
+    return;
+  }
+  std::vector<std::pair<ObjectID, std::string>> objects_to_restore;
+  {
+    absl::MutexLock lock(&active_objects_mu_);
+    int64_t bytes_left =
+        std::min(max_prefetch_bytes, RemainingQuota()) - num_bytes_being_prefetched_;
+    size_t num_bundles_visited = 0;
+    for (const auto &queue :
+         {std::make_pair(&get_request_bundles_, highest_get_req_id_being_pulled_),
+          std::make_pair(&wait_request_bundles_, highest_wait_req_id_being_pulled_),
+          std::make_pair(&task_argument_bundles_, highest_task_req_id_being_pulled_)}) {
+      const Queue &bundles = *queue.first;
+      // Start after the active prefix of the queue.
+      auto order_it = queue.second == 0
+                          ? bundles.ready.begin()
+                          : bundles.ready.upper_bound(bundles.at(queue.second).order);
+      for (; order_it != bundles.ready.end() && bytes_left > 0 &&
+             num_bundles_visited < kMaxBundlesToPrefetch;
+           order_it++, num_bundles_visited++) {
+        for (const auto &ref : bundles.at(order_it->request_id).objects) {
+          const auto obj_id = ObjectRefToId(ref);
+          if (active_object_pull_requests_.contains(obj_id) ||
+              objects_being_prefetched_.contains(obj_id)) {
+            continue;
+          }
+          const auto &request = map_find_or_die(object_pull_requests_, obj_id);
+          auto restore_url = GetDirectRestoreURL(obj_id, request);
+          if (restore_url.empty() || object_is_local_(obj_id)) {
+            continue;
+          }
+          if (static_cast<int64_t>(request.object_size) > bytes_left) {
+            // Keep the bundle order, rather than filling the memory with the objects
+            // of later bundles.
+            bytes_left = 0;
+            break;
+          }
+          RAY_LOG(DEBUG) << "Prefetching spilled object " << obj_id;
+          bytes_left -= request.object_size;
+          objects_being_prefetched_.emplace(obj_id, request.object_size);
+          num_bytes_being_prefetched_ += request.object_size;
+          objects_to_restore.emplace_back(obj_id, std::move(restore_url));
+        }
+      }
+    }
+  }
+
+  // Call the restore callbacks outside of the lock.
+  SortBySpilledLocation(&objects_to_restore);
+  for (const auto &entry : objects_to_restore) {
+    const auto &object_id = entry.first;
+    restore_spilled_object_(object_id,
+                            map_find_or_die(object_pull_requests_, object_id).object_size,
+                            entry.second,
+                            [this, object_id](const ray::Status &status) {
+                              if (!status.ok()) {
+                                RAY_LOG(DEBUG) << "Prefetch of spilled object "
+                                               << object_id << " failed: " << status;
+                                absl::MutexLock lock(&active_objects_mu_);
+                                StopPrefetching(object_id);
+                              }
+                            });
+  }
+  num_prefetched_restores_total_ += objects_to_restore.size();
+}
+
+void PullManager::StopPrefetching(const ObjectID &object_id) {
+  auto it = objects_being_prefetched_.find(object_id);
+  if (it != objects_being_prefetched_.end()) {
+    num_bytes_being_prefetched_ -= it->second;
+    objects_being_prefetched_.erase(it);
   }
 }
 
@@ -379,7 +581,8 @@ std::vector<ObjectID> PullManager::CancelPull(uint64_t request_id) {
   }
 
   // If the pull request was being actively pulled, deactivate it now.
-  if (bundle_it->first <= *highest_req_id_being_pulled) {
+  if (IsPullBundleRequestActive(
+          *request_queue, bundle_it->second, *highest_req_id_being_pulled)) {
     std::unordered_set<ObjectID> object_ids_to_cancel;
     DeactivatePullBundleRequest(
         *request_queue, bundle_it, highest_req_id_being_pulled, &object_ids_to_cancel);
@@ -398,14 +601,19 @@ std::vector<ObjectID> PullManager::CancelPull(uint64_t request_id) {
       RAY_LOG(DEBUG) << "Removing an object pull request of id: " << obj_id;
       it->second.bundle_request_ids.erase(bundle_it->first);
       if (it->second.bundle_request_ids.empty()) {
+        {
+          absl::MutexLock lock(&active_objects_mu_);
+          StopPrefetching(obj_id);
+        }
         ray::stats::STATS_pull_manager_object_request_time_ms.Record(
-            absl::GetCurrentTimeNanos() / 1e3 - it->second.request_start_time_ms,
+            absl::GetCurrentTimeNanos() / 1e6 - it->second.request_start_time_ms,
             "StartToCancel");
         object_pull_requests_.erase(it);
         object_ids_to_cancel_subscription.push_back(obj_id);
       }
     }
   }
+  request_queue->ready.erase(bundle_it->second.order);
   request_queue->erase(bundle_it);
 
   // We need to update the pulls in case there is another request(s) after this
@@ -446,28 +654,44 @@ void PullManager::OnLocationChange(const ObjectID &object_id,
   it->second.spilled_node_id = spilled_node_id;
   it->second.pending_object_creation = pending_creation;
   if (!it->second.object_size_set) {
-    // TODO(swang): This assumes that the object size will be set correctly on
-    // the first location update and that locations will soon appear after the
-    // object size has been set. This can block later requests whose metadata
-    // has already arrived. Instead, we should keep track of which pull
-    // requests are still waiting for object metadata and queue requests in the
-    // order that their metadata appears.
-    // See https://github.com/ray-project/ray/issues/13689.
+    // NOTE(swang): This assumes that the object size will be set correctly on
+    // the first location update. Requests are only ordered once all of their
+    // object sizes are known, so they don't block the requests whose metadata
+    // has already arrived.
     it->second.object_size = object_size;
     it->second.object_size_set = true;
+    std::vector<ObjectID> objects_to_pull;
     for (auto &bundle_request_id : it->second.bundle_request_ids) {
+      Queue *bundles = &get_request_bundles_;
+      uint64_t highest_req_id_being_pulled = highest_get_req_id_being_pulled_;
       auto bundle_it = get_request_bundles_.find(bundle_request_id);
       if (bundle_it == get_request_bundles_.end()) {
+        bundles = &wait_request_bundles_;
+        highest_req_id_being_pulled = highest_wait_req_id_being_pulled_;
         bundle_it = wait_request_bundles_.find(bundle_request_id);
         if (bundle_it == wait_request_bundles_.end()) {
+          bundles = &task_argument_bundles_;
+          highest_req_id_being_pulled = highest_task_req_id_being_pulled_;
           bundle_it = task_argument_bundles_.find(bundle_request_id);
           RAY_CHECK(bundle_it != task_argument_bundles_.end());
         }
       }
       bundle_it->second.RegisterObjectSize(object_size);
+      if (bundle_it->second.num_object_sizes_missing == 0) {
+        MarkPullBundleRequestReady(
+            *bundles, bundle_it, highest_req_id_being_pulled, &objects_to_pull);
+      }
     }
 
     UpdatePullsBasedOnAvailableMemory(num_bytes_available_);
+    {
+      absl::MutexLock lock(&active_objects_mu_);
+      for (const auto &obj_id : objects_to_pull) {
+        if (obj_id != object_id) {
+          TryToMakeObjectLocal(obj_id);
+        }
+      }
+    }
     RAY_LOG(DEBUG) << "Updated size of object " << object_id << " to " << object_size
                    << ", num bytes being pulled is now " << num_bytes_being_pulled_;
     if (it->second.object_size == 0) {
@@ -514,13 +738,7 @@ void PullManager::TryToMakeObjectLocal(const ObjectID &object_id) {
   }
 
   // check if we can restore the object directly in the current raylet.
-  // first check local spilled objects
-  std::string direct_restore_url = get_locally_spilled_object_url_(object_id);
-  if (direct_restore_url.empty()) {
-    if (!request.spilled_url.empty() && request.spilled_node_id.IsNil()) {
-      direct_restore_url = request.spilled_url;
-    }
-  }
+  std::string direct_restore_url = GetDirectRestoreURL(object_id, request);
   if (!direct_restore_url.empty()) {
     // Select an url from the object directory update
     UpdateRetryTimer(request, object_id);
@@ -556,6 +774,18 @@ void PullManager::TryToMakeObjectLocal(const ObjectID &object_id) {
   }
 }
 
+std::string PullManager::GetDirectRestoreURL(const ObjectID &object_id,
+                                             const ObjectPullRequest &request) const {
+  // first check local spilled objects
+  std::string direct_restore_url = get_locally_spilled_object_url_(object_id);
+  if (direct_restore_url.empty()) {
+    if (!request.spilled_url.empty() && request.spilled_node_id.IsNil()) {
+      direct_restore_url = request.spilled_url;
+    }
+  }
+  return direct_restore_url;
+}
+
 bool PullManager::PullFromRandomLocation(const ObjectID &object_id) {
   auto it = object_pull_requests_.find(object_id);
   if (it == object_pull_requests_.end()) {
@@ -571,7 +801,7 @@ bool PullManager::PullFromRandomLocation(const ObjectID &object_id) {
       RAY_LOG(DEBUG) << "Sending pull request from " << self_node_id_
                      << " to spilled location at " << spilled_node_id << " of object "
                      << object_id;
-      send_pull_request_(object_id, spilled_node_id);
+      send_pull_request_(object_id, spilled_node_id, ChunkStripe());
       return true;
     }
     // The timer should never fire if there are no expected client locations.
@@ -580,6 +810,30 @@ bool PullManager::PullFromRandomLocation(const ObjectID &object_id) {
 
   RAY_CHECK(!object_is_local_(object_id));
 
+  const size_t num_sources = std::min<size_t>(
+      node_vector.size(),
+      std::max<int64_t>(1, RayConfig::instance().object_manager_max_pull_sources()));
+  const uint64_t min_striped_bytes =
+      RayConfig::instance().object_manager_striped_pull_min_bytes();
+  if (num_sources > 1 && it->second.object_size >= min_striped_bytes) {
+    // Pull a stripe of the chunks from each of several random copies. Chunks that
+    // are lost with a source are pulled again when the retry timer fires.
+    std::vector<NodeID> sources = node_vector;
+    std::shuffle(sources.begin(), sources.end(), gen_);
+    for (size_t i = 0; i < num_sources; i++) {
+      RAY_CHECK(sources[i] != self_node_id_);
+      RAY_LOG(DEBUG) << "Sending pull request from " << self_node_id_ << " to "
+                     << sources[i] << " of stripe " << i << "/" << num_sources
+                     << " of object " << object_id;
+      ChunkStripe stripe;
+      stripe.index = static_cast<uint32_t>(i);
+      stripe.count = static_cast<uint32_t>(num_sources);
+      send_pull_request_(object_id, sources[i], stripe);
+    }
+    num_striped_pulls_total_++;
+    return true;
+  }
+
   // Choose a random client to pull the object from.
   // Generate a random index.
   std::uniform_int_distribution<int> distribution(0, node_vector.size() - 1);
@@ -588,7 +842,7 @@ bool PullManager::PullFromRandomLocation(const ObjectID &object_id) {
   RAY_CHECK(node_id != self_node_id_);
   RAY_LOG(DEBUG) << "Sending pull request from " << self_node_id_
                  << " to in-memory location at " << node_id << " of object " << object_id;
-  send_pull_request_(object_id, node_id);
+  send_pull_request_(object_id, node_id, ChunkStripe());
   return true;
 }
 
@@ -633,6 +887,7 @@ void PullManager::Tick() {
 
 void PullManager::PinNewObjectIfNeeded(const ObjectID &object_id) {
   absl::MutexLock lock(&active_objects_mu_);
+  StopPrefetching(object_id);
   bool active = active_object_pull_requests_.count(object_id) > 0;
   if (active) {
     if (TryPinObject(object_id)) {
@@ -654,11 +909,14 @@ bool PullManager::TryPinObject(const ObjectID &object_id) {
       auto it = object_pull_requests_.find(object_id);
       RAY_CHECK(it != object_pull_requests_.end());
       ray::stats::STATS_pull_manager_object_request_time_ms.Record(
-          absl::GetCurrentTimeNanos() / 1e3 - it->second.request_start_time_ms,
+          absl::GetCurrentTimeNanos() / 1e6 - it->second.request_start_time_ms,
           "StartToPin");
+      ray::stats::STATS_pull_manager_object_pull_latency_ms.Record(
+          absl::GetCurrentTimeNanos() / 1e6 - it->second.request_start_time_ms,
+          ObjectSizeBucket(pinned_objects_[object_id]->GetSize()));
       if (it->second.activate_time_ms > 0) {
         ray::stats::STATS_pull_manager_object_request_time_ms.Record(
-            absl::GetCurrentTimeNanos() / 1e3 - it->second.activate_time_ms,
+            absl::GetCurrentTimeNanos() / 1e6 - it->second.activate_time_ms,
             "MemoryAvailableToPin");
       }
     } else {
@@ -683,26 +941,32 @@ int PullManager::NumActiveRequests() const { return object_pull_requests_.size()
 
 bool PullManager::IsObjectActive(const ObjectID &object_id) const {
   absl::MutexLock lock(&active_objects_mu_);
-  return active_object_pull_requests_.count(object_id) == 1;
+  return active_object_pull_requests_.count(object_id) == 1 ||
+         objects_being_prefetched_.contains(object_id);
 }
 
 bool PullManager::PullRequestActiveOrWaitingForMetadata(uint64_t request_id) const {
+  const Queue *request_queue = nullptr;
   const uint64_t *highest_req_id_being_pulled = nullptr;
   auto bundle_it = get_request_bundles_.find(request_id);
   if (bundle_it != get_request_bundles_.end()) {
+    request_queue = &get_request_bundles_;
     highest_req_id_being_pulled = &highest_get_req_id_being_pulled_;
   } else {
     bundle_it = wait_request_bundles_.find(request_id);
     if (bundle_it != wait_request_bundles_.end()) {
+      request_queue = &wait_request_bundles_;
       highest_req_id_being_pulled = &highest_wait_req_id_being_pulled_;
     } else {
       bundle_it = task_argument_bundles_.find(request_id);
       RAY_CHECK(bundle_it != task_argument_bundles_.end());
+      request_queue = &task_argument_bundles_;
       highest_req_id_being_pulled = &highest_task_req_id_being_pulled_;
     }
   }
 
-  if (request_id <= *highest_req_id_being_pulled) {
+  if (IsPullBundleRequestActive(
+          *request_queue, bundle_it->second, *highest_req_id_being_pulled)) {
     // This request is in the prefix of the queue that is being pulled.
     return true;
   }
@@ -720,7 +984,7 @@ std::string PullManager::BundleInfo(const Queue &bundles,
   if (it == bundles.end()) {
     return "N/A";
   }
-  auto bundle = it->second;
+  const auto &bundle = it->second;
   std::stringstream result;
   result << bundle.num_bytes_needed << " bytes, " << bundle.objects.size() << " objects";
   if (highest_id_being_pulled) {
@@ -738,43 +1002,14 @@ std::string PullManager::BundleInfo(const Queue &bundles,
 int64_t PullManager::NextRequestBundleSize(const Queue &bundles,
                                            uint64_t highest_id_being_pulled) const {
   // Get the next pull request in the queue.
-  const auto last_request_it = bundles.find(highest_id_being_pulled);
-  auto next_request_it = last_request_it;
-  if (next_request_it == bundles.end()) {
-    // No requests are active. Get the first request in the queue.
-    next_request_it = bundles.begin();
-  } else {
-    next_request_it++;
-  }
-
+  const auto next_request_it = NextPullBundleRequest(bundles, highest_id_being_pulled);
   if (next_request_it == bundles.end()) {
-    // No requests in the queue.
-    return 0L;
-  }
-
-  if (next_request_it->second.num_object_sizes_missing > 0) {
-    // There is at least one object size missing. We should not activate the
-    // bundle, since it may put us over the available capacity.
+    // No requests in the queue, or none whose object sizes are all known.
     return 0L;
   }
 
   absl::MutexLock lock(&active_objects_mu_);
-
-  // Calculate the bytes we need.
-  int64_t bytes_needed_calculated = 0;
-  for (const auto &ref : next_request_it->second.objects) {
-    auto obj_id = ObjectRefToId(ref);
-    bool needs_pull = active_object_pull_requests_.count(obj_id) == 0;
-    if (needs_pull) {
-      // This is the first bundle request in the queue to require this object.
-      // Add the size to the number of bytes being pulled.
-      auto it = object_pull_requests_.find(obj_id);
-      RAY_CHECK(it != object_pull_requests_.end());
-      bytes_needed_calculated += it->second.object_size;
-    }
-  }
-
-  return bytes_needed_calculated;
+  return BytesToActivate(next_request_it->second);
 }
 
 void PullManager::RecordMetrics() const {
@@ -803,15 +1038,44 @@ void PullManager::RecordMetrics() const {
                                                         "Success");
   ray::stats::STATS_pull_manager_num_object_pins.Record(num_failed_pins_total_,
                                                         "Failure");
+
+  // Break down why the requested objects that aren't local yet aren't being pulled:
+  // they don't fit in the memory available for pulls, no node is known to have them,
+  // or an earlier pull didn't complete and they are waiting for the next retry.
+  int64_t num_waiting_for_memory = 0;
+  int64_t num_without_location = 0;
+  int64_t num_waiting_for_retry = 0;
+  const double now = get_time_seconds_();
+  for (const auto &entry : object_pull_requests_) {
+    const auto &request = entry.second;
+    if (pinned_objects_.count(entry.first) > 0) {
+      continue;
+    }
+    if (active_object_pull_requests_.count(entry.first) == 0) {
+      num_waiting_for_memory++;
+    } else if (request.client_locations.empty() && request.spilled_url.empty() &&
+               request.spilled_node_id.IsNil()) {
+      num_without_location++;
+    } else if (request.num_retries > 1 && request.next_pull_time > now) {
+      num_waiting_for_retry++;
+    }
+  }
+  ray::stats::STATS_pull_manager_stalled_objects.Record(num_waiting_for_memory,
+                                                        "MemoryAdmission");
+  ray::stats::STATS_pull_manager_stalled_objects.Record(num_without_location,
+                                                        "NoLocation");
+  ray::stats::STATS_pull_manager_stalled_objects.Record(num_waiting_for_retry,
+                                                        "RetryTimer");
 }
 
-std::string PullManager::DebugString() const {
+std::string PullManager::DebugString(bool full) const {
   absl::MutexLock lock(&active_objects_mu_);
   std::stringstream result;
   result << "PullManager:";
   result << "\n- num bytes available for pulled objects: " << num_bytes_available_;
   result << "\n- num bytes being pulled (all): " << num_bytes_being_pulled_;
   result << "\n- num bytes being pulled / pinned: " << pinned_objects_size_;
+  result << "\n- num bytes being prefetched: " << num_bytes_being_prefetched_;
   result << "\n- num get request bundles: " << get_request_bundles_.size();
   result << "\n- num wait request bundles: " << wait_request_bundles_.size();
   result << "\n- num task request bundles: " << task_argument_bundles_.size();
@@ -827,6 +1091,8 @@ std::string PullManager::DebugString() const {
   result << "\n- num objects actively pulled / pinned: " << pinned_objects_.size();
   result << "\n- num bundles being pulled: " << num_active_bundles_;
   result << "\n- num pull retries: " << num_retries_total_;
+  result << "\n- num striped pulls: " << num_striped_pulls_total_;
+  result << "\n- num prefetched restores: " << num_prefetched_restores_total_;
   result << "\n- max timeout seconds: " << max_timeout_;
   auto it = object_pull_requests_.find(max_timeout_object_id_);
   if (it != object_pull_requests_.end()) {
@@ -839,8 +1105,8 @@ std::string PullManager::DebugString() const {
   } else {
     result << "\n- max timeout request is already processed. No entry.";
   }
-  // Guard this more expensive debug message under event stats.
-  if (RayConfig::instance().event_stats()) {
+  // This walks the active pulls, so only include it in full dumps.
+  if (full) {
     for (const auto &entry : active_object_pull_requests_) {
       auto obj_id = entry.first;
       if (!pinned_objects_.contains(obj_id)) {
@@ -18,6 +18,7 @@
 #include <boost/asio/error.hpp>
 #include <boost/bind/bind.hpp>
 #include <map>
+#include <set>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -43,6 +44,16 @@ enum BundlePriority {
   TASK_ARGS,
 };
 
+/// Options of a pull request, which order the bundles of the same priority class.
+struct PullOptions {
+  /// Bundles of a higher priority are activated first, and preempt active bundles of a
+  /// lower priority, e.g. a driver blocked in ray.get() over prefetched task args.
+  int64_t priority = 0;
+  /// How long the caller waits for the bundle, -1 if it waits forever. Among bundles
+  /// of the same priority, the ones whose deadline is closer are activated first.
+  int64_t timeout_ms = -1;
+};
+
 // Not thread-safe except for IsObjectActive().
 class PullManager {
  public:
@@ -54,7 +65,7 @@ class PullManager {
   /// \param object_is_local A callback which should return true if a given object is
   /// already on the local node.
   /// \param send_pull_request A callback which should send a
-  /// pull request to the specified node.
+  /// pull request for the given stripe of the object's chunks to the specified node.
   /// \param cancel_pull_request A callback which should
   /// cancel pulling an object.
   /// \param restore_spilled_object A callback which should
@@ -62,7 +73,8 @@ class PullManager {
   PullManager(
       NodeID &self_node_id,
       const std::function<bool(const ObjectID &)> object_is_local,
-      const std::function<void(const ObjectID &, const NodeID &)> send_pull_request,
+      const std::function<void(const ObjectID &, const NodeID &, const ChunkStripe &)>
+          send_pull_request,
       const std::function<void(const ObjectID &)> cancel_pull_request,
       const std::function<void(const ObjectID &)> fail_pull_request,
       const RestoreSpilledObjectCallback restore_spilled_object,
@@ -84,10 +96,12 @@ class PullManager {
   /// \param objects_to_locate The objects whose new locations the caller
   /// should subscribe to, and call OnLocationChange for.
   /// prioritized over queued task arguments.
+  /// \param options The order of the bundle within its priority class.
   /// \return A request ID that can be used to cancel the request.
   uint64_t Pull(const std::vector<rpc::ObjectReference> &object_ref_bundle,
                 BundlePriority prio,
-                std::vector<rpc::ObjectReference> *objects_to_locate);
+                std::vector<rpc::ObjectReference> *objects_to_locate,
+                const PullOptions &options = PullOptions());
 
   /// Update the pull requests that are currently being pulled, according to
   /// the current capacity. The PullManager will choose the objects to pull by
@@ -143,9 +157,10 @@ class PullManager {
   /// The number of ongoing object pulls.
   int NumActiveRequests() const;
 
-  /// Returns whether the object is actively being pulled. object_required
-  /// returns whether the object is still needed by some pull request on this
-  /// node (but may not be actively pulled due to throttling).
+  /// Returns whether the object is actively being pulled, or restored ahead of
+  /// its bundle. object_required returns whether the object is still needed by
+  /// some pull request on this node (but may not be actively pulled due to
+  /// throttling).
   ///
   /// This method (and this method only) is thread-safe.
   bool IsObjectActive(const ObjectID &object_id) const;
@@ -164,7 +179,9 @@ class PullManager {
   /// Record the internal metrics.
   void RecordMetrics() const;
 
-  std::string DebugString() const;
+  /// \param full Whether to also include the details that take a walk over the
+  /// active pulls.
+  std::string DebugString(bool full = false) const;
 
   /// Returns the number of bytes of quota remaining. When this is less than zero,
   /// we are OverQuota(). Visible for testing.
@@ -188,7 +205,7 @@ class PullManager {
     // the object.
     double expiration_time_seconds = 0;
     int64_t activate_time_ms = 0;
-    int64_t request_start_time_ms = absl::GetCurrentTimeNanos() / 1e3;
+    int64_t request_start_time_ms = absl::GetCurrentTimeNanos() / 1e6;
     uint8_t num_retries;
     bool object_size_set = false;
     size_t object_size = 0;
@@ -198,15 +215,45 @@ class PullManager {
     absl::flat_hash_set<uint64_t> bundle_request_ids;
   };
 
+  /// The position of a bundle in the activation order of its queue.
+  struct BundleOrder {
+    int64_t priority;
+    double deadline_s;
+    /// The bytes needed by the bundle if shorter bundles go first, otherwise 0.
+    size_t num_bytes;
+    uint64_t request_id;
+
+    /// Higher priorities first, then earlier deadlines, then smaller and then older
+    /// bundles.
+    bool operator<(const BundleOrder &other) const {
+      if (priority != other.priority) {
+        return priority > other.priority;
+      }
+      if (deadline_s != other.deadline_s) {
+        return deadline_s < other.deadline_s;
+      }
+      if (num_bytes != other.num_bytes) {
+        return num_bytes < other.num_bytes;
+      }
+      return request_id < other.request_id;
+    }
+  };
+
   struct PullBundleRequest {
-    PullBundleRequest(const std::vector<rpc::ObjectReference> &requested_objects)
-        : objects(requested_objects), num_object_sizes_missing(objects.size()) {}
+    PullBundleRequest(const std::vector<rpc::ObjectReference> &requested_objects,
+                      const BundleOrder &bundle_order)
+        : objects(requested_objects),
+          num_object_sizes_missing(objects.size()),
+          order(bundle_order) {}
     const std::vector<rpc::ObjectReference> objects;
     size_t num_object_sizes_missing;
     // The total number of bytes needed by this pull bundle request. Note that
     // the objects may overlap with another request, so the actual amount of
     // memory needed to activate this request may be less than this amount.
     size_t num_bytes_needed = 0;
+    // The position of this bundle in the activation order, fixed once all of the
+    // object sizes are known.
+    BundleOrder order;
 
     void RegisterObjectSize(size_t object_size) {
       RAY_CHECK(num_object_sizes_missing > 0);
@@ -215,7 +262,12 @@ class PullManager {
     }
   };
 
-  using Queue = std::map<uint64_t, PullBundleRequest>;
+  /// The bundles of a priority class by request ID.
+  struct Queue : public std::map<uint64_t, PullBundleRequest> {
+    /// The bundles whose object sizes are all known, in the order to activate them.
+    /// The active bundles are a prefix of this order.
+    std::set<BundleOrder> ready;
+  };
 
   /// Try to make an object local, by restoring the object from external
   /// storage or by fetching the object from one of its expected client
@@ -230,6 +282,22 @@ class PullManager {
   /// e.g., for get requests and to ensure at least one active request.
   bool OverQuota();
 
+  /// Return the URL to restore the object from on this node, or an empty string if
+  /// it is not spilled to storage that this node can read.
+  std::string GetDirectRestoreURL(const ObjectID &object_id,
+                                  const ObjectPullRequest &request) const;
+
+  /// Restore the locally spilled objects of the queued bundles that are not active
+  /// yet, in the order that the bundles would be activated, into the memory that
+  /// the active pulls leave free. This is bounded by
+  /// pull_manager_restore_prefetch_bytes.
+  void PrefetchSpilledObjects();
+
+  /// Stop counting an object as prefetched, once it is local, active or no
+  /// longer needed.
+  void StopPrefetching(const ObjectID &object_id)
+      EXCLUSIVE_LOCKS_REQUIRED(active_objects_mu_);
+
   /// Pin the object if possible. Only actively pulled objects should be pinned.
   bool TryPinObject(const ObjectID &object_id);
 
@@ -238,7 +306,9 @@ class PullManager {
 
   /// Try to Pull an object from one of its expected client locations. If there
   /// are more client locations to try after this attempt, then this method
-  /// will try each of the other clients in succession.
+  /// will try each of the other clients in succession. A large object with
+  /// several locations is striped over up to object_manager_max_pull_sources of
+  /// them instead.
   ///
   /// \return True if a pull request was sent, otherwise false.
   bool PullFromRandomLocation(const ObjectID &object_id);
@@ -264,6 +334,36 @@ class PullManager {
                                      bool respect_quota,
                                      std::vector<ObjectID> *objects_to_pull);
 
+  /// Activate a pull request, regardless of the quota, and return the objects that
+  /// were not already being pulled.
+  void ActivatePullBundleRequest(uint64_t request_id,
+                                 const PullBundleRequest &request,
+                                 std::vector<ObjectID> *objects_to_pull)
+      EXCLUSIVE_LOCKS_REQUIRED(active_objects_mu_);
+
+  /// Add a pull request whose object sizes just became known to the activation
+  /// order of its queue. If it goes before the last active request, it is activated
+  /// right away, so that the active requests stay a prefix of the order. The less
+  /// urgent requests are then deactivated by UpdatePullsBasedOnAvailableMemory.
+  void MarkPullBundleRequestReady(Queue &bundles,
+                                  const Queue::iterator &request_it,
+                                  uint64_t highest_req_id_being_pulled,
+                                  std::vector<ObjectID> *objects_to_pull);
+
+  /// Whether the request is in the active prefix of its queue.
+  bool IsPullBundleRequestActive(const Queue &bundles,
+                                 const PullBundleRequest &request,
+                                 uint64_t highest_req_id_being_pulled) const;
+
+  /// Return the next request in the activation order, or the end of the queue.
+  Queue::const_iterator NextPullBundleRequest(const Queue &bundles,
+                                              uint64_t highest_req_id_being_pulled) const;
+
+  /// The number of bytes that activating the request would add to the bytes being
+  /// pulled.
+  int64_t BytesToActivate(const PullBundleRequest &request) const
+      EXCLUSIVE_LOCKS_REQUIRED(active_objects_mu_);
+
   /// Deactivate a pull request in the queue. This cancels any pull or restore
   /// operations for the object.
   void DeactivatePullBundleRequest(const Queue &bundles,
@@ -296,7 +396,8 @@ class PullManager {
   /// See the constructor's arguments.
   NodeID self_node_id_;
   const std::function<bool(const ObjectID &)> object_is_local_;
-  const std::function<void(const ObjectID &, const NodeID &)> send_pull_request_;
+  const std::function<void(const ObjectID &, const NodeID &, const ChunkStripe &)>
+      send_pull_request_;
   const std::function<void(const ObjectID &)> cancel_pull_request_;
   const RestoreSpilledObjectCallback restore_spilled_object_;
   const std::function<double()> get_time_seconds_;
@@ -345,9 +446,9 @@ class PullManager {
   /// the object store is full.
   uint64_t last_oom_reported_ms_ = 0;
 
-  /// A pointer to the highest request ID whose objects we are currently
-  /// pulling. We always pull a contiguous prefix of the active pull requests.
-  /// This means that all requests with a lower ID are either already canceled
+  /// A pointer to the last request, in the activation order of its queue, whose
+  /// objects we are currently pulling. We always pull a contiguous prefix of the
+  /// order. This means that all requests before it are either already canceled
   /// or their objects are also being pulled.
   ///
   /// We keep one pointer for each request queue, since we prioritize worker
@@ -371,6 +472,14 @@ class PullManager {
   absl::flat_hash_map<ObjectID, absl::flat_hash_set<uint64_t>>
       active_object_pull_requests_ GUARDED_BY(active_objects_mu_);
 
+  /// The sizes of the objects that are being restored ahead of their bundle by
+  /// PrefetchSpilledObjects. Disjoint from active_object_pull_requests_.
+  absl::flat_hash_map<ObjectID, size_t> objects_being_prefetched_
+      GUARDED_BY(active_objects_mu_);
+
+  /// The total size of the objects being prefetched.
+  int64_t num_bytes_being_prefetched_ GUARDED_BY(active_objects_mu_) = 0;
+
   /// Tracks the objects we have pinned. Keys are subset of active_object_pull_requests_.
   /// We need to pin these objects so that parts of in-progress bundles aren't evicted
   /// due to self-induced memory pressure.
@@ -392,6 +501,8 @@ class PullManager {
   ObjectID max_timeout_object_id_;
   int64_t num_tries_total_ = 0;
   int64_t num_retries_total_ = 0;
+  int64_t num_striped_pulls_total_ = 0;
+  int64_t num_prefetched_restores_total_ = 0;
   int64_t num_succeeded_pins_total_ = 0;
   int64_t num_failed_pins_total_ = 0;
 
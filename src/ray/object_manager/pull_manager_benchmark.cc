@@ -0,0 +1,92 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/object_manager/pull_manager.h"
+
+namespace ray {
+
+namespace {
+
+/// Pull many bundles of task arguments from remote nodes, with room to pull only a
+/// fraction of them at a time, so that every location update goes through admission
+/// control.
+void BM_PullAdmission(benchmark::State &state) {
+  const int64_t num_bundles = state.range(0);
+  const int64_t objects_per_bundle = 4;
+  const int64_t object_size = 1 << 20;
+  NodeID self_node_id = NodeID::FromRandom();
+  std::vector<NodeID> remote_nodes;
+  for (int i = 0; i < 100; i++) {
+    remote_nodes.push_back(NodeID::FromRandom());
+  }
+  std::vector<std::vector<rpc::ObjectReference>> bundles(num_bundles);
+  const auto job_id = JobID::FromInt(1);
+  for (auto &bundle : bundles) {
+    for (int64_t i = 0; i < objects_per_bundle; i++) {
+      rpc::ObjectReference ref;
+      ref.set_object_id(ObjectID::FromIndex(TaskID::FromRandom(job_id), 1).Binary());
+      bundle.push_back(ref);
+    }
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Room for a tenth of the bundles.
+    PullManager pull_manager(
+        self_node_id,
+        [](const ObjectID &) { return false; },
+        [](const ObjectID &, const NodeID &, const ChunkStripe &) {},
+        [](const ObjectID &) {},
+        [](const ObjectID &) {},
+        [](const ObjectID &,
+           int64_t,
+           const std::string &,
+           std::function<void(const ray::Status &)>) {},
+        []() { return 0.0; },
+        /*pull_timeout_ms=*/10000,
+        /*num_bytes_available=*/num_bundles * objects_per_bundle * object_size / 10,
+        [](const ObjectID &) { return nullptr; },
+        [](const ObjectID &) { return ""; });
+    state.ResumeTiming();
+
+    std::vector<uint64_t> request_ids;
+    request_ids.reserve(bundles.size());
+    std::vector<rpc::ObjectReference> objects_to_locate;
+    for (const auto &bundle : bundles) {
+      request_ids.push_back(
+          pull_manager.Pull(bundle, BundlePriority::TASK_ARGS, &objects_to_locate));
+    }
+    for (size_t i = 0; i < objects_to_locate.size(); i++) {
+      pull_manager.OnLocationChange(
+          ObjectID::FromBinary(objects_to_locate[i].object_id()),
+          {remote_nodes[i % remote_nodes.size()]},
+          /*spilled_url=*/"",
+          NodeID::Nil(),
+          /*pending_creation=*/false,
+          object_size);
+    }
+    for (auto request_id : request_ids) {
+      pull_manager.CancelPull(request_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_bundles);
+}
+BENCHMARK(BM_PullAdmission)->Arg(1 << 10)->Arg(1 << 13);
+
+}  // namespace
+
+}  // namespace ray
@@ -20,10 +20,19 @@
 
 namespace ray {
 
+namespace {
+
+/// The window of a destination decreases once the round trip time of its chunks is
+/// this many times the lowest one seen.
+constexpr double kRttInflationThreshold = 2.0;
+
+}  // namespace
+
 void PushManager::StartPush(const NodeID &dest_id,
                             const ObjectID &obj_id,
                             int64_t num_chunks,
-                            std::function<void(int64_t)> send_chunk_fn) {
+                            std::function<void(int64_t)> send_chunk_fn,
+                            int64_t chunk_slots) {
   auto push_id = std::make_pair(dest_id, obj_id);
   if (push_info_.contains(push_id)) {
     RAY_LOG(DEBUG) << "Duplicate push request " << push_id.first << ", "
@@ -31,15 +40,29 @@ void PushManager::StartPush(const NodeID &dest_id,
     return;
   }
   RAY_CHECK(num_chunks > 0);
-  chunks_remaining_ += num_chunks;
-  push_info_[push_id].reset(new PushState(num_chunks, send_chunk_fn));
+  RAY_CHECK(chunk_slots > 0);
+  chunks_remaining_ += num_chunks * chunk_slots;
+  push_info_[push_id].reset(new PushState(num_chunks, send_chunk_fn, chunk_slots));
+  auto inserted = destinations_.emplace(dest_id, DestinationState());
+  if (inserted.second) {
+    inserted.first->second.window = static_cast<double>(initial_window_);
+  }
   ScheduleRemainingPushes();
 }
 
-void PushManager::OnChunkComplete(const NodeID &dest_id, const ObjectID &obj_id) {
+void PushManager::OnChunkComplete(const NodeID &dest_id,
+                                  const ObjectID &obj_id,
+                                  const Status &status,
+                                  double rtt_s) {
   auto push_id = std::make_pair(dest_id, obj_id);
-  chunks_in_flight_ -= 1;
-  chunks_remaining_ -= 1;
+  const int64_t chunk_slots = push_info_[push_id]->chunk_slots;
+  chunks_in_flight_ -= chunk_slots;
+  chunks_remaining_ -= chunk_slots;
+  auto &dest = destinations_[dest_id];
+  dest.chunks_in_flight -= chunk_slots;
+  if (initial_window_ > 0) {
+    UpdateWindow(&dest, chunk_slots, status, rtt_s);
+  }
   if (--push_info_[push_id]->chunks_remaining <= 0) {
     push_info_.erase(push_id);
     RAY_LOG(DEBUG) << "Push for " << push_id.first << ", " << push_id.second
@@ -60,10 +83,12 @@ void PushManager::ScheduleRemainingPushes() {
     while (it != push_info_.end() && chunks_in_flight_ < max_chunks_in_flight_) {
       auto push_id = it->first;
       auto &info = it->second;
-      if (info->next_chunk_id < info->num_chunks) {
+      auto &dest = destinations_[push_id.first];
+      if (info->next_chunk_id < info->num_chunks && CanSendTo(dest, info->chunk_slots)) {
         // Send the next chunk for this push.
         info->chunk_send_fn(info->next_chunk_id++);
-        chunks_in_flight_ += 1;
+        chunks_in_flight_ += info->chunk_slots;
+        dest.chunks_in_flight += info->chunk_slots;
         keep_looping = true;
         RAY_LOG(DEBUG) << "Sending chunk " << info->next_chunk_id << " of "
                        << info->num_chunks << " for push " << push_id.first << ", "
@@ -76,6 +101,54 @@ void PushManager::ScheduleRemainingPushes() {
   }
 }
 
+bool PushManager::CanSendTo(const DestinationState &dest, int64_t chunk_slots) const {
+  if (initial_window_ == 0 || dest.chunks_in_flight == 0) {
+    // A destination can always have a chunk in flight, even if it is larger than the
+    // window.
+    return true;
+  }
+  return static_cast<double>(dest.chunks_in_flight + chunk_slots) <= dest.window;
+}
+
+void PushManager::UpdateWindow(DestinationState *dest,
+                               int64_t chunk_slots,
+                               const Status &status,
+                               double rtt_s) {
+  bool congested = !status.ok();
+  if (rtt_s > 0) {
+    const double rtt_per_slot_s = rtt_s / chunk_slots;
+    if (dest->min_rtt_s == 0 || rtt_per_slot_s < dest->min_rtt_s) {
+      dest->min_rtt_s = rtt_per_slot_s;
+    }
+    congested |= rtt_per_slot_s > kRttInflationThreshold * dest->min_rtt_s;
+  }
+  if (congested && dest->slots_until_decrease <= 0) {
+    dest->window = std::max(1.0, dest->window / 2);
+    dest->slow_start = false;
+    // The chunks in flight were sent before the decrease, so they don't decrease the
+    // window again.
+    dest->slots_until_decrease = static_cast<double>(dest->chunks_in_flight);
+  } else {
+    dest->slots_until_decrease -= chunk_slots;
+    if (!congested) {
+      // Slow start grows the window by the completed chunks, i.e. doubles it every
+      // round trip, afterwards it grows by one chunk every round trip.
+      dest->window += dest->slow_start ? chunk_slots : chunk_slots / dest->window;
+    }
+  }
+  dest->window = std::min(dest->window, static_cast<double>(max_chunks_in_flight_));
+}
+
+int64_t PushManager::NumChunksInFlight(const NodeID &dest_id) const {
+  auto it = destinations_.find(dest_id);
+  return it == destinations_.end() ? 0 : it->second.chunks_in_flight;
+}
+
+double PushManager::GetWindow(const NodeID &dest_id) const {
+  auto it = destinations_.find(dest_id);
+  return it == destinations_.end() ? 0 : it->second.window;
+}
+
 void PushManager::RecordMetrics() const {
   ray::stats::STATS_push_manager_in_flight_pushes.Record(NumPushesInFlight());
   ray::stats::STATS_push_manager_chunks.Record(NumChunksInFlight(), "InFlight");
@@ -89,6 +162,13 @@ std::string PushManager::DebugString() const {
   result << "\n- num chunks in flight: " << NumChunksInFlight();
   result << "\n- num chunks remaining: " << NumChunksRemaining();
   result << "\n- max chunks allowed: " << max_chunks_in_flight_;
+  if (initial_window_ > 0) {
+    for (const auto &entry : destinations_) {
+      result << "\n- destination " << entry.first << ": chunks in flight "
+             << entry.second.chunks_in_flight << ", window " << entry.second.window
+             << ", min rtt per chunk " << entry.second.min_rtt_s << "s";
+    }
+  }
   return result.str();
 }
 
@@ -26,15 +26,29 @@
 namespace ray {
 
 /// Manages rate limiting and deduplication of outbound object pushes.
+///
+/// Chunks are counted in units of the default chunk size, so a chunk that is twice as
+/// large takes two slots of the limits.
+///
+/// Optionally, the chunks in flight to each destination are also limited by a window
+/// of its own, which adapts to the destination like TCP congestion control. The window
+/// grows additively while chunks complete, and halves when a chunk fails or its round
+/// trip time shows that the chunks queue up on the way, i.e. that the throughput to the
+/// destination no longer grows with the window. This keeps a slow destination from
+/// taking the slots of the fast ones.
 class PushManager {
  public:
   /// Create a push manager.
   ///
   /// \param max_chunks_in_flight Max number of chunks allowed to be in flight
   ///                             from this PushManager (this raylet).
-  PushManager(int64_t max_chunks_in_flight)
-      : max_chunks_in_flight_(max_chunks_in_flight) {
+  /// \param initial_window The initial number of chunks allowed to be in flight to
+  ///                       each destination. 0 to only limit the chunks in flight in
+  ///                       total.
+  PushManager(int64_t max_chunks_in_flight, int64_t initial_window = 0)
+      : max_chunks_in_flight_(max_chunks_in_flight), initial_window_(initial_window) {
     RAY_CHECK(max_chunks_in_flight_ > 0) << max_chunks_in_flight_;
+    RAY_CHECK(initial_window_ >= 0) << initial_window_;
   };
 
   /// Start pushing an object subject to max chunks in flight limit.
@@ -47,14 +61,23 @@ class PushManager {
   /// \param send_chunk_fn This function will be called with args 0...{num_chunks-1}.
   ///                      The caller promises to call PushManager::OnChunkComplete()
   ///                      once a call to send_chunk_fn finishes.
+  /// \param chunk_slots The number of slots each chunk takes, i.e. its size in units
+  ///                    of the default chunk size.
   void StartPush(const NodeID &dest_id,
                  const ObjectID &obj_id,
                  int64_t num_chunks,
-                 std::function<void(int64_t)> send_chunk_fn);
+                 std::function<void(int64_t)> send_chunk_fn,
+                 int64_t chunk_slots = 1);
 
   /// Called every time a chunk completes to trigger additional sends.
   /// TODO(ekl) maybe we should cancel the entire push on error.
-  void OnChunkComplete(const NodeID &dest_id, const ObjectID &obj_id);
+  ///
+  /// \param status Whether the chunk was sent successfully.
+  /// \param rtt_s The time it took to send the chunk, in seconds. 0 if unknown.
+  void OnChunkComplete(const NodeID &dest_id,
+                       const ObjectID &obj_id,
+                       const Status &status = Status::OK(),
+                       double rtt_s = 0);
 
   /// Return the number of chunks currently in flight. For testing only.
   int64_t NumChunksInFlight() const { return chunks_in_flight_; };
@@ -65,6 +88,13 @@ class PushManager {
   /// Return the number of pushes currently in flight. For testing only.
   int64_t NumPushesInFlight() const { return push_info_.size(); };
 
+  /// Return the number of chunks currently in flight to a destination. For testing
+  /// only.
+  int64_t NumChunksInFlight(const NodeID &dest_id) const;
+
+  /// Return the window of a destination, or 0 if there is none. For testing only.
+  double GetWindow(const NodeID &dest_id) const;
+
   /// Record the internal metrics.
   void RecordMetrics() const;
 
@@ -77,28 +107,61 @@ class PushManager {
     const int64_t num_chunks;
     /// The function to send chunks with.
     const std::function<void(int64_t)> chunk_send_fn;
+    /// The number of slots each chunk takes.
+    const int64_t chunk_slots;
     /// The index of the next chunk to send.
     int64_t next_chunk_id;
     /// The number of chunks remaining to send. Once this number drops
     /// to zero, the push is considered complete.
     int64_t chunks_remaining;
 
-    PushState(int64_t num_chunks, std::function<void(int64_t)> chunk_send_fn)
+    PushState(int64_t num_chunks,
+              std::function<void(int64_t)> chunk_send_fn,
+              int64_t chunk_slots)
         : num_chunks(num_chunks),
           chunk_send_fn(chunk_send_fn),
+          chunk_slots(chunk_slots),
           next_chunk_id(0),
           chunks_remaining(num_chunks) {}
   };
 
+  /// Tracks the chunks in flight to a destination, and its window.
+  struct DestinationState {
+    /// The number of chunk slots in flight to the destination.
+    int64_t chunks_in_flight = 0;
+    /// The number of chunk slots allowed to be in flight. Unused if there is no
+    /// initial window.
+    double window = 0;
+    /// Whether the window still doubles every round trip, until its first decrease.
+    bool slow_start = true;
+    /// The lowest round trip time per chunk slot seen so far, in seconds.
+    double min_rtt_s = 0;
+    /// The number of chunk slots to complete before the window may decrease again,
+    /// so that it decreases at most once per round trip.
+    double slots_until_decrease = 0;
+  };
+
   /// Called on completion events to trigger additional pushes.
   void ScheduleRemainingPushes();
 
+  /// Whether another chunk of the given number of slots may be sent to a destination.
+  bool CanSendTo(const DestinationState &dest, int64_t chunk_slots) const;
+
+  /// Adapt the window of a destination to a completed chunk.
+  void UpdateWindow(DestinationState *dest,
+                    int64_t chunk_slots,
+                    const Status &status,
+                    double rtt_s);
+
   /// Pair of (destination, object_id).
   typedef std::pair<NodeID, ObjectID> PushID;
 
   /// Max number of chunks in flight allowed.
   const int64_t max_chunks_in_flight_;
 
+  /// The initial window of each destination, or 0 if the destinations have no window.
+  const int64_t initial_window_;
+
   /// Running count of chunks in flight, used to limit progress of in_flight_pushes_.
   int64_t chunks_in_flight_ = 0;
 
@@ -107,6 +170,10 @@ class PushManager {
 
   /// Tracks all pushes with chunk transfers in flight.
   absl::flat_hash_map<PushID, std::unique_ptr<PushState>> push_info_;
+
+  /// The destinations that chunks were sent to. The windows are kept when there are
+  /// no pushes to a destination, so that the next push doesn't start over.
+  absl::flat_hash_map<NodeID, DestinationState> destinations_;
 };
 
 }  // namespace ray
@@ -14,6 +14,12 @@
 
 #include "ray/object_manager/spilled_object_reader.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
 #include <fstream>
 #include <regex>
 
@@ -22,7 +28,28 @@
 namespace ray {
 namespace {
 const size_t UINT64_size = sizeof(uint64_t);
+
+/// Open the spilled file for the reads of its chunks. Return null if it can't be
+/// opened, in which case the reads fall back to opening it each time.
+std::shared_ptr<const int> OpenSpilledFile(const std::string &file_path) {
+#ifdef _WIN32
+  return nullptr;
+#else
+  int fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+#ifdef __linux__
+  // The chunks of an object are mostly pushed in order, so let the kernel read ahead.
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  return std::shared_ptr<const int>(new int(fd), [](const int *fd) {
+    close(*fd);
+    delete fd;
+  });
+#endif
 }
+}  // namespace
 
 /* static */ absl::optional<SpilledObjectReader>
 SpilledObjectReader::CreateSpilledObjectReader(const std::string &object_url) {
@@ -54,6 +81,7 @@ SpilledObjectReader::CreateSpilledObjectReader(const std::string &object_url) {
     return absl::optional<SpilledObjectReader>();
   }
 
+  auto fd = OpenSpilledFile(file_path);
   return absl::optional<SpilledObjectReader>(
       SpilledObjectReader(std::move(file_path),
                           object_size,
@@ -61,7 +89,8 @@ SpilledObjectReader::CreateSpilledObjectReader(const std::string &object_url) {
                           data_size,
                           metadata_offset,
                           metadata_size,
-                          std::move(owner_address)));
+                          std::move(owner_address),
+                          std::move(fd)));
 }
 
 uint64_t SpilledObjectReader::GetDataSize() const { return data_size_; }
@@ -78,14 +107,16 @@ SpilledObjectReader::SpilledObjectReader(std::string file_path,
                                          uint64_t data_size,
                                          uint64_t metadata_offset,
                                          uint64_t metadata_size,
-                                         rpc::Address owner_address)
+                                         rpc::Address owner_address,
+                                         std::shared_ptr<const int> fd)
     : file_path_(std::move(file_path)),
       object_size_(object_size),
       data_offset_(data_offset),
       data_size_(data_size),
       metadata_offset_(metadata_offset),
       metadata_size_(metadata_size),
-      owner_address_(std::move(owner_address)) {}
+      owner_address_(std::move(owner_address)),
+      fd_(std::move(fd)) {}
 
 /* static */ bool SpilledObjectReader::ParseObjectURL(const std::string &object_url,
                                                       std::string &file_path,
@@ -169,14 +200,37 @@ uint64_t SpilledObjectReader::ToUINT64(const std::string &s) {
 bool SpilledObjectReader::ReadFromDataSection(uint64_t offset,
                                               uint64_t size,
                                               char *output) const {
-  std::ifstream is(file_path_, std::ios::binary);
-  return is.seekg(data_offset_ + offset) && is.read(output, size);
+  return ReadFromFile(data_offset_ + offset, size, output);
 }
 
 bool SpilledObjectReader::ReadFromMetadataSection(uint64_t offset,
                                                   uint64_t size,
                                                   char *output) const {
+  return ReadFromFile(metadata_offset_ + offset, size, output);
+}
+
+bool SpilledObjectReader::ReadFromFile(uint64_t offset,
+                                       uint64_t size,
+                                       char *output) const {
+#ifndef _WIN32
+  if (fd_ != nullptr) {
+    // pread doesn't move a shared file position, so chunks can be read concurrently.
+    while (size > 0) {
+      ssize_t n = pread(*fd_, output, size, offset);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      output += n;
+      offset += n;
+      size -= n;
+    }
+    return true;
+  }
+#endif
   std::ifstream is(file_path_, std::ios::binary);
-  return is.seekg(metadata_offset_ + offset) && is.read(output, size);
+  return is.seekg(offset) && is.read(output, size);
 }
 }  // namespace ray
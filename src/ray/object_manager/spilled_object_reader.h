@@ -16,6 +16,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <memory>
 #include <string>
 
 #include "absl/types/optional.h"
@@ -52,7 +53,11 @@ class SpilledObjectReader : public IObjectReader {
                       uint64_t data_size,
                       uint64_t metadata_offset,
                       uint64_t metadata_size,
-                      rpc::Address owner_address);
+                      rpc::Address owner_address,
+                      std::shared_ptr<const int> fd = nullptr);
+
+  /// Read `size` bytes at `offset` of the file.
+  bool ReadFromFile(uint64_t offset, uint64_t size, char *output) const;
 
   /// Parse the object url in the form of {path}?offset={offset}&size={size}.
   /// Return false if parsing failed.
@@ -117,6 +122,10 @@ class SpilledObjectReader : public IObjectReader {
   const uint64_t metadata_offset_;
   const uint64_t metadata_size_;
   const rpc::Address owner_address_;
+  /// The file, opened once and shared by the copies of the reader, so that chunks are
+  /// read with a single pread each instead of opening the file for every chunk. The
+  /// file is closed with the last copy. If null, every read opens the file.
+  std::shared_ptr<const int> fd_;
 };
 
 }  // namespace ray
@@ -0,0 +1,131 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/bulk_chunk_transport.h"
+
+#include <map>
+#include <thread>
+
+#include "absl/synchronization/mutex.h"
+#include "gtest/gtest.h"
+
+namespace ray {
+
+class BulkChunkTransportTest : public ::testing::Test {
+ protected:
+  BulkChunkTransportTest()
+      : work_(io_service_), remote_(NodeID::FromRandom()) {
+    receiver_ = CreateTcpChunkReceiver(
+        io_service_,
+        "127.0.0.1",
+        [this](const rpc::PushRequest &request, const std::string &data) {
+          absl::MutexLock lock(&mutex_);
+          received_[request.chunk_index()] = data;
+        });
+    remote_.ip = "127.0.0.1";
+    remote_.bulk_port = static_cast<uint16_t>(receiver_->Start());
+    sender_ = CreateTcpChunkSender(io_service_, /*num_streams=*/2);
+    thread_ = std::thread([this]() { io_service_.run(); });
+  }
+
+  ~BulkChunkTransportTest() {
+    receiver_->Stop();
+    io_service_.stop();
+    thread_.join();
+  }
+
+  void SendChunk(uint64_t chunk_index,
+                 std::vector<absl::string_view> chunk,
+                 std::shared_ptr<const void> chunk_owner) {
+    rpc::PushRequest request;
+    request.set_object_id(ObjectID::FromRandom().Binary());
+    request.set_chunk_index(chunk_index);
+    sender_->SendChunk(remote_,
+                       request,
+                       std::move(chunk),
+                       std::move(chunk_owner),
+                       [this](const Status &status) {
+                         absl::MutexLock lock(&mutex_);
+                         statuses_.push_back(status);
+                       });
+  }
+
+  /// Wait until the given number of chunks were sent, and return their statuses.
+  std::vector<Status> WaitForSentChunks(size_t num_chunks) {
+    absl::MutexLock lock(&mutex_);
+    auto sent = [this, num_chunks]() {
+      mutex_.AssertHeld();
+      return statuses_.size() >= num_chunks;
+    };
+    mutex_.AwaitWithTimeout(absl::Condition(&sent), absl::Seconds(10));
+    return statuses_;
+  }
+
+  /// Wait until the given number of chunks were received.
+  std::map<uint64_t, std::string> WaitForReceivedChunks(size_t num_chunks) {
+    absl::MutexLock lock(&mutex_);
+    auto received = [this, num_chunks]() {
+      mutex_.AssertHeld();
+      return received_.size() >= num_chunks;
+    };
+    mutex_.AwaitWithTimeout(absl::Condition(&received), absl::Seconds(10));
+    return received_;
+  }
+
+  instrumented_io_context io_service_;
+  boost::asio::io_service::work work_;
+  std::thread thread_;
+  RemoteConnectionInfo remote_;
+  std::unique_ptr<BulkChunkSender> sender_;
+  std::unique_ptr<BulkChunkReceiver> receiver_;
+  absl::Mutex mutex_;
+  std::vector<Status> statuses_ GUARDED_BY(mutex_);
+  std::map<uint64_t, std::string> received_ GUARDED_BY(mutex_);
+};
+
+TEST_F(BulkChunkTransportTest, TestSendChunks) {
+  auto data = std::make_shared<std::string>(1024 * 1024, 'd');
+  auto metadata = std::make_shared<std::string>("metadata");
+  constexpr int kNumChunks = 10;
+  for (int i = 0; i < kNumChunks; i++) {
+    SendChunk(i, {absl::string_view(*data).substr(i), *metadata}, data);
+  }
+  // An empty chunk is sent as well.
+  SendChunk(kNumChunks, {}, nullptr);
+
+  auto received = WaitForReceivedChunks(kNumChunks + 1);
+  ASSERT_EQ(received.size(), kNumChunks + 1);
+  for (int i = 0; i < kNumChunks; i++) {
+    ASSERT_EQ(received[i], data->substr(i) + *metadata);
+  }
+  ASSERT_TRUE(received[kNumChunks].empty());
+
+  for (const auto &status : WaitForSentChunks(kNumChunks + 1)) {
+    ASSERT_TRUE(status.ok()) << status.ToString();
+  }
+  // The chunks are released once they are sent.
+  ASSERT_EQ(data.use_count(), 1);
+}
+
+TEST_F(BulkChunkTransportTest, TestSendToStoppedReceiver) {
+  receiver_->Stop();
+  auto data = std::make_shared<std::string>("data");
+  SendChunk(0, {*data}, data);
+  auto statuses = WaitForSentChunks(1);
+  ASSERT_EQ(statuses.size(), 1);
+  ASSERT_TRUE(statuses[0].IsIOError()) << statuses[0].ToString();
+  ASSERT_EQ(data.use_count(), 1);
+}
+
+}  // namespace ray
@@ -451,6 +451,54 @@ TEST_F(CreateRequestQueueTest, TestTryRequestImmediately) {
   AssertNoLeaks();
 }
 
+TEST(CreateRequestQueueParameterTest, TestFairQueueing) {
+  int64_t current_time_ns = 0;
+  CreateRequestQueue queue(
+      /*oom_grace_period_s=*/1,
+      /*spill_object_callback=*/[&]() { return false; },
+      /*on_global_gc=*/[&]() {},
+      /*get_time=*/[&]() { return current_time_ns; },
+      /*debug_dump_handler*/ nullptr,
+      /*fair_queueing=*/true);
+
+  auto oom_request = [&](bool fallback, PlasmaObject *result, bool *spill_requested) {
+    return PlasmaError::OutOfMemory;
+  };
+  int num_served = 0;
+  auto request = [&](bool fallback, PlasmaObject *result, bool *spill_requested) {
+    num_served++;
+    result->data_size = 1234;
+    return PlasmaError::OK;
+  };
+
+  // The first client's request doesn't fit, and blocks its own later request.
+  auto client1 = std::make_shared<MockClient>();
+  auto req_id1 = queue.AddRequest(ObjectID::Nil(), client1, oom_request, 1234);
+  auto req_id2 = queue.AddRequest(ObjectID::Nil(), client1, request, 1234);
+  // The requests of other clients are served in the meantime.
+  auto client2 = std::make_shared<MockClient>();
+  auto req_id3 = queue.AddRequest(ObjectID::Nil(), client2, request, 1234);
+  auto req_id4 = queue.AddRequest(ObjectID::Nil(), client2, request, 1234);
+  auto client3 = std::make_shared<MockClient>();
+  auto req_id5 = queue.AddRequest(ObjectID::Nil(), client3, request, 1234);
+
+  ASSERT_TRUE(queue.ProcessRequests().IsObjectStoreFull());
+  ASSERT_EQ(num_served, 3);
+  ASSERT_REQUEST_UNFINISHED(queue, req_id1);
+  ASSERT_REQUEST_UNFINISHED(queue, req_id2);
+  ASSERT_REQUEST_FINISHED(queue, req_id3, PlasmaError::OK);
+  ASSERT_REQUEST_FINISHED(queue, req_id4, PlasmaError::OK);
+  ASSERT_REQUEST_FINISHED(queue, req_id5, PlasmaError::OK);
+
+  // The blocked request still fails after the grace period, and unblocks the
+  // rest of the queue.
+  current_time_ns += 2e9;
+  ASSERT_TRUE(queue.ProcessRequests().ok());
+  ASSERT_EQ(num_served, 4);
+  ASSERT_REQUEST_FINISHED(queue, req_id1, PlasmaError::OutOfMemory);
+  ASSERT_REQUEST_FINISHED(queue, req_id2, PlasmaError::OK);
+}
+
 }  // namespace plasma
 
 int main(int argc, char **argv) {
@@ -121,6 +121,30 @@ TEST_F(GetRequestQueueTest, TestObjectSealed) {
   AssertNoLeak(get_request_queue);
 }
 
+TEST_F(GetRequestQueueTest, TestRequestIdIsKept) {
+  std::vector<uint64_t> replied_request_ids;
+  MockObjectLifecycleManager object_lifecycle_manager;
+  GetRequestQueue get_request_queue(
+      io_context_,
+      object_lifecycle_manager,
+      [&](const ObjectID &object_id, const auto &request) {},
+      [&](const std::shared_ptr<GetRequest> &get_req) {
+        replied_request_ids.push_back(get_req->request_id);
+      });
+  auto client = std::make_shared<MockClient>();
+
+  /// Requests are replied to with the ID they were sent with, so that a client can
+  /// have several in flight.
+  std::vector<ObjectID> object_ids{object_id1};
+  MarkObject(object1, ObjectState::PLASMA_SEALED);
+  EXPECT_CALL(object_lifecycle_manager, GetObject(_)).WillRepeatedly(Return(&object1));
+  get_request_queue.AddRequest(client, object_ids, 1000, false, /*request_id=*/2);
+  get_request_queue.AddRequest(client, object_ids, 1000, false);
+  EXPECT_EQ(replied_request_ids, (std::vector<uint64_t>{2, 0}));
+
+  AssertNoLeak(get_request_queue);
+}
+
 TEST_F(GetRequestQueueTest, TestObjectTimeout) {
   std::promise<bool> promise;
   MockObjectLifecycleManager object_lifecycle_manager;
@@ -161,7 +185,7 @@ TEST_F(GetRequestQueueTest, TestObjectNotSealed) {
       .WillRepeatedly(Return(&object1));
   get_request_queue.AddRequest(client, object_ids, /*timeout_ms*/ -1, false);
   MarkObject(object1, ObjectState::PLASMA_SEALED);
-  get_request_queue.MarkObjectSealed(object_id1);
+  get_request_queue.MarkObjectsSealed({object_id1});
   promise.get_future().get();
 
   AssertNoLeak(get_request_queue);
@@ -197,7 +221,7 @@ TEST_F(GetRequestQueueTest, TestMultipleObjects) {
   EXPECT_FALSE(IsGetRequestExist(get_request_queue, object_id1));
   EXPECT_TRUE(IsGetRequestExist(get_request_queue, object_id2));
   MarkObject(object2, ObjectState::PLASMA_SEALED);
-  get_request_queue.MarkObjectSealed(object_id2);
+  get_request_queue.MarkObjectsSealed({object_id2});
   io_context_.run_one();
   promise2.get_future().get();
   promise3.get_future().get();
@@ -291,6 +315,48 @@ TEST_F(GetRequestQueueTest, TestRemoveTwice) {
 
   ASSERT_NO_THROW(RemoveGetRequest(get_request_queue, dangling_get_request));
 }
+
+TEST_F(GetRequestQueueTest, TestObjectsSealedTogether) {
+  std::vector<std::shared_ptr<GetRequest>> completed_requests;
+  MockObjectLifecycleManager object_lifecycle_manager;
+  GetRequestQueue get_request_queue(
+      io_context_,
+      object_lifecycle_manager,
+      [&](const ObjectID &object_id, const auto &request) {},
+      [&](const std::shared_ptr<GetRequest> &get_req) {
+        completed_requests.push_back(get_req);
+      });
+
+  /// Two clients wait for both objects, and another one for one of them.
+  MarkObject(object1, ObjectState::PLASMA_CREATED);
+  MarkObject(object2, ObjectState::PLASMA_CREATED);
+  EXPECT_CALL(object_lifecycle_manager, GetObject(Eq(object_id1)))
+      .WillRepeatedly(Return(&object1));
+  EXPECT_CALL(object_lifecycle_manager, GetObject(Eq(object_id2)))
+      .WillRepeatedly(Return(&object2));
+  get_request_queue.AddRequest(
+      std::make_shared<MockClient>(), {object_id1, object_id2}, -1, false);
+  get_request_queue.AddRequest(
+      std::make_shared<MockClient>(), {object_id2, object_id1}, -1, false);
+  get_request_queue.AddRequest(std::make_shared<MockClient>(), {object_id2}, -1, false);
+  EXPECT_EQ(2, GetRequestCount(get_request_queue, object_id1));
+  EXPECT_EQ(3, GetRequestCount(get_request_queue, object_id2));
+
+  /// Each request is replied to once, with both objects.
+  MarkObject(object1, ObjectState::PLASMA_SEALED);
+  MarkObject(object2, ObjectState::PLASMA_SEALED);
+  get_request_queue.MarkObjectsSealed({object_id1, object_id2});
+  ASSERT_EQ(3u, completed_requests.size());
+  for (const auto &get_request : completed_requests) {
+    EXPECT_EQ(get_request->num_unique_objects_satisfied,
+              get_request->num_unique_objects_to_wait_for);
+    for (const auto &object : get_request->objects) {
+      EXPECT_EQ(10, object.second.data_size);
+    }
+  }
+
+  AssertNoLeak(get_request_queue);
+}
 }  // namespace plasma
 
 int main(int argc, char **argv) {
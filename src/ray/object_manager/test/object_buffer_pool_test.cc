@@ -16,6 +16,7 @@
 // clang-format off
 #include "ray/object_manager/object_buffer_pool.h"
 
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -49,6 +50,8 @@ class MockPlasmaClient : public plasma::PlasmaClientInterface {
 
   MOCK_METHOD1(Seal, ray::Status(const ObjectID &object_id));
 
+  MOCK_METHOD2(SealPrefix, ray::Status(const ObjectID &object_id, int64_t num_bytes));
+
   MOCK_METHOD1(Abort, ray::Status(const ObjectID &object_id));
 
   ray::Status CreateAndSpillIfNeeded(const ObjectID &object_id,
@@ -163,6 +166,108 @@ TEST_F(ObjectBufferPoolTest, TestSizeMismatch) {
   object_buffer_pool_.WriteChunk(obj_id, data_size_2, 0, 0, mock_data_);
 }
 
+TEST_F(ObjectBufferPoolTest, TestChunkSize) {
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+  const uint64_t data_size = 4 * chunk_size_;
+  const uint64_t large_chunk_size = 2 * chunk_size_;
+  ASSERT_EQ(object_buffer_pool_.GetNumChunks(data_size, large_chunk_size), 2);
+
+  ASSERT_TRUE(object_buffer_pool_
+                  .CreateChunk(obj_id, owner_address, data_size, 0, 0, large_chunk_size)
+                  .ok());
+  // Chunks of the default size are rejected while the object is received in larger
+  // chunks.
+  ASSERT_FALSE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, data_size, 0, 1).ok());
+  ASSERT_TRUE(object_buffer_pool_
+                  .CreateChunk(obj_id, owner_address, data_size, 0, 1, large_chunk_size)
+                  .ok());
+
+  const std::string large_chunk(large_chunk_size, 'x');
+  EXPECT_CALL(*mock_plasma_client_, Seal(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  object_buffer_pool_.WriteChunk(obj_id, data_size, 0, 0, large_chunk);
+  object_buffer_pool_.WriteChunk(obj_id, data_size, 0, 1, large_chunk);
+  AssertNoLeaks();
+}
+
+TEST_F(ObjectBufferPoolTest, TestCreateChunkForWrite) {
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+
+  auto chunk0 = object_buffer_pool_.CreateChunkForWrite(
+      obj_id, owner_address, 2 * chunk_size_, 0, 0);
+  ASSERT_TRUE(chunk0.second.ok());
+  ASSERT_EQ(chunk0.first.buffer_length, chunk_size_);
+  ASSERT_FALSE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 0, 0).ok());
+  // A failed write makes the chunk available again.
+  object_buffer_pool_.FinishChunk(obj_id, 0, /*success=*/false);
+  chunk0 = object_buffer_pool_.CreateChunkForWrite(
+      obj_id, owner_address, 2 * chunk_size_, 0, 0);
+  ASSERT_TRUE(chunk0.second.ok());
+  std::memcpy(chunk0.first.data, mock_data_.data(), chunk_size_);
+  object_buffer_pool_.FinishChunk(obj_id, 0, /*success=*/true);
+
+  auto chunk1 = object_buffer_pool_.CreateChunkForWrite(
+      obj_id, owner_address, 2 * chunk_size_, 0, 1);
+  ASSERT_TRUE(chunk1.second.ok());
+  ASSERT_EQ(chunk1.first.data, chunk0.first.data + chunk_size_);
+  EXPECT_CALL(*mock_plasma_client_, Seal(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  object_buffer_pool_.FinishChunk(obj_id, 1, /*success=*/true);
+  AssertNoLeaks();
+}
+
+TEST_F(ObjectBufferPoolTest, TestAbortWhileWriting) {
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+
+  auto chunk = object_buffer_pool_.CreateChunkForWrite(
+      obj_id, owner_address, 2 * chunk_size_, 0, 0);
+  ASSERT_TRUE(chunk.second.ok());
+  // The buffer isn't released while the chunk is being written into it.
+  EXPECT_CALL(*mock_plasma_client_, Abort(obj_id)).Times(0);
+  object_buffer_pool_.AbortCreate(obj_id);
+  ASSERT_FALSE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 0, 1).ok());
+  ::testing::Mock::VerifyAndClearExpectations(mock_plasma_client_.get());
+
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Abort(obj_id));
+  object_buffer_pool_.FinishChunk(obj_id, 0, /*success=*/true);
+  AssertNoLeaks();
+}
+
+TEST_F(ObjectBufferPoolTest, TestStreamingReads) {
+  ObjectBufferPool object_buffer_pool(
+      mock_plasma_client_, chunk_size_, /*streaming_reads_enabled=*/true);
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+  const uint64_t data_size = 2 * chunk_size_ + chunk_size_ / 2;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(
+        object_buffer_pool.CreateChunk(obj_id, owner_address, data_size, 0, i).ok());
+  }
+
+  // The prefix only grows once the chunks before it are sealed.
+  EXPECT_CALL(*mock_plasma_client_, SealPrefix(obj_id, _)).Times(0);
+  object_buffer_pool.WriteChunk(obj_id, data_size, 0, 1, mock_data_);
+  ::testing::Mock::VerifyAndClearExpectations(mock_plasma_client_.get());
+
+  EXPECT_CALL(*mock_plasma_client_, SealPrefix(obj_id, 2 * chunk_size_));
+  object_buffer_pool.WriteChunk(obj_id, data_size, 0, 0, mock_data_);
+  ::testing::Mock::VerifyAndClearExpectations(mock_plasma_client_.get());
+
+  // The last chunk seals the whole object instead.
+  EXPECT_CALL(*mock_plasma_client_, SealPrefix(obj_id, _)).Times(0);
+  EXPECT_CALL(*mock_plasma_client_, Seal(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  object_buffer_pool.WriteChunk(
+      obj_id, data_size, 0, 2, mock_data_.substr(0, chunk_size_ / 2));
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
@@ -179,6 +179,17 @@ class OwnershipBasedObjectDirectoryTest : public ::testing::Test {
         location_info, object_id, location_lookup_failed);
   }
 
+  void HandleMessage(OwnershipBasedObjectDirectory &directory,
+                     const rpc::WorkerObjectLocationsPubMessage &location_info,
+                     const ObjectID &object_id) {
+    directory.ObjectLocationSubscriptionCallback(
+        location_info, object_id, /*location_lookup_failed=*/false);
+  }
+
+  size_t NumListeners(const OwnershipBasedObjectDirectory &directory) {
+    return directory.listeners_.size();
+  }
+
   int64_t max_batch_size = 20;
   instrumented_io_context io_service_;
   gcs::GcsClientOptions options_;
@@ -525,4 +536,56 @@ TEST_F(OwnershipBasedObjectDirectoryTest, TestNotifyOnUpdate) {
   AssertNoLeak();
 }
 
+TEST_F(OwnershipBasedObjectDirectoryTest, TestCachedLocations) {
+  OwnershipBasedObjectDirectory directory(
+      io_service_,
+      gcs_client_mock_,
+      subscriber_.get(),
+      &client_pool,
+      /*max_object_report_batch_size=*/20,
+      [](const ObjectID &, const rpc::ErrorType &) {},
+      /*location_cache_ttl_ms=*/10);
+  ObjectID obj_id = ObjectID::FromRandom();
+  std::vector<size_t> num_locations;
+  auto callback = [&](const ObjectID &object_id,
+                      const std::unordered_set<NodeID> &client_ids,
+                      const std::string &spilled_url,
+                      const NodeID &spilled_node_id,
+                      bool pending_creation,
+                      size_t object_size) { num_locations.push_back(client_ids.size()); };
+  // The object is only subscribed to once.
+  EXPECT_CALL(*subscriber_, Subscribe(_, _, _, _, _, _, _)).WillOnce(Return(true));
+  EXPECT_CALL(*subscriber_, Unsubscribe(_, _, _)).Times(0);
+  EXPECT_CALL(*node_info_accessor_, IsRemoved(_)).WillRepeatedly(Return(false));
+
+  UniqueID callback_id = UniqueID::FromRandom();
+  ASSERT_TRUE(
+      directory.SubscribeObjectLocations(callback_id, obj_id, rpc::Address(), callback)
+          .ok());
+  rpc::WorkerObjectLocationsPubMessage location_info;
+  location_info.add_node_ids(NodeID::FromRandom().Binary());
+  HandleMessage(directory, location_info, obj_id);
+  ASSERT_EQ(num_locations, std::vector<size_t>({1}));
+  ASSERT_TRUE(directory.UnsubscribeObjectLocations(callback_id, obj_id).ok());
+
+  // The locations are still kept up to date, and are available right away when the
+  // object is needed again.
+  location_info.add_node_ids(NodeID::FromRandom().Binary());
+  HandleMessage(directory, location_info, obj_id);
+  callback_id = UniqueID::FromRandom();
+  ASSERT_TRUE(
+      directory.SubscribeObjectLocations(callback_id, obj_id, rpc::Address(), callback)
+          .ok());
+  io_service_.poll();
+  ASSERT_EQ(num_locations, std::vector<size_t>({1, 2}));
+
+  // The subscription is removed once the locations were cached for long enough.
+  ::testing::Mock::VerifyAndClearExpectations(subscriber_.get());
+  EXPECT_CALL(*subscriber_, Unsubscribe(_, _, _)).WillOnce(Return(true));
+  ASSERT_TRUE(directory.UnsubscribeObjectLocations(callback_id, obj_id).ok());
+  ASSERT_EQ(NumListeners(directory), 1);
+  io_service_.run();
+  ASSERT_EQ(NumListeners(directory), 0);
+}
+
 }  // namespace ray
@@ -34,16 +34,20 @@ class PullManagerTestWithCapacity {
         pull_manager_(
             self_node_id_,
             [this](const ObjectID &object_id) { return object_is_local_; },
-            [this](const ObjectID &object_id, const NodeID &node_id) {
+            [this](const ObjectID &object_id,
+                   const NodeID &node_id,
+                   const ChunkStripe &stripe) {
               num_send_pull_request_calls_++;
+              pull_stripes_sent_[node_id] = stripe;
             },
             [this](const ObjectID &object_id) { num_abort_calls_[object_id]++; },
             [this](const ObjectID &object_id) { timed_out_objects_.insert(object_id); },
             [this](const ObjectID &,
                    int64_t size,
-                   const std::string &,
+                   const std::string &url,
                    std::function<void(const ray::Status &)> callback) {
               num_restore_spilled_object_calls_++;
+              restored_urls_.push_back(url);
               restore_object_callback_ = callback;
             },
             [this]() { return fake_time_; },
@@ -58,6 +62,9 @@ class PullManagerTestWithCapacity {
     ASSERT_TRUE(pull_manager_.get_request_bundles_.empty());
     ASSERT_TRUE(pull_manager_.wait_request_bundles_.empty());
     ASSERT_TRUE(pull_manager_.task_argument_bundles_.empty());
+    ASSERT_TRUE(pull_manager_.get_request_bundles_.ready.empty());
+    ASSERT_TRUE(pull_manager_.wait_request_bundles_.ready.empty());
+    ASSERT_TRUE(pull_manager_.task_argument_bundles_.ready.empty());
     ASSERT_EQ(pull_manager_.num_active_bundles_, 0);
     ASSERT_EQ(pull_manager_.highest_get_req_id_being_pulled_, 0);
     ASSERT_EQ(pull_manager_.highest_wait_req_id_being_pulled_, 0);
@@ -67,6 +74,8 @@ class PullManagerTestWithCapacity {
     ASSERT_TRUE(pull_manager_.active_object_pull_requests_.empty());
     ASSERT_TRUE(pull_manager_.pinned_objects_.empty());
     ASSERT_EQ(pull_manager_.pinned_objects_size_, 0);
+    ASSERT_TRUE(pull_manager_.objects_being_prefetched_.empty());
+    ASSERT_EQ(pull_manager_.num_bytes_being_prefetched_, 0);
     // Most tests should not timeout any pull requests.
     ASSERT_TRUE(timed_out_objects_.empty());
   }
@@ -90,10 +99,12 @@ class PullManagerTestWithCapacity {
   bool allow_pin_ = false;
   int num_send_pull_request_calls_;
   int num_restore_spilled_object_calls_;
+  std::vector<std::string> restored_urls_;
   std::function<void(const ray::Status &)> restore_object_callback_;
   double fake_time_;
   PullManager pull_manager_;
   absl::flat_hash_map<ObjectID, int> num_abort_calls_;
+  absl::flat_hash_map<NodeID, ChunkStripe> pull_stripes_sent_;
   absl::flat_hash_map<ObjectID, std::string> spilled_url_;
   std::unordered_set<ObjectID> timed_out_objects_;
 };
@@ -437,6 +448,64 @@ TEST_P(PullManagerTest, TestLoadBalancingRestorationRequest) {
   ASSERT_TRUE(num_abort_calls_.empty());
 }
 
+TEST_P(PullManagerTest, TestStripedPull) {
+  /// Test that a large object with several copies is pulled in stripes from several
+  /// of them, and a small object from a single copy.
+  RayConfig::instance().initialize(R"(
+      {"object_manager_max_pull_sources": 2,
+       "object_manager_striped_pull_min_bytes": 100})");
+  auto prio = BundlePriority::TASK_ARGS;
+  if (GetParam()) {
+    prio = BundlePriority::GET_REQUEST;
+  }
+  std::unordered_set<NodeID> client_ids;
+  for (int i = 0; i < 3; i++) {
+    client_ids.insert(NodeID::FromRandom());
+  }
+
+  auto refs = CreateObjectRefs(1);
+  auto oids = ObjectRefsToIds(refs);
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  auto req_id = pull_manager_.Pull(refs, prio, &objects_to_locate);
+  pull_manager_.OnLocationChange(oids[0], client_ids, "", NodeID::Nil(), false, 100);
+  ASSERT_EQ(num_send_pull_request_calls_, 2);
+  ASSERT_EQ(pull_stripes_sent_.size(), 2);
+  std::set<uint32_t> stripe_indices;
+  for (const auto &entry : pull_stripes_sent_) {
+    ASSERT_TRUE(client_ids.count(entry.first));
+    ASSERT_EQ(entry.second.count, 2);
+    stripe_indices.insert(entry.second.index);
+  }
+  ASSERT_EQ(stripe_indices, (std::set<uint32_t>{0, 1}));
+  RAY_UNUSED(pull_manager_.CancelPull(req_id));
+
+  num_send_pull_request_calls_ = 0;
+  pull_stripes_sent_.clear();
+  refs = CreateObjectRefs(1);
+  oids = ObjectRefsToIds(refs);
+  req_id = pull_manager_.Pull(refs, prio, &objects_to_locate);
+  pull_manager_.OnLocationChange(oids[0], client_ids, "", NodeID::Nil(), false, 99);
+  ASSERT_EQ(num_send_pull_request_calls_, 1);
+  ASSERT_EQ(pull_stripes_sent_.begin()->second.count, 1);
+  RAY_UNUSED(pull_manager_.CancelPull(req_id));
+
+  AssertNoLeaks();
+  RayConfig::instance().initialize("");
+}
+
+TEST(ChunkStripeTest, TestChunkIndices) {
+  ChunkStripe stripe;
+  ASSERT_EQ(stripe.NumChunks(5), 5);
+  ASSERT_EQ(stripe.ChunkIndex(4), 4);
+  stripe.count = 3;
+  stripe.index = 2;
+  // Chunks 2 and 5 of 0..6.
+  ASSERT_EQ(stripe.NumChunks(7), 2);
+  ASSERT_EQ(stripe.ChunkIndex(0), 2);
+  ASSERT_EQ(stripe.ChunkIndex(1), 5);
+  ASSERT_EQ(stripe.NumChunks(2), 0);
+}
+
 TEST_P(PullManagerTest, TestManyUpdates) {
   auto prio = BundlePriority::TASK_ARGS;
   if (GetParam()) {
@@ -824,6 +893,48 @@ TEST_P(PullManagerWithAdmissionControlTest, TestBasic) {
   AssertNoLeaks();
 }
 
+TEST_P(PullManagerWithAdmissionControlTest, TestKnownObjectSizes) {
+  auto prio = BundlePriority::TASK_ARGS;
+  if (GetParam()) {
+    prio = BundlePriority::GET_REQUEST;
+  }
+  /// Objects whose size the submitter attached to the reference are admitted before
+  /// their first location update.
+  auto refs = CreateObjectRefs(2);
+  auto oids = ObjectRefsToIds(refs);
+  size_t object_size = 2;
+  refs[0].set_object_size(object_size);
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  auto req_id = pull_manager_.Pull(refs, prio, &objects_to_locate);
+  ASSERT_EQ(ObjectRefsToIds(objects_to_locate), oids);
+  AssertNumActiveBundlesEquals(0);
+
+  // The size in the location update of an object whose size is known is ignored.
+  std::unordered_set<NodeID> client_ids;
+  client_ids.insert(NodeID::FromRandom());
+  pull_manager_.OnLocationChange(
+      oids[0], client_ids, "", NodeID::Nil(), false, 2 * object_size);
+  AssertNumActiveBundlesEquals(0);
+  pull_manager_.OnLocationChange(
+      oids[1], client_ids, "", NodeID::Nil(), false, object_size);
+  AssertNumActiveBundlesEquals(1);
+  AssertNumActiveRequestsEquals(2);
+  pull_manager_.CancelPull(req_id);
+
+  // A bundle whose sizes are all known is admitted right away.
+  refs = CreateObjectRefs(2);
+  for (auto &ref : refs) {
+    ref.set_object_size(object_size);
+  }
+  objects_to_locate.clear();
+  req_id = pull_manager_.Pull(refs, prio, &objects_to_locate);
+  AssertNumActiveBundlesEquals(1);
+  AssertNumActiveRequestsEquals(2);
+  ASSERT_FALSE(pull_manager_.HasPullsQueued());
+  pull_manager_.CancelPull(req_id);
+  AssertNoLeaks();
+}
+
 TEST_P(PullManagerWithAdmissionControlTest, TestQueue) {
   auto prio = BundlePriority::TASK_ARGS;
   if (GetParam()) {
@@ -1099,6 +1210,170 @@ TEST_F(PullManagerWithAdmissionControlTest, TestPrioritizeWorkerRequests) {
   AssertNoLeaks();
 }
 
+TEST_F(PullManagerWithAdmissionControlTest, TestPriorityPreemptsTaskArgs) {
+  /// Test that a bundle of a higher priority preempts the active bundles of a lower
+  /// priority in the same queue.
+  int object_size = 4;
+  std::unordered_set<NodeID> client_ids;
+  client_ids.insert(NodeID::FromRandom());
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  std::vector<uint64_t> req_ids;
+  std::vector<ObjectID> oids;
+  for (int64_t priority : {0, 0, 1}) {
+    auto refs = CreateObjectRefs(1);
+    PullOptions options;
+    options.priority = priority;
+    req_ids.push_back(pull_manager_.Pull(
+        refs, BundlePriority::TASK_ARGS, &objects_to_locate, options));
+    oids.push_back(ObjectRefsToIds(refs)[0]);
+    pull_manager_.OnLocationChange(
+        oids.back(), client_ids, "", NodeID::Nil(), false, object_size);
+  }
+
+  // Only two bundles fit, the high priority one and the oldest low priority one.
+  AssertNumActiveBundlesEquals(2);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[0]));
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[1]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[2]));
+  ASSERT_FALSE(pull_manager_.PullRequestActiveOrWaitingForMetadata(req_ids[1]));
+  ASSERT_EQ(num_abort_calls_[oids[1]], 1);
+
+  // The preempted bundle is activated again once the high priority one is done.
+  pull_manager_.CancelPull(req_ids[2]);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[0]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[1]));
+
+  pull_manager_.CancelPull(req_ids[0]);
+  pull_manager_.CancelPull(req_ids[1]);
+  AssertNoLeaks();
+}
+
+TEST_F(PullManagerWithAdmissionControlTest, TestDeadlineOrder) {
+  /// Test that bundles of the same priority are activated by their deadline, and
+  /// that bundles without a deadline go last.
+  int object_size = 6;
+  std::unordered_set<NodeID> client_ids;
+  client_ids.insert(NodeID::FromRandom());
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  std::vector<uint64_t> req_ids;
+  std::vector<ObjectID> oids;
+  auto pull = [&](int64_t timeout_ms) {
+    auto refs = CreateObjectRefs(1);
+    PullOptions options;
+    options.timeout_ms = timeout_ms;
+    req_ids.push_back(pull_manager_.Pull(
+        refs, BundlePriority::WAIT_REQUEST, &objects_to_locate, options));
+    oids.push_back(ObjectRefsToIds(refs)[0]);
+    pull_manager_.OnLocationChange(
+        oids.back(), client_ids, "", NodeID::Nil(), false, object_size);
+  };
+
+  pull(/*timeout_ms=*/-1);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[0]));
+  // A bundle with a deadline preempts the one without.
+  pull(/*timeout_ms=*/1000);
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[0]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[1]));
+  // The deadline is absolute, so a later request with a smaller timeout can still
+  // have a later deadline.
+  fake_time_ += 10;
+  pull(/*timeout_ms=*/500);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[1]));
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[2]));
+  AssertNumActiveBundlesEquals(1);
+
+  pull_manager_.CancelPull(req_ids[1]);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[2]));
+  pull_manager_.CancelPull(req_ids[2]);
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[0]));
+  pull_manager_.CancelPull(req_ids[0]);
+  AssertNoLeaks();
+}
+
+TEST_F(PullManagerWithAdmissionControlTest, TestShortestBundleFirst) {
+  /// Test that smaller bundles of the same priority are activated first, if enabled.
+  RayConfig::instance().initialize(R"({"pull_manager_shortest_bundle_first": true})");
+  std::unordered_set<NodeID> client_ids;
+  client_ids.insert(NodeID::FromRandom());
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  std::vector<uint64_t> req_ids;
+  std::vector<ObjectID> oids;
+  for (int i = 0; i < 3; i++) {
+    auto refs = CreateObjectRefs(1);
+    req_ids.push_back(
+        pull_manager_.Pull(refs, BundlePriority::TASK_ARGS, &objects_to_locate));
+    oids.push_back(ObjectRefsToIds(refs)[0]);
+  }
+  int i = 0;
+  for (int object_size : {8, 2, 4}) {
+    pull_manager_.OnLocationChange(
+        oids[i++], client_ids, "", NodeID::Nil(), false, object_size);
+  }
+
+  // The two smaller bundles fit, even though the larger one was queued first.
+  AssertNumActiveBundlesEquals(2);
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[0]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[1]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[2]));
+
+  for (auto req_id : req_ids) {
+    pull_manager_.CancelPull(req_id);
+  }
+  AssertNoLeaks();
+  RayConfig::instance().initialize("");
+}
+
+TEST_F(PullManagerWithAdmissionControlTest, TestPrefetchSpilledObjects) {
+  /// Test that the spilled objects of a queued bundle are restored in the memory that
+  /// the active bundles leave free, in the order of their offsets.
+  RayConfig::instance().initialize(R"({"pull_manager_restore_prefetch_bytes": 100})");
+  std::unordered_set<NodeID> client_ids;
+  client_ids.insert(NodeID::FromRandom());
+  std::vector<rpc::ObjectReference> objects_to_locate;
+  auto active_refs = CreateObjectRefs(1);
+  auto active_req_id =
+      pull_manager_.Pull(active_refs, BundlePriority::TASK_ARGS, &objects_to_locate);
+  auto queued_refs = CreateObjectRefs(3);
+  auto queued_req_id =
+      pull_manager_.Pull(queued_refs, BundlePriority::TASK_ARGS, &objects_to_locate);
+  auto oids = ObjectRefsToIds(queued_refs);
+
+  pull_manager_.OnLocationChange(
+      ObjectRefsToIds(active_refs)[0], client_ids, "", NodeID::Nil(), false, 8);
+  int i = 0;
+  for (const std::string &offset : {"200", "100", "0"}) {
+    ObjectSpilled(oids[i], "file?offset=" + offset + "&size=1");
+    pull_manager_.OnLocationChange(oids[i++], {}, "", NodeID::Nil(), false, 1);
+  }
+
+  // The queued bundle doesn't fit, but two of its objects do. They are restored in
+  // the order of their offsets.
+  AssertNumActiveBundlesEquals(1);
+  ASSERT_THAT(restored_urls_,
+              ElementsAre("file?offset=100&size=1", "file?offset=200&size=1"));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[0]));
+  ASSERT_TRUE(pull_manager_.IsObjectActive(oids[1]));
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[2]));
+
+  // A restored object is no longer prefetched.
+  pull_manager_.PinNewObjectIfNeeded(oids[1]);
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[1]));
+
+  // A failed restore is no longer prefetched either.
+  restore_object_callback_(Status::IOError("test"));
+  ASSERT_FALSE(pull_manager_.IsObjectActive(oids[0]));
+
+  // Once the queued bundle is activated, all of its objects are pulled.
+  pull_manager_.CancelPull(active_req_id);
+  AssertNumActiveBundlesEquals(1);
+  for (const auto &oid : oids) {
+    ASSERT_TRUE(pull_manager_.IsObjectActive(oid));
+  }
+  pull_manager_.CancelPull(queued_req_id);
+  AssertNoLeaks();
+  RayConfig::instance().initialize("");
+}
+
 TEST_P(PullManagerTest, TestTimeOut) {
   auto prio = BundlePriority::TASK_ARGS;
   if (GetParam()) {
@@ -120,6 +120,84 @@ TEST(TestPushManager, TestMultipleTransfers) {
   }
 }
 
+TEST(TestPushManager, TestChunkSlots) {
+  auto node_id = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  int num_active = 0;
+  PushManager pm(5);
+  // Each chunk takes two slots, so only three of them fit.
+  pm.StartPush(
+      node_id, obj_id, 4, [&](int64_t chunk_id) { num_active++; }, /*chunk_slots=*/2);
+  ASSERT_EQ(num_active, 3);
+  ASSERT_EQ(pm.NumChunksInFlight(), 6);
+  ASSERT_EQ(pm.NumChunksRemaining(), 8);
+  pm.OnChunkComplete(node_id, obj_id);
+  ASSERT_EQ(num_active, 4);
+  for (int i = 0; i < 3; i++) {
+    pm.OnChunkComplete(node_id, obj_id);
+  }
+  ASSERT_EQ(pm.NumChunksInFlight(), 0);
+  ASSERT_EQ(pm.NumChunksRemaining(), 0);
+  ASSERT_EQ(pm.NumPushesInFlight(), 0);
+}
+
+TEST(TestPushManager, TestWindowGrowsAndShrinks) {
+  auto node_id = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  PushManager pm(100, /*initial_window=*/2);
+  pm.StartPush(node_id, obj_id, 1000, [&](int64_t) {});
+  ASSERT_EQ(pm.NumChunksInFlight(node_id), 2);
+  auto complete_round_trip = [&](double rtt_s) {
+    int64_t in_flight = pm.NumChunksInFlight(node_id);
+    for (int64_t i = 0; i < in_flight; i++) {
+      pm.OnChunkComplete(node_id, obj_id, Status::OK(), rtt_s);
+    }
+  };
+
+  // Slow start doubles the window every round trip.
+  complete_round_trip(/*rtt_s=*/1);
+  ASSERT_EQ(pm.GetWindow(node_id), 4);
+  complete_round_trip(/*rtt_s=*/1);
+  ASSERT_EQ(pm.GetWindow(node_id), 8);
+  ASSERT_EQ(pm.NumChunksInFlight(node_id), 8);
+
+  // The chunks queue up, so the window halves, once per round trip.
+  complete_round_trip(/*rtt_s=*/3);
+  ASSERT_EQ(pm.GetWindow(node_id), 4);
+  ASSERT_EQ(pm.NumChunksInFlight(node_id), 4);
+
+  // Afterwards it grows by about one chunk every round trip.
+  complete_round_trip(/*rtt_s=*/1);
+  ASSERT_NEAR(pm.GetWindow(node_id), 5, 0.1);
+
+  // A failed chunk halves the window as well.
+  pm.OnChunkComplete(node_id, obj_id, Status::IOError("failed"), /*rtt_s=*/0);
+  ASSERT_NEAR(pm.GetWindow(node_id), 2.5, 0.1);
+}
+
+TEST(TestPushManager, TestSlowDestinationDoesNotStarveOthers) {
+  auto slow_node = NodeID::FromRandom();
+  auto fast_node = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  PushManager pm(8, /*initial_window=*/4);
+  pm.StartPush(slow_node, obj_id, 1000, [&](int64_t) {});
+  pm.StartPush(fast_node, obj_id, 1000, [&](int64_t) {});
+  ASSERT_EQ(pm.NumChunksInFlight(slow_node), 4);
+  ASSERT_EQ(pm.NumChunksInFlight(fast_node), 4);
+
+  // The chunks to the slow node take longer and longer, and fail.
+  pm.OnChunkComplete(slow_node, obj_id, Status::OK(), /*rtt_s=*/1);
+  pm.OnChunkComplete(slow_node, obj_id, Status::IOError("timed out"), /*rtt_s=*/10);
+  ASSERT_EQ(pm.GetWindow(slow_node), 2.5);
+  // The slots it gave up go to the fast node.
+  for (int i = 0; i < 100; i++) {
+    pm.OnChunkComplete(fast_node, obj_id, Status::OK(), /*rtt_s=*/1);
+  }
+  ASSERT_EQ(pm.NumChunksInFlight(), 8);
+  ASSERT_EQ(pm.NumChunksInFlight(slow_node), 3);
+  ASSERT_EQ(pm.NumChunksInFlight(fast_node), 5);
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
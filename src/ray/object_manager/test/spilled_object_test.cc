@@ -292,6 +292,20 @@ TEST(SpilledObjectReaderTest, CreateSpilledObjectReader) {
   ASSERT_FALSE(SpilledObjectReader::CreateSpilledObjectReader(object_url1).has_value());
 }
 
+TEST(SpilledObjectReaderTest, CopiesShareFile) {
+  std::string data("data");
+  auto object_url = CreateSpilledObjectReaderOnTmp(
+      10 /* object_offset */, data, "metadata", ray::rpc::Address());
+  auto optional_object = SpilledObjectReader::CreateSpilledObjectReader(object_url);
+  ASSERT_TRUE(optional_object.has_value());
+  auto copy = std::make_unique<SpilledObjectReader>(optional_object.value());
+  optional_object.reset();
+  // The copy still reads from the file after the original reader is gone.
+  std::string result(data.size(), '\0');
+  ASSERT_TRUE(copy->ReadFromDataSection(0, data.size(), &result[0]));
+  ASSERT_EQ(data, result);
+}
+
 template <class T>
 std::shared_ptr<T> CreateObjectReader(std::string &data,
                                       std::string &metadata,
@@ -411,6 +425,49 @@ TYPED_TEST(ObjectReaderTest, GetChunk) {
   }
 }
 
+TYPED_TEST(ObjectReaderTest, GetSharedChunk) {
+  std::string data("alotofdata");
+  std::string metadata("meta");
+  rpc::Address owner_address;
+  ChunkObjectReader reader(
+      TestFixture::CreateObjectReader_(data, metadata, owner_address), 3);
+  auto chunk = reader.GetSharedChunk(1);
+  ASSERT_NE(chunk, nullptr);
+  ASSERT_EQ(*chunk, "tof");
+  // The chunk is shared while it's alive.
+  ASSERT_EQ(reader.GetSharedChunk(1), chunk);
+  ASSERT_NE(reader.GetSharedChunk(2), chunk);
+  std::weak_ptr<const std::string> weak_chunk = chunk;
+  chunk.reset();
+  ASSERT_TRUE(weak_chunk.expired());
+  ASSERT_EQ(*reader.GetSharedChunk(1), "tof");
+  ASSERT_EQ(*reader.GetSharedChunk(4), "ta");
+}
+
+TYPED_TEST(ObjectReaderTest, GetChunkInMemory) {
+  std::string data("alotofdata");
+  std::string metadata("meta");
+  rpc::Address owner_address;
+  // Only objects in plasma can be sent straight from memory.
+  const bool expect_in_memory = std::is_same<TypeParam, MemoryObjectReader>::value;
+  for (uint64_t chunk_size : {1, 3, 5, 100}) {
+    auto reader = ChunkObjectReader(
+        TestFixture::CreateObjectReader_(data, metadata, owner_address), chunk_size);
+
+    std::string actual_output_by_chunks;
+    for (uint64_t i = 0; i < reader.GetNumChunks(); i++) {
+      std::vector<absl::string_view> chunk;
+      ASSERT_EQ(expect_in_memory, reader.GetChunkInMemory(i, &chunk));
+      for (const auto &part : chunk) {
+        actual_output_by_chunks.append(part.data(), part.size());
+      }
+    }
+    if (expect_in_memory) {
+      ASSERT_EQ(data + metadata, actual_output_by_chunks);
+    }
+  }
+}
+
 TEST(StringAllocationTest, TestNoCopyWhenStringMoved) {
   // Since protobuf always allocate string on heap,
   // move assign a string field doesn't copy the data.
@@ -262,7 +262,36 @@ void SubscriberState::ConnectToSubscriber(const rpc::PubsubLongPollingRequest &r
 
 void SubscriberState::QueueMessage(const std::shared_ptr<rpc::PubMessage> &pub_message,
                                    bool try_publish) {
-  mailbox_.push(pub_message);
+  if (MailboxEmpty()) {
+    first_queued_time_ms_ = get_time_ms_();
+  }
+  if (IsMergeable(*pub_message)) {
+    auto it = latest_messages_.find(pub_message->key_id());
+    if (it == latest_messages_.end()) {
+      latest_messages_.emplace(pub_message->key_id(), pub_message);
+    } else {
+      // The queued message is shared with the other subscribers, so merge into a copy.
+      auto merged = std::make_shared<rpc::PubMessage>(*it->second);
+      auto *actor = merged->mutable_actor_message();
+      const auto &update = pub_message->actor_message();
+      actor->MergeFrom(update);
+      // These fields may be cleared by the update, which MergeFrom doesn't do.
+      actor->mutable_address()->CopyFrom(update.address());
+      actor->mutable_death_cause()->CopyFrom(update.death_cause());
+      actor->set_pid(update.pid());
+      it->second = merged;
+      mailbox_.push(std::move(merged));
+      if (try_publish) {
+        PublishIfPossible();
+      }
+      return;
+    }
+  }
+  if (IsLowPriority(*pub_message)) {
+    low_priority_mailbox_.push(pub_message);
+  } else {
+    mailbox_.push(pub_message);
+  }
   if (try_publish) {
     PublishIfPossible();
   }
@@ -272,21 +301,78 @@ bool SubscriberState::PublishIfPossible(bool force_noop) {
   if (!long_polling_connection_) {
     return false;
   }
-  if (!force_noop && mailbox_.empty()) {
+  if (!force_noop && MailboxEmpty()) {
+    return false;
+  }
+  const auto linger_ms = RayConfig::instance().publish_linger_ms();
+  if (!force_noop && linger_ms > 0 &&
+      mailbox_.size() + low_priority_mailbox_.size() <
+          static_cast<size_t>(publish_batch_size_) &&
+      get_time_ms_() - first_queued_time_ms_ < linger_ms) {
+    // Wait for more messages to fill the batch.
     return false;
   }
 
   // No message should have been added to the reply.
   RAY_CHECK(long_polling_connection_->reply->pub_messages().empty());
   if (!force_noop) {
-    for (int i = 0; i < publish_batch_size_ && !mailbox_.empty(); ++i) {
-      const rpc::PubMessage &msg = *mailbox_.front();
+    auto *reply = long_polling_connection_->reply;
+    // The last message added to the reply, if consecutive messages from its channel can
+    // be coalesced into it.
+    rpc::PubMessage *coalescing_msg = nullptr;
+    const auto max_bytes = RayConfig::instance().publish_batch_max_bytes();
+    int64_t reply_bytes = 0;
+    for (int i = 0; i < publish_batch_size_ && !MailboxEmpty(); ++i) {
+      // The low priority messages only fill the room left in the reply.
+      auto &mailbox = mailbox_.empty() ? low_priority_mailbox_ : mailbox_;
+      const rpc::PubMessage &msg = *mailbox.front();
       // Avoid sending empty message to the subscriber. The message might have been
       // cleared because the subscribed entity's buffer was full.
-      if (msg.inner_message_case() != rpc::PubMessage::INNER_MESSAGE_NOT_SET) {
-        *long_polling_connection_->reply->add_pub_messages() = msg;
+      if (msg.inner_message_case() == rpc::PubMessage::INNER_MESSAGE_NOT_SET) {
+        mailbox.pop();
+        continue;
       }
-      mailbox_.pop();
+      if (IsMergeable(msg)) {
+        auto it = latest_messages_.find(msg.key_id());
+        if (it != latest_messages_.end() && it->second != mailbox.front()) {
+          // A later message of the key includes this one.
+          mailbox.pop();
+          continue;
+        }
+      }
+      if (max_bytes > 0) {
+        const int64_t msg_bytes = msg.ByteSizeLong();
+        if (reply_bytes > 0 && reply_bytes + msg_bytes > max_bytes) {
+          break;
+        }
+        reply_bytes += msg_bytes;
+      }
+      if (IsMergeable(msg)) {
+        latest_messages_.erase(msg.key_id());
+      }
+      if (!IsCoalescable(msg)) {
+        *reply->add_pub_messages() = msg;
+        coalescing_msg = nullptr;
+      } else if (coalescing_msg == nullptr ||
+                 coalescing_msg->channel_type() != msg.channel_type()) {
+        coalescing_msg = reply->add_pub_messages();
+        *coalescing_msg = msg;
+      } else {
+        // Only coalesce consecutive messages, so that the subscriber still handles the
+        // messages in the order they were published.
+        if (!coalescing_msg->has_batch_message()) {
+          rpc::PubMessage first_msg;
+          first_msg.Swap(coalescing_msg);
+          coalescing_msg->set_channel_type(first_msg.channel_type());
+          coalescing_msg->mutable_batch_message()->add_pub_messages()->Swap(&first_msg);
+        }
+        *coalescing_msg->mutable_batch_message()->add_pub_messages() = msg;
+      }
+      mailbox.pop();
+    }
+    if (!MailboxEmpty()) {
+      // The rest of the mailbox has waited for this reply, so don't linger on it.
+      first_queued_time_ms_ = 0;
     }
   }
   long_polling_connection_->send_reply_callback(Status::OK(), nullptr, nullptr);
@@ -297,9 +383,35 @@ bool SubscriberState::PublishIfPossible(bool force_noop) {
   return true;
 }
 
+bool SubscriberState::IsCoalescable(const rpc::PubMessage &pub_message) {
+  // A borrower publishes a ref removed message per object, so a worker that drops a
+  // large number of borrowed refs at once floods the owner with small messages.
+  return pub_message.has_worker_ref_removed_message();
+}
+
+bool SubscriberState::IsMergeable(const rpc::PubMessage &pub_message) {
+  // Restarting an actor publishes several intermediate states, which a subscriber that
+  // hasn't polled yet doesn't need.
+  return pub_message.has_actor_message() &&
+         RayConfig::instance().publisher_merge_actor_messages();
+}
+
+bool SubscriberState::IsLowPriority(const rpc::PubMessage &pub_message) {
+  if (!RayConfig::instance().publisher_prioritize_channels()) {
+    return false;
+  }
+  switch (pub_message.channel_type()) {
+  case rpc::ChannelType::RAY_ERROR_INFO_CHANNEL:
+  case rpc::ChannelType::RAY_LOG_CHANNEL:
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool SubscriberState::CheckNoLeaks() const {
   // If all message in the mailbox has been replied, consider there is no leak.
-  return !long_polling_connection_ && mailbox_.empty();
+  return !long_polling_connection_ && MailboxEmpty() && latest_messages_.empty();
 }
 
 bool SubscriberState::ConnectionExists() const {
@@ -449,6 +561,13 @@ void Publisher::CheckDeadSubscribers() {
   }
 }
 
+void Publisher::PublishLingeringMessages() {
+  absl::MutexLock lock(&mutex_);
+  for (const auto &[_, subscriber] : subscribers_) {
+    subscriber->PublishIfPossible();
+  }
+}
+
 bool Publisher::CheckNoLeaks() const {
   absl::MutexLock lock(&mutex_);
   for (const auto &subscriber : subscribers_) {
@@ -26,6 +26,7 @@
 #include "absl/synchronization/mutex.h"
 #include "ray/common/asio/periodical_runner.h"
 #include "ray/common/id.h"
+#include "ray/common/ray_config.h"
 #include "ray/rpc/server_call.h"
 #include "src/ray/protobuf/common.pb.h"
 #include "src/ray/protobuf/pubsub.pb.h"
@@ -198,7 +199,12 @@ class SubscriberState {
   void QueueMessage(const std::shared_ptr<rpc::PubMessage> &pub_message,
                     bool try_publish = true);
 
-  /// Publish all queued messages if possible.
+  /// Publish all queued messages if possible. Up to `publish_batch_size` queued
+  /// messages, and up to `publish_batch_max_bytes`, are sent per reply, and consecutive
+  /// messages that can be coalesced are sent as a single message with `batch_message`
+  /// set. A batch that isn't full isn't sent until it has lingered for
+  /// `publish_linger_ms`. If `publisher_prioritize_channels` is set, the messages of
+  /// bulk channels are only sent once no other message is queued.
   ///
   /// \param force_noop If true, reply to the subscriber with an empty message, regardless
   /// of whethere there is any queued message. This is for cases where the current poll
@@ -220,12 +226,32 @@ class SubscriberState {
   const SubscriberID &id() const { return subscriber_id_; }
 
  private:
+  /// Returns true if consecutive messages of the same channel as the given message can
+  /// be sent to the subscriber as a single message.
+  static bool IsCoalescable(const rpc::PubMessage &pub_message);
+
+  /// Returns true if the given message can be merged into the queued message of the
+  /// same key, so that only the latest state of the key is sent.
+  static bool IsMergeable(const rpc::PubMessage &pub_message);
+
+  /// Returns true if the message is from a bulk channel, whose messages are only sent
+  /// once there is room left in a reply.
+  static bool IsLowPriority(const rpc::PubMessage &pub_message);
+
+  /// Returns true if no message is queued.
+  bool MailboxEmpty() const { return mailbox_.empty() && low_priority_mailbox_.empty(); }
+
   /// Subscriber ID, for logging and debugging.
   const SubscriberID subscriber_id_;
   /// Inflight long polling reply callback, for replying to the subscriber.
   std::unique_ptr<LongPollConnection> long_polling_connection_;
   /// Queued messages to publish.
   std::queue<std::shared_ptr<rpc::PubMessage>> mailbox_;
+  /// Queued messages of low priority channels to publish, once `mailbox_` is empty.
+  std::queue<std::shared_ptr<rpc::PubMessage>> low_priority_mailbox_;
+  /// The latest queued message of each key, for the mergeable messages. The earlier
+  /// messages of the key in the mailbox are superseded by it, and are not sent.
+  absl::flat_hash_map<std::string, std::shared_ptr<rpc::PubMessage>> latest_messages_;
   /// Callback to get the current time.
   const std::function<double()> get_time_ms_;
   /// The time in which the connection is considered as timed out.
@@ -234,6 +260,9 @@ class SubscriberState {
   const int publish_batch_size_;
   /// The last time long polling was connected in milliseconds.
   double last_connection_update_time_ms_;
+  /// The time the oldest message in the mailbox was queued in milliseconds, or 0 if
+  /// the mailbox should be published without lingering.
+  double first_queued_time_ms_ = 0;
 };
 
 }  // namespace pub_internal
@@ -323,6 +352,11 @@ class Publisher : public PublisherInterface {
 
     periodical_runner_->RunFnPeriodically([this] { CheckDeadSubscribers(); },
                                           subscriber_timeout_ms);
+    const auto linger_ms = RayConfig::instance().publish_linger_ms();
+    if (linger_ms > 0) {
+      periodical_runner_->RunFnPeriodically([this] { PublishLingeringMessages(); },
+                                            linger_ms);
+    }
   }
 
   ~Publisher() override = default;
@@ -401,6 +435,9 @@ class Publisher : public PublisherInterface {
   /// having a timer per subscriber.
   void CheckDeadSubscribers();
 
+  /// Publish the messages that have lingered for long enough to the subscribers.
+  void PublishLingeringMessages();
+
   std::string DebugString() const;
 
  private:
@@ -127,6 +127,11 @@ void SubscriberChannel::HandlePublishedMessage(const rpc::Address &publisher_add
       << "Message from " << rpc::ChannelType_Name(channel_type) << ", this channel is "
       << rpc::ChannelType_Name(channel_type_);
 
+  if (pub_message.has_batch_message()) {
+    HandlePublishedMessageBatch(publisher_address, pub_message.batch_message());
+    return;
+  }
+
   auto maybe_subscription_callback =
       GetSubscriptionItemCallback(publisher_address, key_id);
   cum_published_messages_++;
@@ -143,6 +148,39 @@ void SubscriberChannel::HandlePublishedMessage(const rpc::Address &publisher_add
       "Subscriber.HandlePublishedMessage_" + channel_name);
 }
 
+void SubscriberChannel::HandlePublishedMessageBatch(
+    const rpc::Address &publisher_address, const rpc::PubMessageBatch &batch) const {
+  std::vector<std::pair<SubscriptionItemCallback, rpc::PubMessage>> callbacks;
+  callbacks.reserve(batch.pub_messages_size());
+  for (const auto &pub_message : batch.pub_messages()) {
+    RAY_CHECK(pub_message.channel_type() == channel_type_)
+        << "Message from " << rpc::ChannelType_Name(pub_message.channel_type())
+        << ", this channel is " << rpc::ChannelType_Name(channel_type_);
+    auto maybe_subscription_callback =
+        GetSubscriptionItemCallback(publisher_address, pub_message.key_id());
+    cum_published_messages_++;
+    if (!maybe_subscription_callback.has_value()) {
+      continue;
+    }
+    cum_processed_messages_++;
+    callbacks.emplace_back(std::move(maybe_subscription_callback.value()), pub_message);
+  }
+  if (callbacks.empty()) {
+    return;
+  }
+  // Run the callbacks of the whole batch in a single handler, instead of posting a
+  // handler per message.
+  const auto &channel_name =
+      rpc::ChannelType_descriptor()->FindValueByNumber(channel_type_)->name();
+  callback_service_->post(
+      [callbacks = std::move(callbacks)]() {
+        for (const auto &[subscription_callback, msg] : callbacks) {
+          subscription_callback(msg);
+        }
+      },
+      "Subscriber.HandlePublishedMessageBatch_" + channel_name);
+}
+
 void SubscriberChannel::HandlePublisherFailure(const rpc::Address &publisher_address,
                                                const Status &status) {
   const auto publisher_id = PublisherID::FromBinary(publisher_address.worker_id());
@@ -263,14 +301,14 @@ bool Subscriber::Unsubscribe(const rpc::ChannelType channel_type,
                              const rpc::Address &publisher_address,
                              const std::string &key_id) {
   // Batch the unsubscribe command.
-  auto command = std::make_unique<CommandItem>();
-  command->cmd.set_channel_type(channel_type);
-  command->cmd.set_key_id(key_id);
-  command->cmd.mutable_unsubscribe_message();
+  rpc::Command command;
+  command.set_channel_type(channel_type);
+  command.set_key_id(key_id);
+  command.mutable_unsubscribe_message();
 
   absl::MutexLock lock(&mutex_);
   const auto publisher_id = PublisherID::FromBinary(publisher_address.worker_id());
-  commands_[publisher_id].emplace(std::move(command));
+  QueueCommand(publisher_id, std::move(command));
   SendCommandBatchIfPossible(publisher_address);
 
   return Channel(channel_type)->Unsubscribe(publisher_address, key_id);
@@ -279,13 +317,13 @@ bool Subscriber::Unsubscribe(const rpc::ChannelType channel_type,
 bool Subscriber::UnsubscribeChannel(const rpc::ChannelType channel_type,
                                     const rpc::Address &publisher_address) {
   // Batch the unsubscribe command.
-  auto command = std::make_unique<CommandItem>();
-  command->cmd.set_channel_type(channel_type);
-  command->cmd.mutable_unsubscribe_message();
+  rpc::Command command;
+  command.set_channel_type(channel_type);
+  command.mutable_unsubscribe_message();
 
   absl::MutexLock lock(&mutex_);
   const auto publisher_id = PublisherID::FromBinary(publisher_address.worker_id());
-  commands_[publisher_id].emplace(std::move(command));
+  QueueCommand(publisher_id, std::move(command));
   SendCommandBatchIfPossible(publisher_address);
 
   return Channel(channel_type)->Unsubscribe(publisher_address, std::nullopt);
@@ -311,19 +349,18 @@ bool Subscriber::SubscribeInternal(
     SubscriptionItemCallback subscription_callback,
     SubscriptionFailureCallback subscription_failure_callback) {
   // Batch a subscribe command.
-  auto command = std::make_unique<CommandItem>();
-  command->cmd.set_channel_type(channel_type);
+  rpc::Command command;
+  command.set_channel_type(channel_type);
   if (key_id) {
-    command->cmd.set_key_id(*key_id);
+    command.set_key_id(*key_id);
   }
   if (sub_message != nullptr) {
-    command->cmd.mutable_subscribe_message()->Swap(sub_message.get());
+    command.mutable_subscribe_message()->Swap(sub_message.get());
   }
-  command->done_cb = std::move(subscribe_done_callback);
   const auto publisher_id = PublisherID::FromBinary(publisher_address.worker_id());
 
   absl::MutexLock lock(&mutex_);
-  commands_[publisher_id].emplace(std::move(command));
+  QueueCommand(publisher_id, std::move(command), std::move(subscribe_done_callback));
   SendCommandBatchIfPossible(publisher_address);
   MakeLongPollingConnectionIfNotConnected(publisher_address);
   return Channel(channel_type)
@@ -376,6 +413,7 @@ void Subscriber::HandleLongPollingResponse(const rpc::Address &publisher_address
     }
     // Empty the command queue because we cannot send commands anymore.
     commands_.erase(publisher_id);
+    cancelable_subscribes_.erase(publisher_id);
   } else {
     for (int i = 0; i < reply.pub_messages_size(); i++) {
       const auto &msg = reply.pub_messages(i);
@@ -403,29 +441,119 @@ void Subscriber::HandleLongPollingResponse(const rpc::Address &publisher_address
   }
 }
 
+void Subscriber::QueueCommand(const PublisherID &publisher_id,
+                              rpc::Command cmd,
+                              SubscribeDoneCallback done_cb) {
+  if (merge_commands_) {
+    CommandKey key(cmd.channel_type(), cmd.key_id());
+    if (key.second.empty()) {
+      // Don't cancel out commands across a command for the whole channel.
+      auto it = cancelable_subscribes_.find(publisher_id);
+      if (it != cancelable_subscribes_.end()) {
+        for (auto entry = it->second.begin(); entry != it->second.end();) {
+          if (entry->first.first == key.first) {
+            it->second.erase(entry++);
+          } else {
+            entry++;
+          }
+        }
+        if (it->second.empty()) {
+          cancelable_subscribes_.erase(it);
+        }
+      }
+    } else if (cmd.has_unsubscribe_message()) {
+      auto it = cancelable_subscribes_.find(publisher_id);
+      if (it != cancelable_subscribes_.end()) {
+        auto subscribe_it = it->second.find(key);
+        if (subscribe_it != it->second.end()) {
+          // The publisher never needs to know about the subscription.
+          subscribe_it->second->canceled = true;
+          it->second.erase(subscribe_it);
+          if (it->second.empty()) {
+            cancelable_subscribes_.erase(it);
+          }
+          return;
+        }
+      }
+    }
+  }
+
+  auto command = std::make_unique<CommandItem>();
+  command->cmd = std::move(cmd);
+  command->done_cb = std::move(done_cb);
+  if (merge_commands_ && !command->cmd.key_id().empty() &&
+      !command->cmd.has_unsubscribe_message()) {
+    CommandKey key(command->cmd.channel_type(), command->cmd.key_id());
+    if (command->done_cb == nullptr) {
+      cancelable_subscribes_[publisher_id][key] = command.get();
+    } else {
+      // The caller waits for the subscription to be acknowledged, so it is sent.
+      auto it = cancelable_subscribes_.find(publisher_id);
+      if (it != cancelable_subscribes_.end()) {
+        it->second.erase(key);
+        if (it->second.empty()) {
+          cancelable_subscribes_.erase(it);
+        }
+      }
+    }
+  }
+  commands_[publisher_id].emplace(std::move(command));
+}
+
 void Subscriber::SendCommandBatchIfPossible(const rpc::Address &publisher_address) {
   const auto publisher_id = PublisherID::FromBinary(publisher_address.worker_id());
-  auto command_batch_sent_it = command_batch_sent_.find(publisher_id);
-
-  // If there's no in flight command batch request to the publisher,
-  // send it. Otherwise, this function will be called when the in flight
-  // request is replied.
-  if (command_batch_sent_it == command_batch_sent_.end()) {
+  while (true) {
+    auto &in_flight = command_batch_sent_[publisher_id];
     // Obtain the command queue.
     auto command_queue_it = commands_.find(publisher_id);
-    if (command_queue_it == commands_.end()) {
+    if (in_flight.num_batches >= max_in_flight_command_batches_ ||
+        command_queue_it == commands_.end()) {
+      if (in_flight.num_batches == 0) {
+        command_batch_sent_.erase(publisher_id);
+      }
       return;
     }
     auto &command_queue = command_queue_it->second;
-    // Update the command in the FIFO order.
+    auto conflicts_with_in_flight = [&in_flight](const CommandKey &key) {
+      if (key.second.empty()) {
+        return in_flight.channels.contains(key.first);
+      }
+      return in_flight.keys.contains(key) ||
+             in_flight.keys.contains(CommandKey(key.first, ""));
+    };
+    // Update the command in the FIFO order, up to the first command whose key is in
+    // flight.
     rpc::PubsubCommandBatchRequest command_batch_request;
     command_batch_request.set_subscriber_id(subscriber_id_.Binary());
     std::vector<SubscribeDoneCallback> done_cb;
+    std::vector<CommandKey> keys;
     while (!command_queue.empty() &&
            done_cb.size() < static_cast<size_t>(max_command_batch_size_)) {
+      auto &command = command_queue.front();
+      CommandKey key(command->cmd.channel_type(), command->cmd.key_id());
+      if (command->canceled) {
+        command_queue.pop();
+        continue;
+      }
+      if (conflicts_with_in_flight(key)) {
+        break;
+      }
+      if (merge_commands_ && !key.second.empty()) {
+        auto it = cancelable_subscribes_.find(publisher_id);
+        if (it != cancelable_subscribes_.end()) {
+          auto subscribe_it = it->second.find(key);
+          if (subscribe_it != it->second.end() && subscribe_it->second == command.get()) {
+            it->second.erase(subscribe_it);
+            if (it->second.empty()) {
+              cancelable_subscribes_.erase(it);
+            }
+          }
+        }
+      }
       auto new_command = command_batch_request.add_commands();
-      new_command->Swap(&command_queue.front()->cmd);
-      done_cb.push_back(std::move(command_queue.front()->done_cb));
+      new_command->Swap(&command->cmd);
+      done_cb.push_back(std::move(command->done_cb));
+      keys.push_back(std::move(key));
       command_queue.pop();
     }
 
@@ -434,20 +562,42 @@ void Subscriber::SendCommandBatchIfPossible(const rpc::Address &publisher_addres
     }
 
     if (done_cb.size() == 0) {
+      if (in_flight.num_batches == 0) {
+        command_batch_sent_.erase(publisher_id);
+      }
       return;
     }
 
-    command_batch_sent_.emplace(publisher_id);
+    in_flight.num_batches++;
+    for (const auto &key : keys) {
+      in_flight.keys[key]++;
+      in_flight.channels[key.first]++;
+    }
     auto subscriber_client = get_client_(publisher_address);
     subscriber_client->PubsubCommandBatch(
         command_batch_request,
-        [this, publisher_address, publisher_id, done_cb = std::move(done_cb)](
-            Status status, const rpc::PubsubCommandBatchReply &reply) {
+        [this,
+         publisher_address,
+         publisher_id,
+         done_cb = std::move(done_cb),
+         keys = std::move(keys)](Status status,
+                                 const rpc::PubsubCommandBatchReply &reply) {
           {
             absl::MutexLock lock(&mutex_);
             auto command_batch_sent_it = command_batch_sent_.find(publisher_id);
             RAY_CHECK(command_batch_sent_it != command_batch_sent_.end());
-            command_batch_sent_.erase(command_batch_sent_it);
+            auto &in_flight = command_batch_sent_it->second;
+            for (const auto &key : keys) {
+              if (--in_flight.keys[key] == 0) {
+                in_flight.keys.erase(key);
+              }
+              if (--in_flight.channels[key.first] == 0) {
+                in_flight.channels.erase(key.first);
+              }
+            }
+            if (--in_flight.num_batches == 0) {
+              command_batch_sent_.erase(command_batch_sent_it);
+            }
           }
           for (const auto &done : done_cb) {
             if (done) {
@@ -478,7 +628,7 @@ bool Subscriber::CheckNoLeaks() const {
     }
   }
   return !leaks && publishers_connected_.empty() && command_batch_sent_.empty() &&
-         commands_.empty();
+         commands_.empty() && cancelable_subscribes_.empty();
 }
 
 std::string Subscriber::DebugString() const {
@@ -24,6 +24,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/id.h"
+#include "ray/common/ray_config.h"
 #include "ray/rpc/client_call.h"
 #include "src/ray/protobuf/common.pb.h"
 #include "src/ray/protobuf/pubsub.pb.h"
@@ -115,6 +116,15 @@ class SubscriberChannel {
   void HandlePublishedMessage(const rpc::Address &publisher_address,
                               const rpc::PubMessage &pub_message) const;
 
+  /// Handle a batch of messages that the publisher coalesced. The subscription
+  /// callbacks of the messages are run in order, in a single handler on the callback
+  /// IO service.
+  ///
+  /// \param publisher_address The address of the publisher.
+  /// \param batch The messages to handle from the publisher.
+  void HandlePublishedMessageBatch(const rpc::Address &publisher_address,
+                                   const rpc::PubMessageBatch &batch) const;
+
   /// Handle the RPC failure of the given publisher.
   /// Note that this will ensure that the callback is running on a designated IO service.
   ///
@@ -331,9 +341,14 @@ class Subscriber : public SubscriberInterface {
       const int64_t max_command_batch_size,
       std::function<std::shared_ptr<SubscriberClientInterface>(const rpc::Address &)>
           get_client,
-      instrumented_io_context *callback_service)
+      instrumented_io_context *callback_service,
+      int64_t max_in_flight_command_batches =
+          RayConfig::instance().max_in_flight_pubsub_command_batches(),
+      bool merge_commands = RayConfig::instance().merge_pubsub_commands())
       : subscriber_id_(subscriber_id),
         max_command_batch_size_(max_command_batch_size),
+        max_in_flight_command_batches_(max_in_flight_command_batches),
+        merge_commands_(merge_commands),
         get_client_(get_client) {
     for (auto type : channels) {
       channels_.emplace(type,
@@ -436,16 +451,29 @@ class Subscriber : public SubscriberInterface {
   void MakeLongPollingConnectionIfNotConnected(const rpc::Address &publisher_address)
       EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  /// Send a command batch to the publisher. To ensure the FIFO order with unary GRPC
-  /// requests (which don't guarantee ordering), the subscriber module only allows to have
-  /// 1-flight GRPC request per the publisher. Since we batch all commands into a single
-  /// request, it should have higher throughput than sending 1 RPC per command
-  /// concurrently.
+  /// Send command batches to the publisher. Unary GRPC requests don't guarantee
+  /// ordering, so to keep the FIFO order of the commands for each key, a command is
+  /// only sent once no command for its key (or, for a command for a whole channel,
+  /// for its channel) is in flight, and at most `max_in_flight_command_batches_`
+  /// batches are in flight per publisher. Since we batch the commands, it should have
+  /// higher throughput than sending 1 RPC per command concurrently.
   /// This RPC should be independent from the long polling RPC to receive published
   /// messages.
   void SendCommandBatchIfPossible(const rpc::Address &publisher_address)
       EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  /// The channel and key that a command is for. The key is empty for commands for a
+  /// whole channel.
+  using CommandKey = std::pair<rpc::ChannelType, std::string>;
+
+  /// Add a command to the queue of a publisher. If merging commands is enabled, an
+  /// unsubscribe command cancels out a subscribe command for the same key that is
+  /// still queued instead of being queued itself.
+  void QueueCommand(const PublisherID &publisher_id,
+                    rpc::Command cmd,
+                    SubscribeDoneCallback done_cb = nullptr)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   /// Return true if the given publisher id has subscription to any of channel.
   bool SubscriptionExists(const PublisherID &publisher_id)
       EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
@@ -460,6 +488,12 @@ class Subscriber : public SubscriberInterface {
   /// The command batch size for the subscriber.
   const int64_t max_command_batch_size_;
 
+  /// The maximum number of command batches in flight per publisher.
+  const int64_t max_in_flight_command_batches_;
+
+  /// Whether to cancel out queued subscribe and unsubscribe commands for the same key.
+  const bool merge_commands_;
+
   /// Gets an rpc client for connecting to the publisher.
   const std::function<std::shared_ptr<SubscriberClientInterface>(const rpc::Address &)>
       get_client_;
@@ -468,22 +502,39 @@ class Subscriber : public SubscriberInterface {
   /// thread safe.
   mutable absl::Mutex mutex_;
 
-  /// Commands queue. Commands are reported in FIFO order to the publisher. This
-  /// guarantees the ordering of commands because they are delivered only by a single RPC
-  /// (long polling request).
+  /// Commands queue. Commands are reported in FIFO order to the publisher, see
+  /// `SendCommandBatchIfPossible`.
   struct CommandItem {
     rpc::Command cmd;
     SubscribeDoneCallback done_cb;
+    /// Whether an unsubscribe command canceled out this subscribe command before it was
+    /// sent, in which case it's dropped.
+    bool canceled = false;
   };
   using CommandQueue = std::queue<std::unique_ptr<CommandItem>>;
   absl::flat_hash_map<PublisherID, CommandQueue> commands_ GUARDED_BY(mutex_);
 
+  /// The queued subscribe commands that are the last queued command for their key, and
+  /// so can be canceled out by an unsubscribe command. Only used if merging commands is
+  /// enabled.
+  absl::flat_hash_map<PublisherID, absl::flat_hash_map<CommandKey, CommandItem *>>
+      cancelable_subscribes_ GUARDED_BY(mutex_);
+
   /// A set to cache the connected publisher ids. "Connected" means the long polling
   /// request is in flight.
   absl::flat_hash_set<PublisherID> publishers_connected_ GUARDED_BY(mutex_);
 
-  /// A set to keep track of in-flight command batch requests
-  absl::flat_hash_set<PublisherID> command_batch_sent_ GUARDED_BY(mutex_);
+  /// The commands in flight to a publisher.
+  struct InFlightCommands {
+    int64_t num_batches = 0;
+    /// The number of commands in flight per key.
+    absl::flat_hash_map<CommandKey, int64_t> keys;
+    /// The number of commands in flight per channel.
+    absl::flat_hash_map<rpc::ChannelType, int64_t> channels;
+  };
+  /// The in-flight command batch requests, per publisher.
+  absl::flat_hash_map<PublisherID, InFlightCommands> command_batch_sent_
+      GUARDED_BY(mutex_);
 
   /// Mapping of channel type to channels.
   absl::flat_hash_map<rpc::ChannelType, std::unique_ptr<SubscriberChannel>> channels_
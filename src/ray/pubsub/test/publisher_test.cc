@@ -14,6 +14,7 @@
 
 #include "ray/pubsub/publisher.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ray/common/asio/instrumented_io_context.h"
@@ -415,6 +416,219 @@ TEST_F(PublisherTest, TestSubscriberBatchSize) {
   }
 }
 
+TEST_F(PublisherTest, TestSubscriberBatchBytesAndLinger) {
+  const int64_t message_bytes = GeneratePubMessage(ObjectID::FromRandom()).ByteSizeLong();
+  RayConfig::instance().initialize(
+      absl::StrCat(R"({"publish_batch_max_bytes": )",
+                   2 * message_bytes + 1,
+                   R"(, "publish_linger_ms": 10})"));
+  rpc::PubsubLongPollingReply reply;
+  int num_replies = 0;
+  rpc::SendReplyCallback send_reply_callback =
+      [&num_replies](Status status,
+                     std::function<void()> success,
+                     std::function<void()> failure) { num_replies++; };
+  auto subscriber = std::make_shared<SubscriberState>(
+      subscriber_id_,
+      [this]() { return current_time_; },
+      subscriber_timeout_ms_,
+      /*publish_batch_size=*/5);
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+
+  // The batch isn't full, so it lingers.
+  for (int i = 0; i < 3; i++) {
+    subscriber->QueueMessage(
+        std::make_shared<rpc::PubMessage>(GeneratePubMessage(ObjectID::FromRandom())));
+  }
+  ASSERT_EQ(num_replies, 0);
+  current_time_ += 10;
+  ASSERT_TRUE(subscriber->PublishIfPossible());
+  ASSERT_EQ(num_replies, 1);
+  // Only 2 messages fit in the bytes of a batch.
+  ASSERT_EQ(reply.pub_messages_size(), 2);
+
+  // The rest of the mailbox is published upon polling, without lingering.
+  reply = rpc::PubsubLongPollingReply();
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  ASSERT_EQ(num_replies, 2);
+  ASSERT_EQ(reply.pub_messages_size(), 1);
+
+  // A full batch doesn't linger.
+  reply = rpc::PubsubLongPollingReply();
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  for (int i = 0; i < 5; i++) {
+    subscriber->QueueMessage(
+        std::make_shared<rpc::PubMessage>(GeneratePubMessage(ObjectID::FromRandom())));
+  }
+  ASSERT_EQ(num_replies, 3);
+  RayConfig::instance().initialize("");
+}
+
+TEST_F(PublisherTest, TestSubscriberCoalesceRefRemovedMessages) {
+  auto generate_ref_removed_message = [](const ObjectID &object_id) {
+    auto pub_message = std::make_shared<rpc::PubMessage>();
+    pub_message->set_key_id(object_id.Binary());
+    pub_message->set_channel_type(rpc::ChannelType::WORKER_REF_REMOVED_CHANNEL);
+    pub_message->mutable_worker_ref_removed_message();
+    return pub_message;
+  };
+
+  rpc::PubsubLongPollingReply reply;
+  rpc::SendReplyCallback send_reply_callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  auto subscriber = std::make_shared<SubscriberState>(
+      subscriber_id_,
+      [this]() { return current_time_; },
+      subscriber_timeout_ms_,
+      /*publish_batch_size=*/5);
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+
+  // A single message is not wrapped in a batch.
+  const auto single_oid = ObjectID::FromRandom();
+  subscriber->QueueMessage(generate_ref_removed_message(single_oid));
+  ASSERT_EQ(reply.pub_messages_size(), 1);
+  ASSERT_TRUE(reply.pub_messages(0).has_worker_ref_removed_message());
+  ASSERT_EQ(reply.pub_messages(0).key_id(), single_oid.Binary());
+
+  // Only consecutive ref removed messages are coalesced, and the batch size still
+  // bounds the number of messages per reply.
+  std::vector<ObjectID> oids;
+  for (int i = 0; i < 6; i++) {
+    oids.push_back(ObjectID::FromRandom());
+  }
+  for (int i = 0; i < 2; i++) {
+    subscriber->QueueMessage(generate_ref_removed_message(oids[i]),
+                             /*try_publish=*/false);
+  }
+  subscriber->QueueMessage(
+      std::make_shared<rpc::PubMessage>(GeneratePubMessage(oids[2])),
+      /*try_publish=*/false);
+  for (int i = 3; i < 6; i++) {
+    subscriber->QueueMessage(generate_ref_removed_message(oids[i]),
+                             /*try_publish=*/false);
+  }
+  reply = rpc::PubsubLongPollingReply();
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+
+  ASSERT_EQ(reply.pub_messages_size(), 3);
+  const auto &first_batch = reply.pub_messages(0).batch_message();
+  ASSERT_EQ(reply.pub_messages(0).channel_type(),
+            rpc::ChannelType::WORKER_REF_REMOVED_CHANNEL);
+  ASSERT_EQ(first_batch.pub_messages_size(), 2);
+  ASSERT_EQ(first_batch.pub_messages(0).key_id(), oids[0].Binary());
+  ASSERT_EQ(first_batch.pub_messages(1).key_id(), oids[1].Binary());
+  ASSERT_TRUE(reply.pub_messages(1).has_worker_object_eviction_message());
+  const auto &second_batch = reply.pub_messages(2).batch_message();
+  ASSERT_EQ(second_batch.pub_messages_size(), 2);
+  ASSERT_EQ(second_batch.pub_messages(0).key_id(), oids[3].Binary());
+  ASSERT_EQ(second_batch.pub_messages(1).key_id(), oids[4].Binary());
+
+  // The remaining message is published upon polling.
+  reply = rpc::PubsubLongPollingReply();
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  ASSERT_EQ(reply.pub_messages_size(), 1);
+  ASSERT_EQ(reply.pub_messages(0).key_id(), oids[5].Binary());
+}
+
+TEST_F(PublisherTest, TestSubscriberMergeActorMessages) {
+  RayConfig::instance().initialize(R"({"publisher_merge_actor_messages": true})");
+  auto generate_actor_message = [](const ActorID &actor_id,
+                                   rpc::ActorTableData::ActorState state,
+                                   int port) {
+    auto pub_message = std::make_shared<rpc::PubMessage>();
+    pub_message->set_key_id(actor_id.Binary());
+    pub_message->set_channel_type(rpc::ChannelType::GCS_ACTOR_CHANNEL);
+    auto *actor = pub_message->mutable_actor_message();
+    actor->set_state(state);
+    if (port != 0) {
+      actor->mutable_address()->set_port(port);
+    }
+    return pub_message;
+  };
+
+  rpc::PubsubLongPollingReply reply;
+  rpc::SendReplyCallback send_reply_callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  auto subscriber = std::make_shared<SubscriberState>(
+      subscriber_id_,
+      [this]() { return current_time_; },
+      subscriber_timeout_ms_,
+      /*publish_batch_size=*/5);
+
+  const auto job_id = JobID::FromInt(1);
+  const auto actor_1 = ActorID::Of(job_id, TaskID::ForDriverTask(job_id), 1);
+  const auto actor_2 = ActorID::Of(job_id, TaskID::ForDriverTask(job_id), 2);
+  auto first_message = generate_actor_message(actor_1, rpc::ActorTableData::ALIVE, 1);
+  first_message->mutable_actor_message()->set_name("actor");
+  subscriber->QueueMessage(first_message);
+  subscriber->QueueMessage(
+      generate_actor_message(actor_2, rpc::ActorTableData::ALIVE, 2));
+  subscriber->QueueMessage(
+      generate_actor_message(actor_1, rpc::ActorTableData::RESTARTING, 0));
+  subscriber->QueueMessage(
+      generate_actor_message(actor_1, rpc::ActorTableData::ALIVE, 3));
+
+  // Only the latest state of each actor is sent, with the fields of the earlier ones.
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  ASSERT_EQ(reply.pub_messages_size(), 2);
+  ASSERT_EQ(reply.pub_messages(0).key_id(), actor_2.Binary());
+  const auto &actor = reply.pub_messages(1).actor_message();
+  ASSERT_EQ(reply.pub_messages(1).key_id(), actor_1.Binary());
+  ASSERT_EQ(actor.state(), rpc::ActorTableData::ALIVE);
+  ASSERT_EQ(actor.address().port(), 3);
+  ASSERT_EQ(actor.name(), "actor");
+  // The queued message, which other subscribers may share, is not modified.
+  ASSERT_EQ(first_message->actor_message().address().port(), 1);
+  ASSERT_TRUE(subscriber->CheckNoLeaks());
+  RayConfig::instance().initialize("");
+}
+
+TEST_F(PublisherTest, TestSubscriberPrioritizeChannels) {
+  RayConfig::instance().initialize(R"({"publisher_prioritize_channels": true})");
+  auto generate_message = [](rpc::ChannelType channel_type) {
+    auto pub_message = std::make_shared<rpc::PubMessage>();
+    pub_message->set_key_id(ObjectID::FromRandom().Binary());
+    pub_message->set_channel_type(channel_type);
+    if (channel_type == rpc::ChannelType::RAY_LOG_CHANNEL) {
+      pub_message->mutable_log_batch_message()->set_pid("1");
+    } else {
+      pub_message->mutable_worker_object_eviction_message();
+    }
+    return pub_message;
+  };
+
+  rpc::PubsubLongPollingReply reply;
+  rpc::SendReplyCallback send_reply_callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  auto subscriber = std::make_shared<SubscriberState>(
+      subscriber_id_,
+      [this]() { return current_time_; },
+      subscriber_timeout_ms_,
+      /*publish_batch_size=*/3);
+
+  for (int i = 0; i < 3; i++) {
+    subscriber->QueueMessage(generate_message(rpc::ChannelType::RAY_LOG_CHANNEL));
+  }
+  for (int i = 0; i < 2; i++) {
+    subscriber->QueueMessage(generate_message(rpc::ChannelType::WORKER_OBJECT_EVICTION));
+  }
+
+  // The eviction messages are sent before the log messages that were queued earlier.
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  ASSERT_EQ(reply.pub_messages_size(), 3);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(reply.pub_messages(i).channel_type(),
+              rpc::ChannelType::WORKER_OBJECT_EVICTION);
+  }
+  ASSERT_EQ(reply.pub_messages(2).channel_type(), rpc::ChannelType::RAY_LOG_CHANNEL);
+
+  reply = rpc::PubsubLongPollingReply();
+  subscriber->ConnectToSubscriber(request_, &reply, send_reply_callback);
+  ASSERT_EQ(reply.pub_messages_size(), 2);
+  ASSERT_TRUE(subscriber->CheckNoLeaks());
+  RayConfig::instance().initialize("");
+}
+
 TEST_F(PublisherTest, TestSubscriberActiveTimeout) {
   ///
   /// Test the active connection timeout.
@@ -71,6 +71,26 @@ class MockWorkerClient : public pubsub::SubscriberClientInterface {
     return true;
   }
 
+  bool ReplyLongPollingWithBatch(rpc::ChannelType channel_type,
+                                 std::vector<ObjectID> &object_ids) {
+    if (long_polling_callbacks.empty()) {
+      return false;
+    }
+    auto callback = long_polling_callbacks.front();
+    auto reply = rpc::PubsubLongPollingReply();
+
+    auto *batch_message = reply.add_pub_messages();
+    batch_message->set_channel_type(channel_type);
+    for (const auto &object_id : object_ids) {
+      auto *new_pub_message = batch_message->mutable_batch_message()->add_pub_messages();
+      new_pub_message->set_key_id(object_id.Binary());
+      new_pub_message->set_channel_type(channel_type);
+    }
+    callback(Status::OK(), reply);
+    long_polling_callbacks.pop_front();
+    return true;
+  }
+
   bool FailureMessagePublished(rpc::ChannelType channel_type,
                                std::vector<ObjectID> &object_ids) {
     if (long_polling_callbacks.empty()) {
@@ -325,6 +345,46 @@ TEST_F(SubscriberTest, TestCallbackNotInvokedForNonSubscribedObject) {
   ASSERT_EQ(object_subscribed_.count(object_id), 0);
 }
 
+TEST_F(SubscriberTest, TestBatchMessage) {
+  ///
+  /// Make sure the callbacks of the messages in a batch are invoked in order, only for
+  /// subscribed objects.
+  ///
+
+  std::vector<ObjectID> objects_received;
+  auto subscription_callback = [&objects_received](const rpc::PubMessage &msg) {
+    objects_received.push_back(ObjectID::FromBinary(msg.key_id()));
+  };
+  auto failure_callback = EMPTY_FAILURE_CALLBACK;
+
+  const auto owner_addr = GenerateOwnerAddress();
+  std::vector<ObjectID> objects_batched;
+  for (int i = 0; i < 3; i++) {
+    const auto object_id = ObjectID::FromRandom();
+    subscriber_->Subscribe(GenerateSubMessage(object_id),
+                           channel,
+                           owner_addr,
+                           object_id.Binary(),
+                           /*subscribe_done_callback=*/nullptr,
+                           subscription_callback,
+                           failure_callback);
+    ASSERT_TRUE(owner_client->ReplyCommandBatch());
+    objects_batched.push_back(object_id);
+  }
+  const auto object_id_not_subscribed = ObjectID::FromRandom();
+  objects_batched.insert(objects_batched.begin() + 1, object_id_not_subscribed);
+
+  ASSERT_EQ(callback_service_.poll(), 0);
+  callback_service_.reset();
+  ASSERT_TRUE(owner_client->ReplyLongPollingWithBatch(channel, objects_batched));
+  // All callbacks are run by a single handler.
+  ASSERT_EQ(callback_service_.poll(), 1);
+  callback_service_.reset();
+  objects_batched.erase(objects_batched.begin() + 1);
+  ASSERT_EQ(objects_received, objects_batched);
+  ASSERT_EQ(owner_client->GetNumberOfInFlightLongPollingRequests(), 1);
+}
+
 TEST_F(SubscriberTest, TestSubscribeChannelEntities) {
   ///
   /// Make sure SubscribeChannel() can receive all entities from a channel.
@@ -848,6 +908,98 @@ TEST_F(SubscriberTest, TestIsSubscribed) {
   ASSERT_FALSE(subscriber_->IsSubscribed(channel, owner_addr, object_id.Binary()));
 }
 
+TEST_F(SubscriberTest, TestMultipleInFlightCommandBatches) {
+  ///
+  /// Multiple batches can be in flight, as long as they don't have commands for the
+  /// same key.
+  ///
+  subscriber_ = std::make_shared<Subscriber>(
+      self_node_id_,
+      /*channels=*/std::vector<rpc::ChannelType>{channel},
+      /*max_command_batch_size*/ 3,
+      client_pool,
+      &callback_service_,
+      /*max_in_flight_command_batches=*/2,
+      /*merge_commands=*/false);
+  auto subscription_callback = [](const rpc::PubMessage &msg) {};
+  auto failure_callback = EMPTY_FAILURE_CALLBACK;
+
+  const auto owner_addr = GenerateOwnerAddress();
+  const auto object_id = ObjectID::FromRandom();
+  const auto object_id_2 = ObjectID::FromRandom();
+  for (const auto &id : {object_id, object_id_2}) {
+    subscriber_->Subscribe(GenerateSubMessage(id),
+                           channel,
+                           owner_addr,
+                           id.Binary(),
+                           /*subscribe_done_callback=*/nullptr,
+                           subscription_callback,
+                           failure_callback);
+  }
+  // Both subscriptions are in flight in separate batches.
+  ASSERT_EQ(owner_client->requests_.size(), 2);
+
+  // The unsubscription of a key in flight waits for the subscription to be replied.
+  ASSERT_TRUE(subscriber_->Unsubscribe(channel, owner_addr, object_id.Binary()));
+  ASSERT_EQ(owner_client->requests_.size(), 2);
+  auto r = owner_client->ReplyCommandBatch();
+  ASSERT_EQ(r->commands(0).key_id(), object_id.Binary());
+  ASSERT_EQ(owner_client->requests_.size(), 2);
+  r = owner_client->ReplyCommandBatch();
+  ASSERT_EQ(r->commands(0).key_id(), object_id_2.Binary());
+  r = owner_client->ReplyCommandBatch();
+  ASSERT_EQ(r->commands(0).key_id(), object_id.Binary());
+  ASSERT_TRUE(r->commands(0).has_unsubscribe_message());
+  ASSERT_FALSE(owner_client->ReplyCommandBatch());
+}
+
+TEST_F(SubscriberTest, TestMergeSubUnsubCommands) {
+  ///
+  /// A subscription that is unsubscribed before it's sent is never sent.
+  ///
+  subscriber_ = std::make_shared<Subscriber>(
+      self_node_id_,
+      /*channels=*/std::vector<rpc::ChannelType>{channel},
+      /*max_command_batch_size*/ 3,
+      client_pool,
+      &callback_service_,
+      /*max_in_flight_command_batches=*/1,
+      /*merge_commands=*/true);
+  auto subscription_callback = [](const rpc::PubMessage &msg) {};
+  auto failure_callback = EMPTY_FAILURE_CALLBACK;
+
+  const auto owner_addr = GenerateOwnerAddress();
+  const auto object_id = ObjectID::FromRandom();
+  const auto object_id_2 = ObjectID::FromRandom();
+  // The first batch is sent right away.
+  subscriber_->Subscribe(GenerateSubMessage(object_id),
+                         channel,
+                         owner_addr,
+                         object_id.Binary(),
+                         /*subscribe_done_callback=*/nullptr,
+                         subscription_callback,
+                         failure_callback);
+  // These commands are queued, and cancel each other out.
+  subscriber_->Subscribe(GenerateSubMessage(object_id_2),
+                         channel,
+                         owner_addr,
+                         object_id_2.Binary(),
+                         /*subscribe_done_callback=*/nullptr,
+                         subscription_callback,
+                         failure_callback);
+  ASSERT_TRUE(subscriber_->Unsubscribe(channel, owner_addr, object_id_2.Binary()));
+  // The unsubscription of a subscription that was sent is still sent.
+  ASSERT_TRUE(subscriber_->Unsubscribe(channel, owner_addr, object_id.Binary()));
+
+  auto r = owner_client->ReplyCommandBatch();
+  ASSERT_EQ(r->commands().size(), 1);
+  r = owner_client->ReplyCommandBatch();
+  ASSERT_EQ(r->commands().size(), 1);
+  ASSERT_EQ(r->commands(0).key_id(), object_id.Binary());
+  ASSERT_TRUE(r->commands(0).has_unsubscribe_message());
+  ASSERT_FALSE(owner_client->ReplyCommandBatch());
+}
+
 // TODO(sang): Need to add a network failure test once we support network failure
 // properly.
 
@@ -19,7 +19,7 @@ namespace ray {
 namespace raylet {
 
 bool DependencyManager::CheckObjectLocal(const ObjectID &object_id) const {
-  return local_objects_.count(object_id) == 1;
+  return local_objects_.contains(object_id);
 }
 
 bool DependencyManager::GetOwnerAddress(const ObjectID &object_id,
@@ -33,6 +33,16 @@ bool DependencyManager::GetOwnerAddress(const ObjectID &object_id,
   return !owner_address->worker_id().empty();
 }
 
+int64_t DependencyManager::GetObjectDemand(const ObjectID &object_id) const {
+  auto obj = required_objects_.find(object_id);
+  if (obj == required_objects_.end()) {
+    return 0;
+  }
+  return obj->second.dependent_tasks.size() +
+         obj->second.dependent_get_requests.size() +
+         obj->second.dependent_wait_requests.size();
+}
+
 void DependencyManager::RemoveObjectIfNotNeeded(
     absl::flat_hash_map<ObjectID, DependencyManager::ObjectDependencies>::iterator
         required_object_it) {
@@ -60,12 +70,13 @@ DependencyManager::GetOrInsertRequiredObject(const ObjectID &object_id,
 
 void DependencyManager::StartOrUpdateWaitRequest(
     const WorkerID &worker_id,
-    const std::vector<rpc::ObjectReference> &required_objects) {
+    const std::vector<rpc::ObjectReference> &required_objects,
+    const PullOptions &options) {
   RAY_LOG(DEBUG) << "Starting wait request for worker " << worker_id;
   auto &wait_request = wait_requests_[worker_id];
   for (const auto &ref : required_objects) {
     const auto obj_id = ObjectRefToId(ref);
-    if (local_objects_.count(obj_id)) {
+    if (local_objects_.contains(obj_id)) {
       // Object is already local. No need to fetch it.
       continue;
     }
@@ -77,7 +88,7 @@ void DependencyManager::StartOrUpdateWaitRequest(
       it->second.dependent_wait_requests.insert(worker_id);
       if (it->second.wait_request_id == 0) {
         it->second.wait_request_id =
-            object_manager_.Pull({ref}, BundlePriority::WAIT_REQUEST);
+            object_manager_.Pull({ref}, BundlePriority::WAIT_REQUEST, options);
         RAY_LOG(DEBUG) << "Started pull for wait request for object " << obj_id
                        << " request: " << it->second.wait_request_id;
       }
@@ -109,38 +120,35 @@ void DependencyManager::CancelWaitRequest(const WorkerID &worker_id) {
 
 void DependencyManager::StartOrUpdateGetRequest(
     const WorkerID &worker_id,
-    const std::vector<rpc::ObjectReference> &required_objects) {
+    const std::vector<rpc::ObjectReference> &required_objects,
+    const PullOptions &options) {
   RAY_LOG(DEBUG) << "Starting get request for worker " << worker_id;
   auto &get_request = get_requests_[worker_id];
   bool modified = false;
   for (const auto &ref : required_objects) {
     const auto obj_id = ObjectRefToId(ref);
-    if (get_request.first.insert(obj_id).second) {
+    if (get_request.objects.insert(obj_id).second) {
       RAY_LOG(DEBUG) << "Worker " << worker_id << " called ray.get on object " << obj_id;
       auto it = GetOrInsertRequiredObject(obj_id, ref);
       it->second.dependent_get_requests.insert(worker_id);
+      get_request.refs.push_back(ObjectIdToRef(obj_id, it->second.owner_address));
       modified = true;
     }
   }
 
   if (modified) {
-    std::vector<rpc::ObjectReference> refs;
-    for (auto &obj_id : get_request.first) {
-      auto it = required_objects_.find(obj_id);
-      RAY_CHECK(it != required_objects_.end());
-      refs.push_back(ObjectIdToRef(obj_id, it->second.owner_address));
-    }
     // Pull the new dependencies before canceling the old request, in case some
     // of the old dependencies are still being fetched.
-    uint64_t new_request_id = object_manager_.Pull(refs, BundlePriority::GET_REQUEST);
-    if (get_request.second != 0) {
+    uint64_t new_request_id =
+        object_manager_.Pull(get_request.refs, BundlePriority::GET_REQUEST, options);
+    if (get_request.pull_request_id != 0) {
       RAY_LOG(DEBUG) << "Canceling pull for get request from worker " << worker_id
-                     << " request: " << get_request.second;
-      object_manager_.CancelPull(get_request.second);
+                     << " request: " << get_request.pull_request_id;
+      object_manager_.CancelPull(get_request.pull_request_id);
     }
-    get_request.second = new_request_id;
+    get_request.pull_request_id = new_request_id;
     RAY_LOG(DEBUG) << "Started pull for get request from worker " << worker_id
-                   << " request: " << get_request.second;
+                   << " request: " << get_request.pull_request_id;
   }
 }
 
@@ -152,10 +160,10 @@ void DependencyManager::CancelGetRequest(const WorkerID &worker_id) {
   }
 
   RAY_LOG(DEBUG) << "Canceling pull for get request from worker " << worker_id
-                 << " request: " << it->second.second;
-  object_manager_.CancelPull(it->second.second);
+                 << " request: " << it->second.pull_request_id;
+  object_manager_.CancelPull(it->second.pull_request_id);
 
-  for (const auto &obj_id : it->second.first) {
+  for (const auto &obj_id : it->second.objects) {
     auto it = required_objects_.find(obj_id);
     RAY_CHECK(it != required_objects_.end());
     it->second.dependent_get_requests.erase(worker_id);
@@ -171,30 +179,31 @@ bool DependencyManager::RequestTaskDependencies(
   RAY_LOG(DEBUG) << "Adding dependencies for task " << task_id
                  << ". Required objects length: " << required_objects.size();
 
-  const auto required_ids = ObjectRefsToIds(required_objects);
-  absl::flat_hash_set<ObjectID> deduped_ids(required_ids.begin(), required_ids.end());
-  auto inserted = queued_task_requests_.emplace(task_id, std::move(deduped_ids));
+  auto inserted = queued_task_requests_.emplace(task_id, TaskDependencies());
   RAY_CHECK(inserted.second) << "Task depedencies can be requested only once per task. "
                              << task_id;
   auto &task_entry = inserted.first->second;
+  task_entry.dependencies.reserve(required_objects.size());
 
+  // Deduplicate the arguments, index the task under each of them and count the ones
+  // that aren't local yet, all in one pass, since tasks can have thousands of them.
   for (const auto &ref : required_objects) {
     const auto obj_id = ObjectRefToId(ref);
+    if (!task_entry.dependencies.insert(obj_id).second) {
+      continue;
+    }
     RAY_LOG(DEBUG) << "Task " << task_id << " blocked on object " << obj_id;
 
     auto it = GetOrInsertRequiredObject(obj_id, ref);
     it->second.dependent_tasks.insert(task_id);
-  }
-
-  for (const auto &obj_id : task_entry.dependencies) {
-    if (local_objects_.count(obj_id)) {
-      task_entry.num_missing_dependencies--;
+    if (!local_objects_.contains(obj_id)) {
+      task_entry.num_missing_dependencies++;
     }
   }
 
   if (!required_objects.empty()) {
     task_entry.pull_request_id =
-        object_manager_.Pull(required_objects, BundlePriority::TASK_ARGS);
+        object_manager_.Pull(required_objects, BundlePriority::TASK_ARGS, PullOptions());
     RAY_LOG(DEBUG) << "Started pull for dependencies of task " << task_id
                    << " request: " << task_entry.pull_request_id;
   }
@@ -224,6 +233,30 @@ void DependencyManager::RemoveTaskDependencies(const TaskID &task_id) {
   queued_task_requests_.erase(task_entry);
 }
 
+void DependencyManager::PrefetchTaskDependencies(
+    const absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> &tasks) {
+  for (auto it = prefetch_requests_.begin(); it != prefetch_requests_.end();) {
+    if (tasks.contains(it->first)) {
+      it++;
+      continue;
+    }
+    RAY_LOG(DEBUG) << "Canceling prefetch for dependencies of task " << it->first
+                   << " request: " << it->second;
+    object_manager_.CancelPull(it->second);
+    prefetch_requests_.erase(it++);
+  }
+  for (const auto &task : tasks) {
+    if (task.second.empty() || prefetch_requests_.contains(task.first)) {
+      continue;
+    }
+    const auto pull_request_id =
+        object_manager_.Pull(task.second, BundlePriority::TASK_ARGS, PullOptions());
+    RAY_LOG(DEBUG) << "Started prefetch for dependencies of task " << task.first
+                   << " request: " << pull_request_id;
+    prefetch_requests_.emplace(task.first, pull_request_id);
+  }
+}
+
 std::vector<TaskID> DependencyManager::HandleObjectMissing(
     const ray::ObjectID &object_id) {
   RAY_CHECK(local_objects_.erase(object_id))
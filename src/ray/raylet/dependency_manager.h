@@ -33,6 +33,8 @@ class TaskDependencyManagerInterface {
       const TaskID &task_id,
       const std::vector<rpc::ObjectReference> &required_objects) = 0;
   virtual void RemoveTaskDependencies(const TaskID &task_id) = 0;
+  virtual void PrefetchTaskDependencies(
+      const absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> &tasks) = 0;
   virtual bool TaskDependenciesBlocked(const TaskID &task_id) const = 0;
   virtual bool CheckObjectLocal(const ObjectID &object_id) const = 0;
   virtual ~TaskDependencyManagerInterface(){};
@@ -69,6 +71,14 @@ class DependencyManager : public TaskDependencyManagerInterface {
   /// \return True if we have owner information for the object.
   bool GetOwnerAddress(const ObjectID &object_id, rpc::Address *owner_address) const;
 
+  /// Get the number of queued tasks and workers that wait on an object, e.g. to spill
+  /// the objects that are not about to be used first.
+  ///
+  /// \param object_id The object.
+  /// \return The number of tasks that the object is an argument of, plus the number of
+  /// workers that called `ray.get` or `ray.wait` on it.
+  int64_t GetObjectDemand(const ObjectID &object_id) const;
+
   /// Start or update a worker's `ray.wait` request. This will attempt to make
   /// any remote objects local, including previously requested objects. The
   /// `ray.wait` request will stay active until the objects are made local or
@@ -78,10 +88,13 @@ class DependencyManager : public TaskDependencyManagerInterface {
   ///
   /// \param worker_id The ID of the worker that called `ray.wait`.
   /// \param required_objects The objects required by the worker.
+  /// \param options The order of the pulls for objects that are not already being
+  /// pulled for another `ray.wait` request.
   /// \return Void.
   void StartOrUpdateWaitRequest(
       const WorkerID &worker_id,
-      const std::vector<rpc::ObjectReference> &required_objects);
+      const std::vector<rpc::ObjectReference> &required_objects,
+      const PullOptions &options = PullOptions());
 
   /// Cancel a worker's `ray.wait` request. We will no longer attempt to fetch
   /// any objects that this worker requested previously, if no other task or
@@ -101,9 +114,11 @@ class DependencyManager : public TaskDependencyManagerInterface {
   ///
   /// \param worker_id The ID of the worker that called `ray.wait`.
   /// \param required_objects The objects required by the worker.
+  /// \param options The order of the pull for the worker's objects.
   /// \return Void.
   void StartOrUpdateGetRequest(const WorkerID &worker_id,
-                               const std::vector<rpc::ObjectReference> &required_objects);
+                               const std::vector<rpc::ObjectReference> &required_objects,
+                               const PullOptions &options = PullOptions());
 
   /// Cancel a worker's `ray.get` request. We will no longer attempt to fetch
   /// any objects that this worker requested previously, if no other task or
@@ -136,6 +151,15 @@ class DependencyManager : public TaskDependencyManagerInterface {
   /// \return Void.
   void RemoveTaskDependencies(const TaskID &task_id);
 
+  /// Set the tasks whose arguments to prefetch, e.g. tasks that are queued for
+  /// resources and will likely run on this node soon. Their arguments are pulled like
+  /// those of queued tasks, but the tasks are not blocked on them. The prefetches of
+  /// the tasks from the previous call that aren't passed again are canceled.
+  ///
+  /// \param tasks The tasks to prefetch the arguments of, with their arguments.
+  void PrefetchTaskDependencies(
+      const absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> &tasks);
+
   /// Handle an object becoming locally available.
   ///
   /// \param object_id The object ID of the object to mark as locally
@@ -170,13 +194,13 @@ class DependencyManager : public TaskDependencyManagerInterface {
         : owner_address(ref.owner_address()) {}
     /// The tasks that depend on this object, either because the object is a task argument
     /// or because the task called `ray.get` on the object.
-    std::unordered_set<TaskID> dependent_tasks;
+    absl::flat_hash_set<TaskID> dependent_tasks;
     /// The workers that depend on this object because they called `ray.get` on the
     /// object.
-    std::unordered_set<WorkerID> dependent_get_requests;
+    absl::flat_hash_set<WorkerID> dependent_get_requests;
     /// The workers that depend on this object because they called `ray.wait` on the
     /// object.
-    std::unordered_set<WorkerID> dependent_wait_requests;
+    absl::flat_hash_set<WorkerID> dependent_wait_requests;
     /// If this object is required by at least one worker that called `ray.wait`, this is
     /// the pull request ID.
     uint64_t wait_request_id = 0;
@@ -191,8 +215,6 @@ class DependencyManager : public TaskDependencyManagerInterface {
 
   /// A struct to represent the object dependencies of a task.
   struct TaskDependencies {
-    TaskDependencies(const absl::flat_hash_set<ObjectID> &deps)
-        : dependencies(std::move(deps)), num_missing_dependencies(dependencies.size()) {}
     /// The objects that the task depends on. These are the arguments to the
     /// task. These must all be simultaneously local before the task is ready
     /// to execute. Objects are removed from this set once
@@ -200,12 +222,24 @@ class DependencyManager : public TaskDependencyManagerInterface {
     absl::flat_hash_set<ObjectID> dependencies;
     /// The number of object arguments that are not available locally. This
     /// must be zero before the task is ready to execute.
-    size_t num_missing_dependencies;
+    size_t num_missing_dependencies = 0;
     /// Used to identify the pull request for the dependencies to the object
     /// manager.
     uint64_t pull_request_id = 0;
   };
 
+  /// The objects that a worker called `ray.get` on.
+  struct GetRequest {
+    /// The objects, to deduplicate the ones passed to later updates of the request.
+    absl::flat_hash_set<ObjectID> objects;
+    /// The references to the objects, in the order they were first requested, so
+    /// that an update can pull them without looking each one up again.
+    std::vector<rpc::ObjectReference> refs;
+    /// The pull request ID for the objects. It should be used to cancel the pull
+    /// request in the object manager once the worker cancels the `ray.get` request.
+    uint64_t pull_request_id = 0;
+  };
+
   /// Stop tracking this object, if it is no longer needed by any worker or
   /// queued task.
   void RemoveObjectIfNotNeeded(
@@ -222,12 +256,12 @@ class DependencyManager : public TaskDependencyManagerInterface {
   /// dependencies are all local or not.
   absl::flat_hash_map<TaskID, TaskDependencies> queued_task_requests_;
 
-  /// A map from worker ID to the set of objects that the worker called
-  /// `ray.get` on and a pull request ID for these objects. The pull request ID
-  /// should be used to cancel the pull request in the object manager once the
-  /// worker cancels the `ray.get` request.
-  absl::flat_hash_map<WorkerID, std::pair<absl::flat_hash_set<ObjectID>, uint64_t>>
-      get_requests_;
+  /// A map from the ID of a task whose arguments are prefetched to the pull request ID
+  /// for the arguments.
+  absl::flat_hash_map<TaskID, uint64_t> prefetch_requests_;
+
+  /// A map from worker ID to the objects that the worker called `ray.get` on.
+  absl::flat_hash_map<WorkerID, GetRequest> get_requests_;
 
   /// A map from worker ID to the set of objects that the worker called
   /// `ray.wait` on. Objects are removed from the set once they are made local,
@@ -241,7 +275,7 @@ class DependencyManager : public TaskDependencyManagerInterface {
 
   /// The set of locally available objects. This is used to determine which
   /// tasks are ready to run and which `ray.wait` requests can be finished.
-  std::unordered_set<ray::ObjectID> local_objects_;
+  absl::flat_hash_set<ray::ObjectID> local_objects_;
 
   friend class DependencyManagerTest;
 };
@@ -32,7 +32,8 @@ using ::testing::Return;
 class MockObjectManager : public ObjectManagerInterface {
  public:
   uint64_t Pull(const std::vector<rpc::ObjectReference> &object_refs,
-                BundlePriority prio) {
+                BundlePriority prio,
+                const PullOptions &options) {
     if (prio == BundlePriority::GET_REQUEST) {
       active_get_requests.insert(req_id);
     } else if (prio == BundlePriority::WAIT_REQUEST) {
@@ -71,6 +72,7 @@ class DependencyManagerTest : public ::testing::Test {
     ASSERT_TRUE(dependency_manager_.queued_task_requests_.empty());
     ASSERT_TRUE(dependency_manager_.get_requests_.empty());
     ASSERT_TRUE(dependency_manager_.wait_requests_.empty());
+    ASSERT_TRUE(dependency_manager_.prefetch_requests_.empty());
     // All pull requests are canceled.
     ASSERT_TRUE(object_manager_mock_.active_task_requests.empty());
     ASSERT_TRUE(object_manager_mock_.active_get_requests.empty());
@@ -345,6 +347,53 @@ TEST_F(DependencyManagerTest, TestDuplicateTaskArgs) {
   AssertNoLeaks();
 }
 
+/// Test a task whose arguments, some of them repeated, are partly local already. Only
+/// the distinct arguments that aren't local should be counted as missing.
+TEST_F(DependencyManagerTest, TestTaskArgsPartlyLocal) {
+  auto local_id = ObjectID::FromRandom();
+  auto remote_id = ObjectID::FromRandom();
+  ASSERT_TRUE(dependency_manager_.HandleObjectLocal(local_id).empty());
+  std::vector<ObjectID> arguments = {local_id, remote_id, local_id, remote_id};
+  TaskID task_id = RandomTaskId();
+  bool ready =
+      dependency_manager_.RequestTaskDependencies(task_id, ObjectIdsToRefs(arguments));
+  ASSERT_FALSE(ready);
+
+  auto ready_task_ids = dependency_manager_.HandleObjectLocal(remote_id);
+  ASSERT_EQ(ready_task_ids, std::vector<TaskID>({task_id}));
+  ready_task_ids = dependency_manager_.HandleObjectMissing(local_id);
+  ASSERT_EQ(ready_task_ids, std::vector<TaskID>({task_id}));
+  ASSERT_EQ(dependency_manager_.HandleObjectLocal(local_id).size(), 1);
+
+  dependency_manager_.RemoveTaskDependencies(task_id);
+  AssertNoLeaks();
+}
+
+TEST_F(DependencyManagerTest, TestPrefetchTaskDependencies) {
+  TaskID task_id1 = RandomTaskId();
+  TaskID task_id2 = RandomTaskId();
+  auto args1 = ObjectIdsToRefs({ObjectID::FromRandom()});
+  auto args2 = ObjectIdsToRefs({ObjectID::FromRandom()});
+  dependency_manager_.PrefetchTaskDependencies({{task_id1, args1}});
+  ASSERT_EQ(object_manager_mock_.active_task_requests.size(), 1);
+  // Prefetching doesn't block the task on its arguments.
+  ASSERT_TRUE(dependency_manager_.required_objects_.empty());
+
+  // The prefetch of the first task is kept, and the second one is started.
+  dependency_manager_.PrefetchTaskDependencies({{task_id1, args1}, {task_id2, args2}});
+  ASSERT_EQ(object_manager_mock_.active_task_requests.size(), 2);
+  ASSERT_EQ(object_manager_mock_.req_id, 3);
+
+  // The first task was queued, so its arguments are pulled for it instead.
+  ASSERT_FALSE(dependency_manager_.RequestTaskDependencies(task_id1, args1));
+  dependency_manager_.PrefetchTaskDependencies({{task_id2, args2}});
+  ASSERT_EQ(object_manager_mock_.active_task_requests.size(), 2);
+
+  dependency_manager_.PrefetchTaskDependencies({});
+  dependency_manager_.RemoveTaskDependencies(task_id1);
+  AssertNoLeaks();
+}
+
 }  // namespace raylet
 
 }  // namespace ray
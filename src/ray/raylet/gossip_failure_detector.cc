@@ -0,0 +1,127 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/gossip_failure_detector.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+GossipFailureDetector::GossipFailureDetector(
+    const NodeID &self_node_id,
+    size_t num_indirect_probes,
+    ProbeFn probe,
+    std::function<void(const NodeID &)> report_suspected)
+    : self_node_id_(self_node_id),
+      num_indirect_probes_(num_indirect_probes),
+      probe_(std::move(probe)),
+      report_suspected_(std::move(report_suspected)),
+      gen_(std::random_device()()) {}
+
+void GossipFailureDetector::AddNode(const rpc::Address &address) {
+  const auto node_id = NodeID::FromBinary(address.raylet_id());
+  if (node_id != self_node_id_) {
+    nodes_[node_id] = address;
+  }
+}
+
+void GossipFailureDetector::RemoveNode(const NodeID &node_id) { nodes_.erase(node_id); }
+
+void GossipFailureDetector::Tick() {
+  // Skip the nodes removed since the round started, and those still being probed
+  // since the last round.
+  while (next_in_round_ < round_.size() &&
+         (!nodes_.contains(round_[next_in_round_]) ||
+          probing_.contains(round_[next_in_round_]))) {
+    next_in_round_++;
+  }
+  if (next_in_round_ == round_.size()) {
+    // Start a new round, so that every node is probed once per round.
+    round_.clear();
+    for (const auto &entry : nodes_) {
+      if (!probing_.contains(entry.first)) {
+        round_.push_back(entry.first);
+      }
+    }
+    std::shuffle(round_.begin(), round_.end(), gen_);
+    next_in_round_ = 0;
+    if (round_.empty()) {
+      return;
+    }
+  }
+
+  const auto node_id = round_[next_in_round_++];
+  probing_.insert(node_id);
+  const auto address = nodes_[node_id];
+  probe_(address, absl::nullopt, [this, node_id](bool reachable) {
+    if (reachable) {
+      OnProbed(node_id, true);
+    } else {
+      ProbeIndirectly(node_id);
+    }
+  });
+}
+
+void GossipFailureDetector::ProbeIndirectly(const NodeID &node_id) {
+  auto it = nodes_.find(node_id);
+  if (it == nodes_.end()) {
+    OnProbed(node_id, true);
+    return;
+  }
+
+  std::vector<rpc::Address> relays;
+  for (const auto &entry : nodes_) {
+    if (entry.first != node_id) {
+      relays.push_back(entry.second);
+    }
+  }
+  std::shuffle(relays.begin(), relays.end(), gen_);
+  relays.resize(std::min(relays.size(), num_indirect_probes_));
+  if (relays.empty()) {
+    OnProbed(node_id, false);
+    return;
+  }
+
+  RAY_LOG(DEBUG) << "Node " << node_id << " didn't reply to a probe, asking "
+                 << relays.size() << " other nodes to probe it.";
+  auto num_pending = std::make_shared<size_t>(relays.size());
+  auto reached = std::make_shared<bool>(false);
+  const auto address = it->second;
+  for (const auto &relay : relays) {
+    probe_(address, relay, [this, node_id, num_pending, reached](bool reachable) {
+      *reached = *reached || reachable;
+      if (--*num_pending == 0) {
+        OnProbed(node_id, *reached);
+      }
+    });
+  }
+}
+
+void GossipFailureDetector::OnProbed(const NodeID &node_id, bool reachable) {
+  probing_.erase(node_id);
+  if (!reachable && nodes_.contains(node_id)) {
+    RAY_LOG(WARNING) << "Node " << node_id
+                     << " didn't reply to any probe, reporting it to the GCS.";
+    report_suspected_(node_id);
+  }
+}
+
+}  // namespace raylet
+
+}  // namespace ray
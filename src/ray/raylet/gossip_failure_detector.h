@@ -0,0 +1,88 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/optional.h"
+#include "ray/common/id.h"
+#include "src/ray/protobuf/common.pb.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// \class GossipFailureDetector
+/// Detects the failures of the other nodes of the cluster by probing them, in the
+/// manner of SWIM, so that the GCS doesn't have to receive a heartbeat from every node.
+/// Each tick, the next node in a shuffled round of all the nodes is probed. If it
+/// doesn't reply, a few other nodes are asked to probe it, so that a slow link between
+/// two nodes doesn't get a node suspected. If none of them gets a reply either, the node
+/// is reported as suspected, and the GCS decides whether it is dead.
+class GossipFailureDetector {
+ public:
+  /// Probe a node, through another node if one is given, and call the callback with
+  /// whether the probed node replied.
+  using ProbeFn = std::function<void(const rpc::Address &node,
+                                     const absl::optional<rpc::Address> &relay,
+                                     std::function<void(bool reachable)> callback)>;
+
+  /// \param self_node_id ID of this node, which is never probed.
+  /// \param num_indirect_probes The number of nodes asked to probe a node that didn't
+  /// reply to a direct probe.
+  /// \param probe Sends the probes.
+  /// \param report_suspected Reports a node that didn't reply to any probe.
+  GossipFailureDetector(const NodeID &self_node_id,
+                        size_t num_indirect_probes,
+                        ProbeFn probe,
+                        std::function<void(const NodeID &)> report_suspected);
+
+  /// Start probing a node.
+  void AddNode(const rpc::Address &address);
+
+  /// Stop probing a node, e.g., once it is marked dead.
+  void RemoveNode(const NodeID &node_id);
+
+  /// Probe the next node of the round. This should be called periodically.
+  void Tick();
+
+ private:
+  /// Ask a few other nodes to probe a node that didn't reply to a direct probe.
+  void ProbeIndirectly(const NodeID &node_id);
+
+  /// Finish the probes of a node, and report it if it didn't reply to any of them.
+  void OnProbed(const NodeID &node_id, bool reachable);
+
+  const NodeID self_node_id_;
+  const size_t num_indirect_probes_;
+  ProbeFn probe_;
+  std::function<void(const NodeID &)> report_suspected_;
+  /// The addresses of the nodes to probe.
+  absl::flat_hash_map<NodeID, rpc::Address> nodes_;
+  /// The current round of probes, in a random order, and the next node to probe in it.
+  std::vector<NodeID> round_;
+  size_t next_in_round_ = 0;
+  /// The nodes whose probes haven't finished yet.
+  absl::flat_hash_set<NodeID> probing_;
+  std::mt19937 gen_;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -0,0 +1,135 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/gossip_failure_detector.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+namespace raylet {
+
+class GossipFailureDetectorTest : public ::testing::Test {
+ public:
+  GossipFailureDetectorTest()
+      : self_node_id_(NodeID::FromRandom()),
+        detector_(
+            self_node_id_,
+            /*num_indirect_probes=*/2,
+            [this](const rpc::Address &node,
+                   const absl::optional<rpc::Address> &relay,
+                   std::function<void(bool)> callback) {
+              probes_.push_back({NodeID::FromBinary(node.raylet_id()),
+                                 relay ? NodeID::FromBinary(relay->raylet_id())
+                                       : NodeID::Nil(),
+                                 callback});
+            },
+            [this](const NodeID &node_id) { suspected_.push_back(node_id); }) {}
+
+  NodeID AddNode() {
+    const auto node_id = NodeID::FromRandom();
+    rpc::Address address;
+    address.set_raylet_id(node_id.Binary());
+    detector_.AddNode(address);
+    return node_id;
+  }
+
+  /// Reply to the outstanding probes, in order.
+  void ReplyToProbes(const std::vector<bool> &reachable) {
+    ASSERT_EQ(probes_.size(), reachable.size());
+    auto probes = std::move(probes_);
+    probes_.clear();
+    for (size_t i = 0; i < probes.size(); i++) {
+      probes[i].callback(reachable[i]);
+    }
+  }
+
+  struct Probe {
+    NodeID node_id;
+    NodeID relay_id;
+    std::function<void(bool)> callback;
+  };
+
+  NodeID self_node_id_;
+  GossipFailureDetector detector_;
+  std::vector<Probe> probes_;
+  std::vector<NodeID> suspected_;
+};
+
+TEST_F(GossipFailureDetectorTest, TestProbeEveryNodeOncePerRound) {
+  absl::flat_hash_set<NodeID> nodes = {AddNode(), AddNode(), AddNode()};
+  rpc::Address self_address;
+  self_address.set_raylet_id(self_node_id_.Binary());
+  detector_.AddNode(self_address);
+
+  for (int round = 0; round < 2; round++) {
+    absl::flat_hash_set<NodeID> probed;
+    for (size_t i = 0; i < nodes.size(); i++) {
+      detector_.Tick();
+      ASSERT_EQ(probes_.size(), 1);
+      ASSERT_TRUE(probes_[0].relay_id.IsNil());
+      probed.insert(probes_[0].node_id);
+      ReplyToProbes({true});
+    }
+    ASSERT_EQ(probed, nodes);
+  }
+  ASSERT_TRUE(suspected_.empty());
+}
+
+TEST_F(GossipFailureDetectorTest, TestIndirectProbes) {
+  AddNode();
+  AddNode();
+  AddNode();
+
+  // One of the other nodes reaches the node, so it isn't suspected.
+  detector_.Tick();
+  const auto node_id = probes_[0].node_id;
+  ReplyToProbes({false});
+  ASSERT_EQ(probes_.size(), 2);
+  for (const auto &probe : probes_) {
+    ASSERT_EQ(probe.node_id, node_id);
+    ASSERT_NE(probe.relay_id, node_id);
+    ASSERT_FALSE(probe.relay_id.IsNil());
+  }
+  ReplyToProbes({false, true});
+  ASSERT_TRUE(suspected_.empty());
+
+  // No one reaches the node, so it's suspected.
+  detector_.Tick();
+  const auto other_node_id = probes_[0].node_id;
+  ReplyToProbes({false});
+  ReplyToProbes({false, false});
+  ASSERT_EQ(suspected_, std::vector<NodeID>({other_node_id}));
+}
+
+TEST_F(GossipFailureDetectorTest, TestRemovedNodeNotSuspected) {
+  const auto node_id = AddNode();
+  detector_.Tick();
+  detector_.RemoveNode(node_id);
+  // There is no other node to ask, and the node is gone anyway.
+  ReplyToProbes({false});
+  ASSERT_TRUE(probes_.empty());
+  ASSERT_TRUE(suspected_.empty());
+  detector_.Tick();
+  ASSERT_TRUE(probes_.empty());
+}
+
+}  // namespace raylet
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
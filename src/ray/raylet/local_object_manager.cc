@@ -14,6 +14,9 @@
 
 #include "ray/raylet/local_object_manager.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
@@ -26,6 +29,12 @@ void LocalObjectManager::PinObjectsAndWaitForFree(
     const std::vector<ObjectID> &object_ids,
     std::vector<std::unique_ptr<RayObject>> &&objects,
     const rpc::Address &owner_address) {
+  // All objects of a request have the same owner, so the subscriptions are queued
+  // together and sent to the owner in as few command batches as possible.
+  rpc::Address subscriber_address;
+  subscriber_address.set_raylet_id(self_node_id_.Binary());
+  subscriber_address.set_ip_address(self_node_address_);
+  subscriber_address.set_port(self_node_port_);
   for (size_t i = 0; i < object_ids.size(); i++) {
     const auto &object_id = object_ids[i];
     auto &object = objects[i];
@@ -61,10 +70,6 @@ void LocalObjectManager::PinObjectsAndWaitForFree(
     auto wait_request = std::make_unique<rpc::WorkerObjectEvictionSubMessage>();
     wait_request->set_object_id(object_id.Binary());
     wait_request->set_intended_worker_id(owner_address.worker_id());
-    rpc::Address subscriber_address;
-    subscriber_address.set_raylet_id(self_node_id_.Binary());
-    subscriber_address.set_ip_address(self_node_address_);
-    subscriber_address.set_port(self_node_port_);
     wait_request->mutable_subscriber_address()->CopyFrom(subscriber_address);
 
     // If the subscription succeeds, register the subscription callback.
@@ -178,22 +183,47 @@ bool LocalObjectManager::SpillObjectsOfSize(int64_t num_bytes_to_spill) {
 
   RAY_LOG(DEBUG) << "Choosing objects to spill of total size " << num_bytes_to_spill;
   int64_t bytes_to_spill = 0;
-  auto it = pinned_objects_.begin();
   std::vector<ObjectID> objects_to_spill;
-  int64_t counts = 0;
-  while (it != pinned_objects_.end() && counts < max_fused_object_count_) {
-    if (is_plasma_object_spillable_(it->first)) {
-      bytes_to_spill += it->second->GetSize();
-      objects_to_spill.push_back(it->first);
+  // Whether all the spillable objects were chosen.
+  bool chose_all_objects = false;
+  if (get_object_demand_) {
+    // (demand, -size, object) of the spillable objects, to spill the objects with the
+    // least demand first, and the largest of those.
+    std::vector<std::tuple<int64_t, int64_t, ObjectID>> candidates;
+    for (const auto &pinned_object : pinned_objects_) {
+      if (is_plasma_object_spillable_(pinned_object.first)) {
+        candidates.emplace_back(get_object_demand_(pinned_object.first),
+                                -static_cast<int64_t>(pinned_object.second->GetSize()),
+                                pinned_object.first);
+      }
     }
-    it++;
-    counts += 1;
+    const size_t num_to_spill =
+        std::min(candidates.size(), static_cast<size_t>(max_fused_object_count_));
+    std::partial_sort(
+        candidates.begin(), candidates.begin() + num_to_spill, candidates.end());
+    for (size_t i = 0; i < num_to_spill; i++) {
+      bytes_to_spill -= std::get<1>(candidates[i]);
+      objects_to_spill.push_back(std::get<2>(candidates[i]));
+    }
+    chose_all_objects = num_to_spill == candidates.size();
+  } else {
+    auto it = pinned_objects_.begin();
+    int64_t counts = 0;
+    while (it != pinned_objects_.end() && counts < max_fused_object_count_) {
+      if (is_plasma_object_spillable_(it->first)) {
+        bytes_to_spill += it->second->GetSize();
+        objects_to_spill.push_back(it->first);
+      }
+      it++;
+      counts += 1;
+    }
+    chose_all_objects = it == pinned_objects_.end();
   }
   if (objects_to_spill.empty()) {
     return false;
   }
 
-  if (it == pinned_objects_.end() && bytes_to_spill < num_bytes_to_spill &&
+  if (chose_all_objects && bytes_to_spill < num_bytes_to_spill &&
       !objects_pending_spill_.empty()) {
     // We have gone through all spillable objects but we have not yet reached
     // the minimum bytes to spill and we are already spilling other objects.
@@ -296,6 +326,10 @@ void LocalObjectManager::SpillObjectsInternal(
     }
     return;
   }
+  if (native_spiller_ != nullptr) {
+    SpillObjectsNatively(objects_to_spill, callback);
+    return;
+  }
   io_worker_pool_.PopSpillWorker(
       [this, objects_to_spill, callback](std::shared_ptr<WorkerInterface> io_worker) {
         rpc::SpillObjectsRequest request;
@@ -323,35 +357,76 @@ void LocalObjectManager::SpillObjectsInternal(
                 num_active_workers_ -= 1;
               }
               io_worker_pool_.PushSpillWorker(io_worker);
-              size_t num_objects_spilled = status.ok() ? r.spilled_objects_url_size() : 0;
-              // Object spilling is always done in the order of the request.
-              // For example, if an object succeeded, it'll guarentee that all objects
-              // before this will succeed.
-              RAY_CHECK(num_objects_spilled <= requested_objects_to_spill.size());
-              for (size_t i = num_objects_spilled; i != requested_objects_to_spill.size();
-                   ++i) {
-                const auto &object_id = requested_objects_to_spill[i];
-                auto it = objects_pending_spill_.find(object_id);
-                RAY_CHECK(it != objects_pending_spill_.end());
-                pinned_objects_size_ += it->second->GetSize();
-                num_bytes_pending_spill_ -= it->second->GetSize();
-                pinned_objects_.emplace(object_id, std::move(it->second));
-                objects_pending_spill_.erase(it);
-              }
-
-              if (!status.ok()) {
-                RAY_LOG(ERROR) << "Failed to send object spilling request: "
-                               << status.ToString();
-              } else {
-                OnObjectSpilled(requested_objects_to_spill, r);
-              }
-              if (callback) {
-                callback(status);
-              }
+              OnSpillObjectsReply(requested_objects_to_spill, status, r, callback);
             });
       });
 }
 
+void LocalObjectManager::SpillObjectsNatively(
+    const std::vector<ObjectID> &objects_to_spill,
+    std::function<void(const ray::Status &)> callback) {
+  std::vector<NativeObjectSpiller::ObjectToSpill> objects;
+  std::vector<ObjectID> requested_objects_to_spill;
+  for (const auto &object_id : objects_to_spill) {
+    auto pending_it = objects_pending_spill_.find(object_id);
+    RAY_CHECK(pending_it != objects_pending_spill_.end());
+    auto freed_it = local_objects_.find(object_id);
+    // If the object hasn't already been freed, spill it.
+    if (freed_it == local_objects_.end() || freed_it->second.second) {
+      objects_pending_spill_.erase(pending_it);
+    } else {
+      // The object stays in objects_pending_spill_, and so pinned, until the spill
+      // is done.
+      objects.push_back({object_id, freed_it->second.first, pending_it->second.get()});
+      requested_objects_to_spill.push_back(object_id);
+    }
+  }
+  native_spiller_->SpillObjects(
+      std::move(objects),
+      [this, requested_objects_to_spill, callback](const ray::Status &status,
+                                                   std::vector<std::string> object_urls) {
+        {
+          absl::MutexLock lock(&mutex_);
+          num_active_workers_ -= 1;
+        }
+        rpc::SpillObjectsReply reply;
+        for (auto &object_url : object_urls) {
+          reply.add_spilled_objects_url(std::move(object_url));
+        }
+        OnSpillObjectsReply(requested_objects_to_spill, status, reply, callback);
+      });
+}
+
+void LocalObjectManager::OnSpillObjectsReply(
+    const std::vector<ObjectID> &requested_objects_to_spill,
+    const ray::Status &status,
+    const rpc::SpillObjectsReply &reply,
+    const std::function<void(const ray::Status &)> &callback) {
+  size_t num_objects_spilled = status.ok() ? reply.spilled_objects_url_size() : 0;
+  // Object spilling is always done in the order of the request.
+  // For example, if an object succeeded, it'll guarentee that all objects
+  // before this will succeed.
+  RAY_CHECK(num_objects_spilled <= requested_objects_to_spill.size());
+  for (size_t i = num_objects_spilled; i != requested_objects_to_spill.size(); ++i) {
+    const auto &object_id = requested_objects_to_spill[i];
+    auto it = objects_pending_spill_.find(object_id);
+    RAY_CHECK(it != objects_pending_spill_.end());
+    pinned_objects_size_ += it->second->GetSize();
+    num_bytes_pending_spill_ -= it->second->GetSize();
+    pinned_objects_.emplace(object_id, std::move(it->second));
+    objects_pending_spill_.erase(it);
+  }
+
+  if (!status.ok()) {
+    RAY_LOG(ERROR) << "Failed to send object spilling request: " << status.ToString();
+  } else {
+    OnObjectSpilled(requested_objects_to_spill, reply);
+  }
+  if (callback) {
+    callback(status);
+  }
+}
+
 void LocalObjectManager::OnObjectSpilled(const std::vector<ObjectID> &object_ids,
                                          const rpc::SpillObjectsReply &worker_reply) {
   for (size_t i = 0; i < static_cast<size_t>(worker_reply.spilled_objects_url_size());
@@ -392,8 +467,12 @@ void LocalObjectManager::OnObjectSpilled(const std::vector<ObjectID> &object_ids
       continue;
     }
     const auto &worker_addr = freed_it->second.first;
+    // Objects spilled to a shared file system can be restored by any node.
+    const bool spilled_to_local_storage =
+        is_external_storage_type_fs_ &&
+        !RayConfig::instance().object_spilling_shared_filesystem();
     object_directory_->ReportObjectSpilled(
-        object_id, self_node_id_, worker_addr, object_url, is_external_storage_type_fs_);
+        object_id, self_node_id_, worker_addr, object_url, spilled_to_local_storage);
   }
 }
 
@@ -424,6 +503,30 @@ void LocalObjectManager::AsyncRestoreSpilledObject(
   RAY_CHECK(objects_pending_restore_.emplace(object_id).second)
       << "Object dedupe wasn't done properly. Please report if you see this issue.";
   num_bytes_pending_restore_ += object_size;
+  // Empty objects have no chunks to restore natively, leave them to the IO workers.
+  if (native_spiller_ != nullptr && restore_spilled_object_natively_ != nullptr &&
+      object_size > 0) {
+    auto start_time = absl::GetCurrentTimeNanos();
+    RAY_LOG(DEBUG) << "Restoring spilled object " << object_id << " natively";
+    restore_spilled_object_natively_(
+        object_id,
+        object_size,
+        object_url,
+        [this, start_time, object_id, object_size, callback](const ray::Status &status) {
+          num_bytes_pending_restore_ -= object_size;
+          objects_pending_restore_.erase(object_id);
+          if (!status.ok()) {
+            RAY_LOG(ERROR) << "Failed to restore spilled object " << object_id << ": "
+                           << status.ToString();
+          } else {
+            OnObjectRestored(object_id, object_size, start_time);
+          }
+          if (callback) {
+            callback(status);
+          }
+        });
+    return;
+  }
   io_worker_pool_.PopRestoreWorker([this, object_id, object_size, object_url, callback](
                                        std::shared_ptr<WorkerInterface> io_worker) {
     auto start_time = absl::GetCurrentTimeNanos();
@@ -442,26 +545,7 @@ void LocalObjectManager::AsyncRestoreSpilledObject(
             RAY_LOG(ERROR) << "Failed to send restore spilled object request: "
                            << status.ToString();
           } else {
-            auto now = absl::GetCurrentTimeNanos();
-            auto restored_bytes = r.bytes_restored_total();
-            RAY_LOG(DEBUG) << "Restored " << restored_bytes << " in "
-                           << (now - start_time) / 1e6 << "ms. Object id:" << object_id;
-            restored_bytes_total_ += restored_bytes;
-            restored_objects_total_ += 1;
-            // Adjust throughput timing to account for concurrent restore operations.
-            restore_time_total_s_ +=
-                (now - std::max(start_time, last_restore_finish_ns_)) / 1e9;
-            if (now - last_restore_log_ns_ > 1e9) {
-              last_restore_log_ns_ = now;
-              RAY_LOG(INFO) << "Restored "
-                            << static_cast<int>(restored_bytes_total_ / (1024 * 1024))
-                            << " MiB, " << restored_objects_total_
-                            << " objects, read throughput "
-                            << static_cast<int>(restored_bytes_total_ / (1024 * 1024) /
-                                                restore_time_total_s_)
-                            << " MiB/s";
-            }
-            last_restore_finish_ns_ = now;
+            OnObjectRestored(object_id, r.bytes_restored_total(), start_time);
           }
           if (callback) {
             callback(status);
@@ -470,6 +554,28 @@ void LocalObjectManager::AsyncRestoreSpilledObject(
   });
 }
 
+void LocalObjectManager::OnObjectRestored(const ObjectID &object_id,
+                                          int64_t restored_bytes,
+                                          int64_t start_time) {
+  auto now = absl::GetCurrentTimeNanos();
+  RAY_LOG(DEBUG) << "Restored " << restored_bytes << " in " << (now - start_time) / 1e6
+                 << "ms. Object id:" << object_id;
+  restored_bytes_total_ += restored_bytes;
+  restored_objects_total_ += 1;
+  // Adjust throughput timing to account for concurrent restore operations.
+  restore_time_total_s_ += (now - std::max(start_time, last_restore_finish_ns_)) / 1e9;
+  if (now - last_restore_log_ns_ > 1e9) {
+    last_restore_log_ns_ = now;
+    RAY_LOG(INFO) << "Restored "
+                  << static_cast<int>(restored_bytes_total_ / (1024 * 1024)) << " MiB, "
+                  << restored_objects_total_ << " objects, read throughput "
+                  << static_cast<int>(restored_bytes_total_ / (1024 * 1024) /
+                                      restore_time_total_s_)
+                  << " MiB/s";
+  }
+  last_restore_finish_ns_ = now;
+}
+
 void LocalObjectManager::ProcessSpilledObjectsDeleteQueue(uint32_t max_batch_size) {
   std::vector<std::string> object_urls_to_delete;
   // Process upto batch size of objects to delete.
@@ -522,6 +628,10 @@ void LocalObjectManager::ProcessSpilledObjectsDeleteQueue(uint32_t max_batch_siz
 }
 
 void LocalObjectManager::DeleteSpilledObjects(std::vector<std::string> &urls_to_delete) {
+  if (native_spiller_ != nullptr) {
+    native_spiller_->DeleteSpilledObjects(urls_to_delete);
+    return;
+  }
   io_worker_pool_.PopDeleteWorker(
       [this, urls_to_delete](std::shared_ptr<WorkerInterface> io_worker) {
         RAY_LOG(DEBUG) << "Sending delete spilled object request. Length: "
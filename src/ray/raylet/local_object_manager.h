@@ -24,6 +24,7 @@
 #include "ray/object_manager/common.h"
 #include "ray/object_manager/object_directory.h"
 #include "ray/pubsub/subscriber.h"
+#include "ray/raylet/native_object_spiller.h"
 #include "ray/raylet/worker_pool.h"
 #include "ray/rpc/worker/core_worker_client_pool.h"
 #include "ray/util/util.h"
@@ -52,7 +53,10 @@ class LocalObjectManager {
       std::function<void(const std::vector<ObjectID> &)> on_objects_freed,
       std::function<bool(const ray::ObjectID &)> is_plasma_object_spillable,
       pubsub::SubscriberInterface *core_worker_subscriber,
-      IObjectDirectory *object_directory)
+      IObjectDirectory *object_directory,
+      std::unique_ptr<NativeObjectSpiller> native_spiller = nullptr,
+      RestoreSpilledObjectCallback restore_spilled_object_natively = nullptr,
+      std::function<int64_t(const ray::ObjectID &)> get_object_demand = nullptr)
       : self_node_id_(node_id),
         self_node_address_(self_node_address),
         self_node_port_(self_node_port),
@@ -70,7 +74,10 @@ class LocalObjectManager {
         max_fused_object_count_(max_fused_object_count),
         next_spill_error_log_bytes_(RayConfig::instance().verbose_spill_logs()),
         core_worker_subscriber_(core_worker_subscriber),
-        object_directory_(object_directory) {}
+        object_directory_(object_directory),
+        native_spiller_(std::move(native_spiller)),
+        restore_spilled_object_natively_(std::move(restore_spilled_object_natively)),
+        get_object_demand_(std::move(get_object_demand)) {}
 
   /// Pin objects.
   ///
@@ -179,6 +186,32 @@ class LocalObjectManager {
   void SpillObjectsInternal(const std::vector<ObjectID> &objects_ids,
                             std::function<void(const ray::Status &)> callback);
 
+  /// Spill objects that were moved to objects_pending_spill_ with the native
+  /// spiller, instead of on an IO worker.
+  void SpillObjectsNatively(const std::vector<ObjectID> &objects_to_spill,
+                            std::function<void(const ray::Status &)> callback);
+
+  /// Handle the reply of a spill request. The objects that were not spilled are
+  /// pinned again.
+  ///
+  /// \param requested_objects_to_spill The objects requested to spill, in order.
+  /// \param status The status of the request.
+  /// \param reply The URLs of the objects that were spilled.
+  /// \param callback The callback of the spill request.
+  void OnSpillObjectsReply(const std::vector<ObjectID> &requested_objects_to_spill,
+                           const ray::Status &status,
+                           const rpc::SpillObjectsReply &reply,
+                           const std::function<void(const ray::Status &)> &callback);
+
+  /// Update the restore stats once an object is restored.
+  ///
+  /// \param object_id The restored object.
+  /// \param restored_bytes The number of bytes restored.
+  /// \param start_time The time the restore started, in nanoseconds.
+  void OnObjectRestored(const ObjectID &object_id,
+                        int64_t restored_bytes,
+                        int64_t start_time);
+
   /// Release an object that has been freed by its owner.
   void ReleaseFreedObject(const ObjectID &object_id);
 
@@ -311,6 +344,19 @@ class LocalObjectManager {
   /// The object directory interface to access object information.
   IObjectDirectory *object_directory_;
 
+  /// If not null, objects are spilled and deleted natively instead of on IO workers.
+  std::unique_ptr<NativeObjectSpiller> native_spiller_;
+
+  /// If not null, and objects are spilled natively, locally spilled objects are
+  /// restored with this callback instead of on IO workers.
+  RestoreSpilledObjectCallback restore_spilled_object_natively_;
+
+  /// If not null, returns the number of queued tasks and workers waiting on an object.
+  /// Objects are then chosen to spill by least demand, and then largest first, instead
+  /// of in the order of the pinned objects, so that objects about to be used aren't
+  /// spilled and read back.
+  std::function<int64_t(const ray::ObjectID &)> get_object_demand_;
+
   ///
   /// Stats
   ///
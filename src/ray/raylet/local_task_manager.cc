@@ -17,6 +17,8 @@
 #include <google/protobuf/map.h>
 
 #include <boost/range/join.hpp>
+#include <functional>
+#include <queue>
 
 #include "ray/stats/metric_defs.h"
 #include "ray/util/logging.h"
@@ -52,7 +54,15 @@ LocalTaskManager::LocalTaskManager(
       get_time_ms_(get_time_ms),
       sched_cls_cap_enabled_(RayConfig::instance().worker_cap_enabled()),
       sched_cls_cap_interval_ms_(sched_cls_cap_interval_ms),
-      sched_cls_cap_max_ms_(RayConfig::instance().worker_cap_max_backoff_delay_ms()) {}
+      sched_cls_cap_max_ms_(RayConfig::instance().worker_cap_max_backoff_delay_ms()),
+      skip_resource_blocked_queues_(
+          RayConfig::instance().skip_resource_blocked_dispatch_queues()),
+      fair_share_tenant_key_(RayConfig::instance().scheduler_fair_share_tenant_key()) {
+  if (RayConfig::instance().scheduler_fair_share()) {
+    fair_share_ = std::make_unique<FairShareTracker>(
+        RayConfig::instance().scheduler_fair_share_weights());
+  }
+}
 
 void LocalTaskManager::QueueAndScheduleTask(std::shared_ptr<internal::Work> work) {
   WaitForTaskArgsRequests(work);
@@ -86,6 +96,18 @@ bool LocalTaskManager::WaitForTaskArgsRequests(std::shared_ptr<internal::Work> w
   return can_dispatch;
 }
 
+void LocalTaskManager::PrefetchTaskArgs(
+    const std::vector<std::shared_ptr<internal::Work>> &works) {
+  absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> tasks;
+  for (const auto &work : works) {
+    const auto &task = work->task;
+    if (!task.GetDependencies().empty()) {
+      tasks.emplace(task.GetTaskSpecification().TaskId(), task.GetDependencies());
+    }
+  }
+  task_dependency_manager_.PrefetchTaskDependencies(tasks);
+}
+
 void LocalTaskManager::ScheduleAndDispatchTasks() {
   DispatchScheduledTasksToWorkers();
   // TODO(swang): Spill from waiting queue first? Otherwise, we may end up
@@ -97,199 +119,306 @@ void LocalTaskManager::ScheduleAndDispatchTasks() {
 }
 
 void LocalTaskManager::DispatchScheduledTasksToWorkers() {
+  if (under_memory_pressure_ && !leased_workers_.empty()) {
+    RAY_LOG_EVERY_MS(INFO, 10000)
+        << "The node is running out of memory, not dispatching more tasks.";
+    return;
+  }
+
   // Check every task in task_to_dispatch queue to see
   // whether it can be dispatched and ran. This avoids head-of-line
   // blocking where a task which cannot be dispatched because
   // there are not enough available resources blocks other
   // tasks from being dispatched.
-  for (auto shapes_it = tasks_to_dispatch_.begin();
-       shapes_it != tasks_to_dispatch_.end();) {
-    auto &scheduling_class = shapes_it->first;
-    auto &dispatch_queue = shapes_it->second;
+  if (fair_share_ == nullptr) {
+    for (auto shapes_it = tasks_to_dispatch_.begin();
+         shapes_it != tasks_to_dispatch_.end();) {
+      // Dispatching may erase the class from the map, which only invalidates the
+      // iterators to it.
+      auto scheduling_class = (shapes_it++)->first;
+      DispatchScheduledTasksOfClass(scheduling_class,
+                                    std::numeric_limits<size_t>::max());
+    }
+    return;
+  }
 
-    if (info_by_sched_cls_.find(scheduling_class) == info_by_sched_cls_.end()) {
-      // Initialize the class info.
-      info_by_sched_cls_.emplace(
-          scheduling_class,
-          SchedulingClassInfo(MaxRunningTasksPerSchedulingClass(scheduling_class)));
+  // With fair share scheduling, dispatch one task at a time from the queue whose
+  // tenant holds the smallest dominant share, so that a tenant with a large backlog
+  // doesn't starve the others. Dispatching only increases the share of a tenant, so a
+  // queue whose share grew since it was pushed is pushed back when it's popped.
+  NodeResources local_resources;
+  if (cluster_resource_scheduler_->GetClusterResourceManager().GetNodeResources(
+          scheduling::NodeID(self_node_id_.Binary()), &local_resources)) {
+    fair_share_->SetTotalResources(local_resources.total);
+  }
+  using QueueShare = std::pair<double, SchedulingClass>;
+  std::priority_queue<QueueShare, std::vector<QueueShare>, std::greater<QueueShare>>
+      queues;
+  for (const auto &entry : tasks_to_dispatch_) {
+    queues.emplace(GetFairShareOfQueue(entry.second), entry.first);
+  }
+  while (!queues.empty()) {
+    const auto [share, scheduling_class] = queues.top();
+    queues.pop();
+    auto it = tasks_to_dispatch_.find(scheduling_class);
+    if (it == tasks_to_dispatch_.end()) {
+      continue;
     }
-    auto &sched_cls_info = info_by_sched_cls_.at(scheduling_class);
-
-    /// We cap the maximum running tasks of a scheduling class to avoid
-    /// scheduling too many tasks of a single type/depth, when there are
-    /// deeper/other functions that should be run. We need to apply back
-    /// pressure to limit the number of worker processes started in scenarios
-    /// with nested tasks.
-    bool is_infeasible = false;
-    for (auto work_it = dispatch_queue.begin(); work_it != dispatch_queue.end();) {
-      auto &work = *work_it;
-      const auto &task = work->task;
-      const auto spec = task.GetTaskSpecification();
-      TaskID task_id = spec.TaskId();
-      if (work->GetState() == internal::WorkStatus::WAITING_FOR_WORKER) {
-        work_it++;
-        continue;
-      }
+    const double current_share = GetFairShareOfQueue(it->second);
+    if (current_share > share) {
+      queues.emplace(current_share, scheduling_class);
+      continue;
+    }
+    if (DispatchScheduledTasksOfClass(scheduling_class, 1) == 0) {
+      continue;
+    }
+    it = tasks_to_dispatch_.find(scheduling_class);
+    if (it != tasks_to_dispatch_.end()) {
+      queues.emplace(GetFairShareOfQueue(it->second), scheduling_class);
+    }
+  }
+}
 
-      // Check if the scheduling class is at capacity now.
-      if (sched_cls_cap_enabled_ &&
-          sched_cls_info.running_tasks.size() >= sched_cls_info.capacity &&
-          work->GetState() == internal::WorkStatus::WAITING) {
-        RAY_LOG(DEBUG) << "Hit cap! time=" << get_time_ms_()
-                       << " next update time=" << sched_cls_info.next_update_time;
-        if (get_time_ms_() < sched_cls_info.next_update_time) {
-          // We're over capacity and it's not time to admit a new task yet.
-          // Calculate the next time we should admit a new task.
-          int64_t current_capacity = sched_cls_info.running_tasks.size();
-          int64_t allowed_capacity = sched_cls_info.capacity;
-          int64_t exp = current_capacity - allowed_capacity;
-          int64_t wait_time = sched_cls_cap_interval_ms_ * (1L << exp);
-          if (wait_time > sched_cls_cap_max_ms_) {
-            wait_time = sched_cls_cap_max_ms_;
-            RAY_LOG(WARNING) << "Starting too many worker processes for a single type of "
-                                "task. Worker process startup is being throttled.";
-          }
-
-          int64_t target_time = get_time_ms_() + wait_time;
-          sched_cls_info.next_update_time =
-              std::min(target_time, sched_cls_info.next_update_time);
-          break;
-        }
+size_t LocalTaskManager::DispatchScheduledTasksOfClass(SchedulingClass scheduling_class,
+                                                       size_t max_dispatched) {
+  const auto &cluster_resource_manager =
+      cluster_resource_scheduler_->GetClusterResourceManager();
+  auto &dispatch_queue = tasks_to_dispatch_.at(scheduling_class);
+  size_t num_dispatched = 0;
+  if (skip_resource_blocked_queues_) {
+    // The tasks of a scheduling class need the same resources, so the queue is
+    // still blocked if nothing changed since it got blocked.
+    auto blocked_it = resource_blocked_classes_.find(scheduling_class);
+    if (blocked_it != resource_blocked_classes_.end()) {
+      if (blocked_it->second.resource_view_version ==
+              cluster_resource_manager.GetResourceViewVersion() &&
+          blocked_it->second.num_task_args_released == num_task_args_released_) {
+        return 0;
       }
+      resource_blocked_classes_.erase(blocked_it);
+    }
+  }
 
-      bool args_missing = false;
-      bool success = PinTaskArgsIfMemoryAvailable(spec, &args_missing);
-      // An argument was evicted since this task was added to the dispatch
-      // queue. Move it back to the waiting queue. The caller is responsible
-      // for notifying us when the task is unblocked again.
-      if (!success) {
-        if (args_missing) {
-          // Insert the task at the head of the waiting queue because we
-          // prioritize spilling from the end of the queue.
-          // TODO(scv119): where does pulling happen?
-          auto it = waiting_task_queue_.insert(waiting_task_queue_.begin(),
-                                               std::move(*work_it));
-          RAY_CHECK(waiting_tasks_index_.emplace(task_id, it).second);
-          work_it = dispatch_queue.erase(work_it);
-        } else {
-          // The task's args cannot be pinned due to lack of memory. We should
-          // retry dispatching the task once another task finishes and releases
-          // its arguments.
-          RAY_LOG(DEBUG) << "Dispatching task " << task_id
-                         << " would put this node over the max memory allowed for "
-                            "arguments of executing tasks ("
-                         << max_pinned_task_arguments_bytes_
-                         << "). Waiting to dispatch task until other tasks complete";
-          RAY_CHECK(!executing_task_args_.empty() && !pinned_task_arguments_.empty())
-              << "Cannot dispatch task " << task_id
-              << " until another task finishes and releases its arguments, but no other "
-                 "task is running";
-          work->SetStateWaiting(
-              internal::UnscheduledWorkCause::WAITING_FOR_AVAILABLE_PLASMA_MEMORY);
-          work_it++;
+  if (info_by_sched_cls_.find(scheduling_class) == info_by_sched_cls_.end()) {
+    // Initialize the class info.
+    info_by_sched_cls_.emplace(
+        scheduling_class,
+        SchedulingClassInfo(MaxRunningTasksPerSchedulingClass(scheduling_class)));
+  }
+  auto &sched_cls_info = info_by_sched_cls_.at(scheduling_class);
+
+  /// We cap the maximum running tasks of a scheduling class to avoid
+  /// scheduling too many tasks of a single type/depth, when there are
+  /// deeper/other functions that should be run. We need to apply back
+  /// pressure to limit the number of worker processes started in scenarios
+  /// with nested tasks.
+  bool is_infeasible = false;
+  for (auto work_it = dispatch_queue.begin(); work_it != dispatch_queue.end();) {
+    auto &work = *work_it;
+    if (work->GetState() == internal::WorkStatus::WAITING_FOR_WORKER) {
+      work_it++;
+      continue;
+    }
+    const auto &task = work->task;
+    const auto spec = task.GetTaskSpecification();
+    TaskID task_id = spec.TaskId();
+
+    // Check if the scheduling class is at capacity now.
+    if (sched_cls_cap_enabled_ &&
+        sched_cls_info.running_tasks.size() >= sched_cls_info.capacity &&
+        work->GetState() == internal::WorkStatus::WAITING) {
+      RAY_LOG(DEBUG) << "Hit cap! time=" << get_time_ms_()
+                     << " next update time=" << sched_cls_info.next_update_time;
+      if (get_time_ms_() < sched_cls_info.next_update_time) {
+        // We're over capacity and it's not time to admit a new task yet.
+        // Calculate the next time we should admit a new task.
+        int64_t current_capacity = sched_cls_info.running_tasks.size();
+        int64_t allowed_capacity = sched_cls_info.capacity;
+        int64_t exp = current_capacity - allowed_capacity;
+        int64_t wait_time = sched_cls_cap_interval_ms_ * (1L << exp);
+        if (wait_time > sched_cls_cap_max_ms_) {
+          wait_time = sched_cls_cap_max_ms_;
+          RAY_LOG(WARNING) << "Starting too many worker processes for a single type of "
+                              "task. Worker process startup is being throttled.";
         }
-        continue;
-      }
 
-      const auto owner_worker_id = WorkerID::FromBinary(spec.CallerAddress().worker_id());
-      const auto owner_node_id = NodeID::FromBinary(spec.CallerAddress().raylet_id());
-
-      // If the owner has died since this task was queued, cancel the task by
-      // killing the worker (unless this task is for a detached actor).
-      if (!spec.IsDetachedActor() && !is_owner_alive_(owner_worker_id, owner_node_id)) {
-        RAY_LOG(WARNING) << "RayTask: " << task.GetTaskSpecification().TaskId()
-                         << "'s caller is no longer running. Cancelling task.";
-        if (!spec.GetDependencies().empty()) {
-          task_dependency_manager_.RemoveTaskDependencies(task_id);
-        }
-        ReleaseTaskArgs(task_id);
-        work_it = dispatch_queue.erase(work_it);
-        continue;
+        int64_t target_time = get_time_ms_() + wait_time;
+        sched_cls_info.next_update_time =
+            std::min(target_time, sched_cls_info.next_update_time);
+        break;
       }
+    }
 
-      // Check if the node is still schedulable. It may not be if dependency resolution
-      // took a long time.
-      auto allocated_instances = std::make_shared<TaskResourceInstances>();
-      bool schedulable =
-          cluster_resource_scheduler_->GetLocalResourceManager()
-              .AllocateLocalTaskResources(spec.GetRequiredResources().GetResourceMap(),
-                                          allocated_instances);
-
-      if (!schedulable) {
-        ReleaseTaskArgs(task_id);
-        // The local node currently does not have the resources to run the task, so we
-        // should try spilling to another node.
-        bool did_spill = TrySpillback(work, is_infeasible);
-        if (!did_spill) {
-          // There must not be any other available nodes in the cluster, so the task
-          // should stay on this node. We can skip the rest of the shape because the
-          // scheduler will make the same decision.
-          work->SetStateWaiting(
-              internal::UnscheduledWorkCause::WAITING_FOR_RESOURCES_AVAILABLE);
-          break;
-        }
-        num_unschedulable_task_spilled_++;
-        if (!spec.GetDependencies().empty()) {
-          task_dependency_manager_.RemoveTaskDependencies(
-              task.GetTaskSpecification().TaskId());
-        }
+    bool args_missing = false;
+    bool success = PinTaskArgsIfMemoryAvailable(spec, &args_missing);
+    // An argument was evicted since this task was added to the dispatch
+    // queue. Move it back to the waiting queue. The caller is responsible
+    // for notifying us when the task is unblocked again.
+    if (!success) {
+      if (args_missing) {
+        // Insert the task at the head of the waiting queue because we
+        // prioritize spilling from the end of the queue.
+        // TODO(scv119): where does pulling happen?
+        auto it = waiting_task_queue_.insert(waiting_task_queue_.begin(),
+                                             std::move(*work_it));
+        RAY_CHECK(waiting_tasks_index_.emplace(task_id, it).second);
         work_it = dispatch_queue.erase(work_it);
       } else {
-        // Force us to recalculate the next update time the next time a task
-        // comes through this queue. We should only do this when we're
-        // confident we're ready to dispatch the task after all checks have
-        // passed.
-        sched_cls_info.next_update_time = std::numeric_limits<int64_t>::max();
-        sched_cls_info.running_tasks.insert(spec.TaskId());
-        // The local node has the available resources to run the task, so we should run
-        // it.
-        std::string allocated_instances_serialized_json = "{}";
-        if (RayConfig::instance().worker_resource_limits_enabled()) {
-          allocated_instances_serialized_json = allocated_instances->SerializeAsJson();
-        }
-        work->allocated_instances = allocated_instances;
-        work->SetStateWaitingForWorker();
-        bool is_detached_actor = spec.IsDetachedActor();
-        auto &owner_address = spec.CallerAddress();
-        /// TODO(scv119): if a worker is not started, the resources is leaked and
-        // task might be hanging.
-        worker_pool_.PopWorker(
-            spec,
-            [this, task_id, scheduling_class, work, is_detached_actor, owner_address](
-                const std::shared_ptr<WorkerInterface> worker,
-                PopWorkerStatus status,
-                const std::string &runtime_env_setup_error_message) -> bool {
-              return PoppedWorkerHandler(worker,
-                                         status,
-                                         task_id,
-                                         scheduling_class,
-                                         work,
-                                         is_detached_actor,
-                                         owner_address,
-                                         runtime_env_setup_error_message);
-            },
-            allocated_instances_serialized_json);
+        // The task's args cannot be pinned due to lack of memory. We should
+        // retry dispatching the task once another task finishes and releases
+        // its arguments.
+        RAY_LOG(DEBUG) << "Dispatching task " << task_id
+                       << " would put this node over the max memory allowed for "
+                          "arguments of executing tasks ("
+                       << max_pinned_task_arguments_bytes_
+                       << "). Waiting to dispatch task until other tasks complete";
+        RAY_CHECK(!executing_task_args_.empty() && !pinned_task_arguments_.empty())
+            << "Cannot dispatch task " << task_id
+            << " until another task finishes and releases its arguments, but no other "
+               "task is running";
+        work->SetStateWaiting(
+            internal::UnscheduledWorkCause::WAITING_FOR_AVAILABLE_PLASMA_MEMORY);
         work_it++;
       }
+      continue;
     }
-    // In the beginning of the loop, we add scheduling_class
-    // to the `info_by_sched_cls_` map.
-    // In cases like dead owners, we may not add any tasks
-    // to `running_tasks` so we can remove the map entry
-    // for that scheduling_class to prevent memory leaks.
-    if (sched_cls_info.running_tasks.size() == 0) {
-      info_by_sched_cls_.erase(scheduling_class);
+
+    const auto owner_worker_id = WorkerID::FromBinary(spec.CallerAddress().worker_id());
+    const auto owner_node_id = NodeID::FromBinary(spec.CallerAddress().raylet_id());
+
+    // If the owner has died since this task was queued, cancel the task by
+    // killing the worker (unless this task is for a detached actor).
+    if (!spec.IsDetachedActor() && !is_owner_alive_(owner_worker_id, owner_node_id)) {
+      RAY_LOG(WARNING) << "RayTask: " << task.GetTaskSpecification().TaskId()
+                       << "'s caller is no longer running. Cancelling task.";
+      if (!spec.GetDependencies().empty()) {
+        task_dependency_manager_.RemoveTaskDependencies(task_id);
+      }
+      ReleaseTaskArgs(task_id);
+      work_it = dispatch_queue.erase(work_it);
+      continue;
     }
-    if (is_infeasible) {
-      // TODO(scv119): fail the request.
-      // Call CancelTask
-      tasks_to_dispatch_.erase(shapes_it++);
-    } else if (dispatch_queue.empty()) {
-      tasks_to_dispatch_.erase(shapes_it++);
+
+    // Check if the node is still schedulable. It may not be if dependency resolution
+    // took a long time.
+    auto allocated_instances = std::make_shared<TaskResourceInstances>();
+    bool schedulable =
+        cluster_resource_scheduler_->GetLocalResourceManager()
+            .AllocateLocalTaskResources(spec.GetRequiredResources().GetResourceMap(),
+                                        allocated_instances);
+
+    if (!schedulable) {
+      ReleaseTaskArgs(task_id);
+      // The local node currently does not have the resources to run the task, so we
+      // should try spilling to another node.
+      bool did_spill = TrySpillback(work, is_infeasible);
+      if (!did_spill) {
+        // There must not be any other available nodes in the cluster, so the task
+        // should stay on this node. We can skip the rest of the shape because the
+        // scheduler will make the same decision.
+        work->SetStateWaiting(
+            internal::UnscheduledWorkCause::WAITING_FOR_RESOURCES_AVAILABLE);
+        if (skip_resource_blocked_queues_ && !is_infeasible) {
+          resource_blocked_classes_[scheduling_class] = {
+              cluster_resource_manager.GetResourceViewVersion(),
+              num_task_args_released_};
+        }
+        break;
+      }
+      num_unschedulable_task_spilled_++;
+      if (!spec.GetDependencies().empty()) {
+        task_dependency_manager_.RemoveTaskDependencies(
+            task.GetTaskSpecification().TaskId());
+      }
+      work_it = dispatch_queue.erase(work_it);
     } else {
-      shapes_it++;
+      // Force us to recalculate the next update time the next time a task
+      // comes through this queue. We should only do this when we're
+      // confident we're ready to dispatch the task after all checks have
+      // passed.
+      sched_cls_info.next_update_time = std::numeric_limits<int64_t>::max();
+      sched_cls_info.running_tasks.insert(spec.TaskId());
+      if (fair_share_ != nullptr) {
+        fair_share_->AddTask(
+            task_id,
+            GetFairShareTenant(spec.JobId()),
+            ResourceMapToResourceRequest(spec.GetRequiredResources().GetResourceMap(),
+                                         /*requires_object_store_memory=*/false));
+      }
+      // The local node has the available resources to run the task, so we should run
+      // it.
+      std::string allocated_instances_serialized_json = "{}";
+      if (RayConfig::instance().worker_resource_limits_enabled()) {
+        allocated_instances_serialized_json = allocated_instances->SerializeAsJson();
+      }
+      work->allocated_instances = allocated_instances;
+      work->SetStateWaitingForWorker();
+      bool is_detached_actor = spec.IsDetachedActor();
+      auto &owner_address = spec.CallerAddress();
+      /// TODO(scv119): if a worker is not started, the resources is leaked and
+      // task might be hanging.
+      worker_pool_.PopWorker(
+          spec,
+          [this, task_id, scheduling_class, work, is_detached_actor, owner_address](
+              const std::shared_ptr<WorkerInterface> worker,
+              PopWorkerStatus status,
+              const std::string &runtime_env_setup_error_message) -> bool {
+            return PoppedWorkerHandler(worker,
+                                       status,
+                                       task_id,
+                                       scheduling_class,
+                                       work,
+                                       is_detached_actor,
+                                       owner_address,
+                                       runtime_env_setup_error_message);
+          },
+          allocated_instances_serialized_json);
+      work_it++;
+      if (++num_dispatched >= max_dispatched) {
+        break;
+      }
     }
   }
+  // In the beginning of the loop, we add scheduling_class
+  // to the `info_by_sched_cls_` map.
+  // In cases like dead owners, we may not add any tasks
+  // to `running_tasks` so we can remove the map entry
+  // for that scheduling_class to prevent memory leaks.
+  if (sched_cls_info.running_tasks.size() == 0) {
+    info_by_sched_cls_.erase(scheduling_class);
+  }
+  if (is_infeasible) {
+    // TODO(scv119): fail the request.
+    // Call CancelTask
+    resource_blocked_classes_.erase(scheduling_class);
+    tasks_to_dispatch_.erase(scheduling_class);
+  } else if (dispatch_queue.empty()) {
+    resource_blocked_classes_.erase(scheduling_class);
+    tasks_to_dispatch_.erase(scheduling_class);
+  }
+  return num_dispatched;
+}
+
+std::string LocalTaskManager::GetFairShareTenant(const JobID &job_id) const {
+  if (!fair_share_tenant_key_.empty()) {
+    auto job_config = worker_pool_.GetJobConfig(job_id);
+    if (job_config) {
+      auto it = job_config->metadata().find(fair_share_tenant_key_);
+      if (it != job_config->metadata().end()) {
+        return it->second;
+      }
+    }
+  }
+  return job_id.Hex();
+}
+
+double LocalTaskManager::GetFairShareOfQueue(
+    const std::deque<std::shared_ptr<internal::Work>> &dispatch_queue) const {
+  if (dispatch_queue.empty()) {
+    return 0;
+  }
+  return fair_share_->GetShare(
+      GetFairShareTenant(dispatch_queue.front()->task.GetTaskSpecification().JobId()));
 }
 
 void LocalTaskManager::SpillWaitingTasks() {
@@ -442,6 +571,7 @@ bool LocalTaskManager::PoppedWorkerHandler(
       }
     }
     if (dispatch_queue.empty()) {
+      resource_blocked_classes_.erase(scheduling_class);
       tasks_to_dispatch_.erase(shapes_it);
     }
     RAY_CHECK(erased);
@@ -589,6 +719,9 @@ void LocalTaskManager::TasksUnblocked(const std::vector<TaskID> &ready_ids) {
 }
 
 void LocalTaskManager::RemoveFromRunningTasksIfExists(const RayTask &task) {
+  if (fair_share_ != nullptr) {
+    fair_share_->RemoveTask(task.GetTaskSpecification().TaskId());
+  }
   auto sched_cls = task.GetTaskSpecification().GetSchedulingClass();
   auto it = info_by_sched_cls_.find(sched_cls);
   if (it != info_by_sched_cls_.end()) {
@@ -614,58 +747,78 @@ void LocalTaskManager::TaskFinished(std::shared_ptr<WorkerInterface> worker,
 // TODO(scv119): task args related logic probaly belongs task dependency manager.
 bool LocalTaskManager::PinTaskArgsIfMemoryAvailable(const TaskSpecification &spec,
                                                     bool *args_missing) {
-  std::vector<std::unique_ptr<RayObject>> args;
   const auto &deps = spec.GetDependencyIds();
-  if (!deps.empty()) {
+  std::vector<std::unique_ptr<RayObject>> args(deps.size());
+  // Arguments that are already pinned for other tasks are shared with them, so
+  // only the others need to be fetched from plasma.
+  std::vector<ObjectID> unpinned_deps;
+  std::vector<size_t> unpinned_indices;
+  for (size_t i = 0; i < deps.size(); i++) {
+    if (!pinned_task_arguments_.contains(deps[i])) {
+      unpinned_deps.push_back(deps[i]);
+      unpinned_indices.push_back(i);
+    }
+  }
+  if (!unpinned_deps.empty()) {
     // This gets refs to the arguments stored in plasma. The refs should be
     // deleted once we no longer need to pin the arguments.
-    if (!get_task_arguments_(deps, &args)) {
+    std::vector<std::unique_ptr<RayObject>> unpinned_args;
+    if (!get_task_arguments_(unpinned_deps, &unpinned_args)) {
       *args_missing = true;
       return false;
     }
-    for (size_t i = 0; i < deps.size(); i++) {
-      if (args[i] == nullptr) {
+    for (size_t i = 0; i < unpinned_deps.size(); i++) {
+      if (unpinned_args[i] == nullptr) {
         // This can happen if the task's arguments were all local at some
         // point, but then at least one was evicted before the task could
         // be dispatched to a worker.
         RAY_LOG(DEBUG)
-            << "RayTask " << spec.TaskId() << " argument " << deps[i]
+            << "RayTask " << spec.TaskId() << " argument " << unpinned_deps[i]
             << " was evicted before the task could be dispatched. This can happen "
                "when there are many objects needed on this node. The task will be "
                "scheduled once all of its dependencies are local.";
         *args_missing = true;
         return false;
       }
+      args[unpinned_indices[i]] = std::move(unpinned_args[i]);
     }
   }
 
   *args_missing = false;
   size_t task_arg_bytes = 0;
-  for (auto &arg : args) {
-    task_arg_bytes += arg->GetSize();
+  // The bytes that pinning the arguments of this task would add.
+  size_t new_pinned_bytes = 0;
+  absl::flat_hash_set<ObjectID> new_pinned_args;
+  for (size_t i = 0; i < deps.size(); i++) {
+    if (args[i] == nullptr) {
+      task_arg_bytes += pinned_task_arguments_.at(deps[i]).first->GetSize();
+    } else {
+      task_arg_bytes += args[i]->GetSize();
+      if (new_pinned_args.insert(deps[i]).second) {
+        new_pinned_bytes += args[i]->GetSize();
+      }
+    }
   }
   RAY_LOG(DEBUG) << "RayTask " << spec.TaskId() << " has args of size " << task_arg_bytes;
-  PinTaskArgs(spec, std::move(args));
-  RAY_LOG(DEBUG) << "Size of pinned task args is now " << pinned_task_arguments_bytes_;
-  if (max_pinned_task_arguments_bytes_ == 0) {
-    // Max threshold for pinned args is not set.
-    return true;
-  }
 
-  if (task_arg_bytes > max_pinned_task_arguments_bytes_) {
-    RAY_LOG(WARNING)
-        << "Dispatched task " << spec.TaskId() << " has arguments of size "
-        << task_arg_bytes
-        << ", but the max memory allowed for arguments of executing tasks is only "
-        << max_pinned_task_arguments_bytes_;
-  } else if (pinned_task_arguments_bytes_ > max_pinned_task_arguments_bytes_) {
-    ReleaseTaskArgs(spec.TaskId());
-    RAY_LOG(DEBUG) << "Cannot dispatch task " << spec.TaskId()
-                   << " with arguments of size " << task_arg_bytes
-                   << " current pinned bytes is " << pinned_task_arguments_bytes_;
-    return false;
+  if (max_pinned_task_arguments_bytes_ > 0) {
+    if (task_arg_bytes > max_pinned_task_arguments_bytes_) {
+      RAY_LOG(WARNING)
+          << "Dispatched task " << spec.TaskId() << " has arguments of size "
+          << task_arg_bytes
+          << ", but the max memory allowed for arguments of executing tasks is only "
+          << max_pinned_task_arguments_bytes_;
+    } else if (pinned_task_arguments_bytes_ + new_pinned_bytes >
+               max_pinned_task_arguments_bytes_) {
+      RAY_LOG(DEBUG) << "Cannot dispatch task " << spec.TaskId()
+                     << " with arguments of size " << task_arg_bytes
+                     << " current pinned bytes is " << pinned_task_arguments_bytes_;
+      return false;
+    }
   }
 
+  PinTaskArgs(spec, std::move(args));
+  RAY_LOG(DEBUG) << "Size of pinned task args is now " << pinned_task_arguments_bytes_;
   return true;
 }
 
@@ -678,10 +831,12 @@ void LocalTaskManager::PinTaskArgs(const TaskSpecification &spec,
   auto inserted = executing_task_args_.emplace(spec.TaskId(), deps).second;
   if (inserted) {
     for (size_t i = 0; i < deps.size(); i++) {
+      // The arguments that are already pinned are null in `args`.
       auto inserted =
           pinned_task_arguments_.emplace(deps[i], std::make_pair(std::move(args[i]), 0));
       auto it = inserted.first;
       if (inserted.second) {
+        RAY_CHECK(it->second.first != nullptr);
         // This is the first task that needed this argument.
         pinned_task_arguments_bytes_ += it->second.first->GetSize();
       }
@@ -711,6 +866,7 @@ void LocalTaskManager::ReleaseTaskArgs(const TaskID &task_id) {
       }
     }
     executing_task_args_.erase(it);
+    num_task_args_released_++;
   }
 }
 
@@ -754,6 +910,7 @@ bool LocalTaskManager::CancelTask(
         (*work_it)->SetStateCancelled();
         work_queue.erase(work_it);
         if (work_queue.empty()) {
+          resource_blocked_classes_.erase(shapes_it->first);
           tasks_to_dispatch_.erase(shapes_it);
         }
         return true;
@@ -844,6 +1001,9 @@ void LocalTaskManager::Dispatch(
   }
   worker->AssignTaskId(task_spec.TaskId());
   worker->SetAssignedTask(task);
+  if (cpu_pinning_) {
+    cpu_pinning_->PinLeasedWorker(worker->GetProcess().GetId(), *allocated_instances);
+  }
 
   // Pass the contact info of the worker to use.
   reply->set_worker_pid(worker->GetProcess().GetId());
@@ -1032,9 +1192,27 @@ uint64_t LocalTaskManager::MaxRunningTasksPerSchedulingClass(
 void LocalTaskManager::RecordMetrics() const {
   ray::stats::STATS_scheduler_tasks.Record(executing_task_args_.size(), "Executing");
   ray::stats::STATS_scheduler_tasks.Record(waiting_tasks_index_.size(), "Waiting");
+  if (fair_share_ != nullptr) {
+    const auto shares = fair_share_->GetShares();
+    for (auto it = reported_fair_share_tenants_.begin();
+         it != reported_fair_share_tenants_.end();) {
+      if (!shares.contains(*it)) {
+        ray::stats::STATS_scheduler_tenant_dominant_share.Record(0, {{"Tenant", *it}});
+        reported_fair_share_tenants_.erase(it++);
+      } else {
+        it++;
+      }
+    }
+    for (const auto &entry : shares) {
+      ray::stats::STATS_scheduler_tenant_dominant_share.Record(entry.second,
+                                                               {{"Tenant", entry.first}});
+      reported_fair_share_tenants_.insert(entry.first);
+    }
+    ray::stats::STATS_scheduler_fairness_index.Record(fair_share_->GetFairnessIndex());
+  }
 }
 
-void LocalTaskManager::DebugStr(std::stringstream &buffer) const {
+void LocalTaskManager::DebugStr(std::stringstream &buffer, bool full) const {
   buffer << "Waiting tasks size: " << waiting_tasks_index_.size() << "\n";
   buffer << "Number of executing tasks: " << executing_task_args_.size() << "\n";
   buffer << "Number of pinned task arguments: " << pinned_task_arguments_.size() << "\n";
@@ -1042,6 +1220,21 @@ void LocalTaskManager::DebugStr(std::stringstream &buffer) const {
   buffer << "Number of spilled waiting tasks: " << num_waiting_task_spilled_ << "\n";
   buffer << "Number of spilled unschedulable tasks: " << num_unschedulable_task_spilled_
          << "\n";
+  if (full) {
+    DebugStrResourceUsage(buffer);
+  }
+  buffer << "Running tasks by scheduling class:\n";
+
+  for (const auto &pair : info_by_sched_cls_) {
+    const auto &sched_cls = pair.first;
+    const auto &info = pair.second;
+    const auto &descriptor = TaskSpecification::GetSchedulingClassDescriptor(sched_cls);
+    buffer << "    - " << descriptor.DebugString() << ": " << info.running_tasks.size()
+           << "/" << info.capacity << "\n";
+  }
+}
+
+void LocalTaskManager::DebugStrResourceUsage(std::stringstream &buffer) const {
   buffer << "Resource usage {\n";
 
   // Calculates how much resources are occupied by tasks or actors.
@@ -1078,15 +1271,6 @@ void LocalTaskManager::DebugStr(std::stringstream &buffer) const {
            << "\n";
   }
   buffer << "}\n";
-  buffer << "Running tasks by scheduling class:\n";
-
-  for (const auto &pair : info_by_sched_cls_) {
-    const auto &sched_cls = pair.first;
-    const auto &info = pair.second;
-    const auto &descriptor = TaskSpecification::GetSchedulingClassDescriptor(sched_cls);
-    buffer << "    - " << descriptor.DebugString() << ": " << info.running_tasks.size()
-           << "/" << info.capacity << "\n";
-  }
 }
 
 }  // namespace raylet
@@ -22,9 +22,11 @@
 #include "ray/raylet/dependency_manager.h"
 #include "ray/raylet/scheduling/cluster_resource_scheduler.h"
 #include "ray/raylet/scheduling/cluster_task_manager_interface.h"
+#include "ray/raylet/scheduling/fair_share.h"
 #include "ray/raylet/scheduling/internal.h"
 #include "ray/raylet/scheduling/local_task_manager_interface.h"
 #include "ray/raylet/worker.h"
+#include "ray/raylet/worker_cpu_pinning.h"
 #include "ray/raylet/worker_pool.h"
 #include "ray/rpc/grpc_client.h"
 #include "ray/rpc/node_manager/node_manager_client.h"
@@ -97,6 +99,9 @@ class LocalTaskManager : public ILocalTaskManager {
   // Schedule and dispatch tasks.
   void ScheduleAndDispatchTasks() override;
 
+  void PrefetchTaskArgs(
+      const std::vector<std::shared_ptr<internal::Work>> &works) override;
+
   /// Move tasks from waiting to ready for dispatch. Called when a task's
   /// dependencies are resolved.
   ///
@@ -168,6 +173,17 @@ class LocalTaskManager : public ILocalTaskManager {
 
   void ClearWorkerBacklog(const WorkerID &worker_id);
 
+  /// Set whether the node is running out of memory. While it is, no more tasks are
+  /// dispatched, unless none are running, so that the node still makes progress.
+  void SetUnderMemoryPressure(bool under_memory_pressure) {
+    under_memory_pressure_ = under_memory_pressure;
+  }
+
+  /// Set the pinning of leased workers to the CPUs allocated to them.
+  void SetCpuPinning(std::shared_ptr<const WorkerCpuPinning> cpu_pinning) {
+    cpu_pinning_ = std::move(cpu_pinning);
+  }
+
   const absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
       &GetTaskToDispatch() const override {
     return tasks_to_dispatch_;
@@ -180,7 +196,10 @@ class LocalTaskManager : public ILocalTaskManager {
 
   void RecordMetrics() const override;
 
-  void DebugStr(std::stringstream &buffer) const override;
+  void DebugStr(std::stringstream &buffer, bool full) const override;
+
+  /// Dump the resources used by every worker, which is expensive on busy nodes.
+  void DebugStrResourceUsage(std::stringstream &buffer) const;
 
   size_t GetNumTaskSpilled() const override { return num_task_spilled_; }
   size_t GetNumWaitingTaskSpilled() const override { return num_waiting_task_spilled_; }
@@ -212,6 +231,24 @@ class LocalTaskManager : public ILocalTaskManager {
   /// different node.
   void DispatchScheduledTasksToWorkers();
 
+  /// Attempts to dispatch the tasks of one scheduling class, see
+  /// `DispatchScheduledTasksToWorkers`. The class is removed from
+  /// `tasks_to_dispatch_` if its queue is emptied.
+  ///
+  /// \param scheduling_class The scheduling class.
+  /// \param max_dispatched The maximum number of tasks to dispatch.
+  /// \return The number of tasks dispatched.
+  size_t DispatchScheduledTasksOfClass(SchedulingClass scheduling_class,
+                                       size_t max_dispatched);
+
+  /// Return the fair share scheduling tenant of a job.
+  std::string GetFairShareTenant(const JobID &job_id) const;
+
+  /// Return the dominant share of the tenant of the task at the head of a dispatch
+  /// queue.
+  double GetFairShareOfQueue(
+      const std::deque<std::shared_ptr<internal::Work>> &dispatch_queue) const;
+
   /// Helper method when the current node does not have the available resources to run a
   /// task.
   ///
@@ -302,6 +339,46 @@ class LocalTaskManager : public ILocalTaskManager {
   /// details about what information is tracked.
   absl::flat_hash_map<SchedulingClass, SchedulingClassInfo> info_by_sched_cls_;
 
+  /// The state in which the dispatch queue of a scheduling class got blocked
+  /// on local resources, with no other node to spill its tasks to. The queue
+  /// gets the same decision until either field changes, so it is not revisited
+  /// until then.
+  struct ResourceBlockedState {
+    /// The version of the cluster resource view.
+    uint64_t resource_view_version;
+    /// The value of `num_task_args_released_`.
+    uint64_t num_task_args_released;
+  };
+
+  /// The dispatch queues that are blocked on local resources. Only used if
+  /// `skip_resource_blocked_dispatch_queues` is set.
+  absl::flat_hash_map<SchedulingClass, ResourceBlockedState> resource_blocked_classes_;
+
+  /// The number of times that the pinned arguments of a task were released,
+  /// which may let blocked tasks pin their arguments.
+  uint64_t num_task_args_released_ = 0;
+
+  /// Whether to skip the dispatch queues in `resource_blocked_classes_`.
+  bool skip_resource_blocked_queues_;
+
+  /// Whether the node is running out of memory, see `SetUnderMemoryPressure`.
+  bool under_memory_pressure_ = false;
+
+  /// Pins leased workers to CPUs, if set.
+  std::shared_ptr<const WorkerCpuPinning> cpu_pinning_;
+
+  /// The resources held by the running tasks of every tenant. Only set if
+  /// `scheduler_fair_share` is enabled, in which case the dispatch queues are served
+  /// in the order of the dominant shares of their tenants.
+  std::unique_ptr<FairShareTracker> fair_share_;
+
+  /// The job config metadata key that names the tenant of a job, see
+  /// `scheduler_fair_share_tenant_key`.
+  const std::string fair_share_tenant_key_;
+
+  /// The tenants whose dominant share was last reported as nonzero.
+  mutable absl::flat_hash_set<std::string> reported_fair_share_tenants_;
+
   /// Queue of lease requests that should be scheduled onto workers.
   /// Tasks move from scheduled | waiting -> dispatch.
   /// Tasks can also move from dispatch -> waiting if one of their arguments is
@@ -22,8 +22,10 @@
 #include "ray/common/task/task_common.h"
 #include "ray/gcs/gcs_client/gcs_client.h"
 #include "ray/raylet/raylet.h"
+#include "ray/stats/metric_defs.h"
 #include "ray/stats/stats.h"
 #include "ray/util/event.h"
+#include "ray/util/util.h"
 
 DEFINE_string(raylet_socket_name, "", "The socket name of raylet.");
 DEFINE_string(store_socket_name, "", "The socket name of object store.");
@@ -130,6 +132,8 @@ int main(int argc, char *argv[]) {
   // as there is no more work to be processed.
   boost::asio::io_service::work main_work(main_service);
 
+  const int64_t process_start_time_ms = current_time_ms();
+
   // Initialize gcs client
   std::shared_ptr<ray::gcs::GcsClient> gcs_client;
   ray::gcs::GcsClientOptions client_options(FLAGS_gcs_address);
@@ -144,6 +148,7 @@ int main(int argc, char *argv[]) {
         RAY_CHECK_OK(status);
         RAY_CHECK(stored_raylet_config.has_value());
         RayConfig::instance().initialize(stored_raylet_config.get());
+        main_service.StartLagProbe("raylet");
 
         // Parse the worker port list.
         std::istringstream worker_port_list_string(worker_port_list);
@@ -260,8 +265,11 @@ int main(int argc, char *argv[]) {
             {ray::stats::VersionKey, kRayVersion},
             {ray::stats::NodeAddressKey, node_ip_address}};
         ray::stats::Init(global_tags, metrics_agent_port);
+        ray::stats::STATS_raylet_startup_time_ms.Record(
+            current_time_ms() - process_start_time_ms, "Config");
 
         // Initialize the node manager.
+        const int64_t init_start_time_ms = current_time_ms();
         raylet = std::make_unique<ray::raylet::Raylet>(main_service,
                                                        raylet_socket_name,
                                                        node_ip_address,
@@ -270,16 +278,19 @@ int main(int argc, char *argv[]) {
                                                        object_manager_config,
                                                        gcs_client,
                                                        metrics_export_port);
+        ray::stats::STATS_raylet_startup_time_ms.Record(
+            current_time_ms() - init_start_time_ms, "Init");
 
         // Initialize event framework.
         if (RayConfig::instance().event_log_reporter_enabled() && !log_dir.empty()) {
           ray::RayEventInit(ray::rpc::Event_SourceType::Event_SourceType_RAYLET,
                             {{"node_id", raylet->GetNodeId().Hex()}},
                             log_dir,
-                            RayConfig::instance().event_level());
+                            RayConfig::instance().event_level(),
+                            RayConfig::instance().event_log_reporter_async());
         };
 
-        raylet->Start();
+        raylet->Start(process_start_time_ms);
       }));
 
   // Destroy the Raylet on a SIGTERM. The pointer to main_service is
@@ -0,0 +1,122 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/memory_monitor.h"
+
+#include <unistd.h>
+
+#include <fstream>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+namespace {
+
+/// Read the single number in a file, e.g. a cgroup memory file.
+///
+/// \return The number, or -1 if the file can't be read or doesn't hold a number,
+/// e.g. "max" for an unlimited cgroup.
+int64_t ReadNumber(const std::string &path) {
+  std::ifstream file(path);
+  int64_t value;
+  if (!(file >> value)) {
+    return -1;
+  }
+  return value;
+}
+
+}  // namespace
+
+bool MemoryMonitor::Refresh() {
+  last_snapshot_ = take_snapshot_();
+  const bool under_pressure =
+      last_snapshot_.total_bytes > 0 &&
+      last_snapshot_.used_bytes > usage_threshold_ * last_snapshot_.total_bytes;
+  if (under_pressure != under_pressure_) {
+    RAY_LOG(INFO) << "Node memory usage is " << last_snapshot_.used_bytes << " of "
+                  << last_snapshot_.total_bytes << " bytes, "
+                  << (under_pressure ? "above" : "back below") << " the threshold of "
+                  << usage_threshold_;
+  }
+  under_pressure_ = under_pressure;
+  return under_pressure_;
+}
+
+MemorySnapshot MemoryMonitor::TakeSnapshot(const std::string &cgroup_dir,
+                                           const std::string &meminfo_path) {
+  MemorySnapshot snapshot;
+  const int64_t cgroup_limit = ReadNumber(cgroup_dir + "/memory.max");
+  const int64_t cgroup_usage = ReadNumber(cgroup_dir + "/memory.current");
+  if (cgroup_limit > 0 && cgroup_usage >= 0) {
+    snapshot.used_bytes = cgroup_usage;
+    snapshot.total_bytes = cgroup_limit;
+    return snapshot;
+  }
+
+  std::ifstream meminfo(meminfo_path);
+  std::string key;
+  int64_t value;
+  std::string unit;
+  int64_t total_kb = -1;
+  int64_t available_kb = -1;
+  while (meminfo >> key >> value >> unit) {
+    if (key == "MemTotal:") {
+      total_kb = value;
+    } else if (key == "MemAvailable:") {
+      available_kb = value;
+    }
+  }
+  if (total_kb > 0 && available_kb >= 0) {
+    snapshot.total_bytes = total_kb * 1024;
+    snapshot.used_bytes = (total_kb - available_kb) * 1024;
+  }
+  return snapshot;
+}
+
+int64_t MemoryMonitor::GetProcessRssBytes(pid_t pid) {
+  // The second field of statm is the number of resident pages.
+  std::ifstream statm("/proc/" + std::to_string(pid) + "/statm");
+  int64_t size_pages;
+  int64_t resident_pages;
+  if (!(statm >> size_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+std::shared_ptr<WorkerInterface> MemoryMonitor::SelectWorkerToKill(
+    const std::vector<std::shared_ptr<WorkerInterface>> &workers) {
+  std::shared_ptr<WorkerInterface> selected;
+  for (const auto &worker : workers) {
+    if (worker->IsDead() || worker->GetAssignedTaskId().IsNil()) {
+      continue;
+    }
+    const auto &spec = worker->GetAssignedTask().GetTaskSpecification();
+    if (!spec.IsNormalTask() || spec.GetMessage().max_retries() == 0) {
+      continue;
+    }
+    if (selected == nullptr ||
+        worker->GetAssignedTaskTime() > selected->GetAssignedTaskTime()) {
+      selected = worker;
+    }
+  }
+  return selected;
+}
+
+}  // namespace raylet
+
+}  // namespace ray
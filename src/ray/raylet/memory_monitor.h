@@ -0,0 +1,89 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ray/raylet/worker.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// The memory usage of the node.
+struct MemorySnapshot {
+  int64_t used_bytes = 0;
+  /// The memory that the node may use, or 0 if it isn't known.
+  int64_t total_bytes = 0;
+};
+
+/// \class MemoryMonitor
+/// Samples the memory usage of the node, to tell when it's about to run out of memory
+/// and workers are about to be killed by the kernel, so that the raylet can stop
+/// starting tasks and pick which worker to kill itself. The usage is read from the
+/// node's cgroup (v2) if it has a memory limit, e.g. in a container, and else from
+/// /proc/meminfo. Sampling only reads a couple of small files.
+class MemoryMonitor {
+ public:
+  /// \param usage_threshold The fraction of the node's memory above which the node
+  /// is under memory pressure.
+  /// \param take_snapshot Returns the memory usage of the node.
+  explicit MemoryMonitor(
+      float usage_threshold,
+      std::function<MemorySnapshot()> take_snapshot = [] { return TakeSnapshot(); })
+      : usage_threshold_(usage_threshold), take_snapshot_(std::move(take_snapshot)) {}
+
+  /// Sample the memory usage of the node.
+  ///
+  /// \return Whether the node is under memory pressure.
+  bool Refresh();
+
+  /// Whether the node was under memory pressure when it was last sampled.
+  bool IsUnderPressure() const { return under_pressure_; }
+
+  const MemorySnapshot &LastSnapshot() const { return last_snapshot_; }
+
+  /// Read the memory usage of the node.
+  ///
+  /// \param cgroup_dir The directory of the cgroup (v2) of the node.
+  /// \param meminfo_path The path of the node's meminfo, used if the cgroup has no
+  /// memory limit.
+  static MemorySnapshot TakeSnapshot(const std::string &cgroup_dir = "/sys/fs/cgroup",
+                                     const std::string &meminfo_path = "/proc/meminfo");
+
+  /// Read the resident memory of a process, or return 0 if it can't be read.
+  static int64_t GetProcessRssBytes(pid_t pid);
+
+  /// Pick the worker to kill to relieve memory pressure. This is the worker that was
+  /// most recently assigned a task that can be retried, so that the least work is
+  /// lost and the task runs again once there is memory for it. Actors aren't picked.
+  ///
+  /// \return The worker, or nullptr if no worker runs a task that can be retried.
+  static std::shared_ptr<WorkerInterface> SelectWorkerToKill(
+      const std::vector<std::shared_ptr<WorkerInterface>> &workers);
+
+ private:
+  const float usage_threshold_;
+  const std::function<MemorySnapshot()> take_snapshot_;
+  MemorySnapshot last_snapshot_;
+  bool under_pressure_ = false;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
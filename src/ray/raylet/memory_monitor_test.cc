@@ -0,0 +1,130 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/memory_monitor.h"
+
+#include <unistd.h>
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "ray/raylet/test/util.h"
+
+namespace ray {
+
+namespace raylet {
+
+class MemoryMonitorTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    char dir[] = "/tmp/memory_monitor_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+  }
+
+  void TearDown() override {
+    for (const auto &file : {"memory.max", "memory.current", "meminfo"}) {
+      unlink((dir_ + "/" + file).c_str());
+    }
+    rmdir(dir_.c_str());
+  }
+
+  void WriteFile(const std::string &name, const std::string &contents) {
+    std::ofstream(dir_ + "/" + name) << contents;
+  }
+
+  std::shared_ptr<MockWorker> AddWorker(rpc::TaskType type,
+                                        int max_retries,
+                                        int64_t assigned_task_time_ms) {
+    auto worker = std::make_shared<MockWorker>(WorkerID::FromRandom(), 1234);
+    rpc::TaskSpec message;
+    message.set_type(type);
+    message.set_max_retries(max_retries);
+    worker->SetAssignedTask(RayTask(TaskSpecification(message)));
+    worker->AssignTaskId(TaskID::FromRandom(JobID::FromInt(1)));
+    worker->SetAssignedTaskTime(assigned_task_time_ms);
+    workers_.push_back(worker);
+    return worker;
+  }
+
+ protected:
+  std::string dir_;
+  std::vector<std::shared_ptr<WorkerInterface>> workers_;
+};
+
+TEST_F(MemoryMonitorTest, TestSnapshotFromCgroup) {
+  WriteFile("memory.max", "1000\n");
+  WriteFile("memory.current", "600\n");
+  WriteFile("meminfo", "MemTotal: 4 kB\nMemAvailable: 1 kB\n");
+  auto snapshot = MemoryMonitor::TakeSnapshot(dir_, dir_ + "/meminfo");
+  ASSERT_EQ(snapshot.used_bytes, 600);
+  ASSERT_EQ(snapshot.total_bytes, 1000);
+}
+
+TEST_F(MemoryMonitorTest, TestSnapshotFromMeminfo) {
+  // The cgroup has no memory limit, so the node's memory is used.
+  WriteFile("memory.max", "max\n");
+  WriteFile("memory.current", "600\n");
+  WriteFile("meminfo",
+            "MemTotal:        4 kB\nMemFree:         1 kB\nMemAvailable:    1 kB\n");
+  auto snapshot = MemoryMonitor::TakeSnapshot(dir_, dir_ + "/meminfo");
+  ASSERT_EQ(snapshot.used_bytes, 3 * 1024);
+  ASSERT_EQ(snapshot.total_bytes, 4 * 1024);
+
+  // Nothing can be read.
+  snapshot = MemoryMonitor::TakeSnapshot(dir_ + "/missing", dir_ + "/missing");
+  ASSERT_EQ(snapshot.total_bytes, 0);
+}
+
+TEST_F(MemoryMonitorTest, TestRefresh) {
+  MemorySnapshot snapshot;
+  MemoryMonitor monitor(0.9, [&snapshot] { return snapshot; });
+  // The usage is unknown.
+  ASSERT_FALSE(monitor.Refresh());
+  snapshot = {90, 100};
+  ASSERT_FALSE(monitor.Refresh());
+  snapshot = {91, 100};
+  ASSERT_TRUE(monitor.Refresh());
+  ASSERT_TRUE(monitor.IsUnderPressure());
+  ASSERT_EQ(monitor.LastSnapshot().used_bytes, 91);
+  snapshot = {50, 100};
+  ASSERT_FALSE(monitor.Refresh());
+  ASSERT_FALSE(monitor.IsUnderPressure());
+}
+
+TEST_F(MemoryMonitorTest, TestSelectWorkerToKill) {
+  ASSERT_EQ(MemoryMonitor::SelectWorkerToKill(workers_), nullptr);
+
+  auto oldest = AddWorker(rpc::TaskType::NORMAL_TASK, 3, 100);
+  auto newest = AddWorker(rpc::TaskType::NORMAL_TASK, -1, 200);
+  // Tasks that can't be retried and actors are never picked, even if newer.
+  AddWorker(rpc::TaskType::NORMAL_TASK, 0, 300);
+  AddWorker(rpc::TaskType::ACTOR_TASK, 3, 300);
+  AddWorker(rpc::TaskType::ACTOR_CREATION_TASK, 3, 300);
+  // Idle workers aren't picked either.
+  workers_.push_back(std::make_shared<MockWorker>(WorkerID::FromRandom(), 1234));
+
+  ASSERT_EQ(MemoryMonitor::SelectWorkerToKill(workers_), newest);
+  newest->MarkDead();
+  ASSERT_EQ(MemoryMonitor::SelectWorkerToKill(workers_), oldest);
+}
+
+}  // namespace raylet
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/native_object_spiller.h"
+
+#include <fcntl.h>
+
+#include <boost/asio/post.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+namespace {
+
+/// The alignment of the offsets, sizes and buffers of O_DIRECT writes.
+constexpr size_t kDirectIOAlignment = 4096;
+
+/// The size of the buffer that the objects are staged in before they are written.
+constexpr size_t kWriteBufferSize = 4 * 1024 * 1024;
+
+#ifndef _WIN32
+/// Writes a file sequentially, through an aligned buffer so that it can be written
+/// with O_DIRECT. Without O_DIRECT, large objects are written straight from their
+/// memory instead.
+class FusedFileWriter {
+ public:
+  FusedFileWriter(int fd, bool direct_io)
+      : fd_(fd),
+        direct_io_(direct_io),
+        buffer_(static_cast<char *>(std::aligned_alloc(kDirectIOAlignment,
+                                                       kWriteBufferSize)),
+                &std::free) {}
+
+  ~FusedFileWriter() { close(fd_); }
+
+  /// The number of bytes appended so far.
+  uint64_t Size() const { return file_offset_ + buffer_used_; }
+
+  Status Append(const uint8_t *data, size_t size) {
+    if (!direct_io_ && size >= kWriteBufferSize) {
+      RAY_RETURN_NOT_OK(Flush(buffer_used_));
+      RAY_RETURN_NOT_OK(Write(reinterpret_cast<const char *>(data), size));
+      return Status::OK();
+    }
+    while (size > 0) {
+      const size_t copied = std::min(size, kWriteBufferSize - buffer_used_);
+      std::memcpy(buffer_.get() + buffer_used_, data, copied);
+      buffer_used_ += copied;
+      data += copied;
+      size -= copied;
+      if (buffer_used_ == kWriteBufferSize) {
+        RAY_RETURN_NOT_OK(Flush(kWriteBufferSize));
+      }
+    }
+    return Status::OK();
+  }
+
+  Status AppendUINT64(uint64_t value) {
+    // The sizes in the spilled files are little endian.
+    uint8_t bytes[sizeof(uint64_t)];
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+      bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    return Append(bytes, sizeof(bytes));
+  }
+
+  /// Write the rest of the buffer. An O_DIRECT write is padded to the alignment, and
+  /// the padding is truncated off afterwards.
+  Status Finish() {
+    const uint64_t size = Size();
+    if (!direct_io_) {
+      return Flush(buffer_used_);
+    }
+    const size_t padded_size =
+        (buffer_used_ + kDirectIOAlignment - 1) / kDirectIOAlignment * kDirectIOAlignment;
+    std::memset(buffer_.get() + buffer_used_, 0, padded_size - buffer_used_);
+    RAY_RETURN_NOT_OK(Flush(padded_size));
+    if (ftruncate(fd_, size) != 0) {
+      return Status::IOError(std::string("ftruncate: ") + std::strerror(errno));
+    }
+    return Status::OK();
+  }
+
+ private:
+  Status Flush(size_t size) {
+    RAY_RETURN_NOT_OK(Write(buffer_.get(), size));
+    // Account only for the bytes of the buffer, not for the padding.
+    file_offset_ -= size - buffer_used_;
+    buffer_used_ = 0;
+    return Status::OK();
+  }
+
+  Status Write(const char *data, size_t size) {
+    while (size > 0) {
+      const ssize_t written = pwrite(fd_, data, size, file_offset_);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return Status::IOError(std::string("pwrite: ") + std::strerror(errno));
+      }
+      data += written;
+      size -= written;
+      file_offset_ += written;
+    }
+    return Status::OK();
+  }
+
+  const int fd_;
+  const bool direct_io_;
+  std::unique_ptr<char, decltype(&std::free)> buffer_;
+  size_t buffer_used_ = 0;
+  uint64_t file_offset_ = 0;
+};
+#endif
+
+/// Return the path of the file that an object URL points into.
+std::string GetSpilledFilePath(const std::string &object_url) {
+  return object_url.substr(0, object_url.find('?'));
+}
+
+}  // namespace
+
+NativeObjectSpiller::NativeObjectSpiller(instrumented_io_context &callback_service,
+                                         std::string directory,
+                                         int num_threads,
+                                         bool direct_io)
+    : callback_service_(callback_service),
+      directory_(std::move(directory)),
+      direct_io_(direct_io),
+      io_threads_(std::max(num_threads, 1)) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  RAY_CHECK(!ec) << "Failed to create the spill directory " << directory_ << ": "
+                 << ec.message();
+}
+
+NativeObjectSpiller::~NativeObjectSpiller() {
+  io_threads_.stop();
+  io_threads_.join();
+}
+
+void NativeObjectSpiller::SpillObjects(std::vector<ObjectToSpill> objects,
+                                       SpillCallback callback) {
+  if (objects.empty()) {
+    callback_service_.post([callback]() { callback(Status::OK(), {}); },
+                           "NativeObjectSpiller.SpillObjects");
+    return;
+  }
+  // Name the files like the Python filesystem storage does.
+  const std::string path = directory_ + "/" + UniqueID::FromRandom().Hex() + "-multi-" +
+                           std::to_string(objects.size());
+  boost::asio::post(io_threads_,
+                    [this, path, objects = std::move(objects), callback]() {
+                      std::vector<std::string> object_urls;
+                      auto status =
+                          WriteFusedFile(path, objects, direct_io_, &object_urls);
+                      callback_service_.post(
+                          [callback, status, object_urls = std::move(object_urls)]() {
+                            callback(status, std::move(object_urls));
+                          },
+                          "NativeObjectSpiller.SpillObjects");
+                    });
+}
+
+void NativeObjectSpiller::DeleteSpilledObjects(std::vector<std::string> object_urls) {
+  boost::asio::post(io_threads_, [object_urls = std::move(object_urls)]() {
+    for (const auto &object_url : object_urls) {
+      const auto path = GetSpilledFilePath(object_url);
+      std::error_code ec;
+      if (!std::filesystem::remove(path, ec) && ec) {
+        RAY_LOG(ERROR) << "Failed to delete the spilled file " << path << ": "
+                       << ec.message();
+      }
+    }
+  });
+}
+
+/* static */
+Status NativeObjectSpiller::WriteFusedFile(const std::string &path,
+                                           const std::vector<ObjectToSpill> &objects,
+                                           bool direct_io,
+                                           std::vector<std::string> *object_urls) {
+#ifdef _WIN32
+  return Status::NotImplemented("Native object spilling is not supported on Windows.");
+#else
+  int flags = O_WRONLY | O_CREAT | O_TRUNC;
+  int fd = -1;
+#ifdef O_DIRECT
+  if (direct_io) {
+    // Not all filesystems support O_DIRECT, fall back to buffered writes on those.
+    fd = open(path.c_str(), flags | O_DIRECT, 0644);
+  }
+#endif
+  if (fd < 0) {
+    direct_io = false;
+    fd = open(path.c_str(), flags, 0644);
+  }
+  if (fd < 0) {
+    return Status::IOError("Failed to open " + path + ": " + std::strerror(errno));
+  }
+
+  auto status = [&]() {
+    FusedFileWriter writer(fd, direct_io);
+    for (const auto &object : objects) {
+      const uint64_t object_offset = writer.Size();
+      const std::string address = object.owner_address.SerializeAsString();
+      const auto &metadata = object.object->GetMetadata();
+      const auto data = object.object->GetData();
+      const uint64_t metadata_size = metadata ? metadata->Size() : 0;
+      const uint64_t data_size = data ? data->Size() : 0;
+      RAY_RETURN_NOT_OK(writer.AppendUINT64(address.size()));
+      RAY_RETURN_NOT_OK(writer.AppendUINT64(metadata_size));
+      RAY_RETURN_NOT_OK(writer.AppendUINT64(data_size));
+      RAY_RETURN_NOT_OK(writer.Append(reinterpret_cast<const uint8_t *>(address.data()),
+                                      address.size()));
+      if (metadata_size > 0) {
+        RAY_RETURN_NOT_OK(writer.Append(metadata->Data(), metadata_size));
+      }
+      if (data_size > 0) {
+        RAY_RETURN_NOT_OK(writer.Append(data->Data(), data_size));
+      }
+      object_urls->push_back(path + "?offset=" + std::to_string(object_offset) +
+                             "&size=" + std::to_string(writer.Size() - object_offset));
+    }
+    return writer.Finish();
+  }();
+  if (!status.ok()) {
+    object_urls->clear();
+    unlink(path.c_str());
+  }
+  return status;
+#endif
+}
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -0,0 +1,97 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio/thread_pool.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ray/common/asio/instrumented_io_context.h"
+#include "ray/common/id.h"
+#include "ray/common/ray_object.h"
+#include "ray/common/status.h"
+#include "src/ray/protobuf/common.pb.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// Spills objects from plasma to files on the local filesystem, and deletes the
+/// files, on threads of its own instead of on Python IO workers. The objects of a
+/// spill request are fused into one file, in the same layout as the files of the
+/// Python filesystem storage, so that either can restore them.
+class NativeObjectSpiller {
+ public:
+  /// An object to spill.
+  struct ObjectToSpill {
+    ObjectID object_id;
+    rpc::Address owner_address;
+    /// The object in plasma. It must stay pinned until the spill is done.
+    const RayObject *object;
+  };
+
+  /// Called once a spill is done, with the URLs of the spilled objects in the
+  /// order of the request, or an error if none of them could be spilled.
+  using SpillCallback =
+      std::function<void(const Status &status, std::vector<std::string> object_urls)>;
+
+  /// Create a spiller.
+  ///
+  /// \param callback_service The event loop that the spill callbacks are posted to.
+  /// \param directory The directory to spill the objects to.
+  /// \param num_threads The number of spills and deletes that run in parallel.
+  /// \param direct_io Whether to write with O_DIRECT, bypassing the page cache.
+  NativeObjectSpiller(instrumented_io_context &callback_service,
+                      std::string directory,
+                      int num_threads,
+                      bool direct_io);
+
+  ~NativeObjectSpiller();
+
+  /// Spill the objects into one fused file.
+  ///
+  /// \param objects The objects to spill.
+  /// \param callback Called on the callback service once the objects are spilled.
+  void SpillObjects(std::vector<ObjectToSpill> objects, SpillCallback callback);
+
+  /// Delete spilled files, given the URL of any object in them.
+  ///
+  /// \param object_urls The URLs of the objects whose files to delete.
+  void DeleteSpilledObjects(std::vector<std::string> object_urls);
+
+  /// Write the objects to a fused file at the given path, and return their URLs.
+  ///
+  /// \param path The path of the file to write.
+  /// \param objects The objects to write.
+  /// \param direct_io Whether to write with O_DIRECT, if the filesystem supports it.
+  /// \param[out] object_urls The URLs of the written objects.
+  /// \return The status of the write. The file is removed if it failed.
+  static Status WriteFusedFile(const std::string &path,
+                               const std::vector<ObjectToSpill> &objects,
+                               bool direct_io,
+                               std::vector<std::string> *object_urls);
+
+ private:
+  instrumented_io_context &callback_service_;
+  const std::string directory_;
+  const bool direct_io_;
+  /// The threads that write and delete the spilled files.
+  boost::asio::thread_pool io_threads_;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -14,6 +14,8 @@
 
 #include "ray/raylet/node_manager.h"
 
+#include <google/protobuf/util/message_differencer.h>
+
 #include <cctype>
 #include <csignal>
 #include <fstream>
@@ -26,6 +28,8 @@
 #include "ray/common/buffer.h"
 #include "ray/common/common_protocol.h"
 #include "ray/common/constants.h"
+#include "ray/common/cpu_profiler.h"
+#include "ray/common/mutex_contention.h"
 #include "ray/common/status.h"
 #include "ray/gcs/pb_util.h"
 #include "ray/raylet/format/node_manager_generated.h"
@@ -77,6 +81,32 @@ std::vector<ray::rpc::ObjectReference> FlatbufferToObjectReference(
   return refs;
 }
 
+/// The pull options of the objects that a worker blocks on. The pulls of a driver go
+/// before those of workers, since the whole job waits for it.
+ray::PullOptions WorkerPullOptions(const ray::raylet::WorkerInterface &worker,
+                                   int64_t timeout_ms) {
+  ray::PullOptions options;
+  options.priority = worker.GetWorkerType() == ray::rpc::WorkerType::DRIVER ? 1 : 0;
+  options.timeout_ms = timeout_ms;
+  return options;
+}
+
+/// Create the native object spiller if it is enabled, or return null to spill on IO
+/// workers.
+std::unique_ptr<ray::raylet::NativeObjectSpiller> CreateNativeObjectSpiller(
+    instrumented_io_context &io_service, int max_io_workers) {
+  const auto &directory = RayConfig::instance().object_spilling_native_directory();
+  if (directory.empty() || !RayConfig::instance().is_external_storage_type_fs()) {
+    return nullptr;
+  }
+  RAY_LOG(INFO) << "Spilling objects natively to " << directory;
+  return std::make_unique<ray::raylet::NativeObjectSpiller>(
+      io_service,
+      directory,
+      max_io_workers,
+      RayConfig::instance().object_spilling_native_direct_io());
+}
+
 }  // namespace
 
 namespace ray {
@@ -201,6 +231,7 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
           /*get_time=*/[]() { return absl::GetCurrentTimeNanos() / 1e6; }),
       client_call_manager_(io_service),
       worker_rpc_pool_(client_call_manager_),
+      raylet_rpc_pool_(client_call_manager_),
       core_worker_subscriber_(std::make_unique<pubsub::Subscriber>(
           self_node_id_,
           /*channels=*/
@@ -225,7 +256,9 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
             rpc::ObjectReference ref;
             ref.set_object_id(obj_id.Binary());
             MarkObjectsAsFailed(error_type, {ref}, JobID::Nil());
-          })),
+          },
+          /*location_cache_ttl_ms=*/
+          RayConfig::instance().object_location_cache_ttl_ms())),
       object_manager_(
           io_service,
           self_node_id,
@@ -322,7 +355,22 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
             return object_manager_.IsPlasmaObjectSpillable(object_id);
           },
           /*core_worker_subscriber_=*/core_worker_subscriber_.get(),
-          object_directory_.get()),
+          object_directory_.get(),
+          CreateNativeObjectSpiller(io_service, config.max_io_workers),
+          /*restore_spilled_object_natively=*/
+          [this](const ObjectID &object_id,
+                 int64_t object_size,
+                 const std::string &object_url,
+                 std::function<void(const ray::Status &)> callback) {
+            object_manager_.RestoreFromFilesystem(object_id, object_url, callback);
+          },
+          /*get_object_demand=*/
+          RayConfig::instance().spill_objects_by_demand()
+              ? std::function<int64_t(const ObjectID &)>(
+                    [this](const ObjectID &object_id) {
+                      return dependency_manager_.GetObjectDemand(object_id);
+                    })
+              : nullptr),
       high_plasma_storage_usage_(RayConfig::instance().high_plasma_storage_usage()),
       local_gc_run_time_ns_(absl::GetCurrentTimeNanos()),
       local_gc_throttler_(RayConfig::instance().local_gc_min_interval_s() * 1e9),
@@ -393,6 +441,17 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
       get_node_info_func,
       announce_infeasible_task,
       local_task_manager_);
+  if (RayConfig::instance().worker_cpu_pinning_enabled()) {
+    auto cpu_pinning = std::make_shared<const WorkerCpuPinning>(
+        WorkerCpuPinning::GetAllowedCpus(),
+        RayConfig::instance().num_raylet_reserved_cpus());
+    RAY_LOG(INFO) << "Pinning the raylet to " << cpu_pinning->ReservedCpus().size()
+                  << " CPUs and workers to " << cpu_pinning->WorkerCpus().size()
+                  << " CPUs.";
+    cpu_pinning->PinRaylet();
+    worker_pool_.SetCpuPinning(cpu_pinning);
+    local_task_manager_->SetCpuPinning(cpu_pinning);
+  }
   placement_group_resource_manager_ = std::make_shared<NewPlacementGroupResourceManager>(
       std::dynamic_pointer_cast<ClusterResourceScheduler>(cluster_resource_scheduler_));
 
@@ -400,7 +459,12 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
       [this]() { cluster_task_manager_->ScheduleAndDispatchTasks(); },
       RayConfig::instance().worker_cap_initial_backoff_delay_ms());
 
+  const int64_t store_connect_start_ms = current_time_ms();
   RAY_CHECK_OK(store_client_.Connect(config.store_socket_name.c_str()));
+  // Connecting waits for the object store to start, which includes preallocating
+  // its memory unless that is done in the background.
+  ray::stats::STATS_raylet_startup_time_ms.Record(
+      current_time_ms() - store_connect_start_ms, "ObjectStore");
   // Run the node manger rpc server.
   node_manager_server_.RegisterService(node_manager_service_);
   node_manager_server_.RegisterService(agent_manager_service_);
@@ -437,7 +501,26 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
 
 ray::Status NodeManager::RegisterGcs() {
   // Start sending heartbeat here to ensure it happening after raylet being registered.
-  heartbeat_sender_.reset(new HeartbeatSender(self_node_id_, gcs_client_));
+  if (RayConfig::instance().raylet_gossip_probe_period_ms() > 0) {
+    gossip_failure_detector_ = std::make_unique<GossipFailureDetector>(
+        self_node_id_,
+        RayConfig::instance().raylet_gossip_num_indirect_probes(),
+        [this](const rpc::Address &node,
+               const absl::optional<rpc::Address> &relay,
+               std::function<void(bool)> callback) {
+          ProbeNode(node, relay, std::move(callback));
+        },
+        [this](const NodeID &node_id) {
+          RAY_CHECK_OK(gcs_client_->Nodes().AsyncReportNodeSuspected(
+              node_id, self_node_id_, nullptr));
+        });
+    periodical_runner_.RunFnPeriodically(
+        [this] { gossip_failure_detector_->Tick(); },
+        RayConfig::instance().raylet_gossip_probe_period_ms(),
+        "NodeManager.deadline_timer.gossip_probe");
+  } else {
+    heartbeat_sender_.reset(new HeartbeatSender(self_node_id_, gcs_client_));
+  }
   auto on_node_change = [this](const NodeID &node_id, const GcsNodeInfo &data) {
     if (data.state() == GcsNodeInfo::ALIVE) {
       NodeAdded(data);
@@ -524,6 +607,19 @@ ray::Status NodeManager::RegisterGcs() {
         RayConfig::instance().free_objects_period_milliseconds(),
         "NodeManager.deadline_timer.flush_free_objects");
   }
+  if (RayConfig::instance().work_stealing_period_ms() > 0) {
+    periodical_runner_.RunFnPeriodically([this] { StealTasks(); },
+                                         RayConfig::instance().work_stealing_period_ms(),
+                                         "NodeManager.deadline_timer.steal_tasks");
+  }
+  if (RayConfig::instance().memory_monitor_interval_ms() > 0) {
+    memory_monitor_ =
+        std::make_unique<MemoryMonitor>(RayConfig::instance().memory_usage_threshold());
+    periodical_runner_.RunFnPeriodically(
+        [this] { CheckMemoryPressure(); },
+        RayConfig::instance().memory_monitor_interval_ms(),
+        "NodeManager.deadline_timer.check_memory_pressure");
+  }
   last_resource_report_at_ms_ = now_ms;
   /// If periodic asio stats print is enabled, it will print it.
   const auto event_stats_print_interval_ms =
@@ -545,34 +641,85 @@ ray::Status NodeManager::RegisterGcs() {
 }
 
 void NodeManager::KillWorker(std::shared_ptr<WorkerInterface> worker) {
+  KillWorkers({std::move(worker)});
+}
+
+void NodeManager::KillWorkers(
+    const std::vector<std::shared_ptr<WorkerInterface>> &workers) {
+  if (workers.empty()) {
+    return;
+  }
 #ifdef _WIN32
 // TODO(mehrdadn): implement graceful process termination mechanism
 #else
-  // If we're just cleaning up a single worker, allow it some time to clean
-  // up its state before force killing. The client socket will be closed
-  // and the worker struct will be freed after the timeout.
-  kill(worker->GetProcess().GetId(), SIGTERM);
+  // Allow the workers some time to clean up their state before force killing. The
+  // client sockets will be closed and the worker structs will be freed after the
+  // timeout, which all the workers wait out together.
+  for (const auto &worker : workers) {
+    kill(worker->GetProcess().GetId(), SIGTERM);
+  }
 #endif
 
   auto retry_timer = std::make_shared<boost::asio::deadline_timer>(io_service_);
   auto retry_duration = boost::posix_time::milliseconds(
       RayConfig::instance().kill_worker_timeout_milliseconds());
   retry_timer->expires_from_now(retry_duration);
-  retry_timer->async_wait([retry_timer, worker](const boost::system::error_code &error) {
-    RAY_LOG(DEBUG) << "Send SIGKILL to worker, pid=" << worker->GetProcess().GetId();
-    // Force kill worker
-    worker->GetProcess().Kill();
+  retry_timer->async_wait([retry_timer, workers](const boost::system::error_code &error) {
+    for (const auto &worker : workers) {
+      RAY_LOG(DEBUG) << "Send SIGKILL to worker, pid=" << worker->GetProcess().GetId();
+      // Force kill worker
+      worker->GetProcess().Kill();
+    }
   });
 }
 
 void NodeManager::DestroyWorker(std::shared_ptr<WorkerInterface> worker,
                                 rpc::WorkerExitType disconnect_type) {
-  // We should disconnect the client first. Otherwise, we'll remove bundle resources
+  DestroyWorkers({std::move(worker)}, disconnect_type);
+}
+
+void NodeManager::DestroyWorkers(
+    const std::vector<std::shared_ptr<WorkerInterface>> &workers,
+    rpc::WorkerExitType disconnect_type) {
+  // We should disconnect the clients first. Otherwise, we'll remove bundle resources
   // before actual resources are returned. Subsequent disconnect request that comes
   // due to worker dead will be ignored.
-  DisconnectClient(worker->Connection(), disconnect_type);
-  worker->MarkDead();
-  KillWorker(worker);
+  for (const auto &worker : workers) {
+    DisconnectClient(worker->Connection(), disconnect_type);
+    worker->MarkDead();
+  }
+  KillWorkers(workers);
+}
+
+void NodeManager::CheckMemoryPressure() {
+  const bool was_under_pressure = memory_monitor_->IsUnderPressure();
+  const bool under_pressure = memory_monitor_->Refresh();
+  local_task_manager_->SetUnderMemoryPressure(under_pressure);
+  if (!under_pressure) {
+    if (was_under_pressure) {
+      // Dispatch the tasks that were held back.
+      cluster_task_manager_->ScheduleAndDispatchTasks();
+    }
+    return;
+  }
+
+  auto worker =
+      MemoryMonitor::SelectWorkerToKill(worker_pool_.GetAllRegisteredWorkers(true));
+  if (worker == nullptr) {
+    RAY_LOG_EVERY_MS(WARNING, 10000)
+        << "The node is running out of memory, but no worker runs a task that can be "
+           "retried.";
+    return;
+  }
+  const auto pid = worker->GetProcess().GetId();
+  RAY_LOG(WARNING) << "The node is running out of memory, using "
+                   << memory_monitor_->LastSnapshot().used_bytes << " of "
+                   << memory_monitor_->LastSnapshot().total_bytes
+                   << " bytes. Killing worker " << worker->WorkerId() << " (pid " << pid
+                   << ", " << MemoryMonitor::GetProcessRssBytes(pid)
+                   << " bytes resident), so that its task "
+                   << worker->GetAssignedTaskId() << " is retried.";
+  DestroyWorker(worker, rpc::WorkerExitType::SYSTEM_ERROR_EXIT);
 }
 
 void NodeManager::HandleJobStarted(const JobID &job_id, const JobTableData &job_data) {
@@ -721,8 +868,9 @@ void NodeManager::HandleReleaseUnusedBundles(
         << ", task id: " << worker->GetAssignedTaskId()
         << ", actor id: " << worker->GetActorId()
         << ", worker id: " << worker->WorkerId();
-    DestroyWorker(worker, rpc::WorkerExitType::UNUSED_RESOURCE_RELEASED);
   }
+  DestroyWorkers(workers_associated_with_unused_bundles,
+                 rpc::WorkerExitType::UNUSED_RESOURCE_RELEASED);
 
   // Return unused bundle resources.
   placement_group_resource_manager_->ReturnUnusedBundle(in_use_bundles);
@@ -766,6 +914,120 @@ void NodeManager::HandleGetObjectsInfo(const rpc::GetObjectsInfoRequest &request
       /*include_task_info*/ false);
 }
 
+void NodeManager::HandleStealTasks(const rpc::StealTasksRequest &request,
+                                   rpc::StealTasksReply *reply,
+                                   rpc::SendReplyCallback send_reply_callback) {
+  const NodeID node_id = NodeID::FromBinary(request.node_id());
+  RAY_LOG(DEBUG) << "Node " << node_id << " asked for queued tasks.";
+  // Take the idle node's report over our view of it, which may be stale by up to a
+  // resource report period, and reschedule. The queued tasks that fit there are spilled
+  // back to it; each spillback subtracts from the view, so we don't send it too many.
+  rpc::ResourcesData resources_data;
+  resources_data.set_resources_available_changed(true);
+  resources_data.mutable_resources_available()->insert(
+      request.resources_available().begin(), request.resources_available().end());
+  if (cluster_resource_scheduler_->GetClusterResourceManager()
+          .UpdateNodeAvailableResourcesIfExist(scheduling::NodeID(node_id.Binary()),
+                                               resources_data)) {
+    cluster_task_manager_->ScheduleAndDispatchTasks();
+  }
+  send_reply_callback(Status::OK(), nullptr, nullptr);
+}
+
+void NodeManager::StealTasks() {
+  if (steal_tasks_in_flight_ || !local_task_manager_->GetTaskToDispatch().empty() ||
+      cluster_resource_scheduler_->GetLocalResourceManager().GetLocalAvailableCpus() <=
+          0) {
+    return;
+  }
+
+  NodeID victim_id = NodeID::Nil();
+  uint64_t max_num_queued_tasks = 0;
+  for (const auto &entry : remote_node_num_queued_tasks_) {
+    if (entry.second > max_num_queued_tasks) {
+      victim_id = entry.first;
+      max_num_queued_tasks = entry.second;
+    }
+  }
+  const auto address_it = remote_node_manager_addresses_.find(victim_id);
+  if (address_it == remote_node_manager_addresses_.end()) {
+    return;
+  }
+
+  rpc::Address address;
+  address.set_raylet_id(victim_id.Binary());
+  address.set_ip_address(address_it->second.first);
+  address.set_port(address_it->second.second);
+  const auto available = cluster_resource_scheduler_->GetClusterResourceManager()
+                             .GetNodeResources(scheduling::NodeID(self_node_id_.Binary()))
+                             .available.ToResourceMap();
+  steal_tasks_in_flight_ = true;
+  raylet_rpc_pool_.GetOrConnectByAddress(address)->StealTasks(
+      self_node_id_,
+      available,
+      [this](const Status &status, const rpc::StealTasksReply &reply) {
+        if (!status.ok()) {
+          RAY_LOG(DEBUG) << "Failed to steal tasks: " << status;
+        }
+        steal_tasks_in_flight_ = false;
+      });
+}
+
+void NodeManager::HandleProbeNode(const rpc::ProbeNodeRequest &request,
+                                  rpc::ProbeNodeReply *reply,
+                                  rpc::SendReplyCallback send_reply_callback) {
+  if (!request.has_target()) {
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+    return;
+  }
+  ProbeNode(request.target(),
+            absl::nullopt,
+            [reply, send_reply_callback](bool reachable) {
+              reply->set_target_reachable(reachable);
+              send_reply_callback(Status::OK(), nullptr, nullptr);
+            });
+}
+
+void NodeManager::HandleProfileCpu(const rpc::ProfileCpuRequest &request,
+                                   rpc::ProfileCpuReply *reply,
+                                   rpc::SendReplyCallback send_reply_callback) {
+  RAY_LOG(INFO) << "Profiling the CPU use of the raylet for " << request.duration_ms()
+                << " ms.";
+  Status status =
+      CpuProfiler::Instance().Start(request.frequency() > 0 ? request.frequency() : 100);
+  if (!status.ok()) {
+    send_reply_callback(status, nullptr, nullptr);
+    return;
+  }
+  RAY_UNUSED(execute_after(
+      io_service_,
+      [reply, send_reply_callback]() {
+        Status status = CpuProfiler::Instance().Stop(reply->mutable_profile());
+        send_reply_callback(status, nullptr, nullptr);
+      },
+      request.duration_ms()));
+}
+
+void NodeManager::ProbeNode(const rpc::Address &node,
+                            const absl::optional<rpc::Address> &relay,
+                            std::function<void(bool reachable)> callback) {
+  if (relay) {
+    raylet_rpc_pool_.GetOrConnectByAddress(*relay)->ProbeNode(
+        node,
+        [callback = std::move(callback)](const Status &status,
+                                         const rpc::ProbeNodeReply &reply) {
+          callback(status.ok() && reply.target_reachable());
+        });
+  } else {
+    raylet_rpc_pool_.GetOrConnectByAddress(node)->ProbeNode(
+        absl::nullopt,
+        [callback = std::move(callback)](const Status &status,
+                                         const rpc::ProbeNodeReply &reply) {
+          callback(status.ok());
+        });
+  }
+}
+
 void NodeManager::QueryAllWorkerStates(
     const std::function<void(const ray::Status &, const rpc::GetCoreWorkerStatsReply &)>
         &on_replied,
@@ -901,6 +1163,13 @@ void NodeManager::NodeAdded(const GcsNodeInfo &node_info) {
   // Store address of the new node manager for rpc requests.
   remote_node_manager_addresses_[node_id] =
       std::make_pair(node_info.node_manager_address(), node_info.node_manager_port());
+  if (gossip_failure_detector_) {
+    rpc::Address address;
+    address.set_raylet_id(node_info.node_id());
+    address.set_ip_address(node_info.node_manager_address());
+    address.set_port(node_info.node_manager_port());
+    gossip_failure_detector_->AddNode(address);
+  }
 
   // Fetch resource info for the remote node and update cluster resource map.
   RAY_CHECK_OK(gcs_client_->NodeResources().AsyncGetResources(
@@ -958,6 +1227,11 @@ void NodeManager::NodeRemoved(const NodeID &node_id) {
   if (node_entry != remote_node_manager_addresses_.end()) {
     remote_node_manager_addresses_.erase(node_entry);
   }
+  remote_node_num_queued_tasks_.erase(node_id);
+  if (gossip_failure_detector_) {
+    gossip_failure_detector_->RemoveNode(node_id);
+  }
+  raylet_rpc_pool_.Disconnect(node_id);
 
   // Notify the object directory that the node has been removed so that it
   // can remove it from any cached locations.
@@ -985,6 +1259,7 @@ void NodeManager::HandleUnexpectedWorkerFailure(const rpc::WorkerDeltaData &data
   // from the task queues. This is only necessary for lease requests that are
   // infeasible, since requests that are fulfilled will get canceled during
   // dispatch.
+  std::vector<std::shared_ptr<WorkerInterface>> workers_to_kill;
   for (const auto &pair : leased_workers_) {
     auto &worker = pair.second;
     const auto owner_worker_id =
@@ -1000,17 +1275,18 @@ void NodeManager::HandleUnexpectedWorkerFailure(const rpc::WorkerDeltaData &data
         if (owner_worker_id == worker_id) {
           RAY_LOG(INFO) << "Owner process " << owner_worker_id
                         << " died, killing leased worker " << worker->WorkerId();
-          KillWorker(worker);
+          workers_to_kill.push_back(worker);
         }
       } else if (owner_node_id == node_id) {
         // If the leased worker's owner was on the failed node, then kill the leased
         // worker.
         RAY_LOG(INFO) << "Owner node " << owner_node_id << " died, killing leased worker "
                       << worker->WorkerId();
-        KillWorker(worker);
+        workers_to_kill.push_back(worker);
       }
     }
   }
+  KillWorkers(workers_to_kill);
 }
 
 void NodeManager::ResourceCreateUpdated(const NodeID &node_id,
@@ -1066,8 +1342,11 @@ void NodeManager::ResourceDeleted(const NodeID &node_id,
 
 void NodeManager::UpdateResourceUsage(const NodeID &node_id,
                                       const rpc::ResourcesData &resource_data) {
-  if (!cluster_resource_scheduler_->GetClusterResourceManager().UpdateNode(
-          scheduling::NodeID(node_id.Binary()), resource_data)) {
+  auto &cluster_resource_manager =
+      cluster_resource_scheduler_->GetClusterResourceManager();
+  const auto resource_view_version = cluster_resource_manager.GetResourceViewVersion();
+  if (!cluster_resource_manager.UpdateNode(scheduling::NodeID(node_id.Binary()),
+                                           resource_data)) {
     RAY_LOG(INFO)
         << "[UpdateResourceUsage]: received resource usage from unknown node id "
         << node_id;
@@ -1079,9 +1358,19 @@ void NodeManager::UpdateResourceUsage(const NodeID &node_id,
     should_local_gc_ = true;
   }
 
-  // If light resource usage report enabled, we update remote resources only when related
-  // resources map in heartbeat is not empty.
-  cluster_task_manager_->ScheduleAndDispatchTasks();
+  if (resource_data.resource_load_changed()) {
+    uint64_t num_queued_tasks = 0;
+    for (const auto &demand : resource_data.resource_load_by_shape().resource_demands()) {
+      num_queued_tasks += demand.num_ready_requests_queued();
+    }
+    remote_node_num_queued_tasks_[node_id] = num_queued_tasks;
+  }
+
+  // Scheduling decisions only depend on the resource view, so there is nothing new to
+  // schedule unless the report changed it.
+  if (cluster_resource_manager.GetResourceViewVersion() != resource_view_version) {
+    cluster_task_manager_->ScheduleAndDispatchTasks();
+  }
 }
 
 void NodeManager::ResourceUsageBatchReceived(
@@ -1495,7 +1784,8 @@ void NodeManager::ProcessFetchOrReconstructMessage(
     if (worker && !worker->GetAssignedTaskId().IsNil()) {
       // This will start a fetch for the objects that gets canceled once the
       // objects are local, or if the worker dies.
-      dependency_manager_.StartOrUpdateGetRequest(worker->WorkerId(), refs);
+      dependency_manager_.StartOrUpdateGetRequest(
+          worker->WorkerId(), refs, WorkerPullOptions(*worker, /*timeout_ms=*/-1));
     }
   } else {
     // The values are needed. Add all requested objects to the list to
@@ -1547,19 +1837,21 @@ void NodeManager::ProcessWaitRequestMessage(
                         refs,
                         current_task_id,
                         /*ray_get=*/false,
-                        /*mark_worker_blocked*/ was_blocked);
+                        /*mark_worker_blocked*/ was_blocked,
+                        /*timeout_ms=*/message->timeout());
   }
   uint64_t num_required_objects = static_cast<uint64_t>(message->num_ready_objects());
+  const int64_t request_id = message->request_id();
   wait_manager_.Wait(
       object_ids,
       message->timeout(),
       num_required_objects,
-      [this, resolve_objects, was_blocked, client, current_task_id](
+      [this, resolve_objects, was_blocked, client, current_task_id, request_id](
           std::vector<ObjectID> ready, std::vector<ObjectID> remaining) {
         // Write the data.
         flatbuffers::FlatBufferBuilder fbb;
         flatbuffers::Offset<protocol::WaitReply> wait_reply = protocol::CreateWaitReply(
-            fbb, to_flatbuf(fbb, ready), to_flatbuf(fbb, remaining));
+            fbb, to_flatbuf(fbb, ready), to_flatbuf(fbb, remaining), request_id);
         fbb.Finish(wait_reply);
 
         auto status =
@@ -1625,6 +1917,20 @@ void NodeManager::HandleUpdateResourceUsage(
     const rpc::UpdateResourceUsageRequest &request,
     rpc::UpdateResourceUsageReply *reply,
     rpc::SendReplyCallback send_reply_callback) {
+  if (request.forward_to_size() > 0) {
+    // This raylet is a relay, so pass the batch on to the rest of its group.
+    std::string serialized_batch = request.serialized_resource_usage_batch();
+    for (const auto &address : request.forward_to()) {
+      raylet_rpc_pool_.GetOrConnectByAddress(address)->UpdateResourceUsage(
+          serialized_batch,
+          /*forward_to=*/{},
+          [](const Status &status, const rpc::UpdateResourceUsageReply &reply) {
+            if (!status.ok()) {
+              RAY_LOG(DEBUG) << "Failed to relay a resource broadcast: " << status;
+            }
+          });
+    }
+  }
   rpc::ResourceUsageBroadcastData resource_usage_batch;
   resource_usage_batch.ParseFromString(request.serialized_resource_usage_batch());
   // When next_resource_seq_no_ == 0 it means it just started.
@@ -1680,6 +1986,19 @@ void NodeManager::HandleRequestResourceReport(
   FillResourceReport(*resources_data);
   resources_data->set_cluster_full_of_actors_detected(resource_deadlock_warned_ >= 1);
 
+  if (!google::protobuf::util::MessageDifferencer::Equals(*resources_data,
+                                                          last_resource_report_)) {
+    last_resource_report_ = *resources_data;
+    resource_report_version_++;
+  }
+  reply->set_report_version(resource_report_version_);
+  if (request.last_report_version() == resource_report_version_) {
+    // The GCS already has this report, so spare it from handling it again.
+    resources_data->Clear();
+    resources_data->set_node_id(self_node_id_.Binary());
+    reply->set_unchanged(true);
+  }
+
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
 
@@ -1800,18 +2119,23 @@ void NodeManager::HandleCancelResourceReserve(
     const rpc::CancelResourceReserveRequest &request,
     rpc::CancelResourceReserveReply *reply,
     rpc::SendReplyCallback send_reply_callback) {
-  auto bundle_spec = BundleSpecification(request.bundle_spec());
-  RAY_LOG(DEBUG) << "Request to cancel reserved resource is received, "
-                 << bundle_spec.DebugString();
+  std::vector<BundleSpecification> bundle_specs;
+  absl::flat_hash_set<PlacementGroupID> placement_group_ids;
+  for (const auto &bundle : request.bundle_specs()) {
+    bundle_specs.emplace_back(bundle);
+    placement_group_ids.insert(bundle_specs.back().PlacementGroupId());
+    RAY_LOG(DEBUG) << "Request to cancel reserved resource is received, "
+                   << bundle_specs.back().DebugString();
+  }
 
-  // Kill all workers that are currently associated with the placement group.
+  // Kill all workers that are currently associated with the placement groups.
   // NOTE: We can't traverse directly with `leased_workers_`, because `DestroyWorker` will
   // delete the element of `leased_workers_`. So we need to filter out
   // `workers_associated_with_pg` separately.
   std::vector<std::shared_ptr<WorkerInterface>> workers_associated_with_pg;
   for (const auto &worker_it : leased_workers_) {
     auto &worker = worker_it.second;
-    if (worker->GetBundleId().first == bundle_spec.PlacementGroupId()) {
+    if (placement_group_ids.contains(worker->GetBundleId().first)) {
       workers_associated_with_pg.emplace_back(worker);
     }
   }
@@ -1819,15 +2143,18 @@ void NodeManager::HandleCancelResourceReserve(
     RAY_LOG(DEBUG)
         << "Destroying worker since its placement group was removed. Placement group id: "
         << worker->GetBundleId().first
-        << ", bundle index: " << bundle_spec.BundleId().second
+        << ", bundle index: " << worker->GetBundleId().second
         << ", task id: " << worker->GetAssignedTaskId()
         << ", actor id: " << worker->GetActorId()
         << ", worker id: " << worker->WorkerId();
-    DestroyWorker(worker, rpc::WorkerExitType::PLACEMENT_GROUP_REMOVED);
   }
+  DestroyWorkers(workers_associated_with_pg,
+                 rpc::WorkerExitType::PLACEMENT_GROUP_REMOVED);
 
-  // Return bundle resources.
-  placement_group_resource_manager_->ReturnBundle(bundle_spec);
+  // Return bundle resources, and dispatch the tasks that fit in them once.
+  for (const auto &bundle_spec : bundle_specs) {
+    placement_group_resource_manager_->ReturnBundle(bundle_spec);
+  }
   cluster_task_manager_->ScheduleAndDispatchTasks();
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
@@ -2012,7 +2339,8 @@ void NodeManager::AsyncResolveObjects(
     const std::vector<rpc::ObjectReference> &required_object_refs,
     const TaskID &current_task_id,
     bool ray_get,
-    bool mark_worker_blocked) {
+    bool mark_worker_blocked,
+    int64_t timeout_ms) {
   std::shared_ptr<WorkerInterface> worker = worker_pool_.GetRegisteredWorker(client);
   if (!worker) {
     // The client is a driver. Drivers do not hold resources, so we simply mark
@@ -2024,11 +2352,13 @@ void NodeManager::AsyncResolveObjects(
   // Subscribe to the objects required by the task. These objects will be
   // fetched and/or restarted as necessary, until the objects become local
   // or are unsubscribed.
+  const auto options = WorkerPullOptions(*worker, timeout_ms);
   if (ray_get) {
-    dependency_manager_.StartOrUpdateGetRequest(worker->WorkerId(), required_object_refs);
+    dependency_manager_.StartOrUpdateGetRequest(
+        worker->WorkerId(), required_object_refs, options);
   } else {
-    dependency_manager_.StartOrUpdateWaitRequest(worker->WorkerId(),
-                                                 required_object_refs);
+    dependency_manager_.StartOrUpdateWaitRequest(
+        worker->WorkerId(), required_object_refs, options);
   }
 }
 
@@ -2228,7 +2558,7 @@ void NodeManager::DumpDebugState() const {
 
 const NodeManagerConfig &NodeManager::GetInitialConfig() const { return initial_config_; }
 
-std::string NodeManager::DebugString() const {
+std::string NodeManager::DebugString(bool full) const {
   std::stringstream result;
   uint64_t now_ms = current_time_ms();
   result << "NodeManager:";
@@ -2237,11 +2567,11 @@ std::string NodeManager::DebugString() const {
   result << "\nInitialConfigResources: " << initial_config_.resource_config.DebugString();
   if (cluster_task_manager_ != nullptr) {
     result << "\nClusterTaskManager:\n";
-    result << cluster_task_manager_->DebugStr();
+    result << cluster_task_manager_->DebugStr(full);
   }
   result << "\nClusterResources:";
   result << "\n" << local_object_manager_.DebugString();
-  result << "\n" << object_manager_.DebugString();
+  result << "\n" << object_manager_.DebugString(full);
   result << "\n" << gcs_client_->DebugString();
   result << "\n" << worker_pool_.DebugString();
   result << "\n" << dependency_manager_.DebugString();
@@ -2253,13 +2583,20 @@ std::string NodeManager::DebugString() const {
            << async_plasma_objects_notification_.size();
   }
 
-  result << "\nRemote node managers: ";
-  for (const auto &entry : remote_node_manager_addresses_) {
-    result << "\n" << entry.first;
+  if (full) {
+    result << "\nRemote node managers: ";
+    for (const auto &entry : remote_node_manager_addresses_) {
+      result << "\n" << entry.first;
+    }
+  } else {
+    result << "\nnum remote node managers: " << remote_node_manager_addresses_.size();
   }
 
   // Event stats.
   result << "\nEvent stats:" << io_service_.stats().StatsString();
+  if (RayConfig::instance().mutex_contention_tracing()) {
+    result << "\n" << MutexContentionTracker::Instance().DebugString();
+  }
 
   result << "\nDebugString() time ms: " << (current_time_ms() - now_ms);
   return result.str();
@@ -2354,6 +2691,9 @@ void NodeManager::HandleGetNodeStats(const rpc::GetNodeStatsRequest &node_stats_
                                      rpc::GetNodeStatsReply *reply,
                                      rpc::SendReplyCallback send_reply_callback) {
   cluster_task_manager_->FillPendingActorInfo(reply);
+  if (node_stats_request.include_debug_state()) {
+    reply->set_debug_state(DebugString(/*full=*/true));
+  }
   // Report object spilling stats.
   local_object_manager_.FillObjectSpillingStats(reply);
   // Report object store stats.
@@ -2362,39 +2702,65 @@ void NodeManager::HandleGetNodeStats(const rpc::GetNodeStatsRequest &node_stats_
   if (!recorded_metrics_) {
     RecordMetrics();
   }
-  for (const auto &view : opencensus::stats::StatsExporter::GetViewData()) {
-    auto view_data = reply->add_view_data();
-    view_data->set_view_name(view.first.name());
-    if (view.second.type() == opencensus::stats::ViewData::Type::kInt64) {
-      for (const auto &measure : view.second.int_data()) {
-        auto measure_data = view_data->add_measures();
-        measure_data->set_tags(compact_tag_string(view.first, measure.first));
-        measure_data->set_int_value(measure.second);
-      }
-    } else if (view.second.type() == opencensus::stats::ViewData::Type::kDouble) {
-      for (const auto &measure : view.second.double_data()) {
-        auto measure_data = view_data->add_measures();
-        measure_data->set_tags(compact_tag_string(view.first, measure.first));
-        measure_data->set_double_value(measure.second);
-      }
-    } else {
-      RAY_CHECK(view.second.type() == opencensus::stats::ViewData::Type::kDistribution);
-      for (const auto &measure : view.second.distribution_data()) {
-        auto measure_data = view_data->add_measures();
-        measure_data->set_tags(compact_tag_string(view.first, measure.first));
-        measure_data->set_distribution_min(measure.second.min());
-        measure_data->set_distribution_mean(measure.second.mean());
-        measure_data->set_distribution_max(measure.second.max());
-        measure_data->set_distribution_count(measure.second.count());
-        for (const auto &bound : measure.second.bucket_boundaries().lower_boundaries()) {
-          measure_data->add_distribution_bucket_boundaries(bound);
+  if (!node_stats_request.exclude_view_data()) {
+    for (const auto &view : opencensus::stats::StatsExporter::GetViewData()) {
+      auto view_data = reply->add_view_data();
+      view_data->set_view_name(view.first.name());
+      if (view.second.type() == opencensus::stats::ViewData::Type::kInt64) {
+        for (const auto &measure : view.second.int_data()) {
+          auto measure_data = view_data->add_measures();
+          measure_data->set_tags(compact_tag_string(view.first, measure.first));
+          measure_data->set_int_value(measure.second);
         }
-        for (const auto &count : measure.second.bucket_counts()) {
-          measure_data->add_distribution_bucket_counts(count);
+      } else if (view.second.type() == opencensus::stats::ViewData::Type::kDouble) {
+        for (const auto &measure : view.second.double_data()) {
+          auto measure_data = view_data->add_measures();
+          measure_data->set_tags(compact_tag_string(view.first, measure.first));
+          measure_data->set_double_value(measure.second);
+        }
+      } else {
+        RAY_CHECK(view.second.type() == opencensus::stats::ViewData::Type::kDistribution);
+        for (const auto &measure : view.second.distribution_data()) {
+          auto measure_data = view_data->add_measures();
+          measure_data->set_tags(compact_tag_string(view.first, measure.first));
+          measure_data->set_distribution_min(measure.second.min());
+          measure_data->set_distribution_mean(measure.second.mean());
+          measure_data->set_distribution_max(measure.second.max());
+          measure_data->set_distribution_count(measure.second.count());
+          for (const auto &bound :
+               measure.second.bucket_boundaries().lower_boundaries()) {
+            measure_data->add_distribution_bucket_boundaries(bound);
+          }
+          for (const auto &count : measure.second.bucket_counts()) {
+            measure_data->add_distribution_bucket_counts(count);
+          }
         }
       }
     }
   }
+  if (node_stats_request.exclude_core_workers_stats()) {
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+    return;
+  }
+  const int64_t refresh_interval_ms =
+      RayConfig::instance().node_stats_cache_refresh_interval_ms();
+  if (refresh_interval_ms > 0 && !node_stats_request.include_memory_info()) {
+    if (core_worker_stats_refresh_time_ms_ == 0) {
+      // Nothing is cached yet, so wait for the first refresh.
+      RefreshCoreWorkerStatsCache([this, reply, send_reply_callback]() {
+        FillCoreWorkerStatsFromCache(reply);
+        send_reply_callback(Status::OK(), nullptr, nullptr);
+      });
+      return;
+    }
+    if (current_time_ms() - core_worker_stats_refresh_time_ms_ >= refresh_interval_ms &&
+        !core_worker_stats_refresh_callbacks_.has_value()) {
+      RefreshCoreWorkerStatsCache([]() {});
+    }
+    FillCoreWorkerStatsFromCache(reply);
+    send_reply_callback(Status::OK(), nullptr, nullptr);
+    return;
+  }
   // As a result of the HandleGetNodeStats, we are collecting information from all
   // workers on this node. This is done by calling GetCoreWorkerStats on each worker. In
   // order to send up-to-date information back, we wait until all workers have replied,
@@ -2432,6 +2798,64 @@ void NodeManager::HandleGetNodeStats(const rpc::GetNodeStatsRequest &node_stats_
   }
 }
 
+void NodeManager::RefreshCoreWorkerStatsCache(std::function<void()> callback) {
+  if (core_worker_stats_refresh_callbacks_.has_value()) {
+    core_worker_stats_refresh_callbacks_->push_back(std::move(callback));
+    return;
+  }
+  core_worker_stats_refresh_callbacks_.emplace();
+  core_worker_stats_refresh_callbacks_->push_back(std::move(callback));
+
+  auto all_workers = worker_pool_.GetAllRegisteredWorkers(/* filter_dead_worker */ true);
+  for (auto driver :
+       worker_pool_.GetAllRegisteredDrivers(/* filter_dead_driver */ true)) {
+    all_workers.push_back(driver);
+  }
+  // The stats are collected into a new cache, so that the workers that exited since
+  // the last refresh are dropped from it.
+  auto core_worker_stats = std::make_shared<std::vector<rpc::CoreWorkerStats>>();
+  auto num_pending = std::make_shared<size_t>(1);
+  auto on_done = [this, core_worker_stats, num_pending]() {
+    if (--*num_pending > 0) {
+      return;
+    }
+    cached_core_worker_stats_ = std::move(*core_worker_stats);
+    core_worker_stats_refresh_time_ms_ = current_time_ms();
+    auto callbacks = std::move(*core_worker_stats_refresh_callbacks_);
+    core_worker_stats_refresh_callbacks_.reset();
+    for (const auto &callback : callbacks) {
+      callback();
+    }
+  };
+  for (const auto &worker : all_workers) {
+    if (worker->IsDead()) {
+      continue;
+    }
+    rpc::GetCoreWorkerStatsRequest request;
+    request.set_intended_worker_id(worker->WorkerId().Binary());
+    (*num_pending)++;
+    worker->rpc_client()->GetCoreWorkerStats(
+        request,
+        [core_worker_stats, on_done](const ray::Status &status,
+                                     const rpc::GetCoreWorkerStatsReply &r) {
+          if (status.ok()) {
+            core_worker_stats->push_back(r.core_worker_stats());
+          }
+          on_done();
+        });
+  }
+  on_done();
+}
+
+void NodeManager::FillCoreWorkerStatsFromCache(rpc::GetNodeStatsReply *reply) const {
+  for (const auto &stats : cached_core_worker_stats_) {
+    reply->add_core_workers_stats()->CopyFrom(stats);
+  }
+  reply->set_num_workers(cached_core_worker_stats_.size());
+  reply->set_core_workers_stats_age_ms(current_time_ms() -
+                                       core_worker_stats_refresh_time_ms_);
+}
+
 rpc::ObjectStoreStats AccumulateStoreStats(
     std::vector<rpc::GetNodeStatsReply> node_stats) {
   rpc::ObjectStoreStats store_stats;
@@ -2631,6 +3055,9 @@ void NodeManager::RecordMetrics() {
   cluster_task_manager_->RecordMetrics();
   object_manager_.RecordMetrics();
   local_object_manager_.RecordMetrics();
+  if (RayConfig::instance().mutex_contention_tracing()) {
+    MutexContentionTracker::Instance().RecordMetrics();
+  }
 
   uint64_t current_time = current_time_ms();
   uint64_t duration_ms = current_time - last_metrics_recorded_at_ms_;
@@ -14,10 +14,13 @@
 
 #pragma once
 
+#include <optional>
+
 // clang-format off
 #include "ray/rpc/grpc_client.h"
 #include "ray/rpc/node_manager/node_manager_server.h"
 #include "ray/rpc/node_manager/node_manager_client.h"
+#include "ray/rpc/node_manager/node_manager_client_pool.h"
 #include "ray/common/id.h"
 #include "ray/common/task/task.h"
 #include "ray/common/ray_object.h"
@@ -34,7 +37,9 @@
 #include "ray/raylet/scheduling/cluster_task_manager.h"
 #include "ray/raylet/scheduling/cluster_task_manager_interface.h"
 #include "ray/raylet/dependency_manager.h"
+#include "ray/raylet/gossip_failure_detector.h"
 #include "ray/raylet/local_task_manager.h"
+#include "ray/raylet/memory_monitor.h"
 #include "ray/raylet/wait_manager.h"
 #include "ray/raylet/worker_pool.h"
 #include "ray/rpc/worker/core_worker_client_pool.h"
@@ -179,8 +184,12 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
 
   /// Returns debug string for class.
   ///
+  /// \param full Whether to also list the resources of every node and worker and the
+  /// remote node managers. These walks are expensive on large clusters, so the
+  /// periodic dumps only print their counts, and the full state is generated on
+  /// demand through GetNodeStats.
   /// \return string.
-  std::string DebugString() const;
+  std::string DebugString(bool full = false) const;
 
   /// Record metrics.
   void RecordMetrics();
@@ -189,6 +198,7 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   int GetServerPort() const { return node_manager_server_.GetPort(); }
 
   int GetObjectManagerPort() const { return object_manager_.GetServerPort(); }
+  int GetObjectManagerBulkPort() const { return object_manager_.GetBulkPort(); }
 
   LocalObjectManager &GetLocalObjectManager() { return local_object_manager_; }
 
@@ -272,6 +282,14 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   /// Write out debug state to a file.
   void DumpDebugState() const;
 
+  /// Collect the stats of all the workers and drivers into the worker stats cache.
+  ///
+  /// \param callback Called once the cache is refreshed.
+  void RefreshCoreWorkerStatsCache(std::function<void()> callback);
+
+  /// Fill the stats of the workers and drivers of a `NodeStats` reply from the cache.
+  void FillCoreWorkerStatsFromCache(rpc::GetNodeStatsReply *reply) const;
+
   /// Flush objects that are out of scope in the application. This will attempt
   /// to eagerly evict all plasma copies of the object from the cluster.
   void FlushObjectsToFree();
@@ -313,12 +331,14 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   /// \param ray_get Whether the task is blocked in a `ray.get` call.
   /// \param mark_worker_blocked Whether to mark the worker as blocked. This
   ///                            should be False for direct calls.
+  /// \param timeout_ms How long the client waits for the objects, -1 if forever.
   /// \return Void.
   void AsyncResolveObjects(const std::shared_ptr<ClientConnection> &client,
                            const std::vector<rpc::ObjectReference> &required_object_refs,
                            const TaskID &current_task_id,
                            bool ray_get,
-                           bool mark_worker_blocked);
+                           bool mark_worker_blocked,
+                           int64_t timeout_ms = -1);
 
   /// Handle end of a blocking object get. This could be a task assigned to a
   /// worker, an out-of-band task (e.g., a thread created by the application),
@@ -355,6 +375,12 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   /// \return Void.
   void KillWorker(std::shared_ptr<WorkerInterface> worker);
 
+  /// Kill a batch of workers. All of them are sent SIGTERM at once, and the ones that
+  /// are still alive are force killed together after a single timeout.
+  ///
+  /// \param workers The workers to kill.
+  void KillWorkers(const std::vector<std::shared_ptr<WorkerInterface>> &workers);
+
   /// Destroy a worker.
   /// We will disconnect the worker connection first and then kill the worker.
   ///
@@ -364,6 +390,13 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
       std::shared_ptr<WorkerInterface> worker,
       rpc::WorkerExitType disconnect_type = rpc::WorkerExitType::SYSTEM_ERROR_EXIT);
 
+  /// Destroy a batch of workers, see `DestroyWorker` and `KillWorkers`.
+  ///
+  /// \param workers The workers to destroy.
+  /// \param disconnect_type The reason the workers are destroyed.
+  void DestroyWorkers(const std::vector<std::shared_ptr<WorkerInterface>> &workers,
+                      rpc::WorkerExitType disconnect_type);
+
   /// When a job finished, loop over all of the queued tasks for that job and
   /// treat them as failed.
   ///
@@ -588,6 +621,30 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
                             rpc::GetObjectsInfoReply *reply,
                             rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Handle a `StealTasks` request.
+  void HandleStealTasks(const rpc::StealTasksRequest &request,
+                        rpc::StealTasksReply *reply,
+                        rpc::SendReplyCallback send_reply_callback) override;
+
+  /// If this node is idle, ask the peer with the most queued tasks to spill some of
+  /// them here.
+  void StealTasks();
+
+  /// Handle a `ProbeNode` request.
+  void HandleProbeNode(const rpc::ProbeNodeRequest &request,
+                       rpc::ProbeNodeReply *reply,
+                       rpc::SendReplyCallback send_reply_callback) override;
+
+  /// Handle a `ProfileCpu` request.
+  void HandleProfileCpu(const rpc::ProfileCpuRequest &request,
+                        rpc::ProfileCpuReply *reply,
+                        rpc::SendReplyCallback send_reply_callback) override;
+
+  /// Send a probe of the gossip failure detector.
+  void ProbeNode(const rpc::Address &node,
+                 const absl::optional<rpc::Address> &relay,
+                 std::function<void(bool reachable)> callback);
+
   /// Trigger local GC on each worker of this raylet.
   void DoLocalGC(bool triggered_by_global_gc = false);
 
@@ -595,6 +652,10 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   /// unable to schedule new tasks or actors at all.
   void WarnResourceDeadlock();
 
+  /// Sample the memory usage of the node, and if it's running out of memory, stop
+  /// dispatching tasks and kill a worker whose task can be retried.
+  void CheckMemoryPressure();
+
   /// Dispatch tasks to available workers.
   void DispatchScheduledTasksToWorkers();
 
@@ -651,6 +712,11 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   std::shared_ptr<gcs::GcsClient> gcs_client_;
   /// Class to send heartbeat to GCS.
   std::unique_ptr<HeartbeatSender> heartbeat_sender_;
+  /// Probes the other nodes instead of sending heartbeats to the GCS, if gossip
+  /// failure detection is enabled.
+  std::unique_ptr<GossipFailureDetector> gossip_failure_detector_;
+  /// Samples the memory usage of the node, if the memory monitor is enabled.
+  std::unique_ptr<MemoryMonitor> memory_monitor_;
   /// A pool of workers.
   WorkerPool worker_pool_;
   /// The `ClientCallManager` object that is shared by all `NodeManagerClient`s
@@ -658,6 +724,9 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   rpc::ClientCallManager client_call_manager_;
   /// Pool of RPC client connections to core workers.
   rpc::CoreWorkerClientPool worker_rpc_pool_;
+  /// Pool of RPC client connections to the raylets that resource broadcasts are
+  /// relayed to.
+  rpc::NodeManagerClientPool raylet_rpc_pool_;
   /// The raylet client to initiate the pubsub to core workers (owners).
   /// It is used to subscribe objects to evict.
   std::unique_ptr<pubsub::SubscriberInterface> core_worker_subscriber_;
@@ -682,6 +751,14 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   int resource_deadlock_warned_ = 0;
   /// Whether we have recorded any metrics yet.
   bool recorded_metrics_ = false;
+
+  /// The stats of the workers and drivers, collected for `NodeStats` requests if
+  /// `node_stats_cache_refresh_interval_ms` is set.
+  std::vector<rpc::CoreWorkerStats> cached_core_worker_stats_;
+  /// When the cache was last refreshed, or 0 if it never was.
+  int64_t core_worker_stats_refresh_time_ms_ = 0;
+  /// The callbacks waiting for the refresh of the cache in progress, if any.
+  std::optional<std::vector<std::function<void()>>> core_worker_stats_refresh_callbacks_;
   /// The path to the ray temp dir.
   std::string temp_dir_;
   /// Initial node manager configuration.
@@ -783,6 +860,17 @@ class NodeManager : public rpc::NodeManagerServiceHandler {
   /// Number of tasks that are spilled back to other nodes.
   uint64_t metrics_num_task_spilled_back_;
 
+  /// The last resource report served to the GCS, and its version, which is bumped
+  /// whenever the report changes.
+  rpc::ResourcesData last_resource_report_;
+  int64_t resource_report_version_ = 0;
+
+  /// Number of tasks queued on each remote node, as of its last resource report.
+  absl::flat_hash_map<NodeID, uint64_t> remote_node_num_queued_tasks_;
+
+  /// Whether a `StealTasks` request sent by this node is in flight.
+  bool steal_tasks_in_flight_ = false;
+
   /// Managers all bundle-related operations.
   std::shared_ptr<PlacementGroupResourceManager> placement_group_resource_manager_;
 
@@ -125,18 +125,13 @@ void NewPlacementGroupResourceManager::CommitBundle(
 
   const auto &task_resource_instances = *bundle_state->resources_;
 
-  const auto &resources = bundle_spec.GetFormattedResources();
-  for (const auto &resource : resources) {
-    const auto &resource_name = resource.first;
-    const auto &original_resource_name = GetOriginalResourceName(resource_name);
-    if (original_resource_name != kBundle_ResourceLabel) {
-      const auto &instances =
-          task_resource_instances.Get(ResourceID(original_resource_name));
-      cluster_resource_scheduler_->GetLocalResourceManager().AddLocalResourceInstances(
-          scheduling::ResourceID{resource_name}, instances);
+  auto &local_resource_manager = cluster_resource_scheduler_->GetLocalResourceManager();
+  for (const auto &resource : bundle_spec.GetFormattedResourceIds()) {
+    if (!resource.original_id.IsNil()) {
+      const auto &instances = task_resource_instances.Get(resource.original_id);
+      local_resource_manager.AddLocalResourceInstances(resource.id, instances);
     } else {
-      cluster_resource_scheduler_->GetLocalResourceManager().AddLocalResourceInstances(
-          scheduling::ResourceID{resource_name}, {resource.second});
+      local_resource_manager.AddLocalResourceInstances(resource.id, {resource.value});
     }
   }
 }
@@ -169,23 +164,22 @@ void NewPlacementGroupResourceManager::ReturnBundle(
 
   // Substract placement group resources from resource allocator
   // `ClusterResourceScheduler`.
-  const auto &placement_group_resources = bundle_spec.GetFormattedResources();
   auto resource_instances = std::make_shared<TaskResourceInstances>();
   cluster_resource_scheduler_->GetLocalResourceManager().AllocateLocalTaskResources(
-      placement_group_resources, resource_instances);
+      bundle_spec.GetFormattedResourceRequest(), resource_instances);
 
-  for (const auto &resource : placement_group_resources) {
-    auto resource_id = scheduling::ResourceID{resource.first};
+  for (const auto &resource : bundle_spec.GetFormattedResourceIds()) {
+    const auto &resource_id = resource.id;
     if (cluster_resource_scheduler_->GetLocalResourceManager().IsAvailableResourceEmpty(
             resource_id)) {
-      RAY_LOG(DEBUG) << "Available bundle resource:[" << resource.first
+      RAY_LOG(DEBUG) << "Available bundle resource:[" << resource_id
                      << "] is empty, Will delete it from local resource";
       // Delete local resource if available resource is empty when return bundle, or there
       // will be resource leak.
       cluster_resource_scheduler_->GetLocalResourceManager().DeleteLocalResource(
           resource_id);
     } else {
-      RAY_LOG(DEBUG) << "Available bundle resource:[" << resource.first
+      RAY_LOG(DEBUG) << "Available bundle resource:[" << resource_id
                      << "] is not empty. Resources are not deleted from the local node.";
     }
   }
@@ -20,6 +20,7 @@
 #include <iostream>
 
 #include "ray/common/status.h"
+#include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
 
 namespace {
@@ -85,6 +86,7 @@ Raylet::Raylet(instrumented_io_context &main_service,
   self_node_info_.set_raylet_socket_name(socket_name);
   self_node_info_.set_object_store_socket_name(object_manager_config.store_socket_name);
   self_node_info_.set_object_manager_port(node_manager_.GetObjectManagerPort());
+  self_node_info_.set_object_manager_bulk_port(node_manager_.GetObjectManagerBulkPort());
   self_node_info_.set_node_manager_port(node_manager_.GetServerPort());
   self_node_info_.set_node_manager_hostname(boost::asio::ip::host_name());
   self_node_info_.set_metrics_export_port(metrics_export_port);
@@ -95,8 +97,18 @@ Raylet::Raylet(instrumented_io_context &main_service,
 
 Raylet::~Raylet() {}
 
-void Raylet::Start() {
-  RAY_CHECK_OK(RegisterGcs());
+void Raylet::Start(int64_t process_start_time_ms) {
+  const int64_t register_start_time_ms = current_time_ms();
+  RAY_CHECK_OK(RegisterGcs([process_start_time_ms, register_start_time_ms]() {
+    const int64_t now_ms = current_time_ms();
+    ray::stats::STATS_raylet_startup_time_ms.Record(now_ms - register_start_time_ms,
+                                                    "Register");
+    ray::stats::STATS_raylet_startup_time_ms.Record(now_ms - process_start_time_ms,
+                                                    "Total");
+    RAY_LOG(INFO) << "Raylet became ready " << now_ms - process_start_time_ms
+                  << "ms after it started, registering with the GCS took "
+                  << now_ms - register_start_time_ms << "ms.";
+  }));
 
   // Start listening for clients.
   DoAccept();
@@ -108,8 +120,8 @@ void Raylet::Stop() {
   acceptor_.close();
 }
 
-ray::Status Raylet::RegisterGcs() {
-  auto register_callback = [this](const Status &status) {
+ray::Status Raylet::RegisterGcs(std::function<void()> on_registered) {
+  auto register_callback = [this, on_registered](const Status &status) {
     RAY_CHECK_OK(status);
     RAY_LOG(INFO) << "Raylet of id, " << self_node_id_
                   << " started. Raylet consists of node_manager and object_manager."
@@ -119,6 +131,7 @@ ray::Status Raylet::RegisterGcs() {
                   << ":" << self_node_info_.object_manager_port()
                   << " hostname: " << self_node_info_.node_manager_address();
     RAY_CHECK_OK(node_manager_.RegisterGcs());
+    on_registered();
   };
 
   RAY_RETURN_NOT_OK(
@@ -57,7 +57,10 @@ class Raylet {
          int metrics_export_port);
 
   /// Start this raylet.
-  void Start();
+  ///
+  /// \param process_start_time_ms The time the raylet process started, to report how
+  /// long it took to become ready.
+  void Start(int64_t process_start_time_ms = current_time_ms());
 
   /// Stop this raylet.
   void Stop();
@@ -69,7 +72,9 @@ class Raylet {
 
  private:
   /// Register GCS client.
-  ray::Status RegisterGcs();
+  ///
+  /// \param on_registered Called once the raylet is registered.
+  ray::Status RegisterGcs(std::function<void()> on_registered);
 
   /// Accept a client connection.
   void DoAccept();
@@ -20,10 +20,6 @@
 namespace ray {
 using namespace ::ray::scheduling;
 
-bool IsPredefinedResource(scheduling::ResourceID resource) {
-  return resource.ToInt() >= 0 && resource.ToInt() < PredefinedResourcesEnum_MAX;
-}
-
 /// Convert a map of resources to a ResourceRequest data structure.
 ResourceRequest ResourceMapToResourceRequest(
     const absl::flat_hash_map<std::string, double> &resource_map,
@@ -35,6 +31,15 @@ ResourceRequest ResourceMapToResourceRequest(
   return res;
 }
 
+ResourceRequest ResourceMapToResourceRequest(
+    const google::protobuf::Map<std::string, double> &resource_map) {
+  ResourceRequest res;
+  for (const auto &entry : resource_map) {
+    res.Set(ResourceID(entry.first), FixedPoint(entry.second));
+  }
+  return res;
+}
+
 /// Convert a map of resources to a ResourceRequest data structure.
 ///
 /// \param string_to_int_map: Map between names and ids maintained by the
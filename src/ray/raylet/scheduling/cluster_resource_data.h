@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <google/protobuf/map.h>
+
+#include <algorithm>
+#include <array>
 #include <boost/range/adaptor/map.hpp>
 #include <iostream>
 #include <sstream>
@@ -30,17 +34,25 @@ namespace ray {
 
 using scheduling::ResourceID;
 
-bool IsPredefinedResource(scheduling::ResourceID resource_id);
+/// Whether the given resource is one of the predefined resources (CPU, memory, GPU and
+/// object store memory).
+inline bool IsPredefinedResource(scheduling::ResourceID resource_id) {
+  return resource_id.ToInt() >= 0 && resource_id.ToInt() < PredefinedResourcesEnum_MAX;
+}
 
 /// Represents a set of resources.
 /// NOTE: negative values are valid in this set, while 0 is not. This means if any
 /// resource value is changed to 0, the resource will be removed.
+///
+/// The predefined resources are stored in a fixed-size dense array indexed by
+/// `PredefinedResourcesEnum`, and custom resources are stored in a small vector sorted
+/// by resource ID. This keeps the comparisons done by the scheduler for every
+/// (request, node) pair free of hashing, and mostly within a single cache line.
 /// TODO(hchen): This class should be independent with tasks. We should move out the
 /// "requires_object_store_memory_" field, and rename this class to ResourceSet.
 class ResourceRequest {
  public:
-  using ResourceIdIterator =
-      boost::select_first_range<absl::flat_hash_map<ResourceID, FixedPoint>>;
+  using ResourceIdIterator = std::vector<ResourceID>;
 
   /// Construct an empty ResourceRequest.
   ResourceRequest() : ResourceRequest({}, false) {}
@@ -53,9 +65,7 @@ class ResourceRequest {
                   bool requires_object_store_memory)
       : requires_object_store_memory_(requires_object_store_memory) {
     for (auto entry : resource_map) {
-      if (entry.second != 0) {
-        resources_[entry.first] = entry.second;
-      }
+      Set(entry.first, entry.second);
     }
   }
 
@@ -66,8 +76,11 @@ class ResourceRequest {
   /// Get the value of a particular resource.
   /// If the resource doesn't exist, return 0.
   FixedPoint Get(ResourceID resource_id) const {
-    auto it = resources_.find(resource_id);
-    if (it == resources_.end()) {
+    if (IsPredefinedResource(resource_id)) {
+      return predefined_resources_[resource_id.ToInt()];
+    }
+    auto it = FindCustom(resource_id);
+    if (it == custom_resources_.end() || it->first != resource_id) {
       return FixedPoint(0);
     } else {
       return it->second;
@@ -77,44 +90,101 @@ class ResourceRequest {
   /// Set a resource to the given value.
   /// NOTE: if the new value is 0, the resource will be removed.
   ResourceRequest &Set(ResourceID resource_id, FixedPoint value) {
+    if (IsPredefinedResource(resource_id)) {
+      predefined_resources_[resource_id.ToInt()] = value;
+      return *this;
+    }
+    auto it = FindCustom(resource_id);
+    bool exists = it != custom_resources_.end() && it->first == resource_id;
     if (value == 0) {
-      resources_.erase(resource_id);
+      if (exists) {
+        custom_resources_.erase(it);
+      }
+    } else if (exists) {
+      it->second = value;
     } else {
-      resources_[resource_id] = value;
+      custom_resources_.emplace(it, resource_id, value);
     }
     return *this;
   }
 
   /// Check whether a particular resource exist.
-  bool Has(ResourceID resource_id) const { return resources_.contains(resource_id); }
+  bool Has(ResourceID resource_id) const { return Get(resource_id) != 0; }
 
   /// Clear the whole set.
-  void Clear() { resources_.clear(); }
+  void Clear() {
+    predefined_resources_.fill(FixedPoint(0));
+    custom_resources_.clear();
+  }
 
   /// Remove the negative values in this set.
   void RemoveNegative() {
-    for (auto it = resources_.begin(); it != resources_.end();) {
-      if (it->second < 0) {
-        resources_.erase(it++);
-      } else {
-        it++;
+    for (auto &value : predefined_resources_) {
+      if (value < 0) {
+        value = FixedPoint(0);
       }
     }
+    custom_resources_.erase(
+        std::remove_if(custom_resources_.begin(),
+                       custom_resources_.end(),
+                       [](const std::pair<ResourceID, FixedPoint> &entry) {
+                         return entry.second < 0;
+                       }),
+        custom_resources_.end());
   }
 
   /// Return the number of resources in this set.
-  size_t Size() const { return resources_.size(); }
+  size_t Size() const {
+    size_t size = custom_resources_.size();
+    for (auto &value : predefined_resources_) {
+      if (value != 0) {
+        size++;
+      }
+    }
+    return size;
+  }
 
   /// Return true if this set is empty.
-  bool IsEmpty() const { return resources_.empty(); }
+  bool IsEmpty() const { return Size() == 0; }
 
-  /// Return a boost::range object that can be used as an iterator of the resource IDs.
-  ResourceIdIterator ResourceIds() const { return boost::adaptors::keys(resources_); }
+  /// Return true if this set contains any non-predefined resource.
+  bool HasCustomResources() const { return !custom_resources_.empty(); }
+
+  /// Return true if any custom resource in this set has a negative value.
+  bool HasNegativeCustomResources() const {
+    for (auto &entry : custom_resources_) {
+      if (entry.second < 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Return the IDs of the resources in this set. Predefined resources come first, in
+  /// the order of `PredefinedResourcesEnum`, followed by custom resources sorted by ID.
+  ResourceIdIterator ResourceIds() const {
+    ResourceIdIterator ids;
+    ids.reserve(PredefinedResourcesEnum_MAX + custom_resources_.size());
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      if (predefined_resources_[i] != 0) {
+        ids.emplace_back(i);
+      }
+    }
+    for (auto &entry : custom_resources_) {
+      ids.push_back(entry.first);
+    }
+    return ids;
+  }
 
   /// Return a map from the resource ids to the values.
   absl::flat_hash_map<ResourceID, FixedPoint> ToMap() const {
     absl::flat_hash_map<ResourceID, FixedPoint> res;
-    for (auto entry : resources_) {
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      if (predefined_resources_[i] != 0) {
+        res.emplace(ResourceID(i), predefined_resources_[i]);
+      }
+    }
+    for (auto &entry : custom_resources_) {
       res.emplace(entry.first, entry.second);
     }
     return res;
@@ -123,7 +193,7 @@ class ResourceRequest {
   /// Return a map from resource names (string) to values (double).
   absl::flat_hash_map<std::string, double> ToResourceMap() const {
     absl::flat_hash_map<std::string, double> resource_map;
-    for (auto entry : resources_) {
+    for (auto &entry : ToMap()) {
       resource_map.emplace(entry.first.Binary(), entry.second.Double());
     }
     return resource_map;
@@ -142,63 +212,81 @@ class ResourceRequest {
   }
 
   ResourceRequest &operator+=(const ResourceRequest &other) {
-    for (auto &entry : other.resources_) {
-      auto it = resources_.find(entry.first);
-      if (it != resources_.end()) {
-        it->second += entry.second;
-        if (it->second == 0) {
-          resources_.erase(it);
-        }
-      } else {
-        resources_.emplace(entry.first, entry.second);
-      }
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      predefined_resources_[i] += other.predefined_resources_[i];
+    }
+    for (auto &entry : other.custom_resources_) {
+      Set(entry.first, Get(entry.first) + entry.second);
     }
     return *this;
   }
 
   ResourceRequest &operator-=(const ResourceRequest &other) {
-    for (auto &entry : other.resources_) {
-      auto it = resources_.find(entry.first);
-      if (it != resources_.end()) {
-        it->second -= entry.second;
-        if (it->second == 0) {
-          resources_.erase(it);
-        }
-      } else {
-        resources_.emplace(entry.first, -entry.second);
-      }
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      predefined_resources_[i] -= other.predefined_resources_[i];
+    }
+    for (auto &entry : other.custom_resources_) {
+      Set(entry.first, Get(entry.first) - entry.second);
     }
     return *this;
   }
 
   bool operator==(const ResourceRequest &other) const {
-    return this->resources_ == other.resources_;
+    return this->predefined_resources_ == other.predefined_resources_ &&
+           this->custom_resources_ == other.custom_resources_;
   }
 
   bool operator!=(const ResourceRequest &other) const { return !(*this == other); }
 
+  /// Hash the resources, so that requests can be keys of hash containers. Consistent
+  /// with `operator==`.
+  template <typename H>
+  friend H AbslHashValue(H h, const ResourceRequest &request) {
+    for (const auto &value : request.predefined_resources_) {
+      h = H::combine(std::move(h), value.Double());
+    }
+    for (const auto &entry : request.custom_resources_) {
+      h = H::combine(std::move(h), entry.first.ToInt(), entry.second.Double());
+    }
+    return H::combine(std::move(h), request.custom_resources_.size());
+  }
+
   /// Check whether this set is a subset of another one.
   /// If A <= B, it means for each resource, its value in A is less than or equqal to that
   /// in B.
   bool operator<=(const ResourceRequest &other) const {
-    // Check all resources that exist in this.
-    for (auto &entry : resources_) {
-      auto &this_value = entry.second;
-      auto other_value = FixedPoint(0);
-      auto it = other.resources_.find(entry.first);
-      if (it != other.resources_.end()) {
-        other_value = it->second;
-      }
-      if (this_value > other_value) {
+    // Absent predefined resources are stored as 0, so a plain element-wise comparison
+    // covers resources that only exist in one of the two sets.
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      if (predefined_resources_[i] > other.predefined_resources_[i]) {
         return false;
       }
     }
-    // Check all resources that exist in other, but not in this.
-    for (auto &entry : other.resources_) {
-      if (!resources_.contains(entry.first)) {
-        if (entry.second < 0) {
+    // Both custom resource vectors are sorted by ID, so merge them in a single pass.
+    auto this_it = custom_resources_.begin();
+    auto other_it = other.custom_resources_.begin();
+    while (this_it != custom_resources_.end() ||
+           other_it != other.custom_resources_.end()) {
+      if (other_it == other.custom_resources_.end() ||
+          (this_it != custom_resources_.end() && this_it->first < other_it->first)) {
+        // The resource only exists in this.
+        if (this_it->second > 0) {
           return false;
         }
+        this_it++;
+      } else if (this_it == custom_resources_.end() ||
+                 other_it->first < this_it->first) {
+        // The resource only exists in other.
+        if (other_it->second < 0) {
+          return false;
+        }
+        other_it++;
+      } else {
+        if (this_it->second > other_it->second) {
+          return false;
+        }
+        this_it++;
+        other_it++;
       }
     }
     return true;
@@ -226,8 +314,33 @@ class ResourceRequest {
   }
 
  private:
-  /// Map from the resource IDs to the resource values.
-  absl::flat_hash_map<ResourceID, FixedPoint> resources_;
+  using CustomResources = std::vector<std::pair<ResourceID, FixedPoint>>;
+
+  static bool LessThanId(const std::pair<ResourceID, FixedPoint> &entry, ResourceID id) {
+    return entry.first < id;
+  }
+
+  /// Return an iterator to the first custom resource whose ID is not less than the
+  /// given one.
+  CustomResources::const_iterator FindCustom(ResourceID resource_id) const {
+    return std::lower_bound(custom_resources_.begin(),
+                            custom_resources_.end(),
+                            resource_id,
+                            LessThanId);
+  }
+
+  CustomResources::iterator FindCustom(ResourceID resource_id) {
+    return std::lower_bound(custom_resources_.begin(),
+                            custom_resources_.end(),
+                            resource_id,
+                            LessThanId);
+  }
+
+  /// Values of the predefined resources, indexed by `PredefinedResourcesEnum`. Absent
+  /// resources have the value 0.
+  std::array<FixedPoint, PredefinedResourcesEnum_MAX> predefined_resources_;
+  /// Custom resources and their values, sorted by resource ID. Never contains 0 values.
+  CustomResources custom_resources_;
   /// Whether this task requires object store memory.
   /// TODO(swang): This should be a quantity instead of a flag.
   bool requires_object_store_memory_ = false;
@@ -499,4 +612,9 @@ ResourceRequest ResourceMapToResourceRequest(
     const absl::flat_hash_map<std::string, double> &resource_map,
     bool requires_object_store_memory);
 
+/// Convert a protobuf map of resources to a ResourceRequest data structure, without
+/// going through an intermediate map.
+ResourceRequest ResourceMapToResourceRequest(
+    const google::protobuf::Map<std::string, double> &resource_map);
+
 }  // namespace ray
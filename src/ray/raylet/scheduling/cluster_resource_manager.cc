@@ -22,7 +22,7 @@
 
 namespace ray {
 
-ClusterResourceManager::ClusterResourceManager() : nodes_{} {}
+ClusterResourceManager::ClusterResourceManager() : nodes_{}, resource_columns_{} {}
 
 void ClusterResourceManager::AddOrUpdateNode(
     scheduling::NodeID node_id,
@@ -43,30 +43,77 @@ void ClusterResourceManager::AddOrUpdateNode(scheduling::NodeID node_id,
     nodes_.emplace(node_id, node_resources);
   } else {
     // This node exists, so update its resources.
+    const auto &local_view = it->second.GetLocalView();
+    bool changed = local_view != node_resources ||
+                   local_view.object_pulls_queued != node_resources.object_pulls_queued;
     it->second = Node(node_resources);
+    if (!changed) {
+      return;
+    }
+  }
+  OnNodeResourcesChanged(node_id, node_resources);
+}
+
+void ClusterResourceManager::OnNodeResourcesChanged(scheduling::NodeID node_id,
+                                                    const NodeResources &node_resources) {
+  resource_columns_.Update(node_id, node_resources);
+  resource_shape_index_.UpdateNode(node_id, node_resources);
+  resource_view_version_++;
+}
+
+void ClusterResourceManager::TrackResourceShape(const ResourceRequest &shape) {
+  resource_shape_index_.AddShape(shape);
+}
+
+void ClusterResourceManager::UntrackResourceShape(const ResourceRequest &shape) {
+  resource_shape_index_.RemoveShape(shape);
+}
+
+bool ClusterResourceManager::HasFeasibleNode(const ResourceRequest &shape) const {
+  if (resource_shape_index_.HasShape(shape)) {
+    return !resource_shape_index_.GetFeasibleNodes(shape).empty();
+  }
+  for (const auto &entry : nodes_) {
+    if (entry.second.GetLocalView().IsFeasible(shape)) {
+      return true;
+    }
   }
+  return false;
 }
 
 bool ClusterResourceManager::UpdateNode(scheduling::NodeID node_id,
                                         const rpc::ResourcesData &resource_data) {
-  if (!nodes_.contains(node_id)) {
+  auto it = nodes_.find(node_id);
+  if (it == nodes_.end()) {
     return false;
   }
 
-  auto resources_total = MapFromProtobuf(resource_data.resources_total());
-  auto resources_available = MapFromProtobuf(resource_data.resources_available());
-  NodeResources node_resources =
-      ResourceMapToNodeResources(resources_total, resources_available);
-  NodeResources local_view;
-  RAY_CHECK(GetNodeResources(node_id, &local_view));
-
-  local_view.total = node_resources.total;
+  // Most reports don't change anything, so compare them with our view in place and
+  // only apply, and notify about, what changed.
+  auto *local_view = it->second.GetMutableLocalView();
+  bool changed = false;
+  auto total = ResourceMapToResourceRequest(resource_data.resources_total());
+  if (local_view->total != total) {
+    local_view->total = std::move(total);
+    changed = true;
+  }
   if (resource_data.resources_available_changed()) {
-    local_view.available = node_resources.available;
-    local_view.object_pulls_queued = resource_data.object_pulls_queued();
+    auto available = ResourceMapToResourceRequest(resource_data.resources_available());
+    if (local_view->available != available) {
+      local_view->available = std::move(available);
+      changed = true;
+    }
+    if (local_view->object_pulls_queued != resource_data.object_pulls_queued()) {
+      local_view->object_pulls_queued = resource_data.object_pulls_queued();
+      changed = true;
+    }
   }
 
-  AddOrUpdateNode(node_id, local_view);
+  if (changed) {
+    RAY_LOG(DEBUG) << "Update node info, node_id: " << node_id.ToInt()
+                   << ", node_resources: " << local_view->DebugString();
+    OnNodeResourcesChanged(node_id, *local_view);
+  }
   return true;
 }
 
@@ -77,6 +124,9 @@ bool ClusterResourceManager::RemoveNode(scheduling::NodeID node_id) {
     return false;
   } else {
     nodes_.erase(it);
+    resource_columns_.Remove(node_id);
+    resource_shape_index_.RemoveNode(node_id);
+    resource_view_version_++;
     return true;
   }
 }
@@ -124,6 +174,7 @@ void ClusterResourceManager::UpdateResourceCapacity(scheduling::NodeID node_id,
   }
   local_view->total.Set(resource_id, total);
   local_view->available.Set(resource_id, available);
+  OnNodeResourcesChanged(node_id, *local_view);
 }
 
 void ClusterResourceManager::DeleteResource(scheduling::NodeID node_id,
@@ -136,6 +187,7 @@ void ClusterResourceManager::DeleteResource(scheduling::NodeID node_id,
   auto local_view = it->second.GetMutableLocalView();
   local_view->total.Set(resource_id, 0);
   local_view->available.Set(resource_id, 0);
+  OnNodeResourcesChanged(node_id, *local_view);
 }
 
 std::string ClusterResourceManager::GetNodeResourceViewString(
@@ -153,6 +205,10 @@ const absl::flat_hash_map<scheduling::NodeID, Node>
   return nodes_;
 }
 
+const NodeResourceColumns &ClusterResourceManager::GetResourceColumns() const {
+  return resource_columns_;
+}
+
 bool ClusterResourceManager::SubtractNodeAvailableResources(
     scheduling::NodeID node_id, const ResourceRequest &resource_request) {
   auto it = nodes_.find(node_id);
@@ -164,6 +220,7 @@ bool ClusterResourceManager::SubtractNodeAvailableResources(
 
   resources->available -= resource_request;
   resources->available.RemoveNegative();
+  OnNodeResourcesChanged(node_id, *resources);
 
   // TODO(swang): We should also subtract object store memory if the task has
   // arguments. Right now we do not modify object_pulls_queued in case of
@@ -210,6 +267,7 @@ bool ClusterResourceManager::AddNodeAvailableResources(
       node_resources->available.Set(resource_id, new_available);
     }
   }
+  OnNodeResourcesChanged(node_id, *node_resources);
   return true;
 }
 
@@ -234,6 +292,7 @@ bool ClusterResourceManager::UpdateNodeAvailableResourcesIfExist(
   for (auto &resource_id : node_resources->total.ResourceIds()) {
     node_resources->available.Set(resource_id, resources.Get(resource_id));
   }
+  OnNodeResourcesChanged(node_id, *node_resources);
   return true;
 }
 
@@ -25,6 +25,8 @@
 #include "ray/raylet/scheduling/cluster_resource_data.h"
 #include "ray/raylet/scheduling/fixed_point.h"
 #include "ray/raylet/scheduling/local_resource_manager.h"
+#include "ray/raylet/scheduling/node_resource_columns.h"
+#include "ray/raylet/scheduling/resource_shape_index.h"
 #include "ray/util/logging.h"
 #include "src/ray/protobuf/gcs.pb.h"
 
@@ -43,6 +45,28 @@ class ClusterResourceManager {
   /// Get the resource view of the cluster.
   const absl::flat_hash_map<scheduling::NodeID, Node> &GetResourceView() const;
 
+  /// Get the structure-of-arrays view of the predefined resources of the cluster. It is
+  /// always consistent with `GetResourceView`.
+  const NodeResourceColumns &GetResourceColumns() const;
+
+  /// Get the version of the resource view. It is bumped every time the total or
+  /// available resources, or the pull manager state, of any node changes, and when nodes
+  /// are added or removed. Callers can use it to tell whether a scheduling decision
+  /// computed earlier is still valid.
+  uint64_t GetResourceViewVersion() const { return resource_view_version_; }
+
+  /// Start tracking the nodes whose total resources satisfy a resource shape, see
+  /// `HasFeasibleNode`. Each call must be matched by a call to `UntrackResourceShape`.
+  void TrackResourceShape(const ResourceRequest &shape);
+
+  /// Stop tracking a resource shape.
+  void UntrackResourceShape(const ResourceRequest &shape);
+
+  /// Return whether the total resources of any node satisfy a resource shape. This is
+  /// cheap for shapes tracked by `TrackResourceShape`, and falls back to a scan of all
+  /// nodes for other shapes.
+  bool HasFeasibleNode(const ResourceRequest &shape) const;
+
   // Mapping from predefined resource indexes to resource strings
   std::string GetResourceNameFromIndex(int64_t res_idx);
 
@@ -124,9 +148,6 @@ class ClusterResourceManager {
 
   void DebugString(std::stringstream &buffer) const;
 
- private:
-  friend class ClusterResourceScheduler;
-
   /// Add a new node or overwrite the resources of an existing node.
   ///
   /// \param node_id: Node ID.
@@ -138,13 +159,29 @@ class ClusterResourceManager {
       const absl::flat_hash_map<std::string, double> &resource_map_total,
       const absl::flat_hash_map<std::string, double> &resource_map_available);
 
+ private:
+  friend class ClusterResourceScheduler;
+
   /// Return resources associated to the given node_id in ret_resources.
   /// If node_id not found, return false; otherwise return true.
   bool GetNodeResources(scheduling::NodeID node_id, NodeResources *ret_resources) const;
 
+  /// Must be called after the local view of a node changes, to keep the columns and the
+  /// shape index in sync and bump the resource view version.
+  void OnNodeResourcesChanged(scheduling::NodeID node_id,
+                              const NodeResources &node_resources);
+
   /// List of nodes in the clusters and their resources organized as a map.
   /// The key of the map is the node ID.
   absl::flat_hash_map<scheduling::NodeID, Node> nodes_;
+  /// Columnar copy of the predefined resources in `nodes_`. Every method that changes
+  /// the local view of a node must also update this.
+  NodeResourceColumns resource_columns_;
+  /// Index from the tracked resource shapes to the nodes that can satisfy them. Kept in
+  /// sync with `nodes_` like `resource_columns_`.
+  ResourceShapeIndex resource_shape_index_;
+  /// See `GetResourceViewVersion`.
+  uint64_t resource_view_version_ = 0;
 
   friend class ClusterResourceSchedulerTest;
   friend struct ClusterResourceManagerTest;
@@ -173,4 +173,123 @@ TEST_F(ClusterResourceManagerTest, UpdateNodeNormalTaskResources) {
   ASSERT_TRUE(node_resources.normal_task_resources.Get(ResourceID::CPU()) == 0.8);
 }
 
+TEST_F(ClusterResourceManagerTest, ResourceColumnsFollowResourceView) {
+  auto check_consistent = [this]() {
+    const auto &columns = manager->GetResourceColumns();
+    ASSERT_EQ(columns.Size(), manager->GetResourceView().size());
+    for (const auto &request : {ResourceMapToResourceRequest({{"CPU", 1}}, false),
+                                ResourceMapToResourceRequest({{"CUSTOM", 1}}, false),
+                                ResourceMapToResourceRequest({}, false)}) {
+      std::vector<uint8_t> feasible;
+      std::vector<uint8_t> available;
+      columns.CheckRequest(request, &feasible, &available);
+      for (size_t i = 0; i < columns.Size(); i++) {
+        const auto &node_resources = manager->GetNodeResources(columns.NodeIdAt(i));
+        ASSERT_EQ(columns.IndexOf(columns.NodeIdAt(i)), i);
+        if (columns.NeedsFullCheck(i, request)) {
+          continue;
+        }
+        ASSERT_EQ(static_cast<bool>(feasible[i]), node_resources.IsFeasible(request));
+        ASSERT_EQ(static_cast<bool>(available[i]),
+                  node_resources.IsAvailable(request, /*ignore_at_capacity=*/true));
+      }
+    }
+  };
+
+  check_consistent();
+  ASSERT_TRUE(manager->GetResourceColumns().NeedsFullCheck(
+      0, ResourceMapToResourceRequest({{"CUSTOM", 1}}, false)));
+
+  manager->SubtractNodeAvailableResources(
+      node0, ResourceMapToResourceRequest({{"CPU", 1}}, false));
+  check_consistent();
+  std::vector<uint8_t> feasible;
+  std::vector<uint8_t> available;
+  const auto &columns = manager->GetResourceColumns();
+  columns.CheckRequest(
+      ResourceMapToResourceRequest({{"CPU", 1}}, false), &feasible, &available);
+  ASSERT_TRUE(feasible[columns.IndexOf(node0)]);
+  ASSERT_FALSE(available[columns.IndexOf(node0)]);
+
+  manager->AddNodeAvailableResources(node0,
+                                     ResourceMapToResourceRequest({{"CPU", 1}}, false));
+  manager->UpdateResourceCapacity(node3, ResourceID::CPU(), 4);
+  check_consistent();
+  ASSERT_EQ(columns.Total(columns.IndexOf(node3), CPU), 4);
+
+  manager->DeleteResource(node2, ResourceID::CPU());
+  ASSERT_TRUE(manager->RemoveNode(node0));
+  check_consistent();
+  ASSERT_EQ(columns.IndexOf(node0), columns.Size());
+  ASSERT_EQ(columns.Total(columns.IndexOf(node2), CPU), 0);
+}
+
+TEST_F(ClusterResourceManagerTest, ResourceShapeIndexTest) {
+  auto big_cpu = ResourceMapToResourceRequest({{"CPU", 2}}, false);
+  auto custom = ResourceMapToResourceRequest({{"CUSTOM", 1}}, false);
+  ASSERT_FALSE(manager->HasFeasibleNode(big_cpu));
+
+  manager->TrackResourceShape(big_cpu);
+  manager->TrackResourceShape(big_cpu);
+  manager->TrackResourceShape(custom);
+  ASSERT_FALSE(manager->HasFeasibleNode(big_cpu));
+  ASSERT_TRUE(manager->HasFeasibleNode(custom));
+
+  // Changes of available resources don't affect feasibility.
+  manager->SubtractNodeAvailableResources(node1, custom);
+  manager->SubtractNodeAvailableResources(node2, custom);
+  ASSERT_TRUE(manager->HasFeasibleNode(custom));
+
+  // A node that can satisfy the shape joins.
+  manager->UpdateResourceCapacity(node3, ResourceID::CPU(), 2);
+  ASSERT_TRUE(manager->HasFeasibleNode(big_cpu));
+  ASSERT_TRUE(manager->RemoveNode(node3));
+  ASSERT_FALSE(manager->HasFeasibleNode(big_cpu));
+
+  // An existing node grows, then shrinks.
+  manager->UpdateResourceCapacity(node0, ResourceID::CPU(), 2);
+  ASSERT_TRUE(manager->HasFeasibleNode(big_cpu));
+  manager->UpdateResourceCapacity(node0, ResourceID::CPU(), 1);
+  ASSERT_FALSE(manager->HasFeasibleNode(big_cpu));
+
+  manager->DeleteResource(node1, scheduling::ResourceID("CUSTOM"));
+  manager->DeleteResource(node2, scheduling::ResourceID("CUSTOM"));
+  ASSERT_FALSE(manager->HasFeasibleNode(custom));
+
+  // Untracked shapes are still answered correctly.
+  manager->UntrackResourceShape(big_cpu);
+  manager->UntrackResourceShape(big_cpu);
+  manager->UntrackResourceShape(custom);
+  auto small_cpu = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  ASSERT_TRUE(manager->HasFeasibleNode(small_cpu));
+  ASSERT_FALSE(manager->HasFeasibleNode(big_cpu));
+}
+
+TEST_F(ClusterResourceManagerTest, UpdateNodeOnlyAppliesChangesTest) {
+  rpc::ResourcesData resource_data;
+  (*resource_data.mutable_resources_total())["CPU"] = 1;
+  (*resource_data.mutable_resources_available())["CPU"] = 1;
+  resource_data.set_resources_available_changed(true);
+  ASSERT_FALSE(manager->UpdateNode(node3, resource_data));
+
+  // Reporting the same resources doesn't change the resource view.
+  auto version = manager->GetResourceViewVersion();
+  ASSERT_TRUE(manager->UpdateNode(node0, resource_data));
+  ASSERT_EQ(manager->GetResourceViewVersion(), version);
+
+  (*resource_data.mutable_resources_available())["CPU"] = 0;
+  ASSERT_TRUE(manager->UpdateNode(node0, resource_data));
+  ASSERT_GT(manager->GetResourceViewVersion(), version);
+  ASSERT_EQ(manager->GetNodeResources(node0).available.Get(ResourceID::CPU()), 0);
+  ASSERT_EQ(manager->GetNodeResources(node0).total.Get(ResourceID::CPU()), 1);
+
+  // The available resources are only applied when they are marked as changed.
+  version = manager->GetResourceViewVersion();
+  (*resource_data.mutable_resources_available())["CPU"] = 1;
+  resource_data.set_resources_available_changed(false);
+  ASSERT_TRUE(manager->UpdateNode(node0, resource_data));
+  ASSERT_EQ(manager->GetResourceViewVersion(), version);
+  ASSERT_EQ(manager->GetNodeResources(node0).available.Get(ResourceID::CPU()), 0);
+}
+
 }  // namespace ray
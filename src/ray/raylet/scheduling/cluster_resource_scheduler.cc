@@ -18,6 +18,7 @@
 
 #include "ray/common/grpc_util.h"
 #include "ray/common/ray_config.h"
+#include "ray/util/process.h"
 
 namespace ray {
 
@@ -82,6 +83,12 @@ void ClusterResourceScheduler::Init(
           *cluster_resource_manager_,
           /*is_node_available_fn*/
           [this](auto node_id) { return this->NodeAlive(node_id); });
+  const auto &trace_directory = RayConfig::instance().scheduler_trace_directory();
+  if (!trace_directory.empty()) {
+    trace_writer_ = SchedulingTraceWriter::Open(
+        trace_directory + "/scheduler_trace_" + std::to_string(GetPID()) + ".bin",
+        local_node_id_);
+  }
 }
 
 bool ClusterResourceScheduler::NodeAlive(scheduling::NodeID node_id) const {
@@ -95,6 +102,16 @@ bool ClusterResourceScheduler::NodeAlive(scheduling::NodeID node_id) const {
   return is_node_available_fn_(node_id);
 }
 
+scheduling::NodeID ClusterResourceScheduler::ScheduleAndRecord(
+    const ResourceRequest &resource_request, const SchedulingOptions &options) {
+  auto node_id = scheduling_policy_->Schedule(resource_request, options);
+  if (trace_writer_ != nullptr) {
+    trace_writer_->RecordDecision(
+        *cluster_resource_manager_, resource_request, options, node_id);
+  }
+  return node_id;
+}
+
 bool ClusterResourceScheduler::IsSchedulable(const ResourceRequest &resource_request,
                                              scheduling::NodeID node_id) const {
   // It's okay if the local node's pull manager is at capacity because we
@@ -116,21 +133,21 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
   // The zero cpu actor is a special case that must be handled the same way by all
   // scheduling policies.
   if (actor_creation && resource_request.IsEmpty()) {
-    return scheduling_policy_->Schedule(resource_request, SchedulingOptions::Random());
+    return ScheduleAndRecord(resource_request, SchedulingOptions::Random());
   }
 
   auto best_node_id = scheduling::NodeID::Nil();
   if (scheduling_strategy.scheduling_strategy_case() ==
       rpc::SchedulingStrategy::SchedulingStrategyCase::kSpreadSchedulingStrategy) {
     best_node_id =
-        scheduling_policy_->Schedule(resource_request,
-                                     SchedulingOptions::Spread(
-                                         /*avoid_local_node*/ force_spillback,
-                                         /*require_node_available*/ force_spillback));
+        ScheduleAndRecord(resource_request,
+                          SchedulingOptions::Spread(
+                              /*avoid_local_node*/ force_spillback,
+                              /*require_node_available*/ force_spillback));
   } else if (scheduling_strategy.scheduling_strategy_case() ==
              rpc::SchedulingStrategy::SchedulingStrategyCase::
                  kNodeAffinitySchedulingStrategy) {
-    best_node_id = scheduling_policy_->Schedule(
+    best_node_id = ScheduleAndRecord(
         resource_request,
         SchedulingOptions::NodeAffinity(
             force_spillback,
@@ -141,10 +158,10 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
     // TODO (Alex): Setting require_available == force_spillback is a hack in order to
     // remain bug compatible with the legacy scheduling algorithms.
     best_node_id =
-        scheduling_policy_->Schedule(resource_request,
-                                     SchedulingOptions::Hybrid(
-                                         /*avoid_local_node*/ force_spillback,
-                                         /*require_node_available*/ force_spillback));
+        ScheduleAndRecord(resource_request,
+                          SchedulingOptions::Hybrid(
+                              /*avoid_local_node*/ force_spillback,
+                              /*require_node_available*/ force_spillback));
   }
 
   *is_infeasible = best_node_id.IsNil();
@@ -30,6 +30,7 @@
 #include "ray/raylet/scheduling/local_resource_manager.h"
 #include "ray/raylet/scheduling/policy/composite_scheduling_policy.h"
 #include "ray/raylet/scheduling/scheduling_ids.h"
+#include "ray/raylet/scheduling/scheduling_trace.h"
 #include "ray/util/logging.h"
 #include "src/ray/protobuf/gcs.pb.h"
 
@@ -129,6 +130,11 @@ class ClusterResourceScheduler {
 
   bool NodeAlive(scheduling::NodeID node_id) const;
 
+  /// Pick a node for a resource request with the scheduling policy, and record the
+  /// decision if `scheduler_trace_directory` is set.
+  scheduling::NodeID ScheduleAndRecord(const ResourceRequest &resource_request,
+                                       const SchedulingOptions &options);
+
   /// Decrease the available resources of a node when a resource request is
   /// scheduled on the given node.
   ///
@@ -200,6 +206,8 @@ class ClusterResourceScheduler {
   /// The bundle scheduling policy to use.
   std::unique_ptr<raylet_scheduling_policy::IBundleSchedulingPolicy>
       bundle_scheduling_policy_;
+  /// Records the scheduling decisions, if enabled.
+  std::unique_ptr<SchedulingTraceWriter> trace_writer_;
 
   friend class ClusterResourceSchedulerTest;
   FRIEND_TEST(ClusterResourceSchedulerTest, PopulatePredefinedResources);
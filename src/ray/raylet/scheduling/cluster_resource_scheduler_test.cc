@@ -15,6 +15,7 @@
 // clang-format off
 #include "ray/raylet/scheduling/cluster_resource_scheduler.h"
 
+#include <algorithm>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -1487,6 +1488,40 @@ TEST_F(ClusterResourceSchedulerTest, CustomResourceInstanceTest) {
   ASSERT_FALSE(success) << resource_scheduler.DebugString();
 }
 
+TEST_F(ClusterResourceSchedulerTest, UnitInstanceAllocationTest) {
+  SetUnitInstanceResourceIds({ResourceID::GPU()});
+  ClusterResourceScheduler resource_scheduler(
+      scheduling::NodeID("local"), {{"CPU", 4}, {"GPU", 4}}, is_node_available_fn_);
+  auto &local_resource_manager = resource_scheduler.GetLocalResourceManager();
+
+  // Leave instances with 0.5 and 0.25 available.
+  auto task_allocation = std::make_shared<TaskResourceInstances>();
+  ASSERT_TRUE(local_resource_manager.AllocateTaskResourceInstances(
+      CreateResourceRequest({{ResourceID::GPU(), 0.5}}), task_allocation));
+  task_allocation = std::make_shared<TaskResourceInstances>();
+  ASSERT_TRUE(local_resource_manager.AllocateTaskResourceInstances(
+      CreateResourceRequest({{ResourceID::GPU(), 0.75}}), task_allocation));
+  NodeResourceInstances old_local_resources = local_resource_manager.GetLocalResources();
+
+  // There are only two unit-capacity instances left, so nothing is allocated.
+  task_allocation = std::make_shared<TaskResourceInstances>();
+  ASSERT_FALSE(local_resource_manager.AllocateTaskResourceInstances(
+      CreateResourceRequest({{ResourceID::GPU(), 3}}), task_allocation));
+  ASSERT_TRUE(local_resource_manager.GetLocalResources() == old_local_resources);
+
+  // The fractional part goes to the instance it fits exactly.
+  task_allocation = std::make_shared<TaskResourceInstances>();
+  ASSERT_TRUE(local_resource_manager.AllocateTaskResourceInstances(
+      CreateResourceRequest({{ResourceID::GPU(), 2.25}}), task_allocation));
+  auto gpu_allocation = task_allocation->Get(ResourceID::GPU());
+  ASSERT_EQ(FixedPoint::Sum(gpu_allocation), 2.25);
+  ASSERT_EQ(std::count(gpu_allocation.begin(), gpu_allocation.end(), FixedPoint(1.)), 2);
+  auto gpu_available =
+      local_resource_manager.GetLocalResources().available.Get(ResourceID::GPU());
+  ASSERT_EQ(FixedPoint::Sum(gpu_available), 0.5);
+  ASSERT_EQ(std::count(gpu_available.begin(), gpu_available.end(), FixedPoint(0.5)), 1);
+}
+
 TEST_F(ClusterResourceSchedulerTest, TaskResourceInstancesSerializedStringTest) {
   SetUnitInstanceResourceIds({ResourceID("GPU")});
   ClusterResourceScheduler resource_scheduler(scheduling::NodeID("local"),
@@ -30,7 +30,8 @@ ClusterTaskManager::ClusterTaskManager(
     internal::NodeInfoGetter get_node_info,
     std::function<void(const RayTask &)> announce_infeasible_task,
     std::shared_ptr<ILocalTaskManager> local_task_manager,
-    std::function<int64_t(void)> get_time_ms)
+    std::function<int64_t(void)> get_time_ms,
+    int64_t task_args_prefetch_lookahead)
     : self_node_id_(self_node_id),
       cluster_resource_scheduler_(cluster_resource_scheduler),
       get_node_info_(get_node_info),
@@ -39,7 +40,8 @@ ClusterTaskManager::ClusterTaskManager(
       scheduler_resource_reporter_(
           tasks_to_schedule_, infeasible_tasks_, *local_task_manager_),
       internal_stats_(*this, *local_task_manager_),
-      get_time_ms_(get_time_ms) {}
+      get_time_ms_(get_time_ms),
+      task_args_prefetch_lookahead_(task_args_prefetch_lookahead) {}
 
 void ClusterTaskManager::QueueAndScheduleTask(
     const RayTask &task,
@@ -75,15 +77,42 @@ void ReplyCancelled(const internal::Work &work,
   reply->set_scheduling_failure_message(scheduling_failure_message);
   callback();
 }
+
+/// Whether the scheduling decision for a task only depends on its scheduling class and
+/// the cluster resource view, so that it can be shared by every task of that class.
+/// This is the case for everything that goes through the hybrid policy.
+bool IsSchedulingDecisionCacheable(const TaskSpecification &task_spec) {
+  if (task_spec.IsActorCreationTask() &&
+      task_spec.GetRequiredPlacementResources().IsEmpty()) {
+    // Zero-resource actors are placed by the random policy.
+    return false;
+  }
+  const auto strategy_case =
+      task_spec.GetMessage().scheduling_strategy().scheduling_strategy_case();
+  return strategy_case !=
+             rpc::SchedulingStrategy::SchedulingStrategyCase::kSpreadSchedulingStrategy &&
+         strategy_case != rpc::SchedulingStrategy::SchedulingStrategyCase::
+                              kNodeAffinitySchedulingStrategy;
+}
 }  // namespace
 
 void ClusterTaskManager::ScheduleAndDispatchTasks() {
   // Always try to schedule infeasible tasks in case they are now feasible.
   TryScheduleInfeasibleTask();
+  const auto &cluster_resource_manager =
+      cluster_resource_scheduler_->GetClusterResourceManager();
   for (auto shapes_it = tasks_to_schedule_.begin();
        shapes_it != tasks_to_schedule_.end();) {
     auto &work_queue = shapes_it->second;
     bool is_infeasible = false;
+    // All tasks in this queue share a scheduling class. As long as the resource view
+    // doesn't change (e.g. tasks are queued locally without being dispatched yet), they
+    // get the same decision, so cache it instead of rerunning the policy over the whole
+    // cluster for every task.
+    const bool cacheable =
+        !work_queue.empty() &&
+        IsSchedulingDecisionCacheable(work_queue.front()->task.GetTaskSpecification());
+    SchedulingDecisionCache cache;
     for (auto work_it = work_queue.begin(); work_it != work_queue.end();) {
       // Check every task in task_to_schedule queue to see
       // whether it can be scheduled. This avoids head-of-line
@@ -94,12 +123,26 @@ void ClusterTaskManager::ScheduleAndDispatchTasks() {
       RayTask task = work->task;
       RAY_LOG(DEBUG) << "Scheduling pending task "
                      << task.GetTaskSpecification().TaskId();
-      auto scheduling_node_id = cluster_resource_scheduler_->GetBestSchedulableNode(
-          task.GetTaskSpecification(),
-          work->PrioritizeLocalNode(),
-          /*exclude_local_node*/ false,
-          /*requires_object_store_memory*/ false,
-          &is_infeasible);
+      scheduling::NodeID scheduling_node_id;
+      const auto version = cluster_resource_manager.GetResourceViewVersion();
+      if (cacheable && cache.valid && cache.resource_view_version == version &&
+          cache.prioritize_local_node == work->PrioritizeLocalNode()) {
+        scheduling_node_id = cache.node_id;
+        is_infeasible = cache.is_infeasible;
+        internal_stats_.SchedulingDecisionCacheHit();
+      } else {
+        scheduling_node_id = cluster_resource_scheduler_->GetBestSchedulableNode(
+            task.GetTaskSpecification(),
+            work->PrioritizeLocalNode(),
+            /*exclude_local_node*/ false,
+            /*requires_object_store_memory*/ false,
+            &is_infeasible);
+        cache.valid = cacheable;
+        cache.resource_view_version = version;
+        cache.prioritize_local_node = work->PrioritizeLocalNode();
+        cache.node_id = scheduling_node_id;
+        cache.is_infeasible = is_infeasible;
+      }
 
       // There is no node that has available resources to run the request.
       // Move on to the next shape.
@@ -140,6 +183,9 @@ void ClusterTaskManager::ScheduleAndDispatchTasks() {
       const RayTask task = work->task;
       announce_infeasible_task_(task);
 
+      if (!infeasible_tasks_.contains(shapes_it->first)) {
+        TrackInfeasibleShape(shapes_it->first, task);
+      }
       // TODO(sang): Use a shared pointer deque to reduce copy overhead.
       infeasible_tasks_[shapes_it->first] = shapes_it->second;
       tasks_to_schedule_.erase(shapes_it++);
@@ -150,15 +196,60 @@ void ClusterTaskManager::ScheduleAndDispatchTasks() {
     }
   }
 
+  if (task_args_prefetch_lookahead_ > 0) {
+    PrefetchQueuedTaskArgs();
+  }
   local_task_manager_->ScheduleAndDispatchTasks();
 }
 
+void ClusterTaskManager::PrefetchQueuedTaskArgs() {
+  // The tasks left in the queues are waiting for resources. This node is where they are
+  // most likely to run, unless resources free up elsewhere first.
+  std::vector<std::shared_ptr<internal::Work>> works;
+  for (const auto &shapes : tasks_to_schedule_) {
+    const auto &work_queue = shapes.second;
+    const auto num_works = std::min(static_cast<int64_t>(work_queue.size()),
+                                    task_args_prefetch_lookahead_);
+    works.insert(works.end(), work_queue.begin(), work_queue.begin() + num_works);
+  }
+  local_task_manager_->PrefetchTaskArgs(works);
+}
+
+void ClusterTaskManager::TrackInfeasibleShape(SchedulingClass scheduling_class,
+                                              const RayTask &task) {
+  auto shape = ResourceMapToResourceRequest(
+      task.GetTaskSpecification().GetRequiredPlacementResources().GetResourceMap(),
+      /*requires_object_store_memory=*/false);
+  cluster_resource_scheduler_->GetClusterResourceManager().TrackResourceShape(shape);
+  infeasible_shapes_.emplace(scheduling_class, std::move(shape));
+}
+
+void ClusterTaskManager::UntrackInfeasibleShape(SchedulingClass scheduling_class) {
+  auto it = infeasible_shapes_.find(scheduling_class);
+  if (it == infeasible_shapes_.end()) {
+    return;
+  }
+  cluster_resource_scheduler_->GetClusterResourceManager().UntrackResourceShape(
+      it->second);
+  infeasible_shapes_.erase(it);
+}
+
 void ClusterTaskManager::TryScheduleInfeasibleTask() {
+  const auto &cluster_resource_manager =
+      cluster_resource_scheduler_->GetClusterResourceManager();
   for (auto shapes_it = infeasible_tasks_.begin();
        shapes_it != infeasible_tasks_.end();) {
     auto &work_queue = shapes_it->second;
     RAY_CHECK(!work_queue.empty())
         << "Empty work queue shouldn't have been added as a infeasible shape.";
+    // Skip the scheduling policy while no node can satisfy the shape at all. The shape
+    // index is only updated when nodes join or leave or their total resources change.
+    auto shape_it = infeasible_shapes_.find(shapes_it->first);
+    if (shape_it != infeasible_shapes_.end() &&
+        !cluster_resource_manager.HasFeasibleNode(shape_it->second)) {
+      shapes_it++;
+      continue;
+    }
     // We only need to check the first item because every task has the same shape.
     // If the first entry is infeasible, that means everything else is the same.
     const auto work = work_queue[0];
@@ -184,6 +275,7 @@ void ClusterTaskManager::TryScheduleInfeasibleTask() {
                      << task.GetTaskSpecification().TaskId()
                      << " is now feasible. Move the entry back to tasks_to_schedule_";
       tasks_to_schedule_[shapes_it->first] = shapes_it->second;
+      UntrackInfeasibleShape(shapes_it->first);
       infeasible_tasks_.erase(shapes_it++);
     }
   }
@@ -222,6 +314,7 @@ bool ClusterTaskManager::CancelTask(
         ReplyCancelled(*(*work_it), failure_type, scheduling_failure_message);
         work_queue.erase(work_it);
         if (work_queue.empty()) {
+          UntrackInfeasibleShape(shapes_it->first);
           infeasible_tasks_.erase(shapes_it);
         }
         return true;
@@ -296,8 +389,8 @@ bool ClusterTaskManager::AnyPendingTasksForResourceAcquisition(
 
 void ClusterTaskManager::RecordMetrics() const { internal_stats_.RecordMetrics(); }
 
-std::string ClusterTaskManager::DebugStr() const {
-  return internal_stats_.ComputeAndReportDebugStr();
+std::string ClusterTaskManager::DebugStr(bool full) const {
+  return internal_stats_.ComputeAndReportDebugStr(full);
 }
 
 void ClusterTaskManager::ScheduleOnNode(const NodeID &spillback_to,
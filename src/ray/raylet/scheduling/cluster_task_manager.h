@@ -16,6 +16,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/ray_object.h"
 #include "ray/common/task/task.h"
 #include "ray/common/task/task_common.h"
@@ -48,15 +49,19 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
   ///                                  is infeasible.
   /// \param local_task_manager: Manages local tasks.
   /// \param get_time_ms: A callback which returns the current time in milliseconds.
+  /// \param task_args_prefetch_lookahead: The number of tasks per scheduling class,
+  ///                                     waiting for resources, to prefetch the
+  ///                                     arguments of.
   ClusterTaskManager(
       const NodeID &self_node_id,
       std::shared_ptr<ClusterResourceScheduler> cluster_resource_scheduler,
       internal::NodeInfoGetter get_node_info,
       std::function<void(const RayTask &)> announce_infeasible_task,
       std::shared_ptr<ILocalTaskManager> local_task_manager,
-      std::function<int64_t(void)> get_time_ms = []() {
-        return (int64_t)(absl::GetCurrentTimeNanos() / 1e6);
-      });
+      std::function<int64_t(void)> get_time_ms =
+          []() { return (int64_t)(absl::GetCurrentTimeNanos() / 1e6); },
+      int64_t task_args_prefetch_lookahead =
+          RayConfig::instance().task_args_prefetch_lookahead());
 
   /// Queue task and schedule. This hanppens when processing the worker lease request.
   ///
@@ -122,11 +127,40 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
   void RecordMetrics() const override;
 
   /// The helper to dump the debug state of the cluster task manater.
-  std::string DebugStr() const override;
+  std::string DebugStr(bool full = false) const override;
 
  private:
+  /// The last scheduling decision made for a scheduling class during one
+  /// `ScheduleAndDispatchTasks` round.
+  struct SchedulingDecisionCache {
+    /// Whether the fields below hold a reusable decision.
+    bool valid = false;
+    /// Version of the cluster resource view the decision was computed on.
+    uint64_t resource_view_version = 0;
+    /// The decision depends on whether the local node is prioritized.
+    bool prioritize_local_node = false;
+    scheduling::NodeID node_id = scheduling::NodeID::Nil();
+    bool is_infeasible = false;
+  };
+
   void TryScheduleInfeasibleTask();
 
+  /// Prefetch the arguments of the first tasks of each scheduling class that are
+  /// waiting for resources, so that they are local once the tasks can run.
+  void PrefetchQueuedTaskArgs();
+
+  /// Start tracking the resource shape of a scheduling class that just became
+  /// infeasible in the cluster resource manager, so that `TryScheduleInfeasibleTask`
+  /// only re-examines it once some node can satisfy it.
+  ///
+  /// \param scheduling_class The infeasible scheduling class.
+  /// \param task A task of the scheduling class.
+  void TrackInfeasibleShape(SchedulingClass scheduling_class, const RayTask &task);
+
+  /// Stop tracking the resource shape of a scheduling class that left
+  /// `infeasible_tasks_`.
+  void UntrackInfeasibleShape(SchedulingClass scheduling_class);
+
   // Schedule the task onto a node (which could be either remote or local).
   void ScheduleOnNode(const NodeID &node_to_schedule,
                       const std::shared_ptr<internal::Work> &work);
@@ -159,6 +193,9 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
   /// Tasks go between scheduling <-> infeasible.
   absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
       infeasible_tasks_;
+  /// The resource shapes of the scheduling classes in `infeasible_tasks_`, as tracked by
+  /// the cluster resource manager.
+  absl::flat_hash_map<SchedulingClass, ResourceRequest> infeasible_shapes_;
 
   const SchedulerResourceReporter scheduler_resource_reporter_;
   mutable SchedulerStats internal_stats_;
@@ -166,9 +203,15 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
   /// Returns the current time in milliseconds.
   std::function<int64_t()> get_time_ms_;
 
+  /// The number of tasks per scheduling class waiting for resources to prefetch the
+  /// arguments of, or 0 to not prefetch.
+  const int64_t task_args_prefetch_lookahead_;
+
   friend class SchedulerStats;
   friend class ClusterTaskManagerTest;
   FRIEND_TEST(ClusterTaskManagerTest, FeasibleToNonFeasible);
+  FRIEND_TEST(ClusterTaskManagerTest, SchedulingDecisionCacheTest);
+  FRIEND_TEST(ClusterTaskManagerTest, InfeasibleShapeIndexTest);
 };
 }  // namespace raylet
 }  // namespace ray
@@ -0,0 +1,165 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <deque>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/common/task/task_util.h"
+#include "ray/raylet/scheduling/cluster_task_manager.h"
+
+namespace ray {
+namespace raylet {
+
+namespace {
+
+/// A local task manager that never runs anything, so that every task is spilled to the
+/// remote nodes.
+class NoopLocalTaskManager : public ILocalTaskManager {
+ public:
+  void QueueAndScheduleTask(std::shared_ptr<internal::Work> work) override {}
+
+  void ScheduleAndDispatchTasks() override {}
+
+  void PrefetchTaskArgs(
+      const std::vector<std::shared_ptr<internal::Work>> &works) override {}
+
+  bool CancelTask(const TaskID &task_id,
+                  rpc::RequestWorkerLeaseReply::SchedulingFailureType failure_type,
+                  const std::string &scheduling_failure_message) override {
+    return false;
+  }
+
+  const absl::flat_hash_map<SchedulingClass,
+                            std::deque<std::shared_ptr<internal::Work>>>
+      &GetTaskToDispatch() const override {
+    return tasks_to_dispatch_;
+  }
+
+  const absl::flat_hash_map<SchedulingClass, absl::flat_hash_map<WorkerID, int64_t>>
+      &GetBackLogTracker() const override {
+    return backlog_tracker_;
+  }
+
+  bool AnyPendingTasksForResourceAcquisition(RayTask *example,
+                                             bool *any_pending,
+                                             int *num_pending_actor_creation,
+                                             int *num_pending_tasks) const override {
+    return false;
+  }
+
+  void RecordMetrics() const override {}
+
+  void DebugStr(std::stringstream &buffer, bool full) const override {}
+
+  size_t GetNumTaskSpilled() const override { return 0; }
+  size_t GetNumWaitingTaskSpilled() const override { return 0; }
+  size_t GetNumUnschedulableTaskSpilled() const override { return 0; }
+
+ private:
+  absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
+      tasks_to_dispatch_;
+  absl::flat_hash_map<SchedulingClass, absl::flat_hash_map<WorkerID, int64_t>>
+      backlog_tracker_;
+};
+
+RayTask CreateTask(const std::unordered_map<std::string, double> &required_resources) {
+  TaskSpecBuilder spec_builder;
+  const auto job_id = JobID::FromInt(1);
+  spec_builder.SetCommonTaskSpec(TaskID::FromRandom(job_id),
+                                 "benchmark_task",
+                                 Language::PYTHON,
+                                 FunctionDescriptorBuilder::BuildPython("", "", "", ""),
+                                 job_id,
+                                 TaskID::Nil(),
+                                 0,
+                                 TaskID::Nil(),
+                                 rpc::Address(),
+                                 0,
+                                 required_resources,
+                                 {},
+                                 "",
+                                 0);
+  return RayTask(spec_builder.Build());
+}
+
+/// Schedule a burst of tasks of a few shapes on a large cluster, from a node that has
+/// no resources of its own, so that every task is spilled back to a remote node.
+///
+/// \param state.range(0) The number of nodes.
+/// \param state.range(1) The number of tasks.
+void BM_ScheduleAndSpillback(benchmark::State &state) {
+  const int64_t num_nodes = state.range(0);
+  const int64_t num_tasks = state.range(1);
+  const NodeID self_node_id = NodeID::FromRandom();
+  std::vector<NodeID> node_ids;
+  for (int64_t i = 0; i < num_nodes; i++) {
+    node_ids.push_back(NodeID::FromRandom());
+  }
+  const std::vector<std::unordered_map<std::string, double>> shapes = {
+      {{kCPU_ResourceLabel, 1}},
+      {{kCPU_ResourceLabel, 2}},
+      {{kCPU_ResourceLabel, 1}, {kGPU_ResourceLabel, 1}},
+      {{kCPU_ResourceLabel, 0.5}, {kMemory_ResourceLabel, 1}}};
+  std::vector<RayTask> tasks;
+  for (int64_t i = 0; i < num_tasks; i++) {
+    tasks.push_back(CreateTask(shapes[i % shapes.size()]));
+  }
+  rpc::GcsNodeInfo node_info;
+  absl::flat_hash_map<std::string, double> node_resources = {
+      {kCPU_ResourceLabel, 64}, {kGPU_ResourceLabel, 8}, {kMemory_ResourceLabel, 256}};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto scheduler = std::make_shared<ClusterResourceScheduler>(
+        scheduling::NodeID(self_node_id.Binary()),
+        absl::flat_hash_map<std::string, double>{{kCPU_ResourceLabel, 0}},
+        /*is_node_available_fn=*/[](scheduling::NodeID) { return true; });
+    for (const auto &node_id : node_ids) {
+      scheduler->GetClusterResourceManager().AddOrUpdateNode(
+          scheduling::NodeID(node_id.Binary()), node_resources, node_resources);
+    }
+    ClusterTaskManager task_manager(
+        self_node_id,
+        scheduler,
+        /*get_node_info=*/
+        [&node_info](const NodeID &) -> const rpc::GcsNodeInfo * { return &node_info; },
+        /*announce_infeasible_task=*/[](const RayTask &) {},
+        std::make_shared<NoopLocalTaskManager>());
+    std::vector<rpc::RequestWorkerLeaseReply> replies(tasks.size());
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+      task_manager.QueueAndScheduleTask(
+          tasks[i],
+          /*grant_or_reject=*/false,
+          /*is_selected_based_on_locality=*/false,
+          &replies[i],
+          [](Status, std::function<void()>, std::function<void()>) {});
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+BENCHMARK(BM_ScheduleAndSpillback)
+    ->Args({100, 1000})
+    ->Args({1000, 1000})
+    ->Args({1000, 10000})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace raylet
+}  // namespace ray
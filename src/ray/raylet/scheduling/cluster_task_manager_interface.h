@@ -80,7 +80,10 @@ class ClusterTaskManagerInterface {
                                                      int *num_pending_tasks) const = 0;
 
   /// The helper to dump the debug state of the cluster task manater.
-  virtual std::string DebugStr() const = 0;
+  ///
+  /// \param full Whether to also list the resources of every node of the cluster and
+  /// of every worker, which is expensive on large clusters and busy nodes.
+  virtual std::string DebugStr(bool full = false) const = 0;
 
   /// Record the internal metrics.
   virtual void RecordMetrics() const = 0;
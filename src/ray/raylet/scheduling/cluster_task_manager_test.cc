@@ -67,6 +67,10 @@ class MockWorkerPool : public WorkerPoolInterface {
     return {};
   }
 
+  boost::optional<const rpc::JobConfig &> GetJobConfig(const JobID &job_id) const {
+    return boost::none;
+  }
+
   void TriggerCallbacksWithNotOKStatus(
       PopWorkerStatus status, const std::string &runtime_env_setup_error_msg = "") {
     RAY_CHECK(status != PopWorkerStatus::OK);
@@ -201,6 +205,14 @@ class MockTaskDependencyManager : public TaskDependencyManagerInterface {
     RAY_CHECK(subscribed_tasks.erase(task_id));
   }
 
+  void PrefetchTaskDependencies(
+      const absl::flat_hash_map<TaskID, std::vector<rpc::ObjectReference>> &tasks) {
+    prefetched_tasks.clear();
+    for (const auto &task : tasks) {
+      prefetched_tasks.insert(task.first);
+    }
+  }
+
   bool TaskDependenciesBlocked(const TaskID &task_id) const {
     return blocked_tasks.count(task_id);
   }
@@ -210,6 +222,7 @@ class MockTaskDependencyManager : public TaskDependencyManagerInterface {
   std::unordered_set<ObjectID> &missing_objects_;
   std::unordered_set<TaskID> subscribed_tasks;
   std::unordered_set<TaskID> blocked_tasks;
+  std::unordered_set<TaskID> prefetched_tasks;
 };
 
 class FeatureFlagEnvironment : public ::testing::Environment {
@@ -259,6 +272,7 @@ class ClusterTaskManagerTest : public ::testing::Test {
             /* get_task_arguments= */
             [this](const std::vector<ObjectID> &object_ids,
                    std::vector<std::unique_ptr<RayObject>> *results) {
+              num_task_args_fetched_ += object_ids.size();
               for (auto &obj_id : object_ids) {
                 if (missing_objects_.count(obj_id) == 0) {
                   results->emplace_back(MakeDummyArg());
@@ -322,9 +336,11 @@ class ClusterTaskManagerTest : public ::testing::Test {
     ASSERT_TRUE(local_task_manager_->waiting_tasks_index_.empty());
     ASSERT_TRUE(local_task_manager_->waiting_task_queue_.empty());
     ASSERT_TRUE(task_manager_.infeasible_tasks_.empty());
+    ASSERT_TRUE(task_manager_.infeasible_shapes_.empty());
     ASSERT_TRUE(local_task_manager_->executing_task_args_.empty());
     ASSERT_TRUE(local_task_manager_->pinned_task_arguments_.empty());
     ASSERT_TRUE(local_task_manager_->info_by_sched_cls_.empty());
+    ASSERT_TRUE(local_task_manager_->resource_blocked_classes_.empty());
     ASSERT_EQ(local_task_manager_->pinned_task_arguments_bytes_, 0);
     ASSERT_TRUE(dependency_manager_.subscribed_tasks.empty());
   }
@@ -369,6 +385,7 @@ class ClusterTaskManagerTest : public ::testing::Test {
 
   bool is_owner_alive_;
   int default_arg_size_ = 10;
+  int num_task_args_fetched_ = 0;
 
   int node_info_calls_;
   int announce_infeasible_task_calls_;
@@ -750,6 +767,59 @@ TEST_F(ClusterTaskManagerTest, ResourceTakenWhileResolving) {
   AssertNoLeaks();
 }
 
+TEST_F(ClusterTaskManagerTest, SkipResourceBlockedDispatchQueue) {
+  /*
+    Test that a dispatch queue blocked on local resources is not revisited until
+    the resources change.
+  */
+  local_task_manager_->skip_resource_blocked_queues_ = true;
+  std::shared_ptr<MockWorker> worker1 =
+      std::make_shared<MockWorker>(WorkerID::FromRandom(), 1234);
+  std::shared_ptr<MockWorker> worker2 =
+      std::make_shared<MockWorker>(WorkerID::FromRandom(), 1235);
+  pool_.PushWorker(std::static_pointer_cast<WorkerInterface>(worker1));
+  pool_.PushWorker(std::static_pointer_cast<WorkerInterface>(worker2));
+
+  rpc::RequestWorkerLeaseReply reply;
+  int num_callbacks = 0;
+  auto callback = [&num_callbacks](Status, std::function<void()>, std::function<void()>) {
+    num_callbacks++;
+  };
+
+  auto task1 = CreateTask({{ray::kCPU_ResourceLabel, 8}});
+  task_manager_.QueueAndScheduleTask(task1, false, false, &reply, callback);
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(num_callbacks, 1);
+  ASSERT_EQ(leased_workers_.size(), 1);
+
+  /* The second task is blocked behind the first one */
+  auto task2 = CreateTask({{ray::kCPU_ResourceLabel, 8}});
+  task_manager_.QueueAndScheduleTask(task2, false, false, &reply, callback);
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(num_callbacks, 1);
+  ASSERT_EQ(local_task_manager_->resource_blocked_classes_.size(), 1);
+
+  /* Nothing changed, so the queue stays blocked without being revisited */
+  task_manager_.ScheduleAndDispatchTasks();
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(num_callbacks, 1);
+  ASSERT_EQ(local_task_manager_->resource_blocked_classes_.size(), 1);
+  ASSERT_EQ(NumTasksToDispatchWithStatus(internal::WorkStatus::WAITING), 1);
+
+  /* The first task finishes and releases its resources */
+  RayTask finished_task;
+  local_task_manager_->TaskFinished(leased_workers_.begin()->second, &finished_task);
+  leased_workers_.clear();
+  task_manager_.ScheduleAndDispatchTasks();
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(num_callbacks, 2);
+  ASSERT_EQ(leased_workers_.size(), 1);
+  ASSERT_TRUE(local_task_manager_->resource_blocked_classes_.empty());
+
+  local_task_manager_->TaskFinished(leased_workers_.begin()->second, &finished_task);
+  AssertNoLeaks();
+}
+
 TEST_F(ClusterTaskManagerTest, TestIsSelectedBasedOnLocality) {
   std::shared_ptr<MockWorker> worker1 =
       std::make_shared<MockWorker>(WorkerID::FromRandom(), 1234);
@@ -1214,6 +1284,36 @@ TEST_F(ClusterTaskManagerTest, HeartbeatTest) {
   }
 }
 
+TEST_F(ClusterTaskManagerTest, ResourceLoadReportsLargestShapesTest) {
+  RayConfig::instance().initialize(R"({"max_resource_shapes_per_load_report": 2})");
+  absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
+      tasks_to_schedule;
+  absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
+      infeasible_tasks;
+  // Four shapes of 1 to 4 CPUs, with 1, 4, 2 and 3 queued tasks. Only the sizes of the
+  // queues are reported, so they hold no actual work.
+  const std::vector<int> num_queued = {1, 4, 2, 3};
+  for (size_t i = 0; i < num_queued.size(); i++) {
+    RayTask task = CreateTask({{ray::kCPU_ResourceLabel, i + 1}});
+    tasks_to_schedule[task.GetTaskSpecification().GetSchedulingClass()].resize(
+        num_queued[i]);
+  }
+  SchedulerResourceReporter reporter(
+      tasks_to_schedule, infeasible_tasks, *local_task_manager_);
+
+  rpc::ResourcesData data;
+  reporter.FillResourceUsage(data, nullptr);
+  // Only the two shapes with the most queued tasks are reported.
+  std::set<double> reported_cpus;
+  for (const auto &demand : data.resource_load_by_shape().resource_demands()) {
+    reported_cpus.insert(demand.shape().at("CPU"));
+  }
+  ASSERT_EQ(reported_cpus, std::set<double>({2, 4}));
+  ASSERT_EQ(data.resource_load().at("CPU"), 2 * 4 + 4 * 3);
+
+  RayConfig::instance().initialize(R"({"max_resource_shapes_per_load_report": 100})");
+}
+
 TEST_F(ClusterTaskManagerTest, BacklogReportTest) {
   /*
     Test basic scheduler functionality:
@@ -1569,6 +1669,83 @@ TEST_F(ClusterTaskManagerTest, FeasibleToNonFeasible) {
             task1.GetTaskSpecification().TaskId());
 }
 
+TEST_F(ClusterTaskManagerTest, SchedulingDecisionCacheTest) {
+  // Tasks of the same scheduling class that are queued locally while waiting for their
+  // arguments don't change the resource view, so the scheduling decision of the first
+  // one is reused for the others.
+  std::vector<RayTask> tasks;
+  std::vector<rpc::RequestWorkerLeaseReply> replies(3);
+  int num_callbacks = 0;
+  for (int i = 0; i < 3; i++) {
+    tasks.push_back(CreateTask({{ray::kCPU_ResourceLabel, 1}}, 1));
+    missing_objects_.insert(tasks.back().GetTaskSpecification().GetDependencyIds()[0]);
+  }
+  const auto scheduling_class = tasks[0].GetTaskSpecification().GetSchedulingClass();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(tasks[i].GetTaskSpecification().GetSchedulingClass(), scheduling_class);
+    task_manager_.tasks_to_schedule_[scheduling_class].push_back(
+        std::make_shared<internal::Work>(tasks[i],
+                                         /*grant_or_reject=*/false,
+                                         /*is_selected_based_on_locality=*/false,
+                                         &replies[i],
+                                         [&num_callbacks] { num_callbacks++; }));
+  }
+
+  task_manager_.ScheduleAndDispatchTasks();
+  ASSERT_TRUE(task_manager_.tasks_to_schedule_.empty());
+  ASSERT_EQ(local_task_manager_->waiting_task_queue_.size(), 3);
+  ASSERT_EQ(num_callbacks, 0);
+  ASSERT_NE(task_manager_.DebugStr().find("num_scheduling_decision_cache_hits: 2"),
+            std::string::npos);
+
+  // Only the full dump lists the resources of every node and worker.
+  const auto summary = task_manager_.DebugStr();
+  ASSERT_NE(summary.find("num cluster nodes: "), std::string::npos);
+  ASSERT_EQ(summary.find("cluster_resource_scheduler state: "), std::string::npos);
+  ASSERT_EQ(summary.find("Resource usage {"), std::string::npos);
+  const auto full = task_manager_.DebugStr(/*full=*/true);
+  ASSERT_NE(full.find("cluster_resource_scheduler state: "), std::string::npos);
+  ASSERT_NE(full.find("Resource usage {"), std::string::npos);
+}
+
+TEST_F(ClusterTaskManagerTest, InfeasibleShapeIndexTest) {
+  // The resource shape of an infeasible scheduling class is tracked by the cluster
+  // resource manager while the class is in the infeasible queue.
+  RayTask task = CreateTask({{ray::kCPU_ResourceLabel, 12}});
+  rpc::RequestWorkerLeaseReply reply;
+  bool callback_occurred = false;
+  auto callback = [&callback_occurred](
+                      Status, std::function<void()>, std::function<void()>) {
+    callback_occurred = true;
+  };
+  task_manager_.QueueAndScheduleTask(task, false, false, &reply, callback);
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(task_manager_.infeasible_tasks_.size(), 1);
+  ASSERT_EQ(task_manager_.infeasible_shapes_.size(), 1);
+  const auto shape = ResourceMapToResourceRequest({{ray::kCPU_ResourceLabel, 12}}, false);
+  auto &cluster_resource_manager = scheduler_->GetClusterResourceManager();
+  ASSERT_FALSE(cluster_resource_manager.HasFeasibleNode(shape));
+
+  // Nodes that can't satisfy the shape don't make it feasible.
+  AddNode(NodeID::FromRandom(), 8);
+  task_manager_.ScheduleAndDispatchTasks();
+  ASSERT_EQ(task_manager_.infeasible_tasks_.size(), 1);
+  ASSERT_FALSE(callback_occurred);
+
+  // Once a node that can satisfy the shape joins, the task is spilled back to it and
+  // the shape isn't tracked anymore.
+  auto remote_node_id = NodeID::FromRandom();
+  AddNode(remote_node_id, 12);
+  ASSERT_TRUE(cluster_resource_manager.HasFeasibleNode(shape));
+  task_manager_.ScheduleAndDispatchTasks();
+  pool_.TriggerCallbacks();
+  ASSERT_TRUE(callback_occurred);
+  ASSERT_EQ(reply.retry_at_raylet_address().raylet_id(), remote_node_id.Binary());
+  ASSERT_TRUE(task_manager_.infeasible_tasks_.empty());
+  ASSERT_TRUE(task_manager_.infeasible_shapes_.empty());
+  AssertNoLeaks();
+}
+
 TEST_F(ClusterTaskManagerTestWithGPUsAtHead, RleaseAndReturnWorkerCpuResources) {
   const NodeResources &node_resources =
       scheduler_->GetClusterResourceManager().GetNodeResources(
@@ -1800,6 +1977,7 @@ TEST_F(ClusterTaskManagerTest, PinnedArgsSameMemoryTest) {
   AssertPinnedTaskArgumentsPresent(task);
 
   // This task can run because it depends on the same object as the first task.
+  // The object is already pinned, so it isn't fetched from plasma again.
   auto task2 = CreateTask(
       {{ray::kCPU_ResourceLabel, 1}}, 1, task.GetTaskSpecification().GetDependencyIds());
   task_manager_.QueueAndScheduleTask(task2, false, false, &reply, callback);
@@ -1807,6 +1985,7 @@ TEST_F(ClusterTaskManagerTest, PinnedArgsSameMemoryTest) {
   ASSERT_EQ(num_callbacks, 2);
   ASSERT_EQ(leased_workers_.size(), 2);
   ASSERT_EQ(pool_.workers.size(), 0);
+  ASSERT_EQ(num_task_args_fetched_, 1);
 
   RayTask finished_task;
   for (auto &worker : leased_workers_) {
@@ -0,0 +1,113 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/fair_share.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+FairShareTracker::FairShareTracker(const std::string &weights) {
+  for (absl::string_view entry : absl::StrSplit(weights, ',', absl::SkipWhitespace())) {
+    std::vector<absl::string_view> parts =
+        absl::StrSplit(absl::StripAsciiWhitespace(entry), absl::MaxSplits(':', 1));
+    double weight = 0;
+    if (parts.size() != 2 || !absl::SimpleAtod(parts[1], &weight) || weight <= 0) {
+      RAY_LOG(WARNING) << "Ignoring the invalid fair share weight \"" << entry << "\".";
+      continue;
+    }
+    weights_[std::string(parts[0])] = weight;
+  }
+}
+
+void FairShareTracker::SetTotalResources(const ResourceRequest &total_resources) {
+  total_resources_ = total_resources;
+}
+
+void FairShareTracker::AddTask(const TaskID &task_id,
+                               const std::string &tenant,
+                               const ResourceRequest &resources) {
+  if (!tasks_.emplace(task_id, std::make_pair(tenant, resources)).second) {
+    return;
+  }
+  auto &usage = usage_by_tenant_[tenant];
+  usage.resources += resources;
+  usage.num_tasks++;
+}
+
+void FairShareTracker::RemoveTask(const TaskID &task_id) {
+  auto it = tasks_.find(task_id);
+  if (it == tasks_.end()) {
+    return;
+  }
+  auto usage_it = usage_by_tenant_.find(it->second.first);
+  RAY_CHECK(usage_it != usage_by_tenant_.end());
+  if (--usage_it->second.num_tasks == 0) {
+    usage_by_tenant_.erase(usage_it);
+  } else {
+    usage_it->second.resources -= it->second.second;
+  }
+  tasks_.erase(it);
+}
+
+double FairShareTracker::GetShare(const std::string &tenant) const {
+  auto it = usage_by_tenant_.find(tenant);
+  if (it == usage_by_tenant_.end()) {
+    return 0;
+  }
+  double dominant_share = 0;
+  for (auto resource_id : it->second.resources.ResourceIds()) {
+    const double total = total_resources_.Get(resource_id).Double();
+    if (total > 0) {
+      dominant_share = std::max(
+          dominant_share, it->second.resources.Get(resource_id).Double() / total);
+    }
+  }
+  return dominant_share / GetWeight(tenant);
+}
+
+absl::flat_hash_map<std::string, double> FairShareTracker::GetShares() const {
+  absl::flat_hash_map<std::string, double> shares;
+  for (const auto &entry : usage_by_tenant_) {
+    shares[entry.first] = GetShare(entry.first);
+  }
+  return shares;
+}
+
+double FairShareTracker::GetFairnessIndex() const {
+  double sum = 0;
+  double sum_of_squares = 0;
+  for (const auto &entry : usage_by_tenant_) {
+    const double share = GetShare(entry.first);
+    sum += share;
+    sum_of_squares += share * share;
+  }
+  if (sum_of_squares == 0) {
+    return 1;
+  }
+  return sum * sum / (usage_by_tenant_.size() * sum_of_squares);
+}
+
+double FairShareTracker::GetWeight(const std::string &tenant) const {
+  auto it = weights_.find(tenant);
+  return it == weights_.end() ? 1 : it->second;
+}
+
+}  // namespace ray
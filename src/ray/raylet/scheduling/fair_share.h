@@ -0,0 +1,80 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/id.h"
+#include "ray/raylet/scheduling/cluster_resource_data.h"
+
+namespace ray {
+
+/// \class FairShareTracker
+/// Tracks the resources held by the running tasks of every tenant of a node, for
+/// dominant resource fairness (DRF) between the tenants. The dominant share of a
+/// tenant is the largest fraction of any resource of the node that its tasks hold,
+/// divided by the weight of the tenant. Dispatching the tasks of the tenant with the
+/// smallest dominant share first keeps a tenant with a large backlog from starving
+/// the others.
+///
+/// This class is not thread safe.
+class FairShareTracker {
+ public:
+  /// \param weights The weights of the tenants, as "tenant1:weight1,tenant2:weight2".
+  /// Tenants that aren't listed have a weight of 1.
+  explicit FairShareTracker(const std::string &weights);
+
+  /// Set the total resources of the node, which the shares are fractions of.
+  void SetTotalResources(const ResourceRequest &total_resources);
+
+  /// Add the resources of a running task to its tenant. Does nothing if the task was
+  /// already added.
+  void AddTask(const TaskID &task_id,
+               const std::string &tenant,
+               const ResourceRequest &resources);
+
+  /// Remove the resources of a task that is no longer running. Does nothing if the
+  /// task wasn't added.
+  void RemoveTask(const TaskID &task_id);
+
+  /// Return the weighted dominant share of a tenant, 0 if it has no running tasks.
+  double GetShare(const std::string &tenant) const;
+
+  /// Return the weighted dominant shares of the tenants with running tasks.
+  absl::flat_hash_map<std::string, double> GetShares() const;
+
+  /// Return Jain's fairness index of the weighted dominant shares of the tenants with
+  /// running tasks, from 1/n when a single tenant holds all the resources to 1 when
+  /// the shares are equal.
+  double GetFairnessIndex() const;
+
+ private:
+  double GetWeight(const std::string &tenant) const;
+
+  struct TenantUsage {
+    ResourceRequest resources;
+    int64_t num_tasks = 0;
+  };
+
+  absl::flat_hash_map<std::string, double> weights_;
+  ResourceRequest total_resources_;
+  /// The tenant and resources of each running task.
+  absl::flat_hash_map<TaskID, std::pair<std::string, ResourceRequest>> tasks_;
+  /// The tenants with running tasks.
+  absl::flat_hash_map<std::string, TenantUsage> usage_by_tenant_;
+};
+
+}  // namespace ray
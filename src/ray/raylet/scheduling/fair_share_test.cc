@@ -0,0 +1,56 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/fair_share.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+TEST(FairShareTrackerTest, TestDominantShares) {
+  FairShareTracker tracker("batch:2, invalid, negative:-1");
+  tracker.SetTotalResources(ResourceMapToResourceRequest({{"CPU", 8}, {"GPU", 2}}, false));
+  const auto task1 = TaskID::FromRandom(JobID::FromInt(1));
+  const auto task2 = TaskID::FromRandom(JobID::FromInt(1));
+  const auto task3 = TaskID::FromRandom(JobID::FromInt(2));
+
+  // The share of a tenant is the largest fraction of any resource it holds.
+  tracker.AddTask(task1, "batch", ResourceMapToResourceRequest({{"CPU", 4}}, false));
+  tracker.AddTask(
+      task3, "interactive", ResourceMapToResourceRequest({{"CPU", 1}, {"GPU", 1}}, false));
+  ASSERT_DOUBLE_EQ(tracker.GetShare("interactive"), 0.5);
+  // The share of a tenant is divided by its weight.
+  ASSERT_DOUBLE_EQ(tracker.GetShare("batch"), 0.25);
+  ASSERT_DOUBLE_EQ(tracker.GetShare("negative"), 0);
+
+  // Adding a task twice doesn't count its resources twice.
+  tracker.AddTask(task2, "batch", ResourceMapToResourceRequest({{"CPU", 4}}, false));
+  tracker.AddTask(task2, "batch", ResourceMapToResourceRequest({{"CPU", 4}}, false));
+  ASSERT_DOUBLE_EQ(tracker.GetShare("batch"), 0.5);
+  ASSERT_DOUBLE_EQ(tracker.GetFairnessIndex(), 1);
+
+  tracker.RemoveTask(task1);
+  tracker.RemoveTask(task1);
+  ASSERT_DOUBLE_EQ(tracker.GetShare("batch"), 0.25);
+  // (0.25 + 0.5)^2 / (2 * (0.25^2 + 0.5^2))
+  ASSERT_DOUBLE_EQ(tracker.GetFairnessIndex(), 0.9);
+
+  tracker.RemoveTask(task2);
+  const auto shares = tracker.GetShares();
+  ASSERT_EQ(shares.size(), 1);
+  ASSERT_DOUBLE_EQ(shares.at("interactive"), 0.5);
+  ASSERT_DOUBLE_EQ(tracker.GetFairnessIndex(), 1);
+}
+
+}  // namespace ray
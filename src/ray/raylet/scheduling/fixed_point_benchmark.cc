@@ -0,0 +1,89 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/raylet/scheduling/fixed_point.h"
+
+namespace ray {
+
+namespace {
+
+/// Resource quantities as the scheduler sees them: mostly whole CPUs, with some
+/// fractional GPUs.
+std::vector<FixedPoint> CreateQuantities(int num_quantities) {
+  std::vector<FixedPoint> quantities;
+  quantities.reserve(num_quantities);
+  for (int i = 0; i < num_quantities; i++) {
+    quantities.emplace_back(i % 4 == 0 ? 0.25 : static_cast<double>(i % 16));
+  }
+  return quantities;
+}
+
+void BM_FixedPointFromDouble(benchmark::State &state) {
+  std::vector<double> values(1024);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = i * 0.5;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FixedPointVectorFromDouble(values));
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FixedPointFromDouble);
+
+/// Subtract a request from the available resources and add it back, as allocating and
+/// releasing the resources of a task does.
+void BM_FixedPointAllocateAndRelease(benchmark::State &state) {
+  auto available = CreateQuantities(1024);
+  const auto request = CreateQuantities(1024);
+  for (auto _ : state) {
+    for (size_t i = 0; i < available.size(); i++) {
+      if (available[i] >= request[i]) {
+        available[i] -= request[i];
+        available[i] += request[i];
+      }
+    }
+    benchmark::DoNotOptimize(available);
+  }
+  state.SetItemsProcessed(state.iterations() * available.size());
+}
+BENCHMARK(BM_FixedPointAllocateAndRelease);
+
+void BM_FixedPointSum(benchmark::State &state) {
+  const auto quantities = CreateQuantities(1024);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FixedPoint::Sum(quantities));
+  }
+  state.SetItemsProcessed(state.iterations() * quantities.size());
+}
+BENCHMARK(BM_FixedPointSum);
+
+void BM_FixedPointToDouble(benchmark::State &state) {
+  const auto quantities = CreateQuantities(1024);
+  for (auto _ : state) {
+    double sum = 0;
+    for (const auto &quantity : quantities) {
+      sum += quantity.Double();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * quantities.size());
+}
+BENCHMARK(BM_FixedPointToDouble);
+
+}  // namespace
+
+}  // namespace ray
@@ -137,35 +137,50 @@ bool LocalResourceManager::AllocateResourceInstances(
   // If resource constraint is soft, allocate as many full unit-capacity resources and
   // then distribute remaining_demand across remaining instances. Note that in case we can
   // overallocate this resource.
-  if (remaining_demand >= 1.) {
-    for (size_t i = 0; i < available.size(); i++) {
-      if (available[i] == 1.) {
-        // Allocate a full unit-capacity instance.
-        (*allocation)[i] = 1.;
-        available[i] = 0;
-        remaining_demand -= 1.;
+  //
+  // The instances are compared against FixedPoint constants rather than double
+  // literals, so that each comparison is a plain integer one. Whether there are enough
+  // unit-capacity instances is checked before any of them is taken, so that a failed
+  // allocation leaves the instances untouched.
+  const FixedPoint one = 1.;
+  const FixedPoint zero = 0.;
+  if (remaining_demand >= one) {
+    FixedPoint whole_units = 0.;
+    for (size_t i = 0; i < available.size() && remaining_demand - whole_units >= one;
+         i++) {
+      if (available[i] == one) {
+        whole_units += one;
       }
-      if (remaining_demand < 1.) {
-        break;
+    }
+    if (remaining_demand - whole_units >= one) {
+      // Cannot satisfy a demand greater than one if no unit capacity resource is
+      // available.
+      return false;
+    }
+    for (size_t i = 0; i < available.size() && remaining_demand >= one; i++) {
+      if (available[i] == one) {
+        // Allocate a full unit-capacity instance.
+        (*allocation)[i] = one;
+        available[i] = zero;
+        remaining_demand -= one;
       }
     }
   }
 
-  if (remaining_demand >= 1.) {
-    // Cannot satisfy a demand greater than one if no unit capacity resource is available.
-    return false;
-  }
-
   // Remaining demand is fractional. Find the best fit, if exists.
-  if (remaining_demand > 0.) {
+  if (remaining_demand > zero) {
     int64_t idx_best_fit = -1;
-    FixedPoint available_best_fit = 1.;
+    FixedPoint available_best_fit = one;
     for (size_t i = 0; i < available.size(); i++) {
       if (available[i] >= remaining_demand) {
         if (idx_best_fit == -1 ||
             (available[i] - remaining_demand < available_best_fit)) {
           available_best_fit = available[i] - remaining_demand;
           idx_best_fit = static_cast<int64_t>(i);
+          if (available_best_fit == zero) {
+            // Nothing fits better than an exact fit.
+            break;
+          }
         }
       }
     }
@@ -37,6 +37,11 @@ class ILocalTaskManager {
   // Schedule and dispatch tasks.
   virtual void ScheduleAndDispatchTasks() = 0;
 
+  /// Prefetch the arguments of tasks that aren't queued locally yet, but will likely
+  /// run on this node soon. Replaces the tasks passed to the previous call.
+  virtual void PrefetchTaskArgs(
+      const std::vector<std::shared_ptr<internal::Work>> &works) = 0;
+
   /// Attempt to cancel an already queued task.
   ///
   /// \param task_id: The id of the task to remove.
@@ -65,7 +70,8 @@ class ILocalTaskManager {
 
   virtual void RecordMetrics() const = 0;
 
-  virtual void DebugStr(std::stringstream &buffer) const = 0;
+  /// \param full Whether to also list the resources used by every worker.
+  virtual void DebugStr(std::stringstream &buffer, bool full) const = 0;
 
   virtual size_t GetNumTaskSpilled() const = 0;
   virtual size_t GetNumWaitingTaskSpilled() const = 0;
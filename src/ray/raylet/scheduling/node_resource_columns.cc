@@ -0,0 +1,125 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/node_resource_columns.h"
+
+namespace ray {
+
+namespace {
+
+/// mask[i] &= (value <= column[i]). Kept as a standalone loop over contiguous memory so
+/// that it is vectorized.
+void AndLessEqual(FixedPoint value,
+                  const std::vector<FixedPoint> &column,
+                  std::vector<uint8_t> *mask) {
+  const FixedPoint *values = column.data();
+  uint8_t *out = mask->data();
+  const size_t size = column.size();
+  for (size_t i = 0; i < size; i++) {
+    out[i] &= static_cast<uint8_t>(value <= values[i]);
+  }
+}
+
+}  // namespace
+
+void NodeResourceColumns::Update(scheduling::NodeID node_id,
+                                 const NodeResources &node_resources) {
+  auto it = node_index_.find(node_id);
+  size_t index;
+  if (it == node_index_.end()) {
+    index = node_ids_.size();
+    node_index_.emplace(node_id, index);
+    node_ids_.push_back(node_id);
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      total_[i].emplace_back(0);
+      available_[i].emplace_back(0);
+    }
+    object_pulls_queued_.push_back(0);
+    has_negative_custom_.push_back(0);
+    membership_version_++;
+  } else {
+    index = it->second;
+  }
+
+  for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+    total_[i][index] = node_resources.total.Get(scheduling::ResourceID(i));
+    available_[i][index] = node_resources.available.Get(scheduling::ResourceID(i));
+  }
+  object_pulls_queued_[index] = node_resources.object_pulls_queued;
+  has_negative_custom_[index] = node_resources.total.HasNegativeCustomResources() ||
+                                node_resources.available.HasNegativeCustomResources();
+}
+
+void NodeResourceColumns::Remove(scheduling::NodeID node_id) {
+  auto it = node_index_.find(node_id);
+  if (it == node_index_.end()) {
+    return;
+  }
+  const size_t index = it->second;
+  const size_t last = node_ids_.size() - 1;
+  node_index_.erase(it);
+  if (index != last) {
+    // Move the last node into the freed slot to keep the columns dense.
+    node_ids_[index] = node_ids_[last];
+    node_index_[node_ids_[index]] = index;
+    for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+      total_[i][index] = total_[i][last];
+      available_[i][index] = available_[i][last];
+    }
+    object_pulls_queued_[index] = object_pulls_queued_[last];
+    has_negative_custom_[index] = has_negative_custom_[last];
+  }
+  node_ids_.pop_back();
+  for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+    total_[i].pop_back();
+    available_[i].pop_back();
+  }
+  object_pulls_queued_.pop_back();
+  has_negative_custom_.pop_back();
+  membership_version_++;
+}
+
+void NodeResourceColumns::CheckRequest(const ResourceRequest &resource_request,
+                                       std::vector<uint8_t> *feasible,
+                                       std::vector<uint8_t> *available) const {
+  feasible->assign(Size(), 1);
+  available->assign(Size(), 1);
+  // Every predefined resource is checked, including the ones that are absent from the
+  // request, so that nodes with negative values are rejected the same way
+  // `ResourceRequest::operator<=` does.
+  for (size_t i = 0; i < PredefinedResourcesEnum_MAX; i++) {
+    const FixedPoint value = resource_request.Get(scheduling::ResourceID(i));
+    AndLessEqual(value, total_[i], feasible);
+    AndLessEqual(value, available_[i], available);
+  }
+}
+
+float NodeResourceColumns::CalculateCriticalResourceUtilization(size_t index) const {
+  float highest = 0;
+  for (const auto &i : {CPU, MEM, OBJECT_STORE_MEM}) {
+    const auto &total = total_[i][index];
+    if (total == 0) {
+      continue;
+    }
+    const auto &available = available_[i][index];
+
+    float utilization = 1 - (available.Double() / total.Double());
+    if (utilization > highest) {
+      highest = utilization;
+    }
+  }
+  return highest;
+}
+
+}  // namespace ray
@@ -42,6 +42,21 @@ BundleSchedulingPolicy::SelectCandidateNodes(const SchedulingContext *context) c
   return result;
 }
 
+void BundleSchedulingPolicy::SetPreferredNodes(const SchedulingContext *context) {
+  absl::flat_hash_set<scheduling::NodeID> preferred_nodes;
+  auto bundle_scheduling_context = dynamic_cast<const BundleSchedulingContext *>(context);
+  if (bundle_scheduling_context &&
+      bundle_scheduling_context->bundle_locations_.has_value()) {
+    const auto &bundle_locations = bundle_scheduling_context->bundle_locations_.value();
+    if (bundle_locations != nullptr) {
+      for (auto &bundle : *bundle_locations) {
+        preferred_nodes.insert(scheduling::NodeID(bundle.second.first.Binary()));
+      }
+    }
+  }
+  node_scorer_->SetPreferredNodes(std::move(preferred_nodes));
+}
+
 std::pair<std::vector<int>, std::vector<const ResourceRequest *>>
 BundleSchedulingPolicy::SortRequiredResources(
     const std::vector<const ResourceRequest *> &resource_request_list) {
@@ -122,7 +137,8 @@ std::pair<scheduling::NodeID, const Node *> BundleSchedulingPolicy::GetBestNode(
   // Score the nodes.
   for (const auto &[node_id, node] : candidate_nodes) {
     const auto &node_resources = node->GetLocalView();
-    double node_score = node_scorer_->Score(required_resources, node_resources);
+    double node_score =
+        node_scorer_->ScoreNode(node_id, required_resources, node_resources);
     if (best_node_id.IsNil() || best_node_score < node_score) {
       best_node_id = node_id;
       best_node_score = node_score;
@@ -146,6 +162,7 @@ SchedulingResult BundlePackSchedulingPolicy::Schedule(
     RAY_LOG(DEBUG) << "The candidate nodes is empty, return directly.";
     return SchedulingResult::Infeasible();
   }
+  SetPreferredNodes(options.scheduling_context.get());
 
   // First schedule scarce resources (such as GPU) and large capacity resources to improve
   // the scheduling success rate.
@@ -218,6 +235,7 @@ SchedulingResult BundleSpreadSchedulingPolicy::Schedule(
     RAY_LOG(DEBUG) << "The candidate nodes is empty, return directly.";
     return SchedulingResult::Infeasible();
   }
+  SetPreferredNodes(options.scheduling_context.get());
 
   // First schedule scarce resources (such as GPU) and large capacity resources to improve
   // the scheduling success rate.
@@ -279,6 +297,7 @@ SchedulingResult BundleStrictPackSchedulingPolicy::Schedule(
     RAY_LOG(DEBUG) << "The candidate nodes is empty, return directly.";
     return SchedulingResult::Infeasible();
   }
+  SetPreferredNodes(options.scheduling_context.get());
 
   // Aggregate required resources.
   ResourceRequest aggregated_resource_request;
@@ -332,6 +351,7 @@ SchedulingResult BundleStrictSpreadSchedulingPolicy::Schedule(
     RAY_LOG(DEBUG) << "The candidate nodes is empty, return directly.";
     return SchedulingResult::Infeasible();
   }
+  SetPreferredNodes(options.scheduling_context.get());
 
   if (resource_request_list.size() > candidate_nodes.size()) {
     RAY_LOG(DEBUG) << "The number of required resources " << resource_request_list.size()
@@ -30,10 +30,11 @@ class BundleSchedulingPolicy : public IBundleSchedulingPolicy {
  public:
   explicit BundleSchedulingPolicy(
       ClusterResourceManager &cluster_resource_manager,
-      std::function<bool(scheduling::NodeID)> is_node_available)
+      std::function<bool(scheduling::NodeID)> is_node_available,
+      std::unique_ptr<NodeScorer> node_scorer = std::make_unique<LeastResourceScorer>())
       : cluster_resource_manager_(cluster_resource_manager),
         is_node_available_(is_node_available),
-        node_scorer_(new LeastResourceScorer()) {}
+        node_scorer_(std::move(node_scorer)) {}
 
  protected:
   /// Filter out candidate nodes which can be used for scheduling.
@@ -42,6 +43,11 @@ class BundleSchedulingPolicy : public IBundleSchedulingPolicy {
   virtual absl::flat_hash_map<scheduling::NodeID, const Node *> SelectCandidateNodes(
       const SchedulingContext *context) const;
 
+  /// Pass the nodes that already hold bundles of the placement group to the scorer.
+  ///
+  /// \param context The scheduling context of the placement group.
+  void SetPreferredNodes(const SchedulingContext *context);
+
   /// Sort required resources according to the scarcity and capacity of resources.
   /// We will first schedule scarce resources (such as GPU) and large capacity resources
   /// to improve the scheduling success rate.
@@ -42,6 +42,34 @@ scheduling::NodeID CompositeSchedulingPolicy::Schedule(
   UNREACHABLE;
 }
 
+std::vector<scheduling::NodeID> CompositeSchedulingPolicy::ScheduleBatch(
+    const std::vector<const ResourceRequest *> &resource_request_list,
+    SchedulingOptions options) {
+  std::vector<scheduling::NodeID> result;
+  result.reserve(resource_request_list.size());
+  // The resources of the nodes that requests were placed on, from before the first
+  // placement. Only these nodes are copied, and they are restored exactly once the
+  // whole group is placed, even if a placement clamped some available resources to 0.
+  absl::flat_hash_map<scheduling::NodeID, NodeResources> original_resources;
+  for (const auto *resource_request : resource_request_list) {
+    const auto node_id = Schedule(*resource_request, options);
+    result.push_back(node_id);
+    if (node_id.IsNil()) {
+      continue;
+    }
+    if (!original_resources.contains(node_id)) {
+      original_resources.emplace(node_id,
+                                 cluster_resource_manager_.GetNodeResources(node_id));
+    }
+    RAY_CHECK(cluster_resource_manager_.SubtractNodeAvailableResources(
+        node_id, *resource_request));
+  }
+  for (const auto &[node_id, node_resources] : original_resources) {
+    cluster_resource_manager_.AddOrUpdateNode(node_id, node_resources);
+  }
+  return result;
+}
+
 SchedulingResult CompositeBundleSchedulingPolicy::Schedule(
     const std::vector<const ResourceRequest *> &resource_request_list,
     SchedulingOptions options) {
@@ -33,20 +33,42 @@ class CompositeSchedulingPolicy : public ISchedulingPolicy {
   CompositeSchedulingPolicy(scheduling::NodeID local_node_id,
                             ClusterResourceManager &cluster_resource_manager,
                             std::function<bool(scheduling::NodeID)> is_node_available)
-      : hybrid_policy_(
-            local_node_id, cluster_resource_manager.GetResourceView(), is_node_available),
-        random_policy_(
-            local_node_id, cluster_resource_manager.GetResourceView(), is_node_available),
-        spread_policy_(
-            local_node_id, cluster_resource_manager.GetResourceView(), is_node_available),
+      : cluster_resource_manager_(cluster_resource_manager),
+        hybrid_policy_(local_node_id,
+                       cluster_resource_manager.GetResourceView(),
+                       cluster_resource_manager.GetResourceColumns(),
+                       is_node_available),
+        random_policy_(local_node_id,
+                       cluster_resource_manager.GetResourceView(),
+                       cluster_resource_manager.GetResourceColumns(),
+                       is_node_available),
+        spread_policy_(local_node_id,
+                       cluster_resource_manager.GetResourceView(),
+                       cluster_resource_manager.GetResourceColumns(),
+                       is_node_available),
         node_affinity_policy_(local_node_id,
                               cluster_resource_manager.GetResourceView(),
+                              cluster_resource_manager.GetResourceColumns(),
                               is_node_available) {}
 
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
                               SchedulingOptions options) override;
 
+  /// Schedule a group of requests jointly, with the same options. Each request is
+  /// placed as if the requests before it had already been placed, so that requests that
+  /// don't all fit on one node aren't all sent to the same node. The resources of the
+  /// cluster are the same on return as before the call.
+  ///
+  /// \param resource_request_list The requests to schedule, in order.
+  /// \param options The scheduling options of all the requests.
+  /// \return The node of each request, in order, or nil for the requests that couldn't
+  /// be scheduled.
+  std::vector<scheduling::NodeID> ScheduleBatch(
+      const std::vector<const ResourceRequest *> &resource_request_list,
+      SchedulingOptions options);
+
  private:
+  ClusterResourceManager &cluster_resource_manager_;
   HybridSchedulingPolicy hybrid_policy_;
   RandomSchedulingPolicy random_policy_;
   SpreadSchedulingPolicy spread_policy_;
@@ -60,10 +82,18 @@ class CompositeBundleSchedulingPolicy : public IBundleSchedulingPolicy {
   explicit CompositeBundleSchedulingPolicy(
       ClusterResourceManager &cluster_resource_manager,
       std::function<bool(scheduling::NodeID)> is_node_available)
-      : bundle_pack_policy_(cluster_resource_manager, is_node_available),
-        bundle_spread_policy_(cluster_resource_manager, is_node_available),
-        bundle_strict_spread_policy_(cluster_resource_manager, is_node_available),
-        bundle_strict_pack_policy_(cluster_resource_manager, is_node_available) {}
+      : bundle_pack_policy_(cluster_resource_manager,
+                            is_node_available,
+                            CreateNodeScorerForStrategy("PACK")),
+        bundle_spread_policy_(cluster_resource_manager,
+                              is_node_available,
+                              CreateNodeScorerForStrategy("SPREAD")),
+        bundle_strict_spread_policy_(cluster_resource_manager,
+                                     is_node_available,
+                                     CreateNodeScorerForStrategy("STRICT_SPREAD")),
+        bundle_strict_pack_policy_(cluster_resource_manager,
+                                   is_node_available,
+                                   CreateNodeScorerForStrategy("STRICT_PACK")) {}
 
   SchedulingResult Schedule(
       const std::vector<const ResourceRequest *> &resource_request_list,
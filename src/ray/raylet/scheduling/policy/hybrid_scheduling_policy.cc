@@ -16,6 +16,7 @@
 
 #include <functional>
 
+#include "absl/strings/match.h"
 #include "ray/util/container_util.h"
 #include "ray/util/util.h"
 
@@ -28,23 +29,35 @@ scheduling::NodeID HybridSchedulingPolicy::HybridPolicyWithFilter(
     float spread_threshold,
     bool force_spillback,
     bool require_node_available,
-    NodeFilter node_filter) {
-  // Step 1: Generate the traversal order. We guarantee that the first node is local, to
+    NodeFilter node_filter,
+    const absl::optional<scheduling::ResourceID> &node_group) {
+  RAY_CHECK(nodes_.contains(local_node_id_));
+  RAY_CHECK(columns_.Size() == nodes_.size());
+
+  // Step 1: Check the request against the predefined resources of all nodes at once.
+  columns_.CheckRequest(resource_request, &feasible_mask_, &available_mask_);
+
+  // Step 2: Generate the traversal order. We guarantee that the first node is local, to
   // encourage local scheduling. The rest of the traversal order should be globally
-  // consistent, to encourage using "warm" workers.
-  std::vector<scheduling::NodeID> round;
-  round.reserve(nodes_.size());
-  const auto local_it = nodes_.find(local_node_id_);
-  RAY_CHECK(local_it != nodes_.end());
-  auto predicate = [this, node_filter](scheduling::NodeID node_id,
-                                       const NodeResources &node_resources) {
-    if (!is_node_available_(node_id)) {
+  // consistent, to encourage using "warm" workers. Infeasible nodes are dropped here, so
+  // the traversal only visits candidates.
+  auto predicate = [this, node_filter, &node_group, &resource_request](size_t index) {
+    const auto node_id = columns_.NodeIdAt(index);
+    if (!feasible_mask_[index] || !is_node_available_(node_id)) {
+      return false;
+    }
+    if (columns_.NeedsFullCheck(index, resource_request) &&
+        !nodes_.at(node_id).GetLocalView().IsFeasible(resource_request)) {
+      return false;
+    }
+    if (node_group.has_value() &&
+        !nodes_.at(node_id).GetLocalView().total.Has(*node_group)) {
       return false;
     }
     if (node_filter == NodeFilter::kAny) {
       return true;
     }
-    const bool has_gpu = node_resources.total.Has(ResourceID::GPU());
+    const bool has_gpu = columns_.Total(index, GPU) != 0;
     if (node_filter == NodeFilter::kGPU) {
       return has_gpu;
     }
@@ -52,20 +65,23 @@ scheduling::NodeID HybridSchedulingPolicy::HybridPolicyWithFilter(
     return !has_gpu;
   };
 
-  const auto &local_node_view = local_it->second.GetLocalView();
+  // Pairs of (node id, column index).
+  std::vector<std::pair<scheduling::NodeID, size_t>> round;
+  round.reserve(columns_.Size());
+  const size_t local_index = columns_.IndexOf(local_node_id_);
+  RAY_CHECK(local_index < columns_.Size());
   // If we should include local node at all, make sure it is at the front of the list
   // so that
   // 1. It's first in traversal order.
   // 2. It's easy to avoid sorting it.
-  if (predicate(local_node_id_, local_node_view) && !force_spillback) {
-    round.push_back(local_node_id_);
+  if (!force_spillback && predicate(local_index)) {
+    round.emplace_back(local_node_id_, local_index);
   }
 
   const auto start_index = round.size();
-  for (const auto &pair : nodes_) {
-    if (pair.first != local_node_id_ &&
-        predicate(pair.first, pair.second.GetLocalView())) {
-      round.push_back(pair.first);
+  for (size_t index = 0; index < columns_.Size(); index++) {
+    if (index != local_index && predicate(index)) {
+      round.emplace_back(columns_.NodeIdAt(index), index);
     }
   }
   // Sort all the nodes, making sure that if we added the local node in front, it stays in
@@ -76,35 +92,34 @@ scheduling::NodeID HybridSchedulingPolicy::HybridPolicyWithFilter(
   float best_utilization_score = INFINITY;
   bool best_is_available = false;
 
-  // Step 2: Perform the round robin.
-  auto round_it = round.begin();
-  for (; round_it != round.end(); round_it++) {
-    const auto &node_id = *round_it;
-    const auto &it = nodes_.find(node_id);
-    RAY_CHECK(it != nodes_.end());
-    const auto &node = it->second;
-    if (!node.GetLocalView().IsFeasible(resource_request)) {
-      continue;
-    }
+  // Step 3: Perform the round robin.
+  for (const auto &entry : round) {
+    const auto &node_id = entry.first;
+    const auto index = entry.second;
 
-    bool ignore_pull_manager_at_capacity = false;
-    if (node_id == local_node_id_) {
+    bool is_available = available_mask_[index];
+    if (node_id != local_node_id_ && resource_request.RequiresObjectStoreMemory() &&
+        columns_.ObjectPullsQueued(index)) {
       // It's okay if the local node's pull manager is at
       // capacity because we will eventually spill the task
       // back from the waiting queue if its args cannot be
       // pulled.
-      ignore_pull_manager_at_capacity = true;
+      is_available = false;
+    }
+    if (is_available && columns_.NeedsFullCheck(index, resource_request)) {
+      is_available = nodes_.at(node_id).GetLocalView().IsAvailable(
+          resource_request, /*ignore_pull_manager_at_capacity=*/true);
     }
-    bool is_available = node.GetLocalView().IsAvailable(resource_request,
-                                                        ignore_pull_manager_at_capacity);
     float critical_resource_utilization =
-        node.GetLocalView().CalculateCriticalResourceUtilization();
-    RAY_LOG(DEBUG) << "Node " << node_id.ToInt() << " is "
-                   << (is_available ? "available" : "not available") << " for request "
-                   << resource_request.DebugString()
-                   << " with critical resource utilization "
-                   << critical_resource_utilization << " based on local view "
-                   << node.GetLocalView().DebugString();
+        columns_.CalculateCriticalResourceUtilization(index);
+    if (RAY_LOG_ENABLED(DEBUG)) {
+      RAY_LOG(DEBUG) << "Node " << node_id.ToInt() << " is "
+                     << (is_available ? "available" : "not available")
+                     << " for request " << resource_request.DebugString()
+                     << " with critical resource utilization "
+                     << critical_resource_utilization << " based on local view "
+                     << nodes_.at(node_id).GetLocalView().DebugString();
+    }
     if (critical_resource_utilization < spread_threshold) {
       critical_resource_utilization = 0;
     }
@@ -136,10 +151,39 @@ scheduling::NodeID HybridSchedulingPolicy::HybridPolicyWithFilter(
   return best_node_id;
 }
 
+absl::optional<scheduling::ResourceID> HybridSchedulingPolicy::GetLocalNodeGroup(
+    const std::string &node_group_resource_prefix) const {
+  const auto &total = nodes_.at(local_node_id_).GetLocalView().total;
+  for (const auto &resource_id : total.ResourceIds()) {
+    if (absl::StartsWith(resource_id.Binary(), node_group_resource_prefix)) {
+      return resource_id;
+    }
+  }
+  return absl::nullopt;
+}
+
 scheduling::NodeID HybridSchedulingPolicy::Schedule(
     const ResourceRequest &resource_request, SchedulingOptions options) {
   RAY_CHECK(options.scheduling_type == SchedulingType::HYBRID)
       << "HybridPolicy policy requires type = HYBRID";
+  if (!options.node_group_resource_prefix.empty()) {
+    // Try the available nodes in the group of the local node first.
+    const auto node_group = GetLocalNodeGroup(options.node_group_resource_prefix);
+    if (node_group.has_value()) {
+      const bool avoid_gpu_nodes =
+          options.avoid_gpu_nodes && !resource_request.Has(ResourceID::GPU());
+      auto best_node_id = HybridPolicyWithFilter(
+          resource_request,
+          options.spread_threshold,
+          options.avoid_local_node,
+          /*require_node_available*/ true,
+          avoid_gpu_nodes ? NodeFilter::kNonGpu : NodeFilter::kAny,
+          node_group);
+      if (!best_node_id.IsNil()) {
+        return best_node_id;
+      }
+    }
+  }
   if (!options.avoid_gpu_nodes || resource_request.Has(ResourceID::GPU())) {
     return HybridPolicyWithFilter(resource_request,
                                   options.spread_threshold,
@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "ray/raylet/scheduling/node_resource_columns.h"
 #include "ray/raylet/scheduling/policy/scheduling_policy.h"
 
 namespace ray {
@@ -45,13 +48,22 @@ namespace raylet_scheduling_policy {
 /// We call this a hybrid policy because below the threshold, the traversal and
 /// truncation properties will lead to packing of nodes. Above the threshold, the policy
 /// will act like a traditional weighted round robin.
+///
+/// Feasibility and availability of all nodes are computed up front in one batch from
+/// the columnar resource view, so the traversal only visits feasible nodes.
+///
+/// If nodes are grouped (e.g. by zone, see `scheduler_node_group_resource_prefix`), an
+/// available node in the group of the local node is preferred over the other nodes, to
+/// keep tasks and their data within the group.
 class HybridSchedulingPolicy : public ISchedulingPolicy {
  public:
   HybridSchedulingPolicy(scheduling::NodeID local_node_id,
                          const absl::flat_hash_map<scheduling::NodeID, Node> &nodes,
+                         const NodeResourceColumns &columns,
                          std::function<bool(scheduling::NodeID)> is_node_available)
       : local_node_id_(local_node_id),
         nodes_(nodes),
+        columns_(columns),
         is_node_available_(is_node_available) {}
 
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
@@ -63,6 +75,12 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
   /// List of nodes in the clusters and their resources organized as a map.
   /// The key of the map is the node ID.
   const absl::flat_hash_map<scheduling::NodeID, Node> &nodes_;
+  /// The same nodes as `nodes_`, in a structure-of-arrays layout.
+  const NodeResourceColumns &columns_;
+  /// Scratch buffers for the feasibility and availability masks, reused across calls
+  /// to avoid reallocating them for every request.
+  std::vector<uint8_t> feasible_mask_;
+  std::vector<uint8_t> available_mask_;
 
   /// Function Checks if node is alive.
   std::function<bool(scheduling::NodeID)> is_node_available_;
@@ -78,18 +96,27 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
     kNonGpu
   };
 
+  /// Get the group of the local node, i.e. its custom resource whose name starts with
+  /// the prefix, if any.
+  absl::optional<scheduling::ResourceID> GetLocalNodeGroup(
+      const std::string &node_group_resource_prefix) const;
+
   /// \param resource_request: The resource request we're attempting to schedule.
   /// \param node_filter: defines the subset of nodes were are allowed to schedule on.
   /// can be one of kAny (can schedule on all nodes), kGPU (can only schedule on kGPU
   /// nodes), kNonGpu (can only schedule on non-GPU nodes.
   ///
+  /// \param node_group: if set, only schedule on the nodes that have this resource.
+  ///
   /// \return -1 if the task is unfeasible, otherwise the node id (key in `nodes`) to
   /// schedule on.
-  scheduling::NodeID HybridPolicyWithFilter(const ResourceRequest &resource_request,
-                                            float spread_threshold,
-                                            bool force_spillback,
-                                            bool require_available,
-                                            NodeFilter node_filter = NodeFilter::kAny);
+  scheduling::NodeID HybridPolicyWithFilter(
+      const ResourceRequest &resource_request,
+      float spread_threshold,
+      bool force_spillback,
+      bool require_available,
+      NodeFilter node_filter = NodeFilter::kAny,
+      const absl::optional<scheduling::ResourceID> &node_group = absl::nullopt);
 };
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
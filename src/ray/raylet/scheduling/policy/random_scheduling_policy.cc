@@ -16,13 +16,30 @@
 
 #include <functional>
 
-#include "ray/util/container_util.h"
 #include "ray/util/util.h"
 
 namespace ray {
 
 namespace raylet_scheduling_policy {
 
+bool RandomSchedulingPolicy::CanFulfil(size_t index,
+                                       const ResourceRequest &resource_request) const {
+  if (!feasible_mask_[index] || !available_mask_[index]) {
+    return false;
+  }
+  const auto node_id = columns_.NodeIdAt(index);
+  if (!is_node_available_(node_id)) {
+    return false;
+  }
+  if (columns_.NeedsFullCheck(index, resource_request)) {
+    const auto &node = nodes_.at(node_id).GetLocalView();
+    return node.IsFeasible(resource_request) &&
+           node.IsAvailable(resource_request,
+                            /*ignore_pull_manager_at_capacity*/ true);
+  }
+  return true;
+}
+
 scheduling::NodeID RandomSchedulingPolicy::Schedule(
     const ResourceRequest &resource_request, SchedulingOptions options) {
   RAY_CHECK(options.scheduling_type == SchedulingType::RANDOM)
@@ -38,26 +55,31 @@ scheduling::NodeID RandomSchedulingPolicy::Schedule(
       << "avoid_local_node = false, "
       << "require_node_available = true, "
       << "avoid_gpu_nodes = false.";
+  RAY_CHECK(columns_.Size() == nodes_.size());
 
-  std::uniform_int_distribution<int> distribution(0, nodes_.size() - 1);
-  int idx = distribution(gen_);
-  auto iter = std::next(nodes_.begin(), idx);
-  for (size_t i = 0; i < nodes_.size(); ++i) {
-    // TODO(scv119): if there are a lot of nodes died or can't fulfill the resource
-    // requirement, the distribution might not be even.
-    const auto &node_id = iter->first;
-    const auto &node = iter->second;
-    if (is_node_available_(node_id) && node.GetLocalView().IsFeasible(resource_request) &&
-        node.GetLocalView().IsAvailable(resource_request,
-                                        /*ignore_pull_manager_at_capacity*/ true)) {
-      best_node = iter->first;
-      break;
+  columns_.CheckRequest(resource_request, &feasible_mask_, &available_mask_);
+  // Pick a node uniformly at random. If it can't fulfil the request, pick uniformly
+  // among those that can instead. Either way, each node that can fulfil the request is
+  // picked with the same probability, and in the common case only one node is checked.
+  std::uniform_int_distribution<size_t> distribution(0, columns_.Size() - 1);
+  size_t index = distribution(gen_);
+  if (!CanFulfil(index, resource_request)) {
+    candidates_.clear();
+    for (size_t i = 0; i < columns_.Size(); i++) {
+      if (CanFulfil(i, resource_request)) {
+        candidates_.push_back(i);
+      }
     }
-    ++iter;
-    if (iter == nodes_.end()) {
-      iter = nodes_.begin();
+    index = columns_.Size();
+    if (!candidates_.empty()) {
+      std::uniform_int_distribution<size_t> candidate_distribution(
+          0, candidates_.size() - 1);
+      index = candidates_[candidate_distribution(gen_)];
     }
   }
+  if (index < columns_.Size()) {
+    best_node = columns_.NodeIdAt(index);
+  }
   RAY_LOG(DEBUG) << "RandomPolicy, best_node = " << best_node.ToInt()
                  << ", # nodes = " << nodes_.size()
                  << ", resource_request = " << resource_request.DebugString();
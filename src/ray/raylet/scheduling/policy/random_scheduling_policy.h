@@ -16,36 +16,50 @@
 
 #include <vector>
 
+#include "ray/raylet/scheduling/node_resource_columns.h"
 #include "ray/raylet/scheduling/policy/scheduling_policy.h"
 
 namespace ray {
 namespace raylet_scheduling_policy {
 
-/// Policy that "randomly" picks a node that could fulfil the request.
-/// TODO(scv119): if there are a lot of nodes died or can't fulfill the resource
-/// requirement, the distribution might not be even.
+/// Policy that randomly picks a node that could fulfil the request. Every node that
+/// could fulfil the request is equally likely to be picked.
 class RandomSchedulingPolicy : public ISchedulingPolicy {
  public:
   RandomSchedulingPolicy(scheduling::NodeID local_node_id,
                          const absl::flat_hash_map<scheduling::NodeID, Node> &nodes,
+                         const NodeResourceColumns &columns,
                          std::function<bool(scheduling::NodeID)> is_node_available)
       : local_node_id_(local_node_id),
         nodes_(nodes),
+        columns_(columns),
         gen_(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
         is_node_available_(is_node_available) {}
 
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
                               SchedulingOptions options) override;
 
+ private:
+  /// Whether the node at the given column index can fulfil the request right now.
+  /// `feasible_mask_` and `available_mask_` must have been computed for the request.
+  bool CanFulfil(size_t index, const ResourceRequest &resource_request) const;
+
   /// Identifier of local node.
   const scheduling::NodeID local_node_id_;
   /// List of nodes in the clusters and their resources organized as a map.
   /// The key of the map is the node ID.
   const absl::flat_hash_map<scheduling::NodeID, Node> &nodes_;
+  /// The predefined resources of the nodes in columns, to pick a node by index and to
+  /// check a request against all nodes at once.
+  const NodeResourceColumns &columns_;
   /// Internally maintained random number generator.
   std::mt19937_64 gen_;
   /// Function Checks if node is alive.
   std::function<bool(scheduling::NodeID)> is_node_available_;
+  /// Scratch buffers, kept as members to avoid allocating on every call.
+  std::vector<uint8_t> feasible_mask_;
+  std::vector<uint8_t> available_mask_;
+  std::vector<size_t> candidates_;
 };
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -57,11 +57,15 @@ struct SchedulingOptions {
 
   // construct option for hybrid scheduling policy.
   static SchedulingOptions Hybrid(bool avoid_local_node, bool require_node_available) {
-    return SchedulingOptions(SchedulingType::HYBRID,
-                             RayConfig::instance().scheduler_spread_threshold(),
-                             avoid_local_node,
-                             require_node_available,
-                             RayConfig::instance().scheduler_avoid_gpu_nodes());
+    SchedulingOptions scheduling_options(
+        SchedulingType::HYBRID,
+        RayConfig::instance().scheduler_spread_threshold(),
+        avoid_local_node,
+        require_node_available,
+        RayConfig::instance().scheduler_avoid_gpu_nodes());
+    scheduling_options.node_group_resource_prefix =
+        RayConfig::instance().scheduler_node_group_resource_prefix();
+    return scheduling_options;
   }
 
   static SchedulingOptions NodeAffinity(bool avoid_local_node,
@@ -77,21 +81,25 @@ struct SchedulingOptions {
   }
 
   // construct option for soft pack scheduling policy.
-  static SchedulingOptions BundlePack() {
+  static SchedulingOptions BundlePack(
+      std::unique_ptr<SchedulingContext> scheduling_context = nullptr) {
     return SchedulingOptions(SchedulingType::BUNDLE_PACK,
                              /*spread_threshold*/ 0,
                              /*avoid_local_node*/ false,
                              /*require_node_available*/ true,
-                             /*avoid_gpu_nodes*/ false);
+                             /*avoid_gpu_nodes*/ false,
+                             /*scheduling_context*/ std::move(scheduling_context));
   }
 
   // construct option for strict spread scheduling policy.
-  static SchedulingOptions BundleSpread() {
+  static SchedulingOptions BundleSpread(
+      std::unique_ptr<SchedulingContext> scheduling_context = nullptr) {
     return SchedulingOptions(SchedulingType::BUNDLE_SPREAD,
                              /*spread_threshold*/ 0,
                              /*avoid_local_node*/ false,
                              /*require_node_available*/ true,
-                             /*avoid_gpu_nodes*/ false);
+                             /*avoid_gpu_nodes*/ false,
+                             /*scheduling_context*/ std::move(scheduling_context));
   }
 
   // construct option for strict pack scheduling policy.
@@ -122,6 +130,9 @@ struct SchedulingOptions {
   std::shared_ptr<SchedulingContext> scheduling_context;
   std::string node_affinity_node_id;
   bool node_affinity_soft = false;
+  // If not empty, prefer the nodes in the same group as the local node, see
+  // `scheduler_node_group_resource_prefix`.
+  std::string node_group_resource_prefix;
 
  private:
   SchedulingOptions(SchedulingType type,
@@ -62,7 +62,9 @@ class SchedulingPolicyTest : public ::testing::Test {
   ClusterResourceManager MockClusterResourceManager(
       const absl::flat_hash_map<scheduling::NodeID, Node> &nodes) {
     ClusterResourceManager cluster_resource_manager;
-    cluster_resource_manager.nodes_ = nodes;
+    for (const auto &entry : nodes) {
+      cluster_resource_manager.AddOrUpdateNode(entry.first, entry.second.GetLocalView());
+    }
     return cluster_resource_manager;
   }
 };
@@ -153,6 +155,76 @@ TEST_F(SchedulingPolicyTest, SpreadPolicyTest) {
   ASSERT_TRUE(to_schedule.IsNil());
 }
 
+TEST_F(SchedulingPolicyTest, SpreadPolicyNodesAddedAndRemovedTest) {
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+
+  nodes.emplace(local_node, CreateNodeResources(20, 20, 0, 0, 0, 0));
+  nodes.emplace(remote_node, CreateNodeResources(20, 20, 0, 0, 0, 0));
+  nodes.emplace(remote_node_2, CreateNodeResources(20, 20, 0, 0, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  raylet_scheduling_policy::CompositeSchedulingPolicy scheduling_policy(
+      local_node, cluster_resource_manager, [](auto) { return true; });
+
+  auto spread = [&]() {
+    return scheduling_policy.Schedule(req, SchedulingOptions::Spread(false, false));
+  };
+  ASSERT_EQ(spread(), local_node);
+  ASSERT_EQ(spread(), remote_node);
+  ASSERT_EQ(spread(), remote_node_2);
+  ASSERT_EQ(spread(), local_node);
+
+  // The new node joins the round.
+  cluster_resource_manager.AddOrUpdateNode(remote_node_3,
+                                           CreateNodeResources(20, 20, 0, 0, 0, 0));
+  ASSERT_EQ(spread(), remote_node);
+  ASSERT_EQ(spread(), remote_node_2);
+  ASSERT_EQ(spread(), remote_node_3);
+
+  // The removed node leaves the round, and the others are still visited in order even
+  // though their column indexes changed.
+  ASSERT_TRUE(cluster_resource_manager.RemoveNode(remote_node));
+  ASSERT_EQ(spread(), local_node);
+  ASSERT_EQ(spread(), remote_node_2);
+  ASSERT_EQ(spread(), remote_node_3);
+  ASSERT_EQ(spread(), local_node);
+}
+
+TEST_F(SchedulingPolicyTest, ScheduleBatchTest) {
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 3}}, false);
+
+  nodes.emplace(local_node, CreateNodeResources(4, 4, 0, 0, 0, 0));
+  nodes.emplace(remote_node, CreateNodeResources(4, 4, 0, 0, 0, 0));
+  nodes.emplace(remote_node_2, CreateNodeResources(4, 4, 0, 0, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  raylet_scheduling_policy::CompositeSchedulingPolicy scheduling_policy(
+      local_node, cluster_resource_manager, [](auto) { return true; });
+
+  // One request fits on each node, so the requests are spread over all the nodes and
+  // the fourth one can't be placed.
+  auto to_schedule = scheduling_policy.ScheduleBatch(
+      {&req, &req, &req, &req}, HybridOptions(0.5, false, true));
+  ASSERT_EQ(to_schedule.size(), 4);
+  ASSERT_EQ(to_schedule[0], local_node);
+  ASSERT_EQ(
+      absl::flat_hash_set<scheduling::NodeID>(to_schedule.begin(), to_schedule.end() - 1),
+      absl::flat_hash_set<scheduling::NodeID>({local_node, remote_node, remote_node_2}));
+  ASSERT_TRUE(to_schedule[3].IsNil());
+
+  // The resources of the cluster are left unchanged.
+  for (const auto &[node_id, node] : nodes) {
+    ASSERT_EQ(cluster_resource_manager.GetNodeResources(node_id), node.GetLocalView());
+  }
+
+  // Without requiring an available node, the fourth request is placed on a node that
+  // is feasible, and the resources are still restored exactly.
+  to_schedule = scheduling_policy.ScheduleBatch({&req, &req, &req, &req},
+                                                HybridOptions(0.5, false, false));
+  ASSERT_FALSE(to_schedule[3].IsNil());
+  for (const auto &[node_id, node] : nodes) {
+    ASSERT_EQ(cluster_resource_manager.GetNodeResources(node_id), node.GetLocalView());
+  }
+}
+
 TEST_F(SchedulingPolicyTest, RandomPolicyTest) {
   ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
 
@@ -185,6 +257,35 @@ TEST_F(SchedulingPolicyTest, RandomPolicyTest) {
   ASSERT_TRUE(num_node_1_picks > 0);
 }
 
+TEST_F(SchedulingPolicyTest, RandomPolicyUniformTest) {
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+
+  // Only two of the nodes can fulfil the request, and they should be picked equally
+  // often regardless of where the other nodes are.
+  nodes.emplace(local_node, CreateNodeResources(20, 20, 0, 0, 0, 0));
+  nodes.emplace(remote_node, CreateNodeResources(0, 20, 0, 0, 0, 0));
+  nodes.emplace(remote_node_2, CreateNodeResources(0, 20, 0, 0, 0, 0));
+  nodes.emplace(remote_node_3, CreateNodeResources(20, 20, 0, 0, 0, 0));
+  nodes.emplace(scheduling::NodeID(4), CreateNodeResources(0, 0, 0, 0, 0, 0));
+
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  raylet_scheduling_policy::CompositeSchedulingPolicy scheduling_policy(
+      local_node, cluster_resource_manager, [](auto) { return true; });
+
+  std::map<scheduling::NodeID, size_t> decisions;
+  for (int i = 0; i < 2000; i++) {
+    decisions[scheduling_policy.Schedule(req, SchedulingOptions::Random())]++;
+  }
+  ASSERT_EQ(decisions.size(), 2);
+  // Each node is expected to be picked 1000 times, with a standard deviation of ~22.
+  ASSERT_GT(decisions[local_node], 850);
+  ASSERT_GT(decisions[remote_node_3], 850);
+
+  // No node can fulfil the request.
+  req = ResourceMapToResourceRequest({{"CPU", 30}}, false);
+  ASSERT_TRUE(scheduling_policy.Schedule(req, SchedulingOptions::Random()).IsNil());
+}
+
 TEST_F(SchedulingPolicyTest, FeasibleDefinitionTest) {
   auto task_req1 =
       ResourceMapToResourceRequest({{"CPU", 1}, {"object_store_memory", 1}}, false);
@@ -290,6 +391,53 @@ TEST_F(SchedulingPolicyTest, AvailableOverFeasibleTest) {
   ASSERT_EQ(to_schedule, remote_node);
 }
 
+TEST_F(SchedulingPolicyTest, LocalNodeGroupPreferredTest) {
+  // In this test, the local node is full. The remote node in another zone has a lower
+  // critical resource utilization than the one in the same zone as the local node, but
+  // the latter is preferred as long as it is available.
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto add_node = [this](scheduling::NodeID node_id,
+                         double available_cpu,
+                         const std::string &zone) {
+    auto resources = CreateNodeResources(available_cpu, 2, 0, 0, 0, 0);
+    resources.total.Set(ResourceID(zone), 1);
+    resources.available.Set(ResourceID(zone), 1);
+    nodes.emplace(node_id, resources);
+  };
+  add_node(local_node, 0, "zone:a");
+  add_node(remote_node, 2, "zone:b");
+  add_node(remote_node_2, 1, "zone:a");
+
+  auto options = HybridOptions(0.50, false, false);
+  {
+    auto cluster_resource_manager = MockClusterResourceManager(nodes);
+    auto to_schedule = raylet_scheduling_policy::CompositeSchedulingPolicy(
+                           local_node, cluster_resource_manager, [](auto) { return true; })
+                           .Schedule(req, options);
+    ASSERT_EQ(to_schedule, remote_node);
+  }
+
+  options.node_group_resource_prefix = "zone:";
+  {
+    auto cluster_resource_manager = MockClusterResourceManager(nodes);
+    auto to_schedule = raylet_scheduling_policy::CompositeSchedulingPolicy(
+                           local_node, cluster_resource_manager, [](auto) { return true; })
+                           .Schedule(req, options);
+    ASSERT_EQ(to_schedule, remote_node_2);
+  }
+
+  // Once no node in the zone is available, nodes in other zones are considered.
+  nodes.erase(remote_node_2);
+  add_node(remote_node_2, 0, "zone:a");
+  {
+    auto cluster_resource_manager = MockClusterResourceManager(nodes);
+    auto to_schedule = raylet_scheduling_policy::CompositeSchedulingPolicy(
+                           local_node, cluster_resource_manager, [](auto) { return true; })
+                           .Schedule(req, options);
+    ASSERT_EQ(to_schedule, remote_node);
+  }
+}
+
 TEST_F(SchedulingPolicyTest, InfeasibleTest) {
   // All the nodes are infeasible, so we return -1.
   ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}, {"GPU", 1}}, false);
@@ -488,6 +636,88 @@ TEST_F(SchedulingPolicyTest, NonGpuNodePreferredSchedulingTest) {
   ASSERT_EQ(to_schedule, remote_node);
 }
 
+TEST_F(SchedulingPolicyTest, DotProductScorerTest) {
+  DotProductScorer scorer;
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 2}}, false);
+
+  // The node that the request fills up the most is favored.
+  auto half_used = CreateNodeResources(4, 8, 0, 0, 0, 0);
+  auto mostly_used = CreateNodeResources(2, 8, 0, 0, 0, 0);
+  ASSERT_GT(scorer.Score(req, mostly_used), scorer.Score(req, half_used));
+
+  // Infeasible nodes are rejected.
+  auto full = CreateNodeResources(1, 8, 0, 0, 0, 0);
+  ASSERT_LT(scorer.Score(req, full), 0);
+}
+
+TEST_F(SchedulingPolicyTest, GpuFragmentationAwareScorerTest) {
+  GpuFragmentationAwareScorer scorer;
+
+  // Requests without GPUs go to nodes without GPUs, even a busier one.
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto cpu_node = CreateNodeResources(2, 8, 0, 0, 0, 0);
+  auto gpu_node = CreateNodeResources(8, 8, 0, 0, 1, 1);
+  ASSERT_GT(scorer.Score(req, cpu_node), scorer.Score(req, gpu_node));
+
+  // Fractional GPU requests go to the node whose GPU is already split.
+  req = ResourceMapToResourceRequest({{"GPU", 0.5}}, false);
+  auto fragmented_gpu_node = CreateNodeResources(8, 8, 0, 0, 1.5, 2);
+  auto whole_gpu_node = CreateNodeResources(8, 8, 0, 0, 2, 2);
+  ASSERT_GT(scorer.Score(req, fragmented_gpu_node), scorer.Score(req, whole_gpu_node));
+
+  // Whole GPU requests go to the node with the fewest free GPUs.
+  req = ResourceMapToResourceRequest({{"GPU", 1}}, false);
+  auto busy_gpu_node = CreateNodeResources(8, 8, 0, 0, 1, 2);
+  ASSERT_GT(scorer.Score(req, busy_gpu_node), scorer.Score(req, whole_gpu_node));
+  ASSERT_LT(scorer.Score(req, cpu_node), 0);
+}
+
+TEST_F(SchedulingPolicyTest, LocalityWeightedScorerTest) {
+  auto preferred_node_id = NodeID::FromRandom();
+  auto preferred_node = scheduling::NodeID(preferred_node_id.Binary());
+  auto other_node = scheduling::NodeID(NodeID::FromRandom().Binary());
+  nodes.emplace(preferred_node, CreateNodeResources(4, 8, 0, 0, 0, 0));
+  nodes.emplace(other_node, CreateNodeResources(8, 8, 0, 0, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  ResourceRequest req = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  std::vector<const ResourceRequest *> req_list = {&req};
+
+  // Without locality, the less loaded node wins.
+  BundlePackSchedulingPolicy least_resource_policy(cluster_resource_manager,
+                                                   [](auto) { return true; });
+  auto result = least_resource_policy.Schedule(req_list, SchedulingOptions::BundlePack());
+  ASSERT_TRUE(result.status.IsSuccess());
+  ASSERT_EQ(result.selected_nodes[0], other_node);
+
+  // The node that already holds a bundle of the placement group wins with locality.
+  auto bundle_locations = std::make_shared<BundleLocations>();
+  bundle_locations->emplace(BundleID(PlacementGroupID::Of(JobID::FromInt(1)), 0),
+                            std::make_pair(preferred_node_id, nullptr));
+  BundlePackSchedulingPolicy locality_policy(cluster_resource_manager,
+                                             [](auto) { return true; },
+                                             CreateNodeScorer("locality_weighted"));
+  result = locality_policy.Schedule(
+      req_list,
+      SchedulingOptions::BundlePack(
+          std::make_unique<BundleSchedulingContext>(bundle_locations)));
+  ASSERT_TRUE(result.status.IsSuccess());
+  ASSERT_EQ(result.selected_nodes[0], preferred_node);
+}
+
+TEST_F(SchedulingPolicyTest, NodeScorerForStrategyTest) {
+  RayConfig::instance().initialize(
+      R"({"placement_group_node_scorers": "PACK:dot_product,SPREAD:gpu_fragmentation"})");
+  ASSERT_NE(dynamic_cast<DotProductScorer *>(CreateNodeScorerForStrategy("PACK").get()),
+            nullptr);
+  ASSERT_NE(dynamic_cast<GpuFragmentationAwareScorer *>(
+                CreateNodeScorerForStrategy("SPREAD").get()),
+            nullptr);
+  ASSERT_NE(dynamic_cast<LeastResourceScorer *>(
+                CreateNodeScorerForStrategy("STRICT_PACK").get()),
+            nullptr);
+  RayConfig::instance().initialize(R"({"placement_group_node_scorers": ""})");
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -14,30 +14,53 @@
 
 #include "ray/raylet/scheduling/policy/scorer.h"
 
+#include <boost/algorithm/string.hpp>
+#include <cmath>
 #include <numeric>
 
+#include "ray/common/ray_config.h"
+
 namespace ray {
 namespace raylet_scheduling_policy {
 
+namespace {
+
+/// The bonus that `CreateNodeScorer("locality_weighted")` gives to preferred nodes,
+/// i.e. as much as one fully free resource is worth to `LeastResourceScorer`.
+constexpr double kDefaultLocalityWeight = 1.0;
+
+/// Return the available resources of a node that scorers should look at.
+///
+/// In GCS-based actor scheduling, the `NodeResources` are only acquired or released by
+/// actor scheduling, instead of being updated by resource reports from raylets. So we
+/// have to subtract normal task resources (if exist) from the current available
+/// resources.
+///
+/// \param node_resources The node resources.
+/// \param buffer Storage for the result when it has to be computed.
+/// \return The available resources, either `node_resources.available` or `*buffer`.
+const ResourceRequest &GetAvailableResources(const NodeResources &node_resources,
+                                             ResourceRequest *buffer) {
+  if (node_resources.normal_task_resources.IsEmpty()) {
+    return node_resources.available;
+  }
+  *buffer = node_resources.available;
+  *buffer -= node_resources.normal_task_resources;
+  buffer->RemoveNegative();
+  return *buffer;
+}
+
+}  // namespace
+
 double LeastResourceScorer::Score(const ResourceRequest &required_resources,
                                   const NodeResources &node_resources) {
-  // In GCS-based actor scheduling, the `NodeResources` are only acquired or released by
-  // actor scheduling, instead of being updated by resource reports from raylets. So we
-  // have to subtract normal task resources (if exist) from the current available
-  // resources.
-  const NodeResources *node_resources_ptr = &node_resources;
-  NodeResources new_node_resources;
-  if (!node_resources.normal_task_resources.IsEmpty()) {
-    new_node_resources = node_resources;
-    new_node_resources.available -= node_resources.normal_task_resources;
-    new_node_resources.available.RemoveNegative();
-    node_resources_ptr = &new_node_resources;
-  }
+  ResourceRequest buffer;
+  const auto &available = GetAvailableResources(node_resources, &buffer);
 
   double node_score = 0.;
   for (auto &resource_id : required_resources.ResourceIds()) {
     const auto &request_resource = required_resources.Get(resource_id);
-    const auto &node_available_resource = node_resources_ptr->available.Get(resource_id);
+    const auto &node_available_resource = available.Get(resource_id);
     auto score = Calculate(request_resource, node_available_resource);
     if (score < 0.) {
       return -1.;
@@ -62,5 +85,111 @@ double LeastResourceScorer::Calculate(const FixedPoint &requested,
   return (available - requested).Double() / available.Double();
 }
 
+double DotProductScorer::Score(const ResourceRequest &required_resources,
+                               const NodeResources &node_resources) {
+  ResourceRequest buffer;
+  const auto &available = GetAvailableResources(node_resources, &buffer);
+
+  double node_score = 0.;
+  size_t num_resources = 0;
+  for (auto &resource_id : required_resources.ResourceIds()) {
+    const auto &requested = required_resources.Get(resource_id);
+    const auto &node_available = available.Get(resource_id);
+    if (requested > node_available) {
+      return -1.;
+    }
+    const double total = node_resources.total.Get(resource_id).Double();
+    if (total <= 0.) {
+      continue;
+    }
+    // The share of the node that the request takes, times the share of the node that
+    // will be in use once the request is placed.
+    const double request_share = requested.Double() / total;
+    const double used_share = (total - (node_available - requested).Double()) / total;
+    node_score += request_share * used_share;
+    num_resources++;
+  }
+  return num_resources == 0 ? 0. : node_score / num_resources;
+}
+
+double GpuFragmentationAwareScorer::Score(const ResourceRequest &required_resources,
+                                          const NodeResources &node_resources) {
+  const double least_resource_score =
+      least_resource_scorer_.Score(required_resources, node_resources);
+  if (least_resource_score < 0.) {
+    return -1.;
+  }
+
+  const auto gpu_id = ResourceID::GPU();
+  const auto &requested_gpu = required_resources.Get(gpu_id);
+  if (requested_gpu == 0) {
+    // Normalize the least resource score to [0, 1], and rank all nodes without GPUs
+    // above the nodes with GPUs.
+    const double normalized_score =
+        required_resources.IsEmpty()
+            ? 0.
+            : least_resource_score / required_resources.Size();
+    return node_resources.total.Get(gpu_id) == 0 ? 1. + normalized_score
+                                                 : normalized_score;
+  }
+
+  ResourceRequest buffer;
+  const auto &available_gpu = GetAvailableResources(node_resources, &buffer).Get(gpu_id);
+  const double remaining_gpu = (available_gpu - requested_gpu).Double();
+  // Rank the nodes where the request leaves only whole GPUs behind first, then favor
+  // the nodes whose free GPUs the request fills up the most.
+  const double no_fraction_left = remaining_gpu == std::floor(remaining_gpu) ? 1. : 0.;
+  return no_fraction_left + requested_gpu.Double() / available_gpu.Double();
+}
+
+double LocalityWeightedScorer::Score(const ResourceRequest &required_resources,
+                                     const NodeResources &node_resources) {
+  return base_scorer_->Score(required_resources, node_resources);
+}
+
+double LocalityWeightedScorer::ScoreNode(scheduling::NodeID node_id,
+                                         const ResourceRequest &required_resources,
+                                         const NodeResources &node_resources) {
+  const double node_score =
+      base_scorer_->ScoreNode(node_id, required_resources, node_resources);
+  if (node_score < 0. || !preferred_nodes_.contains(node_id)) {
+    return node_score;
+  }
+  return node_score + locality_weight_;
+}
+
+std::unique_ptr<NodeScorer> CreateNodeScorer(const std::string &name) {
+  if (name == "least_resource") {
+    return std::make_unique<LeastResourceScorer>();
+  } else if (name == "dot_product") {
+    return std::make_unique<DotProductScorer>();
+  } else if (name == "gpu_fragmentation") {
+    return std::make_unique<GpuFragmentationAwareScorer>();
+  } else if (name == "locality_weighted") {
+    return std::make_unique<LocalityWeightedScorer>(
+        std::make_unique<LeastResourceScorer>(), kDefaultLocalityWeight);
+  }
+  RAY_LOG(FATAL) << "Unknown node scorer: " << name;
+  return nullptr;
+}
+
+std::unique_ptr<NodeScorer> CreateNodeScorerForStrategy(const std::string &strategy) {
+  const std::string &config = RayConfig::instance().placement_group_node_scorers();
+  if (!config.empty()) {
+    std::vector<std::string> entries;
+    boost::split(entries, config, boost::is_any_of(","));
+    for (const auto &entry : entries) {
+      std::vector<std::string> parts;
+      boost::split(parts, entry, boost::is_any_of(":"));
+      RAY_CHECK(parts.size() == 2)
+          << "Invalid entry in placement_group_node_scorers: " << entry;
+      if (parts[0] == strategy) {
+        return CreateNodeScorer(parts[1]);
+      }
+    }
+  }
+  return std::make_unique<LeastResourceScorer>();
+}
+
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
 #include <optional>
+#include <string>
 
+#include "absl/container/flat_hash_set.h"
 #include "ray/raylet/scheduling/cluster_resource_data.h"
 
 namespace ray {
@@ -34,6 +37,26 @@ class NodeScorer {
   /// \return Score of the node.
   virtual double Score(const ResourceRequest &required_resources,
                        const NodeResources &node_resources) = 0;
+
+  /// \brief Score according to node resources and the ID of the node. Scorers that
+  /// only look at the node resources don't need to override this.
+  ///
+  /// \param node_id The ID of the node.
+  /// \param required_resources The required resources.
+  /// \param node_resources The node resources which contains available and total
+  /// resources.
+  /// \return Score of the node.
+  virtual double ScoreNode(scheduling::NodeID node_id,
+                           const ResourceRequest &required_resources,
+                           const NodeResources &node_resources) {
+    return Score(required_resources, node_resources);
+  }
+
+  /// \brief Set the nodes that already hold bundles of the placement group that is
+  /// being scheduled. Scorers that don't care about locality ignore this.
+  ///
+  /// \param nodes The nodes that hold bundles of the placement group.
+  virtual void SetPreferredNodes(absl::flat_hash_set<scheduling::NodeID> nodes) {}
 };
 
 /// LeastResourceScorer is a score plugin that favors nodes with fewer allocation
@@ -52,5 +75,67 @@ class LeastResourceScorer : public NodeScorer {
   double Calculate(const FixedPoint &requested, const FixedPoint &available);
 };
 
+/// DotProductScorer is a best-fit score plugin. It scores a node by the dot product
+/// of the normalized request and the normalized utilization of the node after the
+/// request is placed, so that nodes that the request fills up the most, in the
+/// dimensions that it asks for, are favored.
+class DotProductScorer : public NodeScorer {
+ public:
+  double Score(const ResourceRequest &required_resources,
+               const NodeResources &node_resources) override;
+};
+
+/// GpuFragmentationAwareScorer is a score plugin that tries to keep whole GPUs free.
+/// Requests without GPUs are steered away from GPU nodes, and GPU requests favor nodes
+/// where they leave no fractional GPU behind, then nodes they fill up the most.
+class GpuFragmentationAwareScorer : public NodeScorer {
+ public:
+  double Score(const ResourceRequest &required_resources,
+               const NodeResources &node_resources) override;
+
+ private:
+  LeastResourceScorer least_resource_scorer_;
+};
+
+/// LocalityWeightedScorer adds a fixed bonus to the score of another scorer for the
+/// nodes that already hold bundles of the placement group being scheduled.
+class LocalityWeightedScorer : public NodeScorer {
+ public:
+  /// \param base_scorer The scorer whose score is weighted.
+  /// \param locality_weight The bonus added to the score of preferred nodes.
+  LocalityWeightedScorer(std::unique_ptr<NodeScorer> base_scorer, double locality_weight)
+      : base_scorer_(std::move(base_scorer)), locality_weight_(locality_weight) {}
+
+  double Score(const ResourceRequest &required_resources,
+               const NodeResources &node_resources) override;
+
+  double ScoreNode(scheduling::NodeID node_id,
+                   const ResourceRequest &required_resources,
+                   const NodeResources &node_resources) override;
+
+  void SetPreferredNodes(absl::flat_hash_set<scheduling::NodeID> nodes) override {
+    preferred_nodes_ = std::move(nodes);
+  }
+
+ private:
+  std::unique_ptr<NodeScorer> base_scorer_;
+  double locality_weight_;
+  absl::flat_hash_set<scheduling::NodeID> preferred_nodes_;
+};
+
+/// \brief Create a scorer by name.
+///
+/// \param name One of "least_resource", "dot_product", "gpu_fragmentation" and
+/// "locality_weighted". The last one weights "least_resource" by locality.
+/// \return The scorer. Crashes if the name is unknown.
+std::unique_ptr<NodeScorer> CreateNodeScorer(const std::string &name);
+
+/// \brief Create the scorer configured for a placement group strategy by
+/// `RayConfig::placement_group_node_scorers`.
+///
+/// \param strategy The name of the placement group strategy, e.g. "STRICT_PACK".
+/// \return The scorer. Defaults to `LeastResourceScorer`.
+std::unique_ptr<NodeScorer> CreateNodeScorerForStrategy(const std::string &strategy);
+
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -0,0 +1,103 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ray/raylet/scheduling/policy/scorer.h"
+
+namespace ray {
+namespace raylet_scheduling_policy {
+
+namespace {
+
+constexpr int kNumNodes = 10000;
+
+const std::vector<std::string> kScorerNames = {
+    "least_resource", "dot_product", "gpu_fragmentation", "locality_weighted"};
+
+/// A cluster where a quarter of the nodes have GPUs, and every node is partially used.
+std::vector<std::pair<scheduling::NodeID, NodeResources>> CreateNodes() {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> used_share(0, 1);
+  std::vector<std::pair<scheduling::NodeID, NodeResources>> nodes;
+  nodes.reserve(kNumNodes);
+  for (int i = 0; i < kNumNodes; i++) {
+    NodeResources resources;
+    const double total_cpu = 16;
+    const double total_memory = 64;
+    const double total_gpu = i % 4 == 0 ? 8 : 0;
+    resources.total.Set(ResourceID::CPU(), total_cpu)
+        .Set(ResourceID::Memory(), total_memory)
+        .Set(ResourceID::GPU(), total_gpu);
+    resources.available.Set(ResourceID::CPU(), total_cpu * used_share(gen))
+        .Set(ResourceID::Memory(), total_memory * used_share(gen))
+        .Set(ResourceID::GPU(), total_gpu * used_share(gen));
+    nodes.emplace_back(scheduling::NodeID(i), std::move(resources));
+  }
+  return nodes;
+}
+
+/// Bundles that alternate between CPU only and fractional GPU requests.
+std::vector<ResourceRequest> CreateBundles(int num_bundles) {
+  std::vector<ResourceRequest> bundles;
+  for (int i = 0; i < num_bundles; i++) {
+    ResourceRequest bundle;
+    bundle.Set(ResourceID::CPU(), 1).Set(ResourceID::Memory(), 2);
+    if (i % 2 == 1) {
+      bundle.Set(ResourceID::GPU(), 0.5);
+    }
+    bundles.push_back(std::move(bundle));
+  }
+  return bundles;
+}
+
+/// Score every node for every bundle, as `BundleSchedulingPolicy::GetBestNode` does.
+/// Args: the index of the scorer in `kScorerNames`, and the number of bundles.
+void BM_ScoreNodes(benchmark::State &state) {
+  const auto nodes = CreateNodes();
+  const auto bundles = CreateBundles(state.range(1));
+  auto scorer = CreateNodeScorer(kScorerNames[state.range(0)]);
+  absl::flat_hash_set<scheduling::NodeID> preferred_nodes;
+  for (int i = 0; i < kNumNodes; i += 100) {
+    preferred_nodes.insert(scheduling::NodeID(i));
+  }
+  scorer->SetPreferredNodes(std::move(preferred_nodes));
+  state.SetLabel(kScorerNames[state.range(0)]);
+
+  for (auto _ : state) {
+    for (const auto &bundle : bundles) {
+      double best_score = -1;
+      for (const auto &[node_id, node_resources] : nodes) {
+        best_score =
+            std::max(best_score, scorer->ScoreNode(node_id, bundle, node_resources));
+      }
+      benchmark::DoNotOptimize(best_score);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumNodes * bundles.size());
+}
+
+BENCHMARK(BM_ScoreNodes)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, kScorerNames.size() - 1, 1),
+                   {1, 8, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace raylet_scheduling_policy
+}  // namespace ray
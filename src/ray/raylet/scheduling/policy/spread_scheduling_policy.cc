@@ -14,26 +14,38 @@
 
 #include "ray/raylet/scheduling/policy/spread_scheduling_policy.h"
 
+#include <algorithm>
 #include <functional>
 
-#include "ray/util/container_util.h"
 #include "ray/util/util.h"
 
 namespace ray {
 
 namespace raylet_scheduling_policy {
 
+void SpreadSchedulingPolicy::UpdateRound() {
+  if (round_built_ && round_version_ == columns_.MembershipVersion()) {
+    return;
+  }
+  round_.resize(columns_.Size());
+  for (size_t i = 0; i < round_.size(); i++) {
+    round_[i] = i;
+  }
+  std::sort(round_.begin(), round_.end(), [this](size_t a, size_t b) {
+    return columns_.NodeIdAt(a) < columns_.NodeIdAt(b);
+  });
+  round_version_ = columns_.MembershipVersion();
+  round_built_ = true;
+}
+
 scheduling::NodeID SpreadSchedulingPolicy::Schedule(
     const ResourceRequest &resource_request, SchedulingOptions options) {
   RAY_CHECK(options.spread_threshold == 0 &&
             options.scheduling_type == SchedulingType::SPREAD)
       << "SpreadPolicy policy requires spread_threshold = 0 and type = SPREAD";
-  std::vector<scheduling::NodeID> round;
-  round.reserve(nodes_.size());
-  for (const auto &pair : nodes_) {
-    round.emplace_back(pair.first);
-  }
-  std::sort(round.begin(), round.end());
+  RAY_CHECK(columns_.Size() == nodes_.size());
+  UpdateRound();
+  columns_.CheckRequest(resource_request, &feasible_mask_, &available_mask_);
 
   // Spread among available nodes first.
   // If there is no available nodes, we spread among feasible nodes.
@@ -41,23 +53,35 @@ scheduling::NodeID SpreadSchedulingPolicy::Schedule(
        (options.require_node_available ? std::vector<bool>{true}
                                        : std::vector<bool>{true, false})) {
     size_t round_index = spread_scheduling_next_index_;
-    for (size_t i = 0; i < round.size(); ++i, ++round_index) {
-      const auto &node_id = round[round_index % round.size()];
-      const auto &node = map_find_or_die(nodes_, node_id);
+    for (size_t i = 0; i < round_.size(); ++i, ++round_index) {
+      const size_t index = round_[round_index % round_.size()];
+      const auto node_id = columns_.NodeIdAt(index);
       if (node_id == local_node_id_ && options.avoid_local_node) {
         continue;
       }
-      if (!is_node_alive_(node_id) || !node.GetLocalView().IsFeasible(resource_request)) {
+      if (!feasible_mask_[index] || !is_node_alive_(node_id)) {
         continue;
       }
-
-      if (available_nodes_only &&
-          !node.GetLocalView().IsAvailable(resource_request,
-                                           /*ignore_pull_manager_at_capacity=*/false)) {
+      const bool needs_full_check = columns_.NeedsFullCheck(index, resource_request);
+      if (needs_full_check &&
+          !nodes_.at(node_id).GetLocalView().IsFeasible(resource_request)) {
         continue;
       }
 
-      spread_scheduling_next_index_ = ((round_index + 1) % round.size());
+      if (available_nodes_only) {
+        bool is_available = available_mask_[index] &&
+                            !(resource_request.RequiresObjectStoreMemory() &&
+                              columns_.ObjectPullsQueued(index));
+        if (is_available && needs_full_check) {
+          is_available = nodes_.at(node_id).GetLocalView().IsAvailable(
+              resource_request, /*ignore_pull_manager_at_capacity=*/false);
+        }
+        if (!is_available) {
+          continue;
+        }
+      }
+
+      spread_scheduling_next_index_ = ((round_index + 1) % round_.size());
       return node_id;
     }
   }
@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "ray/raylet/scheduling/node_resource_columns.h"
 #include "ray/raylet/scheduling/policy/hybrid_scheduling_policy.h"
 #include "ray/raylet/scheduling/policy/scheduling_policy.h"
 
@@ -28,23 +29,44 @@ class SpreadSchedulingPolicy : public ISchedulingPolicy {
  public:
   SpreadSchedulingPolicy(scheduling::NodeID local_node_id,
                          const absl::flat_hash_map<scheduling::NodeID, Node> &nodes,
+                         const NodeResourceColumns &columns,
                          std::function<bool(scheduling::NodeID)> is_node_alive)
-      : local_node_id_(local_node_id), nodes_(nodes), is_node_alive_(is_node_alive) {}
+      : local_node_id_(local_node_id),
+        nodes_(nodes),
+        columns_(columns),
+        is_node_alive_(is_node_alive) {}
 
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
                               SchedulingOptions options) override;
 
+ private:
+  /// Rebuild `round_` if nodes were added or removed since it was last built.
+  void UpdateRound();
+
   /// Identifier of local node.
   const scheduling::NodeID local_node_id_;
   /// List of nodes in the clusters and their resources organized as a map.
   /// The key of the map is the node ID.
   const absl::flat_hash_map<scheduling::NodeID, Node> &nodes_;
+  /// The predefined resources of the nodes in columns, to check a request against all
+  /// nodes at once.
+  const NodeResourceColumns &columns_;
+  /// The column indexes of the nodes, ordered by node ID. This only changes when nodes
+  /// are added or removed, so it isn't rebuilt for every request.
+  std::vector<size_t> round_;
+  /// The `MembershipVersion` of `columns_` that `round_` was built at.
+  uint64_t round_version_ = 0;
+  bool round_built_ = false;
   // The node to start round robin if it's spread scheduling.
   // The index may be inaccurate when nodes are added or removed dynamically,
   // but it should still be better than always scanning from 0 for spread scheduling.
   size_t spread_scheduling_next_index_ = 0;
   /// Function Checks if node is alive.
   std::function<bool(scheduling::NodeID)> is_node_alive_;
+  /// Scratch masks of feasible and available nodes, indexed by column index. They are
+  /// kept as members to avoid allocating on every call.
+  std::vector<uint8_t> feasible_mask_;
+  std::vector<uint8_t> available_mask_;
 };
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -152,6 +152,60 @@ TEST_F(ResourceRequestTest, TestOperators) {
   ASSERT_EQ(r1.ToMap(), expected);
 }
 
+TEST_F(ResourceRequestTest, TestPredefinedAndCustomLayout) {
+  auto cpu_id = ResourceID::CPU();
+  auto gpu_id = ResourceID::GPU();
+  auto mem_id = ResourceID::Memory();
+  std::vector<ResourceID> custom_ids;
+  for (int i = 0; i < 10; i++) {
+    custom_ids.emplace_back("custom" + std::to_string(i));
+  }
+
+  // Insert custom resources in an arbitrary order, interleaved with predefined ones.
+  ResourceRequest r1;
+  for (int i = 9; i >= 0; i -= 2) {
+    r1.Set(custom_ids[i], i + 1);
+  }
+  r1.Set(gpu_id, 1);
+  for (int i = 0; i < 10; i += 2) {
+    r1.Set(custom_ids[i], i + 1);
+  }
+  r1.Set(cpu_id, 2);
+  ASSERT_EQ(r1.Size(), 12);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(r1.Get(custom_ids[i]), i + 1);
+  }
+
+  // Predefined resources come first, followed by custom resources sorted by ID.
+  auto resource_ids = r1.ResourceIds();
+  ASSERT_EQ(resource_ids[0], cpu_id);
+  ASSERT_EQ(resource_ids[1], gpu_id);
+  ASSERT_TRUE(std::is_sorted(resource_ids.begin() + 2, resource_ids.end()));
+
+  // The insertion order doesn't affect equality.
+  ResourceRequest r2(r1.ToMap());
+  ASSERT_EQ(r1, r2);
+
+  // An absent predefined resource compares like a 0 value.
+  r2.Set(mem_id, 1);
+  ASSERT_TRUE(r1 <= r2);
+  ASSERT_FALSE(r2 <= r1);
+  r2.Set(mem_id, -1);
+  ASSERT_FALSE(r1 <= r2);
+  ASSERT_TRUE(r2 <= r1);
+
+  // Removing custom resources keeps the remaining ones reachable.
+  r2 = r1;
+  for (int i = 0; i < 10; i += 3) {
+    r2.Set(custom_ids[i], 0);
+  }
+  ASSERT_EQ(r2.Size(), 8);
+  ASSERT_TRUE(r2 <= r1);
+  ASSERT_FALSE(r1 <= r2);
+  ASSERT_EQ(r2.Get(custom_ids[1]), 2);
+  ASSERT_FALSE(r2.Has(custom_ids[3]));
+}
+
 class TaskResourceInstancesTest : public ::testing::Test {};
 
 TEST_F(TaskResourceInstancesTest, TestBasic) {
@@ -0,0 +1,78 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/resource_shape_index.h"
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+void ResourceShapeIndex::AddShape(const ResourceRequest &shape) {
+  auto &tracked_shape = shapes_[shape];
+  if (tracked_shape.ref_count++ > 0) {
+    return;
+  }
+  for (const auto &[node_id, total] : node_totals_) {
+    if (shape <= total) {
+      tracked_shape.feasible_nodes.insert(node_id);
+    }
+  }
+}
+
+void ResourceShapeIndex::RemoveShape(const ResourceRequest &shape) {
+  auto it = shapes_.find(shape);
+  RAY_CHECK(it != shapes_.end()) << "Removing a shape that isn't tracked: "
+                                 << shape.DebugString();
+  if (--it->second.ref_count == 0) {
+    shapes_.erase(it);
+  }
+}
+
+const absl::flat_hash_set<scheduling::NodeID> &ResourceShapeIndex::GetFeasibleNodes(
+    const ResourceRequest &shape) const {
+  auto it = shapes_.find(shape);
+  RAY_CHECK(it != shapes_.end()) << "Shape isn't tracked: " << shape.DebugString();
+  return it->second.feasible_nodes;
+}
+
+void ResourceShapeIndex::UpdateNode(scheduling::NodeID node_id,
+                                    const NodeResources &node_resources) {
+  auto it = node_totals_.find(node_id);
+  if (it == node_totals_.end()) {
+    it = node_totals_.emplace(node_id, node_resources.total).first;
+  } else if (it->second == node_resources.total) {
+    return;
+  } else {
+    it->second = node_resources.total;
+  }
+
+  for (auto &[shape, tracked_shape] : shapes_) {
+    if (shape <= it->second) {
+      tracked_shape.feasible_nodes.insert(node_id);
+    } else {
+      tracked_shape.feasible_nodes.erase(node_id);
+    }
+  }
+}
+
+void ResourceShapeIndex::RemoveNode(scheduling::NodeID node_id) {
+  if (node_totals_.erase(node_id) == 0) {
+    return;
+  }
+  for (auto &[shape, tracked_shape] : shapes_) {
+    tracked_shape.feasible_nodes.erase(node_id);
+  }
+}
+
+}  // namespace ray
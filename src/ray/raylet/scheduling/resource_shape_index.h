@@ -0,0 +1,79 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "ray/raylet/scheduling/cluster_resource_data.h"
+#include "ray/raylet/scheduling/scheduling_ids.h"
+
+namespace ray {
+
+/// An index from resource shapes to the nodes whose total resources could ever satisfy
+/// them, kept up to date by `ClusterResourceManager`.
+///
+/// A node is only re-checked against the tracked shapes when its total resources
+/// change, so the frequent updates of available resources are cheap. Callers with
+/// many infeasible shapes can then skip a shape entirely until a node that can satisfy
+/// it joins the cluster, instead of rescanning every node for every shape.
+///
+/// This class is not thread safe.
+class ResourceShapeIndex {
+ public:
+  ResourceShapeIndex() = default;
+
+  /// Start tracking a shape. Shapes are reference counted, and each call must be
+  /// matched by a call to `RemoveShape`.
+  void AddShape(const ResourceRequest &shape);
+
+  /// Stop tracking a shape.
+  void RemoveShape(const ResourceRequest &shape);
+
+  /// Return whether the shape is tracked.
+  bool HasShape(const ResourceRequest &shape) const { return shapes_.contains(shape); }
+
+  /// Return the number of tracked shapes.
+  size_t NumShapes() const { return shapes_.size(); }
+
+  /// Return the nodes whose total resources satisfy a tracked shape.
+  /// NOTE: the shape must be tracked.
+  const absl::flat_hash_set<scheduling::NodeID> &GetFeasibleNodes(
+      const ResourceRequest &shape) const;
+
+  /// Add a new node or update the resources of an existing node. This is a no-op for
+  /// the tracked shapes if the total resources of the node didn't change.
+  void UpdateNode(scheduling::NodeID node_id, const NodeResources &node_resources);
+
+  /// Remove a node. This is a no-op if the node doesn't exist.
+  void RemoveNode(scheduling::NodeID node_id);
+
+ private:
+  struct TrackedShape {
+    /// Number of `AddShape` calls not matched by a `RemoveShape` call yet.
+    int64_t ref_count = 0;
+    /// Nodes whose total resources satisfy the shape.
+    absl::flat_hash_set<scheduling::NodeID> feasible_nodes;
+  };
+
+  /// The tracked shapes.
+  absl::flat_hash_map<ResourceRequest, TrackedShape> shapes_;
+  /// The total resources of every node, used to fill in the feasible nodes of newly
+  /// tracked shapes and to tell whether an update changes the totals.
+  absl::flat_hash_map<scheduling::NodeID, ResourceRequest> node_totals_;
+};
+
+}  // namespace ray
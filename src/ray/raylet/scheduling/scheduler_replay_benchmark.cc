@@ -0,0 +1,156 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays a scheduling trace recorded with `scheduler_trace_directory` against the
+// scheduling policies of this build, and reports their throughput and the quality of
+// their placements next to the recorded ones.
+//
+// Usage: scheduler_replay TRACE_FILE [NUM_ITERATIONS]
+//
+// Each decision is replayed against the resource view that the recorded decision was
+// made with, so the replayed decisions don't change the resources of the cluster.
+// All the nodes of the view are considered alive.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/time/clock.h"
+#include "ray/raylet/scheduling/cluster_resource_manager.h"
+#include "ray/raylet/scheduling/policy/composite_scheduling_policy.h"
+#include "ray/raylet/scheduling/scheduling_trace.h"
+
+namespace ray {
+
+namespace {
+
+/// The quality of the placements of a set of decisions.
+struct PlacementStats {
+  int64_t num_decisions = 0;
+  /// The decisions that found no node.
+  int64_t num_infeasible = 0;
+  /// The decisions that picked a node with the requested resources available, rather
+  /// than a node where the request has to wait.
+  int64_t num_available = 0;
+  /// The sum of the critical resource utilization of the picked nodes, before the
+  /// request was placed.
+  double total_utilization = 0;
+  absl::flat_hash_set<scheduling::NodeID> nodes;
+
+  void Add(const ClusterResourceManager &cluster_resource_manager,
+           const ResourceRequest &resource_request,
+           scheduling::NodeID node_id) {
+    num_decisions++;
+    const auto &nodes_view = cluster_resource_manager.GetResourceView();
+    auto it = nodes_view.find(node_id);
+    if (node_id.IsNil() || it == nodes_view.end()) {
+      num_infeasible++;
+      return;
+    }
+    const auto &resources = it->second.GetLocalView();
+    if (resources.IsAvailable(resource_request)) {
+      num_available++;
+    }
+    total_utilization += resources.CalculateCriticalResourceUtilization();
+    nodes.insert(node_id);
+  }
+
+  void Print(const std::string &name) const {
+    const int64_t num_placed = num_decisions - num_infeasible;
+    std::cout << name << ": infeasible " << num_infeasible << ", placed on an available "
+              << "node " << 100.0 * num_available / std::max<int64_t>(num_placed, 1)
+              << "%, mean utilization of the picked node "
+              << total_utilization / std::max<int64_t>(num_placed, 1) << ", distinct "
+              << "nodes " << nodes.size() << std::endl;
+  }
+};
+
+int Replay(const std::string &path, int64_t num_iterations) {
+  auto reader = SchedulingTraceReader::Open(path);
+  if (reader == nullptr) {
+    std::cerr << "Failed to read the scheduling trace " << path << std::endl;
+    return 1;
+  }
+  std::vector<SchedulingTraceEvent> events;
+  SchedulingTraceEvent event;
+  while (reader->Next(&event)) {
+    events.push_back(event);
+  }
+
+  for (int64_t iteration = 0; iteration < num_iterations; iteration++) {
+    ClusterResourceManager cluster_resource_manager;
+    raylet_scheduling_policy::CompositeSchedulingPolicy policy(
+        reader->LocalNodeId(),
+        cluster_resource_manager,
+        /*is_node_available=*/[](scheduling::NodeID) { return true; });
+    PlacementStats recorded;
+    PlacementStats replayed;
+    int64_t num_same_node = 0;
+    int64_t schedule_time_ns = 0;
+
+    for (const auto &event : events) {
+      switch (event.type) {
+      case SchedulingTraceEvent::Type::NODE_UPDATE:
+        cluster_resource_manager.AddOrUpdateNode(event.node_id, event.node_resources);
+        break;
+      case SchedulingTraceEvent::Type::NODE_REMOVE:
+        cluster_resource_manager.RemoveNode(event.node_id);
+        break;
+      case SchedulingTraceEvent::Type::DECISION: {
+        const int64_t start_ns = absl::GetCurrentTimeNanos();
+        const auto node_id = policy.Schedule(event.resource_request, event.options);
+        schedule_time_ns += absl::GetCurrentTimeNanos() - start_ns;
+        recorded.Add(
+            cluster_resource_manager, event.resource_request, event.selected_node_id);
+        replayed.Add(cluster_resource_manager, event.resource_request, node_id);
+        if (node_id == event.selected_node_id) {
+          num_same_node++;
+        }
+        break;
+      }
+      }
+    }
+
+    const int64_t num_decisions = replayed.num_decisions;
+    std::cout << "Iteration " << iteration << ": replayed " << num_decisions
+              << " decisions in " << schedule_time_ns / 1e6 << " ms, "
+              << std::setprecision(4)
+              << num_decisions / std::max(schedule_time_ns / 1e9, 1e-9)
+              << " decisions/s, "
+              << schedule_time_ns / std::max<int64_t>(num_decisions, 1)
+              << " ns/decision, same node as recorded "
+              << 100.0 * num_same_node / std::max<int64_t>(num_decisions, 1) << "%"
+              << std::endl;
+    recorded.Print("  Recorded");
+    replayed.Print("  Replayed");
+  }
+  return 0;
+}
+
+}  // namespace
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " TRACE_FILE [NUM_ITERATIONS]" << std::endl;
+    return 1;
+  }
+  const int64_t num_iterations = argc > 2 ? std::atoll(argv[2]) : 1;
+  return ray::Replay(argv[1], num_iterations);
+}
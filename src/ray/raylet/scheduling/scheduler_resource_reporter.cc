@@ -16,8 +16,7 @@
 
 #include <google/protobuf/util/json_util.h>
 
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <algorithm>
 #include <boost/range/join.hpp>
 
 namespace ray {
@@ -56,6 +55,19 @@ int64_t SchedulerResourceReporter::TotalBacklogSize(
   return sum;
 }
 
+const absl::flat_hash_map<std::string, double> &SchedulerResourceReporter::GetShape(
+    SchedulingClass scheduling_class) const {
+  auto it = shapes_.find(scheduling_class);
+  if (it == shapes_.end()) {
+    it = shapes_
+             .emplace(scheduling_class,
+                      TaskSpecification::GetSchedulingClassDescriptor(scheduling_class)
+                          .resource_set.GetResourceMap())
+             .first;
+  }
+  return it->second;
+}
+
 void SchedulerResourceReporter::FillResourceUsage(
     rpc::ResourcesData &data,
     const std::shared_ptr<NodeResources> &last_reported_resources) const {
@@ -63,79 +75,75 @@ void SchedulerResourceReporter::FillResourceUsage(
     return;
   }
 
-  auto resource_loads = data.mutable_resource_load();
-  auto resource_load_by_shape =
-      data.mutable_resource_load_by_shape()->mutable_resource_demands();
-
-  int num_reported = 0;
-  int64_t skipped_requests = 0;
-
+  struct ShapeLoad {
+    SchedulingClass scheduling_class;
+    int64_t count;
+    bool is_infeasible;
+    int64_t backlog_size;
+  };
+  std::vector<ShapeLoad> loads;
+  // The backlog of a scheduling class is only reported with its first entry.
   absl::flat_hash_set<SchedulingClass> visited;
-  auto fill_resource_usage_helper = [&](const auto &range, bool is_infeasible) mutable {
-    for (auto [scheduling_class, count] : range) {
-      if (num_reported++ >= max_resource_shapes_per_load_report_ &&
-          max_resource_shapes_per_load_report_ >= 0) {
-        // TODO (Alex): It's possible that we skip a different scheduling key which
-        // contains the same resources.
-        skipped_requests++;
-        break;
-      }
-
-      const auto &resources =
-          TaskSpecification::GetSchedulingClassDescriptor(scheduling_class)
-              .resource_set.GetResourceMap();
-      auto by_shape_entry = resource_load_by_shape->Add();
-
-      for (const auto &resource : resources) {
-        const auto &label = resource.first;
-        const auto &quantity = resource.second;
-
-        if (count != 0) {
-          // Add to `resource_loads`.
-          (*resource_loads)[label] += quantity * count;
-        }
-        // Add to `resource_load_by_shape`.
-        (*by_shape_entry->mutable_shape())[label] = quantity;
+  auto add_loads = [&loads, &visited, this](const auto &queues, bool is_infeasible) {
+    for (const auto &[scheduling_class, queue] : queues) {
+      int64_t backlog_size = 0;
+      if (visited.insert(scheduling_class).second) {
+        backlog_size = TotalBacklogSize(scheduling_class);
       }
+      loads.push_back({scheduling_class,
+                       static_cast<int64_t>(queue.size()),
+                       is_infeasible,
+                       backlog_size});
+    }
+  };
+  add_loads(tasks_to_schedule_, false);
+  add_loads(tasks_to_dispatch_, false);
+  add_loads(infeasible_tasks_, true);
+  for (const auto &[scheduling_class, _] : backlog_tracker_) {
+    if (!visited.contains(scheduling_class)) {
+      loads.push_back({scheduling_class, 0, false, TotalBacklogSize(scheduling_class)});
+    }
+  }
 
-      if (is_infeasible) {
-        by_shape_entry->set_num_infeasible_requests_queued(count);
-      } else {
-        by_shape_entry->set_num_ready_requests_queued(count);
-      }
+  if (max_resource_shapes_per_load_report_ > 0 &&
+      loads.size() > static_cast<size_t>(max_resource_shapes_per_load_report_)) {
+    // Report the shapes with the most queued and backlogged requests, so that the
+    // largest demands are the ones the autoscaler sees.
+    // TODO (Alex): It's possible that we skip a different scheduling key which
+    // contains the same resources.
+    const auto end = loads.begin() + max_resource_shapes_per_load_report_;
+    std::nth_element(
+        loads.begin(), end, loads.end(), [](const auto &a, const auto &b) {
+          return a.count + a.backlog_size > b.count + b.backlog_size;
+        });
+    RAY_LOG(INFO) << "More than " << max_resource_shapes_per_load_report_
+                  << " scheduling classes. The resource loads of the "
+                  << loads.size() - max_resource_shapes_per_load_report_
+                  << " smallest ones are not reported to the autoscaler.";
+    loads.erase(end, loads.end());
+  }
 
-      // Backlog has already been set
-      if (visited.count(scheduling_class) == 0) {
-        by_shape_entry->set_backlog_size(TotalBacklogSize(scheduling_class));
-        visited.insert(scheduling_class);
+  auto resource_loads = data.mutable_resource_load();
+  auto resource_load_by_shape =
+      data.mutable_resource_load_by_shape()->mutable_resource_demands();
+  resource_load_by_shape->Reserve(loads.size());
+  for (const auto &load : loads) {
+    auto by_shape_entry = resource_load_by_shape->Add();
+    for (const auto &[label, quantity] : GetShape(load.scheduling_class)) {
+      if (load.count != 0) {
+        // Add to `resource_loads`.
+        (*resource_loads)[label] += quantity * load.count;
       }
+      // Add to `resource_load_by_shape`.
+      (*by_shape_entry->mutable_shape())[label] = quantity;
     }
-  };
 
-  auto transform_func = [](const auto &pair) {
-    return std::make_pair(pair.first, pair.second.size());
-  };
-
-  fill_resource_usage_helper(
-      tasks_to_schedule_ | boost::adaptors::transformed(transform_func), false);
-  fill_resource_usage_helper(
-      tasks_to_dispatch_ | boost::adaptors::transformed(transform_func), false);
-  fill_resource_usage_helper(
-      infeasible_tasks_ | boost::adaptors::transformed(transform_func), true);
-  auto backlog_tracker_range = backlog_tracker_ |
-                               boost::adaptors::transformed([](const auto &pair) {
-                                 return std::make_pair(pair.first, 0);
-                               }) |
-                               boost::adaptors::filtered([&visited](const auto &pair) {
-                                 return visited.count(pair.first) == 0;
-                               });
-
-  fill_resource_usage_helper(backlog_tracker_range, false);
-
-  if (skipped_requests > 0) {
-    RAY_LOG(INFO) << "More than " << max_resource_shapes_per_load_report_
-                  << " scheduling classes. Some resource loads may not be reported to "
-                     "the autoscaler.";
+    if (load.is_infeasible) {
+      by_shape_entry->set_num_infeasible_requests_queued(load.count);
+    } else {
+      by_shape_entry->set_num_ready_requests_queued(load.count);
+    }
+    by_shape_entry->set_backlog_size(load.backlog_size);
   }
 
   if (RayConfig::instance().enable_light_weight_resource_report()) {
@@ -57,6 +57,10 @@ class SchedulerResourceReporter {
  private:
   int64_t TotalBacklogSize(SchedulingClass scheduling_class) const;
 
+  /// Return the resources of a scheduling class, by name.
+  const absl::flat_hash_map<std::string, double> &GetShape(
+      SchedulingClass scheduling_class) const;
+
   const int64_t max_resource_shapes_per_load_report_;
   const absl::flat_hash_map<SchedulingClass, std::deque<std::shared_ptr<internal::Work>>>
       &tasks_to_schedule_;
@@ -69,6 +73,11 @@ class SchedulerResourceReporter {
 
   const absl::flat_hash_map<SchedulingClass, absl::flat_hash_map<WorkerID, int64_t>>
       &backlog_tracker_;
+
+  /// Cache of `GetShape`. A scheduling class always has the same resources, so this
+  /// saves building the map of resource names on every report.
+  mutable absl::flat_hash_map<SchedulingClass, absl::flat_hash_map<std::string, double>>
+      shapes_;
 };
 
 }  // namespace raylet
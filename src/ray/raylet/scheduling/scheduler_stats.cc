@@ -156,7 +156,7 @@ void SchedulerStats::RecordMetrics() const {
                                                           "WaitingForWorkers");
 }
 
-std::string SchedulerStats::ComputeAndReportDebugStr() {
+std::string SchedulerStats::ComputeAndReportDebugStr(bool full) {
   ComputeStats();
   if (num_tasks_to_schedule_ + num_tasks_to_dispatch_ + num_infeasible_tasks_ > 1000) {
     RAY_LOG(WARNING)
@@ -181,9 +181,17 @@ std::string SchedulerStats::ComputeAndReportDebugStr() {
          << num_worker_not_started_by_process_rate_limit_ << "\n";
   buffer << "num_tasks_waiting_for_workers: " << num_tasks_waiting_for_workers_ << "\n";
   buffer << "num_cancelled_tasks: " << num_cancelled_tasks_ << "\n";
-  buffer << "cluster_resource_scheduler state: "
-         << cluster_task_manager_.cluster_resource_scheduler_->DebugString() << "\n";
-  local_task_manager_.DebugStr(buffer);
+  buffer << "num_scheduling_decision_cache_hits: " << num_scheduling_decision_cache_hits_
+         << "\n";
+  auto &cluster_resource_scheduler = *cluster_task_manager_.cluster_resource_scheduler_;
+  if (full) {
+    buffer << "cluster_resource_scheduler state: "
+           << cluster_resource_scheduler.DebugString() << "\n";
+  } else {
+    buffer << "num cluster nodes: "
+           << cluster_resource_scheduler.GetClusterResourceManager().NumNodes() << "\n";
+  }
+  local_task_manager_.DebugStr(buffer, full);
 
   buffer << "==================================================\n";
   return buffer.str();
@@ -191,5 +199,9 @@ std::string SchedulerStats::ComputeAndReportDebugStr() {
 
 void SchedulerStats::TaskSpilled() { metric_tasks_spilled_++; }
 
+void SchedulerStats::SchedulingDecisionCacheHit() {
+  num_scheduling_decision_cache_hits_++;
+}
+
 }  // namespace raylet
 }  // namespace ray
@@ -34,12 +34,16 @@ class SchedulerStats {
   // Report metrics doesn't recompute the stats.
   void RecordMetrics() const;
 
-  // Recompute the stats and report the result as string.
-  std::string ComputeAndReportDebugStr();
+  // Recompute the stats and report the result as string. The resources of every node
+  // and worker are only listed if `full` is set.
+  std::string ComputeAndReportDebugStr(bool full);
 
   // increase the task spilled counter.
   void TaskSpilled();
 
+  // increase the counter of scheduling decisions reused from the per-class cache.
+  void SchedulingDecisionCacheHit();
+
  private:
   // recompute the metrics.
   void ComputeStats();
@@ -76,6 +80,9 @@ class SchedulerStats {
   int64_t num_tasks_to_schedule_ = 0;
   /// Number of tasks to dispatch.
   int64_t num_tasks_to_dispatch_ = 0;
+  /// Number of tasks whose scheduling decision was reused from a previous task of the
+  /// same scheduling class instead of running the scheduling policy.
+  int64_t num_scheduling_decision_cache_hits_ = 0;
 };
 
 }  // namespace raylet
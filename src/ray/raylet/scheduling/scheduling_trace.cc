@@ -0,0 +1,389 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/scheduling_trace.h"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+using raylet_scheduling_policy::SchedulingOptions;
+using raylet_scheduling_policy::SchedulingType;
+
+namespace {
+
+/// The first bytes of a trace file, which end with the version of the format.
+constexpr char kMagic[] = "RAYSCHT1";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+
+/// The number of decisions after which the buffered records are written to the file.
+constexpr uint64_t kDecisionsPerFlush = 1000;
+
+enum RecordType : uint8_t {
+  /// The index and name of a resource.
+  RESOURCE_NAME = 1,
+  /// The index and ID of a node.
+  NODE_NAME = 2,
+  /// The index of a node, whether it has pulls queued, and its total and available
+  /// resources.
+  NODE_UPDATE = 3,
+  /// The index of a node.
+  NODE_REMOVE = 4,
+  /// The resource view version, the options, the resource request and the index of
+  /// the selected node, or 0.
+  DECISION = 5,
+};
+
+/// The bits of the flags of a decision.
+enum DecisionFlag : uint8_t {
+  AVOID_LOCAL_NODE = 1 << 0,
+  REQUIRE_NODE_AVAILABLE = 1 << 1,
+  AVOID_GPU_NODES = 1 << 2,
+  NODE_AFFINITY_SOFT = 1 << 3,
+  REQUIRES_OBJECT_STORE_MEMORY = 1 << 4,
+};
+
+void WriteVarint(uint64_t value, std::string *out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void WriteDouble(double value, std::string *out) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out->append(bytes, sizeof(value));
+}
+
+void WriteString(const std::string &value, std::string *out) {
+  WriteVarint(value.size(), out);
+  out->append(value);
+}
+
+/// Reads the fields of the records of a trace. All the methods return false if the
+/// trace ends before the field.
+class Decoder {
+ public:
+  Decoder(const std::string &data, size_t offset) : data_(data), offset_(offset) {}
+
+  size_t Offset() const { return offset_; }
+
+  bool ReadByte(uint8_t *value) {
+    if (offset_ >= data_.size()) {
+      return false;
+    }
+    *value = static_cast<uint8_t>(data_[offset_++]);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte)) {
+        return false;
+      }
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadDouble(double *value) {
+    if (data_.size() - offset_ < sizeof(*value)) {
+      return false;
+    }
+    std::memcpy(value, data_.data() + offset_, sizeof(*value));
+    offset_ += sizeof(*value);
+    return true;
+  }
+
+  bool ReadString(std::string *value) {
+    uint64_t size;
+    if (!ReadVarint(&size) || data_.size() - offset_ < size) {
+      return false;
+    }
+    value->assign(data_, offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const std::string &data_;
+  size_t offset_;
+};
+
+}  // namespace
+
+std::unique_ptr<SchedulingTraceWriter> SchedulingTraceWriter::Open(
+    const std::string &path, scheduling::NodeID local_node_id) {
+  std::unique_ptr<SchedulingTraceWriter> writer(new SchedulingTraceWriter());
+  writer->file_.open(path, std::ios::binary | std::ios::trunc);
+  if (!writer->file_) {
+    RAY_LOG(WARNING) << "Failed to create the scheduling trace " << path;
+    return nullptr;
+  }
+  std::string header(kMagic, kMagicSize);
+  WriteString(local_node_id.IsNil() ? "" : local_node_id.Binary(), &header);
+  writer->file_.write(header.data(), header.size());
+  RAY_LOG(INFO) << "Recording the scheduling decisions to " << path;
+  return writer;
+}
+
+void SchedulingTraceWriter::RecordDecision(
+    const ClusterResourceManager &cluster_resource_manager,
+    const ResourceRequest &resource_request,
+    const SchedulingOptions &options,
+    scheduling::NodeID selected_node_id) {
+  const uint64_t version = cluster_resource_manager.GetResourceViewVersion();
+  if (version != last_resource_view_version_) {
+    WriteResourceViewChanges(cluster_resource_manager);
+    last_resource_view_version_ = version;
+  }
+
+  std::string record;
+  record.push_back(DECISION);
+  WriteVarint(version, &record);
+  record.push_back(static_cast<char>(options.scheduling_type));
+  WriteDouble(options.spread_threshold, &record);
+  uint8_t flags = 0;
+  flags |= options.avoid_local_node ? AVOID_LOCAL_NODE : 0;
+  flags |= options.require_node_available ? REQUIRE_NODE_AVAILABLE : 0;
+  flags |= options.avoid_gpu_nodes ? AVOID_GPU_NODES : 0;
+  flags |= options.node_affinity_soft ? NODE_AFFINITY_SOFT : 0;
+  flags |= resource_request.RequiresObjectStoreMemory() ? REQUIRES_OBJECT_STORE_MEMORY
+                                                        : 0;
+  record.push_back(static_cast<char>(flags));
+  WriteString(options.node_affinity_node_id, &record);
+  WriteString(options.node_group_resource_prefix, &record);
+  WriteResources(resource_request, &record);
+  WriteVarint(selected_node_id.IsNil() ? 0 : NodeIndex(selected_node_id), &record);
+  file_.write(record.data(), record.size());
+
+  if (++num_unflushed_decisions_ >= kDecisionsPerFlush) {
+    Flush();
+  }
+}
+
+void SchedulingTraceWriter::Flush() {
+  file_.flush();
+  num_unflushed_decisions_ = 0;
+}
+
+void SchedulingTraceWriter::WriteResourceViewChanges(
+    const ClusterResourceManager &cluster_resource_manager) {
+  const auto &nodes = cluster_resource_manager.GetResourceView();
+  for (const auto &entry : nodes) {
+    const auto &resources = entry.second.GetLocalView();
+    auto it = recorded_nodes_.find(entry.first);
+    if (it != recorded_nodes_.end() && it->second.total == resources.total &&
+        it->second.available == resources.available &&
+        it->second.object_pulls_queued == resources.object_pulls_queued) {
+      continue;
+    }
+    std::string record;
+    record.push_back(NODE_UPDATE);
+    WriteVarint(NodeIndex(entry.first), &record);
+    record.push_back(resources.object_pulls_queued ? 1 : 0);
+    WriteResources(resources.total, &record);
+    WriteResources(resources.available, &record);
+    file_.write(record.data(), record.size());
+    recorded_nodes_[entry.first] = resources;
+  }
+
+  for (auto it = recorded_nodes_.begin(); it != recorded_nodes_.end();) {
+    if (nodes.contains(it->first)) {
+      it++;
+      continue;
+    }
+    std::string record;
+    record.push_back(NODE_REMOVE);
+    WriteVarint(NodeIndex(it->first), &record);
+    file_.write(record.data(), record.size());
+    recorded_nodes_.erase(it++);
+  }
+}
+
+uint64_t SchedulingTraceWriter::NodeIndex(scheduling::NodeID node_id) {
+  auto it = node_indexes_.find(node_id);
+  if (it != node_indexes_.end()) {
+    return it->second;
+  }
+  const uint64_t index = node_indexes_.size() + 1;
+  node_indexes_.emplace(node_id, index);
+  std::string record;
+  record.push_back(NODE_NAME);
+  WriteVarint(index, &record);
+  WriteString(node_id.Binary(), &record);
+  file_.write(record.data(), record.size());
+  return index;
+}
+
+void SchedulingTraceWriter::WriteResources(const ResourceRequest &resources,
+                                           std::string *record) {
+  const auto resource_map = resources.ToResourceMap();
+  WriteVarint(resource_map.size(), record);
+  for (const auto &entry : resource_map) {
+    auto it = resource_indexes_.find(entry.first);
+    if (it == resource_indexes_.end()) {
+      const uint64_t index = resource_indexes_.size() + 1;
+      it = resource_indexes_.emplace(entry.first, index).first;
+      std::string name_record;
+      name_record.push_back(RESOURCE_NAME);
+      WriteVarint(index, &name_record);
+      WriteString(entry.first, &name_record);
+      file_.write(name_record.data(), name_record.size());
+    }
+    WriteVarint(it->second, record);
+    WriteDouble(entry.second, record);
+  }
+}
+
+std::unique_ptr<SchedulingTraceReader> SchedulingTraceReader::Open(
+    const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  std::unique_ptr<SchedulingTraceReader> reader(new SchedulingTraceReader());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  reader->data_ = buffer.str();
+  if (reader->data_.compare(0, kMagicSize, kMagic) != 0) {
+    return nullptr;
+  }
+  Decoder decoder(reader->data_, kMagicSize);
+  std::string local_node_id;
+  if (!decoder.ReadString(&local_node_id)) {
+    return nullptr;
+  }
+  if (!local_node_id.empty()) {
+    reader->local_node_id_ = scheduling::NodeID(local_node_id);
+  }
+  reader->offset_ = decoder.Offset();
+  return reader;
+}
+
+bool SchedulingTraceReader::Next(SchedulingTraceEvent *event) {
+  Decoder decoder(data_, offset_);
+  auto read_node = [this, &decoder](scheduling::NodeID *node_id) {
+    uint64_t index;
+    if (!decoder.ReadVarint(&index)) {
+      return false;
+    }
+    auto it = nodes_.find(index);
+    *node_id = it == nodes_.end() ? scheduling::NodeID::Nil() : it->second;
+    return true;
+  };
+  auto read_resources = [this, &decoder](absl::flat_hash_map<std::string, double> *map) {
+    uint64_t count;
+    if (!decoder.ReadVarint(&count)) {
+      return false;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+      uint64_t index;
+      double value;
+      if (!decoder.ReadVarint(&index) || !decoder.ReadDouble(&value)) {
+        return false;
+      }
+      (*map)[resources_[index]] = value;
+    }
+    return true;
+  };
+
+  while (true) {
+    uint8_t type;
+    if (!decoder.ReadByte(&type)) {
+      return false;
+    }
+    switch (type) {
+    case RESOURCE_NAME:
+    case NODE_NAME: {
+      uint64_t index;
+      std::string name;
+      if (!decoder.ReadVarint(&index) || !decoder.ReadString(&name)) {
+        return false;
+      }
+      if (type == RESOURCE_NAME) {
+        resources_[index] = std::move(name);
+      } else {
+        nodes_.emplace(index, scheduling::NodeID(name));
+      }
+      offset_ = decoder.Offset();
+      continue;
+    }
+    case NODE_UPDATE: {
+      uint8_t object_pulls_queued;
+      absl::flat_hash_map<std::string, double> total;
+      absl::flat_hash_map<std::string, double> available;
+      if (!read_node(&event->node_id) || !decoder.ReadByte(&object_pulls_queued) ||
+          !read_resources(&total) || !read_resources(&available)) {
+        return false;
+      }
+      event->type = SchedulingTraceEvent::Type::NODE_UPDATE;
+      event->node_resources = ResourceMapToNodeResources(total, available);
+      event->node_resources.object_pulls_queued = object_pulls_queued != 0;
+      break;
+    }
+    case NODE_REMOVE: {
+      if (!read_node(&event->node_id)) {
+        return false;
+      }
+      event->type = SchedulingTraceEvent::Type::NODE_REMOVE;
+      break;
+    }
+    case DECISION: {
+      uint8_t scheduling_type;
+      double spread_threshold;
+      uint8_t flags;
+      auto &options = event->options;
+      absl::flat_hash_map<std::string, double> resources;
+      if (!decoder.ReadVarint(&event->resource_view_version) ||
+          !decoder.ReadByte(&scheduling_type) ||
+          !decoder.ReadDouble(&spread_threshold) || !decoder.ReadByte(&flags) ||
+          !decoder.ReadString(&options.node_affinity_node_id) ||
+          !decoder.ReadString(&options.node_group_resource_prefix) ||
+          !read_resources(&resources) || !read_node(&event->selected_node_id)) {
+        return false;
+      }
+      event->type = SchedulingTraceEvent::Type::DECISION;
+      options.scheduling_type = static_cast<SchedulingType>(scheduling_type);
+      options.spread_threshold = spread_threshold;
+      options.avoid_local_node = flags & AVOID_LOCAL_NODE;
+      options.require_node_available = flags & REQUIRE_NODE_AVAILABLE;
+      options.avoid_gpu_nodes = flags & AVOID_GPU_NODES;
+      options.node_affinity_soft = flags & NODE_AFFINITY_SOFT;
+      event->resource_request = ResourceMapToResourceRequest(
+          resources, (flags & REQUIRES_OBJECT_STORE_MEMORY) != 0);
+      break;
+    }
+    default:
+      RAY_LOG(WARNING) << "Unknown record type " << static_cast<int>(type)
+                       << " in the scheduling trace at offset " << offset_;
+      return false;
+    }
+    offset_ = decoder.Offset();
+    return true;
+  }
+}
+
+}  // namespace ray
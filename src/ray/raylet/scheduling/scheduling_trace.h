@@ -0,0 +1,147 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/raylet/scheduling/cluster_resource_data.h"
+#include "ray/raylet/scheduling/cluster_resource_manager.h"
+#include "ray/raylet/scheduling/policy/scheduling_options.h"
+#include "ray/raylet/scheduling/scheduling_ids.h"
+
+namespace ray {
+
+/// An event of a scheduling trace.
+struct SchedulingTraceEvent {
+  enum class Type {
+    /// A node was added to the resource view or its resources changed.
+    NODE_UPDATE,
+    /// A node was removed from the resource view.
+    NODE_REMOVE,
+    /// The scheduling policy picked a node for a resource request.
+    DECISION,
+  };
+  Type type = Type::DECISION;
+  /// The node of a NODE_UPDATE or NODE_REMOVE event.
+  scheduling::NodeID node_id = scheduling::NodeID::Nil();
+  /// The resources of the node of a NODE_UPDATE event.
+  NodeResources node_resources;
+  /// The version of the resource view that a DECISION was made with.
+  uint64_t resource_view_version = 0;
+  /// The request and options of a DECISION.
+  ResourceRequest resource_request;
+  raylet_scheduling_policy::SchedulingOptions options =
+      raylet_scheduling_policy::SchedulingOptions::Random();
+  /// The node picked by a DECISION, or nil if no node could be picked.
+  scheduling::NodeID selected_node_id = scheduling::NodeID::Nil();
+};
+
+/// \class SchedulingTraceWriter
+/// Records the scheduling decisions of a `ClusterResourceScheduler` into a compact
+/// binary trace, so that the scheduling policies can be tuned offline by replaying
+/// the trace with the `scheduler_replay` benchmark.
+///
+/// Every decision is recorded with its resource request and scheduling options, the
+/// node that was picked, and the version of the resource view it was made with. The
+/// resource view itself is recorded incrementally: before a decision made with a new
+/// version, only the nodes whose resources changed since the last decision are
+/// written. Node IDs and resource names are written once and then referred to by
+/// index.
+///
+/// This class is not thread safe.
+class SchedulingTraceWriter {
+ public:
+  /// Create a trace file.
+  ///
+  /// \param path The path of the trace file, which is overwritten if it exists.
+  /// \param local_node_id The node that the decisions are made on.
+  /// \return The writer, or nullptr if the file can't be created.
+  static std::unique_ptr<SchedulingTraceWriter> Open(const std::string &path,
+                                                     scheduling::NodeID local_node_id);
+
+  /// Record a scheduling decision.
+  ///
+  /// \param cluster_resource_manager The resource view the decision was made with.
+  /// \param resource_request The request that was scheduled.
+  /// \param options The options it was scheduled with.
+  /// \param selected_node_id The node that was picked, or nil.
+  void RecordDecision(const ClusterResourceManager &cluster_resource_manager,
+                      const ResourceRequest &resource_request,
+                      const raylet_scheduling_policy::SchedulingOptions &options,
+                      scheduling::NodeID selected_node_id);
+
+  /// Write the buffered records to the file.
+  void Flush();
+
+ private:
+  SchedulingTraceWriter() = default;
+
+  /// Write the nodes of the resource view that changed since the last decision.
+  void WriteResourceViewChanges(const ClusterResourceManager &cluster_resource_manager);
+
+  /// Return the index of a node in the trace, and write its ID first if it's new.
+  uint64_t NodeIndex(scheduling::NodeID node_id);
+
+  /// Write the resources of a request, writing the names of new resources first.
+  void WriteResources(const ResourceRequest &resources, std::string *record);
+
+  std::ofstream file_;
+  /// The version of the resource view of the last decision.
+  uint64_t last_resource_view_version_ = UINT64_MAX;
+  /// The resources of each node as of the last recorded decision.
+  absl::flat_hash_map<scheduling::NodeID, NodeResources> recorded_nodes_;
+  /// The indexes of the nodes and resources in the trace, from 1.
+  absl::flat_hash_map<scheduling::NodeID, uint64_t> node_indexes_;
+  absl::flat_hash_map<std::string, uint64_t> resource_indexes_;
+  /// The number of decisions since the file was last flushed.
+  uint64_t num_unflushed_decisions_ = 0;
+};
+
+/// \class SchedulingTraceReader
+/// Reads the events of a trace written by `SchedulingTraceWriter`.
+class SchedulingTraceReader {
+ public:
+  /// Read a trace file.
+  ///
+  /// \param path The path of the trace file.
+  /// \return The reader, or nullptr if the file can't be read or isn't a trace.
+  static std::unique_ptr<SchedulingTraceReader> Open(const std::string &path);
+
+  /// The node that the decisions were made on.
+  scheduling::NodeID LocalNodeId() const { return local_node_id_; }
+
+  /// Read the next event.
+  ///
+  /// \param[out] event The event.
+  /// \return False at the end of the trace. A trace that ends in a partially written
+  /// record, e.g. because the process was killed, ends before that record.
+  bool Next(SchedulingTraceEvent *event);
+
+ private:
+  SchedulingTraceReader() = default;
+
+  std::string data_;
+  size_t offset_ = 0;
+  scheduling::NodeID local_node_id_ = scheduling::NodeID::Nil();
+  /// The nodes and resources of the trace by index, from 1.
+  absl::flat_hash_map<uint64_t, scheduling::NodeID> nodes_;
+  absl::flat_hash_map<uint64_t, std::string> resources_;
+};
+
+}  // namespace ray
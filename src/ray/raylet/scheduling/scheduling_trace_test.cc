@@ -0,0 +1,144 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/scheduling_trace.h"
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "ray/common/id.h"
+#include "ray/util/filesystem.h"
+
+namespace ray {
+
+using raylet_scheduling_policy::SchedulingOptions;
+using raylet_scheduling_policy::SchedulingType;
+
+class SchedulingTraceTest : public ::testing::Test {
+ public:
+  SchedulingTraceTest()
+      : path_(JoinPaths(GetUserTempDir(),
+                        "scheduling_trace_test_" + UniqueID::FromRandom().Hex())) {}
+
+  ~SchedulingTraceTest() { std::filesystem::remove(path_); }
+
+ protected:
+  const std::string path_;
+};
+
+TEST_F(SchedulingTraceTest, TestRoundTrip) {
+  const scheduling::NodeID node1("node1");
+  const scheduling::NodeID node2("node2");
+  ClusterResourceManager cluster_resource_manager;
+  cluster_resource_manager.AddOrUpdateNode(
+      node1, {{"CPU", 4}, {"custom", 1}}, {{"CPU", 2}, {"custom", 1}});
+  cluster_resource_manager.AddOrUpdateNode(node2, {{"CPU", 8}}, {{"CPU", 8}});
+  const auto request =
+      ResourceMapToResourceRequest({{"CPU", 1}, {"custom", 0.5}},
+                                   /*requires_object_store_memory=*/true);
+  const auto affinity = SchedulingOptions::NodeAffinity(
+      /*avoid_local_node=*/true, /*require_node_available=*/false, "node2", true);
+
+  auto writer = SchedulingTraceWriter::Open(path_, node1);
+  ASSERT_NE(writer, nullptr);
+  writer->RecordDecision(
+      cluster_resource_manager, request, SchedulingOptions::Random(), node1);
+  // Decisions with the same resource view don't record the nodes again.
+  writer->RecordDecision(cluster_resource_manager, request, affinity, node1);
+  cluster_resource_manager.RemoveNode(node1);
+  cluster_resource_manager.AddOrUpdateNode(node2, {{"CPU", 8}}, {{"CPU", 4}});
+  writer->RecordDecision(
+      cluster_resource_manager, request, affinity, scheduling::NodeID::Nil());
+  writer->Flush();
+
+  auto reader = SchedulingTraceReader::Open(path_);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(reader->LocalNodeId(), node1);
+  std::vector<SchedulingTraceEvent> events;
+  SchedulingTraceEvent event;
+  while (reader->Next(&event)) {
+    events.push_back(event);
+  }
+  ASSERT_EQ(events.size(), 7);
+
+  // The nodes are recorded in any order before the first decision.
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(events[i].type, SchedulingTraceEvent::Type::NODE_UPDATE);
+    const auto &expected = events[i].node_id == node1
+                               ? ResourceMapToNodeResources({{"CPU", 4}, {"custom", 1}},
+                                                            {{"CPU", 2}, {"custom", 1}})
+                               : ResourceMapToNodeResources({{"CPU", 8}}, {{"CPU", 8}});
+    ASSERT_EQ(events[i].node_resources.total, expected.total);
+    ASSERT_EQ(events[i].node_resources.available, expected.available);
+  }
+  ASSERT_NE(events[0].node_id, events[1].node_id);
+
+  ASSERT_EQ(events[2].type, SchedulingTraceEvent::Type::DECISION);
+  ASSERT_EQ(events[2].options.scheduling_type, SchedulingType::RANDOM);
+  ASSERT_EQ(events[2].resource_request, request);
+  ASSERT_TRUE(events[2].resource_request.RequiresObjectStoreMemory());
+  ASSERT_EQ(events[2].selected_node_id, node1);
+
+  ASSERT_EQ(events[3].type, SchedulingTraceEvent::Type::DECISION);
+  ASSERT_EQ(events[3].resource_view_version, events[2].resource_view_version);
+  ASSERT_EQ(events[3].options.scheduling_type, SchedulingType::NODE_AFFINITY);
+  ASSERT_TRUE(events[3].options.avoid_local_node);
+  ASSERT_FALSE(events[3].options.require_node_available);
+  ASSERT_EQ(events[3].options.node_affinity_node_id, "node2");
+  ASSERT_TRUE(events[3].options.node_affinity_soft);
+  ASSERT_EQ(events[3].options.spread_threshold, affinity.spread_threshold);
+
+  // Only the changes to the resource view are recorded before the next decision.
+  ASSERT_EQ(events[4].type, SchedulingTraceEvent::Type::NODE_UPDATE);
+  ASSERT_EQ(events[4].node_id, node2);
+  ASSERT_EQ(events[4].node_resources.available,
+            ResourceMapToResourceRequest({{"CPU", 4}}, false));
+  ASSERT_EQ(events[5].type, SchedulingTraceEvent::Type::NODE_REMOVE);
+  ASSERT_EQ(events[5].node_id, node1);
+  ASSERT_EQ(events[6].type, SchedulingTraceEvent::Type::DECISION);
+  ASSERT_GT(events[6].resource_view_version, events[3].resource_view_version);
+  ASSERT_TRUE(events[6].selected_node_id.IsNil());
+}
+
+TEST_F(SchedulingTraceTest, TestTruncatedTrace) {
+  ClusterResourceManager cluster_resource_manager;
+  cluster_resource_manager.AddOrUpdateNode(
+      scheduling::NodeID("node1"), {{"CPU", 4}}, {{"CPU", 4}});
+  auto writer = SchedulingTraceWriter::Open(path_, scheduling::NodeID::Nil());
+  ASSERT_NE(writer, nullptr);
+  const auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  writer->RecordDecision(cluster_resource_manager,
+                         request,
+                         SchedulingOptions::Random(),
+                         scheduling::NodeID::Nil());
+  writer->RecordDecision(cluster_resource_manager,
+                         request,
+                         SchedulingOptions::Random(),
+                         scheduling::NodeID::Nil());
+  writer.reset();
+
+  // A trace cut in the middle of the last record ends before it.
+  std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - 2);
+  auto reader = SchedulingTraceReader::Open(path_);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_TRUE(reader->LocalNodeId().IsNil());
+  SchedulingTraceEvent event;
+  ASSERT_TRUE(reader->Next(&event));
+  ASSERT_EQ(event.type, SchedulingTraceEvent::Type::NODE_UPDATE);
+  ASSERT_TRUE(reader->Next(&event));
+  ASSERT_EQ(event.type, SchedulingTraceEvent::Type::DECISION);
+  ASSERT_FALSE(reader->Next(&event));
+}
+
+}  // namespace ray
@@ -116,6 +116,9 @@ class MockWorkerClient : public rpc::CoreWorkerClientInterface {
       ASSERT_TRUE(object_location_update.has_spilled_location_update());
       object_urls.emplace(ObjectID::FromBinary(object_location_update.object_id()),
                           object_location_update.spilled_location_update().spilled_url());
+      const auto object_id = ObjectID::FromBinary(object_location_update.object_id());
+      spilled_to_local_storage[object_id] =
+          object_location_update.spilled_location_update().spilled_to_local_storage();
     }
     update_object_location_batch_callbacks.push_back(callback);
   }
@@ -132,6 +135,7 @@ class MockWorkerClient : public rpc::CoreWorkerClientInterface {
   }
 
   absl::flat_hash_map<ObjectID, std::string> object_urls;
+  absl::flat_hash_map<ObjectID, bool> spilled_to_local_storage;
   std::deque<rpc::ClientCallback<rpc::UpdateObjectLocationBatchReply>>
       update_object_location_batch_callbacks;
 };
@@ -298,7 +302,8 @@ class MockObjectBuffer : public Buffer {
 class LocalObjectManagerTestWithMinSpillingSize {
  public:
   LocalObjectManagerTestWithMinSpillingSize(int64_t min_spilling_size,
-                                            int64_t max_fused_object_count)
+                                            int64_t max_fused_object_count,
+                                            bool spill_by_demand = false)
       : subscriber_(std::make_shared<MockSubscriber>()),
         owner_client(std::make_shared<MockWorkerClient>()),
         client_pool([&](const rpc::Address &addr) { return owner_client; }),
@@ -335,7 +340,16 @@ class LocalObjectManagerTestWithMinSpillingSize {
               return unevictable_objects_.count(object_id) == 0;
             },
             /*core_worker_subscriber=*/subscriber_.get(),
-            object_directory_.get()),
+            object_directory_.get(),
+            /*native_spiller=*/nullptr,
+            /*restore_spilled_object_natively=*/nullptr,
+            /*get_object_demand=*/
+            spill_by_demand ? std::function<int64_t(const ray::ObjectID &)>(
+                                  [this](const ray::ObjectID &object_id) -> int64_t {
+                                    auto it = object_demand_.find(object_id);
+                                    return it == object_demand_.end() ? 0 : it->second;
+                                  })
+                            : nullptr),
         unpins(std::make_shared<absl::flat_hash_map<ObjectID, int>>()) {
     RayConfig::instance().initialize(R"({"object_spilling_config": "dummy"})");
   }
@@ -368,6 +382,8 @@ class LocalObjectManagerTestWithMinSpillingSize {
   size_t max_fused_object_count_;
   std::shared_ptr<gcs::GcsClient> gcs_client_;
   std::unique_ptr<IObjectDirectory> object_directory_;
+  // The demand of the objects, if they are spilled by demand.
+  absl::flat_hash_map<ObjectID, int64_t> object_demand_;
   LocalObjectManager manager;
 
   std::unordered_set<ObjectID> freed;
@@ -384,6 +400,13 @@ class LocalObjectManagerTest : public LocalObjectManagerTestWithMinSpillingSize,
   LocalObjectManagerTest() : LocalObjectManagerTestWithMinSpillingSize(0, 1) {}
 };
 
+class LocalObjectManagerDemandTest : public LocalObjectManagerTestWithMinSpillingSize,
+                                     public ::testing::Test {
+ public:
+  LocalObjectManagerDemandTest()
+      : LocalObjectManagerTestWithMinSpillingSize(0, 1, /*spill_by_demand=*/true) {}
+};
+
 class LocalObjectManagerFusedTest : public LocalObjectManagerTestWithMinSpillingSize,
                                     public ::testing::Test {
  public:
@@ -608,6 +631,36 @@ TEST_F(LocalObjectManagerTest, TestSpillObjectsOfSizeZero) {
   ASSERT_FALSE(worker_pool.FlushPopSpillWorkerCallbacks());
 }
 
+TEST_F(LocalObjectManagerTest, TestSpillToSharedFilesystem) {
+  rpc::Address owner_address;
+  owner_address.set_worker_id(WorkerID::FromRandom().Binary());
+
+  for (bool shared_filesystem : {false, true}) {
+    RayConfig::instance().initialize(
+        std::string(R"({"object_spilling_config": "dummy", )") +
+        R"("object_spilling_shared_filesystem": )" +
+        (shared_filesystem ? "true}" : "false}"));
+    ObjectID object_id = ObjectID::FromRandom();
+    auto data_buffer = std::make_shared<MockObjectBuffer>(1000, object_id, unpins);
+    std::vector<std::unique_ptr<RayObject>> objects;
+    objects.push_back(std::make_unique<RayObject>(
+        data_buffer, nullptr, std::vector<rpc::ObjectReference>()));
+    manager.PinObjectsAndWaitForFree({object_id}, std::move(objects), owner_address);
+    manager.SpillObjects({object_id},
+                         [&](const Status &status) { ASSERT_TRUE(status.ok()); });
+    ASSERT_TRUE(worker_pool.FlushPopSpillWorkerCallbacks());
+    EXPECT_CALL(worker_pool, PushSpillWorker(_));
+    ASSERT_TRUE(worker_pool.io_worker_client->ReplySpillObjects({BuildURL("url")}));
+    ASSERT_TRUE(owner_client->ReplyUpdateObjectLocationBatch());
+    // Objects spilled to a shared file system are reported like those spilled to cloud
+    // storage, so that other nodes restore them directly.
+    ASSERT_EQ(owner_client->spilled_to_local_storage[object_id], !shared_filesystem);
+  }
+  RayConfig::instance().initialize(
+      R"({"object_spilling_config": "dummy",
+          "object_spilling_shared_filesystem": false})");
+}
+
 TEST_F(LocalObjectManagerTest, TestSpillUptoMaxFuseCount) {
   ///
   /// Test objects are only fused up to max_fused_object_count.
@@ -657,6 +710,38 @@ TEST_F(LocalObjectManagerTest, TestSpillUptoMaxFuseCount) {
   }
 }
 
+TEST_F(LocalObjectManagerDemandTest, TestSpillByDemand) {
+  rpc::Address owner_address;
+  owner_address.set_worker_id(WorkerID::FromRandom().Binary());
+
+  std::vector<ObjectID> object_ids;
+  std::vector<std::unique_ptr<RayObject>> objects;
+  for (int i = 0; i < 3; i++) {
+    ObjectID object_id = ObjectID::FromRandom();
+    object_ids.push_back(object_id);
+    auto data_buffer = std::make_shared<MockObjectBuffer>(1000, object_id, unpins);
+    objects.push_back(std::make_unique<RayObject>(
+        data_buffer, nullptr, std::vector<rpc::ObjectReference>()));
+  }
+  // Only the last object isn't waited on.
+  object_demand_[object_ids[0]] = 2;
+  object_demand_[object_ids[1]] = 1;
+  manager.PinObjectsAndWaitForFree(object_ids, std::move(objects), owner_address);
+
+  // One object is spilled at a time, the one with the least demand first.
+  for (int i = 2; i >= 0; i--) {
+    ASSERT_TRUE(manager.SpillObjectsOfSize(1000));
+    ASSERT_TRUE(worker_pool.FlushPopSpillWorkerCallbacks());
+    EXPECT_CALL(worker_pool, PushSpillWorker(_));
+    ASSERT_TRUE(worker_pool.io_worker_client->ReplySpillObjects({BuildURL("url")}));
+    ASSERT_TRUE(owner_client->ReplyUpdateObjectLocationBatch());
+    ASSERT_EQ((*unpins)[object_ids[i]], 1);
+    for (int j = 0; j < i; j++) {
+      ASSERT_EQ((*unpins)[object_ids[j]], 0);
+    }
+  }
+}
+
 TEST_F(LocalObjectManagerTest, TestSpillObjectNotEvictable) {
   rpc::Address owner_address;
   owner_address.set_worker_id(WorkerID::FromRandom().Binary());
@@ -0,0 +1,158 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/native_object_spiller.h"
+
+#include <filesystem>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ray/object_manager/spilled_object_reader.h"
+#include "ray/util/filesystem.h"
+
+namespace ray {
+
+namespace raylet {
+
+class NativeObjectSpillerTest : public ::testing::TestWithParam<bool> {
+ protected:
+  NativeObjectSpillerTest()
+      : work_(io_service_),
+        directory_(JoinPaths(GetUserTempDir(),
+                             "native_spiller_test_" + UniqueID::FromRandom().Hex())),
+        spiller_(io_service_, directory_, /*num_threads=*/2, /*direct_io=*/GetParam()) {}
+
+  ~NativeObjectSpillerTest() { std::filesystem::remove_all(directory_); }
+
+  /// Add an object to spill, with the given data and metadata.
+  void AddObject(const std::string &data, const std::string &metadata) {
+    std::shared_ptr<Buffer> data_buffer;
+    std::shared_ptr<Buffer> metadata_buffer;
+    if (!data.empty()) {
+      data_buffer = std::make_shared<LocalMemoryBuffer>(
+          reinterpret_cast<uint8_t *>(const_cast<char *>(data.data())),
+          data.size(),
+          /*copy_data=*/true);
+    }
+    if (!metadata.empty()) {
+      metadata_buffer = std::make_shared<LocalMemoryBuffer>(
+          reinterpret_cast<uint8_t *>(const_cast<char *>(metadata.data())),
+          metadata.size(),
+          /*copy_data=*/true);
+    }
+    objects_.push_back(std::make_unique<RayObject>(
+        data_buffer, metadata_buffer, std::vector<rpc::ObjectReference>()));
+    rpc::Address owner_address;
+    owner_address.set_ip_address("127.0.0.1");
+    owner_address.set_port(static_cast<int32_t>(objects_to_spill_.size()));
+    objects_to_spill_.push_back(
+        {ObjectID::FromRandom(), owner_address, objects_.back().get()});
+    data_.push_back(data);
+    metadata_.push_back(metadata);
+  }
+
+  /// Check that the objects can be read back from their spilled URLs.
+  void AssertSpilled(const std::vector<std::string> &object_urls) {
+    ASSERT_EQ(object_urls.size(), objects_to_spill_.size());
+    const auto path = object_urls[0].substr(0, object_urls[0].find('?'));
+    for (size_t i = 0; i < object_urls.size(); i++) {
+      // The objects are fused into one file.
+      ASSERT_EQ(object_urls[i].substr(0, object_urls[i].find('?')), path);
+      auto reader = SpilledObjectReader::CreateSpilledObjectReader(object_urls[i]);
+      ASSERT_TRUE(reader.has_value()) << object_urls[i];
+      ASSERT_EQ(reader->GetOwnerAddress().port(), static_cast<int32_t>(i));
+      ASSERT_EQ(reader->GetDataSize(), data_[i].size());
+      ASSERT_EQ(reader->GetMetadataSize(), metadata_[i].size());
+      std::string data(data_[i].size(), '\0');
+      std::string metadata(metadata_[i].size(), '\0');
+      ASSERT_TRUE(reader->ReadFromDataSection(0, data.size(), &data[0]));
+      ASSERT_TRUE(reader->ReadFromMetadataSection(0, metadata.size(), &metadata[0]));
+      ASSERT_EQ(data, data_[i]);
+      ASSERT_EQ(metadata, metadata_[i]);
+    }
+    // The file ends with the last object, without any padding.
+    const auto &last_url = object_urls.back();
+    const auto offset_pos = last_url.find("?offset=") + strlen("?offset=");
+    const auto size_pos = last_url.find("&size=") + strlen("&size=");
+    ASSERT_EQ(std::filesystem::file_size(path),
+              std::stoull(last_url.substr(offset_pos)) +
+                  std::stoull(last_url.substr(size_pos)));
+  }
+
+  instrumented_io_context io_service_;
+  boost::asio::io_service::work work_;
+  const std::string directory_;
+  NativeObjectSpiller spiller_;
+  std::vector<std::unique_ptr<RayObject>> objects_;
+  std::vector<NativeObjectSpiller::ObjectToSpill> objects_to_spill_;
+  std::vector<std::string> data_;
+  std::vector<std::string> metadata_;
+};
+
+TEST_P(NativeObjectSpillerTest, TestWriteFusedFile) {
+  AddObject("data", "metadata");
+  AddObject("", "metadata only");
+  // Larger than the write buffer.
+  AddObject(std::string(5 * 1024 * 1024 + 3, 'x'), "");
+  AddObject("last", "");
+
+  std::vector<std::string> object_urls;
+  const auto path = JoinPaths(directory_, "fused");
+  ASSERT_TRUE(NativeObjectSpiller::WriteFusedFile(
+                  path, objects_to_spill_, /*direct_io=*/GetParam(), &object_urls)
+                  .ok());
+  AssertSpilled(object_urls);
+}
+
+TEST_P(NativeObjectSpillerTest, TestSpillAndDelete) {
+  for (int i = 0; i < 3; i++) {
+    AddObject("data" + std::to_string(i), "metadata");
+  }
+
+  bool spilled = false;
+  std::vector<std::string> object_urls;
+  spiller_.SpillObjects(objects_to_spill_,
+                        [&](const Status &status, std::vector<std::string> urls) {
+                          ASSERT_TRUE(status.ok()) << status.ToString();
+                          object_urls = std::move(urls);
+                          spilled = true;
+                        });
+  while (!spilled) {
+    io_service_.run_one();
+  }
+  AssertSpilled(object_urls);
+
+  const auto path = object_urls[0].substr(0, object_urls[0].find('?'));
+  spiller_.DeleteSpilledObjects({object_urls[0]});
+  for (int i = 0; i < 1000 && std::filesystem::exists(path); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_P(NativeObjectSpillerTest, TestWriteFailure) {
+  AddObject("data", "metadata");
+  std::vector<std::string> object_urls;
+  const auto path = JoinPaths(directory_, "no_such_directory", "fused");
+  ASSERT_TRUE(NativeObjectSpiller::WriteFusedFile(
+                  path, objects_to_spill_, /*direct_io=*/GetParam(), &object_urls)
+                  .IsIOError());
+  ASSERT_TRUE(object_urls.empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(DirectIO, NativeObjectSpillerTest, testing::Values(false, true));
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -34,9 +34,16 @@ class MockWorker : public WorkerInterface {
 
   void SetOwnerAddress(const rpc::Address &address) { address_ = address; }
 
-  void AssignTaskId(const TaskID &task_id) {}
+  void AssignTaskId(const TaskID &task_id) { task_id_ = task_id; }
 
-  void SetAssignedTask(const RayTask &assigned_task) { task_ = assigned_task; }
+  void SetAssignedTask(const RayTask &assigned_task) {
+    task_ = assigned_task;
+    assigned_task_time_ms_ = current_time_ms();
+  }
+
+  int64_t GetAssignedTaskTime() const { return assigned_task_time_ms_; }
+
+  void SetAssignedTaskTime(int64_t time_ms) { assigned_task_time_ms_ = time_ms; }
 
   const std::string IpAddress() const { return address_.ip_address(); }
 
@@ -57,11 +64,8 @@ class MockWorker : public WorkerInterface {
     return lifetime_allocated_instances_;
   }
 
-  void MarkDead() { RAY_CHECK(false) << "Method unused"; }
-  bool IsDead() const {
-    RAY_CHECK(false) << "Method unused";
-    return false;
-  }
+  void MarkDead() { dead_ = true; }
+  bool IsDead() const { return dead_; }
   void MarkBlocked() { blocked_ = true; }
   void MarkUnblocked() { blocked_ = false; }
   bool IsBlocked() const { return blocked_; }
@@ -86,10 +90,7 @@ class MockWorker : public WorkerInterface {
     return -1;
   }
   void SetAssignedPort(int port) { RAY_CHECK(false) << "Method unused"; }
-  const TaskID &GetAssignedTaskId() const {
-    RAY_CHECK(false) << "Method unused";
-    return TaskID::Nil();
-  }
+  const TaskID &GetAssignedTaskId() const { return task_id_; }
   bool AddBlockedTaskId(const TaskID &task_id) {
     RAY_CHECK(false) << "Method unused";
     return false;
@@ -171,7 +172,10 @@ class MockWorker : public WorkerInterface {
   bool is_detached_actor_;
   BundleID bundle_id_;
   bool blocked_ = false;
+  bool dead_ = false;
   RayTask task_;
+  TaskID task_id_;
+  int64_t assigned_task_time_ms_ = 0;
   int runtime_env_hash_;
 };
 
@@ -28,25 +28,37 @@ void WaitManager::Wait(const std::vector<ObjectID> &object_ids,
   RAY_CHECK_LE(num_required_objects, object_ids.size());
 
   const uint64_t wait_id = next_wait_id_++;
-  wait_requests_.emplace(
-      wait_id, WaitRequest(timeout_ms, callback, object_ids, num_required_objects));
+  auto &wait_request =
+      wait_requests_
+          .emplace(wait_id,
+                   WaitRequest(timeout_ms, callback, object_ids, num_required_objects))
+          .first->second;
 
-  auto &wait_request = wait_requests_.at(wait_id);
+  // Only the first local objects, in input order, are returned as ready, so stop
+  // checking once there are enough of them.
   for (const auto &object_id : object_ids) {
+    if (wait_request.ready.size() >= num_required_objects) {
+      break;
+    }
     if (is_object_local_(object_id)) {
       wait_request.ready.emplace(object_id);
     }
   }
 
-  for (const auto &object_id : wait_request.object_ids) {
-    object_to_wait_requests_[object_id].emplace(wait_id);
-  }
-
   if (wait_request.ready.size() >= wait_request.num_required_objects ||
       wait_request.timeout_ms == 0) {
     // Requirements already satisfied.
     WaitComplete(wait_id);
-  } else if (wait_request.timeout_ms != -1) {
+    return;
+  }
+
+  for (const auto &object_id : wait_request.object_ids) {
+    if (!wait_request.ready.contains(object_id)) {
+      object_to_wait_requests_[object_id].emplace(wait_id);
+    }
+  }
+
+  if (wait_request.timeout_ms != -1) {
     // If a timeout was provided, then set a timer. If there are no
     // enough locally available objects by the time the timer expires,
     // then we will return from the Wait.
@@ -67,10 +79,16 @@ void WaitManager::WaitComplete(uint64_t wait_id) {
   auto &wait_request = map_find_or_die(wait_requests_, wait_id);
 
   for (const auto &object_id : wait_request.object_ids) {
-    auto &requests = object_to_wait_requests_.at(object_id);
-    requests.erase(wait_id);
-    if (requests.empty()) {
-      object_to_wait_requests_.erase(object_id);
+    if (wait_request.ready.contains(object_id)) {
+      continue;
+    }
+    auto it = object_to_wait_requests_.find(object_id);
+    if (it == object_to_wait_requests_.end()) {
+      continue;
+    }
+    it->second.erase(wait_id);
+    if (it->second.empty()) {
+      object_to_wait_requests_.erase(it);
     }
   }
 
@@ -79,7 +97,7 @@ void WaitManager::WaitComplete(uint64_t wait_id) {
   std::vector<ObjectID> remaining;
   for (const auto &object_id : wait_request.object_ids) {
     if (ready.size() < wait_request.num_required_objects &&
-        wait_request.ready.count(object_id) > 0) {
+        wait_request.ready.contains(object_id)) {
       ready.push_back(object_id);
     } else {
       remaining.push_back(object_id);
@@ -92,12 +110,16 @@ void WaitManager::WaitComplete(uint64_t wait_id) {
 }
 
 void WaitManager::HandleObjectLocal(const ray::ObjectID &object_id) {
-  if (object_to_wait_requests_.find(object_id) == object_to_wait_requests_.end()) {
+  auto it = object_to_wait_requests_.find(object_id);
+  if (it == object_to_wait_requests_.end()) {
     return;
   }
+  // The object is now ready for all the requests waiting on it.
+  const auto wait_ids = std::move(it->second);
+  object_to_wait_requests_.erase(it);
 
   std::vector<uint64_t> complete_waits;
-  for (const auto &wait_id : object_to_wait_requests_.at(object_id)) {
+  for (const auto &wait_id : wait_ids) {
     auto &wait_request = map_find_or_die(wait_requests_, wait_id);
     wait_request.ready.emplace(object_id);
     if (wait_request.ready.size() >= wait_request.num_required_objects) {
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "ray/common/id.h"
 
 namespace ray {
@@ -73,8 +75,9 @@ class WaitManager {
     const std::vector<ObjectID> object_ids;
     /// The number of required objects.
     const uint64_t num_required_objects;
-    /// The objects that have been locally available.
-    std::unordered_set<ObjectID> ready;
+    /// The objects that have been locally available. The request waits on the
+    /// other objects only.
+    absl::flat_hash_set<ObjectID> ready;
   };
 
   /// Completion handler for Wait.
@@ -93,8 +96,9 @@ class WaitManager {
   /// A set of active wait requests.
   std::unordered_map<uint64_t, WaitRequest> wait_requests_;
 
-  /// Map from object to wait requests that are waiting for this object.
-  std::unordered_map<ObjectID, std::unordered_set<uint64_t>> object_to_wait_requests_;
+  /// Map from object to wait requests that are waiting for this object. An object is
+  /// dropped from here as soon as it's local, since it's then ready for all of them.
+  absl::flat_hash_map<ObjectID, absl::flat_hash_set<uint64_t>> object_to_wait_requests_;
 
   uint64_t next_wait_id_;
 
@@ -24,6 +24,7 @@ class WaitManagerTest : public ::testing::Test {
   WaitManagerTest()
       : wait_manager(
             [this](const ObjectID &object_id) {
+              num_local_checks++;
               return local_objects.count(object_id) > 0;
             },
             [this](std::function<void()> fn, int64_t ms) {
@@ -37,6 +38,7 @@ class WaitManagerTest : public ::testing::Test {
   }
 
   std::unordered_set<ObjectID> local_objects;
+  int num_local_checks = 0;
   std::function<void()> delay_fn;
   int64_t delay_ms = -1;
   WaitManager wait_manager;
@@ -136,6 +138,45 @@ TEST_F(WaitManagerTest, TestWaitTimeout) {
   AssertNoLeaks();
 }
 
+TEST_F(WaitManagerTest, TestWaitPartlyLocal) {
+  ObjectID obj1 = ObjectID::FromRandom();
+  ObjectID obj2 = ObjectID::FromRandom();
+  ObjectID obj3 = ObjectID::FromRandom();
+  local_objects.emplace(obj1);
+  std::vector<ObjectID> ready;
+  std::vector<ObjectID> remaining;
+  wait_manager.Wait(std::vector<ObjectID>{obj1, obj2, obj3},
+                    -1,
+                    2,
+                    [&](std::vector<ObjectID> _ready, std::vector<ObjectID> _remaining) {
+                      ready = _ready;
+                      remaining = _remaining;
+                    });
+  ASSERT_TRUE(ready.empty());
+  // The local object isn't waited on.
+  ASSERT_EQ(wait_manager.object_to_wait_requests_.size(), 2);
+
+  wait_manager.HandleObjectLocal(obj3);
+  ASSERT_EQ(ready, (std::vector<ObjectID>{obj1, obj3}));
+  ASSERT_EQ(remaining, std::vector<ObjectID>{obj2});
+  AssertNoLeaks();
+
+  // Once enough objects are local, the rest aren't checked.
+  local_objects.emplace(obj2);
+  num_local_checks = 0;
+  wait_manager.Wait(std::vector<ObjectID>{obj1, obj2, obj3},
+                    -1,
+                    1,
+                    [&](std::vector<ObjectID> _ready, std::vector<ObjectID> _remaining) {
+                      ready = _ready;
+                      remaining = _remaining;
+                    });
+  ASSERT_EQ(num_local_checks, 1);
+  ASSERT_EQ(ready, std::vector<ObjectID>{obj1});
+  ASSERT_EQ(remaining, (std::vector<ObjectID>{obj2, obj3}));
+  AssertNoLeaks();
+}
+
 }  // namespace raylet
 }  // namespace ray
 
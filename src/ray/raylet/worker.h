@@ -27,6 +27,7 @@
 #include "ray/raylet/scheduling/scheduling_ids.h"
 #include "ray/rpc/worker/core_worker_client.h"
 #include "ray/util/process.h"
+#include "ray/util/util.h"
 
 namespace ray {
 
@@ -99,6 +100,9 @@ class WorkerInterface {
 
   virtual void SetAssignedTask(const RayTask &assigned_task) = 0;
 
+  /// The time in milliseconds when the worker was last assigned a task.
+  virtual int64_t GetAssignedTaskTime() const = 0;
+
   virtual bool IsRegistered() = 0;
 
   virtual rpc::CoreWorkerClientInterface *rpc_client() = 0;
@@ -201,7 +205,12 @@ class Worker : public WorkerInterface {
 
   RayTask &GetAssignedTask() { return assigned_task_; };
 
-  void SetAssignedTask(const RayTask &assigned_task) { assigned_task_ = assigned_task; };
+  void SetAssignedTask(const RayTask &assigned_task) {
+    assigned_task_ = assigned_task;
+    assigned_task_time_ms_ = current_time_ms();
+  };
+
+  int64_t GetAssignedTaskTime() const { return assigned_task_time_ms_; }
 
   bool IsRegistered() { return rpc_client_ != nullptr; }
 
@@ -280,6 +289,8 @@ class Worker : public WorkerInterface {
   std::shared_ptr<TaskResourceInstances> lifetime_allocated_instances_;
   /// RayTask being assigned to this worker.
   RayTask assigned_task_;
+  /// The time in milliseconds when `assigned_task_` was assigned.
+  int64_t assigned_task_time_ms_ = 0;
 };
 
 }  // namespace raylet
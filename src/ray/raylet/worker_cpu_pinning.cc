@@ -0,0 +1,134 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/worker_cpu_pinning.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+WorkerCpuPinning::WorkerCpuPinning(const std::vector<int> &allowed_cpus,
+                                   size_t num_reserved_cpus) {
+  num_reserved_cpus =
+      allowed_cpus.empty() ? 0 : std::min(num_reserved_cpus, allowed_cpus.size() - 1);
+  reserved_cpus_.assign(allowed_cpus.begin(), allowed_cpus.begin() + num_reserved_cpus);
+  worker_cpus_.assign(allowed_cpus.begin() + num_reserved_cpus, allowed_cpus.end());
+}
+
+std::vector<int> WorkerCpuPinning::GetAllowedCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+bool WorkerCpuPinning::PinProcess(pid_t pid, const std::vector<int> &cpus) {
+#ifdef __linux__
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  // The affinity is per thread, so pin each thread of the process.
+  bool pinned = true;
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator it("/proc/" + std::to_string(pid) + "/task",
+                                                ec),
+       end;
+       !ec && it != end;
+       it.increment(ec)) {
+    const pid_t tid = std::stoi(it->path().filename().string());
+    if (sched_setaffinity(tid, sizeof(cpu_set), &cpu_set) != 0) {
+      RAY_LOG(DEBUG) << "Failed to pin thread " << tid << " of process " << pid
+                     << ", errno: " << errno;
+      pinned = false;
+    }
+  }
+  return pinned && !ec;
+#else
+  return false;
+#endif
+}
+
+void WorkerCpuPinning::PinRaylet() const {
+#ifdef __linux__
+  if (reserved_cpus_.empty()) {
+    return;
+  }
+  if (!PinProcess(getpid(), reserved_cpus_)) {
+    RAY_LOG(WARNING) << "Failed to pin the raylet to its reserved CPUs.";
+  }
+#endif
+}
+
+void WorkerCpuPinning::PinStartedWorker(pid_t pid) const {
+  if (!reserved_cpus_.empty()) {
+    PinProcess(pid, worker_cpus_);
+  }
+}
+
+void WorkerCpuPinning::PinLeasedWorker(
+    pid_t pid, const TaskResourceInstances &allocated_instances) const {
+  PinProcess(pid, GetWorkerCpus(allocated_instances));
+}
+
+std::vector<int> WorkerCpuPinning::GetWorkerCpus(
+    const TaskResourceInstances &allocated_instances) const {
+  const auto cpu_id = ResourceID::CPU();
+  if (worker_cpus_.empty() || !cpu_id.IsUnitInstanceResource() ||
+      !allocated_instances.Has(cpu_id)) {
+    return worker_cpus_;
+  }
+  // The CPU instances are numbered from 0, so map them onto the workers' CPUs.
+  std::vector<int> cpus;
+  const auto &instances = allocated_instances.Get(cpu_id);
+  for (size_t i = 0; i < instances.size(); i++) {
+    if (instances[i] > 0) {
+      const int cpu = worker_cpus_[i % worker_cpus_.size()];
+      if (std::find(cpus.begin(), cpus.end(), cpu) == cpus.end()) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  if (cpus.empty()) {
+    return worker_cpus_;
+  }
+  return cpus;
+}
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -0,0 +1,74 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <vector>
+
+#include "ray/raylet/scheduling/cluster_resource_data.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// \class WorkerCpuPinning
+/// Pins the raylet and its workers to the CPUs of the node, so that workers don't
+/// interfere with each other and with the raylet. The first CPUs that the raylet may
+/// run on are reserved for the raylet and its threads (including the object store),
+/// and workers run on the others. A leased worker is pinned to the CPUs of the CPU
+/// instances allocated to it, if CPU is a unit instance resource, and else may run on
+/// any of the workers' CPUs. Only supported on Linux.
+class WorkerCpuPinning {
+ public:
+  /// \param allowed_cpus The CPUs that the raylet may run on.
+  /// \param num_reserved_cpus The number of the allowed CPUs to reserve for the
+  /// raylet. At least one CPU is always left for the workers.
+  WorkerCpuPinning(const std::vector<int> &allowed_cpus, size_t num_reserved_cpus);
+
+  /// Return the CPUs that the calling process may run on.
+  static std::vector<int> GetAllowedCpus();
+
+  /// Pin all the threads of a process to the given CPUs. Threads that the process
+  /// starts afterwards inherit the CPUs of the thread that starts them.
+  ///
+  /// \return Whether all the threads were pinned.
+  static bool PinProcess(pid_t pid, const std::vector<int> &cpus);
+
+  /// Pin the raylet to the reserved CPUs.
+  void PinRaylet() const;
+
+  /// Let a worker that was just started run on any of the workers' CPUs. Otherwise it
+  /// would inherit the reserved CPUs from the raylet.
+  void PinStartedWorker(pid_t pid) const;
+
+  /// Pin a leased worker to the CPUs of the instances allocated to it.
+  void PinLeasedWorker(pid_t pid, const TaskResourceInstances &allocated_instances) const;
+
+  /// Return the CPUs that a worker with the given allocated instances runs on.
+  std::vector<int> GetWorkerCpus(const TaskResourceInstances &allocated_instances) const;
+
+  const std::vector<int> &ReservedCpus() const { return reserved_cpus_; }
+
+  const std::vector<int> &WorkerCpus() const { return worker_cpus_; }
+
+ private:
+  std::vector<int> reserved_cpus_;
+  std::vector<int> worker_cpus_;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -0,0 +1,73 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/worker_cpu_pinning.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+namespace raylet {
+
+class WorkerCpuPinningTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    RayConfig::instance().initialize(
+        R"(
+{
+  "predefined_unit_instance_resources": "CPU,GPU"
+}
+  )");
+  }
+};
+
+TEST_F(WorkerCpuPinningTest, TestReserveCpus) {
+  WorkerCpuPinning pinning({0, 2, 4, 6}, 1);
+  ASSERT_EQ(pinning.ReservedCpus(), std::vector<int>({0}));
+  ASSERT_EQ(pinning.WorkerCpus(), std::vector<int>({2, 4, 6}));
+
+  // At least one CPU is left for the workers.
+  WorkerCpuPinning all_reserved({0, 1}, 4);
+  ASSERT_EQ(all_reserved.ReservedCpus(), std::vector<int>({0}));
+  ASSERT_EQ(all_reserved.WorkerCpus(), std::vector<int>({1}));
+
+  WorkerCpuPinning none_allowed({}, 4);
+  ASSERT_TRUE(none_allowed.ReservedCpus().empty());
+  ASSERT_TRUE(none_allowed.WorkerCpus().empty());
+}
+
+TEST_F(WorkerCpuPinningTest, TestWorkerCpus) {
+  ASSERT_TRUE(ResourceID::CPU().IsUnitInstanceResource());
+  WorkerCpuPinning pinning({0, 1, 2, 3}, 1);
+
+  TaskResourceInstances instances;
+  // Workers without CPUs may run on any of the workers' CPUs.
+  ASSERT_EQ(pinning.GetWorkerCpus(instances), std::vector<int>({1, 2, 3}));
+  instances.Set(ResourceID::CPU(), {0, 1, 0});
+  ASSERT_EQ(pinning.GetWorkerCpus(instances), std::vector<int>({2}));
+  instances.Set(ResourceID::CPU(), {1, 0, 1});
+  ASSERT_EQ(pinning.GetWorkerCpus(instances), std::vector<int>({1, 3}));
+  // There are more CPU instances than CPUs.
+  instances.Set(ResourceID::CPU(), {0, 0, 0, 1, 1});
+  ASSERT_EQ(pinning.GetWorkerCpus(instances), std::vector<int>({1, 2}));
+}
+
+}  // namespace raylet
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
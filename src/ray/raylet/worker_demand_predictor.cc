@@ -0,0 +1,88 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/worker_demand_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+WorkerDemandPredictor::WorkerDemandPredictor(int64_t half_life_ms)
+    : half_life_ms_(half_life_ms) {
+  RAY_CHECK(half_life_ms_ > 0);
+}
+
+void WorkerDemandPredictor::RecordDemand(const WorkerDemandKey &key,
+                                         int64_t num_workers,
+                                         int64_t now_ms) {
+  auto it = demands_.find(key);
+  if (it == demands_.end()) {
+    if (num_workers > 0) {
+      demands_.emplace(key, Demand{static_cast<double>(num_workers), now_ms});
+    }
+    return;
+  }
+  it->second.peak =
+      std::max(DecayedPeak(it->second, now_ms), static_cast<double>(num_workers));
+  it->second.updated_ms = now_ms;
+}
+
+int64_t WorkerDemandPredictor::PredictDemand(const WorkerDemandKey &key,
+                                             int64_t now_ms) const {
+  auto it = demands_.find(key);
+  if (it == demands_.end()) {
+    return 0;
+  }
+  return std::llround(DecayedPeak(it->second, now_ms));
+}
+
+absl::flat_hash_map<WorkerDemandKey, int64_t> WorkerDemandPredictor::PredictAllDemands(
+    int64_t now_ms) {
+  absl::flat_hash_map<WorkerDemandKey, int64_t> predictions;
+  for (auto it = demands_.begin(); it != demands_.end();) {
+    int64_t prediction = std::llround(DecayedPeak(it->second, now_ms));
+    if (prediction == 0) {
+      demands_.erase(it++);
+      continue;
+    }
+    predictions.emplace(it->first, prediction);
+    it++;
+  }
+  return predictions;
+}
+
+void WorkerDemandPredictor::RemoveJob(const JobID &job_id) {
+  for (auto it = demands_.begin(); it != demands_.end();) {
+    if (it->first.job_id == job_id) {
+      demands_.erase(it++);
+    } else {
+      it++;
+    }
+  }
+}
+
+double WorkerDemandPredictor::DecayedPeak(const Demand &demand, int64_t now_ms) const {
+  int64_t elapsed_ms = std::max<int64_t>(now_ms - demand.updated_ms, 0);
+  return demand.peak *
+         std::exp2(-static_cast<double>(elapsed_ms) / static_cast<double>(half_life_ms_));
+}
+
+}  // namespace raylet
+
+}  // namespace ray
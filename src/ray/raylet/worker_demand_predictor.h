@@ -0,0 +1,84 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/id.h"
+#include "src/ray/protobuf/common.pb.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// The workers that can serve each other's tasks: same job, runtime env and language.
+struct WorkerDemandKey {
+  JobID job_id;
+  int runtime_env_hash;
+  Language language;
+
+  bool operator==(const WorkerDemandKey &other) const {
+    return job_id == other.job_id && runtime_env_hash == other.runtime_env_hash &&
+           language == other.language;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const WorkerDemandKey &key) {
+    return H::combine(std::move(h), key.job_id, key.runtime_env_hash, key.language);
+  }
+};
+
+/// \class WorkerDemandPredictor
+/// Predicts the near-term peak number of workers of each key from the demand that was
+/// observed for it. The prediction is the peak demand, decayed exponentially by the
+/// time since it was observed, so that the workers of a job that runs in periodic
+/// bursts are kept warm between the bursts, and let go once the job stops.
+class WorkerDemandPredictor {
+ public:
+  /// \param half_life_ms The time it takes for the observed peak to decay to half.
+  explicit WorkerDemandPredictor(int64_t half_life_ms);
+
+  /// Record the number of workers of a key that are needed now.
+  void RecordDemand(const WorkerDemandKey &key, int64_t num_workers, int64_t now_ms);
+
+  /// Get the predicted number of workers of a key.
+  int64_t PredictDemand(const WorkerDemandKey &key, int64_t now_ms) const;
+
+  /// Get the predicted number of workers of every key that still needs any, and forget
+  /// the others.
+  absl::flat_hash_map<WorkerDemandKey, int64_t> PredictAllDemands(int64_t now_ms);
+
+  /// Forget the demand of a job, e.g., once it finishes.
+  void RemoveJob(const JobID &job_id);
+
+ private:
+  struct Demand {
+    /// The peak demand, as of the last update.
+    double peak;
+    /// The time of the last update.
+    int64_t updated_ms;
+  };
+
+  /// The peak of a demand, decayed to now.
+  double DecayedPeak(const Demand &demand, int64_t now_ms) const;
+
+  const int64_t half_life_ms_;
+  absl::flat_hash_map<WorkerDemandKey, Demand> demands_;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
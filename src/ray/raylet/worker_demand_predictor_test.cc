@@ -0,0 +1,64 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/worker_demand_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+namespace raylet {
+
+TEST(WorkerDemandPredictorTest, TestDecayedPeak) {
+  WorkerDemandPredictor predictor(/*half_life_ms=*/1000);
+  WorkerDemandKey key{JobID::FromInt(1), 0, Language::PYTHON};
+  WorkerDemandKey other_key{JobID::FromInt(2), 0, Language::PYTHON};
+  ASSERT_EQ(predictor.PredictDemand(key, 0), 0);
+
+  predictor.RecordDemand(key, 8, 0);
+  ASSERT_EQ(predictor.PredictDemand(key, 0), 8);
+  // A lower demand doesn't lower the peak.
+  predictor.RecordDemand(key, 2, 0);
+  ASSERT_EQ(predictor.PredictDemand(key, 0), 8);
+  // The peak halves every half life.
+  ASSERT_EQ(predictor.PredictDemand(key, 1000), 4);
+  ASSERT_EQ(predictor.PredictDemand(key, 2000), 2);
+  // A higher demand raises the peak.
+  predictor.RecordDemand(key, 6, 1000);
+  ASSERT_EQ(predictor.PredictDemand(key, 1000), 6);
+
+  predictor.RecordDemand(other_key, 1, 1000);
+  auto predictions = predictor.PredictAllDemands(1000);
+  ASSERT_EQ(predictions.size(), 2);
+  ASSERT_EQ(predictions[key], 6);
+  ASSERT_EQ(predictions[other_key], 1);
+
+  // The demands that decayed to nothing are forgotten.
+  predictions = predictor.PredictAllDemands(3000);
+  ASSERT_EQ(predictions.size(), 1);
+  ASSERT_EQ(predictions[key], 2);
+
+  predictor.RemoveJob(key.job_id);
+  ASSERT_EQ(predictor.PredictDemand(key, 3000), 0);
+  ASSERT_TRUE(predictor.PredictAllDemands(3000).empty());
+}
+
+}  // namespace raylet
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
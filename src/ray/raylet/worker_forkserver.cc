@@ -0,0 +1,184 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/worker_forkserver.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <tuple>
+
+#include "ray/common/id.h"
+#include "ray/util/filesystem.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace raylet {
+
+namespace {
+
+#ifdef __linux__
+/// The time to wait for the zygote to fork a worker before giving up on it.
+constexpr int kForkTimeoutSeconds = 10;
+
+bool WriteAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = write(fd, data, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool ReadAll(int fd, char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = read(fd, data, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    size -= n;
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
+WorkerForkserver::WorkerForkserver(const std::string &python_executable,
+                                   const std::string &forkserver_script)
+    : socket_path_(JoinPaths(GetUserTempDir(),
+                             "ray_forkserver_" + std::to_string(GetPID()) + "_" +
+                                 UniqueID::FromRandom().Hex().substr(0, 8))) {
+#ifdef __linux__
+  std::error_code ec;
+  std::tie(zygote_, ec) =
+      Process::Spawn({python_executable, forkserver_script, socket_path_},
+                     /*decouple=*/false);
+  if (ec) {
+    RAY_LOG(WARNING) << "Failed to start the worker forkserver: " << ec.message();
+    failed_ = true;
+  }
+#else
+  failed_ = true;
+#endif
+}
+
+WorkerForkserver::~WorkerForkserver() { Shutdown(); }
+
+bool WorkerForkserver::Connect() {
+#ifdef __linux__
+  if (fd_ >= 0) {
+    return true;
+  }
+  struct sockaddr_un addr;
+  if (socket_path_.size() >= sizeof(addr.sun_path)) {
+    RAY_LOG(WARNING) << "The path of the worker forkserver's socket is too long: "
+                     << socket_path_;
+    failed_ = true;
+    return false;
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return false;
+  }
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+    // The zygote is still importing Ray.
+    close(fd);
+    return false;
+  }
+  struct timeval timeout;
+  timeout.tv_sec = kForkTimeoutSeconds;
+  timeout.tv_usec = 0;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  fd_ = fd;
+  RAY_LOG(INFO) << "Connected to the worker forkserver with pid " << zygote_.GetId();
+  return true;
+#else
+  return false;
+#endif
+}
+
+Process WorkerForkserver::Fork(const std::vector<std::string> &worker_command_args,
+                               const ProcessEnvironment &env) {
+#ifdef __linux__
+  if (failed_ || !Connect()) {
+    return Process();
+  }
+  // The arguments and the environment variables, separated by an empty string.
+  std::string payload;
+  for (const auto &arg : worker_command_args) {
+    payload.append(arg).push_back('\0');
+  }
+  payload.push_back('\0');
+  for (const auto &entry : env) {
+    payload.append(entry.first).append("=").append(entry.second).push_back('\0');
+  }
+  uint32_t size = htonl(static_cast<uint32_t>(payload.size()));
+  int32_t pid = -1;
+  if (!WriteAll(fd_, reinterpret_cast<const char *>(&size), sizeof(size)) ||
+      !WriteAll(fd_, payload.data(), payload.size()) ||
+      !ReadAll(fd_, reinterpret_cast<char *>(&pid), sizeof(pid))) {
+    RAY_LOG(WARNING) << "The worker forkserver failed, workers will be started "
+                        "without it.";
+    Shutdown();
+    return Process();
+  }
+  pid = static_cast<int32_t>(ntohl(static_cast<uint32_t>(pid)));
+  if (pid <= 0) {
+    return Process();
+  }
+  return Process::FromPid(pid);
+#else
+  return Process();
+#endif
+}
+
+void WorkerForkserver::Shutdown() {
+#ifdef __linux__
+  failed_ = true;
+  if (fd_ >= 0) {
+    // The zygote exits once it's disconnected.
+    close(fd_);
+    fd_ = -1;
+  } else if (zygote_.IsValid() && zygote_.IsAlive()) {
+    zygote_.Kill();
+  }
+  unlink(socket_path_.c_str());
+#endif
+}
+
+}  // namespace raylet
+
+}  // namespace ray
@@ -0,0 +1,73 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ray/util/process.h"
+
+namespace ray {
+
+namespace raylet {
+
+/// \class WorkerForkserver
+/// Starts Python workers by forking them from a zygote process that has already
+/// imported Ray, so that the workers don't pay for starting the interpreter and
+/// importing Ray. See python/ray/workers/forkserver.py for the protocol.
+///
+/// The zygote is started on construction, and it takes a while to import Ray, so
+/// Fork() returns a null process until the zygote is ready. The zygote exits once
+/// this object is destroyed. Only supported on Linux.
+class WorkerForkserver {
+ public:
+  /// \param python_executable The Python executable to run the zygote with.
+  /// \param forkserver_script The path of the zygote's script.
+  WorkerForkserver(const std::string &python_executable,
+                   const std::string &forkserver_script);
+
+  ~WorkerForkserver();
+
+  /// Fork a worker from the zygote.
+  ///
+  /// \param worker_command_args The command line of the worker, whose second argument
+  /// is the worker's script.
+  /// \param env The environment variables to set on the worker, besides the ones
+  /// inherited from the raylet.
+  /// \return The forked worker, or a null process if the zygote isn't ready or
+  /// failed, in which case the caller should start the worker itself.
+  Process Fork(const std::vector<std::string> &worker_command_args,
+               const ProcessEnvironment &env);
+
+ private:
+  /// Connect to the zygote, if it is ready.
+  bool Connect();
+
+  /// Stop using the zygote, e.g., after it failed.
+  void Shutdown();
+
+  /// The path of the Unix socket that the zygote listens on.
+  const std::string socket_path_;
+  /// The zygote process.
+  Process zygote_;
+  /// The connection to the zygote, or -1 if not connected.
+  int fd_ = -1;
+  /// Whether the zygote failed, so it is no longer used.
+  bool failed_ = false;
+};
+
+}  // namespace raylet
+
+}  // namespace ray
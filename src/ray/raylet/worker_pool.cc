@@ -18,6 +18,7 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 
+#include "absl/strings/match.h"
 #include "ray/common/constants.h"
 #include "ray/common/network_util.h"
 #include "ray/common/ray_config.h"
@@ -134,6 +135,10 @@ WorkerPool::WorkerPool(instrumented_io_context &io_service,
       free_ports_->push(port);
     }
   }
+  if (RayConfig::instance().worker_demand_half_life_ms() > 0) {
+    demand_predictor_ = std::make_unique<WorkerDemandPredictor>(
+        RayConfig::instance().worker_demand_half_life_ms());
+  }
   if (RayConfig::instance().kill_idle_workers_interval_ms() > 0) {
     periodical_runner_.RunFnPeriodically(
         [this] { TryKillingIdleWorkers(); },
@@ -166,6 +171,10 @@ void WorkerPool::SetAgentManager(std::shared_ptr<AgentManager> agent_manager) {
   agent_manager_ = agent_manager;
 }
 
+void WorkerPool::SetCpuPinning(std::shared_ptr<const WorkerCpuPinning> cpu_pinning) {
+  cpu_pinning_ = std::move(cpu_pinning);
+}
+
 void WorkerPool::PopWorkerCallbackAsync(const PopWorkerCallback &callback,
                                         std::shared_ptr<WorkerInterface> worker,
                                         PopWorkerStatus status) {
@@ -569,6 +578,25 @@ Process WorkerPool::StartProcess(const std::vector<std::string> &worker_command_
     RAY_LOG(DEBUG) << debug_info;
   }
 
+  if (RayConfig::instance().worker_forkserver() && worker_command_args.size() >= 2 &&
+      absl::EndsWith(worker_command_args[1], kDefaultWorkerFilename)) {
+    if (!forkserver_) {
+      forkserver_ = std::make_unique<WorkerForkserver>(
+          worker_command_args[0],
+          (boost::filesystem::path(worker_command_args[1]).parent_path() /
+           kForkserverFilename)
+              .string());
+    }
+    Process child = forkserver_->Fork(worker_command_args, env);
+    if (!child.IsNull()) {
+      if (cpu_pinning_) {
+        cpu_pinning_->PinStartedWorker(child.GetId());
+      }
+      return child;
+    }
+    // The forkserver isn't ready yet, so start the worker from scratch.
+  }
+
   // Launch the process to create the worker.
   std::error_code ec;
   std::vector<const char *> argv;
@@ -589,6 +617,9 @@ Process WorkerPool::StartProcess(const std::vector<std::string> &worker_command_
                      << ec.message();
     }
   }
+  if (cpu_pinning_) {
+    cpu_pinning_->PinStartedWorker(child.GetId());
+  }
   return child;
 }
 
@@ -675,6 +706,9 @@ void WorkerPool::HandleJobFinished(const JobID &job_id) {
     DeleteRuntimeEnvIfPossible(job_config->runtime_env_info().serialized_runtime_env());
   }
   finished_jobs_.insert(job_id);
+  if (demand_predictor_) {
+    demand_predictor_->RemoveJob(job_id);
+  }
 }
 
 boost::optional<const rpc::JobConfig &> WorkerPool::GetJobConfig(
@@ -992,6 +1026,12 @@ void WorkerPool::PushWorker(const std::shared_ptr<WorkerInterface> &worker) {
 void WorkerPool::TryKillingIdleWorkers() {
   RAY_CHECK(idle_of_all_languages_.size() == idle_of_all_languages_map_.size());
 
+  // The idle workers to keep for the predicted demand.
+  absl::flat_hash_map<WorkerDemandKey, int64_t> idle_workers_to_keep;
+  if (demand_predictor_) {
+    idle_workers_to_keep = UpdateWorkerDemand();
+  }
+
   int64_t now = get_time_();
   size_t running_size = 0;
   for (const auto &worker : GetAllRegisteredWorkers()) {
@@ -1003,21 +1043,29 @@ void WorkerPool::TryKillingIdleWorkers() {
   // idle workers that it needs to.
   RAY_CHECK(running_size >= pending_exit_idle_workers_.size());
   running_size -= pending_exit_idle_workers_.size();
+  // The idle workers of finished jobs are all killed at once, however long they have
+  // been idle, so the FIFO scan below only stops early once none of them are left.
+  size_t num_idle_workers_of_finished_jobs = 0;
+  for (const auto &idle_pair : idle_of_all_languages_) {
+    if (finished_jobs_.contains(idle_pair.first->GetAssignedJobId())) {
+      num_idle_workers_of_finished_jobs++;
+    }
+  }
   // Kill idle workers in FIFO order.
   for (const auto &idle_pair : idle_of_all_languages_) {
     const auto &idle_worker = idle_pair.first;
     const auto &job_id = idle_worker->GetAssignedJobId();
-    if (running_size <= static_cast<size_t>(num_workers_soft_limit_)) {
-      if (!finished_jobs_.count(job_id)) {
-        // Ignore the soft limit for jobs that have already finished, as we
-        // should always clean up these workers.
+    if (finished_jobs_.contains(job_id)) {
+      num_idle_workers_of_finished_jobs--;
+    } else if (running_size <= static_cast<size_t>(num_workers_soft_limit_) ||
+               now - idle_pair.second <
+                   RayConfig::instance().idle_worker_killing_time_threshold_ms()) {
+      // Ignore the soft limit and the idle time for jobs that have already finished,
+      // as we should always clean up these workers.
+      if (num_idle_workers_of_finished_jobs == 0) {
         break;
       }
-    }
-
-    if (now - idle_pair.second <
-        RayConfig::instance().idle_worker_killing_time_threshold_ms()) {
-      break;
+      continue;
     }
 
     if (idle_worker->IsDead()) {
@@ -1025,6 +1073,14 @@ void WorkerPool::TryKillingIdleWorkers() {
       // This is possible because a Java worker process may hold multiple workers.
       continue;
     }
+
+    auto keep_it = idle_workers_to_keep.find(WorkerDemandKey{
+        job_id, idle_worker->GetRuntimeEnvHash(), idle_worker->GetLanguage()});
+    if (keep_it != idle_workers_to_keep.end() && keep_it->second > 0) {
+      // The worker is expected to be needed again soon.
+      keep_it->second--;
+      continue;
+    }
     auto worker_startup_token = idle_worker->GetStartupToken();
     auto &worker_state = GetStateForLanguage(idle_worker->GetLanguage());
 
@@ -1145,6 +1201,86 @@ void WorkerPool::TryKillingIdleWorkers() {
   RAY_CHECK(idle_of_all_languages_.size() == idle_of_all_languages_map_.size());
 }
 
+absl::flat_hash_map<WorkerDemandKey, int64_t> WorkerPool::UpdateWorkerDemand() {
+  int64_t now = get_time_();
+  absl::flat_hash_map<WorkerDemandKey, int64_t> num_busy_workers;
+  absl::flat_hash_map<WorkerDemandKey, int64_t> num_idle_workers;
+  int64_t total_busy_workers = 0;
+  for (const auto &worker : GetAllRegisteredWorkers(/*filter_dead_workers=*/true)) {
+    // Actors hold on to their workers, so they don't need warm workers.
+    if (worker->GetWorkerType() != rpc::WorkerType::WORKER ||
+        !worker->GetActorId().IsNil()) {
+      continue;
+    }
+    WorkerDemandKey key{
+        worker->GetAssignedJobId(), worker->GetRuntimeEnvHash(), worker->GetLanguage()};
+    if (idle_of_all_languages_map_.contains(worker)) {
+      num_idle_workers[key]++;
+    } else {
+      num_busy_workers[key]++;
+      total_busy_workers++;
+    }
+  }
+  for (const auto &entry : num_busy_workers) {
+    demand_predictor_->RecordDemand(entry.first, entry.second, now);
+  }
+
+  // Workers that are still starting may be used for any job of their language.
+  absl::flat_hash_map<Language, int64_t> num_starting_workers;
+  for (const auto &entry : states_by_lang_) {
+    for (const auto &process : entry.second.worker_processes) {
+      if (process.second.worker_type == rpc::WorkerType::WORKER) {
+        num_starting_workers[entry.first] += process.second.num_starting_workers;
+      }
+    }
+  }
+
+  absl::flat_hash_map<WorkerDemandKey, int64_t> idle_workers_to_keep;
+  // The warm workers are kept within the soft limit.
+  int64_t budget = num_workers_soft_limit_ - total_busy_workers;
+  for (const auto &entry : demand_predictor_->PredictAllDemands(now)) {
+    const auto &key = entry.first;
+    if (budget <= 0) {
+      break;
+    }
+    if (finished_jobs_.contains(key.job_id) || !states_by_lang_.count(key.language)) {
+      continue;
+    }
+    auto busy_it = num_busy_workers.find(key);
+    int64_t num_needed =
+        entry.second - (busy_it == num_busy_workers.end() ? 0 : busy_it->second);
+    if (num_needed <= 0) {
+      continue;
+    }
+    num_needed = std::min(num_needed, budget);
+    budget -= num_needed;
+    idle_workers_to_keep[key] = num_needed;
+
+    // Workers with a runtime env are only started once a task needs them, as their
+    // runtime env has to be set up first.
+    if (key.runtime_env_hash != 0) {
+      continue;
+    }
+    auto idle_it = num_idle_workers.find(key);
+    int64_t num_to_start =
+        num_needed - (idle_it == num_idle_workers.end() ? 0 : idle_it->second);
+    auto &num_starting = num_starting_workers[key.language];
+    int64_t num_starting_used = std::min(std::max<int64_t>(num_to_start, 0), num_starting);
+    num_starting -= num_starting_used;
+    num_to_start -= num_starting_used;
+    if (num_to_start > 0) {
+      RAY_LOG(DEBUG) << "Prestarting " << num_to_start << " workers for job "
+                     << key.job_id << " given the predicted demand of " << entry.second
+                     << " workers";
+    }
+    for (int64_t i = 0; i < num_to_start; i++) {
+      PopWorkerStatus status;
+      StartWorkerProcess(key.language, rpc::WorkerType::WORKER, key.job_id, &status);
+    }
+  }
+  return idle_workers_to_keep;
+}
+
 void WorkerPool::PopWorker(const TaskSpecification &task_spec,
                            const PopWorkerCallback &callback,
                            const std::string &allocated_instances_serialized_json) {
@@ -1322,6 +1458,13 @@ void WorkerPool::PopWorker(const TaskSpecification &task_spec,
 void WorkerPool::PrestartWorkers(const TaskSpecification &task_spec,
                                  int64_t backlog_size,
                                  int64_t num_available_cpus) {
+  if (demand_predictor_ && !task_spec.IsActorCreationTask()) {
+    demand_predictor_->RecordDemand(
+        WorkerDemandKey{
+            task_spec.JobId(), task_spec.GetRuntimeEnvHash(), task_spec.GetLanguage()},
+        std::min(backlog_size, num_available_cpus),
+        get_time_());
+  }
   // Code path of task that needs a dedicated worker.
   if ((task_spec.IsActorCreationTask() && !task_spec.DynamicWorkerOptions().empty()) ||
       task_spec.HasRuntimeEnv()) {
@@ -34,6 +34,9 @@
 #include "ray/gcs/gcs_client/gcs_client.h"
 #include "ray/raylet/agent_manager.h"
 #include "ray/raylet/worker.h"
+#include "ray/raylet/worker_cpu_pinning.h"
+#include "ray/raylet/worker_demand_predictor.h"
+#include "ray/raylet/worker_forkserver.h"
 
 namespace ray {
 
@@ -117,6 +120,13 @@ class WorkerPoolInterface {
   virtual const std::vector<std::shared_ptr<WorkerInterface>> GetAllRegisteredWorkers(
       bool filter_dead_workers = false) const = 0;
 
+  /// Get the job config by job id.
+  ///
+  /// \param job_id ID of the job.
+  /// \return Job config if given job is running, else nullptr.
+  virtual boost::optional<const rpc::JobConfig &> GetJobConfig(
+      const JobID &job_id) const = 0;
+
   virtual ~WorkerPoolInterface(){};
 };
 
@@ -207,6 +217,9 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
   /// Set agent manager.
   void SetAgentManager(std::shared_ptr<AgentManager> agent_manager);
 
+  /// Set the pinning of started workers to CPUs.
+  void SetCpuPinning(std::shared_ptr<const WorkerCpuPinning> cpu_pinning);
+
   /// Handles the event that a job is started.
   ///
   /// \param job_id ID of the started job.
@@ -401,6 +414,12 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
   /// reasonable size.
   void TryKillingIdleWorkers();
 
+  /// Record the demand of the busy workers, and prestart the workers that the predicted
+  /// demand needs. Called periodically if worker_demand_half_life_ms is set.
+  ///
+  /// \return The number of idle workers of each key to keep for the predicted demand.
+  absl::flat_hash_map<WorkerDemandKey, int64_t> UpdateWorkerDemand();
+
  protected:
   void update_worker_startup_token_counter();
 
@@ -712,6 +731,9 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
   std::shared_ptr<gcs::GcsClient> gcs_client_;
   /// The native library path which includes the core libraries.
   std::string native_library_path_;
+  /// Forks the Python workers when worker_forkserver is enabled. Started when the
+  /// first Python worker is.
+  std::unique_ptr<WorkerForkserver> forkserver_;
   /// The callback that will be triggered once it times out to start a worker.
   std::function<void()> starting_worker_timeout_callback_;
   /// If 1, expose Ray debuggers started by the workers externally (to this node).
@@ -753,8 +775,13 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
 
   /// A callback to get the current time.
   const std::function<double()> get_time_;
+  /// Predicts the demand of workers from its history, so that the workers of bursty
+  /// jobs are kept warm. Null if worker_demand_half_life_ms isn't set.
+  std::unique_ptr<WorkerDemandPredictor> demand_predictor_;
   /// Agent manager.
   std::shared_ptr<AgentManager> agent_manager_;
+  /// Pins started workers to CPUs, if set.
+  std::shared_ptr<const WorkerCpuPinning> cpu_pinning_;
 
   /// Stats
   int64_t process_failed_job_config_missing_ = 0;
@@ -83,6 +83,48 @@ Status raylet::RayletConnection::AtomicRequestReply(MessageType request_type,
   return status;
 }
 
+Status raylet::RayletConnection::PipelinedRequestReply(
+    MessageType request_type,
+    MessageType reply_type,
+    int64_t request_id,
+    const std::function<int64_t(const std::vector<uint8_t> &)> &get_request_id,
+    std::vector<uint8_t> *reply_message,
+    flatbuffers::FlatBufferBuilder *fbb) {
+  RAY_RETURN_NOT_OK(WriteMessage(request_type, fbb));
+  reply_mutex_.Lock();
+  while (true) {
+    // Wait until another thread has read the reply to this request, or until no thread
+    // is reading, in which case read the next reply ourselves.
+    auto ready = [this, request_id]() EXCLUSIVE_LOCKS_REQUIRED(reply_mutex_) {
+      return !reading_reply_ || pending_replies_.contains(request_id);
+    };
+    reply_mutex_.Await(absl::Condition(&ready));
+    auto it = pending_replies_.find(request_id);
+    if (it != pending_replies_.end()) {
+      *reply_message = std::move(it->second);
+      pending_replies_.erase(it);
+      reply_mutex_.Unlock();
+      return Status::OK();
+    }
+
+    reading_reply_ = true;
+    reply_mutex_.Unlock();
+    std::vector<uint8_t> message;
+    auto status = conn_->ReadMessage(static_cast<int64_t>(reply_type), &message);
+    if (!status.ok()) {
+      reply_mutex_.Lock();
+      reading_reply_ = false;
+      reply_mutex_.Unlock();
+      ShutdownIfLocalRayletDisconnected(status);
+      return status;
+    }
+    const int64_t reply_request_id = get_request_id(message);
+    reply_mutex_.Lock();
+    reading_reply_ = false;
+    pending_replies_[reply_request_id] = std::move(message);
+  }
+}
+
 void raylet::RayletConnection::ShutdownIfLocalRayletDisconnected(const Status &status) {
   if (!status.ok() && IsRayletFailed(RayConfig::instance().RAYLET_PID())) {
     RAY_LOG(WARNING) << "The connection is failed because the local raylet has been "
@@ -250,6 +292,7 @@ Status raylet::RayletClient::Wait(const std::vector<ObjectID> &object_ids,
                                   const TaskID &current_task_id,
                                   WaitResultPair *result) {
   // Write request.
+  const int64_t request_id = conn_->NextRequestId();
   flatbuffers::FlatBufferBuilder fbb;
   auto message = protocol::CreateWaitRequest(fbb,
                                              to_flatbuf(fbb, object_ids),
@@ -257,11 +300,21 @@ Status raylet::RayletClient::Wait(const std::vector<ObjectID> &object_ids,
                                              num_returns,
                                              timeout_milliseconds,
                                              mark_worker_blocked,
-                                             to_flatbuf(fbb, current_task_id));
+                                             to_flatbuf(fbb, current_task_id),
+                                             request_id);
   fbb.Finish(message);
   std::vector<uint8_t> reply;
-  RAY_RETURN_NOT_OK(conn_->AtomicRequestReply(
-      MessageType::WaitRequest, MessageType::WaitReply, &reply, &fbb));
+  // Waits from several threads may be outstanding at once, so they're pipelined
+  // rather than serialized on the connection.
+  RAY_RETURN_NOT_OK(conn_->PipelinedRequestReply(
+      MessageType::WaitRequest,
+      MessageType::WaitReply,
+      request_id,
+      [](const std::vector<uint8_t> &reply) {
+        return flatbuffers::GetRoot<protocol::WaitReply>(reply.data())->request_id();
+      },
+      &reply,
+      &fbb));
   // Parse the flatbuffer object.
   auto reply_message = flatbuffers::GetRoot<protocol::WaitReply>(reply.data());
   auto found = reply_message->found();
@@ -433,10 +486,12 @@ void raylet::RayletClient::CommitBundleResources(
 }
 
 void raylet::RayletClient::CancelResourceReserve(
-    const BundleSpecification &bundle_spec,
+    const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
     const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback) {
   rpc::CancelResourceReserveRequest request;
-  request.mutable_bundle_spec()->CopyFrom(bundle_spec.GetMessage());
+  for (const auto &bundle_spec : bundle_specs) {
+    request.add_bundle_specs()->CopyFrom(bundle_spec->GetMessage());
+  }
   grpc_client_->CancelResourceReserve(request, callback);
 }
 
@@ -463,16 +518,63 @@ void raylet::RayletClient::PinObjectIDs(
     const rpc::Address &caller_address,
     const std::vector<ObjectID> &object_ids,
     const rpc::ClientCallback<rpc::PinObjectIDsReply> &callback) {
+  pins_in_flight_++;
+  const int64_t max_requests_in_flight =
+      RayConfig::instance().raylet_client_max_pin_requests_in_flight();
+  if (max_requests_in_flight > 0) {
+    absl::MutexLock lock(&pin_mutex_);
+    if (pin_requests_in_flight_ >= max_requests_in_flight) {
+      // Wait for a request to finish, and send this one together with the others that
+      // queue up in the meantime.
+      pending_pins_.push_back({caller_address, object_ids, callback});
+      return;
+    }
+    pin_requests_in_flight_++;
+  }
+  SendPinObjectIDs(caller_address, object_ids, {callback});
+}
+
+void raylet::RayletClient::SendPinObjectIDs(
+    const rpc::Address &caller_address,
+    const std::vector<ObjectID> &object_ids,
+    std::vector<rpc::ClientCallback<rpc::PinObjectIDsReply>> callbacks) {
   rpc::PinObjectIDsRequest request;
   request.mutable_owner_address()->CopyFrom(caller_address);
   for (const ObjectID &object_id : object_ids) {
     request.add_object_ids(object_id.Binary());
   }
-  pins_in_flight_++;
-  auto rpc_callback = [this, callback = std::move(callback)](
+  auto rpc_callback = [this, callbacks = std::move(callbacks)](
                           Status status, const rpc::PinObjectIDsReply &reply) {
-    pins_in_flight_--;
-    callback(status, reply);
+    pins_in_flight_ -= callbacks.size();
+    for (const auto &callback : callbacks) {
+      callback(status, reply);
+    }
+    if (RayConfig::instance().raylet_client_max_pin_requests_in_flight() <= 0) {
+      return;
+    }
+    // Send the pending requests of the owner of the oldest one as a single request.
+    rpc::Address next_caller_address;
+    std::vector<ObjectID> next_object_ids;
+    std::vector<rpc::ClientCallback<rpc::PinObjectIDsReply>> next_callbacks;
+    {
+      absl::MutexLock lock(&pin_mutex_);
+      if (pending_pins_.empty()) {
+        pin_requests_in_flight_--;
+        return;
+      }
+      next_caller_address = pending_pins_.front().caller_address;
+      for (auto it = pending_pins_.begin(); it != pending_pins_.end();) {
+        if (it->caller_address.worker_id() != next_caller_address.worker_id()) {
+          it++;
+          continue;
+        }
+        next_object_ids.insert(
+            next_object_ids.end(), it->object_ids.begin(), it->object_ids.end());
+        next_callbacks.push_back(std::move(it->callback));
+        it = pending_pins_.erase(it);
+      }
+    }
+    SendPinObjectIDs(next_caller_address, next_object_ids, std::move(next_callbacks));
   };
   grpc_client_->PinObjectIDs(request, rpc_callback);
 }
@@ -486,6 +588,27 @@ void raylet::RayletClient::ShutdownRaylet(
   grpc_client_->ShutdownRaylet(request, callback);
 }
 
+void raylet::RayletClient::StealTasks(
+    const NodeID &node_id,
+    const absl::flat_hash_map<std::string, double> &resources_available,
+    const rpc::ClientCallback<rpc::StealTasksReply> &callback) {
+  rpc::StealTasksRequest request;
+  request.set_node_id(node_id.Binary());
+  request.mutable_resources_available()->insert(resources_available.begin(),
+                                                resources_available.end());
+  grpc_client_->StealTasks(request, callback);
+}
+
+void raylet::RayletClient::ProbeNode(
+    const absl::optional<rpc::Address> &target,
+    const rpc::ClientCallback<rpc::ProbeNodeReply> &callback) {
+  rpc::ProbeNodeRequest request;
+  if (target) {
+    request.mutable_target()->CopyFrom(*target);
+  }
+  grpc_client_->ProbeNode(request, callback);
+}
+
 void raylet::RayletClient::GlobalGC(
     const rpc::ClientCallback<rpc::GlobalGCReply> &callback) {
   rpc::GlobalGCRequest request;
@@ -495,15 +618,21 @@ void raylet::RayletClient::GlobalGC(
 void raylet::RayletClient::UpdateResourceUsage(
 
     std::string &serialized_resource_usage_batch,
+    const std::vector<rpc::Address> &forward_to,
     const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) {
   rpc::UpdateResourceUsageRequest request;
   request.set_serialized_resource_usage_batch(serialized_resource_usage_batch);
+  for (const auto &address : forward_to) {
+    request.add_forward_to()->CopyFrom(address);
+  }
   grpc_client_->UpdateResourceUsage(request, callback);
 }
 
 void raylet::RayletClient::RequestResourceReport(
+    int64_t last_report_version,
     const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback) {
   rpc::RequestResourceReportRequest request;
+  request.set_last_report_version(last_report_version);
   grpc_client_->RequestResourceReport(request, callback);
 }
 
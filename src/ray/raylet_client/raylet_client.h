@@ -14,10 +14,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/buffer.h"
 #include "ray/common/bundle_spec.h"
@@ -130,8 +135,11 @@ class ResourceReserveInterface {
       const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
       const ray::rpc::ClientCallback<ray::rpc::CommitBundleResourcesReply> &callback) = 0;
 
+  /// Request a raylet to return the resources of given bundles, whether they are
+  /// prepared or committed. This is used to roll back or remove a placement group.
+  /// \param bundle_specs Bundles reserved at this raylet.
   virtual void CancelResourceReserve(
-      const BundleSpecification &bundle_spec,
+      const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
       const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback) = 0;
 
   virtual void ReleaseUnusedBundles(
@@ -159,11 +167,23 @@ class DependencyWaiterInterface {
 /// Inteface for getting resource reports.
 class ResourceTrackingInterface {
  public:
+  /// Send a batch of resource usage to the raylet.
+  ///
+  /// \param serialized_resource_usage_batch The serialized ResourceUsageBroadcastData.
+  /// \param forward_to The raylets that the raylet relays the batch to.
+  /// \param callback The callback of the RPC.
   virtual void UpdateResourceUsage(
       std::string &serialized_resource_usage_batch,
+      const std::vector<rpc::Address> &forward_to,
       const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) = 0;
 
+  /// Request a resource report from the raylet.
+  ///
+  /// \param last_report_version The version of the last report received from the
+  /// raylet, or 0. The report is only sent if it changed since that version.
+  /// \param callback The callback of the RPC.
   virtual void RequestResourceReport(
+      int64_t last_report_version,
       const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback) = 0;
 
   virtual ~ResourceTrackingInterface(){};
@@ -189,6 +209,24 @@ class RayletClientInterface : public PinObjectsInterface,
       const NodeID &node_id,
       bool graceful,
       const rpc::ClientCallback<rpc::ShutdownRayletReply> &callback) = 0;
+
+  /// Ask the raylet to spill the queued tasks that fit on an idle node to it.
+  ///
+  /// \param node_id The idle node.
+  /// \param resources_available The resources currently available on the idle node.
+  /// \param callback The callback of the RPC.
+  virtual void StealTasks(
+      const NodeID &node_id,
+      const absl::flat_hash_map<std::string, double> &resources_available,
+      const rpc::ClientCallback<rpc::StealTasksReply> &callback) = 0;
+
+  /// Check that the raylet is alive, or ask it to check another raylet.
+  ///
+  /// \param target The raylet to check on the sender's behalf, or nullopt to only
+  /// check this raylet.
+  /// \param callback The callback of the RPC.
+  virtual void ProbeNode(const absl::optional<rpc::Address> &target,
+                         const rpc::ClientCallback<rpc::ProbeNodeReply> &callback) = 0;
 };
 
 namespace raylet {
@@ -217,6 +255,30 @@ class RayletConnection {
                                  std::vector<uint8_t> *reply_message,
                                  flatbuffers::FlatBufferBuilder *fbb = nullptr);
 
+  /// Return a new ID to tag a request sent with PipelinedRequestReply.
+  int64_t NextRequestId() { return next_request_id_++; }
+
+  /// Send a request and wait for its reply, while other threads may have requests
+  /// outstanding on the same connection. The raylet may reply to them in any order, so
+  /// each reply is matched to its request by the request ID it carries: whichever
+  /// waiting thread is reading from the socket hands the replies to the others over.
+  /// This must not be used while an AtomicRequestReply is outstanding.
+  ///
+  /// \param request_type The type of the request.
+  /// \param reply_type The type of the reply. All the requests outstanding at once must
+  /// have the same reply type.
+  /// \param request_id The ID that the request was tagged with, from NextRequestId.
+  /// \param get_request_id Return the request ID of a reply.
+  /// \param[out] reply_message The reply to this request.
+  /// \param fbb The request.
+  ray::Status PipelinedRequestReply(
+      MessageType request_type,
+      MessageType reply_type,
+      int64_t request_id,
+      const std::function<int64_t(const std::vector<uint8_t> &)> &get_request_id,
+      std::vector<uint8_t> *reply_message,
+      flatbuffers::FlatBufferBuilder *fbb);
+
  private:
   /// Shutdown the raylet if the local connection is disconnected.
   void ShutdownIfLocalRayletDisconnected(const Status &status);
@@ -226,6 +288,16 @@ class RayletConnection {
   std::mutex mutex_;
   /// A mutex to protect write operations of the raylet client.
   std::mutex write_mutex_;
+  /// The ID of the next pipelined request.
+  std::atomic<int64_t> next_request_id_{1};
+  /// Protects the pipelined replies below.
+  absl::Mutex reply_mutex_;
+  /// Whether a thread is reading a pipelined reply from the socket.
+  bool reading_reply_ GUARDED_BY(reply_mutex_) = false;
+  /// The pipelined replies that were read from the socket but not yet taken by the
+  /// threads that sent their requests, keyed by request ID.
+  absl::flat_hash_map<int64_t, std::vector<uint8_t>> pending_replies_
+      GUARDED_BY(reply_mutex_);
 };
 
 class RayletClient : public RayletClientInterface {
@@ -424,7 +496,7 @@ class RayletClient : public RayletClientInterface {
 
   /// Implements CancelResourceReserveInterface.
   void CancelResourceReserve(
-      const BundleSpecification &bundle_spec,
+      const std::vector<std::shared_ptr<const BundleSpecification>> &bundle_specs,
       const ray::rpc::ClientCallback<ray::rpc::CancelResourceReserveReply> &callback)
       override;
 
@@ -443,6 +515,13 @@ class RayletClient : public RayletClientInterface {
       bool graceful,
       const rpc::ClientCallback<rpc::ShutdownRayletReply> &callback) override;
 
+  void StealTasks(const NodeID &node_id,
+                  const absl::flat_hash_map<std::string, double> &resources_available,
+                  const rpc::ClientCallback<rpc::StealTasksReply> &callback) override;
+
+  void ProbeNode(const absl::optional<rpc::Address> &target,
+                 const rpc::ClientCallback<rpc::ProbeNodeReply> &callback) override;
+
   void GetSystemConfig(
       const rpc::ClientCallback<rpc::GetSystemConfigReply> &callback) override;
 
@@ -453,9 +532,11 @@ class RayletClient : public RayletClientInterface {
 
   void UpdateResourceUsage(
       std::string &serialized_resource_usage_batch,
+      const std::vector<rpc::Address> &forward_to,
       const rpc::ClientCallback<rpc::UpdateResourceUsageReply> &callback) override;
 
   void RequestResourceReport(
+      int64_t last_report_version,
       const rpc::ClientCallback<rpc::RequestResourceReportReply> &callback) override;
 
   // Subscribe to receive notification on plasma object
@@ -483,9 +564,34 @@ class RayletClient : public RayletClientInterface {
   /// The connection to the raylet server.
   std::unique_ptr<RayletConnection> conn_;
 
+  /// Send a pin request for the given objects, and call all the given callbacks when
+  /// it is done.
+  void SendPinObjectIDs(
+      const rpc::Address &caller_address,
+      const std::vector<ObjectID> &object_ids,
+      std::vector<ray::rpc::ClientCallback<ray::rpc::PinObjectIDsReply>> callbacks);
+
   /// The number of object ID pin RPCs currently in flight.
   std::atomic<int64_t> pins_in_flight_{0};
 
+  /// A pin request that waits for a request in flight to finish, so that it can be
+  /// sent together with the other requests of the same owner.
+  struct PendingPin {
+    rpc::Address caller_address;
+    std::vector<ObjectID> object_ids;
+    ray::rpc::ClientCallback<ray::rpc::PinObjectIDsReply> callback;
+  };
+
+  /// Protects the pending pin requests.
+  absl::Mutex pin_mutex_;
+
+  /// The pin requests waiting to be sent, in the order they were made.
+  std::deque<PendingPin> pending_pins_ GUARDED_BY(pin_mutex_);
+
+  /// The number of pin requests sent to the raylet and not replied yet. Each may
+  /// carry several PinObjectIDs calls.
+  int64_t pin_requests_in_flight_ GUARDED_BY(pin_mutex_) = 0;
+
  protected:
   RayletClient() {}
 };
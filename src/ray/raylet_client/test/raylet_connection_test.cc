@@ -0,0 +1,92 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ray/common/client_connection.h"
+#include "ray/raylet/format/node_manager_generated.h"
+#include "ray/raylet_client/raylet_client.h"
+#include "ray/util/util.h"
+
+namespace ray {
+namespace raylet {
+
+int64_t GetReplyRequestId(const std::vector<uint8_t> &reply) {
+  return flatbuffers::GetRoot<protocol::WaitReply>(reply.data())->request_id();
+}
+
+TEST(RayletConnectionTest, TestPipelinedRepliesOutOfOrder) {
+  instrumented_io_context io_service;
+  const std::string socket_path =
+      "/tmp/raylet_connection_test_" + std::to_string(getpid());
+  std::remove(socket_path.c_str());
+  boost::asio::basic_socket_acceptor<local_stream_protocol> acceptor(
+      io_service, ParseUrlEndpoint(socket_path));
+  RayletConnection connection(io_service, socket_path, /*num_retries=*/1, /*timeout=*/0);
+  local_stream_socket socket(io_service);
+  acceptor.accept(socket);
+  auto raylet = ServerConnection::Create(std::move(socket));
+
+  // Each thread has a request outstanding at the same time.
+  const int num_requests = 8;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; i++) {
+    threads.emplace_back([&connection] {
+      const int64_t request_id = connection.NextRequestId();
+      flatbuffers::FlatBufferBuilder fbb;
+      fbb.Finish(protocol::CreateWaitRequest(
+          fbb, 0, 0, 0, 0, /*mark_worker_blocked=*/false, 0, request_id));
+      std::vector<uint8_t> reply;
+      ASSERT_TRUE(connection
+                      .PipelinedRequestReply(MessageType::WaitRequest,
+                                             MessageType::WaitReply,
+                                             request_id,
+                                             GetReplyRequestId,
+                                             &reply,
+                                             &fbb)
+                      .ok());
+      ASSERT_EQ(GetReplyRequestId(reply), request_id);
+    });
+  }
+
+  // The raylet only replies once it has received all the requests, and in the reverse
+  // order.
+  std::vector<int64_t> request_ids;
+  for (int i = 0; i < num_requests; i++) {
+    std::vector<uint8_t> request;
+    ASSERT_TRUE(
+        raylet->ReadMessage(static_cast<int64_t>(MessageType::WaitRequest), &request)
+            .ok());
+    request_ids.push_back(
+        flatbuffers::GetRoot<protocol::WaitRequest>(request.data())->request_id());
+  }
+  for (auto it = request_ids.rbegin(); it != request_ids.rend(); it++) {
+    flatbuffers::FlatBufferBuilder fbb;
+    fbb.Finish(protocol::CreateWaitReply(fbb, 0, 0, *it));
+    ASSERT_TRUE(raylet
+                    ->WriteMessage(static_cast<int64_t>(MessageType::WaitReply),
+                                   fbb.GetSize(),
+                                   fbb.GetBufferPointer())
+                    .ok());
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::remove(socket_path.c_str());
+}
+
+}  // namespace raylet
+}  // namespace ray
@@ -0,0 +1,129 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/rpc/client_call.h"
+
+#include <algorithm>
+
+#include "ray/common/ray_config.h"
+
+namespace ray {
+namespace rpc {
+
+void ClientCallReceiver::OnCompletion(ClientCallTag *tag, bool ok) {
+  tag->GetCall()->SetReturnStatus();
+  std::shared_ptr<StatsHandle> stats_handle = tag->GetCall()->GetStatsHandle();
+  RAY_CHECK(stats_handle != nullptr);
+  const int64_t received_time = absl::GetCurrentTimeNanos();
+  ray::stats::STATS_grpc_client_req_in_flight.Record(--tag->NumInFlight(),
+                                                     stats_handle->event_name);
+  if (ok) {
+    ray::stats::STATS_grpc_client_req_latency_ms.Record(
+        (received_time - tag->GetSentTime()) / 1000000.0, stats_handle->event_name);
+  }
+  {
+    // Post under the lock, so that nothing is posted once the manager is destroyed.
+    absl::MutexLock lock(&mutex_);
+    if (ok && !main_service_.stopped() && !shutdown_) {
+      // Post the callback to the main event loop.
+      main_service_.post(
+          [tag, received_time]() {
+            ray::stats::STATS_grpc_client_req_callback_queue_time_ms.Record(
+                (absl::GetCurrentTimeNanos() - received_time) / 1000000.0,
+                tag->GetCall()->GetStatsHandle()->event_name);
+            tag->GetCall()->OnReplyReceived();
+            // The call is finished, and we can delete this tag now.
+            delete tag;
+          },
+          std::move(stats_handle));
+      return;
+    }
+  }
+  delete tag;
+}
+
+ClientCompletionQueues::ClientCompletionQueues(int num_threads) : shutdown_(false) {
+  RAY_CHECK(num_threads > 0);
+  rr_index_ = rand() % num_threads;
+  // Start the polling threads.
+  cqs_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    cqs_.push_back(std::make_unique<grpc::CompletionQueue>());
+  }
+  for (int i = 0; i < num_threads; i++) {
+    polling_threads_.emplace_back(
+        &ClientCompletionQueues::PollEventsFromCompletionQueue, this, i);
+  }
+}
+
+ClientCompletionQueues::~ClientCompletionQueues() {
+  shutdown_ = true;
+  for (auto &cq : cqs_) {
+    cq->Shutdown();
+  }
+  for (auto &polling_thread : polling_threads_) {
+    polling_thread.join();
+  }
+}
+
+ClientCompletionQueues *ClientCompletionQueues::Shared() {
+  static ClientCompletionQueues *shared = []() -> ClientCompletionQueues * {
+    int64_t num_threads = RayConfig::instance().grpc_client_shared_cq_threads();
+    if (num_threads < 0) {
+      return nullptr;
+    }
+    if (num_threads == 0) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Never destroyed, so that the threads keep polling for as long as any manager
+    // might use them.
+    return new ClientCompletionQueues(num_threads);
+  }();
+  return shared;
+}
+
+void ClientCompletionQueues::PollEventsFromCompletionQueue(int index) {
+  SetThreadName("client.poll" + std::to_string(index));
+  void *got_tag = nullptr;
+  bool ok = false;
+  // Keep reading events from the `CompletionQueue` until it's shutdown.
+  // NOTE(edoakes): we use AsyncNext here because for some unknown reason,
+  // synchronous cq_.Next blocks indefinitely in the case that the process
+  // received a SIGTERM.
+  while (true) {
+    auto deadline = gpr_time_add(gpr_now(GPR_CLOCK_REALTIME),
+                                 gpr_time_from_millis(250, GPR_TIMESPAN));
+    auto status = cqs_[index]->AsyncNext(&got_tag, &ok, deadline);
+    if (status == grpc::CompletionQueue::SHUTDOWN) {
+      break;
+    } else if (status == grpc::CompletionQueue::TIMEOUT && shutdown_) {
+      // If we timed out and shutdown, then exit immediately. This should not
+      // be needed, but gRPC seems to not return SHUTDOWN correctly in these
+      // cases (e.g., test_wait will hang on shutdown without this check).
+      break;
+    } else if (status != grpc::CompletionQueue::TIMEOUT) {
+      // NOTE: CompletionQueue::TIMEOUT and gRPC deadline exceeded are different.
+      // If the client deadline is exceeded, event is obtained at this block.
+      auto tag = reinterpret_cast<ClientCallTag *>(got_tag);
+      // Refresh the tag.
+      got_tag = nullptr;
+      // Hold the receiver, since handing the tag over may delete it.
+      auto receiver = tag->GetReceiver();
+      receiver->OnCompletion(tag, ok && !shutdown_);
+    }
+  }
+}
+
+}  // namespace rpc
+}  // namespace ray
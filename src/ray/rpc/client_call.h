@@ -14,15 +14,22 @@
 
 #pragma once
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
 #include <boost/asio.hpp>
 #include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/grpc_util.h"
 #include "ray/common/status.h"
+#include "ray/rpc/common.h"
+#include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
 
 namespace ray {
@@ -49,6 +56,7 @@ class ClientCall {
 };
 
 class ClientCallManager;
+class ClientCallReceiver;
 
 /// Represents the client callback function of a particular rpc method.
 ///
@@ -69,7 +77,9 @@ class ClientCallImpl : public ClientCall {
   explicit ClientCallImpl(const ClientCallback<Reply> &callback,
                           std::shared_ptr<StatsHandle> stats_handle,
                           int64_t timeout_ms = -1)
-      : callback_(std::move(const_cast<ClientCallback<Reply> &>(callback))),
+      : reply_arena_(reply_arena_block_, sizeof(reply_arena_block_)),
+        reply_(google::protobuf::Arena::CreateMessage<Reply>(&reply_arena_)),
+        callback_(std::move(const_cast<ClientCallback<Reply> &>(callback))),
         stats_handle_(std::move(stats_handle)) {
     if (timeout_ms != -1) {
       auto deadline =
@@ -95,15 +105,26 @@ class ClientCallImpl : public ClientCall {
       status = return_status_;
     }
     if (callback_ != nullptr) {
-      callback_(status, reply_);
+      callback_(status, *reply_);
     }
   }
 
   std::shared_ptr<StatsHandle> GetStatsHandle() override { return stats_handle_; }
 
  private:
-  /// The reply message.
-  Reply reply_;
+  /// The size of the block, embedded in the call, that the reply is allocated from.
+  /// Replies that don't fit in it allocate more blocks from the heap.
+  static constexpr size_t kReplyArenaInitialBlockSize = 512;
+
+  /// The initial block of `reply_arena_`.
+  alignas(8) char reply_arena_block_[kReplyArenaInitialBlockSize];
+
+  /// The arena that the reply message and its fields are allocated from, so that
+  /// small replies don't allocate at all.
+  google::protobuf::Arena reply_arena_;
+
+  /// The reply message, owned by `reply_arena_`.
+  Reply *reply_;
 
   /// The callback function to handle the reply.
   ClientCallback<Reply> callback_;
@@ -150,13 +171,104 @@ class ClientCallTag {
   /// Constructor.
   ///
   /// \param call A `ClientCall` that represents a request.
-  explicit ClientCallTag(std::shared_ptr<ClientCall> call) : call_(std::move(call)) {}
+  /// \param receiver Where the reply of the request is posted to.
+  /// \param num_in_flight The number of requests of the method that are in flight in
+  /// the process, which already counts this one.
+  ClientCallTag(std::shared_ptr<ClientCall> call,
+                std::shared_ptr<ClientCallReceiver> receiver,
+                std::atomic<int64_t> &num_in_flight)
+      : call_(std::move(call)),
+        receiver_(std::move(receiver)),
+        num_in_flight_(num_in_flight),
+        sent_time_(absl::GetCurrentTimeNanos()) {}
 
   /// Get the wrapped `ClientCall`.
   const std::shared_ptr<ClientCall> &GetCall() const { return call_; }
 
+  /// Get where the reply of the request is posted to.
+  const std::shared_ptr<ClientCallReceiver> &GetReceiver() const { return receiver_; }
+
+  /// Get the number of requests of the method that are in flight in the process.
+  std::atomic<int64_t> &NumInFlight() const { return num_in_flight_; }
+
+  /// Get the time at which the request was sent, in nanoseconds.
+  int64_t GetSentTime() const { return sent_time_; }
+
  private:
   std::shared_ptr<ClientCall> call_;
+  std::shared_ptr<ClientCallReceiver> receiver_;
+  std::atomic<int64_t> &num_in_flight_;
+  int64_t sent_time_;
+};
+
+/// Posts the replies of the requests of a `ClientCallManager` to its main event loop.
+/// The tags of the requests in flight share it with the manager, so that replies that
+/// arrive after the manager is destroyed are dropped instead of posted.
+class ClientCallReceiver {
+ public:
+  explicit ClientCallReceiver(instrumented_io_context &main_service)
+      : main_service_(main_service) {}
+
+  /// Post the callback of the request of a tag that was polled from a completion queue
+  /// to the main event loop, and delete the tag once the callback has run. If the
+  /// request failed or the manager was destroyed, the tag is deleted right away.
+  ///
+  /// \param tag The tag of the request.
+  /// \param ok Whether the completion queue reported the request as successful.
+  void OnCompletion(ClientCallTag *tag, bool ok);
+
+  /// Drop the replies of all the requests that complete from now on.
+  void Shutdown() {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+
+ private:
+  /// The main event loop, to which the callback functions will be posted.
+  instrumented_io_context &main_service_;
+
+  absl::Mutex mutex_;
+
+  /// Whether the manager has been destroyed.
+  bool shutdown_ GUARDED_BY(mutex_) = false;
+};
+
+/// A set of gRPC `CompletionQueue`s that outgoing requests are sent on, each polled by
+/// a thread of its own, which hands the completed requests to their receivers.
+class ClientCompletionQueues {
+ public:
+  /// Constructor.
+  ///
+  /// \param num_threads The number of queues, and of the threads that poll them.
+  explicit ClientCompletionQueues(int num_threads);
+
+  ~ClientCompletionQueues();
+
+  /// Get the queue to send the next request on, in a round-robin fashion.
+  grpc::CompletionQueue *Next() { return cqs_[rr_index_++ % cqs_.size()].get(); }
+
+  /// Get the queues shared by all the `ClientCallManager`s of this process, as
+  /// configured by `grpc_client_shared_cq_threads` when this is first called.
+  ///
+  /// \return The shared queues, or nullptr if every manager should poll its own queues.
+  static ClientCompletionQueues *Shared();
+
+ private:
+  /// This function runs in a background thread. It keeps polling events from the
+  /// `CompletionQueue`, and hands the completed requests to their receivers.
+  void PollEventsFromCompletionQueue(int index);
+
+  /// Whether the queues have shut down.
+  std::atomic<bool> shutdown_;
+
+  /// The index to send RPCs in a round-robin fashion
+  std::atomic<unsigned int> rr_index_;
+
+  /// The gRPC `CompletionQueue` objects used to poll events.
+  std::vector<std::unique_ptr<grpc::CompletionQueue>> cqs_;
+
+  /// Polling threads to check the completion queues.
+  std::vector<std::thread> polling_threads_;
 };
 
 /// Represents the generic signature of a `FooService::Stub::PrepareAsyncBar`
@@ -174,8 +286,10 @@ using PrepareAsyncFunction = std::unique_ptr<grpc::ClientAsyncResponseReader<Rep
 /// `ClientCallManager` is used to manage outgoing gRPC requests and the lifecycles of
 /// `ClientCall` objects.
 ///
-/// It maintains a thread that keeps polling events from `CompletionQueue`, and post
-/// the callback function to the main event loop when a reply is received.
+/// It maintains threads that keep polling events from `CompletionQueue`s, and post
+/// the callback function to the main event loop when a reply is received. If
+/// `grpc_client_shared_cq_threads` is set, the queues and their threads are shared by
+/// all the managers of the process instead.
 ///
 /// Multiple clients can share one `ClientCallManager`.
 class ClientCallManager {
@@ -188,27 +302,19 @@ class ClientCallManager {
                              int num_threads = 1,
                              int64_t call_timeout_ms = -1)
       : main_service_(main_service),
-        num_threads_(num_threads),
-        shutdown_(false),
+        receiver_(std::make_shared<ClientCallReceiver>(main_service)),
+        cqs_(ClientCompletionQueues::Shared()),
         call_timeout_ms_(call_timeout_ms) {
-    rr_index_ = rand() % num_threads_;
-    // Start the polling threads.
-    cqs_.reserve(num_threads_);
-    for (int i = 0; i < num_threads_; i++) {
-      cqs_.push_back(std::make_unique<grpc::CompletionQueue>());
-      polling_threads_.emplace_back(
-          &ClientCallManager::PollEventsFromCompletionQueue, this, i);
+    if (cqs_ == nullptr) {
+      own_cqs_ = std::make_unique<ClientCompletionQueues>(num_threads);
+      cqs_ = own_cqs_.get();
     }
   }
 
   ~ClientCallManager() {
-    shutdown_ = true;
-    for (auto &cq : cqs_) {
-      cq->Shutdown();
-    }
-    for (auto &polling_thread : polling_threads_) {
-      polling_thread.join();
-    }
+    // Drop the replies that arrive from now on, whether they are polled by our own
+    // threads (which are joined when `own_cqs_` is destroyed) or the shared ones.
+    receiver_->Shutdown();
   }
 
   /// Create a new `ClientCall` and send request.
@@ -235,6 +341,37 @@ class ClientCallManager {
       const ClientCallback<Reply> &callback,
       std::string call_name,
       int64_t method_timeout_ms = -1) {
+    return CreateCall<Reply>(
+        [&stub, prepare_async_function, &request](grpc::ClientContext *context,
+                                                  grpc::CompletionQueue *cq) {
+          return (stub.*prepare_async_function)(context, request, cq);
+        },
+        callback,
+        std::move(call_name),
+        method_timeout_ms);
+  }
+
+  /// Create a new `ClientCall` and send the request prepared by the given function.
+  ///
+  /// \tparam Reply Type of the reply message.
+  /// \tparam PrepareAsyncCall Type of a function that takes a `grpc::ClientContext *`
+  /// and a `grpc::CompletionQueue *`, and returns the
+  /// `grpc::ClientAsyncResponseReader<Reply>` of the request, e.g. from a generic stub.
+  ///
+  /// \param[in] prepare_async_call The function that prepares the call of the request.
+  /// \param[in] callback The callback function that handles reply.
+  /// \param[in] call_name The name of the gRPC method call.
+  /// \param[in] method_timeout_ms The timeout of the RPC method in ms.
+  /// -1 means it will use the default timeout configured for the handler.
+  ///
+  /// \return A `ClientCall` representing the request that was just sent.
+  template <class Reply, class PrepareAsyncCall>
+  std::shared_ptr<ClientCall> CreateCall(const PrepareAsyncCall &prepare_async_call,
+                                         const ClientCallback<Reply> &callback,
+                                         std::string call_name,
+                                         int64_t method_timeout_ms = -1) {
+    auto &num_in_flight = InFlightCallCounter(call_name);
+    ray::stats::STATS_grpc_client_req_in_flight.Record(++num_in_flight, call_name);
     auto stats_handle = main_service_.stats().RecordStart(call_name);
     if (method_timeout_ms == -1) {
       method_timeout_ms = call_timeout_ms_;
@@ -243,86 +380,32 @@ class ClientCallManager {
         callback, std::move(stats_handle), method_timeout_ms);
     // Send request.
     // Find the next completion queue to wait for response.
-    call->response_reader_ = (stub.*prepare_async_function)(
-        &call->context_, request, cqs_[rr_index_++ % num_threads_].get());
+    call->response_reader_ = prepare_async_call(&call->context_, cqs_->Next());
     call->response_reader_->StartCall();
     // Create a new tag object. This object will eventually be deleted in the
-    // `ClientCallManager::PollEventsFromCompletionQueue` when reply is received.
+    // `ClientCallReceiver::OnCompletion` when reply is received.
     //
     // NOTE(chen): Unlike `ServerCall`, we can't directly use `ClientCall` as the tag.
     // Because this function must return a `shared_ptr` to make sure the returned
     // `ClientCall` is safe to use. But `response_reader_->Finish` only accepts a raw
     // pointer.
-    auto tag = new ClientCallTag(call);
-    call->response_reader_->Finish(&call->reply_, &call->status_, (void *)tag);
+    auto tag = new ClientCallTag(call, receiver_, num_in_flight);
+    call->response_reader_->Finish(call->reply_, &call->status_, (void *)tag);
     return call;
   }
 
  private:
-  /// This function runs in a background thread. It keeps polling events from the
-  /// `CompletionQueue`, and dispatches the event to the callbacks via the `ClientCall`
-  /// objects.
-  void PollEventsFromCompletionQueue(int index) {
-    SetThreadName("client.poll" + std::to_string(index));
-    void *got_tag = nullptr;
-    bool ok = false;
-    // Keep reading events from the `CompletionQueue` until it's shutdown.
-    // NOTE(edoakes): we use AsyncNext here because for some unknown reason,
-    // synchronous cq_.Next blocks indefinitely in the case that the process
-    // received a SIGTERM.
-    while (true) {
-      auto deadline = gpr_time_add(gpr_now(GPR_CLOCK_REALTIME),
-                                   gpr_time_from_millis(250, GPR_TIMESPAN));
-      auto status = cqs_[index]->AsyncNext(&got_tag, &ok, deadline);
-      if (status == grpc::CompletionQueue::SHUTDOWN) {
-        break;
-      } else if (status == grpc::CompletionQueue::TIMEOUT && shutdown_) {
-        // If we timed out and shutdown, then exit immediately. This should not
-        // be needed, but gRPC seems to not return SHUTDOWN correctly in these
-        // cases (e.g., test_wait will hang on shutdown without this check).
-        break;
-      } else if (status != grpc::CompletionQueue::TIMEOUT) {
-        // NOTE: CompletionQueue::TIMEOUT and gRPC deadline exceeded are different.
-        // If the client deadline is exceeded, event is obtained at this block.
-        auto tag = reinterpret_cast<ClientCallTag *>(got_tag);
-        // Refresh the tag.
-        got_tag = nullptr;
-        tag->GetCall()->SetReturnStatus();
-        std::shared_ptr<StatsHandle> stats_handle = tag->GetCall()->GetStatsHandle();
-        RAY_CHECK(stats_handle != nullptr);
-        if (ok && !main_service_.stopped() && !shutdown_) {
-          // Post the callback to the main event loop.
-          main_service_.post(
-              [tag]() {
-                tag->GetCall()->OnReplyReceived();
-                // The call is finished, and we can delete this tag now.
-                delete tag;
-              },
-              std::move(stats_handle));
-        } else {
-          delete tag;
-        }
-      }
-    }
-  }
-
   /// The main event loop, to which the callback functions will be posted.
   instrumented_io_context &main_service_;
 
-  /// The number of polling threads.
-  int num_threads_;
-
-  /// Whether the client has shutdown.
-  std::atomic<bool> shutdown_;
-
-  /// The index to send RPCs in a round-robin fashion
-  std::atomic<unsigned int> rr_index_;
+  /// Where the replies of the requests are posted to.
+  std::shared_ptr<ClientCallReceiver> receiver_;
 
-  /// The gRPC `CompletionQueue` object used to poll events.
-  std::vector<std::unique_ptr<grpc::CompletionQueue>> cqs_;
+  /// The queues that requests are sent on, either the shared ones or `own_cqs_`.
+  ClientCompletionQueues *cqs_;
 
-  /// Polling threads to check the completion queue.
-  std::vector<std::thread> polling_threads_;
+  /// The queues of this manager, if it doesn't use the shared ones.
+  std::unique_ptr<ClientCompletionQueues> own_cqs_;
 
   // Timeout in ms for calls created.
   int64_t call_timeout_ms_;
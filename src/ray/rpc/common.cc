@@ -17,6 +17,9 @@
 #include <fstream>
 #include <sstream>
 
+#include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 namespace ray::rpc {
 
 std::string ReadCert(const std::string &cert_filepath) {
@@ -26,4 +29,12 @@ std::string ReadCert(const std::string &cert_filepath) {
   return buffer.str();
 };
 
+std::atomic<int64_t> &InFlightCallCounter(const std::string &call_name) {
+  static absl::Mutex mutex;
+  // Counters are never erased, and a node map keeps their addresses stable.
+  static auto *counters = new absl::node_hash_map<std::string, std::atomic<int64_t>>();
+  absl::MutexLock lock(&mutex);
+  return (*counters)[call_name];
+}
+
 }  // namespace ray::rpc
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 namespace ray::rpc {
@@ -19,4 +21,10 @@ namespace ray::rpc {
 // Utility to read cert file from a particular location
 std::string ReadCert(const std::string &cert_filepath);
 
+/// Get the number of calls of a gRPC method that are in flight in this process, over
+/// all the servers, or all the clients, of the method. The counter is never destroyed.
+///
+/// \param call_name The name of the method, as recorded in the metrics.
+std::atomic<int64_t> &InFlightCallCounter(const std::string &call_name);
+
 }  // namespace ray::rpc
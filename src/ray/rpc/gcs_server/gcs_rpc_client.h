@@ -209,6 +209,12 @@ class GcsRpcClient {
                              actor_info_grpc_client_,
                              /*method_timeout_ms*/ -1, )
 
+  /// Register a batch of actors via GCS Service.
+  VOID_GCS_RPC_CLIENT_METHOD(ActorInfoGcsService,
+                             RegisterActors,
+                             actor_info_grpc_client_,
+                             /*method_timeout_ms*/ -1, )
+
   /// Create actor via GCS Service.
   VOID_GCS_RPC_CLIENT_METHOD(ActorInfoGcsService,
                              CreateActor,
@@ -305,6 +311,12 @@ class GcsRpcClient {
                              heartbeat_info_grpc_client_,
                              /*method_timeout_ms*/ -1, )
 
+  /// Report a node that didn't reply to probes to GCS Service.
+  VOID_GCS_RPC_CLIENT_METHOD(HeartbeatInfoGcsService,
+                             ReportNodeSuspected,
+                             heartbeat_info_grpc_client_,
+                             /*method_timeout_ms*/ -1, )
+
   /// Add profile data to GCS Service.
   VOID_GCS_RPC_CLIENT_METHOD(StatsGcsService,
                              AddProfileData,
@@ -317,6 +329,12 @@ class GcsRpcClient {
                              stats_grpc_client_,
                              /*method_timeout_ms*/ -1, )
 
+  /// Profile the CPU use of the GCS server for the requested duration.
+  VOID_GCS_RPC_CLIENT_METHOD(StatsGcsService,
+                             ProfileGcsCpu,
+                             stats_grpc_client_,
+                             /*method_timeout_ms*/ -1, )
+
   /// Report a worker failure to GCS Service.
   VOID_GCS_RPC_CLIENT_METHOD(WorkerInfoGcsService,
                              ReportWorkerFailure,
@@ -397,6 +415,14 @@ class GcsRpcClient {
                              InternalKVKeys,
                              internal_kv_grpc_client_,
                              /*method_timeout_ms*/ -1, )
+  VOID_GCS_RPC_CLIENT_METHOD(InternalKVGcsService,
+                             InternalKVMultiGet,
+                             internal_kv_grpc_client_,
+                             /*method_timeout_ms*/ -1, )
+  VOID_GCS_RPC_CLIENT_METHOD(InternalKVGcsService,
+                             InternalKVMultiPut,
+                             internal_kv_grpc_client_,
+                             /*method_timeout_ms*/ -1, )
 
   /// Operations for pubsub
   VOID_GCS_RPC_CLIENT_METHOD(InternalPubSubGcsService,
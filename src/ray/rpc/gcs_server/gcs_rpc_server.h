@@ -141,6 +141,10 @@ class ActorInfoGcsServiceHandler {
                                    RegisterActorReply *reply,
                                    SendReplyCallback send_reply_callback) = 0;
 
+  virtual void HandleRegisterActors(const RegisterActorsRequest &request,
+                                    RegisterActorsReply *reply,
+                                    SendReplyCallback send_reply_callback) = 0;
+
   virtual void HandleCreateActor(const CreateActorRequest &request,
                                  CreateActorReply *reply,
                                  SendReplyCallback send_reply_callback) = 0;
@@ -185,6 +189,7 @@ class ActorInfoGrpcService : public GrpcService {
     /// Register/Create Actor RPC takes long time, we shouldn't limit them to avoid
     /// distributed deadlock.
     ACTOR_INFO_SERVICE_RPC_HANDLER(RegisterActor, -1);
+    ACTOR_INFO_SERVICE_RPC_HANDLER(RegisterActors, -1);
     ACTOR_INFO_SERVICE_RPC_HANDLER(CreateActor, -1);
 
     /// Others need back pressure.
@@ -317,6 +322,9 @@ class HeartbeatInfoGcsServiceHandler {
   virtual void HandleCheckAlive(const CheckAliveRequest &request,
                                 CheckAliveReply *reply,
                                 SendReplyCallback send_reply_callback) = 0;
+  virtual void HandleReportNodeSuspected(const ReportNodeSuspectedRequest &request,
+                                         ReportNodeSuspectedReply *reply,
+                                         SendReplyCallback send_reply_callback) = 0;
 };
 /// The `GrpcService` for `HeartbeatInfoGcsService`.
 class HeartbeatInfoGrpcService : public GrpcService {
@@ -335,6 +343,7 @@ class HeartbeatInfoGrpcService : public GrpcService {
       std::vector<std::unique_ptr<ServerCallFactory>> *server_call_factories) override {
     HEARTBEAT_INFO_SERVICE_RPC_HANDLER(ReportHeartbeat);
     HEARTBEAT_INFO_SERVICE_RPC_HANDLER(CheckAlive);
+    HEARTBEAT_INFO_SERVICE_RPC_HANDLER(ReportNodeSuspected);
   }
 
  private:
@@ -355,6 +364,10 @@ class StatsGcsServiceHandler {
   virtual void HandleGetAllProfileInfo(const GetAllProfileInfoRequest &request,
                                        GetAllProfileInfoReply *reply,
                                        SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleProfileGcsCpu(const ProfileGcsCpuRequest &request,
+                                   ProfileGcsCpuReply *reply,
+                                   SendReplyCallback send_reply_callback) = 0;
 };
 
 /// The `GrpcService` for `StatsGcsService`.
@@ -375,6 +388,7 @@ class StatsGrpcService : public GrpcService {
       std::vector<std::unique_ptr<ServerCallFactory>> *server_call_factories) override {
     STATS_SERVICE_RPC_HANDLER(AddProfileData);
     STATS_SERVICE_RPC_HANDLER(GetAllProfileInfo);
+    STATS_SERVICE_RPC_HANDLER(ProfileGcsCpu);
   }
 
  private:
@@ -517,6 +531,14 @@ class InternalKVGcsServiceHandler {
   virtual void HandleInternalKVExists(const InternalKVExistsRequest &request,
                                       InternalKVExistsReply *reply,
                                       SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleInternalKVMultiGet(const InternalKVMultiGetRequest &request,
+                                        InternalKVMultiGetReply *reply,
+                                        SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleInternalKVMultiPut(const InternalKVMultiPutRequest &request,
+                                        InternalKVMultiPutReply *reply,
+                                        SendReplyCallback send_reply_callback) = 0;
 };
 
 class InternalKVGrpcService : public GrpcService {
@@ -535,6 +557,8 @@ class InternalKVGrpcService : public GrpcService {
     INTERNAL_KV_SERVICE_RPC_HANDLER(InternalKVDel);
     INTERNAL_KV_SERVICE_RPC_HANDLER(InternalKVExists);
     INTERNAL_KV_SERVICE_RPC_HANDLER(InternalKVKeys);
+    INTERNAL_KV_SERVICE_RPC_HANDLER(InternalKVMultiGet);
+    INTERNAL_KV_SERVICE_RPC_HANDLER(InternalKVMultiPut);
   }
 
  private:
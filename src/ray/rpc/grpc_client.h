@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/grpcpp.h>
 
 #include <boost/asio.hpp>
@@ -59,29 +61,58 @@ class GrpcClient {
     argument.SetInt(GRPC_ARG_ENABLE_HTTP_PROXY, 0);
     argument.SetMaxSendMessageSize(::RayConfig::instance().max_grpc_message_size());
     argument.SetMaxReceiveMessageSize(::RayConfig::instance().max_grpc_message_size());
+    SetIdleTimeout(&argument);
 
-    std::shared_ptr<grpc::Channel> channel = BuildChannel(argument, address, port);
+    std::shared_ptr<grpc::Channel> channel =
+        BuildChannel(argument, address + ":" + std::to_string(port));
 
     stub_ = GrpcService::NewStub(channel);
+    generic_stub_ = std::make_unique<grpc::GenericStub>(channel);
   }
 
+  /// Connect to a server that listens on a unix domain socket.
+  ///
+  /// \param[in] unix_socket_path The path of the socket file.
+  GrpcClient(const std::string &unix_socket_path, ClientCallManager &call_manager)
+      : client_call_manager_(call_manager), use_tls_(false) {
+    grpc::ChannelArguments argument;
+    argument.SetMaxSendMessageSize(::RayConfig::instance().max_grpc_message_size());
+    argument.SetMaxReceiveMessageSize(::RayConfig::instance().max_grpc_message_size());
+    SetIdleTimeout(&argument);
+
+    std::shared_ptr<grpc::Channel> channel =
+        BuildChannel(argument, "unix:" + unix_socket_path);
+
+    stub_ = GrpcService::NewStub(channel);
+    generic_stub_ = std::make_unique<grpc::GenericStub>(channel);
+  }
+
+  /// \param[in] compression The algorithm to compress the requests with. The server
+  /// tells gRPC which algorithms it supports, and it falls back to no compression.
   GrpcClient(const std::string &address,
              const int port,
              ClientCallManager &call_manager,
              int num_threads,
-             bool use_tls = false)
+             bool use_tls = false,
+             grpc_compression_algorithm compression = GRPC_COMPRESS_NONE)
       : client_call_manager_(call_manager), use_tls_(use_tls) {
     grpc::ResourceQuota quota;
     quota.SetMaxThreads(num_threads);
     grpc::ChannelArguments argument;
     argument.SetResourceQuota(quota);
+    if (compression != GRPC_COMPRESS_NONE) {
+      argument.SetCompressionAlgorithm(compression);
+    }
     argument.SetInt(GRPC_ARG_ENABLE_HTTP_PROXY, 0);
     argument.SetMaxSendMessageSize(::RayConfig::instance().max_grpc_message_size());
     argument.SetMaxReceiveMessageSize(::RayConfig::instance().max_grpc_message_size());
+    SetIdleTimeout(&argument);
 
-    std::shared_ptr<grpc::Channel> channel = BuildChannel(argument, address, port);
+    std::shared_ptr<grpc::Channel> channel =
+        BuildChannel(argument, address + ":" + std::to_string(port));
 
     stub_ = GrpcService::NewStub(channel);
+    generic_stub_ = std::make_unique<grpc::GenericStub>(channel);
   }
 
   /// Create a new `ClientCall` and send request.
@@ -115,16 +146,65 @@ class GrpcClient {
     RAY_CHECK(call != nullptr);
   }
 
+  /// Create a new `ClientCall` and send a request that the caller serialized, e.g. to
+  /// send parts of it straight from memory that the request doesn't own.
+  ///
+  /// \tparam Reply Type of the reply message.
+  ///
+  /// \param[in] method The full name of the gRPC method, "/package.Service/Method".
+  /// \param[in] request The serialized request message.
+  /// \param[in] callback The callback function that handles reply.
+  /// \param[in] call_name The name of the gRPC method call.
+  /// \param[in] method_timeout_ms The timeout of the RPC method in ms.
+  /// -1 means it will use the default timeout configured for the handler.
+  template <class Reply>
+  void CallMethodWithSerializedRequest(const std::string &method,
+                                       const grpc::ByteBuffer &request,
+                                       const ClientCallback<Reply> &callback,
+                                       std::string call_name = "UNKNOWN_RPC",
+                                       int64_t method_timeout_ms = -1) {
+    ClientCallback<grpc::ByteBuffer> parse_reply =
+        [callback](const Status &status, const grpc::ByteBuffer &serialized_reply) {
+          Reply reply;
+          if (!status.ok()) {
+            callback(status, reply);
+            return;
+          }
+          grpc::ByteBuffer buffer(serialized_reply);
+          auto parse_status =
+              grpc::SerializationTraits<Reply>::Deserialize(&buffer, &reply);
+          callback(GrpcStatusToRayStatus(parse_status), reply);
+        };
+    auto call = client_call_manager_.CreateCall<grpc::ByteBuffer>(
+        [this, &method, &request](grpc::ClientContext *context,
+                                  grpc::CompletionQueue *cq) {
+          return generic_stub_->PrepareUnaryCall(context, method, request, cq);
+        },
+        parse_reply,
+        std::move(call_name),
+        method_timeout_ms);
+    RAY_CHECK(call != nullptr);
+  }
+
  private:
   ClientCallManager &client_call_manager_;
   /// The gRPC-generated stub.
   std::unique_ptr<typename GrpcService::Stub> stub_;
+  /// The stub for requests serialized by the caller, on the same channel.
+  std::unique_ptr<grpc::GenericStub> generic_stub_;
   /// Whether to use TLS.
   bool use_tls_;
 
+  /// Make the channel close its connection when it's idle, if configured to.
+  static void SetIdleTimeout(grpc::ChannelArguments *argument) {
+    const int64_t idle_timeout_ms = ::RayConfig::instance().grpc_client_idle_timeout_ms();
+    if (idle_timeout_ms >= 0) {
+      argument->SetInt(GRPC_ARG_CLIENT_IDLE_TIMEOUT_MS, idle_timeout_ms);
+    }
+  }
+
   std::shared_ptr<grpc::Channel> BuildChannel(const grpc::ChannelArguments &argument,
-                                              const std::string &address,
-                                              int port) {
+                                              const std::string &target) {
     std::shared_ptr<grpc::Channel> channel;
     if (::RayConfig::instance().USE_TLS()) {
       std::string server_cert_file =
@@ -140,12 +220,10 @@ class GrpcClient {
       ssl_opts.pem_private_key = private_key;
       ssl_opts.pem_cert_chain = server_cert_chain;
       auto ssl_creds = grpc::SslCredentials(ssl_opts);
-      channel = grpc::CreateCustomChannel(
-          address + ":" + std::to_string(port), ssl_creds, argument);
+      channel = grpc::CreateCustomChannel(target, ssl_creds, argument);
     } else {
-      channel = grpc::CreateCustomChannel(address + ":" + std::to_string(port),
-                                          grpc::InsecureChannelCredentials(),
-                                          argument);
+      channel = grpc::CreateCustomChannel(
+          target, grpc::InsecureChannelCredentials(), argument);
     }
     return channel;
   };
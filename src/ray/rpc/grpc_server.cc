@@ -16,6 +16,7 @@
 
 #include <grpcpp/impl/service_type.h>
 
+#include <algorithm>
 #include <boost/asio/detail/socket_holder.hpp>
 
 #include "ray/common/ray_config.h"
@@ -74,8 +75,17 @@ void GrpcServer::Run() {
     std::shared_ptr<grpc::ServerCredentials> server_creds;
     server_creds = grpc::SslServerCredentials(ssl_opts);
     builder.AddListeningPort(server_address, server_creds, &port_);
+    if (!unix_socket_path_.empty()) {
+      std::remove(unix_socket_path_.c_str());
+      builder.AddListeningPort("unix:" + unix_socket_path_, server_creds);
+    }
   } else {
     builder.AddListeningPort(server_address, grpc::InsecureServerCredentials(), &port_);
+    if (!unix_socket_path_.empty()) {
+      std::remove(unix_socket_path_.c_str());
+      builder.AddListeningPort("unix:" + unix_socket_path_,
+                               grpc::InsecureServerCredentials());
+    }
   }
   // Register all the services to this server.
   if (services_.empty()) {
@@ -104,19 +114,20 @@ void GrpcServer::Run() {
   RAY_CHECK(port_ > 0);
   RAY_LOG(INFO) << name_ << " server started, listening on port " << port_ << ".";
 
-  // Create calls for all the server call factories.
+  // Create calls for all the server call factories. There is a factory per RPC handler
+  // per completion queue.
   for (auto &entry : server_call_factories_) {
-    for (int i = 0; i < num_threads_; i++) {
-      // Create a buffer of 100 calls for each RPC handler.
-      // TODO(edoakes): a small buffer should be fine and seems to have better
-      // performance, but we don't currently handle backpressure on the client.
-      int buffer_size = 100;
-      if (entry->GetMaxActiveRPCs() != -1) {
-        buffer_size = entry->GetMaxActiveRPCs();
-      }
-      for (int j = 0; j < buffer_size; j++) {
-        entry->CreateCall();
-      }
+    // Start with a small buffer of calls for each RPC handler, which grows up to
+    // `grpc_server_max_pending_calls` when bursts of requests take all of them.
+    int64_t buffer_size = std::max<int64_t>(
+        1,
+        std::min(RayConfig::instance().grpc_server_initial_pending_calls(),
+                 RayConfig::instance().grpc_server_max_pending_calls()));
+    if (entry->GetMaxActiveRPCs() != -1) {
+      buffer_size = entry->GetMaxActiveRPCs();
+    }
+    for (int64_t j = 0; j < buffer_size; j++) {
+      entry->CreateCall();
     }
   }
   // Start threads that polls incoming requests.
@@ -153,6 +164,7 @@ void GrpcServer::PollEventsFromCompletionQueue(int index) {
         // We've received a new incoming request. Now this call object is used to
         // track this request.
         server_call->SetState(ServerCallState::PROCESSING);
+        server_call->GetServerCallFactory().OnCallAccepted();
         server_call->HandleRequest();
         break;
       case ServerCallState::SENDING_REPLY:
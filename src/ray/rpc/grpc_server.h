@@ -17,6 +17,8 @@
 #include <grpcpp/grpcpp.h>
 
 #include <boost/asio.hpp>
+#include <cstdio>
+#include <string>
 #include <thread>
 #include <utility>
 
@@ -77,6 +79,12 @@ class GrpcServer {
   /// Destruct this gRPC server.
   ~GrpcServer() { Shutdown(); }
 
+  /// Also listen on a unix domain socket, in addition to the port. Must be called before
+  /// `Run`. A stale socket file at the path is removed.
+  ///
+  /// \param[in] path The path of the socket file.
+  void ListenOnUnixSocket(const std::string &path) { unix_socket_path_ = path; }
+
   /// Initialize and run this server.
   void Run();
 
@@ -95,6 +103,9 @@ class GrpcServer {
       is_closed_ = true;
       RAY_LOG(DEBUG) << "gRPC server of " << name_ << " shutdown.";
       server_.reset();
+      if (!unix_socket_path_.empty()) {
+        std::remove(unix_socket_path_.c_str());
+      }
     }
   }
 
@@ -121,6 +132,8 @@ class GrpcServer {
   /// Listen to localhost (127.0.0.1) only if it's true, otherwise listen to all network
   /// interfaces (0.0.0.0)
   const bool listen_to_localhost_only_;
+  /// The path of the unix domain socket to also listen on, or empty.
+  std::string unix_socket_path_;
   /// Indicates whether this server has been closed.
   bool is_closed_;
   /// The `grpc::Service` objects which should be registered to `ServerBuilder`.
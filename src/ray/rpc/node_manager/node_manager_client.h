@@ -189,6 +189,24 @@ class NodeManagerWorkerClient
                          grpc_client_,
                          /*method_timeout_ms*/ -1, )
 
+  /// Ask the node to spill queued tasks to an idle node.
+  VOID_RPC_CLIENT_METHOD(NodeManagerService,
+                         StealTasks,
+                         grpc_client_,
+                         /*method_timeout_ms*/ -1, )
+
+  /// Check that the node is alive, or ask it to check another node.
+  VOID_RPC_CLIENT_METHOD(NodeManagerService,
+                         ProbeNode,
+                         grpc_client_,
+                         ::RayConfig::instance().raylet_gossip_probe_timeout_ms(), )
+
+  /// Profile the CPU use of the raylet for the requested duration.
+  VOID_RPC_CLIENT_METHOD(NodeManagerService,
+                         ProfileCpu,
+                         grpc_client_,
+                         /*method_timeout_ms*/ -1, )
+
  private:
   /// Constructor.
   ///
@@ -45,7 +45,10 @@ namespace rpc {
   RPC_SERVICE_HANDLER(NodeManagerService, GetGcsServerAddress, -1)    \
   RPC_SERVICE_HANDLER(NodeManagerService, ShutdownRaylet, -1)         \
   RPC_SERVICE_HANDLER(NodeManagerService, GetTasksInfo, -1)           \
-  RPC_SERVICE_HANDLER(NodeManagerService, GetObjectsInfo, -1)
+  RPC_SERVICE_HANDLER(NodeManagerService, GetObjectsInfo, -1)         \
+  RPC_SERVICE_HANDLER(NodeManagerService, StealTasks, -1)             \
+  RPC_SERVICE_HANDLER(NodeManagerService, ProbeNode, -1)              \
+  RPC_SERVICE_HANDLER(NodeManagerService, ProfileCpu, -1)
 
 /// Interface of the `NodeManagerService`, see `src/ray/protobuf/node_manager.proto`.
 class NodeManagerServiceHandler {
@@ -146,6 +149,18 @@ class NodeManagerServiceHandler {
   virtual void HandleGetObjectsInfo(const GetObjectsInfoRequest &request,
                                     GetObjectsInfoReply *reply,
                                     SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleStealTasks(const StealTasksRequest &request,
+                                StealTasksReply *reply,
+                                SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleProbeNode(const ProbeNodeRequest &request,
+                               ProbeNodeReply *reply,
+                               SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleProfileCpu(const ProfileCpuRequest &request,
+                                ProfileCpuReply *reply,
+                                SendReplyCallback send_reply_callback) = 0;
 };
 
 /// The `GrpcService` for `NodeManagerService`.
@@ -14,12 +14,16 @@
 
 #pragma once
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/resource_quota.h>
 #include <grpcpp/support/channel_arguments.h>
 
 #include <thread>
+#include <vector>
 
+#include "absl/strings/string_view.h"
 #include "ray/common/status.h"
 #include "ray/rpc/grpc_client.h"
 #include "ray/util/logging.h"
@@ -29,6 +33,48 @@
 namespace ray {
 namespace rpc {
 
+/// Serialize a push request whose chunk data is sent straight from the given memory,
+/// without copying it into the request. The request is serialized without its data,
+/// followed by the data field, which is parsed as if it had been set in the request.
+///
+/// \param request The request, without its data.
+/// \param chunk The memory of the chunk data, in order.
+/// \param chunk_owner Kept alive until gRPC is done with the memory of the chunk.
+/// \return The serialized request.
+inline grpc::ByteBuffer SerializePushRequest(
+    const PushRequest &request,
+    const std::vector<absl::string_view> &chunk,
+    const std::shared_ptr<const void> &chunk_owner) {
+  RAY_CHECK(request.data().empty());
+  uint64_t chunk_size = 0;
+  for (const auto &part : chunk) {
+    chunk_size += part.size();
+  }
+  std::string header;
+  {
+    google::protobuf::io::StringOutputStream stream(&header);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    RAY_CHECK(request.SerializeToCodedStream(&output));
+    // Wire type 2 is a length delimited field.
+    output.WriteTag((PushRequest::kDataFieldNumber << 3) | 2);
+    output.WriteVarint64(chunk_size);
+  }
+  std::vector<grpc::Slice> slices;
+  slices.reserve(chunk.size() + 1);
+  slices.emplace_back(header);
+  for (const auto &part : chunk) {
+    if (part.empty()) {
+      continue;
+    }
+    slices.emplace_back(
+        const_cast<char *>(part.data()),
+        part.size(),
+        [](void *owner) { delete static_cast<std::shared_ptr<const void> *>(owner); },
+        new std::shared_ptr<const void>(chunk_owner));
+  }
+  return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
 /// Client used for communicating with a remote node manager server.
 class ObjectManagerClient {
  public:
@@ -48,7 +94,14 @@ class ObjectManagerClient {
     grpc_clients_.reserve(num_connections_);
     for (int i = 0; i < num_connections_; i++) {
       grpc_clients_.emplace_back(new GrpcClient<ObjectManagerService>(
-          address, port, client_call_manager, num_connections_));
+          address,
+          port,
+          client_call_manager,
+          num_connections_,
+          /*use_tls=*/false,
+          ::RayConfig::instance().object_manager_transfer_compression()
+              ? GRPC_COMPRESS_GZIP
+              : GRPC_COMPRESS_NONE));
     }
   };
 
@@ -61,6 +114,25 @@ class ObjectManagerClient {
                          grpc_clients_[push_rr_index_++ % num_connections_],
                          /*method_timeout_ms*/ -1, )
 
+  /// Push a chunk of an object to remote object manager, sending the chunk straight
+  /// from memory instead of copying it into the request.
+  ///
+  /// \param request The request message, without the chunk data.
+  /// \param chunk The memory of the chunk data, in order.
+  /// \param chunk_owner Kept alive until the chunk is sent, e.g. to pin the object.
+  /// \param callback The callback function that handles reply from server
+  void PushChunk(const PushRequest &request,
+                 const std::vector<absl::string_view> &chunk,
+                 const std::shared_ptr<const void> &chunk_owner,
+                 const ClientCallback<PushReply> &callback) {
+    grpc_clients_[push_rr_index_++ % num_connections_]
+        ->CallMethodWithSerializedRequest<PushReply>(
+            "/ray.rpc.ObjectManagerService/Push",
+            SerializePushRequest(request, chunk, chunk_owner),
+            callback,
+            "ObjectManagerService.grpc_client.Push");
+  }
+
   /// Pull object from remote object manager
   ///
   /// \param request The request message
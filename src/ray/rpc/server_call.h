@@ -17,11 +17,14 @@
 #include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 
+#include <algorithm>
 #include <boost/asio.hpp>
 
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/grpc_util.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/status.h"
+#include "ray/rpc/common.h"
 #include "ray/stats/metric.h"
 #include "ray/stats/metric_defs.h"
 
@@ -103,6 +106,11 @@ class ServerCallFactory {
   /// Get the maximum request number to handle at the same time. -1 means no limit.
   virtual int64_t GetMaxActiveRPCs() const = 0;
 
+  /// Invoked when a call created by this factory receives a request. Unless the number
+  /// of active requests is limited, this creates calls to accept the next requests, so
+  /// that the number of calls waiting for requests follows the observed concurrency.
+  virtual void OnCallAccepted() const = 0;
+
   virtual ~ServerCallFactory() = default;
 };
 
@@ -132,20 +140,26 @@ class ServerCallImpl : public ServerCall {
   /// \param[in] service_handler The service handler that handles the request.
   /// \param[in] handle_request_function Pointer to the service handler function.
   /// \param[in] io_service The event loop.
+  /// \param[in] num_in_flight The number of requests of the method that are in flight
+  /// in the process.
   ServerCallImpl(
       const ServerCallFactory &factory,
       ServiceHandler &service_handler,
       HandleRequestFunction<ServiceHandler, Request, Reply> handle_request_function,
       instrumented_io_context &io_service,
-      std::string call_name)
-      : state_(ServerCallState::PENDING),
+      std::string call_name,
+      std::atomic<int64_t> &num_in_flight)
+      : arena_(arena_block_, sizeof(arena_block_)),
+        state_(ServerCallState::PENDING),
         factory_(factory),
         service_handler_(service_handler),
         handle_request_function_(handle_request_function),
         response_writer_(&context_),
         io_service_(io_service),
         call_name_(std::move(call_name)),
+        num_in_flight_(num_in_flight),
         start_time_(0) {
+    request_ = google::protobuf::Arena::CreateMessage<Request>(&arena_);
     reply_ = google::protobuf::Arena::CreateMessage<Reply>(&arena_);
     // TODO call_name_ sometimes get corrunpted due to memory issues.
     RAY_CHECK(!call_name_.empty()) << "Call name is empty";
@@ -161,6 +175,7 @@ class ServerCallImpl : public ServerCall {
   void HandleRequest() override {
     start_time_ = absl::GetCurrentTimeNanos();
     ray::stats::STATS_grpc_server_req_handling.Record(1.0, call_name_);
+    ray::stats::STATS_grpc_server_req_in_flight.Record(++num_in_flight_, call_name_);
     if (!io_service_.stopped()) {
       io_service_.post([this] { HandleRequestImpl(); }, call_name_);
     } else {
@@ -173,18 +188,11 @@ class ServerCallImpl : public ServerCall {
 
   void HandleRequestImpl() {
     state_ = ServerCallState::PROCESSING;
-    // NOTE(hchen): This `factory` local variable is needed. Because `SendReply` runs in
-    // a different thread, and will cause `this` to be deleted.
-    const auto &factory = factory_;
-    if (factory.GetMaxActiveRPCs() == -1) {
-      // Create a new `ServerCall` to accept the next incoming request.
-      // We create this before handling the request only when no back pressure limit is
-      // set. So that the it can be populated by the completion queue in the background if
-      // a new request comes in.
-      factory.CreateCall();
-    }
+    handler_start_time_ = absl::GetCurrentTimeNanos();
+    ray::stats::STATS_grpc_server_req_queue_time_ms.Record(
+        (handler_start_time_ - start_time_) / 1000000.0, call_name_);
     (service_handler_.*handle_request_function_)(
-        request_,
+        *request_,
         reply_,
         [this](
             Status status, std::function<void()> success, std::function<void()> failure) {
@@ -226,15 +234,37 @@ class ServerCallImpl : public ServerCall {
     auto end_time = absl::GetCurrentTimeNanos();
     ray::stats::STATS_grpc_server_req_process_time_ms.Record(
         (end_time - start_time_) / 1000000.0, call_name_);
+    ray::stats::STATS_grpc_server_req_reply_time_ms.Record(
+        (end_time - reply_start_time_) / 1000000.0, call_name_);
+    ray::stats::STATS_grpc_server_req_in_flight.Record(--num_in_flight_, call_name_);
   }
   /// Tell gRPC to finish this request and send reply asynchronously.
   void SendReply(const Status &status) {
     state_ = ServerCallState::SENDING_REPLY;
+    reply_start_time_ = absl::GetCurrentTimeNanos();
+    if (handler_start_time_ != 0) {
+      ray::stats::STATS_grpc_server_req_handler_time_ms.Record(
+          (reply_start_time_ - handler_start_time_) / 1000000.0, call_name_);
+    }
+    const auto compression_min_bytes =
+        RayConfig::instance().grpc_reply_compression_min_bytes();
+    if (compression_min_bytes >= 0 &&
+        reply_->ByteSizeLong() >= static_cast<size_t>(compression_min_bytes)) {
+      context_.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
     response_writer_.Finish(*reply_, RayStatusToGrpcStatus(status), this);
   }
 
-  /// The memory pool for this request. It's used for reply.
-  /// With arena, we'll be able to setup the reply without copying some field.
+  /// The size of the block, embedded in the call, that the request and the reply are
+  /// allocated from. Messages that don't fit in it allocate more blocks from the heap.
+  static constexpr size_t kArenaInitialBlockSize = 512;
+
+  /// The initial block of `arena_`.
+  alignas(8) char arena_block_[kArenaInitialBlockSize];
+
+  /// The memory pool for this request. It's used for the request and the reply.
+  /// With arena, we'll be able to setup the reply without copying some field, and
+  /// small messages don't allocate at all.
   google::protobuf::Arena arena_;
 
   /// State of this call.
@@ -259,8 +289,9 @@ class ServerCallImpl : public ServerCall {
   /// The event loop.
   instrumented_io_context &io_service_;
 
-  /// The request message.
-  Request request_;
+  /// The request message. This one is owned by arena. It's not valid beyond
+  /// the life-cycle of this call.
+  Request *request_;
 
   /// The reply message. This one is owned by arena. It's not valid beyond
   /// the life-cycle of this call.
@@ -275,9 +306,18 @@ class ServerCallImpl : public ServerCall {
   /// The callback when sending reply fails.
   std::function<void()> send_reply_failure_callback_ = nullptr;
 
+  /// The number of requests of this method that are in flight in the process.
+  std::atomic<int64_t> &num_in_flight_;
+
   /// The ts when the request created
   int64_t start_time_;
 
+  /// The ts when the handler started handling the request, 0 if it didn't.
+  int64_t handler_start_time_ = 0;
+
+  /// The ts when the reply started to be sent.
+  int64_t reply_start_time_ = 0;
+
   template <class T1, class T2, class T3, class T4>
   friend class ServerCallFactoryImpl;
 };
@@ -334,17 +374,28 @@ class ServerCallFactoryImpl : public ServerCallFactory {
         cq_(cq),
         io_service_(io_service),
         call_name_(std::move(call_name)),
-        max_active_rpcs_(max_active_rpcs) {}
+        num_in_flight_calls_(InFlightCallCounter(call_name_)),
+        max_active_rpcs_(max_active_rpcs),
+        target_pending_calls_(std::max<int64_t>(
+            1,
+            std::min(RayConfig::instance().grpc_server_initial_pending_calls(),
+                     RayConfig::instance().grpc_server_max_pending_calls()))) {}
 
   void CreateCall() const override {
+    num_pending_calls_++;
     // Create a new `ServerCall`. This object will eventually be deleted by
     // `GrpcServer::PollEventsFromCompletionQueue`.
     auto call = new ServerCallImpl<ServiceHandler, Request, Reply>(
-        *this, service_handler_, handle_request_function_, io_service_, call_name_);
+        *this,
+        service_handler_,
+        handle_request_function_,
+        io_service_,
+        call_name_,
+        num_in_flight_calls_);
     /// Request gRPC runtime to starting accepting this kind of request, using the call as
     /// the tag.
     (service_.*request_call_function_)(&call->context_,
-                                       &call->request_,
+                                       call->request_,
                                        &call->response_writer_,
                                        cq_.get(),
                                        cq_.get(),
@@ -353,6 +404,27 @@ class ServerCallFactoryImpl : public ServerCallFactory {
 
   int64_t GetMaxActiveRPCs() const override { return max_active_rpcs_; }
 
+  void OnCallAccepted() const override {
+    num_pending_calls_--;
+    if (GetMaxActiveRPCs() != -1) {
+      // The call is replaced once its reply is sent.
+      return;
+    }
+    if (num_pending_calls_ == 0) {
+      // Every call was taken by a request, so more requests than the target may be
+      // arriving concurrently.
+      target_pending_calls_ =
+          std::min(target_pending_calls_ * 2,
+                   RayConfig::instance().grpc_server_max_pending_calls());
+    }
+    // Create calls to accept the next incoming requests. We create them before the
+    // request is handled, so that they can be populated by the completion queue in the
+    // background if new requests come in.
+    while (num_pending_calls_ < target_pending_calls_) {
+      CreateCall();
+    }
+  }
+
  private:
   /// The gRPC-generated `AsyncService`.
   AsyncService &service_;
@@ -375,9 +447,20 @@ class ServerCallFactoryImpl : public ServerCallFactory {
   /// Human-readable name for this RPC call.
   std::string call_name_;
 
+  /// The number of requests of this method that are in flight in the process.
+  std::atomic<int64_t> &num_in_flight_calls_;
+
   /// Maximum request number to handle at the same time.
   /// -1 means no limit.
   uint64_t max_active_rpcs_;
+
+  /// The number of calls waiting for a request. Only accessed by the thread that polls
+  /// `cq_`, once the server is running.
+  mutable int64_t num_pending_calls_ = 0;
+
+  /// The number of calls to keep waiting for requests, if the number of active requests
+  /// is not limited. Grows when requests take all the waiting calls.
+  mutable int64_t target_pending_calls_;
 };
 
 }  // namespace rpc
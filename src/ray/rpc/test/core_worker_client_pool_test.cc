@@ -0,0 +1,93 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/rpc/worker/core_worker_client_pool.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace rpc {
+
+class CoreWorkerClientPoolTest : public ::testing::Test {
+ public:
+  CoreWorkerClientPoolTest()
+      : pool_(
+            [this](const Address &address) {
+              num_connects_++;
+              return std::make_shared<CoreWorkerClientInterface>();
+            },
+            /*max_size=*/2) {}
+
+  Address WorkerAddress(const WorkerID &worker_id) {
+    Address address;
+    address.set_worker_id(worker_id.Binary());
+    return address;
+  }
+
+ protected:
+  int num_connects_ = 0;
+  CoreWorkerClientPool pool_;
+};
+
+TEST_F(CoreWorkerClientPoolTest, EvictsLeastRecentlyUsedIdleClients) {
+  std::vector<WorkerID> workers;
+  for (int i = 0; i < 3; i++) {
+    workers.push_back(WorkerID::FromRandom());
+  }
+  pool_.GetOrConnect(WorkerAddress(workers[0]));
+  pool_.GetOrConnect(WorkerAddress(workers[1]));
+  // Use the first client again, so that the second is the least recently used.
+  pool_.GetOrConnect(WorkerAddress(workers[0]));
+  pool_.GetOrConnect(WorkerAddress(workers[2]));
+  ASSERT_EQ(pool_.Size(), 2);
+  ASSERT_TRUE(pool_.GetByID(workers[0]).has_value());
+  ASSERT_FALSE(pool_.GetByID(workers[1]).has_value());
+  ASSERT_TRUE(pool_.GetByID(workers[2]).has_value());
+
+  // An evicted client reconnects when it's used again.
+  pool_.GetOrConnect(WorkerAddress(workers[1]));
+  ASSERT_EQ(num_connects_, 4);
+}
+
+TEST_F(CoreWorkerClientPoolTest, DoesNotEvictClientsInUse) {
+  std::vector<WorkerID> workers;
+  for (int i = 0; i < 3; i++) {
+    workers.push_back(WorkerID::FromRandom());
+  }
+  // The first two clients are held outside of the pool.
+  auto client0 = pool_.GetOrConnect(WorkerAddress(workers[0]));
+  auto client1 = pool_.GetOrConnect(WorkerAddress(workers[1]));
+  pool_.GetOrConnect(WorkerAddress(workers[2]));
+  // The pool is over its size, but all of its clients were in use.
+  ASSERT_EQ(pool_.Size(), 3);
+
+  client0.reset();
+  pool_.GetOrConnect(WorkerAddress(WorkerID::FromRandom()));
+  ASSERT_EQ(pool_.Size(), 2);
+  ASSERT_FALSE(pool_.GetByID(workers[0]).has_value());
+  ASSERT_EQ(pool_.GetByID(workers[1]).value(), client1);
+}
+
+TEST_F(CoreWorkerClientPoolTest, Disconnect) {
+  auto worker_id = WorkerID::FromRandom();
+  pool_.GetOrConnect(WorkerAddress(worker_id));
+  pool_.Disconnect(worker_id);
+  ASSERT_EQ(pool_.Size(), 0);
+  ASSERT_FALSE(pool_.GetByID(worker_id).has_value());
+}
+
+}  // namespace rpc
+}  // namespace ray
@@ -0,0 +1,70 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/rpc/object_manager/object_manager_client.h"
+
+#include <grpcpp/impl/codegen/proto_utils.h>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace rpc {
+
+TEST(ObjectManagerClientTest, TestSerializePushRequest) {
+  PushRequest request;
+  request.set_push_id("push_id");
+  request.set_object_id("object_id");
+  request.set_node_id("node_id");
+  request.mutable_owner_address()->set_raylet_id("raylet_id");
+  request.set_chunk_index(3);
+  request.set_data_size(100);
+  request.set_metadata_size(10);
+
+  auto data = std::make_shared<std::string>("alotofdata");
+  auto metadata = std::make_shared<std::string>("meta");
+  std::vector<absl::string_view> chunk{absl::string_view(*data).substr(4),
+                                       absl::string_view(*metadata)};
+  PushRequest parsed_request;
+  {
+    auto serialized_request = SerializePushRequest(request, chunk, data);
+    // Every part of the chunk keeps its owner alive.
+    ASSERT_EQ(data.use_count(), 3);
+    ASSERT_TRUE(
+        grpc::SerializationTraits<PushRequest>::Deserialize(&serialized_request,
+                                                            &parsed_request)
+            .ok());
+  }
+  // The chunk is released once gRPC is done with it.
+  ASSERT_EQ(data.use_count(), 1);
+
+  request.set_data("ofdatameta");
+  ASSERT_EQ(parsed_request.SerializeAsString(), request.SerializeAsString());
+}
+
+TEST(ObjectManagerClientTest, TestSerializeEmptyPushRequest) {
+  PushRequest request;
+  request.set_object_id("object_id");
+  auto owner = std::make_shared<int>(0);
+  auto serialized_request = SerializePushRequest(request, {}, owner);
+  ASSERT_EQ(owner.use_count(), 1);
+  PushRequest parsed_request;
+  ASSERT_TRUE(grpc::SerializationTraits<PushRequest>::Deserialize(&serialized_request,
+                                                                  &parsed_request)
+                  .ok());
+  ASSERT_EQ(parsed_request.object_id(), "object_id");
+  ASSERT_TRUE(parsed_request.data().empty());
+}
+
+}  // namespace rpc
+}  // namespace ray
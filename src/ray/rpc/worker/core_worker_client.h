@@ -29,6 +29,8 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/hash/hash.h"
+#include "ray/common/id.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/status.h"
 #include "ray/pubsub/subscriber.h"
 #include "ray/rpc/grpc_client.h"
@@ -131,6 +133,11 @@ class CoreWorkerClientInterface : public pubsub::SubscriberClientInterface {
   virtual void GetObjectStatus(const GetObjectStatusRequest &request,
                                const ClientCallback<GetObjectStatusReply> &callback) {}
 
+  /// Ask the owner of several objects about their current status.
+  virtual void GetObjectStatusBatch(
+      const GetObjectStatusBatchRequest &request,
+      const ClientCallback<GetObjectStatusBatchReply> &callback) {}
+
   /// Ask the actor's owner to reply when the actor has gone out of scope.
   virtual void WaitForActorOutOfScope(
       const WaitForActorOutOfScopeRequest &request,
@@ -193,6 +200,10 @@ class CoreWorkerClientInterface : public pubsub::SubscriberClientInterface {
                                  const ClientCallback<AssignObjectOwnerReply> &callback) {
   }
 
+  virtual void ReportStreamingReturn(
+      const ReportStreamingReturnRequest &request,
+      const ClientCallback<ReportStreamingReturnReply> &callback) {}
+
   /// Returns the max acked sequence number, useful for checking on progress.
   virtual int64_t ClientProcessedUpToSeqno() { return -1; }
 
@@ -208,12 +219,38 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
   /// \param[in] address Address of the worker server.
   /// \param[in] port Port of the worker server.
   /// \param[in] client_call_manager The `ClientCallManager` used for managing requests.
-  CoreWorkerClient(const rpc::Address &address, ClientCallManager &client_call_manager)
+  /// \param[in] unix_socket_path If not empty, connect to the worker through this unix
+  /// domain socket instead of its port, e.g. because it's on the same node.
+  CoreWorkerClient(const rpc::Address &address,
+                   ClientCallManager &client_call_manager,
+                   const std::string &unix_socket_path = "")
       : addr_(address) {
-    grpc_client_ = std::make_unique<GrpcClient<CoreWorkerService>>(
-        addr_.ip_address(), addr_.port(), client_call_manager);
+    if (unix_socket_path.empty()) {
+      grpc_client_ = std::make_unique<GrpcClient<CoreWorkerService>>(
+          addr_.ip_address(), addr_.port(), client_call_manager);
+    } else {
+      grpc_client_ = std::make_unique<GrpcClient<CoreWorkerService>>(unix_socket_path,
+                                                                     client_call_manager);
+    }
   };
 
+  /// Return the path of the unix domain socket that a worker listens on, or an empty
+  /// string if the path would be too long for a socket address. The path only depends
+  /// on the socket directory of the node and the worker ID, so that the other workers
+  /// on the node can find it.
+  static std::string UnixSocketPath(const std::string &socket_dir,
+                                    const WorkerID &worker_id) {
+    // The path must fit in sockaddr_un::sun_path, which is 104 bytes on macOS and 108
+    // on Linux, including the terminating null. A prefix of the random worker ID is
+    // enough to tell the workers apart.
+    const size_t max_path_length = 103;
+    auto path = socket_dir + "/worker_" + worker_id.Hex().substr(0, 16);
+    if (path.size() > max_path_length) {
+      return "";
+    }
+    return path;
+  }
+
   const rpc::Address &Addr() const override { return addr_; }
 
   VOID_RPC_CLIENT_METHOD(CoreWorkerService,
@@ -228,6 +265,12 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
                          /*method_timeout_ms*/ -1,
                          override)
 
+  VOID_RPC_CLIENT_METHOD(CoreWorkerService,
+                         GetObjectStatusBatch,
+                         grpc_client_,
+                         /*method_timeout_ms*/ -1,
+                         override)
+
   VOID_RPC_CLIENT_METHOD(CoreWorkerService,
                          KillActor,
                          grpc_client_,
@@ -321,6 +364,12 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
                          /*method_timeout_ms*/ -1,
                          override)
 
+  VOID_RPC_CLIENT_METHOD(CoreWorkerService,
+                         ReportStreamingReturn,
+                         grpc_client_,
+                         /*method_timeout_ms*/ -1,
+                         override)
+
   void PushActorTask(std::unique_ptr<PushTaskRequest> request,
                      bool skip_queue,
                      const ClientCallback<PushTaskReply> &callback) override {
@@ -364,11 +413,23 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
   /// The client will guarantee no more than kMaxBytesInFlight bytes of RPCs are being
   /// sent at once. This prevents the server scheduling queue from being overwhelmed.
   /// See direct_actor.proto for a description of the ordering protocol.
+  ///
+  /// If push_task_batch_size is greater than 1, the tasks are sent in batches, and a
+  /// batch that isn't full is held until the batches in flight are replied to.
   void SendRequests() {
     absl::MutexLock lock(&mutex_);
     auto this_ptr = this->shared_from_this();
+    const size_t batch_size = ::RayConfig::instance().push_task_batch_size();
 
     while (!send_queue_.empty() && rpc_bytes_in_flight_ < kMaxBytesInFlight) {
+      if (batch_size > 1) {
+        if (num_batches_in_flight_ > 0 && send_queue_.size() < batch_size) {
+          // Wait for more tasks, so that they are sent in one batch.
+          break;
+        }
+        SendBatch(batch_size);
+        continue;
+      }
       auto pair = std::move(*send_queue_.begin());
       send_queue_.pop_front();
 
@@ -413,6 +474,65 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
   }
 
  private:
+  /// Send up to `batch_size` pending tasks in one PushTaskBatch RPC.
+  void SendBatch(size_t batch_size) EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    auto this_ptr = this->shared_from_this();
+    PushTaskBatchRequest batch_request;
+    std::vector<ClientCallback<PushTaskReply>> callbacks;
+    int64_t batch_size_bytes = 0;
+    int64_t max_seq_no = -1;
+    while (!send_queue_.empty() && callbacks.size() < batch_size) {
+      auto pair = std::move(*send_queue_.begin());
+      send_queue_.pop_front();
+
+      auto &request = *pair.first;
+      batch_size_bytes += RequestSizeInBytes(request);
+      max_seq_no = std::max(max_seq_no, request.sequence_number());
+      request.set_client_processed_up_to(max_finished_seq_no_);
+      batch_request.add_requests()->Swap(&request);
+      callbacks.push_back(std::move(pair.second));
+    }
+    rpc_bytes_in_flight_ += batch_size_bytes;
+    num_batches_in_flight_++;
+
+    auto rpc_callback = [this,
+                         this_ptr,
+                         max_seq_no,
+                         batch_size_bytes,
+                         callbacks = std::move(callbacks)](
+                            Status status, const rpc::PushTaskBatchReply &reply) {
+      {
+        absl::MutexLock lock(&mutex_);
+        if (max_seq_no > max_finished_seq_no_) {
+          max_finished_seq_no_ = max_seq_no;
+        }
+        rpc_bytes_in_flight_ -= batch_size_bytes;
+        RAY_CHECK(rpc_bytes_in_flight_ >= 0);
+        num_batches_in_flight_--;
+      }
+      SendRequests();
+      for (size_t i = 0; i < callbacks.size(); i++) {
+        if (!status.ok() || static_cast<int>(i) >= reply.replies_size()) {
+          callbacks[i](status.ok() ? Status::IOError("Missing reply to task") : status,
+                       rpc::PushTaskReply());
+        } else {
+          callbacks[i](reply.status_codes(i) == static_cast<int32_t>(StatusCode::OK)
+                           ? Status::OK()
+                           : Status(StatusCode(reply.status_codes(i)),
+                                    reply.status_messages(i)),
+                       reply.replies(i));
+        }
+      }
+    };
+
+    RAY_UNUSED(INVOKE_RPC_CALL(CoreWorkerService,
+                               PushTaskBatch,
+                               batch_request,
+                               std::move(rpc_callback),
+                               grpc_client_,
+                               /*method_timeout_ms*/ -1));
+  }
+
   /// Protects against unsafe concurrent access from the callback thread.
   absl::Mutex mutex_;
 
@@ -429,6 +549,9 @@ class CoreWorkerClient : public std::enable_shared_from_this<CoreWorkerClient>,
   /// The number of bytes currently in flight.
   int64_t rpc_bytes_in_flight_ GUARDED_BY(mutex_) = 0;
 
+  /// The number of PushTaskBatch RPCs currently in flight.
+  int64_t num_batches_in_flight_ GUARDED_BY(mutex_) = 0;
+
   /// The max sequence number we have processed responses for.
   int64_t max_finished_seq_no_ GUARDED_BY(mutex_) = -1;
 };
@@ -14,9 +14,19 @@
 
 #include "ray/rpc/worker/core_worker_client_pool.h"
 
+#include <iterator>
+
 namespace ray {
 namespace rpc {
 
+namespace {
+
+/// The number of least recently used clients that an eviction looks at, at most. This
+/// bounds the work of a connection when most of the clients are in use.
+constexpr size_t kMaxEvictionCandidates = 16;
+
+}  // namespace
+
 optional<shared_ptr<CoreWorkerClientInterface>> CoreWorkerClientPool::GetByID(
     ray::WorkerID id) {
   absl::MutexLock lock(&mu_);
@@ -24,7 +34,7 @@ optional<shared_ptr<CoreWorkerClientInterface>> CoreWorkerClientPool::GetByID(
   if (it == client_map_.end()) {
     return {};
   }
-  return it->second;
+  return it->second.client;
 }
 
 shared_ptr<CoreWorkerClientInterface> CoreWorkerClientPool::GetOrConnect(
@@ -34,10 +44,13 @@ shared_ptr<CoreWorkerClientInterface> CoreWorkerClientPool::GetOrConnect(
   auto id = WorkerID::FromBinary(addr_proto.worker_id());
   auto it = client_map_.find(id);
   if (it != client_map_.end()) {
-    return it->second;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+    return it->second.client;
   }
   auto connection = client_factory_(addr_proto);
-  client_map_[id] = connection;
+  lru_.push_front(id);
+  client_map_[id] = ClientEntry{connection, lru_.begin()};
+  EvictIdleClients();
 
   RAY_LOG(DEBUG) << "Connected to " << addr_proto.ip_address() << ":"
                  << addr_proto.port();
@@ -50,8 +63,29 @@ void CoreWorkerClientPool::Disconnect(ray::WorkerID id) {
   if (it == client_map_.end()) {
     return;
   }
+  lru_.erase(it->second.lru_it);
   client_map_.erase(it);
 }
 
+void CoreWorkerClientPool::EvictIdleClients() {
+  if (max_size_ == 0) {
+    return;
+  }
+  for (size_t i = 0; i < kMaxEvictionCandidates && client_map_.size() > max_size_; i++) {
+    auto lru_it = std::prev(lru_.end());
+    auto it = client_map_.find(*lru_it);
+    RAY_CHECK(it != client_map_.end());
+    if (it->second.client.use_count() > 1) {
+      // The client is still held by someone else, e.g. to submit tasks to an actor, so
+      // removing it wouldn't close its connection. Treat it as recently used.
+      lru_.splice(lru_.begin(), lru_, lru_it);
+      continue;
+    }
+    RAY_LOG(DEBUG) << "Removing idle client of worker " << it->first;
+    lru_.erase(lru_it);
+    client_map_.erase(it);
+  }
+}
+
 }  // namespace rpc
 }  // namespace ray
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <list>
+
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
@@ -32,11 +34,15 @@ class CoreWorkerClientPool {
 
   /// Creates a CoreWorkerClientPool based on the low-level ClientCallManager.
   CoreWorkerClientPool(rpc::ClientCallManager &ccm)
-      : client_factory_(defaultClientFactory(ccm)){};
+      : client_factory_(defaultClientFactory(ccm)),
+        max_size_(::RayConfig::instance().core_worker_client_pool_max_size()){};
 
   /// Creates a CoreWorkerClientPool by a given connection function.
-  CoreWorkerClientPool(ClientFactoryFn client_factory)
-      : client_factory_(client_factory){};
+  ///
+  /// \param max_size The number of clients above which the least recently used ones
+  /// that are not used outside of the pool are removed. 0 means no limit.
+  CoreWorkerClientPool(ClientFactoryFn client_factory, size_t max_size = 0)
+      : client_factory_(client_factory), max_size_(max_size){};
 
   /// Returns an existing Interface if one exists, or an empty optional
   /// otherwise.
@@ -46,8 +52,17 @@ class CoreWorkerClientPool {
   /// Returns an open CoreWorkerClientInterface if one exists, and connect to one
   /// if it does not. The returned pointer is borrowed, and expected to be used
   /// briefly.
+  ///
+  /// If the pool holds more than its maximum number of clients, this removes the least
+  /// recently used ones that nobody else holds, which closes their connections.
   shared_ptr<CoreWorkerClientInterface> GetOrConnect(const Address &addr_proto);
 
+  /// Returns the number of clients in the pool.
+  size_t Size() {
+    absl::MutexLock lock(&mu_);
+    return client_map_.size();
+  }
+
   /// Removes a connection to the worker from the pool, if one exists. Since the
   /// shared pointer will no longer be retained in the pool, the connection will
   /// be open until it's no longer used, at which time it will disconnect.
@@ -63,17 +78,33 @@ class CoreWorkerClientPool {
     };
   };
 
+  /// Remove the least recently used clients that aren't held outside of the pool, until
+  /// the pool is back to its maximum size or enough clients were looked at.
+  void EvictIdleClients() EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// A client in the pool.
+  struct ClientEntry {
+    shared_ptr<CoreWorkerClientInterface> client;
+    /// The position of the worker in `lru_`.
+    std::list<ray::WorkerID>::iterator lru_it;
+  };
+
   /// This factory function does the connection to CoreWorkerClient, and is
   /// provided by the constructor (either the default implementation, above, or a
   /// provided one)
   ClientFactoryFn client_factory_;
 
+  /// The number of clients above which idle clients are removed. 0 means no limit.
+  const size_t max_size_;
+
   absl::Mutex mu_;
 
   /// A pool of open connections by WorkerID. Clients can reuse the connection
   /// objects in this pool by requesting them.
-  absl::flat_hash_map<ray::WorkerID, shared_ptr<CoreWorkerClientInterface>> client_map_
-      GUARDED_BY(mu_);
+  absl::flat_hash_map<ray::WorkerID, ClientEntry> client_map_ GUARDED_BY(mu_);
+
+  /// The workers of the clients in the pool, from the most to the least recently used.
+  std::list<ray::WorkerID> lru_ GUARDED_BY(mu_);
 };
 
 }  // namespace rpc
@@ -14,6 +14,8 @@
 
 #include "ray/stats/metric.h"
 
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
 #include "opencensus/stats/internal/aggregation_window.h"
 #include "opencensus/stats/internal/set_aggregation_window.h"
 #include "opencensus/stats/measure_registry.h"
@@ -81,6 +83,49 @@ void StatsConfig::SetIsInitialized(bool initialized) { is_initialized_ = initial
 
 bool StatsConfig::IsInitialized() const { return is_initialized_; }
 
+void StatsConfig::SetMaxTagCombinations(size_t max_tag_combinations) {
+  max_tag_combinations_ = max_tag_combinations;
+}
+
+size_t StatsConfig::GetMaxTagCombinations() const { return max_tag_combinations_; }
+
+///
+/// Tag Cardinality Limiter
+///
+void TagCardinalityLimiter::Limit(const std::string &metric_name,
+                                  TagsType &tags,
+                                  size_t begin) {
+  const int64_t max_combinations = max_combinations_;
+  const size_t limit = max_combinations >= 0
+                           ? static_cast<size_t>(max_combinations)
+                           : StatsConfig::instance().GetMaxTagCombinations();
+  if (limit == 0 || begin >= tags.size()) {
+    return;
+  }
+  size_t hash = 0;
+  for (size_t i = begin; i < tags.size(); i++) {
+    hash = absl::Hash<std::tuple<size_t, absl::string_view, absl::string_view>>()(
+        {hash, tags[i].first.name(), tags[i].second});
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    if (combinations_.contains(hash)) {
+      return;
+    }
+    if (combinations_.size() < limit) {
+      combinations_.insert(hash);
+      return;
+    }
+  }
+  RAY_LOG_EVERY_MS(WARNING, 60000)
+      << "Metric " << metric_name << " has more than " << limit
+      << " combinations of tag values, the values of the new ones are replaced.";
+  const auto overflow_value = "other_" + std::to_string(hash % kNumOverflowTagValues);
+  for (size_t i = begin; i < tags.size(); i++) {
+    tags[i].second = overflow_value;
+  }
+}
+
 ///
 /// Metric
 ///
@@ -112,6 +157,7 @@ void Metric::Record(double value, const TagsType &tags) {
 
   // Do record.
   TagsType combined_tags(tags);
+  tag_limiter_.Limit(name_, combined_tags);
   combined_tags.insert(std::end(combined_tags),
                        std::begin(StatsConfig::instance().GetGlobalTags()),
                        std::end(StatsConfig::instance().GetGlobalTags()));
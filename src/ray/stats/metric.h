@@ -16,11 +16,14 @@
 
 #include <ctype.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
 #include "gtest/gtest_prod.h"
 #include "opencensus/stats/stats.h"
 #include "opencensus/stats/stats_exporter.h"
@@ -52,6 +55,10 @@ class StatsConfig final {
 
   bool IsInitialized() const;
 
+  /// Get the maximum number of combinations of tag values of a metric, 0 if there is
+  /// no limit.
+  size_t GetMaxTagCombinations() const;
+
   ///
   /// Functions that should be used only inside stats::Init()
   /// NOTE: StatsConfig is not thread-safe. If you use these functions
@@ -68,6 +75,8 @@ class StatsConfig final {
   void SetIsDisableStats(bool disable_stats);
   /// Set the global tags that will be appended to all metrics in this process.
   void SetGlobalTags(const TagsType &global_tags);
+  /// Set the maximum number of combinations of tag values of a metric.
+  void SetMaxTagCombinations(size_t max_tag_combinations);
   /// Add the initializer
   void AddInitializer(std::function<void()> func) {
     initializers_.push_back(std::move(func));
@@ -95,9 +104,47 @@ class StatsConfig final {
   absl::Duration harvest_interval_ = absl::Milliseconds(5000);
   // Whether or not if the stats has been initialized.
   bool is_initialized_ = false;
+  // The maximum number of combinations of tag values of a metric, 0 if unlimited.
+  size_t max_tag_combinations_ = 0;
   std::vector<std::function<void()>> initializers_;
 };
 
+/// Bounds the number of combinations of tag values that a metric is recorded with, so
+/// that tags such as function names can't make the number of views grow without
+/// bound. Once the limit is reached, the values of every new combination are replaced
+/// with one of kNumOverflowTagValues "other" values, picked by the hash of the
+/// combination.
+///
+/// This class is thread safe.
+class TagCardinalityLimiter {
+ public:
+  static constexpr size_t kNumOverflowTagValues = 8;
+
+  /// Set the limit, which overrides the limit of the StatsConfig.
+  ///
+  /// \param max_combinations The limit, 0 for no limit.
+  void SetMaxCombinations(size_t max_combinations) {
+    max_combinations_ = static_cast<int64_t>(max_combinations);
+  }
+
+  /// Replace the values of the tags of a record if they are a new combination, and
+  /// the limit is reached.
+  ///
+  /// \param metric_name The name of the metric, for logging.
+  /// \param tags The tags of the record.
+  /// \param begin The index of the first tag to limit. The tags before it, e.g. the
+  /// global tags, are kept as is.
+  void Limit(const std::string &metric_name, TagsType &tags, size_t begin = 0)
+      LOCKS_EXCLUDED(mutex_);
+
+ private:
+  /// The limit, or -1 to use the limit of the StatsConfig.
+  std::atomic<int64_t> max_combinations_{-1};
+  absl::Mutex mutex_;
+  /// The hashes of the combinations of tag values that were recorded.
+  absl::flat_hash_set<size_t> combinations_ GUARDED_BY(mutex_);
+};
+
 /// A thin wrapper that wraps the `opencensus::tag::measure` for using it simply.
 class Metric {
  public:
@@ -133,6 +180,14 @@ class Metric {
   /// \param tags The map tag values that we want to record for this metric record.
   void Record(double value, const std::unordered_map<std::string, std::string> &tags);
 
+  /// Limit the number of combinations of tag values that this metric is recorded
+  /// with, instead of using the limit of the StatsConfig.
+  ///
+  /// \param max_tag_combinations The limit, 0 for no limit.
+  void SetMaxTagCombinations(size_t max_tag_combinations) {
+    tag_limiter_.SetMaxCombinations(max_tag_combinations);
+  }
+
  protected:
   virtual void RegisterView() = 0;
 
@@ -146,6 +201,8 @@ class Metric {
   // For making sure thread-safe to all of metric registrations.
   static absl::Mutex registration_mutex_;
 
+  TagCardinalityLimiter tag_limiter_;
+
 };  // class Metric
 
 class Gauge : public Metric {
@@ -345,8 +402,10 @@ class Stats {
       return;
     }
     TagsType combined_tags = StatsConfig::instance().GetGlobalTags();
+    const size_t num_global_tags = combined_tags.size();
     CheckPrintableChar(tag_val);
     combined_tags.emplace_back(tag_keys_[0], std::move(tag_val));
+    tag_limiter_.Limit(measure_->GetDescriptor().name(), combined_tags, num_global_tags);
     opencensus::stats::Record({{*measure_, val}}, std::move(combined_tags));
   }
 
@@ -358,13 +417,23 @@ class Stats {
       return;
     }
     TagsType combined_tags = StatsConfig::instance().GetGlobalTags();
+    const size_t num_global_tags = combined_tags.size();
     for (auto &[tag_key, tag_val] : tags) {
       CheckPrintableChar(tag_val);
       combined_tags.emplace_back(TagKeyType::Register(tag_key), std::move(tag_val));
     }
+    tag_limiter_.Limit(measure_->GetDescriptor().name(), combined_tags, num_global_tags);
     opencensus::stats::Record({{*measure_, val}}, std::move(combined_tags));
   }
 
+  /// Limit the number of combinations of tag values that this metric is recorded
+  /// with, instead of using the limit of the StatsConfig.
+  ///
+  /// \param max_tag_combinations The limit, 0 for no limit.
+  void SetMaxTagCombinations(size_t max_tag_combinations) {
+    tag_limiter_.SetMaxCombinations(max_tag_combinations);
+  }
+
  private:
   void CheckPrintableChar(const std::string &val) {
 #ifndef NDEBUG
@@ -378,6 +447,7 @@ class Stats {
 
   const std::vector<opencensus::tags::TagKey> tag_keys_;
   std::unique_ptr<opencensus::stats::Measure<double>> measure_;
+  TagCardinalityLimiter tag_limiter_;
 };
 
 }  // namespace internal
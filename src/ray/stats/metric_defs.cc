@@ -42,6 +42,23 @@ DEFINE_stats(operation_active_count,
              ("Method"),
              (),
              ray::stats::GAUGE);
+DEFINE_stats(event_loop_lag_ms,
+             "How late an event loop runs the handlers that are due",
+             ("Name"),
+             ({1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+
+/// Lock contention
+DEFINE_stats(mutex_contentions,
+             "Number of times a lock was released while others waited for it",
+             ("Name"),
+             (),
+             ray::stats::COUNT);
+DEFINE_stats(mutex_wait_time_ms,
+             "Time spent waiting for a contended lock",
+             ("Name"),
+             (),
+             ray::stats::SUM);
 
 /// GRPC server
 DEFINE_stats(grpc_server_req_process_time_ms,
@@ -64,6 +81,43 @@ DEFINE_stats(grpc_server_req_finished,
              ("Method"),
              (),
              ray::stats::COUNT);
+DEFINE_stats(grpc_server_req_queue_time_ms,
+             "Time from receiving a request until its handler runs on the event loop",
+             ("Method"),
+             ({0.1, 1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(grpc_server_req_handler_time_ms,
+             "Time from the start of a request's handler until it replies",
+             ("Method"),
+             ({0.1, 1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(grpc_server_req_reply_time_ms,
+             "Time to send the reply to a request",
+             ("Method"),
+             ({0.1, 1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(grpc_server_req_in_flight,
+             "Number of requests received by grpc server and not replied to yet",
+             ("Method"),
+             (),
+             ray::stats::GAUGE);
+
+/// GRPC client
+DEFINE_stats(grpc_client_req_latency_ms,
+             "Time from sending a request until its reply is received",
+             ("Method"),
+             ({0.1, 1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(grpc_client_req_callback_queue_time_ms,
+             "Time from receiving a reply until its callback runs on the event loop",
+             ("Method"),
+             ({0.1, 1, 10, 100, 1000, 10000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(grpc_client_req_in_flight,
+             "Number of requests sent by grpc client and not replied to yet",
+             ("Method"),
+             (),
+             ray::stats::GAUGE);
 
 /// Object Manager.
 DEFINE_stats(object_manager_bytes,
@@ -80,6 +134,13 @@ DEFINE_stats(object_manager_received_chunks,
              (),
              ray::stats::GAUGE);
 
+DEFINE_stats(object_manager_peer_throughput_bytes_per_s,
+             "Bytes per second of object chunks sent to or received from each peer "
+             "node, broken per direction {Sent, Received}.",
+             ("Direction", "PeerNode"),
+             (),
+             ray::stats::GAUGE);
+
 /// Pull Manager
 DEFINE_stats(
     pull_manager_usage_bytes,
@@ -118,6 +179,46 @@ DEFINE_stats(pull_manager_object_request_time_ms,
              ("Type"),
              ({1, 10, 100, 1000, 10000}),
              ray::stats::HISTOGRAM);
+DEFINE_stats(pull_manager_object_pull_latency_ms,
+             "Time between the pull request of an object and the object being local, "
+             "broken per object size {<1MB, 1-100MB, >100MB}.",
+             ("SizeBucket"),
+             ({1, 10, 100, 1000, 10000, 100000}),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(pull_manager_stalled_objects,
+             "Number of requested objects that aren't being pulled, broken per reason "
+             "{MemoryAdmission, NoLocation, RetryTimer}.",
+             ("Reason"),
+             (),
+             ray::stats::GAUGE);
+
+/// Plasma Store
+DEFINE_stats(object_store_eviction_policy_total,
+             "Cumulative number of eviction policy decisions broken per policy and per "
+             "type {Hit, Miss, Eviction}.",
+             ("Policy", "Type"),
+             (),
+             ray::stats::GAUGE);
+
+DEFINE_stats(object_store_tier_bytes,
+             "Bytes of the objects in the object store, broken down by the tier they "
+             "are allocated in {SharedMemory, Filesystem}.",
+             ("Tier"),
+             (),
+             ray::stats::GAUGE);
+
+DEFINE_stats(object_store_job_bytes,
+             "Bytes of the objects of each job in the shared memory of the object store.",
+             ("JobId"),
+             (),
+             ray::stats::GAUGE);
+
+DEFINE_stats(object_store_job_quota_exceeded,
+             "Number of create attempts of a job over its object store quota {Soft, "
+             "Hard}, which didn't evict objects or didn't use shared memory.",
+             ("JobId", "Quota"),
+             (),
+             ray::stats::COUNT);
 
 /// Push Manager
 DEFINE_stats(push_manager_in_flight_pushes,
@@ -153,6 +254,26 @@ DEFINE_stats(scheduler_failed_worker_startup_total,
              ("Reason"),
              (),
              ray::stats::GAUGE);
+DEFINE_stats(scheduler_tenant_dominant_share,
+             "The weighted dominant share of the local resources held by the running "
+             "tasks of each tenant, with fair share scheduling.",
+             ("Tenant"),
+             (),
+             ray::stats::GAUGE);
+DEFINE_stats(scheduler_fairness_index,
+             "Jain's fairness index of the weighted dominant shares of the tenants "
+             "with running tasks, with fair share scheduling.",
+             (),
+             (),
+             ray::stats::GAUGE);
+
+/// Raylet
+DEFINE_stats(raylet_startup_time_ms,
+             "Time the raylet took to become ready, broken down by stage {Config, "
+             "ObjectStore, Init, Register, Total}.",
+             ("Stage"),
+             (),
+             ray::stats::GAUGE);
 
 /// Local Object Manager
 DEFINE_stats(
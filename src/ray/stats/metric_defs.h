@@ -47,16 +47,29 @@ DECLARE_stats(operation_count);
 DECLARE_stats(operation_run_time_ms);
 DECLARE_stats(operation_queue_time_ms);
 DECLARE_stats(operation_active_count);
+DECLARE_stats(event_loop_lag_ms);
+DECLARE_stats(mutex_contentions);
+DECLARE_stats(mutex_wait_time_ms);
 
 /// GRPC server
 DECLARE_stats(grpc_server_req_process_time_ms);
 DECLARE_stats(grpc_server_req_new);
 DECLARE_stats(grpc_server_req_handling);
 DECLARE_stats(grpc_server_req_finished);
+DECLARE_stats(grpc_server_req_queue_time_ms);
+DECLARE_stats(grpc_server_req_handler_time_ms);
+DECLARE_stats(grpc_server_req_reply_time_ms);
+DECLARE_stats(grpc_server_req_in_flight);
+
+/// GRPC client
+DECLARE_stats(grpc_client_req_latency_ms);
+DECLARE_stats(grpc_client_req_callback_queue_time_ms);
+DECLARE_stats(grpc_client_req_in_flight);
 
 /// Object Manager.
 DECLARE_stats(object_manager_bytes);
 DECLARE_stats(object_manager_received_chunks);
+DECLARE_stats(object_manager_peer_throughput_bytes_per_s);
 
 /// Pull Manager
 DECLARE_stats(pull_manager_usage_bytes);
@@ -68,6 +81,14 @@ DECLARE_stats(pull_manager_active_bundles);
 DECLARE_stats(pull_manager_retries_total);
 DECLARE_stats(pull_manager_num_object_pins);
 DECLARE_stats(pull_manager_object_request_time_ms);
+DECLARE_stats(pull_manager_object_pull_latency_ms);
+DECLARE_stats(pull_manager_stalled_objects);
+
+/// Plasma Store
+DECLARE_stats(object_store_eviction_policy_total);
+DECLARE_stats(object_store_tier_bytes);
+DECLARE_stats(object_store_job_bytes);
+DECLARE_stats(object_store_job_quota_exceeded);
 
 /// Push Manager
 DECLARE_stats(push_manager_in_flight_pushes);
@@ -77,6 +98,11 @@ DECLARE_stats(push_manager_chunks);
 DECLARE_stats(scheduler_failed_worker_startup_total);
 DECLARE_stats(scheduler_tasks);
 DECLARE_stats(scheduler_unscheduleable_tasks);
+DECLARE_stats(scheduler_tenant_dominant_share);
+DECLARE_stats(scheduler_fairness_index);
+
+/// Raylet
+DECLARE_stats(raylet_startup_time_ms);
 
 /// Local Object Manager
 DECLARE_stats(spill_manager_objects);
@@ -138,6 +164,11 @@ static Gauge ObjectStoreFallbackMemory(
     "Amount of memory in fallback allocations in the filesystem.",
     "bytes");
 
+static Gauge ObjectStoreSmallObjectUnusedMemory(
+    "object_store_small_object_unused_memory",
+    "Amount of memory in the pages of small objects that is not used by any object.",
+    "bytes");
+
 static Gauge ObjectStoreLocalObjects("object_store_num_local_objects",
                                      "Number of objects currently in the object store.",
                                      "objects");
@@ -108,11 +108,35 @@ void MetricPointExporter::ExportViewData(
 
 OpenCensusProtoExporter::OpenCensusProtoExporter(const int port,
                                                  instrumented_io_context &io_service,
-                                                 const std::string address)
-    : client_call_manager_(io_service) {
+                                                 const std::string address,
+                                                 bool report_only_changed)
+    : report_only_changed_(report_only_changed), client_call_manager_(io_service) {
   client_.reset(new rpc::MetricsAgentClient(address, port, client_call_manager_));
 };
 
+bool OpenCensusProtoExporter::SeriesChanged(const std::string &metric_name,
+                                            const std::vector<std::string> &tag_values,
+                                            const SeriesValue &value) {
+  if (!report_only_changed_) {
+    return true;
+  }
+  std::string key = metric_name;
+  for (const auto &tag_value : tag_values) {
+    key.push_back('\0');
+    key.append(tag_value);
+  }
+  absl::MutexLock lock(&mutex_);
+  auto inserted = reported_series_.emplace(std::move(key), value);
+  if (inserted.second) {
+    return true;
+  }
+  if (inserted.first->second == value) {
+    return false;
+  }
+  inserted.first->second = value;
+  return true;
+}
+
 void OpenCensusProtoExporter::ExportViewData(
     const std::vector<std::pair<opencensus::stats::ViewDescriptor,
                                 opencensus::stats::ViewData>> &data) {
@@ -160,19 +184,30 @@ void OpenCensusProtoExporter::ExportViewData(
     switch (view_data.type()) {
     case opencensus::stats::ViewData::Type::kDouble:
       for (const auto &row : view_data.double_data()) {
+        if (!SeriesChanged(measure_descriptor.name(), row.first, {0, row.second})) {
+          continue;
+        }
         auto point_proto = make_new_data_point_proto(row.first /*tag_values*/);
         point_proto->set_double_value(row.second);
       }
       break;
     case opencensus::stats::ViewData::Type::kInt64:
       for (const auto &row : view_data.int_data()) {
+        if (!SeriesChanged(measure_descriptor.name(), row.first, {row.second, 0})) {
+          continue;
+        }
         auto point_proto = make_new_data_point_proto(row.first /*tag_values*/);
         point_proto->set_int64_value(row.second);
       }
       break;
     case opencensus::stats::ViewData::Type::kDistribution:
       for (const auto &row : view_data.distribution_data()) {
-        opencensus::stats::Distribution dist_value = row.second;
+        const opencensus::stats::Distribution &dist_value = row.second;
+        if (!SeriesChanged(measure_descriptor.name(),
+                           row.first,
+                           {dist_value.count(), dist_value.mean()})) {
+          continue;
+        }
 
         auto point_proto = make_new_data_point_proto(row.first /*tag_values*/);
 
@@ -198,12 +233,24 @@ void OpenCensusProtoExporter::ExportViewData(
       RAY_LOG(FATAL) << "Unknown view data type.";
       break;
     }
+    if (request_point_proto->timeseries_size() == 0) {
+      // None of the time series of the metric changed.
+      request_proto.mutable_metrics()->RemoveLast();
+    }
+  }
+  if (request_proto.metrics_size() == 0) {
+    return;
   }
 
   client_->ReportOCMetrics(
-      request_proto, [](const Status &status, const rpc::ReportOCMetricsReply &reply) {
+      request_proto, [this](const Status &status, const rpc::ReportOCMetricsReply &reply) {
         RAY_UNUSED(reply);
         if (!status.ok()) {
+          if (report_only_changed_) {
+            // The agent may have lost the time series, so report all of them next time.
+            absl::MutexLock lock(&mutex_);
+            reported_series_.clear();
+          }
           RAY_LOG_EVERY_N(WARNING, 10000)
               << "Export metrics to agent failed: " << status
               << ". This won't affect Ray, but you can lose metrics from the cluster.";
@@ -15,7 +15,9 @@
 #pragma once
 #include <boost/asio.hpp>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
 #include "opencensus/stats/stats.h"
 #include "opencensus/tags/tag_key.h"
 #include "ray/common/asio/instrumented_io_context.h"
@@ -94,17 +96,22 @@ class MetricPointExporter final : public opencensus::stats::StatsExporter::Handl
 
 class OpenCensusProtoExporter final : public opencensus::stats::StatsExporter::Handler {
  public:
+  /// \param report_only_changed Whether to only report the time series that changed
+  /// since the last successful report.
   OpenCensusProtoExporter(const int port,
                           instrumented_io_context &io_service,
-                          const std::string address);
+                          const std::string address,
+                          bool report_only_changed = false);
 
   ~OpenCensusProtoExporter() = default;
 
   static void Register(const int port,
                        instrumented_io_context &io_service,
-                       const std::string address) {
+                       const std::string address,
+                       bool report_only_changed = false) {
     opencensus::stats::StatsExporter::RegisterPushHandler(
-        absl::make_unique<OpenCensusProtoExporter>(port, io_service, address));
+        absl::make_unique<OpenCensusProtoExporter>(
+            port, io_service, address, report_only_changed));
   }
 
   void ExportViewData(
@@ -112,6 +119,19 @@ class OpenCensusProtoExporter final : public opencensus::stats::StatsExporter::H
                                   opencensus::stats::ViewData>> &data) override;
 
  private:
+  /// The value of a time series: its value for a counter or a gauge, or its count and
+  /// sum for a histogram.
+  using SeriesValue = std::pair<int64_t, double>;
+
+  /// Whether a time series changed since the last report, and remember its value.
+  bool SeriesChanged(const std::string &metric_name,
+                     const std::vector<std::string> &tag_values,
+                     const SeriesValue &value);
+
+  const bool report_only_changed_;
+  absl::Mutex mutex_;
+  /// The reported value of every time series, by metric name and tag values.
+  absl::flat_hash_map<std::string, SeriesValue> reported_series_ GUARDED_BY(mutex_);
   /// Call Manager for gRPC client.
   rpc::ClientCallManager client_call_manager_;
   /// Client to call a metrics agent gRPC server.
@@ -94,14 +94,21 @@ static inline void Init(const TagsType &global_tags,
       absl::Milliseconds(std::max(RayConfig::instance().metrics_report_interval_ms() / 2,
                                   static_cast<uint64_t>(500))));
 
-  MetricPointExporter::Register(exporter, metrics_report_batch_size);
-  OpenCensusProtoExporter::Register(
-      metrics_agent_port, (*metrics_io_service), "127.0.0.1");
+  // The default exporter drops the points, so don't spend time converting them.
+  if (exporter_to_use != nullptr) {
+    MetricPointExporter::Register(exporter, metrics_report_batch_size);
+  }
+  OpenCensusProtoExporter::Register(metrics_agent_port,
+                                    (*metrics_io_service),
+                                    "127.0.0.1",
+                                    RayConfig::instance().metrics_report_only_changed());
   opencensus::stats::StatsExporter::SetInterval(
       StatsConfig::instance().GetReportInterval());
   opencensus::stats::DeltaProducer::Get()->SetHarvestInterval(
       StatsConfig::instance().GetHarvestInterval());
   StatsConfig::instance().SetGlobalTags(global_tags);
+  StatsConfig::instance().SetMaxTagCombinations(
+      std::max(RayConfig::instance().metrics_max_tag_combinations(), int64_t{0}));
   for (auto &f : StatsConfig::instance().PopInitializers()) {
     f();
   }
@@ -16,6 +16,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -237,6 +238,37 @@ TEST_F(StatsTest, STAT_DEF) {
   STATS_test_declare.Record(1.0, "Test");
 }
 
+TEST(Metric, TagCardinalityLimiterTest) {
+  stats::TagCardinalityLimiter limiter;
+  limiter.SetMaxCombinations(2);
+  auto method_key = stats::TagKeyType::Register("method");
+  auto limit = [&limiter, &method_key](const std::string &value) {
+    stats::TagsType tags = {{stats::LanguageKey, "CPP"}, {method_key, value}};
+    limiter.Limit("test", tags, /*begin=*/1);
+    // The tags before begin are kept.
+    EXPECT_EQ(tags[0].second, "CPP");
+    return tags[1].second;
+  };
+
+  ASSERT_EQ(limit("a"), "a");
+  ASSERT_EQ(limit("b"), "b");
+  ASSERT_EQ(limit("a"), "a");
+  // Past the limit, the values of new combinations are replaced by a bounded set of
+  // values.
+  std::set<std::string> overflow_values;
+  for (int i = 0; i < 100; i++) {
+    auto value = limit("c" + std::to_string(i));
+    ASSERT_EQ(value.rfind("other_", 0), 0);
+    overflow_values.insert(value);
+  }
+  ASSERT_LE(overflow_values.size(), stats::TagCardinalityLimiter::kNumOverflowTagValues);
+  ASSERT_EQ(limit("b"), "b");
+
+  // 0 means no limit.
+  limiter.SetMaxCombinations(0);
+  ASSERT_EQ(limit("d"), "d");
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
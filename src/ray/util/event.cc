@@ -23,15 +23,21 @@ namespace ray {
 ///
 /// LogEventReporter
 ///
+/// The maximum number of events that wait for the background thread of an async
+/// reporter. The oldest events are dropped beyond it.
+static constexpr size_t kMaxPendingEvents = 10000;
+
 LogEventReporter::LogEventReporter(rpc::Event_SourceType source_type,
                                    const std::string &log_dir,
                                    bool force_flush,
                                    int rotate_max_file_size,
-                                   int rotate_max_file_num)
+                                   int rotate_max_file_num,
+                                   bool async)
     : log_dir_(log_dir),
       force_flush_(force_flush),
       rotate_max_file_size_(rotate_max_file_size),
-      rotate_max_file_num_(rotate_max_file_num) {
+      rotate_max_file_num_(rotate_max_file_num),
+      async_(async) {
   RAY_CHECK(log_dir_ != "");
   if (log_dir_.back() != '/') {
     log_dir_ += '/';
@@ -59,9 +65,21 @@ LogEventReporter::LogEventReporter(rpc::Event_SourceType source_type,
                                            rotate_max_file_num_);
   }
   log_sink_->set_pattern("%v");
+  if (async_) {
+    write_thread_ = std::thread([this]() { RunWriteLoop(); });
+  }
 }
 
-LogEventReporter::~LogEventReporter() { Flush(); }
+LogEventReporter::~LogEventReporter() {
+  if (async_) {
+    {
+      absl::MutexLock lock(&mutex_);
+      stopped_ = true;
+    }
+    write_thread_.join();
+  }
+  Flush();
+}
 
 void LogEventReporter::Flush() { log_sink_->flush(); }
 
@@ -113,14 +131,55 @@ std::string LogEventReporter::EventToString(const rpc::Event &event,
 void LogEventReporter::Report(const rpc::Event &event, const json &custom_fields) {
   RAY_CHECK(Event_SourceType_IsValid(event.source_type()));
   RAY_CHECK(Event_Severity_IsValid(event.severity()));
-  std::string result = EventToString(event, custom_fields);
+  // A fatal event is written right away, because the process exits after it.
+  if (async_ && event.severity() != rpc::Event_Severity::Event_Severity_FATAL) {
+    absl::MutexLock lock(&mutex_);
+    if (pending_events_.size() >= kMaxPendingEvents) {
+      pending_events_.pop_front();
+      RAY_LOG_EVERY_MS(WARNING, 10000)
+          << "Too many events are waiting to be written to " << file_name_
+          << ", the oldest ones are dropped.";
+    }
+    pending_events_.emplace_back(event, custom_fields);
+    return;
+  }
 
-  log_sink_->info(result);
+  Write(event, custom_fields);
   if (force_flush_) {
     Flush();
   }
 }
 
+void LogEventReporter::Write(const rpc::Event &event, const json &custom_fields) {
+  std::string result = EventToString(event, custom_fields);
+  log_sink_->info(result);
+}
+
+void LogEventReporter::RunWriteLoop() {
+  while (true) {
+    std::deque<std::pair<rpc::Event, json>> events;
+    bool stopped;
+    {
+      absl::MutexLock lock(&mutex_);
+      auto ready = [this]() EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return stopped_ || !pending_events_.empty();
+      };
+      mutex_.Await(absl::Condition(&ready));
+      events.swap(pending_events_);
+      stopped = stopped_;
+    }
+    for (const auto &[event, custom_fields] : events) {
+      Write(event, custom_fields);
+    }
+    if (force_flush_ && !events.empty()) {
+      Flush();
+    }
+    if (stopped) {
+      return;
+    }
+  }
+}
+
 ///
 /// EventManager
 ///
@@ -301,7 +360,7 @@ void RayEvent::SendMessage(const std::string &message) {
     event.set_message(message);
     event.set_timestamp(current_sys_time_us());
 
-    auto mp = context.GetCustomFields();
+    const auto &mp = context.GetCustomFields();
     for (const auto &pair : mp) {
       custom_fields_[pair.first] = pair.second;
     }
@@ -322,12 +381,18 @@ static absl::once_flag init_once_;
 void RayEventInit(rpc::Event_SourceType source_type,
                   const absl::flat_hash_map<std::string, std::string> &custom_fields,
                   const std::string &log_dir,
-                  const std::string &event_level) {
-  absl::call_once(init_once_, [&source_type, &custom_fields, &log_dir, &event_level]() {
+                  const std::string &event_level,
+                  bool async_reporter) {
+  absl::call_once(init_once_, [&]() {
     RayEventContext::Instance().SetEventContext(source_type, custom_fields);
     auto event_dir = boost::filesystem::path(log_dir) / boost::filesystem::path("events");
     ray::EventManager::Instance().AddReporter(
-        std::make_shared<ray::LogEventReporter>(source_type, event_dir.string()));
+        std::make_shared<ray::LogEventReporter>(source_type,
+                                                event_dir.string(),
+                                                /*force_flush=*/true,
+                                                /*rotate_max_file_size=*/100,
+                                                /*rotate_max_file_num=*/20,
+                                                async_reporter));
     SetEventLevel(event_level);
     RAY_LOG(INFO) << "Ray Event initialized for " << Event_SourceType_Name(source_type);
   });
@@ -19,13 +19,16 @@
 #include <boost/asio/ip/host_name.hpp>
 #include <cmath>
 #include <cstring>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "nlohmann/json.hpp"
 #include "ray/util/logging.h"
 #include "ray/util/util.h"
@@ -64,11 +67,15 @@ class BaseEventReporter {
 // responsible for writing event to specific file
 class LogEventReporter : public BaseEventReporter {
  public:
+  /// \param async Whether the events are formatted and written by a background thread,
+  /// in batches, instead of by the thread that reports them. The file is then flushed
+  /// once per batch.
   LogEventReporter(rpc::Event_SourceType source_type,
                    const std::string &log_dir,
                    bool force_flush = true,
                    int rotate_max_file_size = 100,
-                   int rotate_max_file_num = 20);
+                   int rotate_max_file_num = 20,
+                   bool async = false);
 
   virtual ~LogEventReporter();
 
@@ -87,6 +94,12 @@ class LogEventReporter : public BaseEventReporter {
 
   virtual std::string GetReporterKey() override { return "log.event.reporter"; }
 
+  /// Format an event and write it to the file.
+  void Write(const rpc::Event &event, const json &custom_fields);
+
+  /// Write the queued events in batches, until the reporter is destroyed.
+  void RunWriteLoop();
+
  protected:
   std::string log_dir_;
   bool force_flush_;
@@ -96,6 +109,13 @@ class LogEventReporter : public BaseEventReporter {
   std::string file_name_;
 
   std::shared_ptr<spdlog::logger> log_sink_;
+
+  const bool async_;
+  absl::Mutex mutex_;
+  /// The events that are waiting for the background thread, in the async mode.
+  std::deque<std::pair<rpc::Event, json>> pending_events_ GUARDED_BY(mutex_);
+  bool stopped_ GUARDED_BY(mutex_) = false;
+  std::thread write_thread_;
 };
 
 // store the reporters, add reporters and clean reporters
@@ -279,10 +299,13 @@ class RayEvent {
 /// \param log_dir The log directory to generate event subdirectory.
 /// \param event_level The input event level. It should be one of "info","warning",
 /// "error" and "fatal". You can also use capital letters for the options above.
+/// \param async_reporter Whether the events are written to the log by a background
+/// thread.
 /// \return void.
 void RayEventInit(rpc::Event_SourceType source_type,
                   const absl::flat_hash_map<std::string, std::string> &custom_fields,
                   const std::string &log_dir,
-                  const std::string &event_level = "warning");
+                  const std::string &event_level = "warning",
+                  bool async_reporter = false);
 
 }  // namespace ray
@@ -319,6 +319,44 @@ TEST_F(EventTest, TestLogOneThread) {
   }
 }
 
+TEST_F(EventTest, TestLogAsync) {
+  RayEventContext::Instance().SetEventContext(
+      rpc::Event_SourceType::Event_SourceType_RAYLET,
+      absl::flat_hash_map<std::string, std::string>(
+          {{"node_id", "node 1"}, {"job_id", "job 1"}, {"task_id", "task 1"}}));
+
+  EventManager::Instance().AddReporter(
+      std::make_shared<LogEventReporter>(rpc::Event_SourceType::Event_SourceType_RAYLET,
+                                         log_dir,
+                                         /*force_flush=*/true,
+                                         /*rotate_max_file_size=*/100,
+                                         /*rotate_max_file_num=*/20,
+                                         /*async=*/true));
+
+  int print_times = 1000;
+  for (int i = 1; i <= print_times; ++i) {
+    RAY_EVENT(INFO, "label " + std::to_string(i)) << "send message " + std::to_string(i);
+  }
+  // The reporter writes out the queued events when it is destroyed.
+  EventManager::Instance().ClearReporters();
+
+  std::vector<std::string> vc;
+  ReadContentFromFile(vc, log_dir + "/event_RAYLET.log");
+  EXPECT_EQ((int)vc.size(), print_times);
+  for (int i = 0; i < print_times; ++i) {
+    json custom_fields;
+    rpc::Event ele = GetEventFromString(vc[i], &custom_fields);
+    CheckEventDetail(ele,
+                     "job 1",
+                     "node 1",
+                     "task 1",
+                     "RAYLET",
+                     "INFO",
+                     "label " + std::to_string(i + 1),
+                     "send message " + std::to_string(i + 1));
+  }
+}
+
 TEST_F(EventTest, TestMultiThreadContextCopy) {
   ray::RayEventContext::Instance().ResetEventContext();
   ray::EventManager::Instance().AddReporter(std::make_shared<TestEventReporter>());
@@ -36,6 +36,7 @@
 #include "absl/debugging/symbolize.h"
 #include "ray/util/event_label.h"
 #include "ray/util/filesystem.h"
+#include "spdlog/async.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -54,6 +55,10 @@ long RayLog::log_rotation_max_size_ = 1 << 29;
 long RayLog::log_rotation_file_num_ = 10;
 bool RayLog::is_failure_signal_handler_installed_ = false;
 std::atomic<bool> RayLog::initialized_ = false;
+std::atomic<bool> RayLog::is_async_logging_ = false;
+
+/// The number of log records that can wait for the background thread in the async mode.
+constexpr size_t kAsyncLogQueueSize = 8192;
 
 std::string GetCallTrace() {
   std::vector<void *> local_stack;
@@ -127,7 +132,10 @@ class SpdLogMessage final {
     // NOTE(lingxuan.zlx): See more fmt by visiting https://github.com/fmtlib/fmt.
     logger->log(
         static_cast<spdlog::level::level_enum>(loglevel_), /*fmt*/ "{}", str_.str());
-    logger->flush();
+    // The async logger is flushed by its background thread.
+    if (!RayLog::IsAsyncLogging()) {
+      logger->flush();
+    }
   }
 
   ~SpdLogMessage() { Flush(); }
@@ -194,6 +202,8 @@ void RayLog::StartRayLog(const std::string &app_name,
     RAY_LOG(INFO) << "Set ray log level from environment variable RAY_BACKEND_LOG_LEVEL"
                   << " to " << static_cast<int>(severity_threshold);
   }
+  const char *async_var = std::getenv("RAY_BACKEND_LOG_ASYNC");
+  bool is_async_logging = async_var != nullptr && std::string(async_var) == "1";
   severity_threshold_ = severity_threshold;
   app_name_ = app_name;
   log_dir_ = log_dir;
@@ -269,14 +279,30 @@ void RayLog::StartRayLog(const std::string &app_name,
   sinks.push_back(err_sink);
 
   // Set the combined logger.
-  auto logger = std::make_shared<spdlog::logger>(
-      RayLog::GetLoggerName(), sinks.begin(), sinks.end());
+  std::shared_ptr<spdlog::logger> logger;
+  if (is_async_logging) {
+    // The logs are written by a background thread, so that the logging threads don't
+    // block on the IO. When the queue is full, the oldest logs are dropped instead.
+    spdlog::init_thread_pool(kAsyncLogQueueSize, 1);
+    logger = std::make_shared<spdlog::async_logger>(
+        RayLog::GetLoggerName(),
+        sinks.begin(),
+        sinks.end(),
+        spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+    // Errors are still written out right away.
+    logger->flush_on(spdlog::level::err);
+  } else {
+    logger = std::make_shared<spdlog::logger>(
+        RayLog::GetLoggerName(), sinks.begin(), sinks.end());
+  }
   logger->set_level(level);
   logger->set_pattern(log_format_pattern_);
   spdlog::set_level(static_cast<spdlog::level::level_enum>(severity_threshold_));
   spdlog::set_pattern(log_format_pattern_);
   spdlog::set_default_logger(logger);
 
+  is_async_logging_ = is_async_logging;
   initialized_ = true;
 }
 
@@ -363,6 +389,8 @@ std::string RayLog::GetLogFormatPattern() { return log_format_pattern_; }
 
 std::string RayLog::GetLoggerName() { return logger_name_; }
 
+bool RayLog::IsAsyncLogging() { return is_async_logging_; }
+
 void RayLog::AddFatalLogCallbacks(
     const std::vector<FatalLogCallback> &expose_log_callbacks) {
   fatal_log_callbacks_.insert(fatal_log_callbacks_.end(),
@@ -409,6 +437,10 @@ RayLog::~RayLog() {
     }
   }
   if (severity_ == RayLogLevel::FATAL) {
+    if (is_async_logging_) {
+      // Wait for the background thread to write out the logs before exiting.
+      spdlog::shutdown();
+    }
     std::_Exit(EXIT_FAILURE);
   }
 }
@@ -282,6 +282,10 @@ class RayLog : public RayLogBase {
 
   static std::string GetLoggerName();
 
+  /// Whether the logs are written by a background thread. This is enabled with the
+  /// environment variable RAY_BACKEND_LOG_ASYNC=1.
+  static bool IsAsyncLogging();
+
   /// Add callback functions that will be triggered to expose fatal log.
   static void AddFatalLogCallbacks(
       const std::vector<FatalLogCallback> &expose_log_callbacks);
@@ -322,6 +326,8 @@ class RayLog : public RayLogBase {
   static long log_rotation_file_num_;
   // Ray default logger name.
   static std::string logger_name_;
+  // Whether the logs are written by a background thread.
+  static std::atomic<bool> is_async_logging_;
 
  protected:
   virtual std::ostream &Stream();
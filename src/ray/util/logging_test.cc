@@ -195,6 +195,19 @@ TEST(PrintLogTest, LogTestWithInit) {
   RayLog::ShutDownRayLog();
 }
 
+TEST(PrintLogTest, LogTestWithAsyncLogging) {
+  setenv("RAY_BACKEND_LOG_ASYNC", "1", /*overwrite=*/1);
+  RayLog::StartRayLog("", RayLogLevel::DEBUG, ray::GetUserTempDir());
+  EXPECT_TRUE(RayLog::IsAsyncLogging());
+  PrintLog();
+  RayLog::ShutDownRayLog();
+  unsetenv("RAY_BACKEND_LOG_ASYNC");
+
+  RayLog::StartRayLog("", RayLogLevel::DEBUG, ray::GetUserTempDir());
+  EXPECT_FALSE(RayLog::IsAsyncLogging());
+  RayLog::ShutDownRayLog();
+}
+
 // This test will output large amount of logs to stderr, should be disabled in travis.
 TEST(LogPerfTest, PerfTest) {
   RayLog::StartRayLog(
@@ -15,11 +15,109 @@
 #include "ray/util/memory.h"
 
 #include <cstring>
+#include <deque>
+#include <functional>
 #include <thread>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+
 namespace ray {
 
+namespace {
+
+/// Copies at least this large bypass the cache with streaming stores, since the
+/// destination won't fit in it anyway and would only evict the source.
+constexpr int64_t kStreamingCopyThreshold = 8 * 1024 * 1024;
+
+/// The threads that parallel_memcopy copies on. They are started on first use and
+/// kept for the lifetime of the process, so that a copy doesn't pay for starting
+/// threads.
+class MemcopyThreadPool {
+ public:
+  static MemcopyThreadPool &Instance() {
+    // Leaked, so that the threads don't have to be joined at exit.
+    static auto *pool = new MemcopyThreadPool();
+    return *pool;
+  }
+
+  /// Run the tasks on the pool, and block until they are all done.
+  void Run(std::vector<std::function<void()>> tasks) {
+    absl::BlockingCounter counter(tasks.size());
+    {
+      absl::MutexLock lock(&mutex_);
+      while (num_threads_ < tasks.size()) {
+        std::thread([this] { RunTasks(); }).detach();
+        num_threads_++;
+      }
+      for (auto &task : tasks) {
+        queue_.push_back([task = std::move(task), &counter] {
+          task();
+          counter.DecrementCount();
+        });
+      }
+    }
+    counter.Wait();
+  }
+
+ private:
+  void RunTasks() {
+    while (true) {
+      std::function<void()> task;
+      {
+        absl::MutexLock lock(&mutex_);
+        mutex_.Await(absl::Condition(
+            +[](std::deque<std::function<void()>> *queue) { return !queue->empty(); },
+            &queue_));
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+  absl::Mutex mutex_;
+  std::deque<std::function<void()>> queue_ GUARDED_BY(mutex_);
+  size_t num_threads_ GUARDED_BY(mutex_) = 0;
+};
+
+/// Copy with non-temporal stores where the CPU supports them, else with memcpy.
+void StreamingCopy(uint8_t *dst, const uint8_t *src, int64_t nbytes) {
+#if defined(__SSE2__)
+  // Streaming stores need a 16 byte aligned destination.
+  int64_t head = (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15;
+  if (head > nbytes) {
+    head = nbytes;
+  }
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  nbytes -= head;
+  for (; nbytes >= 64; nbytes -= 64, dst += 64, src += 64) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst), a);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), b);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), c);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), d);
+  }
+  std::memcpy(dst, src, nbytes);
+  // Make the streaming stores visible before the copy is reported done.
+  _mm_sfence();
+#else
+  std::memcpy(dst, src, nbytes);
+#endif
+}
+
+}  // namespace
+
 uint8_t *pointer_logical_and(const uint8_t *address, uintptr_t bits) {
   uintptr_t value = reinterpret_cast<uintptr_t>(address);
   return reinterpret_cast<uint8_t *>(value & bits);
@@ -30,7 +128,6 @@ void parallel_memcopy(uint8_t *dst,
                       int64_t nbytes,
                       uintptr_t block_size,
                       int num_threads) {
-  std::vector<std::thread> threadpool(num_threads);
   uint8_t *left = pointer_logical_and(src + block_size - 1, ~(block_size - 1));
   uint8_t *right = pointer_logical_and(src + nbytes, ~(block_size - 1));
   int64_t num_blocks = (right - left) / block_size;
@@ -48,20 +145,22 @@ void parallel_memcopy(uint8_t *dst,
   // | prefix | num_threads * chunk_size | suffix |.
   // Each thread gets a "chunk" of k blocks.
 
-  // Start all threads first and handle leftovers while threads run.
+  const bool streaming = nbytes >= kStreamingCopyThreshold;
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(num_threads);
   for (int i = 0; i < num_threads; i++) {
-    threadpool[i] = std::thread(
-        std::memcpy, dst + prefix + i * chunk_size, left + i * chunk_size, chunk_size);
+    tasks.emplace_back([streaming, dst, prefix, left, chunk_size, i] {
+      if (streaming) {
+        StreamingCopy(dst + prefix + i * chunk_size, left + i * chunk_size, chunk_size);
+      } else {
+        std::memcpy(dst + prefix + i * chunk_size, left + i * chunk_size, chunk_size);
+      }
+    });
   }
-
+  // The leftovers are small, copy them before handing out the chunks.
   std::memcpy(dst, src, prefix);
   std::memcpy(dst + prefix + num_threads * chunk_size, right, suffix);
-
-  for (auto &t : threadpool) {
-    if (t.joinable()) {
-      t.join();
-    }
-  }
+  MemcopyThreadPool::Instance().Run(std::move(tasks));
 }
 
 }  // namespace ray
@@ -19,7 +19,8 @@
 namespace ray {
 
 // A helper function for doing memcpy with multiple threads. This is required
-// to saturate the memory bandwidth of modern cpus.
+// to saturate the memory bandwidth of modern cpus. The threads are kept in a pool
+// across calls, and large copies use non-temporal stores where available.
 void parallel_memcopy(uint8_t *dst,
                       const uint8_t *src,
                       int64_t nbytes,
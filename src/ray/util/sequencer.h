@@ -16,6 +16,8 @@
 
 #include <deque>
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
@@ -31,38 +33,92 @@ using SequencerDoneCallback = std::function<void()>;
 template <class KEY>
 class Sequencer {
  public:
+  using Operation = std::function<void(SequencerDoneCallback done_callback)>;
+
   /// This function is used to ask the sequencer to execute the given operation.
   /// The sequencer guarantees that all operations with the same key are sequenced.
   ///
   /// \param key The key of operation.
   /// \param operation The operation to be called.
-  void Post(KEY key, std::function<void(SequencerDoneCallback done_callback)> operation) {
+  void Post(KEY key, Operation operation) {
+    PostOperation(std::move(key), std::move(operation), /*mergeable=*/false, nullptr);
+  }
+
+  /// Like `Post`, but a queued mergeable operation is replaced by the next mergeable
+  /// operation of the same key, e.g. consecutive puts of the same key where the last
+  /// write wins, so that they are executed once.
+  ///
+  /// \param key The key of operation.
+  /// \param operation The operation to be called.
+  /// \param on_superseded Called instead of the operation if it is replaced before it
+  /// starts, once the operation that replaced it completes.
+  void PostMergeable(KEY key, Operation operation, SequencerDoneCallback on_superseded) {
+    PostOperation(std::move(key),
+                  std::move(operation),
+                  /*mergeable=*/true,
+                  std::move(on_superseded));
+  }
+
+ private:
+  struct PendingOperation {
+    Operation operation;
+    bool mergeable;
+    SequencerDoneCallback on_superseded;
+    /// The callbacks of the operations replaced by this one.
+    std::vector<SequencerDoneCallback> superseded;
+  };
+
+  void PostOperation(KEY key,
+                     Operation operation,
+                     bool mergeable,
+                     SequencerDoneCallback on_superseded) {
     mutex_.Lock();
-    pending_operations_[key].push_back(operation);
-    int queue_size = pending_operations_[key].size();
+    auto &queue = pending_operations_[key];
+    PendingOperation pending;
+    pending.operation = std::move(operation);
+    pending.mergeable = mergeable;
+    pending.on_superseded = std::move(on_superseded);
+    // The front operation is running, so only the ones behind it can be replaced.
+    if (mergeable && queue.size() > 1 && queue.back().mergeable) {
+      pending.superseded = std::move(queue.back().superseded);
+      if (queue.back().on_superseded) {
+        pending.superseded.push_back(std::move(queue.back().on_superseded));
+      }
+      queue.back() = std::move(pending);
+      mutex_.Unlock();
+      return;
+    }
+    queue.push_back(std::move(pending));
+    int queue_size = queue.size();
+    auto first_operation = queue.front().operation;
     mutex_.Unlock();
 
     if (1 == queue_size) {
       auto done_callback = [this, key]() { PostExecute(key); };
-      operation(done_callback);
+      first_operation(done_callback);
     }
   }
 
- private:
   /// This function is used when a operation completes.
   /// If the sequencer has operations with the same key, we will execute next operation.
   ///
   /// \param key The key of operation.
   void PostExecute(const KEY key) {
     mutex_.Lock();
+    auto superseded = std::move(pending_operations_[key].front().superseded);
     pending_operations_[key].pop_front();
+    Operation operation;
     if (pending_operations_[key].empty()) {
       pending_operations_.erase(key);
-      mutex_.Unlock();
     } else {
-      auto operation = pending_operations_[key].front();
-      mutex_.Unlock();
+      operation = pending_operations_[key].front().operation;
+    }
+    mutex_.Unlock();
 
+    for (const auto &callback : superseded) {
+      callback();
+    }
+    if (operation) {
       auto done_callback = [this, key]() { PostExecute(key); };
       operation(done_callback);
     }
@@ -71,10 +127,8 @@ class Sequencer {
   // Mutex to protect the pending_operations_ field.
   absl::Mutex mutex_;
 
-  absl::flat_hash_map<
-      KEY,
-      std::deque<std::function<void(SequencerDoneCallback done_callback)>>>
-      pending_operations_ GUARDED_BY(mutex_);
+  absl::flat_hash_map<KEY, std::deque<PendingOperation>> pending_operations_
+      GUARDED_BY(mutex_);
 };
 
 }  // namespace ray
@@ -15,7 +15,9 @@
 #include "ray/util/sequencer.h"
 
 #include <chrono>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "ray/util/logging.h"
@@ -46,6 +48,48 @@ TEST(SequencerTest, ExecuteOrderedTest) {
   }
 }
 
+TEST(SequencerTest, MergeQueuedOperationsTest) {
+  Sequencer<int> sequencer;
+  std::vector<std::string> executed;
+  std::vector<SequencerDoneCallback> running;
+  auto operation = [&executed, &running](const std::string &name) {
+    return [name, &executed, &running](SequencerDoneCallback done_callback) {
+      executed.push_back(name);
+      running.push_back(done_callback);
+    };
+  };
+  std::vector<std::string> superseded;
+  auto on_superseded = [&superseded](const std::string &name) {
+    return [name, &superseded]() { superseded.push_back(name); };
+  };
+
+  // The running operation isn't replaced.
+  sequencer.PostMergeable(1, operation("put1"), on_superseded("put1"));
+  sequencer.PostMergeable(1, operation("put2"), on_superseded("put2"));
+  sequencer.PostMergeable(1, operation("put3"), on_superseded("put3"));
+  sequencer.Post(1, operation("delete"));
+  // A mergeable operation doesn't replace a non-mergeable one.
+  sequencer.PostMergeable(1, operation("put4"), on_superseded("put4"));
+  // Operations of other keys aren't replaced.
+  sequencer.PostMergeable(2, operation("other"), on_superseded("other"));
+  ASSERT_EQ(executed, std::vector<std::string>({"put1", "other"}));
+
+  auto done = running[0];
+  done();
+  ASSERT_EQ(executed, std::vector<std::string>({"put1", "other", "put3"}));
+  ASSERT_TRUE(superseded.empty());
+  // The replaced operation is done once the one that replaced it completes.
+  done = running[2];
+  done();
+  ASSERT_EQ(superseded, std::vector<std::string>({"put2"}));
+  ASSERT_EQ(executed, std::vector<std::string>({"put1", "other", "put3", "delete"}));
+  done = running[3];
+  done();
+  ASSERT_EQ(executed,
+            std::vector<std::string>({"put1", "other", "put3", "delete", "put4"}));
+  ASSERT_EQ(superseded, std::vector<std::string>({"put2"}));
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
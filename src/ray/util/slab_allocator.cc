@@ -0,0 +1,71 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/util/slab_allocator.h"
+
+#include <algorithm>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace {
+
+size_t RoundUpToAlignment(size_t size) {
+  constexpr size_t kAlignment = alignof(std::max_align_t);
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+}  // namespace
+
+SlabArena::SlabArena(size_t object_size, size_t blocks_per_slab)
+    : object_size_(object_size),
+      block_size_(RoundUpToAlignment(std::max(object_size, sizeof(FreeBlock)))),
+      blocks_per_slab_(blocks_per_slab) {
+  RAY_CHECK(object_size_ > 0);
+  RAY_CHECK(blocks_per_slab_ > 0);
+}
+
+void *SlabArena::Allocate() {
+  if (free_list_ == nullptr) {
+    AddSlab();
+  }
+  FreeBlock *block = free_list_;
+  free_list_ = block->next;
+  num_allocated_blocks_++;
+  return block;
+}
+
+void SlabArena::Deallocate(void *block) {
+  RAY_CHECK(num_allocated_blocks_ > 0);
+  auto *free_block = static_cast<FreeBlock *>(block);
+  free_block->next = free_list_;
+  free_list_ = free_block;
+  num_allocated_blocks_--;
+}
+
+void SlabArena::AddSlab() {
+  // `new[]` aligns the slab to at least `alignof(std::max_align_t)`, and the block size
+  // is a multiple of it, so every block is aligned too.
+  slabs_.emplace_back(new std::byte[block_size_ * blocks_per_slab_]);
+  std::byte *slab = slabs_.back().get();
+  // Push the blocks in reverse order, so that they are handed out in address order.
+  for (size_t i = blocks_per_slab_; i > 0; i--) {
+    auto *block = reinterpret_cast<FreeBlock *>(slab + (i - 1) * block_size_);
+    block->next = free_list_;
+    free_list_ = block;
+  }
+}
+
+}  // namespace ray
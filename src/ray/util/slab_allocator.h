@@ -0,0 +1,132 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ray {
+
+/// A pool of fixed size blocks, carved out of large slabs. Freed blocks are kept in a
+/// free list and reused by later allocations, and slabs are only returned to the
+/// system when the arena is destroyed. This avoids a `malloc` call and its header per
+/// object for tables holding millions of objects of the same type.
+///
+/// This class is not thread safe.
+class SlabArena {
+ public:
+  /// Create an arena.
+  ///
+  /// \param object_size The size of the objects allocated from this arena.
+  /// \param blocks_per_slab The number of objects per slab.
+  explicit SlabArena(size_t object_size, size_t blocks_per_slab = 1024);
+
+  SlabArena(const SlabArena &) = delete;
+  SlabArena &operator=(const SlabArena &) = delete;
+
+  /// Return a block of `ObjectSize()` bytes, aligned to `alignof(std::max_align_t)`.
+  void *Allocate();
+
+  /// Return a block allocated by `Allocate` to the arena.
+  void Deallocate(void *block);
+
+  /// The size of the objects allocated from this arena.
+  size_t ObjectSize() const { return object_size_; }
+
+  /// The number of blocks that are currently allocated.
+  size_t NumAllocatedBlocks() const { return num_allocated_blocks_; }
+
+  /// The number of slabs that the arena holds.
+  size_t NumSlabs() const { return slabs_.size(); }
+
+ private:
+  /// A free block, linked to the next free block.
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  /// Allocate a new slab and push its blocks to the free list.
+  void AddSlab();
+
+  const size_t object_size_;
+  /// The object size, rounded up so that every block is aligned.
+  const size_t block_size_;
+  const size_t blocks_per_slab_;
+  std::vector<std::unique_ptr<std::byte[]>> slabs_;
+  FreeBlock *free_list_ = nullptr;
+  size_t num_allocated_blocks_ = 0;
+};
+
+/// A standard allocator that allocates single objects of `SlabArena::ObjectSize()`
+/// bytes from a shared `SlabArena`, and everything else from the heap. This is meant
+/// for node based containers such as `absl::node_hash_map`, where each node is
+/// allocated separately. The allocator doesn't use an arena when it is default
+/// constructed.
+///
+/// This class is not thread safe. Containers that share an arena must be guarded by the
+/// same lock.
+template <typename T>
+class SlabAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  SlabAllocator() = default;
+
+  explicit SlabAllocator(std::shared_ptr<SlabArena> arena) : arena_(std::move(arena)) {}
+
+  template <typename U>
+  SlabAllocator(const SlabAllocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    if (UseArena(n)) {
+      return static_cast<T *>(arena_->Allocate());
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (UseArena(n)) {
+      arena_->Deallocate(p);
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  const std::shared_ptr<SlabArena> &arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const SlabAllocator<U> &other) const {
+    return arena_ == other.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const SlabAllocator<U> &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  bool UseArena(size_t n) const {
+    return arena_ != nullptr && n == 1 && sizeof(T) == arena_->ObjectSize() &&
+           alignof(T) <= alignof(std::max_align_t);
+  }
+
+  std::shared_ptr<SlabArena> arena_;
+};
+
+}  // namespace ray
@@ -0,0 +1,96 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/util/slab_allocator.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/node_hash_map.h"
+#include "gtest/gtest.h"
+
+namespace ray {
+
+TEST(SlabArenaTest, TestAllocateAndReuse) {
+  SlabArena arena(/*object_size=*/24, /*blocks_per_slab=*/4);
+  ASSERT_EQ(arena.NumSlabs(), 0);
+
+  std::vector<void *> blocks;
+  for (int i = 0; i < 5; i++) {
+    void *block = arena.Allocate();
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0);
+    blocks.push_back(block);
+  }
+  ASSERT_EQ(arena.NumAllocatedBlocks(), 5);
+  ASSERT_EQ(arena.NumSlabs(), 2);
+
+  // Freed blocks are reused before a new slab is allocated.
+  arena.Deallocate(blocks[1]);
+  ASSERT_EQ(arena.NumAllocatedBlocks(), 4);
+  ASSERT_EQ(arena.Allocate(), blocks[1]);
+  for (int i = 0; i < 3; i++) {
+    arena.Allocate();
+  }
+  ASSERT_EQ(arena.NumAllocatedBlocks(), 8);
+  ASSERT_EQ(arena.NumSlabs(), 2);
+}
+
+TEST(SlabAllocatorTest, TestNodeHashMap) {
+  using Map = absl::node_hash_map<int,
+                                  std::string,
+                                  absl::Hash<int>,
+                                  std::equal_to<int>,
+                                  SlabAllocator<std::pair<const int, std::string>>>;
+  auto arena = std::make_shared<SlabArena>(sizeof(Map::value_type));
+  Map map(/*bucket_count=*/0,
+          Map::hasher(),
+          Map::key_equal(),
+          Map::allocator_type(arena));
+
+  for (int i = 0; i < 1000; i++) {
+    map.emplace(i, std::to_string(i));
+  }
+  // Only the nodes come from the arena, the slot array comes from the heap.
+  ASSERT_EQ(arena->NumAllocatedBlocks(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(map.at(i), std::to_string(i));
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    map.erase(i);
+  }
+  ASSERT_EQ(arena->NumAllocatedBlocks(), 500);
+
+  // Moving the map keeps using the same arena.
+  Map moved = std::move(map);
+  ASSERT_EQ(moved.get_allocator().arena(), arena);
+  moved.clear();
+  ASSERT_EQ(arena->NumAllocatedBlocks(), 0);
+}
+
+TEST(SlabAllocatorTest, TestWithoutArena) {
+  // A default constructed allocator allocates from the heap.
+  absl::node_hash_map<int,
+                      int,
+                      absl::Hash<int>,
+                      std::equal_to<int>,
+                      SlabAllocator<std::pair<const int, int>>>
+      map;
+  map.emplace(1, 2);
+  ASSERT_EQ(map.at(1), 2);
+  ASSERT_EQ(map.get_allocator().arena(), nullptr);
+}
+
+}  // namespace ray
@@ -0,0 +1,212 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
+
+/// \class small_set
+///
+/// A set that stores up to `N` elements inline, and only moves them to a heap
+/// allocated `absl::flat_hash_set` once it grows past `N` elements. This is meant for
+/// sets that are usually empty or hold a single element, where a hash set would pay
+/// for a heap allocation per set. Lookups in the inline storage are linear scans, so
+/// `N` should stay small.
+///
+/// Only `const` iteration is supported, and any insertion or erasure may invalidate
+/// iterators.
+template <typename T, size_t N = 1>
+class small_set {
+ private:
+  using inline_type = absl::InlinedVector<T, N>;
+  using spilled_type = absl::flat_hash_set<T>;
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return spilled_ ? *spilled_it_ : *inline_it_; }
+    pointer operator->() const { return &**this; }
+
+    const_iterator &operator++() {
+      if (spilled_) {
+        ++spilled_it_;
+      } else {
+        ++inline_it_;
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return spilled_ ? spilled_it_ == other.spilled_it_
+                      : inline_it_ == other.inline_it_;
+    }
+    bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class small_set;
+
+    explicit const_iterator(typename inline_type::const_iterator it)
+        : inline_it_(it), spilled_(false) {}
+    explicit const_iterator(typename spilled_type::const_iterator it)
+        : spilled_it_(it), spilled_(true) {}
+
+    typename inline_type::const_iterator inline_it_{};
+    typename spilled_type::const_iterator spilled_it_{};
+    bool spilled_ = false;
+  };
+  using iterator = const_iterator;
+
+  small_set() = default;
+
+  template <typename InputIt>
+  small_set(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  small_set(std::initializer_list<T> values) : small_set(values.begin(), values.end()) {}
+
+  small_set(const small_set &other) { *this = other; }
+
+  small_set &operator=(const small_set &other) {
+    if (this != &other) {
+      inline_ = other.inline_;
+      spilled_ = other.spilled_ ? std::make_unique<spilled_type>(*other.spilled_)
+                                : nullptr;
+    }
+    return *this;
+  }
+
+  small_set(small_set &&other) = default;
+  small_set &operator=(small_set &&other) = default;
+
+  const_iterator begin() const {
+    return spilled_ ? const_iterator(spilled_->begin()) : const_iterator(inline_.begin());
+  }
+  const_iterator end() const {
+    return spilled_ ? const_iterator(spilled_->end()) : const_iterator(inline_.end());
+  }
+
+  size_t size() const { return spilled_ ? spilled_->size() : inline_.size(); }
+
+  bool empty() const { return size() == 0; }
+
+  const_iterator find(const T &value) const {
+    if (spilled_) {
+      return const_iterator(spilled_->find(value));
+    }
+    return const_iterator(std::find(inline_.begin(), inline_.end(), value));
+  }
+
+  size_t count(const T &value) const { return find(value) != end(); }
+
+  bool contains(const T &value) const { return count(value) > 0; }
+
+  std::pair<const_iterator, bool> insert(const T &value) {
+    if (spilled_) {
+      auto [it, inserted] = spilled_->insert(value);
+      return {const_iterator(it), inserted};
+    }
+    auto it = std::find(inline_.begin(), inline_.end(), value);
+    if (it != inline_.end()) {
+      return {const_iterator(it), false};
+    }
+    if (inline_.size() < N) {
+      inline_.push_back(value);
+      return {const_iterator(inline_.end() - 1), true};
+    }
+    // Spill all elements to the heap.
+    spilled_ = std::make_unique<spilled_type>(std::make_move_iterator(inline_.begin()),
+                                              std::make_move_iterator(inline_.end()));
+    inline_.clear();
+    return {const_iterator(spilled_->insert(value).first), true};
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> emplace(Args &&...args) {
+    return insert(T(std::forward<Args>(args)...));
+  }
+
+  size_t erase(const T &value) {
+    if (spilled_) {
+      return spilled_->erase(value);
+    }
+    auto it = std::find(inline_.begin(), inline_.end(), value);
+    if (it == inline_.end()) {
+      return 0;
+    }
+    // The order of the inline elements doesn't matter, so fill the hole with the last
+    // element.
+    if (it != inline_.end() - 1) {
+      *it = std::move(inline_.back());
+    }
+    inline_.pop_back();
+    return 1;
+  }
+
+  void clear() {
+    inline_.clear();
+    spilled_.reset();
+  }
+
+  bool operator==(const small_set &other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    for (const auto &value : *this) {
+      if (!other.contains(value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator!=(const small_set &other) const { return !(*this == other); }
+
+ private:
+  /// The elements, as long as the set has not spilled to the heap.
+  inline_type inline_;
+  /// The elements, once the set has grown past N elements. The set stays spilled until
+  /// it is cleared.
+  std::unique_ptr<spilled_type> spilled_;
+};
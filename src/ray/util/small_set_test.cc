@@ -0,0 +1,92 @@
+// Copyright 2022 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/util/small_set.h"
+
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+TEST(SmallSetTest, TestInline) {
+  small_set<int, 2> set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.begin(), set.end());
+
+  ASSERT_TRUE(set.insert(1).second);
+  ASSERT_FALSE(set.insert(1).second);
+  ASSERT_TRUE(set.emplace(2).second);
+  ASSERT_EQ(set.size(), 2);
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_EQ(set.count(2), 1);
+  ASSERT_FALSE(set.contains(3));
+  ASSERT_EQ(*set.find(2), 2);
+  ASSERT_EQ(set.find(3), set.end());
+
+  ASSERT_EQ(set.erase(3), 0);
+  ASSERT_EQ(set.erase(1), 1);
+  ASSERT_EQ(set.size(), 1);
+  ASSERT_FALSE(set.contains(1));
+  ASSERT_TRUE(set.contains(2));
+}
+
+TEST(SmallSetTest, TestSpill) {
+  small_set<std::string, 2> set{"a", "b"};
+  ASSERT_EQ(set.size(), 2);
+
+  // Growing past the inline capacity moves all elements to the heap.
+  ASSERT_TRUE(set.insert("c").second);
+  ASSERT_FALSE(set.insert("a").second);
+  ASSERT_EQ(set.size(), 3);
+  ASSERT_EQ(std::set<std::string>(set.begin(), set.end()),
+            std::set<std::string>({"a", "b", "c"}));
+
+  ASSERT_EQ(set.erase("a"), 1);
+  ASSERT_EQ(set.erase("a"), 0);
+  ASSERT_EQ(set.size(), 2);
+  ASSERT_EQ(std::set<std::string>(set.begin(), set.end()),
+            std::set<std::string>({"b", "c"}));
+
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.insert("d").second);
+  ASSERT_EQ(*set.begin(), "d");
+}
+
+TEST(SmallSetTest, TestCopyAndCompare) {
+  small_set<int> inlined{1};
+  small_set<int> spilled{1, 2, 3};
+
+  auto inlined_copy = inlined;
+  auto spilled_copy = spilled;
+  ASSERT_EQ(inlined_copy, inlined);
+  ASSERT_EQ(spilled_copy, spilled);
+  ASSERT_NE(inlined, spilled);
+
+  // Copies don't share storage with the original.
+  spilled_copy.erase(2);
+  ASSERT_TRUE(spilled.contains(2));
+  ASSERT_NE(spilled_copy, spilled);
+
+  // Sets with the same elements are equal, regardless of how they are stored.
+  spilled_copy.erase(3);
+  ASSERT_EQ(spilled_copy, inlined);
+
+  auto moved = std::move(spilled);
+  ASSERT_EQ(moved.size(), 3);
+}
+
+}  // namespace ray